@@ -136,7 +136,18 @@ LOCAL_SRC_FILES := \
     src/agent/main.cpp \
     src/agent/ncp_openthread.cpp \
     src/agent/thread_helper.cpp \
+    src/common/binary_logging.cpp \
+    src/common/circular_logging.cpp \
+    src/common/histogram.cpp \
     src/common/logging.cpp \
+    src/common/mainloop_stats.cpp \
+    src/common/memory_stats.cpp \
+    src/common/reactor.cpp \
+    src/common/table_version.cpp \
+    src/common/task_queue.cpp \
+    src/common/time.cpp \
+    src/common/timer.cpp \
+    src/common/worker_pool.cpp \
     src/dbus/common/dbus_message_helper.cpp \
     src/dbus/common/dbus_message_helper_openthread.cpp \
     src/dbus/common/error.cpp \
@@ -144,9 +155,11 @@ LOCAL_SRC_FILES := \
     src/dbus/server/dbus_object.cpp \
     src/dbus/server/dbus_thread_object.cpp \
     src/dbus/server/error_helper.cpp \
-    src/utils/event_emitter.cpp \
+    src/utils/channel_quality.cpp \
+    src/utils/counter_history.cpp \
     src/utils/hex.cpp \
     src/utils/strcpy_utils.cpp \
+    src/utils/topology.cpp \
     $(NULL)
 
 LOCAL_STATIC_LIBRARIES += \
@@ -160,6 +173,7 @@ LOCAL_LDLIBS := \
 
 ifeq ($(OTBR_MDNS),mDNSResponder)
 LOCAL_SRC_FILES += \
+    src/mdns/mdns.cpp \
     src/mdns/mdns_mdnssd.cpp \
     $(NULL)
 
@@ -171,6 +185,7 @@ LOCAL_CFLAGS += \
     $(NULL)
 
 LOCAL_SRC_FILES += \
+    src/mdns/mdns.cpp \
     src/mdns/mdns_mojo.cpp \
     $(NULL)
 
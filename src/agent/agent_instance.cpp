@@ -34,15 +34,27 @@
 #include "agent/agent_instance.hpp"
 
 #include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <openthread/platform/toolchain.h>
 
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
 
 namespace otbr {
 
+#if OTBR_ENABLE_HOT_RESTART && OTBR_ENABLE_REST_SERVER
+static const char kRestListenFdName[] = "rest-listen";
+#endif
+
 AgentInstance::AgentInstance(Ncp::Controller *aNcp)
     : mNcp(aNcp)
     , mBorderAgent(aNcp)
+#if OTBR_ENABLE_REST_SERVER
+    , mRestServer(reinterpret_cast<Ncp::ControllerOpenThread *>(aNcp))
+#endif
 {
 }
 
@@ -51,9 +63,15 @@ otbrError AgentInstance::Init(void)
     otbrError error = OTBR_ERROR_NONE;
 
     SuccessOrExit(error = mNcp->Init());
+    LogStartupMilestone("RCP initialized");
 
     mBorderAgent.Init();
 
+#if OTBR_ENABLE_REST_SERVER
+    // The agent still serves the Thread network without the REST server, e.g. when the port is in use.
+    mRestServer.Init();
+#endif
+
 exit:
     otbrLogResult("Initialize OpenThread Border Router Agent", error);
     return error;
@@ -64,13 +82,48 @@ void AgentInstance::UpdateFdSet(otSysMainloopContext &aMainloop)
     mNcp->UpdateFdSet(aMainloop);
     mBorderAgent.UpdateFdSet(aMainloop.mReadFdSet, aMainloop.mWriteFdSet, aMainloop.mErrorFdSet, aMainloop.mMaxFd,
                              aMainloop.mTimeout);
+#if OTBR_ENABLE_REST_SERVER
+    mRestServer.UpdateFdSet(aMainloop);
+#endif
 }
 
 void AgentInstance::Process(const otSysMainloopContext &aMainloop)
 {
     mNcp->Process(aMainloop);
     mBorderAgent.Process(aMainloop.mReadFdSet, aMainloop.mWriteFdSet, aMainloop.mErrorFdSet);
+#if OTBR_ENABLE_REST_SERVER
+    mRestServer.Process(aMainloop);
+#endif
+}
+
+#if OTBR_ENABLE_HOT_RESTART
+void AgentInstance::SaveState(HotRestartSnapshot &aSnapshot)
+{
+#if OTBR_ENABLE_REST_SERVER
+    if (mRestServer.GetListenFd() >= 0 &&
+        aSnapshot.AddFd(kRestListenFdName, mRestServer.GetListenFd()) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to save the REST server socket: %s", strerror(errno));
+    }
+#else
+    OT_UNUSED_VARIABLE(aSnapshot);
+#endif
+}
+
+void AgentInstance::RestoreState(HotRestartSnapshot &aSnapshot)
+{
+#if OTBR_ENABLE_REST_SERVER
+    int restListenFd = aSnapshot.TakeFd(kRestListenFdName);
+
+    if (restListenFd >= 0)
+    {
+        mRestServer.SetListenFd(restListenFd);
+    }
+#else
+    OT_UNUSED_VARIABLE(aSnapshot);
+#endif
 }
+#endif // OTBR_ENABLE_HOT_RESTART
 
 AgentInstance::~AgentInstance(void)
 {
@@ -43,6 +43,13 @@
 
 #include "agent/border_agent.hpp"
 #include "agent/ncp.hpp"
+#if OTBR_ENABLE_HOT_RESTART
+#include "common/hot_restart.hpp"
+#endif
+
+#if OTBR_ENABLE_REST_SERVER
+#include "rest/rest_server.hpp"
+#endif
 
 namespace otbr {
 
@@ -97,9 +104,30 @@ public:
      */
     Ncp::Controller &GetNcp(void) { return *mNcp; }
 
+#if OTBR_ENABLE_HOT_RESTART
+    /**
+     * This method saves the state handed over to the agent replacing this one.
+     *
+     * @param[inout]    aSnapshot   A reference to the snapshot.
+     *
+     */
+    void SaveState(HotRestartSnapshot &aSnapshot);
+
+    /**
+     * This method restores the state handed over by the agent this one replaces, it is called before Init().
+     *
+     * @param[inout]    aSnapshot   A reference to the snapshot, the restored file descriptors are taken out of it.
+     *
+     */
+    void RestoreState(HotRestartSnapshot &aSnapshot);
+#endif
+
 private:
     Ncp::Controller *mNcp;
     BorderAgent      mBorderAgent;
+#if OTBR_ENABLE_REST_SERVER
+    Rest::RestServer mRestServer;
+#endif
 };
 
 } // namespace otbr
@@ -49,11 +49,41 @@
 #include "agent/uris.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/time.hpp"
 #include "common/tlv.hpp"
 #include "common/types.hpp"
 #include "utils/hex.hpp"
 #include "utils/strcpy_utils.hpp"
 
+/**
+ * The minimum interval in milliseconds between two updates of the border agent service.
+ *
+ * Updates requested within the hold-down are merged and published once it expires.
+ *
+ */
+#ifndef OTBR_CONFIG_BORDER_AGENT_PUBLISH_HOLDDOWN
+#define OTBR_CONFIG_BORDER_AGENT_PUBLISH_HOLDDOWN 1000
+#endif
+
+/**
+ * The file persisting the last published border agent service, an empty string disables it.
+ *
+ * At startup the persisted service is published right away, before the NCP reports the current values.
+ *
+ */
+#ifndef OTBR_CONFIG_BORDER_AGENT_CACHE_FILE
+#define OTBR_CONFIG_BORDER_AGENT_CACHE_FILE "/var/lib/thread/otbr-border-agent.cache"
+#endif
+
+/**
+ * The time in milliseconds a service published from the cache is kept without being confirmed by the NCP.
+ *
+ */
+#ifndef OTBR_CONFIG_BORDER_AGENT_CACHED_SERVICE_TIMEOUT
+#define OTBR_CONFIG_BORDER_AGENT_CACHED_SERVICE_TIMEOUT 30000
+#endif
+
 namespace otbr {
 
 static const uint16_t kThreadVersion11 = 2; ///< Thread Version 1.1
@@ -61,6 +91,8 @@ static const uint16_t kThreadVersion12 = 3; ///< Thread Version 1.2
 
 static const char kBorderAgentServiceType[] = "_meshcop._udp."; ///< Border agent service type of mDNS
 
+static const uint8_t kCacheFileMagic[] = {'O', 'T', 'B', 'A', 1}; ///< Identifies version 1 of the cache file.
+
 /**
  * Locators
  *
@@ -88,7 +120,15 @@ BorderAgent::BorderAgent(Ncp::Controller *aNcp)
 #endif
     , mNcp(aNcp)
     , mThreadStarted(false)
+    , mPublishTimer(HandlePublishTimer, this)
+    , mLastPublishTime(0)
+    , mPendingReason(kPublishReasonNum)
+    , mCachedServiceStale(false)
+    , mCachedServiceTimer(HandleCachedServiceTimer, this)
 {
+    mPublishedName[0] = '\0';
+    mCachedName[0]    = '\0';
+    memset(&mPublishCounters, 0, sizeof(mPublishCounters));
 }
 
 void BorderAgent::Init(void)
@@ -97,34 +137,47 @@ void BorderAgent::Init(void)
     memset(mExtPanId, 0, sizeof(mExtPanId));
     mExtPanIdInitialized = false;
     mThreadVersion       = 0;
+    mTxtRecord.Clear();
 
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    mNcp->On(Ncp::kEventExtPanId, HandleExtPanId, this);
-    mNcp->On(Ncp::kEventNetworkName, HandleNetworkName, this);
-    mNcp->On(Ncp::kEventThreadVersion, HandleThreadVersion, this);
+    mNcp->On<Ncp::kEventExtPanId>(HandleExtPanId, this);
+    mNcp->On<Ncp::kEventNetworkName>(HandleNetworkName, this);
+    mNcp->On<Ncp::kEventThreadVersion>(HandleThreadVersion, this);
 #endif
-    mNcp->On(Ncp::kEventThreadState, HandleThreadState, this);
-    mNcp->On(Ncp::kEventPSKc, HandlePSKc, this);
+    mNcp->On<Ncp::kEventThreadState>(HandleThreadState, this);
+    mNcp->On<Ncp::kEventPSKc>(HandlePSKc, this);
+    mNcp->On<Ncp::kEventNetworkState>(HandleNetworkState, this);
 
     otbrLogResult("Check if Thread is up", mNcp->RequestEvent(Ncp::kEventThreadState));
     otbrLogResult("Check if PSKc is initialized", mNcp->RequestEvent(Ncp::kEventPSKc));
+
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    StartCachedService();
+#endif
 }
 
-otbrError BorderAgent::Start(void)
+otbrError BorderAgent::Start(PublishReason aReason)
 {
     otbrError error = OTBR_ERROR_NONE;
 
     VerifyOrExit(mThreadStarted && mPSKcInitialized, errno = EAGAIN, error = OTBR_ERROR_ERRNO);
 
-    // In case we didn't receive Thread down event.
-    Stop();
-
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
     SuccessOrExit(error = mNcp->RequestEvent(Ncp::kEventNetworkName));
     SuccessOrExit(error = mNcp->RequestEvent(Ncp::kEventExtPanId));
 
     SuccessOrExit(error = mNcp->RequestEvent(Ncp::kEventThreadVersion));
-    StartPublishService();
+
+    // In case we didn't receive Thread down event, drop the service published under a stale name. A service
+    // under the current name is updated in place or left alone if nothing changed.
+    if (IsPublished() && strcmp(mPublishedName, mNetworkName) != 0)
+    {
+        StopPublishService();
+    }
+
+    StartPublishService(aReason);
+#else
+    (void)aReason;
 #endif // OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
 
     // Suppress unused warning of label exit
@@ -158,7 +211,17 @@ void BorderAgent::HandleMdnsState(Mdns::State aState)
     switch (aState)
     {
     case Mdns::kStateReady:
-        PublishService();
+        // The publisher holds no registration when it becomes ready.
+        mPublishedName[0] = '\0';
+
+        if (mCachedServiceStale)
+        {
+            PublishCachedService();
+        }
+        else
+        {
+            PublishService(kPublishReasonMdnsReady);
+        }
         break;
     default:
         otbrLog(OTBR_LOG_WARNING, "MDNS service not available!");
@@ -186,6 +249,7 @@ void BorderAgent::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, c
     }
 }
 
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
 static const char *ThreadVersionToString(uint16_t aThreadVersion)
 {
     switch (aThreadVersion)
@@ -199,29 +263,190 @@ static const char *ThreadVersionToString(uint16_t aThreadVersion)
         abort();
     }
 }
+#endif
 
-void BorderAgent::PublishService(void)
+void BorderAgent::PublishService(PublishReason aReason)
 {
-    char xpanid[sizeof(mExtPanId) * 2 + 1];
+    unsigned long now = GetMainloopNow();
 
     assert(mNetworkName[0] != '\0');
     assert(mExtPanIdInitialized);
-    Utils::Bytes2Hex(mExtPanId, sizeof(mExtPanId), xpanid);
-
     assert(mThreadVersion != 0);
-    mPublisher->PublishService(kBorderAgentUdpPort, mNetworkName, kBorderAgentServiceType, "nn", mNetworkName, "xp",
-                               xpanid, "tv", ThreadVersionToString(mThreadVersion), NULL);
+
+    if (IsPublished() && strcmp(mPublishedName, mNetworkName) == 0 && mPublishedTxtRecord == mTxtRecord)
+    {
+        ++mPublishCounters.mSuppressed[aReason];
+        ExitNow();
+    }
+
+    if (mPublishTimer.IsRunning())
+    {
+        // An update is already held down, it will carry this change too.
+        ++mPublishCounters.mSuppressed[mPendingReason];
+        mPendingReason = aReason;
+        ExitNow();
+    }
+
+    if (IsPublished() && now - mLastPublishTime < OTBR_CONFIG_BORDER_AGENT_PUBLISH_HOLDDOWN)
+    {
+        mPendingReason = aReason;
+        mPublishTimer.StartAt(mLastPublishTime + OTBR_CONFIG_BORDER_AGENT_PUBLISH_HOLDDOWN);
+        ExitNow();
+    }
+
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    SuccessOrExit(mPublisher->PublishService(kBorderAgentUdpPort, mNetworkName, kBorderAgentServiceType, mTxtRecord));
+#endif
+
+    if (mLastPublishTime == 0)
+    {
+        LogStartupMilestone("MeshCoP service published");
+    }
+
+    strcpy_safe(mPublishedName, sizeof(mPublishedName), mNetworkName);
+    mPublishedTxtRecord = mTxtRecord;
+    mLastPublishTime    = now;
+    ++mPublishCounters.mPublished[aReason];
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    SaveCachedService();
+#endif
+
+exit:
+    return;
 }
 
-void BorderAgent::StartPublishService(void)
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+void BorderAgent::StartCachedService(void)
+{
+    FILE *   fp = NULL;
+    uint8_t  magic[sizeof(kCacheFileMagic)];
+    uint8_t  nameLength;
+    uint16_t txtLength;
+    uint8_t  txtData[Mdns::TxtRecord::kMaxSizeOfData];
+
+    VerifyOrExit(OTBR_CONFIG_BORDER_AGENT_CACHE_FILE[0] != '\0');
+    // The current values are already known, there is nothing to speed up.
+    VerifyOrExit(!IsPublished() && !mPublisher->IsStarted());
+
+    fp = fopen(OTBR_CONFIG_BORDER_AGENT_CACHE_FILE, "rb");
+    VerifyOrExit(fp != NULL);
+
+    VerifyOrExit(fread(magic, sizeof(magic), 1, fp) == 1 && memcmp(magic, kCacheFileMagic, sizeof(magic)) == 0);
+    VerifyOrExit(fread(&nameLength, sizeof(nameLength), 1, fp) == 1);
+    VerifyOrExit(nameLength > 0 && nameLength < sizeof(mCachedName));
+    VerifyOrExit(fread(mCachedName, nameLength, 1, fp) == 1);
+    mCachedName[nameLength] = '\0';
+    VerifyOrExit(fread(&txtLength, sizeof(txtLength), 1, fp) == 1);
+    VerifyOrExit(txtLength <= sizeof(txtData) && fread(txtData, 1, txtLength, fp) == txtLength);
+    VerifyOrExit(mCachedTxtRecord.SetData(txtData, txtLength) == OTBR_ERROR_NONE);
+
+    otbrLog(OTBR_LOG_INFO, "Publishing the cached border agent service %s until the NCP confirms it", mCachedName);
+    mCachedServiceStale = true;
+    mCachedServiceTimer.Start(OTBR_CONFIG_BORDER_AGENT_CACHED_SERVICE_TIMEOUT);
+    mPublisher->Start();
+
+exit:
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    if (!mCachedServiceStale)
+    {
+        mCachedName[0] = '\0';
+    }
+}
+
+void BorderAgent::PublishCachedService(void)
+{
+    VerifyOrExit(mPublisher->PublishService(kBorderAgentUdpPort, mCachedName, kBorderAgentServiceType,
+                                            mCachedTxtRecord) == OTBR_ERROR_NONE);
+
+    // Not setting the last publish time, the update with the current values is not held down.
+    strcpy_safe(mPublishedName, sizeof(mPublishedName), mCachedName);
+    mPublishedTxtRecord = mCachedTxtRecord;
+    LogStartupMilestone("Cached MeshCoP service published");
+
+exit:
+    return;
+}
+
+void BorderAgent::StopCachedService(void)
+{
+    mCachedServiceStale = false;
+    mCachedServiceTimer.Stop();
+}
+
+void BorderAgent::SaveCachedService(void)
+{
+    std::string tempFile = std::string(OTBR_CONFIG_BORDER_AGENT_CACHE_FILE) + ".tmp";
+    otbrError   error    = OTBR_ERROR_ERRNO;
+    FILE *      fp       = NULL;
+    uint8_t     nameLength;
+    uint16_t    txtLength = mPublishedTxtRecord.GetLength();
+
+    VerifyOrExit(OTBR_CONFIG_BORDER_AGENT_CACHE_FILE[0] != '\0', error = OTBR_ERROR_NONE);
+
+    fp = fopen(tempFile.c_str(), "wb");
+    VerifyOrExit(fp != NULL);
+
+    nameLength = static_cast<uint8_t>(strlen(mPublishedName));
+    VerifyOrExit(fwrite(kCacheFileMagic, sizeof(kCacheFileMagic), 1, fp) == 1);
+    VerifyOrExit(fwrite(&nameLength, sizeof(nameLength), 1, fp) == 1);
+    VerifyOrExit(fwrite(mPublishedName, nameLength, 1, fp) == 1);
+    VerifyOrExit(fwrite(&txtLength, sizeof(txtLength), 1, fp) == 1);
+    VerifyOrExit(fwrite(mPublishedTxtRecord.GetData(), 1, txtLength, fp) == txtLength);
+
+    error = fclose(fp) == 0 ? OTBR_ERROR_NONE : OTBR_ERROR_ERRNO;
+    fp    = NULL;
+    SuccessOrExit(error);
+
+    // The file is replaced atomically, a crash while writing leaves the previous cache in place.
+    VerifyOrExit(rename(tempFile.c_str(), OTBR_CONFIG_BORDER_AGENT_CACHE_FILE) == 0, error = OTBR_ERROR_ERRNO);
+
+exit:
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to save the border agent service cache: %s", strerror(errno));
+        unlink(tempFile.c_str());
+    }
+}
+#endif // OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+
+void BorderAgent::HandleCachedServiceTimer(Timer &aTimer, void *aContext)
+{
+    BorderAgent *borderAgent = static_cast<BorderAgent *>(aContext);
+
+    (void)aTimer;
+    otbrLog(OTBR_LOG_INFO, "Withdrawing the cached border agent service, not confirmed by the NCP");
+    borderAgent->StopPublishService();
+}
+
+void BorderAgent::HandlePublishTimer(Timer &aTimer, void *aContext)
+{
+    BorderAgent *borderAgent = static_cast<BorderAgent *>(aContext);
+
+    (void)aTimer;
+    borderAgent->PublishService(borderAgent->mPendingReason);
+}
+
+void BorderAgent::StartPublishService(PublishReason aReason)
 {
     VerifyOrExit(mNetworkName[0] != '\0');
     VerifyOrExit(mExtPanIdInitialized);
     VerifyOrExit(mThreadVersion != 0);
 
+    // The current values replace the service published from the cache, if any.
+    StopCachedService();
+
     if (mPublisher->IsStarted())
     {
-        PublishService();
+        PublishService(aReason);
     }
     else
     {
@@ -234,6 +459,12 @@ exit:
 
 void BorderAgent::StopPublishService(void)
 {
+    mPublishTimer.Stop();
+    mPublishedName[0] = '\0';
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    StopCachedService();
+#endif
+
     VerifyOrExit(mPublisher != NULL);
 
     if (mPublisher->IsStarted())
@@ -248,14 +479,8 @@ exit:
 void BorderAgent::SetNetworkName(const char *aNetworkName)
 {
     strcpy_safe(mNetworkName, sizeof(mNetworkName), aNetworkName);
-
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    if (mThreadStarted)
-    {
-        // Restart publisher to publish new service name.
-        mPublisher->Stop();
-        StartPublishService();
-    }
+    mTxtRecord.SetEntry("nn", mNetworkName);
 #endif
 }
 
@@ -264,9 +489,11 @@ void BorderAgent::SetExtPanId(const uint8_t *aExtPanId)
     memcpy(mExtPanId, aExtPanId, sizeof(mExtPanId));
     mExtPanIdInitialized = true;
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    if (mThreadStarted)
     {
-        StartPublishService();
+        char xpanid[sizeof(mExtPanId) * 2 + 1];
+
+        Utils::Bytes2Hex(mExtPanId, sizeof(mExtPanId), xpanid);
+        mTxtRecord.SetEntry("xp", xpanid);
     }
 #endif
 }
@@ -275,20 +502,13 @@ void BorderAgent::SetThreadVersion(uint16_t aThreadVersion)
 {
     mThreadVersion = aThreadVersion;
 #if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
-    if (mThreadStarted)
-    {
-        StartPublishService();
-    }
+    mTxtRecord.SetEntry("tv", ThreadVersionToString(mThreadVersion));
 #endif
 }
 
-void BorderAgent::HandlePSKc(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandlePSKc(void *aContext, const uint8_t *aPSKc)
 {
-    OT_UNUSED_VARIABLE(aEvent);
-
-    assert(aEvent == Ncp::kEventPSKc);
-
-    static_cast<BorderAgent *>(aContext)->HandlePSKc(va_arg(aArguments, const uint8_t *));
+    static_cast<BorderAgent *>(aContext)->HandlePSKc(aPSKc);
 }
 
 void BorderAgent::HandlePSKc(const uint8_t *aPSKc)
@@ -306,7 +526,7 @@ void BorderAgent::HandlePSKc(const uint8_t *aPSKc)
 
     if (mPSKcInitialized)
     {
-        Start();
+        Start(kPublishReasonPSKc);
     }
     else
     {
@@ -325,7 +545,7 @@ void BorderAgent::HandleThreadState(bool aStarted)
     if (aStarted)
     {
         SuccessOrExit(mNcp->RequestEvent(Ncp::kEventPSKc));
-        Start();
+        Start(kPublishReasonThreadState);
     }
     else
     {
@@ -336,45 +556,69 @@ exit:
     otbrLog(OTBR_LOG_INFO, "Thread is %s", (aStarted ? "up" : "down"));
 }
 
-void BorderAgent::HandleThreadState(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleNetworkState(uint32_t aChanged, const Ncp::NetworkState &aState)
 {
-    OT_UNUSED_VARIABLE(aEvent);
+    bool nameChanged   = false;
+    bool extPanChanged = false;
 
-    assert(aEvent == Ncp::kEventThreadState);
+    if (aChanged & Ncp::kChangedNetworkName)
+    {
+        nameChanged = (strcmp(mNetworkName, aState.mNetworkName) != 0);
+        SetNetworkName(aState.mNetworkName);
+    }
 
-    int started = va_arg(aArguments, int);
-    static_cast<BorderAgent *>(aContext)->HandleThreadState(started);
-}
+    if (aChanged & Ncp::kChangedExtPanId)
+    {
+        extPanChanged = !mExtPanIdInitialized || memcmp(mExtPanId, aState.mExtPanId, sizeof(mExtPanId)) != 0;
+        SetExtPanId(aState.mExtPanId);
+    }
 
-void BorderAgent::HandleNetworkName(void *aContext, int aEvent, va_list aArguments)
-{
-    OT_UNUSED_VARIABLE(aEvent);
+    if ((aChanged & Ncp::kChangedThreadState) && aState.mAttached != mThreadStarted)
+    {
+        // Starting refreshes the whole service, so the other changes need no separate republish.
+        HandleThreadState(aState.mAttached);
+        ExitNow();
+    }
+
+    VerifyOrExit(mThreadStarted && (nameChanged || extPanChanged));
 
-    assert(aEvent == Ncp::kEventNetworkName);
+#if OTBR_ENABLE_MDNS_AVAHI || OTBR_ENABLE_MDNS_MDNSSD || OTBR_ENABLE_MDNS_MOJO
+    if (nameChanged)
+    {
+        // Restart publisher to publish new service name.
+        StopPublishService();
+    }
+
+    StartPublishService(nameChanged ? kPublishReasonNetworkName : kPublishReasonExtPanId);
+#endif
 
-    const char *networkName = va_arg(aArguments, const char *);
-    static_cast<BorderAgent *>(aContext)->SetNetworkName(networkName);
+exit:
+    return;
 }
 
-void BorderAgent::HandleExtPanId(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleNetworkState(void *aContext, uint32_t aChanged, const Ncp::NetworkState &aState)
 {
-    OT_UNUSED_VARIABLE(aEvent);
-
-    assert(aEvent == Ncp::kEventExtPanId);
+    static_cast<BorderAgent *>(aContext)->HandleNetworkState(aChanged, aState);
+}
 
-    const uint8_t *xpanid = va_arg(aArguments, const uint8_t *);
-    static_cast<BorderAgent *>(aContext)->SetExtPanId(xpanid);
+void BorderAgent::HandleThreadState(void *aContext, bool aStarted)
+{
+    static_cast<BorderAgent *>(aContext)->HandleThreadState(aStarted);
 }
 
-void BorderAgent::HandleThreadVersion(void *aContext, int aEvent, va_list aArguments)
+void BorderAgent::HandleNetworkName(void *aContext, const char *aNetworkName)
 {
-    OT_UNUSED_VARIABLE(aEvent);
+    static_cast<BorderAgent *>(aContext)->SetNetworkName(aNetworkName);
+}
 
-    assert(aEvent == Ncp::kEventThreadVersion);
+void BorderAgent::HandleExtPanId(void *aContext, const uint8_t *aExtPanId)
+{
+    static_cast<BorderAgent *>(aContext)->SetExtPanId(aExtPanId);
+}
 
-    // `uint16_t` has been promoted to `int`.
-    uint16_t threadVersion = static_cast<uint16_t>(va_arg(aArguments, int));
-    static_cast<BorderAgent *>(aContext)->SetThreadVersion(threadVersion);
+void BorderAgent::HandleThreadVersion(void *aContext, uint16_t aThreadVersion)
+{
+    static_cast<BorderAgent *>(aContext)->SetThreadVersion(aThreadVersion);
 }
 
 } // namespace otbr
@@ -37,6 +37,7 @@
 #include <stdint.h>
 
 #include "agent/ncp.hpp"
+#include "common/timer.hpp"
 #include "mdns/mdns.hpp"
 
 namespace otbr {
@@ -57,6 +58,30 @@ namespace otbr {
 class BorderAgent
 {
 public:
+    /**
+     * The reasons for publishing the border agent service.
+     *
+     */
+    enum PublishReason
+    {
+        kPublishReasonThreadState, ///< Thread became up.
+        kPublishReasonPSKc,        ///< The PSKc became initialized.
+        kPublishReasonNetworkName, ///< The network name changed.
+        kPublishReasonExtPanId,    ///< The extended PAN ID changed.
+        kPublishReasonMdnsReady,   ///< The MDNS publisher became ready.
+        kPublishReasonNum,         ///< The number of publish reasons.
+    };
+
+    /**
+     * This structure represents the counters of service publications by reason.
+     *
+     */
+    struct PublishCounters
+    {
+        uint32_t mPublished[kPublishReasonNum];  ///< Updates handed to the MDNS publisher.
+        uint32_t mSuppressed[kPublishReasonNum]; ///< Updates dropped as unchanged or merged into a held-down one.
+    };
+
     /**
      * The constructor to initialize the Thread border agent.
      *
@@ -95,15 +120,25 @@ public:
      */
     void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
 
+    /**
+     * This method returns the service publication counters.
+     *
+     * @returns A reference to the publication counters.
+     *
+     */
+    const PublishCounters &GetPublishCounters(void) const { return mPublishCounters; }
+
 private:
     /**
      * This method starts border agent service.
      *
+     * @param[in]   aReason     The reason for starting.
+     *
      * @retval  OTBR_ERROR_NONE     Successfully started border agent.
      * @retval  OTBR_ERROR_ERRNO    Failed to start border agent.
      *
      */
-    otbrError Start(void);
+    otbrError Start(PublishReason aReason);
 
     /**
      * This method stops border agent service.
@@ -116,23 +151,33 @@ private:
         static_cast<BorderAgent *>(aContext)->HandleMdnsState(aState);
     }
     void HandleMdnsState(Mdns::State aState);
-    void PublishService(void);
-    void StartPublishService(void);
+    void PublishService(PublishReason aReason);
+    void StartPublishService(PublishReason aReason);
     void StopPublishService(void);
+    bool IsPublished(void) const { return mPublishedName[0] != '\0'; }
+    void StartCachedService(void);
+    void PublishCachedService(void);
+    void StopCachedService(void);
+    void SaveCachedService(void);
 
     void SetNetworkName(const char *aNetworkName);
     void SetExtPanId(const uint8_t *aExtPanId);
     void SetThreadVersion(uint16_t aThreadVersion);
     void HandleThreadState(bool aStarted);
     void HandlePSKc(const uint8_t *aPSKc);
+    void HandleNetworkState(uint32_t aChanged, const Ncp::NetworkState &aState);
 
-    static void HandlePSKc(void *aContext, int aEvent, va_list aArguments);
-    static void HandleThreadState(void *aContext, int aEvent, va_list aArguments);
-    static void HandleNetworkName(void *aContext, int aEvent, va_list aArguments);
-    static void HandleExtPanId(void *aContext, int aEvent, va_list aArguments);
-    static void HandleThreadVersion(void *aContext, int aEvent, va_list aArguments);
+    static void HandlePSKc(void *aContext, const uint8_t *aPSKc);
+    static void HandleThreadState(void *aContext, bool aStarted);
+    static void HandleNetworkName(void *aContext, const char *aNetworkName);
+    static void HandleExtPanId(void *aContext, const uint8_t *aExtPanId);
+    static void HandleThreadVersion(void *aContext, uint16_t aThreadVersion);
+    static void HandleNetworkState(void *aContext, uint32_t aChanged, const Ncp::NetworkState &aState);
+    static void HandlePublishTimer(Timer &aTimer, void *aContext);
+    static void HandleCachedServiceTimer(Timer &aTimer, void *aContext);
 
     Mdns::Publisher *mPublisher;
+    Mdns::TxtRecord  mTxtRecord; ///< The TXT record of the border agent service, updated as the fields change.
     Ncp::Controller *mNcp;
 
     uint8_t  mExtPanId[kSizeExtPanId];
@@ -141,6 +186,18 @@ private:
     char     mNetworkName[kSizeNetworkName + 1];
     bool     mThreadStarted;
     bool     mPSKcInitialized;
+
+    Mdns::TxtRecord mPublishedTxtRecord;                  ///< The TXT record last handed to the publisher.
+    char            mPublishedName[kSizeNetworkName + 1]; ///< The instance name last published, empty if none.
+    Timer           mPublishTimer;                        ///< Fires when the publish hold-down expires.
+    unsigned long   mLastPublishTime;                     ///< The time of the last publication.
+    PublishReason   mPendingReason;                       ///< The reason of the update being held down.
+    PublishCounters mPublishCounters;
+
+    char            mCachedName[kSizeNetworkName + 1]; ///< The instance name of the service loaded from the cache.
+    Mdns::TxtRecord mCachedTxtRecord;                  ///< The TXT record of the service loaded from the cache.
+    bool            mCachedServiceStale;               ///< Whether the cached service awaits the NCP's values.
+    Timer           mCachedServiceTimer;               ///< Fires when the cached service is withdrawn.
 };
 
 /**
@@ -28,26 +28,43 @@
 
 #include <openthread-br/config.h>
 
-#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <limits.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
-#include <openthread/logging.h>
-
 #include "agent/agent_instance.hpp"
 #include "agent/ncp.hpp"
 #include "common/code_utils.hpp"
+#include "common/flight_recorder.hpp"
+#if OTBR_ENABLE_HOT_RESTART
+#include "common/hot_restart.hpp"
+#endif
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/thread_policy.hpp"
+#include "common/time.hpp"
+#include "common/timer.hpp"
 #include "common/types.hpp"
+#if OTBR_ENABLE_EPOLL
+#include "common/reactor.hpp"
+#endif
 
 #include "agent/ncp_openthread.hpp"
+#if OTBR_ENABLE_SYSTEMD_WATCHDOG
+#include "agent/watchdog.hpp"
+#endif
 #if OTBR_ENABLE_DBUS_SERVER
 #include "dbus/server/dbus_agent.hpp"
 using otbr::DBus::DBusAgent;
@@ -55,50 +72,508 @@ using otbr::DBus::DBusAgent;
 using otbr::Ncp::ControllerOpenThread;
 
 #if OTBR_ENABLE_OPENWRT
-extern void       UbusUpdateFdSet(fd_set &aReadFdSet, int &aMaxFd);
-extern void       UbusProcess(const fd_set &aReadFdSet);
-extern void       UbusServerRun(void);
-extern void       UbusServerInit(otbr::Ncp::ControllerOpenThread *aController, std::mutex *aNcpThreadMutex);
-static std::mutex sThreadMutex;
+extern void UbusServerRun(void);
+extern void UbusServerInit(otbr::Ncp::ControllerOpenThread *aController);
 #endif
 
 static const char kSyslogIdent[]          = "otbr-agent";
 static const char kDefaultInterfaceName[] = "wpan0";
 
-// Default poll timeout.
-static const struct timeval kPollTimeout = {10, 0};
-static const struct option  kOptions[]   = {{"debug-level", required_argument, NULL, 'd'},
+// Poll timeout when no module has a deadline, the main loop only wakes up for real events.
+static const struct timeval kPollTimeout = {INT_MAX, 0};
+static const struct option  kOptions[]   = {{"binary-log", required_argument, NULL, 'B'},
+                                         {"config", required_argument, NULL, 'C'},
+                                         {"debug-level", required_argument, NULL, 'd'},
+                                         {"dbus-peer-address", required_argument, NULL, 'P'},
                                          {"help", no_argument, NULL, 'h'},
+                                         {"hot-restart", no_argument, NULL, 'R'},
+                                         {"journal", no_argument, NULL, 'J'},
+                                         {"circular-log", required_argument, NULL, 'L'},
+                                         {"sched", required_argument, NULL, 'S'},
                                          {"thread-ifname", required_argument, NULL, 'I'},
                                          {"verbose", no_argument, NULL, 'v'},
                                          {"version", no_argument, NULL, 'V'},
                                          {0, 0, 0, 0}};
 
+#ifndef OTBR_CONFIG_FLIGHT_RECORDER_DUMP_FILE
+/**
+ * The file the flight recorder is written to on SIGUSR1.
+ *
+ */
+#define OTBR_CONFIG_FLIGHT_RECORDER_DUMP_FILE "/tmp/otbr-agent-flight-records.txt"
+#endif
+
+#ifndef OTBR_CONFIG_HOT_RESTART_SOCKET_PREFIX
+/**
+ * The prefix of the socket a new agent takes over from the running one with, followed by the interface name.
+ *
+ */
+#define OTBR_CONFIG_HOT_RESTART_SOCKET_PREFIX "/run/otbr-agent-"
+#endif
+
+#ifndef OTBR_CONFIG_HOT_RESTART_TIMEOUT
+/**
+ * The time in milliseconds a new agent waits for the running one to hand over and exit.
+ *
+ */
+#define OTBR_CONFIG_HOT_RESTART_TIMEOUT 10000
+#endif
+
+/**
+ * This structure represents the options of otbr-agent, from the command line or the configuration file.
+ *
+ */
+struct AgentOptions
+{
+    std::string              mInterfaceName;  ///< The Thread interface name.
+    std::string              mRadioDevice;    ///< The radio device, empty if not given.
+    std::string              mRadioConfig;    ///< The radio device parameters.
+    std::string              mConfigFile;     ///< The configuration file re-read on SIGHUP, empty if none.
+    std::string              mBinaryLog;      ///< The binary log file, empty if none.
+    std::string              mCircularLog;    ///< The circular log file, empty if none.
+    std::string              mPeerAddress;    ///< The D-Bus peer-to-peer address, empty if none.
+    std::vector<std::string> mLogLevels;      ///< The log level arguments, in order.
+    std::vector<std::string> mThreadPolicies; ///< The thread policy arguments, in order.
+    bool                     mJournal;        ///< Whether to log to the journal.
+    bool                     mVerbose;        ///< Whether to print logs on stderr.
+    bool                     mHotRestart;     ///< Whether to take over from the running agent.
+    bool                     mHelp;           ///< Whether the help is requested.
+    bool                     mVersion;        ///< Whether the version is requested.
+};
+
+static volatile sig_atomic_t sFlightRecordsRequested = 0;
+static volatile sig_atomic_t sReloadRequested        = 0;
+
+// The signal handlers write to this pipe, its read end is polled so that a signal always wakes up the main loop.
+static volatile int sSignalPipe[2] = {-1, -1};
+
+// The options in effect, the strings are referenced by the modules and never change once the agent started.
+static AgentOptions sOptions;
+static int          sDefaultLogLevel;
+
+#if OTBR_ENABLE_HOT_RESTART
+// Destroyed after the agent instance, a new agent taking over proceeds once the radio is released.
+static otbr::HotRestart sHotRestart;
+static const char       kFlightRecordsName[] = "flight-records";
+#endif
+
 static void HandleSignal(int aSignal)
 {
     signal(aSignal, SIG_DFL);
 }
 
-static int Mainloop(otbr::AgentInstance &aInstance, const char *aInterfaceName)
+static void WakeUpMainloop(void)
+{
+    int     savedErrno = errno;
+    int     fd         = sSignalPipe[1];
+    char    byte       = 0;
+    ssize_t rval;
+
+    // The pipe is non-blocking, a full pipe wakes up the main loop already.
+    if (fd >= 0)
+    {
+        rval = write(fd, &byte, sizeof(byte));
+        (void)rval;
+    }
+
+    errno = savedErrno;
+}
+
+static void HandleFlightRecordsSignal(int aSignal)
+{
+    (void)aSignal;
+    sFlightRecordsRequested = 1;
+    WakeUpMainloop();
+}
+
+static void HandleReloadSignal(int aSignal)
+{
+    (void)aSignal;
+    sReloadRequested = 1;
+    WakeUpMainloop();
+}
+
+static otbrError OpenSignalPipe(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    int       fds[2];
+
+    VerifyOrExit(pipe2(fds, O_CLOEXEC | O_NONBLOCK) == 0, error = OTBR_ERROR_ERRNO);
+    sSignalPipe[0] = fds[0];
+    sSignalPipe[1] = fds[1];
+
+exit:
+    return error;
+}
+
+static void CloseSignalPipe(void)
+{
+    int readFd  = sSignalPipe[0];
+    int writeFd = sSignalPipe[1];
+
+    // The handlers stop writing before the number can be reused.
+    sSignalPipe[0] = -1;
+    sSignalPipe[1] = -1;
+
+    if (readFd >= 0)
+    {
+        close(readFd);
+        close(writeFd);
+    }
+}
+
+static bool ParseOptions(int aArgc, char *aArgv[], AgentOptions &aOptions)
+{
+    int  opt;
+    bool valid = false;
+
+    aOptions.mInterfaceName = kDefaultInterfaceName;
+    aOptions.mJournal       = false;
+    aOptions.mVerbose       = false;
+    aOptions.mHotRestart    = false;
+    aOptions.mHelp          = false;
+    aOptions.mVersion       = false;
+
+    // Restarts the scanning, the configuration file is parsed again on each reload.
+    optind = 0;
+
+    while ((opt = getopt_long(aArgc, aArgv, "B:C:d:hI:JL:P:RS:Vv", kOptions, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'B':
+            aOptions.mBinaryLog = optarg;
+            break;
+
+        case 'C':
+            aOptions.mConfigFile = optarg;
+            break;
+
+        case 'd':
+            // Either the default log level, or the log level of a module such as "mdns=7".
+            aOptions.mLogLevels.push_back(optarg);
+            break;
+
+        case 'I':
+            aOptions.mInterfaceName = optarg;
+            break;
+
+        case 'J':
+            aOptions.mJournal = true;
+            break;
+
+        case 'L':
+            aOptions.mCircularLog = optarg;
+            break;
+
+        case 'P':
+            aOptions.mPeerAddress = optarg;
+            break;
+
+        case 'R':
+            aOptions.mHotRestart = true;
+            break;
+
+        case 'S':
+            aOptions.mThreadPolicies.push_back(optarg);
+            break;
+
+        case 'v':
+            aOptions.mVerbose = true;
+            break;
+
+        case 'V':
+            aOptions.mVersion = true;
+            break;
+
+        case 'h':
+            aOptions.mHelp = true;
+            break;
+
+        default:
+            ExitNow();
+            break;
+        }
+    }
+
+    if (optind + 1 < aArgc)
+    {
+        aOptions.mRadioDevice = aArgv[optind];
+        aOptions.mRadioConfig = aArgv[optind + 1];
+    }
+
+    valid = true;
+
+exit:
+    return valid;
+}
+
+static bool ApplyLogLevels(const std::vector<std::string> &aLogLevels)
+{
+    int  levels[OTBR_LOG_MODULE_NUM];
+    bool valid = true;
+
+    for (int module = 0; module < OTBR_LOG_MODULE_NUM; module++)
+    {
+        levels[module] = otbrLogGetModuleLevel(static_cast<otbrLogModule>(module));
+    }
+
+    // The levels not given fall back to their defaults, as if the agent had been started with the arguments.
+    for (int module = 0; module < OTBR_LOG_MODULE_NUM; module++)
+    {
+        otbrLogSetModuleLevel(static_cast<otbrLogModule>(module),
+                              module == OTBR_LOG_MODULE_DEFAULT ? sDefaultLogLevel : OTBR_LOG_INHERIT);
+    }
+
+    for (const std::string &logLevel : aLogLevels)
+    {
+        VerifyOrExit(otbrLogParseLevel(logLevel.c_str()), valid = false);
+    }
+
+exit:
+    if (!valid)
+    {
+        for (int module = 0; module < OTBR_LOG_MODULE_NUM; module++)
+        {
+            otbrLogSetModuleLevel(static_cast<otbrLogModule>(module), levels[module]);
+        }
+    }
+
+    return valid;
+}
+
+/**
+ * This function reads the options from a configuration file in the format of otbr-agent.default.
+ *
+ * The options are the value of the last OTBR_AGENT_OPTS assignment, unquoted and split on whitespace like systemd
+ * does for $OTBR_AGENT_OPTS.
+ *
+ */
+static bool ReadConfigFile(const char *aFilename, AgentOptions &aOptions)
+{
+    static const char kAssignment[] = "OTBR_AGENT_OPTS=";
+
+    std::ifstream            file(aFilename);
+    std::string              line;
+    std::string              value;
+    std::vector<std::string> args;
+    std::vector<char *>      argv;
+    bool                     found = false;
+    bool                     valid = false;
+
+    VerifyOrExit(file.is_open());
+
+    while (std::getline(file, line))
+    {
+        size_t start = line.find_first_not_of(" \t");
+
+        if (start == std::string::npos || line.compare(start, sizeof(kAssignment) - 1, kAssignment) != 0)
+        {
+            continue;
+        }
+
+        value = line.substr(start + sizeof(kAssignment) - 1);
+        value = value.substr(0, value.find_last_not_of(" \t\r") + 1);
+        if (value.size() >= 2 && (value[0] == '"' || value[0] == '\'') && value.back() == value[0])
+        {
+            value = value.substr(1, value.size() - 2);
+        }
+        found = true;
+    }
+
+    VerifyOrExit(found, errno = ENOENT);
+
+    {
+        std::istringstream stream(value);
+        std::string        arg;
+
+        args.push_back(kSyslogIdent);
+        while (stream >> arg)
+        {
+            args.push_back(arg);
+        }
+    }
+
+    for (std::string &arg : args)
+    {
+        argv.push_back(&arg[0]);
+    }
+    argv.push_back(NULL);
+
+    VerifyOrExit(ParseOptions(static_cast<int>(args.size()), argv.data(), aOptions), errno = EINVAL);
+    valid = true;
+
+exit:
+    return valid;
+}
+
+static void WarnRestartRequired(bool aChanged, const char *aOption)
+{
+    if (aChanged)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Reload: %s changed, it takes effect on restart", aOption);
+    }
+}
+
+/**
+ * This function applies the changes of the configuration file to the running agent.
+ *
+ * The log levels and the journal are changed in place, the Thread network, the radio and the D-Bus connection are
+ * left as they are. The options which can't be changed without a restart are reported.
+ *
+ */
+static void ReloadOptions(void)
+{
+    AgentOptions options;
+
+    VerifyOrExit(!sOptions.mConfigFile.empty(), otbrLog(OTBR_LOG_WARNING, "Reload: no configuration file, see -C"));
+    VerifyOrExit(ReadConfigFile(sOptions.mConfigFile.c_str(), options),
+                 otbrLog(OTBR_LOG_WARNING, "Reload: failed to read %s: %s", sOptions.mConfigFile.c_str(),
+                         strerror(errno)));
+
+    otbrLog(OTBR_LOG_NOTICE, "Reloading %s", sOptions.mConfigFile.c_str());
+
+    WarnRestartRequired(options.mInterfaceName != sOptions.mInterfaceName, "thread-ifname");
+    WarnRestartRequired(options.mRadioDevice != sOptions.mRadioDevice || options.mRadioConfig != sOptions.mRadioConfig,
+                        "radio device");
+    WarnRestartRequired(options.mBinaryLog != sOptions.mBinaryLog, "binary-log");
+    WarnRestartRequired(options.mCircularLog != sOptions.mCircularLog, "circular-log");
+    WarnRestartRequired(options.mPeerAddress != sOptions.mPeerAddress, "dbus-peer-address");
+    WarnRestartRequired(options.mThreadPolicies != sOptions.mThreadPolicies, "sched");
+    WarnRestartRequired(options.mVerbose != sOptions.mVerbose, "verbose");
+
+    if (options.mLogLevels != sOptions.mLogLevels)
+    {
+        if (ApplyLogLevels(options.mLogLevels))
+        {
+            sOptions.mLogLevels = options.mLogLevels;
+            otbrLog(OTBR_LOG_NOTICE, "Reload: log levels updated");
+
+            if (ControllerOpenThread::UpdateLogLevel() != OT_ERROR_NONE)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Reload: failed to update the OpenThread log level");
+            }
+        }
+        else
+        {
+            otbrLog(OTBR_LOG_WARNING, "Reload: invalid debug-level, log levels unchanged");
+        }
+    }
+
+    if (options.mJournal != sOptions.mJournal)
+    {
+        if (otbrLogEnableJournal(options.mJournal) == OTBR_ERROR_NONE)
+        {
+            sOptions.mJournal = options.mJournal;
+            otbrLog(OTBR_LOG_NOTICE, "Reload: journal %s", options.mJournal ? "enabled" : "disabled");
+        }
+        else
+        {
+            otbrLog(OTBR_LOG_WARNING, "Reload: failed to change the journal: %s", strerror(errno));
+        }
+    }
+
+exit:
+    return;
+}
+
+static void WriteFlightRecords(void)
+{
+    FILE *file = fopen(OTBR_CONFIG_FLIGHT_RECORDER_DUMP_FILE, "w");
+
+    VerifyOrExit(file != NULL, otbrLog(OTBR_LOG_WARNING, "Failed to open %s: %s",
+                                       OTBR_CONFIG_FLIGHT_RECORDER_DUMP_FILE, strerror(errno)));
+    otbr::DumpFlightRecords(file);
+    fclose(file);
+    otbrLog(OTBR_LOG_NOTICE, "Flight records written to %s", OTBR_CONFIG_FLIGHT_RECORDER_DUMP_FILE);
+
+exit:
+    return;
+}
+
+#if OTBR_ENABLE_HOT_RESTART
+static std::string GetHotRestartPath(void)
+{
+    return OTBR_CONFIG_HOT_RESTART_SOCKET_PREFIX + sOptions.mInterfaceName + ".sock";
+}
+
+static void SaveHotRestartState(otbr::AgentInstance &aInstance, otbr::HotRestartSnapshot &aSnapshot)
+{
+    std::string flightRecords;
+
+    aInstance.SaveState(aSnapshot);
+    otbr::SaveFlightRecords(flightRecords);
+    aSnapshot.SetValue(kFlightRecordsName, flightRecords);
+}
+
+// Returns whether the running agent handed its state over and exited, the radio is then kept as it is.
+static bool TakeOver(otbr::HotRestartSnapshot &aSnapshot)
+{
+    std::string path = GetHotRestartPath();
+    std::string flightRecords;
+    bool        tookOver = false;
+
+    otbrLog(OTBR_LOG_NOTICE, "Taking over from the agent listening on %s", path.c_str());
+    VerifyOrExit(otbr::HotRestart::Request(path, aSnapshot, OTBR_CONFIG_HOT_RESTART_TIMEOUT) == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_WARNING, "Failed to take over, starting afresh: %s", strerror(errno)));
+    tookOver = true;
+
+    if (aSnapshot.GetValue(kFlightRecordsName, flightRecords) && !otbr::RestoreFlightRecords(flightRecords))
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to restore some flight records");
+    }
+
+exit:
+    return tookOver;
+}
+#endif // OTBR_ENABLE_HOT_RESTART
+
+#if OTBR_ENABLE_DBUS_SERVER
+static int Mainloop(otbr::AgentInstance &aInstance, DBusAgent &aDBusAgent)
+#else
+static int Mainloop(otbr::AgentInstance &aInstance)
+#endif
 {
     int error = EXIT_FAILURE;
+#if OTBR_ENABLE_EPOLL
+    otbr::Reactor reactor;
+#endif
 #if OTBR_ENABLE_DBUS_SERVER
-    ControllerOpenThread *     ncpOpenThread = reinterpret_cast<ControllerOpenThread *>(&aInstance.GetNcp());
-    std::unique_ptr<DBusAgent> dbusAgent     = std::unique_ptr<DBusAgent>(new DBusAgent(aInterfaceName, ncpOpenThread));
+    ControllerOpenThread *ncpOpenThread = reinterpret_cast<ControllerOpenThread *>(&aInstance.GetNcp());
 
-    dbusAgent->Init();
-#else
-    (void)aInterfaceName;
+    aDBusAgent.Init();
+#endif
+#if OTBR_ENABLE_SYSTEMD_WATCHDOG
+    otbr::Watchdog watchdog(*reinterpret_cast<ControllerOpenThread *>(&aInstance.GetNcp()));
+
+    watchdog.Init();
+#endif
+#if OTBR_ENABLE_EPOLL
+    VerifyOrExit(reactor.Init() == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_ERR, "Failed to create epoll reactor: %s", strerror(errno)));
+#endif
+    VerifyOrExit(OpenSignalPipe() == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_ERR, "Failed to create signal pipe: %s", strerror(errno)));
+#if OTBR_ENABLE_HOT_RESTART
+    // A new agent can still start afresh, after this one stopped on SIGTERM.
+    sHotRestart.Listen(GetHotRestartPath(), [&aInstance](otbr::HotRestartSnapshot &aSnapshot) {
+        SaveHotRestartState(aInstance, aSnapshot);
+    });
 #endif
     otbrLog(OTBR_LOG_INFO, "Border router agent started.");
+    otbr::LogStartupMilestone("Main loop started");
 
     // allow quitting elegantly
     signal(SIGTERM, HandleSignal);
+    signal(SIGUSR1, HandleFlightRecordsSignal);
+    signal(SIGHUP, HandleReloadSignal);
 
     while (true)
     {
-        otSysMainloopContext mainloop;
-        int                  rval;
+        otSysMainloopContext    mainloop;
+        otbr::MainloopCounters &counters = otbr::GetMainloopCounters();
+        uint64_t                wakeup;
+        int                     rval;
 
         mainloop.mMaxFd   = -1;
         mainloop.mTimeout = kPollTimeout;
@@ -107,20 +582,76 @@ static int Mainloop(otbr::AgentInstance &aInstance, const char *aInterfaceName)
         FD_ZERO(&mainloop.mWriteFdSet);
         FD_ZERO(&mainloop.mErrorFdSet);
 
-        aInstance.UpdateFdSet(mainloop);
+        FD_SET(sSignalPipe[0], &mainloop.mReadFdSet);
+        mainloop.mMaxFd = sSignalPipe[0];
 
-#if OTBR_ENABLE_DBUS_SERVER
-        dbusAgent->UpdateFdSet(mainloop.mReadFdSet, mainloop.mWriteFdSet, mainloop.mErrorFdSet, mainloop.mMaxFd,
-                               mainloop.mTimeout);
+        {
+            otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageAgentUpdateFdSet);
+
+            aInstance.UpdateFdSet(mainloop);
+#if OTBR_ENABLE_HOT_RESTART
+            sHotRestart.UpdateFdSet(mainloop.mReadFdSet, mainloop.mMaxFd);
 #endif
+        }
 
-#if OTBR_ENABLE_OPENWRT
-        UbusUpdateFdSet(mainloop.mReadFdSet, mainloop.mMaxFd);
-        sThreadMutex.unlock();
+#if OTBR_ENABLE_DBUS_SERVER
+        {
+            otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageDBusUpdateFdSet);
+
+            aDBusAgent.UpdateFdSet(mainloop.mReadFdSet, mainloop.mWriteFdSet, mainloop.mErrorFdSet, mainloop.mMaxFd,
+                                   mainloop.mTimeout);
+        }
 #endif
 
+        otbr::TimerScheduler::Get().UpdateTimeout(otbr::GetNow(), mainloop.mTimeout);
+
+        if (mainloop.mTimeout.tv_sec == 0 && mainloop.mTimeout.tv_usec == 0)
+        {
+            ++counters.mZeroTimeoutPolls;
+        }
+
+#if OTBR_ENABLE_EPOLL
+        rval = reactor.Poll(mainloop.mReadFdSet, mainloop.mWriteFdSet, mainloop.mErrorFdSet, mainloop.mMaxFd,
+                            mainloop.mTimeout);
+#else
         rval = select(mainloop.mMaxFd + 1, &mainloop.mReadFdSet, &mainloop.mWriteFdSet, &mainloop.mErrorFdSet,
                       &mainloop.mTimeout);
+#endif
+        wakeup = otbr::GetMainloopClock();
+        otbr::UpdateMainloopNow();
+
+        // SIGUSR1 and SIGHUP interrupt the poll, or wake it up through the signal pipe when they arrive before it.
+        // Unlike SIGTERM they don't end the main loop.
+        if (rval > 0 && FD_ISSET(sSignalPipe[0], &mainloop.mReadFdSet))
+        {
+            char buffer[16];
+
+            while (read(sSignalPipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+        }
+
+        if (sFlightRecordsRequested || sReloadRequested)
+        {
+            bool interrupted = (rval < 0 && errno == EINTR);
+
+            if (sFlightRecordsRequested)
+            {
+                sFlightRecordsRequested = 0;
+                WriteFlightRecords();
+            }
+
+            if (sReloadRequested)
+            {
+                sReloadRequested = 0;
+                ReloadOptions();
+            }
+
+            if (interrupted)
+            {
+                continue;
+            }
+        }
 
 #if OTBR_ENABLE_DBUS_SERVER
         if (ncpOpenThread->IsResetRequested())
@@ -132,33 +663,69 @@ static int Mainloop(otbr::AgentInstance &aInstance, const char *aInterfaceName)
 
         if (rval >= 0)
         {
-#if OTBR_ENABLE_OPENWRT
-            sThreadMutex.lock();
-            UbusProcess(mainloop.mReadFdSet);
+            uint32_t fired;
+
+            ++counters.mWakeups;
+
+            {
+                otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageTimers);
+
+                fired = otbr::TimerScheduler::Get().Process(otbr::GetMainloopNow());
+            }
+
+            if (fired == 0 && rval == 0)
+            {
+                ++counters.mSpuriousWakeups;
+            }
+
+            otbr::RecordMainloopStage(otbr::kMainloopStageDispatchLatency, wakeup);
+
+            {
+                otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageAgentProcess);
+
+                aInstance.Process(mainloop);
+#if OTBR_ENABLE_HOT_RESTART
+                sHotRestart.Process(mainloop.mReadFdSet);
+#endif
+            }
+
+#if OTBR_ENABLE_HOT_RESTART
+            // The new agent waits for this one to exit, the D-Bus requests left are answered by the new one.
+            if (sHotRestart.IsHandedOver())
+            {
+                error = EXIT_SUCCESS;
+                break;
+            }
 #endif
-            aInstance.Process(mainloop);
 
 #if OTBR_ENABLE_DBUS_SERVER
-            dbusAgent->Process(mainloop.mReadFdSet, mainloop.mWriteFdSet, mainloop.mErrorFdSet);
+            {
+                otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageDBusProcess);
+
+                aDBusAgent.Process(mainloop.mReadFdSet, mainloop.mWriteFdSet, mainloop.mErrorFdSet);
+            }
 #endif
         }
         else
         {
-#if OTBR_ENABLE_OPENWRT
-            sThreadMutex.lock();
-#endif
             error = OTBR_ERROR_ERRNO;
-            otbrLog(OTBR_LOG_ERR, "select() failed", strerror(errno));
+            otbrLog(OTBR_LOG_ERR, "Mainloop poll failed: %s", strerror(errno));
             break;
         }
     }
 
+exit:
+    CloseSignalPipe();
     return error;
 }
 
 static void PrintHelp(const char *aProgramName)
 {
-    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v] [RADIO_DEVICE] [RADIO_CONFIG]\n", aProgramName);
+    fprintf(stderr,
+            "Usage: %s [-I interfaceName] [-d [MODULE=]DEBUG_LEVEL]... [-B BINARY_LOG] [-L CIRCULAR_LOG] [-J] "
+            "[-P DBUS_PEER_ADDRESS] [-S CLASS=[POLICY[:PRIORITY]][@CPUS]]... [-C CONFIG_FILE] [-R] [-v] "
+            "[RADIO_DEVICE] [RADIO_CONFIG]\n",
+            aProgramName);
 }
 
 static void PrintVersion(void)
@@ -174,96 +741,121 @@ static void OnAllocateFailed(void)
 
 int main(int argc, char *argv[])
 {
-    int                    logLevel = OTBR_LOG_INFO;
-    int                    opt;
-    int                    ret           = EXIT_SUCCESS;
-    const char *           interfaceName = kDefaultInterfaceName;
-    otbr::Ncp::Controller *ncp           = NULL;
-    bool                   verbose       = false;
+    int                    ret = EXIT_SUCCESS;
+    otbr::Ncp::Controller *ncp = NULL;
+    const char *           interfaceName;
+#if OTBR_ENABLE_HOT_RESTART
+    otbr::HotRestartSnapshot snapshot;
+#endif
 
     std::set_new_handler(OnAllocateFailed);
 
-    while ((opt = getopt_long(argc, argv, "d:hI:Vv", kOptions, NULL)) != -1)
+    sDefaultLogLevel = otbrLogGetLevel();
+    VerifyOrExit(ParseOptions(argc, argv, sOptions), PrintHelp(argv[0]), ret = EXIT_FAILURE);
+
+    if (sOptions.mVersion)
     {
-        switch (opt)
-        {
-        case 'd':
-            logLevel = atoi(optarg);
-            VerifyOrExit(logLevel >= OTBR_LOG_EMERG && logLevel <= OTBR_LOG_DEBUG, ret = EXIT_FAILURE);
-            break;
+        PrintVersion();
+        ExitNow();
+    }
 
-        case 'I':
-            interfaceName = optarg;
-            break;
+    if (sOptions.mHelp)
+    {
+        PrintHelp(argv[0]);
+        ExitNow(ret = EXIT_SUCCESS);
+    }
 
-        case 'v':
-            verbose = true;
-            break;
+    VerifyOrExit(ApplyLogLevels(sOptions.mLogLevels), ret = EXIT_FAILURE);
+    for (const std::string &threadPolicy : sOptions.mThreadPolicies)
+    {
+        VerifyOrExit(otbr::ParseThreadPolicy(threadPolicy.c_str()), ret = EXIT_FAILURE);
+    }
 
-        case 'V':
-            PrintVersion();
-            ExitNow();
-            break;
+    VerifyOrExit(!sOptions.mRadioDevice.empty(), ret = EXIT_FAILURE);
+    interfaceName = sOptions.mInterfaceName.c_str();
+    ncp = otbr::Ncp::Controller::Create(interfaceName, &sOptions.mRadioDevice[0], &sOptions.mRadioConfig[0]);
+    VerifyOrExit(ncp != NULL, ret = EXIT_FAILURE);
 
-        case 'h':
-            PrintHelp(argv[0]);
-            ExitNow(ret = EXIT_SUCCESS);
-            break;
-        default:
-            PrintHelp(argv[0]);
-            ExitNow(ret = EXIT_FAILURE);
-            break;
-        }
+    otbrLogInit(kSyslogIdent, otbrLogGetLevel(), sOptions.mVerbose);
+    otbrLogSetInterface(interfaceName);
+
+    // The threads started from now on inherit the policy of the main thread, unless their class has its own.
+    otbr::ApplyThreadPolicy(otbr::kThreadClassMain);
+#if !OTBR_ENABLE_NCP_THREAD
+    // Without a radio thread, the spinel path runs in the main loop.
+    otbr::ApplyThreadPolicy(otbr::kThreadClassRadio);
+#endif
+
+    if (sOptions.mJournal && otbrLogEnableJournal(true) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to log to the journal: %s", strerror(errno));
+        sOptions.mJournal = false;
     }
 
-    VerifyOrExit(optind + 1 < argc, ret = EXIT_FAILURE);
-    ncp = otbr::Ncp::Controller::Create(interfaceName, argv[optind], argv[optind + 1]);
-    VerifyOrExit(ncp != NULL, ret = EXIT_FAILURE);
+    if (!sOptions.mBinaryLog.empty() && otbrLogSetBinaryFilename(sOptions.mBinaryLog.c_str()) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to create binary log %s: %s", sOptions.mBinaryLog.c_str(), strerror(errno));
+    }
 
-    otbrLogInit(kSyslogIdent, logLevel, verbose);
+    if (!sOptions.mCircularLog.empty() &&
+        otbrLogSetCircularFilename(sOptions.mCircularLog.c_str()) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to create circular log %s: %s", sOptions.mCircularLog.c_str(),
+                strerror(errno));
+    }
 
     otbrLog(OTBR_LOG_INFO, "Thread interface %s", interfaceName);
 
+#if OTBR_ENABLE_HOT_RESTART
+    if (sOptions.mHotRestart && TakeOver(snapshot))
     {
-        otbr::AgentInstance instance(ncp);
-        otLogLevel          level;
+        reinterpret_cast<ControllerOpenThread *>(ncp)->KeepRadioState();
+    }
+#else
+    if (sOptions.mHotRestart)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Hot restart is not supported by this build, starting afresh");
+    }
+#endif
 
-        SuccessOrExit(ret = instance.Init());
+    {
+        otbr::AgentInstance instance(ncp);
+#if OTBR_ENABLE_DBUS_SERVER
+        DBusAgent dbusAgent(interfaceName, reinterpret_cast<ControllerOpenThread *>(ncp));
 
-        switch (logLevel)
+        if (!sOptions.mPeerAddress.empty())
         {
-        case OTBR_LOG_EMERG:
-        case OTBR_LOG_ALERT:
-        case OTBR_LOG_CRIT:
-            level = OT_LOG_LEVEL_CRIT;
-            break;
-        case OTBR_LOG_ERR:
-        case OTBR_LOG_WARNING:
-            level = OT_LOG_LEVEL_WARN;
-            break;
-        case OTBR_LOG_NOTICE:
-            level = OT_LOG_LEVEL_NOTE;
-            break;
-        case OTBR_LOG_INFO:
-            level = OT_LOG_LEVEL_INFO;
-            break;
-        case OTBR_LOG_DEBUG:
-            level = OT_LOG_LEVEL_DEBG;
-            break;
-        default:
-            ExitNow(ret = EXIT_FAILURE);
-            break;
+            dbusAgent.SetPeerAddress(sOptions.mPeerAddress.c_str());
         }
 
-        VerifyOrExit(otLoggingSetLevel(level) == OT_ERROR_NONE, ret = EXIT_FAILURE);
+        // The bus connection doesn't depend on the RCP, it is set up while the RCP is brought up.
+        std::thread dbusConnect([&dbusAgent]() { dbusAgent.Connect(); });
+#endif
+
+        otbr::LogStartupMilestone("Agent starting");
+#if OTBR_ENABLE_HOT_RESTART
+        instance.RestoreState(snapshot);
+        snapshot.Clear();
+#endif
+        ret = instance.Init();
+#if OTBR_ENABLE_DBUS_SERVER
+        dbusConnect.join();
+#endif
+        SuccessOrExit(ret);
+
+        VerifyOrExit(ControllerOpenThread::UpdateLogLevel() == OT_ERROR_NONE, ret = EXIT_FAILURE);
 
 #if OTBR_ENABLE_OPENWRT
         ControllerOpenThread *ncpThread = reinterpret_cast<ControllerOpenThread *>(ncp);
 
-        UbusServerInit(ncpThread, &sThreadMutex);
+        UbusServerInit(ncpThread);
         std::thread(UbusServerRun).detach();
 #endif
-        SuccessOrExit(ret = Mainloop(instance, interfaceName));
+#if OTBR_ENABLE_DBUS_SERVER
+        SuccessOrExit(ret = Mainloop(instance, dbusAgent));
+#else
+        SuccessOrExit(ret = Mainloop(instance));
+#endif
     }
 
     otbrLogDeinit();
@@ -68,13 +68,57 @@ enum
     kEventThreadState,      ///< Thread State.
     kEventThreadVersion,    ///< Thread Version.
     kEventUdpForwardStream, ///< UDP forward stream arrived.
+    kEventNetworkState,     ///< Network state changed, delivered once per coalescing window.
 };
 
+/**
+ * This enumeration defines the bits of the changed mask of kEventNetworkState.
+ *
+ */
+enum
+{
+    kChangedNetworkName = 1 << 0, ///< The network name changed.
+    kChangedExtPanId    = 1 << 1, ///< The extended PAN ID changed.
+    kChangedThreadState = 1 << 2, ///< The attached state may have changed.
+};
+
+/**
+ * This structure represents a consolidated snapshot of the network state.
+ *
+ */
+struct NetworkState
+{
+    const char *   mNetworkName; ///< The network name.
+    const uint8_t *mExtPanId;    ///< The extended PAN ID.
+    bool           mAttached;    ///< Whether Thread is attached.
+};
+
+/**
+ * This type defines the signatures of the NCP events, in the order of the event ids.
+ *
+ * - kEventExtPanId: the extended PAN ID.
+ * - kEventNetworkName: the network name.
+ * - kEventPSKc: the PSKc.
+ * - kEventThreadState: whether Thread is attached.
+ * - kEventThreadVersion: the Thread version.
+ * - kEventUdpForwardStream: the payload, its length, the peer port, the peer address and the socket port.
+ * - kEventNetworkState: the kChanged* mask and the network state snapshot.
+ *
+ */
+typedef EventEmitter<Event<const uint8_t *>,
+                     Event<const char *>,
+                     Event<const uint8_t *>,
+                     Event<bool>,
+                     Event<uint16_t>,
+                     Event<const uint8_t *, uint16_t, uint16_t, const in6_addr *, uint16_t>,
+                     Event<uint32_t, const NetworkState &>>
+    ControllerEvents;
+
 /**
  * This interface defines NCP Controller functionality.
  *
  */
-class Controller : public EventEmitter
+class Controller : public ControllerEvents
 {
 public:
     /**
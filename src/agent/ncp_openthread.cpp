@@ -26,14 +26,21 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_NCP
+
 #include "agent/ncp_openthread.hpp"
 
 #include <assert.h>
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <future>
+
 #include <openthread/cli.h>
 #include <openthread/dataset.h>
+#include <openthread/logging.h>
 #include <openthread/tasklet.h>
 #include <openthread/thread.h>
 #include <openthread/thread_ftd.h>
@@ -42,21 +49,96 @@
 #include <openthread/platform/settings.h>
 
 #include "common/code_utils.hpp"
+#include "common/flight_recorder.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/thread_policy.hpp"
+#include "common/time.hpp"
 #include "common/types.hpp"
 
-static bool sReset;
+/**
+ * The window in milliseconds in which OpenThread state changes are coalesced into a single notification.
+ *
+ * With 0 the changes reported within one main loop turn are delivered together on the next turn.
+ *
+ */
+#ifndef OTBR_CONFIG_STATE_CHANGED_COALESCE_WINDOW
+#define OTBR_CONFIG_STATE_CHANGED_COALESCE_WINDOW 0
+#endif
+
+/**
+ * The interval in milliseconds to retry resuming the Thread network after a failure.
+ *
+ */
+#ifndef OTBR_CONFIG_RESUME_NETWORK_RETRY_INTERVAL
+#define OTBR_CONFIG_RESUME_NETWORK_RETRY_INTERVAL 1000
+#endif
+
+/**
+ * The interval in milliseconds to refresh the counters on the status page, state changes are published immediately.
+ *
+ */
+#ifndef OTBR_CONFIG_STATUS_PAGE_REFRESH_INTERVAL
+#define OTBR_CONFIG_STATUS_PAGE_REFRESH_INTERVAL 1000
+#endif
+
+/**
+ * The number of frames the frame capture ring holds, for a reader to catch up with bursts of traffic.
+ *
+ */
+#ifndef OTBR_CONFIG_FRAME_CAPTURE_RECORDS
+#define OTBR_CONFIG_FRAME_CAPTURE_RECORDS 1024
+#endif
+
+/**
+ * The time budget in microseconds of a slice of background jobs, which bounds the delay they add to the radio.
+ *
+ */
+#ifndef OTBR_CONFIG_BACKGROUND_SLICE_BUDGET
+#define OTBR_CONFIG_BACKGROUND_SLICE_BUDGET 1000
+#endif
+
+static std::atomic<bool> sReset;
+static std::atomic<bool> sCreated; ///< Whether a controller exists, the platform supports only one.
 using std::chrono::duration_cast;
-using std::chrono::microseconds;
-using std::chrono::seconds;
+using std::chrono::milliseconds;
 using std::chrono::steady_clock;
 
 namespace otbr {
 namespace Ncp {
 
+// The state changes signaled after a reset, covering the state that subscribers mirror.
+static const otChangedFlags kResetChangedFlags =
+    OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_NETWORK_NAME | OT_CHANGED_THREAD_EXT_PANID | OT_CHANGED_THREAD_PANID |
+    OT_CHANGED_THREAD_CHANNEL | OT_CHANGED_THREAD_PARTITION_ID | OT_CHANGED_THREAD_NETDATA | OT_CHANGED_THREAD_ML_ADDR |
+    OT_CHANGED_MASTER_KEY;
+
+#if OTBR_ENABLE_NCP_THREAD
+// Radio thread poll timeout when neither OpenThread nor a radio poller has a deadline.
+static const struct timeval kRadioPollTimeout = {INT_MAX, 0};
+#endif
+
 ControllerOpenThread::ControllerOpenThread(const char *aInterfaceName, char *aRadioFile, char *aRadioConfig)
-    : mTriedAttach(false)
+#if OTBR_ENABLE_NCP_THREAD
+    : mRadioTimers(GetNow())
+    , mRadioThreadRunning(false)
+    , mTimerTasks(mRadioTimers)
+    , mPendingChangedFlags(0)
+    , mBackgroundJobs(OTBR_CONFIG_BACKGROUND_SLICE_BUDGET, mRadioTimers)
+#else
+    : mPendingChangedFlags(0)
+    , mBackgroundJobs(OTBR_CONFIG_BACKGROUND_SLICE_BUDGET)
+#endif
+    , mResumeNetworkTimer(HandleResumeNetworkTimer, this, GetInstanceTimers())
+#if OTBR_ENABLE_STATUS_PAGE
+    , mStatusPageTimer(HandleStatusPageTimer, this, GetInstanceTimers())
+#endif
 {
+    bool created = sCreated.exchange(true);
+
+    assert(!created);
+    OT_UNUSED_VARIABLE(created);
+
     memset(&mConfig, 0, sizeof(mConfig));
 
     mConfig.mInterfaceName = aInterfaceName;
@@ -68,16 +150,21 @@ ControllerOpenThread::ControllerOpenThread(const char *aInterfaceName, char *aRa
 
 ControllerOpenThread::~ControllerOpenThread(void)
 {
+#if OTBR_ENABLE_NCP_THREAD
+    StopRadioThread();
+#endif
     otInstanceFinalize(mInstance);
     otSysDeinit();
+    sCreated = false;
 }
 
-otbrError ControllerOpenThread::Init(void)
+otbrError ControllerOpenThread::InitInstance(void)
 {
     otbrError error = OTBR_ERROR_NONE;
 
     mInstance = otSysInit(&mConfig);
     otCliUartInit(mInstance);
+    mConfig.mResetRadio = true;
 
     {
         otError result = otSetStateChangedCallback(mInstance, &ControllerOpenThread::HandleStateChanged, this);
@@ -86,107 +173,451 @@ otbrError ControllerOpenThread::Init(void)
         VerifyOrExit(result == OT_ERROR_NONE, error = OTBR_ERROR_OPENTHREAD);
     }
 
+#if OTBR_ENABLE_FRAME_CAPTURE
+    // The frames are only copied into the ring, a reader that falls behind makes them dropped.
+    if (mFrameCapture.IsOpen())
+    {
+        otLinkSetPcapCallback(mInstance, &ControllerOpenThread::HandleFrameCapture, this);
+    }
+#endif
+
+exit:
+    return error;
+}
+
+otbrError ControllerOpenThread::Init(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+#if OTBR_ENABLE_FRAME_CAPTURE
+    {
+        std::string frameCaptureName = std::string("/otbr-agent-") + mConfig.mInterfaceName + "-frames";
+
+        if (mFrameCapture.Open(frameCaptureName.c_str(), OTBR_CONFIG_FRAME_CAPTURE_RECORDS) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to open frame capture %s: %s", frameCaptureName.c_str(),
+                    strerror(errno));
+        }
+    }
+#endif
+
+    SuccessOrExit(error = InitInstance());
+
+    // The background jobs run on the thread owning the instance, and leave it the tasklets pending.
+    mBackgroundJobs.SetYieldCheck([this]() { return otTaskletsArePending(mInstance); });
+
     mThreadHelper = std::unique_ptr<otbr::agent::ThreadHelper>(new otbr::agent::ThreadHelper(mInstance, this));
 
+    VerifyOrExit(mTasks.Init() == OTBR_ERROR_NONE, error = OTBR_ERROR_ERRNO);
+    // The network is resumed on the first processing of the instance, and only retried after a failure.
+    mTasks.Post([this]() { ResumeNetwork(); });
+#if OTBR_ENABLE_STATUS_PAGE
+    {
+        std::string statusPageName = std::string("/otbr-agent-") + mConfig.mInterfaceName;
+
+        if (mStatusPage.Open(statusPageName.c_str()) == OTBR_ERROR_NONE)
+        {
+            mTasks.Post([this]() { RefreshStatusPage(); });
+        }
+        else
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to open status page %s: %s", statusPageName.c_str(), strerror(errno));
+        }
+    }
+#endif
+#if OTBR_ENABLE_NCP_THREAD
+    VerifyOrExit(mCompletions.Init() == OTBR_ERROR_NONE, error = OTBR_ERROR_ERRNO);
+    StartRadioThread();
+#endif
+
 exit:
     return error;
 }
 
-void ControllerOpenThread::HandleStateChanged(otChangedFlags aFlags)
+void ControllerOpenThread::GetEventState(EventState &aState)
 {
+    aState.mNetworkName = otThreadGetNetworkName(mInstance);
+    aState.mExtPanId    = *otThreadGetExtendedPanId(mInstance);
+    aState.mPskc        = *otThreadGetPskc(mInstance);
+
+    switch (otThreadGetDeviceRole(mInstance))
+    {
+    case OT_DEVICE_ROLE_CHILD:
+    case OT_DEVICE_ROLE_ROUTER:
+    case OT_DEVICE_ROLE_LEADER:
+        aState.mAttached = true;
+        break;
+    default:
+        aState.mAttached = false;
+        break;
+    }
+}
+
+void ControllerOpenThread::EmitEvent(int aEvent, const EventState &aState)
+{
+    switch (aEvent)
+    {
+    case kEventExtPanId:
+        Emit<kEventExtPanId>(aState.mExtPanId.m8);
+        break;
+    case kEventThreadState:
+        Emit<kEventThreadState>(aState.mAttached);
+        break;
+    case kEventNetworkName:
+        Emit<kEventNetworkName>(aState.mNetworkName.c_str());
+        break;
+    case kEventPSKc:
+        Emit<kEventPSKc>(aState.mPskc.m8);
+        break;
+    case kEventThreadVersion:
+        Emit<kEventThreadVersion>(otThreadGetVersion());
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
+
+void ControllerOpenThread::EmitStateChanged(otChangedFlags aFlags, const EventState &aState)
+{
+    uint32_t     changed = 0;
+    NetworkState state;
+
     if (aFlags & OT_CHANGED_THREAD_NETWORK_NAME)
     {
-        EventEmitter::Emit(kEventNetworkName, otThreadGetNetworkName(mInstance));
+        changed |= kChangedNetworkName;
     }
 
     if (aFlags & OT_CHANGED_THREAD_EXT_PANID)
     {
-        EventEmitter::Emit(kEventExtPanId, otThreadGetExtendedPanId(mInstance));
+        changed |= kChangedExtPanId;
     }
 
     if (aFlags & OT_CHANGED_THREAD_ROLE)
     {
-        bool attached = false;
+        changed |= kChangedThreadState;
+    }
 
-        switch (otThreadGetDeviceRole(mInstance))
-        {
-        case OT_DEVICE_ROLE_CHILD:
-        case OT_DEVICE_ROLE_ROUTER:
-        case OT_DEVICE_ROLE_LEADER:
-            attached = true;
-            break;
-        default:
-            break;
-        }
+    VerifyOrExit(changed != 0);
 
-        EventEmitter::Emit(kEventThreadState, attached);
+    state.mNetworkName = aState.mNetworkName.c_str();
+    state.mExtPanId    = aState.mExtPanId.m8;
+    state.mAttached    = aState.mAttached;
+
+    Emit<kEventNetworkState>(changed, state);
+
+exit:
+    return;
+}
+
+void ControllerOpenThread::HandleStateChanged(otChangedFlags aFlags)
+{
+    RecordFlightEvent(kFlightEventStateChanged, 0, aFlags);
+
+    // Bursts of changes, e.g. during attach or partition merges, are delivered as one consolidated snapshot.
+    if (mPendingChangedFlags == 0 &&
+        !mTimerTasks.Post(OTBR_CONFIG_STATE_CHANGED_COALESCE_WINDOW, [this]() { FlushStateChanged(); }).IsPending())
+    {
+        // Nothing would flush the changes without a timer task, so they are delivered right away.
+        mPendingChangedFlags = aFlags;
+        FlushStateChanged();
+        ExitNow();
     }
 
-    mThreadHelper->StateChangedCallback(aFlags);
+    mPendingChangedFlags |= aFlags;
+
+exit:
+    return;
 }
 
-static struct timeval ToTimeVal(const microseconds &aTime)
+void ControllerOpenThread::FlushStateChanged(void)
 {
-    constexpr int  kUsPerSecond = 1000000;
-    struct timeval val;
+    otChangedFlags flags = mPendingChangedFlags;
+    EventState     state;
+
+    mPendingChangedFlags = 0;
+    GetEventState(state);
+
+#if OTBR_ENABLE_NCP_THREAD
+    // Event handlers belong to the main loop, they get a snapshot of the state taken on the radio thread.
+    PostToMainloop([this, flags, state]() { EmitStateChanged(flags, state); });
+#else
+    EmitStateChanged(flags, state);
+#endif
+
+    mThreadHelper->StateChangedCallback(flags);
+#if OTBR_ENABLE_STATUS_PAGE
+    UpdateStatusPage();
+#endif
+}
 
-    val.tv_sec  = aTime.count() / kUsPerSecond;
-    val.tv_usec = aTime.count() % kUsPerSecond;
+#if OTBR_ENABLE_STATUS_PAGE
+void ControllerOpenThread::UpdateStatusPage(void)
+{
+    StatusPage           status;
+    const otMacCounters *macCounters = otLinkGetCounters(mInstance);
+    const otIpCounters * ipCounters  = otThreadGetIp6Counters(mInstance);
+
+    memset(&status, 0, sizeof(status));
+    status.mUpdateTime  = GetNow();
+    status.mPartitionId = otThreadGetPartitionId(mInstance);
+    status.mRloc16      = otThreadGetRloc16(mInstance);
+    status.mPanId       = otLinkGetPanId(mInstance);
+    memcpy(status.mExtPanId, otThreadGetExtendedPanId(mInstance)->m8, sizeof(status.mExtPanId));
+    status.mRole         = static_cast<uint8_t>(otThreadGetDeviceRole(mInstance));
+    status.mChannel      = otLinkGetChannel(mInstance);
+    status.mMacTxTotal   = macCounters->mTxTotal;
+    status.mMacRxTotal   = macCounters->mRxTotal;
+    status.mMacTxErrCca  = macCounters->mTxErrCca;
+    status.mMacTxRetry   = macCounters->mTxRetry;
+    status.mMacRxErrFcs  = macCounters->mRxErrFcs;
+    status.mIp6TxSuccess = ipCounters->mTxSuccess;
+    status.mIp6RxSuccess = ipCounters->mRxSuccess;
+    status.mIp6TxFailure = ipCounters->mTxFailure;
+    status.mIp6RxFailure = ipCounters->mRxFailure;
+
+    mStatusPage.Update(status);
+}
 
-    return val;
-};
+void ControllerOpenThread::RefreshStatusPage(void)
+{
+    UpdateStatusPage();
+    mStatusPageTimer.Start(OTBR_CONFIG_STATUS_PAGE_REFRESH_INTERVAL);
+}
 
-void ControllerOpenThread::UpdateFdSet(otSysMainloopContext &aMainloop)
+void ControllerOpenThread::HandleStatusPageTimer(Timer &aTimer, void *aContext)
 {
-    microseconds timeout = microseconds(aMainloop.mTimeout.tv_usec) + seconds(aMainloop.mTimeout.tv_sec);
-    auto         now     = steady_clock::now();
+    OT_UNUSED_VARIABLE(aTimer);
 
+    static_cast<ControllerOpenThread *>(aContext)->RefreshStatusPage();
+}
+#endif // OTBR_ENABLE_STATUS_PAGE
+
+#if OTBR_ENABLE_FRAME_CAPTURE
+void ControllerOpenThread::HandleFrameCapture(const otRadioFrame *aFrame, bool aIsTx)
+{
+    mFrameCapture.Append(aFrame->mPsdu, aFrame->mLength, aFrame->mChannel,
+                         aIsTx ? OT_RADIO_RSSI_INVALID : aFrame->mInfo.mRxInfo.mRssi, aIsTx);
+}
+#endif // OTBR_ENABLE_FRAME_CAPTURE
+
+void ControllerOpenThread::UpdateInstanceFdSet(otSysMainloopContext &aMainloop)
+{
     if (otTaskletsArePending(mInstance))
     {
-        timeout = microseconds::zero();
+        aMainloop.mTimeout.tv_sec  = 0;
+        aMainloop.mTimeout.tv_usec = 0;
     }
-    else if (!mTimers.empty())
+
+    mTasks.UpdateFdSet(aMainloop.mReadFdSet, aMainloop.mMaxFd);
+    otSysMainloopUpdate(mInstance, &aMainloop);
+}
+
+void ControllerOpenThread::ProcessInstance(const otSysMainloopContext &aMainloop)
+{
     {
-        if (mTimers.begin()->first < now)
-        {
-            timeout = microseconds::zero();
-        }
-        else
-        {
-            timeout = std::min(timeout, duration_cast<microseconds>(mTimers.begin()->first - now));
-        }
+        MainloopStageTimer stageTimer(kMainloopStageOtTasklets);
+
+        otTaskletsProcess(mInstance);
     }
 
-    aMainloop.mTimeout = ToTimeVal(timeout);
+    {
+        MainloopStageTimer stageTimer(kMainloopStageOtProcess);
 
-    otSysMainloopUpdate(mInstance, &aMainloop);
+        otSysMainloopProcess(mInstance, &aMainloop);
+    }
+
+    mTasks.Process(aMainloop.mReadFdSet);
+}
+
+void ControllerOpenThread::ResumeNetwork(void)
+{
+    otError error = mThreadHelper->TryResumeNetwork();
+
+    if (error == OT_ERROR_NONE)
+    {
+        LogStartupMilestone("Network resumed");
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to resume the network: %s", otThreadErrorToString(error));
+        mResumeNetworkTimer.Start(OTBR_CONFIG_RESUME_NETWORK_RETRY_INTERVAL);
+    }
+}
+
+void ControllerOpenThread::HandleResumeNetworkTimer(Timer &aTimer, void *aContext)
+{
+    OT_UNUSED_VARIABLE(aTimer);
+
+    static_cast<ControllerOpenThread *>(aContext)->ResumeNetwork();
+}
+
+void ControllerOpenThread::UpdateFdSet(otSysMainloopContext &aMainloop)
+{
+#if OTBR_ENABLE_NCP_THREAD
+    mCompletions.UpdateFdSet(aMainloop.mReadFdSet, aMainloop.mMaxFd);
+#else
+    UpdateInstanceFdSet(aMainloop);
+#endif
 }
 
 void ControllerOpenThread::Process(const otSysMainloopContext &aMainloop)
 {
-    auto now = steady_clock::now();
+#if OTBR_ENABLE_NCP_THREAD
+    mCompletions.Process(aMainloop.mReadFdSet);
+#else
+    ProcessInstance(aMainloop);
+#endif
+}
 
-    otTaskletsProcess(mInstance);
+void ControllerOpenThread::Post(const std::function<void(void)> &aTask)
+{
+    mTasks.Post(aTask);
+}
+
+void ControllerOpenThread::Post(const std::function<void(void)> &aTask, const std::function<void(void)> &aCompletion)
+{
+    mTasks.Post([this, aTask, aCompletion]() {
+        aTask();
+        PostToMainloop(aCompletion);
+    });
+}
+
+void ControllerOpenThread::PostToMainloop(const std::function<void(void)> &aTask)
+{
+#if OTBR_ENABLE_NCP_THREAD
+    mCompletions.Post(aTask);
+#else
+    mTasks.Post(aTask);
+#endif
+}
 
-    otSysMainloopProcess(mInstance, &aMainloop);
+void ControllerOpenThread::Invoke(const std::function<void(void)> &aTask)
+{
+#if OTBR_ENABLE_NCP_THREAD
+    if (mRadioThreadRunning && !IsRadioThread())
+    {
+        std::promise<void> done;
 
-    while (!mTimers.empty() && mTimers.begin()->first <= now)
+        mTasks.Post([&aTask, &done]() {
+            aTask();
+            done.set_value();
+        });
+        done.get_future().wait();
+    }
+    else
+#endif
     {
-        mTimers.begin()->second();
-        mTimers.erase(mTimers.begin());
+        aTask();
     }
+}
+
+#if OTBR_ENABLE_NCP_THREAD
+void ControllerOpenThread::StartRadioThread(void)
+{
+    // The radio thread starts by taking the instance mutex, so it only runs once mRadioThread is assigned.
+    std::lock_guard<std::mutex> lock(mInstanceMutex);
 
-    if (!mTriedAttach && mThreadHelper->TryResumeNetwork() == OT_ERROR_NONE)
+    assert(!mRadioThreadRunning);
+
+    mRadioThreadRunning = true;
+    mRadioThread        = std::thread(&ControllerOpenThread::RunRadioThread, this);
+}
+
+void ControllerOpenThread::StopRadioThread(void)
+{
+    VerifyOrExit(mRadioThread.joinable());
+
+    mRadioThreadRunning = false;
+    mTasks.Post([]() {});
+    mRadioThread.join();
+
+exit:
+    return;
+}
+
+void ControllerOpenThread::RunRadioThread(void)
+{
+    std::unique_lock<std::mutex> lock(mInstanceMutex);
+
+    ApplyThreadPolicy(kThreadClassRadio);
+    otbrLog(OTBR_LOG_INFO, "Radio thread started.");
+
+    while (mRadioThreadRunning)
     {
-        mTriedAttach = true;
+        otSysMainloopContext mainloop;
+        int                  rval;
+
+        mainloop.mMaxFd   = -1;
+        mainloop.mTimeout = kRadioPollTimeout;
+
+        FD_ZERO(&mainloop.mReadFdSet);
+        FD_ZERO(&mainloop.mWriteFdSet);
+        FD_ZERO(&mainloop.mErrorFdSet);
+
+        UpdateInstanceFdSet(mainloop);
+
+        mRadioTimers.UpdateTimeout(GetNow(), mainloop.mTimeout);
+
+        lock.unlock();
+        rval = select(mainloop.mMaxFd + 1, &mainloop.mReadFdSet, &mainloop.mWriteFdSet, &mainloop.mErrorFdSet,
+                      &mainloop.mTimeout);
+        lock.lock();
+
+        if (rval < 0)
+        {
+            VerifyOrExit(errno == EINTR, otbrLog(OTBR_LOG_ERR, "Radio thread select failed: %s", strerror(errno)));
+            continue;
+        }
+
+        mRadioTimers.Process(GetNow());
+        ProcessInstance(mainloop);
     }
+
+exit:
+    mRadioThreadRunning = false;
+    otbrLog(OTBR_LOG_INFO, "Radio thread stopped.");
 }
+#endif // OTBR_ENABLE_NCP_THREAD
 
 void ControllerOpenThread::Reset(void)
 {
+    RecordFlightEvent(kFlightEventRadioReset, 0, 0);
+
+#if OTBR_ENABLE_NCP_THREAD
+    StopRadioThread();
+#endif
+    // Pending timer tasks, timers and background jobs refer to the instance being finalized.
+    mTimerTasks.Clear();
+    mBackgroundJobs.Clear();
+    mResumeNetworkTimer.Stop();
+#if OTBR_ENABLE_STATUS_PAGE
+    mStatusPageTimer.Stop();
+#endif
+    mPendingChangedFlags = 0;
     otInstanceFinalize(mInstance);
     otSysDeinit();
-    Init();
+
+    if (InitInstance() != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to reinitialize the OpenThread instance");
+    }
+
+    mThreadHelper->HandleInstanceReset(mInstance);
+
+    // Subscribers resync with the state of the new instance, which the network settings are restored into.
+    HandleStateChanged(kResetChangedFlags);
+    mTasks.Post([this]() { ResumeNetwork(); });
+#if OTBR_ENABLE_STATUS_PAGE
+    if (mStatusPage.IsOpen())
+    {
+        mTasks.Post([this]() { RefreshStatusPage(); });
+    }
+#endif
+
+#if OTBR_ENABLE_NCP_THREAD
+    StartRadioThread();
+#endif
     sReset = false;
 }
 
@@ -197,60 +628,52 @@ bool ControllerOpenThread::IsResetRequested(void)
 
 otbrError ControllerOpenThread::RequestEvent(int aEvent)
 {
-    otbrError ret = OTBR_ERROR_NONE;
+    EventState state;
 
-    switch (aEvent)
-    {
-    case kEventExtPanId:
-    {
-        EventEmitter::Emit(kEventExtPanId, otThreadGetExtendedPanId(mInstance));
-        break;
-    }
-    case kEventThreadState:
-    {
-        bool attached = false;
+    Invoke([this, &state]() { GetEventState(state); });
+    EmitEvent(aEvent, state);
 
-        switch (otThreadGetDeviceRole(mInstance))
-        {
-        case OT_DEVICE_ROLE_CHILD:
-        case OT_DEVICE_ROLE_ROUTER:
-        case OT_DEVICE_ROLE_LEADER:
-            attached = true;
-            break;
-        default:
-            break;
-        }
+    return OTBR_ERROR_NONE;
+}
 
-        EventEmitter::Emit(kEventThreadState, attached);
-        break;
-    }
-    case kEventNetworkName:
+TimerTaskHandle ControllerOpenThread::PostTimerTask(std::chrono::steady_clock::time_point aTimePoint,
+                                                    const std::function<void(void)> &     aTask)
+{
+    auto delay = duration_cast<milliseconds>(aTimePoint - steady_clock::now());
+
+    return mTimerTasks.Post(delay.count() > 0 ? static_cast<uint64_t>(delay.count()) : 0, aTask);
+}
+
+otError ControllerOpenThread::UpdateLogLevel(void)
+{
+    otLogLevel level = OT_LOG_LEVEL_NONE;
+
+    switch (otbrLogGetEffectiveLevel(OTBR_LOG_MODULE_NCP))
     {
-        EventEmitter::Emit(kEventNetworkName, otThreadGetNetworkName(mInstance));
+    case OTBR_LOG_EMERG:
+    case OTBR_LOG_ALERT:
+    case OTBR_LOG_CRIT:
+        level = OT_LOG_LEVEL_CRIT;
         break;
-    }
-    case kEventPSKc:
-    {
-        EventEmitter::Emit(kEventPSKc, otThreadGetPskc(mInstance));
+    case OTBR_LOG_ERR:
+    case OTBR_LOG_WARNING:
+        level = OT_LOG_LEVEL_WARN;
         break;
-    }
-    case kEventThreadVersion:
-    {
-        EventEmitter::Emit(kEventThreadVersion, otThreadGetVersion());
+    case OTBR_LOG_NOTICE:
+        level = OT_LOG_LEVEL_NOTE;
+        break;
+    case OTBR_LOG_INFO:
+        level = OT_LOG_LEVEL_INFO;
+        break;
+    case OTBR_LOG_DEBUG:
+        level = OT_LOG_LEVEL_DEBG;
         break;
-    }
     default:
         assert(false);
         break;
     }
 
-    return ret;
-}
-
-void ControllerOpenThread::PostTimerTask(std::chrono::steady_clock::time_point aTimePoint,
-                                         const std::function<void(void)> &     aTask)
-{
-    mTimers.insert({aTimePoint, aTask});
+    return otLoggingSetLevel(level);
 }
 
 Controller *Controller::Create(const char *aInterfaceName, char *aRadioFile, char *aRadioConfig)
@@ -263,8 +686,6 @@ Controller *Controller::Create(const char *aInterfaceName, char *aRadioFile, cha
  */
 extern "C" void otPlatLog(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
 {
-    OT_UNUSED_VARIABLE(aLogRegion);
-
     int otbrLogLevel;
 
     switch (aLogLevel)
@@ -294,8 +715,19 @@ extern "C" void otPlatLog(otLogLevel aLogLevel, otLogRegion aLogRegion, const ch
 
     va_list ap;
     va_start(ap, aFormat);
-    otbrLogv(otbrLogLevel, aFormat, ap);
+    otbrLogv(OTBR_LOG_MODULE_NCP, otbrLogLevel, aFormat, ap);
     va_end(ap);
+
+    // The platform warnings and errors include the failures of the spinel exchanges with the RCP.
+    if (aLogRegion == OT_LOG_REGION_PLATFORM && aLogLevel <= OT_LOG_LEVEL_WARN)
+    {
+        char text[32];
+
+        va_start(ap, aFormat);
+        vsnprintf(text, sizeof(text), aFormat, ap);
+        va_end(ap);
+        RecordFlightEvent(kFlightEventRadioError, static_cast<uint16_t>(aLogLevel), 0, text);
+    }
 }
 
 } // namespace Ncp
@@ -34,14 +34,28 @@
 #ifndef OTBR_AGENT_NCP_OPENTHREAD_HPP_
 #define OTBR_AGENT_NCP_OPENTHREAD_HPP_
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
+
+#if OTBR_ENABLE_NCP_THREAD
+#include <mutex>
+#include <thread>
+#endif
 
 #include <openthread/instance.h>
+#include <openthread/link.h>
 #include <openthread/openthread-system.h>
 
 #include "ncp.hpp"
 #include "agent/thread_helper.hpp"
+#include "common/background_scheduler.hpp"
+#include "common/frame_capture.hpp"
+#include "common/status_page.hpp"
+#include "common/task_queue.hpp"
+#include "common/timer.hpp"
 
 namespace otbr {
 namespace Ncp {
@@ -49,6 +63,9 @@ namespace Ncp {
 /**
  * This interface defines NCP Controller functionality.
  *
+ * The OpenThread POSIX platform keeps its radio, settings and reset state in process-wide globals, so at most one
+ * controller may exist in a process. Each Thread network needs its own otbr-agent process.
+ *
  */
 class ControllerOpenThread : public Controller
 {
@@ -71,6 +88,14 @@ public:
      */
     otbrError Init(void) override;
 
+    /**
+     * This method makes Init() keep the state of the radio, which another agent was driving until now.
+     *
+     * The radio is reset again by later resets of the controller.
+     *
+     */
+    void KeepRadioState(void) { mConfig.mResetRadio = false; }
+
     /**
      * This method get mInstance pointer.
      *
@@ -106,6 +131,9 @@ public:
     /**
      * This method reset the NCP controller.
      *
+     * The OpenThread instance is recreated and the radio is reset, while the agent side, including the thread helper
+     * and the handlers registered with it, is kept and re-bound to the new instance.
+     *
      */
     void Reset(void) override;
 
@@ -129,23 +157,181 @@ public:
      */
     otbrError RequestEvent(int aEvent) override;
 
-    void PostTimerTask(std::chrono::steady_clock::time_point aTimePoint, const std::function<void(void)> &aTask);
+    /**
+     * This method posts a task to be run by the main loop timer service.
+     *
+     * @param[in]   aTimePoint  The time point at which the task should be run.
+     * @param[in]   aTask       The task to run.
+     *
+     * @returns A handle to cancel or reschedule the task.
+     *
+     */
+    TimerTaskHandle PostTimerTask(std::chrono::steady_clock::time_point aTimePoint,
+                                  const std::function<void(void)> &     aTask);
+
+    /**
+     * This method returns the scheduler of the timers run by the thread owning the OpenThread instance.
+     *
+     * Timers whose handlers access the OpenThread instance must be scheduled on it, as the radio thread owns the
+     * instance when OpenThread runs in a thread of its own.
+     *
+     * @returns A reference to the timer scheduler.
+     *
+     */
+    TimerScheduler &GetInstanceTimers(void)
+    {
+#if OTBR_ENABLE_NCP_THREAD
+        return mRadioTimers;
+#else
+        return TimerScheduler::Get();
+#endif
+    }
+
+    /**
+     * This method returns the scheduler of the background jobs, run by the instance timers.
+     *
+     * The jobs may access the OpenThread instance. They get OTBR_CONFIG_BACKGROUND_SLICE_BUDGET per slice and yield
+     * to the pending tasklets. They are cancelled when the controller is reset.
+     *
+     * @returns A reference to the background scheduler.
+     *
+     */
+    BackgroundScheduler &GetBackgroundJobs(void) { return mBackgroundJobs; }
+
+    /**
+     * This method posts a task to be run by the thread owning the OpenThread instance.
+     *
+     * It may be called from any thread.
+     *
+     * @param[in]   aTask   The task to run.
+     *
+     */
+    void Post(const std::function<void(void)> &aTask);
+
+    /**
+     * This method posts a task to be run by the thread owning the OpenThread instance, and a completion to be run
+     * by the main loop once the task is done.
+     *
+     * It may be called from any thread.
+     *
+     * @param[in]   aTask           The task to run.
+     * @param[in]   aCompletion     The completion to run in the main loop.
+     *
+     */
+    void Post(const std::function<void(void)> &aTask, const std::function<void(void)> &aCompletion);
+
+    /**
+     * This method posts a task to be run by the main loop.
+     *
+     * It may be called from any thread, typically to deliver OpenThread callbacks to main loop modules.
+     *
+     * @param[in]   aTask   The task to run.
+     *
+     */
+    void PostToMainloop(const std::function<void(void)> &aTask);
+
+    /**
+     * This method runs a task on the thread owning the OpenThread instance and waits for it to complete.
+     *
+     * The task runs immediately if the caller already owns the OpenThread instance.
+     *
+     * @param[in]   aTask   The task to run.
+     *
+     */
+    void Invoke(const std::function<void(void)> &aTask);
+
+#if OTBR_ENABLE_NCP_THREAD
+    /**
+     * This method returns the mutex held by the radio thread while it processes the OpenThread instance.
+     *
+     * Threads accessing the OpenThread instance directly instead of through Post() or Invoke() must hold it.
+     *
+     * @returns A reference to the instance mutex.
+     *
+     */
+    std::mutex &GetInstanceMutex(void) { return mInstanceMutex; }
+#endif
+
+    /**
+     * This method sets the log level of OpenThread to the log level in effect for the NCP module.
+     *
+     * OpenThread filters its logs before passing them on, so its level follows the level of the module.
+     *
+     * @retval OT_ERROR_NONE    Successfully set the log level.
+     * @retval ...              The error of OpenThread otherwise.
+     *
+     */
+    static otError UpdateLogLevel(void);
 
     ~ControllerOpenThread(void) override;
 
 private:
+    struct EventState
+    {
+        std::string     mNetworkName;
+        otExtendedPanId mExtPanId;
+        otPskc          mPskc;
+        bool            mAttached;
+    };
+
     static void HandleStateChanged(otChangedFlags aFlags, void *aContext)
     {
         static_cast<ControllerOpenThread *>(aContext)->HandleStateChanged(aFlags);
     }
     void HandleStateChanged(otChangedFlags aFlags);
+    void FlushStateChanged(void);
+    void GetEventState(EventState &aState);
+    void EmitStateChanged(otChangedFlags aFlags, const EventState &aState);
+    void EmitEvent(int aEvent, const EventState &aState);
+    void UpdateInstanceFdSet(otSysMainloopContext &aMainloop);
+    void ProcessInstance(const otSysMainloopContext &aMainloop);
+
+    otbrError   InitInstance(void);
+    void        ResumeNetwork(void);
+    static void HandleResumeNetworkTimer(Timer &aTimer, void *aContext);
+#if OTBR_ENABLE_STATUS_PAGE
+    void        UpdateStatusPage(void);
+    void        RefreshStatusPage(void);
+    static void HandleStatusPageTimer(Timer &aTimer, void *aContext);
+#endif
+#if OTBR_ENABLE_FRAME_CAPTURE
+    static void HandleFrameCapture(const otRadioFrame *aFrame, bool aIsTx, void *aContext)
+    {
+        static_cast<ControllerOpenThread *>(aContext)->HandleFrameCapture(aFrame, aIsTx);
+    }
+    void HandleFrameCapture(const otRadioFrame *aFrame, bool aIsTx);
+#endif
+
+#if OTBR_ENABLE_NCP_THREAD
+    void StartRadioThread(void);
+    void StopRadioThread(void);
+    void RunRadioThread(void);
+    bool IsRadioThread(void) const { return std::this_thread::get_id() == mRadioThread.get_id(); }
+#endif
 
     otInstance *mInstance;
 
-    otPlatformConfig                                                                mConfig;
-    std::unique_ptr<otbr::agent::ThreadHelper>                                      mThreadHelper;
-    std::multimap<std::chrono::steady_clock::time_point, std::function<void(void)>> mTimers;
-    bool                                                                            mTriedAttach;
+    otPlatformConfig                           mConfig;
+    std::unique_ptr<otbr::agent::ThreadHelper> mThreadHelper;
+    TaskQueue                                  mTasks;
+#if OTBR_ENABLE_NCP_THREAD
+    TaskQueue         mCompletions;
+    TimerScheduler    mRadioTimers;
+    std::mutex        mInstanceMutex;
+    std::thread       mRadioThread;
+    std::atomic<bool> mRadioThreadRunning;
+#endif
+    TimerTaskPool       mTimerTasks;
+    otChangedFlags      mPendingChangedFlags;
+    BackgroundScheduler mBackgroundJobs;
+    Timer               mResumeNetworkTimer;
+#if OTBR_ENABLE_STATUS_PAGE
+    Timer            mStatusPageTimer;
+    StatusPageWriter mStatusPage;
+#endif
+#if OTBR_ENABLE_FRAME_CAPTURE
+    FrameCaptureWriter mFrameCapture;
+#endif
 };
 
 } // namespace Ncp
@@ -26,18 +26,24 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_NCP
+
 #include "agent/thread_helper.hpp"
 
 #include <assert.h>
 #include <limits.h>
 #include <string.h>
 
+#include <algorithm>
 #include <string>
 
 #include <openthread/border_router.h>
 #include <openthread/channel_manager.h>
+#include <openthread/channel_monitor.h>
+#include <openthread/commissioner.h>
 #include <openthread/jam_detection.h>
 #include <openthread/joiner.h>
+#include <openthread/netdiag.h>
 #include <openthread/thread_ftd.h>
 #include <openthread/platform/radio.h>
 
@@ -45,18 +51,177 @@
 #include "common/byteswap.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/time.hpp"
+
+#ifndef OTBR_CONFIG_SCAN_RESULTS_FRESHNESS
+/**
+ * The time in milliseconds the results of a Thread network scan are reused for later scan requests.
+ *
+ * Scanning takes the radio off the network channel for a few seconds, so refreshing a page listing the networks
+ * should not scan again every time.
+ *
+ */
+#define OTBR_CONFIG_SCAN_RESULTS_FRESHNESS 10000
+#endif
+
+#ifndef OTBR_CONFIG_CHANNEL_QUALITY_SAMPLE_INTERVAL
+/**
+ * The interval in milliseconds of sampling the channel qualities.
+ *
+ * Energy scans are only performed while the device is not attached, so they never take the radio off an attached
+ * network.
+ *
+ */
+#define OTBR_CONFIG_CHANNEL_QUALITY_SAMPLE_INTERVAL 60000
+#endif
+
+#ifndef OTBR_CONFIG_COUNTER_HISTORY_SAMPLE_INTERVAL
+/**
+ * The interval in milliseconds of sampling the counter histories.
+ *
+ */
+#define OTBR_CONFIG_COUNTER_HISTORY_SAMPLE_INTERVAL 1000
+#endif
+
+#ifndef OTBR_CONFIG_COUNTER_HISTORY_FINE_SLOTS
+/**
+ * The number of sample intervals kept at full resolution, five minutes with the default sample interval.
+ *
+ */
+#define OTBR_CONFIG_COUNTER_HISTORY_FINE_SLOTS 300
+#endif
+
+#ifndef OTBR_CONFIG_COUNTER_HISTORY_COARSE_RATIO
+/**
+ * The number of sample intervals summed into each coarse interval, one minute with the default sample interval.
+ *
+ */
+#define OTBR_CONFIG_COUNTER_HISTORY_COARSE_RATIO 60
+#endif
+
+#ifndef OTBR_CONFIG_COUNTER_HISTORY_COARSE_SLOTS
+/**
+ * The number of coarse intervals kept, one day with the default sample interval.
+ *
+ */
+#define OTBR_CONFIG_COUNTER_HISTORY_COARSE_SLOTS 1440
+#endif
+
+#ifndef OTBR_CONFIG_ADDRESS_CACHE_SAMPLE_INTERVAL
+/**
+ * The interval in milliseconds of sampling the EID-to-RLOC address cache.
+ *
+ * The address queries are told from the changes between samples, so a shorter interval misses fewer of them.
+ *
+ */
+#define OTBR_CONFIG_ADDRESS_CACHE_SAMPLE_INTERVAL 1000
+#endif
+
+#ifndef OTBR_CONFIG_ADDRESS_CACHE_ENTRIES_PER_STEP
+/**
+ * The number of address cache entries walked by a step of the background sampling.
+ *
+ */
+#define OTBR_CONFIG_ADDRESS_CACHE_ENTRIES_PER_STEP 16
+#endif
+
+#ifndef OTBR_CONFIG_ADDRESS_CACHE_MAX_RESTARTS
+/**
+ * The number of times a walk of the address cache is restarted before it is completed in one step.
+ *
+ */
+#define OTBR_CONFIG_ADDRESS_CACHE_MAX_RESTARTS 2
+#endif
+
+#ifndef OTBR_CONFIG_TOPOLOGY_MAX_QUERIES
+/**
+ * The maximum number of network diagnostic queries in flight while crawling the network topology.
+ *
+ */
+#define OTBR_CONFIG_TOPOLOGY_MAX_QUERIES 4
+#endif
+
+#ifndef OTBR_CONFIG_TOPOLOGY_QUERY_TIMEOUT
+/**
+ * The time in milliseconds to wait for a router to respond to a network diagnostic query.
+ *
+ */
+#define OTBR_CONFIG_TOPOLOGY_QUERY_TIMEOUT 5000
+#endif
+
+#ifndef OTBR_CONFIG_TOPOLOGY_NODE_TTL
+/**
+ * The time in milliseconds a router is kept in the network topology after it last responded.
+ *
+ */
+#define OTBR_CONFIG_TOPOLOGY_NODE_TTL 600000
+#endif
+
+#ifndef OTBR_CONFIG_MAX_QUEUED_OPERATIONS
+/**
+ * The maximum number of scan, attach and joiner start requests waiting for a conflicting operation, more are rejected.
+ *
+ */
+#define OTBR_CONFIG_MAX_QUEUED_OPERATIONS 8
+#endif
 
 namespace otbr {
 namespace agent {
 
+static unsigned long GetInstanceNow(void)
+{
+#if OTBR_ENABLE_NCP_THREAD
+    // The main loop timestamp is only for the main loop thread, the radio thread reads the clock.
+    return GetNow();
+#else
+    return GetMainloopNow();
+#endif
+}
+
 ThreadHelper::ThreadHelper(otInstance *aInstance, otbr::Ncp::ControllerOpenThread *aNcp)
     : mInstance(aInstance)
     , mNcp(aNcp)
+    , mScanResultsTime(0)
+    , mChannelQualityTimer(HandleChannelQualityTimer, this, aNcp->GetInstanceTimers())
+    , mChannelMonitorSampleCount(0)
+    , mCounterHistories(kHistoryCounterNum,
+                        CounterHistory(OTBR_CONFIG_COUNTER_HISTORY_FINE_SLOTS,
+                                       OTBR_CONFIG_COUNTER_HISTORY_COARSE_SLOTS,
+                                       OTBR_CONFIG_COUNTER_HISTORY_COARSE_RATIO))
+    , mCounterHistoryTimer(HandleCounterHistoryTimer, this, aNcp->GetInstanceTimers())
+    , mAddressCacheTimer(HandleAddressCacheTimer, this, aNcp->GetInstanceTimers())
+    , mAddressCacheJob(0)
+    , mAddressCacheSlice(0)
+    , mAddressCacheRestarts(0)
+    , mTopology(std::bind(&ThreadHelper::SendTopologyQuery, this, std::placeholders::_1),
+                OTBR_CONFIG_TOPOLOGY_MAX_QUERIES,
+                OTBR_CONFIG_TOPOLOGY_QUERY_TIMEOUT,
+                OTBR_CONFIG_TOPOLOGY_NODE_TTL)
+    , mTopologyTimer(HandleTopologyTimer, this, aNcp->GetInstanceTimers())
+    , mTopologyTime(0)
+    , mOperationQueueCounters()
+    , mJoinerChannel(0)
+    , mJoinerOnCachedChannel(false)
+    , mJoinerSupportedChannelMask(0)
+    , mJoinerPhaseTime(0)
+    , mJoinerCounters()
 {
+    mChannelQualityTimer.Start(OTBR_CONFIG_CHANNEL_QUALITY_SAMPLE_INTERVAL);
+    SampleCounterHistories();
+    mCounterHistoryTimer.Start(OTBR_CONFIG_COUNTER_HISTORY_SAMPLE_INTERVAL);
+    SampleAddressCache();
+    mAddressCacheTimer.Start(OTBR_CONFIG_ADDRESS_CACHE_SAMPLE_INTERVAL);
+    otThreadSetReceiveDiagnosticGetCallback(mInstance, sDiagnosticGetResponseHandler, this);
 }
 
 void ThreadHelper::StateChangedCallback(otChangedFlags aFlags)
 {
+    for (const auto &handler : mStateChangedHandlers)
+    {
+        handler(aFlags);
+    }
+
     if (aFlags & OT_CHANGED_THREAD_ROLE)
     {
         otDeviceRole role = otThreadGetDeviceRole(mInstance);
@@ -70,45 +235,385 @@ void ThreadHelper::StateChangedCallback(otChangedFlags aFlags)
         {
             if (mAttachHandler != nullptr)
             {
-                mAttachHandler(OT_ERROR_NONE);
-                mAttachHandler = nullptr;
+                CompleteOperation(mAttachHandler, OT_ERROR_NONE);
             }
             else if (mJoinerHandler != nullptr)
             {
-                mJoinerHandler(OT_ERROR_NONE);
-                mJoinerHandler = nullptr;
+                CompleteOperation(mJoinerHandler, OT_ERROR_NONE);
             }
         }
     }
 }
 
+void ThreadHelper::HandleInstanceReset(otInstance *aInstance)
+{
+    std::vector<ScanHandler>    scanHandlers;
+    std::vector<ResultHandler>  topologyHandlers;
+    ResultHandler               attachHandler;
+    ResultHandler               joinerHandler;
+    std::deque<QueuedOperation> queuedOperations;
+
+    mInstance = aInstance;
+    otThreadSetReceiveDiagnosticGetCallback(mInstance, sDiagnosticGetResponseHandler, this);
+
+    // The close tasks were cancelled with the timer tasks of the finalized instance.
+    mUnsecurePortCloseTasks.clear();
+    mScanResults.clear();
+    mScanResultsTime           = 0;
+    mChannelMonitorSampleCount = 0;
+
+    // The counters of the new instance start from zero, the time since the last sample is not an interval.
+    for (CounterHistory &history : mCounterHistories)
+    {
+        history.Restart();
+    }
+    // The sampling job was cancelled with the background jobs of the finalized instance.
+    mAddressCacheJob = 0;
+    mAddressCacheEntries.clear();
+    mAddressCacheStats.Restart();
+
+    // The new instance may be on another network.
+    mTopology.Clear();
+    mTopologyTimer.Stop();
+    mTopologyTime = 0;
+
+    // Handlers may start new operations, which must not be aborted along with these.
+    scanHandlers.swap(mScanHandlers);
+    topologyHandlers.swap(mTopologyHandlers);
+    attachHandler.swap(mAttachHandler);
+    joinerHandler.swap(mJoinerHandler);
+    queuedOperations.swap(mQueuedOperations);
+    mOperationQueueCounters.mDepth = 0;
+
+    // The supported channels of the new instance are the defaults, the channel of the last join is kept for the
+    // rejoin which usually follows a factory reset.
+    mJoinerOnCachedChannel = false;
+
+    for (const auto &handler : scanHandlers)
+    {
+        handler(OT_ERROR_ABORT, {});
+    }
+
+    for (const auto &handler : topologyHandlers)
+    {
+        handler(OT_ERROR_ABORT);
+    }
+
+    if (attachHandler != nullptr)
+    {
+        attachHandler(OT_ERROR_ABORT);
+    }
+
+    if (joinerHandler != nullptr)
+    {
+        joinerHandler(OT_ERROR_ABORT);
+    }
+
+    for (const QueuedOperation &operation : queuedOperations)
+    {
+        AbortOperation(operation, OT_ERROR_ABORT);
+    }
+}
+
 void ThreadHelper::AddDeviceRoleHandler(DeviceRoleHandler aHandler)
 {
     mDeviceRoleHandlers.emplace_back(aHandler);
 }
 
+void ThreadHelper::AddStateChangedHandler(StateChangedHandler aHandler)
+{
+    mStateChangedHandlers.emplace_back(aHandler);
+}
+
+void ThreadHelper::AddScanResultHandler(ScanResultHandler aHandler)
+{
+    mScanResultHandlers.emplace_back(aHandler);
+}
+
 void ThreadHelper::Scan(ScanHandler aHandler)
+{
+    VerifyOrExit(aHandler != nullptr);
+
+    if (!mScanHandlers.empty())
+    {
+        otbrLog(OTBR_LOG_INFO, "Joining the scan in progress");
+        mScanHandlers.emplace_back(aHandler);
+        ExitNow();
+    }
+
+    if (mScanResultsTime != 0 && GetInstanceNow() - mScanResultsTime < OTBR_CONFIG_SCAN_RESULTS_FRESHNESS)
+    {
+        otbrLog(OTBR_LOG_INFO, "Reusing the results of the scan %lums ago", GetInstanceNow() - mScanResultsTime);
+        aHandler(OT_ERROR_NONE, mScanResults);
+        ExitNow();
+    }
+
+    if (IsOperationPending())
+    {
+        QueuedOperation operation;
+
+        for (QueuedOperation &queued : mQueuedOperations)
+        {
+            if (queued.mType == kOperationScan)
+            {
+                otbrLog(OTBR_LOG_INFO, "Merging into the scan waiting");
+                queued.mScanHandlers.emplace_back(aHandler);
+                mOperationQueueCounters.mMerged++;
+                ExitNow();
+            }
+        }
+
+        operation.mType = kOperationScan;
+        operation.mScanHandlers.emplace_back(aHandler);
+        QueueOperation(std::move(operation));
+    }
+    else
+    {
+        StartScan(aHandler);
+    }
+
+exit:
+    return;
+}
+
+void ThreadHelper::StartScan(ScanHandler aHandler)
 {
     otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(aHandler != nullptr);
-    mScanHandler = aHandler;
-    mScanResults.clear();
+    // The handlers of merged scan requests join the scan started for the first one.
+    if (!mScanHandlers.empty())
+    {
+        mScanHandlers.emplace_back(aHandler);
+        ExitNow();
+    }
 
     error =
         otLinkActiveScan(mInstance, /*scanChannels =*/0, /*scanDuration=*/0, &ThreadHelper::sActiveScanHandler, this);
+    SuccessOrExit(error);
+
+    mScanResults.clear();
+    mScanHandlers.emplace_back(aHandler);
 
 exit:
     if (error != OT_ERROR_NONE)
     {
-        if (aHandler)
+        aHandler(error, {});
+    }
+}
+
+void ThreadHelper::CrawlTopology(uint32_t aMaxAge, ResultHandler aHandler)
+{
+    otError               error = OT_ERROR_NONE;
+    otDeviceRole          role  = otThreadGetDeviceRole(mInstance);
+    otRouterInfo          info;
+    std::vector<uint16_t> routers;
+
+    VerifyOrExit(aHandler != nullptr);
+
+    if (!mTopologyHandlers.empty())
+    {
+        otbrLog(OTBR_LOG_INFO, "Joining the topology crawl in progress");
+        mTopologyHandlers.emplace_back(aHandler);
+        ExitNow();
+    }
+
+    if (mTopologyTime != 0 && GetInstanceNow() - mTopologyTime < aMaxAge)
+    {
+        aHandler(OT_ERROR_NONE);
+        ExitNow();
+    }
+
+    VerifyOrExit(role != OT_DEVICE_ROLE_DISABLED && role != OT_DEVICE_ROLE_DETACHED, error = OT_ERROR_INVALID_STATE);
+
+    if (role == OT_DEVICE_ROLE_CHILD)
+    {
+        // A child only knows its parent, the crawl finds the other routers from there.
+        SuccessOrExit(error = otThreadGetParentInfo(mInstance, &info));
+        routers.push_back(info.mRloc16);
+    }
+    else
+    {
+        for (uint8_t routerId = 0; routerId <= otThreadGetMaxRouterId(mInstance); routerId++)
         {
-            mScanHandler(error, {});
+            if (otThreadGetRouterInfo(mInstance, routerId, &info) == OT_ERROR_NONE && info.mAllocated)
+            {
+                routers.push_back(info.mRloc16);
+            }
         }
-        mScanHandler = nullptr;
+    }
+
+    mTopologyHandlers.emplace_back(aHandler);
+    mTopology.Start(GetInstanceNow(), routers);
+    UpdateTopologyCrawl();
+
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        aHandler(error);
     }
 }
 
+bool ThreadHelper::SendTopologyQuery(uint16_t aRloc16)
+{
+    static const uint8_t kTlvTypes[] = {
+        OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS,
+        OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS,
+        OT_NETWORK_DIAGNOSTIC_TLV_ROUTE,
+        OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE,
+    };
+
+    otIp6Address address;
+    otError      error;
+
+    // The routing locator of the router, i.e. <mesh local prefix>:0:ff:fe00:<rloc16>.
+    memcpy(address.mFields.m8, otThreadGetMeshLocalPrefix(mInstance)->m8, sizeof(otMeshLocalPrefix));
+    memset(&address.mFields.m8[sizeof(otMeshLocalPrefix)], 0, sizeof(address) - sizeof(otMeshLocalPrefix));
+    address.mFields.m8[11] = 0xff;
+    address.mFields.m8[12] = 0xfe;
+    address.mFields.m8[14] = static_cast<uint8_t>(aRloc16 >> 8);
+    address.mFields.m8[15] = static_cast<uint8_t>(aRloc16 & 0xff);
+
+    error = otThreadSendDiagnosticGet(mInstance, &address, kTlvTypes, sizeof(kTlvTypes));
+
+    if (error != OT_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to query the topology of router 0x%04x: %s", aRloc16,
+                otThreadErrorToString(error));
+    }
+
+    return error == OT_ERROR_NONE;
+}
+
+void ThreadHelper::sDiagnosticGetResponseHandler(otMessage *          aMessage,
+                                                 const otMessageInfo *aMessageInfo,
+                                                 void *               aThreadHelper)
+{
+    OT_UNUSED_VARIABLE(aMessageInfo);
+
+    static_cast<ThreadHelper *>(aThreadHelper)->DiagnosticGetResponseHandler(aMessage);
+}
+
+void ThreadHelper::DiagnosticGetResponseHandler(otMessage *aMessage)
+{
+    enum
+    {
+        kModeRxOnWhenIdle      = 1 << 3, ///< If the device has its receiver on when not transmitting.
+        kModeSecureDataRequest = 1 << 2, ///< If the device uses link layer security for all data requests.
+        kModeFullThreadDevice  = 1 << 1, ///< If the device is an FTD.
+        kModeFullNetworkData   = 1 << 0, ///< If the device requires the full Network Data.
+    };
+
+    otNetworkDiagIterator iterator = OT_NETWORK_DIAGNOSTIC_ITERATOR_INIT;
+    otNetworkDiagTlv      tlv;
+    Topology::Node        node      = {};
+    bool                  hasRloc16 = false;
+    std::vector<uint16_t> routers;
+
+    while (otThreadGetNextDiagnosticTlv(aMessage, &iterator, &tlv) == OT_ERROR_NONE)
+    {
+        switch (tlv.mType)
+        {
+        case OT_NETWORK_DIAGNOSTIC_TLV_EXT_ADDRESS:
+            node.mExtAddress = Encoding::BigEndian::ReadUint64(tlv.mData.mExtAddress.m8);
+            break;
+
+        case OT_NETWORK_DIAGNOSTIC_TLV_SHORT_ADDRESS:
+            node.mRloc16 = tlv.mData.mAddr16;
+            hasRloc16    = true;
+            break;
+
+        case OT_NETWORK_DIAGNOSTIC_TLV_ROUTE:
+            for (uint16_t i = 0; i < tlv.mData.mRoute.mRouteCount; i++)
+            {
+                const otNetworkDiagRouteData &route  = tlv.mData.mRoute.mRouteData[i];
+                uint16_t                      rloc16 = static_cast<uint16_t>(route.mRouterId << 10);
+
+                // The route table lists all routers, only the neighbors have a link quality both ways.
+                routers.push_back(rloc16);
+
+                if (route.mLinkQualityIn != 0 && route.mLinkQualityOut != 0)
+                {
+                    node.mLinks.push_back({rloc16, route.mLinkQualityIn, route.mLinkQualityOut});
+                }
+            }
+            break;
+
+        case OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE:
+            for (uint16_t i = 0; i < tlv.mData.mChildTable.mCount; i++)
+            {
+                const otNetworkDiagChildEntry &entry = tlv.mData.mChildTable.mTable[i];
+                uint8_t                        mode  = 0;
+
+                mode |= entry.mMode.mRxOnWhenIdle ? kModeRxOnWhenIdle : 0;
+                mode |= entry.mMode.mSecureDataRequests ? kModeSecureDataRequest : 0;
+                mode |= entry.mMode.mDeviceType ? kModeFullThreadDevice : 0;
+                mode |= entry.mMode.mNetworkData ? kModeFullNetworkData : 0;
+
+                // The RLOC16 of the router is added once known, the TLVs may come in any order.
+                node.mChildren.push_back({entry.mChildId, mode});
+            }
+            break;
+
+        default:
+            // Ignore other network diagnostics data.
+            break;
+        }
+    }
+
+    VerifyOrExit(hasRloc16);
+
+    for (Topology::Child &child : node.mChildren)
+    {
+        child.mRloc16 |= node.mRloc16;
+    }
+
+    mTopology.HandleResponse(GetInstanceNow(), node, routers);
+    UpdateTopologyCrawl();
+
+exit:
+    return;
+}
+
+void ThreadHelper::HandleTopologyTimer(Timer &aTimer, void *aThreadHelper)
+{
+    OT_UNUSED_VARIABLE(aTimer);
+
+    ThreadHelper *threadHelper = static_cast<ThreadHelper *>(aThreadHelper);
+
+    threadHelper->mTopology.Process(GetInstanceNow());
+    threadHelper->UpdateTopologyCrawl();
+}
+
+void ThreadHelper::UpdateTopologyCrawl(void)
+{
+    std::vector<ResultHandler> handlers;
+    uint64_t                   deadline;
+
+    // There is always a query in flight until the crawl completes.
+    if (mTopology.GetNextDeadline(deadline))
+    {
+        mTopologyTimer.StartAt(deadline);
+        ExitNow();
+    }
+
+    mTopologyTimer.Stop();
+    VerifyOrExit(!mTopologyHandlers.empty());
+
+    mTopologyTime = GetInstanceNow();
+    mTopology.Expire(mTopologyTime);
+    otbrLog(OTBR_LOG_INFO, "Crawled the network topology, %zu routers", mTopology.GetNodes().size());
+
+    handlers.swap(mTopologyHandlers);
+
+    for (const auto &handler : handlers)
+    {
+        handler(OT_ERROR_NONE);
+    }
+
+exit:
+    return;
+}
+
 void ThreadHelper::RandomFill(void *aBuf, size_t size)
 {
     std::uniform_int_distribution<> dist(0, UINT8_MAX);
@@ -131,14 +636,192 @@ void ThreadHelper::ActiveScanHandler(otActiveScanResult *aResult)
 {
     if (aResult == nullptr)
     {
-        if (mScanHandler != nullptr)
+        std::vector<ScanHandler> handlers;
+
+        // A handler may start another scan, which must not be joined by the handlers of this one.
+        handlers.swap(mScanHandlers);
+        mScanResultsTime = GetInstanceNow();
+
+        for (const auto &handler : handlers)
         {
-            mScanHandler(OT_ERROR_NONE, mScanResults);
+            handler(OT_ERROR_NONE, mScanResults);
         }
+
+        StartQueuedOperations();
     }
     else
     {
         mScanResults.push_back(*aResult);
+
+        for (const auto &handler : mScanResultHandlers)
+        {
+            handler(*aResult);
+        }
+    }
+}
+
+void ThreadHelper::HandleChannelQualityTimer(Timer &aTimer, void *aThreadHelper)
+{
+    aTimer.Start(OTBR_CONFIG_CHANNEL_QUALITY_SAMPLE_INTERVAL);
+    static_cast<ThreadHelper *>(aThreadHelper)->SampleChannelQuality();
+}
+
+void ThreadHelper::SampleChannelQuality(void)
+{
+    uint32_t     channelMask = otLinkGetSupportedChannelMask(mInstance);
+    otDeviceRole role        = otThreadGetDeviceRole(mInstance);
+
+#if OPENTHREAD_CONFIG_CHANNEL_MONITOR_ENABLE
+    uint32_t sampleCount = otChannelMonitorGetSampleCount(mInstance);
+
+    // The occupancies are averages over the monitor window already, sample them only after new samples arrived.
+    if (otChannelMonitorIsRunning(mInstance) && sampleCount != mChannelMonitorSampleCount)
+    {
+        mChannelMonitorSampleCount = sampleCount;
+
+        for (uint8_t i = 0; i < ChannelQuality::kMaxChannels; i++)
+        {
+            if (channelMask & (1U << i))
+            {
+                mChannelQuality.AddOccupancy(i, otChannelMonitorGetChannelOccupancy(mInstance, i));
+            }
+        }
+    }
+#else
+    OT_UNUSED_VARIABLE(mChannelMonitorSampleCount);
+#endif // OPENTHREAD_CONFIG_CHANNEL_MONITOR_ENABLE
+
+    if ((role == OT_DEVICE_ROLE_DISABLED || role == OT_DEVICE_ROLE_DETACHED) && mScanHandlers.empty() &&
+        !otLinkIsEnergyScanInProgress(mInstance))
+    {
+        otError error = otLinkEnergyScan(mInstance, channelMask, /* aScanDuration */ 0, sEnergyScanHandler, this);
+
+        otbrLog(OTBR_LOG_DEBUG, "Energy scan for channel qualities: %s", otThreadErrorToString(error));
+    }
+}
+
+void ThreadHelper::HandleCounterHistoryTimer(Timer &aTimer, void *aThreadHelper)
+{
+    aTimer.Start(OTBR_CONFIG_COUNTER_HISTORY_SAMPLE_INTERVAL);
+    static_cast<ThreadHelper *>(aThreadHelper)->SampleCounterHistories();
+}
+
+void ThreadHelper::SampleCounterHistories(void)
+{
+    const otMacCounters *macCounters = otLinkGetCounters(mInstance);
+    const otIpCounters * ipCounters  = otThreadGetIp6Counters(mInstance);
+    uint64_t             now         = GetInstanceNow();
+
+    mCounterHistories[kHistoryMacTxTotal].Sample(now, macCounters->mTxTotal);
+    mCounterHistories[kHistoryMacRxTotal].Sample(now, macCounters->mRxTotal);
+    mCounterHistories[kHistoryMacTxErrCca].Sample(now, macCounters->mTxErrCca);
+    mCounterHistories[kHistoryMacTxRetry].Sample(now, macCounters->mTxRetry);
+    mCounterHistories[kHistoryMacRxErrFcs].Sample(now, macCounters->mRxErrFcs);
+    mCounterHistories[kHistoryIp6TxSuccess].Sample(now, ipCounters->mTxSuccess);
+    mCounterHistories[kHistoryIp6RxSuccess].Sample(now, ipCounters->mRxSuccess);
+    mCounterHistories[kHistoryIp6TxFailure].Sample(now, ipCounters->mTxFailure);
+    mCounterHistories[kHistoryIp6RxFailure].Sample(now, ipCounters->mRxFailure);
+}
+
+void ThreadHelper::HandleAddressCacheTimer(Timer &aTimer, void *aThreadHelper)
+{
+    aTimer.Start(OTBR_CONFIG_ADDRESS_CACHE_SAMPLE_INTERVAL);
+    static_cast<ThreadHelper *>(aThreadHelper)->SampleAddressCache();
+}
+
+void ThreadHelper::SampleAddressCache(void)
+{
+    BackgroundScheduler &background = mNcp->GetBackgroundJobs();
+
+    // A sample which did not complete within an interval is taken again from the start.
+    background.Cancel(mAddressCacheJob);
+    mAddressCacheEntries.clear();
+    memset(&mAddressCacheIterator, 0, sizeof(mAddressCacheIterator));
+    mAddressCacheRestarts = 0;
+    mAddressCacheJob      = background.Post([this]() { return SampleAddressCacheStep(); });
+}
+
+bool ThreadHelper::SampleAddressCacheStep(void)
+{
+    otCacheEntryInfo info;
+    uint64_t         slice = mNcp->GetBackgroundJobs().GetCounters().mSlices;
+    uint32_t         limit = OTBR_CONFIG_ADDRESS_CACHE_ENTRIES_PER_STEP;
+    bool             done  = false;
+
+    // The instance only runs between two slices, so the cache may have changed, and the iterator be stale, when the
+    // walk started in an earlier slice. The walk is restarted then, and completed in this step once restarted too many
+    // times, so that a busy instance still gets a consistent sample.
+    if (slice != mAddressCacheSlice && !mAddressCacheEntries.empty())
+    {
+        mAddressCacheEntries.clear();
+        memset(&mAddressCacheIterator, 0, sizeof(mAddressCacheIterator));
+        mAddressCacheRestarts++;
+    }
+
+    if (mAddressCacheRestarts >= OTBR_CONFIG_ADDRESS_CACHE_MAX_RESTARTS)
+    {
+        limit = UINT32_MAX;
+    }
+
+    mAddressCacheSlice = slice;
+
+    // The cache is a table of the host, walking it does not talk to the RCP.
+    for (uint32_t i = 0; i < limit; i++)
+    {
+        AddressCacheStats::Entry entry;
+
+        if (otThreadGetNextCacheEntry(mInstance, &info, &mAddressCacheIterator) != OT_ERROR_NONE)
+        {
+            done = true;
+            break;
+        }
+
+        std::copy(std::begin(info.mTarget.mFields.m8), std::end(info.mTarget.mFields.m8), entry.mTarget.begin());
+        entry.mRloc16 = info.mRloc16;
+        entry.mState  = static_cast<AddressCacheStats::State>(info.mState);
+
+        if (std::none_of(mAddressCacheEntries.begin(), mAddressCacheEntries.end(),
+                         [&entry](const AddressCacheStats::Entry &aSampled) {
+                             return aSampled.mTarget == entry.mTarget;
+                         }))
+        {
+            mAddressCacheEntries.push_back(entry);
+        }
+    }
+
+    if (done)
+    {
+        mAddressCacheJob = 0;
+        mAddressCacheStats.Sample(std::move(mAddressCacheEntries));
+        mAddressCacheEntries.clear();
+    }
+
+    return done;
+}
+
+const char *ThreadHelper::GetHistoryCounterName(HistoryCounter aCounter)
+{
+    static const char *const kNames[] = {
+        "MacTxTotal",   "MacRxTotal",   "MacTxErrCca",  "MacTxRetry",   "MacRxErrFcs",
+        "Ip6TxSuccess", "Ip6RxSuccess", "Ip6TxFailure", "Ip6RxFailure",
+    };
+
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == kHistoryCounterNum, "Missing counter names");
+
+    return kNames[aCounter];
+}
+
+void ThreadHelper::sEnergyScanHandler(otEnergyScanResult *aResult, void *aThreadHelper)
+{
+    static_cast<ThreadHelper *>(aThreadHelper)->EnergyScanHandler(aResult);
+}
+
+void ThreadHelper::EnergyScanHandler(otEnergyScanResult *aResult)
+{
+    // The scan completes with a null result.
+    if (aResult != nullptr)
+    {
+        mChannelQuality.AddEnergy(aResult->mChannel, aResult->mMaxRssi);
     }
 }
 
@@ -160,19 +843,6 @@ uint8_t ThreadHelper::RandomChannelFromChannelMask(uint32_t aChannelMask)
     return channels[std::uniform_int_distribution<unsigned int>(0, numValidChannels - 1)(mRandomDevice)];
 }
 
-static otExtendedPanId ToOtExtendedPanId(uint64_t aExtPanId)
-{
-    otExtendedPanId extPanId;
-    uint64_t        mask = UINT8_MAX;
-
-    for (size_t i = 0; i < sizeof(uint64_t); i++)
-    {
-        extPanId.m8[i] = static_cast<uint8_t>((aExtPanId >> ((sizeof(uint64_t) - i - 1) * 8)) & mask);
-    }
-
-    return extPanId;
-}
-
 void ThreadHelper::Attach(const std::string &         aNetworkName,
                           uint16_t                    aPanId,
                           uint64_t                    aExtPanId,
@@ -180,7 +850,31 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
                           const std::vector<uint8_t> &aPSKc,
                           uint32_t                    aChannelMask,
                           ResultHandler               aHandler)
+{
+    if (aHandler != nullptr && IsOperationPending())
+    {
+        QueuedOperation operation;
 
+        operation.mType    = kOperationAttach;
+        operation.mHandler = aHandler;
+        operation.mStart   = [=](ResultHandler aQueuedHandler) {
+            StartAttach(aNetworkName, aPanId, aExtPanId, aMasterKey, aPSKc, aChannelMask, aQueuedHandler);
+        };
+        QueueOperation(std::move(operation));
+    }
+    else
+    {
+        StartAttach(aNetworkName, aPanId, aExtPanId, aMasterKey, aPSKc, aChannelMask, aHandler);
+    }
+}
+
+void ThreadHelper::StartAttach(const std::string &         aNetworkName,
+                               uint16_t                    aPanId,
+                               uint64_t                    aExtPanId,
+                               const std::vector<uint8_t> &aMasterKey,
+                               const std::vector<uint8_t> &aPSKc,
+                               uint32_t                    aChannelMask,
+                               ResultHandler               aHandler)
 {
     otError         error = OT_ERROR_NONE;
     otExtendedPanId extPanId;
@@ -190,7 +884,7 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
     uint8_t         channel;
 
     VerifyOrExit(aHandler != nullptr, error = OT_ERROR_INVALID_ARGS);
-    VerifyOrExit(mAttachHandler == nullptr && mJoinerHandler == nullptr, error = OT_ERROR_INVALID_STATE);
+    assert(mAttachHandler == nullptr && mJoinerHandler == nullptr);
     mAttachHandler = aHandler;
     VerifyOrExit(aMasterKey.empty() || aMasterKey.size() == sizeof(masterKey.m8), error = OT_ERROR_INVALID_ARGS);
     VerifyOrExit(aPSKc.empty() || aPSKc.size() == sizeof(pskc.m8), error = OT_ERROR_INVALID_ARGS);
@@ -203,7 +897,7 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
 
     if (aExtPanId != UINT64_MAX)
     {
-        extPanId = ToOtExtendedPanId(aExtPanId);
+        Encoding::BigEndian::WriteUint64(aExtPanId, extPanId.m8);
     }
     else
     {
@@ -241,7 +935,11 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
     SuccessOrExit(error = otThreadSetExtendedPanId(mInstance, &extPanId));
     SuccessOrExit(error = otThreadSetMasterKey(mInstance, &masterKey));
 
-    channelMask = otPlatRadioGetPreferredChannelMask(mInstance) & aChannelMask;
+    {
+        MainloopStageTimer stageTimer(kMainloopStageRcpPropertyGet);
+
+        channelMask = otPlatRadioGetPreferredChannelMask(mInstance) & aChannelMask;
+    }
 
     if (channelMask == 0)
     {
@@ -249,7 +947,7 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
     }
     VerifyOrExit(channelMask != 0, otbrLog(OTBR_LOG_WARNING, "Invalid channel mask"), error = OT_ERROR_INVALID_ARGS);
 
-    channel = RandomChannelFromChannelMask(channelMask);
+    channel = RandomChannelFromChannelMask(mChannelQuality.GetLeastCongestedChannels(channelMask));
     SuccessOrExit(otLinkSetChannel(mInstance, channel));
 
     SuccessOrExit(error = otThreadSetPskc(mInstance, &pskc));
@@ -258,17 +956,14 @@ void ThreadHelper::Attach(const std::string &         aNetworkName,
 exit:
     if (error != OT_ERROR_NONE)
     {
-        if (aHandler)
-        {
-            aHandler(error);
-        }
-        mAttachHandler = nullptr;
+        CompleteOperation(mAttachHandler, error);
     }
 }
 
 otError ThreadHelper::Reset(void)
 {
     mDeviceRoleHandlers.clear();
+    mStateChangedHandlers.clear();
     otInstanceReset(mInstance);
 
     return OT_ERROR_NONE;
@@ -281,27 +976,177 @@ void ThreadHelper::JoinerStart(const std::string &aPskd,
                                const std::string &aVendorSwVersion,
                                const std::string &aVendorData,
                                ResultHandler      aHandler)
+{
+    if (aHandler != nullptr && IsOperationPending())
+    {
+        QueuedOperation operation;
+
+        operation.mType    = kOperationJoiner;
+        operation.mHandler = aHandler;
+        operation.mStart   = [=](ResultHandler aQueuedHandler) {
+            StartJoiner(aPskd, aProvisioningUrl, aVendorName, aVendorModel, aVendorSwVersion, aVendorData,
+                        aQueuedHandler);
+        };
+        QueueOperation(std::move(operation));
+    }
+    else
+    {
+        StartJoiner(aPskd, aProvisioningUrl, aVendorName, aVendorModel, aVendorSwVersion, aVendorData, aHandler);
+    }
+}
+
+void ThreadHelper::StartJoiner(const std::string &aPskd,
+                               const std::string &aProvisioningUrl,
+                               const std::string &aVendorName,
+                               const std::string &aVendorModel,
+                               const std::string &aVendorSwVersion,
+                               const std::string &aVendorData,
+                               ResultHandler      aHandler)
 {
     otError error = OT_ERROR_NONE;
 
     VerifyOrExit(aHandler != nullptr, error = OT_ERROR_INVALID_ARGS);
-    VerifyOrExit(mAttachHandler == nullptr && mJoinerHandler == nullptr, error = OT_ERROR_INVALID_STATE);
-    mJoinerHandler = aHandler;
+    assert(mAttachHandler == nullptr && mJoinerHandler == nullptr);
+    mJoinerHandler    = aHandler;
+    mJoinerParameters = {aPskd, aProvisioningUrl, aVendorName, aVendorModel, aVendorSwVersion, aVendorData};
 
     if (!otIp6IsEnabled(mInstance))
     {
         SuccessOrExit(error = otIp6SetEnabled(mInstance, true));
     }
-    error = otJoinerStart(mInstance, aPskd.c_str(), aProvisioningUrl.c_str(), aVendorName.c_str(), aVendorModel.c_str(),
-                          aVendorSwVersion.c_str(), aVendorData.c_str(), sJoinerCallback, this);
+    error = StartJoinerDiscovery(/* aCachedChannel */ mJoinerChannel != 0);
 exit:
     if (error != OT_ERROR_NONE)
     {
-        if (aHandler)
+        CompleteOperation(mJoinerHandler, error);
+    }
+}
+
+otError ThreadHelper::StartJoinerDiscovery(bool aCachedChannel)
+{
+    const JoinerParameters &parameters = mJoinerParameters;
+    otError                 error;
+
+    // The joiner discovers joiner routers on all the supported channels, which are limited to the cached channel
+    // while trying it. They can only be changed while the Thread protocols are disabled, as they are while joining.
+    mJoinerOnCachedChannel = false;
+
+    if (aCachedChannel)
+    {
+        mJoinerSupportedChannelMask = otLinkGetSupportedChannelMask(mInstance);
+
+        if ((mJoinerSupportedChannelMask & (1U << mJoinerChannel)) &&
+            otLinkSetSupportedChannelMask(mInstance, 1U << mJoinerChannel) == OT_ERROR_NONE)
         {
-            aHandler(error);
+            otbrLog(OTBR_LOG_INFO, "Joining on channel %u of the last join first", mJoinerChannel);
+            mJoinerOnCachedChannel = true;
+            mJoinerCounters.mCachedChannelAttempts++;
+        }
+    }
+
+    mJoinerPhaseTime = GetInstanceNow();
+    error            = otJoinerStart(mInstance, parameters.mPskd.c_str(), parameters.mProvisioningUrl.c_str(),
+                          parameters.mVendorName.c_str(), parameters.mVendorModel.c_str(),
+                          parameters.mVendorSwVersion.c_str(), parameters.mVendorData.c_str(), sJoinerCallback, this);
+
+    if (error != OT_ERROR_NONE && mJoinerOnCachedChannel)
+    {
+        mJoinerOnCachedChannel = false;
+        otLinkSetSupportedChannelMask(mInstance, mJoinerSupportedChannelMask);
+    }
+
+    return error;
+}
+
+void ThreadHelper::QueueOperation(QueuedOperation aOperation)
+{
+    if (mQueuedOperations.size() >= OTBR_CONFIG_MAX_QUEUED_OPERATIONS)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Too many requests waiting for a conflicting operation");
+        mOperationQueueCounters.mRejected++;
+        AbortOperation(aOperation, OT_ERROR_BUSY);
+        ExitNow();
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Queued behind a conflicting operation and %zu requests", mQueuedOperations.size());
+    aOperation.mQueuedTime = GetInstanceNow();
+    mQueuedOperations.push_back(std::move(aOperation));
+
+    mOperationQueueCounters.mQueued++;
+    mOperationQueueCounters.mDepth     = static_cast<uint32_t>(mQueuedOperations.size());
+    mOperationQueueCounters.mPeakDepth = std::max(mOperationQueueCounters.mPeakDepth, mOperationQueueCounters.mDepth);
+
+exit:
+    return;
+}
+
+void ThreadHelper::AbortOperation(const QueuedOperation &aOperation, otError aError)
+{
+    for (const auto &handler : aOperation.mScanHandlers)
+    {
+        handler(aError, {});
+    }
+
+    if (aOperation.mHandler != nullptr)
+    {
+        aOperation.mHandler(aError);
+    }
+}
+
+void ThreadHelper::CompleteOperation(ResultHandler &aHandler, otError aError)
+{
+    ResultHandler handler;
+
+    handler.swap(aHandler);
+
+    if (handler != nullptr)
+    {
+        handler(aError);
+    }
+
+    StartQueuedOperations();
+}
+
+void ThreadHelper::StartQueuedOperations(void)
+{
+    static const char *const kOperationNames[] = {"scan", "attach", "joiner start"};
+
+    // The queued requests are started one at a time, a request which fails to start completes right away and the
+    // next one is started.
+    while (mAttachHandler == nullptr && mJoinerHandler == nullptr && mScanHandlers.empty() &&
+           !mQueuedOperations.empty())
+    {
+        // A scan takes a few seconds and someone usually waits for its results, attaching may take minutes, so the
+        // scan goes first and the others in request order.
+        auto next = std::find_if(mQueuedOperations.begin(), mQueuedOperations.end(),
+                                 [](const QueuedOperation &aOperation) { return aOperation.mType == kOperationScan; });
+
+        if (next == mQueuedOperations.end())
+        {
+            next = mQueuedOperations.begin();
+        }
+
+        QueuedOperation operation = std::move(*next);
+        unsigned long   waitTime  = GetInstanceNow() - operation.mQueuedTime;
+
+        mQueuedOperations.erase(next);
+        mOperationQueueCounters.mDepth = static_cast<uint32_t>(mQueuedOperations.size());
+        mOperationQueueCounters.mTotalWaitTime += static_cast<uint32_t>(waitTime);
+        mOperationQueueCounters.mMaxWaitTime =
+            std::max(mOperationQueueCounters.mMaxWaitTime, static_cast<uint32_t>(waitTime));
+        otbrLog(OTBR_LOG_INFO, "Starting the %s requested %lums ago", kOperationNames[operation.mType], waitTime);
+
+        if (operation.mType == kOperationScan)
+        {
+            for (const auto &handler : operation.mScanHandlers)
+            {
+                StartScan(handler);
+            }
+        }
+        else
+        {
+            operation.mStart(operation.mHandler);
         }
-        mJoinerHandler = nullptr;
     }
 }
 
@@ -314,17 +1159,101 @@ void ThreadHelper::sJoinerCallback(otError aError, void *aThreadHelper)
 
 void ThreadHelper::JoinerCallback(otError aError)
 {
+    uint32_t phaseTime = static_cast<uint32_t>(GetInstanceNow() - mJoinerPhaseTime);
+
+    if (mJoinerOnCachedChannel)
+    {
+        mJoinerOnCachedChannel = false;
+        otLinkSetSupportedChannelMask(mInstance, mJoinerSupportedChannelMask);
+        mJoinerCounters.mLastCachedChannelTime = phaseTime;
+        otbrLog(OTBR_LOG_INFO, "Joining on channel %u: %s in %ums", mJoinerChannel, otThreadErrorToString(aError),
+                phaseTime);
+
+        // The network may have moved to another channel, or the joiner routers may be gone. A wrong PSKd fails on
+        // any channel, and an aborted join is not retried.
+        if (aError != OT_ERROR_NONE && aError != OT_ERROR_SECURITY && aError != OT_ERROR_ABORT)
+        {
+            mJoinerChannel = 0;
+            aError         = StartJoinerDiscovery(/* aCachedChannel */ false);
+            VerifyOrExit(aError != OT_ERROR_NONE);
+        }
+        else if (aError == OT_ERROR_NONE)
+        {
+            mJoinerCounters.mCachedChannelJoins++;
+        }
+    }
+    else
+    {
+        mJoinerCounters.mFullDiscoveries++;
+        mJoinerCounters.mLastFullDiscoveryTime = phaseTime;
+        otbrLog(OTBR_LOG_INFO, "Joining with full discovery: %s in %ums", otThreadErrorToString(aError), phaseTime);
+    }
+
+    if (aError == OT_ERROR_NONE)
+    {
+        // The joiner tunes to the channel of the joiner router it joined through.
+        mJoinerChannel = otLinkGetChannel(mInstance);
+    }
+
     if (aError != OT_ERROR_NONE)
     {
         otbrLog(OTBR_LOG_WARNING, "Failed to join Thread network: %s", otThreadErrorToString(aError));
         LogOpenThreadResult("Stop Thread network", otIp6SetEnabled(mInstance, false));
-        mJoinerHandler(aError);
-        mJoinerHandler = nullptr;
+        CompleteOperation(mJoinerHandler, aError);
     }
     else
     {
         LogOpenThreadResult("Start Thread network", otIp6SetEnabled(mInstance, true));
     }
+
+exit:
+    return;
+}
+
+otError ThreadHelper::AddJoiners(const std::vector<Joiner> &aJoiners)
+{
+    otError error = OT_ERROR_NONE;
+    size_t  added = 0;
+
+    for (; added < aJoiners.size(); added++)
+    {
+        const Joiner &joiner = aJoiners[added];
+
+        SuccessOrExit(error = otCommissionerAddJoiner(mInstance, joiner.mAny ? nullptr : &joiner.mEui64,
+                                                      joiner.mPskd.c_str(), joiner.mTimeout));
+    }
+
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        while (added > 0)
+        {
+            const Joiner &joiner = aJoiners[--added];
+
+            otCommissionerRemoveJoiner(mInstance, joiner.mAny ? nullptr : &joiner.mEui64);
+        }
+    }
+
+    LogOpenThreadResult("Add joiners", error);
+    return error;
+}
+
+otError ThreadHelper::RemoveJoiners(const std::vector<Joiner> &aJoiners)
+{
+    otError error = OT_ERROR_NONE;
+
+    for (const Joiner &joiner : aJoiners)
+    {
+        otError removeError = otCommissionerRemoveJoiner(mInstance, joiner.mAny ? nullptr : &joiner.mEui64);
+
+        if (error == OT_ERROR_NONE && removeError != OT_ERROR_NOT_FOUND)
+        {
+            error = removeError;
+        }
+    }
+
+    LogOpenThreadResult("Remove joiners", error);
+    return error;
 }
 
 otError ThreadHelper::TryResumeNetwork(void)
@@ -361,27 +1290,37 @@ otError ThreadHelper::PermitUnsecureJoin(uint16_t aPort, uint32_t aSeconds)
 
     if (aSeconds > 0)
     {
-        auto triggerTime = std::chrono::steady_clock::now() + std::chrono::seconds(aSeconds);
+        auto             triggerTime = std::chrono::steady_clock::now() + std::chrono::seconds(aSeconds);
+        TimerTaskHandle &closeTask   = mUnsecurePortCloseTasks[aPort];
 
-        if (mUnsecurePortCloseTime.find(aPort) == mUnsecurePortCloseTime.end() ||
-            mUnsecurePortCloseTime[aPort] < triggerTime)
+        if (!closeTask.IsPending())
         {
-            mUnsecurePortCloseTime[aPort] = triggerTime;
-        }
+            closeTask = mNcp->PostTimerTask(triggerTime, [this, aPort]() {
+                otExtAddress noneAddress;
 
-        mNcp->PostTimerTask(triggerTime, [this, aPort]() {
-            auto         now = std::chrono::steady_clock::now();
-            otExtAddress noneAddress;
+                // 0 to clean steering data
+                memset(&noneAddress.m8, 0, sizeof(noneAddress.m8));
+                (void)otIp6RemoveUnsecurePort(mInstance, aPort);
+                otThreadSetSteeringData(mInstance, &noneAddress);
+                mUnsecurePortCloseTasks.erase(aPort);
+            });
 
-            // 0 to clean steering data
-            memset(&noneAddress.m8, 0, sizeof(noneAddress.m8));
-            if (now >= mUnsecurePortCloseTime[aPort])
+            if (!closeTask.IsPending())
             {
+                otExtAddress noneAddress;
+
+                // Nothing would close the port without the timer task, so it is not left open.
+                memset(&noneAddress.m8, 0, sizeof(noneAddress.m8));
                 (void)otIp6RemoveUnsecurePort(mInstance, aPort);
                 otThreadSetSteeringData(mInstance, &noneAddress);
-                mUnsecurePortCloseTime.erase(aPort);
+                mUnsecurePortCloseTasks.erase(aPort);
+                ExitNow(error = OT_ERROR_NO_BUFS);
             }
-        });
+        }
+        else if (closeTask.GetDeadline() < GetNow() + aSeconds * 1000ULL)
+        {
+            closeTask.Reschedule(aSeconds * 1000ULL);
+        }
     }
     else
     {
@@ -390,6 +1329,12 @@ otError ThreadHelper::PermitUnsecureJoin(uint16_t aPort, uint32_t aSeconds)
         memset(&noneAddress.m8, 0, sizeof(noneAddress.m8));
         (void)otIp6RemoveUnsecurePort(mInstance, aPort);
         otThreadSetSteeringData(mInstance, &noneAddress);
+
+        if (mUnsecurePortCloseTasks.count(aPort) != 0)
+        {
+            mUnsecurePortCloseTasks[aPort].Cancel();
+            mUnsecurePortCloseTasks.erase(aPort);
+        }
     }
 
 exit:
@@ -30,6 +30,7 @@
 #define OTBR_THREAD_HELPER_HPP_
 
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <map>
 #include <random>
@@ -41,9 +42,16 @@
 #include <openthread/jam_detection.h>
 #include <openthread/joiner.h>
 #include <openthread/netdata.h>
+#include <openthread/netdiag.h>
 #include <openthread/thread.h>
 
+#include "common/background_scheduler.hpp"
 #include "common/logging.hpp"
+#include "common/timer.hpp"
+#include "utils/address_cache_stats.hpp"
+#include "utils/channel_quality.hpp"
+#include "utils/counter_history.hpp"
+#include "utils/topology.hpp"
 
 namespace otbr {
 namespace Ncp {
@@ -57,9 +65,69 @@ namespace agent {
 class ThreadHelper
 {
 public:
-    using DeviceRoleHandler = std::function<void(otDeviceRole)>;
-    using ScanHandler       = std::function<void(otError, const std::vector<otActiveScanResult> &)>;
-    using ResultHandler     = std::function<void(otError)>;
+    using DeviceRoleHandler   = std::function<void(otDeviceRole)>;
+    using StateChangedHandler = std::function<void(otChangedFlags)>;
+    using ScanHandler         = std::function<void(otError, const std::vector<otActiveScanResult> &)>;
+    using ScanResultHandler   = std::function<void(const otActiveScanResult &)>;
+    using ResultHandler       = std::function<void(otError)>;
+
+    /**
+     * The counters whose history is kept by the Thread helper.
+     *
+     */
+    enum HistoryCounter
+    {
+        kHistoryMacTxTotal,   ///< The MAC frames transmitted.
+        kHistoryMacRxTotal,   ///< The MAC frames received.
+        kHistoryMacTxErrCca,  ///< The MAC transmissions failed for CCA.
+        kHistoryMacTxRetry,   ///< The MAC retransmissions.
+        kHistoryMacRxErrFcs,  ///< The MAC frames received with a bad FCS.
+        kHistoryIp6TxSuccess, ///< The IPv6 packets transmitted.
+        kHistoryIp6RxSuccess, ///< The IPv6 packets received.
+        kHistoryIp6TxFailure, ///< The IPv6 packets failed to transmit.
+        kHistoryIp6RxFailure, ///< The IPv6 packets failed to receive.
+        kHistoryCounterNum,   ///< The number of counters.
+    };
+
+    /**
+     * This structure represents the counters of the operations scheduled by the Thread helper.
+     *
+     */
+    struct OperationQueueCounters
+    {
+        uint32_t mDepth;         ///< The operations waiting now.
+        uint32_t mPeakDepth;     ///< The largest number of operations seen waiting.
+        uint32_t mQueued;        ///< The operations which had to wait for a conflicting one.
+        uint32_t mMerged;        ///< The scans merged into a scan already waiting.
+        uint32_t mRejected;      ///< The operations rejected as too many were waiting.
+        uint32_t mTotalWaitTime; ///< The total time the started operations waited, in milliseconds.
+        uint32_t mMaxWaitTime;   ///< The longest time a started operation waited, in milliseconds.
+    };
+
+    /**
+     * This structure represents the counters of the joins of the device.
+     *
+     */
+    struct JoinerCounters
+    {
+        uint32_t mCachedChannelAttempts; ///< The joins tried on the channel of the last successful join first.
+        uint32_t mCachedChannelJoins;    ///< The joins which succeeded on the channel of the last successful join.
+        uint32_t mFullDiscoveries;       ///< The joins which discovered the joiner routers on all channels.
+        uint32_t mLastCachedChannelTime; ///< The duration of the last join on the cached channel, in milliseconds.
+        uint32_t mLastFullDiscoveryTime; ///< The duration of the last join with full discovery, in milliseconds.
+    };
+
+    /**
+     * This structure represents a joiner of the commissioner.
+     *
+     */
+    struct Joiner
+    {
+        bool         mAny;     ///< Whether the entry accepts any joiner, @p mEui64 is ignored then.
+        otExtAddress mEui64;   ///< The EUI-64 of the joiner.
+        std::string  mPskd;    ///< The pre-shared key of the joiner.
+        uint32_t     mTimeout; ///< The time the joiner is accepted for, in seconds.
+    };
 
     /**
      * The constructor of a Thread helper.
@@ -78,6 +146,14 @@ public:
      */
     void AddDeviceRoleHandler(DeviceRoleHandler aHandler);
 
+    /**
+     * This method adds a callback for OpenThread state changes.
+     *
+     * @param[in]   aHandler  The state changed handler, called with the `OT_CHANGED_*` flags of the changes.
+     *
+     */
+    void AddStateChangedHandler(StateChangedHandler aHandler);
+
     /**
      * This method permits unsecure join on port.
      *
@@ -89,18 +165,52 @@ public:
      */
     otError PermitUnsecureJoin(uint16_t aPort, uint32_t aSeconds);
 
+    /**
+     * This method adds a callback for each network found by the Thread network scans.
+     *
+     * @param[in]   aHandler  The scan result handler, called as soon as a network is found.
+     *
+     */
+    void AddScanResultHandler(ScanResultHandler aHandler);
+
     /**
      * This method performs a Thread network scan.
      *
+     * A scan requested while another one is in progress joins it, and the results of a scan completed less than
+     * `OTBR_CONFIG_SCAN_RESULTS_FRESHNESS` milliseconds ago are reused without scanning again. Otherwise a scan
+     * requested while attaching or joining waits for it, ahead of the queued attach and joiner start requests, and
+     * scans requested meanwhile are merged into it.
+     *
      * @param[in]   aHandler  The scan result handler.
      *
      */
     void Scan(ScanHandler aHandler);
 
+    /**
+     * This method crawls the routers of the Thread network to refresh its topology.
+     *
+     * A crawl requested while another one is in progress joins it, and the topology of a crawl completed less than
+     * @p aMaxAge milliseconds ago is reused without crawling again.
+     *
+     * @param[in]   aMaxAge     The maximum age of the topology to reuse, in milliseconds.
+     * @param[in]   aHandler    The crawl result handler, the topology is available from GetTopology().
+     *
+     */
+    void CrawlTopology(uint32_t aMaxAge, ResultHandler aHandler);
+
+    /**
+     * This method returns the topology of the Thread network, as of the last crawl.
+     *
+     * @returns The network topology.
+     *
+     */
+    const Topology &GetTopology(void) const { return mTopology; }
+
     /**
      * This method attaches the device to the Thread network.
      *
-     * @note The joiner start and the attach proccesses are exclusive
+     * @note The joiner start, the attach and the scan processes are exclusive. One requested while another one is in
+     *       progress is queued, and started once the earlier ones complete.
      *
      * @param[in]   aNetworkName    The network name.
      * @param[in]   aPanId          The pan id, UINT16_MAX for random.
@@ -130,7 +240,11 @@ public:
     /**
      * This method triggers a thread join process.
      *
-     * @note The joiner start and the attach proccesses are exclusive
+     * The join is tried first on the channel of the last successful join, e.g. when rejoining after a factory reset,
+     * which only takes a single channel discovery. Joiner routers are discovered on all channels if that fails.
+     *
+     * @note The joiner start, the attach and the scan processes are exclusive. One requested while another one is in
+     *       progress is queued, and started once the earlier ones complete.
      *
      * @param[in]   aPskd             The pre-shared key for device.
      * @param[in]   aProvisioningUrl  The provision url.
@@ -149,6 +263,30 @@ public:
                      const std::string &aVendorData,
                      ResultHandler      aHandler);
 
+    /**
+     * This method adds joiners to the commissioner's joiner table.
+     *
+     * The joiners are added all or none: when adding one fails, the joiners added by this call are removed again.
+     *
+     * @param[in]   aJoiners    The joiners to add.
+     *
+     * @returns The error value of underlying OpenThread api calls.
+     *
+     */
+    otError AddJoiners(const std::vector<Joiner> &aJoiners);
+
+    /**
+     * This method removes joiners from the commissioner's joiner table.
+     *
+     * Only the EUI-64s of the joiners are used, joiners not in the table are skipped.
+     *
+     * @param[in]   aJoiners    The joiners to remove.
+     *
+     * @returns The first error of the underlying OpenThread api calls, other joiners are still removed.
+     *
+     */
+    otError RemoveJoiners(const std::vector<Joiner> &aJoiners);
+
     /**
      * This method tries to restore the network after reboot
      *
@@ -157,6 +295,76 @@ public:
      */
     otError TryResumeNetwork(void);
 
+    /**
+     * This method re-binds the helper to a new OpenThread instance after a reset.
+     *
+     * The registered handlers are kept. Operations in progress on the finalized instance, i.e. scans, attaching and
+     * joining, and the queued requests are completed with OT_ERROR_ABORT.
+     *
+     * @param[in]   aInstance   The new OpenThread instance.
+     *
+     */
+    void HandleInstanceReset(otInstance *aInstance);
+
+    /**
+     * This method returns the congestion scores of the channels.
+     *
+     * The scores are sampled in the background from the channel monitor, and from energy scans while the device is
+     * not attached. They are used to pick the channel when attaching with more than one channel allowed.
+     *
+     * @returns The channel congestion scores.
+     *
+     */
+    const ChannelQuality &GetChannelQuality(void) const { return mChannelQuality; }
+
+    /**
+     * This method returns the history of a counter.
+     *
+     * The counters are sampled in the background, so that their rates can be computed without polling.
+     *
+     * @param[in]   aCounter    The counter.
+     *
+     * @returns The counter history.
+     *
+     */
+    const CounterHistory &GetCounterHistory(HistoryCounter aCounter) const { return mCounterHistories[aCounter]; }
+
+    /**
+     * This method returns the counters of the operations scheduled by the helper, i.e. scans, attaching and joining.
+     *
+     * @returns The operation queue counters.
+     *
+     */
+    const OperationQueueCounters &GetOperationQueueCounters(void) const { return mOperationQueueCounters; }
+
+    /**
+     * This method returns the counters of the joins of the device.
+     *
+     * @returns The joiner counters.
+     *
+     */
+    const JoinerCounters &GetJoinerCounters(void) const { return mJoinerCounters; }
+
+    /**
+     * This method returns the EID-to-RLOC address cache and the counters of its activity.
+     *
+     * The cache is sampled in the background, so reading it never waits for OpenThread.
+     *
+     * @returns The address cache statistics.
+     *
+     */
+    const AddressCacheStats &GetAddressCacheStats(void) const { return mAddressCacheStats; }
+
+    /**
+     * This method returns the name of a counter whose history is kept.
+     *
+     * @param[in]   aCounter    The counter.
+     *
+     * @returns The counter name.
+     *
+     */
+    static const char *GetHistoryCounterName(HistoryCounter aCounter);
+
     /**
      * This method returns the underlying OpenThread instance.
      *
@@ -187,9 +395,90 @@ public:
     }
 
 private:
+    enum OperationType
+    {
+        kOperationScan,   ///< An active scan.
+        kOperationAttach, ///< Attaching to a network.
+        kOperationJoiner, ///< Joining a network.
+    };
+
+    /**
+     * This structure represents a request waiting for the conflicting operation in progress.
+     *
+     */
+    struct QueuedOperation
+    {
+        OperationType                      mType;
+        unsigned long                      mQueuedTime;   ///< The main loop time the request was queued at.
+        std::vector<ScanHandler>           mScanHandlers; ///< The handlers of a scan, merged requests included.
+        std::function<void(ResultHandler)> mStart;        ///< Starts an attach or joiner start with the handler.
+        ResultHandler                      mHandler;      ///< The result handler of an attach or joiner start.
+    };
+
+    /**
+     * This structure represents the parameters of the join in progress.
+     *
+     */
+    struct JoinerParameters
+    {
+        std::string mPskd;
+        std::string mProvisioningUrl;
+        std::string mVendorName;
+        std::string mVendorModel;
+        std::string mVendorSwVersion;
+        std::string mVendorData;
+    };
+
+    void StartScan(ScanHandler aHandler);
+    void StartAttach(const std::string &         aNetworkName,
+                     uint16_t                    aPanId,
+                     uint64_t                    aExtPanId,
+                     const std::vector<uint8_t> &aMasterKey,
+                     const std::vector<uint8_t> &aPSKc,
+                     uint32_t                    aChannelMask,
+                     ResultHandler               aHandler);
+    void StartJoiner(const std::string &aPskd,
+                     const std::string &aProvisioningUrl,
+                     const std::string &aVendorName,
+                     const std::string &aVendorModel,
+                     const std::string &aVendorSwVersion,
+                     const std::string &aVendorData,
+                     ResultHandler      aHandler);
+    bool IsOperationPending(void) const
+    {
+        return mAttachHandler != nullptr || mJoinerHandler != nullptr || !mScanHandlers.empty() ||
+               !mQueuedOperations.empty();
+    }
+    otError     StartJoinerDiscovery(bool aCachedChannel);
+    void        QueueOperation(QueuedOperation aOperation);
+    static void AbortOperation(const QueuedOperation &aOperation, otError aError);
+    void        CompleteOperation(ResultHandler &aHandler, otError aError);
+    void        StartQueuedOperations(void);
+
     static void sActiveScanHandler(otActiveScanResult *aResult, void *aThreadHelper);
     void        ActiveScanHandler(otActiveScanResult *aResult);
 
+    static void sEnergyScanHandler(otEnergyScanResult *aResult, void *aThreadHelper);
+    void        EnergyScanHandler(otEnergyScanResult *aResult);
+
+    static void HandleChannelQualityTimer(Timer &aTimer, void *aThreadHelper);
+    void        SampleChannelQuality(void);
+
+    static void HandleCounterHistoryTimer(Timer &aTimer, void *aThreadHelper);
+    void        SampleCounterHistories(void);
+
+    static void HandleAddressCacheTimer(Timer &aTimer, void *aThreadHelper);
+    void        SampleAddressCache(void);
+    bool        SampleAddressCacheStep(void);
+
+    static void sDiagnosticGetResponseHandler(otMessage *          aMessage,
+                                              const otMessageInfo *aMessageInfo,
+                                              void *               aThreadHelper);
+    void        DiagnosticGetResponseHandler(otMessage *aMessage);
+    bool        SendTopologyQuery(uint16_t aRloc16);
+    static void HandleTopologyTimer(Timer &aTimer, void *aThreadHelper);
+    void        UpdateTopologyCrawl(void);
+
     static void sJoinerCallback(otError aError, void *aThreadHelper);
     void        JoinerCallback(otError aResult);
 
@@ -200,15 +489,47 @@ private:
 
     otbr::Ncp::ControllerOpenThread *mNcp;
 
-    ScanHandler                     mScanHandler;
+    std::vector<ScanHandler>        mScanHandlers; ///< The handlers waiting for the scan in progress.
+    std::vector<ScanResultHandler>  mScanResultHandlers;
     std::vector<otActiveScanResult> mScanResults;
+    unsigned long                   mScanResultsTime; ///< The time the last scan completed, 0 if none.
+
+    std::vector<DeviceRoleHandler>   mDeviceRoleHandlers;
+    std::vector<StateChangedHandler> mStateChangedHandlers;
+
+    std::map<uint16_t, TimerTaskHandle> mUnsecurePortCloseTasks;
+
+    ChannelQuality mChannelQuality;
+    Timer          mChannelQualityTimer;
+    uint32_t       mChannelMonitorSampleCount; ///< The sample count of the channel monitor when last sampled.
+
+    std::vector<CounterHistory> mCounterHistories; ///< The histories, indexed by `HistoryCounter`.
+    Timer                       mCounterHistoryTimer;
+
+    AddressCacheStats                     mAddressCacheStats;
+    Timer                                 mAddressCacheTimer;
+    uint32_t                              mAddressCacheJob;      ///< The background job of the sample in progress.
+    uint64_t                              mAddressCacheSlice;    ///< The background slice of the last walk step.
+    uint32_t                              mAddressCacheRestarts; ///< The restarts of the walk in progress.
+    otCacheEntryIterator                  mAddressCacheIterator;
+    std::vector<AddressCacheStats::Entry> mAddressCacheEntries; ///< The entries of the sample in progress.
 
-    std::vector<DeviceRoleHandler> mDeviceRoleHandlers;
+    Topology                   mTopology;
+    Timer                      mTopologyTimer;
+    std::vector<ResultHandler> mTopologyHandlers; ///< The handlers waiting for the crawl in progress.
+    unsigned long              mTopologyTime;     ///< The time the last crawl completed, 0 if none.
 
-    std::map<uint16_t, std::chrono::steady_clock::time_point> mUnsecurePortCloseTime;
+    ResultHandler               mAttachHandler;
+    ResultHandler               mJoinerHandler;
+    std::deque<QueuedOperation> mQueuedOperations; ///< The requests waiting, in request order.
+    OperationQueueCounters      mOperationQueueCounters;
 
-    ResultHandler mAttachHandler;
-    ResultHandler mJoinerHandler;
+    JoinerParameters mJoinerParameters;           ///< The parameters of the join in progress.
+    uint8_t          mJoinerChannel;              ///< The channel of the last successful join, 0 if none.
+    bool             mJoinerOnCachedChannel;      ///< Whether the join in progress is tried on the cached channel.
+    uint32_t         mJoinerSupportedChannelMask; ///< The supported channels to restore after the cached channel.
+    unsigned long    mJoinerPhaseTime;            ///< The main loop time the discovery in progress started at.
+    JoinerCounters   mJoinerCounters;
 
     std::random_device mRandomDevice;
 };
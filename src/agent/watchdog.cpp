@@ -0,0 +1,120 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the systemd watchdog of the agent main loop.
+ */
+
+#include "agent/watchdog.hpp"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <systemd/sd-daemon.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+
+namespace otbr {
+
+// The number of health checks per watchdog timeout, so a single slow period doesn't get the agent restarted.
+static const uint64_t kChecksPerTimeout = 4;
+
+Watchdog::Watchdog(Ncp::ControllerOpenThread &aNcp)
+    : mNcp(aNcp)
+    , mTimer(HandleTimer, this)
+    , mInterval(0)
+    , mLastCheck(0)
+    , mStallTime(0)
+    , mProbePending(false)
+{
+}
+
+void Watchdog::Init(void)
+{
+    uint64_t timeout = 0;
+    int      rval    = sd_watchdog_enabled(0, &timeout);
+
+    if (rval < 0)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to get the watchdog timeout: %s", strerror(-rval));
+    }
+
+    VerifyOrExit(rval > 0);
+
+    mInterval = timeout / 1000 / kChecksPerTimeout;
+    otbrLog(OTBR_LOG_INFO, "Watchdog timeout %" PRIu64 "ms", timeout / 1000);
+
+    mLastCheck = GetMainloopClock();
+    mStallTime = GetMainloopStallTime();
+    HandleTimer();
+
+exit:
+    return;
+}
+
+void Watchdog::HandleTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<Watchdog *>(aContext)->HandleTimer();
+}
+
+void Watchdog::HandleTimer(void)
+{
+    uint64_t now       = GetMainloopClock();
+    uint64_t stallTime = GetMainloopStallTime();
+
+    if (mProbePending)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Withholding the watchdog keep-alive, the OpenThread instance is not responding");
+    }
+    else if ((stallTime - mStallTime) * 2 > now - mLastCheck)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Withholding the watchdog keep-alive, the main loop stalled for %" PRIu64 "ms",
+                (stallTime - mStallTime) / 1000);
+    }
+    else
+    {
+        sd_notify(0, "WATCHDOG=1");
+    }
+
+    mLastCheck = now;
+    mStallTime = stallTime;
+
+    if (!mProbePending)
+    {
+        mProbePending = true;
+        mNcp.Post([]() {}, [this]() { mProbePending = false; });
+    }
+
+    mTimer.Start(mInterval);
+}
+
+} // namespace otbr
@@ -0,0 +1,85 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the systemd watchdog of the agent main loop.
+ */
+
+#ifndef OTBR_AGENT_WATCHDOG_HPP_
+#define OTBR_AGENT_WATCHDOG_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include "agent/ncp_openthread.hpp"
+#include "common/timer.hpp"
+
+namespace otbr {
+
+/**
+ * This class feeds the systemd watchdog while the main loop is healthy.
+ *
+ * The loop is healthy when it spent no more than half of the last check period stalled, and the thread owning the
+ * OpenThread instance completed the probe posted at the previous check. systemd restarts the agent once the
+ * keep-alives stop.
+ *
+ */
+class Watchdog
+{
+public:
+    /**
+     * The constructor initializes the watchdog.
+     *
+     * @param[in]   aNcp    A reference to the OpenThread controller.
+     *
+     */
+    explicit Watchdog(Ncp::ControllerOpenThread &aNcp);
+
+    /**
+     * This method starts feeding the watchdog, if the service manager enabled it.
+     *
+     */
+    void Init(void);
+
+private:
+    static void HandleTimer(Timer &aTimer, void *aContext);
+    void        HandleTimer(void);
+
+    Ncp::ControllerOpenThread &mNcp;
+    Timer                      mTimer;
+    uint64_t                   mInterval;     ///< The check period in milliseconds.
+    uint64_t                   mLastCheck;    ///< The timestamp of the last check, from GetMainloopClock().
+    uint64_t                   mStallTime;    ///< The main loop stall time at the last check, in microseconds.
+    bool                       mProbePending; ///< Whether the probe posted to the OpenThread instance is not done.
+};
+
+} // namespace otbr
+
+#endif // OTBR_AGENT_WATCHDOG_HPP_
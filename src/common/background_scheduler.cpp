@@ -0,0 +1,163 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the cooperative scheduler of background agent work.
+ */
+
+#include "common/background_scheduler.hpp"
+
+#include <algorithm>
+
+#include "common/code_utils.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/time.hpp"
+
+#ifndef OTBR_CONFIG_BACKGROUND_MAX_YIELDS
+/**
+ * The number of slices in a row which may yield to foreground work without running a step.
+ *
+ */
+#define OTBR_CONFIG_BACKGROUND_MAX_YIELDS 8
+#endif
+
+namespace otbr {
+
+BackgroundScheduler::BackgroundScheduler(uint32_t aBudget, TimerScheduler &aScheduler)
+    : mTimer(HandleTimer, this, aScheduler)
+    , mBudget(aBudget)
+    , mNextId(0)
+    , mRunningId(0)
+    , mYieldsInRow(0)
+    , mCounters()
+{
+}
+
+BackgroundScheduler::BackgroundScheduler(uint32_t aBudget)
+    : BackgroundScheduler(aBudget, TimerScheduler::Get())
+{
+}
+
+uint32_t BackgroundScheduler::Post(const Step &aStep)
+{
+    if (++mNextId == 0)
+    {
+        ++mNextId;
+    }
+
+    mJobs.push_back(Job{mNextId, aStep});
+    ++mCounters.mJobs;
+
+    if (!mTimer.IsRunning())
+    {
+        mTimer.Start(0);
+    }
+
+    return mNextId;
+}
+
+void BackgroundScheduler::Cancel(uint32_t aJob)
+{
+    VerifyOrExit(aJob != 0);
+
+    if (aJob == mRunningId)
+    {
+        mRunningId = 0;
+        ExitNow();
+    }
+
+    mJobs.erase(std::remove_if(mJobs.begin(), mJobs.end(), [aJob](const Job &aPending) { return aPending.mId == aJob; }),
+                mJobs.end());
+
+exit:
+    return;
+}
+
+bool BackgroundScheduler::IsPending(uint32_t aJob) const
+{
+    return aJob != 0 && (aJob == mRunningId || std::any_of(mJobs.begin(), mJobs.end(), [aJob](const Job &aPending) {
+                             return aPending.mId == aJob;
+                         }));
+}
+
+void BackgroundScheduler::Clear(void)
+{
+    mJobs.clear();
+    mRunningId = 0;
+    mTimer.Stop();
+}
+
+void BackgroundScheduler::HandleTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<BackgroundScheduler *>(aContext)->RunSlice();
+}
+
+void BackgroundScheduler::RunSlice(void)
+{
+    MainloopStageTimer stageTimer(kMainloopStageBackgroundSlice);
+    uint64_t           start = GetNowPrecise();
+
+    ++mCounters.mSlices;
+
+    do
+    {
+        Job job;
+
+        if (mYieldCheck && mYieldsInRow < OTBR_CONFIG_BACKGROUND_MAX_YIELDS && mYieldCheck())
+        {
+            ++mCounters.mYields;
+            ++mYieldsInRow;
+            break;
+        }
+
+        mYieldsInRow = 0;
+
+        // The job is out of the queue while its step runs, the step may post or cancel jobs, including itself.
+        job = std::move(mJobs.front());
+        mJobs.pop_front();
+        mRunningId = job.mId;
+        ++mCounters.mSteps;
+
+        if (!job.mStep() && mRunningId == job.mId)
+        {
+            mJobs.push_back(std::move(job));
+        }
+
+        mRunningId = 0;
+    } while (!mJobs.empty() && GetNowPrecise() - start < mBudget);
+
+    // The next slice runs after the main loop polled its file descriptors, deadlines are in milliseconds.
+    if (!mJobs.empty())
+    {
+        mTimer.Start(1);
+    }
+}
+
+} // namespace otbr
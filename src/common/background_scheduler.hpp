@@ -0,0 +1,181 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the cooperative scheduler of background agent work.
+ */
+
+#ifndef OTBR_COMMON_BACKGROUND_SCHEDULER_HPP_
+#define OTBR_COMMON_BACKGROUND_SCHEDULER_HPP_
+
+#include "openthread-br/config.h"
+
+#include <deque>
+#include <functional>
+
+#include <stdint.h>
+
+#include "common/timer.hpp"
+
+namespace otbr {
+
+/**
+ * This class implements a cooperative scheduler of background jobs, which run in slices of a time budget.
+ *
+ * A job is a step function doing one resumable unit of work, called again until it reports the job complete. A
+ * slice runs the steps of the pending jobs in turn from a timer, until its budget is spent or foreground work is
+ * pending, then the main loop polls its file descriptors before the next slice runs.
+ *
+ */
+class BackgroundScheduler
+{
+public:
+    /**
+     * This function pointer is called to run one step of a job.
+     *
+     * @retval true     The job is complete.
+     * @retval false    The job has more steps to run.
+     *
+     */
+    typedef std::function<bool(void)> Step;
+
+    /**
+     * This function pointer is called before each step.
+     *
+     * @retval true     Foreground work is pending, the slice yields.
+     * @retval false    The slice goes on.
+     *
+     */
+    typedef std::function<bool(void)> YieldCheck;
+
+    /**
+     * This structure represents the counters of the scheduler.
+     *
+     */
+    struct Counters
+    {
+        uint64_t mJobs;   ///< The number of jobs posted.
+        uint64_t mSlices; ///< The number of slices run.
+        uint64_t mSteps;  ///< The number of steps run.
+        uint64_t mYields; ///< The number of slices which yielded to foreground work.
+    };
+
+    /**
+     * The constructor of a background scheduler.
+     *
+     * @param[in]   aBudget     The time budget of a slice in microseconds, at least one step runs in a slice.
+     * @param[in]   aScheduler  The timer scheduler to run the slices on.
+     *
+     */
+    BackgroundScheduler(uint32_t aBudget, TimerScheduler &aScheduler);
+
+    /**
+     * The constructor of a background scheduler on the timer scheduler driven by the main loop.
+     *
+     * @param[in]   aBudget     The time budget of a slice in microseconds, at least one step runs in a slice.
+     *
+     */
+    explicit BackgroundScheduler(uint32_t aBudget);
+
+    /**
+     * This method sets the function telling whether foreground work is pending.
+     *
+     * A slice which keeps yielding still runs a step after a few slices, so that the jobs complete eventually.
+     *
+     * @param[in]   aYieldCheck     The function, or nullptr to never yield before the budget is spent.
+     *
+     */
+    void SetYieldCheck(const YieldCheck &aYieldCheck) { mYieldCheck = aYieldCheck; }
+
+    /**
+     * This method posts a job, its first step runs in the next slice.
+     *
+     * @param[in]   aStep   The step function of the job.
+     *
+     * @returns The identifier of the job, never 0.
+     *
+     */
+    uint32_t Post(const Step &aStep);
+
+    /**
+     * This method cancels a job, which may be the one running.
+     *
+     * @param[in]   aJob    The identifier of the job, 0 and the identifiers of completed jobs are ignored.
+     *
+     */
+    void Cancel(uint32_t aJob);
+
+    /**
+     * This method indicates whether a job is pending.
+     *
+     * @param[in]   aJob    The identifier of the job.
+     *
+     * @retval true     The job has steps left to run.
+     * @retval false    The job is complete or cancelled.
+     *
+     */
+    bool IsPending(uint32_t aJob) const;
+
+    /**
+     * This method cancels all the jobs.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method returns the counters of the scheduler.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    struct Job
+    {
+        uint32_t mId;
+        Step     mStep;
+    };
+
+    static void HandleTimer(Timer &aTimer, void *aContext);
+    void        RunSlice(void);
+
+    std::deque<Job> mJobs;
+    Timer           mTimer;
+    YieldCheck      mYieldCheck;
+    uint32_t        mBudget;
+    uint32_t        mNextId;
+    uint32_t        mRunningId; ///< The job whose step is running, 0 if none or if it was cancelled.
+    uint8_t         mYieldsInRow;
+    Counters        mCounters;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_BACKGROUND_SCHEDULER_HPP_
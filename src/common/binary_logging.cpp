@@ -0,0 +1,651 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the binary log.
+ */
+
+#include "common/binary_logging.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+#include "common/time.hpp"
+
+namespace otbr {
+
+namespace BinaryLog {
+
+static bool IsFlag(char aChar)
+{
+    return aChar != '\0' && strchr("-+ #0'", aChar) != NULL;
+}
+
+static bool IsDigit(char aChar)
+{
+    return aChar >= '0' && aChar <= '9';
+}
+
+static const char *SkipWidth(const char *aFormat, uint8_t &aStars)
+{
+    if (*aFormat == '*')
+    {
+        aStars++;
+        aFormat++;
+    }
+    else
+    {
+        while (IsDigit(*aFormat))
+        {
+            aFormat++;
+        }
+    }
+
+    return aFormat;
+}
+
+const char *NextConversion(const char *aFormat, Conversion &aConversion)
+{
+    const char *cur    = strchr(aFormat, '%');
+    int         longs  = 0;
+    char        length = '\0';
+
+    VerifyOrExit(cur != NULL);
+
+    aConversion.mStart = cur++;
+    aConversion.mStars = 0;
+    aConversion.mType  = kArgNone;
+
+    while (IsFlag(*cur))
+    {
+        cur++;
+    }
+
+    cur = SkipWidth(cur, aConversion.mStars);
+
+    if (*cur == '.')
+    {
+        cur = SkipWidth(cur + 1, aConversion.mStars);
+    }
+
+    for (; *cur != '\0' && strchr("hlLqjzt", *cur) != NULL; cur++)
+    {
+        length = *cur;
+        longs += (*cur == 'l' || *cur == 'q') ? 1 : 0;
+    }
+
+    switch (*cur)
+    {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'c':
+        if (length == 'z' || length == 't')
+        {
+            aConversion.mType = kArgSize;
+        }
+        else if (length == 'j')
+        {
+            aConversion.mType = kArgIntMax;
+        }
+        else if (longs >= 2 || length == 'q' || length == 'L')
+        {
+            aConversion.mType = kArgLongLong;
+        }
+        else if (longs == 1)
+        {
+            aConversion.mType = kArgLong;
+        }
+        else
+        {
+            aConversion.mType = kArgInt;
+        }
+        break;
+
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        aConversion.mType = (length == 'L') ? kArgLongDouble : kArgDouble;
+        break;
+
+    case 's':
+        aConversion.mType = kArgString;
+        break;
+
+    case 'p':
+    case 'n':
+        aConversion.mType = kArgPointer;
+        break;
+
+    case '\0':
+        // A truncated conversion ends the format string.
+        cur--;
+        break;
+
+    default:
+        // "%%" and "%m" take no argument.
+        break;
+    }
+
+    cur++;
+    aConversion.mLength = static_cast<size_t>(cur - aConversion.mStart);
+
+exit:
+    return cur;
+}
+
+Writer::Writer(void)
+    : mHeader(NULL)
+    , mBase(NULL)
+    , mSize(0)
+{
+}
+
+Writer::~Writer(void)
+{
+    Close();
+}
+
+otbrError Writer::Open(const char *aFilename, uint32_t aSize)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    int       fd    = -1;
+    void *    base;
+
+    VerifyOrExit(!IsOpen(), errno = EALREADY);
+    VerifyOrExit(aSize >= sizeof(FileHeader) + 2 * kMaxRecordSize, errno = EINVAL);
+
+    fd = open(aFilename, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    VerifyOrExit(fd >= 0);
+    VerifyOrExit(ftruncate(fd, aSize) == 0);
+
+    base = mmap(NULL, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(base != MAP_FAILED);
+
+    mBase   = static_cast<uint8_t *>(base);
+    mSize   = aSize;
+    mHeader = static_cast<FileHeader *>(base);
+
+    memset(mHeader, 0, sizeof(*mHeader));
+    mHeader->mMagic         = kMagic;
+    mHeader->mVersion       = kVersion;
+    mHeader->mHeaderSize    = sizeof(FileHeader);
+    mHeader->mFormatsOffset = sizeof(FileHeader);
+    mHeader->mFormatsSize   = (aSize - sizeof(FileHeader)) / 4;
+    mHeader->mRingOffset    = mHeader->mFormatsOffset + mHeader->mFormatsSize;
+    mHeader->mRingSize      = aSize - mHeader->mRingOffset;
+    mHeader->mStartTime     = GetNow();
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (fd >= 0)
+    {
+        // The mapping keeps the file open.
+        close(fd);
+    }
+
+    return error;
+}
+
+void Writer::Close(void)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrExit(IsOpen());
+
+    msync(mBase, mSize, MS_SYNC);
+    munmap(mBase, mSize);
+    mHeader = NULL;
+    mBase   = NULL;
+    mSize   = 0;
+    mFormats.clear();
+
+exit:
+    return;
+}
+
+const Writer::Format &Writer::LookupFormat(const char *aFormat)
+{
+    FormatMap::iterator it = mFormats.find(aFormat);
+
+    if (it == mFormats.end())
+    {
+        Format       format;
+        Conversion   conversion;
+        FormatHeader formatHeader;
+        size_t       length = strlen(aFormat) + 1;
+
+        for (const char *cur = NextConversion(aFormat, conversion); cur != NULL; cur = NextConversion(cur, conversion))
+        {
+            format.mArgTypes.insert(format.mArgTypes.end(), conversion.mStars, kArgInt);
+
+            if (conversion.mType != kArgNone)
+            {
+                format.mArgTypes.push_back(conversion.mType);
+            }
+        }
+
+        if (length <= UINT16_MAX && mHeader->mFormatsUsed + sizeof(formatHeader) + length <= mHeader->mFormatsSize)
+        {
+            uint8_t *dst = mBase + mHeader->mFormatsOffset + mHeader->mFormatsUsed;
+
+            format.mId           = mHeader->mFormatCount;
+            formatHeader.mId     = format.mId;
+            formatHeader.mLength = static_cast<uint16_t>(length);
+            memcpy(dst, &formatHeader, sizeof(formatHeader));
+            memcpy(dst + sizeof(formatHeader), aFormat, length);
+            mHeader->mFormatsUsed += sizeof(formatHeader) + length;
+            mHeader->mFormatCount++;
+        }
+        else
+        {
+            format.mId = kUnknownFormat;
+        }
+
+        it = mFormats.insert(std::make_pair(aFormat, format)).first;
+    }
+
+    return it->second;
+}
+
+void Writer::Append(const uint8_t *aRecord, uint16_t aLength)
+{
+    const uint32_t ringSize = mHeader->mRingSize;
+    uint8_t *      ring     = mBase + mHeader->mRingOffset;
+    uint64_t       head     = mHeader->mHead;
+    uint32_t       offset   = static_cast<uint32_t>(head % ringSize);
+    uint32_t       skip     = (offset + aLength > ringSize) ? ringSize - offset : 0;
+
+    // Drop the oldest records overlapping the new one.
+    while (head + skip + aLength - mHeader->mTail > ringSize)
+    {
+        uint32_t tailOffset = static_cast<uint32_t>(mHeader->mTail % ringSize);
+        uint16_t length     = 0;
+
+        if (ringSize - tailOffset >= sizeof(RecordHeader))
+        {
+            memcpy(&length, ring + tailOffset, sizeof(length));
+        }
+
+        mHeader->mTail += (length == 0) ? ringSize - tailOffset : length;
+    }
+
+    if (skip > 0)
+    {
+        if (skip >= sizeof(uint16_t))
+        {
+            memset(ring + offset, 0, sizeof(uint16_t));
+        }
+
+        head += skip;
+        offset = 0;
+    }
+
+    memcpy(ring + offset, aRecord, aLength);
+
+    // The head moves last, so that a crash in between leaves only intact records.
+    mHeader->mHead = head + aLength;
+}
+
+void Writer::Record(int aLevel, const char *aFormat, va_list aArguments)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    uint8_t                     record[kMaxRecordSize];
+    RecordHeader                header;
+    size_t                      length = sizeof(header);
+
+    VerifyOrExit(IsOpen());
+
+    {
+        const Format &format = LookupFormat(aFormat);
+
+        header.mLevel     = static_cast<uint8_t>(aLevel);
+        header.mTruncated = 0;
+        header.mFormatId  = format.mId;
+        header.mTime      = static_cast<uint32_t>(GetNow() - mHeader->mStartTime);
+
+        for (ArgType type : format.mArgTypes)
+        {
+            int64_t     integer = 0;
+            double      real    = 0;
+            const char *string  = NULL;
+            size_t      size    = sizeof(integer);
+
+            switch (type)
+            {
+            case kArgInt:
+                integer = va_arg(aArguments, int);
+                break;
+            case kArgLong:
+                integer = va_arg(aArguments, long);
+                break;
+            case kArgLongLong:
+                integer = va_arg(aArguments, long long);
+                break;
+            case kArgSize:
+                integer = static_cast<int64_t>(va_arg(aArguments, size_t));
+                break;
+            case kArgIntMax:
+                integer = va_arg(aArguments, intmax_t);
+                break;
+            case kArgDouble:
+                real = va_arg(aArguments, double);
+                size = sizeof(real);
+                break;
+            case kArgLongDouble:
+                real = static_cast<double>(va_arg(aArguments, long double));
+                size = sizeof(real);
+                break;
+            case kArgString:
+                string = va_arg(aArguments, const char *);
+                string = (string == NULL) ? "(null)" : string;
+                size   = 1 + strnlen(string, kMaxStringArg);
+                break;
+            case kArgPointer:
+                integer = static_cast<int64_t>(reinterpret_cast<uintptr_t>(va_arg(aArguments, void *)));
+                break;
+            case kArgNone:
+                break;
+            }
+
+            if (length + size > sizeof(record))
+            {
+                header.mTruncated = 1;
+                break;
+            }
+
+            if (type == kArgString)
+            {
+                record[length] = static_cast<uint8_t>(size - 1);
+                memcpy(record + length + 1, string, size - 1);
+            }
+            else if (type == kArgDouble || type == kArgLongDouble)
+            {
+                memcpy(record + length, &real, size);
+            }
+            else
+            {
+                memcpy(record + length, &integer, size);
+            }
+
+            length += size;
+        }
+    }
+
+    header.mLength = static_cast<uint16_t>(length);
+    memcpy(record, &header, sizeof(header));
+    Append(record, header.mLength);
+
+exit:
+    return;
+}
+
+static const char *LevelToString(uint8_t aLevel)
+{
+    static const char *const kLevels[] = {"EMERG", "ALERT", "CRIT", "ERR", "WARNING", "NOTICE", "INFO", "DEBUG"};
+
+    return aLevel < sizeof(kLevels) / sizeof(kLevels[0]) ? kLevels[aLevel] : "?";
+}
+
+template <typename T>
+static void PrintArg(FILE *aOutput, const std::string &aSpec, const int *aStars, uint8_t aCount, T aValue)
+{
+    switch (aCount)
+    {
+    case 0:
+        fprintf(aOutput, aSpec.c_str(), aValue);
+        break;
+    case 1:
+        fprintf(aOutput, aSpec.c_str(), aStars[0], aValue);
+        break;
+    default:
+        fprintf(aOutput, aSpec.c_str(), aStars[0], aStars[1], aValue);
+        break;
+    }
+}
+
+static void PrintRecord(FILE *aOutput, const char *aFormat, const RecordHeader &aHeader, const uint8_t *aArgs)
+{
+    const uint8_t *end = aArgs + aHeader.mLength - sizeof(RecordHeader);
+    const char *   cur = aFormat;
+    const char *   next;
+    Conversion     conversion;
+
+    fprintf(aOutput, "%4lu.%03lu | %s | ", static_cast<unsigned long>(aHeader.mTime / 1000),
+            static_cast<unsigned long>(aHeader.mTime % 1000), LevelToString(aHeader.mLevel));
+
+    for (next = NextConversion(cur, conversion); next != NULL; cur = next, next = NextConversion(cur, conversion))
+    {
+        std::string spec(conversion.mStart, conversion.mLength);
+        int         stars[2] = {0, 0};
+        int64_t     integer;
+        double      real;
+
+        fwrite(cur, 1, static_cast<size_t>(conversion.mStart - cur), aOutput);
+
+        for (uint8_t i = 0; i < conversion.mStars && i < 2; i++)
+        {
+            VerifyOrExit(aArgs + sizeof(integer) <= end);
+            memcpy(&integer, aArgs, sizeof(integer));
+            aArgs += sizeof(integer);
+            stars[i] = static_cast<int>(integer);
+        }
+
+        switch (conversion.mType)
+        {
+        case kArgNone:
+            if (spec == "%%")
+            {
+                fputc('%', aOutput);
+            }
+            break;
+
+        case kArgDouble:
+        case kArgLongDouble:
+            VerifyOrExit(aArgs + sizeof(real) <= end);
+            memcpy(&real, aArgs, sizeof(real));
+            aArgs += sizeof(real);
+            if (conversion.mType == kArgDouble)
+            {
+                PrintArg(aOutput, spec, stars, conversion.mStars, real);
+            }
+            else
+            {
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<long double>(real));
+            }
+            break;
+
+        case kArgString:
+        {
+            std::string string;
+
+            VerifyOrExit(aArgs < end && aArgs + 1 + aArgs[0] <= end);
+            string.assign(reinterpret_cast<const char *>(aArgs + 1), aArgs[0]);
+            aArgs += 1 + aArgs[0];
+            PrintArg(aOutput, spec, stars, conversion.mStars, string.c_str());
+            break;
+        }
+
+        default:
+            VerifyOrExit(aArgs + sizeof(integer) <= end);
+            memcpy(&integer, aArgs, sizeof(integer));
+            aArgs += sizeof(integer);
+
+            switch (conversion.mType)
+            {
+            case kArgInt:
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<int>(integer));
+                break;
+            case kArgLong:
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<long>(integer));
+                break;
+            case kArgLongLong:
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<long long>(integer));
+                break;
+            case kArgSize:
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<size_t>(integer));
+                break;
+            case kArgIntMax:
+                PrintArg(aOutput, spec, stars, conversion.mStars, static_cast<intmax_t>(integer));
+                break;
+            default:
+                if (spec.back() == 'p')
+                {
+                    PrintArg(aOutput, spec, stars, conversion.mStars,
+                             reinterpret_cast<void *>(static_cast<uintptr_t>(integer)));
+                }
+                break;
+            }
+            break;
+        }
+    }
+
+    fputs(cur, aOutput);
+
+exit:
+    if (next != NULL)
+    {
+        fputs("<truncated>", aOutput);
+    }
+
+    fputc('\n', aOutput);
+}
+
+otbrError Decode(const char *aFilename, FILE *aOutput)
+{
+    otbrError                error = OTBR_ERROR_ERRNO;
+    FILE *                   fp    = fopen(aFilename, "rb");
+    std::vector<uint8_t>     file;
+    std::vector<std::string> formats;
+    FileHeader               header;
+    long                     size;
+
+    VerifyOrExit(fp != NULL);
+    VerifyOrExit(fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0);
+    VerifyOrExit(static_cast<size_t>(size) >= sizeof(header), errno = EINVAL);
+
+    file.resize(static_cast<size_t>(size));
+    VerifyOrExit(fread(&file[0], 1, file.size(), fp) == file.size(), errno = EIO);
+
+    memcpy(&header, &file[0], sizeof(header));
+    VerifyOrExit(header.mMagic == kMagic && header.mVersion == kVersion && header.mHeaderSize == sizeof(header),
+                 errno = EINVAL);
+    VerifyOrExit(header.mFormatsOffset + header.mFormatsSize <= file.size() &&
+                     header.mFormatsUsed <= header.mFormatsSize &&
+                     header.mRingOffset + header.mRingSize <= file.size() && header.mRingSize > 0 &&
+                     header.mHead >= header.mTail && header.mHead - header.mTail <= header.mRingSize,
+                 errno = EINVAL);
+
+    for (uint32_t offset = 0; offset + sizeof(FormatHeader) <= header.mFormatsUsed;)
+    {
+        const uint8_t *cur = &file[header.mFormatsOffset + offset];
+        FormatHeader   formatHeader;
+
+        memcpy(&formatHeader, cur, sizeof(formatHeader));
+        VerifyOrExit(formatHeader.mLength > 0 &&
+                         offset + sizeof(formatHeader) + formatHeader.mLength <= header.mFormatsUsed,
+                     errno = EINVAL);
+
+        if (formatHeader.mId >= formats.size())
+        {
+            formats.resize(formatHeader.mId + 1);
+        }
+
+        formats[formatHeader.mId].assign(reinterpret_cast<const char *>(cur + sizeof(formatHeader)),
+                                         formatHeader.mLength - 1);
+        offset += sizeof(formatHeader) + formatHeader.mLength;
+    }
+
+    for (uint64_t pos = header.mTail; pos < header.mHead;)
+    {
+        uint32_t       offset = static_cast<uint32_t>(pos % header.mRingSize);
+        const uint8_t *cur    = &file[header.mRingOffset + offset];
+        RecordHeader   recordHeader;
+
+        recordHeader.mLength = 0;
+
+        if (header.mRingSize - offset >= sizeof(recordHeader))
+        {
+            memcpy(&recordHeader, cur, sizeof(recordHeader));
+        }
+
+        if (recordHeader.mLength == 0)
+        {
+            pos += header.mRingSize - offset;
+            continue;
+        }
+
+        VerifyOrExit(recordHeader.mLength >= sizeof(recordHeader) && offset + recordHeader.mLength <= header.mRingSize,
+                     errno = EINVAL);
+
+        if (recordHeader.mFormatId < formats.size())
+        {
+            PrintRecord(aOutput, formats[recordHeader.mFormatId].c_str(), recordHeader, cur + sizeof(recordHeader));
+        }
+        else
+        {
+            fprintf(aOutput, "%4lu.%03lu | %s | <unknown format %" PRIu32 ">\n",
+                    static_cast<unsigned long>(recordHeader.mTime / 1000),
+                    static_cast<unsigned long>(recordHeader.mTime % 1000), LevelToString(recordHeader.mLevel),
+                    recordHeader.mFormatId);
+        }
+
+        pos += recordHeader.mLength;
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    return error;
+}
+
+} // namespace BinaryLog
+
+} // namespace otbr
@@ -0,0 +1,256 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the binary log, which records raw log arguments and formats them offline.
+ */
+
+#ifndef OTBR_COMMON_BINARY_LOGGING_HPP_
+#define OTBR_COMMON_BINARY_LOGGING_HPP_
+
+#include "openthread-br/config.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+namespace BinaryLog {
+
+/**
+ * The binary log is a file mapped in memory, in native byte order, so that it survives a crash of the process:
+ *
+ *     | FileHeader | formats: FormatHeader + text ... | ring: RecordHeader + arguments ... |
+ *
+ * Each format string is stored once, records only refer to its id and carry the raw arguments. Records never
+ * straddle the end of the ring, a record length of 0 marks the unused end of the ring before wrapping.
+ *
+ */
+enum
+{
+    kMagic         = 0x4c42544f, ///< "OTBL" in little endian.
+    kVersion       = 1,          ///< The version of the binary log layout.
+    kMaxRecordSize = 512,        ///< The max size of a record in bytes, arguments beyond are truncated.
+    kMaxStringArg  = 64,         ///< The max length of a string argument, longer strings are truncated.
+};
+
+/**
+ * The format id of records whose format string did not fit in the format area.
+ *
+ */
+static const uint32_t kUnknownFormat = 0xffffffff;
+
+/**
+ * This structure represents the header of a binary log file.
+ *
+ */
+struct FileHeader
+{
+    uint32_t mMagic;         ///< kMagic.
+    uint16_t mVersion;       ///< kVersion.
+    uint16_t mHeaderSize;    ///< The size of this header.
+    uint32_t mFormatsOffset; ///< The offset of the format area in the file.
+    uint32_t mFormatsSize;   ///< The size of the format area.
+    uint32_t mFormatsUsed;   ///< The bytes used in the format area.
+    uint32_t mFormatCount;   ///< The number of formats stored, also the id of the next format.
+    uint32_t mRingOffset;    ///< The offset of the record ring in the file.
+    uint32_t mRingSize;      ///< The size of the record ring.
+    uint64_t mHead;          ///< The position after the newest record, modulo mRingSize in the ring.
+    uint64_t mTail;          ///< The position of the oldest record, modulo mRingSize in the ring.
+    uint64_t mStartTime;     ///< The time in milliseconds record times are relative to.
+};
+
+/**
+ * This structure represents the header of a format string, followed by the string and its null terminator.
+ *
+ */
+struct FormatHeader
+{
+    uint32_t mId;     ///< The format id.
+    uint16_t mLength; ///< The length of the string, including the null terminator.
+};
+
+/**
+ * This structure represents the header of a record, followed by its arguments.
+ *
+ * Integers and pointers are stored as 64-bit integers, floating point numbers as doubles, and strings as a 8-bit
+ * length followed by the characters.
+ *
+ */
+struct RecordHeader
+{
+    uint16_t mLength;    ///< The length of the record, including this header.
+    uint8_t  mLevel;     ///< The log level.
+    uint8_t  mTruncated; ///< Whether arguments were truncated.
+    uint32_t mFormatId;  ///< The format id.
+    uint32_t mTime;      ///< The time in milliseconds since FileHeader::mStartTime.
+};
+
+/**
+ * This enumeration represents the C type of a printf argument.
+ *
+ */
+enum ArgType : uint8_t
+{
+    kArgNone,       ///< The conversion takes no argument.
+    kArgInt,        ///< int or smaller integers.
+    kArgLong,       ///< long.
+    kArgLongLong,   ///< long long.
+    kArgSize,       ///< size_t or ptrdiff_t.
+    kArgIntMax,     ///< intmax_t.
+    kArgDouble,     ///< double.
+    kArgLongDouble, ///< long double.
+    kArgString,     ///< const char *.
+    kArgPointer,    ///< void *.
+};
+
+/**
+ * This structure represents a conversion specification in a printf format string.
+ *
+ */
+struct Conversion
+{
+    const char *mStart;  ///< The '%' starting the conversion.
+    size_t      mLength; ///< The length of the conversion.
+    uint8_t     mStars;  ///< The number of int arguments for '*' width and precision, preceding the value.
+    ArgType     mType;   ///< The type of the value.
+};
+
+/**
+ * This function finds the next conversion specification in a printf format string.
+ *
+ * @param[in]   aFormat         A pointer to the format string.
+ * @param[out]  aConversion     A reference to the conversion found.
+ *
+ * @returns A pointer to the format string after the conversion, NULL if no more conversion.
+ *
+ */
+const char *NextConversion(const char *aFormat, Conversion &aConversion);
+
+/**
+ * This class implements the writer of a binary log.
+ *
+ */
+class Writer
+{
+public:
+    /**
+     * The constructor initializes a closed binary log.
+     *
+     */
+    Writer(void);
+
+    /**
+     * The destructor closes the binary log.
+     *
+     */
+    ~Writer(void);
+
+    /**
+     * This method creates the binary log file and maps it into memory.
+     *
+     * @param[in]   aFilename   The path of the binary log file.
+     * @param[in]   aSize       The size of the binary log file in bytes.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the binary log.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create or map the file.
+     *
+     */
+    otbrError Open(const char *aFilename, uint32_t aSize);
+
+    /**
+     * This method unmaps the binary log file.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method indicates whether the binary log is open.
+     *
+     * @returns Whether the binary log is open.
+     *
+     */
+    bool IsOpen(void) const { return mHeader != NULL; }
+
+    /**
+     * This method records a log without formatting it.
+     *
+     * @param[in]   aLevel      The log level.
+     * @param[in]   aFormat     The format string as in printf, which must outlive the binary log.
+     * @param[in]   aArguments  The arguments of @p aFormat.
+     *
+     */
+    void Record(int aLevel, const char *aFormat, va_list aArguments);
+
+private:
+    struct Format
+    {
+        uint32_t             mId;
+        std::vector<ArgType> mArgTypes;
+    };
+
+    // Format strings are usually literals, so they are cached by address.
+    typedef std::unordered_map<const char *, Format> FormatMap;
+
+    const Format &LookupFormat(const char *aFormat);
+    void          Append(const uint8_t *aRecord, uint16_t aLength);
+
+    std::mutex  mLock;
+    FormatMap   mFormats;
+    FileHeader *mHeader;
+    uint8_t *   mBase;
+    size_t      mSize;
+};
+
+/**
+ * This function decodes a binary log file into text.
+ *
+ * @param[in]   aFilename   The path of the binary log file.
+ * @param[in]   aOutput     The stream to write the text to.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully decoded the binary log.
+ * @retval  OTBR_ERROR_ERRNO    Failed to read the file, or EINVAL if it is not a valid binary log.
+ *
+ */
+otbrError Decode(const char *aFilename, FILE *aOutput);
+
+} // namespace BinaryLog
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_BINARY_LOGGING_HPP_
@@ -38,4 +38,85 @@
 #include <byteswap.h>
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
+namespace otbr {
+namespace Encoding {
+namespace BigEndian {
+
+/**
+ * This function reads an unsigned integer stored in big-endian byte order.
+ *
+ * It does not depend on the byte order of the host, and folds to a constant for constant input.
+ *
+ * @tparam      UintType    The unsigned integer type to read.
+ *
+ * @param[in]   aBuffer     A pointer to the first byte of the integer.
+ * @param[in]   aLength     The number of bytes left to read.
+ * @param[in]   aValue      The value of the bytes already read.
+ *
+ * @returns The unsigned integer.
+ *
+ */
+template <typename UintType>
+constexpr UintType ReadUint(const uint8_t *aBuffer, size_t aLength = sizeof(UintType), UintType aValue = 0)
+{
+    return aLength == 0 ? aValue
+                        : ReadUint<UintType>(aBuffer + 1, aLength - 1,
+                                             static_cast<UintType>(static_cast<UintType>(aValue << 8) | aBuffer[0]));
+}
+
+/**
+ * This function writes an unsigned integer in big-endian byte order.
+ *
+ * @tparam      UintType    The unsigned integer type to write.
+ *
+ * @param[in]   aValue      The unsigned integer.
+ * @param[out]  aBuffer     A pointer to the buffer of at least sizeof(UintType) bytes.
+ *
+ */
+template <typename UintType> inline void WriteUint(UintType aValue, uint8_t *aBuffer)
+{
+    for (size_t i = sizeof(UintType); i > 0; i--)
+    {
+        aBuffer[i - 1] = static_cast<uint8_t>(aValue & 0xff);
+        aValue         = static_cast<UintType>(aValue >> 8);
+    }
+}
+
+constexpr uint16_t ReadUint16(const uint8_t *aBuffer)
+{
+    return ReadUint<uint16_t>(aBuffer);
+}
+
+constexpr uint32_t ReadUint32(const uint8_t *aBuffer)
+{
+    return ReadUint<uint32_t>(aBuffer);
+}
+
+constexpr uint64_t ReadUint64(const uint8_t *aBuffer)
+{
+    return ReadUint<uint64_t>(aBuffer);
+}
+
+inline void WriteUint16(uint16_t aValue, uint8_t *aBuffer)
+{
+    WriteUint(aValue, aBuffer);
+}
+
+inline void WriteUint32(uint32_t aValue, uint8_t *aBuffer)
+{
+    WriteUint(aValue, aBuffer);
+}
+
+inline void WriteUint64(uint64_t aValue, uint8_t *aBuffer)
+{
+    WriteUint(aValue, aBuffer);
+}
+
+} // namespace BigEndian
+} // namespace Encoding
+} // namespace otbr
+
 #endif // OTBR_COMMON_BYTESWAP_HPP_
@@ -0,0 +1,201 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the circular log.
+ */
+
+#include "common/circular_logging.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+namespace CircularLog {
+
+Writer::Writer(void)
+    : mHeader(NULL)
+    , mRing(NULL)
+    , mSize(0)
+{
+}
+
+Writer::~Writer(void)
+{
+    Close();
+}
+
+otbrError Writer::Open(const char *aFilename, uint32_t aSize)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    int       fd    = -1;
+    void *    base;
+
+    VerifyOrExit(!IsOpen(), errno = EALREADY);
+    VerifyOrExit(aSize > sizeof(FileHeader), errno = EINVAL);
+
+    fd = open(aFilename, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    VerifyOrExit(fd >= 0);
+    VerifyOrExit(ftruncate(fd, aSize) == 0);
+
+    base = mmap(NULL, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(base != MAP_FAILED);
+
+    mSize   = aSize;
+    mHeader = static_cast<FileHeader *>(base);
+    mRing   = static_cast<char *>(base) + sizeof(FileHeader);
+
+    memset(mHeader, 0, sizeof(*mHeader));
+    mHeader->mMagic      = kMagic;
+    mHeader->mVersion    = kVersion;
+    mHeader->mHeaderSize = sizeof(FileHeader);
+    mHeader->mRingSize   = aSize - sizeof(FileHeader);
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (fd >= 0)
+    {
+        // The mapping keeps the file open.
+        close(fd);
+    }
+
+    return error;
+}
+
+void Writer::Close(void)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrExit(IsOpen());
+
+    msync(mHeader, mSize, MS_SYNC);
+    munmap(mHeader, mSize);
+    mHeader = NULL;
+    mRing   = NULL;
+    mSize   = 0;
+
+exit:
+    return;
+}
+
+void Writer::Append(const char *aText, size_t aLength)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    size_t                      offset;
+    size_t                      length;
+
+    VerifyOrExit(IsOpen());
+
+    // Only the end of a line longer than the ring is kept.
+    if (aLength > mHeader->mRingSize)
+    {
+        aText += aLength - mHeader->mRingSize;
+        aLength = mHeader->mRingSize;
+    }
+
+    offset = static_cast<size_t>(mHeader->mHead % mHeader->mRingSize);
+    length = mHeader->mRingSize - offset;
+    length = (aLength < length) ? aLength : length;
+
+    memcpy(mRing + offset, aText, length);
+    memcpy(mRing, aText + length, aLength - length);
+
+    // The kernel writes the dirty pages back, a crash of the process loses nothing.
+    mHeader->mHead += aLength;
+
+exit:
+    return;
+}
+
+otbrError Decode(const char *aFilename, FILE *aOutput)
+{
+    otbrError         error = OTBR_ERROR_ERRNO;
+    FILE *            fp    = fopen(aFilename, "rb");
+    std::vector<char> file;
+    FileHeader        header;
+    const char *      ring;
+    long              size;
+    uint64_t          start;
+
+    VerifyOrExit(fp != NULL);
+    VerifyOrExit(fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0);
+    VerifyOrExit(static_cast<size_t>(size) >= sizeof(header), errno = EINVAL);
+
+    file.resize(static_cast<size_t>(size));
+    VerifyOrExit(fread(&file[0], 1, file.size(), fp) == file.size(), errno = EIO);
+
+    memcpy(&header, &file[0], sizeof(header));
+    VerifyOrExit(header.mMagic == kMagic && header.mVersion == kVersion && header.mHeaderSize == sizeof(header),
+                 errno = EINVAL);
+    VerifyOrExit(header.mRingSize > 0 && header.mHeaderSize + header.mRingSize <= file.size(), errno = EINVAL);
+
+    ring  = &file[header.mHeaderSize];
+    start = (header.mHead > header.mRingSize) ? header.mHead - header.mRingSize : 0;
+
+    // The oldest line is partially overwritten once the ring wrapped, skip it.
+    if (start > 0)
+    {
+        while (start < header.mHead && ring[start++ % header.mRingSize] != '\n')
+        {
+        }
+    }
+
+    for (uint64_t pos = start; pos < header.mHead;)
+    {
+        size_t offset = static_cast<size_t>(pos % header.mRingSize);
+        size_t length = header.mRingSize - offset;
+
+        length = (header.mHead - pos < length) ? static_cast<size_t>(header.mHead - pos) : length;
+        VerifyOrExit(fwrite(ring + offset, 1, length, aOutput) == length);
+        pos += length;
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    return error;
+}
+
+} // namespace CircularLog
+
+} // namespace otbr
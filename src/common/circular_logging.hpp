@@ -0,0 +1,156 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the circular log, which keeps the most recent text logs in a fixed size file.
+ */
+
+#ifndef OTBR_COMMON_CIRCULAR_LOGGING_HPP_
+#define OTBR_COMMON_CIRCULAR_LOGGING_HPP_
+
+#include "openthread-br/config.h"
+
+#include <mutex>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+namespace CircularLog {
+
+/**
+ * The circular log is a file mapped in memory, in native byte order, so that it survives a crash of the process:
+ *
+ *     | FileHeader | ring: log lines ... |
+ *
+ * Log lines are copied into the ring as is and wrap around its end, the oldest line may be partially overwritten.
+ *
+ */
+enum
+{
+    kMagic   = 0x4c43544f, ///< "OTCL" in little endian.
+    kVersion = 1,          ///< The version of the circular log layout.
+};
+
+/**
+ * This structure represents the header of a circular log file.
+ *
+ */
+struct FileHeader
+{
+    uint32_t mMagic;      ///< kMagic.
+    uint16_t mVersion;    ///< kVersion.
+    uint16_t mHeaderSize; ///< The size of this header, also the offset of the ring in the file.
+    uint32_t mRingSize;   ///< The size of the ring.
+    uint32_t mReserved;   ///< Reserved, zero.
+    uint64_t mHead;       ///< The number of bytes ever written, modulo mRingSize the position of the next byte.
+};
+
+/**
+ * This class implements the writer of a circular log.
+ *
+ */
+class Writer
+{
+public:
+    /**
+     * The constructor initializes a closed circular log.
+     *
+     */
+    Writer(void);
+
+    /**
+     * The destructor closes the circular log.
+     *
+     */
+    ~Writer(void);
+
+    /**
+     * This method creates the circular log file and maps it into memory.
+     *
+     * @param[in]   aFilename   The path of the circular log file.
+     * @param[in]   aSize       The size of the circular log file in bytes.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the circular log.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create or map the file.
+     *
+     */
+    otbrError Open(const char *aFilename, uint32_t aSize);
+
+    /**
+     * This method unmaps the circular log file.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method indicates whether the circular log is open.
+     *
+     * @returns Whether the circular log is open.
+     *
+     */
+    bool IsOpen(void) const { return mHeader != NULL; }
+
+    /**
+     * This method appends a log line to the circular log.
+     *
+     * @param[in]   aText       A pointer to the log line, including its trailing newline.
+     * @param[in]   aLength     The length of the log line.
+     *
+     */
+    void Append(const char *aText, size_t aLength);
+
+private:
+    std::mutex  mLock;
+    FileHeader *mHeader;
+    char *      mRing;
+    size_t      mSize;
+};
+
+/**
+ * This function writes the complete lines of a circular log file as text, from the oldest to the newest.
+ *
+ * @param[in]   aFilename   The path of the circular log file.
+ * @param[in]   aOutput     The stream to write the text to.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully decoded the circular log.
+ * @retval  OTBR_ERROR_ERRNO    Failed to read the file, or EINVAL if it is not a valid circular log.
+ *
+ */
+otbrError Decode(const char *aFilename, FILE *aOutput);
+
+} // namespace CircularLog
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_CIRCULAR_LOGGING_HPP_
@@ -34,9 +34,12 @@
 #define __APPLE_USE_RFC_3542
 #endif
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_DTLS
+
 #include "common/dtls_mbedtls.hpp"
 
 #include <algorithm>
+#include <new>
 
 #include <assert.h>
 #include <errno.h>
@@ -44,19 +47,82 @@
 #include <unistd.h>
 
 #include "common/code_utils.hpp"
+#include "common/flight_recorder.hpp"
 #include "common/logging.hpp"
 #include "common/time.hpp"
+#include "common/tracepoint.hpp"
 #include "common/types.hpp"
 
+/**
+ * The number of worker threads running DTLS handshakes, 0 to run handshakes on the main loop.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_HANDSHAKE_WORKERS
+#define OTBR_CONFIG_DTLS_HANDSHAKE_WORKERS 0
+#endif
+
+/**
+ * The max number of ClientHellos per second accepted from a source address without a session.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_ADMISSION_RATE
+#define OTBR_CONFIG_DTLS_ADMISSION_RATE 8
+#endif
+
+/**
+ * The max number of DTLS sessions kept for resumption.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_SESSION_CACHE_SIZE
+#define OTBR_CONFIG_DTLS_SESSION_CACHE_SIZE 8
+#endif
+
+/**
+ * The lifetime in seconds of cached DTLS sessions and session tickets.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_SESSION_TIMEOUT
+#define OTBR_CONFIG_DTLS_SESSION_TIMEOUT 3600
+#endif
+
+/**
+ * The average number of verbose mbedTLS logs per second, twice as many may come in a burst.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_DEBUG_LOG_RATE
+#define OTBR_CONFIG_DTLS_DEBUG_LOG_RATE 50
+#endif
+
 namespace otbr {
 
 namespace Dtls {
 
+// The session whose handshake runs on this thread, receiving the exported keys.
+static thread_local MbedtlsSession *sHandshakingSession = NULL;
+
+/**
+ * This class makes the logs of the calling thread belong to a session, until it goes out of scope.
+ *
+ */
+class LogSessionScope
+{
+public:
+    explicit LogSessionScope(uint32_t aSession)
+        : mPrevious(otbrLogSetSession(aSession))
+    {
+    }
+
+    ~LogSessionScope(void) { otbrLogSetSession(mPrevious); }
+
+private:
+    uint32_t mPrevious;
+};
+
 static int FromOtbrLogLevel(void)
 {
     int level = 0;
 
-    switch (otbrLogGetLevel())
+    switch (otbrLogGetEffectiveLevel(OTBR_LOG_MODULE_DTLS))
     {
     case OTBR_LOG_EMERG:
     case OTBR_LOG_ALERT:
@@ -123,9 +189,15 @@ void MbedtlsServer::MbedtlsDebug(int aLevel, const char *aFile, int aLine, const
         break;
     }
 
-    if (level != 0)
+    // Verbose mbedTLS logs come for each record, and are throttled not to slow down the handshakes.
+    if (level == OTBR_LOG_DEBUG)
+    {
+        otbrLogThrottled(OTBR_CONFIG_DTLS_DEBUG_LOG_RATE, OTBR_CONFIG_DTLS_DEBUG_LOG_RATE * 2, level,
+                         "DTLS[:%hu] %s:%04d: %s", mPort, aFile, aLine, aMessage);
+    }
+    else if (level != 0)
     {
-        otbrLog(aLevel, "DTLS[:%hu] %s:%04d: %s", mPort, aFile, aLine, aMessage);
+        otbrLog(level, "DTLS[:%hu] %s:%04d: %s", mPort, aFile, aLine, aMessage);
     }
 }
 
@@ -149,8 +221,26 @@ otbrError MbedtlsServer::Start(void)
     mbedtls_ssl_cookie_init(&mCookie);
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_init(&mCache);
+    mbedtls_ssl_cache_set_max_entries(&mCache, OTBR_CONFIG_DTLS_SESSION_CACHE_SIZE);
+    mbedtls_ssl_cache_set_timeout(&mCache, OTBR_CONFIG_DTLS_SESSION_TIMEOUT);
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_init(&mTicket);
 #endif
+    memset(mAdmissionSources, 0, sizeof(mAdmissionSources));
     mbedtls_entropy_init(&mEntropy);
+
+    if (mSessionPool.empty())
+    {
+        mSessionPool.resize(OTBR_CONFIG_DTLS_MAX_SESSIONS);
+        mFreeSessionSlots.reserve(mSessionPool.size());
+        mSessions.reserve(mSessionPool.size());
+
+        for (SessionPool::iterator it = mSessionPool.begin(); it != mSessionPool.end(); ++it)
+        {
+            mFreeSessionSlots.push_back(&*it);
+        }
+    }
     mbedtls_ctr_drbg_init(&mCtrDrbg);
 
     // Allow all debug message here and filter in MbedtlsDebug().
@@ -161,7 +251,7 @@ otbrError MbedtlsServer::Start(void)
     SuccessOrExit(error = mbedtls_ssl_config_defaults(&mConf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
                                                       MBEDTLS_SSL_PRESET_DEFAULT));
 
-    mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mCtrDrbg);
+    mbedtls_ssl_conf_rng(&mConf, Random, this);
     mbedtls_ssl_conf_min_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
     mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
     mbedtls_ssl_conf_dbg(&mConf, MbedtlsDebug, this);
@@ -169,15 +259,27 @@ otbrError MbedtlsServer::Start(void)
     mbedtls_ssl_conf_read_timeout(&mConf, 0);
 
 #if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_conf_session_cache(&mConf, &mCache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+    mbedtls_ssl_conf_session_cache(&mConf, this, GetCache, SetCache);
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+    SuccessOrExit(error = mbedtls_ssl_ticket_setup(&mTicket, Random, this, MBEDTLS_CIPHER_AES_128_GCM,
+                                                   OTBR_CONFIG_DTLS_SESSION_TIMEOUT));
+    mbedtls_ssl_conf_session_tickets_cb(&mConf, WriteTicket, ParseTicket, this);
 #endif
 
     SuccessOrExit(error = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, &mCtrDrbg));
 
-    mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check, &mCookie);
+    mbedtls_ssl_conf_dtls_cookies(&mConf, WriteCookie, CheckCookie, this);
+    mbedtls_ssl_conf_export_keys_cb(&mConf, MbedtlsSession::ExportKeys, NULL);
 
     SuccessOrExit(ret = Bind());
 
+    if (OTBR_CONFIG_DTLS_HANDSHAKE_WORKERS > 0)
+    {
+        SuccessOrExit(ret = mHandshakeCompletions.Init());
+        mHandshakeWorkers.Start(OTBR_CONFIG_DTLS_HANDSHAKE_WORKERS);
+    }
+
 exit:
 
     if (error != 0)
@@ -189,6 +291,81 @@ exit:
     return ret;
 }
 
+int MbedtlsServer::Random(void *aContext, unsigned char *aBuffer, size_t aLength)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mCryptoLock);
+
+    return mbedtls_ctr_drbg_random(&server.mCtrDrbg, aBuffer, aLength);
+}
+
+int MbedtlsServer::WriteCookie(void *               aContext,
+                               unsigned char **     aBuffer,
+                               unsigned char *      aEnd,
+                               const unsigned char *aClientId,
+                               size_t               aClientIdLength)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mCryptoLock);
+
+    return mbedtls_ssl_cookie_write(&server.mCookie, aBuffer, aEnd, aClientId, aClientIdLength);
+}
+
+int MbedtlsServer::CheckCookie(void *               aContext,
+                               const unsigned char *aCookie,
+                               size_t               aCookieLength,
+                               const unsigned char *aClientId,
+                               size_t               aClientIdLength)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mCryptoLock);
+
+    // Every peer returns a valid cookie, a source address seen before may be spoofed. Returning peers save the full
+    // handshake by resuming their session instead.
+    return mbedtls_ssl_cookie_check(&server.mCookie, aCookie, aCookieLength, aClientId, aClientIdLength);
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+int MbedtlsServer::GetCache(void *aContext, mbedtls_ssl_session *aSession)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mCryptoLock);
+
+    return mbedtls_ssl_cache_get(&server.mCache, aSession);
+}
+
+int MbedtlsServer::SetCache(void *aContext, const mbedtls_ssl_session *aSession)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mCryptoLock);
+
+    return mbedtls_ssl_cache_set(&server.mCache, aSession);
+}
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+int MbedtlsServer::WriteTicket(void *                     aContext,
+                               const mbedtls_ssl_session *aSession,
+                               unsigned char *            aStart,
+                               const unsigned char *      aEnd,
+                               size_t *                   aLength,
+                               uint32_t *                 aLifetime)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mTicketLock);
+
+    return mbedtls_ssl_ticket_write(&server.mTicket, aSession, aStart, aEnd, aLength, aLifetime);
+}
+
+int MbedtlsServer::ParseTicket(void *aContext, mbedtls_ssl_session *aSession, unsigned char *aBuffer, size_t aLength)
+{
+    MbedtlsServer &             server = *static_cast<MbedtlsServer *>(aContext);
+    std::lock_guard<std::mutex> lock(server.mTicketLock);
+
+    return mbedtls_ssl_ticket_parse(&server.mTicket, aSession, aBuffer, aLength);
+}
+#endif
+
 otbrError MbedtlsServer::Bind(void)
 {
     otbrError           ret = OTBR_ERROR_ERRNO;
@@ -220,6 +397,9 @@ exit:
 
 void MbedtlsSession::SetState(State aState)
 {
+    // The session is identified by the low bits of its address.
+    RecordFlightEvent(kFlightEventDtlsState, static_cast<uint16_t>(aState),
+                      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)));
     mState = aState;
     mServer.HandleSessionState(*this, aState);
 }
@@ -232,28 +412,110 @@ void MbedtlsSession::SetDataHandler(DataHandler aDataHandler, void *aContext)
 
 ssize_t MbedtlsSession::Write(const uint8_t *aBuffer, uint16_t aLength)
 {
-    int ret;
+    ssize_t ret = MBEDTLS_ERR_SSL_WANT_WRITE;
+
+    OTBR_TRACEPOINT2(dtls__write__begin, this, aLength);
+    VerifyOrExit(!mClosing, ret = MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
 
-    do
+    // Records are written in order, nothing is written while others are queued.
+    if (mWriteQueue.empty())
     {
         ret = mbedtls_ssl_write(&mSsl, aBuffer, aLength);
-    } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+    }
 
-    if (ret < 0)
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+    {
+        VerifyOrExit(mWriteQueue.size() < kMaxPendingWrites, ret = MBEDTLS_ERR_SSL_WANT_WRITE);
+
+        mWantWrite = mWantWrite || ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+        mWriteQueue.push_back(Datagram(aBuffer, aBuffer + aLength));
+        ret = aLength;
+    }
+    else if (ret < 0)
     {
         SetState(kStateError);
     }
 
+exit:
+    OTBR_TRACEPOINT2(dtls__write__end, this, ret);
     return ret;
 }
 
+void MbedtlsSession::FlushWrites(void)
+{
+    int ret;
+
+    VerifyOrExit(!mHandshakeBusy);
+
+    while (!mWriteQueue.empty())
+    {
+        const Datagram &record = mWriteQueue.front();
+
+        // mbedtls expects the same data again after it asked to retry.
+        ret = mbedtls_ssl_write(&mSsl, &record[0], record.size());
+
+        if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+        {
+            mWantWrite = (ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+            ExitNow();
+        }
+
+        if (ret < 0)
+        {
+            otbrLog(OTBR_LOG_ERR, "DTLS write error: -0x%04x!", -ret);
+            mWriteQueue.clear();
+            mClosing = false;
+            SetState(kStateError);
+            ExitNow();
+        }
+
+        mWriteQueue.pop_front();
+    }
+
+    if (mClosing)
+    {
+        ret = mbedtls_ssl_close_notify(&mSsl);
+
+        if (ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+        {
+            mWantWrite = true;
+            ExitNow();
+        }
+
+        mClosing = false;
+        SetState(kStateEnd);
+    }
+
+exit:
+    return;
+}
+
+void MbedtlsSession::ProcessWritable(void)
+{
+    LogSessionScope logSession(mId);
+
+    VerifyOrExit(!mHandshakeBusy);
+    mWantWrite = false;
+
+    if (mState == kStateHandshaking && !mClosing)
+    {
+        Handshake();
+    }
+    else
+    {
+        FlushWrites();
+    }
+
+exit:
+    return;
+}
+
 void MbedtlsSession::Close(void)
 {
-    VerifyOrExit(mState != kStateError && mState != kStateEnd);
+    VerifyOrExit(mState != kStateError && mState != kStateEnd && !mClosing);
 
-    while (mbedtls_ssl_close_notify(&mSsl) == MBEDTLS_ERR_SSL_WANT_WRITE)
-        ;
-    SetState(kStateEnd);
+    mClosing = true;
+    FlushWrites();
 
 exit:
     return;
@@ -261,19 +523,41 @@ exit:
 
 MbedtlsSession::~MbedtlsSession(void)
 {
+    LogSessionScope logSession(mId);
+
     Close();
-    // In case session socket is not actually created.
-    if (mNet.fd != mServer.mSocket)
+
+    if (mClosing)
     {
-        mbedtls_net_free(&mNet);
+        otbrLog(OTBR_LOG_WARNING, "DTLS session destroyed before close notify was sent.");
     }
+
     mbedtls_ssl_free(&mSsl);
     otbrLog(OTBR_LOG_INFO, "DTLS session destroyed: %d.", mState);
 }
 
-void MbedtlsSession::Process(void)
+void MbedtlsSession::HandleExpirationTimer(Timer &aTimer, void *aContext)
 {
-    mExpiration = GetNow() + kSessionTimeout;
+    MbedtlsSession *session = static_cast<MbedtlsSession *>(aContext);
+
+    (void)aTimer;
+    session->mServer.HandleSessionExpired(*session);
+}
+
+void MbedtlsSession::Process(const uint8_t *aBuffer, uint16_t aLength)
+{
+    LogSessionScope logSession(mId);
+
+    mExpirationTimer.Start(kSessionTimeout);
+
+    if (mState == kStateHandshaking && mServer.mHandshakeWorkers.IsRunning())
+    {
+        QueueHandshake(aBuffer, aLength);
+        ExitNow();
+    }
+
+    mReceiveBuffer = aBuffer;
+    mReceiveLength = aLength;
 
     switch (mState)
     {
@@ -283,11 +567,23 @@ void MbedtlsSession::Process(void)
 
     case kStateReady:
         Read();
+
+        if (mState == kStateReady)
+        {
+            FlushWrites();
+        }
         break;
 
     default:
         break;
     }
+
+    // The datagram belongs to the caller and is only valid during this call.
+    mReceiveBuffer = NULL;
+    mReceiveLength = 0;
+
+exit:
+    return;
 }
 
 int MbedtlsSession::Read(void)
@@ -295,6 +591,7 @@ int MbedtlsSession::Read(void)
     uint8_t buffer[kMaxSizeOfPacket];
     int     ret = 0;
 
+    OTBR_TRACEPOINT1(dtls__read__begin, this);
     ret = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer));
 
     if (ret > 0)
@@ -329,6 +626,11 @@ int MbedtlsSession::Read(void)
             ret = 0;
             break;
 
+        case MBEDTLS_ERR_SSL_WANT_WRITE:
+            mWantWrite = true;
+            ret        = 0;
+            break;
+
         default:
             otbrLog(OTBR_LOG_ERR, "DTLS read error: -0x%04x!", -ret);
             SetState(kStateError);
@@ -336,6 +638,7 @@ int MbedtlsSession::Read(void)
         }
     }
 
+    OTBR_TRACEPOINT2(dtls__read__end, this, ret);
     return ret;
 } // namespace Dtls
 
@@ -351,22 +654,38 @@ int MbedtlsSession::ExportKeys(void *               aContext,
     mbedtls_sha256_init(&sha256);
     mbedtls_sha256_starts(&sha256, 0);
     mbedtls_sha256_update(&sha256, aKeyBlock, 2 * static_cast<uint16_t>(aMacLength + aKeyLength + aIvLength));
-    mbedtls_sha256_finish(&sha256, static_cast<MbedtlsSession *>(aContext)->mKek);
+    if (sHandshakingSession != NULL)
+    {
+        mbedtls_sha256_finish(&sha256, sHandshakingSession->mKek);
+    }
+
+    mbedtls_sha256_free(&sha256);
 
+    (void)aContext;
     (void)aMasterSecret;
     return 0;
 }
 
 MbedtlsSession::MbedtlsSession(MbedtlsServer &            aServer,
-                               const mbedtls_net_context &aNet,
                                const struct sockaddr_in6 &aRemoteSock,
                                const sockaddr_in6 &       aLocalSock)
-    : mNet(aNet)
-    , mRemoteSock(aRemoteSock)
+    : mRemoteSock(aRemoteSock)
     , mLocalSock(aLocalSock)
     , mServer(aServer)
+    , mId(aServer.mCounters.mAcceptedSessions + 1)
+    , mExpirationTimer(HandleExpirationTimer, this)
     , mIsTimerSet(false)
+    , mReceiveBuffer(NULL)
+    , mReceiveLength(0)
+    , mWantWrite(false)
+    , mClosing(false)
+    , mHandshakeBusy(false)
+    , mOffloaded(false)
+    , mHandshakeResult(0)
+    , mHandshakeStart(GetNow())
+    , mStepStart(0)
 {
+    memset(&mHandshakeStats, 0, sizeof(mHandshakeStats));
 }
 
 void MbedtlsSession::SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal)
@@ -425,6 +744,8 @@ otbrError MbedtlsSession::Init(void)
     otbrError error = OTBR_ERROR_NONE;
     int       rval  = 0;
 
+    // The level of the DTLS logs may be changed at runtime, and applies from the next session.
+    mbedtls_debug_set_threshold(FromOtbrLogLevel());
     mbedtls_ssl_init(&mSsl);
     SuccessOrExit(rval = mbedtls_ssl_setup(&mSsl, &mServer.mConf));
 
@@ -450,62 +771,238 @@ exit:
 
 int MbedtlsSession::ReadMbedtls(unsigned char *aBuffer, size_t aLength)
 {
-    return mbedtls_net_recv(&mNet, aBuffer, aLength);
+    int ret;
+
+    VerifyOrExit(mReceiveBuffer != NULL, ret = MBEDTLS_ERR_SSL_WANT_READ);
+
+    if (aLength > mReceiveLength)
+    {
+        aLength = mReceiveLength;
+    }
+
+    memcpy(aBuffer, mReceiveBuffer, aLength);
+    ret            = static_cast<int>(aLength);
+    mReceiveBuffer = NULL;
+    mReceiveLength = 0;
+
+exit:
+    return ret;
 }
 
 int MbedtlsSession::SendMbedtls(const unsigned char *aBuffer, size_t aLength)
 {
-    int  opt = 1;
-    int &fd  = mNet.fd;
-    int  ret = 0;
+    int ret;
+
+    // The main loop owns the socket, datagrams of an offloaded handshake step are sent when it completes.
+    if (mOffloaded)
+    {
+        mOutputs.push_back(Datagram(aBuffer, aBuffer + aLength));
+        ret = static_cast<int>(aLength);
+    }
+    else
+    {
+        ret = SendDatagram(aBuffer, aLength);
+    }
+
+    return ret;
+}
+
+size_t MbedtlsSession::GetMemoryUsage(void) const
+{
+    // mbedtls allocates an input and an output record buffer of MBEDTLS_SSL_MAX_CONTENT_LEN plus framing.
+    size_t usage = sizeof(*this) + 2 * MBEDTLS_SSL_MAX_CONTENT_LEN + mInput.capacity();
+
+    for (DatagramQueue::const_iterator it = mWriteQueue.begin(); it != mWriteQueue.end(); ++it)
+    {
+        usage += it->capacity();
+    }
+
+    for (DatagramQueue::const_iterator it = mInputs.begin(); it != mInputs.end(); ++it)
+    {
+        usage += it->capacity();
+    }
+
+    for (DatagramList::const_iterator it = mOutputs.begin(); it != mOutputs.end(); ++it)
+    {
+        usage += it->capacity();
+    }
+
+    return usage;
+}
+
+int MbedtlsSession::SendDatagram(const unsigned char *aBuffer, size_t aLength)
+{
+    uint8_t       control[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+    struct msghdr msghdr;
+    struct iovec  iov;
+    ssize_t       ret;
 
-    VerifyOrExit((fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) != -1, ret = -1);
-    SuccessOrExit(ret = setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)));
-    SuccessOrExit(ret = bind(fd, reinterpret_cast<const struct sockaddr *>(&mLocalSock), sizeof(mLocalSock)));
-    SuccessOrExit(ret = connect(fd, reinterpret_cast<const struct sockaddr *>(&mRemoteSock), sizeof(mRemoteSock)));
-    SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
-    mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
-    VerifyOrExit((ret = mbedtls_net_send(&mNet, aBuffer, aLength)) != -1);
+    // Datagrams sent while the server dispatches a batch go out together with a single sendmmsg().
+    VerifyOrExit(!mServer.mBatchSends || aLength > kMaxSizeOfPacket,
+                 ret = mServer.QueueDatagram(aBuffer, aLength, mRemoteSock, mLocalSock));
+
+    MbedtlsServer::InitSendHeader(msghdr, iov, const_cast<unsigned char *>(aBuffer), aLength, control, sizeof(control),
+                                  mRemoteSock, mLocalSock);
+    ret = sendmsg(mServer.mSocket, &msghdr, MSG_DONTWAIT);
+
+    if (ret < 0)
+    {
+        ret = (errno == EAGAIN || errno == EWOULDBLOCK) ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_NET_SEND_FAILED;
+    }
 
 exit:
-    return ret;
+    return static_cast<int>(ret);
 }
 
 int MbedtlsSession::Handshake(void)
 {
-    int ret = 0;
+    int           ret   = 0;
+    unsigned long start = GetNow();
 
     VerifyOrExit(mState == kStateHandshaking, otbrLog(OTBR_LOG_ERR, "Invalid DTLS session state!"));
 
-    otbrLog(OTBR_LOG_INFO, "DTLS handshaking...");
+    otbrLogTrace("DTLS handshaking...");
+
+    OTBR_TRACEPOINT1(dtls__handshake__begin, this);
+    ret = RunHandshake();
+    OTBR_TRACEPOINT2(dtls__handshake__end, this, ret);
+    HandleHandshakeResult(ret, GetNow() - start);
 
-    SuccessOrExit(ret = mbedtls_ssl_handshake(&mSsl));
+exit:
+    return ret;
+}
 
-    otbrLog(OTBR_LOG_INFO, "DTLS session ready.");
+int MbedtlsSession::RunHandshake(void)
+{
+    int ret;
 
-    SetState(kStateReady);
+    sHandshakingSession = this;
+    ret                 = mbedtls_ssl_handshake(&mSsl);
+    sHandshakingSession = NULL;
 
-exit:
+    return ret;
+}
 
-    if (ret)
+void MbedtlsSession::HandleHandshakeResult(int aResult, unsigned long aStepTime)
+{
+    ++mHandshakeStats.mSteps;
+    ++mServer.mCounters.mHandshakeSteps;
+
+    if (aStepTime > mHandshakeStats.mMaxStepTime)
     {
-        if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+        mHandshakeStats.mMaxStepTime = static_cast<uint32_t>(aStepTime);
+    }
+
+    if (aResult == 0)
+    {
+        mHandshakeStats.mHandshakeTime = static_cast<uint32_t>(GetNow() - mHandshakeStart);
+        otbrLog(OTBR_LOG_INFO, "DTLS session ready in %u ms, using %zu bytes.", mHandshakeStats.mHandshakeTime,
+                GetMemoryUsage());
+        SetState(kStateReady);
+    }
+    else if (aResult == MBEDTLS_ERR_SSL_WANT_READ || aResult == MBEDTLS_ERR_SSL_WANT_WRITE)
+    {
+        otbrLogTrace("DTLS handshake pending: -0x%04x.", -aResult);
+        mWantWrite = (aResult == MBEDTLS_ERR_SSL_WANT_WRITE);
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_ERR, "DTLS handshake failed: -0x%04x!", -aResult);
+        if (aResult != MBEDTLS_ERR_SSL_HELLO_VERIFY_REQUIRED)
         {
-            otbrLog(OTBR_LOG_INFO, "DTLS handshake pending: -0x%04x.", -ret);
+            mbedtls_ssl_send_alert_message(&mSsl, MBEDTLS_SSL_ALERT_LEVEL_FATAL,
+                                           MBEDTLS_SSL_ALERT_MSG_HANDSHAKE_FAILURE);
         }
-        else
+        mState = kStateError;
+    }
+}
+
+void MbedtlsSession::QueueHandshake(const uint8_t *aBuffer, uint16_t aLength)
+{
+    VerifyOrExit(mInputs.size() < kMaxPendingInputs, ++mServer.mCounters.mDroppedDatagrams;
+                 otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS handshake queue full!"));
+
+    mInputs.push_back(Datagram(aBuffer, aBuffer + aLength));
+    mHandshakeStats.mQueueDepth = static_cast<uint32_t>(mInputs.size());
+
+    if (mHandshakeStats.mQueueDepth > mHandshakeStats.mMaxQueueDepth)
+    {
+        mHandshakeStats.mMaxQueueDepth = mHandshakeStats.mQueueDepth;
+    }
+
+    if (!mHandshakeBusy)
+    {
+        SubmitHandshake();
+    }
+
+exit:
+    return;
+}
+
+void MbedtlsSession::SubmitHandshake(void)
+{
+    mInput.swap(mInputs.front());
+    mInputs.pop_front();
+    mHandshakeStats.mQueueDepth = static_cast<uint32_t>(mInputs.size());
+
+    // The worker owns mSsl until HandleHandshakeStep() runs on the main loop.
+    mReceiveBuffer = &mInput[0];
+    mReceiveLength = static_cast<uint16_t>(mInput.size());
+    mHandshakeBusy = true;
+    mOffloaded     = true;
+    mStepStart     = GetNow();
+
+    mServer.mHandshakeWorkers.Post([this]() { RunHandshakeStep(); });
+}
+
+void MbedtlsSession::RunHandshakeStep(void)
+{
+    LogSessionScope logSession(mId);
+
+    mHandshakeResult = RunHandshake();
+    mServer.mHandshakeCompletions.Post([this]() { HandleHandshakeStep(); });
+}
+
+void MbedtlsSession::HandleHandshakeStep(void)
+{
+    LogSessionScope logSession(mId);
+
+    mHandshakeBusy = false;
+    mOffloaded     = false;
+    mReceiveBuffer = NULL;
+    mReceiveLength = 0;
+
+    for (DatagramList::iterator it = mOutputs.begin(); it != mOutputs.end(); ++it)
+    {
+        // A flight dropped here is retransmitted by mbedtls.
+        if (SendDatagram(&(*it)[0], it->size()) < 0)
         {
-            otbrLog(OTBR_LOG_ERR, "DTLS handshake failed: -0x%04x!", -ret);
-            if (ret != MBEDTLS_ERR_SSL_HELLO_VERIFY_REQUIRED)
-            {
-                mbedtls_ssl_send_alert_message(&mSsl, MBEDTLS_SSL_ALERT_LEVEL_FATAL,
-                                               MBEDTLS_SSL_ALERT_MSG_HANDSHAKE_FAILURE);
-            }
-            mState = kStateError;
+            ++mServer.mCounters.mDroppedDatagrams;
+            otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS dropped handshake datagram!");
         }
     }
 
-    return ret;
+    mOutputs.clear();
+    HandleHandshakeResult(mHandshakeResult, GetNow() - mStepStart);
+
+    if (mClosing)
+    {
+        FlushWrites();
+    }
+    else if (mState == kStateHandshaking && !mInputs.empty())
+    {
+        SubmitHandshake();
+    }
+
+    // Datagrams received after the final flight carry application data.
+    while (mState == kStateReady && !mInputs.empty())
+    {
+        mInput.swap(mInputs.front());
+        mInputs.pop_front();
+        Process(&mInput[0], static_cast<uint16_t>(mInput.size()));
+    }
+
+    mHandshakeStats.mQueueDepth = static_cast<uint32_t>(mInputs.size());
 }
 
 void MbedtlsServer::UpdateFdSet(fd_set & aReadFdSet,
@@ -514,62 +1011,60 @@ void MbedtlsServer::UpdateFdSet(fd_set & aReadFdSet,
                                 int &    aMaxFd,
                                 timeval &aTimeout)
 {
-    unsigned long now     = GetNow();
-    unsigned long timeout = GetTimestamp(aTimeout);
+    bool wantsWrite = false;
 
-    for (SessionSet::iterator it = mSessions.begin(); it != mSessions.end();)
+    for (SessionMap::iterator it = mSessions.begin(); it != mSessions.end();)
     {
-        MbedtlsSession *session = *it;
-
-        if (session->GetExpiration() <= now)
+        if (it->second->IsAlive() || it->second->IsBusy())
         {
-            otbrLog(OTBR_LOG_INFO, "DTLS session timeout!");
-            HandleSessionState(*session, Session::kStateExpired);
-            delete session;
-            it = mSessions.erase(it);
-        }
-        else if (session->GetState() == Session::kStateReady || session->GetState() == Session::kStateHandshaking)
-        {
-            int fd = session->GetFd();
-
-            otbrLog(OTBR_LOG_INFO, "DTLS session[%d] alive.", fd);
-            FD_SET(fd, &aReadFdSet);
-
-            if (aMaxFd < fd)
-            {
-                aMaxFd = fd;
-            }
-
-            if (static_cast<long>(session->GetExpiration() - (now + timeout)) < 0)
-            {
-                timeout = static_cast<unsigned long>(session->GetExpiration() - now);
-            }
-
-            // TODO error set
+            wantsWrite = wantsWrite || it->second->WantsWrite();
             ++it;
         }
         else
         {
-            delete session;
+            DeleteSession(it->second);
             it = mSessions.erase(it);
         }
     }
 
+    // Datagrams of all sessions arrive on the server socket.
     if (mSocket >= 0)
     {
         FD_SET(mSocket, &aReadFdSet);
 
+        if (wantsWrite)
+        {
+            FD_SET(mSocket, &aWriteFdSet);
+        }
+
         if (aMaxFd < mSocket)
         {
             aMaxFd = mSocket;
         }
     }
 
-    aTimeout.tv_sec  = timeout / 1000;
-    aTimeout.tv_usec = (timeout % 1000) * 1000;
+    mHandshakeCompletions.UpdateFdSet(aReadFdSet, aMaxFd);
 
-    (void)aWriteFdSet;
     (void)aErrorFdSet;
+    (void)aTimeout;
+}
+
+void MbedtlsServer::HandleSessionExpired(MbedtlsSession &aSession)
+{
+    SessionMap::iterator it = mSessions.find(MakeSessionKey(aSession.mRemoteSock, aSession.mLocalSock));
+
+    if (aSession.IsBusy())
+    {
+        // A session is never destroyed under a running handshake step.
+        aSession.mExpirationTimer.Start(MbedtlsSession::kSessionTimeout);
+    }
+    else if (it != mSessions.end() && it->second == &aSession)
+    {
+        otbrLog(OTBR_LOG_INFO, "DTLS session timeout!");
+        HandleSessionState(aSession, Session::kStateExpired);
+        mSessions.erase(it);
+        DeleteSession(&aSession);
+    }
 }
 
 void MbedtlsServer::HandleSessionState(Session &aSession, Session::State aState)
@@ -581,15 +1076,380 @@ void MbedtlsServer::HandleSessionState(Session &aSession, Session::State aState)
     }
 }
 
+bool MbedtlsServer::SessionKey::operator==(const SessionKey &aOther) const
+{
+    return mPeerPort == aOther.mPeerPort &&
+           memcmp(mPeerAddress.s6_addr, aOther.mPeerAddress.s6_addr, sizeof(mPeerAddress.s6_addr)) == 0 &&
+           memcmp(mLocalAddress.s6_addr, aOther.mLocalAddress.s6_addr, sizeof(mLocalAddress.s6_addr)) == 0;
+}
+
+size_t MbedtlsServer::SessionKeyHash::operator()(const SessionKey &aKey) const
+{
+    // FNV-1a over the fields, the padding of the key is not initialized.
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(aKey.mPeerAddress.s6_addr); i++)
+    {
+        hash = (hash ^ aKey.mPeerAddress.s6_addr[i]) * 16777619u;
+        hash = (hash ^ aKey.mLocalAddress.s6_addr[i]) * 16777619u;
+    }
+
+    hash = (hash ^ (aKey.mPeerPort & 0xff)) * 16777619u;
+    hash = (hash ^ (aKey.mPeerPort >> 8)) * 16777619u;
+
+    return hash;
+}
+
+MbedtlsServer::SessionKey MbedtlsServer::MakeSessionKey(const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock)
+{
+    SessionKey key;
+
+    key.mPeerAddress  = aRemoteSock.sin6_addr;
+    key.mLocalAddress = aLocalSock.sin6_addr;
+    key.mPeerPort     = aRemoteSock.sin6_port;
+
+    return key;
+}
+
+void MbedtlsServer::DispatchPacket(const uint8_t *     aBuffer,
+                                   uint16_t            aLength,
+                                   const sockaddr_in6 &aSrc,
+                                   const sockaddr_in6 &aDst)
+{
+    SessionKey           key = MakeSessionKey(aSrc, aDst);
+    SessionMap::iterator it  = mSessions.find(key);
+
+    if (it != mSessions.end() && !it->second->IsAlive())
+    {
+        // The peer starts over after its previous session ended.
+        DeleteSession(it->second);
+        mSessions.erase(it);
+        it = mSessions.end();
+    }
+
+    if (it == mSessions.end())
+    {
+        MbedtlsSession *session;
+
+        // No state is allocated for a peer until it returns a valid cookie.
+        VerifyOrExit(AdmitPeer(aBuffer, aLength, aSrc, aDst));
+
+        session = NewSession(aSrc, aDst);
+
+        if (session == NULL)
+        {
+            ++mCounters.mRejectedSessions;
+            otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS rejected session, all %zu sessions are in use.",
+                               mSessionPool.size());
+            ExitNow();
+        }
+
+        ++mCounters.mAcceptedSessions;
+        otbrLogTrace("DTLS accepting new session...");
+        VerifyOrExit(session->Init() == OTBR_ERROR_NONE, DeleteSession(session));
+
+        it = mSessions.insert(std::make_pair(key, session)).first;
+    }
+
+    it->second->Process(aBuffer, aLength);
+
+exit:
+    return;
+}
+
+void MbedtlsServer::InitSendHeader(struct msghdr &     aHeader,
+                                   struct iovec &      aIov,
+                                   uint8_t *           aPacket,
+                                   size_t              aLength,
+                                   uint8_t *           aControl,
+                                   size_t              aControlSize,
+                                   sockaddr_in6 &      aPeerSock,
+                                   const sockaddr_in6 &aLocalSock)
+{
+    struct cmsghdr *    cmsg;
+    struct in6_pktinfo *pktinfo;
+
+    // All sessions send through the server socket, the source address is the one the peer sent to.
+    memset(&aHeader, 0, sizeof(aHeader));
+    memset(aControl, 0, aControlSize);
+    aIov.iov_base          = aPacket;
+    aIov.iov_len           = aLength;
+    aHeader.msg_name       = &aPeerSock;
+    aHeader.msg_namelen    = sizeof(aPeerSock);
+    aHeader.msg_iov        = &aIov;
+    aHeader.msg_iovlen     = 1;
+    aHeader.msg_control    = aControl;
+    aHeader.msg_controllen = aControlSize;
+
+    cmsg             = CMSG_FIRSTHDR(&aHeader);
+    cmsg->cmsg_level = IPPROTO_IPV6;
+    cmsg->cmsg_type  = IPV6_PKTINFO;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(struct in6_pktinfo));
+
+    pktinfo               = reinterpret_cast<struct in6_pktinfo *>(CMSG_DATA(cmsg));
+    pktinfo->ipi6_addr    = aLocalSock.sin6_addr;
+    pktinfo->ipi6_ifindex = aLocalSock.sin6_scope_id;
+}
+
+int MbedtlsServer::QueueDatagram(const uint8_t *     aBuffer,
+                                 size_t              aLength,
+                                 const sockaddr_in6 &aPeerSock,
+                                 const sockaddr_in6 &aLocalSock)
+{
+    OutgoingDatagram *datagram;
+
+    if (mSendCount == kMaxPendingSends)
+    {
+        FlushSends();
+    }
+
+    datagram = &mSendRing[mSendCount];
+    memcpy(datagram->mPacket, aBuffer, aLength);
+    datagram->mPeerSock = aPeerSock;
+    InitSendHeader(mSendHeaders[mSendCount].msg_hdr, datagram->mIov, datagram->mPacket, aLength, datagram->mControl,
+                   sizeof(datagram->mControl), datagram->mPeerSock, aLocalSock);
+    ++mSendCount;
+
+    return static_cast<int>(aLength);
+}
+
+void MbedtlsServer::FlushSends(void)
+{
+    unsigned sent = 0;
+
+    while (sent < mSendCount)
+    {
+#ifdef __linux__
+        int ret = sendmmsg(mSocket, &mSendHeaders[sent], mSendCount - sent, MSG_DONTWAIT);
+#else
+        int ret = (sendmsg(mSocket, &mSendHeaders[sent].msg_hdr, MSG_DONTWAIT) < 0) ? -1 : 1;
+#endif
+
+        if (ret > 0)
+        {
+            sent += static_cast<unsigned>(ret);
+            continue;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        // Lost datagrams are retransmitted by mbedtls during handshakes and by CoAP afterwards.
+        ++mCounters.mDroppedDatagrams;
+        otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS dropped datagram: %s.", strerror(errno));
+        ++sent;
+    }
+
+    mSendCount = 0;
+}
+
+int MbedtlsServer::ReceiveDatagrams(void)
+{
+    for (int i = 0; i < kMaxPacketsPerProcess; i++)
+    {
+        IncomingDatagram &datagram = mReceiveRing[i];
+        struct msghdr &   msghdr   = mReceiveHeaders[i].msg_hdr;
+
+        // The kernel updates the name and control lengths, so that the headers are reset before every batch.
+        memset(&msghdr, 0, sizeof(msghdr));
+        memset(&datagram.mPeerSock, 0, sizeof(datagram.mPeerSock));
+        datagram.mIov.iov_base = datagram.mPacket;
+        datagram.mIov.iov_len  = sizeof(datagram.mPacket);
+        msghdr.msg_name        = &datagram.mPeerSock;
+        msghdr.msg_namelen     = sizeof(datagram.mPeerSock);
+        msghdr.msg_iov         = &datagram.mIov;
+        msghdr.msg_iovlen      = 1;
+        msghdr.msg_control     = datagram.mControl;
+        msghdr.msg_controllen  = sizeof(datagram.mControl);
+    }
+
+#ifdef __linux__
+    return recvmmsg(mSocket, mReceiveHeaders, kMaxPacketsPerProcess, MSG_DONTWAIT, NULL);
+#else
+    int count = 0;
+
+    for (; count < kMaxPacketsPerProcess; count++)
+    {
+        ssize_t length = recvmsg(mSocket, &mReceiveHeaders[count].msg_hdr, MSG_DONTWAIT);
+
+        if (length < 0)
+        {
+            break;
+        }
+
+        mReceiveHeaders[count].msg_len = static_cast<unsigned int>(length);
+    }
+
+    return count > 0 ? count : -1;
+#endif
+}
+
+bool MbedtlsServer::AdmitPeer(const uint8_t *     aBuffer,
+                              uint16_t            aLength,
+                              const sockaddr_in6 &aSrc,
+                              const sockaddr_in6 &aDst)
+{
+    enum
+    {
+        kRecordHeaderSize    = 13,
+        kHandshakeHeaderSize = 12,
+        kContentHandshake    = 22,
+        kClientHello         = 1,
+        kRandomSize          = 32,
+    };
+
+    bool           admitted = false;
+    const uint8_t *end      = aBuffer + aLength;
+    const uint8_t *handshake;
+    const uint8_t *cursor;
+    uint16_t       recordLength;
+    uint32_t       messageLength;
+    uint8_t        cookieLength;
+
+    // Only the first fragment-free ClientHello of epoch 0 starts a session.
+    VerifyOrExit(aLength >= kRecordHeaderSize + kHandshakeHeaderSize, ++mCounters.mInvalidDatagrams);
+    recordLength = static_cast<uint16_t>((aBuffer[11] << 8) | aBuffer[12]);
+    VerifyOrExit(aBuffer[0] == kContentHandshake && aBuffer[3] == 0 && aBuffer[4] == 0 &&
+                     recordLength <= aLength - kRecordHeaderSize,
+                 ++mCounters.mInvalidDatagrams);
+
+    handshake     = aBuffer + kRecordHeaderSize;
+    messageLength = (static_cast<uint32_t>(handshake[1]) << 16) | (handshake[2] << 8) | handshake[3];
+    VerifyOrExit(handshake[0] == kClientHello && memcmp(&handshake[1], &handshake[9], 3) == 0 && handshake[6] == 0 &&
+                     handshake[7] == 0 && handshake[8] == 0 &&
+                     messageLength + kHandshakeHeaderSize <= recordLength,
+                 ++mCounters.mInvalidDatagrams);
+
+    VerifyOrExit(!IsRateLimited(aSrc.sin6_addr), ++mCounters.mRateLimitedDatagrams);
+
+    // Skip the client version and random, then the session id, to reach the cookie.
+    cursor = handshake + kHandshakeHeaderSize + 2 + kRandomSize;
+    VerifyOrExit(cursor < end && cursor + 1 + *cursor < end, ++mCounters.mInvalidDatagrams);
+    cursor += 1 + *cursor;
+    cookieLength = *cursor++;
+    VerifyOrExit(cursor + cookieLength <= end, ++mCounters.mInvalidDatagrams);
+
+    if (CheckCookie(this, cursor, cookieLength, reinterpret_cast<const unsigned char *>(&aSrc), sizeof(aSrc)) == 0)
+    {
+        admitted = true;
+    }
+    else
+    {
+        SendHelloVerifyRequest(aBuffer + 5, handshake + 4, aSrc, aDst);
+    }
+
+exit:
+    return admitted;
+}
+
+bool MbedtlsServer::IsRateLimited(const in6_addr &aAddress)
+{
+    unsigned long    now    = GetMainloopNow();
+    AdmissionSource *source = &mAdmissionSources[0];
+
+    // Reuse the entry of this address if any, otherwise replace the one with the oldest window.
+    for (AdmissionSource &admissionSource : mAdmissionSources)
+    {
+        if (admissionSource.mCount != 0 && memcmp(&admissionSource.mAddress, &aAddress, sizeof(aAddress)) == 0)
+        {
+            source = &admissionSource;
+            break;
+        }
+
+        if (admissionSource.mCount == 0 || admissionSource.mWindowStart < source->mWindowStart)
+        {
+            source = &admissionSource;
+        }
+    }
+
+    if (source->mCount == 0 || memcmp(&source->mAddress, &aAddress, sizeof(aAddress)) != 0 ||
+        now - source->mWindowStart >= 1000)
+    {
+        source->mAddress     = aAddress;
+        source->mWindowStart = now;
+        source->mCount       = 0;
+    }
+
+    return ++source->mCount > OTBR_CONFIG_DTLS_ADMISSION_RATE;
+}
+
+void MbedtlsServer::SendHelloVerifyRequest(const uint8_t *     aRecordSequence,
+                                           const uint8_t *     aMessageSequence,
+                                           const sockaddr_in6 &aSrc,
+                                           const sockaddr_in6 &aDst)
+{
+    enum
+    {
+        kHelloVerifyRequest = 3,
+        kBodyOffset         = 25,
+        kMaxSizeOfCookie    = 32,
+    };
+
+    uint8_t        packet[kBodyOffset + 3 + kMaxSizeOfCookie] = {22, 0xfe, 0xfd};
+    unsigned char *cookie                                     = &packet[kBodyOffset + 3];
+    uint16_t       bodyLength;
+
+    SuccessOrExit(WriteCookie(this, &cookie, packet + sizeof(packet), reinterpret_cast<const unsigned char *>(&aSrc),
+                              sizeof(aSrc)));
+    bodyLength = static_cast<uint16_t>(cookie - &packet[kBodyOffset]);
+
+    // RFC 6347 4.2.1, the HelloVerifyRequest echoes the record and message sequence numbers of the ClientHello.
+    memcpy(&packet[5], aRecordSequence, 6);
+    packet[11] = static_cast<uint8_t>((12 + bodyLength) >> 8);
+    packet[12] = static_cast<uint8_t>(12 + bodyLength);
+
+    packet[13] = kHelloVerifyRequest;
+    packet[15] = packet[23] = static_cast<uint8_t>(bodyLength >> 8);
+    packet[16] = packet[24] = static_cast<uint8_t>(bodyLength);
+    memcpy(&packet[17], aMessageSequence, 2);
+
+    packet[kBodyOffset]     = 0xfe;
+    packet[kBodyOffset + 1] = 0xfd;
+    packet[kBodyOffset + 2] = static_cast<uint8_t>(bodyLength - 3);
+
+    ++mCounters.mHelloVerifyRequests;
+    QueueDatagram(packet, kBodyOffset + bodyLength, aSrc, aDst);
+
+exit:
+    return;
+}
+
+MbedtlsSession *MbedtlsServer::NewSession(const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock)
+{
+    MbedtlsSession *session = NULL;
+
+    VerifyOrExit(!mFreeSessionSlots.empty());
+    session = new (mFreeSessionSlots.back()) MbedtlsSession(*this, aRemoteSock, aLocalSock);
+    mFreeSessionSlots.pop_back();
+
+exit:
+    return session;
+}
+
+void MbedtlsServer::DeleteSession(MbedtlsSession *aSession)
+{
+    aSession->~MbedtlsSession();
+    mFreeSessionSlots.push_back(aSession);
+}
+
+size_t MbedtlsServer::GetSessionMemoryUsage(void) const
+{
+    size_t usage = 0;
+
+    for (SessionMap::const_iterator it = mSessions.begin(); it != mSessions.end(); ++it)
+    {
+        usage += it->second->GetMemoryUsage();
+    }
+
+    return usage;
+}
+
 void MbedtlsServer::ProcessServer(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
-    uint8_t       packet[kMaxSizeOfPacket];
-    uint8_t       control[kMaxSizeOfControl];
-    otbrError     error = OTBR_ERROR_ERRNO; // Assume error
-    sockaddr_in6  src;
-    sockaddr_in6  dst;
-    struct msghdr msghdr;
-    struct iovec  iov[1];
+    otbrError error = OTBR_ERROR_ERRNO; // Assume error
+    int       count;
 
     /* Connection is not alive yet, or is shut down */
     VerifyOrExit(mSocket >= 0, error = OTBR_ERROR_NONE);
@@ -597,64 +1457,59 @@ void MbedtlsServer::ProcessServer(const fd_set &aReadFdSet, const fd_set &aWrite
     /* If this is not set, then some other handle became rd/wr able, it is not an error */
     VerifyOrExit(FD_ISSET(mSocket, &aReadFdSet), error = OTBR_ERROR_NONE);
 
-    otbrLog(OTBR_LOG_INFO, "Trying to accept connection...");
-    memset(&src, 0, sizeof(src));
-    memset(&dst, 0, sizeof(dst));
-    memset(&msghdr, 0, sizeof(msghdr));
-    msghdr.msg_name    = &src;
-    msghdr.msg_namelen = sizeof(src);
-    memset(&iov, 0, sizeof(iov));
-    iov[0].iov_base       = packet;
-    iov[0].iov_len        = kMaxSizeOfPacket;
-    msghdr.msg_iov        = iov;
-    msghdr.msg_iovlen     = 1;
-    msghdr.msg_control    = control;
-    msghdr.msg_controllen = sizeof(control);
-
-    VerifyOrExit(recvmsg(mSocket, &msghdr, MSG_PEEK) > 0);
-
-    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msghdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msghdr, cmsg))
-    {
-        if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
-        {
-            const struct in6_pktinfo *pktinfo = reinterpret_cast<const struct in6_pktinfo *>(CMSG_DATA(cmsg));
-            memcpy(dst.sin6_addr.s6_addr, pktinfo->ipi6_addr.s6_addr, sizeof(dst.sin6_addr));
-            dst.sin6_family = AF_INET6;
-            dst.sin6_port   = ntohs(mPort);
-            break;
-        }
+    // Bounded by the ring size so that a flood of datagrams cannot starve the main loop.
+    count = ReceiveDatagrams();
+
+    if (count < 0)
+    {
+        VerifyOrExit(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR, ++mCounters.mReceiveErrors);
+        count = 0;
     }
 
-    VerifyOrExit(memcmp(dst.sin6_addr.s6_addr, in6addr_any.s6_addr, sizeof(dst.sin6_addr)) != 0, errno = EDESTADDRREQ);
+    mBatchSends = true;
 
-    // TODO Should check if this client has an existing session.
+    for (int i = 0; i < count; i++)
     {
-        mbedtls_net_context net = {mSocket};
+        const IncomingDatagram &datagram = mReceiveRing[i];
+        struct msghdr &         msghdr   = mReceiveHeaders[i].msg_hdr;
+        size_t                  length   = mReceiveHeaders[i].msg_len;
+        sockaddr_in6            dst;
 
-        MbedtlsSession *session = new MbedtlsSession(*this, net, src, dst);
+        memset(&dst, 0, sizeof(dst));
+        ++mCounters.mReceivedDatagrams;
 
-        VerifyOrExit(session->Init() == OTBR_ERROR_NONE, delete session);
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msghdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msghdr, cmsg))
+        {
+            if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
+            {
+                const struct in6_pktinfo *pktinfo = reinterpret_cast<const struct in6_pktinfo *>(CMSG_DATA(cmsg));
+                memcpy(dst.sin6_addr.s6_addr, pktinfo->ipi6_addr.s6_addr, sizeof(dst.sin6_addr));
+                dst.sin6_family   = AF_INET6;
+                dst.sin6_port     = htons(mPort);
+                dst.sin6_scope_id = pktinfo->ipi6_ifindex;
+                break;
+            }
+        }
 
-        mSessions.push_back(session);
-        mbedtls_ssl_conf_export_keys_cb(&mConf, MbedtlsSession::ExportKeys, session);
-        session->Process();
+        if (length == 0 || memcmp(dst.sin6_addr.s6_addr, in6addr_any.s6_addr, sizeof(dst.sin6_addr)) == 0)
+        {
+            ++mCounters.mDroppedDatagrams;
+            otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS dropped datagram without destination address.");
+            continue;
+        }
+
+        DispatchPacket(datagram.mPacket, static_cast<uint16_t>(length), datagram.mPeerSock, dst);
     }
 
+    mBatchSends = false;
+    FlushSends();
     error = OTBR_ERROR_NONE;
 
 exit:
+    // Errors of an unconnected UDP socket concern single datagrams, e.g. a pending ICMP error, the socket stays usable.
     if (error)
     {
-        otbrLog(OTBR_LOG_ERR, "DTLS failed to initiate new session: %s.", otbrErrorString(error));
-        otbrLog(OTBR_LOG_INFO, "Trying to create new server socket...");
-        close(mSocket);
-        mSocket = -1;
-
-        if (Bind())
-        {
-            otbrLog(OTBR_LOG_ERR, "Unable create new server socket! Die now!");
-            abort();
-        }
+        otbrLogRateLimited(1000, OTBR_LOG_WARNING, "DTLS failed to receive: %s.", strerror(errno));
     }
 
     (void)aWriteFdSet;
@@ -663,21 +1518,23 @@ exit:
 
 void MbedtlsServer::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
-    for (SessionSet::iterator it = mSessions.begin(); it != mSessions.end(); ++it)
-    {
-        MbedtlsSession *session = *it;
-        int             fd      = session->GetFd();
+    mBatchSends = true;
+    mHandshakeCompletions.Process(aReadFdSet);
+    mBatchSends = false;
+    FlushSends();
 
-        if (FD_ISSET(fd, &aReadFdSet))
+    if (mSocket >= 0 && FD_ISSET(mSocket, &aWriteFdSet))
+    {
+        for (SessionMap::iterator it = mSessions.begin(); it != mSessions.end(); ++it)
         {
-            otbrLog(OTBR_LOG_INFO, "DTLS session [%d] become readable.", fd);
-            session->Process();
+            if (it->second->IsAlive() && it->second->WantsWrite())
+            {
+                it->second->ProcessWritable();
+            }
         }
     }
 
     ProcessServer(aReadFdSet, aWriteFdSet, aErrorFdSet);
-
-    (void)aErrorFdSet;
 }
 
 otbrError MbedtlsServer::SetPSK(const uint8_t *aPSK, uint8_t aLength)
@@ -700,20 +1557,24 @@ exit:
 
 MbedtlsServer::~MbedtlsServer(void)
 {
-    SessionSet::iterator it = mSessions.begin();
+    // No handshake step may run once sessions are destroyed.
+    mHandshakeWorkers.Stop();
 
-    while (it != mSessions.end())
+    for (SessionMap::iterator it = mSessions.begin(); it != mSessions.end(); ++it)
     {
-        MbedtlsSession *session = *it;
-        delete session;
-        it = mSessions.erase(it);
+        DeleteSession(it->second);
     }
 
+    mSessions.clear();
+
     close(mSocket);
     mbedtls_ssl_config_free(&mConf);
     mbedtls_ssl_cookie_free(&mCookie);
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_free(&mCache);
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_free(&mTicket);
 #endif
     mbedtls_ctr_drbg_free(&mCtrDrbg);
     mbedtls_entropy_free(&mEntropy);
@@ -36,12 +36,17 @@
 
 #include "openthread-br/config.h"
 
+#include <deque>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <netinet/in.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
 
 extern "C" {
 
@@ -69,9 +74,26 @@ extern "C" {
 #include <mbedtls/ssl_cache.h>
 #endif
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
+
 } // extern "C"
 
 #include "common/dtls.hpp"
+#include "common/memory_stats.hpp"
+#include "common/static_pool.hpp"
+#include "common/task_queue.hpp"
+#include "common/timer.hpp"
+#include "common/worker_pool.hpp"
+
+/**
+ * The max number of concurrent DTLS sessions, whose memory is allocated when the server starts.
+ *
+ */
+#ifndef OTBR_CONFIG_DTLS_MAX_SESSIONS
+#define OTBR_CONFIG_DTLS_MAX_SESSIONS 32
+#endif
 
 namespace otbr {
 
@@ -94,6 +116,20 @@ enum
     kMaxSizeOfControl = 1500, ///< Max size of control message in bytes.
 };
 
+#ifdef __linux__
+typedef struct mmsghdr DatagramHeader;
+#else
+/**
+ * This structure mirrors struct mmsghdr on platforms without recvmmsg() and sendmmsg().
+ *
+ */
+struct DatagramHeader
+{
+    struct msghdr msg_hdr; ///< The message header.
+    unsigned int  msg_len; ///< The number of bytes received or sent.
+};
+#endif
+
 /**
  * This class implements the DTLS Session functionality based on mbedTLS.
  *
@@ -103,17 +139,28 @@ class MbedtlsSession : public Session
     friend class MbedtlsServer;
 
 public:
+    /**
+     * This structure contains the handshake statistics of a session.
+     *
+     */
+    struct HandshakeStats
+    {
+        uint32_t mSteps;         ///< The number of handshake steps run.
+        uint32_t mQueueDepth;    ///< The number of datagrams waiting for a handshake worker.
+        uint32_t mMaxQueueDepth; ///< The maximum number of datagrams waiting for a handshake worker.
+        uint32_t mMaxStepTime;   ///< The maximum time in milliseconds of a handshake step, including queuing.
+        uint32_t mHandshakeTime; ///< The time in milliseconds from session creation to ready, 0 if not ready.
+    };
+
     /**
      * The constructor to initialize a DTLS session.
      *
      * @param[in]   aServer     A reference to the DTLS server.
-     * @param[in]   aNet        A reference to the mbedtls_net_context.
      * @param[in]   aRemoteSock A reference to the remote sockaddr of this session.
      * @param[in]   aLocalSock  A reference to the local sockaddr of this session.
      *
      */
     MbedtlsSession(MbedtlsServer &            aServer,
-                   const mbedtls_net_context &aNet,
                    const struct sockaddr_in6 &aRemoteSock,
                    const struct sockaddr_in6 &aLocalSock);
 
@@ -128,6 +175,18 @@ public:
      */
     otbrError Init(void);
 
+    /**
+     * This method writes data to the peer without blocking.
+     *
+     * Data which cannot be written because the socket is busy is queued and written when the socket becomes writable.
+     *
+     * @param[in]   aBuffer     A pointer to the data.
+     * @param[in]   aLength     The length of the data.
+     *
+     * @returns The number of bytes written or queued, or a negative mbedtls error. MBEDTLS_ERR_SSL_WANT_WRITE is
+     *          returned when the queue is full.
+     *
+     */
     ssize_t Write(const uint8_t *aBuffer, uint16_t aLength);
     void    SetDataHandler(DataHandler aDataHandler, void *aContext);
 
@@ -140,12 +199,13 @@ public:
     State GetState(void) const { return mState; }
 
     /**
-     * This method returns the underlying unix fd of this session.
+     * This method indicates whether this session is handshaking or ready.
      *
-     * @returns Unix file descriptor.
+     * @retval true     The session is alive.
+     * @retval false    The session has ended.
      *
      */
-    int GetFd(void) const { return mNet.fd; }
+    bool IsAlive(void) const { return mState == kStateHandshaking || mState == kStateReady; }
 
     /**
      * This method returns the expiration of this session.
@@ -153,7 +213,7 @@ public:
      * @returns Expiration in miniseconds.
      *
      */
-    uint64_t GetExpiration() const { return mExpiration; }
+    uint64_t GetExpiration() const { return mExpirationTimer.GetDeadline(); }
 
     /**
      * This method returns the exported KEK of this session.
@@ -163,22 +223,77 @@ public:
     const uint8_t *GetKek(void) { return mKek; }
 
     /**
-     * This method performs the session processing.
+     * This method performs the session processing for a datagram received from the peer.
+     *
+     * @param[in]   aBuffer     A pointer to the datagram.
+     * @param[in]   aLength     The length of the datagram.
      *
      */
-    void Process(void);
+    void Process(const uint8_t *aBuffer, uint16_t aLength);
 
     /**
      * This method closes the DTLS session.
      *
+     * Queued data and the close notify are written without blocking, the session ends once they are sent.
+     *
      */
     void Close(void);
 
+    /**
+     * This method indicates whether this session waits for the socket to become writable.
+     *
+     * @retval true     The session has data blocked by the socket.
+     * @retval false    The session has nothing to write.
+     *
+     */
+    bool WantsWrite(void) const { return mWantWrite; }
+
+    /**
+     * This method continues the operations of this session blocked by the socket.
+     *
+     */
+    void ProcessWritable(void);
+
+    /**
+     * This method indicates whether a handshake step of this session is running on a worker.
+     *
+     * @retval true     The session must not be used or destroyed until the step completes.
+     * @retval false    No handshake step is running.
+     *
+     */
+    bool IsBusy(void) const { return mHandshakeBusy; }
+
+    /**
+     * This method returns the handshake statistics of this session.
+     *
+     * @returns A reference to the handshake statistics.
+     *
+     */
+    const HandshakeStats &GetHandshakeStats(void) const { return mHandshakeStats; }
+
+    /**
+     * This method returns an estimate of the memory used by this session.
+     *
+     * The estimate includes the session object, the mbedtls record buffers and the queued datagrams, but not the
+     * transient handshake state of mbedtls.
+     *
+     * @returns The memory used in bytes.
+     *
+     */
+    size_t GetMemoryUsage(void) const;
+
 private:
+    // The datagrams buffered by a session are accounted to the DTLS memory.
+    typedef std::vector<uint8_t, TaggedAllocator<uint8_t, kMemoryTagDtls>>   Datagram;
+    typedef std::deque<Datagram, TaggedAllocator<Datagram, kMemoryTagDtls>>  DatagramQueue;
+    typedef std::vector<Datagram, TaggedAllocator<Datagram, kMemoryTagDtls>> DatagramList;
+
     enum
     {
-        kSessionTimeout = 60000, ///< Default DTLS session timeout in miniseconds.
-        kKekSize        = 32,    ///< Size of KEK.
+        kSessionTimeout   = 60000, ///< Default DTLS session timeout in miniseconds.
+        kKekSize          = 32,    ///< Size of KEK.
+        kMaxPendingWrites = 8,     ///< Max number of records waiting for the socket.
+        kMaxPendingInputs = 8,     ///< Max number of datagrams waiting for a handshake worker.
     };
 
     static int ExportKeys(void *               aContext,
@@ -188,7 +303,15 @@ private:
                           size_t               aKeyLength,
                           size_t               aIvLength);
     int        Handshake(void);
+    int        RunHandshake(void);
+    void       HandleHandshakeResult(int aResult, unsigned long aStepTime);
+    void       QueueHandshake(const uint8_t *aBuffer, uint16_t aLength);
+    void       SubmitHandshake(void);
+    void       RunHandshakeStep(void);
+    void       HandleHandshakeStep(void);
     int        Read(void);
+    int        SendDatagram(const unsigned char *aBuffer, size_t aLength);
+    void       FlushWrites(void);
     void       SetState(State aState);
     static int SendMbedtls(void *aContext, const unsigned char *aBuffer, size_t aLength)
     {
@@ -202,12 +325,13 @@ private:
     }
     int ReadMbedtls(unsigned char *aBuffer, size_t aLength);
 
+    static void HandleExpirationTimer(Timer &aTimer, void *aContext);
+
     static void SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal);
     void        SetDelay(uint32_t aIntermediate, uint32_t aFinal);
     static int  GetDelay(void *aContext);
     int         GetDelay(void) const;
 
-    mbedtls_net_context mNet;
     mbedtls_ssl_context mSsl;
 
     DataHandler    mDataHandler;
@@ -216,11 +340,29 @@ private:
     sockaddr_in6   mRemoteSock;
     sockaddr_in6   mLocalSock;
     MbedtlsServer &mServer;
-    unsigned long  mExpiration;
+    uint32_t       mId; ///< The session id in logs.
+    Timer          mExpirationTimer;
     uint8_t        mKek[kKekSize];
     unsigned long  mIntermediate;
     unsigned long  mFinal;
     bool           mIsTimerSet;
+    const uint8_t *mReceiveBuffer; ///< The datagram being processed, NULL once consumed.
+    uint16_t       mReceiveLength;
+    bool           mWantWrite; ///< An operation is blocked until the socket becomes writable.
+    bool           mClosing;   ///< The close notify is sent after the queued records.
+
+    DatagramQueue mWriteQueue;
+
+    // Handshake steps offloaded to a worker, mSsl is only used by the worker while mHandshakeBusy is set.
+    bool           mHandshakeBusy;
+    bool           mOffloaded; ///< Datagrams sent by mbedtls are kept in mOutputs.
+    int            mHandshakeResult;
+    unsigned long  mHandshakeStart;
+    unsigned long  mStepStart;
+    Datagram       mInput;
+    DatagramQueue  mInputs;
+    DatagramList   mOutputs;
+    HandshakeStats mHandshakeStats;
 };
 
 /**
@@ -232,6 +374,23 @@ class MbedtlsServer : public Server
     friend class MbedtlsSession;
 
 public:
+    /**
+     * This structure contains the datagram and session counters of the server.
+     *
+     */
+    struct Counters
+    {
+        uint32_t mReceivedDatagrams;    ///< The number of datagrams received.
+        uint32_t mDroppedDatagrams;     ///< The number of datagrams dropped, received or sent.
+        uint32_t mAcceptedSessions;     ///< The number of sessions created.
+        uint32_t mRejectedSessions;     ///< The number of sessions refused because the session pool is exhausted.
+        uint32_t mHelloVerifyRequests;  ///< The number of stateless HelloVerifyRequests sent to unknown peers.
+        uint32_t mRateLimitedDatagrams; ///< The number of ClientHellos dropped by the per-source rate limit.
+        uint32_t mInvalidDatagrams;     ///< The number of datagrams from unknown peers which are no ClientHello.
+        uint32_t mReceiveErrors;        ///< The number of failed receptions on the server socket.
+        uint32_t mHandshakeSteps;       ///< The number of handshake steps run by all sessions.
+    };
+
     /**
      * The constructor to initialize a DTLS server.
      *
@@ -245,7 +404,10 @@ public:
         , mPort(aPort)
         , mStateHandler(aStateHandler)
         , mContext(aContext)
+        , mSendCount(0)
+        , mBatchSends(false)
     {
+        memset(&mCounters, 0, sizeof(mCounters));
     }
 
     ~MbedtlsServer(void);
@@ -307,22 +469,175 @@ public:
      */
     otbrError SetSeed(const uint8_t *aSeed, uint16_t aLength);
 
+    /**
+     * This method returns the datagram and session counters of this server.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+    /**
+     * This method returns the number of sessions the server can hold at once.
+     *
+     * @returns The capacity of the session pool.
+     *
+     */
+    size_t GetSessionCapacity(void) const { return mSessionPool.size(); }
+
+    /**
+     * This method returns an estimate of the memory used by all sessions.
+     *
+     * @returns The memory used in bytes.
+     *
+     */
+    size_t GetSessionMemoryUsage(void) const;
+
 private:
-    typedef std::vector<MbedtlsSession *> SessionSet;
+    /**
+     * This structure identifies a session by the addresses of its datagrams.
+     *
+     */
+    struct SessionKey
+    {
+        bool operator==(const SessionKey &aOther) const;
+
+        in6_addr mPeerAddress;
+        in6_addr mLocalAddress;
+        uint16_t mPeerPort;
+    };
+
+    struct SessionKeyHash
+    {
+        size_t operator()(const SessionKey &aKey) const;
+    };
+
+    typedef std::aligned_storage<sizeof(MbedtlsSession), alignof(MbedtlsSession)>::type SessionSlot;
+
+#if OTBR_ENABLE_STATIC_POOLS
+    // The sessions live in the server and the nodes of their map in a static pool, so only the map buckets are
+    // allocated, once when the server starts.
+    typedef StaticPoolAllocator<std::pair<const SessionKey, MbedtlsSession *>, OTBR_CONFIG_DTLS_MAX_SESSIONS>
+        SessionNodes;
+
+    typedef std::unordered_map<SessionKey, MbedtlsSession *, SessionKeyHash, std::equal_to<SessionKey>, SessionNodes>
+        SessionMap;
+
+    typedef StaticVector<SessionSlot, OTBR_CONFIG_DTLS_MAX_SESSIONS> SessionPool;
+    typedef StaticVector<void *, OTBR_CONFIG_DTLS_MAX_SESSIONS>      SessionSlots;
+#else
+    typedef std::unordered_map<SessionKey, MbedtlsSession *, SessionKeyHash>       SessionMap;
+    typedef std::vector<SessionSlot, TaggedAllocator<SessionSlot, kMemoryTagDtls>> SessionPool;
+    typedef std::vector<void *>                                                    SessionSlots;
+#endif
+
+    /**
+     * This structure counts the ClientHellos of a source address within the current rate limiting window.
+     *
+     */
+    struct AdmissionSource
+    {
+        in6_addr      mAddress;
+        unsigned long mWindowStart;
+        uint32_t      mCount;
+    };
+
     enum
     {
-        kMaxSizeOfPSK = 32, ///< Max size of PSK in bytes.
+        kMaxSizeOfPSK         = 32, ///< Max size of PSK in bytes.
+        kMaxPacketsPerProcess = 16, ///< Max number of datagrams received in one Process() call.
+        kMaxPendingSends      = 16, ///< Max number of datagrams sent in one batch.
+        kMaxAdmissionSources  = 32, ///< Max number of source addresses rate limited at once.
+    };
+
+    /**
+     * This structure holds a slot of the receive ring.
+     *
+     */
+    struct IncomingDatagram
+    {
+        uint8_t      mPacket[kMaxSizeOfPacket];
+        uint8_t      mControl[kMaxSizeOfControl];
+        sockaddr_in6 mPeerSock;
+        iovec        mIov;
     };
 
+    /**
+     * This structure holds a slot of the send ring.
+     *
+     */
+    struct OutgoingDatagram
+    {
+        uint8_t      mPacket[kMaxSizeOfPacket];
+        uint8_t      mControl[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+        sockaddr_in6 mPeerSock;
+        iovec        mIov;
+    };
+
+    static SessionKey MakeSessionKey(const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock);
+
+    // The random generator, cookies and session cache are shared by sessions handshaking on workers.
+    static int Random(void *aContext, unsigned char *aBuffer, size_t aLength);
+    static int WriteCookie(void *               aContext,
+                           unsigned char **     aBuffer,
+                           unsigned char *      aEnd,
+                           const unsigned char *aClientId,
+                           size_t               aClientIdLength);
+    static int CheckCookie(void *               aContext,
+                           const unsigned char *aCookie,
+                           size_t               aCookieLength,
+                           const unsigned char *aClientId,
+                           size_t               aClientIdLength);
+#if defined(MBEDTLS_SSL_CACHE_C)
+    static int GetCache(void *aContext, mbedtls_ssl_session *aSession);
+    static int SetCache(void *aContext, const mbedtls_ssl_session *aSession);
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+    static int WriteTicket(void *                     aContext,
+                           const mbedtls_ssl_session *aSession,
+                           unsigned char *            aStart,
+                           const unsigned char *      aEnd,
+                           size_t *                   aLength,
+                           uint32_t *                 aLifetime);
+    static int ParseTicket(void *aContext, mbedtls_ssl_session *aSession, unsigned char *aBuffer, size_t aLength);
+#endif
+
     void HandleSessionState(Session &aSession, Session::State aState);
+    void HandleSessionExpired(MbedtlsSession &aSession);
     void ProcessServer(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    void DispatchPacket(const uint8_t *aBuffer, uint16_t aLength, const sockaddr_in6 &aSrc, const sockaddr_in6 &aDst);
+
+    bool AdmitPeer(const uint8_t *aBuffer, uint16_t aLength, const sockaddr_in6 &aSrc, const sockaddr_in6 &aDst);
+    bool IsRateLimited(const in6_addr &aAddress);
+    void SendHelloVerifyRequest(const uint8_t *     aRecordSequence,
+                                const uint8_t *     aMessageSequence,
+                                const sockaddr_in6 &aSrc,
+                                const sockaddr_in6 &aDst);
+
+    MbedtlsSession *NewSession(const sockaddr_in6 &aRemoteSock, const sockaddr_in6 &aLocalSock);
+    void            DeleteSession(MbedtlsSession *aSession);
+
+    static void InitSendHeader(struct msghdr &     aHeader,
+                               struct iovec &      aIov,
+                               uint8_t *           aPacket,
+                               size_t              aLength,
+                               uint8_t *           aControl,
+                               size_t              aControlSize,
+                               sockaddr_in6 &      aPeerSock,
+                               const sockaddr_in6 &aLocalSock);
+    int         ReceiveDatagrams(void);
+    int         QueueDatagram(const uint8_t *     aBuffer,
+                              size_t              aLength,
+                              const sockaddr_in6 &aPeerSock,
+                              const sockaddr_in6 &aLocalSock);
+    void        FlushSends(void);
 
     otbrError Bind(void);
 
     static void MbedtlsDebug(void *aContext, int aLevel, const char *aFile, int aLine, const char *aMessage);
     void        MbedtlsDebug(int aLevel, const char *aFile, int aLine, const char *aMessage);
 
-    SessionSet   mSessions;
+    SessionMap   mSessions;
     int          mSocket;
     uint16_t     mPort;
     StateHandler mStateHandler;
@@ -331,6 +646,19 @@ private:
     uint16_t     mSeedLength;
     uint8_t      mPSK[kMaxSizeOfPSK];
     uint8_t      mPSKLength;
+    Counters     mCounters;
+
+    // Sessions are constructed in slots allocated once at start, so the memory used does not grow with sessions.
+    SessionPool  mSessionPool;
+    SessionSlots mFreeSessionSlots;
+
+    // Datagrams are received and sent in batches through preallocated rings, one system call per batch.
+    IncomingDatagram mReceiveRing[kMaxPacketsPerProcess];
+    DatagramHeader   mReceiveHeaders[kMaxPacketsPerProcess];
+    OutgoingDatagram mSendRing[kMaxPendingSends];
+    DatagramHeader   mSendHeaders[kMaxPendingSends];
+    uint8_t          mSendCount;
+    bool             mBatchSends; ///< Datagrams sent by sessions are queued in mSendRing until FlushSends().
 
     mbedtls_ssl_cookie_ctx   mCookie;
     mbedtls_entropy_context  mEntropy;
@@ -339,6 +667,16 @@ private:
 #if defined(MBEDTLS_SSL_CACHE_C)
     mbedtls_ssl_cache_context mCache;
 #endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_TICKET_C)
+    mbedtls_ssl_ticket_context mTicket;
+    std::mutex                 mTicketLock; ///< Tickets draw random numbers under mCryptoLock.
+#endif
+    std::mutex mCryptoLock;
+
+    AdmissionSource mAdmissionSources[kMaxAdmissionSources];
+
+    WorkerPool mHandshakeWorkers;
+    TaskQueue  mHandshakeCompletions;
 };
 
 /**
@@ -0,0 +1,259 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the flight recorder.
+ */
+
+#include "common/flight_recorder.hpp"
+
+#include <atomic>
+
+#include <assert.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef OTBR_CONFIG_FLIGHT_RECORDER_SIZE
+/**
+ * The number of records the flight recorder keeps, a power of two.
+ *
+ */
+#define OTBR_CONFIG_FLIGHT_RECORDER_SIZE 1024
+#endif
+
+namespace otbr {
+
+namespace {
+
+static_assert((OTBR_CONFIG_FLIGHT_RECORDER_SIZE & (OTBR_CONFIG_FLIGHT_RECORDER_SIZE - 1)) == 0,
+              "OTBR_CONFIG_FLIGHT_RECORDER_SIZE must be a power of two");
+
+enum
+{
+    kFlightTextSize = 24, ///< The size of the text of a record, including the null terminator.
+};
+
+/**
+ * This structure represents a slot of the flight recorder.
+ *
+ * The sequence number is 0 while the slot is being written, readers copy the slot and keep the copy only when the
+ * sequence number is the expected one before and after copying.
+ *
+ */
+struct FlightSlot
+{
+    std::atomic<uint32_t> mSequence;
+    uint16_t              mEvent;
+    uint16_t              mCode;
+    uint32_t              mValue;
+    uint32_t              mTime;
+    char                  mText[kFlightTextSize];
+};
+
+FlightSlot            sFlightSlots[OTBR_CONFIG_FLIGHT_RECORDER_SIZE];
+std::atomic<uint32_t> sFlightSequence;
+
+const char *const kFlightEventNames[] = {
+    "StateChanged", "RadioError", "RadioReset", "DBusCall", "DtlsState", "MdnsPublished",
+};
+
+static_assert(sizeof(kFlightEventNames) / sizeof(kFlightEventNames[0]) == kFlightEventNum,
+              "kFlightEventNames doesn't match FlightEvent");
+
+// The coarse clock is a plain read of the vDSO page, its resolution of a kernel tick is enough to tell events apart
+// in time, their order is given by the sequence numbers.
+uint32_t GetFlightTime(void)
+{
+    timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return static_cast<uint32_t>(static_cast<uint64_t>(now.tv_sec) * 1000 +
+                                 static_cast<uint64_t>(now.tv_nsec / 1000000));
+}
+
+void RecordFlightEventAt(uint32_t aTime, uint16_t aEvent, uint16_t aCode, uint32_t aValue, const char *aText)
+{
+    uint32_t    sequence = sFlightSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+    FlightSlot &slot     = sFlightSlots[(sequence - 1) % OTBR_CONFIG_FLIGHT_RECORDER_SIZE];
+    size_t      length   = 0;
+
+    slot.mSequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.mEvent = aEvent;
+    slot.mCode  = aCode;
+    slot.mValue = aValue;
+    slot.mTime  = aTime;
+
+    if (aText != nullptr)
+    {
+        while (length < kFlightTextSize - 1 && aText[length] != '\0')
+        {
+            slot.mText[length] = aText[length];
+            length++;
+        }
+    }
+
+    slot.mText[length] = '\0';
+    slot.mSequence.store(sequence, std::memory_order_release);
+}
+
+template <typename T> void AppendField(std::string &aBuffer, T aField)
+{
+    aBuffer.append(reinterpret_cast<const char *>(&aField), sizeof(aField));
+}
+
+template <typename T> bool ReadField(const std::string &aBuffer, size_t &aOffset, T &aField)
+{
+    bool ok = aBuffer.size() - aOffset >= sizeof(aField);
+
+    if (ok)
+    {
+        memcpy(&aField, aBuffer.data() + aOffset, sizeof(aField));
+        aOffset += sizeof(aField);
+    }
+
+    return ok;
+}
+
+} // namespace
+
+void RecordFlightEvent(FlightEvent aEvent, uint16_t aCode, uint32_t aValue, const char *aText)
+{
+    RecordFlightEventAt(GetFlightTime(), aEvent, aCode, aValue, aText);
+}
+
+const char *GetFlightEventName(FlightEvent aEvent)
+{
+    assert(aEvent < kFlightEventNum);
+    return kFlightEventNames[aEvent];
+}
+
+void GetFlightRecords(std::vector<FlightRecord> &aRecords)
+{
+    uint32_t last  = sFlightSequence.load(std::memory_order_acquire);
+    uint32_t first = (last > OTBR_CONFIG_FLIGHT_RECORDER_SIZE) ? last - OTBR_CONFIG_FLIGHT_RECORDER_SIZE + 1 : 1;
+    uint32_t now   = GetFlightTime();
+
+    aRecords.clear();
+
+    for (uint32_t sequence = first; sequence != last + 1; sequence++)
+    {
+        const FlightSlot &slot = sFlightSlots[(sequence - 1) % OTBR_CONFIG_FLIGHT_RECORDER_SIZE];
+        FlightRecord      record;
+        char              text[kFlightTextSize];
+
+        if (slot.mSequence.load(std::memory_order_acquire) != sequence)
+        {
+            continue;
+        }
+
+        record.mEvent = static_cast<FlightEvent>(slot.mEvent);
+        record.mCode  = slot.mCode;
+        record.mValue = slot.mValue;
+        record.mAge   = now - slot.mTime;
+        memcpy(text, slot.mText, sizeof(text));
+        text[sizeof(text) - 1] = '\0';
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.mSequence.load(std::memory_order_relaxed) != sequence || record.mEvent >= kFlightEventNum)
+        {
+            continue;
+        }
+
+        record.mText = text;
+        aRecords.push_back(record);
+    }
+}
+
+void SaveFlightRecords(std::string &aBuffer)
+{
+    std::vector<FlightRecord> records;
+    uint32_t                  now;
+
+    GetFlightRecords(records);
+    now = GetFlightTime();
+    aBuffer.clear();
+
+    for (const FlightRecord &record : records)
+    {
+        AppendField<uint32_t>(aBuffer, now - record.mAge);
+        AppendField<uint16_t>(aBuffer, record.mEvent);
+        AppendField<uint16_t>(aBuffer, record.mCode);
+        AppendField<uint32_t>(aBuffer, record.mValue);
+        AppendField<uint8_t>(aBuffer, static_cast<uint8_t>(record.mText.size()));
+        aBuffer.append(record.mText);
+    }
+}
+
+bool RestoreFlightRecords(const std::string &aBuffer)
+{
+    size_t offset = 0;
+    bool   ok     = true;
+
+    while (ok && offset < aBuffer.size())
+    {
+        uint32_t    time;
+        uint16_t    event;
+        uint16_t    code;
+        uint32_t    value;
+        uint8_t     length;
+        std::string text;
+
+        ok = ReadField(aBuffer, offset, time) && ReadField(aBuffer, offset, event) &&
+             ReadField(aBuffer, offset, code) && ReadField(aBuffer, offset, value) &&
+             ReadField(aBuffer, offset, length) && aBuffer.size() - offset >= length && event < kFlightEventNum;
+
+        if (ok)
+        {
+            text.assign(aBuffer, offset, length);
+            offset += length;
+            RecordFlightEventAt(time, event, code, value, text.c_str());
+        }
+    }
+
+    return ok;
+}
+
+void DumpFlightRecords(FILE *aOutput)
+{
+    std::vector<FlightRecord> records;
+
+    GetFlightRecords(records);
+
+    for (const FlightRecord &record : records)
+    {
+        fprintf(aOutput, "-%" PRIu32 ".%03" PRIu32 "s %-14s code=%u value=0x%08" PRIx32 " %s\n", record.mAge / 1000,
+                record.mAge % 1000, GetFlightEventName(record.mEvent), record.mCode, record.mValue,
+                record.mText.c_str());
+    }
+}
+
+} // namespace otbr
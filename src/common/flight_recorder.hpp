@@ -0,0 +1,143 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the flight recorder, which keeps the most recent agent events in memory.
+ */
+
+#ifndef OTBR_COMMON_FLIGHT_RECORDER_HPP_
+#define OTBR_COMMON_FLIGHT_RECORDER_HPP_
+
+#include "openthread-br/config.h"
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace otbr {
+
+/**
+ * This enumeration defines the events of the flight recorder, and what their code, value and text hold.
+ *
+ */
+enum FlightEvent : uint16_t
+{
+    kFlightEventStateChanged,  ///< OpenThread state changed, the value holds the otChangedFlags.
+    kFlightEventRadioError,    ///< Platform warning or error, e.g. of spinel, the code holds the otLogLevel.
+    kFlightEventRadioReset,    ///< The OpenThread instance was reset.
+    kFlightEventDBusCall,      ///< D-Bus method call, the value holds the duration in microseconds.
+    kFlightEventDtlsState,     ///< DTLS session state changed, the code holds the state, the value the session.
+    kFlightEventMdnsPublished, ///< mDNS publish result, the code holds the negated otbrError.
+    kFlightEventNum,           ///< Number of events.
+};
+
+/**
+ * This structure represents a record read from the flight recorder.
+ *
+ */
+struct FlightRecord
+{
+    uint32_t    mAge;   ///< The time since the event, in milliseconds.
+    FlightEvent mEvent; ///< The event.
+    uint16_t    mCode;  ///< The code of the event.
+    uint32_t    mValue; ///< The value of the event.
+    std::string mText;  ///< The text of the event, truncated.
+};
+
+/**
+ * This function records an event in the flight recorder.
+ *
+ * Recording takes no lock and does not allocate, so it can be called from any thread on hot paths. The oldest
+ * records are overwritten once the recorder is full.
+ *
+ * @param[in]   aEvent  The event.
+ * @param[in]   aCode   The code of the event.
+ * @param[in]   aValue  The value of the event.
+ * @param[in]   aText   The text of the event, truncated to a few characters, or nullptr for none.
+ *
+ */
+void RecordFlightEvent(FlightEvent aEvent, uint16_t aCode, uint32_t aValue, const char *aText = nullptr);
+
+/**
+ * This function returns the name of a flight recorder event.
+ *
+ * @param[in]   aEvent  The event.
+ *
+ * @returns The name of the event.
+ *
+ */
+const char *GetFlightEventName(FlightEvent aEvent);
+
+/**
+ * This function reads the records of the flight recorder, from the oldest to the newest.
+ *
+ * Records being overwritten while they are read are left out.
+ *
+ * @param[out]  aRecords    The records.
+ *
+ */
+void GetFlightRecords(std::vector<FlightRecord> &aRecords);
+
+/**
+ * This function saves the records of the flight recorder, from the oldest to the newest.
+ *
+ * The records are saved with their time on the system wide monotonic clock, another process on the same host
+ * restores them where they belong in its own timeline, e.g. an agent replacing this one.
+ *
+ * @param[out]  aBuffer     The buffer the records are saved to, in host byte order.
+ *
+ */
+void SaveFlightRecords(std::string &aBuffer);
+
+/**
+ * This function records the events saved by SaveFlightRecords().
+ *
+ * It is called before any other event is recorded, so that the records stay in order.
+ *
+ * @param[in]   aBuffer     The buffer the records were saved to.
+ *
+ * @retval true     Restored all the records.
+ * @retval false    The buffer is malformed, the records before the malformed one are restored.
+ *
+ */
+bool RestoreFlightRecords(const std::string &aBuffer);
+
+/**
+ * This function writes the records of the flight recorder as text, from the oldest to the newest.
+ *
+ * @param[in]   aOutput     The stream to write the text to.
+ *
+ */
+void DumpFlightRecords(FILE *aOutput);
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_FLIGHT_RECORDER_HPP_
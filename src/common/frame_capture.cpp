@@ -0,0 +1,297 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the shared memory ring of captured 802.15.4 frames.
+ */
+
+#include "common/frame_capture.hpp"
+
+#include <atomic>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+/**
+ * This structure represents the header of the shared memory object, followed by the records.
+ *
+ * The writer owns mHead and mDropped, the reader owns mTail. The records from mTail to mHead, modulo mRecordCount,
+ * are ready to be read, the others may be written.
+ *
+ */
+struct FrameCaptureRegion
+{
+    enum : uint32_t
+    {
+        kMagic   = 0x4f544643, ///< "OTFC"
+        kVersion = 1,
+    };
+
+    uint32_t              mMagic;       ///< kMagic, written after the rest of the header.
+    uint16_t              mVersion;     ///< The layout version.
+    uint16_t              mRecordSize;  ///< The size of a record, readers reject a ring of another size.
+    uint32_t              mRecordCount; ///< The number of records.
+    uint32_t              mReserved;
+    std::atomic<uint64_t> mHead;    ///< The number of frames ever written.
+    std::atomic<uint64_t> mTail;    ///< The number of frames ever consumed.
+    std::atomic<uint64_t> mDropped; ///< The number of frames dropped because the ring was full.
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The positions must be lock-free to be shared between processes");
+static_assert(sizeof(FrameRecord) % 8 == 0, "Records must keep the timestamps aligned");
+
+static size_t GetRegionSize(uint32_t aRecordCount)
+{
+    return sizeof(FrameCaptureRegion) + static_cast<size_t>(aRecordCount) * sizeof(FrameRecord);
+}
+
+FrameCaptureWriter::FrameCaptureWriter(void)
+    : mRegion(nullptr)
+    , mRecords(nullptr)
+    , mSize(0)
+{
+}
+
+FrameCaptureWriter::~FrameCaptureWriter(void)
+{
+    Close();
+}
+
+otbrError FrameCaptureWriter::Open(const char *aName, uint32_t aRecordCount)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    size_t    size  = GetRegionSize(aRecordCount);
+    int       fd    = -1;
+    void *    region;
+
+    VerifyOrExit(mRegion == nullptr, errno = EALREADY, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(aRecordCount > 0, errno = EINVAL, error = OTBR_ERROR_ERRNO);
+
+    fd = shm_open(aName, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    VerifyOrExit(fd != -1, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(ftruncate(fd, static_cast<off_t>(size)) == 0, error = OTBR_ERROR_ERRNO);
+
+    region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(region != MAP_FAILED, error = OTBR_ERROR_ERRNO);
+
+    // Readers check the magic last, a ring left by a previous writer is reset before it is valid again.
+    mRegion         = static_cast<FrameCaptureRegion *>(region);
+    mRecords        = reinterpret_cast<FrameRecord *>(mRegion + 1);
+    mSize           = size;
+    mRegion->mMagic = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    mRegion->mVersion     = FrameCaptureRegion::kVersion;
+    mRegion->mRecordSize  = sizeof(FrameRecord);
+    mRegion->mRecordCount = aRecordCount;
+    mRegion->mReserved    = 0;
+    mRegion->mHead.store(0, std::memory_order_relaxed);
+    mRegion->mTail.store(0, std::memory_order_relaxed);
+    mRegion->mDropped.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mRegion->mMagic = FrameCaptureRegion::kMagic;
+
+    mName = aName;
+
+exit:
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    return error;
+}
+
+void FrameCaptureWriter::Close(void)
+{
+    VerifyOrExit(mRegion != nullptr);
+
+    munmap(mRegion, mSize);
+    shm_unlink(mName.c_str());
+    mRegion  = nullptr;
+    mRecords = nullptr;
+    mSize    = 0;
+    mName.clear();
+
+exit:
+    return;
+}
+
+void FrameCaptureWriter::Append(const uint8_t *aPsdu, uint16_t aLength, uint8_t aChannel, int8_t aRssi, bool aIsTx)
+{
+    uint64_t     head;
+    FrameRecord *record;
+    timespec     now;
+
+    VerifyOrExit(mRegion != nullptr);
+
+    head = mRegion->mHead.load(std::memory_order_relaxed);
+    if (head - mRegion->mTail.load(std::memory_order_acquire) >= mRegion->mRecordCount)
+    {
+        mRegion->mDropped.store(mRegion->mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        ExitNow();
+    }
+
+    if (aLength > FrameRecord::kMaxPsduSize)
+    {
+        aLength = FrameRecord::kMaxPsduSize;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    record             = &mRecords[head % mRegion->mRecordCount];
+    record->mTimestamp = static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec / 1000);
+    record->mLength    = static_cast<uint8_t>(aLength);
+    record->mChannel   = aChannel;
+    record->mRssi      = aRssi;
+    record->mFlags     = aIsTx ? FrameRecord::kFlagTx : 0;
+    record->mReserved  = 0;
+    memcpy(record->mPsdu, aPsdu, aLength);
+
+    mRegion->mHead.store(head + 1, std::memory_order_release);
+
+exit:
+    return;
+}
+
+FrameCaptureReader::FrameCaptureReader(void)
+    : mRegion(nullptr)
+    , mRecords(nullptr)
+    , mSize(0)
+    , mDroppedBase(0)
+{
+}
+
+FrameCaptureReader::~FrameCaptureReader(void)
+{
+    Close();
+}
+
+otbrError FrameCaptureReader::Open(const char *aName)
+{
+    otbrError   error = OTBR_ERROR_NONE;
+    int         fd    = -1;
+    struct stat objectStat;
+    void *      region;
+
+    VerifyOrExit(mRegion == nullptr, errno = EALREADY, error = OTBR_ERROR_ERRNO);
+
+    fd = shm_open(aName, O_RDWR | O_CLOEXEC, 0);
+    VerifyOrExit(fd != -1, error = OTBR_ERROR_ERRNO);
+
+    // Accessing a mapping beyond the end of the object faults, e.g. when the writer hasn't sized it yet.
+    VerifyOrExit(fstat(fd, &objectStat) == 0, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(static_cast<size_t>(objectStat.st_size) >= sizeof(FrameCaptureRegion), errno = EPROTO,
+                 error = OTBR_ERROR_ERRNO);
+
+    region = mmap(nullptr, static_cast<size_t>(objectStat.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(region != MAP_FAILED, error = OTBR_ERROR_ERRNO);
+    mRegion  = static_cast<FrameCaptureRegion *>(region);
+    mRecords = reinterpret_cast<const FrameRecord *>(mRegion + 1);
+    mSize    = static_cast<size_t>(objectStat.st_size);
+
+    VerifyOrExit(mRegion->mMagic == FrameCaptureRegion::kMagic, errno = EPROTO, error = OTBR_ERROR_ERRNO);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    VerifyOrExit(mRegion->mVersion == FrameCaptureRegion::kVersion && mRegion->mRecordSize == sizeof(FrameRecord) &&
+                     mRegion->mRecordCount > 0 && GetRegionSize(mRegion->mRecordCount) <= mSize,
+                 errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+    // The records left by a previous reader or written while there was none are stale.
+    mDroppedBase = mRegion->mDropped.load(std::memory_order_relaxed);
+    mRegion->mTail.store(mRegion->mHead.load(std::memory_order_acquire), std::memory_order_release);
+
+exit:
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        Close();
+    }
+
+    return error;
+}
+
+void FrameCaptureReader::Close(void)
+{
+    VerifyOrExit(mRegion != nullptr);
+
+    munmap(mRegion, mSize);
+    mRegion  = nullptr;
+    mRecords = nullptr;
+    mSize    = 0;
+
+exit:
+    return;
+}
+
+const FrameRecord *FrameCaptureReader::Peek(void) const
+{
+    const FrameRecord *record = nullptr;
+    uint64_t           tail;
+
+    VerifyOrExit(mRegion != nullptr);
+
+    tail = mRegion->mTail.load(std::memory_order_relaxed);
+    VerifyOrExit(tail != mRegion->mHead.load(std::memory_order_acquire));
+    record = &mRecords[tail % mRegion->mRecordCount];
+
+exit:
+    return record;
+}
+
+void FrameCaptureReader::Consume(void)
+{
+    uint64_t tail;
+
+    VerifyOrExit(Peek() != nullptr);
+
+    tail = mRegion->mTail.load(std::memory_order_relaxed);
+    mRegion->mTail.store(tail + 1, std::memory_order_release);
+
+exit:
+    return;
+}
+
+uint64_t FrameCaptureReader::GetDroppedFrames(void) const
+{
+    return (mRegion != nullptr) ? mRegion->mDropped.load(std::memory_order_relaxed) - mDroppedBase : 0;
+}
+
+} // namespace otbr
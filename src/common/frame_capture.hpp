@@ -0,0 +1,218 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the shared memory ring of captured 802.15.4 frames.
+ */
+
+#ifndef OTBR_COMMON_FRAME_CAPTURE_HPP_
+#define OTBR_COMMON_FRAME_CAPTURE_HPP_
+
+#include "openthread-br/config.h"
+
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This structure represents a captured frame, as laid out in the ring.
+ *
+ */
+struct FrameRecord
+{
+    enum : uint8_t
+    {
+        kMaxPsduSize = 127, ///< The largest 802.15.4 PSDU.
+        kFlagTx      = 1,   ///< The frame was transmitted, otherwise received.
+    };
+
+    uint64_t mTimestamp;          ///< The wall clock time of the capture, in microseconds since the epoch.
+    uint8_t  mLength;             ///< The length of the PSDU, including the FCS.
+    uint8_t  mChannel;            ///< The channel of the frame.
+    int8_t   mRssi;               ///< The RSSI in dBm of a received frame, 127 if not known.
+    uint8_t  mFlags;              ///< Flags of the frame, such as kFlagTx.
+    uint32_t mReserved;           ///< Reserved, always 0.
+    uint8_t  mPsdu[kMaxPsduSize]; ///< The PSDU, the FCS may not be valid.
+    uint8_t  mPadding;            ///< Reserved, keeps records 8-byte aligned.
+};
+
+struct FrameCaptureRegion;
+
+/**
+ * This class implements the writer of a frame capture ring in POSIX shared memory.
+ *
+ * The ring has a single writer and a single reader, which consumes the records in place. Neither blocks the other:
+ * a frame captured while the ring is full is dropped and counted, so that the writer never waits for the reader.
+ *
+ */
+class FrameCaptureWriter
+{
+public:
+    /**
+     * The constructor initializes a closed writer.
+     *
+     */
+    FrameCaptureWriter(void);
+
+    /**
+     * The destructor closes and removes the ring.
+     *
+     */
+    ~FrameCaptureWriter(void);
+
+    /**
+     * This method creates the ring, or takes over an existing one.
+     *
+     * @param[in]   aName           The shared memory object name, starting with '/'.
+     * @param[in]   aRecordCount    The number of frames the ring holds.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the ring.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create or map the shared memory object.
+     *
+     */
+    otbrError Open(const char *aName, uint32_t aRecordCount);
+
+    /**
+     * This method unmaps and removes the ring.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method indicates whether the ring is open.
+     *
+     * @retval true     The ring is open.
+     * @retval false    The ring is closed.
+     *
+     */
+    bool IsOpen(void) const { return mRegion != nullptr; }
+
+    /**
+     * This method appends a frame to the ring, doing nothing if the ring is not open.
+     *
+     * @param[in]   aPsdu       A pointer to the PSDU.
+     * @param[in]   aLength     The length of the PSDU, including the FCS.
+     * @param[in]   aChannel    The channel of the frame.
+     * @param[in]   aRssi       The RSSI in dBm of a received frame, 127 if not known.
+     * @param[in]   aIsTx       Whether the frame was transmitted.
+     *
+     */
+    void Append(const uint8_t *aPsdu, uint16_t aLength, uint8_t aChannel, int8_t aRssi, bool aIsTx);
+
+private:
+    FrameCaptureWriter(const FrameCaptureWriter &) = delete;
+    FrameCaptureWriter &operator=(const FrameCaptureWriter &) = delete;
+
+    FrameCaptureRegion *mRegion;
+    FrameRecord *       mRecords;
+    size_t              mSize;
+    std::string         mName;
+};
+
+/**
+ * This class implements the reader of a frame capture ring in POSIX shared memory.
+ *
+ */
+class FrameCaptureReader
+{
+public:
+    /**
+     * The constructor initializes a closed reader.
+     *
+     */
+    FrameCaptureReader(void);
+
+    /**
+     * The destructor closes the ring.
+     *
+     */
+    ~FrameCaptureReader(void);
+
+    /**
+     * This method maps a ring created by a writer.
+     *
+     * The frames captured before are discarded, only the frames captured from now on are read.
+     *
+     * @param[in]   aName   The shared memory object name, starting with '/'.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the ring.
+     * @retval  OTBR_ERROR_ERRNO    Failed to open or map the shared memory object, or it is not a frame capture ring
+     *                              of this version, errno is EPROTO.
+     *
+     */
+    otbrError Open(const char *aName);
+
+    /**
+     * This method unmaps the ring.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method returns the oldest frame not consumed yet.
+     *
+     * The record stays valid and unchanged until it is consumed by Consume().
+     *
+     * @returns A pointer to the record in the ring, nullptr if the ring is empty or not open.
+     *
+     */
+    const FrameRecord *Peek(void) const;
+
+    /**
+     * This method consumes the frame returned by Peek(), so that the writer may reuse its record.
+     *
+     */
+    void Consume(void);
+
+    /**
+     * This method returns the number of frames dropped since the reader was opened, because the ring was full.
+     *
+     * @returns The number of frames dropped.
+     *
+     */
+    uint64_t GetDroppedFrames(void) const;
+
+private:
+    FrameCaptureReader(const FrameCaptureReader &) = delete;
+    FrameCaptureReader &operator=(const FrameCaptureReader &) = delete;
+
+    FrameCaptureRegion *mRegion;
+    const FrameRecord * mRecords;
+    size_t              mSize;
+    uint64_t            mDroppedBase;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_FRAME_CAPTURE_HPP_
@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a lock-free log-linear histogram.
+ */
+
+#include "common/histogram.hpp"
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+Histogram::Histogram(void)
+{
+    Clear();
+}
+
+void Histogram::Record(uint32_t aValue)
+{
+    uint32_t max = mMax.load(std::memory_order_relaxed);
+
+    mBuckets[GetBucketIndex(aValue)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(aValue, std::memory_order_relaxed);
+
+    while (aValue > max && !mMax.compare_exchange_weak(max, aValue, std::memory_order_relaxed))
+        ;
+}
+
+void Histogram::Clear(void)
+{
+    for (std::atomic<uint32_t> &bucket : mBuckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    mCount.store(0, std::memory_order_relaxed);
+    mSum.store(0, std::memory_order_relaxed);
+    mMax.store(0, std::memory_order_relaxed);
+}
+
+uint8_t Histogram::GetBucketIndex(uint32_t aValue)
+{
+    uint8_t index;
+    uint8_t shift;
+
+    if (aValue < kSubBuckets)
+    {
+        ExitNow(index = static_cast<uint8_t>(aValue));
+    }
+
+    // Number of bits below the kSubBucketBits + 1 most significant ones.
+    shift = static_cast<uint8_t>(31 - __builtin_clz(aValue) - kSubBucketBits);
+    index = static_cast<uint8_t>((shift + 1) * kSubBuckets + ((aValue >> shift) & (kSubBuckets - 1)));
+
+exit:
+    return index;
+}
+
+uint32_t Histogram::GetBucketLowerBound(uint8_t aIndex)
+{
+    uint32_t bound;
+
+    if (aIndex < kSubBuckets)
+    {
+        ExitNow(bound = aIndex);
+    }
+
+    bound = static_cast<uint32_t>(kSubBuckets + aIndex % kSubBuckets) << (aIndex / kSubBuckets - 1);
+
+exit:
+    return bound;
+}
+
+} // namespace otbr
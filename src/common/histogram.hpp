@@ -0,0 +1,151 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a lock-free log-linear histogram.
+ */
+
+#ifndef OTBR_COMMON_HISTOGRAM_HPP_
+#define OTBR_COMMON_HISTOGRAM_HPP_
+
+#include "openthread-br/config.h"
+
+#include <atomic>
+
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class implements a log-linear histogram of 32-bit samples.
+ *
+ * Values below kSubBuckets have their own bucket. Each following power of two is split into kSubBuckets
+ * linear buckets, so the relative error of a bucket is bounded by 1 / kSubBuckets. Recording is wait-free
+ * and may happen concurrently with readers on other threads.
+ *
+ */
+class Histogram
+{
+public:
+    enum
+    {
+        kSubBucketBits = 2,
+        kSubBuckets    = 1 << kSubBucketBits,
+        kBuckets       = (32 - kSubBucketBits + 1) * kSubBuckets, ///< Number of buckets.
+    };
+
+    /**
+     * The constructor initializes an empty histogram.
+     *
+     */
+    Histogram(void);
+
+    /**
+     * This method records a sample.
+     *
+     * @param[in]   aValue  The sample value.
+     *
+     */
+    void Record(uint32_t aValue);
+
+    /**
+     * This method clears all recorded samples.
+     *
+     * Samples recorded concurrently with this call may be partially kept.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method returns the number of recorded samples.
+     *
+     * @returns The number of samples.
+     *
+     */
+    uint64_t GetCount(void) const { return mCount.load(std::memory_order_relaxed); }
+
+    /**
+     * This method returns the sum of recorded samples.
+     *
+     * @returns The sum of samples.
+     *
+     */
+    uint64_t GetSum(void) const { return mSum.load(std::memory_order_relaxed); }
+
+    /**
+     * This method returns the largest recorded sample.
+     *
+     * @returns The largest sample, or 0 if nothing has been recorded.
+     *
+     */
+    uint32_t GetMax(void) const { return mMax.load(std::memory_order_relaxed); }
+
+    /**
+     * This method returns the number of samples in a bucket.
+     *
+     * @param[in]   aIndex  The bucket index, must be less than kBuckets.
+     *
+     * @returns The number of samples in the bucket.
+     *
+     */
+    uint32_t GetBucketCount(uint8_t aIndex) const { return mBuckets[aIndex].load(std::memory_order_relaxed); }
+
+    /**
+     * This method returns the bucket index of a value.
+     *
+     * @param[in]   aValue  The value.
+     *
+     * @returns The bucket index.
+     *
+     */
+    static uint8_t GetBucketIndex(uint32_t aValue);
+
+    /**
+     * This method returns the smallest value belonging to a bucket.
+     *
+     * @param[in]   aIndex  The bucket index, must be less than kBuckets.
+     *
+     * @returns The lower bound of the bucket.
+     *
+     */
+    static uint32_t GetBucketLowerBound(uint8_t aIndex);
+
+private:
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    std::atomic<uint32_t> mBuckets[kBuckets];
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint32_t> mMax;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_HISTOGRAM_HPP_
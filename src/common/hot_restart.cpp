@@ -0,0 +1,555 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements handing the state of otbr-agent over to the agent replacing it.
+ */
+
+#include "common/hot_restart.hpp"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+
+#ifndef OTBR_CONFIG_HOT_RESTART_MAX_SNAPSHOT_SIZE
+/**
+ * The maximum size in bytes of a snapshot, including its header and names.
+ *
+ */
+#define OTBR_CONFIG_HOT_RESTART_MAX_SNAPSHOT_SIZE 65536
+#endif
+
+namespace otbr {
+
+namespace {
+
+enum : uint8_t
+{
+    kMaxFds     = 16, ///< The maximum number of file descriptors of a snapshot.
+    kEntryFd    = 1,  ///< The entry of a file descriptor, in the order of the SCM_RIGHTS array.
+    kEntryValue = 2,  ///< The entry of a value, the name is followed by the 32-bit length of the value and the value.
+};
+
+/**
+ * This structure represents the header of a snapshot message, followed by the entries.
+ *
+ * Both agents run on the same host, the fields are in host byte order.
+ *
+ */
+struct SnapshotHeader
+{
+    enum : uint32_t
+    {
+        kMagic   = 0x4f544852, ///< "OTHR"
+        kVersion = 1,
+    };
+
+    uint32_t mMagic;
+    uint16_t mVersion;
+    uint8_t  mFdCount;
+    uint8_t  mReserved;
+};
+
+const size_t kMaxSnapshotSize = OTBR_CONFIG_HOT_RESTART_MAX_SNAPSHOT_SIZE;
+
+void AppendName(std::vector<uint8_t> &aBuffer, uint8_t aKind, const std::string &aName)
+{
+    aBuffer.push_back(aKind);
+    aBuffer.push_back(static_cast<uint8_t>(aName.size()));
+    aBuffer.insert(aBuffer.end(), aName.begin(), aName.end());
+}
+
+bool ReadBytes(const uint8_t *&aCursor, const uint8_t *aEnd, void *aData, size_t aLength)
+{
+    bool ok = static_cast<size_t>(aEnd - aCursor) >= aLength;
+
+    if (ok)
+    {
+        memcpy(aData, aCursor, aLength);
+        aCursor += aLength;
+    }
+
+    return ok;
+}
+
+bool ReadString(const uint8_t *&aCursor, const uint8_t *aEnd, size_t aLength, std::string &aString)
+{
+    bool ok = static_cast<size_t>(aEnd - aCursor) >= aLength;
+
+    if (ok)
+    {
+        aString.assign(reinterpret_cast<const char *>(aCursor), aLength);
+        aCursor += aLength;
+    }
+
+    return ok;
+}
+
+otbrError MakeAddress(const std::string &aPath, sockaddr_un &aAddress)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    memset(&aAddress, 0, sizeof(aAddress));
+    aAddress.sun_family = AF_UNIX;
+    VerifyOrExit(aPath.size() < sizeof(aAddress.sun_path), errno = ENAMETOOLONG, error = OTBR_ERROR_ERRNO);
+    memcpy(aAddress.sun_path, aPath.c_str(), aPath.size());
+
+exit:
+    return error;
+}
+
+// Waits for the socket to be readable, or to be closed by the peer, until the deadline.
+otbrError WaitReadable(int aSocket, unsigned long aDeadline)
+{
+    otbrError     error = OTBR_ERROR_NONE;
+    pollfd        pfd;
+    unsigned long now;
+    int           rval;
+
+    pfd.fd     = aSocket;
+    pfd.events = POLLIN;
+
+    while (true)
+    {
+        now = GetNow();
+        VerifyOrExit(now < aDeadline, errno = ETIMEDOUT, error = OTBR_ERROR_ERRNO);
+
+        rval = poll(&pfd, 1, static_cast<int>(std::min(aDeadline - now, static_cast<unsigned long>(INT_MAX))));
+        VerifyOrExit(rval <= 0);
+        VerifyOrExit(rval == 0 || errno == EINTR, error = OTBR_ERROR_ERRNO);
+    }
+
+exit:
+    return error;
+}
+
+} // namespace
+
+HotRestartSnapshot::~HotRestartSnapshot(void)
+{
+    Clear();
+}
+
+otbrError HotRestartSnapshot::AddFd(const std::string &aName, int aFd)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    Fd        fd;
+
+    VerifyOrExit(mFds.size() < kMaxFds && aName.size() <= UINT8_MAX, errno = EINVAL, error = OTBR_ERROR_ERRNO);
+    fd.mName = aName;
+    fd.mFd   = fcntl(aFd, F_DUPFD_CLOEXEC, 0);
+    VerifyOrExit(fd.mFd >= 0, error = OTBR_ERROR_ERRNO);
+    mFds.push_back(fd);
+
+exit:
+    return error;
+}
+
+void HotRestartSnapshot::SetValue(const std::string &aName, const std::string &aValue)
+{
+    for (Value &value : mValues)
+    {
+        if (value.mName == aName)
+        {
+            value.mValue = aValue;
+            ExitNow();
+        }
+    }
+
+    mValues.push_back(Value{aName, aValue});
+
+exit:
+    return;
+}
+
+int HotRestartSnapshot::TakeFd(const std::string &aName)
+{
+    int fd = -1;
+
+    for (auto it = mFds.begin(); it != mFds.end(); ++it)
+    {
+        if (it->mName == aName)
+        {
+            fd = it->mFd;
+            mFds.erase(it);
+            break;
+        }
+    }
+
+    return fd;
+}
+
+bool HotRestartSnapshot::GetValue(const std::string &aName, std::string &aValue) const
+{
+    bool found = false;
+
+    for (const Value &value : mValues)
+    {
+        if (value.mName == aName)
+        {
+            aValue = value.mValue;
+            found  = true;
+            break;
+        }
+    }
+
+    return found;
+}
+
+void HotRestartSnapshot::Clear(void)
+{
+    for (const Fd &fd : mFds)
+    {
+        close(fd.mFd);
+    }
+
+    mFds.clear();
+    mValues.clear();
+}
+
+otbrError HotRestartSnapshot::Send(int aSocket) const
+{
+    otbrError            error = OTBR_ERROR_NONE;
+    std::vector<uint8_t> buffer(sizeof(SnapshotHeader));
+    SnapshotHeader       header;
+    char                 control[CMSG_SPACE(sizeof(int) * kMaxFds)];
+    iovec                iov;
+    msghdr               message;
+
+    memset(&header, 0, sizeof(header));
+    header.mMagic   = SnapshotHeader::kMagic;
+    header.mVersion = SnapshotHeader::kVersion;
+    header.mFdCount = static_cast<uint8_t>(mFds.size());
+    memcpy(&buffer[0], &header, sizeof(header));
+
+    for (const Fd &fd : mFds)
+    {
+        AppendName(buffer, kEntryFd, fd.mName);
+    }
+
+    for (const Value &value : mValues)
+    {
+        uint32_t length = static_cast<uint32_t>(value.mValue.size());
+
+        VerifyOrExit(value.mName.size() <= UINT8_MAX && value.mValue.size() <= kMaxSnapshotSize, errno = EMSGSIZE,
+                     error = OTBR_ERROR_ERRNO);
+        AppendName(buffer, kEntryValue, value.mName);
+        buffer.insert(buffer.end(), reinterpret_cast<const uint8_t *>(&length),
+                      reinterpret_cast<const uint8_t *>(&length) + sizeof(length));
+        buffer.insert(buffer.end(), value.mValue.begin(), value.mValue.end());
+    }
+
+    VerifyOrExit(buffer.size() <= kMaxSnapshotSize, errno = EMSGSIZE, error = OTBR_ERROR_ERRNO);
+
+    iov.iov_base = &buffer[0];
+    iov.iov_len  = buffer.size();
+    memset(&message, 0, sizeof(message));
+    message.msg_iov    = &iov;
+    message.msg_iovlen = 1;
+
+    if (!mFds.empty())
+    {
+        cmsghdr *cmsg;
+
+        memset(control, 0, sizeof(control));
+        message.msg_control    = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * mFds.size());
+        cmsg                   = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level       = SOL_SOCKET;
+        cmsg->cmsg_type        = SCM_RIGHTS;
+        cmsg->cmsg_len         = CMSG_LEN(sizeof(int) * mFds.size());
+
+        for (size_t i = 0; i < mFds.size(); i++)
+        {
+            memcpy(CMSG_DATA(cmsg) + i * sizeof(int), &mFds[i].mFd, sizeof(int));
+        }
+    }
+
+    VerifyOrExit(sendmsg(aSocket, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(buffer.size()),
+                 error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+otbrError HotRestartSnapshot::Receive(int aSocket)
+{
+    otbrError            error = OTBR_ERROR_NONE;
+    std::vector<uint8_t> buffer(kMaxSnapshotSize);
+    char                 control[CMSG_SPACE(sizeof(int) * kMaxFds)];
+    std::vector<int>     fds;
+    SnapshotHeader       header;
+    const uint8_t *      cursor;
+    const uint8_t *      end;
+    iovec                iov;
+    msghdr               message;
+    ssize_t              length;
+
+    Clear();
+
+    iov.iov_base = &buffer[0];
+    iov.iov_len  = buffer.size();
+    memset(&message, 0, sizeof(message));
+    message.msg_iov        = &iov;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    do
+    {
+        length = recvmsg(aSocket, &message, MSG_CMSG_CLOEXEC);
+    } while (length < 0 && errno == EINTR);
+
+    VerifyOrExit(length >= 0, error = OTBR_ERROR_ERRNO);
+
+    // The file descriptors are owned from now on, whatever the message holds.
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+            size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                int fd;
+
+                memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                fds.push_back(fd);
+            }
+        }
+    }
+
+    cursor = &buffer[0];
+    end    = cursor + length;
+    VerifyOrExit((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0, errno = EPROTO, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(ReadBytes(cursor, end, &header, sizeof(header)) && header.mMagic == SnapshotHeader::kMagic &&
+                     header.mVersion == SnapshotHeader::kVersion && header.mFdCount == fds.size(),
+                 errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+    while (cursor != end)
+    {
+        uint8_t     kind;
+        uint8_t     nameLength;
+        std::string name;
+
+        VerifyOrExit(ReadBytes(cursor, end, &kind, sizeof(kind)) &&
+                         ReadBytes(cursor, end, &nameLength, sizeof(nameLength)) &&
+                         ReadString(cursor, end, nameLength, name),
+                     errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+        if (kind == kEntryFd)
+        {
+            VerifyOrExit(mFds.size() < fds.size(), errno = EPROTO, error = OTBR_ERROR_ERRNO);
+            mFds.push_back(Fd{name, fds[mFds.size()]});
+        }
+        else
+        {
+            uint32_t    valueLength;
+            std::string value;
+
+            VerifyOrExit(kind == kEntryValue && ReadBytes(cursor, end, &valueLength, sizeof(valueLength)) &&
+                             ReadString(cursor, end, valueLength, value),
+                         errno = EPROTO, error = OTBR_ERROR_ERRNO);
+            mValues.push_back(Value{name, value});
+        }
+    }
+
+    VerifyOrExit(mFds.size() == fds.size(), errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        int savedErrno = errno;
+
+        // The file descriptors already in mFds are closed by Clear().
+        for (size_t i = mFds.size(); i < fds.size(); i++)
+        {
+            close(fds[i]);
+        }
+
+        Clear();
+        errno = savedErrno;
+    }
+
+    return error;
+}
+
+HotRestart::HotRestart(void)
+    : mListenFd(-1)
+    , mPeerFd(-1)
+{
+}
+
+HotRestart::~HotRestart(void)
+{
+    if (mListenFd >= 0)
+    {
+        close(mListenFd);
+        unlink(mPath.c_str());
+    }
+
+    // The new agent waits for this connection to be closed, the resources it takes over are released by now.
+    if (mPeerFd >= 0)
+    {
+        close(mPeerFd);
+    }
+}
+
+otbrError HotRestart::Listen(const std::string &aPath, SnapshotHandler aHandler)
+{
+    otbrError   error = OTBR_ERROR_NONE;
+    sockaddr_un address;
+
+    VerifyOrExit(mListenFd < 0, errno = EALREADY, error = OTBR_ERROR_ERRNO);
+    SuccessOrExit(error = MakeAddress(aPath, address));
+
+    mListenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    VerifyOrExit(mListenFd >= 0, error = OTBR_ERROR_ERRNO);
+
+    // A socket left by an agent which didn't exit cleanly refuses connections, it is replaced.
+    unlink(aPath.c_str());
+    VerifyOrExit(bind(mListenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0,
+                 error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(chmod(aPath.c_str(), S_IRUSR | S_IWUSR) == 0, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(listen(mListenFd, 1) == 0, error = OTBR_ERROR_ERRNO);
+
+    mPath    = aPath;
+    mHandler = aHandler;
+
+exit:
+    if (error != OTBR_ERROR_NONE && mListenFd >= 0)
+    {
+        close(mListenFd);
+        mListenFd = -1;
+    }
+
+    otbrLogResult("Listen for hot restart", error);
+    return error;
+}
+
+otbrError HotRestart::Request(const std::string &aPath, HotRestartSnapshot &aSnapshot, uint32_t aTimeout)
+{
+    otbrError     error    = OTBR_ERROR_NONE;
+    unsigned long deadline = GetNow() + aTimeout;
+    int           fd       = -1;
+    sockaddr_un   address;
+    char          byte;
+    ssize_t       length;
+
+    SuccessOrExit(error = MakeAddress(aPath, address));
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    VerifyOrExit(fd >= 0, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0,
+                 error = OTBR_ERROR_ERRNO);
+
+    SuccessOrExit(error = WaitReadable(fd, deadline));
+    SuccessOrExit(error = aSnapshot.Receive(fd));
+    otbrLog(OTBR_LOG_INFO, "Received the hot restart snapshot, waiting for the running agent to exit");
+
+    // The running agent sends nothing more, the socket becomes readable when it is closed.
+    SuccessOrExit(error = WaitReadable(fd, deadline));
+    do
+    {
+        length = recv(fd, &byte, sizeof(byte), 0);
+    } while (length < 0 && errno == EINTR);
+    VerifyOrExit(length == 0, errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+exit:
+    if (fd >= 0)
+    {
+        int savedErrno = errno;
+
+        close(fd);
+        errno = savedErrno;
+    }
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        aSnapshot.Clear();
+    }
+
+    return error;
+}
+
+void HotRestart::UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd)
+{
+    VerifyOrExit(mListenFd >= 0 && mPeerFd < 0);
+
+    FD_SET(mListenFd, &aReadFdSet);
+    aMaxFd = std::max(aMaxFd, mListenFd);
+
+exit:
+    return;
+}
+
+void HotRestart::Process(const fd_set &aReadFdSet)
+{
+    otbrError          error = OTBR_ERROR_NONE;
+    HotRestartSnapshot snapshot;
+    ucred              credentials;
+    socklen_t          credentialsLength = sizeof(credentials);
+    int                fd                = -1;
+
+    VerifyOrExit(mListenFd >= 0 && mPeerFd < 0 && FD_ISSET(mListenFd, &aReadFdSet));
+
+    fd = accept4(mListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    VerifyOrExit(fd >= 0);
+
+    // The socket is only accessible to the user of the agent, let alone root, the credentials are checked anyway.
+    VerifyOrExit(getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &credentialsLength) == 0 &&
+                     credentials.uid == geteuid(),
+                 errno = EPERM, error = OTBR_ERROR_ERRNO);
+
+    mHandler(snapshot);
+    SuccessOrExit(error = snapshot.Send(fd));
+
+    otbrLog(OTBR_LOG_NOTICE, "Handed over to the agent of pid %d", static_cast<int>(credentials.pid));
+    mPeerFd = fd;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to hand over to a new agent: %s", strerror(errno));
+        close(fd);
+    }
+}
+
+} // namespace otbr
@@ -0,0 +1,254 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for handing the state of otbr-agent over to the agent replacing it.
+ */
+
+#ifndef OTBR_COMMON_HOT_RESTART_HPP_
+#define OTBR_COMMON_HOT_RESTART_HPP_
+
+#include "openthread-br/config.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <sys/select.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class represents the state handed over to a new agent: named file descriptors and named opaque values.
+ *
+ * The snapshot owns its file descriptors, they are closed with it unless taken.
+ *
+ */
+class HotRestartSnapshot
+{
+public:
+    /**
+     * The constructor initializes an empty snapshot.
+     *
+     */
+    HotRestartSnapshot(void) = default;
+
+    /**
+     * The destructor closes the file descriptors not taken.
+     *
+     */
+    ~HotRestartSnapshot(void);
+
+    /**
+     * This method adds a duplicate of a file descriptor to the snapshot.
+     *
+     * @param[in]   aName   The name of the file descriptor.
+     * @param[in]   aFd     The file descriptor, which stays owned by the caller.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the file descriptor.
+     * @retval  OTBR_ERROR_ERRNO    Failed to duplicate the file descriptor, or the snapshot holds too many of them.
+     *
+     */
+    otbrError AddFd(const std::string &aName, int aFd);
+
+    /**
+     * This method sets a value of the snapshot.
+     *
+     * @param[in]   aName   The name of the value.
+     * @param[in]   aValue  The value.
+     *
+     */
+    void SetValue(const std::string &aName, const std::string &aValue);
+
+    /**
+     * This method takes a file descriptor out of the snapshot.
+     *
+     * @param[in]   aName   The name of the file descriptor.
+     *
+     * @returns The file descriptor, now owned by the caller, or -1 if the snapshot holds none of this name.
+     *
+     */
+    int TakeFd(const std::string &aName);
+
+    /**
+     * This method gets a value of the snapshot.
+     *
+     * @param[in]   aName   The name of the value.
+     * @param[out]  aValue  The value.
+     *
+     * @retval true     The value was found.
+     * @retval false    The snapshot holds no value of this name.
+     *
+     */
+    bool GetValue(const std::string &aName, std::string &aValue) const;
+
+    /**
+     * This method closes the file descriptors and removes the values.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method sends the snapshot as one message on a SOCK_SEQPACKET socket, the file descriptors as SCM_RIGHTS.
+     *
+     * @param[in]   aSocket     The socket.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully sent the snapshot.
+     * @retval  OTBR_ERROR_ERRNO    Failed to send, or the snapshot is too large, errno is EMSGSIZE.
+     *
+     */
+    otbrError Send(int aSocket) const;
+
+    /**
+     * This method receives a snapshot sent by Send(), replacing the content of this one.
+     *
+     * @param[in]   aSocket     The socket.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully received the snapshot.
+     * @retval  OTBR_ERROR_ERRNO    Failed to receive, or the message is not a snapshot of this version, errno is
+     *                              EPROTO.
+     *
+     */
+    otbrError Receive(int aSocket);
+
+private:
+    struct Fd
+    {
+        std::string mName;
+        int         mFd;
+    };
+
+    struct Value
+    {
+        std::string mName;
+        std::string mValue;
+    };
+
+    std::vector<Fd>    mFds;
+    std::vector<Value> mValues;
+};
+
+/**
+ * This class implements the hand-over of the agent state over a UNIX socket.
+ *
+ * The running agent listens on the socket. A new agent connects to it and receives the snapshot of the running one,
+ * which then leaves its main loop and releases the radio. The socket stays connected until the running agent exits,
+ * which tells the new one that the radio is free.
+ *
+ */
+class HotRestart
+{
+public:
+    /**
+     * This function pointer is called to fill the snapshot handed over to a new agent.
+     *
+     * @param[out]  aSnapshot   The snapshot, which is empty.
+     *
+     */
+    typedef std::function<void(HotRestartSnapshot &aSnapshot)> SnapshotHandler;
+
+    /**
+     * The constructor initializes the hand-over, which is not listening.
+     *
+     */
+    HotRestart(void);
+
+    /**
+     * The destructor stops listening and, if the state was handed over, lets the new agent take over.
+     *
+     */
+    ~HotRestart(void);
+
+    /**
+     * This method starts listening for a new agent.
+     *
+     * @param[in]   aPath       The path of the socket.
+     * @param[in]   aHandler    The handler filling the snapshot.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started listening.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create the socket.
+     *
+     */
+    otbrError Listen(const std::string &aPath, SnapshotHandler aHandler);
+
+    /**
+     * This method receives the snapshot of the running agent and waits for it to exit.
+     *
+     * @param[in]   aPath       The path of the socket of the running agent.
+     * @param[out]  aSnapshot   The snapshot.
+     * @param[in]   aTimeout    The time in milliseconds to wait for the snapshot and then for the agent to exit.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully received the snapshot, the running agent exited.
+     * @retval  OTBR_ERROR_ERRNO    Failed to connect, receive or wait, errno is ETIMEDOUT for the latter.
+     *
+     */
+    static otbrError Request(const std::string &aPath, HotRestartSnapshot &aSnapshot, uint32_t aTimeout);
+
+    /**
+     * This method indicates whether the state was handed over, and the agent should leave its main loop.
+     *
+     * @retval true     The state was handed over.
+     * @retval false    No new agent took over yet.
+     *
+     */
+    bool IsHandedOver(void) const { return mPeerFd >= 0; }
+
+    /**
+     * This method updates the fd_set for mainloop.
+     *
+     * @param[inout]  aReadFdSet   A reference to read file descriptors.
+     * @param[inout]  aMaxFd       A reference to the max file descriptor.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd);
+
+    /**
+     * This method performs the hand-over when a new agent connected.
+     *
+     * @param[in]   aReadFdSet   A reference to read file descriptors.
+     *
+     */
+    void Process(const fd_set &aReadFdSet);
+
+private:
+    HotRestart(const HotRestart &) = delete;
+    HotRestart &operator=(const HotRestart &) = delete;
+
+    int             mListenFd;
+    int             mPeerFd;
+    std::string     mPath;
+    SnapshotHandler mHandler;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_HOT_RESTART_HPP_
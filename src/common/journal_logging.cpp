@@ -0,0 +1,270 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the journal log.
+ */
+
+#include "common/journal_logging.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <systemd/sd-journal.h>
+
+#include "common/code_utils.hpp"
+#include "common/thread_policy.hpp"
+
+/**
+ * The max number of logs waiting for the journal writer, logs beyond are dropped.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_JOURNAL_QUEUE
+#define OTBR_CONFIG_LOG_JOURNAL_QUEUE 256
+#endif
+
+/**
+ * The interval in milliseconds the journal writer sends queued logs at, unless errors or a full batch wake it up.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_JOURNAL_FLUSH_INTERVAL
+#define OTBR_CONFIG_LOG_JOURNAL_FLUSH_INTERVAL 100
+#endif
+
+namespace otbr {
+
+namespace JournalLog {
+
+static const char   kMessageField[]     = "MESSAGE=";
+static const size_t kMessageFieldLength = sizeof(kMessageField) - 1;
+
+Writer::Writer(void)
+    : mRunning(false)
+    , mDropped(0)
+    , mDroppedReported(0)
+    , mPrintStderr(false)
+{
+}
+
+Writer::~Writer(void)
+{
+    Close();
+}
+
+void Writer::Open(const char *aIdent, bool aPrintStderr)
+{
+    VerifyOrExit(!IsOpen());
+
+    mIdent       = aIdent;
+    mIdentField  = "SYSLOG_IDENTIFIER=" + mIdent;
+    mPrintStderr = aPrintStderr;
+    mPending.reserve(OTBR_CONFIG_LOG_JOURNAL_QUEUE);
+    mRunning = true;
+    mThread  = std::thread(&Writer::Run, this);
+
+exit:
+    return;
+}
+
+void Writer::Close(void)
+{
+    VerifyOrExit(IsOpen());
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        mRunning = false;
+    }
+
+    mSignal.notify_one();
+    mThread.join();
+
+exit:
+    return;
+}
+
+void Writer::SetInterface(const char *aInterfaceName)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mInterfaceField = std::string("OTBR_INTERFACE=") + aInterfaceName;
+}
+
+void Writer::Record(otbrLogModule    aModule,
+                    int              aLevel,
+                    const otbrError *aError,
+                    uint32_t         aSession,
+                    const char *     aFormat,
+                    va_list          aArguments)
+{
+    Entry entry;
+    int   length;
+
+    entry.mLevel    = static_cast<uint8_t>(aLevel);
+    entry.mModule   = static_cast<uint8_t>(aModule);
+    entry.mHasError = (aError != NULL);
+    entry.mError    = static_cast<int16_t>(aError != NULL ? *aError : OTBR_ERROR_NONE);
+    entry.mSession  = aSession;
+
+    memcpy(entry.mMessage, kMessageField, kMessageFieldLength);
+    length = vsnprintf(entry.mMessage + kMessageFieldLength, sizeof(entry.mMessage) - kMessageFieldLength, aFormat,
+                       aArguments);
+
+    length        = kMessageFieldLength + (length < 0 ? 0 : length);
+    entry.mLength = static_cast<uint16_t>(length < kMaxMessageSize ? length : kMaxMessageSize - 1);
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        VerifyOrExit(mPending.size() < OTBR_CONFIG_LOG_JOURNAL_QUEUE, ++mDropped);
+        mPending.push_back(entry);
+        VerifyOrExit(aLevel <= OTBR_LOG_ERR || mPending.size() >= OTBR_CONFIG_LOG_JOURNAL_QUEUE / 2);
+    }
+
+    // Errors are sent right away so that they are not lost in a crash shortly after.
+    mSignal.notify_one();
+
+exit:
+    return;
+}
+
+void Writer::Run(void)
+{
+    std::vector<Entry> batch;
+    std::string        interfaceField;
+    bool               running = true;
+
+    ApplyThreadPolicy(kThreadClassLog);
+    batch.reserve(OTBR_CONFIG_LOG_JOURNAL_QUEUE);
+
+    while (running)
+    {
+        uint32_t dropped;
+
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+
+            if (mRunning.load() && mPending.empty())
+            {
+                mSignal.wait_for(lock, std::chrono::milliseconds(OTBR_CONFIG_LOG_JOURNAL_FLUSH_INTERVAL));
+            }
+
+            // Drain what producers queued before stopping.
+            running = mRunning.load();
+            batch.swap(mPending);
+            interfaceField = mInterfaceField;
+        }
+
+        dropped = mDropped.load() - mDroppedReported;
+
+        if (dropped > 0)
+        {
+            mDroppedReported += dropped;
+            sd_journal_send("MESSAGE=%u logs dropped", dropped, "PRIORITY=%d", OTBR_LOG_WARNING, mIdentField.c_str(),
+                            NULL);
+        }
+
+        for (std::vector<Entry>::const_iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            Send(*it, interfaceField);
+        }
+
+        batch.clear();
+    }
+}
+
+void Writer::Send(const Entry &aEntry, const std::string &aInterfaceField)
+{
+    enum
+    {
+        kMaxFields = 7,
+    };
+
+    struct iovec fields[kMaxFields];
+    int          count = 0;
+    char         priority[16];
+    char         module[32];
+    char         error[48];
+    char         session[32];
+
+    fields[count].iov_base = const_cast<char *>(aEntry.mMessage);
+    fields[count].iov_len  = aEntry.mLength;
+    count++;
+
+    fields[count].iov_base = priority;
+    fields[count].iov_len  = static_cast<size_t>(snprintf(priority, sizeof(priority), "PRIORITY=%d", aEntry.mLevel));
+    count++;
+
+    fields[count].iov_base = const_cast<char *>(mIdentField.data());
+    fields[count].iov_len  = mIdentField.size();
+    count++;
+
+    fields[count].iov_base = module;
+    fields[count].iov_len  = static_cast<size_t>(snprintf(
+        module, sizeof(module), "OTBR_MODULE=%s", otbrLogModuleToString(static_cast<otbrLogModule>(aEntry.mModule))));
+    count++;
+
+    if (!aInterfaceField.empty())
+    {
+        fields[count].iov_base = const_cast<char *>(aInterfaceField.data());
+        fields[count].iov_len  = aInterfaceField.size();
+        count++;
+    }
+
+    if (aEntry.mHasError)
+    {
+        fields[count].iov_base = error;
+        fields[count].iov_len  = static_cast<size_t>(snprintf(error, sizeof(error), "OTBR_ERROR=%s",
+                                                             otbrErrorString(static_cast<otbrError>(aEntry.mError))));
+        count++;
+    }
+
+    if (aEntry.mSession != 0)
+    {
+        fields[count].iov_base = session;
+        fields[count].iov_len =
+            static_cast<size_t>(snprintf(session, sizeof(session), "OTBR_SESSION=%u", aEntry.mSession));
+        count++;
+    }
+
+    sd_journal_sendv(fields, count);
+
+    if (mPrintStderr)
+    {
+        // Same as what syslog prints with LOG_PERROR.
+        fprintf(stderr, "%s[%d]: %.*s\n", mIdent.c_str(), static_cast<int>(getpid()),
+                static_cast<int>(aEntry.mLength - kMessageFieldLength), aEntry.mMessage + kMessageFieldLength);
+    }
+}
+
+} // namespace JournalLog
+
+} // namespace otbr
@@ -0,0 +1,172 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the journal log, which sends logs with structured fields to systemd-journald.
+ */
+
+#ifndef OTBR_COMMON_JOURNAL_LOGGING_HPP_
+#define OTBR_COMMON_JOURNAL_LOGGING_HPP_
+
+#include "openthread-br/config.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "common/logging.hpp"
+#include "common/types.hpp"
+
+namespace otbr {
+
+namespace JournalLog {
+
+/**
+ * This class implements the writer of the journal log.
+ *
+ * Logs are formatted by the caller into a queue, and a background thread sends them to journald in batches, so that
+ * callers never block on the journal socket.
+ *
+ */
+class Writer
+{
+public:
+    enum
+    {
+        kMaxMessageSize = 512, ///< The max length of a message, longer messages are truncated.
+    };
+
+    /**
+     * The constructor initializes a closed journal log.
+     *
+     */
+    Writer(void);
+
+    /**
+     * The destructor closes the journal log.
+     *
+     */
+    ~Writer(void);
+
+    /**
+     * This method starts sending logs to journald.
+     *
+     * @param[in]   aIdent          The syslog identifier of the logs.
+     * @param[in]   aPrintStderr    Whether to also print the logs to stderr.
+     *
+     */
+    void Open(const char *aIdent, bool aPrintStderr);
+
+    /**
+     * This method stops sending logs to journald, after sending all queued logs.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method indicates whether the journal log is open.
+     *
+     * @returns Whether the journal log is open.
+     *
+     */
+    bool IsOpen(void) const { return mRunning.load(std::memory_order_relaxed); }
+
+    /**
+     * This method sets the Thread interface which all following logs are recorded with.
+     *
+     * @param[in]   aInterfaceName  The name of the Thread interface.
+     *
+     */
+    void SetInterface(const char *aInterfaceName);
+
+    /**
+     * This method queues a log.
+     *
+     * @param[in]   aModule     The module of the log.
+     * @param[in]   aLevel      The log level.
+     * @param[in]   aError      A pointer to the error the log reports, NULL if none.
+     * @param[in]   aSession    The session the log belongs to, 0 if none.
+     * @param[in]   aFormat     The format string as in printf.
+     * @param[in]   aArguments  The arguments of @p aFormat.
+     *
+     */
+    void Record(otbrLogModule    aModule,
+                int              aLevel,
+                const otbrError *aError,
+                uint32_t         aSession,
+                const char *     aFormat,
+                va_list          aArguments);
+
+    /**
+     * This method returns the number of logs dropped because the queue was full.
+     *
+     * @returns The number of dropped logs.
+     *
+     */
+    uint32_t GetDroppedCount(void) const { return mDropped.load(); }
+
+private:
+    struct Entry
+    {
+        uint8_t  mLevel;
+        uint8_t  mModule;
+        bool     mHasError;
+        int16_t  mError;
+        uint32_t mSession;
+        uint16_t mLength;
+        char     mMessage[kMaxMessageSize];
+    };
+
+    void Run(void);
+    void Send(const Entry &aEntry, const std::string &aInterfaceField);
+
+    std::mutex              mLock;
+    std::condition_variable mSignal;
+    std::vector<Entry>      mPending;
+    std::thread             mThread;
+    std::atomic<bool>       mRunning;
+    std::atomic<uint32_t>   mDropped;
+    uint32_t                mDroppedReported;
+    bool                    mPrintStderr;
+    std::string             mIdent;
+    std::string             mIdentField;
+    std::string             mInterfaceField;
+};
+
+} // namespace JournalLog
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_JOURNAL_LOGGING_HPP_
@@ -36,21 +36,137 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <syslog.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "common/binary_logging.hpp"
+#include "common/circular_logging.hpp"
+#include "common/code_utils.hpp"
+#include "common/thread_policy.hpp"
 #include "common/time.hpp"
+#if OTBR_ENABLE_JOURNALD
+#include "common/journal_logging.hpp"
+#endif
 
-static int        sLevel      = LOG_INFO;
-static const char kHexChars[] = "0123456789abcdef";
+/**
+ * The number of preallocated records buffering the private log file, must be a power of two.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_RECORDS
+#define OTBR_CONFIG_LOG_RECORDS 128
+#endif
+
+/**
+ * The max size in bytes of a log record, including the timestamp, longer logs are truncated.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_RECORD_SIZE
+#define OTBR_CONFIG_LOG_RECORD_SIZE 512
+#endif
+
+/**
+ * The max time in milliseconds a log record waits before being written to the private log file.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_FLUSH_INTERVAL
+#define OTBR_CONFIG_LOG_FLUSH_INTERVAL 100
+#endif
+
+/**
+ * The number of pending log records waking the writer before the flush interval elapses.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_FLUSH_THRESHOLD
+#define OTBR_CONFIG_LOG_FLUSH_THRESHOLD 32
+#endif
+
+/**
+ * The size in bytes of the binary log file.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_BINARY_SIZE
+#define OTBR_CONFIG_LOG_BINARY_SIZE (1024 * 1024)
+#endif
+
+/**
+ * The size in bytes of the circular log file.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_CIRCULAR_SIZE
+#define OTBR_CONFIG_LOG_CIRCULAR_SIZE (256 * 1024)
+#endif
+
+/**
+ * The max number of bytes hex dumped by otbrDump(), the bytes beyond are only counted.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_DUMP_MAX_SIZE
+#define OTBR_CONFIG_LOG_DUMP_MAX_SIZE 256
+#endif
+
+static_assert((OTBR_CONFIG_LOG_RECORDS & (OTBR_CONFIG_LOG_RECORDS - 1)) == 0, "log records must be a power of two");
+
+static int sLevel = LOG_INFO;
+
+// The levels of the modules, where the default module is not used as its level is the default log level.
+static int sModuleLevels[OTBR_LOG_MODULE_NUM] = {OTBR_LOG_INHERIT, OTBR_LOG_INHERIT, OTBR_LOG_INHERIT, OTBR_LOG_INHERIT,
+                                                 OTBR_LOG_INHERIT, OTBR_LOG_INHERIT, OTBR_LOG_INHERIT};
+
+static const char *const kModuleNames[OTBR_LOG_MODULE_NUM] = {"default", "mdns", "dtls", "dbus", "ncp", "ubus", "web"};
 
 static unsigned long sMsecsStart;
-static bool          sLogCol0 = true; /* we start at col0 */
 static FILE *        sLogFp;
 static bool          sSyslogEnabled = true;
 static bool          sSyslogOpened  = false;
+static const char *  sIdent         = NULL;
+static bool          sPrintStderr   = false;
+
+// The session logs of each thread belong to, recorded by the journal.
+static thread_local uint32_t sLogSession = 0;
+
+/**
+ * This structure represents a log line formatted by the caller and waiting for the writer thread.
+ *
+ * A record is free for a producer when mSequence equals its enqueue position, and ready for the
+ * writer when mSequence equals its enqueue position plus one.
+ *
+ */
+struct LogRecord
+{
+    std::atomic<size_t> mSequence;
+    uint16_t            mLength;
+    char                mText[OTBR_CONFIG_LOG_RECORD_SIZE];
+};
+
+static LogRecord               sLogRecords[OTBR_CONFIG_LOG_RECORDS];
+static std::atomic<size_t>     sLogEnqueuePos(0);
+static std::atomic<size_t>     sLogDequeuePos(0);
+static std::atomic<uint32_t>   sLogDropped(0);
+static uint32_t                sLogDroppedReported = 0;
+static std::atomic<bool>       sLogWriterRunning(false);
+static std::thread             sLogWriter;
+static std::mutex              sLogWriterLock;
+static std::condition_variable sLogWriterSignal;
+
+static otbr::BinaryLog::Writer   sBinaryLog;
+static otbr::CircularLog::Writer sCircularLog;
+#if OTBR_ENABLE_JOURNALD
+static otbr::JournalLog::Writer sJournal;
+#endif
+
+static void LogStartWriter(void);
+static void LogStopWriter(void);
 
 #define LOGFLAG_syslog 1
 #define LOGFLAG_file 2
+#define LOGFLAG_circular 4
 
 /** Set/Clear syslog enable flag */
 void otbrLogEnableSyslog(bool b)
@@ -58,9 +174,54 @@ void otbrLogEnableSyslog(bool b)
     sSyslogEnabled = b;
 }
 
+/** Send logs to the journal instead of the syslog */
+otbrError otbrLogEnableJournal(bool aEnabled)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+#if OTBR_ENABLE_JOURNALD
+    VerifyOrExit(sSyslogOpened, error = OTBR_ERROR_ERRNO; errno = EINVAL);
+
+    if (aEnabled)
+    {
+        sJournal.Open(sIdent, sPrintStderr);
+    }
+    else
+    {
+        sJournal.Close();
+    }
+#else
+    VerifyOrExit(!aEnabled, error = OTBR_ERROR_ERRNO; errno = ENOTSUP);
+#endif
+
+exit:
+    return error;
+}
+
+/** Set the Thread interface recorded by the journal */
+void otbrLogSetInterface(const char *aInterfaceName)
+{
+#if OTBR_ENABLE_JOURNALD
+    sJournal.SetInterface(aInterfaceName);
+#else
+    (void)aInterfaceName;
+#endif
+}
+
+/** Set the session logs of the calling thread belong to */
+uint32_t otbrLogSetSession(uint32_t aSession)
+{
+    uint32_t previous = sLogSession;
+
+    sLogSession = aSession;
+
+    return previous;
+}
+
 /** Enable logging to a specific file */
 void otbrLogSetFilename(const char *filename)
 {
+    LogStopWriter();
     if (sLogFp)
     {
         fclose(sLogFp);
@@ -73,6 +234,7 @@ void otbrLogSetFilename(const char *filename)
         perror(filename);
         exit(EXIT_FAILURE);
     }
+    LogStartWriter();
 }
 
 /** Get the current debug log level */
@@ -88,8 +250,87 @@ void otbrLogSetLevel(int aLevel)
     sLevel = aLevel;
 }
 
+/** Set the log level of a module */
+void otbrLogSetModuleLevel(otbrLogModule aModule, int aLevel)
+{
+    assert(aModule >= OTBR_LOG_MODULE_DEFAULT && aModule < OTBR_LOG_MODULE_NUM);
+
+    if (aModule == OTBR_LOG_MODULE_DEFAULT)
+    {
+        otbrLogSetLevel(aLevel);
+    }
+    else
+    {
+        assert(aLevel == OTBR_LOG_INHERIT || (aLevel >= LOG_EMERG && aLevel <= LOG_DEBUG));
+        sModuleLevels[aModule] = aLevel;
+    }
+}
+
+/** Get the log level set to a module */
+int otbrLogGetModuleLevel(otbrLogModule aModule)
+{
+    assert(aModule >= OTBR_LOG_MODULE_DEFAULT && aModule < OTBR_LOG_MODULE_NUM);
+
+    return aModule == OTBR_LOG_MODULE_DEFAULT ? sLevel : sModuleLevels[aModule];
+}
+
+/** Get the log level in effect for a module */
+int otbrLogGetEffectiveLevel(otbrLogModule aModule)
+{
+    int level = otbrLogGetModuleLevel(aModule);
+
+    return level == OTBR_LOG_INHERIT ? sLevel : level;
+}
+
+const char *otbrLogModuleToString(otbrLogModule aModule)
+{
+    assert(aModule >= OTBR_LOG_MODULE_DEFAULT && aModule < OTBR_LOG_MODULE_NUM);
+
+    return kModuleNames[aModule];
+}
+
+otbrLogModule otbrLogModuleFromString(const char *aName)
+{
+    int module = OTBR_LOG_MODULE_DEFAULT;
+
+    while (module < OTBR_LOG_MODULE_NUM && strcmp(kModuleNames[module], aName) != 0)
+    {
+        module++;
+    }
+
+    return static_cast<otbrLogModule>(module);
+}
+
+bool otbrLogParseLevel(const char *aArgument)
+{
+    const char *  separator = strchr(aArgument, '=');
+    const char *  level     = aArgument;
+    otbrLogModule module    = OTBR_LOG_MODULE_DEFAULT;
+    char *        end;
+    long          value;
+    bool          valid = false;
+
+    if (separator != NULL)
+    {
+        module = otbrLogModuleFromString(std::string(aArgument, separator).c_str());
+        level  = separator + 1;
+        VerifyOrExit(module != OTBR_LOG_MODULE_NUM);
+    }
+
+    value = strtol(level, &end, 10);
+    VerifyOrExit(end != level && *end == '\0');
+    VerifyOrExit((value >= LOG_EMERG && value <= LOG_DEBUG) ||
+                 (value == OTBR_LOG_INHERIT && module != OTBR_LOG_MODULE_DEFAULT));
+
+    otbrLogSetModuleLevel(module, static_cast<int>(value));
+    valid = true;
+
+exit:
+    return valid;
+}
+
 /** Determine if we should not or not log, and if so where to */
-static int LogCheck(int aLevel)
+static int LogCheck(otbrLogModule aModule, int aLevel)
 {
     int r;
 
@@ -97,7 +338,7 @@ static int LogCheck(int aLevel)
 
     r = 0;
 
-    if (sSyslogOpened && sSyslogEnabled && (aLevel <= sLevel))
+    if (sSyslogOpened && sSyslogEnabled && (aLevel <= otbrLogGetEffectiveLevel(aModule)))
     {
         r = r | LOGFLAG_syslog;
     }
@@ -110,6 +351,12 @@ static int LogCheck(int aLevel)
     {
         r = r | LOGFLAG_file;
     }
+
+    /* the circular log is kept for post-mortem, like the separate file */
+    if (sCircularLog.IsOpen())
+    {
+        r = r | LOGFLAG_circular;
+    }
     return r;
 }
 
@@ -122,58 +369,276 @@ static unsigned long GetMsecsNow(void)
     return now;
 }
 
-/** Write this string to the private log file, inserting the timestamp at column 0 */
-static void LogString(const char *cp)
+/** Write all ready records to the private log file, returns the number of records written */
+static size_t LogWriteRecords(void)
 {
-    int ch;
+    enum
+    {
+        kMaxBatch = 64,
+    };
+
+    size_t       count = 0;
+    size_t       batch;
+    struct iovec iov[kMaxBatch + 1];
+    char         dropped[64];
+    uint32_t     droppedCount;
 
-    while ((ch = *cp++) != 0)
+    do
     {
-        if (sLogCol0)
+        size_t pos      = sLogDequeuePos.load(std::memory_order_relaxed);
+        int    iovCount = 0;
+
+        droppedCount = sLogDropped.load() - sLogDroppedReported;
+
+        if (droppedCount > 0)
+        {
+            unsigned long now = GetMsecsNow();
+
+            sLogDroppedReported += droppedCount;
+            iov[iovCount].iov_base = dropped;
+            iov[iovCount].iov_len  = static_cast<size_t>(snprintf(
+                dropped, sizeof(dropped), "%4lu.%03lu | %u logs dropped\n", (now / 1000), (now % 1000), droppedCount));
+            iovCount++;
+        }
+
+        for (batch = 0; batch < kMaxBatch; batch++)
         {
-            sLogCol0 = false;
-            unsigned long n;
-            n = GetMsecsNow();
-            fprintf(sLogFp, "%4lu.%03lu | ", (n / 1000), (n % 1000));
+            LogRecord &record = sLogRecords[(pos + batch) & (OTBR_CONFIG_LOG_RECORDS - 1)];
+
+            if (record.mSequence.load(std::memory_order_acquire) != pos + batch + 1)
+            {
+                break;
+            }
+
+            iov[iovCount].iov_base = record.mText;
+            iov[iovCount].iov_len  = record.mLength;
+            iovCount++;
         }
-        if (ch == '\n')
+
+        if (iovCount > 0 && writev(fileno(sLogFp), iov, iovCount) < 0)
         {
-            sLogCol0 = true;
+            sLogDropped += static_cast<uint32_t>(batch);
         }
-        fputc(ch, sLogFp);
-        if (ch == '\n')
+
+        for (size_t i = 0; i < batch; i++)
         {
-            /* force flush (in case something crashes) */
-            fflush(sLogFp);
+            sLogRecords[(pos + i) & (OTBR_CONFIG_LOG_RECORDS - 1)].mSequence.store(pos + i + OTBR_CONFIG_LOG_RECORDS,
+                                                                                   std::memory_order_release);
         }
+
+        sLogDequeuePos.store(pos + batch, std::memory_order_relaxed);
+
+        count += batch;
+    } while (batch == kMaxBatch);
+
+    return count;
+}
+
+/** Body of the writer thread batching records into the private log file */
+static void LogWriterMain(void)
+{
+    std::unique_lock<std::mutex> lock(sLogWriterLock, std::defer_lock);
+
+    otbr::ApplyThreadPolicy(otbr::kThreadClassLog);
+    lock.lock();
+
+    while (sLogWriterRunning.load())
+    {
+        sLogWriterSignal.wait_for(lock, std::chrono::milliseconds(OTBR_CONFIG_LOG_FLUSH_INTERVAL));
+        LogWriteRecords();
+    }
+
+    // Drain what producers queued before stopping.
+    LogWriteRecords();
+}
+
+/** Start the writer thread of the private log file */
+static void LogStartWriter(void)
+{
+    size_t pos = sLogDequeuePos.load();
+
+    for (size_t i = 0; i < OTBR_CONFIG_LOG_RECORDS; i++)
+    {
+        sLogRecords[(pos + i) & (OTBR_CONFIG_LOG_RECORDS - 1)].mSequence.store(pos + i, std::memory_order_relaxed);
     }
+
+    sLogEnqueuePos.store(pos);
+    sLogWriterRunning = true;
+    sLogWriter        = std::thread(LogWriterMain);
 }
 
-/** Print to the private log file */
-static void LogVprintf(const char *fmt, va_list ap)
+/** Stop the writer thread of the private log file, after writing all pending records */
+static void LogStopWriter(void)
 {
-    char buf[1024];
+    VerifyOrExit(sLogWriterRunning.load());
+
+    {
+        std::lock_guard<std::mutex> lock(sLogWriterLock);
+
+        sLogWriterRunning = false;
+    }
+
+    sLogWriterSignal.notify_one();
+    sLogWriter.join();
+
+exit:
+    return;
+}
+
+/** Claim a free record of the private log file, returns NULL if it is not enabled or the writer falls behind */
+static LogRecord *LogClaimRecord(size_t &aPos)
+{
+    LogRecord *record = NULL;
+    size_t     pos    = sLogEnqueuePos.load(std::memory_order_relaxed);
 
     /* if not enabled ... leave */
-    if (sLogFp == NULL)
+    VerifyOrExit(sLogWriterRunning.load(std::memory_order_relaxed));
+
+    // Claim a free record, or drop the log when the writer falls behind.
+    while (true)
+    {
+        size_t sequence;
+
+        record   = &sLogRecords[pos & (OTBR_CONFIG_LOG_RECORDS - 1)];
+        sequence = record->mSequence.load(std::memory_order_acquire);
+
+        if (sequence == pos)
+        {
+            if (sLogEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (static_cast<ptrdiff_t>(sequence - pos) < 0)
+        {
+            ++sLogDropped;
+            ExitNow(record = NULL);
+        }
+        else
+        {
+            pos = sLogEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    aPos = pos;
+
+exit:
+    return record;
+}
+
+/** Truncate a log line of @p aLength characters formatted into @p aText and end it with a newline */
+static int LogTerminateLine(char *aText, size_t aSize, int aLength)
+{
+    int length = aLength;
+
+    if (length >= static_cast<int>(aSize))
+    {
+        length = static_cast<int>(aSize) - 1;
+    }
+
+    /* logs do not end with a NEWLINE, we add one here */
+    if (aText[length - 1] != '\n')
+    {
+        if (length == static_cast<int>(aSize) - 1)
+        {
+            length--;
+        }
+
+        aText[length++] = '\n';
+    }
+
+    return length;
+}
+
+/** Hand a claimed record of @p aLength characters over to the writer */
+static void LogCommitRecord(LogRecord &aRecord, size_t aPos, int aLevel, int aLength)
+{
+    int length = LogTerminateLine(aRecord.mText, sizeof(aRecord.mText), aLength);
+
+    aRecord.mLength = static_cast<uint16_t>(length);
+    aRecord.mSequence.store(aPos + 1, std::memory_order_release);
+
+    // Errors are written right away so that they are not lost in a crash shortly after.
+    if (aLevel <= OTBR_LOG_ERR ||
+        aPos + 1 - sLogDequeuePos.load(std::memory_order_relaxed) >= OTBR_CONFIG_LOG_FLUSH_THRESHOLD)
     {
-        return;
+        sLogWriterSignal.notify_one();
     }
-    vsnprintf(buf, sizeof(buf), fmt, ap);
+}
+
+/** Print the timestamp of a log line, returns its length */
+static int LogPrintTimestamp(char *aText, size_t aSize)
+{
+    unsigned long now = GetMsecsNow();
+
+    return snprintf(aText, aSize, "%4lu.%03lu | ", (now / 1000), (now % 1000));
+}
+
+/** Print to the private log file, without blocking on the file */
+static void LogVprintf(int aLevel, const char *fmt, va_list ap)
+{
+    LogRecord *record;
+    size_t     pos;
+    int        length;
+    int        prefixLength;
+
+    VerifyOrExit((record = LogClaimRecord(pos)) != NULL);
+
+    prefixLength = LogPrintTimestamp(record->mText, sizeof(record->mText));
+    length       = vsnprintf(record->mText + prefixLength, sizeof(record->mText) - prefixLength, fmt, ap);
+    length       = (length < 0) ? prefixLength : prefixLength + length;
+
+    LogCommitRecord(*record, pos, aLevel, length);
+
+exit:
+    return;
+}
+
+/** Append to the circular log */
+static void LogCircularv(const char *aFormat, va_list ap)
+{
+    char line[OTBR_CONFIG_LOG_RECORD_SIZE];
+    int  length = LogPrintTimestamp(line, sizeof(line));
+    int  messageLength;
 
-    LogString(buf);
+    messageLength = vsnprintf(line + length, sizeof(line) - length, aFormat, ap);
+    length        = LogTerminateLine(line, sizeof(line), length + (messageLength < 0 ? 0 : messageLength));
+
+    sCircularLog.Append(line, static_cast<size_t>(length));
+}
+
+/** Append to the circular log */
+static void LogCircular(const char *aFormat, ...)
+{
+    va_list ap;
+
+    va_start(ap, aFormat);
+    LogCircularv(aFormat, ap);
+    va_end(ap);
 }
 
-/** Print to the private log file */
-static void LogPrintf(const char *fmt, ...)
+/** Record to the binary log */
+static void LogBinary(int aLevel, const char *fmt, ...)
 {
     va_list ap;
 
     va_start(ap, fmt);
-    LogVprintf(fmt, ap);
+    sBinaryLog.Record(aLevel, fmt, ap);
     va_end(ap);
 }
 
+/** Enable the binary log */
+otbrError otbrLogSetBinaryFilename(const char *aFilename)
+{
+    return sBinaryLog.Open(aFilename, OTBR_CONFIG_LOG_BINARY_SIZE);
+}
+
+/** Enable logging to a circular log file */
+otbrError otbrLogSetCircularFilename(const char *aFilename)
+{
+    return sCircularLog.Open(aFilename, OTBR_CONFIG_LOG_CIRCULAR_SIZE);
+}
+
 /** Initialize logging */
 void otbrLogInit(const char *aIdent, int aLevel, bool aPrintStderr)
 {
@@ -186,104 +651,273 @@ void otbrLogInit(const char *aIdent, int aLevel, bool aPrintStderr)
     if (!sSyslogOpened)
     {
         sSyslogOpened = true;
+        sIdent        = aIdent;
+        sPrintStderr  = aPrintStderr;
         openlog(aIdent, (LOG_CONS | LOG_PID) | (aPrintStderr ? LOG_PERROR : 0), LOG_USER);
     }
     sLevel = aLevel;
 }
 
+/** Determine if some output takes this level */
+bool otbrLogIsEnabled(int aLevel)
+{
+    return otbrLogIsModuleEnabled(OTBR_LOG_MODULE_DEFAULT, aLevel);
+}
+
+/** Determine if some output takes this level of the module */
+bool otbrLogIsModuleEnabled(otbrLogModule aModule, int aLevel)
+{
+    return (sSyslogOpened && sSyslogEnabled && aLevel <= otbrLogGetEffectiveLevel(aModule)) || sLogFp != NULL ||
+           sBinaryLog.IsOpen() || sCircularLog.IsOpen();
+}
+
+/** Take a token from the bucket of a throttled call site */
+bool otbrLogTakeToken(otbrLogModule aModule, int aLevel, otbrLogBucket &aBucket, uint32_t aRate, uint32_t aBurst)
+{
+    static const uint32_t kTokenScale = 1000;
+
+    unsigned long now      = otbr::GetNow();
+    uint64_t      capacity = static_cast<uint64_t>(aBurst) * kTokenScale;
+    uint64_t      tokens   = aBucket.mTokens;
+    bool          taken    = false;
+
+    // A call site starts with a full bucket, refilled by aRate tokens per second, i.e. per thousand milliseconds.
+    if (aBucket.mTime == 0)
+    {
+        tokens = capacity;
+    }
+    else
+    {
+        tokens += static_cast<uint64_t>(now - aBucket.mTime) * aRate;
+    }
+    aBucket.mTime   = now;
+    aBucket.mTokens = static_cast<uint32_t>(tokens < capacity ? tokens : capacity);
+
+    if (aBucket.mTokens < kTokenScale)
+    {
+        aBucket.mSuppressed++;
+        ExitNow();
+    }
+
+    aBucket.mTokens -= kTokenScale;
+    taken = true;
+
+    if (aBucket.mSuppressed > 0)
+    {
+        otbrLogImpl(aModule, aLevel, "%u similar logs suppressed", aBucket.mSuppressed);
+        aBucket.mSuppressed = 0;
+    }
+
+exit:
+    return taken;
+}
+
 /** log to the syslog or log file */
-void otbrLog(int aLevel, const char *aFormat, ...)
+void otbrLogImpl(otbrLogModule aModule, int aLevel, const char *aFormat, ...)
 {
     va_list ap;
 
     va_start(ap, aFormat);
-    otbrLogv(aLevel, aFormat, ap);
+    otbrLogv(aModule, aLevel, aFormat, ap);
     va_end(ap);
 }
 
-/** log to the syslog or log file */
-void otbrLogv(int aLevel, const char *aFormat, va_list ap)
+/** log to the journal if enabled, else to the syslog */
+static void LogSystemv(otbrLogModule aModule, int aLevel, const otbrError *aError, const char *aFormat, va_list ap)
+{
+#if OTBR_ENABLE_JOURNALD
+    if (sJournal.IsOpen())
+    {
+        sJournal.Record(aModule, aLevel, aError, sLogSession, aFormat, ap);
+    }
+    else
+#else
+    (void)aModule;
+    (void)aError;
+#endif
+    {
+        vsyslog(aLevel, aFormat, ap);
+    }
+}
+
+/** log to the journal if enabled, else to the syslog */
+static void LogSystem(otbrLogModule aModule, int aLevel, const char *aFormat, ...)
+{
+    va_list ap;
+
+    va_start(ap, aFormat);
+    LogSystemv(aModule, aLevel, NULL, aFormat, ap);
+    va_end(ap);
+}
+
+/** log to all outputs, along with the error the log reports if any */
+static void LogWritev(otbrLogModule aModule, int aLevel, const otbrError *aError, const char *aFormat, va_list ap)
 {
     int r;
 
     assert(aFormat);
 
-    r = LogCheck(aLevel);
+    r = LogCheck(aModule, aLevel);
+
+    /* the binary log records all levels, formatting is deferred to the decoder */
+    if (sBinaryLog.IsOpen())
+    {
+        va_list cpy;
+        va_copy(cpy, ap);
+        sBinaryLog.Record(aLevel, aFormat, cpy);
+        va_end(cpy);
+    }
 
     if (r & LOGFLAG_file)
     {
         va_list cpy;
         va_copy(cpy, ap);
-        LogVprintf(aFormat, cpy);
+        LogVprintf(aLevel, aFormat, cpy);
         va_end(cpy);
+    }
 
-        /* logs do not end with a NEWLINE, we add one here */
-        LogString("\n");
+    if (r & LOGFLAG_circular)
+    {
+        va_list cpy;
+        va_copy(cpy, ap);
+        LogCircularv(aFormat, cpy);
+        va_end(cpy);
     }
 
     if (r & LOGFLAG_syslog)
     {
-        vsyslog(aLevel, aFormat, ap);
+        LogSystemv(aModule, aLevel, aError, aFormat, ap);
     }
 }
 
-/** Hex dump data to the log */
-void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize)
+/** log to the syslog or log file */
+void otbrLogv(otbrLogModule aModule, int aLevel, const char *aFormat, va_list ap)
 {
-    assert(aPrefix && (aMemory || aSize == 0));
-    const uint8_t *pEnd;
-    const uint8_t *p8;
-    int            r;
-    int            addr;
+    LogWritev(aModule, aLevel, NULL, aFormat, ap);
+}
 
-    r = LogCheck(aLevel);
-    if (r == 0)
+/** The two hex digits of each byte value */
+struct HexPairs
+{
+    HexPairs(void)
     {
-        return;
+        static const char kHexChars[] = "0123456789abcdef";
+
+        for (int i = 0; i < 256; i++)
+        {
+            mDigits[i][0] = kHexChars[i >> 4];
+            mDigits[i][1] = kHexChars[i & 0x0f];
+        }
     }
 
-    /* break hex dumps into 16byte lines
-     * In the form ADDR: XX XX XX XX ...
-     */
+    char mDigits[256][2];
+};
+
+/** Encode bytes as space separated hex digits into @p aHex, which takes 3 characters per byte, returns the length */
+static size_t LogEncodeHex(const uint8_t *aBytes, size_t aLength, char *aHex)
+{
+    static const HexPairs sPairs;
 
-    // we pre-increment... so subtract
-    addr = -16;
+    char *hex = aHex;
 
-    while (aSize > 0)
+    // Each byte is one lookup and a copy of two digits, instead of a lookup per digit.
+    for (size_t i = 0; i < aLength; i++, hex += 3)
     {
-        size_t this_size;
-        char   hex[16 * 3 + 1];
+        memcpy(hex, sPairs.mDigits[aBytes[i]], 2);
+        hex[2] = ' ';
+    }
 
-        addr = addr + 16;
-        p8   = (const uint8_t *)(aMemory) + addr;
+    if (hex != aHex)
+    {
+        hex--;
+    }
+    *hex = '\0';
 
-        /* truncate line to max 16 bytes */
-        this_size = aSize;
-        if (this_size > 16)
-        {
-            this_size = 16;
-        }
-        aSize = aSize - this_size;
+    return static_cast<size_t>(hex - aHex);
+}
 
-        char *ch = hex - 1;
+/** Dump a line of hex straight into a record of the private log file */
+static void LogDumpLine(int aLevel, const char *aPrefix, unsigned aOffset, const uint8_t *aBytes, size_t aLength)
+{
+    LogRecord *record;
+    size_t     pos;
+    int        length;
+    size_t     room;
 
-        for (pEnd = p8 + this_size; p8 < pEnd; p8++)
-        {
-            *++ch = kHexChars[(*p8) >> 4];
-            *++ch = kHexChars[(*p8) & 0x0f];
-            *++ch = ' ';
-        }
-        *ch = 0;
+    VerifyOrExit((record = LogClaimRecord(pos)) != NULL);
+
+    length = LogPrintTimestamp(record->mText, sizeof(record->mText));
+    length += snprintf(record->mText + length, sizeof(record->mText) - length, "%s: %04x: ", aPrefix, aOffset);
+
+    // A long prefix leaves less room, and the bytes beyond are cut like a long log is.
+    if (length < static_cast<int>(sizeof(record->mText)))
+    {
+        room = (sizeof(record->mText) - static_cast<size_t>(length)) / 3;
+        length += static_cast<int>(LogEncodeHex(aBytes, aLength < room ? aLength : room, record->mText + length));
+    }
+
+    LogCommitRecord(*record, pos, aLevel, length);
+
+exit:
+    return;
+}
 
-        if (r & LOGFLAG_syslog)
+/** Hex dump data to the log */
+void otbrDumpImpl(otbrLogModule aModule, int aLevel, const char *aPrefix, const void *aMemory, size_t aSize)
+{
+    static const size_t kLineSize = 16;
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(aMemory);
+    size_t         size  = aSize < OTBR_CONFIG_LOG_DUMP_MAX_SIZE ? aSize : OTBR_CONFIG_LOG_DUMP_MAX_SIZE;
+    int            r;
+
+    assert(aPrefix && (aMemory || aSize == 0));
+
+    // The hex digits are only formatted for the outputs which take the level.
+    r = LogCheck(aModule, aLevel);
+    VerifyOrExit(r != 0 || sBinaryLog.IsOpen());
+
+    /* break hex dumps into 16byte lines
+     * In the form ADDR: XX XX XX XX ...
+     */
+    for (size_t offset = 0; offset < size; offset += kLineSize)
+    {
+        size_t   length = (size - offset < kLineSize) ? size - offset : kLineSize;
+        unsigned addr   = static_cast<unsigned>(offset);
+        char     hex[kLineSize * 3];
+
+        if (r & LOGFLAG_file)
         {
-            syslog(aLevel, "%s: %04x: %s", aPrefix, addr, hex);
+            LogDumpLine(aLevel, aPrefix, addr, bytes + offset, length);
         }
-        if (r & LOGFLAG_file)
+
+        if ((r & (LOGFLAG_syslog | LOGFLAG_circular)) || sBinaryLog.IsOpen())
         {
-            LogPrintf("%s: %04x: %s\n", aPrefix, addr, hex);
+            LogEncodeHex(bytes + offset, length, hex);
+
+            if (r & LOGFLAG_circular)
+            {
+                LogCircular("%s: %04x: %s", aPrefix, addr, hex);
+            }
+
+            if (r & LOGFLAG_syslog)
+            {
+                LogSystem(aModule, aLevel, "%s: %04x: %s", aPrefix, addr, hex);
+            }
+            if (sBinaryLog.IsOpen())
+            {
+                LogBinary(aLevel, "%s: %04x: %s", aPrefix, addr, hex);
+            }
         }
     }
+
+    if (size < aSize)
+    {
+        otbrLogImpl(aModule, aLevel, "%s: %zu more bytes not dumped", aPrefix, aSize - size);
+    }
+
+exit:
+    return;
 }
 
 const char *otbrErrorString(otbrError aError)
@@ -323,13 +957,44 @@ const char *otbrErrorString(otbrError aError)
     return error;
 }
 
-void otbrLogResult(const char *aAction, otbrError aError)
+/** log to all outputs, along with the error the log reports */
+static void LogWriteError(otbrLogModule aModule, int aLevel, otbrError aError, const char *aFormat, ...)
 {
-    otbrLog((aError == OTBR_ERROR_NONE ? OTBR_LOG_INFO : OTBR_LOG_WARNING), "%s: %s", aAction, otbrErrorString(aError));
+    va_list ap;
+
+    va_start(ap, aFormat);
+    LogWritev(aModule, aLevel, &aError, aFormat, ap);
+    va_end(ap);
+}
+
+void otbrLogResultImpl(otbrLogModule aModule, const char *aAction, otbrError aError)
+{
+    int level = (aError == OTBR_ERROR_NONE ? OTBR_LOG_INFO : OTBR_LOG_WARNING);
+
+    if (otbrLogIsModuleEnabled(aModule, level))
+    {
+        LogWriteError(aModule, level, aError, "%s: %s", aAction, otbrErrorString(aError));
+    }
+}
+
+uint32_t otbrLogGetDroppedCount(void)
+{
+    return sLogDropped.load();
 }
 
 void otbrLogDeinit(void)
 {
+    sBinaryLog.Close();
+    sCircularLog.Close();
+    LogStopWriter();
+    if (sLogFp)
+    {
+        fclose(sLogFp);
+        sLogFp = NULL;
+    }
+#if OTBR_ENABLE_JOURNALD
+    sJournal.Close();
+#endif
     sSyslogOpened = false;
     closelog();
 }
@@ -33,7 +33,9 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
 
+#include "common/time.hpp"
 #include "common/types.hpp"
 
 /**
@@ -52,6 +54,163 @@ enum
     OTBR_LOG_DEBUG,   /* debug-level messages */
 };
 
+/**
+ * The log level of a module following the default log level.
+ *
+ */
+#define OTBR_LOG_INHERIT (-1)
+
+/**
+ * Logging modules, each of which has its own log level.
+ *
+ */
+enum otbrLogModule
+{
+    OTBR_LOG_MODULE_DEFAULT, ///< Logs of no specific module, whose level is the default for the other modules.
+    OTBR_LOG_MODULE_MDNS,    ///< mDNS publisher and advertising proxy.
+    OTBR_LOG_MODULE_DTLS,    ///< DTLS server of the border agent.
+    OTBR_LOG_MODULE_DBUS,    ///< D-Bus server.
+    OTBR_LOG_MODULE_NCP,     ///< Controller of the Thread NCP, including the logs of OpenThread.
+    OTBR_LOG_MODULE_UBUS,    ///< ubus server of OpenWrt.
+    OTBR_LOG_MODULE_WEB,     ///< Web service.
+    OTBR_LOG_MODULE_NUM,     ///< The number of modules.
+};
+
+/**
+ * The module of the logs in a source file, which is defined before any include to set another module.
+ *
+ */
+#ifndef OTBR_LOG_MODULE
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_DEFAULT
+#endif
+
+/**
+ * The most verbose log level built in, logs of less severe levels compile out.
+ *
+ */
+#ifndef OTBR_CONFIG_LOG_LEVEL
+#define OTBR_CONFIG_LOG_LEVEL OTBR_LOG_DEBUG
+#endif
+
+/**
+ * This macro indicates whether logs at level @p aLevel of the module of the source file are built in and written.
+ *
+ * @param[in]   aLevel  Log level of the logger.
+ *
+ */
+#define otbrLogIsOn(aLevel) ((aLevel) <= OTBR_CONFIG_LOG_LEVEL && otbrLogIsModuleEnabled(OTBR_LOG_MODULE, (aLevel)))
+
+/**
+ * This macro logs at level @p aLevel.
+ *
+ * The arguments are not evaluated unless the log is built in and some output takes @p aLevel.
+ *
+ * @param[in]   aLevel  Log level of the logger.
+ * @param[in]   aFormat Format string as in printf.
+ *
+ */
+#define otbrLog(aLevel, ...) (otbrLogIsOn(aLevel) ? otbrLogImpl(OTBR_LOG_MODULE, (aLevel), __VA_ARGS__) : (void)0)
+
+/**
+ * This macro dumps memory as hex string at level @p aLevel.
+ *
+ * The arguments are not evaluated unless the log is built in and some output takes @p aLevel.
+ *
+ * @param[in]   aLevel  Log level of the logger.
+ * @param[in]   aPrefix String before dumping memory.
+ * @param[in]   aMemory The pointer to the memory to be dumped.
+ * @param[in]   aSize   The size of memory in bytes to be dumped.
+ *
+ */
+#define otbrDump(aLevel, aPrefix, aMemory, aSize) \
+    (otbrLogIsOn(aLevel) ? otbrDumpImpl(OTBR_LOG_MODULE, (aLevel), (aPrefix), (aMemory), (aSize)) : (void)0)
+
+/**
+ * This macro logs at OTBR_LOG_DEBUG on hot paths, and compiles out unless OTBR_ENABLE_LOG_TRACE is set.
+ *
+ */
+#if OTBR_ENABLE_LOG_TRACE
+#define otbrLogTrace(...) otbrLog(OTBR_LOG_DEBUG, __VA_ARGS__)
+#else
+#define otbrLogTrace(...) \
+    do                    \
+    {                     \
+    } while (false)
+#endif
+
+/**
+ * This macro logs at level @p aLevel at most once every @p aInterval milliseconds from this call site.
+ *
+ * @param[in]   aInterval   The minimum interval in milliseconds between two logs.
+ * @param[in]   aLevel      Log level of the logger.
+ *
+ */
+#define otbrLogRateLimited(aInterval, aLevel, ...)                                               \
+    do                                                                                           \
+    {                                                                                            \
+        static unsigned long sLastLogTime = 0;                                                   \
+        unsigned long        logNow       = otbr::GetNow();                                      \
+                                                                                                 \
+        if (sLastLogTime == 0 || logNow - sLastLogTime >= static_cast<unsigned long>(aInterval)) \
+        {                                                                                        \
+            sLastLogTime = logNow;                                                               \
+            otbrLog(aLevel, __VA_ARGS__);                                                        \
+        }                                                                                        \
+    } while (false)
+
+/**
+ * This macro logs at level @p aLevel one in every @p aRate calls from this call site, for logs too many to keep all.
+ *
+ * Only the calls when the log is written count, so that a disabled log costs the same as otbrLog().
+ *
+ * @param[in]   aRate   One log is kept in every @p aRate.
+ * @param[in]   aLevel  Log level of the logger.
+ *
+ */
+#define otbrLogSampled(aRate, aLevel, ...)                       \
+    do                                                           \
+    {                                                            \
+        static unsigned sLogCount = 0;                           \
+                                                                 \
+        if (otbrLogIsOn(aLevel) && sLogCount++ % (aRate) == 0)   \
+        {                                                        \
+            otbrLogImpl(OTBR_LOG_MODULE, (aLevel), __VA_ARGS__); \
+        }                                                        \
+    } while (false)
+
+/**
+ * This structure represents the token bucket of a call site throttled by otbrLogThrottled().
+ *
+ */
+struct otbrLogBucket
+{
+    unsigned long mTime;       ///< The time of the last refill, in milliseconds.
+    uint32_t      mTokens;     ///< The tokens, in thousandths of a log.
+    uint32_t      mSuppressed; ///< The number of logs suppressed since the last one written.
+};
+
+/**
+ * This macro logs at level @p aLevel from this call site at most @p aRate times per second on average, in bursts of
+ * up to @p aBurst logs.
+ *
+ * The number of logs suppressed is written before the next log which is not.
+ *
+ * @param[in]   aRate   The average number of logs per second.
+ * @param[in]   aBurst  The maximum number of logs in a burst.
+ * @param[in]   aLevel  Log level of the logger.
+ *
+ */
+#define otbrLogThrottled(aRate, aBurst, aLevel, ...)                                                           \
+    do                                                                                                         \
+    {                                                                                                          \
+        static otbrLogBucket sLogBucket = {0, 0, 0};                                                           \
+                                                                                                               \
+        if (otbrLogIsOn(aLevel) && otbrLogTakeToken(OTBR_LOG_MODULE, (aLevel), sLogBucket, (aRate), (aBurst))) \
+        {                                                                                                      \
+            otbrLogImpl(OTBR_LOG_MODULE, (aLevel), __VA_ARGS__);                                               \
+        }                                                                                                      \
+    } while (false)
+
 /**
  * Change the log level
  *
@@ -65,6 +224,65 @@ void otbrLogSetLevel(int aLevel);
  */
 int otbrLogGetLevel(void);
 
+/**
+ * This function sets the log level of a module.
+ *
+ * @param[in]   aModule The module, OTBR_LOG_MODULE_DEFAULT to set the default log level.
+ * @param[in]   aLevel  The log level, or OTBR_LOG_INHERIT to follow the default log level.
+ *
+ */
+void otbrLogSetModuleLevel(otbrLogModule aModule, int aLevel);
+
+/**
+ * This function gets the log level of a module.
+ *
+ * @param[in]   aModule The module.
+ *
+ * @returns The log level set to the module, or OTBR_LOG_INHERIT if it follows the default log level.
+ *
+ */
+int otbrLogGetModuleLevel(otbrLogModule aModule);
+
+/**
+ * This function gets the log level in effect for a module.
+ *
+ * @param[in]   aModule The module.
+ *
+ * @returns The log level of the module, or the default log level if it follows the default.
+ *
+ */
+int otbrLogGetEffectiveLevel(otbrLogModule aModule);
+
+/**
+ * This function gets the name of a module.
+ *
+ * @param[in]   aModule The module.
+ *
+ * @returns The name of the module.
+ *
+ */
+const char *otbrLogModuleToString(otbrLogModule aModule);
+
+/**
+ * This function finds a module by name.
+ *
+ * @param[in]   aName   The name of the module.
+ *
+ * @returns The module, or OTBR_LOG_MODULE_NUM if no module has the name.
+ *
+ */
+otbrLogModule otbrLogModuleFromString(const char *aName);
+
+/**
+ * This function sets the log level of a module, or the default log level, from an argument of the command line.
+ *
+ * @param[in]   aArgument   The argument, either LEVEL for the default log level or MODULE=LEVEL.
+ *
+ * @returns Whether the argument is valid.
+ *
+ */
+bool otbrLogParseLevel(const char *aArgument);
+
 /**
  * Control log to syslog
  *
@@ -73,14 +291,72 @@ int otbrLogGetLevel(void);
  */
 void otbrLogEnableSyslog(bool aEnabled);
 
+/**
+ * This function causes logs to be sent to the systemd journal instead of the syslog, with structured fields.
+ * Note: The journal records the module, the Thread interface, the error and the session of each log.
+ * Note: Logs are sent by a background thread, in batches, until otbrLogDeinit() is called.
+ *
+ * @param[in]   aEnabled    true to send logs to the journal, false to send logs to the syslog again.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully changed the output.
+ * @retval  OTBR_ERROR_ERRNO    EINVAL if logging is not initialized, or ENOTSUP if not built with journal support.
+ *
+ */
+otbrError otbrLogEnableJournal(bool aEnabled);
+
+/**
+ * This function sets the Thread interface which the journal records with all following logs.
+ *
+ * @param[in]   aInterfaceName  The name of the Thread interface.
+ *
+ */
+void otbrLogSetInterface(const char *aInterfaceName);
+
+/**
+ * This function sets the session which the following logs of the calling thread belong to.
+ *
+ * @param[in]   aSession    The session id, 0 for no session.
+ *
+ * @returns The previous session id of the calling thread.
+ *
+ */
+uint32_t otbrLogSetSession(uint32_t aSession);
+
 /**
  * This function causes logs to be written to a specific file
  * Note: Logs are still written to the syslog.
+ * Note: Logs are written by a background thread, in batches, until otbrLogDeinit() is called.
  *
  * @param[in] afilename filename to use for private logfile.
  */
 void otbrLogSetFilename(const char *aFilename);
 
+/**
+ * This function causes logs of all levels to be recorded to a binary log file, without being formatted.
+ * Note: Logs are still written to the syslog and private logfile.
+ * Note: The binary log is decoded offline by the log-decoder tool.
+ *
+ * @param[in]   aFilename   The path of the binary log file.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully created the binary log file.
+ * @retval  OTBR_ERROR_ERRNO    Failed to create the binary log file.
+ *
+ */
+otbrError otbrLogSetBinaryFilename(const char *aFilename);
+
+/**
+ * This function causes logs of all levels to be kept in a fixed size circular log file, for post-mortem.
+ * Note: Logs are still written to the syslog, private logfile and binary log.
+ * Note: The file is mapped in memory and survives a crash of the process, the log-decoder tool prints it.
+ *
+ * @param[in]   aFilename   The path of the circular log file, preferably on tmpfs.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully created the circular log file.
+ * @retval  OTBR_ERROR_ERRNO    Failed to create the circular log file.
+ *
+ */
+otbrError otbrLogSetCircularFilename(const char *aFilename);
+
 /**
  * This function initialize the logging service.
  *
@@ -92,16 +368,53 @@ void otbrLogSetFilename(const char *aFilename);
 void otbrLogInit(const char *aIdent, int aLevel, bool aPrintStderr);
 
 /**
- * This function log at level @p aLevel.
+ * This function indicates whether any output takes logs at level @p aLevel.
+ *
+ * @param[in]   aLevel  Log level of the logger.
+ *
+ * @returns Whether logs at @p aLevel are written.
+ *
+ */
+bool otbrLogIsEnabled(int aLevel);
+
+/**
+ * This function indicates whether any output takes logs of a module at level @p aLevel.
+ *
+ * @param[in]   aModule The module of the logger.
+ * @param[in]   aLevel  Log level of the logger.
+ *
+ * @returns Whether logs of @p aModule at @p aLevel are written.
+ *
+ */
+bool otbrLogIsModuleEnabled(otbrLogModule aModule, int aLevel);
+
+/**
+ * This function takes a token from the bucket of a call site throttled by otbrLogThrottled(), use otbrLogThrottled()
+ * instead.
  *
+ * @param[in]     aModule The module of the logger.
+ * @param[in]     aLevel  Log level of the logger.
+ * @param[inout]  aBucket The token bucket of the call site.
+ * @param[in]     aRate   The average number of logs per second.
+ * @param[in]     aBurst  The maximum number of logs in a burst.
+ *
+ * @returns Whether the log is written.
+ *
+ */
+bool otbrLogTakeToken(otbrLogModule aModule, int aLevel, otbrLogBucket &aBucket, uint32_t aRate, uint32_t aBurst);
+
+/**
+ * This function log at level @p aLevel, use otbrLog() instead.
+ *
+ * @param[in]   aModule The module of the logger.
  * @param[in]   aLevel  Log level of the logger.
  * @param[in]   aFormat Format string as in printf.
  *
  */
-void otbrLog(int aLevel, const char *aFormat, ...);
+void otbrLogImpl(otbrLogModule aModule, int aLevel, const char *aFormat, ...);
 
 /**
- * This function log a action result according to @p aError.
+ * This macro log a action result according to @p aError.
  *
  * If @p aError is OTBR_ERROR_NONE, the log level will be OTBR_LOG_INFO,
  * otherwise OTBR_LOG_WARNING.
@@ -110,27 +423,39 @@ void otbrLog(int aLevel, const char *aFormat, ...);
  * @param[in]   aError  The action result.
  *
  */
-void otbrLogResult(const char *aAction, otbrError aError);
+#define otbrLogResult(aAction, aError) otbrLogResultImpl(OTBR_LOG_MODULE, (aAction), (aError))
+
+/**
+ * This function log a action result according to @p aError, use otbrLogResult() instead.
+ *
+ * @param[in]   aModule The module of the logger.
+ * @param[in]   aAction The action description.
+ * @param[in]   aError  The action result.
+ *
+ */
+void otbrLogResultImpl(otbrLogModule aModule, const char *aAction, otbrError aError);
 
 /**
  * This function log at level @p aLevel.
  *
+ * @param[in]   aModule The module of the logger.
  * @param[in]   aLevel  Log level of the logger.
  * @param[in]   aFormat Format string as in printf.
  *
  */
-void otbrLogv(int aLevel, const char *aFormat, va_list);
+void otbrLogv(otbrLogModule aModule, int aLevel, const char *aFormat, va_list);
 
 /**
- * This function dump memory as hex string at level @p aLevel.
+ * This function dump memory as hex string at level @p aLevel, use otbrDump() instead.
  *
+ * @param[in]   aModule The module of the logger.
  * @param[in]   aLevel  Log level of the logger.
  * @param[in]   aPrefix String before dumping memory.
  * @param[in]   aMemory The pointer to the memory to be dumped.
  * @param[in]   aSize   The size of memory in bytes to be dumped.
  *
  */
-void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize);
+void otbrDumpImpl(otbrLogModule aModule, int aLevel, const char *aPrefix, const void *aMemory, size_t aSize);
 
 /**
  * This function converts error code to string.
@@ -142,6 +467,14 @@ void otbrDump(int aLevel, const char *aPrefix, const void *aMemory, size_t aSize
  */
 const char *otbrErrorString(otbrError aError);
 
+/**
+ * This function returns the number of logs dropped from the private log file because its writer fell behind.
+ *
+ * @returns The number of dropped logs.
+ *
+ */
+uint32_t otbrLogGetDroppedCount(void);
+
 /**
  * This function deinitializes the logging service.
  *
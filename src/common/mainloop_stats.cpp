@@ -0,0 +1,136 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements main loop statistics.
+ */
+
+#include "common/mainloop_stats.hpp"
+
+#include <assert.h>
+#include <inttypes.h>
+
+#include <atomic>
+
+#include "common/logging.hpp"
+#include "common/tracepoint.hpp"
+
+#ifndef OTBR_CONFIG_MAINLOOP_STALL_THRESHOLD
+/**
+ * The duration in milliseconds above which a main loop stage is reported as a stall.
+ *
+ */
+#define OTBR_CONFIG_MAINLOOP_STALL_THRESHOLD 500
+#endif
+
+namespace otbr {
+
+static std::atomic<uint32_t> sStalls(0);
+static std::atomic<uint64_t> sStallTime(0);
+
+// The stage nesting on the current thread, a stall is only logged for the innermost stage blocking it.
+static thread_local uint32_t sStageDepth   = 0;
+static thread_local bool     sStageStalled = false;
+
+Histogram &GetMainloopHistogram(MainloopStage aStage)
+{
+    static Histogram sHistograms[kMainloopStageNum];
+
+    assert(aStage < kMainloopStageNum);
+
+    return sHistograms[aStage];
+}
+
+const char *GetMainloopStageName(MainloopStage aStage)
+{
+    static const char *const kNames[] = {
+        "DispatchLatency",       "AgentUpdateFdSet",        "AgentProcess", "MdnsProcess",
+        "Timers",                "DBusUpdateFdSet",         "DBusProcess",  "UbusRequest",
+        "OtTasklets",            "OtProcess",               "RcpPropertyGet",
+        "AdvertisingProxyFlush", "AdvertisingProxyLatency", "BackgroundSlice",
+    };
+
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == kMainloopStageNum, "Stage names mismatch");
+    assert(aStage < kMainloopStageNum);
+
+    return kNames[aStage];
+}
+
+uint32_t GetMainloopStalls(void)
+{
+    return sStalls.load();
+}
+
+uint64_t GetMainloopStallTime(void)
+{
+    return sStallTime.load();
+}
+
+MainloopStageTimer::MainloopStageTimer(MainloopStage aStage)
+    : mStage(aStage)
+    , mStart(GetMainloopClock())
+    , mOutermost(sStageDepth == 0)
+    , mPrevStalled(sStageStalled)
+{
+    OTBR_TRACEPOINT1(mainloop__stage__begin, static_cast<int>(mStage));
+    ++sStageDepth;
+    sStageStalled = false;
+}
+
+MainloopStageTimer::~MainloopStageTimer(void)
+{
+    uint64_t duration = RecordMainloopStage(mStage, mStart);
+    bool     stalled  = duration >= OTBR_CONFIG_MAINLOOP_STALL_THRESHOLD * 1000ull;
+
+    OTBR_TRACEPOINT2(mainloop__stage__end, static_cast<int>(mStage), duration);
+    --sStageDepth;
+
+    if (stalled && !sStageStalled)
+    {
+        ++sStalls;
+        otbrLog(OTBR_LOG_WARNING, "Main loop stalled for %" PRIu64 "ms in %s", duration / 1000,
+                GetMainloopStageName(mStage));
+    }
+
+    if (stalled && mOutermost)
+    {
+        sStallTime += duration;
+    }
+
+    sStageStalled = mPrevStalled || stalled || sStageStalled;
+}
+
+void LogStartupMilestone(const char *aMilestone)
+{
+    static const uint64_t sStartTime = GetNowPrecise();
+
+    otbrLog(OTBR_LOG_INFO, "Startup: %s at +%" PRIu64 "ms", aMilestone, (GetNowPrecise() - sStartTime) / 1000);
+}
+
+} // namespace otbr
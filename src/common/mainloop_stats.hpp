@@ -0,0 +1,206 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for main loop statistics.
+ */
+
+#ifndef OTBR_COMMON_MAINLOOP_STATS_HPP_
+#define OTBR_COMMON_MAINLOOP_STATS_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include "common/histogram.hpp"
+#include "common/time.hpp"
+
+namespace otbr {
+
+/**
+ * This structure represents the wakeup counters of the agent main loop.
+ *
+ */
+struct MainloopCounters
+{
+    uint64_t mWakeups;          ///< The number of times the main loop returned from polling.
+    uint64_t mZeroTimeoutPolls; ///< The number of polls entered with a zero timeout.
+    uint64_t mSpuriousWakeups;  ///< The number of wakeups with neither a ready fd nor a due timer service timer.
+};
+
+/**
+ * This function returns the wakeup counters of the agent main loop.
+ *
+ * @returns A reference to the counters.
+ *
+ */
+inline MainloopCounters &GetMainloopCounters(void)
+{
+    static MainloopCounters sCounters;
+
+    return sCounters;
+}
+
+/**
+ * This enumeration defines the main loop stages with a duration histogram, in microseconds.
+ *
+ */
+enum MainloopStage
+{
+    kMainloopStageDispatchLatency,         ///< From the poll wakeup to the start of the agent instance processing.
+    kMainloopStageAgentUpdateFdSet,        ///< Agent instance UpdateFdSet().
+    kMainloopStageAgentProcess,            ///< Agent instance Process(), including the stages nested in it.
+    kMainloopStageMdnsProcess,             ///< Avahi poller watch callbacks, nested in the agent instance processing.
+    kMainloopStageTimers,                  ///< Timer service handlers.
+    kMainloopStageDBusUpdateFdSet,         ///< D-Bus agent UpdateFdSet().
+    kMainloopStageDBusProcess,             ///< D-Bus agent Process().
+    kMainloopStageUbusRequest,             ///< ubus request handlers, run on the OpenThread instance's thread.
+    kMainloopStageOtTasklets,              ///< OpenThread tasklets, run on the OpenThread instance's thread.
+    kMainloopStageOtProcess,               ///< otSysMainloopProcess(), which exchanges the spinel frames with the RCP.
+    kMainloopStageRcpPropertyGet,          ///< Round trip of a synchronous RCP property get, nested in the caller.
+    kMainloopStageAdvertisingProxyFlush,   ///< Advertising proxy flush of a batch of registrations.
+    kMainloopStageAdvertisingProxyLatency, ///< From an advertising proxy registration to its ack by the MDNS daemon.
+    kMainloopStageBackgroundSlice,         ///< Slice of background jobs, nested in the timer service handlers.
+    kMainloopStageNum,                     ///< Number of stages.
+};
+
+/**
+ * This function returns the duration histogram of a main loop stage.
+ *
+ * @param[in]   aStage  The main loop stage.
+ *
+ * @returns A reference to the histogram.
+ *
+ */
+Histogram &GetMainloopHistogram(MainloopStage aStage);
+
+/**
+ * This function returns the name of a main loop stage.
+ *
+ * @param[in]   aStage  The main loop stage.
+ *
+ * @returns The name of the stage.
+ *
+ */
+const char *GetMainloopStageName(MainloopStage aStage);
+
+/**
+ * This function returns a monotonic timestamp in microseconds for measuring main loop stages.
+ *
+ * @returns The current timestamp in microseconds.
+ *
+ */
+inline uint64_t GetMainloopClock(void)
+{
+    return GetNowPrecise();
+}
+
+/**
+ * This function records a main loop stage duration.
+ *
+ * @param[in]   aStage  The main loop stage.
+ * @param[in]   aStart  The timestamp when the stage started, from GetMainloopClock().
+ *
+ * @returns The duration of the stage in microseconds.
+ *
+ */
+inline uint64_t RecordMainloopStage(MainloopStage aStage, uint64_t aStart)
+{
+    uint64_t duration = GetMainloopClock() - aStart;
+
+    GetMainloopHistogram(aStage).Record(duration > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(duration));
+
+    return duration;
+}
+
+/**
+ * This function returns the number of main loop stalls, on any thread.
+ *
+ * This function may be called from any thread.
+ *
+ * @returns The number of stages which blocked their thread longer than OTBR_CONFIG_MAINLOOP_STALL_THRESHOLD.
+ *
+ */
+uint32_t GetMainloopStalls(void);
+
+/**
+ * This function returns the total time the main loop stalled, on any thread.
+ *
+ * Only the outermost stage of a stall accounts for its duration, so nested stages are not counted twice.
+ *
+ * This function may be called from any thread.
+ *
+ * @returns The total stall time in microseconds.
+ *
+ */
+uint64_t GetMainloopStallTime(void);
+
+/**
+ * This class records the duration of a main loop stage for the lifetime of the instance.
+ *
+ * A stage running longer than OTBR_CONFIG_MAINLOOP_STALL_THRESHOLD is logged as a stall, unless one of the stages
+ * nested in it already was, so the log names the innermost module blocking the loop.
+ *
+ */
+class MainloopStageTimer
+{
+public:
+    /**
+     * The constructor starts measuring a stage.
+     *
+     * @param[in]   aStage  The main loop stage.
+     *
+     */
+    explicit MainloopStageTimer(MainloopStage aStage);
+
+    ~MainloopStageTimer(void);
+
+private:
+    MainloopStageTimer(const MainloopStageTimer &) = delete;
+    MainloopStageTimer &operator=(const MainloopStageTimer &) = delete;
+
+    MainloopStage mStage;
+    uint64_t      mStart;
+    bool          mOutermost;   ///< Whether no other stage was in progress on this thread when this one started.
+    bool          mPrevStalled; ///< Whether a stage before this one, in the enclosing stage, stalled.
+};
+
+/**
+ * This function logs a startup milestone with the time elapsed since the first logged milestone.
+ *
+ * This function may be called from any thread.
+ *
+ * @param[in]   aMilestone  The name of the milestone.
+ *
+ */
+void LogStartupMilestone(const char *aMilestone);
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_MAINLOOP_STATS_HPP_
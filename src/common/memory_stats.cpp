@@ -0,0 +1,114 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the memory accounting of the agent subsystems.
+ */
+
+#include "common/memory_stats.hpp"
+
+#include <atomic>
+
+#include <assert.h>
+
+namespace otbr {
+
+namespace {
+
+/**
+ * This structure holds the counters of a subsystem, each on its own cache line so that subsystems running on
+ * different threads don't contend.
+ *
+ */
+struct alignas(64) AtomicMemoryCounters
+{
+    // size_t stays lock-free on the 32-bit targets, where 64-bit atomics may not be.
+    std::atomic<size_t> mBytes;
+    std::atomic<size_t> mPeakBytes;
+    std::atomic<size_t> mAllocations;
+    std::atomic<size_t> mTotalAllocations;
+};
+
+AtomicMemoryCounters sCounters[kMemoryTagNum];
+
+} // namespace
+
+void RecordAllocation(MemoryTag aTag, size_t aSize)
+{
+    AtomicMemoryCounters &counters = sCounters[aTag];
+    size_t                bytes    = counters.mBytes.fetch_add(aSize, std::memory_order_relaxed) + aSize;
+    size_t                peak     = counters.mPeakBytes.load(std::memory_order_relaxed);
+
+    assert(aTag < kMemoryTagNum);
+
+    counters.mAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.mTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    // The peak rarely changes once the subsystem has warmed up, so this loop usually doesn't run.
+    while (bytes > peak && !counters.mPeakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+    {
+    }
+}
+
+void RecordFree(MemoryTag aTag, size_t aSize)
+{
+    AtomicMemoryCounters &counters = sCounters[aTag];
+
+    assert(aTag < kMemoryTagNum);
+
+    counters.mBytes.fetch_sub(aSize, std::memory_order_relaxed);
+    counters.mAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryCounters GetMemoryCounters(MemoryTag aTag)
+{
+    const AtomicMemoryCounters &counters = sCounters[aTag];
+    MemoryCounters              snapshot;
+
+    assert(aTag < kMemoryTagNum);
+
+    snapshot.mBytes            = counters.mBytes.load(std::memory_order_relaxed);
+    snapshot.mPeakBytes        = counters.mPeakBytes.load(std::memory_order_relaxed);
+    snapshot.mAllocations      = counters.mAllocations.load(std::memory_order_relaxed);
+    snapshot.mTotalAllocations = counters.mTotalAllocations.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+const char *GetMemoryTagName(MemoryTag aTag)
+{
+    static const char *const kNames[] = {"Dtls", "DBus", "Mdns", "Timers"};
+
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == kMemoryTagNum, "Tag names mismatch");
+    assert(aTag < kMemoryTagNum);
+
+    return kNames[aTag];
+}
+
+} // namespace otbr
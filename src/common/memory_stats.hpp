@@ -0,0 +1,247 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the memory accounting of the agent subsystems.
+ */
+
+#ifndef OTBR_COMMON_MEMORY_STATS_HPP_
+#define OTBR_COMMON_MEMORY_STATS_HPP_
+
+#include "openthread-br/config.h"
+
+#include <new>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This enumeration defines the subsystems whose heap memory is accounted.
+ *
+ */
+enum MemoryTag
+{
+    kMemoryTagDtls,   ///< DTLS sessions and their datagram queues.
+    kMemoryTagDBus,   ///< D-Bus server buffers, i.e. the deferred property signals and the request buckets.
+    kMemoryTagMdns,   ///< Avahi poller watches and timeouts.
+    kMemoryTagTimers, ///< Pooled timer tasks.
+    kMemoryTagNum,    ///< Number of tags.
+};
+
+/**
+ * This structure represents the memory counters of a subsystem.
+ *
+ */
+struct MemoryCounters
+{
+    uint64_t mBytes;            ///< The number of bytes currently allocated.
+    uint64_t mPeakBytes;        ///< The largest number of bytes allocated at once.
+    uint64_t mAllocations;      ///< The number of allocations currently alive.
+    uint64_t mTotalAllocations; ///< The number of allocations ever made.
+};
+
+/**
+ * This function accounts an allocation of a subsystem.
+ *
+ * This function may be called from any thread, it only updates relaxed atomic counters.
+ *
+ * @param[in]   aTag    The subsystem.
+ * @param[in]   aSize   The number of bytes allocated.
+ *
+ */
+void RecordAllocation(MemoryTag aTag, size_t aSize);
+
+/**
+ * This function accounts a deallocation of a subsystem.
+ *
+ * This function may be called from any thread, it only updates relaxed atomic counters.
+ *
+ * @param[in]   aTag    The subsystem.
+ * @param[in]   aSize   The number of bytes deallocated, as accounted by RecordAllocation().
+ *
+ */
+void RecordFree(MemoryTag aTag, size_t aSize);
+
+/**
+ * This function returns the memory counters of a subsystem.
+ *
+ * @param[in]   aTag    The subsystem.
+ *
+ * @returns A snapshot of the counters.
+ *
+ */
+MemoryCounters GetMemoryCounters(MemoryTag aTag);
+
+/**
+ * This function returns the name of a subsystem.
+ *
+ * @param[in]   aTag    The subsystem.
+ *
+ * @returns The name of the subsystem.
+ *
+ */
+const char *GetMemoryTagName(MemoryTag aTag);
+
+/**
+ * This class template accounts the heap instances of the classes deriving from it to a subsystem.
+ *
+ * @tparam kTag     The subsystem.
+ *
+ */
+template <MemoryTag kTag> class MemoryTagged
+{
+public:
+    /**
+     * This operator allocates an instance and accounts it.
+     *
+     * @param[in]   aSize   The size of the instance.
+     *
+     * @returns A pointer to the allocated memory.
+     *
+     */
+    static void *operator new(size_t aSize)
+    {
+        void *memory = ::operator new(aSize);
+
+        RecordAllocation(kTag, aSize);
+
+        return memory;
+    }
+
+    /**
+     * This operator frees an instance and accounts it.
+     *
+     * @param[in]   aMemory A pointer to the instance.
+     * @param[in]   aSize   The size of the instance.
+     *
+     */
+    static void operator delete(void *aMemory, size_t aSize)
+    {
+        RecordFree(kTag, aSize);
+        ::operator delete(aMemory);
+    }
+
+    /**
+     * This operator places an instance in memory owned by the caller, which is not accounted.
+     *
+     * @param[in]   aSize   The size of the instance.
+     * @param[in]   aMemory A pointer to the memory.
+     *
+     * @returns @p aMemory.
+     *
+     */
+    static void *operator new(size_t aSize, void *aMemory) noexcept
+    {
+        (void)aSize;
+
+        return aMemory;
+    }
+};
+
+/**
+ * This class template implements a standard allocator accounting the memory of a container to a subsystem.
+ *
+ * @tparam T        The type of the elements.
+ * @tparam kTag     The subsystem.
+ *
+ */
+template <typename T, MemoryTag kTag> class TaggedAllocator
+{
+public:
+    typedef T value_type; ///< The type of the elements.
+
+    /**
+     * This structure rebinds the allocator to another element type, as the tag is no type parameter.
+     *
+     */
+    template <typename U> struct rebind
+    {
+        typedef TaggedAllocator<U, kTag> other; ///< The allocator of @p U.
+    };
+
+    /**
+     * The constructor of an allocator.
+     *
+     */
+    TaggedAllocator(void) = default;
+
+    /**
+     * The constructor of an allocator from an allocator of another element type.
+     *
+     */
+    template <typename U> TaggedAllocator(const TaggedAllocator<U, kTag> &) {}
+
+    /**
+     * This method allocates and accounts memory for @p aCount elements.
+     *
+     * @param[in]   aCount  The number of elements.
+     *
+     * @returns A pointer to the allocated memory.
+     *
+     */
+    T *allocate(size_t aCount)
+    {
+        T *memory = static_cast<T *>(::operator new(aCount * sizeof(T)));
+
+        RecordAllocation(kTag, aCount * sizeof(T));
+
+        return memory;
+    }
+
+    /**
+     * This method frees and accounts memory of @p aCount elements.
+     *
+     * @param[in]   aMemory A pointer to the memory, as returned by allocate().
+     * @param[in]   aCount  The number of elements, as passed to allocate().
+     *
+     */
+    void deallocate(T *aMemory, size_t aCount)
+    {
+        RecordFree(kTag, aCount * sizeof(T));
+        ::operator delete(aMemory);
+    }
+
+    /**
+     * All allocators of a subsystem are interchangeable.
+     *
+     */
+    template <typename U> bool operator==(const TaggedAllocator<U, kTag> &) const { return true; }
+
+    /**
+     * All allocators of a subsystem are interchangeable.
+     *
+     */
+    template <typename U> bool operator!=(const TaggedAllocator<U, kTag> &) const { return false; }
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_MEMORY_STATS_HPP_
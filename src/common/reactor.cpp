@@ -0,0 +1,346 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the epoll based main loop reactor.
+ */
+
+#include "common/reactor.hpp"
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace otbr {
+
+static uint32_t ToEpollEvents(uint32_t aEvents)
+{
+    uint32_t events = 0;
+
+    if (aEvents & Reactor::kEventReadable)
+    {
+        events |= EPOLLIN;
+    }
+
+    if (aEvents & Reactor::kEventWritable)
+    {
+        events |= EPOLLOUT;
+    }
+
+    if (aEvents & Reactor::kEventError)
+    {
+        events |= EPOLLPRI;
+    }
+
+    return events;
+}
+
+static uint32_t FromEpollEvents(uint32_t aEvents)
+{
+    uint32_t events = 0;
+
+    // select() reports a hang-up or a pending error as readable, keep that behavior.
+    if (aEvents & (EPOLLIN | EPOLLHUP | EPOLLERR))
+    {
+        events |= Reactor::kEventReadable;
+    }
+
+    if (aEvents & EPOLLOUT)
+    {
+        events |= Reactor::kEventWritable;
+    }
+
+    if (aEvents & (EPOLLPRI | EPOLLERR | EPOLLHUP))
+    {
+        events |= Reactor::kEventError;
+    }
+
+    return events;
+}
+
+Reactor::Reactor(void)
+    : mEpollFd(-1)
+    , mGeneration(0)
+{
+}
+
+Reactor::~Reactor(void)
+{
+    Deinit();
+}
+
+otbrError Reactor::Init(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mEpollFd < 0);
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(mEpollFd >= 0, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+void Reactor::Deinit(void)
+{
+    if (mEpollFd >= 0)
+    {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+
+    mEntries.clear();
+    mFdSetFds.clear();
+    mNextFdSetFds.clear();
+}
+
+otbrError Reactor::Add(int aFd, uint32_t aEvents, const Handler &aHandler)
+{
+    Entry &entry = mEntries[aFd];
+
+    entry.mEvents  = aEvents;
+    entry.mHandler = aHandler;
+
+    // The number may have been watched for a file closed since, so the registration is always added again.
+    entry.mRegistered = 0;
+
+    return Update(aFd, entry);
+}
+
+otbrError Reactor::Modify(int aFd, uint32_t aEvents)
+{
+    otbrError          error = OTBR_ERROR_NONE;
+    EntryMap::iterator it    = mEntries.find(aFd);
+
+    VerifyOrExit(it != mEntries.end() && it->second.mHandler, errno = ENOENT, error = OTBR_ERROR_ERRNO);
+    it->second.mEvents = aEvents;
+    error              = Update(aFd, it->second);
+
+exit:
+    return error;
+}
+
+void Reactor::Remove(int aFd)
+{
+    EntryMap::iterator it = mEntries.find(aFd);
+
+    VerifyOrExit(it != mEntries.end());
+    it->second.mEvents  = 0;
+    it->second.mHandler = nullptr;
+    Update(aFd, it->second);
+
+exit:
+    return;
+}
+
+otbrError Reactor::Update(int aFd, Entry &aEntry)
+{
+    otbrError          error  = OTBR_ERROR_NONE;
+    uint32_t           events = ToEpollEvents(aEntry.mEvents | aEntry.mFdSetEvents);
+    struct epoll_event event;
+
+    VerifyOrExit(events != aEntry.mRegistered);
+
+    memset(&event, 0, sizeof(event));
+    event.events  = events;
+    event.data.fd = aFd;
+
+    if (events == 0)
+    {
+        // The file descriptor may have been closed already, which removes it from the epoll set implicitly.
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, aFd, &event);
+    }
+    else if (aEntry.mRegistered == 0)
+    {
+        struct stat status;
+
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, aFd, &event) != 0)
+        {
+            VerifyOrExit(errno == EEXIST, error = OTBR_ERROR_ERRNO);
+            VerifyOrExit(epoll_ctl(mEpollFd, EPOLL_CTL_MOD, aFd, &event) == 0, error = OTBR_ERROR_ERRNO);
+        }
+
+        VerifyOrExit(fstat(aFd, &status) == 0, error = OTBR_ERROR_ERRNO);
+        aEntry.mDevice = status.st_dev;
+        aEntry.mInode  = status.st_ino;
+    }
+    else if (epoll_ctl(mEpollFd, EPOLL_CTL_MOD, aFd, &event) != 0)
+    {
+        // The file descriptor was closed and its number reused without being removed first.
+        VerifyOrExit(errno == ENOENT, error = OTBR_ERROR_ERRNO);
+        VerifyOrExit(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, aFd, &event) == 0, error = OTBR_ERROR_ERRNO);
+    }
+
+    aEntry.mRegistered = events;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to watch fd %d: %s", aFd, strerror(errno));
+    }
+    else if (events == 0 && !aEntry.mHandler)
+    {
+        mEntries.erase(aFd);
+    }
+
+    return error;
+}
+
+bool Reactor::IsSameFile(int aFd, const Entry &aEntry)
+{
+    struct stat status;
+
+    return fstat(aFd, &status) == 0 && status.st_dev == aEntry.mDevice && status.st_ino == aEntry.mInode;
+}
+
+void Reactor::UpdateFdSets(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet, int aMaxFd)
+{
+    ++mGeneration;
+    mNextFdSetFds.clear();
+
+    for (int fd = 0; fd <= aMaxFd && fd < FD_SETSIZE; ++fd)
+    {
+        uint32_t events = 0;
+
+        if (FD_ISSET(fd, &aReadFdSet))
+        {
+            events |= kEventReadable;
+        }
+
+        if (FD_ISSET(fd, &aWriteFdSet))
+        {
+            events |= kEventWritable;
+        }
+
+        if (FD_ISSET(fd, &aErrorFdSet))
+        {
+            events |= kEventError;
+        }
+
+        if (events != 0)
+        {
+            Entry &entry = mEntries[fd];
+
+            // A closed file leaves the epoll set, so a number reused with the same interest is registered again.
+            if (entry.mRegistered != 0 && !IsSameFile(fd, entry))
+            {
+                entry.mRegistered = 0;
+            }
+
+            entry.mFdSetEvents = events;
+            entry.mGeneration  = mGeneration;
+            mNextFdSetFds.push_back(fd);
+            Update(fd, entry);
+        }
+    }
+
+    for (int fd : mFdSetFds)
+    {
+        EntryMap::iterator it = mEntries.find(fd);
+
+        if (it != mEntries.end() && it->second.mGeneration != mGeneration)
+        {
+            it->second.mFdSetEvents = 0;
+            Update(fd, it->second);
+        }
+    }
+
+    mFdSetFds.swap(mNextFdSetFds);
+}
+
+int Reactor::Poll(fd_set &              aReadFdSet,
+                  fd_set &              aWriteFdSet,
+                  fd_set &              aErrorFdSet,
+                  int                   aMaxFd,
+                  const struct timeval &aTimeout)
+{
+    struct epoll_event events[kMaxEvents];
+    int                timeout = -1;
+    int                rval;
+
+    if (aTimeout.tv_sec < INT_MAX / 1000)
+    {
+        timeout = static_cast<int>(aTimeout.tv_sec * 1000 + (aTimeout.tv_usec + 999) / 1000);
+    }
+
+    UpdateFdSets(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd);
+
+    FD_ZERO(&aReadFdSet);
+    FD_ZERO(&aWriteFdSet);
+    FD_ZERO(&aErrorFdSet);
+
+    rval = epoll_wait(mEpollFd, events, kMaxEvents, timeout);
+    VerifyOrExit(rval > 0);
+
+    for (int i = 0; i < rval; ++i)
+    {
+        int                fd    = events[i].data.fd;
+        uint32_t           ready = FromEpollEvents(events[i].events);
+        EntryMap::iterator it    = mEntries.find(fd);
+
+        if (it == mEntries.end())
+        {
+            continue;
+        }
+
+        if (ready & it->second.mFdSetEvents & kEventReadable)
+        {
+            FD_SET(fd, &aReadFdSet);
+        }
+
+        if (ready & it->second.mFdSetEvents & kEventWritable)
+        {
+            FD_SET(fd, &aWriteFdSet);
+        }
+
+        if (ready & it->second.mFdSetEvents & kEventError)
+        {
+            FD_SET(fd, &aErrorFdSet);
+        }
+
+        if (it->second.mHandler && (ready & (it->second.mEvents | kEventError)))
+        {
+            // Copy the handler since it may remove itself.
+            Handler handler = it->second.mHandler;
+
+            handler(ready & (it->second.mEvents | kEventError));
+        }
+    }
+
+exit:
+    return rval;
+}
+
+} // namespace otbr
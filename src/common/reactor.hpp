@@ -0,0 +1,204 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the epoll based main loop reactor.
+ */
+
+#ifndef OTBR_COMMON_REACTOR_HPP_
+#define OTBR_COMMON_REACTOR_HPP_
+
+#include "openthread-br/config.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <stdint.h>
+#include <sys/select.h>
+#include <sys/types.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class implements a level-triggered epoll reactor.
+ *
+ * File descriptors are registered with the kernel once and stay registered until they are removed, so each wakeup
+ * only costs as much as the number of ready file descriptors.
+ *
+ * Modules still built around select() can keep filling `fd_set`s: Poll() diffs them against the previous iteration,
+ * only issues epoll_ctl() for file descriptors whose interest or open file changed, and writes the ready set back into
+ * the `fd_set`s for their Process() methods. Those modules may close a file descriptor at any time, so each Poll()
+ * still costs one fstat() per file descriptor in the `fd_set`s, to find the numbers reused by another file.
+ *
+ * All the modules of the agent are still built around select(), so the reactor costs more than select() until they
+ * register their file descriptors with Add(), and it is only used when built with OTBR_EPOLL.
+ *
+ */
+class Reactor
+{
+public:
+    /**
+     * I/O events a handler can be interested in.
+     *
+     */
+    enum
+    {
+        kEventReadable = 1 << 0, ///< The file descriptor is readable.
+        kEventWritable = 1 << 1, ///< The file descriptor is writable.
+        kEventError    = 1 << 2, ///< An error or hang-up is pending on the file descriptor.
+    };
+
+    /**
+     * This function is called when a registered file descriptor becomes ready.
+     *
+     * @param[in]   aEvents     A bit-mask of the ready events.
+     *
+     */
+    typedef std::function<void(uint32_t aEvents)> Handler;
+
+    /**
+     * The constructor of a reactor.
+     *
+     */
+    Reactor(void);
+
+    /**
+     * The destructor of a reactor.
+     *
+     */
+    ~Reactor(void);
+
+    /**
+     * This method creates the epoll instance.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully initialized.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create the epoll instance, errno is set.
+     *
+     */
+    otbrError Init(void);
+
+    /**
+     * This method releases the epoll instance and all registrations.
+     *
+     */
+    void Deinit(void);
+
+    /**
+     * This method registers a handler for a file descriptor.
+     *
+     * @param[in]   aFd         The file descriptor.
+     * @param[in]   aEvents     A bit-mask of the events to watch.
+     * @param[in]   aHandler    The handler to be called when @p aFd is ready.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully registered.
+     * @retval  OTBR_ERROR_ERRNO    Failed to register, errno is set.
+     *
+     */
+    otbrError Add(int aFd, uint32_t aEvents, const Handler &aHandler);
+
+    /**
+     * This method changes the events watched by a registered handler.
+     *
+     * @param[in]   aFd         The file descriptor.
+     * @param[in]   aEvents     A bit-mask of the events to watch.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully modified.
+     * @retval  OTBR_ERROR_ERRNO    Failed to modify, errno is set.
+     *
+     */
+    otbrError Modify(int aFd, uint32_t aEvents);
+
+    /**
+     * This method unregisters the handler of a file descriptor.
+     *
+     * It must be called before the file descriptor is closed.
+     *
+     * @param[in]   aFd         The file descriptor.
+     *
+     */
+    void Remove(int aFd);
+
+    /**
+     * This method waits for I/O events and dispatches them.
+     *
+     * The file descriptors in the `fd_set`s are watched in addition to the registered handlers. On return, the
+     * `fd_set`s only contain the file descriptors which are ready, in the same way as select().
+     *
+     * @param[inout]    aReadFdSet      The read file descriptors.
+     * @param[inout]    aWriteFdSet     The write file descriptors.
+     * @param[inout]    aErrorFdSet     The error file descriptors.
+     * @param[in]       aMaxFd          The max file descriptor in the `fd_set`s.
+     * @param[in]       aTimeout        The maximum time to wait, waits forever if it does not fit in an `int` of
+     *                                  milliseconds.
+     *
+     * @returns The number of ready file descriptors, or -1 on failure with errno set.
+     *
+     */
+    int Poll(fd_set &              aReadFdSet,
+             fd_set &              aWriteFdSet,
+             fd_set &              aErrorFdSet,
+             int                   aMaxFd,
+             const struct timeval &aTimeout);
+
+private:
+    enum
+    {
+        kMaxEvents = 64,
+    };
+
+    struct Entry
+    {
+        uint32_t mEvents;       ///< Events watched by the handler.
+        uint32_t mFdSetEvents;  ///< Events watched through the `fd_set`s.
+        uint32_t mRegistered;   ///< Events currently registered with epoll, 0 if not registered.
+        uint32_t mGeneration;   ///< The Poll() generation in which the `fd_set`s last referred to this entry.
+        dev_t    mDevice;       ///< The device of the file registered with epoll.
+        ino_t    mInode;        ///< The inode of the file registered with epoll.
+        Handler  mHandler;
+    };
+
+    typedef std::unordered_map<int, Entry> EntryMap;
+
+    otbrError   Update(int aFd, Entry &aEntry);
+    void        UpdateFdSets(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet, int aMaxFd);
+    static bool IsSameFile(int aFd, const Entry &aEntry);
+
+    int              mEpollFd;
+    uint32_t         mGeneration;
+    EntryMap         mEntries;
+    std::vector<int> mFdSetFds;
+    std::vector<int> mNextFdSetFds; ///< The storage of the next `mFdSetFds`, kept to not allocate in each Poll().
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_REACTOR_HPP_
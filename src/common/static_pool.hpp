@@ -0,0 +1,337 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the fixed-capacity containers of the static-pool build profile.
+ */
+
+#ifndef OTBR_COMMON_STATIC_POOL_HPP_
+#define OTBR_COMMON_STATIC_POOL_HPP_
+
+#include "openthread-br/config.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <assert.h>
+#include <stddef.h>
+
+namespace otbr {
+
+/**
+ * This class template implements a vector whose elements are stored inline, without any heap allocation.
+ *
+ * It offers the subset of `std::vector` the agent uses, so a container type can be switched between the two by the
+ * build profile. Callers must check `size() < capacity()` before adding an element.
+ *
+ * @tparam T            The type of the elements.
+ * @tparam kCapacity    The max number of elements.
+ *
+ */
+template <typename T, size_t kCapacity> class StaticVector
+{
+public:
+    typedef T        value_type;     ///< The type of the elements.
+    typedef T *      iterator;       ///< The iterator type.
+    typedef const T *const_iterator; ///< The constant iterator type.
+
+    /**
+     * The constructor of an empty vector.
+     *
+     */
+    StaticVector(void)
+        : mSize(0)
+    {
+    }
+
+    /**
+     * The destructor destroys all elements.
+     *
+     */
+    ~StaticVector(void) { clear(); }
+
+    StaticVector(const StaticVector &) = delete;
+    StaticVector &operator=(const StaticVector &) = delete;
+
+    iterator       begin(void) { return Data(); }
+    iterator       end(void) { return Data() + mSize; }
+    const_iterator begin(void) const { return Data(); }
+    const_iterator end(void) const { return Data() + mSize; }
+
+    size_t size(void) const { return mSize; }
+    bool   empty(void) const { return mSize == 0; }
+
+    /**
+     * This method returns the max number of elements, which is fixed at compile time.
+     *
+     */
+    static constexpr size_t capacity(void) { return kCapacity; }
+
+    /**
+     * This method accepts a reservation for compatibility with `std::vector`, which may not exceed the capacity.
+     *
+     */
+    void reserve(size_t aCount) const
+    {
+        (void)aCount;
+        assert(aCount <= kCapacity);
+    }
+
+    T &      operator[](size_t aIndex) { return Data()[aIndex]; }
+    const T &operator[](size_t aIndex) const { return Data()[aIndex]; }
+    T &      back(void) { return Data()[mSize - 1]; }
+    const T &back(void) const { return Data()[mSize - 1]; }
+
+    /**
+     * This method constructs an element at the end.
+     *
+     * @param[in]   aArgs   The arguments passed to the constructor of the element.
+     *
+     */
+    template <typename... Args> void emplace_back(Args &&... aArgs)
+    {
+        assert(mSize < kCapacity);
+        ::new (&mStorage[mSize]) T(std::forward<Args>(aArgs)...);
+        ++mSize;
+    }
+
+    void push_back(const T &aValue) { emplace_back(aValue); }
+
+    void pop_back(void)
+    {
+        assert(mSize > 0);
+        back().~T();
+        --mSize;
+    }
+
+    /**
+     * This method removes an element, moving the following elements down.
+     *
+     * @param[in]   aPosition   The element to remove.
+     *
+     * @returns The iterator to the element following the removed one.
+     *
+     */
+    iterator erase(iterator aPosition)
+    {
+        std::move(aPosition + 1, end(), aPosition);
+        pop_back();
+
+        return aPosition;
+    }
+
+    /**
+     * This method changes the number of elements, default constructing the added ones.
+     *
+     * @param[in]   aCount  The number of elements, which may not exceed the capacity.
+     *
+     */
+    void resize(size_t aCount)
+    {
+        assert(aCount <= kCapacity);
+
+        while (mSize > aCount)
+        {
+            pop_back();
+        }
+
+        while (mSize < aCount)
+        {
+            emplace_back();
+        }
+    }
+
+    void clear(void)
+    {
+        while (mSize > 0)
+        {
+            pop_back();
+        }
+    }
+
+private:
+    T *      Data(void) { return reinterpret_cast<T *>(mStorage); }
+    const T *Data(void) const { return reinterpret_cast<const T *>(mStorage); }
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage[kCapacity];
+    size_t                                                     mSize;
+};
+
+/**
+ * This class template implements a standard allocator serving the nodes of a container from a static pool.
+ *
+ * Single elements, i.e. the nodes of a list or a map, come from a pool of @p kCapacity blocks shared by all containers
+ * of the same type. Arrays, i.e. the buckets of a hash map, are still allocated on the heap, which happens once when
+ * the container is reserved to its capacity up front.
+ *
+ * @tparam T            The type of the elements.
+ * @tparam kCapacity    The max number of elements of all containers of the same type.
+ *
+ */
+template <typename T, size_t kCapacity> class StaticPoolAllocator
+{
+public:
+    typedef T value_type; ///< The type of the elements.
+
+    /**
+     * This structure rebinds the allocator to another element type, as the capacity is no type parameter.
+     *
+     */
+    template <typename U> struct rebind
+    {
+        typedef StaticPoolAllocator<U, kCapacity> other; ///< The allocator of @p U.
+    };
+
+    /**
+     * The constructor of an allocator.
+     *
+     */
+    StaticPoolAllocator(void) = default;
+
+    /**
+     * The constructor of an allocator from an allocator of another element type.
+     *
+     */
+    template <typename U> StaticPoolAllocator(const StaticPoolAllocator<U, kCapacity> &) {}
+
+    /**
+     * This method allocates memory for @p aCount elements.
+     *
+     * @param[in]   aCount  The number of elements.
+     *
+     * @returns A pointer to the allocated memory.
+     *
+     * @throws std::bad_alloc if the pool is exhausted.
+     *
+     */
+    T *allocate(size_t aCount)
+    {
+        void *memory;
+
+        if (aCount != 1)
+        {
+            memory = ::operator new(aCount * sizeof(T));
+        }
+        else if ((memory = GetPool().Allocate()) == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T *>(memory);
+    }
+
+    /**
+     * This method frees memory of @p aCount elements.
+     *
+     * @param[in]   aMemory A pointer to the memory, as returned by allocate().
+     * @param[in]   aCount  The number of elements, as passed to allocate().
+     *
+     */
+    void deallocate(T *aMemory, size_t aCount)
+    {
+        if (aCount != 1)
+        {
+            ::operator delete(aMemory);
+        }
+        else
+        {
+            GetPool().Free(aMemory);
+        }
+    }
+
+    /**
+     * All allocators of a capacity share the same pool of each element type.
+     *
+     */
+    template <typename U> bool operator==(const StaticPoolAllocator<U, kCapacity> &) const { return true; }
+
+    /**
+     * All allocators of a capacity share the same pool of each element type.
+     *
+     */
+    template <typename U> bool operator!=(const StaticPoolAllocator<U, kCapacity> &) const { return false; }
+
+private:
+    class Pool
+    {
+    public:
+        Pool(void)
+            : mFreeList(nullptr)
+        {
+            for (Block &block : mBlocks)
+            {
+                block.mNext = mFreeList;
+                mFreeList   = &block;
+            }
+        }
+
+        void *Allocate(void)
+        {
+            Block *block = mFreeList;
+
+            if (block != nullptr)
+            {
+                mFreeList = block->mNext;
+            }
+
+            return block;
+        }
+
+        void Free(void *aMemory)
+        {
+            Block *block = static_cast<Block *>(aMemory);
+
+            block->mNext = mFreeList;
+            mFreeList    = block;
+        }
+
+    private:
+        union Block
+        {
+            Block *                                                    mNext;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+        };
+
+        Block  mBlocks[kCapacity];
+        Block *mFreeList;
+    };
+
+    static Pool &GetPool(void)
+    {
+        static Pool sPool;
+
+        return sPool;
+    }
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_STATIC_POOL_HPP_
@@ -0,0 +1,237 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the shared memory status page.
+ */
+
+#include "common/status_page.hpp"
+
+#include <atomic>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+/**
+ * This structure represents the layout of the shared memory object.
+ *
+ */
+struct StatusPageRegion
+{
+    enum : uint32_t
+    {
+        kMagic   = 0x4f544253, ///< "OTBS"
+        kVersion = 1,
+    };
+
+    uint32_t              mMagic;    ///< kMagic, written after the rest of the header.
+    uint16_t              mVersion;  ///< The layout version.
+    uint16_t              mSize;     ///< The size of mStatus, readers reject a page of another size.
+    std::atomic<uint32_t> mSequence; ///< Odd while an update is in progress.
+    uint32_t              mReserved;
+    StatusPage            mStatus;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "The sequence must be lock-free to be shared between processes");
+
+StatusPageWriter::StatusPageWriter(void)
+    : mRegion(nullptr)
+{
+}
+
+StatusPageWriter::~StatusPageWriter(void)
+{
+    Close();
+}
+
+otbrError StatusPageWriter::Open(const char *aName)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    int       fd    = -1;
+    void *    region;
+
+    VerifyOrExit(mRegion == nullptr, errno = EALREADY, error = OTBR_ERROR_ERRNO);
+
+    fd = shm_open(aName, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    VerifyOrExit(fd != -1, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(ftruncate(fd, sizeof(StatusPageRegion)) == 0, error = OTBR_ERROR_ERRNO);
+
+    region = mmap(nullptr, sizeof(StatusPageRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(region != MAP_FAILED, error = OTBR_ERROR_ERRNO);
+
+    // Readers check the magic last, a page left by a previous writer is reset before it is valid again.
+    mRegion         = static_cast<StatusPageRegion *>(region);
+    mRegion->mMagic = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    mRegion->mVersion  = StatusPageRegion::kVersion;
+    mRegion->mSize     = sizeof(StatusPage);
+    mRegion->mReserved = 0;
+    mRegion->mSequence.store(0, std::memory_order_relaxed);
+    memset(&mRegion->mStatus, 0, sizeof(mRegion->mStatus));
+    std::atomic_thread_fence(std::memory_order_release);
+    mRegion->mMagic = StatusPageRegion::kMagic;
+
+    mName = aName;
+
+exit:
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    return error;
+}
+
+void StatusPageWriter::Close(void)
+{
+    VerifyOrExit(mRegion != nullptr);
+
+    munmap(mRegion, sizeof(StatusPageRegion));
+    shm_unlink(mName.c_str());
+    mRegion = nullptr;
+    mName.clear();
+
+exit:
+    return;
+}
+
+void StatusPageWriter::Update(const StatusPage &aStatus)
+{
+    uint32_t sequence;
+
+    VerifyOrExit(mRegion != nullptr);
+
+    sequence = mRegion->mSequence.load(std::memory_order_relaxed);
+    mRegion->mSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&mRegion->mStatus, &aStatus, sizeof(aStatus));
+    mRegion->mSequence.store(sequence + 2, std::memory_order_release);
+
+exit:
+    return;
+}
+
+StatusPageReader::StatusPageReader(void)
+    : mRegion(nullptr)
+{
+}
+
+StatusPageReader::~StatusPageReader(void)
+{
+    Close();
+}
+
+otbrError StatusPageReader::Open(const char *aName)
+{
+    otbrError   error = OTBR_ERROR_NONE;
+    int         fd    = -1;
+    struct stat objectStat;
+    void *      region;
+
+    VerifyOrExit(mRegion == nullptr, errno = EALREADY, error = OTBR_ERROR_ERRNO);
+
+    fd = shm_open(aName, O_RDONLY | O_CLOEXEC, 0);
+    VerifyOrExit(fd != -1, error = OTBR_ERROR_ERRNO);
+
+    // Accessing a mapping beyond the end of the object faults, e.g. when the writer hasn't sized it yet.
+    VerifyOrExit(fstat(fd, &objectStat) == 0, error = OTBR_ERROR_ERRNO);
+    VerifyOrExit(static_cast<size_t>(objectStat.st_size) >= sizeof(StatusPageRegion), errno = EPROTO,
+                 error = OTBR_ERROR_ERRNO);
+
+    region = mmap(nullptr, sizeof(StatusPageRegion), PROT_READ, MAP_SHARED, fd, 0);
+    VerifyOrExit(region != MAP_FAILED, error = OTBR_ERROR_ERRNO);
+    mRegion = static_cast<const StatusPageRegion *>(region);
+
+    VerifyOrExit(mRegion->mMagic == StatusPageRegion::kMagic, errno = EPROTO, error = OTBR_ERROR_ERRNO);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    VerifyOrExit(mRegion->mVersion == StatusPageRegion::kVersion && mRegion->mSize == sizeof(StatusPage),
+                 errno = EPROTO, error = OTBR_ERROR_ERRNO);
+
+exit:
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        Close();
+    }
+
+    return error;
+}
+
+void StatusPageReader::Close(void)
+{
+    VerifyOrExit(mRegion != nullptr);
+
+    munmap(const_cast<StatusPageRegion *>(mRegion), sizeof(StatusPageRegion));
+    mRegion = nullptr;
+
+exit:
+    return;
+}
+
+otbrError StatusPageReader::Read(StatusPage &aStatus) const
+{
+    otbrError error = OTBR_ERROR_NONE;
+    uint32_t  before;
+    uint32_t  after;
+
+    VerifyOrExit(mRegion != nullptr, errno = EAGAIN, error = OTBR_ERROR_ERRNO);
+
+    do
+    {
+        before = mRegion->mSequence.load(std::memory_order_acquire);
+
+        if (before & 1)
+        {
+            continue;
+        }
+
+        memcpy(&aStatus, &mRegion->mStatus, sizeof(aStatus));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = mRegion->mSequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    VerifyOrExit(before != 0, errno = EAGAIN, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+} // namespace otbr
@@ -0,0 +1,195 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the shared memory status page.
+ */
+
+#ifndef OTBR_COMMON_STATUS_PAGE_HPP_
+#define OTBR_COMMON_STATUS_PAGE_HPP_
+
+#include "openthread-br/config.h"
+
+#include <string>
+
+#include <stdint.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This structure represents the Thread status published on the status page.
+ *
+ */
+struct StatusPage
+{
+    uint64_t mUpdateTime;    ///< The monotonic time in milliseconds of the last update.
+    uint32_t mPartitionId;   ///< The partition id.
+    uint16_t mRloc16;        ///< The RLOC16.
+    uint16_t mPanId;         ///< The PAN id.
+    uint8_t  mExtPanId[8];   ///< The extended PAN id.
+    uint8_t  mRole;          ///< The device role, an otDeviceRole value.
+    uint8_t  mChannel;       ///< The channel.
+    uint16_t mReserved;      ///< Reserved, always 0.
+    uint32_t mMacTxTotal;    ///< The number of MAC frames transmitted.
+    uint32_t mMacRxTotal;    ///< The number of MAC frames received.
+    uint32_t mMacTxErrCca;   ///< The number of MAC transmissions failed by CCA.
+    uint32_t mMacTxRetry;    ///< The number of MAC retransmissions.
+    uint32_t mMacRxErrFcs;   ///< The number of MAC frames received with a wrong FCS.
+    uint32_t mIp6TxSuccess;  ///< The number of IPv6 packets sent.
+    uint32_t mIp6RxSuccess;  ///< The number of IPv6 packets received.
+    uint32_t mIp6TxFailure;  ///< The number of IPv6 packets failed to send.
+    uint32_t mIp6RxFailure;  ///< The number of IPv6 packets failed to receive.
+};
+
+struct StatusPageRegion;
+
+/**
+ * This class implements the writer of a status page in POSIX shared memory.
+ *
+ * The page is protected by a sequence lock, readers never block the writer and retry while an update is in progress.
+ * There must be a single writer for a page.
+ *
+ */
+class StatusPageWriter
+{
+public:
+    /**
+     * The constructor initializes a closed writer.
+     *
+     */
+    StatusPageWriter(void);
+
+    /**
+     * The destructor closes and removes the page.
+     *
+     */
+    ~StatusPageWriter(void);
+
+    /**
+     * This method creates the page, or takes over an existing one.
+     *
+     * @param[in]   aName   The shared memory object name, starting with '/'.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the page.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create or map the shared memory object.
+     *
+     */
+    otbrError Open(const char *aName);
+
+    /**
+     * This method unmaps and removes the page.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method indicates whether the page is open.
+     *
+     * @retval true     The page is open.
+     * @retval false    The page is closed.
+     *
+     */
+    bool IsOpen(void) const { return mRegion != nullptr; }
+
+    /**
+     * This method publishes a new status, doing nothing if the page is not open.
+     *
+     * @param[in]   aStatus     The status.
+     *
+     */
+    void Update(const StatusPage &aStatus);
+
+private:
+    StatusPageWriter(const StatusPageWriter &) = delete;
+    StatusPageWriter &operator=(const StatusPageWriter &) = delete;
+
+    StatusPageRegion *mRegion;
+    std::string       mName;
+};
+
+/**
+ * This class implements the reader of a status page in POSIX shared memory.
+ *
+ */
+class StatusPageReader
+{
+public:
+    /**
+     * The constructor initializes a closed reader.
+     *
+     */
+    StatusPageReader(void);
+
+    /**
+     * The destructor closes the page.
+     *
+     */
+    ~StatusPageReader(void);
+
+    /**
+     * This method maps a page created by a writer.
+     *
+     * @param[in]   aName   The shared memory object name, starting with '/'.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the page.
+     * @retval  OTBR_ERROR_ERRNO    Failed to open or map the shared memory object, or it is not a status page of
+     *                              this version, errno is EPROTO.
+     *
+     */
+    otbrError Open(const char *aName);
+
+    /**
+     * This method unmaps the page.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method reads a consistent copy of the status.
+     *
+     * @param[out]  aStatus     The status.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully read the status.
+     * @retval  OTBR_ERROR_ERRNO    The page is not open or hasn't been written yet, errno is EAGAIN.
+     *
+     */
+    otbrError Read(StatusPage &aStatus) const;
+
+private:
+    StatusPageReader(const StatusPageReader &) = delete;
+    StatusPageReader &operator=(const StatusPageReader &) = delete;
+
+    const StatusPageRegion *mRegion;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_STATUS_PAGE_HPP_
@@ -0,0 +1,118 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements tracking the versions of table entries.
+ */
+
+#include "common/table_version.hpp"
+
+#include <algorithm>
+
+namespace otbr {
+
+TableVersion::TableVersion(uint32_t aInitialVersion, size_t aMaxRemoved)
+    : mMaxRemoved(aMaxRemoved)
+    , mVersion(aInitialVersion == 0 ? 1 : aInitialVersion)
+    , mOldestVersion(mVersion)
+    , mSinceVersion(mVersion)
+    , mScan(0)
+    , mFullScan(false)
+    , mChanged(false)
+{
+}
+
+bool TableVersion::BeginScan(uint32_t aSinceVersion)
+{
+    // Versions are never 0, and versions of a previous run are most likely outside the known range.
+    mFullScan = aSinceVersion == 0 || IsNewer(mOldestVersion, aSinceVersion) || IsNewer(aSinceVersion, mVersion);
+
+    mSinceVersion = aSinceVersion;
+    mChanged      = false;
+    mScan++;
+
+    return mFullScan;
+}
+
+bool TableVersion::Update(uint64_t aKey, uint64_t aState)
+{
+    auto entry = mEntries.find(aKey);
+
+    if (entry == mEntries.end())
+    {
+        entry = mEntries.insert(std::make_pair(aKey, Entry{aState, NextVersion(), mScan})).first;
+        mRemovals.erase(std::remove_if(mRemovals.begin(), mRemovals.end(),
+                                       [aKey](const Removal &aRemoval) { return aRemoval.mKey == aKey; }),
+                        mRemovals.end());
+        mChanged = true;
+    }
+    else if (entry->second.mState != aState)
+    {
+        entry->second.mState   = aState;
+        entry->second.mVersion = NextVersion();
+        mChanged               = true;
+    }
+
+    entry->second.mScan = mScan;
+
+    return mFullScan || IsNewer(entry->second.mVersion, mSinceVersion);
+}
+
+void TableVersion::EndScan(void)
+{
+    for (auto entry = mEntries.begin(); entry != mEntries.end();)
+    {
+        if (entry->second.mScan != mScan)
+        {
+            mRemovals.push_back(Removal{entry->first, NextVersion()});
+            entry    = mEntries.erase(entry);
+            mChanged = true;
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+
+    if (mRemovals.size() > mMaxRemoved)
+    {
+        size_t forgotten = mRemovals.size() - mMaxRemoved;
+
+        // Readers older than the last forgotten removal would miss it.
+        mOldestVersion = mRemovals[forgotten - 1].mVersion;
+        mRemovals.erase(mRemovals.begin(), mRemovals.begin() + static_cast<ptrdiff_t>(forgotten));
+    }
+
+    if (mChanged)
+    {
+        mVersion = NextVersion();
+    }
+}
+
+} // namespace otbr
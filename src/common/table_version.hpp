@@ -0,0 +1,159 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for tracking the versions of table entries.
+ */
+
+#ifndef OTBR_COMMON_TABLE_VERSION_HPP_
+#define OTBR_COMMON_TABLE_VERSION_HPP_
+
+#include "openthread-br/config.h"
+
+#include <map>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class tracks the version in which each entry of a table was last added, changed or removed.
+ *
+ * The table is scanned in full, entry by entry, and each scan reports the changes since a version given by the
+ * reader. Entries are identified by a 64-bit key, and their relevant attributes are summarized into a 64-bit state.
+ * The table version increases with each scan which found a change.
+ *
+ */
+class TableVersion
+{
+public:
+    /**
+     * The constructor of a table version tracker.
+     *
+     * @param[in]   aInitialVersion     The version of the empty table, which should differ between runs so that
+     *                                  versions seen by readers of a previous run are not mistaken as known.
+     * @param[in]   aMaxRemoved         The number of removed entries remembered, removals beyond it make readers of
+     *                                  older versions rescan the whole table.
+     *
+     */
+    TableVersion(uint32_t aInitialVersion, size_t aMaxRemoved);
+
+    /**
+     * This method starts a scan of the table.
+     *
+     * @param[in]   aSinceVersion   The version the reader saw last, 0 if none.
+     *
+     * @retval  true    The scan reports the whole table, because the changes since @p aSinceVersion are not known.
+     * @retval  false   The scan reports the changes since @p aSinceVersion.
+     *
+     */
+    bool BeginScan(uint32_t aSinceVersion);
+
+    /**
+     * This method updates an entry found by the current scan.
+     *
+     * @param[in]   aKey    The key of the entry.
+     * @param[in]   aState  The state of the entry.
+     *
+     * @retval  true    The entry was added or changed since the version of the scan, and should be reported.
+     * @retval  false   The entry is unchanged since the version of the scan.
+     *
+     */
+    bool Update(uint64_t aKey, uint64_t aState);
+
+    /**
+     * This method ends the current scan, removing the entries it did not find.
+     *
+     */
+    void EndScan(void);
+
+    /**
+     * This method calls a handler with the key of each entry removed since the version of the last scan.
+     *
+     * Nothing is removed from the point of view of a scan reporting the whole table.
+     *
+     * @param[in]   aHandler    The handler, called as `aHandler(uint64_t aKey)`.
+     *
+     */
+    template <typename HandlerType> void ForEachRemoved(HandlerType aHandler) const
+    {
+        for (const Removal &removal : mRemovals)
+        {
+            if (!mFullScan && IsNewer(removal.mVersion, mSinceVersion))
+            {
+                aHandler(removal.mKey);
+            }
+        }
+    }
+
+    /**
+     * This method returns the current version of the table.
+     *
+     * @returns The table version.
+     *
+     */
+    uint32_t GetVersion(void) const { return mVersion; }
+
+private:
+    struct Entry
+    {
+        uint64_t mState;
+        uint32_t mVersion;
+        uint32_t mScan;
+    };
+
+    struct Removal
+    {
+        uint64_t mKey;
+        uint32_t mVersion;
+    };
+
+    uint32_t NextVersion(void) const { return (mVersion + 1 == 0) ? 1 : mVersion + 1; }
+
+    static bool IsNewer(uint32_t aVersion, uint32_t aReference)
+    {
+        return static_cast<int32_t>(aVersion - aReference) > 0;
+    }
+
+    std::map<uint64_t, Entry> mEntries;
+    std::vector<Removal>      mRemovals;
+    size_t                    mMaxRemoved;
+    uint32_t                  mVersion;
+    uint32_t                  mOldestVersion; ///< The oldest version from which changes are known.
+    uint32_t                  mSinceVersion;
+    uint32_t                  mScan;
+    bool                      mFullScan;
+    bool                      mChanged;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_TABLE_VERSION_HPP_
@@ -0,0 +1,197 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a lock-free multi-producer single-consumer task queue.
+ */
+
+#include "common/task_queue.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/eventfd.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace otbr {
+
+TaskQueue::TaskQueue(void)
+    : mHead(&mStub)
+    , mTail(&mStub)
+    , mSignaled(false)
+    , mEventFd(-1)
+{
+    mStub.mNext.store(nullptr, std::memory_order_relaxed);
+}
+
+TaskQueue::~TaskQueue(void)
+{
+    Node *node;
+
+    while ((node = Pop()) != nullptr)
+    {
+        delete node;
+    }
+
+    Deinit();
+}
+
+otbrError TaskQueue::Init(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mEventFd == -1);
+    mEventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    VerifyOrExit(mEventFd != -1, error = OTBR_ERROR_ERRNO);
+
+exit:
+    return error;
+}
+
+void TaskQueue::Deinit(void)
+{
+    if (mEventFd != -1)
+    {
+        close(mEventFd);
+        mEventFd = -1;
+    }
+}
+
+void TaskQueue::Post(const Task &aTask)
+{
+    Node *node = new Node();
+
+    node->mTask = aTask;
+    Push(*node);
+
+    // The node must be linked before signaling, see Process().
+    if (!mSignaled.exchange(true) && mEventFd != -1)
+    {
+        uint64_t one = 1;
+
+        if (write(mEventFd, &one, sizeof(one)) != sizeof(one))
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to signal task queue: %s", strerror(errno));
+        }
+    }
+}
+
+void TaskQueue::UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd) const
+{
+    VerifyOrExit(mEventFd != -1);
+
+    FD_SET(mEventFd, &aReadFdSet);
+
+    if (aMaxFd < mEventFd)
+    {
+        aMaxFd = mEventFd;
+    }
+
+exit:
+    return;
+}
+
+uint32_t TaskQueue::Process(const fd_set &aReadFdSet)
+{
+    uint32_t count = 0;
+    Node *   node;
+
+    if (mEventFd != -1 && FD_ISSET(mEventFd, &aReadFdSet))
+    {
+        uint64_t value;
+
+        if (read(mEventFd, &value, sizeof(value)) != sizeof(value) && errno != EAGAIN)
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to read task queue signal: %s", strerror(errno));
+        }
+    }
+
+    // Clear the signal before draining. A producer racing with the drain either has its task run below or observes
+    // the cleared flag and signals again, so no task is left behind without a pending wakeup.
+    mSignaled.store(false);
+
+    while ((node = Pop()) != nullptr)
+    {
+        node->mTask();
+        delete node;
+        ++count;
+    }
+
+    return count;
+}
+
+void TaskQueue::Push(Node &aNode)
+{
+    Node *prev;
+
+    aNode.mNext.store(nullptr, std::memory_order_relaxed);
+    prev = mHead.exchange(&aNode, std::memory_order_acq_rel);
+    prev->mNext.store(&aNode, std::memory_order_release);
+}
+
+TaskQueue::Node *TaskQueue::Pop(void)
+{
+    Node *tail = mTail;
+    Node *next = tail->mNext.load(std::memory_order_acquire);
+    Node *node = nullptr;
+
+    if (tail == &mStub)
+    {
+        VerifyOrExit(next != nullptr);
+        mTail = next;
+        tail  = next;
+        next  = next->mNext.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        mTail = next;
+        ExitNow(node = tail);
+    }
+
+    // A producer has swapped the head but not linked its node yet, it signals again once linked.
+    VerifyOrExit(tail == mHead.load(std::memory_order_acquire));
+
+    Push(mStub);
+    next = tail->mNext.load(std::memory_order_acquire);
+
+    if (next != nullptr)
+    {
+        mTail = next;
+        node  = tail;
+    }
+
+exit:
+    return node;
+}
+
+} // namespace otbr
@@ -0,0 +1,146 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a lock-free multi-producer single-consumer task queue.
+ */
+
+#ifndef OTBR_COMMON_TASK_QUEUE_HPP_
+#define OTBR_COMMON_TASK_QUEUE_HPP_
+
+#include "openthread-br/config.h"
+
+#include <atomic>
+#include <functional>
+
+#include <stdint.h>
+#include <sys/select.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class implements a lock-free multi-producer single-consumer task queue.
+ *
+ * Any thread may post tasks. A single consumer thread polls the queue's event fd and runs the tasks in the order
+ * they were posted. The event fd is only written when the queue goes from idle to signaled, so a burst of posts
+ * costs a single wakeup.
+ *
+ */
+class TaskQueue
+{
+public:
+    typedef std::function<void(void)> Task;
+
+    /**
+     * The constructor initializes an empty task queue.
+     *
+     */
+    TaskQueue(void);
+
+    /**
+     * The destructor frees the tasks not run yet.
+     *
+     */
+    ~TaskQueue(void);
+
+    /**
+     * This method initializes the event fd of the task queue.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully initialized the task queue.
+     * @retval  OTBR_ERROR_ERRNO    Failed to create the event fd.
+     *
+     */
+    otbrError Init(void);
+
+    /**
+     * This method closes the event fd of the task queue.
+     *
+     */
+    void Deinit(void);
+
+    /**
+     * This method posts a task. It may be called from any thread.
+     *
+     * @param[in]   aTask   The task to run on the consumer thread.
+     *
+     */
+    void Post(const Task &aTask);
+
+    /**
+     * This method updates the fd_set to poll, called from the consumer thread.
+     *
+     * @param[inout]    aReadFdSet  The read fd set.
+     * @param[inout]    aMaxFd      The current max fd in @p aReadFdSet.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd) const;
+
+    /**
+     * This method runs the posted tasks, called from the consumer thread.
+     *
+     * @param[in]   aReadFdSet  The read fd set returned by the poll.
+     *
+     * @returns The number of tasks run.
+     *
+     */
+    uint32_t Process(const fd_set &aReadFdSet);
+
+    /**
+     * This method returns the event fd of the task queue, for consumers running their own event loop.
+     *
+     * @returns The event fd, or -1 if not initialized.
+     *
+     */
+    int GetEventFd(void) const { return mEventFd; }
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> mNext;
+        Task                mTask;
+    };
+
+    TaskQueue(const TaskQueue &) = delete;
+    TaskQueue &operator=(const TaskQueue &) = delete;
+
+    void  Push(Node &aNode);
+    Node *Pop(void);
+
+    std::atomic<Node *> mHead; ///< The most recently posted node, updated by producers.
+    Node *              mTail; ///< The oldest node, only accessed by the consumer.
+    Node                mStub;
+    std::atomic<bool>   mSignaled;
+    int                 mEventFd;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_TASK_QUEUE_HPP_
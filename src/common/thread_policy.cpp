@@ -0,0 +1,237 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the scheduling policies and CPU affinities of the agent threads.
+ */
+
+#include "common/thread_policy.hpp"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace otbr {
+
+namespace {
+
+struct ThreadPolicy
+{
+    bool      mHasSched;
+    bool      mHasCpus;
+    int       mPolicy;
+    int       mPriority;
+    cpu_set_t mCpus;
+};
+
+struct SchedPolicyName
+{
+    const char *mName;
+    int         mPolicy;
+};
+
+const SchedPolicyName kSchedPolicyNames[] = {
+    {"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE}, {"fifo", SCHED_FIFO}, {"rr", SCHED_RR},
+};
+
+ThreadPolicy sPolicies[kThreadClassNum];
+
+bool ParseSched(const std::string &aSched, ThreadPolicy &aPolicy)
+{
+    size_t      separator = aSched.find(':');
+    std::string name      = aSched.substr(0, separator);
+    bool        valid     = false;
+    size_t      i;
+
+    for (i = 0; i < sizeof(kSchedPolicyNames) / sizeof(kSchedPolicyNames[0]); i++)
+    {
+        if (name == kSchedPolicyNames[i].mName)
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(i < sizeof(kSchedPolicyNames) / sizeof(kSchedPolicyNames[0]));
+
+    aPolicy.mPolicy   = kSchedPolicyNames[i].mPolicy;
+    aPolicy.mPriority = sched_get_priority_min(aPolicy.mPolicy);
+
+    if (separator != std::string::npos)
+    {
+        const char *priority = aSched.c_str() + separator + 1;
+        char *      end;
+        long        value = strtol(priority, &end, 10);
+
+        VerifyOrExit(end != priority && *end == '\0');
+        VerifyOrExit(value >= sched_get_priority_min(aPolicy.mPolicy) &&
+                     value <= sched_get_priority_max(aPolicy.mPolicy));
+        aPolicy.mPriority = static_cast<int>(value);
+    }
+
+    aPolicy.mHasSched = true;
+    valid             = true;
+
+exit:
+    return valid;
+}
+
+bool ParseCpus(const std::string &aCpus, ThreadPolicy &aPolicy)
+{
+    const char *cur   = aCpus.c_str();
+    bool        valid = false;
+
+    CPU_ZERO(&aPolicy.mCpus);
+
+    while (true)
+    {
+        char *end;
+        long  first = strtol(cur, &end, 10);
+        long  last  = first;
+
+        VerifyOrExit(end != cur && first >= 0 && first < CPU_SETSIZE);
+
+        if (*end == '-')
+        {
+            cur  = end + 1;
+            last = strtol(cur, &end, 10);
+            VerifyOrExit(end != cur && last >= first && last < CPU_SETSIZE);
+        }
+
+        for (long cpu = first; cpu <= last; cpu++)
+        {
+            CPU_SET(static_cast<int>(cpu), &aPolicy.mCpus);
+        }
+
+        VerifyOrExit(*end == ',' || *end == '\0');
+        cur = end + 1;
+
+        if (*end == '\0')
+        {
+            break;
+        }
+    }
+
+    aPolicy.mHasCpus = true;
+    valid            = true;
+
+exit:
+    return valid;
+}
+
+} // namespace
+
+const char *GetThreadClassName(ThreadClass aClass)
+{
+    static const char *const kNames[] = {"main", "radio", "worker", "log"};
+
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == kThreadClassNum, "Thread class names mismatch");
+
+    return kNames[aClass];
+}
+
+bool ParseThreadPolicy(const char *aArgument)
+{
+    const char * separator = strchr(aArgument, '=');
+    std::string  spec;
+    size_t       at;
+    ThreadPolicy policy;
+    int          threadClass = 0;
+    bool         valid       = false;
+
+    VerifyOrExit(separator != NULL);
+
+    while (threadClass < kThreadClassNum &&
+           std::string(aArgument, separator) != GetThreadClassName(static_cast<ThreadClass>(threadClass)))
+    {
+        threadClass++;
+    }
+
+    VerifyOrExit(threadClass < kThreadClassNum);
+
+    memset(&policy, 0, sizeof(policy));
+    spec = separator + 1;
+    at   = spec.find('@');
+
+    VerifyOrExit(!spec.empty());
+    VerifyOrExit(at == 0 || ParseSched(spec.substr(0, at), policy));
+    VerifyOrExit(at == std::string::npos || ParseCpus(spec.substr(at + 1), policy));
+
+    sPolicies[threadClass] = policy;
+    valid                  = true;
+
+exit:
+    return valid;
+}
+
+bool IsThreadPolicySet(ThreadClass aClass)
+{
+    return sPolicies[aClass].mHasSched || sPolicies[aClass].mHasCpus;
+}
+
+otbrError ApplyThreadPolicy(ThreadClass aClass)
+{
+    const ThreadPolicy &policy = sPolicies[aClass];
+    otbrError           error  = OTBR_ERROR_NONE;
+    int                 rval;
+
+    if (policy.mHasCpus)
+    {
+        rval = pthread_setaffinity_np(pthread_self(), sizeof(policy.mCpus), &policy.mCpus);
+        VerifyOrExit(rval == 0, error = OTBR_ERROR_ERRNO, errno = rval);
+    }
+
+    if (policy.mHasSched)
+    {
+        sched_param param;
+
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = policy.mPriority;
+
+        rval = pthread_setschedparam(pthread_self(), policy.mPolicy, &param);
+        VerifyOrExit(rval == 0, error = OTBR_ERROR_ERRNO, errno = rval);
+    }
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to apply the %s thread policy: %s", GetThreadClassName(aClass),
+                strerror(errno));
+    }
+
+    return error;
+}
+
+} // namespace otbr
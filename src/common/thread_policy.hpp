@@ -0,0 +1,108 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the scheduling policies and CPU affinities of the agent threads.
+ */
+
+#ifndef OTBR_COMMON_THREAD_POLICY_HPP_
+#define OTBR_COMMON_THREAD_POLICY_HPP_
+
+#include "openthread-br/config.h"
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This enumeration defines the classes of threads sharing a scheduling policy.
+ *
+ */
+enum ThreadClass
+{
+    kThreadClassMain,   ///< The main loop.
+    kThreadClassRadio,  ///< The spinel path to the RCP, the radio thread or the main loop without one.
+    kThreadClassWorker, ///< Worker pools, e.g. the DTLS handshakes and the Web jobs.
+    kThreadClassLog,    ///< Log writers.
+    kThreadClassNum,    ///< Number of thread classes.
+};
+
+/**
+ * This function returns the name of a thread class.
+ *
+ * @param[in]   aClass  The thread class.
+ *
+ * @returns The name of the thread class.
+ *
+ */
+const char *GetThreadClassName(ThreadClass aClass);
+
+/**
+ * This function sets the policy of a thread class from an argument of the command line.
+ *
+ * The argument is CLASS=[POLICY[:PRIORITY]][@CPUS], where POLICY is one of other, batch, idle, fifo or rr, and CPUS
+ * is a list of CPUs and ranges such as 0,2-3. The priority of fifo and rr defaults to the lowest one.
+ *
+ * Policies must be set before the threads of the class start.
+ *
+ * @param[in]   aArgument   The argument.
+ *
+ * @returns Whether the argument is valid.
+ *
+ */
+bool ParseThreadPolicy(const char *aArgument);
+
+/**
+ * This function indicates whether a policy was set for a thread class.
+ *
+ * @param[in]   aClass  The thread class.
+ *
+ * @retval true     A policy was set.
+ * @retval false    The threads of the class inherit the policy of the thread creating them.
+ *
+ */
+bool IsThreadPolicySet(ThreadClass aClass);
+
+/**
+ * This function applies the policy of a thread class to the calling thread.
+ *
+ * Only the parts of the policy which were set, the scheduling policy or the CPU affinity, are applied. The
+ * failures are logged.
+ *
+ * @param[in]   aClass  The thread class.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully applied the policy, or no policy was set.
+ * @retval  OTBR_ERROR_ERRNO    Failed to apply the policy, errno is set.
+ *
+ */
+otbrError ApplyThreadPolicy(ThreadClass aClass);
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_THREAD_POLICY_HPP_
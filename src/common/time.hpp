@@ -32,6 +32,7 @@
 #include "openthread-br/config.h"
 
 #include <stdint.h>
+#include <time.h>
 
 #include <sys/time.h>
 
@@ -51,19 +52,54 @@ inline unsigned long GetTimestamp(const timeval &aTime)
 }
 
 /**
- * This method returns the current timestamp in miniseconds.
+ * This method returns the current monotonic timestamp in miniseconds.
+ *
+ * The timestamp only has a meaning relative to other timestamps, and it does not jump when the system time is set.
  *
  * @returns Current timestamp in miniseconds.
  *
  */
 inline unsigned long GetNow(void)
 {
-    timeval now;
+    timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<unsigned long>(now.tv_sec) * 1000 + static_cast<unsigned long>(now.tv_nsec / 1000000);
+}
+
+/**
+ * This method returns the current monotonic timestamp in microseconds, for latency measurements.
+ *
+ * @returns Current timestamp in microseconds.
+ *
+ */
+inline uint64_t GetNowPrecise(void)
+{
+    timespec now;
 
-    gettimeofday(&now, NULL);
-    return static_cast<unsigned long>(now.tv_sec * 1000 + now.tv_usec / 1000);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec / 1000);
 }
 
+/**
+ * This method samples the current timestamp for the rest of the main loop iteration.
+ *
+ * The main loop calls this once after each wakeup, and must be the only thread doing so.
+ *
+ */
+void UpdateMainloopNow(void);
+
+/**
+ * This method returns the timestamp of the current main loop iteration, in miniseconds.
+ *
+ * Processing that only needs the time of the event it handles uses this one timestamp instead of reading the clock
+ * again. It must only be called from the main loop thread, and falls back to GetNow() before the first sample.
+ *
+ * @returns The timestamp sampled by UpdateMainloopNow(), in miniseconds.
+ *
+ */
+unsigned long GetMainloopNow(void);
+
 } // namespace otbr
 
 #endif // OTBR_COMMON_TIME_HPP_
@@ -0,0 +1,429 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the timer service shared by the agent modules.
+ */
+
+#include "common/timer.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+
+namespace otbr {
+
+static uint64_t RotateRight(uint64_t aValue, unsigned aShift)
+{
+    return aShift == 0 ? aValue : (aValue >> aShift) | (aValue << (64 - aShift));
+}
+
+Timer::Timer(Handler aHandler, void *aContext, TimerScheduler &aScheduler)
+    : mHandler(aHandler)
+    , mContext(aContext)
+    , mScheduler(aScheduler)
+    , mDeadline(0)
+    , mNext(nullptr)
+    , mPrevNext(nullptr)
+    , mLevel(0)
+    , mSlot(0)
+{
+}
+
+Timer::Timer(Handler aHandler, void *aContext)
+    : Timer(aHandler, aContext, TimerScheduler::Get())
+{
+}
+
+Timer::~Timer(void)
+{
+    Stop();
+}
+
+void Timer::Start(uint64_t aDelay)
+{
+    StartAt(GetNow() + aDelay);
+}
+
+void Timer::StartAt(uint64_t aDeadline)
+{
+    Stop();
+    mDeadline = aDeadline;
+    mScheduler.Add(*this);
+}
+
+void Timer::Stop(void)
+{
+    if (IsRunning())
+    {
+        mScheduler.Remove(*this);
+    }
+}
+
+TimerScheduler::TimerScheduler(uint64_t aNow)
+    : mCurrent(aNow)
+{
+    memset(mSlots, 0, sizeof(mSlots));
+    memset(mOccupied, 0, sizeof(mOccupied));
+}
+
+TimerScheduler &TimerScheduler::Get(void)
+{
+    static TimerScheduler sScheduler(GetNow());
+
+    return sScheduler;
+}
+
+void TimerScheduler::Link(Timer *&aHead, Timer &aTimer)
+{
+    aTimer.mNext = aHead;
+
+    if (aHead != nullptr)
+    {
+        aHead->mPrevNext = &aTimer.mNext;
+    }
+
+    aHead            = &aTimer;
+    aTimer.mPrevNext = &aHead;
+}
+
+void TimerScheduler::Add(Timer &aTimer)
+{
+    const uint64_t kRange   = 1ULL << (kSlotBits * kLevels);
+    uint64_t       deadline = aTimer.mDeadline < mCurrent ? mCurrent : aTimer.mDeadline;
+    unsigned       level    = 0;
+
+    while (level < kLevels - 1 && deadline - mCurrent >= (1ULL << (kSlotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    if (deadline - mCurrent >= kRange)
+    {
+        // Parked in the last slot within range, it is placed again when that slot is cascaded.
+        deadline = mCurrent + kRange - 1;
+    }
+
+    aTimer.mLevel = static_cast<uint8_t>(level);
+    aTimer.mSlot  = static_cast<uint8_t>((deadline >> (kSlotBits * level)) & kSlotMask);
+
+    Link(mSlots[level][aTimer.mSlot], aTimer);
+    mOccupied[level] |= 1ULL << aTimer.mSlot;
+}
+
+void TimerScheduler::Remove(Timer &aTimer)
+{
+    assert(aTimer.mPrevNext != nullptr);
+
+    *aTimer.mPrevNext = aTimer.mNext;
+
+    if (aTimer.mNext != nullptr)
+    {
+        aTimer.mNext->mPrevNext = aTimer.mPrevNext;
+    }
+
+    if (aTimer.mLevel != kDetached && mSlots[aTimer.mLevel][aTimer.mSlot] == nullptr)
+    {
+        mOccupied[aTimer.mLevel] &= ~(1ULL << aTimer.mSlot);
+    }
+
+    aTimer.mNext     = nullptr;
+    aTimer.mPrevNext = nullptr;
+}
+
+uint64_t TimerScheduler::GetNextDeadline(void) const
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned level = 0; level < kLevels; ++level)
+    {
+        unsigned shift = kSlotBits * level;
+        uint64_t cur   = mCurrent >> shift;
+        unsigned index = static_cast<unsigned>(cur & kSlotMask);
+        uint64_t tick;
+
+        if (mOccupied[level] == 0)
+        {
+            continue;
+        }
+
+        if (level == 0)
+        {
+            tick = mCurrent + static_cast<uint64_t>(__builtin_ctzll(RotateRight(mOccupied[level], index)));
+        }
+        else if ((mCurrent & ((1ULL << shift) - 1)) == 0)
+        {
+            // The slot at the current index is cascaded at mCurrent itself.
+            tick = (cur + static_cast<uint64_t>(__builtin_ctzll(RotateRight(mOccupied[level], index)))) << shift;
+        }
+        else
+        {
+            unsigned offset = 1 + static_cast<unsigned>(
+                                      __builtin_ctzll(RotateRight(mOccupied[level], (index + 1) & kSlotMask)));
+
+            tick = (cur + offset) << shift;
+        }
+
+        if (tick < next)
+        {
+            next = tick;
+        }
+    }
+
+    return next;
+}
+
+void TimerScheduler::Cascade(unsigned aLevel)
+{
+    unsigned slot  = static_cast<unsigned>((mCurrent >> (kSlotBits * aLevel)) & kSlotMask);
+    Timer *  timer = mSlots[aLevel][slot];
+
+    mSlots[aLevel][slot] = nullptr;
+    mOccupied[aLevel] &= ~(1ULL << slot);
+
+    while (timer != nullptr)
+    {
+        Timer *next = timer->mNext;
+
+        Add(*timer);
+        timer = next;
+    }
+}
+
+uint32_t TimerScheduler::Expire(void)
+{
+    unsigned slot    = static_cast<unsigned>(mCurrent & kSlotMask);
+    Timer *  expired = mSlots[0][slot];
+    uint32_t count   = 0;
+
+    mSlots[0][slot] = nullptr;
+    mOccupied[0] &= ~(1ULL << slot);
+
+    if (expired != nullptr)
+    {
+        expired->mPrevNext = &expired;
+    }
+
+    for (Timer *timer = expired; timer != nullptr; timer = timer->mNext)
+    {
+        timer->mLevel = kDetached;
+    }
+
+    ++mCurrent;
+
+    while (expired != nullptr)
+    {
+        Timer *timer = expired;
+
+        Remove(*timer);
+        timer->mHandler(*timer, timer->mContext);
+        ++count;
+    }
+
+    return count;
+}
+
+uint32_t TimerScheduler::Process(uint64_t aNow)
+{
+    uint64_t tick;
+    uint32_t count = 0;
+
+    while ((tick = GetNextDeadline()) <= aNow)
+    {
+        mCurrent = tick;
+
+        for (unsigned level = kLevels - 1; level > 0; --level)
+        {
+            if ((tick & ((1ULL << (kSlotBits * level)) - 1)) == 0)
+            {
+                Cascade(level);
+            }
+        }
+
+        count += Expire();
+    }
+
+    if (mCurrent <= aNow)
+    {
+        mCurrent = aNow + 1;
+    }
+
+    return count;
+}
+
+void TimerScheduler::UpdateTimeout(uint64_t aNow, struct timeval &aTimeout) const
+{
+    uint64_t deadline = GetNextDeadline();
+    uint64_t timeout  = static_cast<uint64_t>(aTimeout.tv_sec) * 1000 + static_cast<uint64_t>(aTimeout.tv_usec) / 1000;
+
+    VerifyOrExit(deadline != UINT64_MAX);
+
+    if (deadline <= aNow)
+    {
+        aTimeout.tv_sec  = 0;
+        aTimeout.tv_usec = 0;
+    }
+    else if (deadline - aNow < timeout)
+    {
+        aTimeout.tv_sec  = static_cast<time_t>((deadline - aNow) / 1000);
+        aTimeout.tv_usec = static_cast<suseconds_t>(((deadline - aNow) % 1000) * 1000);
+    }
+
+exit:
+    return;
+}
+
+TimerTask::TimerTask(TimerTaskPool &aPool)
+    : mTimer(TimerTaskPool::HandleTimer, this, aPool.mScheduler)
+    , mPool(aPool)
+    , mNextFree(nullptr)
+    , mGeneration(0)
+{
+}
+
+bool TimerTaskHandle::IsPending(void) const
+{
+    return IsValid() && mTask->mTimer.IsRunning();
+}
+
+void TimerTaskHandle::Cancel(void)
+{
+    if (IsPending())
+    {
+        mTask->mTimer.Stop();
+        mTask->mPool.Release(*mTask);
+    }
+}
+
+bool TimerTaskHandle::Reschedule(uint64_t aDelay)
+{
+    bool rval = IsValid();
+
+    if (rval)
+    {
+        mTask->mTimer.Start(aDelay);
+    }
+
+    return rval;
+}
+
+uint64_t TimerTaskHandle::GetDeadline(void) const
+{
+    return IsPending() ? mTask->mTimer.GetDeadline() : 0;
+}
+
+TimerTaskPool::TimerTaskPool(TimerScheduler &aScheduler)
+    : mScheduler(aScheduler)
+    , mFreeList(nullptr)
+{
+}
+
+TimerTaskPool::TimerTaskPool(void)
+    : TimerTaskPool(TimerScheduler::Get())
+{
+}
+
+TimerTaskHandle TimerTaskPool::Post(uint64_t aDelay, const std::function<void(void)> &aTask)
+{
+    TimerTask *     task = mFreeList;
+    TimerTaskHandle handle;
+
+    if (task != nullptr)
+    {
+        mFreeList = task->mNextFree;
+    }
+    else
+    {
+        VerifyOrExit(!IsFull(),
+                     otbrLogRateLimited(1000, OTBR_LOG_WARNING, "Timer task dropped, all %zu tasks are pending.",
+                                        mTasks.size()));
+#if OTBR_ENABLE_STATIC_POOLS
+        mTasks.emplace_back(*this);
+#else
+        mTasks.emplace_back(new TimerTask(*this));
+#endif
+        task = &GetTask(mTasks.back());
+    }
+
+    task->mTask = aTask;
+    task->mTimer.Start(aDelay);
+    handle = TimerTaskHandle(*task);
+
+exit:
+    return handle;
+}
+
+void TimerTaskPool::Clear(void)
+{
+    for (auto &entry : mTasks)
+    {
+        TimerTask &task = GetTask(entry);
+
+        if (task.mTimer.IsRunning())
+        {
+            task.mTimer.Stop();
+            Release(task);
+        }
+    }
+}
+
+bool TimerTaskPool::IsFull(void) const
+{
+#if OTBR_ENABLE_STATIC_POOLS
+    return mTasks.size() == mTasks.capacity();
+#else
+    return false;
+#endif
+}
+
+void TimerTaskPool::HandleTimer(Timer &aTimer, void *aContext)
+{
+    TimerTask &task = *static_cast<TimerTask *>(aContext);
+
+    task.mTask();
+
+    // The task may have rescheduled itself.
+    if (!aTimer.IsRunning())
+    {
+        task.mPool.Release(task);
+    }
+}
+
+void TimerTaskPool::Release(TimerTask &aTask)
+{
+    aTask.mTask = nullptr;
+    ++aTask.mGeneration;
+    aTask.mNextFree = mFreeList;
+    mFreeList       = &aTask;
+}
+
+} // namespace otbr
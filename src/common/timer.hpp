@@ -0,0 +1,423 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the timer service shared by the agent modules.
+ */
+
+#ifndef OTBR_COMMON_TIMER_HPP_
+#define OTBR_COMMON_TIMER_HPP_
+
+#include "openthread-br/config.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+#include <sys/time.h>
+
+#include "common/memory_stats.hpp"
+#include "common/static_pool.hpp"
+
+/**
+ * The max number of timer tasks pending at once in a pool of the static-pool build profile.
+ *
+ */
+#ifndef OTBR_CONFIG_TIMER_MAX_TASKS
+#define OTBR_CONFIG_TIMER_MAX_TASKS 16
+#endif
+
+namespace otbr {
+
+class TimerScheduler;
+
+/**
+ * This class implements a one-shot timer.
+ *
+ * A timer is an intrusive node of its scheduler, so starting, restarting and stopping a timer never allocates.
+ *
+ */
+class Timer
+{
+    friend class TimerScheduler;
+
+public:
+    /**
+     * This function pointer is called when the timer fires.
+     *
+     * The timer is already stopped when this function is called, so it is safe to restart or destroy the timer.
+     *
+     * @param[in]   aTimer      A reference to the timer.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    typedef void (*Handler)(Timer &aTimer, void *aContext);
+
+    /**
+     * The constructor of a timer.
+     *
+     * @param[in]   aHandler    The function to be called when the timer fires.
+     * @param[in]   aContext    A pointer to application-specific context.
+     * @param[in]   aScheduler  The scheduler this timer belongs to.
+     *
+     */
+    Timer(Handler aHandler, void *aContext, TimerScheduler &aScheduler);
+
+    /**
+     * The constructor of a timer on the scheduler driven by the main loop.
+     *
+     * @param[in]   aHandler    The function to be called when the timer fires.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    Timer(Handler aHandler, void *aContext);
+
+    /**
+     * The destructor of a timer, which stops the timer.
+     *
+     */
+    ~Timer(void);
+
+    /**
+     * This method (re)starts the timer to fire after a delay.
+     *
+     * @param[in]   aDelay  The delay in milliseconds.
+     *
+     */
+    void Start(uint64_t aDelay);
+
+    /**
+     * This method (re)starts the timer to fire at an absolute time.
+     *
+     * @param[in]   aDeadline   The absolute time in milliseconds, as returned by GetNow().
+     *
+     */
+    void StartAt(uint64_t aDeadline);
+
+    /**
+     * This method stops the timer.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method indicates whether the timer is running.
+     *
+     * @retval  true    The timer is running.
+     * @retval  false   The timer is stopped.
+     *
+     */
+    bool IsRunning(void) const { return mPrevNext != nullptr; }
+
+    /**
+     * This method returns the absolute time when the timer fires.
+     *
+     * @returns The deadline in milliseconds.
+     *
+     */
+    uint64_t GetDeadline(void) const { return mDeadline; }
+
+    /**
+     * This method returns the application-specific context of the timer.
+     *
+     * @returns A pointer to the application-specific context.
+     *
+     */
+    void *GetContext(void) const { return mContext; }
+
+    /**
+     * This method changes the handler of the timer.
+     *
+     * @param[in]   aHandler    The function to be called when the timer fires.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    void SetHandler(Handler aHandler, void *aContext)
+    {
+        mHandler = aHandler;
+        mContext = aContext;
+    }
+
+private:
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+    Handler         mHandler;
+    void *          mContext;
+    TimerScheduler &mScheduler;
+    uint64_t        mDeadline;
+    Timer *         mNext;
+    Timer **        mPrevNext; ///< Points to the link referring to this timer, nullptr if not running.
+    uint8_t         mLevel;
+    uint8_t         mSlot;
+};
+
+/**
+ * This class implements a hierarchical timer wheel.
+ *
+ * Starting and stopping a timer is O(1). Process() and GetNextDeadline() only look at non-empty slots, so their cost
+ * does not depend on the number of pending timers.
+ *
+ */
+class TimerScheduler
+{
+    friend class Timer;
+
+public:
+    /**
+     * The constructor of a timer scheduler.
+     *
+     * @param[in]   aNow    The current time in milliseconds.
+     *
+     */
+    explicit TimerScheduler(uint64_t aNow);
+
+    /**
+     * This method returns the scheduler driven by the main loop.
+     *
+     * @returns A reference to the timer scheduler.
+     *
+     */
+    static TimerScheduler &Get(void);
+
+    /**
+     * This method fires all timers whose deadline is not later than @p aNow.
+     *
+     * @param[in]   aNow    The current time in milliseconds.
+     *
+     * @returns The number of timers fired.
+     *
+     */
+    uint32_t Process(uint64_t aNow);
+
+    /**
+     * This method returns the earliest time at which Process() may have work to do.
+     *
+     * The returned time is never later than the earliest deadline of the pending timers, but may be earlier when
+     * timers far in the future have to be moved to a finer-grained level of the wheel.
+     *
+     * @returns The time in milliseconds, or UINT64_MAX if no timer is running.
+     *
+     */
+    uint64_t GetNextDeadline(void) const;
+
+    /**
+     * This method shrinks a main loop timeout so that the next deadline is not missed.
+     *
+     * @param[in]       aNow        The current time in milliseconds.
+     * @param[inout]    aTimeout    A reference to the timeout.
+     *
+     */
+    void UpdateTimeout(uint64_t aNow, struct timeval &aTimeout) const;
+
+private:
+    enum
+    {
+        kSlotBits = 6,
+        kSlots    = 1 << kSlotBits,
+        kSlotMask = kSlots - 1,
+        kLevels   = 5, ///< Covers about 12 days at 1 ms resolution.
+        kDetached = kLevels,
+    };
+
+    static void Link(Timer *&aHead, Timer &aTimer);
+
+    void Add(Timer &aTimer);
+    void Remove(Timer &aTimer);
+    void     Cascade(unsigned aLevel);
+    uint32_t Expire(void);
+
+    Timer *  mSlots[kLevels][kSlots];
+    uint64_t mOccupied[kLevels]; ///< One bit per non-empty slot.
+    uint64_t mCurrent;           ///< The next tick to be processed.
+};
+
+class TimerTaskPool;
+
+/**
+ * This structure represents a pooled timer task.
+ *
+ */
+struct TimerTask : public MemoryTagged<kMemoryTagTimers>
+{
+    /**
+     * The constructor of a timer task.
+     *
+     * @param[in]   aPool   The pool this task belongs to.
+     *
+     */
+    explicit TimerTask(TimerTaskPool &aPool);
+
+    Timer                     mTimer;      ///< The timer of this task.
+    std::function<void(void)> mTask;       ///< The task to run.
+    TimerTaskPool &           mPool;       ///< The pool this task belongs to.
+    TimerTask *               mNextFree;   ///< The next free task in the pool.
+    uint32_t                  mGeneration; ///< Incremented each time the task is returned to the pool.
+};
+
+/**
+ * This class represents a token of a posted timer task.
+ *
+ * A handle stays valid after the task has run or been cancelled, it is simply no longer pending. It must not be used
+ * after the pool it came from is destroyed.
+ *
+ */
+class TimerTaskHandle
+{
+    friend class TimerTaskPool;
+
+public:
+    /**
+     * The constructor of an empty handle.
+     *
+     */
+    TimerTaskHandle(void)
+        : mTask(nullptr)
+        , mGeneration(0)
+    {
+    }
+
+    /**
+     * This method indicates whether the task is still waiting to run.
+     *
+     * @retval  true    The task is pending.
+     * @retval  false   The task has run, has been cancelled or the handle is empty.
+     *
+     */
+    bool IsPending(void) const;
+
+    /**
+     * This method cancels the task if it is pending.
+     *
+     */
+    void Cancel(void);
+
+    /**
+     * This method changes when the task runs.
+     *
+     * The task may reschedule itself while it is running.
+     *
+     * @param[in]   aDelay  The delay in milliseconds from now.
+     *
+     * @retval  true    Successfully rescheduled.
+     * @retval  false   The task has already run or been cancelled.
+     *
+     */
+    bool Reschedule(uint64_t aDelay);
+
+    /**
+     * This method returns when the task runs.
+     *
+     * @returns The deadline in milliseconds, or 0 if the task is not pending.
+     *
+     */
+    uint64_t GetDeadline(void) const;
+
+private:
+    TimerTaskHandle(TimerTask &aTask)
+        : mTask(&aTask)
+        , mGeneration(aTask.mGeneration)
+    {
+    }
+
+    bool IsValid(void) const { return mTask != nullptr && mTask->mGeneration == mGeneration; }
+
+    TimerTask *mTask;
+    uint32_t   mGeneration;
+};
+
+/**
+ * This class implements a pool of one-shot timer tasks.
+ *
+ * Tasks are recycled through a free list, so posting, cancelling and rescheduling tasks does not allocate once the
+ * pool has grown to the number of concurrently pending tasks, provided the task fits in the small buffer of
+ * `std::function` (typically two pointers). In the static-pool build profile the tasks are stored in the pool, which
+ * refuses tasks beyond OTBR_CONFIG_TIMER_MAX_TASKS.
+ *
+ */
+class TimerTaskPool
+{
+    friend class TimerTaskHandle;
+    friend struct TimerTask;
+
+public:
+    /**
+     * The constructor of a timer task pool.
+     *
+     * @param[in]   aScheduler  The scheduler to run the tasks on.
+     *
+     */
+    explicit TimerTaskPool(TimerScheduler &aScheduler);
+
+    /**
+     * The constructor of a timer task pool on the scheduler driven by the main loop.
+     *
+     */
+    TimerTaskPool(void);
+
+    /**
+     * This method posts a task.
+     *
+     * @param[in]   aDelay  The delay in milliseconds.
+     * @param[in]   aTask   The task to run.
+     *
+     * @returns A handle to cancel or reschedule the task, an empty handle if the pool is exhausted.
+     *
+     */
+    TimerTaskHandle Post(uint64_t aDelay, const std::function<void(void)> &aTask);
+
+    /**
+     * This method cancels all pending tasks.
+     *
+     */
+    void Clear(void);
+
+private:
+    static void HandleTimer(Timer &aTimer, void *aContext);
+    bool        IsFull(void) const;
+    void        Release(TimerTask &aTask);
+
+#if OTBR_ENABLE_STATIC_POOLS
+    typedef StaticVector<TimerTask, OTBR_CONFIG_TIMER_MAX_TASKS> Tasks;
+#else
+    typedef std::vector<std::unique_ptr<TimerTask>> Tasks;
+#endif
+
+    static TimerTask &GetTask(TimerTask &aTask) { return aTask; }
+    static TimerTask &GetTask(const std::unique_ptr<TimerTask> &aTask) { return *aTask; }
+
+    TimerScheduler &mScheduler;
+    Tasks           mTasks;
+    TimerTask *     mFreeList;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_TIMER_HPP_
@@ -0,0 +1,132 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the Tlv view and writer.
+ */
+
+#include "common/tlv.hpp"
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+TlvView::TlvView(const uint8_t *aBuffer, uint16_t aLength, bool aAllowExtended)
+    : mBuffer(aBuffer)
+    , mValidEnd(aBuffer)
+    , mEnd(aBuffer + aLength)
+{
+    while (mValidEnd < mEnd)
+    {
+        const uint8_t *cur       = mValidEnd;
+        size_t         remaining = static_cast<size_t>(mEnd - cur);
+        size_t         header    = sizeof(uint8_t) * 2;
+        size_t         length;
+
+        if (remaining < header)
+        {
+            break;
+        }
+
+        if (cur[1] == Tlv::kLengthEscape)
+        {
+            header += sizeof(uint16_t);
+
+            if (!aAllowExtended || remaining < header)
+            {
+                break;
+            }
+
+            length = static_cast<size_t>(cur[2] << 8 | cur[3]);
+        }
+        else
+        {
+            length = cur[1];
+        }
+
+        if (remaining - header < length)
+        {
+            break;
+        }
+
+        mValidEnd = cur + header + length;
+    }
+}
+
+const Tlv *TlvView::Find(uint8_t aType) const
+{
+    const Tlv *found = nullptr;
+
+    for (const Tlv &tlv : *this)
+    {
+        if (tlv.GetType() == aType)
+        {
+            found = &tlv;
+            break;
+        }
+    }
+
+    return found;
+}
+
+TlvIndex::TlvIndex(const TlvView &aView)
+{
+    for (const Tlv *&tlv : mTlvs)
+    {
+        tlv = nullptr;
+    }
+
+    for (const Tlv &tlv : aView)
+    {
+        if (mTlvs[tlv.GetType()] == nullptr)
+        {
+            mTlvs[tlv.GetType()] = &tlv;
+        }
+    }
+}
+
+bool TlvWriter::Append(uint8_t aType, const void *aValue, uint16_t aLength)
+{
+    bool     extended = (aLength >= Tlv::kLengthEscape);
+    uint32_t size     = sizeof(uint8_t) * 2 + (extended ? sizeof(uint16_t) : 0) + aLength;
+    Tlv *    tlv      = reinterpret_cast<Tlv *>(mBuffer + mLength);
+    bool     appended = false;
+
+    VerifyOrExit(size <= static_cast<uint32_t>(mSize - mLength));
+
+    tlv->SetType(aType);
+    tlv->SetValue(aValue, aLength, extended);
+    mLength  = static_cast<uint16_t>(mLength + size);
+    appended = true;
+
+exit:
+    return appended;
+}
+
+} // namespace otbr
@@ -36,6 +36,7 @@
 
 #include "openthread-br/config.h"
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -47,12 +48,12 @@ namespace otbr {
  */
 class Tlv
 {
+public:
     enum
     {
         kLengthEscape = 0xff, ///< This length value indicates the actual length is of two-bytes length.
     };
 
-public:
     /**
      * This method returns the Tlv type.
      *
@@ -206,6 +207,193 @@ private:
     uint8_t mLength;
 };
 
+/**
+ * This class implements a bounds-checked, zero-copy view of the Tlvs in a buffer.
+ *
+ * The buffer is validated once on construction. Iteration then covers the leading well-formed Tlvs, whose headers
+ * and values are all inside the buffer, without any per-step checks.
+ *
+ */
+class TlvView
+{
+public:
+    /**
+     * This class iterates the Tlvs of a view.
+     *
+     */
+    class Iterator
+    {
+    public:
+        const Tlv &operator*(void) const { return *mTlv; }
+        const Tlv *operator->(void) const { return mTlv; }
+        Iterator & operator++(void)
+        {
+            mTlv = mTlv->GetNext();
+            return *this;
+        }
+        bool operator==(const Iterator &aOther) const { return mTlv == aOther.mTlv; }
+        bool operator!=(const Iterator &aOther) const { return mTlv != aOther.mTlv; }
+
+    private:
+        friend class TlvView;
+
+        explicit Iterator(const uint8_t *aPosition)
+            : mTlv(reinterpret_cast<const Tlv *>(aPosition))
+        {
+        }
+
+        const Tlv *mTlv;
+    };
+
+    /**
+     * This constructor validates the Tlvs in a buffer.
+     *
+     * @param[in]  aBuffer          A pointer to the Tlvs.
+     * @param[in]  aLength          The length of the Tlvs in bytes.
+     * @param[in]  aAllowExtended   Whether Tlvs with an extended length are well-formed.
+     *
+     */
+    TlvView(const uint8_t *aBuffer, uint16_t aLength, bool aAllowExtended = true);
+
+    /**
+     * This method indicates whether the whole buffer consists of well-formed Tlvs.
+     *
+     * @returns Whether the buffer is valid.
+     *
+     */
+    bool IsValid(void) const { return mValidEnd == mEnd; }
+
+    /**
+     * This method returns an iterator to the first Tlv.
+     *
+     */
+    Iterator begin(void) const { return Iterator(mBuffer); }
+
+    /**
+     * This method returns an iterator past the last well-formed Tlv.
+     *
+     */
+    Iterator end(void) const { return Iterator(mValidEnd); }
+
+    /**
+     * This method finds the first Tlv of a type.
+     *
+     * @param[in]  aType  The Tlv type.
+     *
+     * @returns A pointer to the Tlv, or nullptr if there is none.
+     *
+     */
+    const Tlv *Find(uint8_t aType) const;
+
+private:
+    const uint8_t *mBuffer;
+    const uint8_t *mValidEnd;
+    const uint8_t *mEnd;
+};
+
+/**
+ * This class indexes the first Tlv of each type in a view, for repeated lookups.
+ *
+ */
+class TlvIndex
+{
+public:
+    /**
+     * This constructor indexes the well-formed Tlvs of a view.
+     *
+     * @param[in]  aView  The Tlv view, which must outlive the index.
+     *
+     */
+    explicit TlvIndex(const TlvView &aView);
+
+    /**
+     * This method finds the first Tlv of a type.
+     *
+     * @param[in]  aType  The Tlv type.
+     *
+     * @returns A pointer to the Tlv, or nullptr if there is none.
+     *
+     */
+    const Tlv *Find(uint8_t aType) const { return mTlvs[aType]; }
+
+private:
+    const Tlv *mTlvs[256];
+};
+
+/**
+ * This class appends Tlvs into a caller-provided buffer.
+ *
+ */
+class TlvWriter
+{
+public:
+    /**
+     * This constructor initializes an empty writer.
+     *
+     * @param[in]  aBuffer  A pointer to the buffer.
+     * @param[in]  aSize    The size of the buffer in bytes.
+     *
+     */
+    TlvWriter(uint8_t *aBuffer, uint16_t aSize)
+        : mBuffer(aBuffer)
+        , mSize(aSize)
+        , mLength(0)
+    {
+    }
+
+    /**
+     * This method appends a Tlv, using an extended length when @p aLength does not fit in one byte.
+     *
+     * @param[in]  aType    The Tlv type.
+     * @param[in]  aValue   A pointer to the value.
+     * @param[in]  aLength  The length of the value in bytes.
+     *
+     * @returns Whether the Tlv fitted in the buffer. Nothing is written otherwise.
+     *
+     */
+    bool Append(uint8_t aType, const void *aValue, uint16_t aLength);
+
+    /**
+     * This method appends a Tlv with a uint8_t value.
+     *
+     * @param[in]  aType    The Tlv type.
+     * @param[in]  aValue   The value.
+     *
+     * @returns Whether the Tlv fitted in the buffer. Nothing is written otherwise.
+     *
+     */
+    bool Append(uint8_t aType, uint8_t aValue) { return Append(aType, &aValue, sizeof(aValue)); }
+
+    /**
+     * This method appends a Tlv with a uint16_t value in network byte order.
+     *
+     * @param[in]  aType    The Tlv type.
+     * @param[in]  aValue   The value.
+     *
+     * @returns Whether the Tlv fitted in the buffer. Nothing is written otherwise.
+     *
+     */
+    bool Append(uint8_t aType, uint16_t aValue)
+    {
+        uint8_t value[] = {static_cast<uint8_t>(aValue >> 8), static_cast<uint8_t>(aValue & 0xff)};
+
+        return Append(aType, value, sizeof(value));
+    }
+
+    /**
+     * This method returns the length of the Tlvs written so far.
+     *
+     * @returns The length in bytes.
+     *
+     */
+    uint16_t GetLength(void) const { return mLength; }
+
+private:
+    uint8_t *mBuffer;
+    uint16_t mSize;
+    uint16_t mLength;
+};
+
 namespace Meshcop {
 
 enum
@@ -0,0 +1,68 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the static tracepoints of hot paths.
+ */
+
+#ifndef OTBR_COMMON_TRACEPOINT_HPP_
+#define OTBR_COMMON_TRACEPOINT_HPP_
+
+#include "openthread-br/config.h"
+
+/**
+ * @def OTBR_TRACEPOINT
+ *
+ * These macros define a USDT probe of the "otbr" provider, e.g. `OTBR_TRACEPOINT2(dbus__call__begin, a, b)` for
+ * usdt:otbr-agent:otbr:dbus__call__begin in bpftrace, or sdt_otbr:dbus__call__begin in perf once added with
+ * `perf probe sdt_otbr:dbus__call__begin`.
+ *
+ * A probe is a single nop while no tracer is attached, but its arguments are still evaluated, so they must be
+ * values at hand. The probes compile out, arguments included, unless OTBR_ENABLE_USDT is set.
+ *
+ */
+#if OTBR_ENABLE_USDT
+#include <sys/sdt.h>
+
+#define OTBR_TRACEPOINT0(aName) DTRACE_PROBE(otbr, aName)
+#define OTBR_TRACEPOINT1(aName, aArg1) DTRACE_PROBE1(otbr, aName, aArg1)
+#define OTBR_TRACEPOINT2(aName, aArg1, aArg2) DTRACE_PROBE2(otbr, aName, aArg1, aArg2)
+#define OTBR_TRACEPOINT3(aName, aArg1, aArg2, aArg3) DTRACE_PROBE3(otbr, aName, aArg1, aArg2, aArg3)
+#else
+#define OTBR_TRACEPOINT_NONE() \
+    do                         \
+    {                          \
+    } while (false)
+#define OTBR_TRACEPOINT0(aName) OTBR_TRACEPOINT_NONE()
+#define OTBR_TRACEPOINT1(aName, aArg1) OTBR_TRACEPOINT_NONE()
+#define OTBR_TRACEPOINT2(aName, aArg1, aArg2) OTBR_TRACEPOINT_NONE()
+#define OTBR_TRACEPOINT3(aName, aArg1, aArg2, aArg3) OTBR_TRACEPOINT_NONE()
+#endif
+
+#endif // OTBR_COMMON_TRACEPOINT_HPP_
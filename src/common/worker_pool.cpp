@@ -0,0 +1,126 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a pool of worker threads.
+ */
+
+#include "common/worker_pool.hpp"
+
+#include "common/thread_policy.hpp"
+
+namespace otbr {
+
+WorkerPool::WorkerPool(void)
+    : mStopping(false)
+{
+}
+
+WorkerPool::~WorkerPool(void)
+{
+    Stop();
+}
+
+void WorkerPool::Start(uint8_t aWorkers)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mStopping = false;
+
+    for (uint8_t i = 0; i < aWorkers; i++)
+    {
+        mWorkers.emplace_back(&WorkerPool::Run, this);
+    }
+}
+
+void WorkerPool::Stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        mStopping = true;
+        mTasks.clear();
+    }
+
+    mCondition.notify_all();
+
+    for (std::thread &worker : mWorkers)
+    {
+        worker.join();
+    }
+
+    mWorkers.clear();
+}
+
+void WorkerPool::Post(const Task &aTask)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        mTasks.push_back(aTask);
+    }
+
+    mCondition.notify_one();
+}
+
+uint32_t WorkerPool::GetQueueDepth(void) const
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    return static_cast<uint32_t>(mTasks.size());
+}
+
+void WorkerPool::Run(void)
+{
+    std::unique_lock<std::mutex> lock(mLock, std::defer_lock);
+
+    ApplyThreadPolicy(kThreadClassWorker);
+    lock.lock();
+
+    while (true)
+    {
+        Task task;
+
+        mCondition.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+
+        if (mStopping)
+        {
+            break;
+        }
+
+        task = mTasks.front();
+        mTasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+} // namespace otbr
@@ -0,0 +1,128 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a pool of worker threads.
+ */
+
+#ifndef OTBR_COMMON_WORKER_POOL_HPP_
+#define OTBR_COMMON_WORKER_POOL_HPP_
+
+#include "openthread-br/config.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class implements a pool of worker threads running posted tasks.
+ *
+ * Tasks are run in the order they were posted, but tasks may run concurrently on different workers. Results are
+ * usually handed back to the main loop through a TaskQueue.
+ *
+ */
+class WorkerPool
+{
+public:
+    typedef std::function<void(void)> Task;
+
+    /**
+     * The constructor initializes a stopped worker pool.
+     *
+     */
+    WorkerPool(void);
+
+    /**
+     * The destructor stops the worker pool.
+     *
+     */
+    ~WorkerPool(void);
+
+    /**
+     * This method starts the worker threads.
+     *
+     * @param[in]   aWorkers    The number of worker threads.
+     *
+     */
+    void Start(uint8_t aWorkers);
+
+    /**
+     * This method stops the worker threads, waiting for the running tasks and dropping the queued ones.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method indicates whether the worker threads are running.
+     *
+     * @retval true     The worker pool is running.
+     * @retval false    The worker pool is stopped.
+     *
+     */
+    bool IsRunning(void) const { return !mWorkers.empty(); }
+
+    /**
+     * This method posts a task. It may be called from any thread.
+     *
+     * @param[in]   aTask   The task to run on a worker thread.
+     *
+     */
+    void Post(const Task &aTask);
+
+    /**
+     * This method returns the number of tasks waiting for a worker.
+     *
+     * @returns The number of queued tasks.
+     *
+     */
+    uint32_t GetQueueDepth(void) const;
+
+private:
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    void Run(void);
+
+    mutable std::mutex       mLock;
+    std::condition_variable  mCondition;
+    std::deque<Task>         mTasks;
+    std::vector<std::thread> mWorkers;
+    bool                     mStopping;
+};
+
+} // namespace otbr
+
+#endif // OTBR_COMMON_WORKER_POOL_HPP_
@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "common/code_utils.hpp"
+#include "common/time.hpp"
 #include "dbus/client/client_error.hpp"
 #include "dbus/client/thread_api_dbus.hpp"
 #include "dbus/common/constants.hpp"
@@ -61,6 +62,38 @@ static ClientError NameToDeviceRole(const std::string &aRoleName, DeviceRole &aD
     return error;
 }
 
+static bool IsCacheableProperty(const std::string &aPropertyName)
+{
+    // Properties the server reports through PropertiesChanged whenever they change.
+    static const char *const kCacheableProperties[] = {
+        OTBR_DBUS_PROPERTY_DEVICE_ROLE,
+        OTBR_DBUS_PROPERTY_NETWORK_NAME,
+        OTBR_DBUS_PROPERTY_PANID,
+        OTBR_DBUS_PROPERTY_EXTPANID,
+        OTBR_DBUS_PROPERTY_CHANNEL,
+        OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX,
+        OTBR_DBUS_PROPERTY_MESH_LOCAL_EID,
+        OTBR_DBUS_PROPERTY_SUPPORTED_CHANNEL_MASK,
+        OTBR_DBUS_PROPERTY_RLOC16,
+        OTBR_DBUS_PROPERTY_EXTENDED_ADDRESS,
+        OTBR_DBUS_PROPERTY_ROUTER_ID,
+        OTBR_DBUS_PROPERTY_LEADER_DATA,
+        OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY,
+    };
+    bool cacheable = false;
+
+    for (const char *name : kCacheableProperties)
+    {
+        if (aPropertyName == name)
+        {
+            cacheable = true;
+            break;
+        }
+    }
+
+    return cacheable;
+}
+
 bool IsThreadActive(DeviceRole aRole)
 {
     bool isActive = false;
@@ -84,6 +117,10 @@ bool IsThreadActive(DeviceRole aRole)
 ThreadApiDBus::ThreadApiDBus(DBusConnection *aConnection)
     : mInterfaceName("wpan0")
     , mConnection(aConnection)
+    , mGetPropertiesSupported(true)
+    , mSetPropertiesSupported(true)
+    , mPropertyCacheEnabled(false)
+    , mMainloopAttached(false)
 {
     SubscribeDeviceRoleSignal();
 }
@@ -91,10 +128,19 @@ ThreadApiDBus::ThreadApiDBus(DBusConnection *aConnection)
 ThreadApiDBus::ThreadApiDBus(DBusConnection *aConnection, const std::string &aInterfaceName)
     : mInterfaceName(aInterfaceName)
     , mConnection(aConnection)
+    , mGetPropertiesSupported(true)
+    , mSetPropertiesSupported(true)
+    , mPropertyCacheEnabled(false)
+    , mMainloopAttached(false)
 {
     SubscribeDeviceRoleSignal();
 }
 
+ThreadApiDBus::~ThreadApiDBus(void)
+{
+    DetachMainloop();
+}
+
 ClientError ThreadApiDBus::SubscribeDeviceRoleSignal(void)
 {
     std::string matchRule = "type='signal',interface='" DBUS_INTERFACE_PROPERTIES "'";
@@ -106,6 +152,25 @@ ClientError ThreadApiDBus::SubscribeDeviceRoleSignal(void)
 
     VerifyOrExit(!dbus_error_is_set(&error), ret = ClientError::OT_ERROR_FAILED);
 
+    matchRule =
+        "type='signal',interface='" OTBR_DBUS_THREAD_INTERFACE "',member='" OTBR_DBUS_IP6_ADDRESSES_CHANGED_SIGNAL "'";
+    dbus_bus_add_match(mConnection, matchRule.c_str(), &error);
+
+    VerifyOrExit(!dbus_error_is_set(&error), ret = ClientError::OT_ERROR_FAILED);
+
+    matchRule = "type='signal',interface='" OTBR_DBUS_THREAD_INTERFACE "',member='" OTBR_DBUS_LINK_ALERTS_SIGNAL "'";
+    dbus_bus_add_match(mConnection, matchRule.c_str(), &error);
+
+    VerifyOrExit(!dbus_error_is_set(&error), ret = ClientError::OT_ERROR_FAILED);
+
+    // Tells when the server restarts, which drops the property cache.
+    matchRule = "type='signal',sender='" DBUS_SERVICE_DBUS "',interface='" DBUS_INTERFACE_DBUS
+                "',member='NameOwnerChanged',arg0='" OTBR_DBUS_SERVER_PREFIX +
+                mInterfaceName + "'";
+    dbus_bus_add_match(mConnection, matchRule.c_str(), &error);
+
+    VerifyOrExit(!dbus_error_is_set(&error), ret = ClientError::OT_ERROR_FAILED);
+
     dbus_connection_add_filter(mConnection, sDBusMessageFilter, this, nullptr);
 exit:
     dbus_error_free(&error);
@@ -125,41 +190,156 @@ DBusHandlerResult ThreadApiDBus::DBusMessageFilter(DBusConnection *aConnection,
 {
     (void)aConnection;
 
-    DBusMessageIter iter, subIter, dictEntryIter, valIter;
-    std::string     interfaceName, propertyName, val;
-    DeviceRole      role = OTBR_DEVICE_ROLE_DISABLED;
+    DBusMessageIter              iter, subIter, dictEntryIter;
+    std::string                  interfaceName, propertyName, val;
+    std::vector<std::string>     changedProperties, invalidatedProperties;
+    std::shared_ptr<DBusMessage> message;
+    DeviceRole                   role = OTBR_DEVICE_ROLE_DISABLED;
+
+    if (dbus_message_is_signal(aMessage, DBUS_INTERFACE_DBUS, "NameOwnerChanged"))
+    {
+        InvalidatePropertyCache();
+        ExitNow();
+    }
+
+    if (dbus_message_is_signal(aMessage, OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_IP6_ADDRESSES_CHANGED_SIGNAL))
+    {
+        Ip6AddressesChange change;
+        auto               args = std::tie(change.mUpdatedUnicast, change.mRemovedUnicast, change.mSubscribedMulticast,
+                                           change.mUnsubscribedMulticast);
+
+        VerifyOrExit(dbus_message_has_path(aMessage, (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str()));
+        SuccessOrExit(DBusMessageToTuple(*aMessage, args));
+
+        for (const auto &f : mIp6AddressesHandlers)
+        {
+            f(change);
+        }
+        ExitNow();
+    }
+
+    if (dbus_message_is_signal(aMessage, OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_LINK_ALERTS_SIGNAL))
+    {
+        std::vector<LinkAlert> alerts;
+        auto                   args = std::tie(alerts);
+
+        VerifyOrExit(dbus_message_has_path(aMessage, (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str()));
+        SuccessOrExit(DBusMessageToTuple(*aMessage, args));
+
+        for (const auto &f : mLinkAlertsHandlers)
+        {
+            f(alerts);
+        }
+        ExitNow();
+    }
 
     VerifyOrExit(dbus_message_is_signal(aMessage, DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTIES_CHANGED_SIGNAL));
+    VerifyOrExit(dbus_message_has_path(aMessage, (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str()));
     VerifyOrExit(dbus_message_iter_init(aMessage, &iter));
     SuccessOrExit(DBusMessageExtract(&iter, interfaceName));
     VerifyOrExit(interfaceName == OTBR_DBUS_THREAD_INTERFACE);
 
     VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY);
     dbus_message_iter_recurse(&iter, &subIter);
-    VerifyOrExit(dbus_message_iter_get_arg_type(&subIter) == DBUS_TYPE_DICT_ENTRY);
-    dbus_message_iter_recurse(&subIter, &dictEntryIter);
-    SuccessOrExit(DBusMessageExtract(&dictEntryIter, propertyName));
-    VerifyOrExit(dbus_message_iter_get_arg_type(&dictEntryIter) == DBUS_TYPE_VARIANT);
-    dbus_message_iter_recurse(&dictEntryIter, &valIter);
-    SuccessOrExit(DBusMessageExtract(&valIter, val));
 
-    VerifyOrExit(propertyName == OTBR_DBUS_PROPERTY_DEVICE_ROLE);
-    SuccessOrExit(NameToDeviceRole(val, role));
+    // A signal may carry several changed properties.
+    for (; dbus_message_iter_get_arg_type(&subIter) == DBUS_TYPE_DICT_ENTRY; dbus_message_iter_next(&subIter))
+    {
+        dbus_message_iter_recurse(&subIter, &dictEntryIter);
+        SuccessOrExit(DBusMessageExtract(&dictEntryIter, propertyName));
+        changedProperties.push_back(propertyName);
 
-    for (const auto &f : mDeviceRoleHandlers)
+        if (mPropertyCacheEnabled && IsCacheableProperty(propertyName))
+        {
+            if (message == nullptr)
+            {
+                message = std::shared_ptr<DBusMessage>(dbus_message_ref(aMessage), dbus_message_unref);
+            }
+            CacheProperty(propertyName, message, dictEntryIter);
+        }
+
+        if (propertyName == OTBR_DBUS_PROPERTY_DEVICE_ROLE &&
+            DBusMessageExtractFromVariant(&dictEntryIter, val) == OTBR_ERROR_NONE &&
+            NameToDeviceRole(val, role) == ClientError::ERROR_NONE)
+        {
+            for (const auto &f : mDeviceRoleHandlers)
+            {
+                f(role);
+            }
+        }
+    }
+
+    dbus_message_iter_next(&iter);
+    SuccessOrExit(DBusMessageExtract(&iter, invalidatedProperties));
+    for (const auto &name : invalidatedProperties)
+    {
+        mPropertyCache.erase(name);
+    }
+
+    changedProperties.insert(changedProperties.end(), invalidatedProperties.begin(), invalidatedProperties.end());
+    for (const auto &f : mPropertiesChangedHandlers)
     {
-        f(role);
+        f(changedProperties);
     }
 
 exit:
     return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 }
 
+void ThreadApiDBus::SetPropertyCacheEnabled(bool aEnabled)
+{
+    mPropertyCacheEnabled = aEnabled;
+    InvalidatePropertyCache();
+}
+
+void ThreadApiDBus::InvalidatePropertyCache(void)
+{
+    mPropertyCache.clear();
+}
+
+bool ThreadApiDBus::GetCachedProperty(const std::string &aPropertyName, DBusMessageIter &aValue) const
+{
+    auto it    = mPropertyCache.find(aPropertyName);
+    bool found = (it != mPropertyCache.end());
+
+    if (found)
+    {
+        aValue = it->second.mValue;
+    }
+
+    return found;
+}
+
+void ThreadApiDBus::CacheProperty(const std::string &                 aPropertyName,
+                                  const std::shared_ptr<DBusMessage> &aMessage,
+                                  const DBusMessageIter &             aValue)
+{
+    CachedProperty &property = mPropertyCache[aPropertyName];
+
+    property.mMessage = aMessage;
+    property.mValue   = aValue;
+}
+
 void ThreadApiDBus::AddDeviceRoleHandler(const DeviceRoleHandler &aHandler)
 {
     mDeviceRoleHandlers.push_back(aHandler);
 }
 
+void ThreadApiDBus::AddIp6AddressesHandler(const Ip6AddressesHandler &aHandler)
+{
+    mIp6AddressesHandlers.push_back(aHandler);
+}
+
+void ThreadApiDBus::AddLinkAlertsHandler(const LinkAlertsHandler &aHandler)
+{
+    mLinkAlertsHandlers.push_back(aHandler);
+}
+
+void ThreadApiDBus::AddPropertiesChangedHandler(const PropertiesChangedHandler &aHandler)
+{
+    mPropertiesChangedHandlers.push_back(aHandler);
+}
+
 ClientError ThreadApiDBus::Scan(const ScanHandler &aHandler)
 {
     ClientError error = ClientError::ERROR_NONE;
@@ -234,6 +414,8 @@ void ThreadApiDBus::AttachPendingCallHandler(DBusPendingCall *aPending)
     UniqueDBusMessage message(dbus_pending_call_steal_reply(aPending));
     auto              handler = mAttachHandler;
 
+    InvalidatePropertyCache();
+
     if (message != nullptr)
     {
         ret = CheckErrorMessage(message.get());
@@ -273,6 +455,8 @@ void ThreadApiDBus::FactoryResetPendingCallHandler(DBusPendingCall *aPending)
     ClientError       ret = ClientError::OT_ERROR_FAILED;
     UniqueDBusMessage message(dbus_pending_call_steal_reply(aPending));
 
+    InvalidatePropertyCache();
+
     if (message != nullptr)
     {
         ret = CheckErrorMessage(message.get());
@@ -325,6 +509,8 @@ void ThreadApiDBus::JoinerStartPendingCallHandler(DBusPendingCall *aPending)
     UniqueDBusMessage message(dbus_pending_call_steal_reply(aPending));
     auto              handler = mJoinerHandler;
 
+    InvalidatePropertyCache();
+
     if (message != nullptr)
     {
         ret = CheckErrorMessage(message.get());
@@ -339,6 +525,16 @@ ClientError ThreadApiDBus::JoinerStop(void)
     return CallDBusMethodSync(OTBR_DBUS_JOINER_STOP_METHOD);
 }
 
+ClientError ThreadApiDBus::AddJoiners(const std::vector<JoinerInfo> &aJoiners)
+{
+    return CallDBusMethodSync(OTBR_DBUS_ADD_JOINERS_METHOD, std::tie(aJoiners));
+}
+
+ClientError ThreadApiDBus::RemoveJoiners(const std::vector<uint64_t> &aEui64s)
+{
+    return CallDBusMethodSync(OTBR_DBUS_REMOVE_JOINERS_METHOD, std::tie(aEui64s));
+}
+
 ClientError ThreadApiDBus::AddOnMeshPrefix(const OnMeshPrefix &aPrefix)
 {
     return CallDBusMethodSync(OTBR_DBUS_ADD_ON_MESH_PREFIX_METHOD, std::tie(aPrefix));
@@ -359,6 +555,15 @@ ClientError ThreadApiDBus::RemoveExternalRoute(const Ip6Prefix &aPrefix)
     return CallDBusMethodSync(OTBR_DBUS_REMOVE_EXTERNAL_ROUTE_METHOD, std::tie(aPrefix));
 }
 
+ClientError ThreadApiDBus::UpdateBorderRouterConfig(const std::vector<OnMeshPrefix> & aAddedPrefixes,
+                                                    const std::vector<Ip6Prefix> &    aRemovedPrefixes,
+                                                    const std::vector<ExternalRoute> &aAddedRoutes,
+                                                    const std::vector<Ip6Prefix> &    aRemovedRoutes)
+{
+    return CallDBusMethodSync(OTBR_DBUS_UPDATE_BORDER_ROUTER_CONFIG_METHOD,
+                              std::tie(aAddedPrefixes, aRemovedPrefixes, aAddedRoutes, aRemovedRoutes));
+}
+
 ClientError ThreadApiDBus::SetMeshLocalPrefix(const std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> &aPrefix)
 {
     return SetProperty(OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX, aPrefix);
@@ -465,6 +670,11 @@ ClientError ThreadApiDBus::GetStableNetworkData(std::vector<uint8_t> &aNetworkDa
     return GetProperty(OTBR_DBUS_PROPERTY_STABLE_NETWORK_DATA_PRPOERTY, aNetworkData);
 }
 
+ClientError ThreadApiDBus::GetNetworkDataInfo(NetworkDataInfo &aNetworkData)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_NETWORK_DATA_INFO, aNetworkData);
+}
+
 ClientError ThreadApiDBus::GetLocalLeaderWeight(uint8_t &aWeight)
 {
     return GetProperty(OTBR_DBUS_PROPERTY_LOCAL_LEADER_WEIGHT, aWeight);
@@ -480,6 +690,11 @@ ClientError ThreadApiDBus::GetChannelMonitorAllChannelQualities(std::vector<Chan
     return GetProperty(OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_ALL_CHANNEL_QUALITIES, aChannelQualities);
 }
 
+ClientError ThreadApiDBus::GetChannelQualityScores(std::vector<ChannelQuality> &aScores)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_CHANNEL_QUALITY_SCORES, aScores);
+}
+
 ClientError ThreadApiDBus::GetChildTable(std::vector<ChildInfo> &aChildTable)
 {
     return GetProperty(OTBR_DBUS_PROPERTY_CHILD_TABLE, aChildTable);
@@ -490,6 +705,64 @@ ClientError ThreadApiDBus::GetNeighborTable(std::vector<NeighborInfo> &aNeighbor
     return GetProperty(OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY, aNeighborTable);
 }
 
+ClientError ThreadApiDBus::GetChildTableDelta(uint32_t aSinceVersion, TableDelta<ChildInfo> &aDelta)
+{
+    auto reply = std::tie(aDelta.mReset, aDelta.mUpdated, aDelta.mRemoved, aDelta.mVersion);
+
+    return CallDBusMethodSync(OTBR_DBUS_GET_CHILD_TABLE_DELTA_METHOD, std::tie(aSinceVersion), reply);
+}
+
+ClientError ThreadApiDBus::GetNeighborTableDelta(uint32_t aSinceVersion, TableDelta<NeighborInfo> &aDelta)
+{
+    auto reply = std::tie(aDelta.mReset, aDelta.mUpdated, aDelta.mRemoved, aDelta.mVersion);
+
+    return CallDBusMethodSync(OTBR_DBUS_GET_NEIGHBOR_TABLE_DELTA_METHOD, std::tie(aSinceVersion), reply);
+}
+
+ClientError ThreadApiDBus::QueryChildTable(const TableQuery &      aQuery,
+                                           std::vector<ChildInfo> &aChildren,
+                                           uint32_t &              aMatched)
+{
+    auto reply = std::tie(aChildren, aMatched);
+
+    return CallDBusMethodSync(OTBR_DBUS_QUERY_CHILD_TABLE_METHOD, std::tie(aQuery), reply);
+}
+
+ClientError ThreadApiDBus::QueryNeighborTable(const TableQuery &         aQuery,
+                                              std::vector<NeighborInfo> &aNeighbors,
+                                              uint32_t &                 aMatched)
+{
+    auto reply = std::tie(aNeighbors, aMatched);
+
+    return CallDBusMethodSync(OTBR_DBUS_QUERY_NEIGHBOR_TABLE_METHOD, std::tie(aQuery), reply);
+}
+
+ClientError ThreadApiDBus::GetCounterRates(uint32_t aWindow, std::vector<CounterRates> &aRates)
+{
+    auto reply = std::tie(aRates);
+
+    return CallDBusMethodSync(OTBR_DBUS_GET_COUNTER_RATES_METHOD, std::tie(aWindow), reply);
+}
+
+ClientError ThreadApiDBus::GetTopology(uint32_t aMaxAge, std::vector<TopologyNode> &aNodes)
+{
+    auto reply = std::tie(aNodes);
+
+    return CallDBusMethodSync(OTBR_DBUS_GET_TOPOLOGY_METHOD, std::tie(aMaxAge), reply);
+}
+
+ClientError ThreadApiDBus::AddLinkAlertRule(const LinkAlertRule &aRule, uint32_t &aId)
+{
+    auto reply = std::tie(aId);
+
+    return CallDBusMethodSync(OTBR_DBUS_ADD_LINK_ALERT_RULE_METHOD, std::tie(aRule), reply);
+}
+
+ClientError ThreadApiDBus::RemoveLinkAlertRule(uint32_t aId)
+{
+    return CallDBusMethodSync(OTBR_DBUS_REMOVE_LINK_ALERT_RULE_METHOD, std::tie(aId));
+}
+
 ClientError ThreadApiDBus::GetPartitionId(uint32_t &aPartitionId)
 {
     return GetProperty(OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY, aPartitionId);
@@ -510,11 +783,606 @@ ClientError ThreadApiDBus::GetExternalRoutes(std::vector<ExternalRoute> &aExtern
     return GetProperty(OTBR_DBUS_PROPERTY_EXTERNAL_ROUTES, aExternalRoutes);
 }
 
+ClientError ThreadApiDBus::GetMainloopCounters(MainloopCounters &aCounters)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MAINLOOP_COUNTERS, aCounters);
+}
+
+ClientError ThreadApiDBus::GetMainloopHistograms(std::vector<MainloopHistogram> &aHistograms)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MAINLOOP_HISTOGRAMS, aHistograms);
+}
+
+ClientError ThreadApiDBus::GetMemoryUsage(std::vector<MemoryUsage> &aUsages)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MEMORY_USAGE, aUsages);
+}
+
+ClientError ThreadApiDBus::GetDBusQueueCounters(DBusQueueCounters &aCounters)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_DBUS_QUEUE_COUNTERS, aCounters);
+}
+
+ClientError ThreadApiDBus::GetOperationQueueCounters(OperationQueueCounters &aCounters)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_OPERATION_QUEUE_COUNTERS, aCounters);
+}
+
+ClientError ThreadApiDBus::GetJoinerCounters(JoinerCounters &aCounters)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_JOINER_COUNTERS, aCounters);
+}
+
+ClientError ThreadApiDBus::SetActiveDatasetTlvs(const std::vector<uint8_t> &aTlvs)
+{
+    return SetProperty(OTBR_DBUS_PROPERTY_ACTIVE_DATASET_TLVS, aTlvs);
+}
+
+ClientError ThreadApiDBus::SetPendingDatasetTlvs(const std::vector<uint8_t> &aTlvs)
+{
+    return SetProperty(OTBR_DBUS_PROPERTY_PENDING_DATASET_TLVS, aTlvs);
+}
+
+ClientError ThreadApiDBus::GetActiveDatasetTlvs(std::vector<uint8_t> &aTlvs)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_ACTIVE_DATASET_TLVS, aTlvs);
+}
+
+ClientError ThreadApiDBus::GetPendingDatasetTlvs(std::vector<uint8_t> &aTlvs)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_PENDING_DATASET_TLVS, aTlvs);
+}
+
+ClientError ThreadApiDBus::GetActiveDataset(OperationalDataset &aDataset)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_ACTIVE_DATASET, aDataset);
+}
+
+ClientError ThreadApiDBus::GetPendingDataset(OperationalDataset &aDataset)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_PENDING_DATASET, aDataset);
+}
+
+ClientError ThreadApiDBus::GetUnicastAddresses(std::vector<Ip6AddressInfo> &aAddresses)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES, aAddresses);
+}
+
+ClientError ThreadApiDBus::GetMulticastAddresses(std::vector<std::vector<uint8_t>> &aAddresses)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MULTICAST_ADDRESSES, aAddresses);
+}
+
+ClientError ThreadApiDBus::GetAddressCache(std::vector<AddressCacheEntry> &aEntries)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_ADDRESS_CACHE, aEntries);
+}
+
+ClientError ThreadApiDBus::GetAddressCacheCounters(AddressCacheCounters &aCounters)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_ADDRESS_CACHE_COUNTERS, aCounters);
+}
+
+ClientError ThreadApiDBus::GetMeshLocalPrefix(std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> &aPrefix)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX, aPrefix);
+}
+
+ClientError ThreadApiDBus::GetMeshLocalEid(std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> &aAddress)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_MESH_LOCAL_EID, aAddress);
+}
+
+ClientError ThreadApiDBus::GetEui64(uint64_t &aEui64)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_EUI64, aEui64);
+}
+
+ClientError ThreadApiDBus::GetOtHostVersion(std::string &aVersion)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_OT_HOST_VERSION, aVersion);
+}
+
+ClientError ThreadApiDBus::SetLogLevels(const std::vector<LogLevel> &aLevels)
+{
+    return SetProperty(OTBR_DBUS_PROPERTY_LOG_LEVELS, aLevels);
+}
+
+ClientError ThreadApiDBus::GetLogLevels(std::vector<LogLevel> &aLevels)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_LOG_LEVELS, aLevels);
+}
+
+ClientError ThreadApiDBus::SetLinkAlertInterval(uint32_t aInterval)
+{
+    return SetProperty(OTBR_DBUS_PROPERTY_LINK_ALERT_INTERVAL, aInterval);
+}
+
+ClientError ThreadApiDBus::GetLinkAlertRules(std::vector<LinkAlertRule> &aRules)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_LINK_ALERT_RULES, aRules);
+}
+
+ClientError ThreadApiDBus::GetRaisedLinkAlerts(std::vector<LinkAlert> &aAlerts)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_RAISED_LINK_ALERTS, aAlerts);
+}
+
+ClientError ThreadApiDBus::GetFlightRecords(std::vector<FlightRecord> &aRecords)
+{
+    return GetProperty(OTBR_DBUS_PROPERTY_FLIGHT_RECORDS, aRecords);
+}
+
 std::string ThreadApiDBus::GetInterfaceName(void)
 {
     return mInterfaceName;
 }
 
+ClientError ThreadApiDBus::AttachMainloop(void)
+{
+    ClientError error = ClientError::ERROR_NONE;
+
+    VerifyOrExit(!mMainloopAttached);
+    mMainloopAttached = true;
+
+    // libdbus calls the add functions for the watches and timeouts the connection already has.
+    VerifyOrExit(dbus_connection_set_watch_functions(mConnection, sAddWatch, sRemoveWatch, sToggleWatch, this,
+                                                     nullptr) &&
+                     dbus_connection_set_timeout_functions(mConnection, sAddTimeout, sRemoveTimeout, sToggleTimeout,
+                                                           this, nullptr),
+                 error = ClientError::ERROR_DBUS);
+
+exit:
+    if (error != ClientError::ERROR_NONE)
+    {
+        DetachMainloop();
+    }
+    return error;
+}
+
+void ThreadApiDBus::DetachMainloop(void)
+{
+    VerifyOrExit(mMainloopAttached);
+
+    dbus_connection_set_watch_functions(mConnection, nullptr, nullptr, nullptr, nullptr, nullptr);
+    dbus_connection_set_timeout_functions(mConnection, nullptr, nullptr, nullptr, nullptr, nullptr);
+    mWatches.clear();
+    mTimeouts.clear();
+    mMainloopAttached = false;
+
+exit:
+    return;
+}
+
+dbus_bool_t ThreadApiDBus::sAddWatch(DBusWatch *aWatch, void *aThreadApiDBus)
+{
+    static_cast<ThreadApiDBus *>(aThreadApiDBus)->mWatches[aWatch] = (dbus_watch_get_enabled(aWatch) ? true : false);
+    return TRUE;
+}
+
+void ThreadApiDBus::sRemoveWatch(DBusWatch *aWatch, void *aThreadApiDBus)
+{
+    static_cast<ThreadApiDBus *>(aThreadApiDBus)->mWatches.erase(aWatch);
+}
+
+void ThreadApiDBus::sToggleWatch(DBusWatch *aWatch, void *aThreadApiDBus)
+{
+    static_cast<ThreadApiDBus *>(aThreadApiDBus)->mWatches[aWatch] = (dbus_watch_get_enabled(aWatch) ? true : false);
+}
+
+dbus_bool_t ThreadApiDBus::sAddTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus)
+{
+    sToggleTimeout(aTimeout, aThreadApiDBus);
+    return TRUE;
+}
+
+void ThreadApiDBus::sRemoveTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus)
+{
+    static_cast<ThreadApiDBus *>(aThreadApiDBus)->mTimeouts.erase(aTimeout);
+}
+
+void ThreadApiDBus::sToggleTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus)
+{
+    ThreadApiDBus *threadApi = static_cast<ThreadApiDBus *>(aThreadApiDBus);
+
+    // A timeout restarts its interval when it is enabled again.
+    if (dbus_timeout_get_enabled(aTimeout))
+    {
+        threadApi->mTimeouts[aTimeout] = GetNow() + static_cast<unsigned long>(dbus_timeout_get_interval(aTimeout));
+    }
+    else
+    {
+        threadApi->mTimeouts.erase(aTimeout);
+    }
+}
+
+void ThreadApiDBus::UpdateFdSet(fd_set &        aReadFdSet,
+                                fd_set &        aWriteFdSet,
+                                fd_set &        aErrorFdSet,
+                                int &           aMaxFd,
+                                struct timeval &aTimeOut)
+{
+    unsigned long now = GetNow();
+
+    VerifyOrExit(mMainloopAttached);
+
+    if (dbus_connection_get_dispatch_status(mConnection) == DBUS_DISPATCH_DATA_REMAINS)
+    {
+        aTimeOut = {0, 0};
+    }
+
+    for (const auto &p : mWatches)
+    {
+        unsigned int flags = dbus_watch_get_flags(p.first);
+        int          fd    = dbus_watch_get_unix_fd(p.first);
+
+        if (!p.second || fd < 0)
+        {
+            continue;
+        }
+
+        if (flags & DBUS_WATCH_READABLE)
+        {
+            FD_SET(fd, &aReadFdSet);
+        }
+
+        if ((flags & DBUS_WATCH_WRITABLE) && dbus_connection_has_messages_to_send(mConnection))
+        {
+            FD_SET(fd, &aWriteFdSet);
+        }
+
+        FD_SET(fd, &aErrorFdSet);
+
+        if (fd > aMaxFd)
+        {
+            aMaxFd = fd;
+        }
+    }
+
+    for (const auto &p : mTimeouts)
+    {
+        unsigned long remaining = (p.second > now) ? p.second - now : 0;
+
+        if (remaining < GetTimestamp(aTimeOut))
+        {
+            aTimeOut.tv_sec  = static_cast<time_t>(remaining / 1000);
+            aTimeOut.tv_usec = static_cast<suseconds_t>((remaining % 1000) * 1000);
+        }
+    }
+
+exit:
+    return;
+}
+
+void ThreadApiDBus::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+{
+    std::map<DBusWatch *, bool>            watches;
+    std::map<DBusTimeout *, unsigned long> timeouts;
+    unsigned long                          now = GetNow();
+
+    VerifyOrExit(mMainloopAttached);
+
+    // Handling a watch or a timeout may remove others, e.g. a pending call's timeout once its reply is read.
+    watches = mWatches;
+    for (const auto &p : watches)
+    {
+        unsigned int flags = dbus_watch_get_flags(p.first);
+        int          fd    = dbus_watch_get_unix_fd(p.first);
+
+        if (!p.second || fd < 0 || mWatches.find(p.first) == mWatches.end())
+        {
+            continue;
+        }
+
+        if ((flags & DBUS_WATCH_READABLE) && !FD_ISSET(fd, &aReadFdSet))
+        {
+            flags &= static_cast<unsigned int>(~DBUS_WATCH_READABLE);
+        }
+
+        if ((flags & DBUS_WATCH_WRITABLE) && !FD_ISSET(fd, &aWriteFdSet))
+        {
+            flags &= static_cast<unsigned int>(~DBUS_WATCH_WRITABLE);
+        }
+
+        if (FD_ISSET(fd, &aErrorFdSet))
+        {
+            flags |= DBUS_WATCH_ERROR;
+        }
+
+        if (flags != 0)
+        {
+            dbus_watch_handle(p.first, flags);
+        }
+    }
+
+    timeouts = mTimeouts;
+    for (const auto &p : timeouts)
+    {
+        auto it = mTimeouts.find(p.first);
+
+        if (it == mTimeouts.end() || it->second > now)
+        {
+            continue;
+        }
+
+        // The timeout fires again after another interval unless it is removed or disabled.
+        it->second = now + static_cast<unsigned long>(dbus_timeout_get_interval(p.first));
+        dbus_timeout_handle(p.first);
+    }
+
+    while (dbus_connection_dispatch(mConnection) == DBUS_DISPATCH_DATA_REMAINS)
+    {
+    }
+
+exit:
+    return;
+}
+
+ClientError ThreadApiDBus::GetProperties(const std::vector<std::string> &aPropertyNames, PropertyValues &aValues)
+{
+    ClientError       ret     = ClientError::ERROR_NONE;
+    UniqueDBusMessage message = NewGetPropertiesMessage(aPropertyNames);
+    UniqueDBusMessage reply   = nullptr;
+    DBusError         error;
+
+    dbus_error_init(&error);
+    VerifyOrExit(message != nullptr, ret = ClientError::ERROR_DBUS);
+    reply = UniqueDBusMessage(
+        dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
+
+    if (mGetPropertiesSupported && dbus_error_has_name(&error, DBUS_ERROR_UNKNOWN_METHOD))
+    {
+        mGetPropertiesSupported = false;
+        dbus_error_free(&error);
+
+        message = NewGetPropertiesMessage(aPropertyNames);
+        VerifyOrExit(message != nullptr, ret = ClientError::ERROR_DBUS);
+        reply = UniqueDBusMessage(
+            dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
+    }
+
+    VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::ERROR_DBUS);
+    ret = DBus::CheckErrorMessage(reply.get());
+    VerifyOrExit(ret == ClientError::ERROR_NONE);
+    ret = aValues.Parse(std::move(reply));
+exit:
+    dbus_error_free(&error);
+    return ret;
+}
+
+ClientError ThreadApiDBus::GetPropertiesAsync(const std::vector<std::string> &aPropertyNames,
+                                              const PropertiesHandler &       aHandler)
+{
+    bool useGetProperties = mGetPropertiesSupported;
+
+    auto handler = [this, useGetProperties, aPropertyNames, aHandler](ClientError aError, DBusMessage *aReply) {
+        PropertyValues values;
+        bool           retried = false;
+
+        if (useGetProperties && aReply != nullptr && dbus_message_is_error(aReply, DBUS_ERROR_UNKNOWN_METHOD))
+        {
+            mGetPropertiesSupported = false;
+            retried                 = (GetPropertiesAsync(aPropertyNames, aHandler) == ClientError::ERROR_NONE);
+        }
+        else if (aError == ClientError::ERROR_NONE)
+        {
+            aError = values.Parse(UniqueDBusMessage(dbus_message_ref(aReply)));
+        }
+
+        if (!retried)
+        {
+            aHandler(aError, values);
+        }
+    };
+
+    return SendAsync(NewGetPropertiesMessage(aPropertyNames), handler);
+}
+
+ClientError ThreadApiDBus::SetProperties(const PropertyUpdates &              aUpdates,
+                                         std::map<std::string, ClientError> &aResults)
+{
+    ClientError       ret = ClientError::ERROR_NONE;
+    UniqueDBusMessage message(dbus_message_new_method_call(
+        (OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(), (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
+        OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_SET_PROPERTIES_METHOD));
+    UniqueDBusMessage reply = nullptr;
+    DBusMessageIter   iter, subIter, entryIter;
+    DBusError         error;
+
+    dbus_error_init(&error);
+    aResults.clear();
+    VerifyOrExit(mSetPropertiesSupported, ret = ClientError::ERROR_DBUS);
+    VerifyOrExit(message != nullptr, ret = ClientError::ERROR_DBUS);
+
+    dbus_message_iter_init_append(message.get(), &iter);
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
+                                                  "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_VARIANT_AS_STRING "}",
+                                                  &subIter),
+                 ret = ClientError::ERROR_DBUS);
+    for (const auto &value : aUpdates.mValues)
+    {
+        const char *name = value.first.c_str();
+
+        VerifyOrExit(dbus_message_iter_open_container(&subIter, DBUS_TYPE_DICT_ENTRY, nullptr, &entryIter),
+                     ret = ClientError::ERROR_DBUS);
+        VerifyOrExit(dbus_message_iter_append_basic(&entryIter, DBUS_TYPE_STRING, &name),
+                     ret = ClientError::ERROR_DBUS);
+        VerifyOrExit(value.second(entryIter) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
+        VerifyOrExit(dbus_message_iter_close_container(&subIter, &entryIter), ret = ClientError::ERROR_DBUS);
+    }
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter), ret = ClientError::ERROR_DBUS);
+
+    reply = UniqueDBusMessage(
+        dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
+    if (dbus_error_has_name(&error, DBUS_ERROR_UNKNOWN_METHOD))
+    {
+        mSetPropertiesSupported = false;
+    }
+    VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::ERROR_DBUS);
+    SuccessOrExit(ret = DBus::CheckErrorMessage(reply.get()));
+
+    ret = ClientError::ERROR_DBUS;
+    VerifyOrExit(dbus_message_iter_init(reply.get(), &iter) &&
+                 dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY);
+    dbus_message_iter_recurse(&iter, &subIter);
+    while (dbus_message_iter_get_arg_type(&subIter) == DBUS_TYPE_DICT_ENTRY)
+    {
+        std::string name;
+        int32_t     result;
+
+        dbus_message_iter_recurse(&subIter, &entryIter);
+        VerifyOrExit(DBusMessageExtract(&entryIter, name) == OTBR_ERROR_NONE);
+        VerifyOrExit(DBusMessageExtract(&entryIter, result) == OTBR_ERROR_NONE);
+        aResults[name] = static_cast<ClientError>(result);
+        dbus_message_iter_next(&subIter);
+    }
+    ret = ClientError::ERROR_NONE;
+
+    for (const auto &value : aUpdates.mValues)
+    {
+        if (aResults[value.first] != ClientError::ERROR_NONE)
+        {
+            ExitNow(ret = aResults[value.first]);
+        }
+    }
+
+exit:
+    dbus_error_free(&error);
+    InvalidatePropertyCache();
+
+    // The server predates SetProperties, fall back to setting the properties one by one.
+    if (!mSetPropertiesSupported && aResults.empty())
+    {
+        ret = ClientError::ERROR_NONE;
+        for (const auto &value : aUpdates.mValues)
+        {
+            ClientError result = SetPropertyValue(value.first, value.second);
+
+            aResults[value.first] = result;
+            if (ret == ClientError::ERROR_NONE)
+            {
+                ret = result;
+            }
+        }
+    }
+
+    return ret;
+}
+
+UniqueDBusMessage ThreadApiDBus::NewPropertyGetMessage(const std::string &aPropertyName)
+{
+    UniqueDBusMessage message(dbus_message_new_method_call((OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(),
+                                                           (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
+                                                           DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_METHOD));
+
+    if (message != nullptr &&
+        TupleToDBusMessage(*message, std::tie(OTBR_DBUS_THREAD_INTERFACE, aPropertyName)) != OTBR_ERROR_NONE)
+    {
+        message = nullptr;
+    }
+
+    return message;
+}
+
+UniqueDBusMessage ThreadApiDBus::NewGetPropertiesMessage(const std::vector<std::string> &aPropertyNames)
+{
+    UniqueDBusMessage message(nullptr);
+    otbrError         error = OTBR_ERROR_NONE;
+
+    if (mGetPropertiesSupported)
+    {
+        message = UniqueDBusMessage(dbus_message_new_method_call(
+            (OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(), (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
+            OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_PROPERTIES_METHOD));
+        VerifyOrExit(message != nullptr);
+        error = TupleToDBusMessage(*message, std::tie(aPropertyNames));
+    }
+    else
+    {
+        // The server predates GetProperties, GetAll returns a superset of the requested properties.
+        message = UniqueDBusMessage(dbus_message_new_method_call(
+            (OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(), (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
+            DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_ALL_METHOD));
+        VerifyOrExit(message != nullptr);
+        error = TupleToDBusMessage(*message, std::tie(OTBR_DBUS_THREAD_INTERFACE));
+    }
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        message = nullptr;
+    }
+
+exit:
+    return message;
+}
+
+ClientError ThreadApiDBus::SendAsync(UniqueDBusMessage aMessage, const ReplyHandler &aHandler)
+{
+    ClientError      ret     = ClientError::ERROR_NONE;
+    DBusPendingCall *pending = nullptr;
+    ReplyHandler *   handler = nullptr;
+
+    VerifyOrExit(aMessage != nullptr, ret = ClientError::ERROR_DBUS);
+    VerifyOrExit(dbus_connection_send_with_reply(mConnection, aMessage.get(), &pending, DBUS_TIMEOUT_USE_DEFAULT) &&
+                     pending != nullptr,
+                 ret = ClientError::ERROR_DBUS);
+
+    handler = new ReplyHandler(aHandler);
+    if (!dbus_pending_call_set_notify(pending, sHandleAsyncReply, handler, sFreeReplyHandler))
+    {
+        delete handler;
+        dbus_pending_call_cancel(pending);
+        ret = ClientError::ERROR_DBUS;
+    }
+
+exit:
+    if (pending != nullptr)
+    {
+        // The connection keeps its own reference until the reply is handled.
+        dbus_pending_call_unref(pending);
+    }
+    return ret;
+}
+
+void ThreadApiDBus::sHandleAsyncReply(DBusPendingCall *aPending, void *aHandler)
+{
+    UniqueDBusMessage reply(dbus_pending_call_steal_reply(aPending));
+    ClientError       error = (reply != nullptr) ? CheckErrorMessage(reply.get()) : ClientError::ERROR_DBUS;
+
+    (*static_cast<ReplyHandler *>(aHandler))(error, reply.get());
+}
+
+ClientError PropertyValues::Parse(UniqueDBusMessage aReply)
+{
+    ClientError     error = ClientError::ERROR_DBUS;
+    DBusMessageIter iter;
+    DBusMessageIter subIter;
+
+    mValues.clear();
+    mReply = std::move(aReply);
+
+    VerifyOrExit(mReply != nullptr && dbus_message_iter_init(mReply.get(), &iter));
+    VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY);
+    dbus_message_iter_recurse(&iter, &subIter);
+
+    while (dbus_message_iter_get_arg_type(&subIter) == DBUS_TYPE_DICT_ENTRY)
+    {
+        DBusMessageIter entryIter;
+        std::string     name;
+
+        dbus_message_iter_recurse(&subIter, &entryIter);
+        VerifyOrExit(DBusMessageExtract(&entryIter, name) == OTBR_ERROR_NONE);
+        // The iterator now points at the variant value, which stays valid as long as mReply.
+        mValues[name] = entryIter;
+        dbus_message_iter_next(&subIter);
+    }
+
+    error = ClientError::ERROR_NONE;
+
+exit:
+    return error;
+}
+
 ClientError ThreadApiDBus::CallDBusMethodSync(const std::string &aMethodName)
 {
     ClientError       ret = ClientError::ERROR_NONE;
@@ -531,6 +1399,7 @@ ClientError ThreadApiDBus::CallDBusMethodSync(const std::string &aMethodName)
     VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::ERROR_DBUS);
     ret = DBus::CheckErrorMessage(reply.get());
 exit:
+    InvalidatePropertyCache();
     dbus_error_free(&error);
     return ret;
 }
@@ -551,6 +1420,7 @@ ClientError ThreadApiDBus::CallDBusMethodAsync(const std::string &aMethodName, D
     VerifyOrExit(dbus_pending_call_set_notify(pending, aFunction, this, &ThreadApiDBus::EmptyFree) == true,
                  ret = ClientError::ERROR_DBUS);
 exit:
+    InvalidatePropertyCache();
     return ret;
 }
 
@@ -571,6 +1441,31 @@ ClientError ThreadApiDBus::CallDBusMethodSync(const std::string &aMethodName, co
         dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
     VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::ERROR_DBUS);
     ret = DBus::CheckErrorMessage(reply.get());
+exit:
+    InvalidatePropertyCache();
+    dbus_error_free(&error);
+    return ret;
+}
+
+template <typename ArgType, typename ReplyType>
+ClientError ThreadApiDBus::CallDBusMethodSync(const std::string &aMethodName, const ArgType &aArgs, ReplyType &aReply)
+{
+    ClientError             ret = ClientError::ERROR_NONE;
+    DBus::UniqueDBusMessage message(dbus_message_new_method_call((OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(),
+                                                                 (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
+                                                                 OTBR_DBUS_THREAD_INTERFACE, aMethodName.c_str()));
+    DBus::UniqueDBusMessage reply = nullptr;
+    DBusError               error;
+
+    dbus_error_init(&error);
+    VerifyOrExit(message != nullptr, ret = ClientError::ERROR_DBUS);
+    VerifyOrExit(otbr::DBus::TupleToDBusMessage(*message, aArgs) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
+    reply = DBus::UniqueDBusMessage(
+        dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
+    VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::ERROR_DBUS);
+    ret = DBus::CheckErrorMessage(reply.get());
+    VerifyOrExit(ret == ClientError::ERROR_NONE);
+    VerifyOrExit(DBus::DBusMessageToTuple(*reply, aReply) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
 exit:
     dbus_error_free(&error);
     return ret;
@@ -597,11 +1492,19 @@ ClientError ThreadApiDBus::CallDBusMethodAsync(const std::string &           aMe
     VerifyOrExit(dbus_pending_call_set_notify(pending, aFunction, this, &ThreadApiDBus::EmptyFree) == true,
                  ret = ClientError::ERROR_DBUS);
 exit:
+    InvalidatePropertyCache();
     return ret;
 }
 
 template <typename ValType>
 ClientError ThreadApiDBus::SetProperty(const std::string &aPropertyName, const ValType &aValue)
+{
+    return SetPropertyValue(aPropertyName, [&aValue](DBusMessageIter &aIter) {
+        return DBus::DBusMessageEncodeToVariant(&aIter, aValue);
+    });
+}
+
+ClientError ThreadApiDBus::SetPropertyValue(const std::string &aPropertyName, const PropertyUpdates::Encoder &aEncoder)
 {
     DBus::UniqueDBusMessage message(dbus_message_new_method_call((OTBR_DBUS_SERVER_PREFIX + mInterfaceName).c_str(),
                                                                  (OTBR_DBUS_OBJECT_PREFIX + mInterfaceName).c_str(),
@@ -618,7 +1521,7 @@ ClientError ThreadApiDBus::SetProperty(const std::string &aPropertyName, const V
     VerifyOrExit(DBus::DBusMessageEncode(&iter, OTBR_DBUS_THREAD_INTERFACE) == OTBR_ERROR_NONE,
                  ret = ClientError::ERROR_DBUS);
     VerifyOrExit(DBus::DBusMessageEncode(&iter, aPropertyName) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
-    VerifyOrExit(DBus::DBusMessageEncodeToVariant(&iter, aValue) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
+    VerifyOrExit(aEncoder(iter) == OTBR_ERROR_NONE, ret = ClientError::ERROR_DBUS);
 
     reply = DBus::UniqueDBusMessage(
         dbus_connection_send_with_reply_and_block(mConnection, message.get(), DBUS_TIMEOUT_USE_DEFAULT, &error));
@@ -626,6 +1529,7 @@ ClientError ThreadApiDBus::SetProperty(const std::string &aPropertyName, const V
     VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::OT_ERROR_FAILED);
     ret = DBus::CheckErrorMessage(reply.get());
 exit:
+    InvalidatePropertyCache();
     dbus_error_free(&error);
     return ret;
 }
@@ -637,11 +1541,19 @@ template <typename ValType> ClientError ThreadApiDBus::GetProperty(const std::st
                                                                  DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_METHOD));
     DBus::UniqueDBusMessage reply = nullptr;
 
-    ClientError     ret = ClientError::ERROR_NONE;
+    ClientError     ret       = ClientError::ERROR_NONE;
+    bool            cacheable = false;
     DBusError       error;
     DBusMessageIter iter;
 
     dbus_error_init(&error);
+    cacheable = mPropertyCacheEnabled && IsCacheableProperty(aPropertyName);
+    if (cacheable && GetCachedProperty(aPropertyName, iter) &&
+        DBus::DBusMessageExtractFromVariant(&iter, aValue) == OTBR_ERROR_NONE)
+    {
+        ExitNow();
+    }
+
     VerifyOrExit(message != nullptr, ret = ClientError::OT_ERROR_FAILED);
     otbr::DBus::TupleToDBusMessage(*message, std::tie(OTBR_DBUS_THREAD_INTERFACE, aPropertyName));
     reply = DBus::UniqueDBusMessage(
@@ -650,6 +1562,11 @@ template <typename ValType> ClientError ThreadApiDBus::GetProperty(const std::st
     VerifyOrExit(!dbus_error_is_set(&error) && reply != nullptr, ret = ClientError::OT_ERROR_FAILED);
     SuccessOrExit(DBus::CheckErrorMessage(reply.get()));
     VerifyOrExit(dbus_message_iter_init(reply.get(), &iter), ret = ClientError::OT_ERROR_FAILED);
+    if (cacheable)
+    {
+        CacheProperty(aPropertyName, std::shared_ptr<DBusMessage>(dbus_message_ref(reply.get()), dbus_message_unref),
+                      iter);
+    }
     VerifyOrExit(DBus::DBusMessageExtractFromVariant(&iter, aValue) == OTBR_ERROR_NONE,
                  ret = ClientError::OT_ERROR_FAILED);
 
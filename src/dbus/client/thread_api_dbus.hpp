@@ -30,11 +30,15 @@
 #define OTBR_THREAD_API_DBUS_HPP_
 
 #include <functional>
+#include <map>
+#include <memory>
+#include <sys/select.h>
 
 #include <dbus/dbus.h>
 
 #include "dbus/common/constants.hpp"
 #include "dbus/common/dbus_message_helper.hpp"
+#include "dbus/common/dbus_resources.hpp"
 #include "dbus/common/error.hpp"
 #include "dbus/common/types.hpp"
 
@@ -43,12 +47,95 @@ namespace DBus {
 
 bool IsThreadActive(DeviceRole aRole);
 
+/**
+ * This class holds the property values returned by a batched property request.
+ *
+ */
+class PropertyValues
+{
+public:
+    /**
+     * This method gets the value of a property.
+     *
+     * @param[in]   aPropertyName   The property name.
+     * @param[out]  aValue          The property value.
+     *
+     * @retval ERROR_NONE           successfully decoded the value
+     * @retval ERROR_DBUS           the value has a different type
+     * @retval OT_ERROR_NOT_FOUND   the property is not in the reply
+     *
+     */
+    template <typename ValType> ClientError Get(const std::string &aPropertyName, ValType &aValue) const
+    {
+        ClientError     error = ClientError::ERROR_NONE;
+        auto            it    = mValues.find(aPropertyName);
+        DBusMessageIter iter;
+
+        VerifyOrExit(it != mValues.end(), error = ClientError::OT_ERROR_NOT_FOUND);
+        iter = it->second;
+        VerifyOrExit(DBusMessageExtractFromVariant(&iter, aValue) == OTBR_ERROR_NONE, error = ClientError::ERROR_DBUS);
+
+    exit:
+        return error;
+    }
+
+    /**
+     * This method returns whether a property is in the reply.
+     *
+     * @param[in]   aPropertyName   The property name.
+     *
+     */
+    bool Contains(const std::string &aPropertyName) const { return mValues.find(aPropertyName) != mValues.end(); }
+
+private:
+    friend class ThreadApiDBus;
+
+    ClientError Parse(UniqueDBusMessage aReply);
+
+    UniqueDBusMessage                      mReply;
+    std::map<std::string, DBusMessageIter> mValues;
+};
+
+/**
+ * This class holds the property values of a batched property update.
+ *
+ */
+class PropertyUpdates
+{
+public:
+    /**
+     * This method adds the new value of a property to the update.
+     *
+     * @param[in]   aPropertyName   The property name.
+     * @param[in]   aValue          The property value.
+     *
+     */
+    template <typename ValType> void Set(const std::string &aPropertyName, const ValType &aValue)
+    {
+        mValues.emplace_back(aPropertyName,
+                             [aValue](DBusMessageIter &aIter) { return DBusMessageEncodeToVariant(&aIter, aValue); });
+    }
+
+private:
+    friend class ThreadApiDBus;
+
+    using Encoder = std::function<otbrError(DBusMessageIter &)>;
+
+    std::vector<std::pair<std::string, Encoder>> mValues;
+};
+
 class ThreadApiDBus
 {
 public:
-    using DeviceRoleHandler = std::function<void(DeviceRole)>;
-    using ScanHandler       = std::function<void(const std::vector<ActiveScanResult> &)>;
-    using OtResultHandler   = std::function<void(ClientError)>;
+    using DeviceRoleHandler        = std::function<void(DeviceRole)>;
+    using Ip6AddressesHandler      = std::function<void(const Ip6AddressesChange &)>;
+    using LinkAlertsHandler        = std::function<void(const std::vector<LinkAlert> &)>;
+    using PropertiesChangedHandler = std::function<void(const std::vector<std::string> &)>;
+    using ScanHandler              = std::function<void(const std::vector<ActiveScanResult> &)>;
+    using OtResultHandler          = std::function<void(ClientError)>;
+    using PropertiesHandler        = std::function<void(ClientError, const PropertyValues &)>;
+
+    template <typename ValType> using PropertyHandler = std::function<void(ClientError, const ValType &)>;
 
     /**
      * The constructor of a d-bus object.
@@ -69,6 +156,14 @@ public:
      */
     ThreadApiDBus(DBusConnection *aConnection, const std::string &aInterfaceName);
 
+    /**
+     * The destructor of a d-bus object.
+     *
+     * The connection is detached from the application's main loop if AttachMainloop() was called.
+     *
+     */
+    ~ThreadApiDBus(void);
+
     /**
      * This method adds a callback for device role change.
      *
@@ -77,6 +172,55 @@ public:
      */
     void AddDeviceRoleHandler(const DeviceRoleHandler &aHandler);
 
+    /**
+     * This method adds a callback for the changes to the IPv6 address tables.
+     *
+     * The changes since a read of the UnicastAddresses and MulticastAddresses properties can be applied to the
+     * values read. The tables should be read again when they are invalidated by a PropertiesChanged signal, which
+     * tells that a change was lost.
+     *
+     * @param[in]   aHandler  The address change handler.
+     *
+     */
+    void AddIp6AddressesHandler(const Ip6AddressesHandler &aHandler);
+
+    /**
+     * This method adds a callback for the link quality alerts raised or cleared.
+     *
+     * @param[in]   aHandler  The link alerts handler.
+     *
+     */
+    void AddLinkAlertsHandler(const LinkAlertsHandler &aHandler);
+
+    /**
+     * This method adds a callback for the properties reported changed or invalidated by the server.
+     *
+     * The handler is given the names of the properties, and should read the ones it needs.
+     *
+     * @param[in]   aHandler  The properties changed handler.
+     *
+     */
+    void AddPropertiesChangedHandler(const PropertiesChangedHandler &aHandler);
+
+    /**
+     * This method enables or disables the client side cache of stable properties.
+     *
+     * The cached properties are the ones the server reports through PropertiesChanged, such as the device role,
+     * network name, PAN ID and channel. A cached property is filled on its first read and kept up to date by the
+     * signals, which are processed when the connection is dispatched. Method calls and property writes through this
+     * object, as well as a restart of the server, drop the cache.
+     *
+     * @param[in]   aEnabled  Whether to enable the cache.
+     *
+     */
+    void SetPropertyCacheEnabled(bool aEnabled);
+
+    /**
+     * This method drops all cached property values.
+     *
+     */
+    void InvalidatePropertyCache(void);
+
     /**
      * This method permits unsecure join on port.
      *
@@ -183,6 +327,30 @@ public:
      */
     ClientError JoinerStop(void);
 
+    /**
+     * This method adds joiners to the commissioner, all or none.
+     *
+     * @param[in]   aJoiners    The joiners to add.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError AddJoiners(const std::vector<JoinerInfo> &aJoiners);
+
+    /**
+     * This method removes joiners from the commissioner.
+     *
+     * @param[in]   aEui64s     The EUI-64s of the joiners to remove, 0 for the any joiner.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError RemoveJoiners(const std::vector<uint64_t> &aEui64s);
+
     /**
      * This method adds a on-mesh address prefix.
      *
@@ -231,6 +399,27 @@ public:
      */
     ClientError RemoveExternalRoute(const Ip6Prefix &aPrefix);
 
+    /**
+     * This method atomically applies a batch of on-mesh prefix and external route changes.
+     *
+     * The removals are applied before the additions and the result is registered with the leader once. If any change
+     * fails, none of the changes take effect.
+     *
+     * @param[in]   aAddedPrefixes      The on-mesh prefixes to add.
+     * @param[in]   aRemovedPrefixes    The on-mesh prefixes to remove.
+     * @param[in]   aAddedRoutes        The external routes to add.
+     * @param[in]   aRemovedRoutes      The external route prefixes to remove.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError UpdateBorderRouterConfig(const std::vector<OnMeshPrefix> & aAddedPrefixes,
+                                         const std::vector<Ip6Prefix> &    aRemovedPrefixes,
+                                         const std::vector<ExternalRoute> &aAddedRoutes,
+                                         const std::vector<Ip6Prefix> &    aRemovedRoutes);
+
     /**
      * This method sets the mesh-local prefix.
      *
@@ -472,6 +661,18 @@ public:
      */
     ClientError GetStableNetworkData(std::vector<uint8_t> &aNetworkData);
 
+    /**
+     * This method gets the parsed network data, so that the caller needn't parse the TLVs.
+     *
+     * @param[out]  aNetworkData   The on-mesh prefixes, external routes and services with the network data versions.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetNetworkDataInfo(NetworkDataInfo &aNetworkData);
+
     /**
      * This method gets the node's local leader weight.
      *
@@ -508,6 +709,21 @@ public:
      */
     ClientError GetChannelMonitorAllChannelQualities(std::vector<ChannelQuality> &aChannelQualities);
 
+    /**
+     * This method gets the congestion scores of the sampled channels.
+     *
+     * The scores aggregate the channel monitor and energy scan samples, from 0 for an idle channel to 0xffff for a
+     * channel that is always busy. They are reported in the occupancy field.
+     *
+     * @param[out]  aScores     The channel congestion scores.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetChannelQualityScores(std::vector<ChannelQuality> &aScores);
+
     /**
      * This method gets the child table.
      *
@@ -532,6 +748,111 @@ public:
      */
     ClientError GetNeighborTable(std::vector<NeighborInfo> &aNeighborTable);
 
+    /**
+     * This method gets the changes of the child table since a given version.
+     *
+     * @param[in]   aSinceVersion  The version returned by the previous call, or 0 to get the full table.
+     * @param[out]  aDelta         The child table changes.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetChildTableDelta(uint32_t aSinceVersion, TableDelta<ChildInfo> &aDelta);
+
+    /**
+     * This method gets the changes of the neighbor table since a given version.
+     *
+     * @param[in]   aSinceVersion  The version returned by the previous call, or 0 to get the full table.
+     * @param[out]  aDelta         The neighbor table changes.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetNeighborTableDelta(uint32_t aSinceVersion, TableDelta<NeighborInfo> &aDelta);
+
+    /**
+     * This method gets a page of the children matching a query.
+     *
+     * @param[in]   aQuery     The page and the filters of the query.
+     * @param[out]  aChildren  The matching children in the page.
+     * @param[out]  aMatched   The number of matching children.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError QueryChildTable(const TableQuery &aQuery, std::vector<ChildInfo> &aChildren, uint32_t &aMatched);
+
+    /**
+     * This method gets a page of the neighbors matching a query.
+     *
+     * @param[in]   aQuery      The page and the filters of the query.
+     * @param[out]  aNeighbors  The matching neighbors in the page.
+     * @param[out]  aMatched    The number of matching neighbors.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError QueryNeighborTable(const TableQuery &aQuery, std::vector<NeighborInfo> &aNeighbors, uint32_t &aMatched);
+
+    /**
+     * This method gets the rates of the sampled counters over the most recent window.
+     *
+     * @param[in]   aWindow     The window, in milliseconds.
+     * @param[out]  aRates      The rates of the counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetCounterRates(uint32_t aWindow, std::vector<CounterRates> &aRates);
+
+    /**
+     * This method gets the topology of the Thread network.
+     *
+     * @param[in]   aMaxAge     The maximum age of a previous crawl of the network to reuse, in milliseconds.
+     * @param[out]  aNodes      The routers of the network.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetTopology(uint32_t aMaxAge, std::vector<TopologyNode> &aNodes);
+
+    /**
+     * This method adds a link quality alert rule.
+     *
+     * @param[in]   aRule   The rule, of which the ID is ignored.
+     * @param[out]  aId     The ID of the new rule.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError AddLinkAlertRule(const LinkAlertRule &aRule, uint32_t &aId);
+
+    /**
+     * This method removes a link quality alert rule.
+     *
+     * @param[in]   aId     The rule ID.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError RemoveLinkAlertRule(uint32_t aId);
+
     /**
      * This method gets the network's parition id.
      *
@@ -580,6 +901,396 @@ public:
      */
     ClientError GetExternalRoutes(std::vector<ExternalRoute> &aExternalRoutes);
 
+    /**
+     * This method gets the wakeup counters of the agent main loop.
+     *
+     * @param[out]  aCounters   The main loop counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMainloopCounters(MainloopCounters &aCounters); // For telemetry
+
+    /**
+     * This method gets the duration histograms of the agent main loop stages.
+     *
+     * @param[out]  aHistograms     The main loop histograms.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMainloopHistograms(std::vector<MainloopHistogram> &aHistograms); // For telemetry
+
+    /**
+     * This method gets the heap memory accounted to each subsystem of the agent.
+     *
+     * @param[out]  aUsages     The memory usage of the subsystems.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMemoryUsage(std::vector<MemoryUsage> &aUsages); // For telemetry
+
+    /**
+     * This method gets the outgoing queue counters of the server's bus connection.
+     *
+     * @param[out]  aCounters   The queue counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetDBusQueueCounters(DBusQueueCounters &aCounters); // For telemetry
+
+    /**
+     * This method gets the counters of the scan, attach and joiner start requests waiting for conflicting ones.
+     *
+     * @param[out]  aCounters   The operation queue counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetOperationQueueCounters(OperationQueueCounters &aCounters); // For telemetry
+
+    /**
+     * This method gets the counters and phase durations of the joins of the device.
+     *
+     * @param[out]  aCounters   The joiner counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetJoinerCounters(JoinerCounters &aCounters); // For telemetry
+
+    /**
+     * This method gets the entries of the EID-to-RLOC address cache, as last sampled.
+     *
+     * @param[out]  aEntries    The address cache entries.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetAddressCache(std::vector<AddressCacheEntry> &aEntries);
+
+    /**
+     * This method gets the counters of the address queries and evictions of the EID-to-RLOC address cache.
+     *
+     * @param[out]  aCounters   The address cache counters.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetAddressCacheCounters(AddressCacheCounters &aCounters); // For telemetry
+
+    /**
+     * This method sets the active operational dataset.
+     *
+     * @param[in]  aTlvs  The active operational dataset TLVs.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError SetActiveDatasetTlvs(const std::vector<uint8_t> &aTlvs);
+
+    /**
+     * This method sets the pending operational dataset.
+     *
+     * @param[in]  aTlvs  The pending operational dataset TLVs.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError SetPendingDatasetTlvs(const std::vector<uint8_t> &aTlvs);
+
+    /**
+     * This method gets the active operational dataset.
+     *
+     * @param[out]  aTlvs  The active operational dataset TLVs, empty if not present.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetActiveDatasetTlvs(std::vector<uint8_t> &aTlvs);
+
+    /**
+     * This method gets the pending operational dataset.
+     *
+     * @param[out]  aTlvs  The pending operational dataset TLVs, empty if not present.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetPendingDatasetTlvs(std::vector<uint8_t> &aTlvs);
+
+    /**
+     * This method gets the parsed active operational dataset.
+     *
+     * @param[out]  aDataset  The active operational dataset.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetActiveDataset(OperationalDataset &aDataset);
+
+    /**
+     * This method gets the parsed pending operational dataset.
+     *
+     * @param[out]  aDataset  The pending operational dataset.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetPendingDataset(OperationalDataset &aDataset);
+
+    /**
+     * This method gets the unicast addresses of the Thread interface.
+     *
+     * @param[out]  aAddresses  The unicast addresses.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetUnicastAddresses(std::vector<Ip6AddressInfo> &aAddresses);
+
+    /**
+     * This method gets the multicast addresses subscribed by the Thread interface.
+     *
+     * @param[out]  aAddresses  The multicast addresses.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMulticastAddresses(std::vector<std::vector<uint8_t>> &aAddresses);
+
+    /**
+     * This method gets the mesh-local prefix.
+     *
+     * @param[out]  aPrefix  The mesh-local prefix.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMeshLocalPrefix(std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> &aPrefix);
+
+    /**
+     * This method gets the mesh-local EID.
+     *
+     * @param[out]  aAddress  The mesh-local EID.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetMeshLocalEid(std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> &aAddress);
+
+    /**
+     * This method gets the factory-assigned IEEE EUI-64.
+     *
+     * @param[out]  aEui64  The EUI-64.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetEui64(uint64_t &aEui64);
+
+    /**
+     * This method gets the OpenThread version string of the host.
+     *
+     * @param[out]  aVersion  The version string.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetOtHostVersion(std::string &aVersion);
+
+    /**
+     * This method sets the log levels of logging modules, leaving the other modules unchanged.
+     *
+     * @param[in]   aLevels   The log levels, where -1 has a module follow the level of the "default" module.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError SetLogLevels(const std::vector<LogLevel> &aLevels);
+
+    /**
+     * This method gets the log levels of all the logging modules.
+     *
+     * @param[out]  aLevels   The log levels, where -1 has a module follow the level of the "default" module.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetLogLevels(std::vector<LogLevel> &aLevels);
+
+    /**
+     * This method sets the interval to sample the metrics of the link quality alert rules.
+     *
+     * @param[in]   aInterval   The interval, in milliseconds.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError SetLinkAlertInterval(uint32_t aInterval);
+
+    /**
+     * This method gets the link quality alert rules.
+     *
+     * @param[out]  aRules  The rules.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetLinkAlertRules(std::vector<LinkAlertRule> &aRules);
+
+    /**
+     * This method gets the raised link quality alerts.
+     *
+     * @param[out]  aAlerts     The raised alerts, with their last sample.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetRaisedLinkAlerts(std::vector<LinkAlert> &aAlerts);
+
+    /**
+     * This method gets the records of the agent's flight recorder, from the oldest to the newest.
+     *
+     * @param[out]  aRecords    The flight records.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetFlightRecords(std::vector<FlightRecord> &aRecords);
+
+    /**
+     * This method gets several properties in one round trip.
+     *
+     * The Thread interface's GetProperties method is used when the server provides it, and
+     * org.freedesktop.DBus.Properties.GetAll otherwise.
+     *
+     * @param[in]   aPropertyNames  The property names.
+     * @param[out]  aValues         The property values.
+     *
+     * @retval ERROR_NONE successfully performed the dbus function call
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value otherwise
+     *
+     */
+    ClientError GetProperties(const std::vector<std::string> &aPropertyNames, PropertyValues &aValues);
+
+    /**
+     * This method gets several properties in one round trip without blocking.
+     *
+     * The handler is called from the connection's dispatch once the reply arrives. Any number of requests may be
+     * outstanding at the same time.
+     *
+     * @param[in]   aPropertyNames  The property names.
+     * @param[in]   aHandler        The handler of the property values.
+     *
+     * @retval ERROR_NONE successfully sent the request
+     * @retval ERROR_DBUS dbus encode error
+     *
+     */
+    ClientError GetPropertiesAsync(const std::vector<std::string> &aPropertyNames, const PropertiesHandler &aHandler);
+
+    /**
+     * This method sets several properties in one round trip.
+     *
+     * The Thread interface's SetProperties method is used when the server provides it, which applies nothing unless
+     * all the values are valid. Older servers get one org.freedesktop.DBus.Properties.Set call per property.
+     *
+     * @param[in]   aUpdates    The property values.
+     * @param[out]  aResults    The result of each property.
+     *
+     * @retval ERROR_NONE successfully set all the properties
+     * @retval ERROR_DBUS dbus encode/decode error
+     * @retval ...        OpenThread defined error value of the call or of the first property failed otherwise
+     *
+     */
+    ClientError SetProperties(const PropertyUpdates &aUpdates, std::map<std::string, ClientError> &aResults);
+
+    /**
+     * This method gets a property without blocking.
+     *
+     * This is the non-blocking form of each property getter above, e.g.
+     * `GetPropertyAsync<uint16_t>(OTBR_DBUS_PROPERTY_PANID, handler)` for GetPanId(). The handler is called from the
+     * connection's dispatch once the reply arrives. Any number of requests may be outstanding at the same time.
+     *
+     * @param[in]   aPropertyName   The property name.
+     * @param[in]   aHandler        The handler of the property value.
+     *
+     * @retval ERROR_NONE successfully sent the request
+     * @retval ERROR_DBUS dbus encode error
+     *
+     */
+    template <typename ValType>
+    ClientError GetPropertyAsync(const std::string &aPropertyName, const PropertyHandler<ValType> &aHandler)
+    {
+        return SendAsync(NewPropertyGetMessage(aPropertyName), [aHandler](ClientError aError, DBusMessage *aReply) {
+            ValType         value{};
+            DBusMessageIter iter;
+
+            if (aError == ClientError::ERROR_NONE && (!dbus_message_iter_init(aReply, &iter) ||
+                                                      DBusMessageExtractFromVariant(&iter, value) != OTBR_ERROR_NONE))
+            {
+                aError = ClientError::ERROR_DBUS;
+            }
+
+            aHandler(aError, value);
+        });
+    }
+
     /**
      * This method returns the network interface name the client is bound to.
      *
@@ -588,18 +1299,62 @@ public:
      */
     std::string GetInterfaceName(void);
 
+    /**
+     * This method lets the application's main loop drive the connection through UpdateFdSet() and Process().
+     *
+     * This installs the watch and timeout functions of the connection, so the application must not read or dispatch
+     * the connection otherwise, e.g. with dbus_connection_read_write_dispatch(). Signals and the replies of the
+     * asynchronous calls are then handled from Process() without blocking, and the asynchronous calls time out even
+     * when no message arrives. The synchronous calls still block until their reply arrives.
+     *
+     * @retval ERROR_NONE successfully attached the connection
+     * @retval ERROR_DBUS failed to install the watch or timeout functions
+     *
+     */
+    ClientError AttachMainloop(void);
+
+    /**
+     * This method performs the dbus select update.
+     *
+     * @param[inout]    aReadFdSet   The read file descriptors.
+     * @param[inout]    aWriteFdSet  The write file descriptors.
+     * @param[inout]    aErrorFdSet  The error file descriptors.
+     * @param[inout]    aMaxFd       The max file descriptor.
+     * @param[inout]    aTimeOut     The select timeout.
+     *
+     */
+    void UpdateFdSet(fd_set &        aReadFdSet,
+                     fd_set &        aWriteFdSet,
+                     fd_set &        aErrorFdSet,
+                     int &           aMaxFd,
+                     struct timeval &aTimeOut);
+
+    /**
+     * This method processes the dbus I/O and timeouts, and dispatches the messages received.
+     *
+     * @param[in]       aReadFdSet   The read file descriptors.
+     * @param[in]       aWriteFdSet  The write file descriptors.
+     * @param[in]       aErrorFdSet  The error file descriptors.
+     *
+     */
+    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+
 private:
     ClientError CallDBusMethodSync(const std::string &aMethodName);
     ClientError CallDBusMethodAsync(const std::string &aMethodName, DBusPendingCallNotifyFunction aFunction);
 
     template <typename ArgType> ClientError CallDBusMethodSync(const std::string &aMethodName, const ArgType &aArgs);
 
+    template <typename ArgType, typename ReplyType>
+    ClientError CallDBusMethodSync(const std::string &aMethodName, const ArgType &aArgs, ReplyType &aReply);
+
     template <typename ArgType>
     ClientError CallDBusMethodAsync(const std::string &           aMethodName,
                                     const ArgType &               aArgs,
                                     DBusPendingCallNotifyFunction aFunction);
 
     template <typename ValType> ClientError SetProperty(const std::string &aPropertyName, const ValType &aValue);
+    ClientError SetPropertyValue(const std::string &aPropertyName, const PropertyUpdates::Encoder &aEncoder);
 
     template <typename ValType> ClientError GetProperty(const std::string &aPropertyName, ValType &aValue);
 
@@ -616,8 +1371,35 @@ private:
     static void sScanPendingCallHandler(DBusPendingCall *aPending, void *aThreadApiDBus);
     void        ScanPendingCallHandler(DBusPendingCall *aPending);
 
+    using ReplyHandler = std::function<void(ClientError aError, DBusMessage *aReply)>;
+
+    UniqueDBusMessage NewPropertyGetMessage(const std::string &aPropertyName);
+    UniqueDBusMessage NewGetPropertiesMessage(const std::vector<std::string> &aPropertyNames);
+    ClientError       SendAsync(UniqueDBusMessage aMessage, const ReplyHandler &aHandler);
+    static void       sHandleAsyncReply(DBusPendingCall *aPending, void *aHandler);
+    static void       sFreeReplyHandler(void *aHandler) { delete static_cast<ReplyHandler *>(aHandler); }
+
     static void EmptyFree(void *aData) { (void)aData; }
 
+    static dbus_bool_t sAddWatch(DBusWatch *aWatch, void *aThreadApiDBus);
+    static void        sRemoveWatch(DBusWatch *aWatch, void *aThreadApiDBus);
+    static void        sToggleWatch(DBusWatch *aWatch, void *aThreadApiDBus);
+    static dbus_bool_t sAddTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus);
+    static void        sRemoveTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus);
+    static void        sToggleTimeout(DBusTimeout *aTimeout, void *aThreadApiDBus);
+    void               DetachMainloop(void);
+
+    struct CachedProperty
+    {
+        std::shared_ptr<DBusMessage> mMessage; ///< The message holding the value.
+        DBusMessageIter              mValue;   ///< The variant holding the value.
+    };
+
+    bool GetCachedProperty(const std::string &aPropertyName, DBusMessageIter &aValue) const;
+    void CacheProperty(const std::string &                 aPropertyName,
+                       const std::shared_ptr<DBusMessage> &aMessage,
+                       const DBusMessageIter &             aValue);
+
     std::string mInterfaceName;
 
     DBusConnection *mConnection;
@@ -627,7 +1409,21 @@ private:
     OtResultHandler mFactoryResetHandler;
     OtResultHandler mJoinerHandler;
 
-    std::vector<DeviceRoleHandler> mDeviceRoleHandlers;
+    std::vector<DeviceRoleHandler>        mDeviceRoleHandlers;
+    std::vector<Ip6AddressesHandler>      mIp6AddressesHandlers;
+    std::vector<LinkAlertsHandler>        mLinkAlertsHandlers;
+    std::vector<PropertiesChangedHandler> mPropertiesChangedHandlers;
+
+    bool mGetPropertiesSupported;
+    bool mSetPropertiesSupported;
+
+    bool                                  mPropertyCacheEnabled;
+    std::map<std::string, CachedProperty> mPropertyCache;
+
+    // The enabled watches, and the enabled timeouts with their deadlines, of a connection attached to the main loop.
+    bool                                   mMainloopAttached;
+    std::map<DBusWatch *, bool>            mWatches;
+    std::map<DBusTimeout *, unsigned long> mTimeouts;
 };
 
 } // namespace DBus
@@ -37,6 +37,7 @@
 
 #define OTBR_DBUS_SERVER_PREFIX "io.openthread.BorderRouter."
 #define OTBR_DBUS_THREAD_INTERFACE "io.openthread.BorderRouter"
+#define OTBR_DBUS_DEBUG_INTERFACE "io.openthread.BorderRouter.Debug"
 #define OTBR_DBUS_OBJECT_PREFIX "/io/openthread/BorderRouter/"
 
 #define OTBR_DBUS_SCAN_METHOD "Scan"
@@ -48,8 +49,25 @@
 #define OTBR_DBUS_PERMIT_UNSECURE_JOIN_METHOD "PermitUnsecureJoin"
 #define OTBR_DBUS_JOINER_START_METHOD "JoinerStart"
 #define OTBR_DBUS_JOINER_STOP_METHOD "JoinerStop"
+#define OTBR_DBUS_ADD_JOINERS_METHOD "AddJoiners"
+#define OTBR_DBUS_REMOVE_JOINERS_METHOD "RemoveJoiners"
 #define OTBR_DBUS_ADD_EXTERNAL_ROUTE_METHOD "AddExternalRoute"
 #define OTBR_DBUS_REMOVE_EXTERNAL_ROUTE_METHOD "RemoveExternalRoute"
+#define OTBR_DBUS_UPDATE_BORDER_ROUTER_CONFIG_METHOD "UpdateBorderRouterConfig"
+#define OTBR_DBUS_GET_PROPERTIES_METHOD "GetProperties"
+#define OTBR_DBUS_SET_PROPERTIES_METHOD "SetProperties"
+#define OTBR_DBUS_GET_CHILD_TABLE_DELTA_METHOD "GetChildTableDelta"
+#define OTBR_DBUS_GET_NEIGHBOR_TABLE_DELTA_METHOD "GetNeighborTableDelta"
+#define OTBR_DBUS_QUERY_CHILD_TABLE_METHOD "QueryChildTable"
+#define OTBR_DBUS_QUERY_NEIGHBOR_TABLE_METHOD "QueryNeighborTable"
+#define OTBR_DBUS_GET_COUNTER_RATES_METHOD "GetCounterRates"
+#define OTBR_DBUS_GET_TOPOLOGY_METHOD "GetTopology"
+#define OTBR_DBUS_ADD_LINK_ALERT_RULE_METHOD "AddLinkAlertRule"
+#define OTBR_DBUS_REMOVE_LINK_ALERT_RULE_METHOD "RemoveLinkAlertRule"
+#define OTBR_DBUS_RESET_CALL_STATS_METHOD "ResetCallStats"
+
+#define OTBR_DBUS_IP6_ADDRESSES_CHANGED_SIGNAL "Ip6AddressesChanged"
+#define OTBR_DBUS_LINK_ALERTS_SIGNAL "LinkAlerts"
 
 #define OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX "MeshLocalPrefix"
 #define OTBR_DBUS_PROPERTY_LEGACY_ULA_PREFIX "LegacyULAPrefix"
@@ -70,15 +88,40 @@
 #define OTBR_DBUS_PROPERTY_LEADER_DATA "LeaderData"
 #define OTBR_DBUS_PROPERTY_NETWORK_DATA_PRPOERTY "NetworkData"
 #define OTBR_DBUS_PROPERTY_STABLE_NETWORK_DATA_PRPOERTY "StableNetworkData"
+#define OTBR_DBUS_PROPERTY_NETWORK_DATA_INFO "NetworkDataInfo"
 #define OTBR_DBUS_PROPERTY_LOCAL_LEADER_WEIGHT "LocalLeaderWeight"
 #define OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_SAMPLE_COUNT "ChannelMonitorSampleCount"
 #define OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_ALL_CHANNEL_QUALITIES "ChannelMonitorAllChannelQualities"
+#define OTBR_DBUS_PROPERTY_CHANNEL_QUALITY_SCORES "ChannelQualityScores"
 #define OTBR_DBUS_PROPERTY_CHILD_TABLE "ChildTable"
 #define OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY "NeighborTable"
 #define OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY "PartitionID"
 #define OTBR_DBUS_PROPERTY_INSTANT_RSSI "InstantRssi"
 #define OTBR_DBUS_PROPERTY_RADIO_TX_POWER "RadioTxPower"
 #define OTBR_DBUS_PROPERTY_EXTERNAL_ROUTES "ExternalRoutes"
+#define OTBR_DBUS_PROPERTY_MAINLOOP_COUNTERS "MainloopCounters"
+#define OTBR_DBUS_PROPERTY_MAINLOOP_HISTOGRAMS "MainloopHistograms"
+#define OTBR_DBUS_PROPERTY_MEMORY_USAGE "MemoryUsage"
+#define OTBR_DBUS_PROPERTY_DBUS_QUEUE_COUNTERS "DBusQueueCounters"
+#define OTBR_DBUS_PROPERTY_OPERATION_QUEUE_COUNTERS "OperationQueueCounters"
+#define OTBR_DBUS_PROPERTY_JOINER_COUNTERS "JoinerCounters"
+#define OTBR_DBUS_PROPERTY_ADDRESS_CACHE "AddressCache"
+#define OTBR_DBUS_PROPERTY_ADDRESS_CACHE_COUNTERS "AddressCacheCounters"
+#define OTBR_DBUS_PROPERTY_ACTIVE_DATASET_TLVS "ActiveDatasetTlvs"
+#define OTBR_DBUS_PROPERTY_PENDING_DATASET_TLVS "PendingDatasetTlvs"
+#define OTBR_DBUS_PROPERTY_ACTIVE_DATASET "ActiveDataset"
+#define OTBR_DBUS_PROPERTY_PENDING_DATASET "PendingDataset"
+#define OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES "UnicastAddresses"
+#define OTBR_DBUS_PROPERTY_MULTICAST_ADDRESSES "MulticastAddresses"
+#define OTBR_DBUS_PROPERTY_MESH_LOCAL_EID "MeshLocalEid"
+#define OTBR_DBUS_PROPERTY_EUI64 "Eui64"
+#define OTBR_DBUS_PROPERTY_OT_HOST_VERSION "OtHostVersion"
+#define OTBR_DBUS_PROPERTY_LOG_LEVELS "LogLevels"
+#define OTBR_DBUS_PROPERTY_LINK_ALERT_RULES "LinkAlertRules"
+#define OTBR_DBUS_PROPERTY_LINK_ALERT_INTERVAL "LinkAlertInterval"
+#define OTBR_DBUS_PROPERTY_RAISED_LINK_ALERTS "RaisedLinkAlerts"
+#define OTBR_DBUS_PROPERTY_FLIGHT_RECORDS "FlightRecords"
+#define OTBR_DBUS_PROPERTY_CALL_STATS "CallStats"
 
 #define OTBR_ROLE_NAME_DISABLED "disabled"
 #define OTBR_ROLE_NAME_DETACHED "detached"
@@ -71,39 +71,16 @@ exit:
     return error;
 }
 
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint8_t> &aValue)
+otbrError DBusMessageExtract(DBusMessageIter *aIter, const char *&aValue)
 {
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint16_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint32_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint64_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int16_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
+    otbrError error = OTBR_ERROR_NONE;
 
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int32_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
-}
+    VerifyOrExit(dbus_message_iter_get_arg_type(aIter) == DBUS_TYPE_STRING, error = OTBR_ERROR_DBUS);
+    dbus_message_iter_get_basic(aIter, &aValue);
+    dbus_message_iter_next(aIter);
 
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int64_t> &aValue)
-{
-    return DBusMessageExtractPrimitive(aIter, aValue);
+exit:
+    return error;
 }
 
 otbrError DBusMessageEncode(DBusMessageIter *aIter, bool aValue)
@@ -142,40 +119,5 @@ exit:
     return error;
 }
 
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint8_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint16_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint32_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint64_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int16_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int32_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int64_t> &aValue)
-{
-    return DBusMessageEncodePrimitive(aIter, aValue);
-}
-
 } // namespace DBus
 } // namespace otbr
@@ -32,6 +32,7 @@
 #include <array>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <dbus/dbus.h>
@@ -66,11 +67,199 @@ otbrError DBusMessageEncode(DBusMessageIter *aIter, const NeighborInfo &aNeighbo
 otbrError DBusMessageExtract(DBusMessageIter *aIter, NeighborInfo &aNeighborInfo);
 otbrError DBusMessageEncode(DBusMessageIter *aIter, const LeaderData &aLeaderData);
 otbrError DBusMessageExtract(DBusMessageIter *aIter, LeaderData &aLeaderData);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const BorderRouterEntry &aEntry);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, BorderRouterEntry &aEntry);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const ServiceEntry &aEntry);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, ServiceEntry &aEntry);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const NetworkDataInfo &aInfo);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, NetworkDataInfo &aInfo);
 otbrError DBusMessageEncode(DBusMessageIter *aIter, const ChannelQuality &aQuality);
 otbrError DBusMessageExtract(DBusMessageIter *aIter, ChannelQuality &aQuality);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const MainloopCounters &aCounters);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, MainloopCounters &aCounters);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const DBusQueueCounters &aCounters);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, DBusQueueCounters &aCounters);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const OperationQueueCounters &aCounters);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, OperationQueueCounters &aCounters);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const JoinerCounters &aCounters);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, JoinerCounters &aCounters);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const AddressCacheEntry &aEntry);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, AddressCacheEntry &aEntry);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const AddressCacheCounters &aCounters);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, AddressCacheCounters &aCounters);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const OperationalDataset &aDataset);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, OperationalDataset &aDataset);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const Ip6AddressInfo &aInfo);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, Ip6AddressInfo &aInfo);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const LogLevel &aLevel);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, LogLevel &aLevel);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const HistogramBucket &aBucket);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, HistogramBucket &aBucket);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const MainloopHistogram &aHistogram);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, MainloopHistogram &aHistogram);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const MemoryUsage &aUsage);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, MemoryUsage &aUsage);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const JoinerInfo &aJoiner);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, JoinerInfo &aJoiner);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const CounterRates &aRates);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, CounterRates &aRates);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const TopologyLink &aLink);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, TopologyLink &aLink);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const TopologyChild &aChild);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, TopologyChild &aChild);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const TopologyNode &aNode);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, TopologyNode &aNode);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const LinkAlertRule &aRule);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, LinkAlertRule &aRule);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const LinkAlert &aAlert);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, LinkAlert &aAlert);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const TableQuery &aQuery);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, TableQuery &aQuery);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const FlightRecord &aRecord);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, FlightRecord &aRecord);
+otbrError DBusMessageEncode(DBusMessageIter *aIter, const DBusCallStats &aStats);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, DBusCallStats &aStats);
 
 template <typename T> struct DBusTypeTrait;
 
+template <> struct DBusTypeTrait<bool>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_BOOLEAN;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_BOOLEAN_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<int8_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_BYTE;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_BYTE_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<uint8_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_BYTE;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_BYTE_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<uint16_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_UINT16;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT16_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<uint32_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_UINT32;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT32_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<uint64_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_UINT64;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT64_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<int16_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_INT16;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT16_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<int32_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_INT32;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT32_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<int64_t>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_INT64;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT64_AS_STRING;
+};
+
+template <> struct DBusTypeTrait<std::string>
+{
+    static constexpr int         TYPE           = DBUS_TYPE_STRING;
+    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_STRING_AS_STRING;
+};
+
+/**
+ * This class template holds a D-Bus type signature as a string built at compile time.
+ *
+ */
+template <char... CHARS> struct DBusSignature
+{
+    static constexpr char kValue[] = {CHARS..., '\0'};
+};
+
+template <char... CHARS> constexpr char DBusSignature<CHARS...>::kValue[];
+
+template <size_t... INDICES> struct DBusIndexSequence
+{
+};
+
+template <size_t N, size_t... INDICES> struct DBusMakeIndexSequence : DBusMakeIndexSequence<N - 1, N - 1, INDICES...>
+{
+};
+
+template <size_t... INDICES> struct DBusMakeIndexSequence<0, INDICES...>
+{
+    using Type = DBusIndexSequence<INDICES...>;
+};
+
+constexpr size_t DBusSignatureLength(const char *aSignature)
+{
+    return *aSignature == '\0' ? 0 : 1 + DBusSignatureLength(aSignature + 1);
+}
+
+/**
+ * This class template converts the signature of a type with a `DBusTypeTrait` into a `DBusSignature`.
+ *
+ */
+template <typename T,
+          typename INDICES =
+              typename DBusMakeIndexSequence<DBusSignatureLength(DBusTypeTrait<T>::TYPE_AS_STRING)>::Type>
+struct DBusSignatureOf;
+
+template <typename T, size_t... INDICES> struct DBusSignatureOf<T, DBusIndexSequence<INDICES...>>
+{
+    using Type = DBusSignature<DBusTypeTrait<T>::TYPE_AS_STRING[INDICES]...>;
+};
+
+template <typename... SIGNATURES> struct DBusSignatureConcat;
+
+template <char... CHARS> struct DBusSignatureConcat<DBusSignature<CHARS...>>
+{
+    using Type = DBusSignature<CHARS...>;
+};
+
+template <char... CHARS, char... MORE_CHARS, typename... SIGNATURES>
+struct DBusSignatureConcat<DBusSignature<CHARS...>, DBusSignature<MORE_CHARS...>, SIGNATURES...>
+    : DBusSignatureConcat<DBusSignature<CHARS..., MORE_CHARS...>, SIGNATURES...>
+{
+};
+
+/**
+ * The signature of a D-Bus struct of the fields, e.g. "(qay)" for `uint16_t` and `std::vector<uint8_t>`.
+ *
+ */
+template <typename... FIELDS>
+using DBusStructSignature = typename DBusSignatureConcat<DBusSignature<static_cast<char>(DBUS_STRUCT_BEGIN_CHAR)>,
+                                                         typename DBusSignatureOf<FIELDS>::Type...,
+                                                         DBusSignature<static_cast<char>(DBUS_STRUCT_END_CHAR)>>::Type;
+
+/**
+ * The signature of a D-Bus array of the elements, e.g. "a(qy)" for `TopologyChild`.
+ *
+ */
+template <typename T>
+using DBusArraySignature = typename DBusSignatureConcat<DBusSignature<static_cast<char>(DBUS_TYPE_ARRAY)>,
+                                                        typename DBusSignatureOf<T>::Type>::Type;
+
+template <typename T> struct DBusTypeTrait<std::vector<T>>
+{
+    static constexpr const char *TYPE_AS_STRING = DBusArraySignature<T>::kValue;
+};
+
 template <> struct DBusTypeTrait<IpCounters>
 {
     // struct of 32 bytes
@@ -89,12 +278,6 @@ template <> struct DBusTypeTrait<LinkModeConfig>
     static constexpr const char *TYPE_AS_STRING = "(bbbb)";
 };
 
-template <> struct DBusTypeTrait<std::vector<uint8_t>>
-{
-    // array of bytes
-    static constexpr const char *TYPE_AS_STRING = "ay";
-};
-
 template <size_t SIZE> struct DBusTypeTrait<std::array<uint8_t, SIZE>>
 {
     // array of bytes
@@ -103,20 +286,12 @@ template <size_t SIZE> struct DBusTypeTrait<std::array<uint8_t, SIZE>>
 
 template <> struct DBusTypeTrait<Ip6Prefix>
 {
-    // struct of {array of bytes, byte}
-    static constexpr const char *TYPE_AS_STRING = "(ayy)";
+    static constexpr const char *TYPE_AS_STRING = DBusStructSignature<std::vector<uint8_t>, uint8_t>::kValue;
 };
 
 template <> struct DBusTypeTrait<ExternalRoute>
 {
-    // struct of {{array of bytes, byte}, uint16, byte, bool, bool}
-    static constexpr const char *TYPE_AS_STRING = "((ayy)qybb)";
-};
-
-template <> struct DBusTypeTrait<std::vector<ExternalRoute>>
-{
-    // array of {{array of bytes, byte}, uint16, byte, bool, bool}
-    static constexpr const char *TYPE_AS_STRING = "a((ayy)qybb)";
+    static constexpr const char *TYPE_AS_STRING = DBusStructSignature<Ip6Prefix, uint16_t, uint8_t, bool, bool>::kValue;
 };
 
 template <> struct DBusTypeTrait<LeaderData>
@@ -125,10 +300,28 @@ template <> struct DBusTypeTrait<LeaderData>
     static constexpr const char *TYPE_AS_STRING = "(uyyyy)";
 };
 
-template <> struct DBusTypeTrait<std::vector<ChannelQuality>>
+template <> struct DBusTypeTrait<OnMeshPrefix>
+{
+    // struct of {{array of bytes, byte}, byte, {bool, bool, bool, bool, bool, bool, bool}}
+    static constexpr const char *TYPE_AS_STRING = "((ayy)y(bbbbbbb))";
+};
+
+template <> struct DBusTypeTrait<BorderRouterEntry>
+{
+    static constexpr const char *TYPE_AS_STRING = DBusStructSignature<OnMeshPrefix, uint16_t>::kValue;
+};
+
+template <> struct DBusTypeTrait<ServiceEntry>
 {
-    // array of struct of { uint8, uint16 }
-    static constexpr const char *TYPE_AS_STRING = "a(yq)";
+    static constexpr const char *TYPE_AS_STRING =
+        DBusStructSignature<uint32_t, uint8_t, std::vector<uint8_t>, uint16_t, std::vector<uint8_t>, bool>::kValue;
+};
+
+template <> struct DBusTypeTrait<NetworkDataInfo>
+{
+    static constexpr const char *TYPE_AS_STRING =
+        DBusStructSignature<uint8_t, uint8_t, std::vector<BorderRouterEntry>, std::vector<ExternalRoute>,
+                            std::vector<ServiceEntry>>::kValue;
 };
 
 template <> struct DBusTypeTrait<NeighborInfo>
@@ -138,13 +331,6 @@ template <> struct DBusTypeTrait<NeighborInfo>
     static constexpr const char *TYPE_AS_STRING = "(tuquuyyyqqbbbbb)";
 };
 
-template <> struct DBusTypeTrait<std::vector<NeighborInfo>>
-{
-    // array of struct of { uint64, uint32, uint16, uint32, uint32, uint8,
-    //                      uint8, uint8, uint16, uint16, bool, bool, bool, bool }
-    static constexpr const char *TYPE_AS_STRING = "a(tuquuyyyqqbbbbb)";
-};
-
 template <> struct DBusTypeTrait<ChildInfo>
 {
     // struct of { uint64, uint32, uint32, uint16, uint16, uint8, uint8,
@@ -155,9 +341,9 @@ template <> struct DBusTypeTrait<ChildInfo>
 
 template <> struct DBusTypeTrait<ActiveScanResult>
 {
-    // struct of { uint64, string, uint64, array<uint8>, uint16, uint16, uint8,
-    //             uint8, uint8, uint8, bool, bool }
-    static constexpr const char *TYPE_AS_STRING = "(tstayqqyyyybb)";
+    static constexpr const char *TYPE_AS_STRING =
+        DBusStructSignature<uint64_t, std::string, uint64_t, std::vector<uint8_t>, uint16_t, uint16_t, uint8_t, int8_t,
+                            uint8_t, uint8_t, bool, bool>::kValue;
 };
 
 template <> struct DBusTypeTrait<ChannelQuality>
@@ -166,89 +352,189 @@ template <> struct DBusTypeTrait<ChannelQuality>
     static constexpr const char *TYPE_AS_STRING = "(yq)";
 };
 
-template <> struct DBusTypeTrait<std::vector<ChildInfo>>
+template <> struct DBusTypeTrait<MainloopCounters>
 {
-    // array of struct of { uint64, uint32, uint32, uint16, uint16, uint8, uint8,
-    //                      uint8, uint8, uint16, uint16, bool, bool, bool, bool,
-    //                      bool}
-    static constexpr const char *TYPE_AS_STRING = "a(tuuqqyyyyqqbbbbb)";
+    // struct of { uint64, uint64, uint64 }
+    static constexpr const char *TYPE_AS_STRING = "(ttt)";
 };
 
-template <> struct DBusTypeTrait<int8_t>
+template <> struct DBusTypeTrait<DBusQueueCounters>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_BYTE;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_BYTE_AS_STRING;
+    // struct of { uint32, uint32, uint32, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(uuuuu)";
 };
 
-template <> struct DBusTypeTrait<uint8_t>
+template <> struct DBusTypeTrait<OperationQueueCounters>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_BYTE;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_BYTE_AS_STRING;
+    // struct of { uint32, uint32, uint32, uint32, uint32, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(uuuuuuu)";
 };
 
-template <> struct DBusTypeTrait<uint16_t>
+template <> struct DBusTypeTrait<JoinerCounters>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_UINT16;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT16_AS_STRING;
+    // struct of { uint32, uint32, uint32, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(uuuuu)";
 };
 
-template <> struct DBusTypeTrait<uint32_t>
+template <> struct DBusTypeTrait<AddressCacheEntry>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_UINT32;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT32_AS_STRING;
+    // struct of { array<uint8>, uint16, uint8 }
+    static constexpr const char *TYPE_AS_STRING = "(ayqy)";
 };
 
-template <> struct DBusTypeTrait<uint64_t>
+template <> struct DBusTypeTrait<AddressCacheCounters>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_UINT64;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_UINT64_AS_STRING;
+    // struct of { uint32, uint32, uint32, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(uuuuu)";
 };
 
-template <> struct DBusTypeTrait<int16_t>
+template <> struct DBusTypeTrait<OperationalDataset>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_INT16;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT16_AS_STRING;
+    // struct of { uint64, uint64, array<uint8>, string, uint64, array<uint8>, uint32, uint16, uint16, array<uint8>,
+    //             uint16, uint8, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(ttaystayuqqayqyuu)";
 };
 
-template <> struct DBusTypeTrait<int32_t>
+template <> struct DBusTypeTrait<Ip6AddressInfo>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_INT32;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT32_AS_STRING;
+    // struct of { array<uint8>, uint8, bool, bool, bool }
+    static constexpr const char *TYPE_AS_STRING = "(ayybbb)";
 };
 
-template <> struct DBusTypeTrait<int64_t>
+template <> struct DBusTypeTrait<LogLevel>
 {
-    static constexpr int         TYPE           = DBUS_TYPE_INT64;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_INT64_AS_STRING;
+    // struct of { string, int32 }
+    static constexpr const char *TYPE_AS_STRING = "(si)";
 };
 
-template <> struct DBusTypeTrait<std::string>
+template <> struct DBusTypeTrait<HistogramBucket>
+{
+    // struct of { uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(uu)";
+};
+
+template <> struct DBusTypeTrait<MainloopHistogram>
+{
+    static constexpr const char *TYPE_AS_STRING =
+        DBusStructSignature<std::string, uint64_t, uint64_t, uint32_t, std::vector<HistogramBucket>>::kValue;
+};
+
+template <> struct DBusTypeTrait<MemoryUsage>
+{
+    // struct of { string, uint64, uint64, uint64, uint64 }
+    static constexpr const char *TYPE_AS_STRING = "(stttt)";
+};
+
+template <> struct DBusTypeTrait<CounterRates>
+{
+    // struct of { string, uint32, uint64, uint32, uint32, uint32, uint32, uint32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(sutuuuuuu)";
+};
+
+template <> struct DBusTypeTrait<JoinerInfo>
+{
+    // struct of { uint64, string, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(tsu)";
+};
+
+template <> struct DBusTypeTrait<TopologyLink>
+{
+    // struct of { uint16, uint8, uint8 }
+    static constexpr const char *TYPE_AS_STRING = "(qyy)";
+};
+
+template <> struct DBusTypeTrait<TopologyChild>
+{
+    // struct of { uint16, uint8 }
+    static constexpr const char *TYPE_AS_STRING = "(qy)";
+};
+
+template <> struct DBusTypeTrait<TopologyNode>
+{
+    static constexpr const char *TYPE_AS_STRING =
+        DBusStructSignature<uint16_t, uint64_t, uint32_t, std::vector<TopologyLink>,
+                            std::vector<TopologyChild>>::kValue;
+};
+
+template <> struct DBusTypeTrait<LinkAlertRule>
+{
+    // struct of { uint32, string, bool, int32, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(usbiu)";
+};
+
+template <> struct DBusTypeTrait<LinkAlert>
+{
+    // struct of { uint32, uint64, bool, int32 }
+    static constexpr const char *TYPE_AS_STRING = "(utbi)";
+};
+
+template <> struct DBusTypeTrait<TableQuery>
+{
+    // struct of { uint32, uint32, bool, uint16, bool, uint64, uint8, uint8 }
+    static constexpr const char *TYPE_AS_STRING = "(uubqbtyy)";
+};
+
+template <> struct DBusTypeTrait<FlightRecord>
+{
+    // struct of { uint32, string, uint16, uint32, string }
+    static constexpr const char *TYPE_AS_STRING = "(usqus)";
+};
+
+template <> struct DBusTypeTrait<DBusCallStats>
+{
+    // struct of { string, string, uint8, uint32, uint32, uint64, uint32 }
+    static constexpr const char *TYPE_AS_STRING = "(ssyuutu)";
+};
+
+/**
+ * This trait tells whether the in-memory layout of a type matches a fixed-size D-Bus basic type, so that
+ * arrays of it can be appended and read in a single call.
+ *
+ */
+template <typename T> struct IsDBusFixedType : std::false_type
+{
+};
+
+template <> struct IsDBusFixedType<int8_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<uint8_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<uint16_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<uint32_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<uint64_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<int16_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<int32_t> : std::true_type
+{
+};
+
+template <> struct IsDBusFixedType<int64_t> : std::true_type
 {
-    static constexpr int         TYPE           = DBUS_TYPE_STRING;
-    static constexpr const char *TYPE_AS_STRING = DBUS_TYPE_STRING_AS_STRING;
 };
 
 otbrError DBusMessageEncode(DBusMessageIter *aIter, bool aValue);
 otbrError DBusMessageEncode(DBusMessageIter *aIter, int8_t aValue);
 otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::string &aValue);
 otbrError DBusMessageEncode(DBusMessageIter *aIter, const char *aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint8_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint16_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint32_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<uint64_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int16_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int32_t> &aValue);
-otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<int64_t> &aValue);
 otbrError DBusMessageExtract(DBusMessageIter *aIter, bool &aValue);
 otbrError DBusMessageExtract(DBusMessageIter *aIter, int8_t &aValue);
 otbrError DBusMessageExtract(DBusMessageIter *aIter, std::string &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint8_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint16_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint32_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<uint64_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int16_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int32_t> &aValue);
-otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<int64_t> &aValue);
+otbrError DBusMessageExtract(DBusMessageIter *aIter, const char *&aValue); // Points into the message.
 
 template <typename T> otbrError DBusMessageExtract(DBusMessageIter *aIter, T &aValue)
 {
@@ -263,28 +549,40 @@ exit:
     return error;
 }
 
-template <typename T> otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<T> &aValue)
+template <typename T> otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<T> &aValue);
+template <typename T> otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<T> &aValue);
+
+template <typename T>
+otbrError DBusMessageExtractArray(DBusMessageIter *aIter, std::vector<T> &aValue, std::false_type /* aIsFixed */)
 {
     otbrError       error = OTBR_ERROR_NONE;
     DBusMessageIter subIter;
+    size_t          count = 0;
 
     VerifyOrExit(dbus_message_iter_get_arg_type(aIter) == DBUS_TYPE_ARRAY, error = OTBR_ERROR_DBUS);
+    aValue.reserve(static_cast<size_t>(dbus_message_iter_get_element_count(aIter)));
     dbus_message_iter_recurse(aIter, &subIter);
 
-    aValue.clear();
+    // The elements left from a previous decode are decoded in place, reusing the memory of their strings and
+    // vectors, so a caller polling a table into the same vector does not allocate once it is large enough.
     while (dbus_message_iter_get_arg_type(&subIter) != DBUS_TYPE_INVALID)
     {
-        T val;
-        SuccessOrExit(error = DBusMessageExtract(&subIter, val));
-        aValue.push_back(val);
+        if (count == aValue.size())
+        {
+            aValue.emplace_back();
+        }
+        SuccessOrExit(error = DBusMessageExtract(&subIter, aValue[count]));
+        count++;
     }
+    aValue.resize(count);
     dbus_message_iter_next(aIter);
 
 exit:
     return error;
 }
 
-template <typename T> otbrError DBusMessageExtractPrimitive(DBusMessageIter *aIter, std::vector<T> &aValue)
+template <typename T>
+otbrError DBusMessageExtractArray(DBusMessageIter *aIter, std::vector<T> &aValue, std::true_type /* aIsFixed */)
 {
     DBusMessageIter subIter;
     otbrError       error = OTBR_ERROR_NONE;
@@ -295,15 +593,16 @@ template <typename T> otbrError DBusMessageExtractPrimitive(DBusMessageIter *aIt
     VerifyOrExit(dbus_message_iter_get_arg_type(aIter) == DBUS_TYPE_ARRAY, error = OTBR_ERROR_DBUS);
     dbus_message_iter_recurse(aIter, &subIter);
 
+    aValue.clear();
     subtype = dbus_message_iter_get_arg_type(&subIter);
     if (subtype != DBUS_TYPE_INVALID)
     {
-        VerifyOrExit(dbus_message_iter_get_arg_type(&subIter) == DBusTypeTrait<T>::TYPE, error = OTBR_ERROR_DBUS);
+        VerifyOrExit(subtype == DBusTypeTrait<T>::TYPE, error = OTBR_ERROR_DBUS);
         dbus_message_iter_get_fixed_array(&subIter, &val, &n);
 
         if (val != nullptr)
         {
-            aValue = std::vector<T>(val, val + n);
+            aValue.assign(val, val + n);
         }
     }
     dbus_message_iter_next(aIter);
@@ -312,6 +611,11 @@ exit:
     return error;
 }
 
+template <typename T> otbrError DBusMessageExtract(DBusMessageIter *aIter, std::vector<T> &aValue)
+{
+    return DBusMessageExtractArray(aIter, aValue, IsDBusFixedType<T>());
+}
+
 template <typename T, size_t SIZE> otbrError DBusMessageExtract(DBusMessageIter *aIter, std::array<T, SIZE> &aValue)
 {
     DBusMessageIter subIter;
@@ -350,7 +654,8 @@ exit:
     return error;
 }
 
-template <typename T> otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<T> &aValue)
+template <typename T>
+otbrError DBusMessageEncodeArray(DBusMessageIter *aIter, const std::vector<T> &aValue, std::false_type /* aIsFixed */)
 {
     otbrError       error = OTBR_ERROR_NONE;
     DBusMessageIter subIter;
@@ -368,7 +673,8 @@ exit:
     return error;
 }
 
-template <typename T> otbrError DBusMessageEncodePrimitive(DBusMessageIter *aIter, const std::vector<T> &aValue)
+template <typename T>
+otbrError DBusMessageEncodeArray(DBusMessageIter *aIter, const std::vector<T> &aValue, std::true_type /* aIsFixed */)
 {
     DBusMessageIter subIter;
     otbrError       error = OTBR_ERROR_NONE;
@@ -389,6 +695,11 @@ exit:
     return error;
 }
 
+template <typename T> otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::vector<T> &aValue)
+{
+    return DBusMessageEncodeArray(aIter, aValue, IsDBusFixedType<T>());
+}
+
 template <typename T, size_t SIZE>
 otbrError DBusMessageEncode(DBusMessageIter *aIter, const std::array<T, SIZE> &aValue)
 {
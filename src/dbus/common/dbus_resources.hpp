@@ -44,6 +44,13 @@ struct DBusMessageDeleter
 
 using UniqueDBusMessage = std::unique_ptr<DBusMessage, DBusMessageDeleter>;
 
+struct DBusConnectionDeleter
+{
+    void operator()(DBusConnection *aPointer) { dbus_connection_unref(aPointer); }
+};
+
+using UniqueDBusConnection = std::unique_ptr<DBusConnection, DBusConnectionDeleter>;
+
 } // namespace DBus
 } // namespace otbr
 
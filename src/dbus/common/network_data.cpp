@@ -0,0 +1,264 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements parsing the Thread Network Data.
+ */
+
+#include "dbus/common/network_data.hpp"
+
+#include <algorithm>
+
+#include "common/byteswap.hpp"
+#include "common/code_utils.hpp"
+#include "common/tlv.hpp"
+#include "common/types.hpp"
+
+namespace otbr {
+namespace DBus {
+
+namespace {
+
+using Encoding::BigEndian::ReadUint16;
+using Encoding::BigEndian::ReadUint32;
+
+enum
+{
+    kTypeHasRoute     = 0, ///< Has Route TLV
+    kTypePrefix       = 1, ///< Prefix TLV
+    kTypeBorderRouter = 2, ///< Border Router TLV
+    kTypeService      = 5, ///< Service TLV
+    kTypeServer       = 6, ///< Server TLV
+};
+
+enum
+{
+    kStableFlag             = 0x01,  ///< The stable flag in the type field.
+    kHasRouteEntrySize      = 3,     ///< Size of a Has Route TLV entry.
+    kBorderRouterEntrySize  = 4,     ///< Size of a Border Router TLV entry.
+    kServiceThreadFlag      = 0x80,  ///< The T flag of the Service TLV.
+    kServiceIdMask          = 0x0f,  ///< The S_id field of the Service TLV.
+    kThreadEnterpriseNumber = 44970, ///< The enterprise number implied by the T flag.
+};
+
+enum
+{
+    kBorderRouterPreferred    = 1 << 13,
+    kBorderRouterSlaac        = 1 << 12,
+    kBorderRouterDhcp         = 1 << 11,
+    kBorderRouterConfigure    = 1 << 10,
+    kBorderRouterDefaultRoute = 1 << 9,
+    kBorderRouterOnMesh       = 1 << 8,
+};
+
+uint8_t GetTlvType(const Tlv &aTlv)
+{
+    return aTlv.GetType() >> 1;
+}
+
+bool IsTlvStable(const Tlv &aTlv)
+{
+    return (aTlv.GetType() & kStableFlag) != 0;
+}
+
+TlvView GetSubTlvs(const uint8_t *aBegin, const uint8_t *aEnd)
+{
+    // The Network Data never uses extended lengths.
+    return TlvView(aBegin, static_cast<uint16_t>(aEnd - aBegin), /* aAllowExtended */ false);
+}
+
+int8_t PreferenceFromBits(uint8_t aBits)
+{
+    // A 2-bit signed integer as defined in RFC 4191, where the reserved value 0b10 is treated as medium.
+    return aBits == 1 ? 1 : (aBits == 3 ? -1 : 0);
+}
+
+otError ParsePrefix(const Tlv &aPrefixTlv, uint16_t aLocalRloc16, NetworkDataInfo &aInfo)
+{
+    const uint8_t *value = static_cast<const uint8_t *>(aPrefixTlv.GetValue());
+    const uint8_t *end   = value + aPrefixTlv.GetLength();
+    otError        error = OT_ERROR_NONE;
+    Ip6Prefix      prefix;
+    uint8_t        prefixBytes;
+    TlvView        subTlvs(nullptr, 0);
+
+    // Domain ID and prefix length in bits, followed by the prefix.
+    VerifyOrExit(end - value >= 2, error = OT_ERROR_PARSE);
+    prefix.mLength = value[1];
+    VerifyOrExit(prefix.mLength <= 128, error = OT_ERROR_PARSE);
+    prefixBytes = (prefix.mLength + 7) / 8;
+    VerifyOrExit(end - value >= 2 + prefixBytes, error = OT_ERROR_PARSE);
+
+    prefix.mPrefix.assign(OTBR_IP6_PREFIX_SIZE, 0);
+    std::copy(&value[2], &value[2] + std::min<uint8_t>(prefixBytes, OTBR_IP6_PREFIX_SIZE), prefix.mPrefix.begin());
+
+    subTlvs = GetSubTlvs(&value[2 + prefixBytes], end);
+    VerifyOrExit(subTlvs.IsValid(), error = OT_ERROR_PARSE);
+
+    for (const Tlv &sub : subTlvs)
+    {
+        const uint8_t *entry    = static_cast<const uint8_t *>(sub.GetValue());
+        const uint8_t *entryEnd = entry + sub.GetLength();
+
+        switch (GetTlvType(sub))
+        {
+        case kTypeHasRoute:
+            for (; entryEnd - entry >= kHasRouteEntrySize; entry += kHasRouteEntrySize)
+            {
+                ExternalRoute route;
+
+                route.mPrefix              = prefix;
+                route.mRloc16              = ReadUint16(entry);
+                route.mPreference          = PreferenceFromBits(entry[2] >> 6);
+                route.mStable              = IsTlvStable(sub);
+                route.mNextHopIsThisDevice = (route.mRloc16 == aLocalRloc16);
+                aInfo.mExternalRoutes.push_back(route);
+            }
+            break;
+
+        case kTypeBorderRouter:
+            for (; entryEnd - entry >= kBorderRouterEntrySize; entry += kBorderRouterEntrySize)
+            {
+                BorderRouterEntry borderRouter;
+                uint16_t          flags = ReadUint16(&entry[2]);
+
+                borderRouter.mConfig.mPrefix       = prefix;
+                borderRouter.mConfig.mPreference   = PreferenceFromBits(flags >> 14);
+                borderRouter.mConfig.mPreferred    = (flags & kBorderRouterPreferred) != 0;
+                borderRouter.mConfig.mSlaac        = (flags & kBorderRouterSlaac) != 0;
+                borderRouter.mConfig.mDhcp         = (flags & kBorderRouterDhcp) != 0;
+                borderRouter.mConfig.mConfigure    = (flags & kBorderRouterConfigure) != 0;
+                borderRouter.mConfig.mDefaultRoute = (flags & kBorderRouterDefaultRoute) != 0;
+                borderRouter.mConfig.mOnMesh       = (flags & kBorderRouterOnMesh) != 0;
+                borderRouter.mConfig.mStable       = IsTlvStable(sub);
+                borderRouter.mRloc16               = ReadUint16(entry);
+                aInfo.mOnMeshPrefixes.push_back(borderRouter);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+exit:
+    return error;
+}
+
+otError ParseService(const Tlv &aServiceTlv, NetworkDataInfo &aInfo)
+{
+    const uint8_t *value = static_cast<const uint8_t *>(aServiceTlv.GetValue());
+    const uint8_t *end   = value + aServiceTlv.GetLength();
+    otError        error = OT_ERROR_NONE;
+    ServiceEntry   service;
+    uint8_t        serviceDataLength;
+    TlvView        subTlvs(nullptr, 0);
+
+    VerifyOrExit(end - value >= 1, error = OT_ERROR_PARSE);
+    service.mServiceId = value[0] & kServiceIdMask;
+
+    if (value[0] & kServiceThreadFlag)
+    {
+        service.mEnterpriseNumber = kThreadEnterpriseNumber;
+        value += 1;
+    }
+    else
+    {
+        VerifyOrExit(end - value >= 5, error = OT_ERROR_PARSE);
+        service.mEnterpriseNumber = ReadUint32(&value[1]);
+        value += 5;
+    }
+
+    VerifyOrExit(end - value >= 1, error = OT_ERROR_PARSE);
+    serviceDataLength = value[0];
+    VerifyOrExit(end - value >= 1 + serviceDataLength, error = OT_ERROR_PARSE);
+    service.mServiceData.assign(&value[1], &value[1] + serviceDataLength);
+    value += 1 + serviceDataLength;
+
+    subTlvs = GetSubTlvs(value, end);
+    VerifyOrExit(subTlvs.IsValid(), error = OT_ERROR_PARSE);
+
+    for (const Tlv &sub : subTlvs)
+    {
+        const uint8_t *server;
+
+        if (GetTlvType(sub) != kTypeServer)
+        {
+            continue;
+        }
+
+        VerifyOrExit(sub.GetLength() >= sizeof(uint16_t), error = OT_ERROR_PARSE);
+
+        server                = static_cast<const uint8_t *>(sub.GetValue());
+        service.mServerRloc16 = ReadUint16(server);
+        service.mServerData.assign(&server[2], server + sub.GetLength());
+        service.mStable = IsTlvStable(sub);
+        aInfo.mServices.push_back(service);
+    }
+
+exit:
+    return error;
+}
+
+} // namespace
+
+otError ParseNetworkData(const uint8_t *aData, uint16_t aLength, uint16_t aLocalRloc16, NetworkDataInfo &aInfo)
+{
+    TlvView tlvs  = GetSubTlvs(aData, aData + aLength);
+    otError error = OT_ERROR_NONE;
+
+    aInfo.mOnMeshPrefixes.clear();
+    aInfo.mExternalRoutes.clear();
+    aInfo.mServices.clear();
+
+    VerifyOrExit(tlvs.IsValid(), error = OT_ERROR_PARSE);
+
+    for (const Tlv &tlv : tlvs)
+    {
+        switch (GetTlvType(tlv))
+        {
+        case kTypePrefix:
+            SuccessOrExit(error = ParsePrefix(tlv, aLocalRloc16, aInfo));
+            break;
+
+        case kTypeService:
+            SuccessOrExit(error = ParseService(tlv, aInfo));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+exit:
+    return error;
+}
+
+} // namespace DBus
+} // namespace otbr
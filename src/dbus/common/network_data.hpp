@@ -0,0 +1,67 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for parsing the Thread Network Data.
+ */
+
+#ifndef OTBR_DBUS_COMMON_NETWORK_DATA_HPP_
+#define OTBR_DBUS_COMMON_NETWORK_DATA_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+#include "dbus/common/types.hpp"
+
+namespace otbr {
+namespace DBus {
+
+/**
+ * This function parses the Thread Network Data TLVs into on-mesh prefix, external route and service entries.
+ *
+ * Unknown TLVs and sub-TLVs are skipped. The versions in @p aInfo are left untouched.
+ *
+ * @param[in]   aData         A pointer to the Network Data TLVs.
+ * @param[in]   aLength       The length of the Network Data TLVs.
+ * @param[in]   aLocalRloc16  The RLOC16 of this device, used to tell the external routes it provides.
+ * @param[out]  aInfo         A reference to where the parsed entries are put.
+ *
+ * @retval OT_ERROR_NONE   Successfully parsed the Network Data.
+ * @retval OT_ERROR_PARSE  The Network Data is malformed.
+ *
+ */
+otError ParseNetworkData(const uint8_t *aData, uint16_t aLength, uint16_t aLocalRloc16, NetworkDataInfo &aInfo);
+
+} // namespace DBus
+} // namespace otbr
+
+#endif // OTBR_DBUS_COMMON_NETWORK_DATA_HPP_
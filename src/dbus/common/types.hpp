@@ -48,6 +48,29 @@ enum DeviceRole
     OTBR_DEVICE_ROLE_LEADER   = 4,
 };
 
+enum DatasetComponent
+{
+    OTBR_DATASET_ACTIVE_TIMESTAMP  = 1 << 0,
+    OTBR_DATASET_PENDING_TIMESTAMP = 1 << 1,
+    OTBR_DATASET_MASTER_KEY        = 1 << 2,
+    OTBR_DATASET_NETWORK_NAME      = 1 << 3,
+    OTBR_DATASET_EXTENDED_PAN_ID   = 1 << 4,
+    OTBR_DATASET_MESH_LOCAL_PREFIX = 1 << 5,
+    OTBR_DATASET_DELAY             = 1 << 6,
+    OTBR_DATASET_PAN_ID            = 1 << 7,
+    OTBR_DATASET_CHANNEL           = 1 << 8,
+    OTBR_DATASET_PSKC              = 1 << 9,
+    OTBR_DATASET_SECURITY_POLICY   = 1 << 10,
+    OTBR_DATASET_CHANNEL_MASK      = 1 << 11,
+};
+
+enum DBusCallKind
+{
+    OTBR_DBUS_CALL_METHOD       = 0,
+    OTBR_DBUS_CALL_GET_PROPERTY = 1,
+    OTBR_DBUS_CALL_SET_PROPERTY = 2,
+};
+
 struct ActiveScanResult
 {
     uint64_t             mExtAddress;    ///< IEEE 802.15.4 Extended Address
@@ -479,6 +502,18 @@ struct NeighborInfo
     bool     mIsChild;           ///< Is the neighbor a child
 };
 
+/**
+ * This structure represents the changes of a table since a given version.
+ *
+ */
+template <typename EntryType> struct TableDelta
+{
+    bool                   mReset;   ///< Whether mUpdated holds the full table
+    std::vector<EntryType> mUpdated; ///< Entries added or changed since the requested version
+    std::vector<uint64_t>  mRemoved; ///< Extended addresses of the removed entries
+    uint32_t               mVersion; ///< Version to pass in the next request
+};
+
 struct LeaderData
 {
     uint32_t mPartitionId;       ///< Partition ID
@@ -488,6 +523,243 @@ struct LeaderData
     uint8_t  mLeaderRouterId;    ///< Leader Router ID
 };
 
+struct BorderRouterEntry
+{
+    OnMeshPrefix mConfig; ///< The on-mesh prefix configuration
+    uint16_t     mRloc16; ///< The RLOC16 of the border router serving the prefix
+};
+
+struct ServiceEntry
+{
+    uint32_t             mEnterpriseNumber; ///< IANA enterprise number
+    uint8_t              mServiceId;        ///< Service ID assigned by the leader
+    std::vector<uint8_t> mServiceData;      ///< Service data
+    uint16_t             mServerRloc16;     ///< The RLOC16 of the server
+    std::vector<uint8_t> mServerData;       ///< Server data
+    bool                 mStable;           ///< Whether the server entry is in the stable network data
+};
+
+/**
+ * This structure represents the parsed Thread Network Data.
+ *
+ */
+struct NetworkDataInfo
+{
+    uint8_t                        mVersion;        ///< Full Network Data Version
+    uint8_t                        mStableVersion;  ///< Stable Network Data Version
+    std::vector<BorderRouterEntry> mOnMeshPrefixes; ///< One entry per border router of each on-mesh prefix
+    std::vector<ExternalRoute>     mExternalRoutes; ///< One entry per border router of each external route
+    std::vector<ServiceEntry>      mServices;       ///< One entry per server of each service
+};
+
+struct MainloopCounters
+{
+    uint64_t mWakeups;          ///< The number of times the agent main loop returned from polling.
+    uint64_t mZeroTimeoutPolls; ///< The number of polls entered with a zero timeout.
+    uint64_t mSpuriousWakeups;  ///< The number of wakeups with neither a ready fd nor a due timer.
+};
+
+struct DBusQueueCounters
+{
+    uint32_t mOutgoingBytes;     ///< The bytes waiting to be written to the bus.
+    uint32_t mPeakOutgoingBytes; ///< The largest number of bytes seen waiting to be written to the bus.
+    uint32_t mCoalescedSignals;  ///< The PropertiesChanged signals held back while the outgoing queue was full.
+    uint32_t mDroppedSignals;    ///< The other signals dropped while the outgoing queue was full.
+    uint32_t mThrottledRequests; ///< The method calls refused because their sender exceeded its request rate.
+};
+
+struct OperationQueueCounters
+{
+    uint32_t mDepth;         ///< The scan, attach and joiner start requests waiting now.
+    uint32_t mPeakDepth;     ///< The largest number of requests seen waiting.
+    uint32_t mQueued;        ///< The requests which had to wait for a conflicting operation.
+    uint32_t mMerged;        ///< The scan requests merged into a scan already waiting.
+    uint32_t mRejected;      ///< The requests rejected as too many were waiting.
+    uint32_t mTotalWaitTime; ///< The total time the started requests waited, in milliseconds.
+    uint32_t mMaxWaitTime;   ///< The longest time a started request waited, in milliseconds.
+};
+
+struct JoinerCounters
+{
+    uint32_t mCachedChannelAttempts; ///< The joins tried on the channel of the last successful join first.
+    uint32_t mCachedChannelJoins;    ///< The joins which succeeded on the channel of the last successful join.
+    uint32_t mFullDiscoveries;       ///< The joins which discovered the joiner routers on all channels.
+    uint32_t mLastCachedChannelTime; ///< The duration of the last join on the cached channel, in milliseconds.
+    uint32_t mLastFullDiscoveryTime; ///< The duration of the last join with full discovery, in milliseconds.
+};
+
+struct AddressCacheEntry
+{
+    std::vector<uint8_t> mTarget; ///< The EID.
+    uint16_t             mRloc16; ///< The RLOC16 of the EID, if not querying.
+    uint8_t              mState;  ///< The state: 0 cached, 1 snooped, 2 querying, 3 retrying a failed query.
+};
+
+struct AddressCacheCounters
+{
+    uint32_t mQueries;   ///< The address queries started.
+    uint32_t mResponses; ///< The address queries answered by an address notification.
+    uint32_t mFailures;  ///< The address queries which had no answer in time.
+    uint32_t mEvictions; ///< The resolved entries removed, to make room for others or as stale.
+    uint32_t mPeakSize;  ///< The largest number of entries seen.
+};
+
+struct HistogramBucket
+{
+    uint32_t mLowerBound; ///< The smallest value in the bucket, in microseconds.
+    uint32_t mCount;      ///< The number of samples in the bucket.
+};
+
+struct MainloopHistogram
+{
+    std::string                  mStage;   ///< The main loop stage name.
+    uint64_t                     mCount;   ///< The number of samples.
+    uint64_t                     mSum;     ///< The sum of samples, in microseconds.
+    uint32_t                     mMax;     ///< The largest sample, in microseconds.
+    std::vector<HistogramBucket> mBuckets; ///< The non-empty buckets, in ascending order.
+};
+
+struct MemoryUsage
+{
+    std::string mSubsystem;        ///< The subsystem name.
+    uint64_t    mBytes;            ///< The number of bytes currently allocated.
+    uint64_t    mPeakBytes;        ///< The largest number of bytes allocated at once.
+    uint64_t    mAllocations;      ///< The number of allocations currently alive.
+    uint64_t    mTotalAllocations; ///< The number of allocations ever made.
+};
+
+struct JoinerInfo
+{
+    uint64_t    mEui64;   ///< The EUI-64 of the joiner, 0 for any joiner.
+    std::string mPskd;    ///< The pre-shared key of the joiner.
+    uint32_t    mTimeout; ///< The time the joiner is accepted for, in seconds.
+};
+
+struct CounterRates
+{
+    std::string mCounter; ///< The counter name.
+    uint32_t    mWindow;  ///< The duration covered by the history, in milliseconds.
+    uint64_t    mDelta;   ///< The increase of the counter over the window.
+    uint32_t    mMean;    ///< The mean rate over the window, in thousandths of events per second.
+    uint32_t    mMin;     ///< The lowest rate of a sample interval, in thousandths of events per second.
+    uint32_t    mMax;     ///< The highest rate of a sample interval, in thousandths of events per second.
+    uint32_t    mP50;     ///< The median rate of the sample intervals, in thousandths of events per second.
+    uint32_t    mP90;     ///< The 90th percentile rate of the sample intervals, in thousandths of events per second.
+    uint32_t    mP99;     ///< The 99th percentile rate of the sample intervals, in thousandths of events per second.
+};
+
+struct TopologyLink
+{
+    uint16_t mRloc16;         ///< The RLOC16 of the neighboring router.
+    uint8_t  mLinkQualityIn;  ///< The incoming link quality.
+    uint8_t  mLinkQualityOut; ///< The outgoing link quality.
+};
+
+struct TopologyChild
+{
+    uint16_t mRloc16; ///< The RLOC16 of the child.
+    uint8_t  mMode;   ///< The link mode of the child, as in the Mode TLV.
+};
+
+struct OperationalDataset
+{
+    uint64_t             mActiveTimestamp;            ///< The active timestamp.
+    uint64_t             mPendingTimestamp;           ///< The pending timestamp.
+    std::vector<uint8_t> mMasterKey;                  ///< The master key.
+    std::string          mNetworkName;                ///< The network name.
+    uint64_t             mExtendedPanId;              ///< The extended PAN ID.
+    std::vector<uint8_t> mMeshLocalPrefix;            ///< The mesh-local prefix.
+    uint32_t             mDelay;                      ///< The delay timer, in milliseconds.
+    uint16_t             mPanId;                      ///< The PAN ID.
+    uint16_t             mChannel;                    ///< The channel.
+    std::vector<uint8_t> mPskc;                       ///< The PSKc.
+    uint16_t             mSecurityPolicyRotationTime; ///< The key rotation time, in hours.
+    uint8_t              mSecurityPolicyFlags;        ///< The security policy flags.
+    uint32_t             mChannelMask;                ///< The channel mask.
+    uint32_t             mComponents;                 ///< The present components, a bitmask of DatasetComponent.
+};
+
+struct Ip6AddressInfo
+{
+    std::vector<uint8_t> mAddress;      ///< The IPv6 address.
+    uint8_t              mPrefixLength; ///< The prefix length, in bits.
+    bool                 mPreferred;    ///< Whether the address is preferred.
+    bool                 mValid;        ///< Whether the address is valid.
+    bool                 mRloc;         ///< Whether the address is a Thread RLOC or ALOC.
+};
+
+struct Ip6AddressesChange
+{
+    std::vector<Ip6AddressInfo>       mUpdatedUnicast;        ///< The unicast addresses added or changed.
+    std::vector<std::vector<uint8_t>> mRemovedUnicast;        ///< The unicast addresses removed.
+    std::vector<std::vector<uint8_t>> mSubscribedMulticast;   ///< The multicast addresses subscribed.
+    std::vector<std::vector<uint8_t>> mUnsubscribedMulticast; ///< The multicast addresses unsubscribed.
+};
+
+struct LogLevel
+{
+    std::string mModule; ///< The name of the logging module, "default" for the default log level.
+    int32_t     mLevel;  ///< The syslog level, or -1 if the module follows the default log level.
+};
+
+struct LinkAlertRule
+{
+    uint32_t    mId;         ///< The rule ID, ignored when adding a rule.
+    std::string mMetric;     ///< The metric name, such as "Rssi" or "FrameErrorRate".
+    bool        mAbove;      ///< Whether the alert is raised above the threshold, rather than below it.
+    int32_t     mThreshold;  ///< The threshold.
+    uint32_t    mHysteresis; ///< The distance past the threshold a sample must come back to clear the alert.
+};
+
+struct LinkAlert
+{
+    uint32_t mRuleId;     ///< The rule ID.
+    uint64_t mExtAddress; ///< The extended address of the neighbor, 0 for the metrics of the radio.
+    bool     mRaised;     ///< Whether the alert is raised, rather than cleared.
+    int32_t  mValue;      ///< The sample that crossed the threshold.
+};
+
+struct TableQuery
+{
+    uint32_t mOffset;         ///< The number of matching entries to skip.
+    uint32_t mLimit;          ///< The max number of entries to return, 0 for no limit.
+    bool     mHasRloc16;      ///< Whether to match the RLOC16.
+    uint16_t mRloc16;         ///< The RLOC16 of the entries to return.
+    bool     mHasExtAddress;  ///< Whether to match the extended address.
+    uint64_t mExtAddress;     ///< The extended address of the entries to return.
+    uint8_t  mMinLinkQuality; ///< The lowest incoming link quality of the entries to return.
+    uint8_t  mMaxLinkQuality; ///< The highest incoming link quality of the entries to return, at most 3.
+};
+
+struct FlightRecord
+{
+    uint32_t    mAge;   ///< The time since the event, in milliseconds.
+    std::string mEvent; ///< The event name, such as "StateChanged" or "DBusCall".
+    uint16_t    mCode;  ///< The code of the event.
+    uint32_t    mValue; ///< The value of the event.
+    std::string mText;  ///< The text of the event, truncated.
+};
+
+struct DBusCallStats
+{
+    std::string mInterface; ///< The interface name.
+    std::string mMember;    ///< The method or property name.
+    uint8_t     mKind;      ///< The kind of the calls, a DBusCallKind.
+    uint32_t    mCalls;     ///< The number of calls.
+    uint32_t    mErrors;    ///< The number of calls which failed.
+    uint64_t    mTotalTime; ///< The cumulative duration of the calls, in microseconds.
+    uint32_t    mMaxTime;   ///< The longest duration of a call, in microseconds.
+};
+
+struct TopologyNode
+{
+    uint16_t                   mRloc16;     ///< The RLOC16 of the router.
+    uint64_t                   mExtAddress; ///< The extended address of the router, 0 if not known.
+    uint32_t                   mAge;        ///< The time since the router last responded, in milliseconds.
+    std::vector<TopologyLink>  mLinks;      ///< The links to the neighboring routers.
+    std::vector<TopologyChild> mChildren;   ///< The children.
+};
+
 } // namespace DBus
 } // namespace otbr
 
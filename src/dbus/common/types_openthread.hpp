@@ -0,0 +1,254 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * This file includes the conversions between the otbr D-Bus types and the OpenThread types.
+ */
+
+#ifndef OTBR_DBUS_COMMON_TYPES_OPENTHREAD_HPP_
+#define OTBR_DBUS_COMMON_TYPES_OPENTHREAD_HPP_
+
+#include <algorithm>
+
+#include <openthread/border_router.h>
+#include <openthread/thread_ftd.h>
+
+#include "common/byteswap.hpp"
+#include "common/types.hpp"
+#include "dbus/common/types.hpp"
+
+namespace otbr {
+namespace DBus {
+
+/**
+ * This function converts an OpenThread extended address to its D-Bus representation.
+ *
+ * @param[in]   aExtAddress     The extended address.
+ *
+ * @returns The extended address as a big-endian integer.
+ *
+ */
+constexpr uint64_t ConvertToUint64(const otExtAddress &aExtAddress)
+{
+    return Encoding::BigEndian::ReadUint64(aExtAddress.m8);
+}
+
+/**
+ * This function converts an OpenThread extended PAN ID to its D-Bus representation.
+ *
+ * @param[in]   aExtPanId   The extended PAN ID.
+ *
+ * @returns The extended PAN ID as a big-endian integer.
+ *
+ */
+constexpr uint64_t ConvertToUint64(const otExtendedPanId &aExtPanId)
+{
+    return Encoding::BigEndian::ReadUint64(aExtPanId.m8);
+}
+
+/**
+ * This function converts the D-Bus representation of an extended PAN ID to the OpenThread one.
+ *
+ * @param[in]   aExtPanId   The extended PAN ID as a big-endian integer.
+ *
+ * @returns The extended PAN ID.
+ *
+ */
+inline otExtendedPanId ConvertToOtExtendedPanId(uint64_t aExtPanId)
+{
+    otExtendedPanId extPanId;
+
+    Encoding::BigEndian::WriteUint64(aExtPanId, extPanId.m8);
+
+    return extPanId;
+}
+
+/**
+ * This function converts the link fields shared by the OpenThread child and neighbor information.
+ *
+ * @param[in]   aOtInfo     The OpenThread child or neighbor information.
+ * @param[out]  aInfo       The D-Bus child or neighbor information.
+ *
+ */
+template <typename OtInfoType, typename InfoType>
+inline void ConvertLinkInfo(const OtInfoType &aOtInfo, InfoType &aInfo)
+{
+    aInfo.mExtAddress        = ConvertToUint64(aOtInfo.mExtAddress);
+    aInfo.mAge               = aOtInfo.mAge;
+    aInfo.mRloc16            = aOtInfo.mRloc16;
+    aInfo.mLinkQualityIn     = aOtInfo.mLinkQualityIn;
+    aInfo.mAverageRssi       = aOtInfo.mAverageRssi;
+    aInfo.mLastRssi          = aOtInfo.mLastRssi;
+    aInfo.mFrameErrorRate    = aOtInfo.mFrameErrorRate;
+    aInfo.mMessageErrorRate  = aOtInfo.mMessageErrorRate;
+    aInfo.mRxOnWhenIdle      = aOtInfo.mRxOnWhenIdle;
+    aInfo.mSecureDataRequest = aOtInfo.mSecureDataRequest;
+    aInfo.mFullThreadDevice  = aOtInfo.mFullThreadDevice;
+    aInfo.mFullNetworkData   = aOtInfo.mFullNetworkData;
+}
+
+/**
+ * This function converts the OpenThread child information.
+ *
+ * @param[in]   aChildInfo  The OpenThread child information.
+ * @param[out]  aInfo       The D-Bus child information.
+ *
+ */
+inline void Convert(const otChildInfo &aChildInfo, ChildInfo &aInfo)
+{
+    ConvertLinkInfo(aChildInfo, aInfo);
+    aInfo.mTimeout            = aChildInfo.mTimeout;
+    aInfo.mChildId            = aChildInfo.mChildId;
+    aInfo.mNetworkDataVersion = aChildInfo.mNetworkDataVersion;
+    aInfo.mIsStateRestoring   = aChildInfo.mIsStateRestoring;
+}
+
+/**
+ * This function converts the OpenThread neighbor information.
+ *
+ * @param[in]   aNeighborInfo   The OpenThread neighbor information.
+ * @param[out]  aInfo           The D-Bus neighbor information.
+ *
+ */
+inline void Convert(const otNeighborInfo &aNeighborInfo, NeighborInfo &aInfo)
+{
+    ConvertLinkInfo(aNeighborInfo, aInfo);
+    aInfo.mLinkFrameCounter = aNeighborInfo.mLinkFrameCounter;
+    aInfo.mMleFrameCounter  = aNeighborInfo.mMleFrameCounter;
+    aInfo.mIsChild          = aNeighborInfo.mIsChild;
+}
+
+/**
+ * This function converts the D-Bus IPv6 prefix to the OpenThread one.
+ *
+ * The bytes after the prefix are cleared, and a prefix longer than an IPv6 address is truncated.
+ *
+ * @param[in]   aPrefix     The D-Bus IPv6 prefix.
+ * @param[out]  aOtPrefix   The OpenThread IPv6 prefix.
+ *
+ */
+inline void Convert(const Ip6Prefix &aPrefix, otIp6Prefix &aOtPrefix)
+{
+    size_t length = std::min(aPrefix.mPrefix.size(), sizeof(aOtPrefix.mPrefix.mFields.m8));
+
+    aOtPrefix = otIp6Prefix();
+    std::copy(aPrefix.mPrefix.begin(), aPrefix.mPrefix.begin() + static_cast<ptrdiff_t>(length),
+              aOtPrefix.mPrefix.mFields.m8);
+    aOtPrefix.mLength = aPrefix.mLength;
+}
+
+/**
+ * This function converts the OpenThread IPv6 prefix to the D-Bus one.
+ *
+ * @param[in]   aOtPrefix   The OpenThread IPv6 prefix.
+ * @param[out]  aPrefix     The D-Bus IPv6 prefix, of the 8 bytes of a Thread prefix.
+ *
+ */
+inline void Convert(const otIp6Prefix &aOtPrefix, Ip6Prefix &aPrefix)
+{
+    aPrefix.mPrefix.assign(aOtPrefix.mPrefix.mFields.m8, aOtPrefix.mPrefix.mFields.m8 + OTBR_IP6_PREFIX_SIZE);
+    aPrefix.mLength = aOtPrefix.mLength;
+}
+
+/**
+ * This function converts the D-Bus on-mesh prefix to the OpenThread border router configuration.
+ *
+ * @param[in]   aPrefix     The D-Bus on-mesh prefix.
+ * @param[out]  aConfig     The OpenThread border router configuration, whose other fields are cleared.
+ *
+ */
+inline void Convert(const OnMeshPrefix &aPrefix, otBorderRouterConfig &aConfig)
+{
+    aConfig = otBorderRouterConfig();
+    Convert(aPrefix.mPrefix, aConfig.mPrefix);
+    aConfig.mPreference   = aPrefix.mPreference;
+    aConfig.mPreferred    = aPrefix.mPreferred;
+    aConfig.mSlaac        = aPrefix.mSlaac;
+    aConfig.mDhcp         = aPrefix.mDhcp;
+    aConfig.mConfigure    = aPrefix.mConfigure;
+    aConfig.mDefaultRoute = aPrefix.mDefaultRoute;
+    aConfig.mOnMesh       = aPrefix.mOnMesh;
+    aConfig.mStable       = aPrefix.mStable;
+}
+
+/**
+ * This function converts the OpenThread border router configuration to the D-Bus on-mesh prefix.
+ *
+ * @param[in]   aConfig     The OpenThread border router configuration.
+ * @param[out]  aPrefix     The D-Bus on-mesh prefix.
+ *
+ */
+inline void Convert(const otBorderRouterConfig &aConfig, OnMeshPrefix &aPrefix)
+{
+    Convert(aConfig.mPrefix, aPrefix.mPrefix);
+    aPrefix.mPreference   = static_cast<int8_t>(aConfig.mPreference);
+    aPrefix.mPreferred    = aConfig.mPreferred;
+    aPrefix.mSlaac        = aConfig.mSlaac;
+    aPrefix.mDhcp         = aConfig.mDhcp;
+    aPrefix.mConfigure    = aConfig.mConfigure;
+    aPrefix.mDefaultRoute = aConfig.mDefaultRoute;
+    aPrefix.mOnMesh       = aConfig.mOnMesh;
+    aPrefix.mStable       = aConfig.mStable;
+}
+
+/**
+ * This function converts the D-Bus external route to the OpenThread external route configuration.
+ *
+ * @param[in]   aRoute      The D-Bus external route.
+ * @param[out]  aConfig     The OpenThread external route configuration, whose other fields are cleared.
+ *
+ */
+inline void Convert(const ExternalRoute &aRoute, otExternalRouteConfig &aConfig)
+{
+    aConfig = otExternalRouteConfig();
+    Convert(aRoute.mPrefix, aConfig.mPrefix);
+    aConfig.mPreference = aRoute.mPreference;
+    aConfig.mStable     = aRoute.mStable;
+}
+
+/**
+ * This function converts the OpenThread external route configuration to the D-Bus external route.
+ *
+ * @param[in]   aConfig     The OpenThread external route configuration.
+ * @param[out]  aRoute      The D-Bus external route.
+ *
+ */
+inline void Convert(const otExternalRouteConfig &aConfig, ExternalRoute &aRoute)
+{
+    Convert(aConfig.mPrefix, aRoute.mPrefix);
+    aRoute.mRloc16              = aConfig.mRloc16;
+    aRoute.mPreference          = static_cast<int8_t>(aConfig.mPreference);
+    aRoute.mStable              = aConfig.mStable;
+    aRoute.mNextHopIsThisDevice = aConfig.mNextHopIsThisDevice;
+}
+
+} // namespace DBus
+} // namespace otbr
+
+#endif // OTBR_DBUS_COMMON_TYPES_OPENTHREAD_HPP_
@@ -26,31 +26,50 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_DBUS
+
 #include "dbus/server/dbus_agent.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
 #include "dbus/common/constants.hpp"
 
+/**
+ * The max number of peer-to-peer connections accepted at once by the private D-Bus server.
+ *
+ */
+#ifndef OTBR_CONFIG_DBUS_MAX_PEERS
+#define OTBR_CONFIG_DBUS_MAX_PEERS 4
+#endif
+
+/**
+ * The max number of D-Bus messages dispatched in one main loop iteration.
+ *
+ */
+#ifndef OTBR_CONFIG_DBUS_DISPATCH_BUDGET
+#define OTBR_CONFIG_DBUS_DISPATCH_BUDGET 16
+#endif
+
 namespace otbr {
 namespace DBus {
 
-const struct timeval DBusAgent::kPollTimeout = {0, 0};
-
 DBusAgent::DBusAgent(const std::string &aInterfaceName, otbr::Ncp::ControllerOpenThread *aNcp)
     : mInterfaceName(aInterfaceName)
     , mNcp(aNcp)
 {
 }
 
-otbrError DBusAgent::Init(void)
+otbrError DBusAgent::Connect(void)
 {
-    DBusError   dbusError;
-    otbrError   error = OTBR_ERROR_NONE;
-    int         requestReply;
-    std::string serverName = OTBR_DBUS_SERVER_PREFIX + mInterfaceName;
+    DBusError       dbusError;
+    otbrError       error = OTBR_ERROR_NONE;
+    int             requestReply;
+    std::string     serverName = OTBR_DBUS_SERVER_PREFIX + mInterfaceName;
+    DBusConnection *conn;
 
     dbus_error_init(&dbusError);
-    DBusConnection *conn = dbus_bus_get(DBUS_BUS_SYSTEM, &dbusError);
-    mConnection          = std::unique_ptr<DBusConnection, std::function<void(DBusConnection *)>>(
+    VerifyOrExit(mConnection == nullptr);
+    conn        = dbus_bus_get(DBUS_BUS_SYSTEM, &dbusError);
+    mConnection = std::unique_ptr<DBusConnection, std::function<void(DBusConnection *)>>(
         conn, [](DBusConnection *aConnection) { dbus_connection_unref(aConnection); });
     VerifyOrExit(mConnection != nullptr, error = OTBR_ERROR_DBUS);
     dbus_bus_register(mConnection.get(), &dbusError);
@@ -61,17 +80,148 @@ otbrError DBusAgent::Init(void)
                  error = OTBR_ERROR_DBUS);
     VerifyOrExit(dbus_connection_set_watch_functions(mConnection.get(), AddDBusWatch, RemoveDBusWatch, ToggleDBusWatch,
                                                      this, NULL));
-    mThreadObject = std::unique_ptr<DBusThreadObject>(new DBusThreadObject(mConnection.get(), mInterfaceName, mNcp));
-    error         = mThreadObject->Init();
+    LogStartupMilestone("D-Bus connected");
 exit:
     dbus_error_free(&dbusError);
     if (error != OTBR_ERROR_NONE)
     {
+        mConnection.reset();
         otbrLog(OTBR_LOG_ERR, "dbus error %s: %s", dbusError.name, dbusError.message);
     }
     return error;
 }
 
+otbrError DBusAgent::Init(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    if (mConnection == nullptr)
+    {
+        SuccessOrExit(error = Connect());
+    }
+
+    VerifyOrExit(mConnection != nullptr, error = OTBR_ERROR_DBUS);
+    mThreadObject = std::unique_ptr<DBusThreadObject>(new DBusThreadObject(mConnection.get(), mInterfaceName, mNcp));
+    SuccessOrExit(error = mThreadObject->Init());
+
+    if (!mPeerAddress.empty())
+    {
+        error = ListenPeers();
+    }
+
+exit:
+    return error;
+}
+
+otbrError DBusAgent::ListenPeers(void)
+{
+    DBusError dbusError;
+    otbrError error = OTBR_ERROR_NONE;
+
+    dbus_error_init(&dbusError);
+    mPeerServer = UniqueDBusServer(dbus_server_listen(mPeerAddress.c_str(), &dbusError), [](DBusServer *aServer) {
+        dbus_server_disconnect(aServer);
+        dbus_server_unref(aServer);
+    });
+    VerifyOrExit(mPeerServer != nullptr, error = OTBR_ERROR_DBUS);
+    dbus_server_set_new_connection_function(mPeerServer.get(), HandleNewConnection, this, NULL);
+    VerifyOrExit(dbus_server_set_watch_functions(mPeerServer.get(), AddDBusWatch, RemoveDBusWatch, ToggleDBusWatch,
+                                                 this, NULL),
+                 error = OTBR_ERROR_DBUS);
+    otbrLog(OTBR_LOG_INFO, "D-Bus peer server listening on %s", mPeerAddress.c_str());
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        mPeerServer.reset();
+        otbrLog(OTBR_LOG_ERR, "Failed to listen on %s: %s", mPeerAddress.c_str(),
+                dbus_error_is_set(&dbusError) ? dbusError.message : "no memory");
+    }
+
+    dbus_error_free(&dbusError);
+    return error;
+}
+
+void DBusAgent::HandleNewConnection(DBusServer *aServer, DBusConnection *aConnection, void *aContext)
+{
+    (void)aServer;
+    static_cast<DBusAgent *>(aContext)->HandleNewConnection(aConnection);
+}
+
+void DBusAgent::HandleNewConnection(DBusConnection *aConnection)
+{
+    // The server drops the connection unless a reference is kept.
+    UniqueDBusConnection connection(dbus_connection_ref(aConnection), [](DBusConnection *aPeer) {
+        dbus_connection_close(aPeer);
+        dbus_connection_unref(aPeer);
+    });
+
+    VerifyOrExit(mPeerConnections.size() < OTBR_CONFIG_DBUS_MAX_PEERS,
+                 otbrLog(OTBR_LOG_WARNING, "D-Bus peer refused, %zu peers connected", mPeerConnections.size()));
+    VerifyOrExit(dbus_connection_set_watch_functions(aConnection, AddDBusWatch, RemoveDBusWatch, ToggleDBusWatch, this,
+                                                     NULL));
+    VerifyOrExit(mThreadObject->AttachConnection(aConnection) == OTBR_ERROR_NONE);
+
+    mPeerConnections.push_back(std::move(connection));
+    otbrLog(OTBR_LOG_INFO, "D-Bus peer connected, %zu peers connected", mPeerConnections.size());
+
+exit:
+    return;
+}
+
+void DBusAgent::RemoveDisconnectedPeers(void)
+{
+    for (auto it = mPeerConnections.begin(); it != mPeerConnections.end();)
+    {
+        if (dbus_connection_get_is_connected(it->get()))
+        {
+            ++it;
+            continue;
+        }
+
+        mThreadObject->DetachConnection(it->get());
+        it = mPeerConnections.erase(it);
+        otbrLog(OTBR_LOG_INFO, "D-Bus peer disconnected, %zu peers connected", mPeerConnections.size());
+    }
+}
+
+void DBusAgent::DispatchMessages(void)
+{
+    uint32_t budget = OTBR_CONFIG_DBUS_DISPATCH_BUDGET;
+    bool     dispatched;
+
+    // The connections take turns with one message each, the messages left over the budget are dispatched in the next
+    // iterations so that the radio is processed in between. UpdateFdSet() doesn't wait while any are pending.
+    do
+    {
+        dispatched = false;
+
+        for (size_t i = 0; i <= mPeerConnections.size() && budget > 0; i++)
+        {
+            DBusConnection *connection = (i == 0) ? mConnection.get() : mPeerConnections[i - 1].get();
+
+            if (dbus_connection_get_dispatch_status(connection) == DBUS_DISPATCH_DATA_REMAINS)
+            {
+                dbus_connection_dispatch(connection);
+                dispatched = true;
+                budget--;
+            }
+        }
+    } while (dispatched && budget > 0);
+}
+
+bool DBusAgent::HasMessagesToSend(void) const
+{
+    bool hasMessages = dbus_connection_has_messages_to_send(mConnection.get());
+
+    for (const UniqueDBusConnection &peer : mPeerConnections)
+    {
+        hasMessages = hasMessages || dbus_connection_has_messages_to_send(peer.get());
+    }
+
+    return hasMessages;
+}
+
 dbus_bool_t DBusAgent::AddDBusWatch(struct DBusWatch *aWatch, void *aContext)
 {
     static_cast<DBusAgent *>(aContext)->mWatches[aWatch] = true;
@@ -98,11 +248,21 @@ void DBusAgent::UpdateFdSet(fd_set &        aReadFdSet,
     unsigned int flags;
     int          fd;
 
-    if (dbus_connection_get_dispatch_status(mConnection.get()) == DBUS_DISPATCH_DATA_REMAINS)
+    // Only messages already read but not yet dispatched need an immediate wakeup.
+    if (dbus_connection_get_dispatch_status(mConnection.get()) == DBUS_DISPATCH_DATA_REMAINS &&
+        dbus_connection_get_is_connected(mConnection.get()))
     {
         aTimeOut = {0, 0};
     }
 
+    for (const UniqueDBusConnection &peer : mPeerConnections)
+    {
+        if (dbus_connection_get_dispatch_status(peer.get()) == DBUS_DISPATCH_DATA_REMAINS)
+        {
+            aTimeOut = {0, 0};
+        }
+    }
+
     for (const auto &p : mWatches)
     {
         if (!p.second)
@@ -124,7 +284,7 @@ void DBusAgent::UpdateFdSet(fd_set &        aReadFdSet,
             FD_SET(fd, &aReadFdSet);
         }
 
-        if ((flags & DBUS_WATCH_WRITABLE) && dbus_connection_has_messages_to_send(mConnection.get()))
+        if ((flags & DBUS_WATCH_WRITABLE) && HasMessagesToSend())
         {
             FD_SET(fd, &aWriteFdSet);
         }
@@ -143,10 +303,12 @@ void DBusAgent::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, con
     DBusWatch *  watch = NULL;
     unsigned int flags;
     int          fd;
+    WatchMap     watches = mWatches;
 
-    for (const auto &p : mWatches)
+    // Handling a watch may add watches of a new peer or remove those of a disconnected one.
+    for (const auto &p : watches)
     {
-        if (!p.second)
+        if (!p.second || mWatches.find(p.first) == mWatches.end())
         {
             continue;
         }
@@ -178,9 +340,11 @@ void DBusAgent::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, con
         dbus_watch_handle(watch, flags);
     }
 
-    while (DBUS_DISPATCH_DATA_REMAINS == dbus_connection_get_dispatch_status(mConnection.get()) &&
-           dbus_connection_read_write_dispatch(mConnection.get(), 0))
-        ;
+    DispatchMessages();
+    RemoveDisconnectedPeers();
+
+    // Writing above may have drained the outgoing queue enough to send the held back signals.
+    mThreadObject->FlushDeferredSignals();
 }
 
 } // namespace DBus
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 #include <sys/select.h>
 
 #include "dbus/common/dbus_message_helper.hpp"
@@ -56,7 +57,30 @@ public:
     DBusAgent(const std::string &aInterfaceName, otbr::Ncp::ControllerOpenThread *aNcp);
 
     /**
-     * This method initializes the dbus agent.
+     * This method connects the dbus agent to the system bus and requests its server name.
+     *
+     * This method doesn't access the ncp controller, so it may run on another thread while the controller is being
+     * initialized, as long as nothing else uses the dbus agent meanwhile.
+     *
+     * @returns The connection error.
+     *
+     */
+    otbrError Connect(void);
+
+    /**
+     * This method sets the address of a private server exposing the thread object to peer-to-peer connections.
+     *
+     * Clients connecting to this address, e.g. "unix:path=/run/otbr-agent.socket", skip the hop through the bus
+     * daemon. libdbus only accepts clients running as the same user as the agent. This method must be called before
+     * Init(), an empty address disables the server.
+     *
+     * @param[in]   aAddress    The D-Bus server address.
+     *
+     */
+    void SetPeerAddress(const std::string &aAddress) { mPeerAddress = aAddress; }
+
+    /**
+     * This method initializes the dbus agent, connecting it first if Connect() hasn't been called.
      *
      * @returns The intialization error.
      *
@@ -90,17 +114,25 @@ public:
     void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
 
 private:
+    using UniqueDBusConnection = std::unique_ptr<DBusConnection, std::function<void(DBusConnection *)>>;
+    using UniqueDBusServer     = std::unique_ptr<DBusServer, std::function<void(DBusServer *)>>;
+
     static dbus_bool_t AddDBusWatch(struct DBusWatch *aWatch, void *aContext);
     static void        RemoveDBusWatch(struct DBusWatch *aWatch, void *aContext);
     static void        ToggleDBusWatch(struct DBusWatch *aWatch, void *aContext);
 
-    static const struct timeval kPollTimeout;
+    static void HandleNewConnection(DBusServer *aServer, DBusConnection *aConnection, void *aContext);
+    void        HandleNewConnection(DBusConnection *aConnection);
+    otbrError   ListenPeers(void);
+    void        RemoveDisconnectedPeers(void);
+    void        DispatchMessages(void);
+    bool        HasMessagesToSend(void) const;
 
     std::string                       mInterfaceName;
     std::unique_ptr<DBusThreadObject> mThreadObject;
-    using UniqueDBusConnection = std::unique_ptr<DBusConnection, std::function<void(DBusConnection *)>>;
-    UniqueDBusConnection             mConnection;
-    otbr::Ncp::ControllerOpenThread *mNcp;
+    UniqueDBusConnection              mConnection;
+    otbr::Ncp::ControllerOpenThread * mNcp;
+    std::string                       mPeerAddress;
 
     /**
      * This map is used to track DBusWatch-es.
@@ -108,6 +140,10 @@ private:
      */
     using WatchMap = std::map<DBusWatch *, bool>;
     WatchMap mWatches;
+
+    // Destroyed before mWatches, closing a connection removes its watches.
+    UniqueDBusServer                  mPeerServer;
+    std::vector<UniqueDBusConnection> mPeerConnections;
 };
 
 } // namespace DBus
@@ -26,15 +26,79 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_DBUS
+
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
 
 #include <dbus/dbus.h>
 
+#include "common/flight_recorder.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
+#include "common/tracepoint.hpp"
 #include "dbus/server/dbus_object.hpp"
 
+#ifndef OTBR_CONFIG_DBUS_OUTGOING_HIGH_WATERMARK
+/**
+ * The number of bytes waiting to be written to the bus at which signals stop being sent.
+ *
+ */
+#define OTBR_CONFIG_DBUS_OUTGOING_HIGH_WATERMARK (1024 * 1024)
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_OUTGOING_LOW_WATERMARK
+/**
+ * The number of bytes waiting to be written to the bus at which signals are sent again.
+ *
+ */
+#define OTBR_CONFIG_DBUS_OUTGOING_LOW_WATERMARK (256 * 1024)
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_COALESCE_PROPERTY_SIGNALS
+/**
+ * Whether property changes are held back and merged while the outgoing queue is full, instead of dropped.
+ *
+ */
+#define OTBR_CONFIG_DBUS_COALESCE_PROPERTY_SIGNALS 1
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_CLIENT_REQUEST_RATE
+/**
+ * The sustained number of method calls per second served to each sender, 0 to serve all of them.
+ *
+ */
+#define OTBR_CONFIG_DBUS_CLIENT_REQUEST_RATE 50
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_REQUEST_LOG_RATE
+/**
+ * The average number of logs per second of the method calls and property reads, twice as many may come in a burst.
+ *
+ */
+#define OTBR_CONFIG_DBUS_REQUEST_LOG_RATE 10
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_CLIENT_REQUEST_BURST
+/**
+ * The number of method calls a sender may make at once after being idle.
+ *
+ */
+#define OTBR_CONFIG_DBUS_CLIENT_REQUEST_BURST 100
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_MAX_REQUEST_BUCKETS
+/**
+ * The number of senders tracked before the buckets of the idle ones are discarded.
+ *
+ */
+#define OTBR_CONFIG_DBUS_MAX_REQUEST_BUCKETS 64
+#endif
+
+// The content of a full bucket, in thousandths of a request.
+static const uint64_t kRequestBurstTokens = static_cast<uint64_t>(OTBR_CONFIG_DBUS_CLIENT_REQUEST_BURST) * 1000;
+
 using std::placeholders::_1;
 
 namespace otbr {
@@ -43,10 +107,32 @@ namespace DBus {
 DBusObject::DBusObject(DBusConnection *aConnection, const std::string &aObjectPath)
     : mConnection(aConnection)
     , mObjectPath(aObjectPath)
+    , mOutgoingQueueFull(false)
+    , mQueueCounters()
 {
 }
 
 otbrError DBusObject::Init(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    SuccessOrExit(error = RegisterObjectPath(mConnection));
+    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_METHOD,
+                   std::bind(&DBusObject::GetPropertyMethodHandler, this, _1));
+    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_SET_METHOD,
+                   std::bind(&DBusObject::SetPropertyMethodHandler, this, _1));
+    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_ALL_METHOD,
+                   std::bind(&DBusObject::GetAllPropertiesMethodHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_DEBUG_INTERFACE, OTBR_DBUS_RESET_CALL_STATS_METHOD,
+                   std::bind(&DBusObject::ResetCallStatsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_DEBUG_INTERFACE, OTBR_DBUS_PROPERTY_CALL_STATS,
+                               std::bind(&DBusObject::GetCallStatsHandler, this, _1));
+
+exit:
+    return error;
+}
+
+otbrError DBusObject::RegisterObjectPath(DBusConnection *aConnection)
 {
     otbrError            error = OTBR_ERROR_NONE;
     DBusObjectPathVTable vTable;
@@ -55,44 +141,91 @@ otbrError DBusObject::Init(void)
 
     vTable.message_function = DBusObject::sMessageHandler;
 
-    VerifyOrExit(dbus_connection_register_object_path(mConnection, mObjectPath.c_str(), &vTable, this),
+    VerifyOrExit(dbus_connection_register_object_path(aConnection, mObjectPath.c_str(), &vTable, this),
                  error = OTBR_ERROR_DBUS);
-    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_METHOD,
-                   std::bind(&DBusObject::GetPropertyMethodHandler, this, _1));
-    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_SET_METHOD,
-                   std::bind(&DBusObject::SetPropertyMethodHandler, this, _1));
-    RegisterMethod(DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTY_GET_ALL_METHOD,
-                   std::bind(&DBusObject::GetAllPropertiesMethodHandler, this, _1));
 
 exit:
     return error;
 }
 
+otbrError DBusObject::AttachConnection(DBusConnection *aConnection)
+{
+    otbrError error;
+
+    SuccessOrExit(error = RegisterObjectPath(aConnection));
+    mAttachedConnections.push_back(aConnection);
+
+exit:
+    return error;
+}
+
+void DBusObject::DetachConnection(DBusConnection *aConnection)
+{
+    auto it = std::find(mAttachedConnections.begin(), mAttachedConnections.end(), aConnection);
+
+    VerifyOrExit(it != mAttachedConnections.end());
+    dbus_connection_unregister_object_path(aConnection, mObjectPath.c_str());
+    mAttachedConnections.erase(it);
+
+exit:
+    return;
+}
+
+bool DBusObject::SendSignal(DBusMessage *aMessage)
+{
+    // Attached connections only get best-effort delivery, the outgoing queue limits apply to the bus connection.
+    for (DBusConnection *connection : mAttachedConnections)
+    {
+        dbus_connection_send(connection, aMessage, nullptr);
+    }
+
+    return dbus_connection_send(mConnection, aMessage, nullptr);
+}
+
 void DBusObject::RegisterMethod(const std::string &      aInterfaceName,
                                 const std::string &      aMethodName,
                                 const MethodHandlerType &aHandler)
 {
-    std::string fullPath = aInterfaceName + "." + aMethodName;
+    bool added = mMethodHandlers.Add(aInterfaceName, aMethodName, aHandler);
 
-    assert(mMethodHandlers.find(fullPath) == mMethodHandlers.end());
-    mMethodHandlers.emplace(fullPath, aHandler);
+    assert(added);
+    (void)added;
+    mMethodStats.Add(aInterfaceName, aMethodName, CallStats());
 }
 
 void DBusObject::RegisterGetPropertyHandler(const std::string &        aInterfaceName,
                                             const std::string &        aPropertyName,
                                             const PropertyHandlerType &aHandler)
 {
-    mGetPropertyHandlers[aInterfaceName].emplace(aPropertyName, aHandler);
+    mGetPropertyHandlers.Add(aInterfaceName, aPropertyName, aHandler);
+    mGetPropertyStats.Add(aInterfaceName, aPropertyName, CallStats());
 }
 
 void DBusObject::RegisterSetPropertyHandler(const std::string &        aInterfaceName,
                                             const std::string &        aPropertyName,
-                                            const PropertyHandlerType &aHandler)
+                                            const PropertyHandlerType &aHandler,
+                                            const std::string &        aSignature)
 {
-    std::string fullPath = aInterfaceName + "." + aPropertyName;
+    bool added = mSetPropertyHandlers.Add(aInterfaceName, aPropertyName, aHandler);
 
-    assert(mSetPropertyHandlers.find(fullPath) == mSetPropertyHandlers.end());
-    mSetPropertyHandlers.emplace(fullPath, aHandler);
+    assert(added);
+    (void)added;
+    mSetPropertyStats.Add(aInterfaceName, aPropertyName, CallStats());
+
+    if (!aSignature.empty())
+    {
+        mSetPropertySignatures.Add(aInterfaceName, aPropertyName, aSignature);
+    }
+}
+
+void DBusObject::RegisterAsyncGetPropertyHandler(const std::string &             aInterfaceName,
+                                                 const std::string &             aPropertyName,
+                                                 const AsyncPropertyHandlerType &aHandler)
+{
+    bool added = mAsyncGetPropertyHandlers.Add(aInterfaceName, aPropertyName, aHandler);
+
+    assert(added);
+    (void)added;
 }
 
 DBusHandlerResult DBusObject::sMessageHandler(DBusConnection *aConnection, DBusMessage *aMessage, void *aData)
@@ -104,50 +237,98 @@ DBusHandlerResult DBusObject::sMessageHandler(DBusConnection *aConnection, DBusM
 
 DBusHandlerResult DBusObject::MessageHandler(DBusConnection *aConnection, DBusMessage *aMessage)
 {
-    DBusHandlerResult handled = DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
-    DBusRequest       request(aConnection, aMessage);
-    std::string       interface  = dbus_message_get_interface(aMessage);
-    std::string       memberName = interface + "." + dbus_message_get_member(aMessage);
-    auto              iter       = mMethodHandlers.find(memberName);
+    DBusHandlerResult        handled       = DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+    const char *             interfaceName = dbus_message_get_interface(aMessage);
+    const char *             memberName    = dbus_message_get_member(aMessage);
+    const MethodHandlerType *handler;
+    CallStats *              stats;
+
+    VerifyOrExit(dbus_message_get_type(aMessage) == DBUS_MESSAGE_TYPE_METHOD_CALL && interfaceName != nullptr &&
+                 memberName != nullptr);
+    handler = mMethodHandlers.Find(interfaceName, memberName);
+    VerifyOrExit(handler != nullptr);
+    stats = mMethodStats.Find(interfaceName, memberName);
+
+    handled = DBUS_HANDLER_RESULT_HANDLED;
 
-    if (dbus_message_get_type(aMessage) == DBUS_MESSAGE_TYPE_METHOD_CALL && iter != mMethodHandlers.end())
+    if (!ConsumeRequestToken(aConnection, aMessage))
     {
-        otbrLog(OTBR_LOG_INFO, "Handling method %s", memberName.c_str());
-        (iter->second)(request);
-        handled = DBUS_HANDLER_RESULT_HANDLED;
+        DBusRequest request(aConnection, aMessage);
+
+        ++mQueueCounters.mThrottledRequests;
+        stats->Record(0, /* aFailed */ true);
+        request.ReplyOtResult(OT_ERROR_BUSY);
+        ExitNow();
     }
 
+    // Clients polling properties make many calls, which are logged at a bounded rate.
+    otbrLogThrottled(OTBR_CONFIG_DBUS_REQUEST_LOG_RATE, OTBR_CONFIG_DBUS_REQUEST_LOG_RATE * 2, OTBR_LOG_INFO,
+                     "Handling method %s.%s", interfaceName, memberName);
+    {
+        DBusRequest request(aConnection, aMessage);
+        uint64_t    start = GetNowPrecise();
+        uint32_t    duration;
+
+        OTBR_TRACEPOINT2(dbus__call__begin, interfaceName, memberName);
+        (*handler)(request);
+        duration = static_cast<uint32_t>(GetNowPrecise() - start);
+        OTBR_TRACEPOINT2(dbus__call__end, memberName, duration);
+        RecordFlightEvent(kFlightEventDBusCall, 0, duration, memberName);
+        stats->Record(duration, request.IsFailed());
+    }
+
+exit:
     return handled;
 }
 
 void DBusObject::GetPropertyMethodHandler(DBusRequest &aRequest)
 {
-    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
-
-    DBusMessageIter iter;
-    std::string     interfaceName;
-    std::string     propertyName;
-    otError         error = OT_ERROR_NONE;
+    DBusMessageIter                 iter;
+    const char *                    interfaceName;
+    const char *                    propertyName;
+    const PropertyHandlerType *     handler;
+    const AsyncPropertyHandlerType *asyncHandler;
+    otError                         error = OT_ERROR_NONE;
 
-    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
     VerifyOrExit(dbus_message_iter_init(aRequest.GetMessage(), &iter), error = OT_ERROR_FAILED);
     VerifyOrExit(DBusMessageExtract(&iter, interfaceName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
     VerifyOrExit(DBusMessageExtract(&iter, propertyName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
+
+    otbrLogThrottled(OTBR_CONFIG_DBUS_REQUEST_LOG_RATE, OTBR_CONFIG_DBUS_REQUEST_LOG_RATE * 2, OTBR_LOG_INFO,
+                     "GetProperty %s.%s", interfaceName, propertyName);
+    asyncHandler = mAsyncGetPropertyHandlers.Find(interfaceName, propertyName);
+    if (asyncHandler != nullptr)
     {
-        auto propertyIter = mGetPropertyHandlers.find(interfaceName);
+        (*asyncHandler)(aRequest);
+        ExitNow();
+    }
 
-        otbrLog(OTBR_LOG_INFO, "GetProperty %s.%s", interfaceName.c_str(), propertyName.c_str());
-        VerifyOrExit(propertyIter != mGetPropertyHandlers.end(), error = OT_ERROR_NOT_FOUND);
-        {
-            DBusMessageIter replyIter;
-            auto &          interfaceHandlers = propertyIter->second;
-            auto            interfaceIter     = interfaceHandlers.find(propertyName);
+    handler = mGetPropertyHandlers.Find(interfaceName, propertyName);
+    VerifyOrExit(handler != nullptr, error = OT_ERROR_NOT_FOUND);
+    ReplyGetProperty(aRequest, *handler);
 
-            VerifyOrExit(interfaceIter != interfaceHandlers.end(), error = OT_ERROR_NOT_FOUND);
-            dbus_message_iter_init_append(reply.get(), &replyIter);
-            SuccessOrExit(error = interfaceIter->second(replyIter));
-        }
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(error);
     }
+}
+
+void DBusObject::ReplyGetProperty(DBusRequest &aRequest, const PropertyHandlerType &aHandler)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   replyIter;
+    const char *      interfaceName;
+    const char *      propertyName;
+    otError           error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_get_args(aRequest.GetMessage(), nullptr, DBUS_TYPE_STRING, &interfaceName,
+                                       DBUS_TYPE_STRING, &propertyName, DBUS_TYPE_INVALID),
+                 error = OT_ERROR_PARSE);
+    dbus_message_iter_init_append(reply.get(), &replyIter);
+    SuccessOrExit(error = CallPropertyHandler(mGetPropertyStats, interfaceName, propertyName, aHandler, replyIter));
+
 exit:
     if (error == OT_ERROR_NONE)
     {
@@ -162,32 +343,80 @@ exit:
 void DBusObject::GetAllPropertiesMethodHandler(DBusRequest &aRequest)
 {
     UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
-    DBusMessageIter   iter, subIter, dictEntryIter;
-    std::string       interfaceName;
-    auto              args  = std::tie(interfaceName);
+    DBusMessageIter   iter, subIter;
+    const char *      interfaceName;
     otError           error = OT_ERROR_NONE;
 
+    const HandlerTable<PropertyHandlerType>::Entries *handlers;
+
     VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
-    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
-    VerifyOrExit(mGetPropertyHandlers.find(interfaceName) != mGetPropertyHandlers.end(), error = OT_ERROR_NOT_FOUND);
+    VerifyOrExit(dbus_message_iter_init(aRequest.GetMessage(), &iter), error = OT_ERROR_FAILED);
+    VerifyOrExit(DBusMessageExtract(&iter, interfaceName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
+    handlers = mGetPropertyHandlers.Find(interfaceName);
+    VerifyOrExit(handlers != nullptr, error = OT_ERROR_NOT_FOUND);
     dbus_message_iter_init_append(reply.get(), &iter);
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
+                                                  "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_VARIANT_AS_STRING "}",
+                                                  &subIter),
+                 error = OT_ERROR_FAILED);
 
-    for (auto &p : mGetPropertyHandlers.at(interfaceName))
+    for (const auto &handler : *handlers)
     {
-        VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
-                                                      "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_VARIANT_AS_STRING "}",
-                                                      &subIter),
-                     error = OT_ERROR_FAILED);
-        VerifyOrExit(dbus_message_iter_open_container(&subIter, DBUS_TYPE_DICT_ENTRY, nullptr, &dictEntryIter),
-                     error = OT_ERROR_FAILED);
-        VerifyOrExit(DBusMessageEncode(&dictEntryIter, p.first) == OTBR_ERROR_NONE, error = OT_ERROR_FAILED);
+        SuccessOrExit(error = AppendProperty(subIter, interfaceName, handler.mName.c_str(), handler.mHandler));
+    }
 
-        SuccessOrExit(error = p.second(dictEntryIter));
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter), error = OT_ERROR_FAILED);
 
-        VerifyOrExit(dbus_message_iter_close_container(&subIter, &dictEntryIter), error = OT_ERROR_FAILED);
-        VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter));
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusObject::GetPropertiesMethodHandler(const std::string &aInterfaceName, DBusRequest &aRequest)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   iter, namesIter, replyIter, subIter;
+    otError           error = OT_ERROR_NONE;
+
+    const HandlerTable<PropertyHandlerType>::Entries *handlers = mGetPropertyHandlers.Find(aInterfaceName.c_str());
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(handlers != nullptr, error = OT_ERROR_NOT_FOUND);
+    VerifyOrExit(dbus_message_iter_init(aRequest.GetMessage(), &iter), error = OT_ERROR_FAILED);
+    VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY &&
+                     dbus_message_iter_get_element_type(&iter) == DBUS_TYPE_STRING,
+                 error = OT_ERROR_PARSE);
+    dbus_message_iter_recurse(&iter, &namesIter);
+
+    dbus_message_iter_init_append(reply.get(), &replyIter);
+    VerifyOrExit(dbus_message_iter_open_container(&replyIter, DBUS_TYPE_ARRAY,
+                                                  "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_VARIANT_AS_STRING "}",
+                                                  &subIter),
+                 error = OT_ERROR_FAILED);
+
+    while (dbus_message_iter_get_arg_type(&namesIter) != DBUS_TYPE_INVALID)
+    {
+        const char *               propertyName;
+        const PropertyHandlerType *handler;
+
+        VerifyOrExit(DBusMessageExtract(&namesIter, propertyName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
+        handler = mGetPropertyHandlers.Find(aInterfaceName.c_str(), propertyName);
+        if (handler == nullptr)
+        {
+            otbrLog(OTBR_LOG_WARNING, "GetProperties %s.%s not found", aInterfaceName.c_str(), propertyName);
+            ExitNow(error = OT_ERROR_NOT_FOUND);
+        }
+        SuccessOrExit(error = AppendProperty(subIter, aInterfaceName.c_str(), propertyName, *handler));
     }
 
+    VerifyOrExit(dbus_message_iter_close_container(&replyIter, &subIter), error = OT_ERROR_FAILED);
+
 exit:
     if (error == OT_ERROR_NONE)
     {
@@ -199,32 +428,431 @@ exit:
     }
 }
 
-void DBusObject::SetPropertyMethodHandler(DBusRequest &aRequest)
+otError DBusObject::AppendProperty(DBusMessageIter &          aIter,
+                                   const char *               aInterfaceName,
+                                   const char *               aPropertyName,
+                                   const PropertyHandlerType &aHandler)
 {
-    DBusMessageIter iter;
-    std::string     interfaceName;
-    std::string     propertyName;
-    std::string     propertyFullPath;
+    DBusMessageIter dictEntryIter;
     otError         error = OT_ERROR_NONE;
 
+    VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_DICT_ENTRY, nullptr, &dictEntryIter),
+                 error = OT_ERROR_FAILED);
+    VerifyOrExit(dbus_message_iter_append_basic(&dictEntryIter, DBUS_TYPE_STRING, &aPropertyName),
+                 error = OT_ERROR_FAILED);
+    SuccessOrExit(
+        error = CallPropertyHandler(mGetPropertyStats, aInterfaceName, aPropertyName, aHandler, dictEntryIter));
+    VerifyOrExit(dbus_message_iter_close_container(&aIter, &dictEntryIter), error = OT_ERROR_FAILED);
+
+exit:
+    return error;
+}
+
+otError DBusObject::CallPropertyHandler(HandlerTable<CallStats> &  aStats,
+                                        const char *               aInterfaceName,
+                                        const char *               aPropertyName,
+                                        const PropertyHandlerType &aHandler,
+                                        DBusMessageIter &          aIter)
+{
+    CallStats *stats = aStats.Find(aInterfaceName, aPropertyName);
+    uint64_t   start = GetNowPrecise();
+    otError    error = aHandler(aIter);
+
+    if (stats != nullptr)
+    {
+        stats->Record(static_cast<uint32_t>(GetNowPrecise() - start), error != OT_ERROR_NONE);
+    }
+
+    return error;
+}
+
+void DBusObject::CallStats::Record(uint32_t aDuration, bool aFailed)
+{
+    ++mCalls;
+    mErrors += aFailed ? 1 : 0;
+    mTotalTime += aDuration;
+    mMaxTime = std::max(mMaxTime, aDuration);
+}
+
+otError DBusObject::GetCallStatsHandler(DBusMessageIter &aIter)
+{
+    std::vector<DBusCallStats> callStats;
+    otError                    error = OT_ERROR_NONE;
+
+    auto append = [&callStats](DBusCallKind aKind) {
+        return [&callStats, aKind](const std::string &aInterfaceName, const std::string &aName, CallStats &aStats) {
+            // Only the members called since the last reset are reported, to keep the reply short.
+            if (aStats.mCalls != 0)
+            {
+                callStats.push_back({aInterfaceName, aName, static_cast<uint8_t>(aKind), aStats.mCalls,
+                                     aStats.mErrors, aStats.mTotalTime, aStats.mMaxTime});
+            }
+        };
+    };
+
+    mMethodStats.ForEach(append(OTBR_DBUS_CALL_METHOD));
+    mGetPropertyStats.ForEach(append(OTBR_DBUS_CALL_GET_PROPERTY));
+    mSetPropertyStats.ForEach(append(OTBR_DBUS_CALL_SET_PROPERTY));
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, callStats) == OTBR_ERROR_NONE, error = OT_ERROR_FAILED);
+
+exit:
+    return error;
+}
+
+void DBusObject::ResetCallStatsHandler(DBusRequest &aRequest)
+{
+    auto reset = [](const std::string &, const std::string &, CallStats &aStats) { aStats = CallStats(); };
+
+    mMethodStats.ForEach(reset);
+    mGetPropertyStats.ForEach(reset);
+    mSetPropertyStats.ForEach(reset);
+    aRequest.ReplyOtResult(OT_ERROR_NONE);
+}
+
+void DBusObject::SetPropertyMethodHandler(DBusRequest &aRequest)
+{
+    DBusMessageIter            iter;
+    const char *               interfaceName;
+    const char *               propertyName;
+    const PropertyHandlerType *handler;
+    otError                    error = OT_ERROR_NONE;
+
     VerifyOrExit(dbus_message_iter_init(aRequest.GetMessage(), &iter), error = OT_ERROR_FAILED);
     VerifyOrExit(DBusMessageExtract(&iter, interfaceName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
     VerifyOrExit(DBusMessageExtract(&iter, propertyName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
 
-    propertyFullPath = interfaceName + "." + propertyName;
-    otbrLog(OTBR_LOG_INFO, "SetProperty %s", propertyFullPath.c_str());
+    otbrLog(OTBR_LOG_INFO, "SetProperty %s.%s", interfaceName, propertyName);
+    SuccessOrExit(error = FindSetPropertyHandler(interfaceName, propertyName, iter, handler));
+    error = CallPropertyHandler(mSetPropertyStats, interfaceName, propertyName, *handler, iter);
+
+exit:
+    aRequest.ReplyOtResult(error);
+    return;
+}
+
+void DBusObject::SetPropertiesMethodHandler(const std::string &aInterfaceName, DBusRequest &aRequest)
+{
+    struct Update
+    {
+        const char *               mName;
+        const PropertyHandlerType *mHandler;
+        DBusMessageIter            mValue;
+        otError                    mResult;
+    };
+
+    UniqueDBusMessage   reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter     iter, valuesIter, replyIter, subIter;
+    std::vector<Update> updates;
+    otError             error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_init(aRequest.GetMessage(), &iter), error = OT_ERROR_FAILED);
+    VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY &&
+                     dbus_message_iter_get_element_type(&iter) == DBUS_TYPE_DICT_ENTRY,
+                 error = OT_ERROR_PARSE);
+    dbus_message_iter_recurse(&iter, &valuesIter);
+
+    while (dbus_message_iter_get_arg_type(&valuesIter) == DBUS_TYPE_DICT_ENTRY)
+    {
+        DBusMessageIter entryIter;
+        Update          update;
+
+        dbus_message_iter_recurse(&valuesIter, &entryIter);
+        VerifyOrExit(DBusMessageExtract(&entryIter, update.mName) == OTBR_ERROR_NONE, error = OT_ERROR_PARSE);
+        error = FindSetPropertyHandler(aInterfaceName.c_str(), update.mName, entryIter, update.mHandler);
+        if (error != OT_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_WARNING, "SetProperties %s.%s rejected", aInterfaceName.c_str(), update.mName);
+            ExitNow();
+        }
+        update.mValue  = entryIter;
+        update.mResult = OT_ERROR_NONE;
+        updates.push_back(update);
+        dbus_message_iter_next(&valuesIter);
+    }
+
+    otbrLog(OTBR_LOG_INFO, "SetProperties %s, %zu properties", aInterfaceName.c_str(), updates.size());
+    for (Update &update : updates)
     {
-        auto handlerIter = mSetPropertyHandlers.find(propertyFullPath);
+        update.mResult = CallPropertyHandler(mSetPropertyStats, aInterfaceName.c_str(), update.mName, *update.mHandler,
+                                             update.mValue);
+        if (update.mResult != OT_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_WARNING, "SetProperties %s.%s failed: %s", aInterfaceName.c_str(), update.mName,
+                    ConvertToDBusErrorName(update.mResult));
+        }
+    }
 
-        VerifyOrExit(handlerIter != mSetPropertyHandlers.end(), error = OT_ERROR_NOT_FOUND);
-        error = handlerIter->second(iter);
+    dbus_message_iter_init_append(reply.get(), &replyIter);
+    VerifyOrExit(dbus_message_iter_open_container(&replyIter, DBUS_TYPE_ARRAY,
+                                                  "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_INT32_AS_STRING "}",
+                                                  &subIter),
+                 error = OT_ERROR_NO_BUFS);
+
+    for (const Update &update : updates)
+    {
+        DBusMessageIter entryIter;
+        int32_t         result = update.mResult;
+
+        VerifyOrExit(dbus_message_iter_open_container(&subIter, DBUS_TYPE_DICT_ENTRY, nullptr, &entryIter),
+                     error = OT_ERROR_NO_BUFS);
+        VerifyOrExit(dbus_message_iter_append_basic(&entryIter, DBUS_TYPE_STRING, &update.mName),
+                     error = OT_ERROR_NO_BUFS);
+        VerifyOrExit(dbus_message_iter_append_basic(&entryIter, DBUS_TYPE_INT32, &result), error = OT_ERROR_NO_BUFS);
+        VerifyOrExit(dbus_message_iter_close_container(&subIter, &entryIter), error = OT_ERROR_NO_BUFS);
+    }
+
+    VerifyOrExit(dbus_message_iter_close_container(&replyIter, &subIter), error = OT_ERROR_NO_BUFS);
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+otError DBusObject::FindSetPropertyHandler(const char *                aInterfaceName,
+                                           const char *                aPropertyName,
+                                           DBusMessageIter &           aValueIter,
+                                           const PropertyHandlerType *&aHandler) const
+{
+    const std::string *signature = mSetPropertySignatures.Find(aInterfaceName, aPropertyName);
+    otError            error     = OT_ERROR_NONE;
+
+    aHandler = mSetPropertyHandlers.Find(aInterfaceName, aPropertyName);
+    VerifyOrExit(aHandler != nullptr, error = OT_ERROR_NOT_FOUND);
+    VerifyOrExit(dbus_message_iter_get_arg_type(&aValueIter) == DBUS_TYPE_VARIANT, error = OT_ERROR_INVALID_ARGS);
+
+    if (signature != nullptr)
+    {
+        DBusMessageIter valueIter;
+        char *          valueSignature;
+        bool            matched;
+
+        dbus_message_iter_recurse(&aValueIter, &valueIter);
+        valueSignature = dbus_message_iter_get_signature(&valueIter);
+        VerifyOrExit(valueSignature != nullptr, error = OT_ERROR_NO_BUFS);
+        matched = (*signature == valueSignature);
+        dbus_free(valueSignature);
+        VerifyOrExit(matched, error = OT_ERROR_INVALID_ARGS);
+    }
+
+exit:
+    return error;
+}
+
+otbrError DBusObject::SignalPropertiesChanged(const std::string &              aInterfaceName,
+                                              const std::vector<const char *> &aChangedProperties,
+                                              const std::vector<const char *> &aInvalidatedProperties)
+{
+    UniqueDBusMessage signalMsg{
+        dbus_message_new_signal(mObjectPath.c_str(), DBUS_INTERFACE_PROPERTIES, DBUS_PROPERTIES_CHANGED_SIGNAL)};
+    DBusMessageIter iter, subIter;
+    const char *    interfaceName = aInterfaceName.c_str();
+    otbrError       error         = OTBR_ERROR_NONE;
+
+    if (IsOutgoingQueueFull())
+    {
+        for (const char *propertyName : aChangedProperties)
+        {
+            DeferPropertyChanged(aInterfaceName, propertyName, /* aInvalidated */ false);
+        }
+        for (const char *propertyName : aInvalidatedProperties)
+        {
+            DeferPropertyChanged(aInterfaceName, propertyName, /* aInvalidated */ true);
+        }
+        ExitNow();
+    }
+
+    VerifyOrExit(signalMsg != nullptr, error = OTBR_ERROR_DBUS);
+    dbus_message_iter_init_append(signalMsg.get(), &iter);
+
+    // interface_name
+    VerifyOrExit(dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &interfaceName), error = OTBR_ERROR_DBUS);
+
+    // changed_properties
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
+                                                  "{" DBUS_TYPE_STRING_AS_STRING DBUS_TYPE_VARIANT_AS_STRING "}",
+                                                  &subIter),
+                 error = OTBR_ERROR_DBUS);
+    for (const char *propertyName : aChangedProperties)
+    {
+        const PropertyHandlerType *handler = mGetPropertyHandlers.Find(interfaceName, propertyName);
+
+        VerifyOrExit(handler != nullptr, error = OTBR_ERROR_DBUS);
+        VerifyOrExit(AppendProperty(subIter, interfaceName, propertyName, *handler) == OT_ERROR_NONE,
+                     error = OTBR_ERROR_DBUS);
+    }
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter), error = OTBR_ERROR_DBUS);
+
+    // invalidated_properties
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_STRING_AS_STRING, &subIter),
+                 error = OTBR_ERROR_DBUS);
+    for (const char *propertyName : aInvalidatedProperties)
+    {
+        VerifyOrExit(dbus_message_iter_append_basic(&subIter, DBUS_TYPE_STRING, &propertyName),
+                     error = OTBR_ERROR_DBUS);
+    }
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &subIter), error = OTBR_ERROR_DBUS);
+
+    VerifyOrExit(SendSignal(signalMsg.get()), error = OTBR_ERROR_DBUS);
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to signal changed properties of %s", interfaceName);
+    }
+
+    return error;
+}
+
+void DBusObject::FlushDeferredSignals(void)
+{
+    DeferredPropertiesMap     deferred;
+    std::vector<const char *> changed;
+    std::vector<const char *> invalidated;
+
+    VerifyOrExit(!mDeferredProperties.empty() && !IsOutgoingQueueFull());
+    deferred.swap(mDeferredProperties);
+
+    for (const auto &interface : deferred)
+    {
+        changed.clear();
+        invalidated.clear();
+
+        for (const std::string &name : interface.second.mChanged)
+        {
+            changed.push_back(name.c_str());
+        }
+        for (const std::string &name : interface.second.mInvalidated)
+        {
+            invalidated.push_back(name.c_str());
+        }
+
+        SignalPropertiesChanged(interface.first, changed, invalidated);
     }
 
 exit:
-    aRequest.ReplyOtResult(error);
     return;
 }
 
+bool DBusObject::ConsumeRequestToken(DBusConnection *aConnection, DBusMessage *aMessage)
+{
+    const char *  sender = dbus_message_get_sender(aMessage);
+    unsigned long now    = GetMainloopNow();
+    bool          allowed;
+
+    // Peer-to-peer connections have no bus names, their connection identifies the sender.
+    RequestBucketKey key(aConnection, sender != nullptr ? sender : "");
+    auto             bucket = mRequestBuckets.find(key);
+
+    VerifyOrExit(OTBR_CONFIG_DBUS_CLIENT_REQUEST_RATE != 0, allowed = true);
+
+    if (bucket == mRequestBuckets.end())
+    {
+        if (mRequestBuckets.size() >= OTBR_CONFIG_DBUS_MAX_REQUEST_BUCKETS)
+        {
+            // A full bucket is the same as no bucket, only senders still paying for their last burst are kept.
+            for (auto it = mRequestBuckets.begin(); it != mRequestBuckets.end();)
+            {
+                RefillRequestBucket(it->second, now);
+                it = (it->second.mTokens == kRequestBurstTokens) ? mRequestBuckets.erase(it) : std::next(it);
+            }
+        }
+
+        bucket = mRequestBuckets.insert({key, RequestBucket{kRequestBurstTokens, now, false}}).first;
+    }
+
+    RefillRequestBucket(bucket->second, now);
+    allowed = (bucket->second.mTokens >= 1000);
+
+    if (allowed)
+    {
+        bucket->second.mTokens -= 1000;
+    }
+
+    if (allowed == bucket->second.mThrottled)
+    {
+        bucket->second.mThrottled = !allowed;
+        otbrLog(allowed ? OTBR_LOG_INFO : OTBR_LOG_WARNING, "%s requests of D-Bus sender %s",
+                allowed ? "Serving again" : "Throttling", key.second.empty() ? "(peer)" : key.second.c_str());
+    }
+
+exit:
+    return allowed;
+}
+
+void DBusObject::RefillRequestBucket(RequestBucket &aBucket, unsigned long aNow)
+{
+    // One request per second is one token per millisecond.
+    uint64_t refill = static_cast<uint64_t>(aNow - aBucket.mLastRefill) * OTBR_CONFIG_DBUS_CLIENT_REQUEST_RATE;
+
+    aBucket.mTokens     = std::min(aBucket.mTokens + refill, kRequestBurstTokens);
+    aBucket.mLastRefill = aNow;
+}
+
+DBusQueueCounters DBusObject::GetQueueCounters(void) const
+{
+    DBusQueueCounters counters = mQueueCounters;
+
+    counters.mOutgoingBytes     = static_cast<uint32_t>(dbus_connection_get_outgoing_size(mConnection));
+    counters.mPeakOutgoingBytes = std::max(counters.mPeakOutgoingBytes, counters.mOutgoingBytes);
+
+    return counters;
+}
+
+bool DBusObject::IsOutgoingQueueFull(void)
+{
+    uint32_t outgoingBytes = static_cast<uint32_t>(dbus_connection_get_outgoing_size(mConnection));
+
+    mQueueCounters.mOutgoingBytes     = outgoingBytes;
+    mQueueCounters.mPeakOutgoingBytes = std::max(mQueueCounters.mPeakOutgoingBytes, outgoingBytes);
+
+    if (!mOutgoingQueueFull && outgoingBytes >= OTBR_CONFIG_DBUS_OUTGOING_HIGH_WATERMARK)
+    {
+        otbrLog(OTBR_LOG_WARNING, "D-Bus outgoing queue full with %u bytes, holding back signals", outgoingBytes);
+        mOutgoingQueueFull = true;
+    }
+    else if (mOutgoingQueueFull && outgoingBytes <= OTBR_CONFIG_DBUS_OUTGOING_LOW_WATERMARK)
+    {
+        otbrLog(OTBR_LOG_INFO, "D-Bus outgoing queue drained to %u bytes", outgoingBytes);
+        mOutgoingQueueFull = false;
+    }
+
+    return mOutgoingQueueFull;
+}
+
+void DBusObject::DeferPropertyChanged(const std::string &aInterfaceName,
+                                      const std::string &aPropertyName,
+                                      bool               aInvalidated)
+{
+#if OTBR_CONFIG_DBUS_COALESCE_PROPERTY_SIGNALS
+    DeferredProperties &      deferred = mDeferredProperties[aInterfaceName];
+    std::vector<std::string> &add      = aInvalidated ? deferred.mInvalidated : deferred.mChanged;
+    std::vector<std::string> &other    = aInvalidated ? deferred.mChanged : deferred.mInvalidated;
+
+    // The latest kind of change wins, the value itself is read when the signal is finally sent.
+    other.erase(std::remove(other.begin(), other.end(), aPropertyName), other.end());
+    if (std::find(add.begin(), add.end(), aPropertyName) == add.end())
+    {
+        add.push_back(aPropertyName);
+    }
+
+    ++mQueueCounters.mCoalescedSignals;
+#else
+    (void)aInterfaceName;
+    (void)aPropertyName;
+    (void)aInvalidated;
+
+    ++mQueueCounters.mDroppedSignals;
+#endif
+}
+
 DBusObject::~DBusObject(void)
 {
 }
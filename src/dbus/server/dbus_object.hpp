@@ -29,14 +29,19 @@
 #ifndef OTBR_DBUS_DBUS_OBJECT_HPP_
 #define OTBR_DBUS_DBUS_OBJECT_HPP_
 
+#include <algorithm>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
+
+#include <string.h>
 
 #include <dbus/dbus.h>
 
 #include "common/code_utils.hpp"
+#include "common/memory_stats.hpp"
 #include "common/types.hpp"
 #include "dbus/common/constants.hpp"
 #include "dbus/common/dbus_message_helper.hpp"
@@ -57,6 +62,8 @@ public:
 
     using PropertyHandlerType = std::function<otError(DBusMessageIter &)>;
 
+    using AsyncPropertyHandlerType = std::function<void(DBusRequest &)>;
+
     /**
      * The constructor of a d-bus object.
      *
@@ -104,14 +111,43 @@ public:
     /**
      * This method registers the set handler for a property.
      *
+     * Values of another type than @p aSignature are rejected before the handler is called, so that a batch of
+     * properties is either applied as a whole or not at all.
+     *
      * @param[in]   aInterfaceName    The interface name.
      * @param[in]   aMethodName       The method name.
      * @param[in]   aHandler          The method handler.
+     * @param[in]   aSignature        The signature of the property value, empty if only checked by the handler.
      *
      */
     void RegisterSetPropertyHandler(const std::string &        aInterfaceName,
                                     const std::string &        aPropertyName,
-                                    const PropertyHandlerType &aHandler);
+                                    const PropertyHandlerType &aHandler,
+                                    const std::string &        aSignature = "");
+
+    /**
+     * This method registers a get handler replying to the Properties.Get calls of a property asynchronously.
+     *
+     * The handler replies through ReplyGetProperty(), possibly after returning. The get handler of the property is
+     * still used by the calls reading several properties at once.
+     *
+     * @param[in]   aInterfaceName    The interface name.
+     * @param[in]   aPropertyName     The property name.
+     * @param[in]   aHandler          The asynchronous get handler.
+     *
+     */
+    void RegisterAsyncGetPropertyHandler(const std::string &             aInterfaceName,
+                                         const std::string &             aPropertyName,
+                                         const AsyncPropertyHandlerType &aHandler);
+
+    /**
+     * This method replies to a Properties.Get call with the value encoded by a get handler.
+     *
+     * @param[in]   aRequest          The Properties.Get request.
+     * @param[in]   aHandler          The get handler encoding the value.
+     *
+     */
+    void ReplyGetProperty(DBusRequest &aRequest, const PropertyHandlerType &aHandler);
 
     /**
      * This method sends a signal.
@@ -120,8 +156,10 @@ public:
      * @param[in]   aSignalName       The signal name.
      * @param[in]   aArgs             The tuple to be encoded into the signal.
      *
+     * The signal is dropped while the outgoing queue of the connection is full.
+     *
      * @retval OTBR_ERROR_NONE  Signal successfully sent.
-     * @retval OTBR_ERROR_DBUS  Failed to send the signal.
+     * @retval OTBR_ERROR_DBUS  Failed to send the signal, or the outgoing queue is full.
      *
      */
     template <typename... FieldTypes>
@@ -133,10 +171,16 @@ public:
             dbus_message_new_signal(mObjectPath.c_str(), aInterfaceName.c_str(), aSignalName.c_str())};
         otbrError error = OTBR_ERROR_NONE;
 
+        if (IsOutgoingQueueFull())
+        {
+            ++mQueueCounters.mDroppedSignals;
+            ExitNow(error = OTBR_ERROR_DBUS);
+        }
+
         VerifyOrExit(signalMsg != nullptr, error = OTBR_ERROR_DBUS);
-        VerifyOrExit(error = otbr::DBus::TupleToDBusMessage(*signalMsg, aArgs));
+        SuccessOrExit(error = otbr::DBus::TupleToDBusMessage(*signalMsg, aArgs));
 
-        VerifyOrExit(dbus_connection_send(mConnection, signalMsg.get(), nullptr), error = OTBR_ERROR_DBUS);
+        VerifyOrExit(SendSignal(signalMsg.get()), error = OTBR_ERROR_DBUS);
 
     exit:
         return error;
@@ -149,6 +193,9 @@ public:
      * @param[in]   aPropertyName     The property name.
      * @param[in]   aValue            New value of the property.
      *
+     * While the outgoing queue of the connection is full, the change is held back and signaled later with the value
+     * then returned by the property's get handler.
+     *
      * @retval OTBR_ERROR_NONE  Signal successfully sent.
      * @retval OTBR_ERROR_DBUS  Failed to send the signal.
      *
@@ -163,6 +210,12 @@ public:
         DBusMessageIter iter, subIter, dictEntryIter;
         otbrError       error = OTBR_ERROR_NONE;
 
+        if (IsOutgoingQueueFull())
+        {
+            DeferPropertyChanged(aInterfaceName, aPropertyName, /* aInvalidated */ false);
+            ExitNow();
+        }
+
         VerifyOrExit(signalMsg != nullptr, error = OTBR_ERROR_DBUS);
         dbus_message_iter_init_append(signalMsg.get(), &iter);
 
@@ -186,33 +239,341 @@ public:
         // invalidated_properties
         SuccessOrExit(error = DBusMessageEncode(&iter, std::vector<std::string>()));
 
-        VerifyOrExit(dbus_connection_send(mConnection, signalMsg.get(), nullptr), error = OTBR_ERROR_DBUS);
+        VerifyOrExit(SendSignal(signalMsg.get()), error = OTBR_ERROR_DBUS);
 
     exit:
         return error;
     }
 
+    /**
+     * This method sends a property changed signal for several properties at once.
+     *
+     * The values of the changed properties are encoded by their registered get handlers. While the outgoing queue of
+     * the connection is full, the changes are held back and merged into one signal per interface, which is sent once
+     * the queue has drained.
+     *
+     * @param[in]   aInterfaceName          The interface name.
+     * @param[in]   aChangedProperties      Names of the properties changed, with their new values.
+     * @param[in]   aInvalidatedProperties  Names of the properties changed, without their new values.
+     *
+     * @retval OTBR_ERROR_NONE  Signal successfully sent.
+     * @retval OTBR_ERROR_DBUS  Failed to send the signal.
+     *
+     */
+    otbrError SignalPropertiesChanged(const std::string &              aInterfaceName,
+                                      const std::vector<const char *> &aChangedProperties,
+                                      const std::vector<const char *> &aInvalidatedProperties);
+
+    /**
+     * This method sends the property changes held back while the outgoing queue was full, once the queue has drained
+     * below its low watermark.
+     *
+     */
+    virtual void FlushDeferredSignals(void);
+
+    /**
+     * This method exposes this object on an additional connection, e.g. a peer-to-peer connection without bus daemon.
+     *
+     * Method calls arriving on the connection are handled like those from the bus, and signals are sent to it too.
+     *
+     * @param[in]   aConnection     The connection, which must stay valid until DetachConnection() is called.
+     *
+     * @retval OTBR_ERROR_NONE  Successfully attached the connection.
+     * @retval OTBR_ERROR_DBUS  Failed to register the object path on the connection.
+     *
+     */
+    otbrError AttachConnection(DBusConnection *aConnection);
+
+    /**
+     * This method stops exposing this object on a connection attached by AttachConnection().
+     *
+     * @param[in]   aConnection     The connection.
+     *
+     */
+    void DetachConnection(DBusConnection *aConnection);
+
+    /**
+     * This method returns the outgoing queue counters of the connection.
+     *
+     * @returns The outgoing queue counters.
+     *
+     */
+    DBusQueueCounters GetQueueCounters(void) const;
+
     /**
      * The destructor of a d-bus object.
      *
      */
     virtual ~DBusObject(void);
 
+protected:
+    /**
+     * This method dispatches a d-bus message to the registered method handlers.
+     *
+     * @param[in]   aConnection     The dbus connection.
+     * @param[in]   aMessage        The dbus message.
+     *
+     * @returns Whether the message was handled.
+     *
+     */
+    virtual DBusHandlerResult MessageHandler(DBusConnection *aConnection, DBusMessage *aMessage);
+
+    /**
+     * This method handles a method call which fetches a list of properties of an interface at once.
+     *
+     * The method takes the property names as `as`, and replies an `a{sv}` of the properties in the requested order.
+     * Unlike `GetAll`, only the getters of the requested properties are called.
+     *
+     * @param[in]   aInterfaceName  The interface name of the properties.
+     * @param[in]   aRequest        The dbus request.
+     *
+     */
+    void GetPropertiesMethodHandler(const std::string &aInterfaceName, DBusRequest &aRequest);
+
+    /**
+     * This method handles a method call which updates a list of properties of an interface at once.
+     *
+     * The method takes the property values as `a{sv}`. All of them are validated before the first one is applied,
+     * a value which is not writable or has the wrong type fails the call without changing anything. The values are
+     * then applied in order, and the reply is an `a{si}` of the result of each property.
+     *
+     * @param[in]   aInterfaceName  The interface name of the properties.
+     * @param[in]   aRequest        The dbus request.
+     *
+     */
+    void SetPropertiesMethodHandler(const std::string &aInterfaceName, DBusRequest &aRequest);
+
 private:
+    /**
+     * This class implements a table of handlers indexed by interface and member names.
+     *
+     * Both levels are sorted vectors, so that the table is looked up with the names of a message without allocation.
+     *
+     */
+    template <typename HandlerType> class HandlerTable
+    {
+    public:
+        struct Entry
+        {
+            std::string mName;
+            HandlerType mHandler;
+        };
+
+        typedef std::vector<Entry> Entries;
+
+        /**
+         * This method adds a handler.
+         *
+         * @param[in]   aInterfaceName  The interface name.
+         * @param[in]   aName           The member name.
+         * @param[in]   aHandler        The handler.
+         *
+         * @returns Whether the handler was added, false if the member already had a handler.
+         *
+         */
+        bool Add(const std::string &aInterfaceName, const std::string &aName, const HandlerType &aHandler)
+        {
+            auto interface = LowerBound(mInterfaces, aInterfaceName.c_str());
+            bool added     = false;
+
+            if (interface == mInterfaces.end() || interface->mName != aInterfaceName)
+            {
+                interface = mInterfaces.insert(interface, Interface{aInterfaceName, Entries()});
+            }
+
+            {
+                auto entry = LowerBound(interface->mEntries, aName.c_str());
+
+                VerifyOrExit(entry == interface->mEntries.end() || entry->mName != aName);
+                interface->mEntries.insert(entry, Entry{aName, aHandler});
+                added = true;
+            }
+
+        exit:
+            return added;
+        }
+
+        /**
+         * This method finds the handlers of an interface.
+         *
+         * @param[in]   aInterfaceName  The interface name.
+         *
+         * @returns A pointer to the handlers sorted by name, nullptr if the interface has none.
+         *
+         */
+        const Entries *Find(const char *aInterfaceName) const
+        {
+            auto interface = LowerBound(mInterfaces, aInterfaceName);
+
+            return (interface != mInterfaces.end() && interface->mName == aInterfaceName) ? &interface->mEntries
+                                                                                        : nullptr;
+        }
+
+        /**
+         * This method finds the handler of a member.
+         *
+         * @param[in]   aInterfaceName  The interface name.
+         * @param[in]   aName           The member name.
+         *
+         * @returns A pointer to the handler, nullptr if not found.
+         *
+         */
+        const HandlerType *Find(const char *aInterfaceName, const char *aName) const
+        {
+            const Entries *    entries = Find(aInterfaceName);
+            const HandlerType *handler = nullptr;
+
+            VerifyOrExit(entries != nullptr);
+
+            {
+                auto entry = LowerBound(*entries, aName);
+
+                VerifyOrExit(entry != entries->end() && entry->mName == aName);
+                handler = &entry->mHandler;
+            }
+
+        exit:
+            return handler;
+        }
+
+        /**
+         * This method finds the handler of a member.
+         *
+         * @param[in]   aInterfaceName  The interface name.
+         * @param[in]   aName           The member name.
+         *
+         * @returns A pointer to the handler, nullptr if not found.
+         *
+         */
+        HandlerType *Find(const char *aInterfaceName, const char *aName)
+        {
+            return const_cast<HandlerType *>(static_cast<const HandlerTable *>(this)->Find(aInterfaceName, aName));
+        }
+
+        /**
+         * This method calls a function with the interface name and the entry of each handler, in name order.
+         *
+         * @param[in]   aFunction   The function.
+         *
+         */
+        template <typename FunctionType> void ForEach(FunctionType aFunction)
+        {
+            for (Interface &interface : mInterfaces)
+            {
+                for (Entry &entry : interface.mEntries)
+                {
+                    aFunction(interface.mName, entry.mName, entry.mHandler);
+                }
+            }
+        }
+
+    private:
+        struct Interface
+        {
+            std::string mName;
+            Entries     mEntries;
+        };
+
+        template <typename ContainerType>
+        static auto LowerBound(ContainerType &aContainer, const char *aName) -> decltype(aContainer.begin())
+        {
+            return std::lower_bound(aContainer.begin(), aContainer.end(), aName,
+                                    [](const typename ContainerType::value_type &aItem, const char *aKey) {
+                                        return strcmp(aItem.mName.c_str(), aKey) < 0;
+                                    });
+        }
+
+        std::vector<Interface> mInterfaces;
+    };
+
+    struct DeferredProperties
+    {
+        std::vector<std::string> mChanged;     ///< Names of the properties to signal with their values.
+        std::vector<std::string> mInvalidated; ///< Names of the properties to signal as invalidated.
+    };
+
+    // The signals deferred while the outgoing queue is full are accounted to the D-Bus memory.
+    using DeferredPropertiesEntry = std::pair<const std::string, DeferredProperties>;
+    using DeferredPropertiesMap   = std::map<std::string,
+                                           DeferredProperties,
+                                           std::less<std::string>,
+                                           TaggedAllocator<DeferredPropertiesEntry, kMemoryTagDBus>>;
+
+    struct CallStats
+    {
+        uint32_t mCalls;     ///< The number of calls.
+        uint32_t mErrors;    ///< The number of calls which failed.
+        uint64_t mTotalTime; ///< The cumulative duration of the calls, in microseconds.
+        uint32_t mMaxTime;   ///< The longest duration of a call, in microseconds.
+
+        void Record(uint32_t aDuration, bool aFailed);
+    };
+
+    otError AppendProperty(DBusMessageIter &          aIter,
+                           const char *               aInterfaceName,
+                           const char *               aPropertyName,
+                           const PropertyHandlerType &aHandler);
+    otError CallPropertyHandler(HandlerTable<CallStats> &  aStats,
+                                const char *               aInterfaceName,
+                                const char *               aPropertyName,
+                                const PropertyHandlerType &aHandler,
+                                DBusMessageIter &          aIter);
+
+    struct RequestBucket
+    {
+        uint64_t      mTokens;     ///< The requests the sender may still make, in thousandths of a request.
+        unsigned long mLastRefill; ///< The main loop time of the last refill, in milliseconds.
+        bool          mThrottled;  ///< Whether the last request of the sender was refused.
+    };
+
+    using RequestBucketKey   = std::pair<const DBusConnection *, std::string>;
+    using RequestBucketEntry = std::pair<const RequestBucketKey, RequestBucket>;
+    using RequestBucketMap   = std::map<RequestBucketKey,
+                                      RequestBucket,
+                                      std::less<RequestBucketKey>,
+                                      TaggedAllocator<RequestBucketEntry, kMemoryTagDBus>>;
+
+    bool ConsumeRequestToken(DBusConnection *aConnection, DBusMessage *aMessage);
+    void RefillRequestBucket(RequestBucket &aBucket, unsigned long aNow);
+
+    bool IsOutgoingQueueFull(void);
+    void DeferPropertyChanged(const std::string &aInterfaceName, const std::string &aPropertyName, bool aInvalidated);
+
     void GetAllPropertiesMethodHandler(DBusRequest &aRequest);
 
     void GetPropertyMethodHandler(DBusRequest &aRequest);
 
     void SetPropertyMethodHandler(DBusRequest &aRequest);
 
+    otError GetCallStatsHandler(DBusMessageIter &aIter);
+    void    ResetCallStatsHandler(DBusRequest &aRequest);
+
+    otError FindSetPropertyHandler(const char *                aInterfaceName,
+                                   const char *                aPropertyName,
+                                   DBusMessageIter &           aValueIter,
+                                   const PropertyHandlerType *&aHandler) const;
+
     static DBusHandlerResult sMessageHandler(DBusConnection *aConnection, DBusMessage *aMessage, void *aData);
-    DBusHandlerResult        MessageHandler(DBusConnection *aConnection, DBusMessage *aMessage);
 
-    std::unordered_map<std::string, MethodHandlerType>                                    mMethodHandlers;
-    std::unordered_map<std::string, std::unordered_map<std::string, PropertyHandlerType>> mGetPropertyHandlers;
-    std::unordered_map<std::string, PropertyHandlerType>                                  mSetPropertyHandlers;
-    DBusConnection *                                                                      mConnection;
-    std::string                                                                           mObjectPath;
+    otbrError RegisterObjectPath(DBusConnection *aConnection);
+    bool      SendSignal(DBusMessage *aMessage);
+
+    HandlerTable<MethodHandlerType>        mMethodHandlers;
+    HandlerTable<PropertyHandlerType>      mGetPropertyHandlers;
+    HandlerTable<PropertyHandlerType>      mSetPropertyHandlers;
+    HandlerTable<std::string>              mSetPropertySignatures;
+    HandlerTable<AsyncPropertyHandlerType> mAsyncGetPropertyHandlers;
+    HandlerTable<CallStats>                mMethodStats;
+    HandlerTable<CallStats>                mGetPropertyStats;
+    HandlerTable<CallStats>                mSetPropertyStats;
+    DBusConnection *                       mConnection;
+    std::vector<DBusConnection *>          mAttachedConnections;
+    std::string                            mObjectPath;
+
+    bool                  mOutgoingQueueFull;
+    DBusQueueCounters     mQueueCounters;
+    DeferredPropertiesMap mDeferredProperties;
+    RequestBucketMap      mRequestBuckets;
 };
 
 } // namespace DBus
@@ -52,6 +52,7 @@ public:
     DBusRequest(DBusConnection *aConnection, DBusMessage *aMessage)
         : mConnection(aConnection)
         , mMessage(aMessage)
+        , mFailed(false)
     {
         dbus_message_ref(aMessage);
         dbus_connection_ref(aConnection);
@@ -66,6 +67,7 @@ public:
     DBusRequest(const DBusRequest &aOther)
         : mConnection(nullptr)
         , mMessage(nullptr)
+        , mFailed(false)
     {
         CopyFrom(aOther);
     }
@@ -98,6 +100,14 @@ public:
      */
     DBusConnection *GetConnection(void) { return mConnection; }
 
+    /**
+     * This method indicates whether an error was replied through this request.
+     *
+     * @returns Whether ReplyOtResult() was called with an error.
+     *
+     */
+    bool IsFailed(void) const { return mFailed; }
+
     /**
      * This method replies to the d-bus method call.
      *
@@ -135,7 +145,8 @@ public:
         }
         else
         {
-            reply = UniqueDBusMessage(dbus_message_new_error(mMessage, ConvertToDBusErrorName(aError), nullptr));
+            reply   = UniqueDBusMessage(dbus_message_new_error(mMessage, ConvertToDBusErrorName(aError), nullptr));
+            mFailed = true;
         }
 
         VerifyOrExit(reply != nullptr);
@@ -174,12 +185,14 @@ private:
         }
         mConnection = aOther.mConnection;
         mMessage    = aOther.mMessage;
+        mFailed     = aOther.mFailed;
         dbus_message_ref(mMessage);
         dbus_connection_ref(mConnection);
     }
 
     DBusConnection *mConnection;
     DBusMessage *   mMessage;
+    bool            mFailed;
 };
 
 } // namespace DBus
@@ -26,11 +26,18 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_DBUS
+
 #include <assert.h>
 #include <string.h>
 
+#include <algorithm>
+#include <memory>
+#include <random>
+
 #include <openthread/border_router.h>
 #include <openthread/channel_monitor.h>
+#include <openthread/dataset.h>
 #include <openthread/instance.h>
 #include <openthread/joiner.h>
 #include <openthread/link_raw.h>
@@ -40,13 +47,101 @@
 #include <openthread/platform/radio.h>
 
 #include "common/byteswap.hpp"
+#include "common/flight_recorder.hpp"
+#include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/memory_stats.hpp"
+#include "common/time.hpp"
 #include "dbus/common/constants.hpp"
+#include "dbus/common/network_data.hpp"
+#include "dbus/common/types_openthread.hpp"
 #include "dbus/server/dbus_agent.hpp"
 #include "dbus/server/dbus_thread_object.hpp"
+#include "utils/table_query.hpp"
+
+#ifndef OTBR_CONFIG_DBUS_COUNTERS_SIGNAL_INTERVAL
+/**
+ * The interval in milliseconds to sample the counters properties, which are signaled at most once per interval.
+ *
+ */
+#define OTBR_CONFIG_DBUS_COUNTERS_SIGNAL_INTERVAL 10000
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_RADIO_SIGNAL_INTERVAL
+/**
+ * The interval in milliseconds to sample the radio measurement properties, which are signaled at most once per
+ * interval.
+ *
+ */
+#define OTBR_CONFIG_DBUS_RADIO_SIGNAL_INTERVAL 5000
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_RCP_PROPERTY_MAX_AGE
+/**
+ * The time in milliseconds a property read from the RCP, such as the instant RSSI, is served from cache.
+ *
+ */
+#define OTBR_CONFIG_DBUS_RCP_PROPERTY_MAX_AGE 1000
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_TABLE_MAX_REMOVED
+/**
+ * The number of removed child or neighbor table entries remembered for readers of table deltas.
+ *
+ */
+#define OTBR_CONFIG_DBUS_TABLE_MAX_REMOVED 64
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_LINK_ALERT_INTERVAL
+/**
+ * The default interval in milliseconds to sample the link quality metrics of the alert rules.
+ *
+ */
+#define OTBR_CONFIG_DBUS_LINK_ALERT_INTERVAL 1000
+#endif
+
+#ifndef OTBR_CONFIG_DBUS_MAX_LINK_ALERT_RULES
+/**
+ * The maximum number of link quality alert rules.
+ *
+ */
+#define OTBR_CONFIG_DBUS_MAX_LINK_ALERT_RULES 16
+#endif
 
 using std::placeholders::_1;
 using std::placeholders::_2;
 
+static constexpr uint8_t kNetworkDataMaxSize = 255;
+
+/**
+ * This structure holds the result of a property read from the RCP by another thread.
+ *
+ */
+struct RcpPropertyValue
+{
+    otError mError = OT_ERROR_NONE;
+    int8_t  mValue = 0;
+};
+
+static otError ReadRcpInstantRssi(otInstance *aInstance, int8_t &aValue)
+{
+    aValue = otPlatRadioGetRssi(aInstance);
+
+    return OT_ERROR_NONE;
+}
+
+static otError ReadRcpRadioTxPower(otInstance *aInstance, int8_t &aValue)
+{
+    return otPlatRadioGetTransmitPower(aInstance, &aValue);
+}
+
+static otError ReadRcpProperty(otError (*aRead)(otInstance *, int8_t &), otInstance *aInstance, int8_t &aValue)
+{
+    otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageRcpPropertyGet);
+
+    return aRead(aInstance, aValue);
+}
+
 static std::string GetDeviceRoleName(otDeviceRole aRole)
 {
     std::string roleName;
@@ -73,557 +168,2480 @@ static std::string GetDeviceRoleName(otDeviceRole aRole)
     return roleName;
 }
 
-static uint64_t ConvertOpenThreadUint64(const uint8_t *aValue)
-{
-    uint64_t val = 0;
-
-    for (size_t i = 0; i < sizeof(uint64_t); i++)
-    {
-        val = (val << 8) | aValue[i];
-    }
-    return val;
-}
-
 namespace otbr {
 namespace DBus {
 
-DBusThreadObject::DBusThreadObject(DBusConnection *                 aConnection,
-                                   const std::string &              aInterfaceName,
-                                   otbr::Ncp::ControllerOpenThread *aNcp)
-    : DBusObject(aConnection, OTBR_DBUS_OBJECT_PREFIX + aInterfaceName)
-    , mNcp(aNcp)
+/**
+ * This function summarizes the attributes of a child for table deltas.
+ *
+ * The age, link quality, RSSI and error rates change all the time, so they do not make a child changed.
+ *
+ */
+static uint64_t GetChildState(const otChildInfo &aChildInfo)
 {
+    return (static_cast<uint64_t>(aChildInfo.mTimeout) << 32) | (static_cast<uint64_t>(aChildInfo.mRloc16) << 16) |
+           (static_cast<uint64_t>(aChildInfo.mNetworkDataVersion) << 8) | (aChildInfo.mRxOnWhenIdle << 4) |
+           (aChildInfo.mSecureDataRequest << 3) | (aChildInfo.mFullThreadDevice << 2) |
+           (aChildInfo.mFullNetworkData << 1) | aChildInfo.mIsStateRestoring;
 }
 
-otbrError DBusThreadObject::Init(void)
+/**
+ * This function summarizes the attributes of a neighbor for table deltas.
+ *
+ * The age, frame counters, link quality, RSSI and error rates change all the time, so they do not make a neighbor
+ * changed.
+ *
+ */
+static uint64_t GetNeighborState(const otNeighborInfo &aNeighborInfo)
 {
-    otbrError error        = DBusObject::Init();
-    auto      threadHelper = mNcp->GetThreadHelper();
-
-    threadHelper->AddDeviceRoleHandler(std::bind(&DBusThreadObject::DeviceRoleHandler, this, _1));
-
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_SCAN_METHOD,
-                   std::bind(&DBusThreadObject::ScanHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ATTACH_METHOD,
-                   std::bind(&DBusThreadObject::AttachHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_FACTORY_RESET_METHOD,
-                   std::bind(&DBusThreadObject::FactoryResetHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_RESET_METHOD,
-                   std::bind(&DBusThreadObject::ResetHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_JOINER_START_METHOD,
-                   std::bind(&DBusThreadObject::JoinerStartHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_JOINER_STOP_METHOD,
-                   std::bind(&DBusThreadObject::JoinerStopHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PERMIT_UNSECURE_JOIN_METHOD,
-                   std::bind(&DBusThreadObject::PermitUnsecureJoinHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_ON_MESH_PREFIX_METHOD,
-                   std::bind(&DBusThreadObject::AddOnMeshPrefixHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_ON_MESH_PREFIX_METHOD,
-                   std::bind(&DBusThreadObject::RemoveOnMeshPrefixHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_EXTERNAL_ROUTE_METHOD,
-                   std::bind(&DBusThreadObject::AddExternalRouteHandler, this, _1));
-    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_EXTERNAL_ROUTE_METHOD,
-                   std::bind(&DBusThreadObject::RemoveExternalRouteHandler, this, _1));
-
-    RegisterMethod(DBUS_INTERFACE_INTROSPECTABLE, DBUS_INTROSPECT_METHOD,
-                   std::bind(&DBusThreadObject::IntrospectHandler, this, _1));
-
-    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX,
-                               std::bind(&DBusThreadObject::SetMeshLocalPrefixHandler, this, _1));
-    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LEGACY_ULA_PREFIX,
-                               std::bind(&DBusThreadObject::SetLegacyUlaPrefixHandler, this, _1));
-    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_MODE,
-                               std::bind(&DBusThreadObject::SetLinkModeHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_MODE,
-                               std::bind(&DBusThreadObject::GetLinkModeHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
-                               std::bind(&DBusThreadObject::GetDeviceRoleHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NETWORK_NAME,
-                               std::bind(&DBusThreadObject::GetNetworkNameHandler, this, _1));
-
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PANID,
-                               std::bind(&DBusThreadObject::GetPanIdHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTPANID,
-                               std::bind(&DBusThreadObject::GetExtPanIdHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL,
-                               std::bind(&DBusThreadObject::GetChannelHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MASTER_KEY,
-                               std::bind(&DBusThreadObject::GetMasterKeyHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CCA_FAILURE_RATE,
-                               std::bind(&DBusThreadObject::GetCcaFailureRateHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_COUNTERS,
-                               std::bind(&DBusThreadObject::GetLinkCountersHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_IP6_COUNTERS,
-                               std::bind(&DBusThreadObject::GetIp6CountersHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_SUPPORTED_CHANNEL_MASK,
-                               std::bind(&DBusThreadObject::GetSupportedChannelMaskHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RLOC16,
-                               std::bind(&DBusThreadObject::GetRloc16Handler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTENDED_ADDRESS,
-                               std::bind(&DBusThreadObject::GetExtendedAddressHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ROUTER_ID,
-                               std::bind(&DBusThreadObject::GetRouterIdHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LEADER_DATA,
-                               std::bind(&DBusThreadObject::GetLeaderDataHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NETWORK_DATA_PRPOERTY,
-                               std::bind(&DBusThreadObject::GetNetworkDataHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_STABLE_NETWORK_DATA_PRPOERTY,
-                               std::bind(&DBusThreadObject::GetStableNetworkDataHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LOCAL_LEADER_WEIGHT,
-                               std::bind(&DBusThreadObject::GetLocalLeaderWeightHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_SAMPLE_COUNT,
-                               std::bind(&DBusThreadObject::GetChannelMonitorSampleCountHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_ALL_CHANNEL_QUALITIES,
-                               std::bind(&DBusThreadObject::GetChannelMonitorAllChannelQualities, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHILD_TABLE,
-                               std::bind(&DBusThreadObject::GetChildTableHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY,
-                               std::bind(&DBusThreadObject::GetNeighborTableHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY,
-                               std::bind(&DBusThreadObject::GetPartitionIDHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_INSTANT_RSSI,
-                               std::bind(&DBusThreadObject::GetInstantRssiHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RADIO_TX_POWER,
-                               std::bind(&DBusThreadObject::GetRadioTxPowerHandler, this, _1));
-    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTERNAL_ROUTES,
-                               std::bind(&DBusThreadObject::GetExternalRoutesHandler, this, _1));
-
-    return error;
+    return (static_cast<uint64_t>(aNeighborInfo.mRloc16) << 8) | (aNeighborInfo.mRxOnWhenIdle << 4) |
+           (aNeighborInfo.mSecureDataRequest << 3) | (aNeighborInfo.mFullThreadDevice << 2) |
+           (aNeighborInfo.mFullNetworkData << 1) | aNeighborInfo.mIsChild;
 }
 
-void DBusThreadObject::DeviceRoleHandler(otDeviceRole aDeviceRole)
+template <typename HandlerType> static otError ForEachChild(otInstance *aInstance, HandlerType aHandler)
 {
-    SignalPropertyChanged(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE, GetDeviceRoleName(aDeviceRole));
-}
+    uint16_t    maxChildren = otThreadGetMaxAllowedChildren(aInstance);
+    otChildInfo childInfo;
+    otError     error = OT_ERROR_NONE;
 
-void DBusThreadObject::ScanHandler(DBusRequest &aRequest)
-{
-    auto threadHelper = mNcp->GetThreadHelper();
-    threadHelper->Scan(std::bind(&DBusThreadObject::ReplyScanResult, this, aRequest, _1, _2));
+    for (uint16_t childIndex = 0; childIndex < maxChildren; childIndex++)
+    {
+        // The slots of children which are gone are not valid, but the following slots may be.
+        if (otThreadGetChildInfoByIndex(aInstance, childIndex, &childInfo) == OT_ERROR_NONE)
+        {
+            SuccessOrExit(error = aHandler(childInfo));
+        }
+    }
+
+exit:
+    return error;
 }
 
-void DBusThreadObject::ReplyScanResult(DBusRequest &                          aRequest,
-                                       otError                                aError,
-                                       const std::vector<otActiveScanResult> &aResult)
+template <typename HandlerType> static otError ForEachNeighbor(otInstance *aInstance, HandlerType aHandler)
 {
-    std::vector<ActiveScanResult> results;
+    otNeighborInfoIterator iter = OT_NEIGHBOR_INFO_ITERATOR_INIT;
+    otNeighborInfo         neighborInfo;
+    otError                error = OT_ERROR_NONE;
 
-    if (aError != OT_ERROR_NONE)
+    while (otThreadGetNextNeighborInfo(aInstance, &iter, &neighborInfo) == OT_ERROR_NONE)
     {
-        aRequest.ReplyOtResult(aError);
+        SuccessOrExit(error = aHandler(neighborInfo));
     }
-    else
-    {
-        for (const auto &r : aResult)
-        {
-            ActiveScanResult result;
-
-            result.mExtAddress    = ConvertOpenThreadUint64(r.mExtAddress.m8);
-            result.mExtendedPanId = ConvertOpenThreadUint64(r.mExtendedPanId.m8);
-            result.mNetworkName   = r.mNetworkName.m8;
-            result.mSteeringData =
-                std::vector<uint8_t>(r.mSteeringData.m8, r.mSteeringData.m8 + r.mSteeringData.mLength);
-            result.mPanId         = r.mPanId;
-            result.mJoinerUdpPort = r.mJoinerUdpPort;
-            result.mChannel       = r.mChannel;
-            result.mRssi          = r.mRssi;
-            result.mLqi           = r.mLqi;
-            result.mVersion       = r.mVersion;
-            result.mIsNative      = r.mIsNative;
-            result.mIsJoinable    = r.mIsJoinable;
 
-            results.emplace_back(result);
-        }
-
-        aRequest.Reply(std::tie(results));
-    }
+exit:
+    return error;
 }
 
-void DBusThreadObject::AttachHandler(DBusRequest &aRequest)
+/**
+ * This function sets up the selection of the entries of a table query.
+ *
+ */
+static otError ToTableSelector(const TableQuery &aQuery, otbr::TableQuery &aSelector)
 {
-    auto                 threadHelper = mNcp->GetThreadHelper();
-    std::string          name;
-    uint16_t             panid;
-    uint64_t             extPanId;
-    std::vector<uint8_t> masterKey;
-    std::vector<uint8_t> pskc;
-    uint32_t             channelMask;
+    otError error = OT_ERROR_NONE;
 
-    auto args = std::tie(masterKey, panid, name, extPanId, pskc, channelMask);
+    VerifyOrExit(aSelector.SetLinkQualityRange(aQuery.mMinLinkQuality, aQuery.mMaxLinkQuality),
+                 error = OT_ERROR_INVALID_ARGS);
+    aSelector.SetPage(aQuery.mOffset, aQuery.mLimit);
 
-    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    if (aQuery.mHasRloc16)
     {
-        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+        aSelector.SetRloc16(aQuery.mRloc16);
     }
-    else
+
+    if (aQuery.mHasExtAddress)
     {
-        threadHelper->Attach(name, panid, extPanId, masterKey, pskc, channelMask,
-                             [aRequest](otError aError) mutable { aRequest.ReplyOtResult(aError); });
+        aSelector.SetExtAddress(aQuery.mExtAddress);
     }
-}
 
-void DBusThreadObject::FactoryResetHandler(DBusRequest &aRequest)
-{
-    aRequest.ReplyOtResult(OT_ERROR_NONE);
-    otInstanceFactoryReset(mNcp->GetThreadHelper()->GetInstance());
-    mNcp->Reset();
-    mNcp->GetThreadHelper()->AddDeviceRoleHandler(std::bind(&DBusThreadObject::DeviceRoleHandler, this, _1));
-    SignalPropertyChanged(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
-                          GetDeviceRoleName(OT_DEVICE_ROLE_DISABLED));
+exit:
+    return error;
 }
 
-void DBusThreadObject::ResetHandler(DBusRequest &aRequest)
+/**
+ * This function starts encoding a table delta reply, up to the array of updated entries.
+ *
+ */
+static otError BeginTableDelta(DBusMessageIter &aIter,
+                               DBusMessageIter &aEntriesIter,
+                               TableVersion &   aTable,
+                               uint32_t         aSinceVersion,
+                               const char *     aEntrySignature)
 {
-    mNcp->Reset();
-    mNcp->GetThreadHelper()->AddDeviceRoleHandler(std::bind(&DBusThreadObject::DeviceRoleHandler, this, _1));
-    SignalPropertyChanged(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
-                          GetDeviceRoleName(OT_DEVICE_ROLE_DISABLED));
+    dbus_bool_t reset = aTable.BeginScan(aSinceVersion);
+    otError     error = OT_ERROR_NONE;
 
-    aRequest.ReplyOtResult(OT_ERROR_NONE);
+    VerifyOrExit(dbus_message_iter_append_basic(&aIter, DBUS_TYPE_BOOLEAN, &reset), error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_ARRAY, aEntrySignature, &aEntriesIter),
+                 error = OT_ERROR_NO_BUFS);
+
+exit:
+    return error;
 }
 
-void DBusThreadObject::JoinerStartHandler(DBusRequest &aRequest)
+/**
+ * This function finishes encoding a table delta reply, with the removed entries and the new table version.
+ *
+ */
+static otError EndTableDelta(DBusMessageIter &aIter, DBusMessageIter &aEntriesIter, TableVersion &aTable)
 {
-    auto        threadHelper = mNcp->GetThreadHelper();
-    std::string pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData;
-    auto        args = std::tie(pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData);
+    DBusMessageIter removedIter;
+    uint32_t        version;
+    bool            appended = true;
+    otError         error    = OT_ERROR_NONE;
 
-    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
-    {
-        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
-    }
-    else
-    {
-        threadHelper->JoinerStart(pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData,
-                                  [aRequest](otError aError) mutable { aRequest.ReplyOtResult(aError); });
-    }
+    VerifyOrExit(dbus_message_iter_close_container(&aIter, &aEntriesIter), error = OT_ERROR_NO_BUFS);
+    aTable.EndScan();
+
+    VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_ARRAY, DBUS_TYPE_UINT64_AS_STRING, &removedIter),
+                 error = OT_ERROR_NO_BUFS);
+    aTable.ForEachRemoved([&removedIter, &appended](uint64_t aKey) {
+        appended = appended && dbus_message_iter_append_basic(&removedIter, DBUS_TYPE_UINT64, &aKey);
+    });
+    VerifyOrExit(appended, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_close_container(&aIter, &removedIter), error = OT_ERROR_NO_BUFS);
+
+    version = aTable.GetVersion();
+    VerifyOrExit(dbus_message_iter_append_basic(&aIter, DBUS_TYPE_UINT32, &version), error = OT_ERROR_NO_BUFS);
+
+exit:
+    return error;
 }
 
-void DBusThreadObject::JoinerStopHandler(DBusRequest &aRequest)
+static bool IsSameIp6Prefix(const otIp6Prefix &aLhs, const otIp6Prefix &aRhs)
 {
-    auto threadHelper = mNcp->GetThreadHelper();
-
-    otJoinerStop(threadHelper->GetInstance());
-    aRequest.ReplyOtResult(OT_ERROR_NONE);
+    return aLhs.mLength == aRhs.mLength && memcmp(&aLhs.mPrefix, &aRhs.mPrefix, sizeof(aLhs.mPrefix)) == 0;
 }
 
-void DBusThreadObject::PermitUnsecureJoinHandler(DBusRequest &aRequest)
+static void ConvertOperationalDataset(const otOperationalDataset &aOtDataset, OperationalDataset &aDataset)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    uint16_t port;
-    uint32_t timeout;
-    auto     args = std::tie(port, timeout);
+    const otOperationalDatasetComponents &components = aOtDataset.mComponents;
 
-    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    aDataset = OperationalDataset();
+
+    if (components.mIsActiveTimestampPresent)
     {
-        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+        aDataset.mActiveTimestamp = aOtDataset.mActiveTimestamp;
+        aDataset.mComponents |= OTBR_DATASET_ACTIVE_TIMESTAMP;
     }
-    else
+    if (components.mIsPendingTimestampPresent)
     {
-        aRequest.ReplyOtResult(threadHelper->PermitUnsecureJoin(port, timeout));
+        aDataset.mPendingTimestamp = aOtDataset.mPendingTimestamp;
+        aDataset.mComponents |= OTBR_DATASET_PENDING_TIMESTAMP;
     }
-}
+    if (components.mIsMasterKeyPresent)
+    {
+        aDataset.mMasterKey.assign(std::begin(aOtDataset.mMasterKey.m8), std::end(aOtDataset.mMasterKey.m8));
+        aDataset.mComponents |= OTBR_DATASET_MASTER_KEY;
+    }
+    if (components.mIsNetworkNamePresent)
+    {
+        aDataset.mNetworkName = aOtDataset.mNetworkName.m8;
+        aDataset.mComponents |= OTBR_DATASET_NETWORK_NAME;
+    }
+    if (components.mIsExtendedPanIdPresent)
+    {
+        aDataset.mExtendedPanId = ConvertToUint64(aOtDataset.mExtendedPanId);
+        aDataset.mComponents |= OTBR_DATASET_EXTENDED_PAN_ID;
+    }
+    if (components.mIsMeshLocalPrefixPresent)
+    {
+        aDataset.mMeshLocalPrefix.assign(std::begin(aOtDataset.mMeshLocalPrefix.m8),
+                                         std::end(aOtDataset.mMeshLocalPrefix.m8));
+        aDataset.mComponents |= OTBR_DATASET_MESH_LOCAL_PREFIX;
+    }
+    if (components.mIsDelayPresent)
+    {
+        aDataset.mDelay = aOtDataset.mDelay;
+        aDataset.mComponents |= OTBR_DATASET_DELAY;
+    }
+    if (components.mIsPanIdPresent)
+    {
+        aDataset.mPanId = aOtDataset.mPanId;
+        aDataset.mComponents |= OTBR_DATASET_PAN_ID;
+    }
+    if (components.mIsChannelPresent)
+    {
+        aDataset.mChannel = aOtDataset.mChannel;
+        aDataset.mComponents |= OTBR_DATASET_CHANNEL;
+    }
+    if (components.mIsPskcPresent)
+    {
+        aDataset.mPskc.assign(std::begin(aOtDataset.mPskc.m8), std::end(aOtDataset.mPskc.m8));
+        aDataset.mComponents |= OTBR_DATASET_PSKC;
+    }
+    if (components.mIsSecurityPolicyPresent)
+    {
+        aDataset.mSecurityPolicyRotationTime = aOtDataset.mSecurityPolicy.mRotationTime;
+        aDataset.mSecurityPolicyFlags        = aOtDataset.mSecurityPolicy.mFlags;
+        aDataset.mComponents |= OTBR_DATASET_SECURITY_POLICY;
+    }
+    if (components.mIsChannelMaskPresent)
+    {
+        aDataset.mChannelMask = aOtDataset.mChannelMask;
+        aDataset.mComponents |= OTBR_DATASET_CHANNEL_MASK;
+    }
+}
+
+/**
+ * This function encodes an operational dataset as TLVs, which are empty if the dataset is not present.
+ *
+ */
+static otError EncodeDatasetTlvs(DBusMessageIter &aIter,
+                                 otError (*aGet)(otInstance *, otOperationalDatasetTlvs *),
+                                 otInstance *aInstance)
+{
+    otOperationalDatasetTlvs datasetTlvs;
+    std::vector<uint8_t>     tlvs;
+    otError                  error = aGet(aInstance, &datasetTlvs);
+
+    if (error == OT_ERROR_NONE)
+    {
+        tlvs.assign(datasetTlvs.mTlvs, datasetTlvs.mTlvs + datasetTlvs.mLength);
+    }
+    else
+    {
+        VerifyOrExit(error == OT_ERROR_NOT_FOUND);
+        error = OT_ERROR_NONE;
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, tlvs) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+static otError ExtractDatasetTlvs(DBusMessageIter &aIter,
+                                  otError (*aSet)(otInstance *, const otOperationalDatasetTlvs *),
+                                  otInstance *aInstance)
+{
+    otOperationalDatasetTlvs datasetTlvs;
+    std::vector<uint8_t>     tlvs;
+    otError                  error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, tlvs) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(tlvs.size() <= sizeof(datasetTlvs.mTlvs), error = OT_ERROR_INVALID_ARGS);
+    std::copy(tlvs.begin(), tlvs.end(), datasetTlvs.mTlvs);
+    datasetTlvs.mLength = static_cast<uint8_t>(tlvs.size());
+    error               = aSet(aInstance, &datasetTlvs);
+
+exit:
+    return error;
+}
+
+/**
+ * This function encodes a parsed operational dataset, which has no components if the dataset is not present.
+ *
+ */
+static otError EncodeDataset(DBusMessageIter &aIter,
+                             otError (*aGet)(otInstance *, otOperationalDataset *),
+                             otInstance *aInstance)
+{
+    otOperationalDataset otDataset;
+    OperationalDataset   dataset;
+    otError              error = aGet(aInstance, &otDataset);
+
+    if (error == OT_ERROR_NONE)
+    {
+        ConvertOperationalDataset(otDataset, dataset);
+    }
+    else
+    {
+        VerifyOrExit(error == OT_ERROR_NOT_FOUND);
+        error   = OT_ERROR_NONE;
+        dataset = OperationalDataset();
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, dataset) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+static void ReadUnicastAddresses(otInstance *aInstance, std::vector<Ip6AddressInfo> &aAddresses)
+{
+    for (const otNetifAddress *addr = otIp6GetUnicastAddresses(aInstance); addr != nullptr; addr = addr->mNext)
+    {
+        Ip6AddressInfo info;
+
+        info.mAddress.assign(std::begin(addr->mAddress.mFields.m8), std::end(addr->mAddress.mFields.m8));
+        info.mPrefixLength = addr->mPrefixLength;
+        info.mPreferred    = addr->mPreferred;
+        info.mValid        = addr->mValid;
+        info.mRloc         = addr->mRloc;
+        aAddresses.push_back(info);
+    }
+}
+
+static void ReadMulticastAddresses(otInstance *aInstance, std::vector<std::vector<uint8_t>> &aAddresses)
+{
+    const otNetifMulticastAddress *addr;
+
+    for (addr = otIp6GetMulticastAddresses(aInstance); addr != nullptr; addr = addr->mNext)
+    {
+        aAddresses.emplace_back(std::begin(addr->mAddress.mFields.m8), std::end(addr->mAddress.mFields.m8));
+    }
+}
+
+static const std::vector<uint8_t> &GetAddressOf(const Ip6AddressInfo &aInfo)
+{
+    return aInfo.mAddress;
+}
+
+static const std::vector<uint8_t> &GetAddressOf(const std::vector<uint8_t> &aAddress)
+{
+    return aAddress;
+}
+
+static bool IsSameEntry(const Ip6AddressInfo &aLhs, const Ip6AddressInfo &aRhs)
+{
+    return aLhs.mAddress == aRhs.mAddress && aLhs.mPrefixLength == aRhs.mPrefixLength &&
+           aLhs.mPreferred == aRhs.mPreferred && aLhs.mValid == aRhs.mValid && aLhs.mRloc == aRhs.mRloc;
+}
+
+static bool IsSameEntry(const std::vector<uint8_t> &aLhs, const std::vector<uint8_t> &aRhs)
+{
+    return aLhs == aRhs;
+}
+
+/**
+ * This function compares two versions of an address table, keyed by the address.
+ *
+ */
+template <typename EntryType>
+static void DiffIp6Addresses(const std::vector<EntryType> &     aOld,
+                             const std::vector<EntryType> &     aNew,
+                             std::vector<EntryType> &           aUpdated,
+                             std::vector<std::vector<uint8_t>> &aRemoved)
+{
+    for (const EntryType &entry : aNew)
+    {
+        auto old = std::find_if(aOld.begin(), aOld.end(), [&entry](const EntryType &aOldEntry) {
+            return GetAddressOf(aOldEntry) == GetAddressOf(entry);
+        });
+
+        if (old == aOld.end() || !IsSameEntry(*old, entry))
+        {
+            aUpdated.push_back(entry);
+        }
+    }
+
+    for (const EntryType &entry : aOld)
+    {
+        auto found = std::find_if(aNew.begin(), aNew.end(), [&entry](const EntryType &aNewEntry) {
+            return GetAddressOf(aNewEntry) == GetAddressOf(entry);
+        });
+
+        if (found == aNew.end())
+        {
+            aRemoved.push_back(GetAddressOf(entry));
+        }
+    }
+}
+
+static void ConvertTopology(const otbr::Topology &aTopology, std::vector<TopologyNode> &aNodes)
+{
+    unsigned long now = GetNow();
+
+    for (const auto &entry : aTopology.GetNodes())
+    {
+        const otbr::Topology::Node &node = entry.second;
+        TopologyNode                value;
+
+        value.mRloc16     = node.mRloc16;
+        value.mExtAddress = node.mExtAddress;
+        value.mAge        = static_cast<uint32_t>(now - node.mUpdateTime);
+
+        for (const otbr::Topology::Link &link : node.mLinks)
+        {
+            value.mLinks.push_back({link.mRloc16, link.mLinkQualityIn, link.mLinkQualityOut});
+        }
+
+        for (const otbr::Topology::Child &child : node.mChildren)
+        {
+            value.mChildren.push_back({child.mRloc16, child.mMode});
+        }
+
+        aNodes.push_back(value);
+    }
+}
+
+/**
+ * This class applies a batch of changes to the local border router configuration.
+ *
+ * The changes are only registered with the leader on Commit(). If any change or the registration fails, the changes
+ * applied so far are undone in reverse order, so the local configuration matches what was last registered.
+ *
+ */
+class BorderRouterTransaction
+{
+public:
+    explicit BorderRouterTransaction(otInstance *aInstance)
+        : mInstance(aInstance)
+        , mCommitted(false)
+    {
+    }
+
+    ~BorderRouterTransaction(void)
+    {
+        if (!mCommitted)
+        {
+            Rollback();
+        }
+    }
+
+    otError AddOnMeshPrefix(const otBorderRouterConfig &aConfig)
+    {
+        Undo    undo;
+        otError error;
+
+        undo.mIsPrefix  = true;
+        undo.mHadConfig = FindOnMeshPrefix(aConfig.mPrefix, undo.mPrefixConfig);
+        undo.mPrefix    = aConfig.mPrefix;
+
+        SuccessOrExit(error = otBorderRouterAddOnMeshPrefix(mInstance, &aConfig));
+        mUndos.push_back(undo);
+
+    exit:
+        return error;
+    }
+
+    otError RemoveOnMeshPrefix(const otIp6Prefix &aPrefix)
+    {
+        Undo    undo;
+        otError error;
+
+        undo.mIsPrefix  = true;
+        undo.mHadConfig = FindOnMeshPrefix(aPrefix, undo.mPrefixConfig);
+        undo.mPrefix    = aPrefix;
+
+        SuccessOrExit(error = otBorderRouterRemoveOnMeshPrefix(mInstance, &aPrefix));
+        mUndos.push_back(undo);
+
+    exit:
+        return error;
+    }
+
+    otError AddExternalRoute(const otExternalRouteConfig &aConfig)
+    {
+        Undo    undo;
+        otError error;
+
+        undo.mIsPrefix  = false;
+        undo.mHadConfig = FindExternalRoute(aConfig.mPrefix, undo.mRouteConfig);
+        undo.mPrefix    = aConfig.mPrefix;
+
+        SuccessOrExit(error = otBorderRouterAddRoute(mInstance, &aConfig));
+        mUndos.push_back(undo);
+
+    exit:
+        return error;
+    }
+
+    otError RemoveExternalRoute(const otIp6Prefix &aPrefix)
+    {
+        Undo    undo;
+        otError error;
+
+        undo.mIsPrefix  = false;
+        undo.mHadConfig = FindExternalRoute(aPrefix, undo.mRouteConfig);
+        undo.mPrefix    = aPrefix;
+
+        SuccessOrExit(error = otBorderRouterRemoveRoute(mInstance, &aPrefix));
+        mUndos.push_back(undo);
+
+    exit:
+        return error;
+    }
+
+    otError Commit(void)
+    {
+        otError error = OT_ERROR_NONE;
+
+        if (!mUndos.empty())
+        {
+            SuccessOrExit(error = otBorderRouterRegister(mInstance));
+        }
+
+        mCommitted = true;
+
+    exit:
+        return error;
+    }
+
+private:
+    struct Undo
+    {
+        bool                  mIsPrefix;
+        bool                  mHadConfig;
+        otIp6Prefix           mPrefix;
+        otBorderRouterConfig  mPrefixConfig;
+        otExternalRouteConfig mRouteConfig;
+    };
+
+    bool FindOnMeshPrefix(const otIp6Prefix &aPrefix, otBorderRouterConfig &aConfig) const
+    {
+        otNetworkDataIterator iterator = OT_NETWORK_DATA_ITERATOR_INIT;
+        bool                  found    = false;
+
+        while (!found && otBorderRouterGetNextOnMeshPrefix(mInstance, &iterator, &aConfig) == OT_ERROR_NONE)
+        {
+            found = IsSameIp6Prefix(aConfig.mPrefix, aPrefix);
+        }
+
+        return found;
+    }
+
+    bool FindExternalRoute(const otIp6Prefix &aPrefix, otExternalRouteConfig &aConfig) const
+    {
+        otNetworkDataIterator iterator = OT_NETWORK_DATA_ITERATOR_INIT;
+        bool                  found    = false;
+
+        while (!found && otBorderRouterGetNextRoute(mInstance, &iterator, &aConfig) == OT_ERROR_NONE)
+        {
+            found = IsSameIp6Prefix(aConfig.mPrefix, aPrefix);
+        }
+
+        return found;
+    }
+
+    void Rollback(void)
+    {
+        for (auto undo = mUndos.rbegin(); undo != mUndos.rend(); ++undo)
+        {
+            otError error;
+
+            if (undo->mIsPrefix)
+            {
+                error = undo->mHadConfig ? otBorderRouterAddOnMeshPrefix(mInstance, &undo->mPrefixConfig)
+                                         : otBorderRouterRemoveOnMeshPrefix(mInstance, &undo->mPrefix);
+            }
+            else
+            {
+                error = undo->mHadConfig ? otBorderRouterAddRoute(mInstance, &undo->mRouteConfig)
+                                         : otBorderRouterRemoveRoute(mInstance, &undo->mPrefix);
+            }
+
+            if (error != OT_ERROR_NONE)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Failed to undo a border router change: %s", otThreadErrorToString(error));
+            }
+        }
+    }
+
+    otInstance *      mInstance;
+    bool              mCommitted;
+    std::vector<Undo> mUndos;
+};
+
+DBusThreadObject::DBusThreadObject(DBusConnection *                 aConnection,
+                                   const std::string &              aInterfaceName,
+                                   otbr::Ncp::ControllerOpenThread *aNcp)
+    : DBusObject(aConnection, OTBR_DBUS_OBJECT_PREFIX + aInterfaceName)
+    , mNcp(aNcp)
+    , mSnapshotWakeups(0)
+    , mSnapshotValid(false)
+    , mRateLimitedProperties{
+          {OTBR_DBUS_PROPERTY_CCA_FAILURE_RATE, OTBR_CONFIG_DBUS_RADIO_SIGNAL_INTERVAL,
+           &DBusThreadObject::ReadCcaFailureRate, 0, std::vector<uint8_t>()},
+          {OTBR_DBUS_PROPERTY_LINK_COUNTERS, OTBR_CONFIG_DBUS_COUNTERS_SIGNAL_INTERVAL,
+           &DBusThreadObject::ReadLinkCounters, 0, std::vector<uint8_t>()},
+          {OTBR_DBUS_PROPERTY_IP6_COUNTERS, OTBR_CONFIG_DBUS_COUNTERS_SIGNAL_INTERVAL,
+           &DBusThreadObject::ReadIp6Counters, 0, std::vector<uint8_t>()},
+          {OTBR_DBUS_PROPERTY_INSTANT_RSSI, OTBR_CONFIG_DBUS_RADIO_SIGNAL_INTERVAL, &DBusThreadObject::ReadInstantRssi,
+           0, std::vector<uint8_t>()},
+      }
+    , mRcpProperties{
+          {ReadRcpInstantRssi, 0, OT_ERROR_NONE, 0, false, false, std::vector<DBusRequest>()},
+          {ReadRcpRadioTxPower, 0, OT_ERROR_NONE, 0, false, false, std::vector<DBusRequest>()},
+      }
+    , mSampleTimer(HandleSampleTimer, this)
+    , mChildTableVersion(std::random_device()(), OTBR_CONFIG_DBUS_TABLE_MAX_REMOVED)
+    , mNeighborTableVersion(std::random_device()(), OTBR_CONFIG_DBUS_TABLE_MAX_REMOVED)
+    , mNetworkDataInfoRloc16(0)
+    , mNetworkDataInfoValid(false)
+    , mIp6AddressesValid(false)
+    , mLinkAlerts(OTBR_CONFIG_DBUS_MAX_LINK_ALERT_RULES)
+    , mLinkAlertTimer(HandleLinkAlertTimer, this)
+    , mLinkAlertInterval(OTBR_CONFIG_DBUS_LINK_ALERT_INTERVAL)
+    , mLinkAlertTxTotal(0)
+    , mLinkAlertTxRetry(0)
+    , mLinkAlertCountersValid(false)
+{
+}
+
+otbrError DBusThreadObject::Init(void)
+{
+    otbrError error = DBusObject::Init();
+
+    RegisterStateChangedHandler();
+
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_SCAN_METHOD,
+                   std::bind(&DBusThreadObject::ScanHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ATTACH_METHOD,
+                   std::bind(&DBusThreadObject::AttachHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_FACTORY_RESET_METHOD,
+                   std::bind(&DBusThreadObject::FactoryResetHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_RESET_METHOD,
+                   std::bind(&DBusThreadObject::ResetHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_JOINER_START_METHOD,
+                   std::bind(&DBusThreadObject::JoinerStartHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_JOINER_STOP_METHOD,
+                   std::bind(&DBusThreadObject::JoinerStopHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_JOINERS_METHOD,
+                   std::bind(&DBusThreadObject::AddJoinersHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_JOINERS_METHOD,
+                   std::bind(&DBusThreadObject::RemoveJoinersHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PERMIT_UNSECURE_JOIN_METHOD,
+                   std::bind(&DBusThreadObject::PermitUnsecureJoinHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_ON_MESH_PREFIX_METHOD,
+                   std::bind(&DBusThreadObject::AddOnMeshPrefixHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_ON_MESH_PREFIX_METHOD,
+                   std::bind(&DBusThreadObject::RemoveOnMeshPrefixHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_EXTERNAL_ROUTE_METHOD,
+                   std::bind(&DBusThreadObject::AddExternalRouteHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_EXTERNAL_ROUTE_METHOD,
+                   std::bind(&DBusThreadObject::RemoveExternalRouteHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_UPDATE_BORDER_ROUTER_CONFIG_METHOD,
+                   std::bind(&DBusThreadObject::UpdateBorderRouterConfigHandler, this, _1));
+
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_PROPERTIES_METHOD,
+                   std::bind(&DBusThreadObject::GetPropertiesHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_SET_PROPERTIES_METHOD,
+                   std::bind(&DBusThreadObject::SetPropertiesHandler, this, _1));
+
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_CHILD_TABLE_DELTA_METHOD,
+                   std::bind(&DBusThreadObject::GetChildTableDeltaHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_NEIGHBOR_TABLE_DELTA_METHOD,
+                   std::bind(&DBusThreadObject::GetNeighborTableDeltaHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_QUERY_CHILD_TABLE_METHOD,
+                   std::bind(&DBusThreadObject::QueryChildTableHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_QUERY_NEIGHBOR_TABLE_METHOD,
+                   std::bind(&DBusThreadObject::QueryNeighborTableHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_COUNTER_RATES_METHOD,
+                   std::bind(&DBusThreadObject::GetCounterRatesHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_GET_TOPOLOGY_METHOD,
+                   std::bind(&DBusThreadObject::GetTopologyHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_ADD_LINK_ALERT_RULE_METHOD,
+                   std::bind(&DBusThreadObject::AddLinkAlertRuleHandler, this, _1));
+    RegisterMethod(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_REMOVE_LINK_ALERT_RULE_METHOD,
+                   std::bind(&DBusThreadObject::RemoveLinkAlertRuleHandler, this, _1));
+
+    RegisterMethod(DBUS_INTERFACE_INTROSPECTABLE, DBUS_INTROSPECT_METHOD,
+                   std::bind(&DBusThreadObject::IntrospectHandler, this, _1));
+
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX,
+                               std::bind(&DBusThreadObject::SetMeshLocalPrefixHandler, this, _1), "ay");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LEGACY_ULA_PREFIX,
+                               std::bind(&DBusThreadObject::SetLegacyUlaPrefixHandler, this, _1), "ay");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_MODE,
+                               std::bind(&DBusThreadObject::SetLinkModeHandler, this, _1), "(bbbb)");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ACTIVE_DATASET_TLVS,
+                               std::bind(&DBusThreadObject::SetActiveDatasetTlvsHandler, this, _1), "ay");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PENDING_DATASET_TLVS,
+                               std::bind(&DBusThreadObject::SetPendingDatasetTlvsHandler, this, _1), "ay");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LOG_LEVELS,
+                               std::bind(&DBusThreadObject::SetLogLevelsHandler, this, _1), "a(si)");
+    RegisterSetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_ALERT_INTERVAL,
+                               std::bind(&DBusThreadObject::SetLinkAlertIntervalHandler, this, _1), "u");
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX,
+                               std::bind(&DBusThreadObject::GetMeshLocalPrefixHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_MODE,
+                               std::bind(&DBusThreadObject::GetLinkModeHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
+                               std::bind(&DBusThreadObject::GetDeviceRoleHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NETWORK_NAME,
+                               std::bind(&DBusThreadObject::GetNetworkNameHandler, this, _1));
+
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PANID,
+                               std::bind(&DBusThreadObject::GetPanIdHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTPANID,
+                               std::bind(&DBusThreadObject::GetExtPanIdHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL,
+                               std::bind(&DBusThreadObject::GetChannelHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MASTER_KEY,
+                               std::bind(&DBusThreadObject::GetMasterKeyHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CCA_FAILURE_RATE,
+                               std::bind(&DBusThreadObject::GetCcaFailureRateHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_COUNTERS,
+                               std::bind(&DBusThreadObject::GetLinkCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_IP6_COUNTERS,
+                               std::bind(&DBusThreadObject::GetIp6CountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_SUPPORTED_CHANNEL_MASK,
+                               std::bind(&DBusThreadObject::GetSupportedChannelMaskHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RLOC16,
+                               std::bind(&DBusThreadObject::GetRloc16Handler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTENDED_ADDRESS,
+                               std::bind(&DBusThreadObject::GetExtendedAddressHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ROUTER_ID,
+                               std::bind(&DBusThreadObject::GetRouterIdHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LEADER_DATA,
+                               std::bind(&DBusThreadObject::GetLeaderDataHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NETWORK_DATA_PRPOERTY,
+                               std::bind(&DBusThreadObject::GetNetworkDataHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_STABLE_NETWORK_DATA_PRPOERTY,
+                               std::bind(&DBusThreadObject::GetStableNetworkDataHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NETWORK_DATA_INFO,
+                               std::bind(&DBusThreadObject::GetNetworkDataInfoHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LOCAL_LEADER_WEIGHT,
+                               std::bind(&DBusThreadObject::GetLocalLeaderWeightHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_SAMPLE_COUNT,
+                               std::bind(&DBusThreadObject::GetChannelMonitorSampleCountHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL_MONITOR_ALL_CHANNEL_QUALITIES,
+                               std::bind(&DBusThreadObject::GetChannelMonitorAllChannelQualities, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHANNEL_QUALITY_SCORES,
+                               std::bind(&DBusThreadObject::GetChannelQualityScoresHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_CHILD_TABLE,
+                               std::bind(&DBusThreadObject::GetChildTableHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY,
+                               std::bind(&DBusThreadObject::GetNeighborTableHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY,
+                               std::bind(&DBusThreadObject::GetPartitionIDHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_INSTANT_RSSI,
+                               std::bind(&DBusThreadObject::GetInstantRssiHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RADIO_TX_POWER,
+                               std::bind(&DBusThreadObject::GetRadioTxPowerHandler, this, _1));
+    RegisterAsyncGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_INSTANT_RSSI,
+                                    std::bind(&DBusThreadObject::GetRcpPropertyAsyncHandler, this,
+                                              static_cast<uint8_t>(kRcpPropertyInstantRssi), _1));
+    RegisterAsyncGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RADIO_TX_POWER,
+                                    std::bind(&DBusThreadObject::GetRcpPropertyAsyncHandler, this,
+                                              static_cast<uint8_t>(kRcpPropertyRadioTxPower), _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EXTERNAL_ROUTES,
+                               std::bind(&DBusThreadObject::GetExternalRoutesHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MAINLOOP_COUNTERS,
+                               std::bind(&DBusThreadObject::GetMainloopCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MAINLOOP_HISTOGRAMS,
+                               std::bind(&DBusThreadObject::GetMainloopHistogramsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MEMORY_USAGE,
+                               std::bind(&DBusThreadObject::GetMemoryUsageHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DBUS_QUEUE_COUNTERS,
+                               std::bind(&DBusThreadObject::GetDBusQueueCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_OPERATION_QUEUE_COUNTERS,
+                               std::bind(&DBusThreadObject::GetOperationQueueCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_JOINER_COUNTERS,
+                               std::bind(&DBusThreadObject::GetJoinerCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ADDRESS_CACHE,
+                               std::bind(&DBusThreadObject::GetAddressCacheHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ADDRESS_CACHE_COUNTERS,
+                               std::bind(&DBusThreadObject::GetAddressCacheCountersHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ACTIVE_DATASET_TLVS,
+                               std::bind(&DBusThreadObject::GetActiveDatasetTlvsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PENDING_DATASET_TLVS,
+                               std::bind(&DBusThreadObject::GetPendingDatasetTlvsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_ACTIVE_DATASET,
+                               std::bind(&DBusThreadObject::GetActiveDatasetHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_PENDING_DATASET,
+                               std::bind(&DBusThreadObject::GetPendingDatasetHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES,
+                               std::bind(&DBusThreadObject::GetUnicastAddressesHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MULTICAST_ADDRESSES,
+                               std::bind(&DBusThreadObject::GetMulticastAddressesHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_MESH_LOCAL_EID,
+                               std::bind(&DBusThreadObject::GetMeshLocalEidHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_EUI64,
+                               std::bind(&DBusThreadObject::GetEui64Handler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_OT_HOST_VERSION,
+                               std::bind(&DBusThreadObject::GetOtHostVersionHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LOG_LEVELS,
+                               std::bind(&DBusThreadObject::GetLogLevelsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_ALERT_RULES,
+                               std::bind(&DBusThreadObject::GetLinkAlertRulesHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_LINK_ALERT_INTERVAL,
+                               std::bind(&DBusThreadObject::GetLinkAlertIntervalHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_RAISED_LINK_ALERTS,
+                               std::bind(&DBusThreadObject::GetRaisedLinkAlertsHandler, this, _1));
+    RegisterGetPropertyHandler(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_FLIGHT_RECORDS,
+                               std::bind(&DBusThreadObject::GetFlightRecordsHandler, this, _1));
+
+    mSampleTimer.Start(0);
+
+    return error;
+}
+
+DBusHandlerResult DBusThreadObject::MessageHandler(DBusConnection *aConnection, DBusMessage *aMessage)
+{
+    const char *      interfaceName = dbus_message_get_interface(aMessage);
+    const char *      member        = dbus_message_get_member(aMessage);
+    bool              isRead        = false;
+    DBusHandlerResult result;
+
+    if (interfaceName != nullptr && member != nullptr)
+    {
+        isRead =
+            (strcmp(interfaceName, DBUS_INTERFACE_PROPERTIES) == 0 &&
+             (strcmp(member, DBUS_PROPERTY_GET_METHOD) == 0 || strcmp(member, DBUS_PROPERTY_GET_ALL_METHOD) == 0)) ||
+            (strcmp(interfaceName, OTBR_DBUS_THREAD_INTERFACE) == 0 &&
+             strcmp(member, OTBR_DBUS_GET_PROPERTIES_METHOD) == 0);
+    }
+
+#if OTBR_ENABLE_NCP_THREAD
+    {
+        std::unique_lock<std::mutex> lock(mNcp->GetInstanceMutex(), std::defer_lock);
+
+        // Handlers access the OpenThread instance directly, except resetting which restarts the radio thread and
+        // needs the instance mutex to be free.
+        if (member == nullptr ||
+            (strcmp(member, OTBR_DBUS_RESET_METHOD) != 0 && strcmp(member, OTBR_DBUS_FACTORY_RESET_METHOD) != 0))
+        {
+            lock.lock();
+        }
+
+        result = DBusObject::MessageHandler(aConnection, aMessage);
+    }
+#else
+    result = DBusObject::MessageHandler(aConnection, aMessage);
+#endif
+
+    // Any other method may change the state of the Thread interface within this main loop turn.
+    if (!isRead)
+    {
+        mSnapshotValid = false;
+    }
+
+    return result;
+}
+
+void DBusThreadObject::FlushDeferredSignals(void)
+{
+#if OTBR_ENABLE_NCP_THREAD
+    std::lock_guard<std::mutex> lock(mNcp->GetInstanceMutex());
+#endif
+
+    DBusObject::FlushDeferredSignals();
+}
+
+const DBusThreadObject::PropertySnapshot &DBusThreadObject::GetPropertySnapshot(void)
+{
+    uint64_t wakeups = otbr::GetMainloopCounters().mWakeups;
+
+    if (!mSnapshotValid || mSnapshotWakeups != wakeups)
+    {
+        otInstance *instance = mNcp->GetThreadHelper()->GetInstance();
+
+        mSnapshot.mDeviceRole        = otThreadGetDeviceRole(instance);
+        mSnapshot.mNetworkName       = otThreadGetNetworkName(instance);
+        mSnapshot.mPanId             = otLinkGetPanId(instance);
+        mSnapshot.mExtPanId          = ConvertToUint64(*otThreadGetExtendedPanId(instance));
+        mSnapshot.mChannel           = otLinkGetChannel(instance);
+        mSnapshot.mRloc16            = otThreadGetRloc16(instance);
+        mSnapshot.mExtendedAddress   = ConvertToUint64(*otLinkGetExtendedAddress(instance));
+        mSnapshot.mPartitionId       = otThreadGetPartitionId(instance);
+        mSnapshot.mLocalLeaderWeight = otThreadGetLocalLeaderWeight(instance);
+
+        mSnapshotWakeups = wakeups;
+        mSnapshotValid   = true;
+    }
+
+    return mSnapshot;
+}
+
+void DBusThreadObject::RegisterStateChangedHandler(void)
+{
+    agent::ThreadHelper::StateChangedHandler handler = InMainloop(
+        agent::ThreadHelper::StateChangedHandler(std::bind(&DBusThreadObject::StateChangedHandler, this, _1)));
+
+    mNcp->Invoke([this, &handler]() { mNcp->GetThreadHelper()->AddStateChangedHandler(handler); });
+}
+
+void DBusThreadObject::StateChangedHandler(otChangedFlags aFlags)
+{
+    // Properties whose value may be unavailable after the change, such as the router id of a child, are signaled as
+    // invalidated without their values.
+    static const struct
+    {
+        otChangedFlags mFlags;
+        const char *   mName;
+        bool           mInvalidated;
+    } kStateProperties[] = {
+        {OT_CHANGED_THREAD_ROLE, OTBR_DBUS_PROPERTY_DEVICE_ROLE, false},
+        {OT_CHANGED_THREAD_NETWORK_NAME, OTBR_DBUS_PROPERTY_NETWORK_NAME, false},
+        {OT_CHANGED_THREAD_PANID, OTBR_DBUS_PROPERTY_PANID, false},
+        {OT_CHANGED_THREAD_EXT_PANID, OTBR_DBUS_PROPERTY_EXTPANID, false},
+        {OT_CHANGED_THREAD_CHANNEL, OTBR_DBUS_PROPERTY_CHANNEL, false},
+        {OT_CHANGED_MASTER_KEY, OTBR_DBUS_PROPERTY_MASTER_KEY, false},
+        {OT_CHANGED_THREAD_ML_ADDR, OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX, false},
+        {OT_CHANGED_THREAD_ML_ADDR, OTBR_DBUS_PROPERTY_MESH_LOCAL_EID, false},
+        {OT_CHANGED_SUPPORTED_CHANNEL_MASK, OTBR_DBUS_PROPERTY_SUPPORTED_CHANNEL_MASK, false},
+        {OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_RLOC_ADDED, OTBR_DBUS_PROPERTY_RLOC16, false},
+        {OT_CHANGED_THREAD_LL_ADDR, OTBR_DBUS_PROPERTY_EXTENDED_ADDRESS, false},
+        {OT_CHANGED_THREAD_PARTITION_ID, OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY, false},
+        {OT_CHANGED_THREAD_NETDATA, OTBR_DBUS_PROPERTY_NETWORK_DATA_PRPOERTY, false},
+        {OT_CHANGED_THREAD_NETDATA, OTBR_DBUS_PROPERTY_STABLE_NETWORK_DATA_PRPOERTY, false},
+        {OT_CHANGED_THREAD_NETDATA, OTBR_DBUS_PROPERTY_NETWORK_DATA_INFO, false},
+        {OT_CHANGED_THREAD_NETDATA, OTBR_DBUS_PROPERTY_EXTERNAL_ROUTES, false},
+        {OT_CHANGED_THREAD_CHILD_ADDED | OT_CHANGED_THREAD_CHILD_REMOVED, OTBR_DBUS_PROPERTY_CHILD_TABLE, false},
+        {OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_CHILD_ADDED | OT_CHANGED_THREAD_CHILD_REMOVED,
+         OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY, false},
+        {OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_RLOC_ADDED, OTBR_DBUS_PROPERTY_ROUTER_ID, true},
+        {OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_PARTITION_ID | OT_CHANGED_THREAD_NETDATA,
+         OTBR_DBUS_PROPERTY_LEADER_DATA, true},
+    };
+
+#if OTBR_ENABLE_NCP_THREAD
+    std::lock_guard<std::mutex> lock(mNcp->GetInstanceMutex());
+#endif
+
+    mSnapshotValid = false;
+    mChangedProperties.clear();
+    mInvalidatedProperties.clear();
+
+    // The Network Data version restarts in a new partition, so it can't tell the cached Network Data is stale.
+    if (aFlags & (OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_PARTITION_ID))
+    {
+        mNetworkDataInfoValid = false;
+    }
+
+    for (const auto &property : kStateProperties)
+    {
+        if (aFlags & property.mFlags)
+        {
+            (property.mInvalidated ? mInvalidatedProperties : mChangedProperties).push_back(property.mName);
+        }
+    }
+
+    UpdateIp6Addresses(aFlags);
+
+    VerifyOrExit(!mChangedProperties.empty() || !mInvalidatedProperties.empty());
+    SignalPropertiesChanged(OTBR_DBUS_THREAD_INTERFACE, mChangedProperties, mInvalidatedProperties);
+
+exit:
+    return;
+}
+
+void DBusThreadObject::UpdateIp6Addresses(otChangedFlags aFlags)
+{
+    otInstance *                      instance = mNcp->GetThreadHelper()->GetInstance();
+    Ip6AddressesChange                change;
+    std::vector<Ip6AddressInfo>       unicastAddresses;
+    std::vector<std::vector<uint8_t>> multicastAddresses;
+    bool                              wasValid = mIp6AddressesValid;
+
+    VerifyOrExit(!mIp6AddressesValid ||
+                 (aFlags & (OT_CHANGED_IP6_ADDRESS_ADDED | OT_CHANGED_IP6_ADDRESS_REMOVED |
+                            OT_CHANGED_IP6_MULTICAST_SUBSCRIBED | OT_CHANGED_IP6_MULTICAST_UNSUBSCRIBED)));
+
+    // The OpenThread tables are local linked lists, only the changes to them are sent to the bus.
+    ReadUnicastAddresses(instance, unicastAddresses);
+    ReadMulticastAddresses(instance, multicastAddresses);
+    DiffIp6Addresses(mUnicastAddresses, unicastAddresses, change.mUpdatedUnicast, change.mRemovedUnicast);
+    DiffIp6Addresses(mMulticastAddresses, multicastAddresses, change.mSubscribedMulticast,
+                     change.mUnsubscribedMulticast);
+    mUnicastAddresses.swap(unicastAddresses);
+    mMulticastAddresses.swap(multicastAddresses);
+    mIp6AddressesValid = true;
+
+    // Nobody has read the tables before they were first filled, so there is no change to tell.
+    VerifyOrExit(wasValid);
+    VerifyOrExit(!change.mUpdatedUnicast.empty() || !change.mRemovedUnicast.empty() ||
+                 !change.mSubscribedMulticast.empty() || !change.mUnsubscribedMulticast.empty());
+
+    // Readers which missed a change re-read the tables when they are invalidated.
+    if (Signal(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_IP6_ADDRESSES_CHANGED_SIGNAL,
+               std::tie(change.mUpdatedUnicast, change.mRemovedUnicast, change.mSubscribedMulticast,
+                        change.mUnsubscribedMulticast)) != OTBR_ERROR_NONE)
+    {
+        mInvalidatedProperties.push_back(OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES);
+        mInvalidatedProperties.push_back(OTBR_DBUS_PROPERTY_MULTICAST_ADDRESSES);
+    }
+
+exit:
+    return;
+}
+
+void DBusThreadObject::HandleSampleTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<DBusThreadObject *>(aContext)->SampleRateLimitedProperties();
+}
+
+void DBusThreadObject::SampleRateLimitedProperties(void)
+{
+    uint64_t             now        = GetNow();
+    uint64_t             nextSample = UINT64_MAX;
+    std::vector<uint8_t> value;
+
+#if OTBR_ENABLE_NCP_THREAD
+    std::lock_guard<std::mutex> lock(mNcp->GetInstanceMutex());
+#endif
+
+    mChangedProperties.clear();
+    mInvalidatedProperties.clear();
+
+    for (RateLimitedProperty &property : mRateLimitedProperties)
+    {
+        if (property.mNextSample <= now)
+        {
+            (this->*property.mRead)(value);
+
+            if (value != property.mLastValue)
+            {
+                // The first sample only sets the reference value.
+                if (!property.mLastValue.empty())
+                {
+                    mChangedProperties.push_back(property.mName);
+                }
+                property.mLastValue.swap(value);
+            }
+
+            property.mNextSample = now + property.mInterval;
+        }
+
+        nextSample = std::min(nextSample, property.mNextSample);
+    }
+
+    if (!mChangedProperties.empty())
+    {
+        SignalPropertiesChanged(OTBR_DBUS_THREAD_INTERFACE, mChangedProperties, mInvalidatedProperties);
+    }
+
+    mSampleTimer.StartAt(nextSample);
+}
+
+void DBusThreadObject::ReadCcaFailureRate(std::vector<uint8_t> &aValue)
+{
+    uint16_t failureRate = otLinkGetCcaFailureRate(mNcp->GetThreadHelper()->GetInstance());
+
+    aValue.assign(reinterpret_cast<const uint8_t *>(&failureRate),
+                  reinterpret_cast<const uint8_t *>(&failureRate) + sizeof(failureRate));
+}
+
+void DBusThreadObject::ReadLinkCounters(std::vector<uint8_t> &aValue)
+{
+    const otMacCounters *counters = otLinkGetCounters(mNcp->GetThreadHelper()->GetInstance());
+
+    aValue.assign(reinterpret_cast<const uint8_t *>(counters),
+                  reinterpret_cast<const uint8_t *>(counters) + sizeof(*counters));
+}
+
+void DBusThreadObject::ReadIp6Counters(std::vector<uint8_t> &aValue)
+{
+    const otIpCounters *counters = otThreadGetIp6Counters(mNcp->GetThreadHelper()->GetInstance());
+
+    aValue.assign(reinterpret_cast<const uint8_t *>(counters),
+                  reinterpret_cast<const uint8_t *>(counters) + sizeof(*counters));
+}
+
+void DBusThreadObject::ReadInstantRssi(std::vector<uint8_t> &aValue)
+{
+    int8_t rssi;
+
+    if (GetRcpProperty(mRcpProperties[kRcpPropertyInstantRssi], rssi) == OT_ERROR_NONE)
+    {
+        aValue.assign(1, static_cast<uint8_t>(rssi));
+    }
+    else
+    {
+        aValue.clear();
+    }
+}
+
+void DBusThreadObject::HandleLinkAlertTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<DBusThreadObject *>(aContext)->SampleLinkAlerts();
+}
+
+void DBusThreadObject::SampleLinkAlerts(void)
+{
+    otInstance *                      instance = mNcp->GetThreadHelper()->GetInstance();
+    std::vector<LinkAlerts::Crossing> crossings;
+    std::vector<LinkAlert>            alerts;
+
+#if OTBR_ENABLE_NCP_THREAD
+    std::lock_guard<std::mutex> lock(mNcp->GetInstanceMutex());
+#endif
+
+    if (mLinkAlerts.IsSampled(LinkAlerts::kMetricRssi) || mLinkAlerts.IsSampled(LinkAlerts::kMetricFrameErrorRate) ||
+        mLinkAlerts.IsSampled(LinkAlerts::kMetricMessageErrorRate))
+    {
+        ForEachNeighbor(instance, [this, &crossings](const otNeighborInfo &aNeighborInfo) {
+            uint64_t extAddress = ConvertToUint64(aNeighborInfo.mExtAddress);
+
+            mLinkAlerts.Update(LinkAlerts::kMetricRssi, extAddress, aNeighborInfo.mAverageRssi, crossings);
+            mLinkAlerts.Update(LinkAlerts::kMetricFrameErrorRate, extAddress, aNeighborInfo.mFrameErrorRate,
+                               crossings);
+            mLinkAlerts.Update(LinkAlerts::kMetricMessageErrorRate, extAddress, aNeighborInfo.mMessageErrorRate,
+                               crossings);
+            return OT_ERROR_NONE;
+        });
+    }
+
+    if (mLinkAlerts.IsSampled(LinkAlerts::kMetricCcaFailureRate))
+    {
+        mLinkAlerts.Update(LinkAlerts::kMetricCcaFailureRate, 0, otLinkGetCcaFailureRate(instance), crossings);
+    }
+
+    SampleTxRetryRate(crossings);
+
+    // Neighbors missing from this round went away, their alerts are cleared.
+    mLinkAlerts.EndRound(crossings);
+
+    for (const LinkAlerts::Crossing &crossing : crossings)
+    {
+        alerts.push_back({crossing.mRuleId, crossing.mSubject, crossing.mRaised, crossing.mValue});
+    }
+
+    // Readers which missed the signal read the raised alerts from the RaisedLinkAlerts property.
+    if (!alerts.empty() &&
+        Signal(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_LINK_ALERTS_SIGNAL, std::tie(alerts)) != OTBR_ERROR_NONE)
+    {
+        otbrLogRateLimited(1000, OTBR_LOG_WARNING, "Failed to signal %zu link alerts", alerts.size());
+    }
+
+    mLinkAlertTimer.Start(mLinkAlertInterval);
+}
+
+void DBusThreadObject::SampleTxRetryRate(std::vector<LinkAlerts::Crossing> &aCrossings)
+{
+    const otMacCounters *counters = otLinkGetCounters(mNcp->GetThreadHelper()->GetInstance());
+    uint32_t             total;
+    uint32_t             retry;
+    uint32_t             rate;
+
+    // A counter lower than the previous sample was reset to zero in between.
+    total = counters->mTxTotal >= mLinkAlertTxTotal ? counters->mTxTotal - mLinkAlertTxTotal : counters->mTxTotal;
+    retry = counters->mTxRetry >= mLinkAlertTxRetry ? counters->mTxRetry - mLinkAlertTxRetry : counters->mTxRetry;
+    mLinkAlertTxTotal = counters->mTxTotal;
+    mLinkAlertTxRetry = counters->mTxRetry;
+
+    // The first sample is only the baseline of the next interval.
+    VerifyOrExit(mLinkAlertCountersValid, mLinkAlertCountersValid = true);
+    VerifyOrExit(mLinkAlerts.IsSampled(LinkAlerts::kMetricTxRetryRate));
+
+    // The rate is the share of the transmission attempts which were retries, so that it is bounded like the other
+    // error rates.
+    rate = total + retry == 0 ? 0 : static_cast<uint32_t>(uint64_t{retry} * 0xffff / (uint64_t{total} + retry));
+    mLinkAlerts.Update(LinkAlerts::kMetricTxRetryRate, 0, static_cast<int32_t>(rate), aCrossings);
+
+exit:
+    return;
+}
+
+bool DBusThreadObject::IsRcpPropertyFresh(const RcpProperty &aProperty) const
+{
+    return aProperty.mValid && aProperty.mError == OT_ERROR_NONE &&
+           GetNow() - aProperty.mReadTime <= OTBR_CONFIG_DBUS_RCP_PROPERTY_MAX_AGE;
+}
+
+otError DBusThreadObject::GetRcpProperty(RcpProperty &aProperty, int8_t &aValue)
+{
+    if (!IsRcpPropertyFresh(aProperty))
+    {
+        otInstance *instance = mNcp->GetThreadHelper()->GetInstance();
+
+        aProperty.mError    = ReadRcpProperty(aProperty.mRead, instance, aProperty.mValue);
+        aProperty.mReadTime = GetNow();
+        aProperty.mValid    = true;
+    }
+
+    aValue = aProperty.mValue;
+
+    return aProperty.mError;
+}
+
+otError DBusThreadObject::EncodeRcpProperty(RcpProperty &aProperty, DBusMessageIter &aIter)
+{
+    otError error;
+    int8_t  value;
+
+    SuccessOrExit(error = GetRcpProperty(aProperty, value));
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, value) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+void DBusThreadObject::GetRcpPropertyAsyncHandler(uint8_t aIndex, DBusRequest &aRequest)
+{
+    RcpProperty &                     property = mRcpProperties[aIndex];
+    std::shared_ptr<RcpPropertyValue> result;
+    otInstance *                      instance;
+    otError (*read)(otInstance *, int8_t &);
+
+    if (IsRcpPropertyFresh(property))
+    {
+        ReplyRcpProperty(property, aRequest);
+        ExitNow();
+    }
+
+    property.mWaiters.push_back(aRequest);
+    VerifyOrExit(!property.mReading);
+    property.mReading = true;
+
+    // The read runs as a task of the thread owning the OpenThread instance, so that the spinel round trip is not made
+    // in the D-Bus handler, and all the calls dispatched until it completes share its result.
+    result   = std::make_shared<RcpPropertyValue>();
+    instance = mNcp->GetThreadHelper()->GetInstance();
+    read     = property.mRead;
+    mNcp->Post([result, instance, read]() { result->mError = ReadRcpProperty(read, instance, result->mValue); },
+               [this, aIndex, result]() { CompleteRcpPropertyRead(aIndex, result->mError, result->mValue); });
+
+exit:
+    return;
+}
+
+void DBusThreadObject::CompleteRcpPropertyRead(uint8_t aIndex, otError aError, int8_t aValue)
+{
+    RcpProperty &            property = mRcpProperties[aIndex];
+    std::vector<DBusRequest> waiters;
+
+    property.mError    = aError;
+    property.mValue    = aValue;
+    property.mReadTime = GetNow();
+    property.mValid    = true;
+    property.mReading  = false;
+    waiters.swap(property.mWaiters);
+
+    for (DBusRequest &request : waiters)
+    {
+        ReplyRcpProperty(property, request);
+    }
+}
+
+void DBusThreadObject::ReplyRcpProperty(RcpProperty &aProperty, DBusRequest &aRequest)
+{
+    int8_t value = aProperty.mValue;
+
+    if (aProperty.mError != OT_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(aProperty.mError);
+    }
+    else
+    {
+        ReplyGetProperty(aRequest, [value](DBusMessageIter &aIter) {
+            return DBusMessageEncodeToVariant(&aIter, value) == OTBR_ERROR_NONE ? OT_ERROR_NONE
+                                                                                : OT_ERROR_INVALID_ARGS;
+        });
+    }
+}
+
+void DBusThreadObject::ScanHandler(DBusRequest &aRequest)
+{
+    auto threadHelper = mNcp->GetThreadHelper();
+    threadHelper->Scan(InMainloop(
+        agent::ThreadHelper::ScanHandler(std::bind(&DBusThreadObject::ReplyScanResult, this, aRequest, _1, _2))));
+}
+
+void DBusThreadObject::GetPropertiesHandler(DBusRequest &aRequest)
+{
+    GetPropertiesMethodHandler(OTBR_DBUS_THREAD_INTERFACE, aRequest);
+}
+
+void DBusThreadObject::SetPropertiesHandler(DBusRequest &aRequest)
+{
+    SetPropertiesMethodHandler(OTBR_DBUS_THREAD_INTERFACE, aRequest);
+}
+
+void DBusThreadObject::GetChildTableDeltaHandler(DBusRequest &aRequest)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   iter, entriesIter;
+    uint32_t          sinceVersion;
+    auto              args  = std::tie(sinceVersion);
+    otError           error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    dbus_message_iter_init_append(reply.get(), &iter);
+    SuccessOrExit(error = BeginTableDelta(iter, entriesIter, mChildTableVersion, sinceVersion,
+                                          DBusTypeTrait<ChildInfo>::TYPE_AS_STRING));
+    SuccessOrExit(error = ForEachChild(mNcp->GetThreadHelper()->GetInstance(),
+                                       [this, &entriesIter](const otChildInfo &aChildInfo) {
+                                           otError   error = OT_ERROR_NONE;
+                                           ChildInfo info;
+
+                                           VerifyOrExit(mChildTableVersion.Update(
+                                               ConvertToUint64(aChildInfo.mExtAddress),
+                                               GetChildState(aChildInfo)));
+                                           Convert(aChildInfo, info);
+                                           VerifyOrExit(DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE,
+                                                        error = OT_ERROR_NO_BUFS);
+
+                                       exit:
+                                           return error;
+                                       }));
+    SuccessOrExit(error = EndTableDelta(iter, entriesIter, mChildTableVersion));
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::GetNeighborTableDeltaHandler(DBusRequest &aRequest)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   iter, entriesIter;
+    uint32_t          sinceVersion;
+    auto              args  = std::tie(sinceVersion);
+    otError           error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    dbus_message_iter_init_append(reply.get(), &iter);
+    SuccessOrExit(error = BeginTableDelta(iter, entriesIter, mNeighborTableVersion, sinceVersion,
+                                          DBusTypeTrait<NeighborInfo>::TYPE_AS_STRING));
+    SuccessOrExit(error = ForEachNeighbor(mNcp->GetThreadHelper()->GetInstance(),
+                                          [this, &entriesIter](const otNeighborInfo &aNeighborInfo) {
+                                              otError      error = OT_ERROR_NONE;
+                                              NeighborInfo info;
+
+                                              VerifyOrExit(mNeighborTableVersion.Update(
+                                                  ConvertToUint64(aNeighborInfo.mExtAddress),
+                                                  GetNeighborState(aNeighborInfo)));
+                                              Convert(aNeighborInfo, info);
+                                              VerifyOrExit(DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE,
+                                                           error = OT_ERROR_NO_BUFS);
+
+                                          exit:
+                                              return error;
+                                          }));
+    SuccessOrExit(error = EndTableDelta(iter, entriesIter, mNeighborTableVersion));
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::QueryChildTableHandler(DBusRequest &aRequest)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   iter, entriesIter;
+    TableQuery        query;
+    auto              args = std::tie(query);
+    otbr::TableQuery  selector;
+    uint32_t          matched;
+    otError           error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    SuccessOrExit(error = ToTableSelector(query, selector));
+
+    // Only the selected children are converted and encoded, the others are only counted when they match.
+    dbus_message_iter_init_append(reply.get(), &iter);
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBusTypeTrait<ChildInfo>::TYPE_AS_STRING,
+                                                  &entriesIter),
+                 error = OT_ERROR_NO_BUFS);
+    SuccessOrExit(error = ForEachChild(mNcp->GetThreadHelper()->GetInstance(),
+                                       [&selector, &entriesIter](const otChildInfo &aChildInfo) {
+                                           otError   error = OT_ERROR_NONE;
+                                           ChildInfo info;
+
+                                           VerifyOrExit(selector.Select(aChildInfo.mRloc16,
+                                                                        ConvertToUint64(aChildInfo.mExtAddress),
+                                                                        aChildInfo.mLinkQualityIn));
+                                           Convert(aChildInfo, info);
+                                           VerifyOrExit(DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE,
+                                                        error = OT_ERROR_NO_BUFS);
+
+                                       exit:
+                                           return error;
+                                       }));
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &entriesIter), error = OT_ERROR_NO_BUFS);
+    matched = selector.GetMatched();
+    VerifyOrExit(DBusMessageEncode(&iter, matched) == OTBR_ERROR_NONE, error = OT_ERROR_NO_BUFS);
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::QueryNeighborTableHandler(DBusRequest &aRequest)
+{
+    UniqueDBusMessage reply{dbus_message_new_method_return(aRequest.GetMessage())};
+    DBusMessageIter   iter, entriesIter;
+    TableQuery        query;
+    auto              args = std::tie(query);
+    otbr::TableQuery  selector;
+    uint32_t          matched;
+    otError           error = OT_ERROR_NONE;
+
+    VerifyOrExit(reply != nullptr, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    SuccessOrExit(error = ToTableSelector(query, selector));
+
+    dbus_message_iter_init_append(reply.get(), &iter);
+    VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
+                                                  DBusTypeTrait<NeighborInfo>::TYPE_AS_STRING, &entriesIter),
+                 error = OT_ERROR_NO_BUFS);
+    SuccessOrExit(error = ForEachNeighbor(mNcp->GetThreadHelper()->GetInstance(),
+                                          [&selector, &entriesIter](const otNeighborInfo &aNeighborInfo) {
+                                              otError      error = OT_ERROR_NONE;
+                                              NeighborInfo info;
+
+                                              VerifyOrExit(selector.Select(aNeighborInfo.mRloc16,
+                                                                           ConvertToUint64(aNeighborInfo.mExtAddress),
+                                                                           aNeighborInfo.mLinkQualityIn));
+                                              Convert(aNeighborInfo, info);
+                                              VerifyOrExit(DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE,
+                                                           error = OT_ERROR_NO_BUFS);
+
+                                          exit:
+                                              return error;
+                                          }));
+    VerifyOrExit(dbus_message_iter_close_container(&iter, &entriesIter), error = OT_ERROR_NO_BUFS);
+    matched = selector.GetMatched();
+    VerifyOrExit(DBusMessageEncode(&iter, matched) == OTBR_ERROR_NONE, error = OT_ERROR_NO_BUFS);
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        dbus_connection_send(aRequest.GetConnection(), reply.get(), nullptr);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::ReplyScanResult(DBusRequest &                          aRequest,
+                                       otError                                aError,
+                                       const std::vector<otActiveScanResult> &aResult)
+{
+    std::vector<ActiveScanResult> results;
+
+    if (aError != OT_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(aError);
+    }
+    else
+    {
+        for (const auto &r : aResult)
+        {
+            ActiveScanResult result;
+
+            result.mExtAddress    = ConvertToUint64(r.mExtAddress);
+            result.mExtendedPanId = ConvertToUint64(r.mExtendedPanId);
+            result.mNetworkName   = r.mNetworkName.m8;
+            result.mSteeringData =
+                std::vector<uint8_t>(r.mSteeringData.m8, r.mSteeringData.m8 + r.mSteeringData.mLength);
+            result.mPanId         = r.mPanId;
+            result.mJoinerUdpPort = r.mJoinerUdpPort;
+            result.mChannel       = r.mChannel;
+            result.mRssi          = r.mRssi;
+            result.mLqi           = r.mLqi;
+            result.mVersion       = r.mVersion;
+            result.mIsNative      = r.mIsNative;
+            result.mIsJoinable    = r.mIsJoinable;
+
+            results.emplace_back(result);
+        }
+
+        aRequest.Reply(std::tie(results));
+    }
+}
+
+void DBusThreadObject::AttachHandler(DBusRequest &aRequest)
+{
+    auto                 threadHelper = mNcp->GetThreadHelper();
+    std::string          name;
+    uint16_t             panid;
+    uint64_t             extPanId;
+    std::vector<uint8_t> masterKey;
+    std::vector<uint8_t> pskc;
+    uint32_t             channelMask;
+
+    auto args = std::tie(masterKey, panid, name, extPanId, pskc, channelMask);
+
+    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+    }
+    else
+    {
+        threadHelper->Attach(name, panid, extPanId, masterKey, pskc, channelMask,
+                             InMainloop(agent::ThreadHelper::ResultHandler(
+                                 [aRequest](otError aError) mutable { aRequest.ReplyOtResult(aError); })));
+    }
+}
+
+void DBusThreadObject::FactoryResetHandler(DBusRequest &aRequest)
+{
+    aRequest.ReplyOtResult(OT_ERROR_NONE);
+    mNcp->Invoke([this]() { otInstanceFactoryReset(mNcp->GetThreadHelper()->GetInstance()); });
+    mNcp->Reset();
+    RegisterStateChangedHandler();
+    SignalPropertyChanged(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
+                          GetDeviceRoleName(OT_DEVICE_ROLE_DISABLED));
+}
+
+void DBusThreadObject::ResetHandler(DBusRequest &aRequest)
+{
+    mNcp->Reset();
+    RegisterStateChangedHandler();
+    SignalPropertyChanged(OTBR_DBUS_THREAD_INTERFACE, OTBR_DBUS_PROPERTY_DEVICE_ROLE,
+                          GetDeviceRoleName(OT_DEVICE_ROLE_DISABLED));
+
+    aRequest.ReplyOtResult(OT_ERROR_NONE);
+}
+
+void DBusThreadObject::JoinerStartHandler(DBusRequest &aRequest)
+{
+    auto        threadHelper = mNcp->GetThreadHelper();
+    std::string pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData;
+    auto        args = std::tie(pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData);
+
+    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+    }
+    else
+    {
+        threadHelper->JoinerStart(pskd, provisionUrl, vendorName, vendorModel, vendorSwVersion, vendorData,
+                                  InMainloop(agent::ThreadHelper::ResultHandler(
+                                      [aRequest](otError aError) mutable { aRequest.ReplyOtResult(aError); })));
+    }
+}
+
+void DBusThreadObject::JoinerStopHandler(DBusRequest &aRequest)
+{
+    auto threadHelper = mNcp->GetThreadHelper();
+
+    otJoinerStop(threadHelper->GetInstance());
+    aRequest.ReplyOtResult(OT_ERROR_NONE);
+}
+
+static void ConvertJoinerEui64(uint64_t aEui64, agent::ThreadHelper::Joiner &aJoiner)
+{
+    aJoiner.mAny = (aEui64 == 0);
+    Encoding::BigEndian::WriteUint64(aEui64, aJoiner.mEui64.m8);
+}
+
+void DBusThreadObject::AddJoinersHandler(DBusRequest &aRequest)
+{
+    auto                                     threadHelper = mNcp->GetThreadHelper();
+    std::vector<JoinerInfo>                  joinerInfos;
+    std::vector<agent::ThreadHelper::Joiner> joiners;
+    auto                                     args  = std::tie(joinerInfos);
+    otError                                  error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    joiners.resize(joinerInfos.size());
+    for (size_t i = 0; i < joinerInfos.size(); i++)
+    {
+        ConvertJoinerEui64(joinerInfos[i].mEui64, joiners[i]);
+        joiners[i].mPskd    = joinerInfos[i].mPskd;
+        joiners[i].mTimeout = joinerInfos[i].mTimeout;
+    }
+
+    error = threadHelper->AddJoiners(joiners);
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::RemoveJoinersHandler(DBusRequest &aRequest)
+{
+    auto                                     threadHelper = mNcp->GetThreadHelper();
+    std::vector<uint64_t>                    eui64s;
+    std::vector<agent::ThreadHelper::Joiner> joiners;
+    auto                                     args  = std::tie(eui64s);
+    otError                                  error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    joiners.resize(eui64s.size());
+    for (size_t i = 0; i < eui64s.size(); i++)
+    {
+        ConvertJoinerEui64(eui64s[i], joiners[i]);
+    }
+
+    error = threadHelper->RemoveJoiners(joiners);
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::PermitUnsecureJoinHandler(DBusRequest &aRequest)
+{
+    auto     threadHelper = mNcp->GetThreadHelper();
+    uint16_t port;
+    uint32_t timeout;
+    auto     args = std::tie(port, timeout);
+
+    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+    }
+    else
+    {
+        aRequest.ReplyOtResult(threadHelper->PermitUnsecureJoin(port, timeout));
+    }
+}
+
+void DBusThreadObject::AddOnMeshPrefixHandler(DBusRequest &aRequest)
+{
+    auto                 threadHelper = mNcp->GetThreadHelper();
+    OnMeshPrefix         onMeshPrefix;
+    auto                 args  = std::tie(onMeshPrefix);
+    otError              error = OT_ERROR_NONE;
+    otBorderRouterConfig config;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    Convert(onMeshPrefix, config);
+
+    SuccessOrExit(error = otBorderRouterAddOnMeshPrefix(threadHelper->GetInstance(), &config));
+    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::RemoveOnMeshPrefixHandler(DBusRequest &aRequest)
+{
+    auto        threadHelper = mNcp->GetThreadHelper();
+    Ip6Prefix   onMeshPrefix;
+    auto        args  = std::tie(onMeshPrefix);
+    otError     error = OT_ERROR_NONE;
+    otIp6Prefix prefix;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    Convert(onMeshPrefix, prefix);
+
+    SuccessOrExit(error = otBorderRouterRemoveOnMeshPrefix(threadHelper->GetInstance(), &prefix));
+    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::AddExternalRouteHandler(DBusRequest &aRequest)
+{
+    auto                  threadHelper = mNcp->GetThreadHelper();
+    ExternalRoute         route;
+    auto                  args  = std::tie(route);
+    otError               error = OT_ERROR_NONE;
+    otExternalRouteConfig otRoute;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    Convert(route, otRoute);
+
+    SuccessOrExit(error = otBorderRouterAddRoute(threadHelper->GetInstance(), &otRoute));
+    if (route.mStable)
+    {
+        SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+    }
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::RemoveExternalRouteHandler(DBusRequest &aRequest)
+{
+    auto        threadHelper = mNcp->GetThreadHelper();
+    Ip6Prefix   routePrefix;
+    auto        args  = std::tie(routePrefix);
+    otError     error = OT_ERROR_NONE;
+    otIp6Prefix prefix;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    Convert(routePrefix, prefix);
+
+    SuccessOrExit(error = otBorderRouterRemoveRoute(threadHelper->GetInstance(), &prefix));
+    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::UpdateBorderRouterConfigHandler(DBusRequest &aRequest)
+{
+    auto                       threadHelper = mNcp->GetThreadHelper();
+    std::vector<OnMeshPrefix>  addedPrefixes;
+    std::vector<Ip6Prefix>     removedPrefixes;
+    std::vector<ExternalRoute> addedRoutes;
+    std::vector<Ip6Prefix>     removedRoutes;
+    auto                       args  = std::tie(addedPrefixes, removedPrefixes, addedRoutes, removedRoutes);
+    otError                    error = OT_ERROR_NONE;
+    BorderRouterTransaction    transaction(threadHelper->GetInstance());
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    // Removals go first, so a batch can replace an entry by removing and adding the same prefix.
+    for (const Ip6Prefix &removedPrefix : removedPrefixes)
+    {
+        otIp6Prefix prefix;
+
+        Convert(removedPrefix, prefix);
+        SuccessOrExit(error = transaction.RemoveOnMeshPrefix(prefix));
+    }
+
+    for (const Ip6Prefix &removedRoute : removedRoutes)
+    {
+        otIp6Prefix prefix;
+
+        Convert(removedRoute, prefix);
+        SuccessOrExit(error = transaction.RemoveExternalRoute(prefix));
+    }
+
+    for (const OnMeshPrefix &addedPrefix : addedPrefixes)
+    {
+        otBorderRouterConfig config;
+
+        Convert(addedPrefix, config);
+        SuccessOrExit(error = transaction.AddOnMeshPrefix(config));
+    }
+
+    for (const ExternalRoute &addedRoute : addedRoutes)
+    {
+        otExternalRouteConfig config;
+
+        Convert(addedRoute, config);
+        SuccessOrExit(error = transaction.AddExternalRoute(config));
+    }
+
+    SuccessOrExit(error = transaction.Commit());
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::GetCounterRatesHandler(DBusRequest &aRequest)
+{
+    auto                      threadHelper = mNcp->GetThreadHelper();
+    uint32_t                  window;
+    auto                      args = std::tie(window);
+    std::vector<CounterRates> rates;
+    otError                   error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    for (int i = 0; i < otbr::agent::ThreadHelper::kHistoryCounterNum; i++)
+    {
+        auto                        counter = static_cast<otbr::agent::ThreadHelper::HistoryCounter>(i);
+        otbr::CounterHistory::Rates history;
+        CounterRates                value;
+
+        // Counters without a complete sample interval yet are left out.
+        if (threadHelper->GetCounterHistory(counter).GetRates(window, history) != OTBR_ERROR_NONE)
+        {
+            continue;
+        }
+
+        value.mCounter = otbr::agent::ThreadHelper::GetHistoryCounterName(counter);
+        value.mWindow  = history.mWindow;
+        value.mDelta   = history.mDelta;
+        value.mMean    = history.mMean;
+        value.mMin     = history.mMin;
+        value.mMax     = history.mMax;
+        value.mP50     = history.mP50;
+        value.mP90     = history.mP90;
+        value.mP99     = history.mP99;
+        rates.push_back(value);
+    }
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        aRequest.Reply(std::tie(rates));
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::AddLinkAlertRuleHandler(DBusRequest &aRequest)
+{
+    LinkAlertRule    rule;
+    auto             args = std::tie(rule);
+    LinkAlerts::Rule alertRule;
+    uint32_t         id    = 0;
+    otError          error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(LinkAlerts::ParseMetric(rule.mMetric.c_str(), alertRule.mMetric) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+    alertRule.mAbove      = rule.mAbove;
+    alertRule.mThreshold  = rule.mThreshold;
+    alertRule.mHysteresis = rule.mHysteresis;
+    VerifyOrExit(mLinkAlerts.AddRule(alertRule, id) == OTBR_ERROR_NONE, error = OT_ERROR_NO_BUFS);
+
+    // The metrics are only sampled while there are rules.
+    if (!mLinkAlertTimer.IsRunning())
+    {
+        mLinkAlertCountersValid = false;
+        mLinkAlertTimer.Start(0);
+    }
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        aRequest.Reply(std::tie(id));
+    }
+    else
+    {
+        aRequest.ReplyOtResult(error);
+    }
+}
+
+void DBusThreadObject::RemoveLinkAlertRuleHandler(DBusRequest &aRequest)
+{
+    uint32_t id;
+    auto     args  = std::tie(id);
+    otError  error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(mLinkAlerts.RemoveRule(id) == OTBR_ERROR_NONE, error = OT_ERROR_NOT_FOUND);
+
+    if (mLinkAlerts.GetRules().empty())
+    {
+        mLinkAlertTimer.Stop();
+    }
+
+exit:
+    aRequest.ReplyOtResult(error);
+}
+
+void DBusThreadObject::GetTopologyHandler(DBusRequest &aRequest)
+{
+    auto     threadHelper = mNcp->GetThreadHelper();
+    uint32_t maxAge;
+    auto     args = std::tie(maxAge);
+
+    if (DBusMessageToTuple(*aRequest.GetMessage(), args) != OTBR_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(OT_ERROR_INVALID_ARGS);
+    }
+    else
+    {
+        auto reply = InMainloop(std::function<void(otError, const std::vector<TopologyNode> &)>(
+            std::bind(&DBusThreadObject::ReplyTopology, this, aRequest, _1, _2)));
+
+        // The topology is converted where the crawl completes, the reply only gets a copy.
+        threadHelper->CrawlTopology(maxAge, [threadHelper, reply](otError aError) {
+            std::vector<TopologyNode> nodes;
+
+            if (aError == OT_ERROR_NONE)
+            {
+                ConvertTopology(threadHelper->GetTopology(), nodes);
+            }
+
+            reply(aError, nodes);
+        });
+    }
+}
+
+void DBusThreadObject::ReplyTopology(DBusRequest &                    aRequest,
+                                     otError                          aError,
+                                     const std::vector<TopologyNode> &aNodes)
+{
+    if (aError != OT_ERROR_NONE)
+    {
+        aRequest.ReplyOtResult(aError);
+    }
+    else
+    {
+        aRequest.Reply(std::tie(aNodes));
+    }
+}
 
-void DBusThreadObject::AddOnMeshPrefixHandler(DBusRequest &aRequest)
+void DBusThreadObject::IntrospectHandler(DBusRequest &aRequest)
+{
+    std::string xmlString(
+#include "dbus/server/introspect.hpp"
+    );
+
+    aRequest.Reply(std::tie(xmlString));
+}
+
+otError DBusThreadObject::SetMeshLocalPrefixHandler(DBusMessageIter &aIter)
+{
+    auto                                      threadHelper = mNcp->GetThreadHelper();
+    otMeshLocalPrefix                         prefix;
+    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> data{};
+    otError                                   error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    memcpy(&prefix.m8, &data.front(), sizeof(prefix.m8));
+    error = otThreadSetMeshLocalPrefix(threadHelper->GetInstance(), &prefix);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::SetLegacyUlaPrefixHandler(DBusMessageIter &aIter)
+{
+    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> data;
+    otError                                   error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    otNcpHandleDidReceiveNewLegacyUlaPrefix(&data[0]);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::SetLinkModeHandler(DBusMessageIter &aIter)
+{
+    auto             threadHelper = mNcp->GetThreadHelper();
+    LinkModeConfig   cfg;
+    otLinkModeConfig otCfg;
+    otError          error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, cfg) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    otCfg.mDeviceType         = cfg.mDeviceType;
+    otCfg.mNetworkData        = cfg.mNetworkData;
+    otCfg.mSecureDataRequests = cfg.mSecureDataRequests;
+    otCfg.mRxOnWhenIdle       = cfg.mRxOnWhenIdle;
+    error                     = otThreadSetLinkMode(threadHelper->GetInstance(), otCfg);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetMeshLocalPrefixHandler(DBusMessageIter &aIter)
+{
+    auto                                      threadHelper = mNcp->GetThreadHelper();
+    const otMeshLocalPrefix *                 prefix       = otThreadGetMeshLocalPrefix(threadHelper->GetInstance());
+    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> data;
+    otError                                   error = OT_ERROR_NONE;
+
+    memcpy(&data.front(), prefix->m8, sizeof(prefix->m8));
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetLinkModeHandler(DBusMessageIter &aIter)
+{
+    auto             threadHelper = mNcp->GetThreadHelper();
+    otLinkModeConfig otCfg        = otThreadGetLinkMode(threadHelper->GetInstance());
+    LinkModeConfig   cfg;
+    otError          error = OT_ERROR_NONE;
+
+    cfg.mDeviceType         = otCfg.mDeviceType;
+    cfg.mNetworkData        = otCfg.mNetworkData;
+    cfg.mSecureDataRequests = otCfg.mSecureDataRequests;
+    cfg.mRxOnWhenIdle       = otCfg.mRxOnWhenIdle;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, cfg) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetDeviceRoleHandler(DBusMessageIter &aIter)
+{
+    std::string roleName = GetDeviceRoleName(GetPropertySnapshot().mDeviceRole);
+    otError     error    = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, roleName) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetNetworkNameHandler(DBusMessageIter &aIter)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mNetworkName) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetPanIdHandler(DBusMessageIter &aIter)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mPanId) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetExtPanIdHandler(DBusMessageIter &aIter)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mExtPanId) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetChannelHandler(DBusMessageIter &aIter)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mChannel) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetMasterKeyHandler(DBusMessageIter &aIter)
 {
     auto                 threadHelper = mNcp->GetThreadHelper();
-    OnMeshPrefix         onMeshPrefix;
-    auto                 args  = std::tie(onMeshPrefix);
+    const otMasterKey *  masterKey    = otThreadGetMasterKey(threadHelper->GetInstance());
+    std::vector<uint8_t> keyVal(masterKey->m8, masterKey->m8 + sizeof(masterKey->m8));
     otError              error = OT_ERROR_NONE;
-    otBorderRouterConfig config;
 
-    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, keyVal) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetCcaFailureRateHandler(DBusMessageIter &aIter)
+{
+    auto     threadHelper = mNcp->GetThreadHelper();
+    uint16_t failureRate  = otLinkGetCcaFailureRate(threadHelper->GetInstance());
+    otError  error        = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, failureRate) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetLinkCountersHandler(DBusMessageIter &aIter)
+{
+    auto                 threadHelper = mNcp->GetThreadHelper();
+    const otMacCounters *otCounters   = otLinkGetCounters(threadHelper->GetInstance());
+    MacCounters          counters;
+    otError              error = OT_ERROR_NONE;
+
+    counters.mTxTotal              = otCounters->mTxTotal;
+    counters.mTxUnicast            = otCounters->mTxUnicast;
+    counters.mTxBroadcast          = otCounters->mTxBroadcast;
+    counters.mTxAckRequested       = otCounters->mTxAckRequested;
+    counters.mTxAcked              = otCounters->mTxAcked;
+    counters.mTxNoAckRequested     = otCounters->mTxNoAckRequested;
+    counters.mTxData               = otCounters->mTxData;
+    counters.mTxDataPoll           = otCounters->mTxDataPoll;
+    counters.mTxBeacon             = otCounters->mTxBeacon;
+    counters.mTxBeaconRequest      = otCounters->mTxBeaconRequest;
+    counters.mTxOther              = otCounters->mTxOther;
+    counters.mTxRetry              = otCounters->mTxRetry;
+    counters.mTxErrCca             = otCounters->mTxErrCca;
+    counters.mTxErrAbort           = otCounters->mTxErrAbort;
+    counters.mTxErrBusyChannel     = otCounters->mTxErrBusyChannel;
+    counters.mRxTotal              = otCounters->mRxTotal;
+    counters.mRxUnicast            = otCounters->mTxUnicast;
+    counters.mRxBroadcast          = otCounters->mRxBroadcast;
+    counters.mRxData               = otCounters->mRxData;
+    counters.mRxDataPoll           = otCounters->mTxDataPoll;
+    counters.mRxBeacon             = otCounters->mRxBeacon;
+    counters.mRxBeaconRequest      = otCounters->mRxBeaconRequest;
+    counters.mRxOther              = otCounters->mRxOther;
+    counters.mRxAddressFiltered    = otCounters->mRxAddressFiltered;
+    counters.mRxDestAddrFiltered   = otCounters->mRxDestAddrFiltered;
+    counters.mRxDuplicated         = otCounters->mRxDuplicated;
+    counters.mRxErrNoFrame         = otCounters->mRxErrNoFrame;
+    counters.mRxErrUnknownNeighbor = otCounters->mRxErrUnknownNeighbor;
+    counters.mRxErrInvalidSrcAddr  = otCounters->mRxErrInvalidSrcAddr;
+    counters.mRxErrSec             = otCounters->mRxErrSec;
+    counters.mRxErrFcs             = otCounters->mRxErrFcs;
+    counters.mRxErrOther           = otCounters->mRxErrOther;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetMainloopHistogramsHandler(DBusMessageIter &aIter)
+{
+    std::vector<MainloopHistogram> histograms;
+    otError                        error = OT_ERROR_NONE;
+
+    for (int i = 0; i < otbr::kMainloopStageNum; i++)
+    {
+        otbr::MainloopStage    stage     = static_cast<otbr::MainloopStage>(i);
+        const otbr::Histogram &histogram = otbr::GetMainloopHistogram(stage);
+        MainloopHistogram      value;
+
+        value.mStage = otbr::GetMainloopStageName(stage);
+        value.mCount = histogram.GetCount();
+        value.mSum   = histogram.GetSum();
+        value.mMax   = histogram.GetMax();
+
+        for (uint8_t index = 0; index < otbr::Histogram::kBuckets; index++)
+        {
+            uint32_t count = histogram.GetBucketCount(index);
+
+            if (count != 0)
+            {
+                value.mBuckets.push_back({otbr::Histogram::GetBucketLowerBound(index), count});
+            }
+        }
+
+        histograms.push_back(value);
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, histograms) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetMemoryUsageHandler(DBusMessageIter &aIter)
+{
+    std::vector<MemoryUsage> usages;
+    otError                  error = OT_ERROR_NONE;
+
+    for (int i = 0; i < otbr::kMemoryTagNum; i++)
+    {
+        otbr::MemoryTag      tag      = static_cast<otbr::MemoryTag>(i);
+        otbr::MemoryCounters counters = otbr::GetMemoryCounters(tag);
+        MemoryUsage          value;
+
+        value.mSubsystem        = otbr::GetMemoryTagName(tag);
+        value.mBytes            = counters.mBytes;
+        value.mPeakBytes        = counters.mPeakBytes;
+        value.mAllocations      = counters.mAllocations;
+        value.mTotalAllocations = counters.mTotalAllocations;
+        usages.push_back(value);
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, usages) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetDBusQueueCountersHandler(DBusMessageIter &aIter)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetQueueCounters()) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetOperationQueueCountersHandler(DBusMessageIter &aIter)
+{
+    const agent::ThreadHelper::OperationQueueCounters &queueCounters =
+        mNcp->GetThreadHelper()->GetOperationQueueCounters();
+    otError                error = OT_ERROR_NONE;
+    OperationQueueCounters counters;
+
+    counters.mDepth         = queueCounters.mDepth;
+    counters.mPeakDepth     = queueCounters.mPeakDepth;
+    counters.mQueued        = queueCounters.mQueued;
+    counters.mMerged        = queueCounters.mMerged;
+    counters.mRejected      = queueCounters.mRejected;
+    counters.mTotalWaitTime = queueCounters.mTotalWaitTime;
+    counters.mMaxWaitTime   = queueCounters.mMaxWaitTime;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
+otError DBusThreadObject::GetJoinerCountersHandler(DBusMessageIter &aIter)
+{
+    const agent::ThreadHelper::JoinerCounters &joinerCounters = mNcp->GetThreadHelper()->GetJoinerCounters();
+    otError                                    error          = OT_ERROR_NONE;
+    JoinerCounters                             counters;
 
-    // size is guaranteed by parsing
-    std::copy(onMeshPrefix.mPrefix.mPrefix.begin(), onMeshPrefix.mPrefix.mPrefix.end(),
-              &config.mPrefix.mPrefix.mFields.m8[0]);
-    config.mPrefix.mLength = onMeshPrefix.mPrefix.mLength;
-    config.mPreference     = onMeshPrefix.mPreference;
-    config.mSlaac          = onMeshPrefix.mSlaac;
-    config.mDhcp           = onMeshPrefix.mDhcp;
-    config.mConfigure      = onMeshPrefix.mConfigure;
-    config.mDefaultRoute   = onMeshPrefix.mDefaultRoute;
-    config.mOnMesh         = onMeshPrefix.mOnMesh;
-    config.mStable         = onMeshPrefix.mStable;
+    counters.mCachedChannelAttempts = joinerCounters.mCachedChannelAttempts;
+    counters.mCachedChannelJoins    = joinerCounters.mCachedChannelJoins;
+    counters.mFullDiscoveries       = joinerCounters.mFullDiscoveries;
+    counters.mLastCachedChannelTime = joinerCounters.mLastCachedChannelTime;
+    counters.mLastFullDiscoveryTime = joinerCounters.mLastFullDiscoveryTime;
 
-    SuccessOrExit(error = otBorderRouterAddOnMeshPrefix(threadHelper->GetInstance(), &config));
-    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
-    aRequest.ReplyOtResult(error);
+    return error;
 }
 
-void DBusThreadObject::RemoveOnMeshPrefixHandler(DBusRequest &aRequest)
+otError DBusThreadObject::GetAddressCacheHandler(DBusMessageIter &aIter)
 {
-    auto        threadHelper = mNcp->GetThreadHelper();
-    Ip6Prefix   onMeshPrefix;
-    auto        args  = std::tie(onMeshPrefix);
-    otError     error = OT_ERROR_NONE;
-    otIp6Prefix prefix;
+    const AddressCacheStats &      stats = mNcp->GetThreadHelper()->GetAddressCacheStats();
+    std::vector<AddressCacheEntry> entries;
+    otError                        error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-    // size is guaranteed by parsing
-    std::copy(onMeshPrefix.mPrefix.begin(), onMeshPrefix.mPrefix.end(), &prefix.mPrefix.mFields.m8[0]);
-    prefix.mLength = onMeshPrefix.mLength;
+    for (const AddressCacheStats::Entry &entry : stats.GetEntries())
+    {
+        entries.push_back({std::vector<uint8_t>(entry.mTarget.begin(), entry.mTarget.end()), entry.mRloc16,
+                           static_cast<uint8_t>(entry.mState)});
+    }
 
-    SuccessOrExit(error = otBorderRouterRemoveOnMeshPrefix(threadHelper->GetInstance(), &prefix));
-    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, entries) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
-    aRequest.ReplyOtResult(error);
+    return error;
 }
 
-void DBusThreadObject::AddExternalRouteHandler(DBusRequest &aRequest)
+otError DBusThreadObject::GetAddressCacheCountersHandler(DBusMessageIter &aIter)
 {
-    auto                  threadHelper = mNcp->GetThreadHelper();
-    ExternalRoute         route;
-    auto                  args  = std::tie(route);
-    otError               error = OT_ERROR_NONE;
-    otExternalRouteConfig otRoute;
-    otIp6Prefix &         prefix = otRoute.mPrefix;
-
-    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    const AddressCacheStats::Counters &cacheCounters = mNcp->GetThreadHelper()->GetAddressCacheStats().GetCounters();
+    otError                            error         = OT_ERROR_NONE;
+    AddressCacheCounters               counters;
 
-    // size is guaranteed by parsing
-    std::copy(route.mPrefix.mPrefix.begin(), route.mPrefix.mPrefix.end(), &prefix.mPrefix.mFields.m8[0]);
-    prefix.mLength      = route.mPrefix.mLength;
-    otRoute.mPreference = route.mPreference;
-    otRoute.mStable     = route.mStable;
+    counters.mQueries   = cacheCounters.mQueries;
+    counters.mResponses = cacheCounters.mResponses;
+    counters.mFailures  = cacheCounters.mFailures;
+    counters.mEvictions = cacheCounters.mEvictions;
+    counters.mPeakSize  = cacheCounters.mPeakSize;
 
-    SuccessOrExit(error = otBorderRouterAddRoute(threadHelper->GetInstance(), &otRoute));
-    if (route.mStable)
-    {
-        SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
-    }
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
-    aRequest.ReplyOtResult(error);
+    return error;
 }
 
-void DBusThreadObject::RemoveExternalRouteHandler(DBusRequest &aRequest)
+otError DBusThreadObject::SetActiveDatasetTlvsHandler(DBusMessageIter &aIter)
 {
-    auto        threadHelper = mNcp->GetThreadHelper();
-    Ip6Prefix   routePrefix;
-    auto        args  = std::tie(routePrefix);
-    otError     error = OT_ERROR_NONE;
-    otIp6Prefix prefix;
-
-    VerifyOrExit(DBusMessageToTuple(*aRequest.GetMessage(), args) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    return ExtractDatasetTlvs(aIter, otDatasetSetActiveTlvs, mNcp->GetThreadHelper()->GetInstance());
+}
 
-    // size is guaranteed by parsing
-    std::copy(routePrefix.mPrefix.begin(), routePrefix.mPrefix.end(), &prefix.mPrefix.mFields.m8[0]);
-    prefix.mLength = routePrefix.mLength;
+otError DBusThreadObject::SetPendingDatasetTlvsHandler(DBusMessageIter &aIter)
+{
+    return ExtractDatasetTlvs(aIter, otDatasetSetPendingTlvs, mNcp->GetThreadHelper()->GetInstance());
+}
 
-    SuccessOrExit(error = otBorderRouterRemoveRoute(threadHelper->GetInstance(), &prefix));
-    SuccessOrExit(error = otBorderRouterRegister(threadHelper->GetInstance()));
+otError DBusThreadObject::GetActiveDatasetTlvsHandler(DBusMessageIter &aIter)
+{
+    return EncodeDatasetTlvs(aIter, otDatasetGetActiveTlvs, mNcp->GetThreadHelper()->GetInstance());
+}
 
-exit:
-    aRequest.ReplyOtResult(error);
+otError DBusThreadObject::GetPendingDatasetTlvsHandler(DBusMessageIter &aIter)
+{
+    return EncodeDatasetTlvs(aIter, otDatasetGetPendingTlvs, mNcp->GetThreadHelper()->GetInstance());
 }
 
-void DBusThreadObject::IntrospectHandler(DBusRequest &aRequest)
+otError DBusThreadObject::GetActiveDatasetHandler(DBusMessageIter &aIter)
 {
-    std::string xmlString(
-#include "dbus/server/introspect.hpp"
-    );
+    return EncodeDataset(aIter, otDatasetGetActive, mNcp->GetThreadHelper()->GetInstance());
+}
 
-    aRequest.Reply(std::tie(xmlString));
+otError DBusThreadObject::GetPendingDatasetHandler(DBusMessageIter &aIter)
+{
+    return EncodeDataset(aIter, otDatasetGetPending, mNcp->GetThreadHelper()->GetInstance());
 }
 
-otError DBusThreadObject::SetMeshLocalPrefixHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetUnicastAddressesHandler(DBusMessageIter &aIter)
 {
-    auto                                      threadHelper = mNcp->GetThreadHelper();
-    otMeshLocalPrefix                         prefix;
-    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> data{};
-    otError                                   error = OT_ERROR_NONE;
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-    memcpy(&prefix.m8, &data.front(), sizeof(prefix.m8));
-    error = otThreadSetMeshLocalPrefix(threadHelper->GetInstance(), &prefix);
+    UpdateIp6Addresses(0);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, mUnicastAddresses) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::SetLegacyUlaPrefixHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetMulticastAddressesHandler(DBusMessageIter &aIter)
 {
-    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE> data;
-    otError                                   error = OT_ERROR_NONE;
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-    otNcpHandleDidReceiveNewLegacyUlaPrefix(&data[0]);
+    UpdateIp6Addresses(0);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, mMulticastAddresses) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::SetLinkModeHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetMeshLocalEidHandler(DBusMessageIter &aIter)
 {
-    auto             threadHelper = mNcp->GetThreadHelper();
-    LinkModeConfig   cfg;
-    otLinkModeConfig otCfg;
-    otError          error = OT_ERROR_NONE;
+    auto                                       threadHelper = mNcp->GetThreadHelper();
+    const otIp6Address *                       address      = otThreadGetMeshLocalEid(threadHelper->GetInstance());
+    std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> data;
+    otError                                    error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, cfg) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-    otCfg.mDeviceType         = cfg.mDeviceType;
-    otCfg.mNetworkData        = cfg.mNetworkData;
-    otCfg.mSecureDataRequests = cfg.mSecureDataRequests;
-    otCfg.mRxOnWhenIdle       = cfg.mRxOnWhenIdle;
-    error                     = otThreadSetLinkMode(threadHelper->GetInstance(), otCfg);
+    memcpy(&data.front(), address->mFields.m8, sizeof(address->mFields.m8));
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, data) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetLinkModeHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetEui64Handler(DBusMessageIter &aIter)
 {
-    auto             threadHelper = mNcp->GetThreadHelper();
-    otLinkModeConfig otCfg        = otThreadGetLinkMode(threadHelper->GetInstance());
-    LinkModeConfig   cfg;
-    otError          error = OT_ERROR_NONE;
-
-    cfg.mDeviceType         = otCfg.mDeviceType;
-    cfg.mNetworkData        = otCfg.mNetworkData;
-    cfg.mSecureDataRequests = otCfg.mSecureDataRequests;
-    cfg.mRxOnWhenIdle       = otCfg.mRxOnWhenIdle;
+    auto         threadHelper = mNcp->GetThreadHelper();
+    otExtAddress eui64;
+    uint64_t     eui64Value;
+    otError      error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, cfg) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    otLinkGetFactoryAssignedIeeeEui64(threadHelper->GetInstance(), &eui64);
+    eui64Value = ConvertToUint64(eui64);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, eui64Value) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetDeviceRoleHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetOtHostVersionHandler(DBusMessageIter &aIter)
 {
-    auto         threadHelper = mNcp->GetThreadHelper();
-    otDeviceRole role         = otThreadGetDeviceRole(threadHelper->GetInstance());
-    std::string  roleName     = GetDeviceRoleName(role);
-    ;
-    otError error = OT_ERROR_NONE;
+    std::string version = otGetVersionString();
+    otError     error   = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, roleName) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, version) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetNetworkNameHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::SetLogLevelsHandler(DBusMessageIter &aIter)
 {
-    auto        threadHelper = mNcp->GetThreadHelper();
-    std::string networkName  = otThreadGetNetworkName(threadHelper->GetInstance());
-    otError     error        = OT_ERROR_NONE;
+    std::vector<LogLevel>      levels;
+    std::vector<otbrLogModule> modules;
+    otError                    error = OT_ERROR_NONE;
+
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, levels) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+    // All the levels are checked before any is set, so that an invalid one changes nothing.
+    for (const LogLevel &level : levels)
+    {
+        otbrLogModule module = otbrLogModuleFromString(level.mModule.c_str());
+
+        VerifyOrExit(module != OTBR_LOG_MODULE_NUM, error = OT_ERROR_INVALID_ARGS);
+        VerifyOrExit((level.mLevel >= OTBR_LOG_EMERG && level.mLevel <= OTBR_LOG_DEBUG) ||
+                         (level.mLevel == OTBR_LOG_INHERIT && module != OTBR_LOG_MODULE_DEFAULT),
+                     error = OT_ERROR_INVALID_ARGS);
+        modules.push_back(module);
+    }
+
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        otbrLogSetModuleLevel(modules[i], levels[i].mLevel);
+        otbrLog(OTBR_LOG_NOTICE, "Log level of %s set to %d", levels[i].mModule.c_str(), levels[i].mLevel);
+    }
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, networkName) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    error = Ncp::ControllerOpenThread::UpdateLogLevel();
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetPanIdHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetLogLevelsHandler(DBusMessageIter &aIter)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    uint16_t panId        = otLinkGetPanId(threadHelper->GetInstance());
-    otError  error        = OT_ERROR_NONE;
+    std::vector<LogLevel> levels;
+    otError               error = OT_ERROR_NONE;
+
+    for (int module = OTBR_LOG_MODULE_DEFAULT; module < OTBR_LOG_MODULE_NUM; module++)
+    {
+        otbrLogModule logModule = static_cast<otbrLogModule>(module);
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, panId) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+        levels.push_back({otbrLogModuleToString(logModule), otbrLogGetModuleLevel(logModule)});
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, levels) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetExtPanIdHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::SetLinkAlertIntervalHandler(DBusMessageIter &aIter)
 {
-    auto                   threadHelper = mNcp->GetThreadHelper();
-    const otExtendedPanId *extPanId     = otThreadGetExtendedPanId(threadHelper->GetInstance());
-    uint64_t               extPanIdVal;
-    otError                error = OT_ERROR_NONE;
+    uint32_t interval;
+    otError  error = OT_ERROR_NONE;
 
-    extPanIdVal = ConvertOpenThreadUint64(extPanId->m8);
+    VerifyOrExit(DBusMessageExtractFromVariant(&aIter, interval) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(interval > 0, error = OT_ERROR_INVALID_ARGS);
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, extPanIdVal) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    mLinkAlertInterval = interval;
+
+    if (mLinkAlertTimer.IsRunning())
+    {
+        mLinkAlertTimer.Start(mLinkAlertInterval);
+    }
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetChannelHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetLinkAlertRulesHandler(DBusMessageIter &aIter)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    uint16_t channel      = otLinkGetChannel(threadHelper->GetInstance());
-    otError  error        = OT_ERROR_NONE;
+    std::vector<LinkAlertRule> rules;
+    otError                    error = OT_ERROR_NONE;
+
+    for (const LinkAlerts::Rule &rule : mLinkAlerts.GetRules())
+    {
+        rules.push_back({rule.mId, LinkAlerts::GetMetricName(rule.mMetric), rule.mAbove, rule.mThreshold,
+                         rule.mHysteresis});
+    }
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, channel) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, rules) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetMasterKeyHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetLinkAlertIntervalHandler(DBusMessageIter &aIter)
 {
-    auto                 threadHelper = mNcp->GetThreadHelper();
-    const otMasterKey *  masterKey    = otThreadGetMasterKey(threadHelper->GetInstance());
-    std::vector<uint8_t> keyVal(masterKey->m8, masterKey->m8 + sizeof(masterKey->m8));
-    otError              error = OT_ERROR_NONE;
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, keyVal) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, mLinkAlertInterval) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetCcaFailureRateHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetRaisedLinkAlertsHandler(DBusMessageIter &aIter)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    uint16_t failureRate  = otLinkGetCcaFailureRate(threadHelper->GetInstance());
-    otError  error        = OT_ERROR_NONE;
+    std::vector<LinkAlerts::Crossing> raised;
+    std::vector<LinkAlert>            alerts;
+    otError                           error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, failureRate) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    mLinkAlerts.GetRaisedAlerts(raised);
+
+    for (const LinkAlerts::Crossing &alert : raised)
+    {
+        alerts.push_back({alert.mRuleId, alert.mSubject, alert.mRaised, alert.mValue});
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, alerts) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetLinkCountersHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetFlightRecordsHandler(DBusMessageIter &aIter)
 {
-    auto                 threadHelper = mNcp->GetThreadHelper();
-    const otMacCounters *otCounters   = otLinkGetCounters(threadHelper->GetInstance());
-    MacCounters          counters;
-    otError              error = OT_ERROR_NONE;
+    std::vector<otbr::FlightRecord> records;
+    std::vector<FlightRecord>       entries;
+    otError                         error = OT_ERROR_NONE;
 
-    counters.mTxTotal              = otCounters->mTxTotal;
-    counters.mTxUnicast            = otCounters->mTxUnicast;
-    counters.mTxBroadcast          = otCounters->mTxBroadcast;
-    counters.mTxAckRequested       = otCounters->mTxAckRequested;
-    counters.mTxAcked              = otCounters->mTxAcked;
-    counters.mTxNoAckRequested     = otCounters->mTxNoAckRequested;
-    counters.mTxData               = otCounters->mTxData;
-    counters.mTxDataPoll           = otCounters->mTxDataPoll;
-    counters.mTxBeacon             = otCounters->mTxBeacon;
-    counters.mTxBeaconRequest      = otCounters->mTxBeaconRequest;
-    counters.mTxOther              = otCounters->mTxOther;
-    counters.mTxRetry              = otCounters->mTxRetry;
-    counters.mTxErrCca             = otCounters->mTxErrCca;
-    counters.mTxErrAbort           = otCounters->mTxErrAbort;
-    counters.mTxErrBusyChannel     = otCounters->mTxErrBusyChannel;
-    counters.mRxTotal              = otCounters->mRxTotal;
-    counters.mRxUnicast            = otCounters->mTxUnicast;
-    counters.mRxBroadcast          = otCounters->mRxBroadcast;
-    counters.mRxData               = otCounters->mRxData;
-    counters.mRxDataPoll           = otCounters->mTxDataPoll;
-    counters.mRxBeacon             = otCounters->mRxBeacon;
-    counters.mRxBeaconRequest      = otCounters->mRxBeaconRequest;
-    counters.mRxOther              = otCounters->mRxOther;
-    counters.mRxAddressFiltered    = otCounters->mRxAddressFiltered;
-    counters.mRxDestAddrFiltered   = otCounters->mRxDestAddrFiltered;
-    counters.mRxDuplicated         = otCounters->mRxDuplicated;
-    counters.mRxErrNoFrame         = otCounters->mRxErrNoFrame;
-    counters.mRxErrUnknownNeighbor = otCounters->mRxErrUnknownNeighbor;
-    counters.mRxErrInvalidSrcAddr  = otCounters->mRxErrInvalidSrcAddr;
-    counters.mRxErrSec             = otCounters->mRxErrSec;
-    counters.mRxErrFcs             = otCounters->mRxErrFcs;
-    counters.mRxErrOther           = otCounters->mRxErrOther;
+    otbr::GetFlightRecords(records);
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    for (const otbr::FlightRecord &record : records)
+    {
+        entries.push_back(
+            {record.mAge, otbr::GetFlightEventName(record.mEvent), record.mCode, record.mValue, record.mText});
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, entries) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
@@ -661,11 +2679,10 @@ exit:
 
 otError DBusThreadObject::GetRloc16Handler(DBusMessageIter &aIter)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    otError  error        = OT_ERROR_NONE;
-    uint16_t rloc16       = otThreadGetRloc16(threadHelper->GetInstance());
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, rloc16) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mRloc16) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
@@ -673,12 +2690,10 @@ exit:
 
 otError DBusThreadObject::GetExtendedAddressHandler(DBusMessageIter &aIter)
 {
-    auto                threadHelper    = mNcp->GetThreadHelper();
-    otError             error           = OT_ERROR_NONE;
-    const otExtAddress *addr            = otLinkGetExtendedAddress(threadHelper->GetInstance());
-    uint64_t            extendedAddress = ConvertOpenThreadUint64(addr->m8);
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, extendedAddress) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mExtendedAddress) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
@@ -720,15 +2735,13 @@ exit:
 
 otError DBusThreadObject::GetNetworkDataHandler(DBusMessageIter &aIter)
 {
-    static constexpr size_t kNetworkDataMaxSize = 255;
-    auto                    threadHelper        = mNcp->GetThreadHelper();
-    otError                 error               = OT_ERROR_NONE;
-    uint8_t                 data[kNetworkDataMaxSize];
-    uint8_t                 len = sizeof(data);
-    std::vector<uint8_t>    networkData;
+    auto                 threadHelper = mNcp->GetThreadHelper();
+    otError              error        = OT_ERROR_NONE;
+    std::vector<uint8_t> networkData(kNetworkDataMaxSize);
+    uint8_t              len = kNetworkDataMaxSize;
 
-    SuccessOrExit(error = otNetDataGet(threadHelper->GetInstance(), /*stable=*/false, data, &len));
-    networkData = std::vector<uint8_t>(&data[0], &data[len]);
+    SuccessOrExit(error = otNetDataGet(threadHelper->GetInstance(), /*stable=*/false, networkData.data(), &len));
+    networkData.resize(len);
     VerifyOrExit(DBusMessageEncodeToVariant(&aIter, networkData) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
@@ -737,28 +2750,55 @@ exit:
 
 otError DBusThreadObject::GetStableNetworkDataHandler(DBusMessageIter &aIter)
 {
-    static constexpr size_t kNetworkDataMaxSize = 255;
-    auto                    threadHelper        = mNcp->GetThreadHelper();
-    otError                 error               = OT_ERROR_NONE;
-    uint8_t                 data[kNetworkDataMaxSize];
-    uint8_t                 len = sizeof(data);
-    std::vector<uint8_t>    networkData;
+    auto                 threadHelper = mNcp->GetThreadHelper();
+    otError              error        = OT_ERROR_NONE;
+    std::vector<uint8_t> networkData(kNetworkDataMaxSize);
+    uint8_t              len = kNetworkDataMaxSize;
 
-    SuccessOrExit(error = otNetDataGet(threadHelper->GetInstance(), /*stable=*/true, data, &len));
-    networkData = std::vector<uint8_t>(&data[0], &data[len]);
+    SuccessOrExit(error = otNetDataGet(threadHelper->GetInstance(), /*stable=*/true, networkData.data(), &len));
+    networkData.resize(len);
     VerifyOrExit(DBusMessageEncodeToVariant(&aIter, networkData) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
+otError DBusThreadObject::GetNetworkDataInfoHandler(DBusMessageIter &aIter)
+{
+    otInstance *instance = mNcp->GetThreadHelper()->GetInstance();
+    otError     error    = OT_ERROR_NONE;
+    uint8_t     version  = otNetDataGetVersion(instance);
+    uint16_t    rloc16   = otThreadGetRloc16(instance);
+
+    // The full Network Data version changes with any change of the Network Data, stable or not.
+    if (!mNetworkDataInfoValid || mNetworkDataInfo.mVersion != version || mNetworkDataInfoRloc16 != rloc16)
+    {
+        uint8_t data[kNetworkDataMaxSize];
+        uint8_t len = sizeof(data);
+
+        mNetworkDataInfoValid = false;
+        SuccessOrExit(error = otNetDataGet(instance, /*stable=*/false, data, &len));
+        SuccessOrExit(error = ParseNetworkData(data, len, rloc16, mNetworkDataInfo));
+
+        mNetworkDataInfo.mVersion       = version;
+        mNetworkDataInfo.mStableVersion = otNetDataGetStableVersion(instance);
+        mNetworkDataInfoRloc16          = rloc16;
+        mNetworkDataInfoValid           = true;
+    }
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, mNetworkDataInfo) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
 otError DBusThreadObject::GetLocalLeaderWeightHandler(DBusMessageIter &aIter)
 {
-    auto    threadHelper = mNcp->GetThreadHelper();
-    otError error        = OT_ERROR_NONE;
-    uint8_t weight       = otThreadGetLocalLeaderWeight(threadHelper->GetInstance());
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, weight) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mLocalLeaderWeight) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
@@ -810,74 +2850,78 @@ exit:
 #endif // OPENTHREAD_CONFIG_CHANNEL_MONITOR_ENABLE
 }
 
-otError DBusThreadObject::GetChildTableHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetChannelQualityScoresHandler(DBusMessageIter &aIter)
 {
-    auto                   threadHelper = mNcp->GetThreadHelper();
-    otError                error        = OT_ERROR_NONE;
-    uint16_t               childIndex   = 0;
-    otChildInfo            childInfo;
-    std::vector<ChildInfo> childTable;
+    auto                        threadHelper = mNcp->GetThreadHelper();
+    const otbr::ChannelQuality &scores       = threadHelper->GetChannelQuality();
+    otError                     error        = OT_ERROR_NONE;
+    uint32_t                    channelMask  = otLinkGetSupportedChannelMask(threadHelper->GetInstance());
+    std::vector<ChannelQuality> quality;
 
-    while (otThreadGetChildInfoByIndex(threadHelper->GetInstance(), childIndex, &childInfo) == OT_ERROR_NONE)
+    for (uint8_t i = 0; i < otbr::ChannelQuality::kMaxChannels; i++)
     {
-        ChildInfo info;
-
-        info.mExtAddress         = ConvertOpenThreadUint64(childInfo.mExtAddress.m8);
-        info.mTimeout            = childInfo.mTimeout;
-        info.mAge                = childInfo.mAge;
-        info.mChildId            = childInfo.mChildId;
-        info.mNetworkDataVersion = childInfo.mNetworkDataVersion;
-        info.mLinkQualityIn      = childInfo.mLinkQualityIn;
-        info.mAverageRssi        = childInfo.mAverageRssi;
-        info.mLastRssi           = childInfo.mLastRssi;
-        info.mFrameErrorRate     = childInfo.mFrameErrorRate;
-        info.mMessageErrorRate   = childInfo.mMessageErrorRate;
-        info.mRxOnWhenIdle       = childInfo.mRxOnWhenIdle;
-        info.mSecureDataRequest  = childInfo.mSecureDataRequest;
-        info.mFullThreadDevice   = childInfo.mFullThreadDevice;
-        info.mFullNetworkData    = childInfo.mFullNetworkData;
-        info.mIsStateRestoring   = childInfo.mIsStateRestoring;
-        childTable.push_back(info);
-        childIndex++;
+        if ((channelMask & (1U << i)) && scores.HasScore(i))
+        {
+            quality.emplace_back(ChannelQuality{i, scores.GetScore(i)});
+        }
     }
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, childTable) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, quality) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
 }
 
-otError DBusThreadObject::GetNeighborTableHandler(DBusMessageIter &aIter)
+otError DBusThreadObject::GetChildTableHandler(DBusMessageIter &aIter)
 {
-    auto                      threadHelper = mNcp->GetThreadHelper();
-    otError                   error        = OT_ERROR_NONE;
-    otNeighborInfoIterator    iter         = OT_NEIGHBOR_INFO_ITERATOR_INIT;
-    otNeighborInfo            neighborInfo;
-    std::vector<NeighborInfo> neighborTable;
-
-    while (otThreadGetNextNeighborInfo(threadHelper->GetInstance(), &iter, &neighborInfo) == OT_ERROR_NONE)
-    {
-        NeighborInfo info;
+    DBusMessageIter variantIter, entriesIter;
+    otError         error = OT_ERROR_NONE;
+
+    VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_VARIANT,
+                                                  DBusTypeTrait<std::vector<ChildInfo>>::TYPE_AS_STRING, &variantIter),
+                 error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_open_container(&variantIter, DBUS_TYPE_ARRAY,
+                                                  DBusTypeTrait<ChildInfo>::TYPE_AS_STRING, &entriesIter),
+                 error = OT_ERROR_NO_BUFS);
+    SuccessOrExit(error = ForEachChild(mNcp->GetThreadHelper()->GetInstance(),
+                                       [&entriesIter](const otChildInfo &aChildInfo) {
+                                           ChildInfo info;
+
+                                           Convert(aChildInfo, info);
+                                           return DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE
+                                                      ? OT_ERROR_NONE
+                                                      : OT_ERROR_NO_BUFS;
+                                       }));
+    VerifyOrExit(dbus_message_iter_close_container(&variantIter, &entriesIter), error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_close_container(&aIter, &variantIter), error = OT_ERROR_NO_BUFS);
 
-        info.mExtAddress        = ConvertOpenThreadUint64(neighborInfo.mExtAddress.m8);
-        info.mAge               = neighborInfo.mAge;
-        info.mRloc16            = neighborInfo.mRloc16;
-        info.mLinkFrameCounter  = neighborInfo.mLinkFrameCounter;
-        info.mMleFrameCounter   = neighborInfo.mMleFrameCounter;
-        info.mLinkQualityIn     = neighborInfo.mLinkQualityIn;
-        info.mAverageRssi       = neighborInfo.mAverageRssi;
-        info.mLastRssi          = neighborInfo.mLastRssi;
-        info.mFrameErrorRate    = neighborInfo.mFrameErrorRate;
-        info.mMessageErrorRate  = neighborInfo.mMessageErrorRate;
-        info.mRxOnWhenIdle      = neighborInfo.mRxOnWhenIdle;
-        info.mSecureDataRequest = neighborInfo.mSecureDataRequest;
-        info.mFullThreadDevice  = neighborInfo.mFullThreadDevice;
-        info.mFullNetworkData   = neighborInfo.mFullNetworkData;
-        info.mIsChild           = neighborInfo.mIsChild;
-        neighborTable.push_back(info);
-    }
+exit:
+    return error;
+}
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, neighborTable) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+otError DBusThreadObject::GetNeighborTableHandler(DBusMessageIter &aIter)
+{
+    DBusMessageIter variantIter, entriesIter;
+    otError         error = OT_ERROR_NONE;
+
+    VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_VARIANT,
+                                                  DBusTypeTrait<std::vector<NeighborInfo>>::TYPE_AS_STRING,
+                                                  &variantIter),
+                 error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_open_container(&variantIter, DBUS_TYPE_ARRAY,
+                                                  DBusTypeTrait<NeighborInfo>::TYPE_AS_STRING, &entriesIter),
+                 error = OT_ERROR_NO_BUFS);
+    SuccessOrExit(error = ForEachNeighbor(mNcp->GetThreadHelper()->GetInstance(),
+                                          [&entriesIter](const otNeighborInfo &aNeighborInfo) {
+                                              NeighborInfo info;
+
+                                              Convert(aNeighborInfo, info);
+                                              return DBusMessageEncode(&entriesIter, info) == OTBR_ERROR_NONE
+                                                         ? OT_ERROR_NONE
+                                                         : OT_ERROR_NO_BUFS;
+                                          }));
+    VerifyOrExit(dbus_message_iter_close_container(&variantIter, &entriesIter), error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(dbus_message_iter_close_container(&aIter, &variantIter), error = OT_ERROR_NO_BUFS);
 
 exit:
     return error;
@@ -885,11 +2929,10 @@ exit:
 
 otError DBusThreadObject::GetPartitionIDHandler(DBusMessageIter &aIter)
 {
-    auto     threadHelper = mNcp->GetThreadHelper();
-    otError  error        = OT_ERROR_NONE;
-    uint32_t partitionId  = otThreadGetPartitionId(threadHelper->GetInstance());
+    otError error = OT_ERROR_NONE;
 
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, partitionId) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, GetPropertySnapshot().mPartitionId) == OTBR_ERROR_NONE,
+                 error = OT_ERROR_INVALID_ARGS);
 
 exit:
     return error;
@@ -897,28 +2940,12 @@ exit:
 
 otError DBusThreadObject::GetInstantRssiHandler(DBusMessageIter &aIter)
 {
-    auto    threadHelper = mNcp->GetThreadHelper();
-    otError error        = OT_ERROR_NONE;
-    int8_t  rssi         = otPlatRadioGetRssi(threadHelper->GetInstance());
-
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, rssi) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-
-exit:
-    return error;
+    return EncodeRcpProperty(mRcpProperties[kRcpPropertyInstantRssi], aIter);
 }
 
 otError DBusThreadObject::GetRadioTxPowerHandler(DBusMessageIter &aIter)
 {
-    auto    threadHelper = mNcp->GetThreadHelper();
-    otError error        = OT_ERROR_NONE;
-    int8_t  txPower;
-
-    SuccessOrExit(error = otPlatRadioGetTransmitPower(threadHelper->GetInstance(), &txPower));
-
-    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, txPower) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
-
-exit:
-    return error;
+    return EncodeRcpProperty(mRcpProperties[kRcpPropertyRadioTxPower], aIter);
 }
 
 otError DBusThreadObject::GetExternalRoutesHandler(DBusMessageIter &aIter)
@@ -933,13 +2960,7 @@ otError DBusThreadObject::GetExternalRoutesHandler(DBusMessageIter &aIter)
     {
         ExternalRoute route;
 
-        route.mPrefix.mPrefix      = std::vector<uint8_t>(&config.mPrefix.mPrefix.mFields.m8[0],
-                                                     &config.mPrefix.mPrefix.mFields.m8[OTBR_IP6_PREFIX_SIZE]);
-        route.mPrefix.mLength      = config.mPrefix.mLength;
-        route.mRloc16              = config.mRloc16;
-        route.mPreference          = config.mPreference;
-        route.mStable              = config.mStable;
-        route.mNextHopIsThisDevice = config.mNextHopIsThisDevice;
+        Convert(config, route);
         externalRouteTable.push_back(route);
     }
 
@@ -950,5 +2971,21 @@ exit:
     return error;
 }
 
+otError DBusThreadObject::GetMainloopCountersHandler(DBusMessageIter &aIter)
+{
+    const otbr::MainloopCounters &mainloopCounters = otbr::GetMainloopCounters();
+    MainloopCounters              counters;
+    otError                       error = OT_ERROR_NONE;
+
+    counters.mWakeups          = mainloopCounters.mWakeups;
+    counters.mZeroTimeoutPolls = mainloopCounters.mZeroTimeoutPolls;
+    counters.mSpuriousWakeups  = mainloopCounters.mSpuriousWakeups;
+
+    VerifyOrExit(DBusMessageEncodeToVariant(&aIter, counters) == OTBR_ERROR_NONE, error = OT_ERROR_INVALID_ARGS);
+
+exit:
+    return error;
+}
+
 } // namespace DBus
 } // namespace otbr
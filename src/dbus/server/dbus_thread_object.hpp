@@ -29,12 +29,17 @@
 #ifndef OTBR_DBUS_THREAD_OBJECT_HPP_
 #define OTBR_DBUS_THREAD_OBJECT_HPP_
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include <openthread/link.h>
 
 #include "agent/ncp_openthread.hpp"
+#include "common/table_version.hpp"
+#include "common/timer.hpp"
 #include "dbus/server/dbus_object.hpp"
+#include "utils/link_alerts.hpp"
 
 namespace otbr {
 namespace DBus {
@@ -64,28 +69,155 @@ public:
      */
     otbrError Init(void) override;
 
+    /**
+     * This method sends the property changes held back while the outgoing queue was full.
+     *
+     */
+    void FlushDeferredSignals(void) override;
+
+protected:
+    DBusHandlerResult MessageHandler(DBusConnection *aConnection, DBusMessage *aMessage) override;
+
 private:
-    void DeviceRoleHandler(otDeviceRole aDeviceRole);
+    /**
+     * This structure represents the cheap scalar properties, which are read from OpenThread at most once per main
+     * loop turn however many getters are called.
+     *
+     */
+    struct PropertySnapshot
+    {
+        otDeviceRole mDeviceRole;
+        std::string  mNetworkName;
+        uint16_t     mPanId;
+        uint64_t     mExtPanId;
+        uint16_t     mChannel;
+        uint16_t     mRloc16;
+        uint64_t     mExtendedAddress;
+        uint32_t     mPartitionId;
+        uint8_t      mLocalLeaderWeight;
+    };
+
+    /**
+     * This method returns the property snapshot of the current main loop turn, taking it if needed.
+     *
+     * @returns A reference to the snapshot.
+     *
+     */
+    const PropertySnapshot &GetPropertySnapshot(void);
+
+    /**
+     * This method wraps an OpenThread callback so that it runs in the main loop, which owns the dbus connection.
+     *
+     */
+    template <typename... Args> std::function<void(Args...)> InMainloop(std::function<void(Args...)> aHandler)
+    {
+#if OTBR_ENABLE_NCP_THREAD
+        otbr::Ncp::ControllerOpenThread *ncp = mNcp;
+
+        return [ncp, aHandler](Args... aArgs) { ncp->PostToMainloop(std::bind(aHandler, aArgs...)); };
+#else
+        return aHandler;
+#endif
+    }
+
+    /**
+     * This structure represents a property which changes too often to be signaled on every change.
+     *
+     * Such a property is sampled periodically, and signaled at most once per interval when its value changed.
+     *
+     */
+    struct RateLimitedProperty
+    {
+        const char *mName;     ///< The property name.
+        uint32_t    mInterval; ///< The sampling interval in milliseconds.
+        void (DBusThreadObject::*mRead)(std::vector<uint8_t> &aValue);
+        uint64_t             mNextSample; ///< The time of the next sample, as returned by GetNow().
+        std::vector<uint8_t> mLastValue;  ///< The raw value signaled last.
+    };
+
+    /**
+     * This structure represents a property read from the RCP with a spinel round trip.
+     *
+     * Concurrent Properties.Get calls share one read, which runs off the D-Bus handler and is cached for a short time.
+     *
+     */
+    struct RcpProperty
+    {
+        otError (*mRead)(otInstance *aInstance, int8_t &aValue); ///< The function reading the value from the RCP.
+        uint64_t                 mReadTime; ///< The time of the last read, as returned by GetNow().
+        otError                  mError;    ///< The result of the last read.
+        int8_t                   mValue;    ///< The value of the last read.
+        bool                     mValid;    ///< Whether a read has completed.
+        bool                     mReading;  ///< Whether an asynchronous read is in progress.
+        std::vector<DBusRequest> mWaiters;  ///< The Properties.Get calls waiting for the read in progress.
+    };
+
+    enum
+    {
+        kRcpPropertyInstantRssi,
+        kRcpPropertyRadioTxPower,
+        kNumRcpProperties,
+    };
+
+    void RegisterStateChangedHandler(void);
+    void StateChangedHandler(otChangedFlags aFlags);
+    void UpdateIp6Addresses(otChangedFlags aFlags);
+
+    static void HandleSampleTimer(Timer &aTimer, void *aContext);
+    void        SampleRateLimitedProperties(void);
+    void        ReadCcaFailureRate(std::vector<uint8_t> &aValue);
+    void        ReadLinkCounters(std::vector<uint8_t> &aValue);
+    void        ReadIp6Counters(std::vector<uint8_t> &aValue);
+    void        ReadInstantRssi(std::vector<uint8_t> &aValue);
+
+    static void HandleLinkAlertTimer(Timer &aTimer, void *aContext);
+    void        SampleLinkAlerts(void);
+    void        SampleTxRetryRate(std::vector<LinkAlerts::Crossing> &aCrossings);
+
+    bool    IsRcpPropertyFresh(const RcpProperty &aProperty) const;
+    otError GetRcpProperty(RcpProperty &aProperty, int8_t &aValue);
+    otError EncodeRcpProperty(RcpProperty &aProperty, DBusMessageIter &aIter);
+    void    GetRcpPropertyAsyncHandler(uint8_t aIndex, DBusRequest &aRequest);
+    void    CompleteRcpPropertyRead(uint8_t aIndex, otError aError, int8_t aValue);
+    void    ReplyRcpProperty(RcpProperty &aProperty, DBusRequest &aRequest);
 
     void ScanHandler(DBusRequest &aRequest);
+    void GetPropertiesHandler(DBusRequest &aRequest);
+    void SetPropertiesHandler(DBusRequest &aRequest);
+    void GetChildTableDeltaHandler(DBusRequest &aRequest);
+    void GetNeighborTableDeltaHandler(DBusRequest &aRequest);
+    void QueryChildTableHandler(DBusRequest &aRequest);
+    void QueryNeighborTableHandler(DBusRequest &aRequest);
+    void GetCounterRatesHandler(DBusRequest &aRequest);
+    void GetTopologyHandler(DBusRequest &aRequest);
+    void AddLinkAlertRuleHandler(DBusRequest &aRequest);
+    void RemoveLinkAlertRuleHandler(DBusRequest &aRequest);
     void AttachHandler(DBusRequest &aRequest);
     void LeaveHandler(DBusRequest &aRequest);
     void FactoryResetHandler(DBusRequest &aRequest);
     void ResetHandler(DBusRequest &aRequest);
     void JoinerStartHandler(DBusRequest &aRequest);
     void JoinerStopHandler(DBusRequest &aRequest);
+    void AddJoinersHandler(DBusRequest &aRequest);
+    void RemoveJoinersHandler(DBusRequest &aRequest);
     void PermitUnsecureJoinHandler(DBusRequest &aRequest);
     void AddOnMeshPrefixHandler(DBusRequest &aRequest);
     void RemoveOnMeshPrefixHandler(DBusRequest &aRequest);
     void AddExternalRouteHandler(DBusRequest &aRequest);
     void RemoveExternalRouteHandler(DBusRequest &aRequest);
+    void UpdateBorderRouterConfigHandler(DBusRequest &aRequest);
 
     void IntrospectHandler(DBusRequest &aRequest);
 
     otError SetMeshLocalPrefixHandler(DBusMessageIter &aIter);
     otError SetLegacyUlaPrefixHandler(DBusMessageIter &aIter);
     otError SetLinkModeHandler(DBusMessageIter &aIter);
+    otError SetActiveDatasetTlvsHandler(DBusMessageIter &aIter);
+    otError SetPendingDatasetTlvsHandler(DBusMessageIter &aIter);
+    otError SetLogLevelsHandler(DBusMessageIter &aIter);
+    otError SetLinkAlertIntervalHandler(DBusMessageIter &aIter);
 
+    otError GetMeshLocalPrefixHandler(DBusMessageIter &aIter);
     otError GetLinkModeHandler(DBusMessageIter &aIter);
     otError GetDeviceRoleHandler(DBusMessageIter &aIter);
     otError GetNetworkNameHandler(DBusMessageIter &aIter);
@@ -103,19 +235,66 @@ private:
     otError GetLeaderDataHandler(DBusMessageIter &aIter);
     otError GetNetworkDataHandler(DBusMessageIter &aIter);
     otError GetStableNetworkDataHandler(DBusMessageIter &aIter);
+    otError GetNetworkDataInfoHandler(DBusMessageIter &aIter);
     otError GetLocalLeaderWeightHandler(DBusMessageIter &aIter);
     otError GetChannelMonitorSampleCountHandler(DBusMessageIter &aIter);
     otError GetChannelMonitorAllChannelQualities(DBusMessageIter &aIter);
+    otError GetChannelQualityScoresHandler(DBusMessageIter &aIter);
     otError GetChildTableHandler(DBusMessageIter &aIter);
     otError GetNeighborTableHandler(DBusMessageIter &aIter);
     otError GetPartitionIDHandler(DBusMessageIter &aIter);
     otError GetInstantRssiHandler(DBusMessageIter &aIter);
     otError GetRadioTxPowerHandler(DBusMessageIter &aIter);
     otError GetExternalRoutesHandler(DBusMessageIter &aIter);
+    otError GetMainloopCountersHandler(DBusMessageIter &aIter);
+    otError GetMainloopHistogramsHandler(DBusMessageIter &aIter);
+    otError GetMemoryUsageHandler(DBusMessageIter &aIter);
+    otError GetDBusQueueCountersHandler(DBusMessageIter &aIter);
+    otError GetOperationQueueCountersHandler(DBusMessageIter &aIter);
+    otError GetJoinerCountersHandler(DBusMessageIter &aIter);
+    otError GetAddressCacheHandler(DBusMessageIter &aIter);
+    otError GetAddressCacheCountersHandler(DBusMessageIter &aIter);
+    otError GetActiveDatasetTlvsHandler(DBusMessageIter &aIter);
+    otError GetPendingDatasetTlvsHandler(DBusMessageIter &aIter);
+    otError GetActiveDatasetHandler(DBusMessageIter &aIter);
+    otError GetPendingDatasetHandler(DBusMessageIter &aIter);
+    otError GetUnicastAddressesHandler(DBusMessageIter &aIter);
+    otError GetMulticastAddressesHandler(DBusMessageIter &aIter);
+    otError GetLogLevelsHandler(DBusMessageIter &aIter);
+    otError GetMeshLocalEidHandler(DBusMessageIter &aIter);
+    otError GetEui64Handler(DBusMessageIter &aIter);
+    otError GetOtHostVersionHandler(DBusMessageIter &aIter);
+    otError GetLinkAlertRulesHandler(DBusMessageIter &aIter);
+    otError GetLinkAlertIntervalHandler(DBusMessageIter &aIter);
+    otError GetRaisedLinkAlertsHandler(DBusMessageIter &aIter);
+    otError GetFlightRecordsHandler(DBusMessageIter &aIter);
 
     void ReplyScanResult(DBusRequest &aRequest, otError aError, const std::vector<otActiveScanResult> &aResult);
+    void ReplyTopology(DBusRequest &aRequest, otError aError, const std::vector<TopologyNode> &aNodes);
 
-    otbr::Ncp::ControllerOpenThread *mNcp;
+    otbr::Ncp::ControllerOpenThread  *mNcp;
+    PropertySnapshot                  mSnapshot;
+    uint64_t                          mSnapshotWakeups;
+    bool                              mSnapshotValid;
+    RateLimitedProperty               mRateLimitedProperties[4];
+    RcpProperty                       mRcpProperties[kNumRcpProperties];
+    Timer                             mSampleTimer;
+    std::vector<const char *>         mChangedProperties;
+    std::vector<const char *>         mInvalidatedProperties;
+    TableVersion                      mChildTableVersion;
+    TableVersion                      mNeighborTableVersion;
+    NetworkDataInfo                   mNetworkDataInfo;
+    uint16_t                          mNetworkDataInfoRloc16;
+    bool                              mNetworkDataInfoValid;
+    std::vector<Ip6AddressInfo>       mUnicastAddresses;
+    std::vector<std::vector<uint8_t>> mMulticastAddresses;
+    bool                              mIp6AddressesValid;
+    LinkAlerts                        mLinkAlerts;
+    Timer                             mLinkAlertTimer;
+    uint32_t                          mLinkAlertInterval;
+    uint32_t                          mLinkAlertTxTotal;
+    uint32_t                          mLinkAlertTxRetry;
+    bool                              mLinkAlertCountersValid;
 };
 
 } // namespace DBus
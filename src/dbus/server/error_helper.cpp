@@ -27,6 +27,11 @@
  */
 
 #include "dbus/server/error_helper.hpp"
+
+#include <array>
+
+#include <stdint.h>
+
 #include "common/code_utils.hpp"
 #include "dbus/common/dbus_message_helper.hpp"
 
@@ -72,19 +77,28 @@ static const std::pair<otError, const char *> sErrorNames[] = {
 namespace otbr {
 namespace DBus {
 
-const char *ConvertToDBusErrorName(otError aError)
+// Error names indexed by the error value, unknown errors are named as OT_ERROR_NONE.
+typedef std::array<const char *, UINT8_MAX + 1> ErrorNameTable;
+
+static ErrorNameTable BuildErrorNameTable(void)
 {
-    const char *name = sErrorNames[0].second;
+    ErrorNameTable table;
+
+    table.fill(sErrorNames[0].second);
 
     for (const auto &p : sErrorNames)
     {
-        if (p.first == aError)
-        {
-            name = p.second;
-            break;
-        }
+        table[p.first] = p.second;
     }
-    return name;
+
+    return table;
+}
+
+const char *ConvertToDBusErrorName(otError aError)
+{
+    static const ErrorNameTable sErrorNameTable = BuildErrorNameTable();
+
+    return static_cast<size_t>(aError) < sErrorNameTable.size() ? sErrorNameTable[aError] : sErrorNames[0].second;
 }
 
 } // namespace DBus
@@ -0,0 +1,229 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the advertising proxy.
+ */
+
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_MDNS
+
+#include "mdns/advertising_proxy.hpp"
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+
+/**
+ * The delay in milliseconds from the first queued registration to the flush of the batch.
+ *
+ * Registrations arriving within the delay, e.g. from devices re-registering after a leader change, are published
+ * together.
+ *
+ */
+#ifndef OTBR_CONFIG_ADVERTISING_PROXY_FLUSH_DELAY
+#define OTBR_CONFIG_ADVERTISING_PROXY_FLUSH_DELAY 20
+#endif
+
+/**
+ * The number of queued hosts which flushes the batch without waiting for the delay.
+ *
+ */
+#ifndef OTBR_CONFIG_ADVERTISING_PROXY_MAX_PENDING_HOSTS
+#define OTBR_CONFIG_ADVERTISING_PROXY_MAX_PENDING_HOSTS 64
+#endif
+
+namespace otbr {
+
+namespace Mdns {
+
+static std::string GetServiceKey(const char *aName, const char *aType)
+{
+    return std::string(aName) + "." + aType;
+}
+
+AdvertisingProxy::AdvertisingProxy(Publisher &aPublisher)
+    : mPublisher(aPublisher)
+    , mFlushTimer(HandleFlushTimer, this)
+    , mCounters()
+{
+    mPublisher.SetPublishHandler(HandlePublished, this);
+}
+
+AdvertisingProxy::~AdvertisingProxy(void)
+{
+    mPublisher.SetPublishHandler(NULL, NULL);
+}
+
+void AdvertisingProxy::Register(const Host &aHost)
+{
+    PendingHosts::iterator it = mPendingHosts.find(aHost.mName);
+
+    ++mCounters.mRegistrations;
+
+    if (it != mPendingHosts.end())
+    {
+        ++mCounters.mCoalesced;
+        it->second.mHost = aHost;
+    }
+    else
+    {
+        PendingHost &pending = mPendingHosts[aHost.mName];
+
+        pending.mHost         = aHost;
+        pending.mRegisterTime = GetMainloopClock();
+    }
+
+    if (mPendingHosts.size() >= OTBR_CONFIG_ADVERTISING_PROXY_MAX_PENDING_HOSTS)
+    {
+        Flush();
+    }
+    else if (!mFlushTimer.IsRunning())
+    {
+        mFlushTimer.Start(OTBR_CONFIG_ADVERTISING_PROXY_FLUSH_DELAY);
+    }
+}
+
+otbrError AdvertisingProxy::Flush(void)
+{
+    otbrError          ret = OTBR_ERROR_NONE;
+    MainloopStageTimer stageTimer(kMainloopStageAdvertisingProxyFlush);
+
+    mFlushTimer.Stop();
+    VerifyOrExit(!mPendingHosts.empty());
+    SuccessOrExit(ret = mPublisher.BeginServices());
+
+    for (PendingHosts::iterator it = mPendingHosts.begin(); it != mPendingHosts.end(); ++it)
+    {
+        PublishHost(it->second.mHost, it->second.mRegisterTime);
+        mPublishedHosts[it->first] = it->second.mHost;
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Advertising proxy published %zu hosts.", mPendingHosts.size());
+    mPendingHosts.clear();
+    ++mCounters.mBatches;
+    ret = mPublisher.CommitServices();
+
+exit:
+    if (ret != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Advertising proxy failed to flush: %s", otbrErrorString(ret));
+    }
+
+    return ret;
+}
+
+void AdvertisingProxy::PublishHost(const Host &aHost, uint64_t aRegisterTime)
+{
+    Hosts::const_iterator published = mPublishedHosts.find(aHost.mName);
+
+    for (std::vector<Service>::const_iterator service = aHost.mServices.begin(); service != aHost.mServices.end();
+         ++service)
+    {
+        bool        unchanged = false;
+        std::string key       = GetServiceKey(service->mName.c_str(), service->mType.c_str());
+
+        if (published != mPublishedHosts.end())
+        {
+            for (std::vector<Service>::const_iterator old = published->second.mServices.begin();
+                 old != published->second.mServices.end(); ++old)
+            {
+                if (old->mName == service->mName && old->mType == service->mType)
+                {
+                    unchanged = (old->mPort == service->mPort && old->mTxtRecord == service->mTxtRecord);
+                    break;
+                }
+            }
+        }
+
+        if (unchanged)
+        {
+            ++mCounters.mServicesUnchanged;
+            continue;
+        }
+
+        // The publisher may acknowledge the service before AddService() returns.
+        mRegisterTimes[key] = aRegisterTime;
+
+        if (mPublisher.AddService(service->mPort, service->mName.c_str(), service->mType.c_str(),
+                                  service->mTxtRecord.GetData(), service->mTxtRecord.GetLength()) != OTBR_ERROR_NONE)
+        {
+            ++mCounters.mFailures;
+            mRegisterTimes.erase(key);
+            continue;
+        }
+
+        ++mCounters.mServicesPublished;
+    }
+}
+
+void AdvertisingProxy::HandleMdnsState(State aState)
+{
+    if (aState == kStateReady && !mPendingHosts.empty())
+    {
+        Flush();
+    }
+}
+
+void AdvertisingProxy::HandleFlushTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<AdvertisingProxy *>(aContext)->Flush();
+}
+
+void AdvertisingProxy::HandlePublished(void *aContext, const char *aName, const char *aType, otbrError aError)
+{
+    static_cast<AdvertisingProxy *>(aContext)->HandlePublished(aName, aType, aError);
+}
+
+void AdvertisingProxy::HandlePublished(const char *aName, const char *aType, otbrError aError)
+{
+    std::map<std::string, uint64_t>::iterator it = mRegisterTimes.find(GetServiceKey(aName, aType));
+
+    VerifyOrExit(it != mRegisterTimes.end());
+
+    if (aError == OTBR_ERROR_NONE)
+    {
+        RecordMainloopStage(kMainloopStageAdvertisingProxyLatency, it->second);
+    }
+    else
+    {
+        ++mCounters.mFailures;
+        otbrLog(OTBR_LOG_WARNING, "Advertising proxy failed to publish %s.%s: %s", aName, aType,
+                otbrErrorString(aError));
+    }
+
+    mRegisterTimes.erase(it);
+
+exit:
+    return;
+}
+
+} // namespace Mdns
+
+} // namespace otbr
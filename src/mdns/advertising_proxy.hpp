@@ -0,0 +1,194 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the advertising proxy, which publishes the services registered by Thread
+ *   devices on the infrastructure link.
+ */
+
+#ifndef OTBR_AGENT_ADVERTISING_PROXY_HPP_
+#define OTBR_AGENT_ADVERTISING_PROXY_HPP_
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "common/timer.hpp"
+#include "mdns/mdns.hpp"
+
+namespace otbr {
+
+namespace Mdns {
+
+/**
+ * @addtogroup border-router-mdns
+ *
+ * @{
+ */
+
+/**
+ * This class implements an advertising proxy on top of a MDNS publisher.
+ *
+ * Registrations are queued per host and flushed in a single batch of the publisher, a registration replacing the
+ * pending one of the same host. Only the services whose port or TXT record changed since they were last published
+ * are passed to the publisher.
+ *
+ */
+class AdvertisingProxy
+{
+public:
+    /**
+     * This structure represents a service registered by a host.
+     *
+     */
+    struct Service
+    {
+        std::string mName;      ///< The service instance name.
+        std::string mType;      ///< The service type, e.g. "_coap._udp".
+        uint16_t    mPort;      ///< The port number.
+        TxtRecord   mTxtRecord; ///< The TXT record.
+    };
+
+    /**
+     * This structure represents the registration of a host.
+     *
+     */
+    struct Host
+    {
+        std::string          mName;     ///< The host name.
+        std::vector<Service> mServices; ///< All services of the host.
+    };
+
+    /**
+     * This structure represents the counters of the advertising proxy.
+     *
+     */
+    struct Counters
+    {
+        uint64_t mRegistrations;     ///< The number of host registrations received.
+        uint64_t mCoalesced;         ///< The number of registrations replaced by a later one before a flush.
+        uint64_t mBatches;           ///< The number of batches passed to the publisher.
+        uint64_t mServicesPublished; ///< The number of services added or updated in the publisher.
+        uint64_t mServicesUnchanged; ///< The number of services skipped as already published.
+        uint64_t mFailures;          ///< The number of services rejected by the publisher or the daemon.
+    };
+
+    /**
+     * The constructor of the advertising proxy.
+     *
+     * The proxy takes over the publish handler of @p aPublisher, so it can measure the latency of registrations.
+     *
+     * @param[in]   aPublisher  A reference to the MDNS publisher.
+     *
+     */
+    explicit AdvertisingProxy(Publisher &aPublisher);
+
+    ~AdvertisingProxy(void);
+
+    /**
+     * This method queues the registration of a host, published with the next flush.
+     *
+     * @param[in]   aHost   The host with all its services.
+     *
+     */
+    void Register(const Host &aHost);
+
+    /**
+     * This method publishes all queued registrations in a single batch.
+     *
+     * The registrations stay queued if the publisher is not ready.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully passed the registrations to the publisher.
+     * @retval  OTBR_ERROR_ERRNO    The publisher is not ready.
+     * @retval  OTBR_ERROR_MDNS     The publisher failed to commit the batch.
+     *
+     */
+    otbrError Flush(void);
+
+    /**
+     * This method publishes the queued registrations once the publisher becomes ready.
+     *
+     * @param[in]   aState  The new state of the publisher.
+     *
+     */
+    void HandleMdnsState(State aState);
+
+    /**
+     * This method returns the number of hosts waiting for a flush.
+     *
+     * @returns The number of queued hosts.
+     *
+     */
+    size_t GetPendingHostCount(void) const { return mPendingHosts.size(); }
+
+    /**
+     * This method returns the counters of the advertising proxy.
+     *
+     * @returns A reference to the counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    struct PendingHost
+    {
+        Host     mHost;
+        uint64_t mRegisterTime; ///< The time of the first registration coalesced into this one, in microseconds.
+    };
+
+    typedef std::map<std::string, Host>        Hosts;
+    typedef std::map<std::string, PendingHost> PendingHosts;
+
+    AdvertisingProxy(const AdvertisingProxy &) = delete;
+    AdvertisingProxy &operator=(const AdvertisingProxy &) = delete;
+
+    void PublishHost(const Host &aHost, uint64_t aRegisterTime);
+
+    static void HandleFlushTimer(Timer &aTimer, void *aContext);
+    static void HandlePublished(void *aContext, const char *aName, const char *aType, otbrError aError);
+    void        HandlePublished(const char *aName, const char *aType, otbrError aError);
+
+    Publisher &                     mPublisher;
+    PendingHosts                    mPendingHosts;
+    Hosts                           mPublishedHosts;
+    std::map<std::string, uint64_t> mRegisterTimes; ///< The registration time of each service waiting for an ack.
+    Timer                           mFlushTimer;
+    Counters                        mCounters;
+};
+
+/**
+ * @}
+ */
+
+} // namespace Mdns
+
+} // namespace otbr
+
+#endif // OTBR_AGENT_ADVERTISING_PROXY_HPP_
@@ -0,0 +1,449 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the common part of the MDNS service.
+ */
+
+#ifndef TEST_IN_CHROMIUM
+#include "mdns/mdns.hpp"
+#else
+#include "mdns.hpp"
+#endif
+
+#include <errno.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/time.hpp"
+
+namespace otbr {
+
+namespace Mdns {
+
+otbrError TxtRecord::SetEntry(const char *aName, const uint8_t *aValue, uint8_t aValueLength)
+{
+    otbrError    ret          = OTBR_ERROR_NONE;
+    const size_t nameLength   = strlen(aName);
+    const size_t entryLength  = nameLength + 1 + aValueLength;
+    uint8_t *    entry        = FindEntry(aName, nameLength);
+    size_t       oldEntrySize = (entry == NULL ? 0 : 1 + entry[0]);
+
+    VerifyOrExit(entryLength <= UINT8_MAX && mLength - oldEntrySize + 1 + entryLength <= sizeof(mData),
+                 errno = EMSGSIZE, ret = OTBR_ERROR_ERRNO);
+
+    if (entry == NULL)
+    {
+        entry = mData + mLength;
+    }
+    else if (oldEntrySize != 1 + entryLength)
+    {
+        // Shift the following entries so that only this entry is re-encoded.
+        uint8_t *next = entry + oldEntrySize;
+
+        memmove(entry + 1 + entryLength, next, static_cast<size_t>(mData + mLength - next));
+    }
+
+    mLength = static_cast<uint16_t>(mLength - oldEntrySize + 1 + entryLength);
+
+    entry[0] = static_cast<uint8_t>(entryLength);
+    memcpy(entry + 1, aName, nameLength);
+    entry[1 + nameLength] = '=';
+    memcpy(entry + 2 + nameLength, aValue, aValueLength);
+
+exit:
+    return ret;
+}
+
+otbrError TxtRecord::SetEntry(const char *aName, const char *aValue)
+{
+    otbrError    ret         = OTBR_ERROR_NONE;
+    const size_t valueLength = strlen(aValue);
+
+    VerifyOrExit(valueLength <= UINT8_MAX, errno = EMSGSIZE, ret = OTBR_ERROR_ERRNO);
+    ret = SetEntry(aName, reinterpret_cast<const uint8_t *>(aValue), static_cast<uint8_t>(valueLength));
+
+exit:
+    return ret;
+}
+
+otbrError TxtRecord::SetData(const uint8_t *aData, uint16_t aLength)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    VerifyOrExit(aLength <= sizeof(mData), errno = EMSGSIZE, ret = OTBR_ERROR_ERRNO);
+    memcpy(mData, aData, aLength);
+    mLength = aLength;
+
+exit:
+    return ret;
+}
+
+bool TxtRecord::Equals(const uint8_t *aData, uint16_t aLength) const
+{
+    return mLength == aLength && memcmp(mData, aData, aLength) == 0;
+}
+
+uint8_t *TxtRecord::FindEntry(const char *aName, size_t aNameLength)
+{
+    uint8_t *entry = mData;
+
+    for (const uint8_t *end = mData + mLength; entry < end; entry += 1 + entry[0])
+    {
+        const uint8_t entryLength = entry[0];
+
+        if (entryLength >= aNameLength && memcmp(entry + 1, aName, aNameLength) == 0 &&
+            (entryLength == aNameLength || entry[1 + aNameLength] == '='))
+        {
+            ExitNow();
+        }
+    }
+
+    entry = NULL;
+
+exit:
+    return entry;
+}
+
+otbrError Publisher::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+    TxtRecord txtRecord;
+    va_list   args;
+
+    va_start(args, aType);
+
+    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
+    {
+        SuccessOrExit(ret = txtRecord.SetEntry(name, va_arg(args, const char *)));
+    }
+
+    ret = PublishService(aPort, aName, aType, txtRecord);
+
+exit:
+    va_end(args);
+    return ret;
+}
+
+otbrError Publisher::PublishService(uint16_t aPort, const char *aName, const char *aType, const TxtRecord &aTxtRecord)
+{
+    otbrError ret;
+    otbrError error;
+
+    SuccessOrExit(ret = BeginServices());
+
+    ret   = AddService(aPort, aName, aType, aTxtRecord.GetData(), aTxtRecord.GetLength());
+    error = CommitServices();
+
+    if (ret == OTBR_ERROR_NONE)
+    {
+        ret = error;
+    }
+
+exit:
+    return ret;
+}
+
+otbrError Publisher::SubscribeService(const char *aType)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mServiceCache.AddSubscription(aType));
+
+    ret = StartBrowse(aType);
+
+    if (ret != OTBR_ERROR_NONE)
+    {
+        mServiceCache.RemoveSubscription(aType);
+    }
+
+exit:
+    return ret;
+}
+
+void Publisher::UnsubscribeService(const char *aType)
+{
+    VerifyOrExit(mServiceCache.RemoveSubscription(aType));
+    StopBrowse(aType);
+
+exit:
+    return;
+}
+
+void Publisher::UpdateServiceCacheTimeout(timeval &aTimeout) const
+{
+    mServiceCache.UpdateTimeout(GetNow(), aTimeout);
+}
+
+void Publisher::ProcessServiceCache(void)
+{
+    mServiceCache.Expire(GetMainloopNow(), HandleInstanceExpired, this);
+}
+
+void Publisher::HandleInstanceExpired(void *aContext, const ServiceCache::Instance &aInstance, bool aRemoved)
+{
+    Publisher *publisher = static_cast<Publisher *>(aContext);
+
+    if (aRemoved)
+    {
+        publisher->StopResolve(aInstance);
+    }
+    else
+    {
+        publisher->StartResolve(aInstance);
+    }
+}
+
+bool ServiceCache::AddSubscription(const char *aType)
+{
+    bool first = true;
+
+    for (std::vector<Subscription>::iterator it = mSubscriptions.begin(); it != mSubscriptions.end(); ++it)
+    {
+        if (it->mType == aType)
+        {
+            ++it->mCount;
+            first = false;
+            ExitNow();
+        }
+    }
+
+    {
+        Subscription subscription;
+
+        subscription.mType  = aType;
+        subscription.mCount = 1;
+        mSubscriptions.push_back(subscription);
+    }
+
+exit:
+    return first;
+}
+
+bool ServiceCache::RemoveSubscription(const char *aType)
+{
+    bool last = false;
+
+    for (std::vector<Subscription>::iterator it = mSubscriptions.begin(); it != mSubscriptions.end(); ++it)
+    {
+        if (it->mType == aType)
+        {
+            VerifyOrExit(--it->mCount == 0);
+            mSubscriptions.erase(it);
+            last = true;
+            break;
+        }
+    }
+
+    VerifyOrExit(last);
+
+    for (Instances::iterator it = mInstances.begin(); it != mInstances.end();)
+    {
+        it = (it->mType == aType ? mInstances.erase(it) : it + 1);
+    }
+
+exit:
+    return last;
+}
+
+std::vector<std::string> ServiceCache::GetSubscriptions(void) const
+{
+    std::vector<std::string> types;
+
+    for (std::vector<Subscription>::const_iterator it = mSubscriptions.begin(); it != mSubscriptions.end(); ++it)
+    {
+        types.push_back(it->mType);
+    }
+
+    return types;
+}
+
+bool ServiceCache::AddInstance(const char *aName, const char *aType, const char *aDomain, unsigned long aNow)
+{
+    bool added = false;
+
+    VerifyOrExit(FindInstance(aName, aType) == NULL);
+
+    {
+        Instance instance;
+
+        instance.mName       = aName;
+        instance.mType       = aType;
+        instance.mDomain     = (aDomain != NULL ? aDomain : "");
+        instance.mPort       = 0;
+        instance.mResolved   = false;
+        instance.mExpireTime = aNow + kResolveTimeout;
+        mInstances.push_back(instance);
+    }
+
+    added = true;
+
+exit:
+    return added;
+}
+
+void ServiceCache::UpdateInstance(const char *   aName,
+                                  const char *   aType,
+                                  const char *   aHostName,
+                                  uint16_t       aPort,
+                                  const uint8_t *aTxtData,
+                                  uint16_t       aTxtLength,
+                                  uint32_t       aTtl,
+                                  unsigned long  aNow)
+{
+    Instance *instance = LookupInstance(aName, aType);
+
+    // The instance may have been removed while it was being resolved.
+    VerifyOrExit(instance != NULL);
+
+    instance->mHostName = aHostName;
+    instance->mPort     = aPort;
+    SuccessOrExit(instance->mTxtRecord.SetData(aTxtData, aTxtLength));
+    instance->mResolved   = true;
+    instance->mExpireTime = aNow + static_cast<unsigned long>(aTtl) * 1000;
+
+exit:
+    return;
+}
+
+void ServiceCache::RemoveInstance(const char *aName, const char *aType)
+{
+    for (Instances::iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        if (it->mName == aName && it->mType == aType)
+        {
+            mInstances.erase(it);
+            break;
+        }
+    }
+}
+
+const ServiceCache::Instance *ServiceCache::FindInstance(const char *aName, const char *aType) const
+{
+    const Instance *instance = NULL;
+
+    for (Instances::const_iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        if (it->mName == aName && it->mType == aType)
+        {
+            instance = &*it;
+            break;
+        }
+    }
+
+    return instance;
+}
+
+ServiceCache::Instance *ServiceCache::LookupInstance(const char *aName, const char *aType)
+{
+    return const_cast<Instance *>(static_cast<const ServiceCache *>(this)->FindInstance(aName, aType));
+}
+
+void ServiceCache::UpdateTimeout(unsigned long aNow, timeval &aTimeout) const
+{
+    for (Instances::const_iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+    {
+        unsigned long remaining = (it->mExpireTime > aNow ? it->mExpireTime - aNow : 0);
+
+        if (remaining < GetTimestamp(aTimeout))
+        {
+            aTimeout.tv_sec  = static_cast<time_t>(remaining / 1000);
+            aTimeout.tv_usec = static_cast<suseconds_t>((remaining % 1000) * 1000);
+        }
+    }
+}
+
+void ServiceCache::Expire(unsigned long aNow, ExpireHandler aHandler, void *aContext)
+{
+    for (Instances::iterator it = mInstances.begin(); it != mInstances.end();)
+    {
+        if (it->mExpireTime > aNow)
+        {
+            ++it;
+        }
+        else if (it->mResolved)
+        {
+            // Keep serving the stale data while the instance is resolved again.
+            it->mResolved   = false;
+            it->mExpireTime = aNow + kResolveTimeout;
+            aHandler(aContext, *it, false);
+            ++it;
+        }
+        else
+        {
+            Instance instance = *it;
+
+            it = mInstances.erase(it);
+            aHandler(aContext, instance, true);
+        }
+    }
+}
+
+otbrError Publisher::EncodeTxtData(const TxtEntry *aTxtEntries,
+                                   size_t          aNumTxtEntries,
+                                   uint8_t *       aTxtData,
+                                   uint16_t &      aTxtLength)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+    uint8_t * cur = aTxtData;
+
+    for (size_t i = 0; i < aNumTxtEntries; ++i)
+    {
+        const size_t nameLength   = strlen(aTxtEntries[i].mName);
+        const size_t valueLength  = strlen(aTxtEntries[i].mValue);
+        const size_t recordLength = nameLength + 1 + valueLength;
+
+        const size_t used         = static_cast<size_t>(cur - aTxtData);
+
+        VerifyOrExit(recordLength <= UINT8_MAX && used + 1 + recordLength <= aTxtLength, errno = EMSGSIZE,
+                     ret = OTBR_ERROR_ERRNO);
+
+        cur[0] = static_cast<uint8_t>(recordLength);
+        cur += 1;
+
+        memcpy(cur, aTxtEntries[i].mName, nameLength);
+        cur += nameLength;
+
+        cur[0] = '=';
+        cur += 1;
+
+        memcpy(cur, aTxtEntries[i].mValue, valueLength);
+        cur += valueLength;
+    }
+
+    aTxtLength = static_cast<uint16_t>(cur - aTxtData);
+
+exit:
+    return ret;
+}
+
+} // namespace Mdns
+
+} // namespace otbr
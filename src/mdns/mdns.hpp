@@ -34,8 +34,13 @@
 #ifndef OTBR_AGENT_MDNS_HPP_
 #define OTBR_AGENT_MDNS_HPP_
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
 #include <sys/select.h>
 
+#include "common/flight_recorder.hpp"
 #include "common/types.hpp"
 
 namespace otbr {
@@ -61,6 +66,17 @@ enum State
  */
 typedef void (*StateHandler)(void *aContext, State aState);
 
+/**
+ * This function pointer is called when the MDNS daemon acknowledges publishing a service.
+ *
+ * @param[in]   aContext        A pointer to application-specific context.
+ * @param[in]   aName           The name of the service instance.
+ * @param[in]   aType           The type of the service.
+ * @param[in]   aError          OTBR_ERROR_NONE if the service was published, otherwise the failure.
+ *
+ */
+typedef void (*PublishHandler)(void *aContext, const char *aName, const char *aType, otbrError aError);
+
 /**
  * @addtogroup border-router-mdns
  *
@@ -70,6 +86,319 @@ typedef void (*StateHandler)(void *aContext, State aState);
  * @{
  */
 
+/**
+ * This structure represents a key/value pair of a TXT record.
+ *
+ */
+struct TxtEntry
+{
+    const char *mName;  ///< The null-terminated key.
+    const char *mValue; ///< The null-terminated value.
+};
+
+/**
+ * This class implements a TXT record kept in wire format, i.e. a sequence of length-prefixed "key=value" strings.
+ *
+ * Entries are encoded once when set, so a record can be handed to publishers and compared without re-encoding.
+ *
+ */
+class TxtRecord
+{
+public:
+    enum
+    {
+        kMaxSizeOfData = 512, ///< The max size of the encoded TXT data.
+    };
+
+    /**
+     * The constructor initializes an empty TXT record.
+     *
+     */
+    TxtRecord(void)
+        : mLength(0)
+    {
+    }
+
+    /**
+     * This method sets an entry with a binary value, replacing the entry with the same key if any.
+     *
+     * @param[in]   aName           The null-terminated key.
+     * @param[in]   aValue          A pointer to the value.
+     * @param[in]   aValueLength    The length of @p aValue.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the entry.
+     * @retval  OTBR_ERROR_ERRNO    The entry is longer than 255 bytes or the record is full, errno is EMSGSIZE.
+     *
+     */
+    otbrError SetEntry(const char *aName, const uint8_t *aValue, uint8_t aValueLength);
+
+    /**
+     * This method sets an entry with a string value, replacing the entry with the same key if any.
+     *
+     * @param[in]   aName           The null-terminated key.
+     * @param[in]   aValue          The null-terminated value.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the entry.
+     * @retval  OTBR_ERROR_ERRNO    The entry is longer than 255 bytes or the record is full, errno is EMSGSIZE.
+     *
+     */
+    otbrError SetEntry(const char *aName, const char *aValue);
+
+    /**
+     * This method removes all entries.
+     *
+     */
+    void Clear(void) { mLength = 0; }
+
+    /**
+     * This method returns the encoded TXT data.
+     *
+     * @returns A pointer to the encoded TXT data.
+     *
+     */
+    const uint8_t *GetData(void) const { return mData; }
+
+    /**
+     * This method returns the length of the encoded TXT data.
+     *
+     * @returns The length of the encoded TXT data.
+     *
+     */
+    uint16_t GetLength(void) const { return mLength; }
+
+    /**
+     * This method checks whether this record encodes the given TXT data.
+     *
+     * @param[in]   aData       A pointer to the encoded TXT data.
+     * @param[in]   aLength     The length of @p aData.
+     *
+     * @retval true     The record is identical to @p aData.
+     * @retval false    The record differs from @p aData.
+     *
+     */
+    bool Equals(const uint8_t *aData, uint16_t aLength) const;
+
+    /**
+     * This method replaces the content with already encoded TXT data.
+     *
+     * @param[in]   aData       A pointer to the encoded TXT data.
+     * @param[in]   aLength     The length of @p aData.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the data.
+     * @retval  OTBR_ERROR_ERRNO    @p aData is too long, errno is EMSGSIZE.
+     *
+     */
+    otbrError SetData(const uint8_t *aData, uint16_t aLength);
+
+    /**
+     * This method checks whether two TXT records are identical.
+     *
+     * @param[in]   aOther      The TXT record to compare with.
+     *
+     * @retval true     The records are identical.
+     * @retval false    The records differ.
+     *
+     */
+    bool operator==(const TxtRecord &aOther) const { return aOther.Equals(mData, mLength); }
+
+    /**
+     * This method checks whether two TXT records differ.
+     *
+     * @param[in]   aOther      The TXT record to compare with.
+     *
+     * @retval true     The records differ.
+     * @retval false    The records are identical.
+     *
+     */
+    bool operator!=(const TxtRecord &aOther) const { return !(*this == aOther); }
+
+private:
+    uint8_t *FindEntry(const char *aName, size_t aNameLength);
+
+    uint8_t  mData[kMaxSizeOfData];
+    uint16_t mLength;
+};
+
+/**
+ * This class implements the cache of service instances discovered by browsing.
+ *
+ * The cache is shared by all users of a publisher, a service type is browsed once no matter how many users
+ * subscribed to it. Resolved instances expire after their TTL and are then resolved again, an instance which can not
+ * be resolved within kResolveTimeout is dropped.
+ *
+ */
+class ServiceCache
+{
+public:
+    enum
+    {
+        kDefaultTtl     = 4500,  ///< The TTL in seconds used when the backend does not report one (RFC 6762).
+        kResolveTimeout = 10000, ///< The time in milliseconds allowed for resolving an instance.
+    };
+
+    /**
+     * This structure represents a discovered service instance.
+     *
+     */
+    struct Instance
+    {
+        std::string   mName;       ///< The instance name.
+        std::string   mType;       ///< The service type.
+        std::string   mDomain;     ///< The domain the instance was found in.
+        std::string   mHostName;   ///< The host name, valid once resolved.
+        uint16_t      mPort;       ///< The port number, valid once resolved.
+        TxtRecord     mTxtRecord;  ///< The TXT record, valid once resolved.
+        bool          mResolved;   ///< Whether the instance is resolved and not expired.
+        unsigned long mExpireTime; ///< The time at which the instance expires or resolving times out.
+    };
+
+    typedef std::vector<Instance> Instances;
+
+    /**
+     * This function pointer is called when an instance expires.
+     *
+     * @param[in]   aContext    A pointer to application-specific context.
+     * @param[in]   aInstance   The expired instance.
+     * @param[in]   aRemoved    Whether the instance is removed from the cache, otherwise it should be resolved again.
+     *
+     */
+    typedef void (*ExpireHandler)(void *aContext, const Instance &aInstance, bool aRemoved);
+
+    /**
+     * This method adds a subscription to a service type.
+     *
+     * @param[in]   aType   The service type.
+     *
+     * @retval true     This is the first subscription, the service type should be browsed.
+     * @retval false    The service type is already browsed.
+     *
+     */
+    bool AddSubscription(const char *aType);
+
+    /**
+     * This method removes a subscription to a service type, dropping its instances with the last subscription.
+     *
+     * @param[in]   aType   The service type.
+     *
+     * @retval true     This was the last subscription, browsing the service type should stop.
+     * @retval false    The service type is still subscribed or was not subscribed.
+     *
+     */
+    bool RemoveSubscription(const char *aType);
+
+    /**
+     * This method returns the subscribed service types.
+     *
+     * @returns The subscribed service types.
+     *
+     */
+    std::vector<std::string> GetSubscriptions(void) const;
+
+    /**
+     * This method adds an unresolved instance reported by browsing, if not in the cache yet.
+     *
+     * @param[in]   aName       The instance name.
+     * @param[in]   aType       The service type.
+     * @param[in]   aDomain     The domain.
+     * @param[in]   aNow        The current time in milliseconds.
+     *
+     * @retval true     The instance is new and should be resolved.
+     * @retval false    The instance is already in the cache.
+     *
+     */
+    bool AddInstance(const char *aName, const char *aType, const char *aDomain, unsigned long aNow);
+
+    /**
+     * This method updates an instance with the result of resolving it.
+     *
+     * @param[in]   aName       The instance name.
+     * @param[in]   aType       The service type.
+     * @param[in]   aHostName   The host name.
+     * @param[in]   aPort       The port number.
+     * @param[in]   aTxtData    A pointer to the TXT data.
+     * @param[in]   aTxtLength  The length of @p aTxtData.
+     * @param[in]   aTtl        The TTL in seconds.
+     * @param[in]   aNow        The current time in milliseconds.
+     *
+     */
+    void UpdateInstance(const char *   aName,
+                        const char *   aType,
+                        const char *   aHostName,
+                        uint16_t       aPort,
+                        const uint8_t *aTxtData,
+                        uint16_t       aTxtLength,
+                        uint32_t       aTtl,
+                        unsigned long  aNow);
+
+    /**
+     * This method removes an instance.
+     *
+     * @param[in]   aName       The instance name.
+     * @param[in]   aType       The service type.
+     *
+     */
+    void RemoveInstance(const char *aName, const char *aType);
+
+    /**
+     * This method removes all instances, keeping the subscriptions.
+     *
+     */
+    void ClearInstances(void) { mInstances.clear(); }
+
+    /**
+     * This method finds an instance.
+     *
+     * @param[in]   aName       The instance name.
+     * @param[in]   aType       The service type.
+     *
+     * @returns A pointer to the instance, NULL if not found.
+     *
+     */
+    const Instance *FindInstance(const char *aName, const char *aType) const;
+
+    /**
+     * This method returns all cached instances.
+     *
+     * @returns The cached instances.
+     *
+     */
+    const Instances &GetInstances(void) const { return mInstances; }
+
+    /**
+     * This method updates the timeout so that the main loop wakes up for the next expiration.
+     *
+     * @param[in]       aNow        The current time in milliseconds.
+     * @param[inout]    aTimeout    A reference to the timeout of the main loop.
+     *
+     */
+    void UpdateTimeout(unsigned long aNow, timeval &aTimeout) const;
+
+    /**
+     * This method expires instances.
+     *
+     * Expired resolved instances become unresolved and are reported to be resolved again, unresolved instances whose
+     * resolving timed out are removed.
+     *
+     * @param[in]   aNow        The current time in milliseconds.
+     * @param[in]   aHandler    The function to be called for each expired instance.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    void Expire(unsigned long aNow, ExpireHandler aHandler, void *aContext);
+
+private:
+    struct Subscription
+    {
+        std::string mType;
+        uint32_t    mCount;
+    };
+
+    Instance *LookupInstance(const char *aName, const char *aType);
+
+    std::vector<Subscription> mSubscriptions;
+    Instances                 mInstances;
+};
+
 /**
  * This interface defines the functionality of MDNS service.
  *
@@ -77,6 +406,12 @@ typedef void (*StateHandler)(void *aContext, State aState);
 class Publisher
 {
 public:
+    enum
+    {
+        kMaxSizeOfTxtData = TxtRecord::kMaxSizeOfData, ///< The max size of the encoded TXT data of a service.
+        kMaxTxtEntries    = 16,                        ///< The max number of entries in the TXT data of a service.
+    };
+
     /**
      * This method starts the MDNS service.
      *
@@ -102,19 +437,140 @@ public:
     virtual bool IsStarted(void) const = 0;
 
     /**
-     * This method publishes or updates a service.
+     * This method begins a batch of service publications.
+     *
+     * Services added by AddService() take effect together when CommitServices() is called, which lets the backend
+     * register them with a single entry group commit or IPC round trip.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully began the batch.
+     * @retval  OTBR_ERROR_ERRNO    The publisher is not ready.
+     *
+     */
+    virtual otbrError BeginServices(void) = 0;
+
+    /**
+     * This method adds a service to publish or update to the current batch.
      *
+     * @note only text record can be updated.
+     *
+     * @param[in]   aPort               The port number of this service.
      * @param[in]   aName               The name of this service.
      * @param[in]   aType               The type of this service.
+     * @param[in]   aTxtData            A pointer to the TXT data encoded as length-prefixed strings.
+     * @param[in]   aTxtLength          The length of @p aTxtData.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to add the service.
+     * @retval  OTBR_ERROR_MDNS     The backend rejected the service.
+     *
+     */
+    virtual otbrError AddService(uint16_t       aPort,
+                                 const char *   aName,
+                                 const char *   aType,
+                                 const uint8_t *aTxtData,
+                                 uint16_t       aTxtLength) = 0;
+
+    /**
+     * This method commits all services added since BeginServices().
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully committed the services.
+     * @retval  OTBR_ERROR_MDNS     Failed to commit the services.
+     *
+     */
+    virtual otbrError CommitServices(void) = 0;
+
+    /**
+     * This method publishes or updates a single service.
+     *
      * @param[in]   aPort               The port number of this service.
+     * @param[in]   aName               The name of this service.
+     * @param[in]   aType               The type of this service.
      * @param[in]   ...                 Pointers to null-terminated string of key and value for text record.
      *                                  The last argument must be NULL.
      *
      * @retval  OTBR_ERROR_NONE     Successfully published or updated the service.
      * @retval  OTBR_ERROR_ERRNO    Failed to publish or update the service.
+     * @retval  OTBR_ERROR_MDNS     The backend rejected the service.
+     *
+     */
+    otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...);
+
+    /**
+     * This method publishes or updates a single service with a TXT record.
+     *
+     * @param[in]   aPort               The port number of this service.
+     * @param[in]   aName               The name of this service.
+     * @param[in]   aType               The type of this service.
+     * @param[in]   aTxtRecord          The TXT record of this service.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully published or updated the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update the service.
+     * @retval  OTBR_ERROR_MDNS     The backend rejected the service.
+     *
+     */
+    otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, const TxtRecord &aTxtRecord);
+
+    /**
+     * This method subscribes to a service type, its instances are browsed and resolved into the service cache.
+     *
+     * Subscriptions are counted, the service type is browsed once however many times it is subscribed. Browsing
+     * starts as soon as the publisher is ready.
+     *
+     * @param[in]   aType               The service type, e.g. "_meshcop._udp.".
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully subscribed.
+     * @retval  OTBR_ERROR_MDNS     Failed to browse the service type.
      *
      */
-    virtual otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...) = 0;
+    otbrError SubscribeService(const char *aType);
+
+    /**
+     * This method removes a subscription to a service type.
+     *
+     * Browsing stops and the instances are dropped from the cache with the last subscription.
+     *
+     * @param[in]   aType               The service type.
+     *
+     */
+    void UnsubscribeService(const char *aType);
+
+    /**
+     * This method returns the cache of discovered service instances.
+     *
+     * @returns A reference to the service cache.
+     *
+     */
+    const ServiceCache &GetServiceCache(void) const { return mServiceCache; }
+
+    /**
+     * This method sets the handler called when the daemon acknowledges a service added by AddService().
+     *
+     * @param[in]   aHandler            A pointer to the handler, NULL to stop notifying.
+     * @param[in]   aContext            A pointer to application-specific context.
+     *
+     */
+    void SetPublishHandler(PublishHandler aHandler, void *aContext)
+    {
+        mPublishHandler = aHandler;
+        mPublishContext = aContext;
+    }
+
+    /**
+     * This function encodes TXT entries into TXT data as length-prefixed "key=value" strings.
+     *
+     * @param[in]       aTxtEntries     A pointer to the TXT entries.
+     * @param[in]       aNumTxtEntries  The number of entries in @p aTxtEntries.
+     * @param[out]      aTxtData        A pointer to the buffer receiving the TXT data.
+     * @param[inout]    aTxtLength      On input the size of @p aTxtData, on output the length of the TXT data.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully encoded the TXT data.
+     * @retval  OTBR_ERROR_ERRNO    An entry is longer than 255 bytes or the buffer is too small, errno is EMSGSIZE.
+     *
+     */
+    static otbrError EncodeTxtData(const TxtEntry *aTxtEntries,
+                                   size_t          aNumTxtEntries,
+                                   uint8_t *       aTxtData,
+                                   uint16_t &      aTxtLength);
 
     /**
      * This method performs the MDNS processing.
@@ -143,6 +599,12 @@ public:
                              int &    aMaxFd,
                              timeval &aTimeout) = 0;
 
+    Publisher(void)
+        : mPublishHandler(NULL)
+        , mPublishContext(NULL)
+    {
+    }
+
     virtual ~Publisher(void) {}
 
     /**
@@ -170,6 +632,84 @@ public:
      *
      */
     static void Destroy(Publisher *aPublisher);
+
+protected:
+    /**
+     * This method starts browsing a service type.
+     *
+     * Backends which are not ready yet should defer browsing to when they become ready.
+     *
+     * @param[in]   aType               The service type.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started or deferred browsing.
+     * @retval  OTBR_ERROR_MDNS     Failed to browse the service type.
+     *
+     */
+    virtual otbrError StartBrowse(const char *aType) = 0;
+
+    /**
+     * This method stops browsing a service type along with resolving its instances.
+     *
+     * @param[in]   aType               The service type.
+     *
+     */
+    virtual void StopBrowse(const char *aType) = 0;
+
+    /**
+     * This method starts resolving an instance in the service cache.
+     *
+     * @param[in]   aInstance           The instance to resolve.
+     *
+     */
+    virtual void StartResolve(const ServiceCache::Instance &aInstance) = 0;
+
+    /**
+     * This method stops resolving an instance in the service cache.
+     *
+     * @param[in]   aInstance           The instance no longer resolved.
+     *
+     */
+    virtual void StopResolve(const ServiceCache::Instance &aInstance) = 0;
+
+    /**
+     * This method updates the main loop timeout for the expiration of the service cache.
+     *
+     * @param[inout]    aTimeout        A reference to the timeout.
+     *
+     */
+    void UpdateServiceCacheTimeout(timeval &aTimeout) const;
+
+    /**
+     * This method expires the service cache, resolving again or dropping expired instances.
+     *
+     */
+    void ProcessServiceCache(void);
+
+    /**
+     * This method notifies the publish handler of the daemon's acknowledgement of a service.
+     *
+     * @param[in]   aName               The name of the service instance.
+     * @param[in]   aType               The type of the service.
+     * @param[in]   aError              OTBR_ERROR_NONE if the service was published, otherwise the failure.
+     *
+     */
+    void HandlePublished(const char *aName, const char *aType, otbrError aError)
+    {
+        RecordFlightEvent(kFlightEventMdnsPublished, static_cast<uint16_t>(-aError), 0, aName);
+
+        if (mPublishHandler != NULL)
+        {
+            mPublishHandler(mPublishContext, aName, aType, aError);
+        }
+    }
+
+    ServiceCache mServiceCache;
+
+private:
+    PublishHandler mPublishHandler;
+    void *         mPublishContext;
+
+    static void HandleInstanceExpired(void *aContext, const ServiceCache::Instance &aInstance, bool aRemoved);
 };
 
 /**
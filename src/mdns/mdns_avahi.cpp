@@ -31,11 +31,14 @@
  *   This file implements MDNS service based on avahi.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_MDNS
+
 #include "mdns/mdns_avahi.hpp"
 
 #include <avahi-common/alternative.h>
 #include <avahi-common/error.h>
 #include <avahi-common/malloc.h>
+#include <avahi-common/strlst.h>
 #include <avahi-common/timeval.h>
 #include <errno.h>
 #include <stdio.h>
@@ -45,32 +48,58 @@
 
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
 #include "common/time.hpp"
+#include "common/tracepoint.hpp"
 #include "utils/strcpy_utils.hpp"
 
 AvahiTimeout::AvahiTimeout(const struct timeval *aTimeout,
                            AvahiTimeoutCallback  aCallback,
                            void *                aContext,
                            void *                aPoller)
-    : mCallback(aCallback)
+    : mTimer(HandleTimer, this)
+    , mCallback(aCallback)
     , mContext(aContext)
     , mPoller(aPoller)
+    , mNext(NULL)
+{
+    Update(aTimeout);
+}
+
+void AvahiTimeout::Update(const struct timeval *aTimeout)
 {
-    if (aTimeout)
+    if (aTimeout == NULL)
     {
-        mTimeout = otbr::GetNow() + otbr::GetTimestamp(*aTimeout);
+        mTimer.Stop();
     }
     else
     {
-        mTimeout = 0;
+        // avahi_age() returns the microseconds elapsed since @p aTimeout, which is negative for a future time.
+        AvahiUsec age = avahi_age(aTimeout);
+
+        mTimer.Start(age >= 0 ? 0 : static_cast<uint64_t>(-age + 999) / 1000);
     }
 }
 
+void AvahiTimeout::HandleTimer(otbr::Timer &aTimer, void *aContext)
+{
+    AvahiTimeout *timeout = static_cast<AvahiTimeout *>(aContext);
+
+    (void)aTimer;
+    OTBR_TRACEPOINT1(avahi__timeout__begin, timeout);
+    timeout->mCallback(timeout, timeout->mContext);
+    OTBR_TRACEPOINT1(avahi__timeout__end, timeout);
+}
+
 namespace otbr {
 
 namespace Mdns {
 
 Poller::Poller(void)
+    : mFreeWatches(NULL)
+    , mDeadWatches(NULL)
+    , mFreeTimeouts(NULL)
+    , mDispatching(false)
 {
     mAvahiPoller.userdata         = this;
     mAvahiPoller.watch_new        = WatchNew;
@@ -83,6 +112,36 @@ Poller::Poller(void)
     mAvahiPoller.timeout_free   = TimeoutFree;
 }
 
+Poller::~Poller(void)
+{
+    for (WatchTable::iterator it = mWatchTable.begin(); it != mWatchTable.end(); ++it)
+    {
+        while (*it != NULL)
+        {
+            AvahiWatch *watch = *it;
+
+            *it = watch->mNext;
+            delete watch;
+        }
+    }
+
+    while (mFreeWatches != NULL)
+    {
+        AvahiWatch *watch = mFreeWatches;
+
+        mFreeWatches = watch->mNext;
+        delete watch;
+    }
+
+    while (mFreeTimeouts != NULL)
+    {
+        AvahiTimeout *timeout = mFreeTimeouts;
+
+        mFreeTimeouts = timeout->mNext;
+        delete timeout;
+    }
+}
+
 AvahiWatch *Poller::WatchNew(const struct AvahiPoll *aPoller,
                              int                     aFd,
                              AvahiWatchEvent         aEvent,
@@ -94,11 +153,35 @@ AvahiWatch *Poller::WatchNew(const struct AvahiPoll *aPoller,
 
 AvahiWatch *Poller::WatchNew(int aFd, AvahiWatchEvent aEvent, AvahiWatchCallback aCallback, void *aContext)
 {
+    AvahiWatch *watch;
+
     assert(aEvent && aCallback && aFd >= 0);
 
-    mWatches.push_back(new AvahiWatch(aFd, aEvent, aCallback, aContext, this));
+    if (mFreeWatches != NULL)
+    {
+        watch        = mFreeWatches;
+        mFreeWatches = watch->mNext;
+        *watch       = AvahiWatch(aFd, aEvent, aCallback, aContext, this);
+    }
+    else
+    {
+        watch = new AvahiWatch(aFd, aEvent, aCallback, aContext, this);
+    }
+
+    if (static_cast<size_t>(aFd) >= mWatchTable.size())
+    {
+        mWatchTable.resize(aFd + 1, NULL);
+    }
+
+    // Insert at the head so that a watch created by a callback is not visited by the ongoing dispatch.
+    watch->mNext = mWatchTable[aFd];
+    if (watch->mNext != NULL)
+    {
+        watch->mNext->mPrev = watch;
+    }
+    mWatchTable[aFd] = watch;
 
-    return mWatches.back();
+    return watch;
 }
 
 void Poller::WatchUpdate(AvahiWatch *aWatch, AvahiWatchEvent aEvent)
@@ -118,14 +201,45 @@ void Poller::WatchFree(AvahiWatch *aWatch)
 
 void Poller::WatchFree(AvahiWatch &aWatch)
 {
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
+    if (aWatch.mPrev != NULL)
     {
-        if (*it == &aWatch)
-        {
-            mWatches.erase(it);
-            delete &aWatch;
-            break;
-        }
+        aWatch.mPrev->mNext = aWatch.mNext;
+    }
+    else
+    {
+        mWatchTable[aWatch.mFd] = aWatch.mNext;
+    }
+
+    if (aWatch.mNext != NULL)
+    {
+        aWatch.mNext->mPrev = aWatch.mPrev;
+    }
+
+    aWatch.mCallback = NULL;
+
+    if (mDispatching)
+    {
+        // Keep mNext so that the dispatch loop standing on this watch can move on, and reuse mPrev as the link of
+        // the dead list. The watch is recycled only after the dispatch finishes.
+        aWatch.mPrev = mDeadWatches;
+        mDeadWatches = &aWatch;
+    }
+    else
+    {
+        aWatch.mNext = mFreeWatches;
+        mFreeWatches = &aWatch;
+    }
+}
+
+void Poller::ReclaimWatches(void)
+{
+    while (mDeadWatches != NULL)
+    {
+        AvahiWatch *watch = mDeadWatches;
+
+        mDeadWatches = watch->mPrev;
+        watch->mNext = mFreeWatches;
+        mFreeWatches = watch;
     }
 }
 
@@ -140,20 +254,28 @@ AvahiTimeout *Poller::TimeoutNew(const AvahiPoll *     aPoller,
 
 AvahiTimeout *Poller::TimeoutNew(const struct timeval *aTimeout, AvahiTimeoutCallback aCallback, void *aContext)
 {
-    mTimers.push_back(new AvahiTimeout(aTimeout, aCallback, aContext, this));
-    return mTimers.back();
-}
+    AvahiTimeout *timeout;
 
-void Poller::TimeoutUpdate(AvahiTimeout *aTimer, const struct timeval *aTimeout)
-{
-    if (aTimeout == NULL)
+    if (mFreeTimeouts != NULL)
     {
-        aTimer->mTimeout = 0;
+        timeout            = mFreeTimeouts;
+        mFreeTimeouts      = timeout->mNext;
+        timeout->mCallback = aCallback;
+        timeout->mContext  = aContext;
+        timeout->mNext     = NULL;
+        timeout->Update(aTimeout);
     }
     else
     {
-        aTimer->mTimeout = otbr::GetNow() + otbr::GetTimestamp(*aTimeout);
+        timeout = new AvahiTimeout(aTimeout, aCallback, aContext, this);
     }
+
+    return timeout;
+}
+
+void Poller::TimeoutUpdate(AvahiTimeout *aTimer, const struct timeval *aTimeout)
+{
+    aTimer->Update(aTimeout);
 }
 
 void Poller::TimeoutFree(AvahiTimeout *aTimer)
@@ -163,23 +285,29 @@ void Poller::TimeoutFree(AvahiTimeout *aTimer)
 
 void Poller::TimeoutFree(AvahiTimeout &aTimer)
 {
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
-    {
-        if (*it == &aTimer)
-        {
-            mTimers.erase(it);
-            delete &aTimer;
-            break;
-        }
-    }
+    // The timeout stays allocated, so freeing it from its own callback never leaves a dangling timer behind.
+    aTimer.Update(NULL);
+    aTimer.mNext  = mFreeTimeouts;
+    mFreeTimeouts = &aTimer;
 }
 
 void Poller::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout)
 {
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
+    for (size_t fd = 0; fd < mWatchTable.size(); ++fd)
     {
-        int             fd     = (*it)->mFd;
-        AvahiWatchEvent events = (*it)->mEvents;
+        int events = 0;
+
+        for (AvahiWatch *watch = mWatchTable[fd]; watch != NULL; watch = watch->mNext)
+        {
+            events |= watch->mEvents;
+            watch->mHappened = 0;
+            watch->mPolled   = true;
+        }
+
+        if (events == 0)
+        {
+            continue;
+        }
 
         if (AVAHI_WATCH_IN & events)
         {
@@ -201,117 +329,81 @@ void Poller::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aError
             // TODO what do with this event type?
         }
 
-        if (aMaxFd < fd)
+        if (aMaxFd < static_cast<int>(fd))
         {
-            aMaxFd = fd;
+            aMaxFd = static_cast<int>(fd);
         }
-
-        (*it)->mHappened = 0;
     }
 
-    unsigned long now = GetNow();
-
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
-    {
-        unsigned long timeout = (*it)->mTimeout;
-
-        if (timeout == 0)
-        {
-            continue;
-        }
-
-        if (static_cast<long>(timeout - now) <= 0)
-        {
-            aTimeout.tv_usec = 0;
-            aTimeout.tv_sec  = 0;
-            break;
-        }
-        else
-        {
-            time_t      sec;
-            suseconds_t usec;
-
-            timeout -= now;
-            sec  = static_cast<time_t>(timeout / 1000);
-            usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
-
-            if (sec < aTimeout.tv_sec)
-            {
-                aTimeout.tv_sec = sec;
-            }
-            else if (sec == aTimeout.tv_sec)
-            {
-                if (usec < aTimeout.tv_usec)
-                {
-                    aTimeout.tv_usec = usec;
-                }
-            }
-        }
-    }
+    (void)aTimeout;
 }
 
 void Poller::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
-    unsigned long now = GetNow();
+    MainloopStageTimer stageTimer(kMainloopStageMdnsProcess);
+    // Watches on file descriptors opened by a callback were never polled, stop at the current table size.
+    size_t tableSize = mWatchTable.size();
 
-    for (Watches::iterator it = mWatches.begin(); it != mWatches.end(); ++it)
-    {
-        int             fd     = (*it)->mFd;
-        AvahiWatchEvent events = (*it)->mEvents;
+    mDispatching = true;
 
-        (*it)->mHappened = 0;
+    for (size_t fd = 0; fd < tableSize; ++fd)
+    {
+        int happened = 0;
 
-        if ((AVAHI_WATCH_IN & events) && FD_ISSET(fd, &aReadFdSet))
+        if (mWatchTable[fd] == NULL)
         {
-            (*it)->mHappened |= AVAHI_WATCH_IN;
+            continue;
         }
 
-        if ((AVAHI_WATCH_OUT & events) && FD_ISSET(fd, &aWriteFdSet))
+        if (FD_ISSET(fd, &aReadFdSet))
         {
-            (*it)->mHappened |= AVAHI_WATCH_OUT;
+            happened |= AVAHI_WATCH_IN;
         }
 
-        if ((AVAHI_WATCH_ERR & events) && FD_ISSET(fd, &aErrorFdSet))
+        if (FD_ISSET(fd, &aWriteFdSet))
         {
-            (*it)->mHappened |= AVAHI_WATCH_ERR;
+            happened |= AVAHI_WATCH_OUT;
         }
 
-        // TODO hup events
-        if ((*it)->mHappened)
+        if (FD_ISSET(fd, &aErrorFdSet))
         {
-            (*it)->mCallback(*it, (*it)->mFd, static_cast<AvahiWatchEvent>((*it)->mHappened), (*it)->mContext);
+            happened |= AVAHI_WATCH_ERR;
         }
-    }
-
-    std::vector<AvahiTimeout *> expired;
 
-    for (Timers::iterator it = mTimers.begin(); it != mTimers.end(); ++it)
-    {
-        if ((*it)->mTimeout == 0)
+        // TODO hup events
+        if (happened == 0)
         {
             continue;
         }
 
-        if (static_cast<long>((*it)->mTimeout - now) <= 0)
+        for (AvahiWatch *watch = mWatchTable[fd]; watch != NULL; watch = watch->mNext)
         {
-            expired.push_back(*it);
+            // Skip watches freed by an earlier callback or created after the fd sets were filled.
+            if (watch->mCallback == NULL || !watch->mPolled)
+            {
+                continue;
+            }
+
+            watch->mHappened = happened & watch->mEvents;
+
+            if (watch->mHappened)
+            {
+                OTBR_TRACEPOINT2(avahi__watch__begin, static_cast<int>(fd), watch->mHappened);
+                watch->mCallback(watch, watch->mFd, static_cast<AvahiWatchEvent>(watch->mHappened), watch->mContext);
+                OTBR_TRACEPOINT1(avahi__watch__end, static_cast<int>(fd));
+            }
         }
     }
 
-    for (std::vector<AvahiTimeout *>::iterator it = expired.begin(); it != expired.end(); ++it)
-    {
-        AvahiTimeout *avahiTimeout = *it;
-        avahiTimeout->mCallback(avahiTimeout, avahiTimeout->mContext);
-    }
+    mDispatching = false;
+    ReclaimWatches();
 }
-
 PublisherAvahi::PublisherAvahi(int          aProtocol,
                                const char * aHost,
                                const char * aDomain,
                                StateHandler aHandler,
                                void *       aContext)
     : mClient(NULL)
-    , mGroup(NULL)
     , mProtocol(aProtocol == AF_INET6 ? AVAHI_PROTO_INET6
                                       : aProtocol == AF_INET ? AVAHI_PROTO_INET : AVAHI_PROTO_UNSPEC)
     , mHost(aHost)
@@ -319,6 +411,9 @@ PublisherAvahi::PublisherAvahi(int          aProtocol,
     , mState(kStateIdle)
     , mStateHandler(aHandler)
     , mContext(aContext)
+    , mReconnectTimer(HandleReconnectTimer, this)
+    , mReconnectDelay(kMinReconnectDelay)
+    , mRandom(std::random_device()())
 {
 }
 
@@ -349,23 +444,15 @@ bool PublisherAvahi::IsStarted(void) const
 
 void PublisherAvahi::Stop(void)
 {
-    mServices.clear();
-
-    if (mGroup)
-    {
-        int error = avahi_entry_group_reset(mGroup);
-
-        if (error)
-        {
-            otbrLog(OTBR_LOG_ERR, "Failed to reset entry group: %s!", avahi_strerror(error));
-        }
-    }
+    FreeServices();
+    ResetBrowsers();
+    mReconnectTimer.Stop();
+    mReconnectDelay = kMinReconnectDelay;
 
     if (mClient)
     {
         avahi_client_free(mClient);
         mClient = NULL;
-        mGroup  = NULL;
         mState  = kStateIdle;
         mStateHandler(mContext, mState);
     }
@@ -383,10 +470,20 @@ void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupSt
 
 void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState)
 {
-    assert(mGroup == aGroup || mGroup == NULL);
+    Service * service = NULL;
+    otbrError error   = OTBR_ERROR_NONE;
+
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        if (it->mGroup == aGroup)
+        {
+            service = &*it;
+            break;
+        }
+    }
 
-    otbrLog(OTBR_LOG_INFO, "Avahi group change to state %d.", aState);
-    mGroup = aGroup;
+    VerifyOrExit(service != NULL);
+    otbrLog(OTBR_LOG_INFO, "Avahi group of service %s change to state %d.", service->mName, aState);
 
     /* Called whenever the entry group state changes */
     switch (aState)
@@ -398,60 +495,183 @@ void PublisherAvahi::HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupSt
 
     case AVAHI_ENTRY_GROUP_COLLISION:
         otbrLog(OTBR_LOG_ERR, "Name collision!");
+        error = OTBR_ERROR_MDNS;
         break;
 
     case AVAHI_ENTRY_GROUP_FAILURE:
         otbrLog(OTBR_LOG_ERR, "Group failed: %s!",
                 avahi_strerror(avahi_client_errno(avahi_entry_group_get_client(aGroup))));
         /* Some kind of failure happened while we were registering our services */
+        error = OTBR_ERROR_MDNS;
         break;
 
     case AVAHI_ENTRY_GROUP_UNCOMMITED:
     case AVAHI_ENTRY_GROUP_REGISTERING:
-        otbrLog(OTBR_LOG_ERR, "Group ready.");
-        break;
+        otbrLog(OTBR_LOG_DEBUG, "Group ready.");
+        ExitNow();
 
     default:
         assert(false);
-        break;
+        ExitNow();
+    }
+
+    if (service->mPending)
+    {
+        service->mPending = false;
+        HandlePublished(service->mName, service->mType, error);
+    }
+
+exit:
+    return;
+}
+
+void PublisherAvahi::FreeServices(void)
+{
+    FreeGroups();
+    mServices.clear();
+}
+
+void PublisherAvahi::FreeGroups(void)
+{
+    // The services are kept, so they can be published again once the client is running.
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        if (it->mGroup != NULL)
+        {
+            avahi_entry_group_free(it->mGroup);
+            it->mGroup = NULL;
+        }
     }
 }
 
-void PublisherAvahi::CreateGroup(AvahiClient *aClient)
+void PublisherAvahi::RepublishServices(void)
 {
-    VerifyOrExit(mGroup == NULL);
+    size_t count = 0;
 
-    VerifyOrExit((mGroup = avahi_entry_group_new(aClient, HandleGroupState, this)) != NULL);
+    for (Services::iterator it = mServices.begin(); it != mServices.end();)
+    {
+        TxtList txtList;
+        int     error = 0;
 
-exit:
-    if (mGroup == NULL)
+        if (it->mGroup != NULL)
+        {
+            ++it;
+            continue;
+        }
+
+        // The TXT data was validated when the service was added, so it always converts.
+        ConvertTxtData(it->mTxtRecord.GetData(), it->mTxtRecord.GetLength(), txtList);
+        error = CreateServiceGroup(*it, txtList.mHead);
+
+        if (error)
+        {
+            otbrLog(OTBR_LOG_ERR, "Failed to republish service %s: %s!", it->mName, avahi_strerror(error));
+
+            if (it->mPending)
+            {
+                HandlePublished(it->mName, it->mType, OTBR_ERROR_MDNS);
+            }
+
+            it = mServices.erase(it);
+            continue;
+        }
+
+        it->mPending = true;
+        ++count;
+        ++it;
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Republishing %zu services.", count);
+}
+
+void PublisherAvahi::HandleDisconnected(void)
+{
+    // Avahi invalidates every group and browser of a client which lost the daemon.
+    FreeGroups();
+    ResetBrowsers();
+
+    if (mState != kStateIdle)
     {
-        otbrLog(OTBR_LOG_ERR, "avahi_entry_group_new() failed: %s", avahi_strerror(avahi_client_errno(aClient)));
+        mState = kStateIdle;
+        mStateHandler(mContext, mState);
+    }
+}
+
+void PublisherAvahi::ScheduleReconnect(void)
+{
+    // Jitter the delay, so border routers sharing a daemon do not all reconnect at the same time.
+    uint32_t delay = std::uniform_int_distribution<uint32_t>(mReconnectDelay / 2, mReconnectDelay)(mRandom);
+
+    otbrLog(OTBR_LOG_INFO, "Creating avahi client again in %u ms.", delay);
+    mReconnectTimer.Start(delay);
+    mReconnectDelay = (mReconnectDelay < kMaxReconnectDelay / 2) ? mReconnectDelay * 2 : kMaxReconnectDelay;
+}
+
+void PublisherAvahi::HandleReconnectTimer(Timer &aTimer, void *aContext)
+{
+    (void)aTimer;
+    static_cast<PublisherAvahi *>(aContext)->HandleReconnectTimer();
+}
+
+void PublisherAvahi::HandleReconnectTimer(void)
+{
+    int error = 0;
+
+    if (mClient != NULL)
+    {
+        avahi_client_free(mClient);
+        mClient = NULL;
+    }
+
+    mClient = avahi_client_new(mPoller.GetAvahiPoll(), AVAHI_CLIENT_NO_FAIL, HandleClientState, this, &error);
+
+    if (mClient == NULL)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to create avahi client: %s!", avahi_strerror(error));
+
+        // The client may have already failed in its callback, which schedules the retry.
+        if (!mReconnectTimer.IsRunning())
+        {
+            ScheduleReconnect();
+        }
     }
 }
 
 void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aState)
 {
     otbrLog(OTBR_LOG_INFO, "Avahi client state changed to %d.", aState);
+
+    // avahi_client_new() may report the first states before returning the client.
+    mClient = aClient;
+
     switch (aState)
     {
     case AVAHI_CLIENT_S_RUNNING:
         /* The server has startup successfully and registered its host
          * name on the network, so it's time to create our services */
         otbrLog(OTBR_LOG_INFO, "Avahi client ready.");
-        mState = kStateReady;
-        CreateGroup(aClient);
+        mReconnectDelay = kMinReconnectDelay;
+        mState          = kStateReady;
+        // Replay the services kept across a daemon restart, and commit them with what the handler publishes.
+        RepublishServices();
         mStateHandler(mContext, mState);
-        if (mGroup)
+        CommitServices();
+
         {
-            avahi_entry_group_commit(mGroup);
+            std::vector<std::string> types = mServiceCache.GetSubscriptions();
+
+            for (std::vector<std::string>::iterator it = types.begin(); it != types.end(); ++it)
+            {
+                StartBrowse(it->c_str());
+            }
         }
         break;
 
     case AVAHI_CLIENT_FAILURE:
         otbrLog(OTBR_LOG_ERR, "Client failure: %s", avahi_strerror(avahi_client_errno(aClient)));
-        mState = kStateIdle;
-        mStateHandler(mContext, mState);
+        HandleDisconnected();
+        // The client cannot be freed in its own callback, and gives up reconnecting by itself.
+        ScheduleReconnect();
         break;
 
     case AVAHI_CLIENT_S_COLLISION:
@@ -466,15 +686,15 @@ void PublisherAvahi::HandleClientState(AvahiClient *aClient, AvahiClientState aS
         /* The server records are now being established. This
          * might be caused by a host name change. We need to wait
          * for our own records to register until the host name is
-         * properly esatblished. */
-        if (mGroup)
-        {
-            avahi_entry_group_reset(mGroup);
-        }
+         * properly esatblished. The services are published again
+         * once the client is ready. */
+        FreeGroups();
         break;
 
     case AVAHI_CLIENT_CONNECTING:
+        // The daemon is gone or not started yet, the client connects again by itself.
         otbrLog(OTBR_LOG_DEBUG, "Connecting to avahi server");
+        HandleDisconnected();
         break;
 
     default:
@@ -490,79 +710,96 @@ void PublisherAvahi::UpdateFdSet(fd_set & aReadFdSet,
                                  timeval &aTimeout)
 {
     mPoller.UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+    UpdateServiceCacheTimeout(aTimeout);
 }
 
 void PublisherAvahi::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
     mPoller.Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    ProcessServiceCache();
 }
 
-otbrError PublisherAvahi::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+otbrError PublisherAvahi::BeginServices(void)
 {
-    otbrError ret   = OTBR_ERROR_ERRNO;
-    int       error = 0;
-    // aligned with AvahiStringList
-    AvahiStringList  buffer[kMaxSizeOfTxtRecord / sizeof(AvahiStringList)];
-    AvahiStringList *last = NULL;
-    AvahiStringList *curr = buffer;
-    va_list          args;
-    size_t           used = 0;
+    otbrError ret = OTBR_ERROR_NONE;
 
-    va_start(args, aType);
+    VerifyOrExit(mState == kStateReady, errno = EAGAIN, ret = OTBR_ERROR_ERRNO);
 
-    VerifyOrExit(mState == kStateReady, errno = EAGAIN);
+exit:
+    return ret;
+}
 
-    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
-    {
-        int         rval;
-        const char *value  = va_arg(args, const char *);
-        size_t      needed = sizeof(AvahiStringList) + strlen(name) + strlen(value);
+otbrError PublisherAvahi::AddService(uint16_t       aPort,
+                                     const char *   aName,
+                                     const char *   aType,
+                                     const uint8_t *aTxtData,
+                                     uint16_t       aTxtLength)
+{
+    otbrError ret     = OTBR_ERROR_ERRNO;
+    int       error   = 0;
+    Service * service = NULL;
+    TxtList   txtList;
 
-        VerifyOrExit(used + needed < sizeof(buffer), errno = EMSGSIZE);
-        curr->next = last;
-        last       = curr;
-        rval       = sprintf(reinterpret_cast<char *>(curr->text), "%s=%s", name, value);
-        assert(rval > 0);
-        curr->size = static_cast<size_t>(rval);
-        {
-            const uint8_t *next = curr->text + curr->size;
-            curr                = OTBR_ALIGNED(next, AvahiStringList *);
-        }
-        used = static_cast<size_t>(reinterpret_cast<uint8_t *>(curr) - reinterpret_cast<uint8_t *>(buffer));
-    }
+    OTBR_TRACEPOINT3(mdns__publish, aName, aType, aPort);
+    VerifyOrExit(mState == kStateReady, errno = EAGAIN);
 
     for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
         if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)) &&
             it->mPort == aPort)
         {
-            otbrLog(OTBR_LOG_INFO, "MDNS update service %s", aName);
-            error = avahi_entry_group_update_service_txt_strlst(
-                mGroup, AVAHI_IF_UNSPEC, mProtocol, static_cast<AvahiPublishFlags>(0), aName, aType, mDomain, last);
-            SuccessOrExit(error);
-            ret = OTBR_ERROR_NONE;
-            ExitNow();
+            service = &*it;
+            break;
         }
     }
 
-    otbrLog(OTBR_LOG_INFO, "MDNS create service %s", aName);
-    error = avahi_entry_group_add_service_strlst(mGroup, AVAHI_IF_UNSPEC, mProtocol, static_cast<AvahiPublishFlags>(0),
-                                                 aName, aType, mDomain, mHost, aPort, last);
-    SuccessOrExit(error);
+    if (service != NULL && service->mTxtRecord.Equals(aTxtData, aTxtLength))
+    {
+        otbrLog(OTBR_LOG_DEBUG, "MDNS service %s unchanged", aName);
+        ret = OTBR_ERROR_NONE;
+        ExitNow();
+    }
+
+    VerifyOrExit(ConvertTxtData(aTxtData, aTxtLength, txtList));
 
+    if (service != NULL)
+    {
+        otbrLog(OTBR_LOG_INFO, "MDNS update service %s", aName);
+        error = avahi_entry_group_update_service_txt_strlst(service->mGroup, AVAHI_IF_UNSPEC, mProtocol,
+                                                            static_cast<AvahiPublishFlags>(0), aName, aType, mDomain,
+                                                            txtList.mHead);
+        SuccessOrExit(error);
+    }
+    else
     {
-        Service service;
-        strcpy_safe(service.mName, sizeof(service.mName), aName);
-        strcpy_safe(service.mType, sizeof(service.mType), aType);
-        service.mPort = aPort;
-        mServices.push_back(service);
+        Service newService;
+
+#if OTBR_ENABLE_STATIC_POOLS
+        VerifyOrExit(mServices.size() < mServices.capacity(), errno = ENOSPC);
+#endif
+        otbrLog(OTBR_LOG_INFO, "MDNS create service %s", aName);
+        strcpy_safe(newService.mName, sizeof(newService.mName), aName);
+        strcpy_safe(newService.mType, sizeof(newService.mType), aType);
+        newService.mPort    = aPort;
+        newService.mGroup   = NULL;
+        newService.mPending = false;
+        SuccessOrExit(error = CreateServiceGroup(newService, txtList.mHead));
+
+        mServices.push_back(newService);
+        service = &mServices.back();
     }
 
-    ret = OTBR_ERROR_NONE;
+    SuccessOrExit(ret = service->mTxtRecord.SetData(aTxtData, aTxtLength));
 
-exit:
-    va_end(args);
+    // Avahi acknowledges changes to an established group by the reply of the call, others once it is established.
+    service->mPending = (avahi_entry_group_get_state(service->mGroup) != AVAHI_ENTRY_GROUP_ESTABLISHED);
+
+    if (!service->mPending)
+    {
+        HandlePublished(aName, aType, OTBR_ERROR_NONE);
+    }
 
+exit:
     if (error)
     {
         ret = OTBR_ERROR_MDNS;
@@ -577,6 +814,333 @@ exit:
     return ret;
 }
 
+bool PublisherAvahi::ConvertTxtData(const uint8_t *aTxtData, uint16_t aTxtLength, TxtList &aTxtList)
+{
+    bool             ret  = false;
+    AvahiStringList *curr = aTxtList.mBuffer;
+    size_t           used = 0;
+
+    aTxtList.mHead = NULL;
+
+    for (uint16_t offset = 0; offset < aTxtLength;)
+    {
+        uint8_t size   = aTxtData[offset++];
+        size_t  needed = sizeof(AvahiStringList) + size;
+
+        VerifyOrExit(offset + size <= aTxtLength, errno = EINVAL);
+        VerifyOrExit(used + needed < sizeof(aTxtList.mBuffer), errno = EMSGSIZE);
+        curr->next     = aTxtList.mHead;
+        aTxtList.mHead = curr;
+        memcpy(curr->text, aTxtData + offset, size);
+        curr->size = size;
+        offset += size;
+        {
+            const uint8_t *next = curr->text + curr->size;
+            curr                = OTBR_ALIGNED(next, AvahiStringList *);
+        }
+        used = static_cast<size_t>(reinterpret_cast<uint8_t *>(curr) - reinterpret_cast<uint8_t *>(aTxtList.mBuffer));
+    }
+
+    ret = true;
+
+exit:
+    return ret;
+}
+
+int PublisherAvahi::CreateServiceGroup(Service &aService, AvahiStringList *aTxtList)
+{
+    int              error = 0;
+    AvahiEntryGroup *group = avahi_entry_group_new(mClient, HandleGroupState, this);
+
+    VerifyOrExit(group != NULL, error = avahi_client_errno(mClient));
+    error = avahi_entry_group_add_service_strlst(group, AVAHI_IF_UNSPEC, mProtocol, static_cast<AvahiPublishFlags>(0),
+                                                 aService.mName, aService.mType, mDomain, mHost, aService.mPort,
+                                                 aTxtList);
+    SuccessOrExit(error);
+
+    aService.mGroup = group;
+    group           = NULL;
+
+exit:
+    if (group != NULL)
+    {
+        avahi_entry_group_free(group);
+    }
+
+    return error;
+}
+
+otbrError PublisherAvahi::CommitServices(void)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+
+    // Services updated in an established group are announced by avahi directly, only new groups need a commit.
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        int error;
+
+        if (it->mGroup == NULL || avahi_entry_group_get_state(it->mGroup) != AVAHI_ENTRY_GROUP_UNCOMMITED ||
+            avahi_entry_group_is_empty(it->mGroup))
+        {
+            continue;
+        }
+
+        error = avahi_entry_group_commit(it->mGroup);
+
+        if (error)
+        {
+            ret = OTBR_ERROR_MDNS;
+            otbrLog(OTBR_LOG_ERR, "Failed to commit entry group of service %s: %s!", it->mName, avahi_strerror(error));
+        }
+    }
+
+    return ret;
+}
+
+otbrError PublisherAvahi::StartBrowse(const char *aType)
+{
+    otbrError            ret = OTBR_ERROR_NONE;
+    Browser              browser;
+    AvahiServiceBrowser *serviceBrowser;
+
+    // Browsing starts when the client is running.
+    VerifyOrExit(mState == kStateReady && mClient != NULL);
+
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end(); ++it)
+    {
+        VerifyOrExit(it->mType != aType);
+    }
+
+    serviceBrowser = avahi_service_browser_new(mClient, AVAHI_IF_UNSPEC, mProtocol, aType, mDomain,
+                                               static_cast<AvahiLookupFlags>(0), HandleBrowseResult, this);
+
+    if (serviceBrowser == NULL)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", aType, avahi_strerror(avahi_client_errno(mClient)));
+        ExitNow(ret = OTBR_ERROR_MDNS);
+    }
+
+    browser.mType    = aType;
+    browser.mBrowser = serviceBrowser;
+    mBrowsers.push_back(browser);
+
+exit:
+    return ret;
+}
+
+void PublisherAvahi::StopBrowse(const char *aType)
+{
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end();)
+    {
+        if (it->mType == aType)
+        {
+            avahi_service_browser_free(it->mBrowser);
+            it = mBrowsers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end();)
+    {
+        if (it->mType == aType)
+        {
+            avahi_service_resolver_free(it->mResolver);
+            it = mResolvers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void PublisherAvahi::StartResolve(const ServiceCache::Instance &aInstance)
+{
+    Resolver              resolver;
+    AvahiServiceResolver *serviceResolver;
+
+    VerifyOrExit(mState == kStateReady && mClient != NULL);
+
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        VerifyOrExit(it->mName != aInstance.mName || it->mType != aInstance.mType);
+    }
+
+    serviceResolver = avahi_service_resolver_new(mClient, AVAHI_IF_UNSPEC, mProtocol, aInstance.mName.c_str(),
+                                                 aInstance.mType.c_str(), aInstance.mDomain.c_str(), mProtocol,
+                                                 static_cast<AvahiLookupFlags>(0), HandleResolveResult, this);
+
+    if (serviceResolver == NULL)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to resolve %s: %s!", aInstance.mName.c_str(),
+                avahi_strerror(avahi_client_errno(mClient)));
+        ExitNow();
+    }
+
+    resolver.mName     = aInstance.mName;
+    resolver.mType     = aInstance.mType;
+    resolver.mResolver = serviceResolver;
+    mResolvers.push_back(resolver);
+
+exit:
+    return;
+}
+
+void PublisherAvahi::StopResolve(const ServiceCache::Instance &aInstance)
+{
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        if (it->mName == aInstance.mName && it->mType == aInstance.mType)
+        {
+            avahi_service_resolver_free(it->mResolver);
+            mResolvers.erase(it);
+            break;
+        }
+    }
+}
+
+void PublisherAvahi::ResetBrowsers(void)
+{
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        avahi_service_resolver_free(it->mResolver);
+    }
+
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end(); ++it)
+    {
+        avahi_service_browser_free(it->mBrowser);
+    }
+
+    mResolvers.clear();
+    mBrowsers.clear();
+    mServiceCache.ClearInstances();
+}
+
+void PublisherAvahi::HandleBrowseResult(AvahiServiceBrowser *  aBrowser,
+                                        AvahiIfIndex           aInterfaceIndex,
+                                        AvahiProtocol          aProtocol,
+                                        AvahiBrowserEvent      aEvent,
+                                        const char *           aName,
+                                        const char *           aType,
+                                        const char *           aDomain,
+                                        AvahiLookupResultFlags aFlags,
+                                        void *                 aContext)
+{
+    (void)aInterfaceIndex;
+    (void)aProtocol;
+
+    static_cast<PublisherAvahi *>(aContext)->HandleBrowseResult(aBrowser, aEvent, aName, aType, aDomain, aFlags);
+}
+
+void PublisherAvahi::HandleBrowseResult(AvahiServiceBrowser *  aBrowser,
+                                        AvahiBrowserEvent      aEvent,
+                                        const char *           aName,
+                                        const char *           aType,
+                                        const char *           aDomain,
+                                        AvahiLookupResultFlags aFlags)
+{
+    (void)aBrowser;
+
+    switch (aEvent)
+    {
+    case AVAHI_BROWSER_NEW:
+        // Services published by this host are known already.
+        VerifyOrExit(!(aFlags & AVAHI_LOOKUP_RESULT_OUR_OWN));
+        otbrLog(OTBR_LOG_INFO, "MDNS found service %s.%s", aName, aType);
+
+        if (mServiceCache.AddInstance(aName, aType, aDomain, GetMainloopNow()))
+        {
+            StartResolve(*mServiceCache.FindInstance(aName, aType));
+        }
+        break;
+
+    case AVAHI_BROWSER_REMOVE:
+    {
+        const ServiceCache::Instance *instance = mServiceCache.FindInstance(aName, aType);
+
+        VerifyOrExit(instance != NULL);
+        otbrLog(OTBR_LOG_INFO, "MDNS lost service %s.%s", aName, aType);
+        StopResolve(*instance);
+        mServiceCache.RemoveInstance(aName, aType);
+        break;
+    }
+
+    case AVAHI_BROWSER_FAILURE:
+        otbrLog(OTBR_LOG_ERR, "Browser failed: %s!", avahi_strerror(avahi_client_errno(mClient)));
+        break;
+
+    case AVAHI_BROWSER_CACHE_EXHAUSTED:
+    case AVAHI_BROWSER_ALL_FOR_NOW:
+        break;
+    }
+
+exit:
+    return;
+}
+
+void PublisherAvahi::HandleResolveResult(AvahiServiceResolver * aResolver,
+                                         AvahiIfIndex           aInterfaceIndex,
+                                         AvahiProtocol          aProtocol,
+                                         AvahiResolverEvent     aEvent,
+                                         const char *           aName,
+                                         const char *           aType,
+                                         const char *           aDomain,
+                                         const char *           aHostName,
+                                         const AvahiAddress *   aAddress,
+                                         uint16_t               aPort,
+                                         AvahiStringList *      aTxt,
+                                         AvahiLookupResultFlags aFlags,
+                                         void *                 aContext)
+{
+    (void)aInterfaceIndex;
+    (void)aProtocol;
+    (void)aDomain;
+    (void)aAddress;
+    (void)aFlags;
+
+    static_cast<PublisherAvahi *>(aContext)->HandleResolveResult(aResolver, aEvent, aName, aType, aHostName, aPort,
+                                                                 aTxt);
+}
+
+void PublisherAvahi::HandleResolveResult(AvahiServiceResolver *aResolver,
+                                         AvahiResolverEvent    aEvent,
+                                         const char *          aName,
+                                         const char *          aType,
+                                         const char *          aHostName,
+                                         uint16_t              aPort,
+                                         AvahiStringList *     aTxt)
+{
+    // Resolving is one shot, the instance is resolved again when it expires.
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        if (it->mResolver == aResolver)
+        {
+            mResolvers.erase(it);
+            break;
+        }
+    }
+
+    if (aEvent == AVAHI_RESOLVER_FOUND)
+    {
+        uint8_t txt[kMaxSizeOfTxtData];
+        size_t  txtLength = avahi_string_list_serialize(aTxt, txt, sizeof(txt));
+
+        otbrLog(OTBR_LOG_INFO, "MDNS resolved service %s.%s at %s:%u", aName, aType, aHostName, aPort);
+        mServiceCache.UpdateInstance(aName, aType, aHostName, aPort, txt, static_cast<uint16_t>(txtLength),
+                                     ServiceCache::kDefaultTtl, GetMainloopNow());
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to resolve service %s.%s: %s!", aName, aType,
+                avahi_strerror(avahi_client_errno(mClient)));
+    }
+
+    avahi_service_resolver_free(aResolver);
+}
+
 Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
 {
     return new PublisherAvahi(aFamily, aHost, aDomain, aHandler, aContext);
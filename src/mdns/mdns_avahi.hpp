@@ -34,14 +34,28 @@
 #ifndef OTBR_AGENT_MDNS_AVAHI_HPP_
 #define OTBR_AGENT_MDNS_AVAHI_HPP_
 
+#include <random>
+#include <string>
 #include <vector>
 
 #include <avahi-client/client.h>
+#include <avahi-client/lookup.h>
 #include <avahi-client/publish.h>
 #include <avahi-common/domain.h>
 #include <avahi-common/watch.h>
 
 #include "mdns.hpp"
+#include "common/memory_stats.hpp"
+#include "common/static_pool.hpp"
+#include "common/timer.hpp"
+
+/**
+ * The max number of services published at once in the static-pool build profile.
+ *
+ */
+#ifndef OTBR_CONFIG_MDNS_MAX_SERVICES
+#define OTBR_CONFIG_MDNS_MAX_SERVICES 16
+#endif
 
 /**
  * @addtogroup border-router-mdns
@@ -56,14 +70,17 @@
  * This structure implements AvahiWatch.
  *
  */
-struct AvahiWatch
+struct AvahiWatch : public otbr::MemoryTagged<otbr::kMemoryTagMdns>
 {
     int                mFd;       ///< The file descriptor to watch.
     AvahiWatchEvent    mEvents;   ///< The interested events.
     int                mHappened; ///< The events happened.
+    bool               mPolled;   ///< Whether mFd was added to the fd sets of the current poll.
     AvahiWatchCallback mCallback; ///< The function to be called when interested events happened on mFd.
     void *             mContext;  ///< A pointer to application-specific context.
     void *             mPoller;   ///< The poller created this watch.
+    AvahiWatch *       mPrev;     ///< The previous watch on the same file descriptor, or in the dead list.
+    AvahiWatch *       mNext;     ///< The next watch on the same file descriptor, or in the free list.
 
     /**
      * The constructor to initialize an Avahi watch.
@@ -78,9 +95,13 @@ struct AvahiWatch
     AvahiWatch(int aFd, AvahiWatchEvent aEvents, AvahiWatchCallback aCallback, void *aContext, void *aPoller)
         : mFd(aFd)
         , mEvents(aEvents)
+        , mHappened(0)
+        , mPolled(false)
         , mCallback(aCallback)
         , mContext(aContext)
         , mPoller(aPoller)
+        , mPrev(NULL)
+        , mNext(NULL)
     {
     }
 };
@@ -89,23 +110,37 @@ struct AvahiWatch
  * This structure implements the AvahiTimeout.
  *
  */
-struct AvahiTimeout
+struct AvahiTimeout : public otbr::MemoryTagged<otbr::kMemoryTagMdns>
 {
-    unsigned long        mTimeout;  ///< Absolute time when this timer timeout.
+    otbr::Timer          mTimer;    ///< The timer on the main loop timer service.
     AvahiTimeoutCallback mCallback; ///< The function to be called when timeout.
     void *               mContext;  ///< The pointer to application-specific context.
     void *               mPoller;   ///< The poller created this timer.
+    AvahiTimeout *       mNext;     ///< The next timeout in the free list of the poller.
 
     /**
      * The constructor to initialize an AvahiTimeout.
      *
-     * @param[in]   aTimeout    A pointer to the time after which the callback should be called.
+     * @param[in]   aTimeout    A pointer to the absolute time at which the callback should be called,
+     *                          NULL to create a disarmed timeout.
      * @param[in]   aCallback   The function to be called after timeout.
      * @param[in]   aContext    A pointer to application-specific context.
      * @param[in]   aPoller     The Poller this timeout belongs to.
      *
      */
     AvahiTimeout(const struct timeval *aTimeout, AvahiTimeoutCallback aCallback, void *aContext, void *aPoller);
+
+    /**
+     * This method arms or disarms the timeout.
+     *
+     * @param[in]   aTimeout    A pointer to the absolute time at which the callback should be called,
+     *                          NULL to disarm the timeout.
+     *
+     */
+    void Update(const struct timeval *aTimeout);
+
+private:
+    static void HandleTimer(otbr::Timer &aTimer, void *aContext);
 };
 
 namespace otbr {
@@ -125,6 +160,12 @@ public:
      */
     Poller(void);
 
+    /**
+     * The destructor releases all pooled watches and timeouts.
+     *
+     */
+    ~Poller(void);
+
     /**
      * This method updates the fd_set and timeout for mainloop.
      *
@@ -156,8 +197,11 @@ public:
     const AvahiPoll *GetAvahiPoll(void) const { return &mAvahiPoller; }
 
 private:
-    typedef std::vector<AvahiWatch *>   Watches;
-    typedef std::vector<AvahiTimeout *> Timers;
+    /**
+     * This table is indexed by file descriptor, each slot heads the list of watches on that file descriptor.
+     *
+     */
+    typedef std::vector<AvahiWatch *> WatchTable;
 
     static AvahiWatch *    WatchNew(const struct AvahiPoll *aPoller,
                                     int                     aFd,
@@ -177,10 +221,14 @@ private:
     static void            TimeoutUpdate(AvahiTimeout *aTimer, const struct timeval *aTimeout);
     static void            TimeoutFree(AvahiTimeout *aTimer);
     void                   TimeoutFree(AvahiTimeout &aTimer);
-
-    Watches   mWatches;
-    Timers    mTimers;
-    AvahiPoll mAvahiPoller;
+    void                   ReclaimWatches(void);
+
+    WatchTable    mWatchTable;
+    AvahiWatch *  mFreeWatches;  ///< Watches ready for reuse.
+    AvahiWatch *  mDeadWatches;  ///< Watches freed while dispatching, reclaimed once dispatch finishes.
+    AvahiTimeout *mFreeTimeouts; ///< Timeouts ready for reuse.
+    bool          mDispatching;
+    AvahiPoll     mAvahiPoller;
 };
 
 /**
@@ -206,21 +254,47 @@ public:
     ~PublisherAvahi(void);
 
     /**
-     * This method publishes or updates a service.
+     * This method begins a batch of service publications.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully began the batch.
+     * @retval  OTBR_ERROR_ERRNO    The publisher is not ready.
+     *
+     */
+    otbrError BeginServices(void);
+
+    /**
+     * This method adds a service to publish or update.
+     *
+     * Each service is published in its own entry group, so that adding or updating a service does not probe or
+     * announce the others again.
      *
      * @note only text record can be updated.
      *
+     * @param[in]   aPort               The port number of this service.
      * @param[in]   aName               The name of this service.
      * @param[in]   aType               The type of this service.
-     * @param[in]   aPort               The port number of this service.
-     * @param[in]   ...                 Pointers to null-terminated string of key and value for text record.
-     *                                  The last argument must be NULL.
+     * @param[in]   aTxtData            A pointer to the TXT data encoded as length-prefixed strings.
+     * @param[in]   aTxtLength          The length of @p aTxtData.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the service.
+     * @retval  OTBR_ERROR_ERRNO    Failed to add the service.
+     * @retval  OTBR_ERROR_MDNS     Avahi rejected the service.
+     *
+     */
+    otbrError AddService(uint16_t       aPort,
+                         const char *   aName,
+                         const char *   aType,
+                         const uint8_t *aTxtData,
+                         uint16_t       aTxtLength);
+
+    /**
+     * This method commits the entry groups of the services added since the last commit.
      *
-     * @retval  OTBR_ERROR_NONE     Successfully published or updated the service.
-     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update the service.
+     * @retval  OTBR_ERROR_NONE     Successfully committed the services.
+     * @retval  OTBR_ERROR_MDNS     Failed to commit an entry group.
      *
      */
-    otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...);
+    otbrError CommitServices(void);
 
     /**
      * This method starts the MDNS service.
@@ -271,32 +345,120 @@ public:
 private:
     enum
     {
-        kMaxSizeOfTxtRecord   = 128,
         kMaxSizeOfServiceName = AVAHI_LABEL_MAX,
         kMaxSizeOfHost        = AVAHI_LABEL_MAX,
         kMaxSizeOfDomain      = AVAHI_LABEL_MAX,
         kMaxSizeOfServiceType = AVAHI_LABEL_MAX,
     };
 
+    enum : uint32_t
+    {
+        kMinReconnectDelay = 1000,  ///< The initial delay before creating a failed avahi client again, in ms.
+        kMaxReconnectDelay = 60000, ///< The longest delay before creating a failed avahi client again, in ms.
+    };
+
     struct Service
     {
-        char     mName[kMaxSizeOfServiceName];
-        char     mType[kMaxSizeOfServiceType];
-        uint16_t mPort;
+        char             mName[kMaxSizeOfServiceName];
+        char             mType[kMaxSizeOfServiceType];
+        uint16_t         mPort;
+        TxtRecord        mTxtRecord; ///< The TXT record last published, replayed when the daemon is back.
+        AvahiEntryGroup *mGroup;     ///< The entry group publishing only this service, NULL until republished.
+        bool             mPending;   ///< Whether the service waits for its group to be established.
     };
 
+#if OTBR_ENABLE_STATIC_POOLS
+    typedef StaticVector<Service, OTBR_CONFIG_MDNS_MAX_SERVICES> Services;
+#else
     typedef std::vector<Service> Services;
+#endif
+
+    struct TxtList
+    {
+        // aligned with AvahiStringList
+        AvahiStringList  mBuffer[kMaxSizeOfTxtData / sizeof(AvahiStringList) + kMaxTxtEntries];
+        AvahiStringList *mHead;
+    };
+
+    struct Browser
+    {
+        std::string          mType;
+        AvahiServiceBrowser *mBrowser;
+    };
+
+    struct Resolver
+    {
+        std::string           mName;
+        std::string           mType;
+        AvahiServiceResolver *mResolver;
+    };
+
+    typedef std::vector<Browser>  Browsers;
+    typedef std::vector<Resolver> Resolvers;
+
+    otbrError StartBrowse(const char *aType);
+    void      StopBrowse(const char *aType);
+    void      StartResolve(const ServiceCache::Instance &aInstance);
+    void      StopResolve(const ServiceCache::Instance &aInstance);
+    void      ResetBrowsers(void);
+
+    static void HandleBrowseResult(AvahiServiceBrowser *  aBrowser,
+                                   AvahiIfIndex           aInterfaceIndex,
+                                   AvahiProtocol          aProtocol,
+                                   AvahiBrowserEvent      aEvent,
+                                   const char *           aName,
+                                   const char *           aType,
+                                   const char *           aDomain,
+                                   AvahiLookupResultFlags aFlags,
+                                   void *                 aContext);
+    void        HandleBrowseResult(AvahiServiceBrowser *  aBrowser,
+                                   AvahiBrowserEvent      aEvent,
+                                   const char *           aName,
+                                   const char *           aType,
+                                   const char *           aDomain,
+                                   AvahiLookupResultFlags aFlags);
+    static void HandleResolveResult(AvahiServiceResolver * aResolver,
+                                    AvahiIfIndex           aInterfaceIndex,
+                                    AvahiProtocol          aProtocol,
+                                    AvahiResolverEvent     aEvent,
+                                    const char *           aName,
+                                    const char *           aType,
+                                    const char *           aDomain,
+                                    const char *           aHostName,
+                                    const AvahiAddress *   aAddress,
+                                    uint16_t               aPort,
+                                    AvahiStringList *      aTxt,
+                                    AvahiLookupResultFlags aFlags,
+                                    void *                 aContext);
+    void        HandleResolveResult(AvahiServiceResolver *aResolver,
+                                    AvahiResolverEvent    aEvent,
+                                    const char *          aName,
+                                    const char *          aType,
+                                    const char *          aHostName,
+                                    uint16_t              aPort,
+                                    AvahiStringList *     aTxt);
 
     static void HandleClientState(AvahiClient *aClient, AvahiClientState aState, void *aContext);
     void        HandleClientState(AvahiClient *aClient, AvahiClientState aState);
 
-    void        CreateGroup(AvahiClient *aClient);
     static void HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState, void *aContext);
     void        HandleGroupState(AvahiEntryGroup *aGroup, AvahiEntryGroupState aState);
+    void        FreeServices(void);
+    void        FreeGroups(void);
+
+    static bool ConvertTxtData(const uint8_t *aTxtData, uint16_t aTxtLength, TxtList &aTxtList);
+    int         CreateServiceGroup(Service &aService, AvahiStringList *aTxtList);
+    void        RepublishServices(void);
+
+    void        HandleDisconnected(void);
+    void        ScheduleReconnect(void);
+    static void HandleReconnectTimer(Timer &aTimer, void *aContext);
+    void        HandleReconnectTimer(void);
 
     Services         mServices;
+    Browsers         mBrowsers;
+    Resolvers        mResolvers;
     AvahiClient *    mClient;
-    AvahiEntryGroup *mGroup;
     Poller           mPoller;
     int              mProtocol;
     const char *     mHost;
@@ -304,6 +466,9 @@ private:
     State            mState;
     StateHandler     mStateHandler;
     void *           mContext;
+    Timer            mReconnectTimer;
+    uint32_t         mReconnectDelay; ///< The current backoff before creating a failed avahi client again, in ms.
+    std::minstd_rand mRandom;
 };
 
 } // namespace Mdns
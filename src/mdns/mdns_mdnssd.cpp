@@ -31,6 +31,8 @@
  *   This file implements MDNS service based on avahi.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_MDNS
+
 #include "mdns/mdns_mdnssd.hpp"
 
 #include <arpa/inet.h>
@@ -167,7 +169,8 @@ PublisherMDnsSd::PublisherMDnsSd(int          aProtocol,
                                  const char * aDomain,
                                  StateHandler aHandler,
                                  void *       aContext)
-    : mHost(aHost)
+    : mConnection(NULL)
+    , mHost(aHost)
     , mDomain(aDomain)
     , mState(kStateIdle)
     , mStateHandler(aHandler)
@@ -196,7 +199,14 @@ bool PublisherMDnsSd::IsStarted(void) const
 void PublisherMDnsSd::Stop(void)
 {
     VerifyOrExit(mState == kStateReady);
+    Disconnect();
+
+exit:
+    return;
+}
 
+void PublisherMDnsSd::Disconnect(void)
+{
     for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
         otbrLog(OTBR_LOG_INFO, "MDNS remove service %s", it->mName);
@@ -205,8 +215,30 @@ void PublisherMDnsSd::Stop(void)
 
     mServices.clear();
 
-exit:
-    return;
+    // Operations sharing the connection must be deallocated before the connection itself.
+    ResetBrowsers();
+
+    if (mConnection != NULL)
+    {
+        DNSServiceRefDeallocate(mConnection);
+        mConnection = NULL;
+    }
+}
+
+void PublisherMDnsSd::Reconnect(void)
+{
+    std::vector<std::string> types = mServiceCache.GetSubscriptions();
+
+    // An error on the shared connection invalidates every service and browser on it.
+    Disconnect();
+
+    for (std::vector<std::string>::iterator it = types.begin(); it != types.end(); ++it)
+    {
+        StartBrowse(it->c_str());
+    }
+
+    // Let the owner publish its services again.
+    mStateHandler(mContext, mState);
 }
 
 void PublisherMDnsSd::UpdateFdSet(fd_set & aReadFdSet,
@@ -215,51 +247,48 @@ void PublisherMDnsSd::UpdateFdSet(fd_set & aReadFdSet,
                                   int &    aMaxFd,
                                   timeval &aTimeout)
 {
+    int fd;
+
     (void)aWriteFdSet;
     (void)aErrorFdSet;
-    (void)aTimeout;
 
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
-    {
-        int fd = DNSServiceRefSockFD(it->mService);
+    UpdateServiceCacheTimeout(aTimeout);
+    VerifyOrExit(mConnection != NULL);
 
-        assert(fd != -1);
+    fd = DNSServiceRefSockFD(mConnection);
+    assert(fd != -1);
 
-        FD_SET(fd, &aReadFdSet);
+    FD_SET(fd, &aReadFdSet);
 
-        if (fd > aMaxFd)
-        {
-            aMaxFd = fd;
-        }
+    if (fd > aMaxFd)
+    {
+        aMaxFd = fd;
     }
+
+exit:
+    return;
 }
 
 void PublisherMDnsSd::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
-    std::vector<DNSServiceRef> readyServices;
+    DNSServiceErrorType error;
 
     (void)aWriteFdSet;
     (void)aErrorFdSet;
 
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
-    {
-        int fd = DNSServiceRefSockFD(it->mService);
+    VerifyOrExit(mConnection != NULL && FD_ISSET(DNSServiceRefSockFD(mConnection), &aReadFdSet));
 
-        if (FD_ISSET(fd, &aReadFdSet))
-        {
-            readyServices.push_back(it->mService);
-        }
-    }
+    // Results of all services registered on the shared connection are dispatched here.
+    error = DNSServiceProcessResult(mConnection);
 
-    for (std::vector<DNSServiceRef>::iterator it = readyServices.begin(); it != readyServices.end(); ++it)
+    if (error != kDNSServiceErr_NoError)
     {
-        DNSServiceErrorType error = DNSServiceProcessResult(*it);
-
-        if (error != kDNSServiceErr_NoError)
-        {
-            otbrLog(OTBR_LOG_WARNING, "DNSServiceProcessResult failed: %s", DNSErrorToString(error));
-        }
+        otbrLog(OTBR_LOG_WARNING, "DNSServiceProcessResult failed: %s", DNSErrorToString(error));
+        Reconnect();
     }
+
+exit:
+    ProcessServiceCache();
 }
 
 void PublisherMDnsSd::HandleServiceRegisterResult(DNSServiceRef         aService,
@@ -289,6 +318,7 @@ void PublisherMDnsSd::HandleServiceRegisterResult(DNSServiceRef         aService
         {
             otbrLog(OTBR_LOG_INFO, "MDNS added service %s", aName);
             RecordService(aName, aType, aServiceRef);
+            HandlePublished(aName, aType, OTBR_ERROR_NONE);
         }
         else
         {
@@ -300,6 +330,7 @@ void PublisherMDnsSd::HandleServiceRegisterResult(DNSServiceRef         aService
     {
         otbrLog(OTBR_LOG_ERR, "Failed to register service %s: %s", aName, DNSErrorToString(aError));
         DiscardService(aName, aType, aServiceRef);
+        HandlePublished(aName, aType, OTBR_ERROR_MDNS);
     }
 }
 
@@ -320,9 +351,13 @@ void PublisherMDnsSd::DiscardService(const char *aName, const char *aType, DNSSe
     assert(aServiceRef == NULL);
 }
 
-void PublisherMDnsSd::RecordService(const char *aName, const char *aType, DNSServiceRef aServiceRef)
+PublisherMDnsSd::Service &PublisherMDnsSd::RecordService(const char *  aName,
+                                                         const char *  aType,
+                                                         DNSServiceRef aServiceRef)
 {
-    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    Services::iterator it;
+
+    for (it = mServices.begin(); it != mServices.end(); ++it)
     {
         if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)))
         {
@@ -337,84 +372,337 @@ void PublisherMDnsSd::RecordService(const char *aName, const char *aType, DNSSer
         strcpy_safe(service.mName, sizeof(service.mName), aName);
         strcpy_safe(service.mType, sizeof(service.mType), aType);
         service.mService = aServiceRef;
-        mServices.push_back(service);
+        it               = mServices.insert(mServices.end(), service);
     }
 
 exit:
-    return;
+    return *it;
 }
 
-otbrError PublisherMDnsSd::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+otbrError PublisherMDnsSd::BeginServices(void)
 {
-    otbrError     ret   = OTBR_ERROR_NONE;
-    int           error = 0;
-    va_list       args;
-    uint8_t       txt[kMaxSizeOfTxtRecord];
-    uint8_t *     cur        = txt;
-    DNSServiceRef serviceRef = NULL;
+    otbrError ret = OTBR_ERROR_NONE;
 
-    va_start(args, aType);
+    VerifyOrExit(mState == kStateReady, errno = EAGAIN, ret = OTBR_ERROR_ERRNO);
+    ret = Connect();
 
-    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
-    {
-        const char * value        = va_arg(args, const char *);
-        const size_t nameLength   = strlen(name);
-        const size_t valueLength  = strlen(value);
-        size_t       recordLength = nameLength + 1 + valueLength;
+exit:
+    return ret;
+}
 
-        assert(nameLength > 0 && valueLength > 0 && recordLength < kMaxTextRecordSize);
+otbrError PublisherMDnsSd::Connect(void)
+{
+    otbrError ret   = OTBR_ERROR_NONE;
+    int       error = kDNSServiceErr_NoError;
 
-        if (cur + recordLength >= txt + sizeof(txt))
-        {
-            otbrLog(OTBR_LOG_WARNING, "Skip text record too much long: %s=%s", name, value);
-            continue;
-        }
+    VerifyOrExit(mConnection == NULL);
 
-        assert(recordLength <= 255);
-        cur[0] = static_cast<uint8_t>(recordLength);
-        cur += 1;
+    // All services and browsers share one connection to the daemon instead of opening a socket for each.
+    error = DNSServiceCreateConnection(&mConnection);
 
-        memcpy(cur, name, nameLength);
-        cur += nameLength;
+    if (error != kDNSServiceErr_NoError)
+    {
+        ret         = OTBR_ERROR_MDNS;
+        mConnection = NULL;
+        otbrLog(OTBR_LOG_ERR, "Failed to connect to mdnssd: %s!", DNSErrorToString(error));
+    }
 
-        cur[0] = '=';
-        cur += 1;
+exit:
+    return ret;
+}
 
-        memcpy(cur, value, valueLength);
-        cur += valueLength;
-    }
+otbrError PublisherMDnsSd::AddService(uint16_t       aPort,
+                                      const char *   aName,
+                                      const char *   aType,
+                                      const uint8_t *aTxtData,
+                                      uint16_t       aTxtLength)
+{
+    otbrError     ret        = OTBR_ERROR_NONE;
+    int           error      = 0;
+    DNSServiceRef serviceRef = mConnection;
 
-    va_end(args);
+    VerifyOrExit(mConnection != NULL, errno = EAGAIN, ret = OTBR_ERROR_ERRNO);
 
     for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
     {
         if (!strncmp(it->mName, aName, sizeof(it->mName)) && !strncmp(it->mType, aType, sizeof(it->mType)))
         {
-            otbrLog(OTBR_LOG_INFO, "MDNS remove current service %s", aName);
-            DNSServiceUpdateRecord(it->mService, NULL, 0, static_cast<uint16_t>(cur - txt), txt, 0);
+            if (it->mTxtRecord.Equals(aTxtData, aTxtLength))
+            {
+                otbrLog(OTBR_LOG_DEBUG, "MDNS service %s unchanged", aName);
+                ExitNow();
+            }
+
+            otbrLog(OTBR_LOG_INFO, "MDNS update service %s", aName);
+            SuccessOrExit(error = DNSServiceUpdateRecord(it->mService, NULL, 0, aTxtLength, aTxtData, 0));
+            it->mTxtRecord.SetData(aTxtData, aTxtLength);
+            // The daemon has no callback for updated records, its reply to the request is the acknowledgement.
+            HandlePublished(aName, aType, OTBR_ERROR_NONE);
             ExitNow();
         }
     }
 
-    SuccessOrExit(error = DNSServiceRegister(&serviceRef, 0, kDNSServiceInterfaceIndexAny, aName, aType, mDomain, mHost,
-                                             htons(aPort), static_cast<uint16_t>(cur - txt), txt,
-                                             HandleServiceRegisterResult, this));
-    if (serviceRef != NULL)
+    SuccessOrExit(error = DNSServiceRegister(&serviceRef, kDNSServiceFlagsShareConnection,
+                                             kDNSServiceInterfaceIndexAny, aName, aType, mDomain, mHost, htons(aPort),
+                                             aTxtLength, aTxtData, HandleServiceRegisterResult, this));
+    RecordService(aName, aType, serviceRef).mTxtRecord.SetData(aTxtData, aTxtLength);
+
+exit:
+
+    if (error != kDNSServiceErr_NoError)
+    {
+        ret = OTBR_ERROR_MDNS;
+        otbrLog(OTBR_LOG_ERR, "Failed to publish service for mdnssd error: %s!", DNSErrorToString(error));
+    }
+
+    return ret;
+}
+
+otbrError PublisherMDnsSd::CommitServices(void)
+{
+    // Each request is written to the shared connection as it is added, results arrive through Process().
+    return OTBR_ERROR_NONE;
+}
+
+otbrError PublisherMDnsSd::StartBrowse(const char *aType)
+{
+    otbrError     ret        = OTBR_ERROR_NONE;
+    int           error      = kDNSServiceErr_NoError;
+    DNSServiceRef serviceRef = NULL;
+    Browser       browser;
+
+    VerifyOrExit(mState == kStateReady, errno = EAGAIN, ret = OTBR_ERROR_ERRNO);
+
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end(); ++it)
     {
-        RecordService(aName, aType, serviceRef);
+        VerifyOrExit(it->mType != aType);
     }
 
+    SuccessOrExit(ret = Connect());
+    serviceRef = mConnection;
+
+    SuccessOrExit(error = DNSServiceBrowse(&serviceRef, kDNSServiceFlagsShareConnection, kDNSServiceInterfaceIndexAny,
+                                           aType, mDomain, HandleBrowseResult, this));
+
+    browser.mType    = aType;
+    browser.mService = serviceRef;
+    mBrowsers.push_back(browser);
+
 exit:
 
     if (error != kDNSServiceErr_NoError)
     {
         ret = OTBR_ERROR_MDNS;
-        otbrLog(OTBR_LOG_ERR, "Failed to publish service for mdnssd error: %s!", DNSErrorToString(error));
+        otbrLog(OTBR_LOG_ERR, "Failed to browse %s: %s!", aType, DNSErrorToString(error));
     }
 
     return ret;
 }
 
+void PublisherMDnsSd::StopBrowse(const char *aType)
+{
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end();)
+    {
+        if (it->mType == aType)
+        {
+            DNSServiceRefDeallocate(it->mService);
+            it = mBrowsers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end();)
+    {
+        if (it->mType == aType)
+        {
+            DNSServiceRefDeallocate(it->mService);
+            it = mResolvers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void PublisherMDnsSd::StartResolve(const ServiceCache::Instance &aInstance)
+{
+    int           error      = kDNSServiceErr_NoError;
+    DNSServiceRef serviceRef = mConnection;
+    Resolver      resolver;
+
+    VerifyOrExit(mConnection != NULL);
+
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        VerifyOrExit(it->mName != aInstance.mName || it->mType != aInstance.mType);
+    }
+
+    SuccessOrExit(error = DNSServiceResolve(&serviceRef, kDNSServiceFlagsShareConnection, kDNSServiceInterfaceIndexAny,
+                                            aInstance.mName.c_str(), aInstance.mType.c_str(),
+                                            aInstance.mDomain.c_str(), HandleResolveResult, this));
+
+    resolver.mName    = aInstance.mName;
+    resolver.mType    = aInstance.mType;
+    resolver.mService = serviceRef;
+    mResolvers.push_back(resolver);
+
+exit:
+
+    if (error != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to resolve %s: %s!", aInstance.mName.c_str(), DNSErrorToString(error));
+    }
+}
+
+void PublisherMDnsSd::StopResolve(const ServiceCache::Instance &aInstance)
+{
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        if (it->mName == aInstance.mName && it->mType == aInstance.mType)
+        {
+            DNSServiceRefDeallocate(it->mService);
+            mResolvers.erase(it);
+            break;
+        }
+    }
+}
+
+void PublisherMDnsSd::ResetBrowsers(void)
+{
+    for (Resolvers::iterator it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        DNSServiceRefDeallocate(it->mService);
+    }
+
+    for (Browsers::iterator it = mBrowsers.begin(); it != mBrowsers.end(); ++it)
+    {
+        DNSServiceRefDeallocate(it->mService);
+    }
+
+    mResolvers.clear();
+    mBrowsers.clear();
+    mServiceCache.ClearInstances();
+}
+
+void PublisherMDnsSd::HandleBrowseResult(DNSServiceRef       aServiceRef,
+                                         DNSServiceFlags     aFlags,
+                                         uint32_t            aInterfaceIndex,
+                                         DNSServiceErrorType aError,
+                                         const char *        aName,
+                                         const char *        aType,
+                                         const char *        aDomain,
+                                         void *              aContext)
+{
+    (void)aServiceRef;
+    (void)aInterfaceIndex;
+
+    static_cast<PublisherMDnsSd *>(aContext)->HandleBrowseResult(aFlags, aError, aName, aType, aDomain);
+}
+
+void PublisherMDnsSd::HandleBrowseResult(DNSServiceFlags     aFlags,
+                                         DNSServiceErrorType aError,
+                                         const char *        aName,
+                                         const char *        aType,
+                                         const char *        aDomain)
+{
+    if (aError != kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_ERR, "Browser failed: %s!", DNSErrorToString(aError));
+        ExitNow();
+    }
+
+    // Services published by this host are known already.
+    for (Services::iterator it = mServices.begin(); it != mServices.end(); ++it)
+    {
+        VerifyOrExit(strncmp(it->mName, aName, sizeof(it->mName)));
+    }
+
+    if (aFlags & kDNSServiceFlagsAdd)
+    {
+        otbrLog(OTBR_LOG_INFO, "MDNS found service %s.%s", aName, aType);
+
+        if (mServiceCache.AddInstance(aName, aType, aDomain, GetMainloopNow()))
+        {
+            StartResolve(*mServiceCache.FindInstance(aName, aType));
+        }
+    }
+    else
+    {
+        const ServiceCache::Instance *instance = mServiceCache.FindInstance(aName, aType);
+
+        VerifyOrExit(instance != NULL);
+        otbrLog(OTBR_LOG_INFO, "MDNS lost service %s.%s", aName, aType);
+        StopResolve(*instance);
+        mServiceCache.RemoveInstance(aName, aType);
+    }
+
+exit:
+    return;
+}
+
+void PublisherMDnsSd::HandleResolveResult(DNSServiceRef        aServiceRef,
+                                          DNSServiceFlags      aFlags,
+                                          uint32_t             aInterfaceIndex,
+                                          DNSServiceErrorType  aError,
+                                          const char *         aFullName,
+                                          const char *         aHostTarget,
+                                          uint16_t             aPort,
+                                          uint16_t             aTxtLength,
+                                          const unsigned char *aTxtRecord,
+                                          void *               aContext)
+{
+    (void)aFlags;
+    (void)aInterfaceIndex;
+    (void)aFullName;
+
+    static_cast<PublisherMDnsSd *>(aContext)->HandleResolveResult(aServiceRef, aError, aHostTarget, aPort, aTxtLength,
+                                                                  aTxtRecord);
+}
+
+void PublisherMDnsSd::HandleResolveResult(DNSServiceRef        aServiceRef,
+                                          DNSServiceErrorType  aError,
+                                          const char *         aHostTarget,
+                                          uint16_t             aPort,
+                                          uint16_t             aTxtLength,
+                                          const unsigned char *aTxtRecord)
+{
+    Resolvers::iterator it;
+
+    for (it = mResolvers.begin(); it != mResolvers.end(); ++it)
+    {
+        if (it->mService == aServiceRef)
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(it != mResolvers.end());
+
+    if (aError == kDNSServiceErr_NoError)
+    {
+        otbrLog(OTBR_LOG_INFO, "MDNS resolved service %s.%s at %s:%u", it->mName.c_str(), it->mType.c_str(),
+                aHostTarget, ntohs(aPort));
+        mServiceCache.UpdateInstance(it->mName.c_str(), it->mType.c_str(), aHostTarget, ntohs(aPort), aTxtRecord,
+                                     aTxtLength, ServiceCache::kDefaultTtl, GetMainloopNow());
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to resolve service %s.%s: %s!", it->mName.c_str(), it->mType.c_str(),
+                DNSErrorToString(aError));
+    }
+
+    // Resolving is one shot, the instance is resolved again when it expires.
+    DNSServiceRefDeallocate(aServiceRef);
+    mResolvers.erase(it);
+
+exit:
+    return;
+}
+
 Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
 {
     return new PublisherMDnsSd(aFamily, aHost, aDomain, aHandler, aContext);
@@ -34,6 +34,7 @@
 #ifndef OTBR_AGENT_MDNS_MDNSSD_HPP_
 #define OTBR_AGENT_MDNS_MDNSSD_HPP_
 
+#include <string>
 #include <vector>
 
 #include <dns_sd.h>
@@ -68,21 +69,44 @@ public:
     ~PublisherMDnsSd(void);
 
     /**
-     * This method publishes or updates a service.
+     * This method begins a batch of service publications, connecting to the daemon if not yet connected.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully began the batch.
+     * @retval  OTBR_ERROR_ERRNO    The publisher is not ready.
+     * @retval  OTBR_ERROR_MDNS     Failed to connect to the daemon.
+     *
+     */
+    otbrError BeginServices(void);
+
+    /**
+     * This method registers or updates a service on the shared connection.
      *
      * @note only text record can be updated.
      *
+     * @param[in]   aPort               The port number of this service.
      * @param[in]   aName               The name of this service.
      * @param[in]   aType               The type of this service.
-     * @param[in]   aPort               The port number of this service.
-     * @param[in]   ...                 Pointers to null-terminated string of key and value for text record.
-     *                                  The last argument must be NULL.
+     * @param[in]   aTxtData            A pointer to the TXT data encoded as length-prefixed strings.
+     * @param[in]   aTxtLength          The length of @p aTxtData.
      *
-     * @retval  OTBR_ERROR_NONE     Successfully published or updated the service.
-     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update the service.
+     * @retval  OTBR_ERROR_NONE     Successfully added the service.
+     * @retval  OTBR_ERROR_ERRNO    No batch has been begun.
+     * @retval  OTBR_ERROR_MDNS     The daemon rejected the service.
      *
      */
-    otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...);
+    otbrError AddService(uint16_t       aPort,
+                         const char *   aName,
+                         const char *   aType,
+                         const uint8_t *aTxtData,
+                         uint16_t       aTxtLength);
+
+    /**
+     * This method commits the services of the current batch.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully committed the services.
+     *
+     */
+    otbrError CommitServices(void);
 
     /**
      * This method starts the MDNS service.
@@ -131,8 +155,50 @@ public:
     void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
 
 private:
-    void DiscardService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
-    void RecordService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
+    struct Service;
+
+    otbrError Connect(void);
+    void      Disconnect(void);
+    void      Reconnect(void);
+    otbrError StartBrowse(const char *aType);
+    void      StopBrowse(const char *aType);
+    void      StartResolve(const ServiceCache::Instance &aInstance);
+    void      StopResolve(const ServiceCache::Instance &aInstance);
+    void      ResetBrowsers(void);
+
+    static void HandleBrowseResult(DNSServiceRef       aServiceRef,
+                                   DNSServiceFlags     aFlags,
+                                   uint32_t            aInterfaceIndex,
+                                   DNSServiceErrorType aError,
+                                   const char *        aName,
+                                   const char *        aType,
+                                   const char *        aDomain,
+                                   void *              aContext);
+    void        HandleBrowseResult(DNSServiceFlags     aFlags,
+                                   DNSServiceErrorType aError,
+                                   const char *        aName,
+                                   const char *        aType,
+                                   const char *        aDomain);
+
+    static void HandleResolveResult(DNSServiceRef        aServiceRef,
+                                    DNSServiceFlags      aFlags,
+                                    uint32_t             aInterfaceIndex,
+                                    DNSServiceErrorType  aError,
+                                    const char *         aFullName,
+                                    const char *         aHostTarget,
+                                    uint16_t             aPort,
+                                    uint16_t             aTxtLength,
+                                    const unsigned char *aTxtRecord,
+                                    void *               aContext);
+    void        HandleResolveResult(DNSServiceRef        aServiceRef,
+                                    DNSServiceErrorType  aError,
+                                    const char *         aHostTarget,
+                                    uint16_t             aPort,
+                                    uint16_t             aTxtLength,
+                                    const unsigned char *aTxtRecord);
+
+    void     DiscardService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
+    Service &RecordService(const char *aName, const char *aType, DNSServiceRef aServiceRef);
 
     static void HandleServiceRegisterResult(DNSServiceRef         aService,
                                             const DNSServiceFlags aFlags,
@@ -150,12 +216,10 @@ private:
 
     enum
     {
-        kMaxSizeOfTxtRecord   = 128,
         kMaxSizeOfServiceName = kDNSServiceMaxServiceName,
         kMaxSizeOfHost        = 128,
         kMaxSizeOfDomain      = kDNSServiceMaxDomainName,
         kMaxSizeOfServiceType = 64,
-        kMaxTextRecordSize    = 255,
     };
 
     struct Service
@@ -163,16 +227,36 @@ private:
         char          mName[kMaxSizeOfServiceName];
         char          mType[kMaxSizeOfServiceType];
         DNSServiceRef mService;
+        TxtRecord     mTxtRecord; ///< The TXT record last published.
     };
 
     typedef std::vector<Service> Services;
 
-    Services     mServices;
-    const char * mHost;
-    const char * mDomain;
-    State        mState;
-    StateHandler mStateHandler;
-    void *       mContext;
+    struct Browser
+    {
+        std::string   mType;
+        DNSServiceRef mService;
+    };
+
+    struct Resolver
+    {
+        std::string   mName;
+        std::string   mType;
+        DNSServiceRef mService;
+    };
+
+    typedef std::vector<Browser>  Browsers;
+    typedef std::vector<Resolver> Resolvers;
+
+    Services      mServices;
+    Browsers      mBrowsers;
+    Resolvers     mResolvers;
+    DNSServiceRef mConnection;
+    const char *  mHost;
+    const char *  mDomain;
+    State         mState;
+    StateHandler  mStateHandler;
+    void *        mContext;
 };
 
 /**
@@ -31,6 +31,11 @@
  *   This file includes implementation for MDNS service based on mojo.
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_MDNS
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include <base/at_exit.h>
@@ -114,10 +119,18 @@ void MdnsMojoPublisher::TearDownMojoThreads(void)
 
 MdnsMojoPublisher::MdnsMojoPublisher(StateHandler aHandler, void *aContext)
     : mConnector(nullptr)
+    , mDrainPosted(false)
+    , mEventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
     , mStateHandler(aHandler)
     , mContext(aContext)
     , mStarted(false)
 {
+    memset(&mMetrics, 0, sizeof(mMetrics));
+
+    if (mEventFd < 0)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to create eventfd: %s", strerror(errno));
+    }
 }
 
 void MdnsMojoPublisher::ConnectToMojo(void)
@@ -210,48 +223,177 @@ void MdnsMojoPublisher::StopPublishTask(void)
     mPublishedServices.clear();
 }
 
-otbrError MdnsMojoPublisher::PublishService(uint16_t aPort, const char *aName, const char *aType, ...)
+otbrError MdnsMojoPublisher::BeginServices(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mConnector != nullptr, error = OTBR_ERROR_MDNS);
+    mPendingServices.clear();
+
+exit:
+    return error;
+}
+
+otbrError MdnsMojoPublisher::AddService(uint16_t       aPort,
+                                        const char *   aName,
+                                        const char *   aType,
+                                        const uint8_t *aTxtData,
+                                        uint16_t       aTxtLength)
 {
-    otbrError                error = OTBR_ERROR_NONE;
-    std::vector<std::string> text;
-    va_list                  args;
+    otbrError      error = OTBR_ERROR_NONE;
+    PendingService service;
+
+    VerifyOrExit(mConnector != nullptr, error = OTBR_ERROR_MDNS);
+
+    service.mPort         = aPort;
+    service.mType         = aType;
+    service.mInstanceName = aName;
+
+    for (uint16_t offset = 0; offset < aTxtLength;)
+    {
+        uint8_t size = aTxtData[offset++];
+
+        VerifyOrExit(offset + size <= aTxtLength, error = OTBR_ERROR_MDNS);
+        service.mText.emplace_back(reinterpret_cast<const char *>(aTxtData + offset), size);
+        offset += size;
+    }
+
+    mPendingServices.emplace_back(std::move(service));
+
+exit:
+    return error;
+}
 
-    va_start(args, aType);
+otbrError MdnsMojoPublisher::CommitServices(void)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    bool      post  = false;
 
     VerifyOrExit(mConnector != nullptr, error = OTBR_ERROR_MDNS);
-    for (const char *name = va_arg(args, const char *); name; name = va_arg(args, const char *))
+    VerifyOrExit(!mPendingServices.empty());
+
     {
-        const char *value = va_arg(args, const char *);
+        std::lock_guard<std::mutex> lock(mQueueLock);
+
+        for (PendingService &service : mPendingServices)
+        {
+            std::vector<PendingService>::iterator it;
+
+            for (it = mQueue.begin(); it != mQueue.end(); ++it)
+            {
+                if (it->mInstanceName == service.mInstanceName && it->mType == service.mType)
+                {
+                    break;
+                }
+            }
+
+            if (it != mQueue.end())
+            {
+                // Only the latest update of a service matters, keep the queuing time of the first one.
+                service.mQueuedTime = it->mQueuedTime;
+                *it                 = std::move(service);
+                ++mMetrics.mCoalesced;
+            }
+            else if (mQueue.size() < kMaxQueuedServices)
+            {
+                service.mQueuedTime = Clock::now();
+                mQueue.emplace_back(std::move(service));
+            }
+            else
+            {
+                otbrLog(OTBR_LOG_WARNING, "MDNS publish queue is full, dropping %s", service.mInstanceName.c_str());
+                ++mMetrics.mRejected;
+                errno = ENOBUFS;
+                error = OTBR_ERROR_ERRNO;
+            }
+        }
+
+        mMetrics.mQueueDepth = mQueue.size();
+
+        if (mMetrics.mQueueDepth > mMetrics.mMaxQueueDepth)
+        {
+            mMetrics.mMaxQueueDepth = mMetrics.mQueueDepth;
+        }
+
+        // A drain task already posted will pick up the new services as well.
+        post         = !mDrainPosted && !mQueue.empty();
+        mDrainPosted = mDrainPosted || post;
+    }
 
-        text.emplace_back(std::string(name) + "=" + std::string(value));
+    if (post)
+    {
+        mMojoTaskRunner->PostTask(FROM_HERE,
+                                  base::BindOnce(&MdnsMojoPublisher::DrainPublishQueue, base::Unretained(this)));
     }
-    mMojoTaskRunner->PostTask(FROM_HERE, base::BindOnce(&MdnsMojoPublisher::PublishServiceTask, base::Unretained(this),
-                                                        aPort, aType, aName, text));
 
 exit:
-    va_end(args);
+    mPendingServices.clear();
     return error;
 }
 
-void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort,
-                                           const std::string &             aType,
-                                           const std::string &             aInstanceName,
-                                           const std::vector<std::string> &aText)
+otbrError MdnsMojoPublisher::StartBrowse(const char *aType)
+{
+    // The chromecast mDNS responder interface only supports publishing.
+    otbrLog(OTBR_LOG_WARNING, "MDNS browsing %s is not supported", aType);
+    return OTBR_ERROR_MDNS;
+}
+
+void MdnsMojoPublisher::StopBrowse(const char *aType)
+{
+    (void)aType;
+}
+
+void MdnsMojoPublisher::StartResolve(const ServiceCache::Instance &aInstance)
 {
+    (void)aInstance;
+}
+
+void MdnsMojoPublisher::StopResolve(const ServiceCache::Instance &aInstance)
+{
+    (void)aInstance;
+}
+
+void MdnsMojoPublisher::DrainPublishQueue(void)
+{
+    std::vector<PendingService> services;
+
+    {
+        std::lock_guard<std::mutex> lock(mQueueLock);
+
+        services.swap(mQueue);
+        mDrainPosted = false;
+    }
+
+    for (const PendingService &service : services)
+    {
+        if (mConnector == nullptr)
+        {
+            CompletePublish(service.mInstanceName, service.mType, service.mQueuedTime, false);
+        }
+        else
+        {
+            PublishServiceTask(service);
+        }
+    }
+}
+
+void MdnsMojoPublisher::PublishServiceTask(const PendingService &aService)
+{
+    bool                   published = false;
     std::string            serviceName;
     std::string            serviceProtocol;
-    std::string::size_type split = aType.rfind('.');
+    std::string::size_type split     = aService.mType.rfind('.');
 
     // Remove the last trailing dot since the cast mdns will add one
-    if (split + 1 == aType.length())
+    if (split + 1 == aService.mType.length())
     {
-        split = aType.rfind('.', split - 1);
+        split = aService.mType.rfind('.', split - 1);
     }
 
     VerifyOrExit(split != std::string::npos);
 
-    serviceName     = aType.substr(0, split);
-    serviceProtocol = aType.substr(split + 1, std::string::npos);
+    serviceName     = aService.mType.substr(0, split);
+    serviceProtocol = aService.mType.substr(split + 1, std::string::npos);
 
     // Remove the last trailing dot since the cast mdns will add one
     if (serviceProtocol.back() == '.')
@@ -261,18 +403,59 @@ void MdnsMojoPublisher::PublishServiceTask(uint16_t                        aPort
 
     VerifyOrExit(!serviceName.empty() && !serviceProtocol.empty());
 
-    mResponder->UnregisterServiceInstance(serviceName, aInstanceName, base::DoNothing());
+    mResponder->UnregisterServiceInstance(serviceName, aService.mInstanceName, base::DoNothing());
 
     otbrLog(OTBR_LOG_INFO, "service name %s, protocol %s, instance %s", serviceName.c_str(), serviceProtocol.c_str(),
-            aInstanceName.c_str());
-    mResponder->RegisterServiceInstance(serviceName, serviceProtocol, aInstanceName, aPort, aText,
-                                        base::BindOnce([](chromecast::mojom::MdnsResult r) {
-                                            otbrLog(OTBR_LOG_INFO, "register result %d", static_cast<int32_t>(r));
-                                        }));
-    mPublishedServices.emplace_back(std::make_pair(serviceName, aInstanceName));
+            aService.mInstanceName.c_str());
+    mResponder->RegisterServiceInstance(serviceName, serviceProtocol, aService.mInstanceName, aService.mPort,
+                                        aService.mText,
+                                        base::BindOnce(&MdnsMojoPublisher::HandleRegisterResult, base::Unretained(this),
+                                                       aService.mInstanceName, aService.mType, aService.mQueuedTime));
+    mPublishedServices.emplace_back(std::make_pair(serviceName, aService.mInstanceName));
+    published = true;
 
 exit:
-    return;
+    if (!published)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Invalid service type %s", aService.mType.c_str());
+        CompletePublish(aService.mInstanceName, aService.mType, aService.mQueuedTime, false);
+    }
+}
+
+void MdnsMojoPublisher::HandleRegisterResult(const std::string &           aInstanceName,
+                                             const std::string &           aType,
+                                             Clock::time_point             aQueuedTime,
+                                             chromecast::mojom::MdnsResult aResult)
+{
+    otbrLog(OTBR_LOG_INFO, "register result %d", static_cast<int32_t>(aResult));
+    CompletePublish(aInstanceName, aType, aQueuedTime, aResult == chromecast::mojom::MdnsResult::SUCCESS);
+}
+
+void MdnsMojoPublisher::CompletePublish(const std::string &aInstanceName,
+                                        const std::string &aType,
+                                        Clock::time_point  aQueuedTime,
+                                        bool               aSucceeded)
+{
+    Completion completion;
+    uint64_t   event = 1;
+
+    completion.mInstanceName = aInstanceName;
+    completion.mType         = aType;
+    completion.mSucceeded    = aSucceeded;
+    completion.mLatency      = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - aQueuedTime).count());
+
+    {
+        std::lock_guard<std::mutex> lock(mQueueLock);
+
+        mCompletions.emplace_back(std::move(completion));
+    }
+
+    // Completions are handled on the main loop.
+    if (mEventFd >= 0 && write(mEventFd, &event, sizeof(event)) < 0)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to signal eventfd: %s", strerror(errno));
+    }
 }
 
 void MdnsMojoPublisher::UpdateFdSet(fd_set & aReadFdSet,
@@ -281,18 +464,66 @@ void MdnsMojoPublisher::UpdateFdSet(fd_set & aReadFdSet,
                                     int &    aMaxFd,
                                     timeval &aTimeout)
 {
-    (void)aReadFdSet;
     (void)aWriteFdSet;
     (void)aErrorFdSet;
-    (void)aMaxFd;
     (void)aTimeout;
+
+    VerifyOrExit(mEventFd >= 0);
+
+    FD_SET(mEventFd, &aReadFdSet);
+
+    if (mEventFd > aMaxFd)
+    {
+        aMaxFd = mEventFd;
+    }
+
+exit:
+    return;
 }
 
 void MdnsMojoPublisher::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
-    (void)aReadFdSet;
+    std::vector<Completion> completions;
+    uint64_t                events;
+
     (void)aWriteFdSet;
     (void)aErrorFdSet;
+
+    VerifyOrExit(mEventFd >= 0 && FD_ISSET(mEventFd, &aReadFdSet));
+    VerifyOrExit(read(mEventFd, &events, sizeof(events)) == sizeof(events));
+
+    {
+        std::lock_guard<std::mutex> lock(mQueueLock);
+
+        completions.swap(mCompletions);
+        mMetrics.mQueueDepth = mQueue.size();
+    }
+
+    for (const Completion &completion : completions)
+    {
+        if (completion.mSucceeded)
+        {
+            ++mMetrics.mCompleted;
+        }
+        else
+        {
+            otbrLog(OTBR_LOG_WARNING, "Failed to publish service %s", completion.mInstanceName.c_str());
+            ++mMetrics.mFailed;
+        }
+
+        HandlePublished(completion.mInstanceName.c_str(), completion.mType.c_str(),
+                        completion.mSucceeded ? OTBR_ERROR_NONE : OTBR_ERROR_MDNS);
+
+        mMetrics.mLastLatency = completion.mLatency;
+
+        if (completion.mLatency > mMetrics.mMaxLatency)
+        {
+            mMetrics.mMaxLatency = completion.mLatency;
+        }
+    }
+
+exit:
+    return;
 }
 
 MdnsMojoPublisher::~MdnsMojoPublisher()
@@ -301,6 +532,11 @@ MdnsMojoPublisher::~MdnsMojoPublisher()
                               base::BindOnce(&MdnsMojoPublisher::TearDownMojoThreads, base::Unretained(this)));
 
     mMojoCoreThread->join();
+
+    if (mEventFd >= 0)
+    {
+        close(mEventFd);
+    }
 }
 
 Publisher *Publisher::Create(int aFamily, const char *aHost, const char *aDomain, StateHandler aHandler, void *aContext)
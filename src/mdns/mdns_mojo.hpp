@@ -49,7 +49,9 @@
 #include <mojo/public/cpp/bindings/remote.h>
 #endif
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -74,6 +76,22 @@ namespace Mdns {
 class MdnsMojoPublisher : public Publisher
 {
 public:
+    /**
+     * This structure contains the metrics of service publications.
+     *
+     */
+    struct PublishMetrics
+    {
+        uint32_t mQueueDepth;    ///< The number of publications waiting for the mojo thread.
+        uint32_t mMaxQueueDepth; ///< The maximum number of publications waiting for the mojo thread.
+        uint32_t mCoalesced;     ///< The number of publications merged into a queued one of the same service.
+        uint32_t mRejected;      ///< The number of publications rejected because the queue was full.
+        uint32_t mCompleted;     ///< The number of publications completed successfully.
+        uint32_t mFailed;        ///< The number of publications failed.
+        uint32_t mLastLatency;   ///< The latency in milliseconds from queuing to completion of the last publication.
+        uint32_t mMaxLatency;    ///< The maximum latency in milliseconds from queuing to completion.
+    };
+
     /**
      * The constructor to MdnsMojoPublisher
      *
@@ -109,20 +127,52 @@ public:
     bool IsStarted(void) const override;
 
     /**
-     * This method publishes or updates a service.
+     * This method begins a batch of service publications.
      *
+     * @retval  OTBR_ERROR_NONE     Successfully began the batch.
+     * @retval  OTBR_ERROR_MDNS     Not connected to mojo.
+     *
+     */
+    otbrError BeginServices(void) override;
+
+    /**
+     * This method adds a service to publish or update to the current batch.
+     *
+     * @param[in]   aPort               The port number of this service.
      * @param[in]   aName               The name of this service.
      * @param[in]   aType               The type of this service.
-     * @param[in]   aPort               The port number of this service.
-     * @param[in]   ...                 Pointers to null-terminated string of key
-     *                                  and value for text record.
-     *                                  The last argument must be NULL.
+     * @param[in]   aTxtData            A pointer to the TXT data encoded as
+     *                                  length-prefixed strings.
+     * @param[in]   aTxtLength          The length of @p aTxtData.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the service.
+     * @retval  OTBR_ERROR_MDNS     Not connected to mojo.
+     *
+     */
+    otbrError AddService(uint16_t       aPort,
+                         const char *   aName,
+                         const char *   aType,
+                         const uint8_t *aTxtData,
+                         uint16_t       aTxtLength) override;
+
+    /**
+     * This method queues all services of the current batch for the mojo
+     * thread. A service already queued is replaced with the new one.
      *
-     * @retval  OTBR_ERROR_NONE     Successfully published or updated the service.
-     * @retval  OTBR_ERROR_ERRNO    Failed to publish or update the service.
+     * @retval  OTBR_ERROR_NONE     Successfully committed the services.
+     * @retval  OTBR_ERROR_MDNS     Not connected to mojo.
+     * @retval  OTBR_ERROR_ERRNO    The queue is full, errno is set to ENOBUFS.
      *
      */
-    otbrError PublishService(uint16_t aPort, const char *aName, const char *aType, ...) override;
+    otbrError CommitServices(void) override;
+
+    /**
+     * This method returns the metrics of service publications.
+     *
+     * @returns A reference to the publication metrics.
+     *
+     */
+    const PublishMetrics &GetPublishMetrics(void) const { return mMetrics; }
 
     /**
      * This method performs the MDNS processing.
@@ -157,12 +207,43 @@ public:
     ~MdnsMojoPublisher(void) override;
 
 private:
-    static const int kMojoConnectRetrySeconds = 10;
+    static const int    kMojoConnectRetrySeconds = 10;
+    static const size_t kMaxQueuedServices       = 16; ///< The maximum number of services waiting for mojo thread.
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct PendingService
+    {
+        uint16_t                 mPort;
+        std::string              mType;
+        std::string              mInstanceName;
+        std::vector<std::string> mText;
+        Clock::time_point        mQueuedTime;
+    };
 
-    void PublishServiceTask(uint16_t                        aPort,
-                            const std::string &             aType,
-                            const std::string &             aInstanceName,
-                            const std::vector<std::string> &aText);
+    struct Completion
+    {
+        std::string mInstanceName;
+        std::string mType;
+        bool        mSucceeded;
+        uint32_t    mLatency;
+    };
+
+    otbrError StartBrowse(const char *aType) override;
+    void      StopBrowse(const char *aType) override;
+    void      StartResolve(const ServiceCache::Instance &aInstance) override;
+    void      StopResolve(const ServiceCache::Instance &aInstance) override;
+
+    void DrainPublishQueue(void);
+    void PublishServiceTask(const PendingService &aService);
+    void HandleRegisterResult(const std::string &           aInstanceName,
+                              const std::string &           aType,
+                              Clock::time_point             aQueuedTime,
+                              chromecast::mojom::MdnsResult aResult);
+    void CompletePublish(const std::string &aInstanceName,
+                         const std::string &aType,
+                         Clock::time_point  aQueuedTime,
+                         bool               aSucceeded);
 
     bool VerifyFileAccess(const char *aFile);
 
@@ -173,7 +254,6 @@ private:
     void ConnectToMojo(void);
     void mMojoConnectCb(std::unique_ptr<MOJO_CONNECTOR_NS::ExternalConnector> aConnector);
     void mMojoDisconnectedCb(void);
-    void mRegisterServiceCb(chromecast::mojom::MdnsResult aResult);
 
     scoped_refptr<base::SingleThreadTaskRunner>           mMojoTaskRunner;
     std::unique_ptr<std::thread>                          mMojoCoreThread;
@@ -187,6 +267,15 @@ private:
 #endif
 
     std::vector<std::pair<std::string, std::string>> mPublishedServices;
+    std::vector<PendingService>                      mPendingServices;
+
+    // The queue and completions are shared with the mojo thread and guarded by mQueueLock.
+    std::mutex                  mQueueLock;
+    std::vector<PendingService> mQueue;
+    std::vector<Completion>     mCompletions;
+    bool                        mDrainPosted;
+    int                         mEventFd; ///< Signals completions to the main loop.
+    PublishMetrics              mMetrics;
 
     StateHandler mStateHandler;
     void *       mContext;
@@ -30,44 +30,92 @@
 #define BYTE_ORDER_BIG_ENDIAN 1
 #endif
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_UBUS
+
 #include "openwrt/ubus/otubus.hpp"
 
-#include <mutex>
+#include <algorithm>
 
-#include <sys/eventfd.h>
+#include <arpa/inet.h>
 
 #include <openthread/commissioner.h>
 #include <openthread/thread.h>
 #include <openthread/thread_ftd.h>
 
 #include "agent/ncp_openthread.hpp"
+#include "common/byteswap.hpp"
 #include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/memory_stats.hpp"
+#include "common/time.hpp"
+#include "utils/hex.hpp"
+#include "utils/table_query.hpp"
+
+#ifndef OTBR_CONFIG_UBUS_RECONNECT_MIN_DELAY
+/**
+ * The delay in milliseconds before retrying a failed ubus reconnect, doubled on each failure.
+ *
+ */
+#define OTBR_CONFIG_UBUS_RECONNECT_MIN_DELAY 50
+#endif
+
+#ifndef OTBR_CONFIG_UBUS_RECONNECT_MAX_DELAY
+/**
+ * The max delay in milliseconds between the ubus reconnect attempts.
+ *
+ */
+#define OTBR_CONFIG_UBUS_RECONNECT_MAX_DELAY 5000
+#endif
+
+#ifndef OTBR_CONFIG_UBUS_EVENT_BACKLOG
+/**
+ * The max number of ubus events kept while disconnected, the oldest ones are dropped beyond.
+ *
+ */
+#define OTBR_CONFIG_UBUS_EVENT_BACKLOG 32
+#endif
+
+#ifndef OTBR_CONFIG_UBUS_EVENT_MAX_AGE
+/**
+ * The max age in milliseconds of a pending ubus event to replay, older ones are dropped.
+ *
+ */
+#define OTBR_CONFIG_UBUS_EVENT_MAX_AGE 60000
+#endif
 
 namespace otbr {
 namespace ubus {
 
 static UbusServer *sUbusServerInstance = NULL;
-static int         sUbusEfd            = -1;
 static void *      sJsonUri            = NULL;
-static int         sBufNum;
-static std::mutex *sNcpThreadMutex;
 
 const static int PANID_LENGTH     = 10;
 const static int XPANID_LENGTH    = 64;
 const static int MASTERKEY_LENGTH = 64;
 
 UbusServer::UbusServer(Ncp::ControllerOpenThread *aController)
-    : mIfFinishScan(false)
-    , mContext(nullptr)
+    : mContext(nullptr)
     , mSockPath(nullptr)
+    , mScanList(nullptr)
+    , mScanRequest(nullptr)
     , mController(aController)
-    , mSecond(0)
+    , mReconnectDelay(OTBR_CONFIG_UBUS_RECONNECT_MIN_DELAY)
+    , mDisconnectTime(0)
+    , mConnection(0)
 {
     memset(&mNetworkdataBuf, 0, sizeof(mNetworkdataBuf));
     memset(&mBuf, 0, sizeof(mBuf));
+    memset(&mScanBuf, 0, sizeof(mScanBuf));
+    memset(&mEventBuf, 0, sizeof(mEventBuf));
+    memset(&mRepliesFd, 0, sizeof(mRepliesFd));
+    memset(&mReconnectTimer, 0, sizeof(mReconnectTimer));
+    memset(&mConnectionCounters, 0, sizeof(mConnectionCounters));
+    mReconnectTimer.cb = UbusReconnTimer;
 
     blob_buf_init(&mBuf, 0);
     blob_buf_init(&mNetworkdataBuf, 0);
+    blob_buf_init(&mScanBuf, 0);
+    blob_buf_init(&mEventBuf, 0);
 }
 
 UbusServer &UbusServer::GetInstance(void)
@@ -78,8 +126,16 @@ UbusServer &UbusServer::GetInstance(void)
 void UbusServer::Initialize(Ncp::ControllerOpenThread *aController)
 {
     sUbusServerInstance = new UbusServer(aController);
-    otThreadSetReceiveDiagnosticGetCallback(aController->GetInstance(), &UbusServer::HandleDiagnosticGetResponse,
-                                            sUbusServerInstance);
+
+    if (sUbusServerInstance->mReplies.Init() != OTBR_ERROR_NONE)
+    {
+        perror("Failed to create eventfd for ubus");
+        exit(EXIT_FAILURE);
+    }
+
+    // The main loop is not running yet, the handler can be added from this thread.
+    aController->GetThreadHelper()->AddStateChangedHandler(
+        [](otChangedFlags aFlags) { GetInstance().HandleThreadStateChanged(aFlags); });
 }
 
 enum
@@ -95,6 +151,20 @@ enum
     ADD_JOINER_MAX,
 };
 
+enum
+{
+    JOINERS,
+    JOINERS_MAX,
+};
+
+enum
+{
+    JOINER_PSKD,
+    JOINER_EUI64,
+    JOINER_TIMEOUT,
+    JOINER_MAX,
+};
+
 enum
 {
     MASTERKEY,
@@ -106,6 +176,17 @@ enum
     MGMTSET_MAX,
 };
 
+enum
+{
+    NEIGHBOR_OFFSET,
+    NEIGHBOR_LIMIT,
+    NEIGHBOR_RLOC16,
+    NEIGHBOR_EXTADDRESS,
+    NEIGHBOR_MINLINKQUALITY,
+    NEIGHBOR_MAXLINKQUALITY,
+    NEIGHBOR_MAX,
+};
+
 static const struct blobmsg_policy setNetworknamePolicy[SET_NETWORK_MAX] = {
     [SETNETWORK] = {.name = "networkname", .type = BLOBMSG_TYPE_STRING},
 };
@@ -159,6 +240,16 @@ static const struct blobmsg_policy addJoinerPolicy[ADD_JOINER_MAX] = {
     [EUI64] = {.name = "eui64", .type = BLOBMSG_TYPE_STRING},
 };
 
+static const struct blobmsg_policy joinersPolicy[JOINERS_MAX] = {
+    [JOINERS] = {.name = "joiners", .type = BLOBMSG_TYPE_ARRAY},
+};
+
+static const struct blobmsg_policy joinerPolicy[JOINER_MAX] = {
+    [JOINER_PSKD]    = {.name = "pskd", .type = BLOBMSG_TYPE_STRING},
+    [JOINER_EUI64]   = {.name = "eui64", .type = BLOBMSG_TYPE_STRING},
+    [JOINER_TIMEOUT] = {.name = "timeout", .type = BLOBMSG_TYPE_INT32},
+};
+
 static const struct blobmsg_policy mgmtsetPolicy[MGMTSET_MAX] = {
     [MASTERKEY]   = {.name = "masterkey", .type = BLOBMSG_TYPE_STRING},
     [NETWORKNAME] = {.name = "networkname", .type = BLOBMSG_TYPE_STRING},
@@ -168,6 +259,15 @@ static const struct blobmsg_policy mgmtsetPolicy[MGMTSET_MAX] = {
     [PSKC]        = {.name = "pskc", .type = BLOBMSG_TYPE_STRING},
 };
 
+static const struct blobmsg_policy neighborPolicy[NEIGHBOR_MAX] = {
+    [NEIGHBOR_OFFSET]         = {.name = "offset", .type = BLOBMSG_TYPE_INT32},
+    [NEIGHBOR_LIMIT]          = {.name = "limit", .type = BLOBMSG_TYPE_INT32},
+    [NEIGHBOR_RLOC16]         = {.name = "rloc16", .type = BLOBMSG_TYPE_STRING},
+    [NEIGHBOR_EXTADDRESS]     = {.name = "extaddress", .type = BLOBMSG_TYPE_STRING},
+    [NEIGHBOR_MINLINKQUALITY] = {.name = "minlinkquality", .type = BLOBMSG_TYPE_INT32},
+    [NEIGHBOR_MAXLINKQUALITY] = {.name = "maxlinkquality", .type = BLOBMSG_TYPE_INT32},
+};
+
 static const struct ubus_method otbrMethods[] = {
     {"scan", &UbusServer::UbusScanHandler, 0, 0, NULL, 0},
     {"channel", &UbusServer::UbusChannelHandler, 0, 0, NULL, 0},
@@ -187,7 +287,7 @@ static const struct ubus_method otbrMethods[] = {
     {"setpskc", &UbusServer::UbusSetPskcHandler, 0, 0, setPskcPolicy, ARRAY_SIZE(setPskcPolicy)},
     {"threadstart", &UbusServer::UbusThreadStartHandler, 0, 0, NULL, 0},
     {"threadstop", &UbusServer::UbusThreadStopHandler, 0, 0, NULL, 0},
-    {"neighbor", &UbusServer::UbusNeighborHandler, 0, 0, NULL, 0},
+    {"neighbor", &UbusServer::UbusNeighborHandler, 0, 0, neighborPolicy, ARRAY_SIZE(neighborPolicy)},
     {"parent", &UbusServer::UbusParentHandler, 0, 0, NULL, 0},
     {"mode", &UbusServer::UbusModeHandler, 0, 0, NULL, 0},
     {"setmode", &UbusServer::UbusSetModeHandler, 0, 0, setModePolicy, ARRAY_SIZE(setModePolicy)},
@@ -209,7 +309,14 @@ static const struct ubus_method otbrMethods[] = {
     {"macfilterstate", &UbusServer::UbusMacfilterStateHandler, 0, 0, NULL, 0},
     {"macfilteraddr", &UbusServer::UbusMacfilterAddrHandler, 0, 0, NULL, 0},
     {"joineradd", &UbusServer::UbusJoinerAddHandler, 0, 0, addJoinerPolicy, ARRAY_SIZE(addJoinerPolicy)},
+    {"joinersadd", &UbusServer::UbusJoinersAddHandler, 0, 0, joinersPolicy, ARRAY_SIZE(joinersPolicy)},
+    {"joinersremove", &UbusServer::UbusJoinersRemoveHandler, 0, 0, joinersPolicy, ARRAY_SIZE(joinersPolicy)},
     {"mgmtset", &UbusServer::UbusMgmtsetHandler, 0, 0, mgmtsetPolicy, ARRAY_SIZE(mgmtsetPolicy)},
+    {"mainloopstats", &UbusServer::UbusMainloopStatsHandler, 0, 0, NULL, 0},
+    {"memorystats", &UbusServer::UbusMemoryStatsHandler, 0, 0, NULL, 0},
+    {"addresscache", &UbusServer::UbusAddressCacheHandler, 0, 0, NULL, 0},
+    {"connectionstats", &UbusServer::UbusConnectionStatsHandler, 0, 0, NULL, 0},
+    {"getall", &UbusServer::UbusGetAllHandler, 0, 0, NULL, 0},
 };
 
 static struct ubus_object_type otbrObjType = {"otbr_prog", 0, otbrMethods, ARRAY_SIZE(otbrMethods)};
@@ -220,45 +327,146 @@ static struct ubus_object otbr = {
     id : 0,
     path : NULL,
     type : &otbrObjType,
-    subscribe_cb : NULL,
+    subscribe_cb : UbusServer::HandleSubscribe,
     has_subscribers : false,
     methods : otbrMethods,
     n_methods : ARRAY_SIZE(otbrMethods),
 };
 
-void UbusServer::ProcessScan(void)
+void UbusServer::HandleActiveScanResult(otActiveScanResult *aResult, void *aContext)
 {
-    otError  error        = OT_ERROR_NONE;
-    uint32_t scanChannels = 0;
-    uint16_t scanDuration = 0;
+    static_cast<UbusServer *>(aContext)->HandleActiveScanResultDetail(aResult);
+}
+
+void UbusServer::OutputBytes(const uint8_t *aBytes, uint8_t aLength, char *aOutput, size_t aOutputSize)
+{
+    Utils::Bytes2Hex(aBytes, aLength, aOutput, aOutputSize, /* aLowerCase */ true);
+}
+
+void UbusServer::AppendResult(otError aError, struct ubus_context *aContext, struct ubus_request_data *aRequest)
+{
+    OT_UNUSED_VARIABLE(aContext);
+
+    blobmsg_add_u16(&mBuf, "Error", aError);
+    SetReply(aRequest, mBuf.head);
+}
+
+int UbusServer::PostRequest(struct ubus_context *     aContext,
+                            struct ubus_object *      aObj,
+                            struct ubus_request_data *aRequest,
+                            const char *              aMethod,
+                            struct blob_attr *        aMsg,
+                            RequestHandler            aHandler)
+{
+    return PostRequest(aContext, aRequest, aMsg,
+                       [this, aContext, aObj, aMethod, aHandler](struct ubus_request_data *aDeferred,
+                                                                 struct blob_attr *        aCopy) {
+                           (this->*aHandler)(aContext, aObj, aDeferred, aMethod, aCopy);
+                       });
+}
+
+int UbusServer::PostRequest(struct ubus_context *     aContext,
+                            struct ubus_object *      aObj,
+                            struct ubus_request_data *aRequest,
+                            const char *              aMethod,
+                            struct blob_attr *        aMsg,
+                            ActionHandler             aHandler,
+                            const char *              aAction)
+{
+    return PostRequest(aContext, aRequest, aMsg,
+                       [this, aContext, aObj, aMethod, aHandler, aAction](struct ubus_request_data *aDeferred,
+                                                                          struct blob_attr *        aCopy) {
+                           (this->*aHandler)(aContext, aObj, aDeferred, aMethod, aCopy, aAction);
+                       });
+}
+
+int UbusServer::PostRequest(struct ubus_context *     aContext,
+                            struct ubus_request_data *aRequest,
+                            struct blob_attr *        aMsg,
+                            const RequestTask &       aTask)
+{
+    int          rval    = UBUS_STATUS_OK;
+    UbusRequest *request = new UbusRequest();
+
+    // The message buffer is reused by libubus once the handler returns, the deferred handler works on a copy.
+    request->mMsg        = static_cast<struct blob_attr *>(blob_memdup(aMsg));
+    request->mReply      = NULL;
+    request->mConnection = mConnection;
+    request->mHeld       = false;
+    VerifyOrExit(request->mMsg != NULL, rval = UBUS_STATUS_UNKNOWN_ERROR);
+
+    ubus_defer_request(aContext, aRequest, request);
+
+    mController->Post([this, request, aTask]() {
+        {
+            MainloopStageTimer stageTimer(kMainloopStageUbusRequest);
+
+            aTask(request, request->mMsg);
+        }
+
+        if (!request->mHeld)
+        {
+            CompleteRequest(request);
+        }
+    });
+    request = NULL;
 
-    sNcpThreadMutex->lock();
-    SuccessOrExit(error = otLinkActiveScan(mController->GetInstance(), scanChannels, scanDuration,
-                                           &UbusServer::HandleActiveScanResult, this));
 exit:
-    sNcpThreadMutex->unlock();
-    return;
+    delete request;
+    return rval;
 }
 
-void UbusServer::HandleActiveScanResult(otActiveScanResult *aResult, void *aContext)
+void UbusServer::HoldRequest(struct ubus_request_data *aRequest)
 {
-    static_cast<UbusServer *>(aContext)->HandleActiveScanResultDetail(aResult);
+    static_cast<UbusRequest *>(aRequest)->mHeld = true;
 }
 
-void UbusServer::OutputBytes(const uint8_t *aBytes, uint8_t aLength, char *aOutput)
+void UbusServer::SetReply(struct ubus_request_data *aRequest, const struct blob_attr *aReply)
 {
-    char byte2char[5] = "";
-    for (int i = 0; i < aLength; i++)
-    {
-        sprintf(byte2char, "%02x", aBytes[i]);
-        strcat(aOutput, byte2char);
-    }
+    UbusRequest *request = static_cast<UbusRequest *>(aRequest);
+
+    free(request->mReply);
+    request->mReply = static_cast<struct blob_attr *>(blob_memdup(const_cast<struct blob_attr *>(aReply)));
 }
 
-void UbusServer::AppendResult(otError aError, struct ubus_context *aContext, struct ubus_request_data *aRequest)
+void UbusServer::CompleteRequest(struct ubus_request_data *aRequest)
 {
-    blobmsg_add_u16(&mBuf, "Error", aError);
-    ubus_send_reply(aContext, aRequest, mBuf.head);
+    UbusRequest *request = static_cast<UbusRequest *>(aRequest);
+
+    mReplies.Post([this, request]() {
+        // The peer of a request from a lost connection is unknown to the new one, its reply is dropped.
+        if (request->mConnection != mConnection || mDisconnectTime != 0)
+        {
+            std::lock_guard<std::mutex> lock(mConnectionCountersLock);
+
+            mConnectionCounters.mDroppedRequests++;
+        }
+        else
+        {
+            if (request->mReply != NULL)
+            {
+                ubus_send_reply(mContext, request, request->mReply);
+            }
+
+            ubus_complete_deferred_request(mContext, request, UBUS_STATUS_OK);
+        }
+
+        free(request->mReply);
+        free(request->mMsg);
+        delete request;
+    });
+}
+
+void UbusServer::HandleReplies(struct uloop_fd *aFd, unsigned int aEvents)
+{
+    OT_UNUSED_VARIABLE(aEvents);
+
+    fd_set readFdSet;
+
+    FD_ZERO(&readFdSet);
+    FD_SET(aFd->fd, &readFdSet);
+
+    GetInstance().mReplies.Process(readFdSet);
 }
 
 void UbusServer::HandleActiveScanResultDetail(otActiveScanResult *aResult)
@@ -268,32 +476,37 @@ void UbusServer::HandleActiveScanResultDetail(otActiveScanResult *aResult)
     char panidstring[PANID_LENGTH];
     char xpanidstring[XPANID_LENGTH] = "";
 
+    VerifyOrExit(mScanRequest != nullptr);
+
     if (aResult == NULL)
     {
-        blobmsg_close_array(&mBuf, sJsonUri);
-        mIfFinishScan = true;
-        goto exit;
+        blobmsg_close_array(&mScanBuf, mScanList);
+        blobmsg_add_u16(&mScanBuf, "Error", OT_ERROR_NONE);
+        SetReply(mScanRequest, mScanBuf.head);
+        CompleteRequest(mScanRequest);
+        mScanRequest = nullptr;
+        ExitNow();
     }
 
-    jsonList = blobmsg_open_table(&mBuf, NULL);
+    jsonList = blobmsg_open_table(&mScanBuf, NULL);
 
-    blobmsg_add_u32(&mBuf, "IsJoinable", aResult->mIsJoinable);
+    blobmsg_add_u32(&mScanBuf, "IsJoinable", aResult->mIsJoinable);
 
-    blobmsg_add_string(&mBuf, "NetworkName", aResult->mNetworkName.m8);
+    blobmsg_add_string(&mScanBuf, "NetworkName", aResult->mNetworkName.m8);
 
-    OutputBytes(aResult->mExtendedPanId.m8, OT_EXT_PAN_ID_SIZE, xpanidstring);
-    blobmsg_add_string(&mBuf, "ExtendedPanId", xpanidstring);
+    OutputBytes(aResult->mExtendedPanId.m8, OT_EXT_PAN_ID_SIZE, xpanidstring, sizeof(xpanidstring));
+    blobmsg_add_string(&mScanBuf, "ExtendedPanId", xpanidstring);
 
     sprintf(panidstring, "0x%04x", aResult->mPanId);
-    blobmsg_add_string(&mBuf, "PanId", panidstring);
+    blobmsg_add_string(&mScanBuf, "PanId", panidstring);
 
-    blobmsg_add_u32(&mBuf, "Channel", aResult->mChannel);
+    blobmsg_add_u32(&mScanBuf, "Channel", aResult->mChannel);
 
-    blobmsg_add_u32(&mBuf, "Rssi", aResult->mRssi);
+    blobmsg_add_u32(&mScanBuf, "Rssi", aResult->mRssi);
 
-    blobmsg_add_u32(&mBuf, "Lqi", aResult->mLqi);
+    blobmsg_add_u32(&mScanBuf, "Lqi", aResult->mLqi);
 
-    blobmsg_close_table(&mBuf, jsonList);
+    blobmsg_close_table(&mScanBuf, jsonList);
 
 exit:
     return;
@@ -305,7 +518,7 @@ int UbusServer::UbusScanHandler(struct ubus_context *     aContext,
                                 const char *              aMethod,
                                 struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusScanHandlerDetail(aContext, aObj, aRequest, aMethod, aMsg);
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusScanHandlerDetail);
 }
 
 int UbusServer::UbusScanHandlerDetail(struct ubus_context *     aContext,
@@ -318,31 +531,29 @@ int UbusServer::UbusScanHandlerDetail(struct ubus_context *     aContext,
     OT_UNUSED_VARIABLE(aMethod);
     OT_UNUSED_VARIABLE(aMsg);
 
-    otError  error = OT_ERROR_NONE;
-    uint64_t eventNum;
-    ssize_t  retval;
+    otError  error        = OT_ERROR_NONE;
+    uint32_t scanChannels = 0;
+    uint16_t scanDuration = 0;
+
+    VerifyOrExit(mScanRequest == nullptr, error = OT_ERROR_BUSY);
 
-    blob_buf_init(&mBuf, 0);
-    sJsonUri = blobmsg_open_array(&mBuf, "scan_list");
+    // Other requests reuse mBuf while the scan runs, the results are collected in their own buffer.
+    blob_buf_init(&mScanBuf, 0);
+    mScanList = blobmsg_open_array(&mScanBuf, "scan_list");
 
-    mIfFinishScan = 0;
-    sUbusServerInstance->ProcessScan();
+    SuccessOrExit(error = otLinkActiveScan(mController->GetInstance(), scanChannels, scanDuration,
+                                           &UbusServer::HandleActiveScanResult, this));
 
-    eventNum = 1;
-    retval   = write(sUbusEfd, &eventNum, sizeof(uint64_t));
-    if (retval != sizeof(uint64_t))
-    {
-        error = OT_ERROR_FAILED;
-        goto exit;
-    }
+    // The request is completed when the scan done callback arrives.
+    mScanRequest = static_cast<UbusRequest *>(aRequest);
+    HoldRequest(aRequest);
 
-    while (!mIfFinishScan)
+exit:
+    if (error != OT_ERROR_NONE)
     {
-        sleep(1);
+        blob_buf_init(&mBuf, 0);
+        AppendResult(error, aContext, aRequest);
     }
-
-exit:
-    AppendResult(error, aContext, aRequest);
     return 0;
 }
 
@@ -352,7 +563,8 @@ int UbusServer::UbusChannelHandler(struct ubus_context *     aContext,
                                    const char *              aMethod,
                                    struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "channel");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "channel");
 }
 
 int UbusServer::UbusSetChannelHandler(struct ubus_context *     aContext,
@@ -361,7 +573,28 @@ int UbusServer::UbusSetChannelHandler(struct ubus_context *     aContext,
                                       const char *              aMethod,
                                       struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "channel");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "channel");
+}
+
+int UbusServer::UbusJoinersAddHandler(struct ubus_context *     aContext,
+                                      struct ubus_object *      aObj,
+                                      struct ubus_request_data *aRequest,
+                                      const char *              aMethod,
+                                      struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusCommissioner,
+                                     "joinersadd");
+}
+
+int UbusServer::UbusJoinersRemoveHandler(struct ubus_context *     aContext,
+                                         struct ubus_object *      aObj,
+                                         struct ubus_request_data *aRequest,
+                                         const char *              aMethod,
+                                         struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusCommissioner,
+                                     "joinersremove");
 }
 
 int UbusServer::UbusJoinerNumHandler(struct ubus_context *     aContext,
@@ -370,7 +603,8 @@ int UbusServer::UbusJoinerNumHandler(struct ubus_context *     aContext,
                                      const char *              aMethod,
                                      struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "joinernum");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "joinernum");
 }
 
 int UbusServer::UbusNetworknameHandler(struct ubus_context *     aContext,
@@ -379,7 +613,8 @@ int UbusServer::UbusNetworknameHandler(struct ubus_context *     aContext,
                                        const char *              aMethod,
                                        struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "networkname");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "networkname");
 }
 
 int UbusServer::UbusSetNetworknameHandler(struct ubus_context *     aContext,
@@ -388,7 +623,8 @@ int UbusServer::UbusSetNetworknameHandler(struct ubus_context *     aContext,
                                           const char *              aMethod,
                                           struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "networkname");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "networkname");
 }
 
 int UbusServer::UbusStateHandler(struct ubus_context *     aContext,
@@ -397,7 +633,7 @@ int UbusServer::UbusStateHandler(struct ubus_context *     aContext,
                                  const char *              aMethod,
                                  struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "state");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation, "state");
 }
 
 int UbusServer::UbusRloc16Handler(struct ubus_context *     aContext,
@@ -406,7 +642,8 @@ int UbusServer::UbusRloc16Handler(struct ubus_context *     aContext,
                                   const char *              aMethod,
                                   struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "rloc16");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "rloc16");
 }
 
 int UbusServer::UbusPanIdHandler(struct ubus_context *     aContext,
@@ -415,7 +652,7 @@ int UbusServer::UbusPanIdHandler(struct ubus_context *     aContext,
                                  const char *              aMethod,
                                  struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "panid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation, "panid");
 }
 
 int UbusServer::UbusSetPanIdHandler(struct ubus_context *     aContext,
@@ -424,7 +661,7 @@ int UbusServer::UbusSetPanIdHandler(struct ubus_context *     aContext,
                                     const char *              aMethod,
                                     struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "panid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusSetInformation, "panid");
 }
 
 int UbusServer::UbusExtPanIdHandler(struct ubus_context *     aContext,
@@ -433,7 +670,8 @@ int UbusServer::UbusExtPanIdHandler(struct ubus_context *     aContext,
                                     const char *              aMethod,
                                     struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "extpanid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "extpanid");
 }
 
 int UbusServer::UbusSetExtPanIdHandler(struct ubus_context *     aContext,
@@ -442,7 +680,8 @@ int UbusServer::UbusSetExtPanIdHandler(struct ubus_context *     aContext,
                                        const char *              aMethod,
                                        struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "extpanid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "extpanid");
 }
 
 int UbusServer::UbusPskcHandler(struct ubus_context *     aContext,
@@ -451,7 +690,7 @@ int UbusServer::UbusPskcHandler(struct ubus_context *     aContext,
                                 const char *              aMethod,
                                 struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "pskc");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation, "pskc");
 }
 
 int UbusServer::UbusSetPskcHandler(struct ubus_context *     aContext,
@@ -460,7 +699,7 @@ int UbusServer::UbusSetPskcHandler(struct ubus_context *     aContext,
                                    const char *              aMethod,
                                    struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "pskc");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusSetInformation, "pskc");
 }
 
 int UbusServer::UbusMasterkeyHandler(struct ubus_context *     aContext,
@@ -469,7 +708,8 @@ int UbusServer::UbusMasterkeyHandler(struct ubus_context *     aContext,
                                      const char *              aMethod,
                                      struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "masterkey");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "masterkey");
 }
 
 int UbusServer::UbusSetMasterkeyHandler(struct ubus_context *     aContext,
@@ -478,7 +718,8 @@ int UbusServer::UbusSetMasterkeyHandler(struct ubus_context *     aContext,
                                         const char *              aMethod,
                                         struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "masterkey");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "masterkey");
 }
 
 int UbusServer::UbusThreadStartHandler(struct ubus_context *     aContext,
@@ -487,7 +728,7 @@ int UbusServer::UbusThreadStartHandler(struct ubus_context *     aContext,
                                        const char *              aMethod,
                                        struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusThreadHandler(aContext, aObj, aRequest, aMethod, aMsg, "start");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusThreadHandler, "start");
 }
 
 int UbusServer::UbusThreadStopHandler(struct ubus_context *     aContext,
@@ -496,7 +737,7 @@ int UbusServer::UbusThreadStopHandler(struct ubus_context *     aContext,
                                       const char *              aMethod,
                                       struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusThreadHandler(aContext, aObj, aRequest, aMethod, aMsg, "stop");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusThreadHandler, "stop");
 }
 
 int UbusServer::UbusParentHandler(struct ubus_context *     aContext,
@@ -505,7 +746,7 @@ int UbusServer::UbusParentHandler(struct ubus_context *     aContext,
                                   const char *              aMethod,
                                   struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusParentHandlerDetail(aContext, aObj, aRequest, aMethod, aMsg);
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusParentHandlerDetail);
 }
 
 int UbusServer::UbusNeighborHandler(struct ubus_context *     aContext,
@@ -514,7 +755,7 @@ int UbusServer::UbusNeighborHandler(struct ubus_context *     aContext,
                                     const char *              aMethod,
                                     struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusNeighborHandlerDetail(aContext, aObj, aRequest, aMethod, aMsg);
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusNeighborHandlerDetail);
 }
 
 int UbusServer::UbusModeHandler(struct ubus_context *     aContext,
@@ -523,7 +764,7 @@ int UbusServer::UbusModeHandler(struct ubus_context *     aContext,
                                 const char *              aMethod,
                                 struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "mode");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation, "mode");
 }
 
 int UbusServer::UbusSetModeHandler(struct ubus_context *     aContext,
@@ -532,7 +773,7 @@ int UbusServer::UbusSetModeHandler(struct ubus_context *     aContext,
                                    const char *              aMethod,
                                    struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "mode");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusSetInformation, "mode");
 }
 
 int UbusServer::UbusLeaderPartitionIdHandler(struct ubus_context *     aContext,
@@ -541,7 +782,8 @@ int UbusServer::UbusLeaderPartitionIdHandler(struct ubus_context *     aContext,
                                              const char *              aMethod,
                                              struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "leaderpartitionid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "leaderpartitionid");
 }
 
 int UbusServer::UbusSetLeaderPartitionIdHandler(struct ubus_context *     aContext,
@@ -550,7 +792,8 @@ int UbusServer::UbusSetLeaderPartitionIdHandler(struct ubus_context *     aConte
                                                 const char *              aMethod,
                                                 struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "leaderpartitionid");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "leaderpartitionid");
 }
 
 int UbusServer::UbusLeaveHandler(struct ubus_context *     aContext,
@@ -559,7 +802,7 @@ int UbusServer::UbusLeaveHandler(struct ubus_context *     aContext,
                                  const char *              aMethod,
                                  struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusLeaveHandlerDetail(aContext, aObj, aRequest, aMethod, aMsg);
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusLeaveHandlerDetail);
 }
 
 int UbusServer::UbusLeaderdataHandler(struct ubus_context *     aContext,
@@ -568,7 +811,8 @@ int UbusServer::UbusLeaderdataHandler(struct ubus_context *     aContext,
                                       const char *              aMethod,
                                       struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "leaderdata");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "leaderdata");
 }
 
 int UbusServer::UbusNetworkdataHandler(struct ubus_context *     aContext,
@@ -577,7 +821,8 @@ int UbusServer::UbusNetworkdataHandler(struct ubus_context *     aContext,
                                        const char *              aMethod,
                                        struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "networkdata");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusNetworkdataHandlerDetail);
 }
 
 int UbusServer::UbusCommissionerStartHandler(struct ubus_context *     aContext,
@@ -586,7 +831,7 @@ int UbusServer::UbusCommissionerStartHandler(struct ubus_context *     aContext,
                                              const char *              aMethod,
                                              struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusCommissioner(aContext, aObj, aRequest, aMethod, aMsg, "start");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusCommissioner, "start");
 }
 
 int UbusServer::UbusJoinerRemoveHandler(struct ubus_context *     aContext,
@@ -595,7 +840,8 @@ int UbusServer::UbusJoinerRemoveHandler(struct ubus_context *     aContext,
                                         const char *              aMethod,
                                         struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusCommissioner(aContext, aObj, aRequest, aMethod, aMsg, "joinerremove");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusCommissioner, "joinerremove");
 }
 
 int UbusServer::UbusMgmtsetHandler(struct ubus_context *     aContext,
@@ -604,7 +850,56 @@ int UbusServer::UbusMgmtsetHandler(struct ubus_context *     aContext,
                                    const char *              aMethod,
                                    struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusMgmtset(aContext, aObj, aRequest, aMethod, aMsg);
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusMgmtset);
+}
+
+int UbusServer::UbusMainloopStatsHandler(struct ubus_context *     aContext,
+                                         struct ubus_object *      aObj,
+                                         struct ubus_request_data *aRequest,
+                                         const char *              aMethod,
+                                         struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "mainloopstats");
+}
+
+int UbusServer::UbusConnectionStatsHandler(struct ubus_context *     aContext,
+                                           struct ubus_object *      aObj,
+                                           struct ubus_request_data *aRequest,
+                                           const char *              aMethod,
+                                           struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation,
+                                     "connectionstats");
+}
+
+int UbusServer::UbusMemoryStatsHandler(struct ubus_context *     aContext,
+                                       struct ubus_object *      aObj,
+                                       struct ubus_request_data *aRequest,
+                                       const char *              aMethod,
+                                       struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetInformation,
+                                     "memorystats");
+}
+
+int UbusServer::UbusAddressCacheHandler(struct ubus_context *     aContext,
+                                        struct ubus_object *      aObj,
+                                        struct ubus_request_data *aRequest,
+                                        const char *              aMethod,
+                                        struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "addresscache");
+}
+
+int UbusServer::UbusGetAllHandler(struct ubus_context *     aContext,
+                                  struct ubus_object *      aObj,
+                                  struct ubus_request_data *aRequest,
+                                  const char *              aMethod,
+                                  struct blob_attr *        aMsg)
+{
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg, &UbusServer::UbusGetAllHandlerDetail);
 }
 
 int UbusServer::UbusJoinerAddHandler(struct ubus_context *     aContext,
@@ -613,7 +908,8 @@ int UbusServer::UbusJoinerAddHandler(struct ubus_context *     aContext,
                                      const char *              aMethod,
                                      struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusCommissioner(aContext, aObj, aRequest, aMethod, aMsg, "joineradd");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusCommissioner, "joineradd");
 }
 
 int UbusServer::UbusMacfilterAddrHandler(struct ubus_context *     aContext,
@@ -622,7 +918,8 @@ int UbusServer::UbusMacfilterAddrHandler(struct ubus_context *     aContext,
                                          const char *              aMethod,
                                          struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfilteraddr");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "macfilteraddr");
 }
 
 int UbusServer::UbusMacfilterStateHandler(struct ubus_context *     aContext,
@@ -631,7 +928,8 @@ int UbusServer::UbusMacfilterStateHandler(struct ubus_context *     aContext,
                                           const char *              aMethod,
                                           struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusGetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfilterstate");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusGetInformation, "macfilterstate");
 }
 
 int UbusServer::UbusMacfilterAddHandler(struct ubus_context *     aContext,
@@ -640,7 +938,8 @@ int UbusServer::UbusMacfilterAddHandler(struct ubus_context *     aContext,
                                         const char *              aMethod,
                                         struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfilteradd");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "macfilteradd");
 }
 
 int UbusServer::UbusMacfilterRemoveHandler(struct ubus_context *     aContext,
@@ -649,7 +948,8 @@ int UbusServer::UbusMacfilterRemoveHandler(struct ubus_context *     aContext,
                                            const char *              aMethod,
                                            struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfilterremove");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "macfilterremove");
 }
 
 int UbusServer::UbusMacfilterSetStateHandler(struct ubus_context *     aContext,
@@ -658,7 +958,8 @@ int UbusServer::UbusMacfilterSetStateHandler(struct ubus_context *     aContext,
                                              const char *              aMethod,
                                              struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfiltersetstate");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "macfiltersetstate");
 }
 
 int UbusServer::UbusMacfilterClearHandler(struct ubus_context *     aContext,
@@ -667,7 +968,8 @@ int UbusServer::UbusMacfilterClearHandler(struct ubus_context *     aContext,
                                           const char *              aMethod,
                                           struct blob_attr *        aMsg)
 {
-    return GetInstance().UbusSetInformation(aContext, aObj, aRequest, aMethod, aMsg, "macfilterclear");
+    return GetInstance().PostRequest(aContext, aObj, aRequest, aMethod, aMsg,
+                                     &UbusServer::UbusSetInformation, "macfilterclear");
 }
 
 int UbusServer::UbusLeaveHandlerDetail(struct ubus_context *     aContext,
@@ -680,25 +982,11 @@ int UbusServer::UbusLeaveHandlerDetail(struct ubus_context *     aContext,
     OT_UNUSED_VARIABLE(aMethod);
     OT_UNUSED_VARIABLE(aMsg);
 
-    otError  error = OT_ERROR_NONE;
-    uint64_t eventNum;
-    ssize_t  retval;
+    otError error = OT_ERROR_NONE;
 
-    sNcpThreadMutex->lock();
     otInstanceFactoryReset(mController->GetInstance());
 
-    eventNum = 1;
-    retval   = write(sUbusEfd, &eventNum, sizeof(uint64_t));
-    if (retval != sizeof(uint64_t))
-    {
-        error = OT_ERROR_FAILED;
-        goto exit;
-    }
-
     blob_buf_init(&mBuf, 0);
-
-exit:
-    sNcpThreadMutex->unlock();
     AppendResult(error, aContext, aRequest);
     return 0;
 }
@@ -719,19 +1007,16 @@ int UbusServer::UbusThreadHandler(struct ubus_context *     aContext,
 
     if (!strcmp(aAction, "start"))
     {
-        sNcpThreadMutex->lock();
-        SuccessOrExit(error = otIp6SetEnabled(mController->GetInstance(), true));
+            SuccessOrExit(error = otIp6SetEnabled(mController->GetInstance(), true));
         SuccessOrExit(error = otThreadSetEnabled(mController->GetInstance(), true));
     }
     else if (!strcmp(aAction, "stop"))
     {
-        sNcpThreadMutex->lock();
-        SuccessOrExit(error = otThreadSetEnabled(mController->GetInstance(), false));
+            SuccessOrExit(error = otThreadSetEnabled(mController->GetInstance(), false));
         SuccessOrExit(error = otIp6SetEnabled(mController->GetInstance(), false));
     }
 
 exit:
-    sNcpThreadMutex->unlock();
     AppendResult(error, aContext, aRequest);
     return 0;
 }
@@ -755,7 +1040,6 @@ int UbusServer::UbusParentHandlerDetail(struct ubus_context *     aContext,
 
     blob_buf_init(&mBuf, 0);
 
-    sNcpThreadMutex->lock();
     SuccessOrExit(error = otThreadGetParentInfo(mController->GetInstance(), &parentInfo));
 
     jsonArray = blobmsg_open_array(&mBuf, "parent_list");
@@ -768,7 +1052,7 @@ int UbusServer::UbusParentHandlerDetail(struct ubus_context *     aContext,
     sprintf(transfer, "%3d", parentInfo.mAge);
     blobmsg_add_string(&mBuf, "Age", transfer);
 
-    OutputBytes(parentInfo.mExtAddress.m8, sizeof(parentInfo.mExtAddress.m8), extAddress);
+    OutputBytes(parentInfo.mExtAddress.m8, sizeof(parentInfo.mExtAddress.m8), extAddress, sizeof(extAddress));
     blobmsg_add_string(&mBuf, "ExtAddress", extAddress);
 
     blobmsg_add_u16(&mBuf, "LinkQualityIn", parentInfo.mLinkQualityIn);
@@ -777,7 +1061,6 @@ int UbusServer::UbusParentHandlerDetail(struct ubus_context *     aContext,
     blobmsg_close_array(&mBuf, jsonArray);
 
 exit:
-    sNcpThreadMutex->unlock();
     AppendResult(error, aContext, aRequest);
     return error;
 }
@@ -790,7 +1073,6 @@ int UbusServer::UbusNeighborHandlerDetail(struct ubus_context *     aContext,
 {
     OT_UNUSED_VARIABLE(aObj);
     OT_UNUSED_VARIABLE(aMethod);
-    OT_UNUSED_VARIABLE(aMsg);
 
     otError                error = OT_ERROR_NONE;
     otNeighborInfo         neighborInfo;
@@ -799,14 +1081,78 @@ int UbusServer::UbusNeighborHandlerDetail(struct ubus_context *     aContext,
     void *                 jsonList                  = NULL;
     char                   mode[5]                   = "";
     char                   extAddress[XPANID_LENGTH] = "";
+    struct blob_attr *     tb[NEIGHBOR_MAX];
+    TableQuery             query;
 
     blob_buf_init(&mBuf, 0);
 
+    // The filters and the page are applied while iterating, so only the selected neighbors are encoded.
+    blobmsg_parse(neighborPolicy, NEIGHBOR_MAX, tb, blob_data(aMsg), blob_len(aMsg));
+    if (tb[NEIGHBOR_OFFSET] != NULL || tb[NEIGHBOR_LIMIT] != NULL)
+    {
+        uint32_t offset = 0;
+        uint32_t limit  = 0;
+
+        if (tb[NEIGHBOR_OFFSET] != NULL)
+        {
+            offset = blobmsg_get_u32(tb[NEIGHBOR_OFFSET]);
+        }
+
+        if (tb[NEIGHBOR_LIMIT] != NULL)
+        {
+            limit = blobmsg_get_u32(tb[NEIGHBOR_LIMIT]);
+        }
+
+        query.SetPage(offset, limit);
+    }
+    if (tb[NEIGHBOR_RLOC16] != NULL)
+    {
+        long rloc16;
+
+        SuccessOrExit(error = ParseLong(blobmsg_get_string(tb[NEIGHBOR_RLOC16]), rloc16));
+        VerifyOrExit(rloc16 >= 0 && rloc16 <= UINT16_MAX, error = OT_ERROR_INVALID_ARGS);
+        query.SetRloc16(static_cast<uint16_t>(rloc16));
+    }
+    if (tb[NEIGHBOR_EXTADDRESS] != NULL)
+    {
+        otExtAddress addr;
+
+        VerifyOrExit(Utils::Hex2Bytes(blobmsg_get_string(tb[NEIGHBOR_EXTADDRESS]), addr.m8, sizeof(addr)) ==
+                         sizeof(addr),
+                     error = OT_ERROR_PARSE);
+        query.SetExtAddress(Encoding::BigEndian::ReadUint64(addr.m8));
+    }
+    if (tb[NEIGHBOR_MINLINKQUALITY] != NULL || tb[NEIGHBOR_MAXLINKQUALITY] != NULL)
+    {
+        uint32_t minLinkQuality = 0;
+        uint32_t maxLinkQuality = TableQuery::kMaxLinkQuality;
+
+        if (tb[NEIGHBOR_MINLINKQUALITY] != NULL)
+        {
+            minLinkQuality = blobmsg_get_u32(tb[NEIGHBOR_MINLINKQUALITY]);
+        }
+
+        if (tb[NEIGHBOR_MAXLINKQUALITY] != NULL)
+        {
+            maxLinkQuality = blobmsg_get_u32(tb[NEIGHBOR_MAXLINKQUALITY]);
+        }
+
+        VerifyOrExit(maxLinkQuality <= TableQuery::kMaxLinkQuality &&
+                         query.SetLinkQualityRange(static_cast<uint8_t>(minLinkQuality),
+                                                   static_cast<uint8_t>(maxLinkQuality)),
+                     error = OT_ERROR_INVALID_ARGS);
+    }
+
     sJsonUri = blobmsg_open_array(&mBuf, "neighbor_list");
 
-    sNcpThreadMutex->lock();
     while (otThreadGetNextNeighborInfo(mController->GetInstance(), &iterator, &neighborInfo) == OT_ERROR_NONE)
     {
+        if (!query.Select(neighborInfo.mRloc16, Encoding::BigEndian::ReadUint64(neighborInfo.mExtAddress.m8),
+                          neighborInfo.mLinkQualityIn))
+        {
+            continue;
+        }
+
         jsonList = blobmsg_open_table(&mBuf, NULL);
 
         blobmsg_add_string(&mBuf, "Role", neighborInfo.mIsChild ? "C" : "R");
@@ -844,7 +1190,7 @@ int UbusServer::UbusNeighborHandlerDetail(struct ubus_context *     aContext,
         }
         blobmsg_add_string(&mBuf, "Mode", mode);
 
-        OutputBytes(neighborInfo.mExtAddress.m8, sizeof(neighborInfo.mExtAddress.m8), extAddress);
+        OutputBytes(neighborInfo.mExtAddress.m8, sizeof(neighborInfo.mExtAddress.m8), extAddress, sizeof(extAddress));
         blobmsg_add_string(&mBuf, "ExtAddress", extAddress);
 
         blobmsg_add_u16(&mBuf, "LinkQualityIn", neighborInfo.mLinkQualityIn);
@@ -856,9 +1202,9 @@ int UbusServer::UbusNeighborHandlerDetail(struct ubus_context *     aContext,
     }
 
     blobmsg_close_array(&mBuf, sJsonUri);
+    blobmsg_add_u32(&mBuf, "Matched", query.GetMatched());
 
-    sNcpThreadMutex->unlock();
-
+exit:
     AppendResult(error, aContext, aRequest);
     return 0;
 }
@@ -886,8 +1232,8 @@ int UbusServer::UbusMgmtset(struct ubus_context *     aContext,
     if (tb[MASTERKEY] != NULL)
     {
         dataset.mComponents.mIsMasterKeyPresent = true;
-        VerifyOrExit((length = Hex2Bin(blobmsg_get_string(tb[MASTERKEY]), dataset.mMasterKey.m8,
-                                       sizeof(dataset.mMasterKey.m8))) == OT_MASTER_KEY_SIZE,
+        VerifyOrExit((length = Utils::Hex2Bytes(blobmsg_get_string(tb[MASTERKEY]), dataset.mMasterKey.m8,
+                                                sizeof(dataset.mMasterKey.m8))) == OT_MASTER_KEY_SIZE,
                      error = OT_ERROR_PARSE);
         length = 0;
     }
@@ -904,8 +1250,8 @@ int UbusServer::UbusMgmtset(struct ubus_context *     aContext,
     if (tb[EXTPANID] != NULL)
     {
         dataset.mComponents.mIsExtendedPanIdPresent = true;
-        VerifyOrExit(Hex2Bin(blobmsg_get_string(tb[EXTPANID]), dataset.mExtendedPanId.m8,
-                             sizeof(dataset.mExtendedPanId.m8)) >= 0,
+        VerifyOrExit(Utils::Hex2Bytes(blobmsg_get_string(tb[EXTPANID]), dataset.mExtendedPanId.m8,
+                                      sizeof(dataset.mExtendedPanId.m8)) >= 0,
                      error = OT_ERROR_PARSE);
     }
     if (tb[PANID] != NULL)
@@ -923,8 +1269,8 @@ int UbusServer::UbusMgmtset(struct ubus_context *     aContext,
     if (tb[PSKC] != NULL)
     {
         dataset.mComponents.mIsPskcPresent = true;
-        VerifyOrExit((length = Hex2Bin(blobmsg_get_string(tb[PSKC]), dataset.mPskc.m8, sizeof(dataset.mPskc.m8))) ==
-                         OT_PSKC_MAX_SIZE,
+        VerifyOrExit((length = Utils::Hex2Bytes(blobmsg_get_string(tb[PSKC]), dataset.mPskc.m8,
+                                                sizeof(dataset.mPskc.m8))) == OT_PSKC_MAX_SIZE,
                      error = OT_ERROR_PARSE);
         length = 0;
     }
@@ -953,7 +1299,6 @@ int UbusServer::UbusCommissioner(struct ubus_context *     aContext,
 
     otError error = OT_ERROR_NONE;
 
-    sNcpThreadMutex->lock();
 
     if (!strcmp(aAction, "start"))
     {
@@ -984,7 +1329,7 @@ int UbusServer::UbusCommissioner(struct ubus_context *     aContext,
             }
             else
             {
-                VerifyOrExit(Hex2Bin(blobmsg_get_string(tb[EUI64]), addr.m8, sizeof(addr)) == sizeof(addr),
+                VerifyOrExit(Utils::Hex2Bytes(blobmsg_get_string(tb[EUI64]), addr.m8, sizeof(addr)) == sizeof(addr),
                              error = OT_ERROR_PARSE);
                 addrPtr = &addr;
             }
@@ -1009,7 +1354,8 @@ int UbusServer::UbusCommissioner(struct ubus_context *     aContext,
             }
             else
             {
-                VerifyOrExit(Hex2Bin(blobmsg_get_string(tb[SETNETWORK]), addr.m8, sizeof(addr)) == sizeof(addr),
+                VerifyOrExit(Utils::Hex2Bytes(blobmsg_get_string(tb[SETNETWORK]), addr.m8, sizeof(addr)) ==
+                                 sizeof(addr),
                              error = OT_ERROR_PARSE);
                 addrPtr = &addr;
             }
@@ -1017,9 +1363,69 @@ int UbusServer::UbusCommissioner(struct ubus_context *     aContext,
 
         SuccessOrExit(error = otCommissionerRemoveJoiner(mController->GetInstance(), addrPtr));
     }
+    else if (!strcmp(aAction, "joinersadd") || !strcmp(aAction, "joinersremove"))
+    {
+        bool                                     add = !strcmp(aAction, "joinersadd");
+        struct blob_attr *                       tb[JOINERS_MAX];
+        struct blob_attr *                       cur;
+        unsigned int                             rem;
+        std::vector<agent::ThreadHelper::Joiner> joiners;
+
+        blobmsg_parse(joinersPolicy, JOINERS_MAX, tb, blob_data(aMsg), blob_len(aMsg));
+        VerifyOrExit(tb[JOINERS] != NULL, error = OT_ERROR_INVALID_ARGS);
+
+        // The joiners to add are tables of "eui64", "pskd" and "timeout", those to remove are EUI-64 strings.
+        blobmsg_for_each_attr(cur, tb[JOINERS], rem)
+        {
+            agent::ThreadHelper::Joiner joiner;
+            const char *                eui64;
+
+            joiner.mTimeout = kDefaultJoinerTimeout;
+
+            if (add)
+            {
+                struct blob_attr *joinerTb[JOINER_MAX];
+
+                VerifyOrExit(blobmsg_type(cur) == BLOBMSG_TYPE_TABLE, error = OT_ERROR_INVALID_ARGS);
+                blobmsg_parse(joinerPolicy, JOINER_MAX, joinerTb, blobmsg_data(cur), blobmsg_data_len(cur));
+                VerifyOrExit(joinerTb[JOINER_EUI64] != NULL && joinerTb[JOINER_PSKD] != NULL,
+                             error = OT_ERROR_INVALID_ARGS);
+
+                eui64        = blobmsg_get_string(joinerTb[JOINER_EUI64]);
+                joiner.mPskd = blobmsg_get_string(joinerTb[JOINER_PSKD]);
+                if (joinerTb[JOINER_TIMEOUT] != NULL)
+                {
+                    joiner.mTimeout = blobmsg_get_u32(joinerTb[JOINER_TIMEOUT]);
+                }
+            }
+            else
+            {
+                VerifyOrExit(blobmsg_type(cur) == BLOBMSG_TYPE_STRING, error = OT_ERROR_INVALID_ARGS);
+                eui64 = blobmsg_get_string(cur);
+            }
+
+            joiner.mAny = !strcmp(eui64, "*");
+            if (!joiner.mAny)
+            {
+                VerifyOrExit(Utils::Hex2Bytes(eui64, joiner.mEui64.m8, sizeof(joiner.mEui64)) ==
+                                 sizeof(joiner.mEui64),
+                             error = OT_ERROR_PARSE);
+            }
+
+            joiners.push_back(joiner);
+        }
+
+        if (add)
+        {
+            SuccessOrExit(error = mController->GetThreadHelper()->AddJoiners(joiners));
+        }
+        else
+        {
+            SuccessOrExit(error = mController->GetThreadHelper()->RemoveJoiners(joiners));
+        }
+    }
 
 exit:
-    sNcpThreadMutex->unlock();
     blob_buf_init(&mBuf, 0);
     AppendResult(error, aContext, aRequest);
     return 0;
@@ -1032,18 +1438,26 @@ void UbusServer::HandleStateChanged(otCommissionerState aState, void *aContext)
 
 void UbusServer::HandleStateChanged(otCommissionerState aState)
 {
+    const char *state = "unknown";
+
     switch (aState)
     {
     case OT_COMMISSIONER_STATE_DISABLED:
-        otbrLog(OTBR_LOG_INFO, "commissioner state disabled");
+        state = "disabled";
         break;
     case OT_COMMISSIONER_STATE_ACTIVE:
-        otbrLog(OTBR_LOG_INFO, "commissioner state active");
+        state = "active";
         break;
     case OT_COMMISSIONER_STATE_PETITION:
-        otbrLog(OTBR_LOG_INFO, "commissioner state petition");
+        state = "petition";
         break;
     }
+
+    otbrLog(OTBR_LOG_INFO, "commissioner state %s", state);
+
+    blob_buf_init(&mEventBuf, 0);
+    blobmsg_add_string(&mEventBuf, "State", state);
+    NotifyEvent("commissionerstate");
 }
 
 void UbusServer::HandleJoinerEvent(otCommissionerJoinerEvent aEvent, const otExtAddress *aJoinerId, void *aContext)
@@ -1053,357 +1467,648 @@ void UbusServer::HandleJoinerEvent(otCommissionerJoinerEvent aEvent, const otExt
 
 void UbusServer::HandleJoinerEvent(otCommissionerJoinerEvent aEvent, const otExtAddress *aJoinerId)
 {
-    OT_UNUSED_VARIABLE(aJoinerId);
+    const char *event = "unknown";
 
     switch (aEvent)
     {
     case OT_COMMISSIONER_JOINER_START:
-        otbrLog(OTBR_LOG_INFO, "joiner start");
+        event = "start";
         break;
     case OT_COMMISSIONER_JOINER_CONNECTED:
-        otbrLog(OTBR_LOG_INFO, "joiner connected");
+        event = "connected";
         break;
     case OT_COMMISSIONER_JOINER_FINALIZE:
-        otbrLog(OTBR_LOG_INFO, "joiner finalize");
+        event = "finalize";
         break;
     case OT_COMMISSIONER_JOINER_END:
-        otbrLog(OTBR_LOG_INFO, "joiner end");
+        event = "end";
         break;
     case OT_COMMISSIONER_JOINER_REMOVED:
-        otbrLog(OTBR_LOG_INFO, "joiner remove");
+        event = "remove";
         break;
     }
-}
 
-int UbusServer::UbusGetInformation(struct ubus_context *     aContext,
-                                   struct ubus_object *      aObj,
-                                   struct ubus_request_data *aRequest,
-                                   const char *              aMethod,
-                                   struct blob_attr *        aMsg,
-                                   const char *              aAction)
-{
-    OT_UNUSED_VARIABLE(aObj);
-    OT_UNUSED_VARIABLE(aMethod);
-    OT_UNUSED_VARIABLE(aMsg);
+    otbrLog(OTBR_LOG_INFO, "joiner %s", event);
 
-    otError error = OT_ERROR_NONE;
+    blob_buf_init(&mEventBuf, 0);
+    blobmsg_add_string(&mEventBuf, "Event", event);
 
-    blob_buf_init(&mBuf, 0);
+    if (aJoinerId != nullptr)
+    {
+        char joinerId[XPANID_LENGTH] = "";
 
-    sNcpThreadMutex->lock();
-    if (!strcmp(aAction, "networkname"))
-        blobmsg_add_string(&mBuf, "NetworkName", otThreadGetNetworkName(mController->GetInstance()));
-    else if (!strcmp(aAction, "state"))
+        OutputBytes(aJoinerId->m8, sizeof(aJoinerId->m8), joinerId, sizeof(joinerId));
+        blobmsg_add_string(&mEventBuf, "JoinerId", joinerId);
+    }
+
+    NotifyEvent("joiner");
+}
+
+void UbusServer::HandleThreadStateChanged(otChangedFlags aFlags)
+{
+    if (aFlags & OT_CHANGED_THREAD_ROLE)
     {
         char state[10];
+
         GetState(mController->GetInstance(), state);
-        blobmsg_add_string(&mBuf, "State", state);
-    }
-    else if (!strcmp(aAction, "channel"))
-        blobmsg_add_u32(&mBuf, "Channel", otLinkGetChannel(mController->GetInstance()));
-    else if (!strcmp(aAction, "panid"))
-    {
-        char panIdString[PANID_LENGTH];
-        sprintf(panIdString, "0x%04x", otLinkGetPanId(mController->GetInstance()));
-        blobmsg_add_string(&mBuf, "PanId", panIdString);
-    }
-    else if (!strcmp(aAction, "rloc16"))
-    {
-        char rloc[PANID_LENGTH];
-        sprintf(rloc, "0x%04x", otThreadGetRloc16(mController->GetInstance()));
-        blobmsg_add_string(&mBuf, "rloc16", rloc);
+
+        blob_buf_init(&mEventBuf, 0);
+        blobmsg_add_string(&mEventBuf, "State", state);
+        NotifyEvent("state");
     }
-    else if (!strcmp(aAction, "masterkey"))
+
+    // Subscribers fetch the neighbor table again on this event, which carries no data.
+    if (aFlags & (OT_CHANGED_THREAD_ROLE | OT_CHANGED_THREAD_CHILD_ADDED | OT_CHANGED_THREAD_CHILD_REMOVED))
     {
-        char           outputKey[MASTERKEY_LENGTH] = "";
-        const uint8_t *key = reinterpret_cast<const uint8_t *>(otThreadGetMasterKey(mController->GetInstance()));
-        OutputBytes(key, OT_MASTER_KEY_SIZE, outputKey);
-        blobmsg_add_string(&mBuf, "Masterkey", outputKey);
+        blob_buf_init(&mEventBuf, 0);
+        NotifyEvent("neighbor");
     }
-    else if (!strcmp(aAction, "pskc"))
+}
+
+void UbusServer::NotifyEvent(const char *aType)
+{
+    struct blob_attr *msg = static_cast<struct blob_attr *>(blob_memdup(mEventBuf.head));
+
+    VerifyOrExit(msg != NULL, otbrLog(OTBR_LOG_WARNING, "Failed to copy ubus event %s", aType));
+
+    mReplies.Post([this, aType, msg]() { SendEvent(aType, msg); });
+
+exit:
+    return;
+}
+
+void UbusServer::SendEvent(const char *aType, struct blob_attr *aMsg)
+{
+    // Events keep their order, those raised after a pending one are pending too.
+    if (mDisconnectTime == 0 && mPendingEvents.empty())
     {
-        char          outputPskc[MASTERKEY_LENGTH] = "";
-        const otPskc *pskc                         = otThreadGetPskc(mController->GetInstance());
-        OutputBytes(pskc->m8, OT_MASTER_KEY_SIZE, outputPskc);
-        blobmsg_add_string(&mBuf, "pskc", outputPskc);
+        if (mContext != NULL && otbr.has_subscribers)
+        {
+            ubus_notify(mContext, &otbr, aType, aMsg, -1);
+        }
+
+        free(aMsg);
+        ExitNow();
     }
-    else if (!strcmp(aAction, "extpanid"))
+
+    if (mPendingEvents.size() >= OTBR_CONFIG_UBUS_EVENT_BACKLOG)
     {
-        char           outputExtPanId[XPANID_LENGTH] = "";
-        const uint8_t *extPanId =
-            reinterpret_cast<const uint8_t *>(otThreadGetExtendedPanId(mController->GetInstance()));
-        OutputBytes(extPanId, OT_EXT_PAN_ID_SIZE, outputExtPanId);
-        blobmsg_add_string(&mBuf, "ExtPanId", outputExtPanId);
+        std::lock_guard<std::mutex> lock(mConnectionCountersLock);
+
+        free(mPendingEvents.front().mMsg);
+        mPendingEvents.pop_front();
+        mConnectionCounters.mDroppedEvents++;
     }
-    else if (!strcmp(aAction, "mode"))
-    {
-        otLinkModeConfig linkMode;
-        char             mode[5] = "";
 
-        memset(&linkMode, 0, sizeof(otLinkModeConfig));
+    mPendingEvents.push_back({aType, aMsg, GetNow()});
 
-        linkMode = otThreadGetLinkMode(mController->GetInstance());
+exit:
+    return;
+}
 
-        if (linkMode.mRxOnWhenIdle)
-        {
-            strcat(mode, "r");
-        }
+void UbusServer::ReplayEvents(void)
+{
+    uint64_t now      = GetNow();
+    uint32_t replayed = 0;
+    uint32_t dropped  = 0;
 
-        if (linkMode.mSecureDataRequests)
-        {
-            strcat(mode, "s");
-        }
+    VerifyOrExit(mDisconnectTime == 0 && !mPendingEvents.empty());
+
+    // Subscribers of the previous connection subscribe again to the object registered on the new one.
+    VerifyOrExit(otbr.has_subscribers);
+
+    while (!mPendingEvents.empty())
+    {
+        PendingEvent &event = mPendingEvents.front();
 
-        if (linkMode.mDeviceType)
+        if (now - event.mTime <= OTBR_CONFIG_UBUS_EVENT_MAX_AGE)
         {
-            strcat(mode, "d");
+            ubus_notify(mContext, &otbr, event.mType, event.mMsg, -1);
+            replayed++;
         }
-
-        if (linkMode.mNetworkData)
+        else
         {
-            strcat(mode, "n");
+            dropped++;
         }
-        blobmsg_add_string(&mBuf, "Mode", mode);
+
+        free(event.mMsg);
+        mPendingEvents.pop_front();
     }
-    else if (!strcmp(aAction, "leaderpartitionid"))
+
+    otbrLog(OTBR_LOG_INFO, "Replayed %u ubus events, dropped %u too old", replayed, dropped);
+
     {
-        blobmsg_add_u32(&mBuf, "Leaderpartitionid", otThreadGetLocalLeaderPartitionId(mController->GetInstance()));
+        std::lock_guard<std::mutex> lock(mConnectionCountersLock);
+
+        mConnectionCounters.mReplayedEvents += replayed;
+        mConnectionCounters.mDroppedEvents  += dropped;
     }
-    else if (!strcmp(aAction, "leaderdata"))
-    {
-        otLeaderData leaderData;
 
-        SuccessOrExit(error = otThreadGetLeaderData(mController->GetInstance(), &leaderData));
+exit:
+    return;
+}
+
+void UbusServer::HandleSubscribe(struct ubus_context *aContext, struct ubus_object *aObj)
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aObj);
+
+    GetInstance().ReplayEvents();
+}
+
+const UbusServer::InformationEncoder UbusServer::kInformationEncoders[] = {
+    // Sorted by action for the binary search in FindInformationEncoder().
+    {"addresscache", &UbusServer::EncodeAddressCache},
+    {"channel", &UbusServer::EncodeChannel},
+    {"connectionstats", &UbusServer::EncodeConnectionStats},
+    {"extpanid", &UbusServer::EncodeExtPanId},
+    {"joinernum", &UbusServer::EncodeJoinerNum},
+    {"leaderdata", &UbusServer::EncodeLeaderData},
+    {"leaderpartitionid", &UbusServer::EncodeLeaderPartitionId},
+    {"macfilteraddr", &UbusServer::EncodeMacfilterAddr},
+    {"macfilterstate", &UbusServer::EncodeMacfilterState},
+    {"mainloopstats", &UbusServer::EncodeMainloopStats},
+    {"masterkey", &UbusServer::EncodeMasterkey},
+    {"memorystats", &UbusServer::EncodeMemoryStats},
+    {"mode", &UbusServer::EncodeMode},
+    {"networkname", &UbusServer::EncodeNetworkName},
+    {"panid", &UbusServer::EncodePanId},
+    {"pskc", &UbusServer::EncodePskc},
+    {"rloc16", &UbusServer::EncodeRloc16},
+    {"state", &UbusServer::EncodeState},
+};
+
+const UbusServer::InformationEncoder *UbusServer::FindInformationEncoder(const char *aAction)
+{
+    const InformationEncoder *end     = kInformationEncoders + ARRAY_SIZE(kInformationEncoders);
+    const InformationEncoder *encoder = std::lower_bound(
+        kInformationEncoders, end, aAction,
+        [](const InformationEncoder &aEncoder, const char *aKey) { return strcmp(aEncoder.mAction, aKey) < 0; });
+
+    return (encoder != end && !strcmp(encoder->mAction, aAction)) ? encoder : nullptr;
+}
+
+int UbusServer::UbusGetInformation(struct ubus_context *     aContext,
+                                   struct ubus_object *      aObj,
+                                   struct ubus_request_data *aRequest,
+                                   const char *              aMethod,
+                                   struct blob_attr *        aMsg,
+                                   const char *              aAction)
+{
+    OT_UNUSED_VARIABLE(aObj);
+    OT_UNUSED_VARIABLE(aMethod);
+    OT_UNUSED_VARIABLE(aMsg);
 
-        sJsonUri = blobmsg_open_table(&mBuf, "leaderdata");
+    otError                   error   = OT_ERROR_NONE;
+    const InformationEncoder *encoder = FindInformationEncoder(aAction);
 
-        blobmsg_add_u32(&mBuf, "PartitionId", leaderData.mPartitionId);
-        blobmsg_add_u32(&mBuf, "Weighting", leaderData.mWeighting);
-        blobmsg_add_u32(&mBuf, "DataVersion", leaderData.mDataVersion);
-        blobmsg_add_u32(&mBuf, "StableDataVersion", leaderData.mStableDataVersion);
-        blobmsg_add_u32(&mBuf, "LeaderRouterId", leaderData.mLeaderRouterId);
+    blob_buf_init(&mBuf, 0);
 
-        blobmsg_close_table(&mBuf, sJsonUri);
+    if (encoder != nullptr)
+    {
+        error = (this->*encoder->mEncode)();
     }
-    else if (!strcmp(aAction, "networkdata"))
+    else
     {
-        ubus_send_reply(aContext, aRequest, mNetworkdataBuf.head);
-        if (time(NULL) - mSecond > 10)
-        {
-            struct otIp6Address address;
-            uint8_t             tlvTypes[OT_NETWORK_DIAGNOSTIC_TYPELIST_MAX_ENTRIES];
-            uint8_t             count             = 0;
-            char                multicastAddr[10] = "ff03::2";
-            long                value;
+        perror("invalid argument in get information ubus\n");
+    }
 
-            blob_buf_init(&mNetworkdataBuf, 0);
+    AppendResult(error, aContext, aRequest);
+    return 0;
+}
 
-            SuccessOrExit(error = otIp6AddressFromString(multicastAddr, &address));
+int UbusServer::UbusGetAllHandlerDetail(struct ubus_context *     aContext,
+                                        struct ubus_object *      aObj,
+                                        struct ubus_request_data *aRequest,
+                                        const char *              aMethod,
+                                        struct blob_attr *        aMsg)
+{
+    OT_UNUSED_VARIABLE(aObj);
+    OT_UNUSED_VARIABLE(aMethod);
+    OT_UNUSED_VARIABLE(aMsg);
 
-            value             = 5;
-            tlvTypes[count++] = static_cast<uint8_t>(value);
-            value             = 16;
-            tlvTypes[count++] = static_cast<uint8_t>(value);
+    blob_buf_init(&mBuf, 0);
 
-            sBufNum = 0;
-            otThreadSendDiagnosticGet(mController->GetInstance(), &address, tlvTypes, count);
-            mSecond = time(NULL);
-        }
-        goto exit;
-    }
-    else if (!strcmp(aAction, "joinernum"))
+    // All encoders run within this one main loop task, so the reply is a consistent snapshot. Information not
+    // available in the current state, e.g. the leader data of a detached device, is left out.
+    for (const InformationEncoder &encoder : kInformationEncoders)
     {
-        void *       jsonTable = NULL;
-        void *       jsonArray = NULL;
-        otJoinerInfo joinerInfo;
-        uint16_t     iterator        = 0;
-        int          joinerNum       = 0;
-        char         eui64[EXTPANID] = "";
+        (this->*encoder.mEncode)();
+    }
 
-        blob_buf_init(&mBuf, 0);
+    AppendResult(OT_ERROR_NONE, aContext, aRequest);
+    return 0;
+}
 
-        jsonArray = blobmsg_open_array(&mBuf, "joinerList");
-        while (otCommissionerGetNextJoinerInfo(mController->GetInstance(), &iterator, &joinerInfo) == OT_ERROR_NONE)
-        {
-            memset(eui64, 0, sizeof(eui64));
+int UbusServer::UbusNetworkdataHandlerDetail(struct ubus_context *     aContext,
+                                             struct ubus_object *      aObj,
+                                             struct ubus_request_data *aRequest,
+                                             const char *              aMethod,
+                                             struct blob_attr *        aMsg)
+{
+    OT_UNUSED_VARIABLE(aContext);
+    OT_UNUSED_VARIABLE(aObj);
+    OT_UNUSED_VARIABLE(aMethod);
+    OT_UNUSED_VARIABLE(aMsg);
 
-            jsonTable = blobmsg_open_table(&mBuf, NULL);
+    // The reply is built from the network topology once the crawl completes, or at once from a recent one.
+    HoldRequest(aRequest);
+    mController->GetThreadHelper()->CrawlTopology(
+        kTopologyMaxAge, [this, aRequest](otError aError) { ReplyNetworkdata(aRequest, aError); });
 
-            blobmsg_add_string(&mBuf, "pskc", joinerInfo.mPsk);
-            OutputBytes(joinerInfo.mEui64.m8, sizeof(joinerInfo.mEui64.m8), eui64);
-            blobmsg_add_string(&mBuf, "eui64", eui64);
-            if (joinerInfo.mAny)
-                blobmsg_add_u16(&mBuf, "isAny", 1);
-            else
-                blobmsg_add_u16(&mBuf, "isAny", 0);
+    return 0;
+}
+
+otError UbusServer::EncodeNetworkName(void)
+{
+    blobmsg_add_string(&mBuf, "NetworkName", otThreadGetNetworkName(mController->GetInstance()));
 
-            blobmsg_close_table(&mBuf, jsonTable);
+    return OT_ERROR_NONE;
+}
 
-            joinerNum++;
-        }
-        blobmsg_close_array(&mBuf, jsonArray);
+otError UbusServer::EncodeState(void)
+{
+    char state[10];
+    GetState(mController->GetInstance(), state);
+    blobmsg_add_string(&mBuf, "State", state);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeChannel(void)
+{
+    blobmsg_add_u32(&mBuf, "Channel", otLinkGetChannel(mController->GetInstance()));
+
+    return OT_ERROR_NONE;
+}
 
-        blobmsg_add_u32(&mBuf, "joinernum", joinerNum);
+otError UbusServer::EncodePanId(void)
+{
+    char panIdString[PANID_LENGTH];
+    sprintf(panIdString, "0x%04x", otLinkGetPanId(mController->GetInstance()));
+    blobmsg_add_string(&mBuf, "PanId", panIdString);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeRloc16(void)
+{
+    char rloc[PANID_LENGTH];
+    sprintf(rloc, "0x%04x", otThreadGetRloc16(mController->GetInstance()));
+    blobmsg_add_string(&mBuf, "rloc16", rloc);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMasterkey(void)
+{
+    char           outputKey[MASTERKEY_LENGTH] = "";
+    const uint8_t *key = reinterpret_cast<const uint8_t *>(otThreadGetMasterKey(mController->GetInstance()));
+    OutputBytes(key, OT_MASTER_KEY_SIZE, outputKey, sizeof(outputKey));
+    blobmsg_add_string(&mBuf, "Masterkey", outputKey);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodePskc(void)
+{
+    char          outputPskc[MASTERKEY_LENGTH] = "";
+    const otPskc *pskc                         = otThreadGetPskc(mController->GetInstance());
+    OutputBytes(pskc->m8, OT_MASTER_KEY_SIZE, outputPskc, sizeof(outputPskc));
+    blobmsg_add_string(&mBuf, "pskc", outputPskc);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeExtPanId(void)
+{
+    char           outputExtPanId[XPANID_LENGTH] = "";
+    const uint8_t *extPanId =
+        reinterpret_cast<const uint8_t *>(otThreadGetExtendedPanId(mController->GetInstance()));
+    OutputBytes(extPanId, OT_EXT_PAN_ID_SIZE, outputExtPanId, sizeof(outputExtPanId));
+    blobmsg_add_string(&mBuf, "ExtPanId", outputExtPanId);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMode(void)
+{
+    otLinkModeConfig linkMode;
+    char             mode[5] = "";
+
+    memset(&linkMode, 0, sizeof(otLinkModeConfig));
+
+    linkMode = otThreadGetLinkMode(mController->GetInstance());
+
+    if (linkMode.mRxOnWhenIdle)
+    {
+        strcat(mode, "r");
     }
-    else if (!strcmp(aAction, "macfilterstate"))
+
+    if (linkMode.mSecureDataRequests)
     {
-        otMacFilterAddressMode mode = otLinkFilterGetAddressMode(mController->GetInstance());
+        strcat(mode, "s");
+    }
 
-        blob_buf_init(&mBuf, 0);
+    if (linkMode.mDeviceType)
+    {
+        strcat(mode, "d");
+    }
 
-        if (mode == OT_MAC_FILTER_ADDRESS_MODE_DISABLED)
-        {
-            blobmsg_add_string(&mBuf, "state", "disable");
-        }
-        else if (mode == OT_MAC_FILTER_ADDRESS_MODE_WHITELIST)
-        {
-            blobmsg_add_string(&mBuf, "state", "whitelist");
-        }
-        else if (mode == OT_MAC_FILTER_ADDRESS_MODE_BLACKLIST)
-        {
-            blobmsg_add_string(&mBuf, "state", "blacklist");
-        }
+    if (linkMode.mNetworkData)
+    {
+        strcat(mode, "n");
+    }
+    blobmsg_add_string(&mBuf, "Mode", mode);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeLeaderPartitionId(void)
+{
+    blobmsg_add_u32(&mBuf, "Leaderpartitionid", otThreadGetLocalLeaderPartitionId(mController->GetInstance()));
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeLeaderData(void)
+{
+    otError      error = OT_ERROR_NONE;
+    otLeaderData leaderData;
+
+    SuccessOrExit(error = otThreadGetLeaderData(mController->GetInstance(), &leaderData));
+
+    sJsonUri = blobmsg_open_table(&mBuf, "leaderdata");
+
+    blobmsg_add_u32(&mBuf, "PartitionId", leaderData.mPartitionId);
+    blobmsg_add_u32(&mBuf, "Weighting", leaderData.mWeighting);
+    blobmsg_add_u32(&mBuf, "DataVersion", leaderData.mDataVersion);
+    blobmsg_add_u32(&mBuf, "StableDataVersion", leaderData.mStableDataVersion);
+    blobmsg_add_u32(&mBuf, "LeaderRouterId", leaderData.mLeaderRouterId);
+
+    blobmsg_close_table(&mBuf, sJsonUri);
+
+exit:
+    return error;
+}
+
+otError UbusServer::EncodeJoinerNum(void)
+{
+    void *       jsonTable = NULL;
+    void *       jsonArray = NULL;
+    otJoinerInfo joinerInfo;
+    uint16_t     iterator             = 0;
+    int          joinerNum            = 0;
+    char         eui64[XPANID_LENGTH] = "";
+
+    jsonArray = blobmsg_open_array(&mBuf, "joinerList");
+    while (otCommissionerGetNextJoinerInfo(mController->GetInstance(), &iterator, &joinerInfo) == OT_ERROR_NONE)
+    {
+        memset(eui64, 0, sizeof(eui64));
+
+        jsonTable = blobmsg_open_table(&mBuf, NULL);
+
+        blobmsg_add_string(&mBuf, "pskc", joinerInfo.mPsk);
+        OutputBytes(joinerInfo.mEui64.m8, sizeof(joinerInfo.mEui64.m8), eui64, sizeof(eui64));
+        blobmsg_add_string(&mBuf, "eui64", eui64);
+        if (joinerInfo.mAny)
+            blobmsg_add_u16(&mBuf, "isAny", 1);
         else
-        {
-            blobmsg_add_string(&mBuf, "state", "error");
-        }
+            blobmsg_add_u16(&mBuf, "isAny", 0);
+
+        blobmsg_close_table(&mBuf, jsonTable);
+
+        joinerNum++;
     }
-    else if (!strcmp(aAction, "macfilteraddr"))
+    blobmsg_close_array(&mBuf, jsonArray);
+
+    blobmsg_add_u32(&mBuf, "joinernum", joinerNum);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMacfilterState(void)
+{
+    otMacFilterAddressMode mode = otLinkFilterGetAddressMode(mController->GetInstance());
+
+    if (mode == OT_MAC_FILTER_ADDRESS_MODE_DISABLED)
+    {
+        blobmsg_add_string(&mBuf, "state", "disable");
+    }
+    else if (mode == OT_MAC_FILTER_ADDRESS_MODE_WHITELIST)
+    {
+        blobmsg_add_string(&mBuf, "state", "whitelist");
+    }
+    else if (mode == OT_MAC_FILTER_ADDRESS_MODE_BLACKLIST)
+    {
+        blobmsg_add_string(&mBuf, "state", "blacklist");
+    }
+    else
     {
-        otMacFilterEntry    entry;
-        otMacFilterIterator iterator = OT_MAC_FILTER_ITERATOR_INIT;
+        blobmsg_add_string(&mBuf, "state", "error");
+    }
 
-        blob_buf_init(&mBuf, 0);
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMacfilterAddr(void)
+{
+    otMacFilterEntry    entry;
+    otMacFilterIterator iterator = OT_MAC_FILTER_ITERATOR_INIT;
 
-        sJsonUri = blobmsg_open_array(&mBuf, "addrlist");
+    sJsonUri = blobmsg_open_array(&mBuf, "addrlist");
+
+    while (otLinkFilterGetNextAddress(mController->GetInstance(), &iterator, &entry) == OT_ERROR_NONE)
+    {
+        char extAddress[XPANID_LENGTH] = "";
+        OutputBytes(entry.mExtAddress.m8, sizeof(entry.mExtAddress.m8), extAddress, sizeof(extAddress));
+        blobmsg_add_string(&mBuf, "addr", extAddress);
+    }
+
+    blobmsg_close_array(&mBuf, sJsonUri);
 
-        while (otLinkFilterGetNextAddress(mController->GetInstance(), &iterator, &entry) == OT_ERROR_NONE)
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMainloopStats(void)
+{
+    const MainloopCounters &counters  = GetMainloopCounters();
+    void *                  jsonArray = NULL;
+
+    sJsonUri = blobmsg_open_table(&mBuf, "counters");
+    blobmsg_add_u64(&mBuf, "Wakeups", counters.mWakeups);
+    blobmsg_add_u64(&mBuf, "ZeroTimeoutPolls", counters.mZeroTimeoutPolls);
+    blobmsg_add_u64(&mBuf, "SpuriousWakeups", counters.mSpuriousWakeups);
+    blobmsg_close_table(&mBuf, sJsonUri);
+
+    sJsonUri = blobmsg_open_array(&mBuf, "histograms");
+    for (int i = 0; i < kMainloopStageNum; i++)
+    {
+        MainloopStage    stage     = static_cast<MainloopStage>(i);
+        const Histogram &histogram = GetMainloopHistogram(stage);
+        void *           jsonTable = blobmsg_open_table(&mBuf, NULL);
+
+        blobmsg_add_string(&mBuf, "Stage", GetMainloopStageName(stage));
+        blobmsg_add_u64(&mBuf, "Count", histogram.GetCount());
+        blobmsg_add_u64(&mBuf, "Sum", histogram.GetSum());
+        blobmsg_add_u32(&mBuf, "Max", histogram.GetMax());
+
+        jsonArray = blobmsg_open_array(&mBuf, "Buckets");
+        for (uint8_t index = 0; index < Histogram::kBuckets; index++)
         {
-            char extAddress[XPANID_LENGTH] = "";
-            OutputBytes(entry.mExtAddress.m8, sizeof(entry.mExtAddress.m8), extAddress);
-            blobmsg_add_string(&mBuf, "addr", extAddress);
+            uint32_t count = histogram.GetBucketCount(index);
+            void *   jsonBucket;
+
+            if (count == 0)
+            {
+                continue;
+            }
+
+            jsonBucket = blobmsg_open_table(&mBuf, NULL);
+            blobmsg_add_u32(&mBuf, "LowerBound", Histogram::GetBucketLowerBound(index));
+            blobmsg_add_u32(&mBuf, "Count", count);
+            blobmsg_close_table(&mBuf, jsonBucket);
         }
+        blobmsg_close_array(&mBuf, jsonArray);
 
-        blobmsg_close_array(&mBuf, sJsonUri);
+        blobmsg_close_table(&mBuf, jsonTable);
     }
-    else
+    blobmsg_close_array(&mBuf, sJsonUri);
+
+    return OT_ERROR_NONE;
+}
+
+otError UbusServer::EncodeMemoryStats(void)
+{
+    sJsonUri = blobmsg_open_array(&mBuf, "subsystems");
+    for (int i = 0; i < kMemoryTagNum; i++)
     {
-        perror("invalid argument in get information ubus\n");
+        MemoryTag      tag       = static_cast<MemoryTag>(i);
+        MemoryCounters counters  = GetMemoryCounters(tag);
+        void *         jsonTable = blobmsg_open_table(&mBuf, NULL);
+
+        blobmsg_add_string(&mBuf, "Subsystem", GetMemoryTagName(tag));
+        blobmsg_add_u64(&mBuf, "Bytes", counters.mBytes);
+        blobmsg_add_u64(&mBuf, "PeakBytes", counters.mPeakBytes);
+        blobmsg_add_u64(&mBuf, "Allocations", counters.mAllocations);
+        blobmsg_add_u64(&mBuf, "TotalAllocations", counters.mTotalAllocations);
+        blobmsg_close_table(&mBuf, jsonTable);
     }
+    blobmsg_close_array(&mBuf, sJsonUri);
 
-    AppendResult(error, aContext, aRequest);
-exit:
-    sNcpThreadMutex->unlock();
-    return 0;
+    return OT_ERROR_NONE;
 }
 
-void UbusServer::HandleDiagnosticGetResponse(otMessage *aMessage, const otMessageInfo *aMessageInfo, void *aContext)
+otError UbusServer::EncodeConnectionStats(void)
 {
-    static_cast<UbusServer *>(aContext)->HandleDiagnosticGetResponse(aMessage,
-                                                                     *static_cast<const otMessageInfo *>(aMessageInfo));
+    ConnectionCounters counters;
+
+    {
+        std::lock_guard<std::mutex> lock(mConnectionCountersLock);
+
+        counters = mConnectionCounters;
+    }
+
+    blobmsg_add_u32(&mBuf, "Reconnects", counters.mReconnects);
+    blobmsg_add_u32(&mBuf, "LastReconnectLatency", counters.mLastReconnectLatency);
+    blobmsg_add_u32(&mBuf, "MaxReconnectLatency", counters.mMaxReconnectLatency);
+    blobmsg_add_u32(&mBuf, "DroppedRequests", counters.mDroppedRequests);
+    blobmsg_add_u32(&mBuf, "ReplayedEvents", counters.mReplayedEvents);
+    blobmsg_add_u32(&mBuf, "DroppedEvents", counters.mDroppedEvents);
+
+    return OT_ERROR_NONE;
 }
 
-static bool IsRoutingLocator(const otIp6Address *aAddress)
+otError UbusServer::EncodeAddressCache(void)
 {
-    enum
+    static const char *const kStateNames[] = {"cached", "snooped", "query", "retryquery"};
+
+    const AddressCacheStats &          stats    = mController->GetThreadHelper()->GetAddressCacheStats();
+    const AddressCacheStats::Counters &counters = stats.GetCounters();
+
+    sJsonUri = blobmsg_open_table(&mBuf, "counters");
+    blobmsg_add_u32(&mBuf, "Queries", counters.mQueries);
+    blobmsg_add_u32(&mBuf, "Responses", counters.mResponses);
+    blobmsg_add_u32(&mBuf, "Failures", counters.mFailures);
+    blobmsg_add_u32(&mBuf, "Evictions", counters.mEvictions);
+    blobmsg_add_u32(&mBuf, "PeakSize", counters.mPeakSize);
+    blobmsg_close_table(&mBuf, sJsonUri);
+
+    sJsonUri = blobmsg_open_array(&mBuf, "entries");
+    for (const AddressCacheStats::Entry &entry : stats.GetEntries())
     {
-        kAloc16Mask            = 0xfc, ///< The mask for Aloc16.
-        kRloc16ReservedBitMask = 0x02, ///< The mask for the reserved bit of Rloc16.
-    };
+        char  target[INET6_ADDRSTRLEN];
+        void *jsonTable = blobmsg_open_table(&mBuf, NULL);
 
-    return (aAddress->mFields.m32[2] == htonl(0x000000ff) && aAddress->mFields.m16[6] == htons(0xfe00) &&
-            aAddress->mFields.m8[14] < kAloc16Mask && (aAddress->mFields.m8[14] & kRloc16ReservedBitMask) == 0);
+        inet_ntop(AF_INET6, entry.mTarget.data(), target, sizeof(target));
+        blobmsg_add_string(&mBuf, "Target", target);
+        blobmsg_add_u32(&mBuf, "Rloc16", entry.mRloc16);
+        blobmsg_add_string(&mBuf, "State", kStateNames[entry.mState]);
+
+        blobmsg_close_table(&mBuf, jsonTable);
+    }
+    blobmsg_close_array(&mBuf, sJsonUri);
+
+    return OT_ERROR_NONE;
 }
 
-void UbusServer::HandleDiagnosticGetResponse(otMessage *aMessage, const otMessageInfo &aMessageInfo)
+void UbusServer::ReplyNetworkdata(struct ubus_request_data *aRequest, otError aError)
 {
-    uint16_t              rloc16;
-    uint16_t              sockRloc16 = 0;
-    void *                jsonArray  = NULL;
-    void *                jsonItem   = NULL;
-    char                  xrloc[10];
-    otNetworkDiagTlv      diagTlv;
-    otNetworkDiagIterator iterator = OT_NETWORK_DIAGNOSTIC_ITERATOR_INIT;
-
-    char networkdata[20];
-    sprintf(networkdata, "networkdata%d", sBufNum);
-    sJsonUri = blobmsg_open_table(&mNetworkdataBuf, networkdata);
-    sBufNum++;
+    unsigned int index = 0;
+    char         xrloc[10];
 
-    if (IsRoutingLocator(&aMessageInfo.mSockAddr))
+    if (aError != OT_ERROR_NONE)
     {
-        sockRloc16 = aMessageInfo.mPeerAddr.mFields.m16[7];
-        sprintf(xrloc, "0x%04x", sockRloc16);
-        blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
+        blob_buf_init(&mBuf, 0);
+        AppendResult(aError, mContext, aRequest);
+        ExitNow();
     }
 
-    while (otThreadGetNextDiagnosticTlv(aMessage, &iterator, &diagTlv) == OT_ERROR_NONE)
+    blob_buf_init(&mNetworkdataBuf, 0);
+
+    for (const auto &entry : mController->GetThreadHelper()->GetTopology().GetNodes())
     {
-        switch (diagTlv.mType)
-        {
-        case OT_NETWORK_DIAGNOSTIC_TLV_ROUTE:
-        {
-            const otNetworkDiagRoute &route = diagTlv.mData.mRoute;
+        const Topology::Node &node = entry.second;
+        char                  networkdata[20];
+        void *                jsonTable;
+        void *                jsonArray;
+        void *                jsonItem;
 
-            jsonArray = blobmsg_open_array(&mNetworkdataBuf, "routedata");
+        snprintf(networkdata, sizeof(networkdata), "networkdata%u", index++);
+        jsonTable = blobmsg_open_table(&mNetworkdataBuf, networkdata);
 
-            for (uint16_t i = 0; i < route.mRouteCount; ++i)
-            {
-                uint8_t in, out;
-                in  = route.mRouteData[i].mLinkQualityIn;
-                out = route.mRouteData[i].mLinkQualityOut;
-                if (in != 0 && out != 0)
-                {
-                    jsonItem = blobmsg_open_table(&mNetworkdataBuf, "router");
-                    rloc16   = route.mRouteData[i].mRouterId << 10;
-                    blobmsg_add_u32(&mNetworkdataBuf, "routerid", route.mRouteData[i].mRouterId);
-                    sprintf(xrloc, "0x%04x", rloc16);
-                    blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
-                    blobmsg_close_table(&mNetworkdataBuf, jsonItem);
-                }
-            }
-            blobmsg_close_array(&mNetworkdataBuf, jsonArray);
-            break;
-        }
+        snprintf(xrloc, sizeof(xrloc), "0x%04x", node.mRloc16);
+        blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
 
-        case OT_NETWORK_DIAGNOSTIC_TLV_CHILD_TABLE:
+        jsonArray = blobmsg_open_array(&mNetworkdataBuf, "routedata");
+        for (const Topology::Link &link : node.mLinks)
         {
-            jsonArray = blobmsg_open_array(&mNetworkdataBuf, "childdata");
-            for (uint16_t i = 0; i < diagTlv.mData.mChildTable.mCount; ++i)
-            {
-                enum
-                {
-                    kModeRxOnWhenIdle      = 1 << 3, ///< If the device has its receiver on when not transmitting.
-                    kModeSecureDataRequest = 1 << 2, ///< If the device uses link layer security for all data requests.
-                    kModeFullThreadDevice  = 1 << 1, ///< If the device is an FTD.
-                    kModeFullNetworkData   = 1 << 0, ///< If the device requires the full Network Data.
-                };
-                const otNetworkDiagChildEntry &entry = diagTlv.mData.mChildTable.mTable[i];
-
-                uint8_t mode = 0;
-
-                jsonItem = blobmsg_open_table(&mNetworkdataBuf, "child");
-                sprintf(xrloc, "0x%04x", (sockRloc16 | entry.mChildId));
-                blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
-
-                mode = (entry.mMode.mRxOnWhenIdle ? kModeRxOnWhenIdle : 0) |
-                       (entry.mMode.mSecureDataRequests ? kModeSecureDataRequest : 0) |
-                       (entry.mMode.mDeviceType ? kModeFullThreadDevice : 0) |
-                       (entry.mMode.mNetworkData ? kModeFullNetworkData : 0);
-                blobmsg_add_u16(&mNetworkdataBuf, "mode", mode);
-                blobmsg_close_table(&mNetworkdataBuf, jsonItem);
-            }
-            blobmsg_close_array(&mNetworkdataBuf, jsonArray);
-            break;
+            jsonItem = blobmsg_open_table(&mNetworkdataBuf, "router");
+            blobmsg_add_u32(&mNetworkdataBuf, "routerid", link.mRloc16 >> 10);
+            snprintf(xrloc, sizeof(xrloc), "0x%04x", link.mRloc16);
+            blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
+            blobmsg_close_table(&mNetworkdataBuf, jsonItem);
         }
+        blobmsg_close_array(&mNetworkdataBuf, jsonArray);
 
-        default:
-            // Ignore other network diagnostics data.
-            break;
+        jsonArray = blobmsg_open_array(&mNetworkdataBuf, "childdata");
+        for (const Topology::Child &child : node.mChildren)
+        {
+            jsonItem = blobmsg_open_table(&mNetworkdataBuf, "child");
+            snprintf(xrloc, sizeof(xrloc), "0x%04x", child.mRloc16);
+            blobmsg_add_string(&mNetworkdataBuf, "rloc", xrloc);
+            blobmsg_add_u16(&mNetworkdataBuf, "mode", child.mMode);
+            blobmsg_close_table(&mNetworkdataBuf, jsonItem);
         }
+        blobmsg_close_array(&mNetworkdataBuf, jsonArray);
+
+        blobmsg_close_table(&mNetworkdataBuf, jsonTable);
     }
 
-    blobmsg_close_table(&mNetworkdataBuf, sJsonUri);
+    SetReply(aRequest, mNetworkdataBuf.head);
+
+exit:
+    CompleteRequest(aRequest);
 }
 
 int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
@@ -1421,7 +2126,6 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
 
     blob_buf_init(&mBuf, 0);
 
-    sNcpThreadMutex->lock();
     if (!strcmp(aAction, "networkname"))
     {
         struct blob_attr *tb[SET_NETWORK_MAX];
@@ -1467,7 +2171,8 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
             otMasterKey key;
             char *      masterkey = blobmsg_get_string(tb[SETNETWORK]);
 
-            VerifyOrExit(Hex2Bin(masterkey, key.m8, sizeof(key.m8)) == OT_MASTER_KEY_SIZE, error = OT_ERROR_PARSE);
+            VerifyOrExit(Utils::Hex2Bytes(masterkey, key.m8, sizeof(key.m8)) == OT_MASTER_KEY_SIZE,
+                         error = OT_ERROR_PARSE);
             SuccessOrExit(error = otThreadSetMasterKey(mController->GetInstance(), &key));
         }
     }
@@ -1480,7 +2185,8 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
         {
             otPskc pskc;
 
-            VerifyOrExit(Hex2Bin(blobmsg_get_string(tb[SETNETWORK]), pskc.m8, sizeof(pskc)) == OT_PSKC_MAX_SIZE,
+            VerifyOrExit(Utils::Hex2Bytes(blobmsg_get_string(tb[SETNETWORK]), pskc.m8, sizeof(pskc)) ==
+                             OT_PSKC_MAX_SIZE,
                          error = OT_ERROR_PARSE);
             SuccessOrExit(error = otThreadSetPskc(mController->GetInstance(), &pskc));
         }
@@ -1494,7 +2200,7 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
         {
             otExtendedPanId extPanId;
             char *          input = blobmsg_get_string(tb[SETNETWORK]);
-            VerifyOrExit(Hex2Bin(input, extPanId.m8, sizeof(extPanId)) >= 0, error = OT_ERROR_PARSE);
+            VerifyOrExit(Utils::Hex2Bytes(input, extPanId.m8, sizeof(extPanId)) >= 0, error = OT_ERROR_PARSE);
             error = otThreadSetExtendedPanId(mController->GetInstance(), &extPanId);
         }
     }
@@ -1556,7 +2262,8 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
         {
             char *addr = blobmsg_get_string(tb[SETNETWORK]);
 
-            VerifyOrExit(Hex2Bin(addr, extAddr.m8, OT_EXT_ADDRESS_SIZE) == OT_EXT_ADDRESS_SIZE, error = OT_ERROR_PARSE);
+            VerifyOrExit(Utils::Hex2Bytes(addr, extAddr.m8, OT_EXT_ADDRESS_SIZE) == OT_EXT_ADDRESS_SIZE,
+                         error = OT_ERROR_PARSE);
 
             error = otLinkFilterAddAddress(mController->GetInstance(), &extAddr);
 
@@ -1572,7 +2279,8 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
         if (tb[SETNETWORK] != NULL)
         {
             char *addr = blobmsg_get_string(tb[SETNETWORK]);
-            VerifyOrExit(Hex2Bin(addr, extAddr.m8, OT_EXT_ADDRESS_SIZE) == OT_EXT_ADDRESS_SIZE, error = OT_ERROR_PARSE);
+            VerifyOrExit(Utils::Hex2Bytes(addr, extAddr.m8, OT_EXT_ADDRESS_SIZE) == OT_EXT_ADDRESS_SIZE,
+                         error = OT_ERROR_PARSE);
 
             SuccessOrExit(error = otLinkFilterRemoveAddress(mController->GetInstance(), &extAddr));
         }
@@ -1613,7 +2321,6 @@ int UbusServer::UbusSetInformation(struct ubus_context *     aContext,
     }
 
 exit:
-    sNcpThreadMutex->unlock();
     AppendResult(error, aContext, aRequest);
     return 0;
 }
@@ -1659,35 +2366,58 @@ void UbusServer::UbusAddFd()
 
 void UbusServer::UbusReconnTimer(struct uloop_timeout *aTimeout)
 {
-    GetInstance().UbusReconnTimerDetail(aTimeout);
+    OT_UNUSED_VARIABLE(aTimeout);
+
+    GetInstance().Reconnect();
 }
 
-void UbusServer::UbusReconnTimerDetail(struct uloop_timeout *aTimeout)
+void UbusServer::Reconnect(void)
 {
-    OT_UNUSED_VARIABLE(aTimeout);
-
-    static struct uloop_timeout retry = {
-        list : {},
-        pending : false,
-        cb : UbusReconnTimer,
-        time : {},
-    };
-    int time = 2;
+    uint32_t latency;
 
+    // ubus_reconnect() registers the objects of the context again.
     if (ubus_reconnect(mContext, mSockPath) != 0)
     {
-        uloop_timeout_set(&retry, time * 1000);
-        return;
+        otbrLog(OTBR_LOG_DEBUG, "ubus reconnect failed, retrying in %ums", mReconnectDelay);
+        uloop_timeout_set(&mReconnectTimer, static_cast<int>(mReconnectDelay));
+        mReconnectDelay = std::min<uint32_t>(mReconnectDelay * 2, OTBR_CONFIG_UBUS_RECONNECT_MAX_DELAY);
+        ExitNow();
     }
 
     UbusAddFd();
+
+    latency         = static_cast<uint32_t>(GetNow() - mDisconnectTime);
+    mDisconnectTime = 0;
+    mReconnectDelay = OTBR_CONFIG_UBUS_RECONNECT_MIN_DELAY;
+    mConnection++;
+    otbrLog(OTBR_LOG_INFO, "ubus reconnected as %08x in %ums", mContext->local_id, latency);
+
+    {
+        std::lock_guard<std::mutex> lock(mConnectionCountersLock);
+
+        mConnectionCounters.mReconnects++;
+        mConnectionCounters.mLastReconnectLatency = latency;
+        mConnectionCounters.mMaxReconnectLatency  = std::max(mConnectionCounters.mMaxReconnectLatency, latency);
+    }
+
+    ReplayEvents();
+
+exit:
+    return;
 }
 
 void UbusServer::UbusConnectionLost(struct ubus_context *aContext)
 {
     OT_UNUSED_VARIABLE(aContext);
 
-    UbusReconnTimer(NULL);
+    UbusServer &server = GetInstance();
+
+    otbrLog(OTBR_LOG_WARNING, "ubus connection lost");
+
+    // The first attempt is immediate, ubusd may already be back, e.g. after a restart.
+    server.mDisconnectTime = GetNow();
+    server.mReconnectDelay = OTBR_CONFIG_UBUS_RECONNECT_MIN_DELAY;
+    server.Reconnect();
 }
 
 int UbusServer::DisplayUbusInit(const char *aPath)
@@ -1710,6 +2440,11 @@ int UbusServer::DisplayUbusInit(const char *aPath)
     /* file description */
     UbusAddFd();
 
+    /* replies of the requests handled by the OpenThread instance */
+    mRepliesFd.fd = mReplies.GetEventFd();
+    mRepliesFd.cb = HandleReplies;
+    uloop_fd_add(&mRepliesFd, ULOOP_READ);
+
     /* Add a object */
     if (ubus_add_object(mContext, &otbr) != 0)
     {
@@ -1754,112 +2489,15 @@ otError UbusServer::ParseLong(char *aString, long &aLong)
     return (*endptr == '\0') ? OT_ERROR_NONE : OT_ERROR_PARSE;
 }
 
-int UbusServer::Hex2Bin(const char *aHex, uint8_t *aBin, uint16_t aBinLength)
-{
-    size_t      hexLength = strlen(aHex);
-    const char *hexEnd    = aHex + hexLength;
-    uint8_t *   cur       = aBin;
-    uint8_t     numChars  = hexLength & 1;
-    uint8_t     byte      = 0;
-    int         rval;
-
-    VerifyOrExit((hexLength + 1) / 2 <= aBinLength, rval = -1);
-
-    while (aHex < hexEnd)
-    {
-        if ('A' <= *aHex && *aHex <= 'F')
-        {
-            byte |= 10 + (*aHex - 'A');
-        }
-        else if ('a' <= *aHex && *aHex <= 'f')
-        {
-            byte |= 10 + (*aHex - 'a');
-        }
-        else if ('0' <= *aHex && *aHex <= '9')
-        {
-            byte |= *aHex - '0';
-        }
-        else
-        {
-            ExitNow(rval = -1);
-        }
-
-        aHex++;
-        numChars++;
-
-        if (numChars >= 2)
-        {
-            numChars = 0;
-            *cur++   = byte;
-            byte     = 0;
-        }
-        else
-        {
-            byte <<= 4;
-        }
-    }
-
-    rval = static_cast<int>(cur - aBin);
-
-exit:
-    return rval;
-}
-
 } // namespace ubus
 } // namespace otbr
 
-void UbusServerInit(otbr::Ncp::ControllerOpenThread *aController, std::mutex *aNcpThreadMutex)
+void UbusServerInit(otbr::Ncp::ControllerOpenThread *aController)
 {
-    otbr::ubus::sNcpThreadMutex = aNcpThreadMutex;
-    otbr::ubus::sUbusEfd        = eventfd(0, 0);
-
     otbr::ubus::UbusServer::Initialize(aController);
-
-    if (otbr::ubus::sUbusEfd == -1)
-    {
-        perror("Failed to create eventfd for ubus");
-        exit(EXIT_FAILURE);
-    }
 }
 
 void UbusServerRun(void)
 {
     otbr::ubus::UbusServer::GetInstance().InstallUbusObject();
 }
-
-void UbusUpdateFdSet(fd_set &aReadFdSet, int &aMaxFd)
-{
-    VerifyOrExit(otbr::ubus::sUbusEfd != -1);
-
-    FD_SET(otbr::ubus::sUbusEfd, &aReadFdSet);
-
-    if (aMaxFd < otbr::ubus::sUbusEfd)
-    {
-        aMaxFd = otbr::ubus::sUbusEfd;
-    }
-
-exit:
-    return;
-}
-
-void UbusProcess(const fd_set &aReadFdSet)
-{
-    ssize_t  retval;
-    uint64_t num;
-
-    VerifyOrExit(otbr::ubus::sUbusEfd != -1);
-
-    if (FD_ISSET(otbr::ubus::sUbusEfd, &aReadFdSet))
-    {
-        retval = read(otbr::ubus::sUbusEfd, &num, sizeof(uint64_t));
-        if (retval != sizeof(uint64_t))
-        {
-            perror("read ubus eventfd failed\n");
-            exit(EXIT_FAILURE);
-        }
-        goto exit;
-    }
-
-exit:
-    return;
-}
@@ -31,15 +31,23 @@
 
 #include "openthread-br/config.h"
 
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include <stdarg.h>
 #include <time.h>
 
+#include <openthread/instance.h>
 #include <openthread/ip6.h>
 #include <openthread/link.h>
 #include <openthread/netdiag.h>
 #include <openthread/udp.h>
 
 #include "common/code_utils.hpp"
+#include "common/task_queue.hpp"
+#include "common/timer.hpp"
 
 extern "C" {
 #include <libubox/blobmsg_json.h>
@@ -718,6 +726,42 @@ public:
                                        const char *              aMethod,
                                        struct blob_attr *        aMsg);
 
+    /**
+     * This method handle ubus add joiners function request, which adds a list of joiners all or none.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusJoinersAddHandler(struct ubus_context *     aContext,
+                                     struct ubus_object *      aObj,
+                                     struct ubus_request_data *aRequest,
+                                     const char *              aMethod,
+                                     struct blob_attr *        aMsg);
+
+    /**
+     * This method handle ubus remove joiners function request, which removes a list of joiners.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusJoinersRemoveHandler(struct ubus_context *     aContext,
+                                        struct ubus_object *      aObj,
+                                        struct ubus_request_data *aRequest,
+                                        const char *              aMethod,
+                                        struct blob_attr *        aMsg);
+
     /**
      * This method handle ubus get joiner information function request.
      *
@@ -755,35 +799,179 @@ public:
                                   struct blob_attr *        aMsg);
 
     /**
-     * This method handle initial diagnostic get response.
+     * This method handle ubus get main loop statistics function request.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusMainloopStatsHandler(struct ubus_context *     aContext,
+                                        struct ubus_object *      aObj,
+                                        struct ubus_request_data *aRequest,
+                                        const char *              aMethod,
+                                        struct blob_attr *        aMsg);
+
+    /**
+     * This method handle ubus get memory statistics function request.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusMemoryStatsHandler(struct ubus_context *     aContext,
+                                      struct ubus_object *      aObj,
+                                      struct ubus_request_data *aRequest,
+                                      const char *              aMethod,
+                                      struct blob_attr *        aMsg);
+
+    /**
+     * This method handle ubus get address cache function request.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusAddressCacheHandler(struct ubus_context *     aContext,
+                                       struct ubus_object *      aObj,
+                                       struct ubus_request_data *aRequest,
+                                       const char *              aMethod,
+                                       struct blob_attr *        aMsg);
+
+    /**
+     * This method handle ubus get connection statistics function request.
      *
-     * @param[in]   aMessage        A pointer to the message.
-     * @param[in]   aMessageInfo    A pointer to the message information.
-     * @param[in]   aContext        A pointer to the context.
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    static int UbusConnectionStatsHandler(struct ubus_context *     aContext,
+                                          struct ubus_object *      aObj,
+                                          struct ubus_request_data *aRequest,
+                                          const char *              aMethod,
+                                          struct blob_attr *        aMsg);
+
+    /**
+     * This method handles a change of the subscribers of the ubus object, replaying the pending events.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
      *
      */
-    static void HandleDiagnosticGetResponse(otMessage *aMessage, const otMessageInfo *aMessageInfo, void *aContext);
+    static void HandleSubscribe(struct ubus_context *aContext, struct ubus_object *aObj);
 
     /**
-     * This method handle diagnosticget response.
+     * This method handle ubus get all information function request.
      *
-     * @param[in]   aMessage        A pointer to the message.
-     * @param[in]   aMessageInfo    A pointer to the message information.
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
      *
      */
-    void HandleDiagnosticGetResponse(otMessage *aMessage, const otMessageInfo &aMessageInfo);
+    static int UbusGetAllHandler(struct ubus_context *     aContext,
+                                 struct ubus_object *      aObj,
+                                 struct ubus_request_data *aRequest,
+                                 const char *              aMethod,
+                                 struct blob_attr *        aMsg);
 
 private:
-    bool                       mIfFinishScan;
+    /**
+     * This structure represents a ubus request deferred to the OpenThread instance's thread.
+     *
+     */
+    struct UbusRequest : public ubus_request_data
+    {
+        struct blob_attr *mMsg;   ///< A copy of the request message.
+        struct blob_attr *mReply;      ///< The reply to send, or NULL for a status only reply.
+        uint32_t          mConnection; ///< The generation of the ubus connection the request arrived on.
+        bool              mHeld;       ///< Whether an OpenThread callback completes the request later.
+    };
+
+    /**
+     * This structure represents an event raised while no subscriber could receive it.
+     *
+     */
+    struct PendingEvent
+    {
+        const char *      mType; ///< The event type.
+        struct blob_attr *mMsg;  ///< A copy of the event message.
+        uint64_t          mTime; ///< The time the event was raised, as returned by GetNow().
+    };
+
+    /**
+     * This structure represents the counters of the ubus connection.
+     *
+     */
+    struct ConnectionCounters
+    {
+        uint32_t mReconnects;           ///< The number of reconnects.
+        uint32_t mLastReconnectLatency; ///< The time from the last connection loss to the reconnect, in milliseconds.
+        uint32_t mMaxReconnectLatency;  ///< The longest time from a connection loss to the reconnect, in milliseconds.
+        uint32_t mDroppedRequests;      ///< The number of requests whose connection was lost before the reply.
+        uint32_t mReplayedEvents;       ///< The number of events replayed once connected again.
+        uint32_t mDroppedEvents;        ///< The number of events dropped as too old or beyond the backlog.
+    };
+
+    typedef int (UbusServer::*RequestHandler)(struct ubus_context *     aContext,
+                                              struct ubus_object *      aObj,
+                                              struct ubus_request_data *aRequest,
+                                              const char *              aMethod,
+                                              struct blob_attr *        aMsg);
+
+    typedef int (UbusServer::*ActionHandler)(struct ubus_context *     aContext,
+                                             struct ubus_object *      aObj,
+                                             struct ubus_request_data *aRequest,
+                                             const char *              aMethod,
+                                             struct blob_attr *        aMsg,
+                                             const char *              aAction);
+
+    typedef std::function<void(struct ubus_request_data *aRequest, struct blob_attr *aMsg)> RequestTask;
+
     struct ubus_context *      mContext;
     const char *               mSockPath;
     struct blob_buf            mBuf;
     struct blob_buf            mNetworkdataBuf;
+    struct blob_buf            mScanBuf;
+    struct blob_buf            mEventBuf;
+    void *                     mScanList;
+    UbusRequest *              mScanRequest;
     Ncp::ControllerOpenThread *mController;
-    time_t                     mSecond;
+    TaskQueue                  mReplies;
+    struct uloop_fd            mRepliesFd;
+    struct uloop_timeout       mReconnectTimer;
+    uint32_t                   mReconnectDelay; ///< The delay before the next reconnect attempt, in milliseconds.
+    uint64_t                   mDisconnectTime; ///< The time the connection was lost, or 0 while connected.
+    uint32_t                   mConnection;     ///< The generation of the ubus connection.
+    std::deque<PendingEvent>   mPendingEvents;  ///< The events waiting for a connection and a subscriber.
+    ConnectionCounters         mConnectionCounters;
+    std::mutex                 mConnectionCountersLock; ///< The counters are read by the OpenThread instance's thread.
     enum
     {
         kDefaultJoinerTimeout = 120,
+        kTopologyMaxAge       = 10000, ///< The age of the network topology to reuse, in milliseconds.
     };
 
     /**
@@ -794,10 +982,108 @@ private:
     UbusServer(Ncp::ControllerOpenThread *aController);
 
     /**
-     * This method start scan.
+     * This method defers a ubus request and posts its handler to the OpenThread instance's thread.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     * @param[in]   aHandler    The handler to run on the OpenThread instance's thread.
+     *
+     * @retval UBUS_STATUS_OK               Successfully deferred the request.
+     * @retval UBUS_STATUS_UNKNOWN_ERROR    Failed to copy the request message.
+     *
+     */
+    int PostRequest(struct ubus_context *     aContext,
+                    struct ubus_object *      aObj,
+                    struct ubus_request_data *aRequest,
+                    const char *              aMethod,
+                    struct blob_attr *        aMsg,
+                    RequestHandler            aHandler);
+
+    /**
+     * This method defers a ubus request and posts its action handler to the OpenThread instance's thread.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     * @param[in]   aHandler    The handler to run on the OpenThread instance's thread.
+     * @param[in]   aAction     A pointer to the action passed to @p aHandler.
+     *
+     * @retval UBUS_STATUS_OK               Successfully deferred the request.
+     * @retval UBUS_STATUS_UNKNOWN_ERROR    Failed to copy the request message.
+     *
+     */
+    int PostRequest(struct ubus_context *     aContext,
+                    struct ubus_object *      aObj,
+                    struct ubus_request_data *aRequest,
+                    const char *              aMethod,
+                    struct blob_attr *        aMsg,
+                    ActionHandler             aHandler,
+                    const char *              aAction);
+
+    /**
+     * This method defers a ubus request and posts a task handling it to the OpenThread instance's thread.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     * @param[in]   aTask       The task handling the deferred request and its copied message.
+     *
+     * @retval UBUS_STATUS_OK               Successfully deferred the request.
+     * @retval UBUS_STATUS_UNKNOWN_ERROR    Failed to copy the request message.
+     *
+     */
+    int PostRequest(struct ubus_context *     aContext,
+                    struct ubus_request_data *aRequest,
+                    struct blob_attr *        aMsg,
+                    const RequestTask &       aTask);
+
+    /**
+     * This method keeps a deferred request open after its handler returns, it is completed by a later callback.
+     *
+     * @param[in]   aRequest    A pointer to the deferred request.
      *
      */
-    void ProcessScan(void);
+    void HoldRequest(struct ubus_request_data *aRequest);
+
+    /**
+     * This method sets the reply of a deferred request, replacing any previous reply.
+     *
+     * @param[in]   aRequest    A pointer to the deferred request.
+     * @param[in]   aReply      A pointer to the reply message.
+     *
+     */
+    void SetReply(struct ubus_request_data *aRequest, const struct blob_attr *aReply);
+
+    /**
+     * This method hands a deferred request back to the ubus thread, which sends its reply and completes it.
+     *
+     * @param[in]   aRequest    A pointer to the deferred request.
+     *
+     */
+    void CompleteRequest(struct ubus_request_data *aRequest);
+
+    /**
+     * This method replies to a network data request from the network topology.
+     *
+     * @param[in]   aRequest    A pointer to the deferred request.
+     * @param[in]   aError      The result of the topology crawl.
+     *
+     */
+    void ReplyNetworkdata(struct ubus_request_data *aRequest, otError aError);
+
+    /**
+     * This method sends the replies posted to the ubus thread (uloop callback function).
+     *
+     * @param[in]   aFd         A pointer to the uloop fd of the reply queue.
+     * @param[in]   aEvents     The uloop events.
+     *
+     */
+    static void HandleReplies(struct uloop_fd *aFd, unsigned int aEvents);
 
     /**
      * This method detailly start scan.
@@ -906,6 +1192,42 @@ private:
                                const char *              aMethod,
                                struct blob_attr *        aMsg);
 
+    /**
+     * This method replies all the information of the get information request at once.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    int UbusGetAllHandlerDetail(struct ubus_context *     aContext,
+                                struct ubus_object *      aObj,
+                                struct ubus_request_data *aRequest,
+                                const char *              aMethod,
+                                struct blob_attr *        aMsg);
+
+    /**
+     * This method handle network data request, which is replied once the network topology is crawled.
+     *
+     * @param[in]   aContext    A pointer to the ubus context.
+     * @param[in]   aObj        A pointer to the ubus object.
+     * @param[in]   aRequest    A pointer to the ubus request.
+     * @param[in]   aMethod     A pointer to the ubus method.
+     * @param[in]   aMsg        A pointer to the ubus message.
+     *
+     * @retval 0   Successfully handler the request.
+     *
+     */
+    int UbusNetworkdataHandlerDetail(struct ubus_context *     aContext,
+                                     struct ubus_object *      aObj,
+                                     struct ubus_request_data *aRequest,
+                                     const char *              aMethod,
+                                     struct blob_attr *        aMsg);
+
     /**
      * This method handle thread related request.
      *
@@ -1022,6 +1344,24 @@ private:
      */
     void HandleJoinerEvent(otCommissionerJoinerEvent aEvent, const otExtAddress *aJoinerId);
 
+    /**
+     * This method handle Thread state change, notifying the role and neighbor changes to the subscribers.
+     *
+     * @param[in]   aFlags      The flags of the changed states.
+     *
+     */
+    void HandleThreadStateChanged(otChangedFlags aFlags);
+
+    /**
+     * This method notifies the event in mEventBuf to the subscribers of the otbr object.
+     *
+     * The notification is sent from the ubus thread, the message is copied before this method returns.
+     *
+     * @param[in]   aType       A pointer to the event type, which must stay valid until the notification is sent.
+     *
+     */
+    void NotifyEvent(const char *aType);
+
     /**
      * This method convert thread network state to string.
      *
@@ -1046,12 +1386,27 @@ private:
     static void UbusReconnTimer(struct uloop_timeout *aTimeout);
 
     /**
-     * This method detailly handle ubus reconnect time.
+     * This method attempts to reconnect to ubus, and retries with an exponential backoff on failure.
      *
-     * @param[in]   aTimeout    A pointer to the timeout.
+     */
+    void Reconnect(void);
+
+    /**
+     * This method sends the pending events, once connected again and subscribed to.
      *
      */
-    void UbusReconnTimerDetail(struct uloop_timeout *aTimeout);
+    void ReplayEvents(void);
+
+    /**
+     * This method sends an event, or keeps it pending when it can't be delivered now.
+     *
+     * It must be called from the ubus thread.
+     *
+     * @param[in]   aType   A pointer to the event type, which must outlive the event.
+     * @param[in]   aMsg    A pointer to the event message, freed by this method.
+     *
+     */
+    void SendEvent(const char *aType, struct blob_attr *aMsg);
 
     /**
      * This method handle ubus connection lost.
@@ -1090,35 +1445,73 @@ private:
     otError ParseLong(char *aString, long &aLong);
 
     /**
-     * This method converts a hex string to binary.
+     * This method output bytes into char*.
      *
-     * @param[in]   aHex        A pointer to the hex string.
-     * @param[out]  aBin        A pointer to where the binary representation is placed.
-     * @param[in]   aBinLength  Maximum length of the binary representation.
+     * @param[in]   aBytes      A pointer to the bytes need to be convert.
+     * @param[in]   aLength     The length of the bytes.
+     * @param[out]  aOutput     A pointer to the char* string.
+     * @param[in]   aOutputSize The size of @p aOutput, including the null terminator.
      *
-     * @returns The number of bytes in the binary representation.
      */
-    int Hex2Bin(const char *aHex, uint8_t *aBin, uint16_t aBinLength);
+    void OutputBytes(const uint8_t *aBytes, uint8_t aLength, char *aOutput, size_t aOutputSize);
 
     /**
-     * This method output bytes into char*.
+     * This method append result in message and sets it as the reply of the deferred request.
      *
-     * @param[in]   aBytes  A pointer to the bytes need to be convert.
-     * @param[in]   aLength The length of the bytes.
-     * @param[out]  aOutput A pointer to the char* string.
+     * @param[in]   aError      The error type of the message.
+     * @param[in]   aContext    A pointer to the context.
+     * @param[in]   aRequest    A pointer to the deferred request.
      *
      */
-    void OutputBytes(const uint8_t *aBytes, uint8_t aLength, char *aOutput);
+    void AppendResult(otError aError, struct ubus_context *aContext, struct ubus_request_data *aRequest);
 
     /**
-     * This method append result in message passed to ubus.
+     * This structure maps an action of the get information request to the method encoding its information.
      *
-     * @param[in]   aError      The error type of the message.
-     * @param[in]   aContext    A pointer to the context.
-     * @param[in]   aRequest    A pointer to the request.
+     */
+    struct InformationEncoder
+    {
+        const char *mAction;                  ///< The action, e.g. "networkname".
+        otError (UbusServer::*mEncode)(void); ///< The method appending the information to mBuf.
+    };
+
+    /**
+     * This method finds the encoder of an action.
+     *
+     * @param[in]   aAction     A pointer to the action.
+     *
+     * @returns A pointer to the encoder, or nullptr if the action is unknown.
      *
      */
-    void AppendResult(otError aError, struct ubus_context *aContext, struct ubus_request_data *aRequest);
+    static const InformationEncoder *FindInformationEncoder(const char *aAction);
+
+    /**
+     * These methods append a piece of information to mBuf.
+     *
+     * @retval OT_ERROR_NONE    Successfully appended the information.
+     * @retval ...              The information is not available, and nothing was appended.
+     *
+     */
+    otError EncodeNetworkName(void);
+    otError EncodeState(void);
+    otError EncodeChannel(void);
+    otError EncodePanId(void);
+    otError EncodeRloc16(void);
+    otError EncodeMasterkey(void);
+    otError EncodePskc(void);
+    otError EncodeExtPanId(void);
+    otError EncodeMode(void);
+    otError EncodeLeaderPartitionId(void);
+    otError EncodeLeaderData(void);
+    otError EncodeJoinerNum(void);
+    otError EncodeMacfilterState(void);
+    otError EncodeMacfilterAddr(void);
+    otError EncodeMainloopStats(void);
+    otError EncodeMemoryStats(void);
+    otError EncodeAddressCache(void);
+    otError EncodeConnectionStats(void);
+
+    static const InformationEncoder kInformationEncoders[]; ///< The encoders, sorted by action.
 };
 } // namespace ubus
 } // namespace otbr
@@ -0,0 +1,1099 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the REST server hosted by the agent.
+ */
+
+#include "rest/rest_server.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openthread/border_router.h>
+#include <openthread/instance.h>
+#include <openthread/thread.h>
+
+#include "agent/ncp_openthread.hpp"
+#include "agent/thread_helper.hpp"
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/mainloop_stats.hpp"
+#include "common/memory_stats.hpp"
+#include "common/time.hpp"
+#include "utils/hex.hpp"
+#include "utils/metrics_writer.hpp"
+#include "web/web-service/json.hpp"
+
+#ifndef OTBR_CONFIG_REST_ADDRESS
+/**
+ * The IPv6 address the REST server listens on.
+ *
+ * The requests are not authenticated, so only local clients are served by default.
+ *
+ */
+#define OTBR_CONFIG_REST_ADDRESS "::1"
+#endif
+
+#ifndef OTBR_CONFIG_REST_PORT
+/**
+ * The TCP port the REST server listens on.
+ *
+ */
+#define OTBR_CONFIG_REST_PORT 8081
+#endif
+
+#ifndef OTBR_CONFIG_REST_MAX_CONNECTIONS
+/**
+ * The maximum number of connections served at the same time, others wait in the listen backlog.
+ *
+ */
+#define OTBR_CONFIG_REST_MAX_CONNECTIONS 8
+#endif
+
+#ifndef OTBR_CONFIG_REST_MAX_REQUEST_SIZE
+/**
+ * The maximum size in bytes of a request, including its headers and body.
+ *
+ */
+#define OTBR_CONFIG_REST_MAX_REQUEST_SIZE 4096
+#endif
+
+#ifndef OTBR_CONFIG_REST_IDLE_TIMEOUT
+/**
+ * The time in milliseconds after which a connection without I/O or pending request is closed.
+ *
+ */
+#define OTBR_CONFIG_REST_IDLE_TIMEOUT 30000
+#endif
+
+#ifndef OTBR_CONFIG_REST_METRICS_MAX_AGE
+/**
+ * The time in milliseconds the rendered metrics are served from cache, whatever the number of scrapers.
+ *
+ */
+#define OTBR_CONFIG_REST_METRICS_MAX_AGE 5000
+#endif
+
+namespace otbr {
+namespace Rest {
+
+using Web::JsonReader;
+using Web::JsonWriter;
+
+#define REST_RESPONSE_SUCCESS "successful"
+#define REST_RESPONSE_FAILURE "failed"
+
+static const char          kHttpOk[]                   = "200 OK";
+static const char          kHttpNoContent[]            = "204 No Content";
+static const char          kHttpBadRequest[]           = "400 Bad Request";
+static const char          kHttpNotFound[]             = "404 Not Found";
+static const char          kHttpMethodNotAllowed[]     = "405 Method Not Allowed";
+static const char          kHttpPayloadTooLarge[]      = "413 Payload Too Large";
+static const char          kHttpHeaderFieldsTooLarge[] = "431 Request Header Fields Too Large";
+static const char          kHttpHeaderEnd[]            = "\r\n\r\n";
+static const char          kHttpLineEnd[]              = "\r\n";
+static const char          kHttpVersion10[]            = "HTTP/1.0";
+static const char          kHttpVersionPrefix[]        = "HTTP/1.";
+static const char          kHttpMethodOptions[]        = "OPTIONS";
+static const size_t        kHttpHeaderEndLength        = sizeof(kHttpHeaderEnd) - 1;
+static const size_t        kHttpLineEndLength          = sizeof(kHttpLineEnd) - 1;
+static const size_t        kHttpVersionPrefixLength    = sizeof(kHttpVersionPrefix) - 1;
+static const unsigned long kIdleTimeout                = OTBR_CONFIG_REST_IDLE_TIMEOUT;
+static const unsigned long kMetricsMaxAge              = OTBR_CONFIG_REST_METRICS_MAX_AGE;
+
+const RestServer::Resource RestServer::kResources[] = {
+    {"GET", "/get_properties", &RestServer::HandleStatus},
+    {"GET", "/available_network", &RestServer::HandleAvailableNetworks},
+    {"POST", "/add_prefix", &RestServer::HandleAddPrefix},
+    {"POST", "/delete_prefix", &RestServer::HandleDeletePrefix},
+    {"GET", "/metrics", &RestServer::HandleMetrics},
+};
+
+/**
+ * The MAC counters, which are all 32-bit counters of frames.
+ *
+ */
+static const struct
+{
+    const char *mName;   ///< The metric name.
+    const char *mHelp;   ///< The help text.
+    size_t      mOffset; ///< The offset of the counter in otMacCounters.
+} kMacCounters[] = {
+    {"otbr_mac_tx_total", "Frames transmitted.", offsetof(otMacCounters, mTxTotal)},
+    {"otbr_mac_tx_unicast_total", "Unicast frames transmitted.", offsetof(otMacCounters, mTxUnicast)},
+    {"otbr_mac_tx_broadcast_total", "Broadcast frames transmitted.", offsetof(otMacCounters, mTxBroadcast)},
+    {"otbr_mac_tx_ack_requested_total", "Frames transmitted with an ack request.",
+     offsetof(otMacCounters, mTxAckRequested)},
+    {"otbr_mac_tx_acked_total", "Frames transmitted and acked.", offsetof(otMacCounters, mTxAcked)},
+    {"otbr_mac_tx_no_ack_requested_total", "Frames transmitted without an ack request.",
+     offsetof(otMacCounters, mTxNoAckRequested)},
+    {"otbr_mac_tx_data_total", "Data frames transmitted.", offsetof(otMacCounters, mTxData)},
+    {"otbr_mac_tx_data_poll_total", "Data poll frames transmitted.", offsetof(otMacCounters, mTxDataPoll)},
+    {"otbr_mac_tx_beacon_total", "Beacon frames transmitted.", offsetof(otMacCounters, mTxBeacon)},
+    {"otbr_mac_tx_beacon_request_total", "Beacon request frames transmitted.",
+     offsetof(otMacCounters, mTxBeaconRequest)},
+    {"otbr_mac_tx_other_total", "Other frames transmitted.", offsetof(otMacCounters, mTxOther)},
+    {"otbr_mac_tx_retry_total", "Frame transmission retries.", offsetof(otMacCounters, mTxRetry)},
+    {"otbr_mac_tx_err_cca_total", "Frame transmissions failed on CCA.", offsetof(otMacCounters, mTxErrCca)},
+    {"otbr_mac_tx_err_abort_total", "Frame transmissions aborted.", offsetof(otMacCounters, mTxErrAbort)},
+    {"otbr_mac_tx_err_busy_channel_total", "Frame transmissions failed on a busy channel.",
+     offsetof(otMacCounters, mTxErrBusyChannel)},
+    {"otbr_mac_rx_total", "Frames received.", offsetof(otMacCounters, mRxTotal)},
+    {"otbr_mac_rx_unicast_total", "Unicast frames received.", offsetof(otMacCounters, mRxUnicast)},
+    {"otbr_mac_rx_broadcast_total", "Broadcast frames received.", offsetof(otMacCounters, mRxBroadcast)},
+    {"otbr_mac_rx_data_total", "Data frames received.", offsetof(otMacCounters, mRxData)},
+    {"otbr_mac_rx_data_poll_total", "Data poll frames received.", offsetof(otMacCounters, mRxDataPoll)},
+    {"otbr_mac_rx_beacon_total", "Beacon frames received.", offsetof(otMacCounters, mRxBeacon)},
+    {"otbr_mac_rx_beacon_request_total", "Beacon request frames received.",
+     offsetof(otMacCounters, mRxBeaconRequest)},
+    {"otbr_mac_rx_other_total", "Other frames received.", offsetof(otMacCounters, mRxOther)},
+    {"otbr_mac_rx_address_filtered_total", "Frames dropped by the address filter.",
+     offsetof(otMacCounters, mRxAddressFiltered)},
+    {"otbr_mac_rx_dest_addr_filtered_total", "Frames dropped for their destination address.",
+     offsetof(otMacCounters, mRxDestAddrFiltered)},
+    {"otbr_mac_rx_duplicated_total", "Duplicated frames received.", offsetof(otMacCounters, mRxDuplicated)},
+    {"otbr_mac_rx_err_no_frame_total", "Frames dropped for a missing or malformed payload.",
+     offsetof(otMacCounters, mRxErrNoFrame)},
+    {"otbr_mac_rx_err_unknown_neighbor_total", "Frames dropped from an unknown neighbor.",
+     offsetof(otMacCounters, mRxErrUnknownNeighbor)},
+    {"otbr_mac_rx_err_invalid_src_addr_total", "Frames dropped for an invalid source address.",
+     offsetof(otMacCounters, mRxErrInvalidSrcAddr)},
+    {"otbr_mac_rx_err_sec_total", "Frames dropped by the security checks.", offsetof(otMacCounters, mRxErrSec)},
+    {"otbr_mac_rx_err_fcs_total", "Frames dropped for a bad FCS.", offsetof(otMacCounters, mRxErrFcs)},
+    {"otbr_mac_rx_err_other_total", "Frames dropped for another error.", offsetof(otMacCounters, mRxErrOther)},
+};
+
+/**
+ * The upper bounds of the main loop stage histogram buckets, in microseconds.
+ *
+ * They are powers of two, which are bucket boundaries of `Histogram`, so that the cumulative counts are exact.
+ *
+ */
+static const uint32_t kStageBucketBounds[] = {1U << 4, 1U << 7, 1U << 10, 1U << 13, 1U << 16, 1U << 19, 1U << 22};
+
+static bool ParsePrefix(std::string aPrefix, otIp6Prefix &aResult)
+{
+    bool        ret = false;
+    size_t      slash;
+    in6_addr    address;
+    int         prefixLength;
+    std::string length = "64";
+
+    slash = aPrefix.find('/');
+    if (slash != std::string::npos)
+    {
+        length = aPrefix.substr(slash + 1);
+        aPrefix.resize(slash);
+    }
+
+    VerifyOrExit(inet_pton(AF_INET6, aPrefix.c_str(), &address) == 1);
+    prefixLength = atoi(length.c_str());
+    VerifyOrExit(prefixLength > 0 && prefixLength <= OT_IP6_PREFIX_BITSIZE);
+    memset(&aResult, 0, sizeof(aResult));
+    memcpy(aResult.mPrefix.mFields.m8, address.s6_addr, OT_IP6_PREFIX_SIZE);
+    aResult.mLength = static_cast<uint8_t>(prefixLength);
+    ret             = true;
+
+exit:
+    return ret;
+}
+
+static std::string Ip6AddressToString(const uint8_t *aAddress)
+{
+    char buffer[INET6_ADDRSTRLEN];
+
+    return inet_ntop(AF_INET6, aAddress, buffer, sizeof(buffer)) != NULL ? buffer : "";
+}
+
+static std::string BytesToHex(const uint8_t *aBytes, size_t aLength)
+{
+    char hex[OT_EXT_ADDRESS_SIZE * 2 + 1];
+
+    assert(aLength <= OT_EXT_ADDRESS_SIZE);
+    Utils::Bytes2Hex(aBytes, aLength, hex, sizeof(hex));
+
+    return hex;
+}
+
+static std::string Trim(const std::string &aString)
+{
+    size_t begin = aString.find_first_not_of(" \t");
+    size_t end   = aString.find_last_not_of(" \t");
+
+    return begin == std::string::npos ? "" : aString.substr(begin, end - begin + 1);
+}
+
+static JsonWriter::Encoding GetAcceptedEncoding(const std::string &aAccept)
+{
+    double      cborQuality = 0;
+    double      jsonQuality = 0;
+    size_t      begin       = 0;
+    std::string range;
+
+    // CBOR is only written to the clients asking for it, and not preferring JSON. Wildcards are answered with JSON.
+    while (begin <= aAccept.size())
+    {
+        size_t end        = std::min(aAccept.find(',', begin), aAccept.size());
+        size_t parameters = aAccept.find(';', begin);
+        size_t quality    = aAccept.find("q=", parameters);
+        double value      = (parameters < end && quality < end) ? atof(aAccept.c_str() + quality + 2) : 1;
+
+        range = Trim(aAccept.substr(begin, std::min(parameters, end) - begin));
+        if (strcasecmp(range.c_str(), "application/cbor") == 0)
+        {
+            cborQuality = value;
+        }
+        else if (strcasecmp(range.c_str(), "application/json") == 0)
+        {
+            jsonQuality = value;
+        }
+
+        begin = end + 1;
+    }
+
+    return (cborQuality > 0 && cborQuality >= jsonQuality) ? JsonWriter::kEncodingCbor : JsonWriter::kEncodingJson;
+}
+
+RestServer::RestServer(Ncp::ControllerOpenThread *aNcp)
+    : mNcp(aNcp)
+    , mListenFd(-1)
+    , mNextConnectionId(0)
+    , mMetricsTime(0)
+    , mMetricsValid(false)
+{
+}
+
+RestServer::~RestServer(void)
+{
+    for (Connection &connection : mConnections)
+    {
+        close(connection.mFd);
+    }
+
+    if (mListenFd >= 0)
+    {
+        close(mListenFd);
+    }
+}
+
+void RestServer::SetListenFd(int aFd)
+{
+    assert(mListenFd < 0);
+    mListenFd = aFd;
+}
+
+otbrError RestServer::Init(void)
+{
+    otbrError    error = OTBR_ERROR_ERRNO;
+    sockaddr_in6 address;
+    int          one = 1;
+
+    // The connections queued while the previous agent was handing over are accepted from the first main loop.
+    VerifyOrExit(mListenFd < 0, error = OTBR_ERROR_NONE);
+
+    memset(&address, 0, sizeof(address));
+    address.sin6_family = AF_INET6;
+    address.sin6_port   = htons(OTBR_CONFIG_REST_PORT);
+    VerifyOrExit(inet_pton(AF_INET6, OTBR_CONFIG_REST_ADDRESS, &address.sin6_addr) == 1, errno = EINVAL);
+
+    mListenFd = socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    VerifyOrExit(mListenFd >= 0);
+    VerifyOrExit(setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0);
+    VerifyOrExit(bind(mListenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0);
+    VerifyOrExit(listen(mListenFd, OTBR_CONFIG_REST_MAX_CONNECTIONS) == 0);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE && mListenFd >= 0)
+    {
+        close(mListenFd);
+        mListenFd = -1;
+    }
+
+    otbrLogResult("Start REST server", error);
+    return error;
+}
+
+void RestServer::UpdateFdSet(otSysMainloopContext &aMainloop) const
+{
+    unsigned long now     = GetMainloopNow();
+    unsigned long timeout = kIdleTimeout;
+
+    VerifyOrExit(mListenFd >= 0);
+
+    if (mConnections.size() < OTBR_CONFIG_REST_MAX_CONNECTIONS)
+    {
+        FD_SET(mListenFd, &aMainloop.mReadFdSet);
+        aMainloop.mMaxFd = std::max(aMainloop.mMaxFd, mListenFd);
+    }
+
+    for (const Connection &connection : mConnections)
+    {
+        if (!connection.mClose)
+        {
+            FD_SET(connection.mFd, &aMainloop.mReadFdSet);
+        }
+
+        if (!connection.mOutput.empty())
+        {
+            FD_SET(connection.mFd, &aMainloop.mWriteFdSet);
+        }
+
+        aMainloop.mMaxFd = std::max(aMainloop.mMaxFd, connection.mFd);
+
+        // A scan may take longer than the idle timeout, its connection waits for the results.
+        if (!connection.mPending)
+        {
+            unsigned long idle = std::min(now - connection.mLastActive, kIdleTimeout);
+
+            timeout = std::min(timeout, kIdleTimeout - idle);
+        }
+    }
+
+    if (!mConnections.empty() &&
+        timeout < static_cast<unsigned long>(aMainloop.mTimeout.tv_sec) * 1000 + aMainloop.mTimeout.tv_usec / 1000)
+    {
+        aMainloop.mTimeout.tv_sec  = static_cast<time_t>(timeout / 1000);
+        aMainloop.mTimeout.tv_usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
+    }
+
+exit:
+    return;
+}
+
+void RestServer::Process(const otSysMainloopContext &aMainloop)
+{
+    unsigned long now = GetMainloopNow();
+
+    VerifyOrExit(mListenFd >= 0);
+
+    if (FD_ISSET(mListenFd, &aMainloop.mReadFdSet))
+    {
+        Accept();
+    }
+
+    for (auto it = mConnections.begin(); it != mConnections.end();)
+    {
+        Connection &connection = *it;
+
+        if (FD_ISSET(connection.mFd, &aMainloop.mReadFdSet))
+        {
+            Receive(connection);
+        }
+
+        // The requests already received are also handled here once an asynchronous reply has been delivered.
+        HandleRequests(connection);
+
+        if (!connection.mOutput.empty())
+        {
+            Send(connection);
+        }
+
+        if ((connection.mClose && connection.mOutput.empty() && !connection.mPending) ||
+            (!connection.mPending && now - connection.mLastActive >= kIdleTimeout))
+        {
+            close(connection.mFd);
+            it = mConnections.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+exit:
+    return;
+}
+
+void RestServer::Accept(void)
+{
+    while (mConnections.size() < OTBR_CONFIG_REST_MAX_CONNECTIONS)
+    {
+        Connection connection;
+
+        connection.mFd = accept4(mListenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (connection.mFd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Failed to accept REST connection: %s", strerror(errno));
+            }
+            break;
+        }
+
+        connection.mId         = mNextConnectionId++;
+        connection.mLastActive = GetMainloopNow();
+        connection.mEncoding   = JsonWriter::kEncodingJson;
+        connection.mPending    = false;
+        connection.mClose      = false;
+        mConnections.push_back(connection);
+    }
+}
+
+void RestServer::Receive(Connection &aConnection)
+{
+    char    buffer[1024];
+    ssize_t rval;
+
+    while ((rval = recv(aConnection.mFd, buffer, sizeof(buffer), 0)) > 0)
+    {
+        aConnection.mInput.append(buffer, static_cast<size_t>(rval));
+        aConnection.mLastActive = GetMainloopNow();
+        VerifyOrExit(aConnection.mInput.size() <= OTBR_CONFIG_REST_MAX_REQUEST_SIZE);
+    }
+
+    if (rval == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        // The peer is gone, nothing is left to answer.
+        aConnection.mInput.clear();
+        aConnection.mOutput.clear();
+        aConnection.mPending = false;
+        aConnection.mClose   = true;
+    }
+
+exit:
+    return;
+}
+
+void RestServer::Send(Connection &aConnection)
+{
+    ssize_t rval = 0;
+
+    while (!aConnection.mOutput.empty())
+    {
+        rval = send(aConnection.mFd, aConnection.mOutput.data(), aConnection.mOutput.size(), MSG_NOSIGNAL);
+        VerifyOrExit(rval > 0);
+        aConnection.mOutput.erase(0, static_cast<size_t>(rval));
+        aConnection.mLastActive = GetMainloopNow();
+    }
+
+exit:
+    if (rval < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    {
+        aConnection.mInput.clear();
+        aConnection.mOutput.clear();
+        aConnection.mPending = false;
+        aConnection.mClose   = true;
+    }
+}
+
+void RestServer::HandleRequests(Connection &aConnection)
+{
+    // Requests are answered in order, so a pipelined request waits until the pending one is answered.
+    while (!aConnection.mPending && !aConnection.mClose)
+    {
+        size_t      headerEnd = aConnection.mInput.find(kHttpHeaderEnd);
+        size_t      lineEnd;
+        size_t      methodEnd;
+        size_t      pathEnd;
+        size_t      requestSize;
+        size_t      contentLength = 0;
+        bool        keepAlive;
+        std::string method, path, version;
+
+        // The errors found before the headers are parsed are answered in JSON.
+        aConnection.mEncoding = JsonWriter::kEncodingJson;
+
+        if (headerEnd == std::string::npos)
+        {
+            if (aConnection.mInput.size() > OTBR_CONFIG_REST_MAX_REQUEST_SIZE)
+            {
+                aConnection.mClose = true;
+                Reply(aConnection, kHttpHeaderFieldsTooLarge,
+                      GetResultResponse(OT_ERROR_NO_BUFS, aConnection.mEncoding));
+            }
+            break;
+        }
+
+        lineEnd   = aConnection.mInput.find(kHttpLineEnd);
+        methodEnd = aConnection.mInput.find(' ');
+        pathEnd   = methodEnd < lineEnd ? aConnection.mInput.find(' ', methodEnd + 1) : std::string::npos;
+
+        if (pathEnd >= lineEnd)
+        {
+            aConnection.mClose = true;
+            Reply(aConnection, kHttpBadRequest, GetResultResponse(OT_ERROR_PARSE, aConnection.mEncoding));
+            break;
+        }
+
+        method  = aConnection.mInput.substr(0, methodEnd);
+        path    = aConnection.mInput.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+        version = aConnection.mInput.substr(pathEnd + 1, lineEnd - pathEnd - 1);
+
+        if (version.compare(0, kHttpVersionPrefixLength, kHttpVersionPrefix) != 0)
+        {
+            aConnection.mClose = true;
+            Reply(aConnection, kHttpBadRequest, GetResultResponse(OT_ERROR_PARSE, aConnection.mEncoding));
+            break;
+        }
+
+        keepAlive = version != kHttpVersion10;
+
+        for (size_t begin = lineEnd + kHttpLineEndLength; begin < headerEnd;)
+        {
+            size_t      end   = aConnection.mInput.find(kHttpLineEnd, begin);
+            size_t      colon = aConnection.mInput.find(':', begin);
+            std::string name, value;
+
+            if (colon < end)
+            {
+                name  = Trim(aConnection.mInput.substr(begin, colon - begin));
+                value = Trim(aConnection.mInput.substr(colon + 1, end - colon - 1));
+
+                if (strcasecmp(name.c_str(), "Content-Length") == 0)
+                {
+                    contentLength = strtoul(value.c_str(), nullptr, 10);
+                }
+                else if (strcasecmp(name.c_str(), "Accept") == 0)
+                {
+                    aConnection.mEncoding = GetAcceptedEncoding(value);
+                }
+                else if (strcasecmp(name.c_str(), "Connection") == 0)
+                {
+                    keepAlive = strcasecmp(value.c_str(), "close") != 0 &&
+                                (keepAlive || strcasecmp(value.c_str(), "keep-alive") == 0);
+                }
+            }
+
+            begin = end + kHttpLineEndLength;
+        }
+
+        requestSize = headerEnd + kHttpHeaderEndLength + contentLength;
+        if (contentLength > OTBR_CONFIG_REST_MAX_REQUEST_SIZE || requestSize > OTBR_CONFIG_REST_MAX_REQUEST_SIZE)
+        {
+            aConnection.mClose = true;
+            Reply(aConnection, kHttpPayloadTooLarge, GetResultResponse(OT_ERROR_NO_BUFS, aConnection.mEncoding));
+            break;
+        }
+
+        if (aConnection.mInput.size() < requestSize)
+        {
+            break;
+        }
+
+        {
+            std::string body = aConnection.mInput.substr(headerEnd + kHttpHeaderEndLength, contentLength);
+
+            aConnection.mInput.erase(0, requestSize);
+            aConnection.mClose = !keepAlive;
+            HandleRequest(aConnection, method, path, body);
+        }
+    }
+}
+
+void RestServer::HandleRequest(Connection &       aConnection,
+                               const std::string &aMethod,
+                               const std::string &aPath,
+                               const std::string &aBody)
+{
+    bool        found = false;
+    std::string path  = aPath.substr(0, aPath.find('?'));
+
+    for (const Resource &resource : kResources)
+    {
+        if (path != resource.mPath)
+        {
+            continue;
+        }
+
+        found = true;
+
+        if (aMethod == resource.mMethod)
+        {
+            (this->*resource.mHandler)(aConnection, aBody);
+            ExitNow();
+        }
+    }
+
+    if (found && aMethod == kHttpMethodOptions)
+    {
+        // The preflight of a cross-origin POST with a JSON body.
+        Reply(aConnection, kHttpNoContent, "");
+    }
+    else
+    {
+        Reply(aConnection, found ? kHttpMethodNotAllowed : kHttpNotFound,
+              GetResultResponse(OT_ERROR_NOT_FOUND, aConnection.mEncoding));
+    }
+
+exit:
+    return;
+}
+
+void RestServer::Reply(Connection &       aConnection,
+                       const char *       aStatus,
+                       const std::string &aBody,
+                       const char *       aContentType)
+{
+    aConnection.mOutput += "HTTP/1.1 ";
+    aConnection.mOutput += aStatus;
+    aConnection.mOutput += "\r\nContent-Type: ";
+    aConnection.mOutput += aContentType != nullptr ? aContentType : JsonWriter::GetContentType(aConnection.mEncoding);
+    aConnection.mOutput += "\r\n"
+                           "Vary: Accept\r\n"
+                           "Access-Control-Allow-Origin: *\r\n"
+                           "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
+                           "Access-Control-Allow-Headers: Content-Type\r\n"
+                           "Content-Length: ";
+    aConnection.mOutput += std::to_string(aBody.size());
+    aConnection.mOutput += aConnection.mClose ? "\r\nConnection: close\r\n\r\n" : "\r\n\r\n";
+    aConnection.mOutput += aBody;
+    aConnection.mPending = false;
+}
+
+RestServer::Connection *RestServer::FindConnection(uint32_t aId)
+{
+    Connection *found = nullptr;
+
+    for (Connection &connection : mConnections)
+    {
+        if (connection.mId == aId)
+        {
+            found = &connection;
+            break;
+        }
+    }
+
+    return found;
+}
+
+void RestServer::HandleStatus(Connection &aConnection, const std::string &aBody)
+{
+    std::string     response;
+    JsonWriter      writer(response, aConnection.mEncoding);
+    otDeviceRole    role;
+    std::string     version, networkName;
+    otExtAddress    eui64;
+    uint8_t         channel;
+    otExtendedPanId extPanId;
+    otPanId         panId;
+    otIp6Address    meshLocalPrefixAddress;
+    otIp6Address    meshLocalEid;
+    char            panIdString[sizeof("0xffff")];
+
+    (void)aBody;
+
+    memset(&meshLocalPrefixAddress, 0, sizeof(meshLocalPrefixAddress));
+
+    // All the values are read in one call on the OpenThread thread, so they are consistent with each other.
+    mNcp->Invoke([&]() {
+        otInstance *instance = mNcp->GetInstance();
+
+        role = otThreadGetDeviceRole(instance);
+        VerifyOrExit(role != OT_DEVICE_ROLE_DISABLED && role != OT_DEVICE_ROLE_DETACHED);
+
+        version = otGetVersionString();
+        otLinkGetFactoryAssignedIeeeEui64(instance, &eui64);
+        channel     = otLinkGetChannel(instance);
+        networkName = otThreadGetNetworkName(instance);
+        extPanId    = *otThreadGetExtendedPanId(instance);
+        panId       = otLinkGetPanId(instance);
+        memcpy(meshLocalPrefixAddress.mFields.m8, otThreadGetMeshLocalPrefix(instance)->m8, OT_MESH_LOCAL_PREFIX_SIZE);
+        meshLocalEid = *otThreadGetMeshLocalEid(instance);
+
+    exit:
+        return;
+    });
+
+    writer.BeginObject().Member("error", static_cast<int>(OT_ERROR_NONE)).Key("result");
+
+    // The members are written in the order of the keys, as the web service lists them.
+    if (role == OT_DEVICE_ROLE_DISABLED || role == OT_DEVICE_ROLE_DETACHED)
+    {
+        writer.BeginObject()
+            .Member("NCP:State", otThreadDeviceRoleToString(role))
+            .Member("WPAN service", role == OT_DEVICE_ROLE_DISABLED ? "offline" : "associating")
+            .EndObject();
+    }
+    else
+    {
+        sprintf(panIdString, "0x%04x", panId);
+        writer.BeginObject()
+            .Member("IPv6:MeshLocalAddress", Ip6AddressToString(meshLocalEid.mFields.m8))
+            .Member("IPv6:MeshLocalPrefix", Ip6AddressToString(meshLocalPrefixAddress.mFields.m8) + "/64")
+            .Member("NCP:Channel", std::to_string(channel))
+            .Member("NCP:HardwareAddress", BytesToHex(eui64.m8, sizeof(eui64.m8)))
+            .Member("NCP:State", otThreadDeviceRoleToString(role))
+            .Member("NCP:Version", version)
+            .Member("Network:Name", networkName)
+            .Member("Network:NodeType", otThreadDeviceRoleToString(role))
+            .Member("Network:PANID", panIdString)
+            .Member("Network:XPANID", BytesToHex(extPanId.m8, sizeof(extPanId.m8)))
+            .Member("WPAN service", "associated")
+            .EndObject();
+    }
+
+    writer.EndObject();
+    Reply(aConnection, kHttpOk, response);
+}
+
+void RestServer::HandleAvailableNetworks(Connection &aConnection, const std::string &aBody)
+{
+    uint32_t id = aConnection.mId;
+
+    (void)aBody;
+
+    // The connection may be closed before the scan completes, so the results look it up again by its identifier.
+    aConnection.mPending = true;
+    mNcp->Invoke([this, id]() {
+        mNcp->GetThreadHelper()->Scan([this, id](otError aError, const std::vector<otActiveScanResult> &aResults) {
+            mNcp->PostToMainloop([this, id, aError, aResults]() { ReplyAvailableNetworks(id, aError, aResults); });
+        });
+    });
+}
+
+void RestServer::ReplyAvailableNetworks(uint32_t aId, otError aError, const std::vector<otActiveScanResult> &aResults)
+{
+    Connection *connection = FindConnection(aId);
+    std::string response;
+    JsonWriter  writer(response, connection != nullptr ? connection->mEncoding : JsonWriter::kEncodingJson);
+
+    VerifyOrExit(connection != nullptr && connection->mPending);
+
+    if (aError == OT_ERROR_NONE && aResults.empty())
+    {
+        aError = OT_ERROR_NOT_FOUND;
+    }
+
+    writer.BeginObject().Member("error", static_cast<int>(aError)).Key("result");
+
+    if (aError != OT_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "REST scan error: %s", otThreadErrorToString(aError));
+        writer.Value(REST_RESPONSE_FAILURE);
+    }
+    else
+    {
+        writer.BeginArray();
+        for (const otActiveScanResult &network : aResults)
+        {
+            char panId[sizeof("0xFFFF")];
+
+            sprintf(panId, "0x%X", network.mPanId);
+            writer.BeginObject()
+                .Member("ch", static_cast<int>(network.mChannel))
+                .Member("ha", BytesToHex(network.mExtAddress.m8, sizeof(network.mExtAddress.m8)))
+                .Member("nn", network.mNetworkName.m8)
+                .Member("pi", panId)
+                .Member("xp", BytesToHex(network.mExtendedPanId.m8, sizeof(network.mExtendedPanId.m8)))
+                .EndObject();
+        }
+        writer.EndArray();
+    }
+
+    writer.EndObject();
+    Reply(*connection, kHttpOk, response);
+
+exit:
+    return;
+}
+
+void RestServer::HandleAddPrefix(Connection &aConnection, const std::string &aBody)
+{
+    otError              error = OT_ERROR_NONE;
+    std::string          prefix;
+    bool                 defaultRoute;
+    otBorderRouterConfig config;
+
+    memset(&config, 0, sizeof(config));
+    VerifyOrExit(JsonReader().Bind("prefix", prefix).Bind("defaultRoute", defaultRoute).Parse(aBody),
+                 error = OT_ERROR_PARSE);
+    VerifyOrExit(ParsePrefix(prefix, config.mPrefix), error = OT_ERROR_INVALID_ARGS);
+
+    // The same flags as "prefix add <prefix> paso[r]" of the CLI.
+    config.mPreferred    = true;
+    config.mSlaac        = true;
+    config.mDefaultRoute = defaultRoute;
+    config.mOnMesh       = true;
+    config.mStable       = true;
+
+    mNcp->Invoke([this, &config, &error]() {
+        SuccessOrExit(error = otBorderRouterAddOnMeshPrefix(mNcp->GetInstance(), &config));
+        error = otBorderRouterRegister(mNcp->GetInstance());
+
+    exit:
+        return;
+    });
+
+exit:
+    Reply(aConnection, kHttpOk, GetResultResponse(error, aConnection.mEncoding));
+}
+
+void RestServer::HandleDeletePrefix(Connection &aConnection, const std::string &aBody)
+{
+    otError     error = OT_ERROR_NONE;
+    std::string prefix;
+    otIp6Prefix ip6Prefix;
+
+    VerifyOrExit(JsonReader().Bind("prefix", prefix).Parse(aBody), error = OT_ERROR_PARSE);
+    VerifyOrExit(ParsePrefix(prefix, ip6Prefix), error = OT_ERROR_INVALID_ARGS);
+
+    mNcp->Invoke([this, &ip6Prefix, &error]() {
+        SuccessOrExit(error = otBorderRouterRemoveOnMeshPrefix(mNcp->GetInstance(), &ip6Prefix));
+        error = otBorderRouterRegister(mNcp->GetInstance());
+
+    exit:
+        return;
+    });
+
+exit:
+    Reply(aConnection, kHttpOk, GetResultResponse(error, aConnection.mEncoding));
+}
+
+void RestServer::HandleMetrics(Connection &aConnection, const std::string &aBody)
+{
+    unsigned long now = GetMainloopNow();
+
+    (void)aBody;
+
+    if (!mMetricsValid || now - mMetricsTime >= kMetricsMaxAge)
+    {
+        RenderMetrics(mMetrics);
+        mMetricsTime  = now;
+        mMetricsValid = true;
+    }
+
+    Reply(aConnection, kHttpOk, mMetrics, MetricsWriter::kContentType);
+}
+
+void RestServer::RenderMetrics(std::string &aOutput)
+{
+    static const otDeviceRole kRoles[] = {OT_DEVICE_ROLE_DISABLED, OT_DEVICE_ROLE_DETACHED, OT_DEVICE_ROLE_CHILD,
+                                          OT_DEVICE_ROLE_ROUTER, OT_DEVICE_ROLE_LEADER};
+
+    MetricsWriter               writer(aOutput);
+    otDeviceRole                role;
+    uint32_t                    partitionId;
+    uint16_t                    rloc16;
+    uint8_t                     channel;
+    uint16_t                    ccaFailureRate;
+    otMacCounters               macCounters;
+    otIpCounters                ip6Counters;
+    std::vector<otNeighborInfo> neighbors;
+    size_t                      children = 0;
+
+    // All the values are read in one call on the OpenThread thread, so they are consistent with each other.
+    mNcp->Invoke([&]() {
+        otInstance *           instance = mNcp->GetInstance();
+        otNeighborInfoIterator iterator = OT_NEIGHBOR_INFO_ITERATOR_INIT;
+        otNeighborInfo         neighbor;
+
+        role           = otThreadGetDeviceRole(instance);
+        partitionId    = otThreadGetPartitionId(instance);
+        rloc16         = otThreadGetRloc16(instance);
+        channel        = otLinkGetChannel(instance);
+        ccaFailureRate = otLinkGetCcaFailureRate(instance);
+        macCounters    = *otLinkGetCounters(instance);
+        ip6Counters    = *otThreadGetIp6Counters(instance);
+
+        while (otThreadGetNextNeighborInfo(instance, &iterator, &neighbor) == OT_ERROR_NONE)
+        {
+            neighbors.push_back(neighbor);
+        }
+    });
+
+    writer.Family("otbr_thread_role", MetricsWriter::kTypeGauge, "Whether the Thread device has the role.");
+    for (otDeviceRole value : kRoles)
+    {
+        writer.Label("role", otThreadDeviceRoleToString(value)).Value(static_cast<uint64_t>(value == role));
+    }
+
+    writer.Family("otbr_thread_partition_id", MetricsWriter::kTypeGauge, "The Thread partition ID.")
+        .Value(static_cast<uint64_t>(partitionId));
+    writer.Family("otbr_thread_rloc16", MetricsWriter::kTypeGauge, "The RLOC16 of the Thread device.")
+        .Value(static_cast<uint64_t>(rloc16));
+    writer.Family("otbr_link_channel", MetricsWriter::kTypeGauge, "The IEEE 802.15.4 channel.")
+        .Value(static_cast<uint64_t>(channel));
+    writer
+        .Family("otbr_link_cca_failure_ratio", MetricsWriter::kTypeGauge,
+                "The share of the recent CCA attempts which failed.")
+        .Value(static_cast<double>(ccaFailureRate) / 0xffff);
+
+    for (const auto &counter : kMacCounters)
+    {
+        uint32_t value;
+
+        memcpy(&value, reinterpret_cast<const uint8_t *>(&macCounters) + counter.mOffset, sizeof(value));
+        writer.Family(counter.mName, MetricsWriter::kTypeCounter, counter.mHelp).Value(static_cast<uint64_t>(value));
+    }
+
+    writer.Family("otbr_ip6_tx_success_total", MetricsWriter::kTypeCounter, "IPv6 packets sent.")
+        .Value(static_cast<uint64_t>(ip6Counters.mTxSuccess));
+    writer.Family("otbr_ip6_tx_failure_total", MetricsWriter::kTypeCounter, "IPv6 packets failed to be sent.")
+        .Value(static_cast<uint64_t>(ip6Counters.mTxFailure));
+    writer.Family("otbr_ip6_rx_success_total", MetricsWriter::kTypeCounter, "IPv6 packets received.")
+        .Value(static_cast<uint64_t>(ip6Counters.mRxSuccess));
+    writer.Family("otbr_ip6_rx_failure_total", MetricsWriter::kTypeCounter, "IPv6 packets failed to be received.")
+        .Value(static_cast<uint64_t>(ip6Counters.mRxFailure));
+
+    for (const otNeighborInfo &neighbor : neighbors)
+    {
+        children += neighbor.mIsChild;
+    }
+
+    writer.Family("otbr_thread_neighbors", MetricsWriter::kTypeGauge, "The routers and children in the neighbor table.")
+        .Label("type", "router")
+        .Value(static_cast<uint64_t>(neighbors.size() - children))
+        .Label("type", "child")
+        .Value(static_cast<uint64_t>(children));
+
+    // The neighbors are labeled by their extended address, which is stable across RLOC16 changes.
+    writer.Family("otbr_neighbor_average_rssi_dbm", MetricsWriter::kTypeGauge, "The average RSSI of the neighbor.");
+    for (const otNeighborInfo &neighbor : neighbors)
+    {
+        writer.Label("ext_address", BytesToHex(neighbor.mExtAddress.m8, sizeof(neighbor.mExtAddress.m8)))
+            .Value(static_cast<int64_t>(neighbor.mAverageRssi));
+    }
+
+    writer.Family("otbr_neighbor_link_quality_in", MetricsWriter::kTypeGauge,
+                  "The incoming link quality from the neighbor, from 0 to 3.");
+    for (const otNeighborInfo &neighbor : neighbors)
+    {
+        writer.Label("ext_address", BytesToHex(neighbor.mExtAddress.m8, sizeof(neighbor.mExtAddress.m8)))
+            .Value(static_cast<uint64_t>(neighbor.mLinkQualityIn));
+    }
+
+    writer.Family("otbr_neighbor_frame_error_ratio", MetricsWriter::kTypeGauge,
+                  "The share of the recent frames to the neighbor which failed.");
+    for (const otNeighborInfo &neighbor : neighbors)
+    {
+        writer.Label("ext_address", BytesToHex(neighbor.mExtAddress.m8, sizeof(neighbor.mExtAddress.m8)))
+            .Value(static_cast<double>(neighbor.mFrameErrorRate) / 0xffff);
+    }
+
+    writer.Family("otbr_neighbor_message_error_ratio", MetricsWriter::kTypeGauge,
+                  "The share of the recent messages to the neighbor which failed.");
+    for (const otNeighborInfo &neighbor : neighbors)
+    {
+        writer.Label("ext_address", BytesToHex(neighbor.mExtAddress.m8, sizeof(neighbor.mExtAddress.m8)))
+            .Value(static_cast<double>(neighbor.mMessageErrorRate) / 0xffff);
+    }
+
+    writer.Family("otbr_mainloop_wakeups_total", MetricsWriter::kTypeCounter, "Returns of the main loop from polling.")
+        .Value(GetMainloopCounters().mWakeups);
+    writer
+        .Family("otbr_mainloop_zero_timeout_polls_total", MetricsWriter::kTypeCounter,
+                "Polls of the main loop entered with a zero timeout.")
+        .Value(GetMainloopCounters().mZeroTimeoutPolls);
+    writer
+        .Family("otbr_mainloop_spurious_wakeups_total", MetricsWriter::kTypeCounter,
+                "Wakeups of the main loop with neither a ready fd nor a due timer.")
+        .Value(GetMainloopCounters().mSpuriousWakeups);
+
+    writer.Family("otbr_mainloop_stage_seconds", MetricsWriter::kTypeHistogram,
+                  "The durations of the main loop stages.");
+    for (int i = 0; i < kMainloopStageNum; i++)
+    {
+        MainloopStage    stage     = static_cast<MainloopStage>(i);
+        const Histogram &histogram = GetMainloopHistogram(stage);
+        const char *     name      = GetMainloopStageName(stage);
+        uint64_t         count     = 0;
+        uint8_t          index     = 0;
+
+        for (uint32_t bound : kStageBucketBounds)
+        {
+            for (; index < Histogram::kBuckets && Histogram::GetBucketLowerBound(index) < bound; index++)
+            {
+                count += histogram.GetBucketCount(index);
+            }
+
+            writer.Label("stage", name).Label("le", std::to_string(bound / 1e6)).Value("_bucket", count);
+        }
+
+        for (; index < Histogram::kBuckets; index++)
+        {
+            count += histogram.GetBucketCount(index);
+        }
+
+        // The count is the sum of the buckets rather than the separate total, so that it matches the +Inf bucket.
+        writer.Label("stage", name).Label("le", "+Inf").Value("_bucket", count);
+        writer.Label("stage", name).Value("_sum", histogram.GetSum() / 1e6);
+        writer.Label("stage", name).Value("_count", count);
+    }
+
+    writer.Family("otbr_memory_bytes", MetricsWriter::kTypeGauge, "The heap memory allocated by the subsystem.");
+    for (int i = 0; i < kMemoryTagNum; i++)
+    {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+
+        writer.Label("subsystem", GetMemoryTagName(tag)).Value(GetMemoryCounters(tag).mBytes);
+    }
+
+    writer.Family("otbr_memory_peak_bytes", MetricsWriter::kTypeGauge,
+                  "The largest heap memory allocated by the subsystem at once.");
+    for (int i = 0; i < kMemoryTagNum; i++)
+    {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+
+        writer.Label("subsystem", GetMemoryTagName(tag)).Value(GetMemoryCounters(tag).mPeakBytes);
+    }
+
+    writer.Family("otbr_memory_allocations_total", MetricsWriter::kTypeCounter,
+                  "The heap allocations ever made by the subsystem.");
+    for (int i = 0; i < kMemoryTagNum; i++)
+    {
+        MemoryTag tag = static_cast<MemoryTag>(i);
+
+        writer.Label("subsystem", GetMemoryTagName(tag)).Value(GetMemoryCounters(tag).mTotalAllocations);
+    }
+}
+
+std::string RestServer::GetResultResponse(otError aError, JsonWriter::Encoding aEncoding)
+{
+    std::string response;
+
+    if (aError != OT_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "REST request error: %s", otThreadErrorToString(aError));
+    }
+
+    JsonWriter(response, aEncoding)
+        .BeginObject()
+        .Member("error", static_cast<int>(aError))
+        .Member("result", aError == OT_ERROR_NONE ? REST_RESPONSE_SUCCESS : REST_RESPONSE_FAILURE)
+        .EndObject();
+
+    return response;
+}
+
+} // namespace Rest
+} // namespace otbr
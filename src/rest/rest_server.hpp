@@ -0,0 +1,192 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the REST server hosted by the agent.
+ */
+
+#ifndef OTBR_REST_REST_SERVER_HPP_
+#define OTBR_REST_REST_SERVER_HPP_
+
+#include "openthread-br/config.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <openthread/link.h>
+#include <openthread/openthread-system.h>
+
+#include "common/types.hpp"
+#include "web/web-service/json.hpp"
+
+namespace otbr {
+namespace Ncp {
+class ControllerOpenThread;
+}
+
+namespace Rest {
+
+/**
+ * This class implements the JSON API of otbr-web directly on the agent's main loop.
+ *
+ * The status, scan and on-mesh prefix requests are answered from the OpenThread instance of the agent, without the
+ * web process and its D-Bus round trips in between. Connections are non-blocking and kept alive between requests, a
+ * scan holds its connection until the results are delivered back to the main loop.
+ *
+ * The `/metrics` resource renders the counters, gauges and histograms of the agent in the Prometheus text format
+ * from a snapshot cached for OTBR_CONFIG_REST_METRICS_MAX_AGE, so that the cost of scraping does not grow with the
+ * number of scrapers.
+ *
+ */
+class RestServer
+{
+public:
+    /**
+     * The constructor of a REST server.
+     *
+     * @param[in]   aNcp    A pointer to the OpenThread controller.
+     *
+     */
+    explicit RestServer(Ncp::ControllerOpenThread *aNcp);
+
+    /**
+     * The destructor of a REST server, which closes all the connections.
+     *
+     */
+    ~RestServer(void);
+
+    /**
+     * This method starts listening on OTBR_CONFIG_REST_ADDRESS and OTBR_CONFIG_REST_PORT.
+     *
+     * The socket set by SetListenFd() is used instead, if any.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started listening.
+     * @retval  OTBR_ERROR_ERRNO    Failed to listen, errno is set.
+     *
+     */
+    otbrError Init(void);
+
+    /**
+     * This method sets the socket to accept connections on, e.g. the one of the agent this one replaces.
+     *
+     * It is called before Init().
+     *
+     * @param[in]   aFd     A non-blocking listening socket, owned by the server from now on.
+     *
+     */
+    void SetListenFd(int aFd);
+
+    /**
+     * This method returns the socket the server accepts connections on.
+     *
+     * @returns The socket, -1 if the server is not listening.
+     *
+     */
+    int GetListenFd(void) const { return mListenFd; }
+
+    /**
+     * This method updates the file descriptor sets and timeout for mainloop.
+     *
+     * @param[inout]    aMainloop   A reference to OpenThread mainloop context.
+     *
+     */
+    void UpdateFdSet(otSysMainloopContext &aMainloop) const;
+
+    /**
+     * This method accepts connections, and reads, handles and answers their requests.
+     *
+     * @param[in]       aMainloop   A reference to OpenThread mainloop context.
+     *
+     */
+    void Process(const otSysMainloopContext &aMainloop);
+
+private:
+    struct Connection
+    {
+        int                       mFd;
+        uint32_t                  mId;         ///< The identifier asynchronous replies find the connection with.
+        std::string               mInput;      ///< The bytes received and not handled yet.
+        std::string               mOutput;     ///< The bytes of the responses not sent yet.
+        unsigned long             mLastActive; ///< The main loop time of the last I/O, in milliseconds.
+        Web::JsonWriter::Encoding mEncoding;   ///< The encoding the request being handled accepts.
+        bool                      mPending;    ///< Whether a request waits for an asynchronous reply.
+        bool                      mClose;      ///< Whether to close once the output is sent.
+    };
+
+    typedef void (RestServer::*Handler)(Connection &aConnection, const std::string &aBody);
+
+    struct Resource
+    {
+        const char *mMethod;
+        const char *mPath;
+        Handler     mHandler;
+    };
+
+    static const Resource kResources[];
+
+    void        Accept(void);
+    void        Receive(Connection &aConnection);
+    void        Send(Connection &aConnection);
+    void        HandleRequests(Connection &aConnection);
+    void        HandleRequest(Connection &       aConnection,
+                              const std::string &aMethod,
+                              const std::string &aPath,
+                              const std::string &aBody);
+    void        Reply(Connection &       aConnection,
+                      const char *       aStatus,
+                      const std::string &aBody,
+                      const char *       aContentType = nullptr);
+    Connection *FindConnection(uint32_t aId);
+
+    void HandleStatus(Connection &aConnection, const std::string &aBody);
+    void HandleAvailableNetworks(Connection &aConnection, const std::string &aBody);
+    void HandleAddPrefix(Connection &aConnection, const std::string &aBody);
+    void HandleDeletePrefix(Connection &aConnection, const std::string &aBody);
+    void HandleMetrics(Connection &aConnection, const std::string &aBody);
+    void ReplyAvailableNetworks(uint32_t aId, otError aError, const std::vector<otActiveScanResult> &aResults);
+    void RenderMetrics(std::string &aOutput);
+
+    static std::string GetResultResponse(otError aError, Web::JsonWriter::Encoding aEncoding);
+
+    Ncp::ControllerOpenThread *mNcp;
+    int                        mListenFd;
+    uint32_t                   mNextConnectionId;
+    std::list<Connection>      mConnections;
+    std::string                mMetrics;
+    unsigned long              mMetricsTime;
+    bool                       mMetricsValid;
+};
+
+} // namespace Rest
+} // namespace otbr
+
+#endif // OTBR_REST_REST_SERVER_HPP_
@@ -0,0 +1,108 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the statistics of the EID-to-RLOC address cache.
+ */
+
+#include "utils/address_cache_stats.hpp"
+
+#include <algorithm>
+
+namespace otbr {
+
+AddressCacheStats::AddressCacheStats(void)
+    : mCounters()
+    , mSampled(false)
+{
+}
+
+const AddressCacheStats::Entry *AddressCacheStats::FindEntry(
+    const std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> &aTarget,
+    const std::vector<Entry> &                        aEntries)
+{
+    auto entry = std::find_if(aEntries.begin(), aEntries.end(),
+                              [&aTarget](const Entry &aEntry) { return aEntry.mTarget == aTarget; });
+
+    return entry != aEntries.end() ? &*entry : nullptr;
+}
+
+void AddressCacheStats::Sample(std::vector<Entry> aEntries)
+{
+    if (mSampled)
+    {
+        for (const Entry &entry : aEntries)
+        {
+            const Entry *old         = FindEntry(entry.mTarget, mEntries);
+            bool         wasQuerying = (old != nullptr && IsQuerying(old->mState));
+
+            if (IsQuerying(entry.mState))
+            {
+                if (!wasQuerying)
+                {
+                    mCounters.mQueries++;
+                }
+                if (entry.mState == kStateRetryQuery && (old == nullptr || old->mState != kStateRetryQuery))
+                {
+                    mCounters.mFailures++;
+                }
+            }
+            else if (wasQuerying)
+            {
+                mCounters.mResponses++;
+            }
+            else if (old == nullptr && entry.mState == kStateCached)
+            {
+                // The query was started and answered between the samples.
+                mCounters.mQueries++;
+                mCounters.mResponses++;
+            }
+        }
+
+        for (const Entry &old : mEntries)
+        {
+            if (!IsQuerying(old.mState) && FindEntry(old.mTarget, aEntries) == nullptr)
+            {
+                mCounters.mEvictions++;
+            }
+        }
+    }
+
+    mCounters.mPeakSize = std::max(mCounters.mPeakSize, static_cast<uint32_t>(aEntries.size()));
+    mEntries.swap(aEntries);
+    mSampled = true;
+}
+
+void AddressCacheStats::Restart(void)
+{
+    mEntries.clear();
+    mSampled = false;
+}
+
+} // namespace otbr
@@ -0,0 +1,145 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the statistics of the EID-to-RLOC address cache.
+ */
+
+#ifndef OTBR_UTILS_ADDRESS_CACHE_STATS_HPP_
+#define OTBR_UTILS_ADDRESS_CACHE_STATS_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class derives the activity of the EID-to-RLOC address cache from samples of its entries.
+ *
+ * OpenThread does not count the address queries it sends, so they are told from the state changes of the entries
+ * between two samples. A query answered and evicted within one sample interval is not seen, so the counters are a
+ * lower bound which gets closer with shorter intervals.
+ *
+ */
+class AddressCacheStats
+{
+public:
+    /**
+     * The states of a cache entry.
+     *
+     */
+    enum State
+    {
+        kStateCached,     ///< The RLOC16 is known from an address notification.
+        kStateSnooped,    ///< The RLOC16 is learned from a received frame.
+        kStateQuery,      ///< An address query is in progress.
+        kStateRetryQuery, ///< An address query failed, and is retried after a delay.
+    };
+
+    /**
+     * This structure represents a cache entry.
+     *
+     */
+    struct Entry
+    {
+        std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> mTarget; ///< The EID.
+        uint16_t                                   mRloc16; ///< The RLOC16 of the EID, if not querying.
+        State                                      mState;  ///< The entry state.
+    };
+
+    /**
+     * This structure represents the counters of the cache activity.
+     *
+     */
+    struct Counters
+    {
+        uint32_t mQueries;   ///< The address queries started.
+        uint32_t mResponses; ///< The address queries answered by an address notification.
+        uint32_t mFailures;  ///< The address queries which had no answer in time.
+        uint32_t mEvictions; ///< The resolved entries removed, to make room for others or as stale.
+        uint32_t mPeakSize;  ///< The largest number of entries seen.
+    };
+
+    /**
+     * The constructor initializes an empty cache with zero counters.
+     *
+     */
+    AddressCacheStats(void);
+
+    /**
+     * This method updates the counters from a new sample of the cache entries.
+     *
+     * @param[in]   aEntries    The entries now in the cache, the first sample only sets the reference.
+     *
+     */
+    void Sample(std::vector<Entry> aEntries);
+
+    /**
+     * This method restarts sampling a new cache, keeping the counters.
+     *
+     * The next sample only sets the reference, so that the entries of the previous cache are not counted as evicted.
+     *
+     */
+    void Restart(void);
+
+    /**
+     * This method returns the cache entries of the last sample.
+     *
+     * @returns The cache entries.
+     *
+     */
+    const std::vector<Entry> &GetEntries(void) const { return mEntries; }
+
+    /**
+     * This method returns the counters of the cache activity.
+     *
+     * @returns The counters.
+     *
+     */
+    const Counters &GetCounters(void) const { return mCounters; }
+
+private:
+    static bool         IsQuerying(State aState) { return aState == kStateQuery || aState == kStateRetryQuery; }
+    static const Entry *FindEntry(const std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> &aTarget,
+                                  const std::vector<Entry> &                        aEntries);
+
+    std::vector<Entry> mEntries;
+    Counters           mCounters;
+    bool               mSampled;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_ADDRESS_CACHE_STATS_HPP_
@@ -0,0 +1,127 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the per-channel congestion scores.
+ */
+
+#include "utils/channel_quality.hpp"
+
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+/**
+ * The weight of a new sample is 1 / 2^kSampleWeightShift.
+ *
+ */
+static constexpr uint8_t kSampleWeightShift = 2;
+
+/**
+ * Channels scoring less than this above the best channel are as good as the best one.
+ *
+ */
+static constexpr uint16_t kScoreTolerance = ChannelQuality::kMaxScore / 16;
+
+/**
+ * The maximum RSSI of an idle channel, and of a channel that is always busy, in dBm.
+ *
+ */
+static constexpr int kIdleRssi = -100;
+static constexpr int kBusyRssi = -40;
+
+ChannelQuality::ChannelQuality(void)
+    : mScoredChannels(0)
+{
+    memset(mScores, 0, sizeof(mScores));
+}
+
+void ChannelQuality::AddOccupancy(uint8_t aChannel, uint16_t aOccupancy)
+{
+    AddSample(aChannel, aOccupancy);
+}
+
+void ChannelQuality::AddEnergy(uint8_t aChannel, int8_t aMaxRssi)
+{
+    int rssi = aMaxRssi < kIdleRssi ? kIdleRssi : (aMaxRssi > kBusyRssi ? kBusyRssi : aMaxRssi);
+
+    AddSample(aChannel, static_cast<uint16_t>((rssi - kIdleRssi) * kMaxScore / (kBusyRssi - kIdleRssi)));
+}
+
+void ChannelQuality::AddSample(uint8_t aChannel, uint16_t aScore)
+{
+    VerifyOrExit(aChannel < kMaxChannels);
+
+    if (HasScore(aChannel))
+    {
+        int32_t score = mScores[aChannel];
+
+        score += (static_cast<int32_t>(aScore) - score) / (1 << kSampleWeightShift);
+        mScores[aChannel] = static_cast<uint16_t>(score);
+    }
+    else
+    {
+        mScores[aChannel] = aScore;
+        mScoredChannels |= (1U << aChannel);
+    }
+
+exit:
+    return;
+}
+
+uint32_t ChannelQuality::GetLeastCongestedChannels(uint32_t aChannelMask) const
+{
+    uint32_t scored   = aChannelMask & mScoredChannels;
+    uint32_t best     = 0;
+    uint32_t minScore = kMaxScore;
+
+    VerifyOrExit(scored != 0, best = aChannelMask);
+
+    for (uint8_t i = 0; i < kMaxChannels; i++)
+    {
+        if ((scored & (1U << i)) && mScores[i] < minScore)
+        {
+            minScore = mScores[i];
+        }
+    }
+
+    for (uint8_t i = 0; i < kMaxChannels; i++)
+    {
+        if ((scored & (1U << i)) && mScores[i] <= minScore + kScoreTolerance)
+        {
+            best |= (1U << i);
+        }
+    }
+
+exit:
+    return best;
+}
+
+} // namespace otbr
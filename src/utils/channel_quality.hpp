@@ -0,0 +1,125 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions of the per-channel congestion scores.
+ */
+
+#ifndef OTBR_UTILS_CHANNEL_QUALITY_HPP_
+#define OTBR_UTILS_CHANNEL_QUALITY_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class aggregates RF samples into a congestion score for each channel.
+ *
+ * The score of a channel is an exponentially weighted moving average of its samples, from 0 for an idle channel to
+ * `kMaxScore` for a channel that is always busy, so that older samples decay as new ones arrive.
+ *
+ */
+class ChannelQuality
+{
+public:
+    enum
+    {
+        kMaxChannels = 32,     ///< The number of channels, as the bits of a channel mask.
+        kMaxScore    = 0xffff, ///< The score of a channel that is always busy.
+    };
+
+    /**
+     * The constructor initializes all channels without a score.
+     *
+     */
+    ChannelQuality(void);
+
+    /**
+     * This method adds a channel monitor sample.
+     *
+     * @param[in]   aChannel    The channel.
+     * @param[in]   aOccupancy  The occupancy, as the fraction of busy samples from 0 to 0xffff.
+     *
+     */
+    void AddOccupancy(uint8_t aChannel, uint16_t aOccupancy);
+
+    /**
+     * This method adds an energy scan sample.
+     *
+     * @param[in]   aChannel    The channel.
+     * @param[in]   aMaxRssi    The maximum RSSI in dBm seen on the channel.
+     *
+     */
+    void AddEnergy(uint8_t aChannel, int8_t aMaxRssi);
+
+    /**
+     * This method indicates whether a channel has been sampled.
+     *
+     * @param[in]   aChannel    The channel.
+     *
+     * @retval  true    The channel has a score.
+     * @retval  false   The channel has never been sampled.
+     *
+     */
+    bool HasScore(uint8_t aChannel) const { return aChannel < kMaxChannels && (mScoredChannels & (1U << aChannel)); }
+
+    /**
+     * This method returns the score of a channel.
+     *
+     * @param[in]   aChannel    The channel, which must have a score.
+     *
+     * @returns The congestion score.
+     *
+     */
+    uint16_t GetScore(uint8_t aChannel) const { return mScores[aChannel]; }
+
+    /**
+     * This method returns the least congested channels of a channel mask.
+     *
+     * Channels scoring close to the best one are included too, so that neighbouring networks picking a channel at
+     * the same time do not all pick the same one.
+     *
+     * @param[in]   aChannelMask  The channels to choose from.
+     *
+     * @returns The mask of the least congested channels, or @p aChannelMask if none of them has a score.
+     *
+     */
+    uint32_t GetLeastCongestedChannels(uint32_t aChannelMask) const;
+
+private:
+    void AddSample(uint8_t aChannel, uint16_t aScore);
+
+    uint16_t mScores[kMaxChannels];
+    uint32_t mScoredChannels;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_CHANNEL_QUALITY_HPP_
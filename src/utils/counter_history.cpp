@@ -0,0 +1,169 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the history of a monotonic counter.
+ */
+
+#include "utils/counter_history.hpp"
+
+#include <errno.h>
+
+#include <algorithm>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+CounterHistory::Ring::Ring(uint16_t aSize)
+    : mIntervals(aSize)
+    , mNext(0)
+    , mLength(0)
+{
+}
+
+void CounterHistory::Ring::Push(const Interval &aInterval)
+{
+    mIntervals[mNext] = aInterval;
+    mNext             = static_cast<uint16_t>((mNext + 1) % mIntervals.size());
+
+    if (!IsFull())
+    {
+        mLength++;
+    }
+}
+
+const CounterHistory::Interval &CounterHistory::Ring::GetRecent(uint16_t aAge) const
+{
+    return mIntervals[(mNext + mIntervals.size() - 1 - aAge) % mIntervals.size()];
+}
+
+CounterHistory::CounterHistory(uint16_t aFineSlots, uint16_t aCoarseSlots, uint16_t aCoarseRatio)
+    : mFine(aFineSlots)
+    , mCoarse(aCoarseSlots)
+    , mCoarseRatio(aCoarseRatio)
+    , mCoarsePending{0, 0}
+    , mCoarsePendingCount(0)
+    , mHasBaseline(false)
+    , mLastTime(0)
+    , mLastValue(0)
+{
+}
+
+void CounterHistory::Sample(uint64_t aNow, uint32_t aValue)
+{
+    Interval interval;
+
+    VerifyOrExit(mHasBaseline);
+    VerifyOrExit(aNow > mLastTime);
+
+    interval.mDelta    = (aValue >= mLastValue) ? aValue - mLastValue : aValue;
+    interval.mDuration = static_cast<uint32_t>(std::min<uint64_t>(aNow - mLastTime, UINT32_MAX));
+    mFine.Push(interval);
+
+    mCoarsePending.mDelta += interval.mDelta;
+    mCoarsePending.mDuration += interval.mDuration;
+
+    if (++mCoarsePendingCount == mCoarseRatio)
+    {
+        mCoarse.Push(mCoarsePending);
+        mCoarsePending      = {0, 0};
+        mCoarsePendingCount = 0;
+    }
+
+exit:
+    mHasBaseline = true;
+    mLastTime    = aNow;
+    mLastValue   = aValue;
+}
+
+otbrError CounterHistory::GetRates(uint32_t aWindow, Rates &aRates) const
+{
+    otbrError error = OTBR_ERROR_NONE;
+
+    VerifyOrExit(mFine.GetLength() > 0, errno = EAGAIN, error = OTBR_ERROR_ERRNO);
+
+    ComputeRates(mFine, aWindow, aRates);
+
+    // The coarse ring only helps once it goes back further than the fine one.
+    if (aRates.mWindow < aWindow && mCoarse.GetLength() > 0)
+    {
+        Rates coarse;
+
+        ComputeRates(mCoarse, aWindow, coarse);
+
+        if (coarse.mWindow > aRates.mWindow)
+        {
+            aRates = coarse;
+        }
+    }
+
+exit:
+    return error;
+}
+
+uint32_t CounterHistory::ComputeRate(uint64_t aDelta, uint64_t aDuration)
+{
+    // Thousandths of events per second, from a duration in milliseconds.
+    return static_cast<uint32_t>(std::min<uint64_t>(aDelta * 1000000 / aDuration, UINT32_MAX));
+}
+
+void CounterHistory::ComputeRates(const Ring &aRing, uint32_t aWindow, Rates &aRates)
+{
+    std::vector<uint32_t> rates;
+    uint64_t              duration = 0;
+    uint64_t              delta    = 0;
+    size_t                count;
+
+    // Always take the most recent interval, so that a zero window returns the current rates.
+    for (uint16_t age = 0; age < aRing.GetLength() && (age == 0 || duration < aWindow); age++)
+    {
+        const Interval &interval = aRing.GetRecent(age);
+
+        duration += interval.mDuration;
+        delta += interval.mDelta;
+        rates.push_back(ComputeRate(interval.mDelta, interval.mDuration));
+    }
+
+    std::sort(rates.begin(), rates.end());
+    count = rates.size();
+
+    aRates.mWindow = static_cast<uint32_t>(std::min<uint64_t>(duration, UINT32_MAX));
+    aRates.mDelta  = delta;
+    aRates.mMean   = ComputeRate(delta, duration);
+    aRates.mMin    = rates.front();
+    aRates.mMax    = rates.back();
+
+    // Nearest-rank percentiles.
+    aRates.mP50 = rates[(count * 50 + 99) / 100 - 1];
+    aRates.mP90 = rates[(count * 90 + 99) / 100 - 1];
+    aRates.mP99 = rates[(count * 99 + 99) / 100 - 1];
+}
+
+} // namespace otbr
@@ -0,0 +1,158 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the history of a monotonic counter.
+ */
+
+#ifndef OTBR_UTILS_COUNTER_HISTORY_HPP_
+#define OTBR_UTILS_COUNTER_HISTORY_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class keeps the recent history of a monotonic counter in two rings of per-interval deltas.
+ *
+ * The fine ring keeps every sample interval, and the coarse ring keeps the sum of a fixed number of fine intervals,
+ * so that a long history is kept at a lower resolution with bounded memory.
+ *
+ */
+class CounterHistory
+{
+public:
+    /**
+     * This structure represents the rates of a counter over a window.
+     *
+     * The rates are in thousandths of events per second, so that low rates are not rounded down to zero.
+     *
+     */
+    struct Rates
+    {
+        uint32_t mWindow; ///< The duration covered by the history, in milliseconds.
+        uint64_t mDelta;  ///< The increase of the counter over the window.
+        uint32_t mMean;   ///< The mean rate over the window.
+        uint32_t mMin;    ///< The lowest rate of an interval.
+        uint32_t mMax;    ///< The highest rate of an interval.
+        uint32_t mP50;    ///< The median rate of the intervals.
+        uint32_t mP90;    ///< The 90th percentile rate of the intervals.
+        uint32_t mP99;    ///< The 99th percentile rate of the intervals.
+    };
+
+    /**
+     * The constructor initializes an empty history.
+     *
+     * @param[in]   aFineSlots      The number of intervals in the fine ring.
+     * @param[in]   aCoarseSlots    The number of intervals in the coarse ring.
+     * @param[in]   aCoarseRatio    The number of fine intervals in each coarse interval.
+     *
+     */
+    CounterHistory(uint16_t aFineSlots, uint16_t aCoarseSlots, uint16_t aCoarseRatio);
+
+    /**
+     * This method adds a sample of the counter.
+     *
+     * The first sample after construction or Restart() is only the baseline of the next interval. A counter lower
+     * than the previous sample is taken as reset to zero in between.
+     *
+     * @param[in]   aNow    The timestamp of the sample, in milliseconds.
+     * @param[in]   aValue  The value of the counter.
+     *
+     */
+    void Sample(uint64_t aNow, uint32_t aValue);
+
+    /**
+     * This method drops the baseline, so that the next sample starts a new interval.
+     *
+     * The history is kept. This is used when the counter restarts from an unknown value, or after a pause.
+     *
+     */
+    void Restart(void) { mHasBaseline = false; }
+
+    /**
+     * This method computes the rates of the counter over the most recent window.
+     *
+     * The fine ring is used when it covers the window, and the coarse ring otherwise. The window is shorter than
+     * requested when the history does not go back that far.
+     *
+     * @param[in]   aWindow     The window, in milliseconds.
+     * @param[out]  aRates      The rates over the window.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully computed the rates.
+     * @retval  OTBR_ERROR_ERRNO    There is no complete interval yet, errno is set to EAGAIN.
+     *
+     */
+    otbrError GetRates(uint32_t aWindow, Rates &aRates) const;
+
+private:
+    struct Interval
+    {
+        uint32_t mDelta;    ///< The increase of the counter.
+        uint32_t mDuration; ///< The duration, in milliseconds.
+    };
+
+    class Ring
+    {
+    public:
+        explicit Ring(uint16_t aSize);
+
+        void            Push(const Interval &aInterval);
+        uint16_t        GetLength(void) const { return mLength; }
+        bool            IsFull(void) const { return mLength == mIntervals.size(); }
+        const Interval &GetRecent(uint16_t aAge) const;
+
+    private:
+        std::vector<Interval> mIntervals;
+        uint16_t              mNext;
+        uint16_t              mLength;
+    };
+
+    static uint32_t ComputeRate(uint64_t aDelta, uint64_t aDuration);
+    static void     ComputeRates(const Ring &aRing, uint32_t aWindow, Rates &aRates);
+
+    Ring     mFine;
+    Ring     mCoarse;
+    uint16_t mCoarseRatio;
+    Interval mCoarsePending;      ///< The sum of the fine intervals of the coarse interval in progress.
+    uint16_t mCoarsePendingCount; ///< The number of fine intervals in the coarse interval in progress.
+    bool     mHasBaseline;
+    uint64_t mLastTime;
+    uint32_t mLastValue;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_COUNTER_HISTORY_HPP_
@@ -33,32 +33,102 @@
 
 #include "utils/crc16.hpp"
 
+#include <assert.h>
+
 namespace otbr {
 
+namespace {
+
+// The tables are indexed as kTable[k][x], the CRC contribution of byte x followed by k zero bytes, which lets
+// Update() fold kSliceSize input bytes per step.
+constexpr size_t kSliceSize = 4;
+
+constexpr uint16_t CrcStep(uint16_t aPolynomial, uint16_t aCrc, unsigned aBits)
+{
+    return aBits == 0 ? aCrc
+                      : CrcStep(aPolynomial,
+                                static_cast<uint16_t>((aCrc & 0x8000) ? ((aCrc << 1) ^ aPolynomial) : (aCrc << 1)),
+                                aBits - 1);
+}
+
+constexpr uint16_t CrcByte(uint16_t aPolynomial, unsigned aByte)
+{
+    return CrcStep(aPolynomial, static_cast<uint16_t>(aByte << 8), 8);
+}
+
+constexpr uint16_t CrcZeroByte(uint16_t aPolynomial, uint16_t aCrc)
+{
+    return static_cast<uint16_t>((aCrc << 8) ^ CrcByte(aPolynomial, aCrc >> 8));
+}
+
+constexpr uint16_t CrcEntry(uint16_t aPolynomial, unsigned aZeroBytes, unsigned aByte)
+{
+    return aZeroBytes == 0 ? CrcByte(aPolynomial, aByte)
+                           : CrcZeroByte(aPolynomial, CrcEntry(aPolynomial, aZeroBytes - 1, aByte));
+}
+
+#define OTBR_CRC16_ROW(aPolynomial, aZeroBytes, aRow)                                                            \
+    CrcEntry(aPolynomial, aZeroBytes, aRow + 0x0), CrcEntry(aPolynomial, aZeroBytes, aRow + 0x1),                \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0x2), CrcEntry(aPolynomial, aZeroBytes, aRow + 0x3),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0x4), CrcEntry(aPolynomial, aZeroBytes, aRow + 0x5),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0x6), CrcEntry(aPolynomial, aZeroBytes, aRow + 0x7),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0x8), CrcEntry(aPolynomial, aZeroBytes, aRow + 0x9),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0xa), CrcEntry(aPolynomial, aZeroBytes, aRow + 0xb),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0xc), CrcEntry(aPolynomial, aZeroBytes, aRow + 0xd),            \
+        CrcEntry(aPolynomial, aZeroBytes, aRow + 0xe), CrcEntry(aPolynomial, aZeroBytes, aRow + 0xf)
+
+#define OTBR_CRC16_TABLE(aPolynomial, aZeroBytes)                                                                \
+    {                                                                                                            \
+        OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x00), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x10),            \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x20), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x30),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x40), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x50),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x60), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x70),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x80), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0x90),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xa0), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xb0),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xc0), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xd0),        \
+            OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xe0), OTBR_CRC16_ROW(aPolynomial, aZeroBytes, 0xf0)         \
+    }
+
+#define OTBR_CRC16_TABLES(aPolynomial)                                                                           \
+    {                                                                                                            \
+        OTBR_CRC16_TABLE(aPolynomial, 0), OTBR_CRC16_TABLE(aPolynomial, 1), OTBR_CRC16_TABLE(aPolynomial, 2),    \
+            OTBR_CRC16_TABLE(aPolynomial, 3)                                                                     \
+    }
+
+constexpr uint16_t kCcittTable[kSliceSize][256] = OTBR_CRC16_TABLES(Crc16::kCcitt);
+constexpr uint16_t kAnsiTable[kSliceSize][256]  = OTBR_CRC16_TABLES(Crc16::kAnsi);
+
+static_assert(kCcittTable[0][1] == Crc16::kCcitt, "CRC16-CCITT table is malformed");
+static_assert(kAnsiTable[0][1] == Crc16::kAnsi, "CRC16-ANSI table is malformed");
+
+} // namespace
+
 Crc16::Crc16(Polynomial aPolynomial)
 {
-    mPolynomial = static_cast<uint16_t>(aPolynomial);
+    assert(aPolynomial == kCcitt || aPolynomial == kAnsi);
+    mTable = (aPolynomial == kCcitt) ? kCcittTable : kAnsiTable;
     Init();
 }
 
 void Crc16::Update(uint8_t aByte)
 {
-    uint8_t i;
+    mCrc = static_cast<uint16_t>((mCrc << 8) ^ mTable[0][(mCrc >> 8) ^ aByte]);
+}
+
+void Crc16::Update(const uint8_t *aBuffer, size_t aLength)
+{
+    const uint8_t *end = aBuffer + aLength;
 
-    mCrc = mCrc ^ static_cast<uint16_t>(aByte << 8);
-    i    = 8;
+    for (; end - aBuffer >= static_cast<ptrdiff_t>(kSliceSize); aBuffer += kSliceSize)
+    {
+        mCrc = mTable[3][(mCrc >> 8) ^ aBuffer[0]] ^ mTable[2][(mCrc & 0xff) ^ aBuffer[1]] ^ mTable[1][aBuffer[2]] ^
+               mTable[0][aBuffer[3]];
+    }
 
-    do
+    for (; aBuffer < end; aBuffer++)
     {
-        if (mCrc & 0x8000)
-        {
-            mCrc = static_cast<uint16_t>(mCrc << 1) ^ mPolynomial;
-        }
-        else
-        {
-            mCrc = static_cast<uint16_t>(mCrc << 1);
-        }
-    } while (--i);
+        Update(*aBuffer);
+    }
 }
 
 } // namespace otbr
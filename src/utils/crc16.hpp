@@ -36,6 +36,7 @@
 
 #include "openthread-br/config.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace otbr {
@@ -75,6 +76,17 @@ public:
      */
     void Update(uint8_t aByte);
 
+    /**
+     * This method feeds a buffer into the CRC16 computation.
+     *
+     * The result is the same as feeding each byte in turn, but four bytes are folded per table lookup round.
+     *
+     * @param[in]  aBuffer  A pointer to the bytes.
+     * @param[in]  aLength  The number of bytes.
+     *
+     */
+    void Update(const uint8_t *aBuffer, size_t aLength);
+
     /**
      * This method gets the current CRC16 value.
      *
@@ -84,8 +96,8 @@ public:
     uint16_t Get(void) const { return mCrc; }
 
 private:
-    uint16_t mPolynomial;
-    uint16_t mCrc;
+    const uint16_t (*mTable)[256];
+    uint16_t       mCrc;
 };
 
 } // namespace otbr
@@ -31,63 +31,177 @@
 
 #include "openthread-br/config.h"
 
-#include <list>
-#include <map>
+#include <tuple>
+#include <utility>
 
-#include <stdarg.h>
+#include <assert.h>
+#include <stdint.h>
 
 namespace otbr {
 
 /**
- * This class implements the basic functionality of an event emitter.
+ * This class template implements an event with a compile-time signature and a fixed number of handler slots.
+ *
+ * Registering and emitting never allocate memory, and a handler with a mismatched signature does not compile.
+ *
+ * @tparam Args     The types of the arguments passed to the handlers.
  *
  */
-class EventEmitter
+template <typename... Args> class Event
 {
+public:
+    /**
+     * This function pointer will be called when the event is emitted.
+     *
+     * @param[in]   aContext    A pointer to application-specific context.
+     * @param[in]   aArgs       The arguments associated with this event.
+     *
+     */
+    typedef void (*Callback)(void *aContext, Args... aArgs);
+
+    enum
+    {
+        kMaxHandlers = 4, ///< Maximum number of handlers of an event.
+    };
+
+    /**
+     * The constructor initializes an event without handlers.
+     *
+     */
+    Event(void)
+        : mNumHandlers(0)
+    {
+    }
+
     /**
-     * This function pointer will be called when the @p aEvent is emitted.
+     * This method registers a handler, handlers are called in the order they are registered.
+     *
+     * @param[in]   aCallback   The function pointer to be called.
+     * @param[in]   aContext    A pointer to application-specific context.
+     *
+     */
+    void On(Callback aCallback, void *aContext)
+    {
+        assert(aCallback != nullptr);
+        assert(mNumHandlers < kMaxHandlers);
+
+        if (mNumHandlers < kMaxHandlers)
+        {
+            mHandlers[mNumHandlers].mCallback = aCallback;
+            mHandlers[mNumHandlers].mContext  = aContext;
+            ++mNumHandlers;
+        }
+    }
+
+    /**
+     * This method deregisters the first handler matching @p aCallback and @p aContext.
+     *
+     * It must not be called from a handler of the same event.
      *
+     * @param[in]   aCallback   The function pointer to be called.
      * @param[in]   aContext    A pointer to application-specific context.
-     * @param[in]   aEvent      The emitted event id.
-     * @param[in]   aArguments  The arguments associated with this event.
      *
      */
-    typedef void (*Callback)(void *aContext, int aEvent, va_list aArguments);
+    void Off(Callback aCallback, void *aContext)
+    {
+        for (uint8_t i = 0; i < mNumHandlers; ++i)
+        {
+            if (mHandlers[i].mCallback == aCallback && mHandlers[i].mContext == aContext)
+            {
+                for (--mNumHandlers; i < mNumHandlers; ++i)
+                {
+                    mHandlers[i] = mHandlers[i + 1];
+                }
+                break;
+            }
+        }
+    }
 
+    /**
+     * This method emits the event.
+     *
+     * @param[in]   aArgs   The arguments passed to the handlers.
+     *
+     */
+    void Emit(Args... aArgs) const
+    {
+        for (uint8_t i = 0; i < mNumHandlers; ++i)
+        {
+            mHandlers[i].mCallback(mHandlers[i].mContext, aArgs...);
+        }
+    }
+
+private:
+    struct Handler
+    {
+        Callback mCallback;
+        void *   mContext;
+    };
+
+    Handler mHandlers[kMaxHandlers];
+    uint8_t mNumHandlers;
+};
+
+/**
+ * This class template implements the basic functionality of an event emitter.
+ *
+ * Event ids are indices into @p Events, which gives each event id its compile-time signature.
+ *
+ * @tparam Events   The Event types, in the order of the event ids.
+ *
+ */
+template <typename... Events> class EventEmitter
+{
 public:
     /**
-     * This method register an event handler for @p aEvent.
+     * This type is the Event type of @p kEvent.
      *
-     * @param[in]   aEvent      The event id.
-     * @param[in]   aCallback   The function poiner to be called.
+     */
+    template <int kEvent> using EventType = typename std::tuple_element<kEvent, std::tuple<Events...>>::type;
+
+    /**
+     * This method registers an event handler for @p kEvent.
+     *
+     * @tparam      kEvent      The event id.
+     *
+     * @param[in]   aCallback   The function pointer to be called.
      * @param[in]   aContext    A pointer to application-specific context.
      *
      */
-    void On(int aEvent, Callback aCallback, void *aContext);
+    template <int kEvent> void On(typename EventType<kEvent>::Callback aCallback, void *aContext)
+    {
+        std::get<kEvent>(mEvents).On(aCallback, aContext);
+    }
 
     /**
-     * This method deregister an event handler for @p aEvent.
+     * This method deregisters an event handler for @p kEvent.
      *
-     * @param[in]   aEvent      The event id.
-     * @param[in]   aCallback   The function poiner to be called.
+     * @tparam      kEvent      The event id.
+     *
+     * @param[in]   aCallback   The function pointer to be called.
      * @param[in]   aContext    A pointer to application-specific context.
      *
      */
-    void Off(int aEvent, Callback aCallback, void *aContext);
+    template <int kEvent> void Off(typename EventType<kEvent>::Callback aCallback, void *aContext)
+    {
+        std::get<kEvent>(mEvents).Off(aCallback, aContext);
+    }
 
     /**
      * This method emits an event.
      *
-     * @param[in]   aEvent      The event id.
+     * @tparam      kEvent  The event id.
+     *
+     * @param[in]   aArgs   The arguments passed to the handlers, converted to the signature of @p kEvent.
      *
      */
-    void Emit(int aEvent, ...);
+    template <int kEvent, typename... Args> void Emit(Args &&... aArgs) const
+    {
+        std::get<kEvent>(mEvents).Emit(std::forward<Args>(aArgs)...);
+    }
 
 private:
-    typedef std::pair<Callback, void *> Handler;
-    typedef std::list<Handler>          Handlers;
-    typedef std::map<int, Handlers>     Events;
-    Events                              mEvents;
+    std::tuple<Events...> mEvents;
 };
 
 } // namespace otbr
@@ -33,98 +33,118 @@
 
 #include "utils/hex.hpp"
 
-#include <string>
-
-#include <stdio.h>
 #include <string.h>
 
+#include "common/code_utils.hpp"
+
 namespace otbr {
 
 namespace Utils {
 
-int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength)
+namespace {
+
+const uint8_t kInvalidNibble = 0xff;
+
+// The value of each hex digit, or kInvalidNibble for any other character.
+const uint8_t kHexValues[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+const char kUpperHexDigits[] = "0123456789ABCDEF";
+const char kLowerHexDigits[] = "0123456789abcdef";
+
+} // namespace
+
+int Hex2Bytes(const char *aHex, size_t aHexLength, uint8_t *aBytes, size_t aBytesLength)
 {
-    size_t      hexLength = strlen(aHex);
-    const char *hexEnd    = aHex + hexLength;
-    uint8_t *   cur       = aBytes;
-    uint8_t     numChars  = hexLength & 1;
-    uint8_t     byte      = 0;
+    const uint8_t *hex         = reinterpret_cast<const uint8_t *>(aHex);
+    size_t         bytesLength = (aHexLength + 1) / 2;
+    uint8_t *      cur         = aBytes;
+    uint8_t        invalid     = 0;
+    int            rval        = -1;
 
-    if ((hexLength + 1) / 2 > aBytesLength)
+    VerifyOrExit(bytesLength <= aBytesLength);
+
+    // An odd number of digits is read as if it had a leading zero.
+    if (aHexLength & 1)
     {
-        return -1;
+        invalid |= kHexValues[*hex];
+        *cur++ = kHexValues[*hex++];
     }
 
-    while (aHex < hexEnd)
+    // Invalid digits are accumulated and checked once rather than branched on per digit.
+    for (; cur < aBytes + bytesLength; cur++, hex += 2)
     {
-        if ('A' <= *aHex && *aHex <= 'F')
-        {
-            byte |= 10 + (*aHex - 'A');
-        }
-        else if ('a' <= *aHex && *aHex <= 'f')
-        {
-            byte |= 10 + (*aHex - 'a');
-        }
-        else if ('0' <= *aHex && *aHex <= '9')
-        {
-            byte |= *aHex - '0';
-        }
-        else
-        {
-            return -1;
-        }
-
-        aHex++;
-        numChars++;
-
-        if (numChars >= 2)
-        {
-            numChars = 0;
-            *cur++   = byte;
-            byte     = 0;
-        }
-        else
-        {
-            byte <<= 4;
-        }
+        uint8_t high = kHexValues[hex[0]];
+        uint8_t low  = kHexValues[hex[1]];
+
+        invalid |= high | low;
+        *cur = static_cast<uint8_t>((high << 4) | (low & 0x0f));
     }
 
-    return static_cast<int>(cur - aBytes);
+    VerifyOrExit(invalid != kInvalidNibble);
+    rval = static_cast<int>(bytesLength);
+
+exit:
+    return rval;
 }
 
-size_t Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex)
+int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength)
 {
-    char byteHex[3];
+    return Hex2Bytes(aHex, strlen(aHex), aBytes, aBytesLength);
+}
 
-    std::string hexString;
-    uint8_t     cur[aBytesLength];
+size_t Bytes2Hex(const uint8_t *aBytes, size_t aBytesLength, char *aHex, size_t aHexSize, bool aLowerCase)
+{
+    const char *digits    = aLowerCase ? kLowerHexDigits : kUpperHexDigits;
+    size_t      hexLength = 0;
 
-    memcpy(cur, aBytes, aBytesLength);
+    VerifyOrExit(aHexSize > 0);
+    VerifyOrExit(aBytesLength * 2 < aHexSize, aHex[0] = '\0');
 
-    for (int i = 0; i < aBytesLength; i++)
+    for (size_t i = 0; i < aBytesLength; i++)
     {
-        sprintf(byteHex, "%02X", cur[i]);
-        hexString += byteHex;
+        aHex[2 * i]     = digits[aBytes[i] >> 4];
+        aHex[2 * i + 1] = digits[aBytes[i] & 0x0f];
     }
-    strcpy(aHex, hexString.c_str());
-    return strlen(aHex);
+
+    hexLength       = aBytesLength * 2;
+    aHex[hexLength] = '\0';
+
+exit:
+    return hexLength;
+}
+
+size_t Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex)
+{
+    return Bytes2Hex(aBytes, aBytesLength, aHex, aBytesLength * 2 + 1);
 }
 
 size_t Long2Hex(const uint64_t aLong, char *aHex)
 {
-    std::string hexString;
-    char        byteHex[3];
-    uint64_t    longValue = aLong;
+    uint8_t bytes[sizeof(uint64_t)];
 
-    for (uint8_t i = 0; i < sizeof(uint64_t); i++)
+    for (size_t i = 0; i < sizeof(bytes); i++)
     {
-        uint8_t byte = longValue & 0xff;
-        sprintf(byteHex, "%02X", byte);
-        hexString += byteHex;
-        longValue = longValue >> 8;
+        bytes[i] = static_cast<uint8_t>(aLong >> (8 * i));
     }
-    strcpy(aHex, hexString.c_str());
-    return strlen(aHex);
+
+    return Bytes2Hex(bytes, sizeof(bytes), aHex, sizeof(bytes) * 2 + 1);
 }
 
 } // namespace Utils
@@ -43,10 +43,68 @@ namespace otbr {
 
 namespace Utils {
 
+/**
+ * This function converts a hex string to bytes.
+ *
+ * Both upper and lower case digits are accepted. An odd number of digits is read as if it had a leading zero.
+ *
+ * @param[in]   aHex            A pointer to the hex digits, which need not be null-terminated.
+ * @param[in]   aHexLength      The number of hex digits.
+ * @param[out]  aBytes          A pointer to receive the bytes.
+ * @param[in]   aBytesLength    The size of @p aBytes in bytes.
+ *
+ * @returns The number of bytes written, or -1 if @p aBytes is too small or @p aHex holds a non-hex character.
+ *
+ */
+int Hex2Bytes(const char *aHex, size_t aHexLength, uint8_t *aBytes, size_t aBytesLength);
+
+/**
+ * This function converts a null-terminated hex string to bytes.
+ *
+ * @param[in]   aHex            A pointer to the null-terminated hex string.
+ * @param[out]  aBytes          A pointer to receive the bytes.
+ * @param[in]   aBytesLength    The size of @p aBytes in bytes.
+ *
+ * @returns The number of bytes written, or -1 if @p aBytes is too small or @p aHex holds a non-hex character.
+ *
+ */
 int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength);
 
+/**
+ * This function converts bytes to a null-terminated hex string.
+ *
+ * @param[in]   aBytes          A pointer to the bytes.
+ * @param[in]   aBytesLength    The number of bytes.
+ * @param[out]  aHex            A pointer to receive the hex string.
+ * @param[in]   aHexSize        The size of @p aHex, including the null terminator.
+ * @param[in]   aLowerCase      Whether to write lower case digits instead of upper case ones.
+ *
+ * @returns The length of the hex string, or 0 with an empty string if @p aHex is too small.
+ *
+ */
+size_t Bytes2Hex(const uint8_t *aBytes, size_t aBytesLength, char *aHex, size_t aHexSize, bool aLowerCase = false);
+
+/**
+ * This function converts bytes to a null-terminated upper case hex string.
+ *
+ * @param[in]   aBytes          A pointer to the bytes.
+ * @param[in]   aBytesLength    The number of bytes.
+ * @param[out]  aHex            A pointer to receive the hex string, of at least 2 * @p aBytesLength + 1 chars.
+ *
+ * @returns The length of the hex string.
+ *
+ */
 size_t Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex);
 
+/**
+ * This function converts a 64-bit value to a null-terminated upper case hex string, least significant byte first.
+ *
+ * @param[in]   aLong   The value.
+ * @param[out]  aHex    A pointer to receive the hex string, of at least 17 chars.
+ *
+ * @returns The length of the hex string.
+ *
+ */
 size_t Long2Hex(const uint64_t aLong, char *aHex);
 
 } // namespace Utils
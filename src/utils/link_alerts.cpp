@@ -0,0 +1,210 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the link quality alert rules.
+ */
+
+#include "utils/link_alerts.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+LinkAlerts::LinkAlerts(size_t aMaxRules)
+    : mMaxRules(aMaxRules)
+    , mNextId(1)
+{
+}
+
+otbrError LinkAlerts::AddRule(const Rule &aRule, uint32_t &aId)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    Rule      rule  = aRule;
+
+    VerifyOrExit(aRule.mMetric < kMetricNum, error = OTBR_ERROR_ERRNO, errno = EINVAL);
+    VerifyOrExit(mRules.size() < mMaxRules, error = OTBR_ERROR_ERRNO, errno = ENOSPC);
+
+    rule.mId = mNextId++;
+    // Zero is never a rule ID, so that clients can use it as unset.
+    if (mNextId == 0)
+    {
+        mNextId = 1;
+    }
+
+    mRules.push_back(rule);
+    aId = rule.mId;
+
+exit:
+    return error;
+}
+
+otbrError LinkAlerts::RemoveRule(uint32_t aId)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+
+    for (auto it = mRules.begin(); it != mRules.end(); ++it)
+    {
+        if (it->mId == aId)
+        {
+            mRules.erase(it);
+            error = OTBR_ERROR_NONE;
+            break;
+        }
+    }
+
+    VerifyOrExit(error == OTBR_ERROR_NONE, errno = ENOENT);
+
+    mAlerts.erase(mAlerts.lower_bound(AlertKey(aId, 0)), mAlerts.upper_bound(AlertKey(aId, UINT64_MAX)));
+
+exit:
+    return error;
+}
+
+bool LinkAlerts::IsSampled(Metric aMetric) const
+{
+    bool sampled = false;
+
+    for (const Rule &rule : mRules)
+    {
+        if (rule.mMetric == aMetric)
+        {
+            sampled = true;
+            break;
+        }
+    }
+
+    return sampled;
+}
+
+void LinkAlerts::Update(Metric aMetric, uint64_t aSubject, int32_t aValue, std::vector<Crossing> &aCrossings)
+{
+    for (const Rule &rule : mRules)
+    {
+        AlertKey key(rule.mId, aSubject);
+
+        if (rule.mMetric != aMetric)
+        {
+            continue;
+        }
+
+        auto alert = mAlerts.find(key);
+
+        if (alert == mAlerts.end())
+        {
+            if (IsRaised(rule, aValue))
+            {
+                mAlerts[key] = Alert{aValue, true};
+                aCrossings.push_back(Crossing{rule.mId, aSubject, true, aValue});
+            }
+        }
+        else if (IsCleared(rule, aValue))
+        {
+            mAlerts.erase(alert);
+            aCrossings.push_back(Crossing{rule.mId, aSubject, false, aValue});
+        }
+        else
+        {
+            alert->second.mValue = aValue;
+            alert->second.mSeen  = true;
+        }
+    }
+}
+
+void LinkAlerts::EndRound(std::vector<Crossing> &aCrossings)
+{
+    for (auto it = mAlerts.begin(); it != mAlerts.end();)
+    {
+        if (it->second.mSeen)
+        {
+            it->second.mSeen = false;
+            ++it;
+        }
+        else
+        {
+            aCrossings.push_back(Crossing{it->first.first, it->first.second, false, it->second.mValue});
+            it = mAlerts.erase(it);
+        }
+    }
+}
+
+void LinkAlerts::GetRaisedAlerts(std::vector<Crossing> &aAlerts) const
+{
+    for (const auto &alert : mAlerts)
+    {
+        aAlerts.push_back(Crossing{alert.first.first, alert.first.second, true, alert.second.mValue});
+    }
+}
+
+const char *LinkAlerts::GetMetricName(Metric aMetric)
+{
+    static const char *const kNames[] = {
+        "Rssi", "FrameErrorRate", "MessageErrorRate", "CcaFailureRate", "TxRetryRate",
+    };
+
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == kMetricNum, "Missing metric names");
+
+    return kNames[aMetric];
+}
+
+otbrError LinkAlerts::ParseMetric(const char *aName, Metric &aMetric)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+
+    for (uint8_t i = 0; i < kMetricNum; i++)
+    {
+        if (strcmp(aName, GetMetricName(static_cast<Metric>(i))) == 0)
+        {
+            aMetric = static_cast<Metric>(i);
+            error   = OTBR_ERROR_NONE;
+            break;
+        }
+    }
+
+    VerifyOrExit(error == OTBR_ERROR_NONE, errno = EINVAL);
+
+exit:
+    return error;
+}
+
+bool LinkAlerts::IsRaised(const Rule &aRule, int32_t aValue)
+{
+    return aRule.mAbove ? aValue > aRule.mThreshold : aValue < aRule.mThreshold;
+}
+
+bool LinkAlerts::IsCleared(const Rule &aRule, int32_t aValue)
+{
+    // The bound is computed in 64 bits so that a large hysteresis does not wrap around.
+    return aRule.mAbove ? aValue <= static_cast<int64_t>(aRule.mThreshold) - aRule.mHysteresis
+                        : aValue >= static_cast<int64_t>(aRule.mThreshold) + aRule.mHysteresis;
+}
+
+} // namespace otbr
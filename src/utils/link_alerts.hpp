@@ -0,0 +1,220 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions of the link quality alert rules.
+ */
+
+#ifndef OTBR_UTILS_LINK_ALERTS_HPP_
+#define OTBR_UTILS_LINK_ALERTS_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace otbr {
+
+/**
+ * This class evaluates threshold rules over link quality samples and reports the crossings.
+ *
+ * An alert is raised when a sample crosses the threshold of a rule, and cleared only when a later sample comes back
+ * past the threshold by the hysteresis of the rule, so that a metric hovering around the threshold does not flap.
+ * Only the raised alerts are kept, so that the state is bounded by the rules times the subjects in alert.
+ *
+ */
+class LinkAlerts
+{
+public:
+    /**
+     * This enumeration represents the link quality metrics.
+     *
+     */
+    enum Metric : uint8_t
+    {
+        kMetricRssi,             ///< The average RSSI of a neighbor, in dBm.
+        kMetricFrameErrorRate,   ///< The frame error rate of a neighbor, from 0 to 0xffff.
+        kMetricMessageErrorRate, ///< The message error rate of a neighbor, from 0 to 0xffff.
+        kMetricCcaFailureRate,   ///< The CCA failure rate of the radio, from 0 to 0xffff.
+        kMetricTxRetryRate,      ///< The share of transmissions that were retries, from 0 to 0xffff.
+        kMetricNum,              ///< The number of metrics.
+    };
+
+    /**
+     * This structure represents a threshold rule.
+     *
+     */
+    struct Rule
+    {
+        uint32_t mId;         ///< The rule ID.
+        Metric   mMetric;     ///< The metric.
+        bool     mAbove;      ///< Whether the alert is raised above the threshold, rather than below it.
+        int32_t  mThreshold;  ///< The threshold.
+        uint32_t mHysteresis; ///< The distance past the threshold a sample must come back to clear the alert.
+    };
+
+    /**
+     * This structure represents an alert raised or cleared by a sample.
+     *
+     */
+    struct Crossing
+    {
+        uint32_t mRuleId;  ///< The rule ID.
+        uint64_t mSubject; ///< The extended address of the neighbor, 0 for the metrics of the radio.
+        bool     mRaised;  ///< Whether the alert is raised, rather than cleared.
+        int32_t  mValue;   ///< The sample that crossed the threshold.
+    };
+
+    /**
+     * The constructor initializes an engine without rules.
+     *
+     * @param[in]   aMaxRules   The maximum number of rules.
+     *
+     */
+    explicit LinkAlerts(size_t aMaxRules);
+
+    /**
+     * This method adds a rule.
+     *
+     * @param[in]   aRule   The rule, of which the ID is ignored.
+     * @param[out]  aId     The ID of the new rule.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully added the rule.
+     * @retval  OTBR_ERROR_ERRNO    Failed to add the rule, errno is EINVAL for an unknown metric or ENOSPC when
+     *                              there are too many rules.
+     *
+     */
+    otbrError AddRule(const Rule &aRule, uint32_t &aId);
+
+    /**
+     * This method removes a rule, and drops its alerts without reporting them as cleared.
+     *
+     * @param[in]   aId     The rule ID.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully removed the rule.
+     * @retval  OTBR_ERROR_ERRNO    There is no such rule, errno is set to ENOENT.
+     *
+     */
+    otbrError RemoveRule(uint32_t aId);
+
+    /**
+     * This method returns the rules.
+     *
+     * @returns The rules, in the order they were added.
+     *
+     */
+    const std::vector<Rule> &GetRules(void) const { return mRules; }
+
+    /**
+     * This method indicates whether a metric is used by any rule.
+     *
+     * @param[in]   aMetric     The metric.
+     *
+     * @retval  true    At least one rule uses the metric.
+     * @retval  false   No rule uses the metric, so it needs not be sampled.
+     *
+     */
+    bool IsSampled(Metric aMetric) const;
+
+    /**
+     * This method evaluates the rules of a metric against a sample.
+     *
+     * @param[in]   aMetric     The metric.
+     * @param[in]   aSubject    The extended address of the neighbor, 0 for the metrics of the radio.
+     * @param[in]   aValue      The sample.
+     * @param[out]  aCrossings  The alerts raised or cleared by the sample are appended to this vector.
+     *
+     */
+    void Update(Metric aMetric, uint64_t aSubject, int32_t aValue, std::vector<Crossing> &aCrossings);
+
+    /**
+     * This method ends a sampling round, clearing the alerts of the subjects not sampled since the previous round.
+     *
+     * This is how the alerts of a neighbor that went away are cleared.
+     *
+     * @param[out]  aCrossings  The alerts cleared are appended to this vector, with their last sample.
+     *
+     */
+    void EndRound(std::vector<Crossing> &aCrossings);
+
+    /**
+     * This method returns the raised alerts, for readers which missed some crossings.
+     *
+     * @param[out]  aAlerts     The raised alerts are appended to this vector, with their last sample.
+     *
+     */
+    void GetRaisedAlerts(std::vector<Crossing> &aAlerts) const;
+
+    /**
+     * This method returns the name of a metric.
+     *
+     * @param[in]   aMetric     The metric, which must be less than kMetricNum.
+     *
+     * @returns The metric name.
+     *
+     */
+    static const char *GetMetricName(Metric aMetric);
+
+    /**
+     * This method looks up a metric by name.
+     *
+     * @param[in]   aName       The metric name.
+     * @param[out]  aMetric     The metric.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully found the metric.
+     * @retval  OTBR_ERROR_ERRNO    There is no such metric, errno is set to EINVAL.
+     *
+     */
+    static otbrError ParseMetric(const char *aName, Metric &aMetric);
+
+private:
+    struct Alert
+    {
+        int32_t mValue; ///< The last sample.
+        bool    mSeen;  ///< Whether the subject was sampled in this round.
+    };
+
+    typedef std::pair<uint32_t, uint64_t> AlertKey;
+
+    static bool IsRaised(const Rule &aRule, int32_t aValue);
+    static bool IsCleared(const Rule &aRule, int32_t aValue);
+
+    size_t                    mMaxRules;
+    uint32_t                  mNextId;
+    std::vector<Rule>         mRules;
+    std::map<AlertKey, Alert> mAlerts;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_LINK_ALERTS_HPP_
@@ -0,0 +1,172 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the writer of the Prometheus text exposition format.
+ */
+
+#include "utils/metrics_writer.hpp"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace otbr {
+
+const char MetricsWriter::kContentType[] = "text/plain; version=0.0.4; charset=utf-8";
+
+/**
+ * This function appends text, escaping the backslashes and line feeds, and also the double quotes of a label value.
+ *
+ */
+static void AppendEscaped(std::string &aBuffer, const char *aText, size_t aLength, bool aEscapeQuotes)
+{
+    for (size_t i = 0; i < aLength; i++)
+    {
+        switch (aText[i])
+        {
+        case '\\':
+            aBuffer += "\\\\";
+            break;
+        case '\n':
+            aBuffer += "\\n";
+            break;
+        case '"':
+            aBuffer += aEscapeQuotes ? "\\\"" : "\"";
+            break;
+        default:
+            aBuffer.push_back(aText[i]);
+            break;
+        }
+    }
+}
+
+MetricsWriter::MetricsWriter(std::string &aBuffer)
+    : mBuffer(aBuffer)
+{
+    mBuffer.clear();
+}
+
+MetricsWriter &MetricsWriter::Family(const char *aName, Type aType, const char *aHelp)
+{
+    static const char *const kTypeNames[] = {"counter", "gauge", "histogram"};
+
+    mFamily = aName;
+    mLabels.clear();
+
+    mBuffer += "# HELP ";
+    mBuffer += mFamily;
+    mBuffer.push_back(' ');
+    AppendEscaped(mBuffer, aHelp, strlen(aHelp), false);
+    mBuffer += "\n# TYPE ";
+    mBuffer += mFamily;
+    mBuffer.push_back(' ');
+    mBuffer += kTypeNames[aType];
+    mBuffer.push_back('\n');
+
+    return *this;
+}
+
+MetricsWriter &MetricsWriter::Label(const char *aName, const std::string &aValue)
+{
+    if (!mLabels.empty())
+    {
+        mLabels.push_back(',');
+    }
+
+    mLabels += aName;
+    mLabels += "=\"";
+    AppendEscaped(mLabels, aValue.data(), aValue.size(), true);
+    mLabels.push_back('"');
+
+    return *this;
+}
+
+MetricsWriter &MetricsWriter::Value(const char *aSuffix, uint64_t aValue)
+{
+    char value[sizeof("18446744073709551615")];
+
+    snprintf(value, sizeof(value), "%" PRIu64, aValue);
+    return WriteSample(aSuffix, value);
+}
+
+MetricsWriter &MetricsWriter::Value(const char *aSuffix, int64_t aValue)
+{
+    char value[sizeof("-9223372036854775808")];
+
+    snprintf(value, sizeof(value), "%" PRId64, aValue);
+    return WriteSample(aSuffix, value);
+}
+
+MetricsWriter &MetricsWriter::Value(const char *aSuffix, double aValue)
+{
+    char value[32];
+
+    if (isnan(aValue))
+    {
+        snprintf(value, sizeof(value), "NaN");
+    }
+    else if (isinf(aValue))
+    {
+        snprintf(value, sizeof(value), "%s", aValue > 0 ? "+Inf" : "-Inf");
+    }
+    else
+    {
+        // Enough digits for the microsecond sums of the histograms, without the noise of the full precision.
+        snprintf(value, sizeof(value), "%.15g", aValue);
+    }
+
+    return WriteSample(aSuffix, value);
+}
+
+MetricsWriter &MetricsWriter::WriteSample(const char *aSuffix, const char *aValue)
+{
+    mBuffer += mFamily;
+
+    if (aSuffix != nullptr)
+    {
+        mBuffer += aSuffix;
+    }
+
+    if (!mLabels.empty())
+    {
+        mBuffer.push_back('{');
+        mBuffer += mLabels;
+        mBuffer.push_back('}');
+        mLabels.clear();
+    }
+
+    mBuffer.push_back(' ');
+    mBuffer += aValue;
+    mBuffer.push_back('\n');
+
+    return *this;
+}
+
+} // namespace otbr
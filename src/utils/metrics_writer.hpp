@@ -0,0 +1,175 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions of the writer of the Prometheus text exposition format.
+ */
+
+#ifndef OTBR_UTILS_METRICS_WRITER_HPP_
+#define OTBR_UTILS_METRICS_WRITER_HPP_
+
+#include "openthread-br/config.h"
+
+#include <string>
+
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class writes metrics in the Prometheus text exposition format directly into a string.
+ *
+ * A metric family is started by `Family()` and followed by its samples, each written by zero or more `Label()` calls
+ * and one `Value()` call.
+ *
+ */
+class MetricsWriter
+{
+public:
+    /**
+     * The content type of the text exposition format.
+     *
+     */
+    static const char kContentType[];
+
+    /**
+     * This enumeration represents the metric types.
+     *
+     */
+    enum Type
+    {
+        kTypeCounter,   ///< A monotonic counter, named with a "_total" suffix.
+        kTypeGauge,     ///< A value which goes up and down.
+        kTypeHistogram, ///< A histogram, of which the samples are the "_bucket", "_sum" and "_count" series.
+    };
+
+    /**
+     * This constructor initializes the writer.
+     *
+     * @param[in]  aBuffer  The string to write into. It is cleared, and its storage is reused.
+     *
+     */
+    explicit MetricsWriter(std::string &aBuffer);
+
+    /**
+     * This method starts a metric family, writing its help text and type.
+     *
+     * @param[in]  aName    The metric name.
+     * @param[in]  aType    The metric type.
+     * @param[in]  aHelp    The help text, which is escaped as needed.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Family(const char *aName, Type aType, const char *aHelp);
+
+    /**
+     * This method adds a label to the next sample.
+     *
+     * @param[in]  aName    The label name.
+     * @param[in]  aValue   The label value, which is escaped as needed.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Label(const char *aName, const std::string &aValue);
+
+    /**
+     * This method writes a sample of the current family with the labels added since the previous sample.
+     *
+     * @param[in]  aValue   The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(uint64_t aValue) { return Value(nullptr, aValue); }
+
+    /**
+     * This method writes a sample of the current family with the labels added since the previous sample.
+     *
+     * @param[in]  aValue   The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(int64_t aValue) { return Value(nullptr, aValue); }
+
+    /**
+     * This method writes a sample of the current family with the labels added since the previous sample.
+     *
+     * @param[in]  aValue   The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(double aValue) { return Value(nullptr, aValue); }
+
+    /**
+     * This method writes a sample of a series of the current family, such as the "_sum" of a histogram.
+     *
+     * @param[in]  aSuffix  The suffix of the series name, or nullptr for the family name itself.
+     * @param[in]  aValue   The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(const char *aSuffix, uint64_t aValue);
+
+    /**
+     * This method writes a sample of a series of the current family, such as the "_sum" of a histogram.
+     *
+     * @param[in]  aSuffix  The suffix of the series name, or nullptr for the family name itself.
+     * @param[in]  aValue   The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(const char *aSuffix, int64_t aValue);
+
+    /**
+     * This method writes a sample of a series of the current family, such as the "_sum" of a histogram.
+     *
+     * @param[in]  aSuffix  The suffix of the series name, or nullptr for the family name itself.
+     * @param[in]  aValue   The value, where infinities and NaN are written as "+Inf", "-Inf" and "NaN".
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    MetricsWriter &Value(const char *aSuffix, double aValue);
+
+private:
+    MetricsWriter &WriteSample(const char *aSuffix, const char *aValue);
+
+    std::string &mBuffer;
+    std::string  mFamily;
+    std::string  mLabels;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_METRICS_WRITER_HPP_
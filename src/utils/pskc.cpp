@@ -39,6 +39,10 @@
 namespace otbr {
 namespace Psk {
 
+Pskc::CacheEntry Pskc::sCache[OTBR_CONFIG_PSKC_CACHE_SIZE];
+uint32_t         Pskc::sCacheAge = 0;
+std::mutex       Pskc::sCacheMutex;
+
 void Pskc::SetSalt(const uint8_t *aExtPanId, const char *aNetworkName)
 {
     const char *saltPrefix = "Thread";
@@ -46,6 +50,7 @@ void Pskc::SetSalt(const uint8_t *aExtPanId, const char *aNetworkName)
     int         ret        = kPskcStatus_Ok;
 
     memset(mSalt, 0, sizeof(mSalt));
+    mSaltLen = 0;
     memcpy(mSalt, saltPrefix, strlen(saltPrefix));
     cur += strlen(saltPrefix);
 
@@ -66,53 +71,112 @@ exit:
     return;
 }
 
-const uint8_t *Pskc::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+bool Pskc::DeriveKey(const char *aPassphrase, uint8_t *aKey)
 {
-    uint32_t blockCounter = 0;
-    uint16_t useLen       = 0;
-    uint16_t prfBlockLen  = MBEDTLS_CIPHER_BLKSIZE_MAX;
-    uint8_t  prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
-    uint8_t  prfOutput[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint8_t  keyBlock[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint16_t keyLen = OT_PSKC_LENGTH;
-    uint8_t *pskc   = mPskc;
+    static const uint8_t kZeroKey[OT_PSKC_LENGTH] = {0};
 
-    SetSalt(aExtPanId, aNetworkName);
+    size_t passphraseLen = strlen(aPassphrase);
+    bool   ok            = true;
 
-    while (keyLen)
+    // AES-CMAC-PRF-128 (RFC 4615) uses the passphrase as the key only when it is exactly 128 bits long.
+    if (passphraseLen == OT_PSKC_LENGTH)
+    {
+        memcpy(aKey, aPassphrase, OT_PSKC_LENGTH);
+    }
+    else
     {
-        memcpy(prfInput, mSalt, mSaltLen);
-
-        blockCounter++;
-        prfInput[mSaltLen + 0] = (uint8_t)(blockCounter >> 24);
-        prfInput[mSaltLen + 1] = (uint8_t)(blockCounter >> 16);
-        prfInput[mSaltLen + 2] = (uint8_t)(blockCounter >> 8);
-        prfInput[mSaltLen + 3] = (uint8_t)(blockCounter);
-        // Calculate U_1
-        mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase), strlen(aPassphrase), prfInput,
-                                 mSaltLen + 4, prfOutput);
-        memcpy(keyBlock, prfOutput, prfBlockLen);
-
-        for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
+        ok = mbedtls_cipher_cmac(mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB), kZeroKey,
+                                 sizeof(kZeroKey) * 8, reinterpret_cast<const uint8_t *>(aPassphrase), passphraseLen,
+                                 aKey) == 0;
+    }
+
+    return ok;
+}
+
+bool Pskc::Pbkdf2(const uint8_t *aKey)
+{
+    mbedtls_cipher_context_t cmac;
+    uint8_t                  prfBlock[OT_PBKDF2_SALT_MAX_LENGTH + 4];
+    uint8_t                  prfOutput[OT_PSKC_LENGTH];
+    bool                     ok = false;
+
+    static_assert(OT_PSKC_LENGTH == MBEDTLS_CIPHER_BLKSIZE_MAX, "PSKc is derived from a single AES-CMAC block");
+
+    // The PSKc is exactly one PRF block long, so only block #1 is ever computed.
+    memcpy(prfBlock, mSalt, mSaltLen);
+    prfBlock[mSaltLen + 0] = 0;
+    prfBlock[mSaltLen + 1] = 0;
+    prfBlock[mSaltLen + 2] = 0;
+    prfBlock[mSaltLen + 3] = 1;
+
+    mbedtls_cipher_init(&cmac);
+    VerifyOrExit(mbedtls_cipher_setup(&cmac, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB)) == 0);
+
+    // The AES key schedule and CMAC subkeys only depend on the passphrase, so they are set up once.
+    VerifyOrExit(mbedtls_cipher_cmac_starts(&cmac, aKey, OT_PSKC_LENGTH * 8) == 0);
+
+    // U_1
+    VerifyOrExit(mbedtls_cipher_cmac_update(&cmac, prfBlock, mSaltLen + 4) == 0);
+    VerifyOrExit(mbedtls_cipher_cmac_finish(&cmac, prfOutput) == 0);
+    memcpy(mPskc, prfOutput, sizeof(mPskc));
+
+    for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
+    {
+        // U_i, fed back in place of the previous output
+        VerifyOrExit(mbedtls_cipher_cmac_reset(&cmac) == 0);
+        VerifyOrExit(mbedtls_cipher_cmac_update(&cmac, prfOutput, sizeof(prfOutput)) == 0);
+        VerifyOrExit(mbedtls_cipher_cmac_finish(&cmac, prfOutput) == 0);
+
+        for (uint32_t j = 0; j < sizeof(mPskc); j++)
         {
-            memcpy(prfInput, prfOutput, prfBlockLen);
+            mPskc[j] ^= prfOutput[j];
+        }
+    }
+
+    ok = true;
+
+exit:
+    mbedtls_cipher_free(&cmac);
+    return ok;
+}
+
+const uint8_t *Pskc::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+{
+    std::lock_guard<std::mutex> lock(sCacheMutex);
+    CacheEntry *                entry = NULL;
+    uint8_t                     key[OT_PSKC_LENGTH];
+
+    SetSalt(aExtPanId, aNetworkName);
+    VerifyOrExit(DeriveKey(aPassphrase, key), otbrLog(OTBR_LOG_ERR, "Failed to derive the PSKc key"));
 
-            // Calculate U_i
-            mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase), strlen(aPassphrase), prfInput,
-                                     prfBlockLen, prfOutput);
+    sCacheAge++;
 
-            // xor
-            for (uint32_t j = 0; j < prfBlockLen; j++)
-            {
-                keyBlock[j] ^= prfOutput[j];
-            }
+    for (CacheEntry &candidate : sCache)
+    {
+        if (candidate.mSaltLen == mSaltLen && memcmp(candidate.mSalt, mSalt, mSaltLen) == 0 &&
+            memcmp(candidate.mKey, key, sizeof(key)) == 0)
+        {
+            memcpy(mPskc, candidate.mPskc, sizeof(mPskc));
+            candidate.mAge = sCacheAge;
+            ExitNow();
         }
 
-        useLen = (keyLen < prfBlockLen) ? keyLen : prfBlockLen;
-        memcpy(pskc, keyBlock, useLen);
-        pskc += useLen;
-        keyLen -= useLen;
+        if (entry == NULL || candidate.mAge < entry->mAge)
+        {
+            entry = &candidate;
+        }
     }
+
+    VerifyOrExit(Pbkdf2(key), otbrLog(OTBR_LOG_ERR, "Failed to compute the PSKc"));
+
+    // Replace the least recently used entry.
+    memcpy(entry->mSalt, mSalt, mSaltLen);
+    entry->mSaltLen = mSaltLen;
+    memcpy(entry->mKey, key, sizeof(key));
+    memcpy(entry->mPskc, mPskc, sizeof(mPskc));
+    entry->mAge = sCacheAge;
+
+exit:
     return mPskc;
 }
 
@@ -42,11 +42,23 @@
 #define OT_PBKDF2_SALT_MAX_LENGTH 30
 #define OT_PSKC_LENGTH 16
 
+#include <mutex>
+
 #include <stdint.h>
 #include <string.h>
 
 #include <mbedtls/cmac.h>
 
+/**
+ * @def OTBR_CONFIG_PSKC_CACHE_SIZE
+ *
+ * The number of recently computed PSKc values kept to skip the key derivation on repeated requests.
+ *
+ */
+#ifndef OTBR_CONFIG_PSKC_CACHE_SIZE
+#define OTBR_CONFIG_PSKC_CACHE_SIZE 4
+#endif
+
 namespace otbr {
 namespace Psk {
 
@@ -62,6 +74,9 @@ public:
     /**
      * This method computes the PSKc.
      *
+     * The most recently computed values are cached, keyed on the salt and on the AES-CMAC key derived from the
+     * passphrase, so repeating a request returns without running the key derivation again.
+     *
      * @param[in]  aExtPanId      a pointer to extended PAN ID.
      * @param[in]  aNetworkName   a pointer to network name.
      * @param[in]  aPassphrase    a pointer to passphrase.
@@ -72,7 +87,22 @@ public:
     const uint8_t *ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase);
 
 private:
-    void SetSalt(const uint8_t *aExtPanId, const char *aNetworkName);
+    struct CacheEntry
+    {
+        char     mSalt[OT_PBKDF2_SALT_MAX_LENGTH];
+        uint16_t mSaltLen;
+        uint8_t  mKey[OT_PSKC_LENGTH];
+        uint8_t  mPskc[OT_PSKC_LENGTH];
+        uint32_t mAge;
+    };
+
+    void        SetSalt(const uint8_t *aExtPanId, const char *aNetworkName);
+    static bool DeriveKey(const char *aPassphrase, uint8_t *aKey);
+    bool        Pbkdf2(const uint8_t *aKey);
+
+    static CacheEntry sCache[OTBR_CONFIG_PSKC_CACHE_SIZE];
+    static uint32_t   sCacheAge;
+    static std::mutex sCacheMutex;
 
     char     mSalt[OT_PBKDF2_SALT_MAX_LENGTH];
     uint16_t mSaltLen;
@@ -28,9 +28,13 @@
 
 #include "utils/steering_data.hpp"
 
+#include <algorithm>
+
 #include <assert.h>
+#include <math.h>
 #include <mbedtls/sha256.h>
 
+#include "common/code_utils.hpp"
 #include "utils/crc16.hpp"
 
 namespace otbr {
@@ -44,7 +48,54 @@ void SteeringData::Init(uint8_t aLength)
     Clear();
 }
 
+double SteeringData::ComputeFalsePositiveRate(uint8_t aLength, size_t aJoinerCount)
+{
+    // The probability that a bit is still clear after every joiner set its bits.
+    double clear = pow(1.0 - 1.0 / (aLength * 8), static_cast<double>(kNumHashes * aJoinerCount));
+
+    return pow(1.0 - clear, kNumHashes);
+}
+
+uint8_t SteeringData::ComputeLength(size_t aJoinerCount, double aFalsePositiveRate)
+{
+    uint8_t length = 1;
+
+    while (length < kMaxSizeOfBloomFilter && ComputeFalsePositiveRate(length, aJoinerCount) > aFalsePositiveRate)
+    {
+        ++length;
+    }
+
+    return length;
+}
+
+double SteeringData::GetFalsePositiveRate(void) const
+{
+    unsigned setBits = 0;
+    double   rate    = 1.0;
+
+    VerifyOrExit(mLength > 0);
+
+    for (uint8_t i = 0; i < mLength; i++)
+    {
+        for (uint8_t bits = mBloomFilter[i]; bits != 0; bits &= bits - 1)
+        {
+            ++setBits;
+        }
+    }
+
+    // A joiner not in the list matches if all its bits happen to be set.
+    rate = pow(static_cast<double>(setBits) / (mLength * 8), kNumHashes);
+
+exit:
+    return rate;
+}
+
 void SteeringData::ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId)
+{
+    ComputeJoinerIds(aEui64, 1, aJoinerId);
+}
+
+void SteeringData::ComputeJoinerIds(const uint8_t *aEui64s, size_t aCount, uint8_t *aJoinerIds)
 {
     const size_t           kSizeHashSha256Output = 32;
     const size_t           kSizeEui64            = 8;
@@ -52,29 +103,116 @@ void SteeringData::ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId)
     mbedtls_sha256_context sha256;
 
     mbedtls_sha256_init(&sha256);
-    mbedtls_sha256_starts(&sha256, 0);
-    mbedtls_sha256_update(&sha256, aEui64, kSizeEui64);
-    mbedtls_sha256_finish(&sha256, hash);
 
-    memcpy(aJoinerId, hash, kSizeJoinerId);
-    aJoinerId[0] |= 2;
+    for (size_t i = 0; i < aCount; i++)
+    {
+        mbedtls_sha256_starts(&sha256, 0);
+        mbedtls_sha256_update(&sha256, aEui64s + i * kSizeEui64, kSizeEui64);
+        mbedtls_sha256_finish(&sha256, hash);
+
+        memcpy(aJoinerIds + i * kSizeJoinerId, hash, kSizeJoinerId);
+        aJoinerIds[i * kSizeJoinerId] |= 2;
+    }
+
+    mbedtls_sha256_free(&sha256);
 }
 
-void SteeringData::ComputeBloomFilter(const uint8_t *aJoinerId)
+SteeringData::JoinerHash SteeringData::ComputeJoinerHash(const uint8_t *aJoinerId)
+{
+    Crc16      ccitt(Crc16::kCcitt);
+    Crc16      ansi(Crc16::kAnsi);
+    JoinerHash hash;
+
+    ccitt.Update(aJoinerId, kSizeJoinerId);
+    ansi.Update(aJoinerId, kSizeJoinerId);
+
+    hash.mCcitt = ccitt.Get();
+    hash.mAnsi  = ansi.Get();
+
+    return hash;
+}
+
+void SteeringData::AddJoinerHash(const JoinerHash &aHash)
 {
-    Crc16          ccitt(Crc16::kCcitt);
-    Crc16          ansi(Crc16::kAnsi);
     const uint16_t numBits = mLength * 8;
 
-    for (size_t i = 0; i < kSizeJoinerId; i++)
+    SetBit(static_cast<uint8_t>(aHash.mCcitt % numBits));
+    SetBit(static_cast<uint8_t>(aHash.mAnsi % numBits));
+}
+
+void SteeringData::ComputeBloomFilter(const uint8_t *aJoinerId)
+{
+    AddJoinerHash(ComputeJoinerHash(aJoinerId));
+}
+
+SteeringDataBuilder::SteeringDataBuilder(uint8_t aLength)
+{
+    mSteeringData.Init(aLength);
+}
+
+void SteeringDataBuilder::AddJoiners(const uint8_t *aEui64s, size_t aCount)
+{
+    std::vector<uint8_t> joinerIds(aCount * SteeringData::kSizeJoinerId);
+
+    VerifyOrExit(aCount > 0);
+
+    SteeringData::ComputeJoinerIds(aEui64s, aCount, joinerIds.data());
+    mJoinerHashes.reserve(mJoinerHashes.size() + aCount);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        SteeringData::JoinerHash hash = SteeringData::ComputeJoinerHash(&joinerIds[i * SteeringData::kSizeJoinerId]);
+
+        mJoinerHashes.push_back(hash);
+        mSteeringData.AddJoinerHash(hash);
+    }
+
+exit:
+    return;
+}
+
+bool SteeringDataBuilder::RemoveJoiner(const uint8_t *aEui64)
+{
+    uint8_t                                         joinerId[SteeringData::kSizeJoinerId];
+    SteeringData::JoinerHash                        hash;
+    std::vector<SteeringData::JoinerHash>::iterator it;
+    bool                                            found = false;
+
+    SteeringData::ComputeJoinerId(aEui64, joinerId);
+    hash = SteeringData::ComputeJoinerHash(joinerId);
+
+    it = std::find(mJoinerHashes.begin(), mJoinerHashes.end(), hash);
+    VerifyOrExit(it != mJoinerHashes.end());
+
+    // Order does not matter to the bloom filter.
+    *it = mJoinerHashes.back();
+    mJoinerHashes.pop_back();
+    Rebuild(mSteeringData.GetLength());
+    found = true;
+
+exit:
+    return found;
+}
+
+void SteeringDataBuilder::Clear(void)
+{
+    mJoinerHashes.clear();
+    mSteeringData.Clear();
+}
+
+void SteeringDataBuilder::Rebuild(uint8_t aLength)
+{
+    mSteeringData.Init(aLength);
+
+    for (const SteeringData::JoinerHash &hash : mJoinerHashes)
     {
-        uint8_t byte = aJoinerId[i];
-        ccitt.Update(byte);
-        ansi.Update(byte);
+        mSteeringData.AddJoinerHash(hash);
     }
+}
 
-    SetBit(static_cast<uint8_t>(ccitt.Get() % numBits));
-    SetBit(static_cast<uint8_t>(ansi.Get() % numBits));
+void SteeringDataBuilder::RebuildForFalsePositiveRate(double aFalsePositiveRate)
+{
+    Rebuild(SteeringData::ComputeLength(mJoinerHashes.size(), aFalsePositiveRate));
 }
 
 } // namespace otbr
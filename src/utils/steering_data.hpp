@@ -36,6 +36,9 @@
 
 #include "openthread-br/config.h"
 
+#include <vector>
+
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -52,8 +55,33 @@ public:
     {
         kMaxSizeOfBloomFilter = 16, ///< Max length of bloom filter in bytes.
         kSizeJoinerId         = 8,  ///< Size of Extended Joiner ID.
+        kNumHashes            = 2,  ///< Number of bloom filter bits set by a joiner.
     };
 
+    /**
+     * This method estimates the false positive rate of a bloom filter, i.e. the probability that a joiner not in the
+     * list matches it.
+     *
+     * @param[in]   aLength         Length of the bloom filter in bytes.
+     * @param[in]   aJoinerCount    The number of joiners in the bloom filter.
+     *
+     * @returns The false positive rate, between 0 and 1.
+     *
+     */
+    static double ComputeFalsePositiveRate(uint8_t aLength, size_t aJoinerCount);
+
+    /**
+     * This method computes the shortest bloom filter length keeping the false positive rate of a number of joiners
+     * within a target.
+     *
+     * @param[in]   aJoinerCount        The number of joiners.
+     * @param[in]   aFalsePositiveRate  The target false positive rate, between 0 and 1.
+     *
+     * @returns The length in bytes, kMaxSizeOfBloomFilter if no length reaches the target.
+     *
+     */
+    static uint8_t ComputeLength(size_t aJoinerCount, double aFalsePositiveRate);
+
     /**
      * This method initializes the bloom filter.
      *
@@ -90,6 +118,19 @@ public:
      */
     void ComputeBloomFilter(const uint8_t *aJoinerId);
 
+    /**
+     * This method computes joiner ids from EUI64s.
+     *
+     * This is equivalent to calling ComputeJoinerId() on each EUI64, but the hash context is set up only once.
+     *
+     * @param[in]   aEui64s     A pointer to @p aCount consecutive EUI64s.
+     * @param[in]   aCount      The number of EUI64s.
+     * @param[out]  aJoinerIds  A pointer to receive @p aCount consecutive joiner ids. This pointer can be the same as
+     *                          @p aEui64s.
+     *
+     */
+    static void ComputeJoinerIds(const uint8_t *aEui64s, size_t aCount, uint8_t *aJoinerIds);
+
     /**
      * This method computes joiner id from EUI64.
      *
@@ -113,11 +154,133 @@ public:
      */
     uint8_t GetLength(void) const { return mLength; }
 
+    /**
+     * This method returns the false positive rate of the bloom filter, estimated from the bits it has set.
+     *
+     * @returns The false positive rate, between 0 and 1.
+     *
+     */
+    double GetFalsePositiveRate(void) const;
+
+    /**
+     * This structure represents the two bloom filter hashes of a joiner id.
+     *
+     */
+    struct JoinerHash
+    {
+        uint16_t mCcitt; ///< CRC16-CCITT of the joiner id.
+        uint16_t mAnsi;  ///< CRC16-ANSI of the joiner id.
+
+        bool operator==(const JoinerHash &aOther) const { return mCcitt == aOther.mCcitt && mAnsi == aOther.mAnsi; }
+    };
+
+    /**
+     * This method computes the bloom filter hashes of a joiner id.
+     *
+     * @param[in]  aJoinerId  A pointer to the joiner id.
+     *
+     * @returns The bloom filter hashes.
+     *
+     */
+    static JoinerHash ComputeJoinerHash(const uint8_t *aJoinerId);
+
+    /**
+     * This method adds a joiner to the bloom filter by its hashes.
+     *
+     * @param[in]  aHash  The bloom filter hashes of the joiner id.
+     *
+     */
+    void AddJoinerHash(const JoinerHash &aHash);
+
 private:
     uint8_t mBloomFilter[kMaxSizeOfBloomFilter];
     uint8_t mLength;
 };
 
+/**
+ * This class builds Steering Data for a changing list of joiners.
+ *
+ * The bloom filter hashes of every joiner are kept, so adding joiners only costs their own hashes, and removing a
+ * joiner or changing the filter length rebuilds the filter without hashing any joiner again.
+ *
+ */
+class SteeringDataBuilder
+{
+public:
+    /**
+     * This constructor initializes an empty builder.
+     *
+     * @param[in]  aLength  Length of the bloom filter in bytes.
+     *
+     */
+    explicit SteeringDataBuilder(uint8_t aLength = SteeringData::kMaxSizeOfBloomFilter);
+
+    /**
+     * This method adds joiners by their EUI64s.
+     *
+     * @param[in]  aEui64s  A pointer to @p aCount consecutive EUI64s.
+     * @param[in]  aCount   The number of EUI64s.
+     *
+     */
+    void AddJoiners(const uint8_t *aEui64s, size_t aCount);
+
+    /**
+     * This method adds a joiner by its EUI64.
+     *
+     * @param[in]  aEui64  A pointer to the EUI64.
+     *
+     */
+    void AddJoiner(const uint8_t *aEui64) { AddJoiners(aEui64, 1); }
+
+    /**
+     * This method removes a joiner previously added with its EUI64.
+     *
+     * @param[in]  aEui64  A pointer to the EUI64.
+     *
+     * @returns Whether the joiner was found.
+     *
+     */
+    bool RemoveJoiner(const uint8_t *aEui64);
+
+    /**
+     * This method removes all joiners.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method rebuilds the bloom filter of all joiners with a new length.
+     *
+     * @param[in]  aLength  Length of the bloom filter in bytes.
+     *
+     */
+    void Rebuild(uint8_t aLength);
+
+    /**
+     * This method rebuilds the bloom filter of all joiners with the shortest length reaching a false positive rate.
+     *
+     * @param[in]  aFalsePositiveRate  The target false positive rate, between 0 and 1.
+     *
+     */
+    void RebuildForFalsePositiveRate(double aFalsePositiveRate);
+
+    /**
+     * This method returns the number of joiners.
+     *
+     */
+    size_t GetJoinerCount(void) const { return mJoinerHashes.size(); }
+
+    /**
+     * This method returns the steering data of all joiners.
+     *
+     */
+    const SteeringData &GetSteeringData(void) const { return mSteeringData; }
+
+private:
+    SteeringData                          mSteeringData;
+    std::vector<SteeringData::JoinerHash> mJoinerHashes;
+};
+
 } /* namespace otbr */
 
 #endif // OTBR_UTILS_STEERING_DATA_HPP_
@@ -0,0 +1,100 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the paginated and filtered queries of the child and neighbor tables.
+ */
+
+#include "utils/table_query.hpp"
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+TableQuery::TableQuery(void)
+    : mOffset(0)
+    , mLimit(0)
+    , mMatched(0)
+    , mExtAddress(0)
+    , mRloc16(0)
+    , mMinLinkQuality(0)
+    , mMaxLinkQuality(kMaxLinkQuality)
+    , mHasRloc16(false)
+    , mHasExtAddress(false)
+{
+}
+
+void TableQuery::SetPage(uint32_t aOffset, uint32_t aLimit)
+{
+    mOffset = aOffset;
+    mLimit  = aLimit;
+}
+
+void TableQuery::SetRloc16(uint16_t aRloc16)
+{
+    mRloc16    = aRloc16;
+    mHasRloc16 = true;
+}
+
+void TableQuery::SetExtAddress(uint64_t aExtAddress)
+{
+    mExtAddress    = aExtAddress;
+    mHasExtAddress = true;
+}
+
+bool TableQuery::SetLinkQualityRange(uint8_t aMin, uint8_t aMax)
+{
+    bool valid = (aMin <= aMax && aMax <= kMaxLinkQuality);
+
+    if (valid)
+    {
+        mMinLinkQuality = aMin;
+        mMaxLinkQuality = aMax;
+    }
+
+    return valid;
+}
+
+bool TableQuery::Select(uint16_t aRloc16, uint64_t aExtAddress, uint8_t aLinkQuality)
+{
+    uint32_t index;
+    bool     selected = false;
+
+    VerifyOrExit(!mHasRloc16 || aRloc16 == mRloc16);
+    VerifyOrExit(!mHasExtAddress || aExtAddress == mExtAddress);
+    VerifyOrExit(aLinkQuality >= mMinLinkQuality && aLinkQuality <= mMaxLinkQuality);
+
+    index    = mMatched++;
+    selected = (index >= mOffset && (mLimit == 0 || index - mOffset < mLimit));
+
+exit:
+    return selected;
+}
+
+} // namespace otbr
@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the paginated and filtered queries of the child and neighbor tables.
+ */
+
+#ifndef OTBR_UTILS_TABLE_QUERY_HPP_
+#define OTBR_UTILS_TABLE_QUERY_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+namespace otbr {
+
+/**
+ * This class selects the entries of a table query while the table is iterated.
+ *
+ * The filters are applied first, then the page is taken out of the matching entries, so that only the entries of
+ * the page are encoded. The iteration may go on past the page to count all the matching entries.
+ *
+ */
+class TableQuery
+{
+public:
+    enum
+    {
+        kMaxLinkQuality = 3, ///< The highest link quality.
+    };
+
+    /**
+     * The constructor initializes a query selecting the whole table.
+     *
+     */
+    TableQuery(void);
+
+    /**
+     * This method sets the page to select out of the matching entries.
+     *
+     * @param[in]   aOffset     The number of matching entries to skip.
+     * @param[in]   aLimit      The max number of entries to select, 0 for no limit.
+     *
+     */
+    void SetPage(uint32_t aOffset, uint32_t aLimit);
+
+    /**
+     * This method filters the entries by RLOC16.
+     *
+     * @param[in]   aRloc16     The RLOC16 of the entries to match.
+     *
+     */
+    void SetRloc16(uint16_t aRloc16);
+
+    /**
+     * This method filters the entries by extended address.
+     *
+     * @param[in]   aExtAddress     The extended address of the entries to match, as a big-endian integer.
+     *
+     */
+    void SetExtAddress(uint64_t aExtAddress);
+
+    /**
+     * This method filters the entries by incoming link quality.
+     *
+     * @param[in]   aMin    The lowest link quality to match.
+     * @param[in]   aMax    The highest link quality to match.
+     *
+     * @returns Whether the range is valid.
+     *
+     */
+    bool SetLinkQualityRange(uint8_t aMin, uint8_t aMax);
+
+    /**
+     * This method tells whether an entry is selected, and counts it if it matches the filters.
+     *
+     * @param[in]   aRloc16         The RLOC16 of the entry.
+     * @param[in]   aExtAddress     The extended address of the entry, as a big-endian integer.
+     * @param[in]   aLinkQuality    The incoming link quality of the entry.
+     *
+     * @retval true     The entry matches the filters and is within the page.
+     * @retval false    The entry is filtered out or outside the page.
+     *
+     */
+    bool Select(uint16_t aRloc16, uint64_t aExtAddress, uint8_t aLinkQuality);
+
+    /**
+     * This method returns the number of entries which matched the filters so far.
+     *
+     * @returns The number of matching entries.
+     *
+     */
+    uint32_t GetMatched(void) const { return mMatched; }
+
+private:
+    uint32_t mOffset;
+    uint32_t mLimit;
+    uint32_t mMatched;
+    uint64_t mExtAddress;
+    uint16_t mRloc16;
+    uint8_t  mMinLinkQuality;
+    uint8_t  mMaxLinkQuality;
+    bool     mHasRloc16;
+    bool     mHasExtAddress;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_TABLE_QUERY_HPP_
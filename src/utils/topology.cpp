@@ -0,0 +1,172 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the Thread network topology crawler.
+ */
+
+#include "utils/topology.hpp"
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+
+Topology::Topology(QuerySender aSender, uint8_t aMaxQueries, uint32_t aQueryTimeout, uint32_t aNodeTtl)
+    : mSender(aSender)
+    , mMaxQueries(aMaxQueries)
+    , mQueryTimeout(aQueryTimeout)
+    , mNodeTtl(aNodeTtl)
+{
+}
+
+void Topology::Start(uint64_t aNow, const std::vector<uint16_t> &aRouters)
+{
+    if (!IsCrawling())
+    {
+        mCrawledRouters.clear();
+    }
+
+    for (uint16_t rloc16 : aRouters)
+    {
+        AddPendingRouter(rloc16);
+    }
+
+    SendQueries(aNow);
+}
+
+void Topology::Stop(void)
+{
+    mPendingRouters.clear();
+    mQueries.clear();
+    mCrawledRouters.clear();
+}
+
+void Topology::Clear(void)
+{
+    Stop();
+    mNodes.clear();
+}
+
+void Topology::HandleResponse(uint64_t aNow, const Node &aNode, const std::vector<uint16_t> &aRouters)
+{
+    Node &node = mNodes[aNode.mRloc16];
+
+    node             = aNode;
+    node.mUpdateTime = aNow;
+
+    VerifyOrExit(IsCrawling());
+
+    mQueries.erase(aNode.mRloc16);
+    mCrawledRouters.insert(aNode.mRloc16);
+
+    for (uint16_t rloc16 : aRouters)
+    {
+        AddPendingRouter(rloc16);
+    }
+
+    SendQueries(aNow);
+
+exit:
+    return;
+}
+
+void Topology::Process(uint64_t aNow)
+{
+    for (auto query = mQueries.begin(); query != mQueries.end();)
+    {
+        if (query->second <= aNow)
+        {
+            // The router keeps its last known state until it expires.
+            query = mQueries.erase(query);
+        }
+        else
+        {
+            ++query;
+        }
+    }
+
+    SendQueries(aNow);
+}
+
+bool Topology::GetNextDeadline(uint64_t &aDeadline) const
+{
+    bool found = false;
+
+    for (const auto &query : mQueries)
+    {
+        if (!found || query.second < aDeadline)
+        {
+            aDeadline = query.second;
+            found     = true;
+        }
+    }
+
+    return found;
+}
+
+void Topology::Expire(uint64_t aNow)
+{
+    for (auto node = mNodes.begin(); node != mNodes.end();)
+    {
+        if (aNow - node->second.mUpdateTime > mNodeTtl)
+        {
+            node = mNodes.erase(node);
+        }
+        else
+        {
+            ++node;
+        }
+    }
+}
+
+void Topology::AddPendingRouter(uint16_t aRloc16)
+{
+    if (mCrawledRouters.insert(aRloc16).second)
+    {
+        mPendingRouters.push_back(aRloc16);
+    }
+}
+
+void Topology::SendQueries(uint64_t aNow)
+{
+    while (!mPendingRouters.empty() && mQueries.size() < mMaxQueries)
+    {
+        uint16_t rloc16 = mPendingRouters.front();
+
+        mPendingRouters.pop_front();
+
+        // A router whose query cannot be sent is skipped for this crawl, so that the crawl always ends.
+        if (mSender(rloc16))
+        {
+            mQueries[rloc16] = aNow + mQueryTimeout;
+        }
+    }
+}
+
+} // namespace otbr
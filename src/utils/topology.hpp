@@ -0,0 +1,214 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the Thread network topology crawler.
+ */
+
+#ifndef OTBR_UTILS_TOPOLOGY_HPP_
+#define OTBR_UTILS_TOPOLOGY_HPP_
+
+#include "openthread-br/config.h"
+
+#include <stdint.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace otbr {
+
+/**
+ * This class keeps the graph of a Thread network, and crawls the routers to refresh it.
+ *
+ * A crawl queries the routers with a bounded number of queries in flight, and follows the routers each response
+ * knows of, so that a single router is enough to start from. The graph is updated as the responses arrive, and a
+ * node is kept until it has not responded for a given time.
+ *
+ * This class only schedules the queries, sending them and parsing the responses is up to its user.
+ *
+ */
+class Topology
+{
+public:
+    /**
+     * This structure represents a link from a router to a neighboring router.
+     *
+     */
+    struct Link
+    {
+        uint16_t mRloc16;         ///< The RLOC16 of the neighboring router.
+        uint8_t  mLinkQualityIn;  ///< The incoming link quality, from 1 to 3.
+        uint8_t  mLinkQualityOut; ///< The outgoing link quality, from 1 to 3.
+    };
+
+    /**
+     * This structure represents a child of a router.
+     *
+     */
+    struct Child
+    {
+        uint16_t mRloc16; ///< The RLOC16 of the child.
+        uint8_t  mMode;   ///< The link mode of the child, as in the Mode TLV.
+    };
+
+    /**
+     * This structure represents a router of the network.
+     *
+     */
+    struct Node
+    {
+        uint16_t           mRloc16;     ///< The RLOC16 of the router.
+        uint64_t           mExtAddress; ///< The extended address of the router, 0 if not known.
+        std::vector<Link>  mLinks;      ///< The links to the neighboring routers.
+        std::vector<Child> mChildren;   ///< The children.
+        uint64_t           mUpdateTime; ///< The time the router last responded, in milliseconds.
+    };
+
+    /**
+     * This function sends a query to a router.
+     *
+     * @param[in]   aRloc16     The RLOC16 of the router.
+     *
+     * @retval  true    The query was sent.
+     * @retval  false   The query could not be sent.
+     *
+     */
+    using QuerySender = std::function<bool(uint16_t aRloc16)>;
+
+    /**
+     * The constructor initializes an empty graph.
+     *
+     * @param[in]   aSender         The function sending the queries.
+     * @param[in]   aMaxQueries     The maximum number of queries in flight.
+     * @param[in]   aQueryTimeout   The time to wait for a response to a query, in milliseconds.
+     * @param[in]   aNodeTtl        The time a node is kept without a response, in milliseconds.
+     *
+     */
+    Topology(QuerySender aSender, uint8_t aMaxQueries, uint32_t aQueryTimeout, uint32_t aNodeTtl);
+
+    /**
+     * This method starts a crawl.
+     *
+     * A crawl in progress goes on with the given routers added.
+     *
+     * @param[in]   aNow        The current time, in milliseconds.
+     * @param[in]   aRouters    The RLOC16s of the routers to start from.
+     *
+     */
+    void Start(uint64_t aNow, const std::vector<uint16_t> &aRouters);
+
+    /**
+     * This method stops the crawl in progress, the graph is kept.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method stops the crawl in progress and drops the graph.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method indicates whether a crawl is in progress.
+     *
+     * @retval  true    Some routers are still to be queried or to respond.
+     * @retval  false   No crawl is in progress.
+     *
+     */
+    bool IsCrawling(void) const { return !mPendingRouters.empty() || !mQueries.empty(); }
+
+    /**
+     * This method handles the response of a router.
+     *
+     * Responses from routers not queried, or after their query timed out, update the graph too.
+     *
+     * @param[in]   aNow        The current time, in milliseconds.
+     * @param[in]   aNode       The router, its update time is ignored.
+     * @param[in]   aRouters    The RLOC16s of all routers the responding router knows of, for the crawl to follow.
+     *
+     */
+    void HandleResponse(uint64_t aNow, const Node &aNode, const std::vector<uint16_t> &aRouters);
+
+    /**
+     * This method times out the queries in flight, and sends the next ones.
+     *
+     * @param[in]   aNow    The current time, in milliseconds.
+     *
+     */
+    void Process(uint64_t aNow);
+
+    /**
+     * This method returns when Process() needs to be called next.
+     *
+     * @param[out]  aDeadline   The time the first query in flight times out, in milliseconds.
+     *
+     * @retval  true    @p aDeadline is set.
+     * @retval  false   No query is in flight.
+     *
+     */
+    bool GetNextDeadline(uint64_t &aDeadline) const;
+
+    /**
+     * This method drops the routers which have not responded for the time to live of a node.
+     *
+     * @param[in]   aNow    The current time, in milliseconds.
+     *
+     */
+    void Expire(uint64_t aNow);
+
+    /**
+     * This method returns the routers of the graph.
+     *
+     * @returns The routers, keyed by RLOC16.
+     *
+     */
+    const std::map<uint16_t, Node> &GetNodes(void) const { return mNodes; }
+
+private:
+    void AddPendingRouter(uint16_t aRloc16);
+    void SendQueries(uint64_t aNow);
+
+    QuerySender mSender;
+    uint8_t     mMaxQueries;
+    uint32_t    mQueryTimeout;
+    uint32_t    mNodeTtl;
+
+    std::deque<uint16_t>         mPendingRouters; ///< The routers to query.
+    std::map<uint16_t, uint64_t> mQueries;        ///< The deadlines of the queries in flight, keyed by RLOC16.
+    std::set<uint16_t>           mCrawledRouters; ///< The routers queried or to query by the crawl in progress.
+    std::map<uint16_t, Node>     mNodes;
+};
+
+} // namespace otbr
+
+#endif // OTBR_UTILS_TOPOLOGY_HPP_
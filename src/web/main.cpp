@@ -32,6 +32,8 @@
  */
 #define OT_HTTP_PORT 80
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_WEB
+
 #include "openthread-br/config.h"
 
 #include <errno.h>
@@ -43,8 +45,19 @@
 
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/thread_policy.hpp"
 #include "web/web-service/web_server.hpp"
 
+#ifndef OTBR_CONFIG_WEB_THREAD_POOL_SIZE
+/**
+ * The default number of threads handling http requests.
+ *
+ * More than one thread keeps page loads responsive while a slow request, such as a scan, is being handled.
+ *
+ */
+#define OTBR_CONFIG_WEB_THREAD_POOL_SIZE 4
+#endif
+
 static const char kSyslogIdent[]          = "otWeb";
 static const char kDefaultInterfaceName[] = "wpan0";
 static const char kDefaultListenAddr[]    = "0.0.0.0";
@@ -73,12 +86,12 @@ int main(int argc, char **argv)
     const char *interfaceName  = nullptr;
     const char *httpListenAddr = nullptr;
     const char *httpPort       = nullptr;
-    int         logLevel       = OTBR_LOG_INFO;
     int         ret            = 0;
     int         opt;
-    uint16_t    port = OT_HTTP_PORT;
+    uint16_t    port           = OT_HTTP_PORT;
+    size_t      threadPoolSize = OTBR_CONFIG_WEB_THREAD_POOL_SIZE;
 
-    while ((opt = getopt(argc, argv, "d:I:p:v:a:")) != -1)
+    while ((opt = getopt(argc, argv, "d:I:p:S:t:v:a:")) != -1)
     {
         switch (opt)
         {
@@ -86,7 +99,7 @@ int main(int argc, char **argv)
             httpListenAddr = optarg;
             break;
         case 'd':
-            logLevel = atoi(optarg);
+            VerifyOrExit(otbrLogParseLevel(optarg), fprintf(stderr, "Invalid debug level: %s\n", optarg), ret = -1);
             break;
         case 'I':
             interfaceName = optarg;
@@ -98,13 +111,25 @@ int main(int argc, char **argv)
             port = atoi(httpPort);
             break;
 
+        case 'S':
+            VerifyOrExit(otbr::ParseThreadPolicy(optarg), fprintf(stderr, "Invalid thread policy: %s\n", optarg),
+                         ret = -1);
+            break;
+
+        case 't':
+            VerifyOrExit(atoi(optarg) > 0, fprintf(stderr, "Invalid thread pool size: %s\n", optarg), ret = -1);
+            threadPoolSize = static_cast<size_t>(atoi(optarg));
+            break;
+
         case 'v':
             PrintVersion();
             ExitNow();
             break;
 
         default:
-            fprintf(stderr, "Usage: %s [-d DEBUG_LEVEL] [-I interfaceName] [-p port] [-a listenAddress] [-v]\n",
+            fprintf(stderr,
+                    "Usage: %s [-d [MODULE=]DEBUG_LEVEL]... [-I interfaceName] [-p port] [-a listenAddress] "
+                    "[-S CLASS=[POLICY[:PRIORITY]][@CPUS]]... [-t threads] [-v]\n",
                     argv[0]);
             ExitNow(ret = -1);
             break;
@@ -128,7 +153,8 @@ int main(int argc, char **argv)
         printf("http port not specified, using default %d\n", port);
     }
 
-    otbrLogInit(kSyslogIdent, logLevel, true);
+    otbrLogInit(kSyslogIdent, otbrLogGetLevel(), true);
+    otbr::ApplyThreadPolicy(otbr::kThreadClassMain);
     otbrLog(OTBR_LOG_INFO, "border router web started on %s", interfaceName);
 
     // allow quitting elegantly
@@ -136,7 +162,7 @@ int main(int argc, char **argv)
     signal(SIGINT, HandleSignal);
 
     sServer.reset(new otbr::Web::WebServer());
-    sServer->StartWebServer(interfaceName, httpListenAddr, port);
+    sServer->StartWebServer(interfaceName, httpListenAddr, port, threadPoolSize);
 
     otbrLogDeinit();
 
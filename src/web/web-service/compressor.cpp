@@ -0,0 +1,113 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the compressor of http response bodies.
+ */
+
+#include "web/web-service/compressor.hpp"
+
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+#ifndef OTBR_CONFIG_WEB_COMPRESSION_LEVEL
+/**
+ * The zlib compression level of http response bodies.
+ *
+ * The bodies are small JSON documents compressed on every request, so a fast level is used.
+ *
+ */
+#define OTBR_CONFIG_WEB_COMPRESSION_LEVEL 1
+#endif
+
+namespace otbr {
+namespace Web {
+
+Compressor::Compressor(void)
+{
+    memset(mStreams, 0, sizeof(mStreams));
+    for (bool &initialized : mInitialized)
+    {
+        initialized = false;
+    }
+}
+
+Compressor::~Compressor(void)
+{
+    for (int i = 0; i < kCodingNum; i++)
+    {
+        if (mInitialized[i])
+        {
+            deflateEnd(&mStreams[i]);
+        }
+    }
+}
+
+const char *Compressor::GetCodingName(Coding aCoding)
+{
+    return aCoding == kCodingGzip ? "gzip" : "deflate";
+}
+
+bool Compressor::Compress(Coding aCoding, const std::string &aContent, std::string &aCompressed)
+{
+    // 16 is added to the window bits for a gzip header and trailer instead of the zlib ones.
+    static const int kWindowBits[kCodingNum] = {MAX_WBITS + 16, MAX_WBITS};
+
+    z_stream &stream  = mStreams[aCoding];
+    bool      success = false;
+
+    if (!mInitialized[aCoding])
+    {
+        VerifyOrExit(deflateInit2(&stream, OTBR_CONFIG_WEB_COMPRESSION_LEVEL, Z_DEFLATED, kWindowBits[aCoding],
+                                  MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY) == Z_OK);
+        mInitialized[aCoding] = true;
+    }
+    else
+    {
+        VerifyOrExit(deflateReset(&stream) == Z_OK);
+    }
+
+    aCompressed.resize(deflateBound(&stream, static_cast<uLong>(aContent.size())));
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(aContent.data()));
+    stream.avail_in  = static_cast<uInt>(aContent.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&aCompressed[0]);
+    stream.avail_out = static_cast<uInt>(aCompressed.size());
+
+    // The bound leaves room for the whole output, so a single call finishes the stream.
+    VerifyOrExit(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+    aCompressed.resize(stream.total_out);
+    success = true;
+
+exit:
+    return success;
+}
+
+} // namespace Web
+} // namespace otbr
@@ -0,0 +1,113 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the compressor of http response bodies.
+ */
+
+#ifndef OTBR_WEB_WEB_SERVICE_COMPRESSOR_
+#define OTBR_WEB_WEB_SERVICE_COMPRESSOR_
+
+#include "openthread-br/config.h"
+
+#include <string>
+
+#include <zlib.h>
+
+namespace otbr {
+namespace Web {
+
+/**
+ * This class compresses http response bodies with zlib.
+ *
+ * The deflate streams are kept and reset between bodies, instead of allocated for each body. A compressor is not
+ * thread safe, each thread should have its own.
+ *
+ */
+class Compressor
+{
+public:
+    /**
+     * The content codings of http.
+     *
+     */
+    enum Coding
+    {
+        kCodingGzip,    ///< gzip, RFC 1952.
+        kCodingDeflate, ///< deflate, which is the zlib format of RFC 1950.
+        kCodingNum,
+    };
+
+    /**
+     * This constructor creates a compressor, whose streams are set up on first use.
+     *
+     */
+    Compressor(void);
+
+    /**
+     * This destructor frees the streams.
+     *
+     */
+    ~Compressor(void);
+
+    /**
+     * This method compresses a body.
+     *
+     * @param[in]   aCoding     The content coding.
+     * @param[in]   aContent    The body.
+     * @param[out]  aCompressed The compressed body.
+     *
+     * @retval TRUE   Successfully compressed the body.
+     * @retval FALSE  Failed to compress the body, for lack of memory.
+     *
+     */
+    bool Compress(Coding aCoding, const std::string &aContent, std::string &aCompressed);
+
+    /**
+     * This method returns the token of a content coding, as in the Content-Encoding header.
+     *
+     * @param[in]  aCoding  The content coding.
+     *
+     * @returns The token of the content coding.
+     *
+     */
+    static const char *GetCodingName(Coding aCoding);
+
+private:
+    Compressor(const Compressor &) = delete;
+    Compressor &operator=(const Compressor &) = delete;
+
+    z_stream mStreams[kCodingNum];
+    bool     mInitialized[kCodingNum];
+};
+
+} // namespace Web
+} // namespace otbr
+
+#endif // OTBR_WEB_WEB_SERVICE_COMPRESSOR_
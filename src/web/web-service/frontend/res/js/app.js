@@ -48,9 +48,68 @@
                     networkInfo = value
                 },
             };
+        })
+        .factory('jobs', function($http, $q, $timeout) {
+            // Polls the job status, for browsers without Server-Sent Events or when the stream is broken.
+            function poll(id, resolve, reject) {
+                $http.get('/jobs/' + id).then(function(response) {
+                    if (response.data.state == 'done') {
+                        resolve({data: response.data.result});
+                    } else {
+                        $timeout(function() {
+                            poll(id, resolve, reject);
+                        }, 1000);
+                    }
+                }, reject);
+            }
+
+            return {
+                // Starts a job, and resolves with its result. The other events of the job are passed to onEvent.
+                run: function(operation, data, onEvent) {
+                    return $http({
+                        method: 'POST',
+                        url: '/jobs/' + operation,
+                        data: data,
+                    }).then(function(response) {
+                        var id = response.data.job;
+
+                        return $q(function(resolve, reject) {
+                            if (typeof EventSource === 'undefined') {
+                                poll(id, resolve, reject);
+                                return;
+                            }
+
+                            var source = new EventSource('/jobs/' + id + '/events');
+                            ['state', 'network'].forEach(function(name) {
+                                source.addEventListener(name, function(event) {
+                                    if (onEvent) {
+                                        $timeout(function() {
+                                            onEvent(name, JSON.parse(event.data));
+                                        });
+                                    }
+                                });
+                            });
+                            source.addEventListener('result', function(event) {
+                                source.close();
+                                resolve({data: JSON.parse(event.data)});
+                            });
+                            source.onerror = function() {
+                                source.close();
+                                poll(id, resolve, reject);
+                            };
+                        });
+                    }, function(response) {
+                        // Too many operations are pending, and the busy result is shown as a failure of this one.
+                        if (response.status == 429) {
+                            return {data: response.data};
+                        }
+                        return $q.reject(response);
+                    });
+                },
+            };
         });
 
-    function AppCtrl($scope, $http, $mdDialog, $interval, sharedProperties) {
+    function AppCtrl($scope, $http, $mdDialog, $interval, $timeout, sharedProperties, jobs) {
         $scope.menu = [{
                 title: 'Home',
                 icon: 'home',
@@ -102,6 +161,73 @@
         $scope.headerTitle = 'Home';
         $scope.status = [];
 
+        // The status is pushed by the server while the Status panel is shown.
+        var statusSource = null;
+        var statusJson = {};
+
+        function showStatus() {
+            $scope.status = [];
+            Object.keys(statusJson).sort().forEach(function(name) {
+                $scope.status.push({
+                    name: name,
+                    value: statusJson[name],
+                    icon: 'res/img/icon-info.png',
+                });
+            });
+        }
+
+        function getStatus() {
+            $http.get('/get_properties').then(function(response) {
+                if (response.data.error == 0) {
+                    statusJson = response.data.result;
+                    showStatus();
+                }
+            });
+        }
+
+        function watchStatus() {
+            if (typeof EventSource === 'undefined') {
+                getStatus();
+                return;
+            }
+
+            statusSource = new EventSource('/status/events');
+            statusSource.addEventListener('status', function(event) {
+                var data = JSON.parse(event.data);
+
+                $timeout(function() {
+                    statusJson = data.error == 0 ? data.result : {};
+                    showStatus();
+                });
+            });
+            // Only the changed members are sent, and removed ones are null.
+            statusSource.addEventListener('delta', function(event) {
+                var delta = JSON.parse(event.data);
+
+                $timeout(function() {
+                    Object.keys(delta).forEach(function(name) {
+                        if (delta[name] === null) {
+                            delete statusJson[name];
+                        } else {
+                            statusJson[name] = delta[name];
+                        }
+                    });
+                    showStatus();
+                });
+            });
+            statusSource.onerror = function() {
+                unwatchStatus();
+                getStatus();
+            };
+        }
+
+        function unwatchStatus() {
+            if (statusSource) {
+                statusSource.close();
+                statusSource = null;
+            }
+        }
+
         $scope.isLoading = false;
 
         $scope.showScanAlert = function(ev) {
@@ -122,9 +248,15 @@
                 $scope.menu[i].show = false;
             }
             $scope.menu[index].show = true;
+            unwatchStatus();
             if (index == 1) {
                 $scope.isLoading = true;
-                $http.get('/available_network').then(function(response) {
+                $scope.networksInfo = [];
+                jobs.run('available_network', {}, function(name, data) {
+                    if (name == 'network') {
+                        $scope.networksInfo.push(data);
+                    }
+                }).then(function(response) {
                     $scope.isLoading = false;
                     if (response.data.error == 0) {
                         $scope.networksInfo = response.data.result;
@@ -134,20 +266,7 @@
                 });
             }
             if (index == 3) {
-                $http.get('/get_properties').then(function(response) {
-                    console.log(response);
-                    if (response.data.error == 0) {
-                        var statusJson = response.data.result;
-                        $scope.status = [];
-                        for (var i = 0; i < Object.keys(statusJson).length; i++) {
-                            $scope.status.push({
-                                name: Object.keys(statusJson)[i],
-                                value: statusJson[Object.keys(statusJson)[i]],
-                                icon: 'res/img/icon-info.png',
-                            });
-                        }
-                    }
-                });
+                watchStatus();
             }
         };
 
@@ -165,7 +284,7 @@
             });
         };
 
-        function DialogController($scope, $mdDialog, $http, $interval, sharedProperties) {
+        function DialogController($scope, $mdDialog, $http, $interval, sharedProperties, jobs) {
             var index = sharedProperties.getIndex();
             var networkInfo = sharedProperties.getNetworkInfo();
             $scope.isDisplay = false;
@@ -204,11 +323,7 @@
                     defaultRoute: $scope.thread.defaultRoute,
                     index: index,
                 };
-                var httpRequest = $http({
-                    method: 'POST',
-                    url: '/join_network',
-                    data: data,
-                });
+                var httpRequest = jobs.run('join_network', data);
 
                 data = {
                     extPanId: networkInfo.xp,
@@ -258,11 +373,7 @@
                     networkName: $scope.thread.networkName,
                 };
                 $scope.isForming = true;
-                var httpRequest = $http({
-                    method: 'POST',
-                    url: '/form_network',
-                    data: data,
-                });
+                var httpRequest = jobs.run('form_network', data);
 
                 data = {
                     extPanId: $scope.thread.extPanId,
@@ -355,11 +466,7 @@
                 pskd: $scope.commission.pskd,
                 passphrase: $scope.commission.passphrase,
             };
-            var httpRequest = $http({
-                method: 'POST',
-                url: '/commission',
-                data: data,
-            });
+            var httpRequest = jobs.run('commission', data);
             
             ev.target.disabled = true;
             
@@ -0,0 +1,371 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the long-running web operations.
+ */
+
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_WEB
+
+#include "web/web-service/job_manager.hpp"
+
+#include <condition_variable>
+#include <exception>
+
+#include <json/json.h>
+#include <json/writer.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+#ifndef OTBR_CONFIG_WEB_JOB_HISTORY_SIZE
+/**
+ * The number of finished jobs kept for clients to fetch the results.
+ *
+ */
+#define OTBR_CONFIG_WEB_JOB_HISTORY_SIZE 8
+#endif
+
+#ifndef OTBR_CONFIG_WEB_JOB_LIMIT
+/**
+ * The maximum number of jobs of a name queued or running at the same time.
+ *
+ */
+#define OTBR_CONFIG_WEB_JOB_LIMIT 2
+#endif
+
+namespace otbr {
+namespace Web {
+
+static const char kEventState[]  = "state";
+static const char kEventResult[] = "result";
+
+JobManager::JobManager(void)
+    : mNextId(0)
+{
+    mWorker.Start(1);
+}
+
+JobManager::~JobManager(void)
+{
+    mWorker.Stop();
+}
+
+uint32_t JobManager::Start(const std::string &aName, const Task &aTask, bool aShared)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::shared_ptr<Job> job;
+    Counters &           counters = mCounters[aName];
+    size_t               pending  = 0;
+    uint32_t             id       = 0;
+
+    for (const auto &it : mJobs)
+    {
+        if (it.second->mName == aName && it.second->mState != kStateDone)
+        {
+            id = it.second->mId;
+            pending++;
+        }
+    }
+
+    // The job is shared even if the limit is reached, as it costs nothing more.
+    if (aShared && pending > 0)
+    {
+        counters.mShared++;
+        otbrLog(OTBR_LOG_INFO, "Job %u %s shared", id, aName.c_str());
+        ExitNow();
+    }
+
+    if (pending >= OTBR_CONFIG_WEB_JOB_LIMIT)
+    {
+        counters.mRejected++;
+        otbrLog(OTBR_LOG_WARNING, "Job %s rejected with %zu pending", aName.c_str(), pending);
+        ExitNow(id = 0);
+    }
+
+    job.reset(new Job());
+    job->mId   = id = ++mNextId;
+    job->mName = aName;
+    job->mTask = aTask;
+    SetState(*job, kStateQueued);
+    counters.mStarted++;
+
+    mJobs[job->mId] = job;
+    RemoveFinishedJobs();
+
+    // The worker takes the lock only when it runs the job, so posting under the lock does not block.
+    mWorker.Post([this, job]() { Run(job); });
+
+    otbrLog(OTBR_LOG_INFO, "Job %u %s queued", id, aName.c_str());
+
+exit:
+    return id;
+}
+
+bool JobManager::GetStatus(uint32_t aId, std::string &aStatus) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto             it = mJobs.find(aId);
+    Json::Value      root, events;
+    Json::FastWriter jsonWriter;
+    Json::Reader     reader;
+
+    if (it == mJobs.end())
+    {
+        return false;
+    }
+
+    for (const Event &event : it->second->mEvents)
+    {
+        Json::Value entry, data;
+
+        reader.parse(event.mData, data);
+        entry["event"] = event.mName;
+        entry["data"]  = data;
+        if (event.mName == kEventResult)
+        {
+            root["result"] = data;
+        }
+        events.append(entry);
+    }
+
+    root["job"]    = it->second->mId;
+    root["name"]   = it->second->mName;
+    root["state"]  = StateToString(it->second->mState);
+    root["events"] = events;
+    aStatus        = jsonWriter.write(root);
+
+    return true;
+}
+
+bool JobManager::Subscribe(uint32_t aId, const EventHandler &aHandler)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mJobs.find(aId);
+
+    if (it == mJobs.end())
+    {
+        return false;
+    }
+
+    for (const Event &event : it->second->mEvents)
+    {
+        aHandler(event.mName, event.mData);
+    }
+
+    if (it->second->mState != kStateDone)
+    {
+        it->second->mSubscribers.push_back(aHandler);
+    }
+
+    return true;
+}
+
+bool JobManager::Wait(uint32_t aId, std::string &aResult)
+{
+    std::mutex              mutex;
+    std::condition_variable condition;
+    bool                    done = false;
+    bool                    found;
+
+    // The handler is released by the job manager once the result is published, so the locals outlive its calls.
+    found = Subscribe(aId, [&mutex, &condition, &done, &aResult](const std::string &aEvent, const std::string &aData) {
+        if (aEvent == kEventResult)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            aResult = aData;
+            done    = true;
+            condition.notify_one();
+        }
+    });
+
+    if (found)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        condition.wait(lock, [&done]() { return done; });
+    }
+
+    return found;
+}
+
+void JobManager::GetMetrics(std::string &aMetrics) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Json::Value      root, names(Json::objectValue);
+    Json::FastWriter jsonWriter;
+    unsigned         queued  = 0;
+    unsigned         running = 0;
+
+    for (const auto &it : mCounters)
+    {
+        Json::Value &name = names[it.first];
+
+        name["queued"]   = 0;
+        name["running"]  = 0;
+        name["started"]  = it.second.mStarted;
+        name["shared"]   = it.second.mShared;
+        name["rejected"] = it.second.mRejected;
+    }
+
+    for (const auto &it : mJobs)
+    {
+        const Job &job = *it.second;
+
+        if (job.mState == kStateQueued)
+        {
+            names[job.mName]["queued"] = names[job.mName]["queued"].asUInt() + 1;
+            queued++;
+        }
+        else if (job.mState == kStateRunning)
+        {
+            names[job.mName]["running"] = names[job.mName]["running"].asUInt() + 1;
+            running++;
+        }
+    }
+
+    root["queued"]  = queued;
+    root["running"] = running;
+    root["limit"]   = OTBR_CONFIG_WEB_JOB_LIMIT;
+    root["jobs"]    = names;
+    aMetrics        = jsonWriter.write(root);
+}
+
+const char *JobManager::StateToString(State aState)
+{
+    const char *state = "unknown";
+
+    switch (aState)
+    {
+    case kStateQueued:
+        state = "queued";
+        break;
+    case kStateRunning:
+        state = "running";
+        break;
+    case kStateDone:
+        state = "done";
+        break;
+    }
+
+    return state;
+}
+
+void JobManager::Run(const std::shared_ptr<Job> &aJob)
+{
+    std::string  result;
+    EventHandler publish = [this, aJob](const std::string &aEvent, const std::string &aData) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        Publish(*aJob, aEvent, aData);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        SetState(*aJob, kStateRunning);
+    }
+
+    // Jobs are run without the lock, so that clients can poll and subscribe in the meantime.
+    try
+    {
+        result = aJob->mTask(publish);
+    } catch (std::exception &e)
+    {
+        Json::Value      root;
+        Json::FastWriter jsonWriter;
+
+        otbrLog(OTBR_LOG_ERR, "Job %u %s failed: %s", aJob->mId, aJob->mName.c_str(), e.what());
+        root["result"] = "failed";
+        result         = jsonWriter.write(root);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        aJob->mTask = nullptr;
+        SetState(*aJob, kStateDone);
+        Publish(*aJob, kEventResult, result);
+        aJob->mSubscribers.clear();
+        RemoveFinishedJobs();
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Job %u %s done", aJob->mId, aJob->mName.c_str());
+}
+
+void JobManager::Publish(Job &aJob, const std::string &aEvent, const std::string &aData)
+{
+    aJob.mEvents.push_back({aEvent, aData});
+
+    for (const EventHandler &handler : aJob.mSubscribers)
+    {
+        handler(aEvent, aData);
+    }
+}
+
+void JobManager::SetState(Job &aJob, State aState)
+{
+    Json::Value      root;
+    Json::FastWriter jsonWriter;
+
+    aJob.mState   = aState;
+    root["state"] = StateToString(aState);
+    Publish(aJob, kEventState, jsonWriter.write(root));
+}
+
+void JobManager::RemoveFinishedJobs(void)
+{
+    size_t finished = 0;
+
+    for (const auto &job : mJobs)
+    {
+        finished += (job.second->mState == kStateDone);
+    }
+
+    // Jobs are ordered by id, so the oldest finished jobs are removed first.
+    for (auto it = mJobs.begin(); it != mJobs.end() && finished > OTBR_CONFIG_WEB_JOB_HISTORY_SIZE;)
+    {
+        if (it->second->mState == kStateDone)
+        {
+            it = mJobs.erase(it);
+            --finished;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace Web
+} // namespace otbr
@@ -0,0 +1,200 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions of the long-running web operations.
+ */
+
+#ifndef OTBR_WEB_WEB_SERVICE_JOB_MANAGER_
+#define OTBR_WEB_WEB_SERVICE_JOB_MANAGER_
+
+#include "openthread-br/config.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "common/worker_pool.hpp"
+
+namespace otbr {
+namespace Web {
+
+/**
+ * This class runs long-running operations, such as scan, form and join, as jobs in the background.
+ *
+ * Jobs are run one after another by a single worker. Each job publishes a sequence of events, which ends
+ * with a `result` event carrying the JSON response of the operation.
+ *
+ * As each job ties up the radio for seconds, the jobs of a name not yet done are limited, and a job may be
+ * shared by the requests coming while it is not done.
+ *
+ */
+class JobManager
+{
+public:
+    /**
+     * This function is called for each event of a job.
+     *
+     * @param[in]  aEvent  The event name.
+     * @param[in]  aData   The JSON data of the event.
+     *
+     */
+    typedef std::function<void(const std::string &aEvent, const std::string &aData)> EventHandler;
+
+    /**
+     * This function performs the operation of a job.
+     *
+     * @param[in]  aPublish  The handler to publish progress events of the job.
+     *
+     * @returns The JSON response of the operation.
+     *
+     */
+    typedef std::function<std::string(const EventHandler &aPublish)> Task;
+
+    /**
+     * This method is constructor to initialize the JobManager and start the worker thread.
+     *
+     */
+    JobManager(void);
+
+    /**
+     * This method is destructor to stop the worker thread after the running job finishes, dropping the queued jobs.
+     *
+     */
+    ~JobManager(void);
+
+    /**
+     * This method queues a job.
+     *
+     * @param[in]  aName    The name of the job.
+     * @param[in]  aTask    The operation of the job.
+     * @param[in]  aShared  Whether to share a job of the same name not yet done instead, if any.
+     *
+     * @returns The id of the job, or 0 if the jobs of the name not yet done reach the limit.
+     *
+     */
+    uint32_t Start(const std::string &aName, const Task &aTask, bool aShared = false);
+
+    /**
+     * This method waits for a job to be done.
+     *
+     * @param[in]   aId      The id of the job.
+     * @param[out]  aResult  The JSON response of the operation.
+     *
+     * @returns Whether the job is found.
+     *
+     */
+    bool Wait(uint32_t aId, std::string &aResult);
+
+    /**
+     * This method gets the metrics of the jobs in JSON, including the depth of the queue.
+     *
+     * @param[out]  aMetrics  The JSON metrics, with the counters of each name.
+     *
+     */
+    void GetMetrics(std::string &aMetrics) const;
+
+    /**
+     * This method gets the status of a job in JSON, for polling clients.
+     *
+     * @param[in]   aId      The id of the job.
+     * @param[out]  aStatus  The JSON status, including the events published so far.
+     *
+     * @returns Whether the job is found.
+     *
+     */
+    bool GetStatus(uint32_t aId, std::string &aStatus) const;
+
+    /**
+     * This method subscribes to the events of a job.
+     *
+     * The events published before are replayed first. The handler is released after the `result` event,
+     * and may be called from the worker thread.
+     *
+     * @param[in]  aId       The id of the job.
+     * @param[in]  aHandler  The event handler.
+     *
+     * @returns Whether the job is found.
+     *
+     */
+    bool Subscribe(uint32_t aId, const EventHandler &aHandler);
+
+private:
+    enum State
+    {
+        kStateQueued,
+        kStateRunning,
+        kStateDone,
+    };
+
+    struct Event
+    {
+        std::string mName;
+        std::string mData;
+    };
+
+    struct Job
+    {
+        uint32_t                  mId;
+        std::string               mName;
+        Task                      mTask;
+        State                     mState;
+        std::vector<Event>        mEvents;
+        std::vector<EventHandler> mSubscribers;
+    };
+
+    struct Counters
+    {
+        uint32_t mStarted;  ///< The number of jobs queued.
+        uint32_t mShared;   ///< The number of requests sharing a job not yet done.
+        uint32_t mRejected; ///< The number of requests rejected for the limit.
+    };
+
+    static const char *StateToString(State aState);
+
+    void Run(const std::shared_ptr<Job> &aJob);
+    void Publish(Job &aJob, const std::string &aEvent, const std::string &aData);
+    void SetState(Job &aJob, State aState);
+    void RemoveFinishedJobs(void);
+
+    mutable std::mutex                       mMutex;
+    std::map<uint32_t, std::shared_ptr<Job>> mJobs;
+    std::map<std::string, Counters>          mCounters;
+    uint32_t                                 mNextId;
+    WorkerPool                               mWorker;
+};
+
+} // namespace Web
+} // namespace otbr
+
+#endif // OTBR_WEB_WEB_SERVICE_JOB_MANAGER_
@@ -0,0 +1,556 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the JSON writer and reader of the web service.
+ */
+
+#include "web/web-service/json.hpp"
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+namespace Web {
+
+// The CBOR major types and simple values written.
+static const uint8_t kCborUnsigned    = 0;
+static const uint8_t kCborNegative    = 1;
+static const uint8_t kCborText        = 3;
+static const uint8_t kCborArrayBegin  = 0x9f;
+static const uint8_t kCborObjectBegin = 0xbf;
+static const uint8_t kCborFalse       = 0xf4;
+static const uint8_t kCborTrue        = 0xf5;
+static const uint8_t kCborBreak       = 0xff;
+
+JsonWriter::JsonWriter(std::string &aBuffer, Encoding aEncoding)
+    : mBuffer(aBuffer)
+    , mEncoding(aEncoding)
+{
+    mBuffer.clear();
+}
+
+const char *JsonWriter::GetContentType(Encoding aEncoding)
+{
+    return aEncoding == kEncodingCbor ? "application/cbor" : "application/json";
+}
+
+void JsonWriter::BeginValue(void)
+{
+    // A value follows a key, begins a container, or follows a previous value. CBOR items need no separators.
+    if (mEncoding == kEncodingJson && !mBuffer.empty() && mBuffer.back() != ':' && mBuffer.back() != '{' &&
+        mBuffer.back() != '[')
+    {
+        mBuffer.push_back(',');
+    }
+}
+
+JsonWriter &JsonWriter::BeginObject(void)
+{
+    BeginValue();
+    mBuffer.push_back(static_cast<char>(mEncoding == kEncodingCbor ? kCborObjectBegin : '{'));
+    return *this;
+}
+
+JsonWriter &JsonWriter::EndObject(void)
+{
+    mBuffer.push_back(static_cast<char>(mEncoding == kEncodingCbor ? kCborBreak : '}'));
+    return *this;
+}
+
+JsonWriter &JsonWriter::BeginArray(void)
+{
+    BeginValue();
+    mBuffer.push_back(static_cast<char>(mEncoding == kEncodingCbor ? kCborArrayBegin : '['));
+    return *this;
+}
+
+JsonWriter &JsonWriter::EndArray(void)
+{
+    mBuffer.push_back(static_cast<char>(mEncoding == kEncodingCbor ? kCborBreak : ']'));
+    return *this;
+}
+
+JsonWriter &JsonWriter::Key(const char *aKey)
+{
+    BeginValue();
+    WriteString(aKey, strlen(aKey));
+    if (mEncoding == kEncodingJson)
+    {
+        mBuffer.push_back(':');
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::Value(const char *aValue)
+{
+    BeginValue();
+    WriteString(aValue, strlen(aValue));
+    return *this;
+}
+
+JsonWriter &JsonWriter::Value(const std::string &aValue)
+{
+    BeginValue();
+    WriteString(aValue.data(), aValue.size());
+    return *this;
+}
+
+JsonWriter &JsonWriter::Value(int aValue)
+{
+    char number[sizeof("-2147483648")];
+
+    BeginValue();
+    if (mEncoding == kEncodingCbor)
+    {
+        // A negative integer -1 - n is encoded as n, which is computed without overflowing INT_MIN.
+        WriteCborHead(aValue < 0 ? kCborNegative : kCborUnsigned,
+                      aValue < 0 ? static_cast<uint64_t>(-(aValue + 1)) : static_cast<uint64_t>(aValue));
+    }
+    else
+    {
+        mBuffer.append(number, static_cast<size_t>(snprintf(number, sizeof(number), "%d", aValue)));
+    }
+    return *this;
+}
+
+JsonWriter &JsonWriter::Value(bool aValue)
+{
+    BeginValue();
+    if (mEncoding == kEncodingCbor)
+    {
+        mBuffer.push_back(static_cast<char>(aValue ? kCborTrue : kCborFalse));
+    }
+    else
+    {
+        mBuffer.append(aValue ? "true" : "false");
+    }
+    return *this;
+}
+
+void JsonWriter::WriteCborHead(uint8_t aMajorType, uint64_t aArgument)
+{
+    uint8_t type = static_cast<uint8_t>(aMajorType << 5);
+    int     size;
+
+    // The argument is in the initial byte if it fits, or follows it in the fewest bytes, in network byte order.
+    if (aArgument < 24)
+    {
+        mBuffer.push_back(static_cast<char>(type | aArgument));
+        ExitNow();
+    }
+    else if (aArgument <= UINT8_MAX)
+    {
+        mBuffer.push_back(static_cast<char>(type | 24));
+        size = 1;
+    }
+    else if (aArgument <= UINT16_MAX)
+    {
+        mBuffer.push_back(static_cast<char>(type | 25));
+        size = 2;
+    }
+    else if (aArgument <= UINT32_MAX)
+    {
+        mBuffer.push_back(static_cast<char>(type | 26));
+        size = 4;
+    }
+    else
+    {
+        mBuffer.push_back(static_cast<char>(type | 27));
+        size = 8;
+    }
+
+    for (int shift = (size - 1) * 8; shift >= 0; shift -= 8)
+    {
+        mBuffer.push_back(static_cast<char>((aArgument >> shift) & 0xff));
+    }
+
+exit:
+    return;
+}
+
+void JsonWriter::WriteString(const char *aString, size_t aLength)
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+
+    // A CBOR text string is its length and then its bytes, so nothing is escaped.
+    if (mEncoding == kEncodingCbor)
+    {
+        WriteCborHead(kCborText, aLength);
+        mBuffer.append(aString, aLength);
+        ExitNow();
+    }
+
+    mBuffer.push_back('"');
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        unsigned char c = static_cast<unsigned char>(aString[i]);
+
+        switch (c)
+        {
+        case '"':
+            mBuffer.append("\\\"");
+            break;
+        case '\\':
+            mBuffer.append("\\\\");
+            break;
+        case '\n':
+            mBuffer.append("\\n");
+            break;
+        case '\r':
+            mBuffer.append("\\r");
+            break;
+        case '\t':
+            mBuffer.append("\\t");
+            break;
+        default:
+            if (c < 0x20)
+            {
+                mBuffer.append("\\u00");
+                mBuffer.push_back(kHexDigits[c >> 4]);
+                mBuffer.push_back(kHexDigits[c & 0xf]);
+            }
+            else
+            {
+                mBuffer.push_back(static_cast<char>(c));
+            }
+            break;
+        }
+    }
+
+    mBuffer.push_back('"');
+
+exit:
+    return;
+}
+
+JsonReader::JsonReader(void)
+    : mBindingsCount(0)
+    , mCursor(NULL)
+    , mEnd(NULL)
+{
+}
+
+JsonReader &JsonReader::Bind(const char *aKey, std::string &aValue)
+{
+    aValue.clear();
+    return Bind(aKey, kTypeString, &aValue);
+}
+
+JsonReader &JsonReader::Bind(const char *aKey, bool &aValue)
+{
+    aValue = false;
+    return Bind(aKey, kTypeBool, &aValue);
+}
+
+JsonReader &JsonReader::Bind(const char *aKey, int &aValue)
+{
+    aValue = 0;
+    return Bind(aKey, kTypeInt, &aValue);
+}
+
+JsonReader &JsonReader::Bind(const char *aKey, Type aType, void *aValue)
+{
+    assert(mBindingsCount < kMaxBindings);
+
+    mBindings[mBindingsCount].mKey   = aKey;
+    mBindings[mBindingsCount].mType  = aType;
+    mBindings[mBindingsCount].mValue = aValue;
+    mBindingsCount++;
+
+    return *this;
+}
+
+const JsonReader::Binding *JsonReader::FindBinding(const std::string &aKey) const
+{
+    const Binding *binding = NULL;
+
+    for (uint8_t i = 0; i < mBindingsCount; i++)
+    {
+        if (aKey == mBindings[i].mKey)
+        {
+            binding = &mBindings[i];
+            break;
+        }
+    }
+
+    return binding;
+}
+
+bool JsonReader::Parse(const std::string &aJson)
+{
+    bool ret = false;
+
+    mCursor = aJson.data();
+    mEnd    = aJson.data() + aJson.size();
+
+    VerifyOrExit(Consume('{'));
+    if (!Consume('}'))
+    {
+        do
+        {
+            VerifyOrExit(ParseMember());
+        } while (Consume(','));
+        VerifyOrExit(Consume('}'));
+    }
+
+    SkipSpaces();
+    ret = (mCursor == mEnd);
+
+exit:
+    return ret;
+}
+
+void JsonReader::SkipSpaces(void)
+{
+    while (mCursor != mEnd && (*mCursor == ' ' || *mCursor == '\t' || *mCursor == '\n' || *mCursor == '\r'))
+    {
+        mCursor++;
+    }
+}
+
+bool JsonReader::Consume(char aChar)
+{
+    bool consumed = false;
+
+    SkipSpaces();
+    if (mCursor != mEnd && *mCursor == aChar)
+    {
+        mCursor++;
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+bool JsonReader::ParseMember(void)
+{
+    bool ret = false;
+
+    SkipSpaces();
+    VerifyOrExit(ParseString(&mKey));
+    VerifyOrExit(Consume(':'));
+    ret = ParseValue(FindBinding(mKey), 0);
+
+exit:
+    return ret;
+}
+
+bool JsonReader::ParseString(std::string *aString)
+{
+    bool ret = false;
+
+    VerifyOrExit(mCursor != mEnd && *mCursor == '"');
+    mCursor++;
+
+    if (aString != NULL)
+    {
+        aString->clear();
+    }
+
+    while (mCursor != mEnd && *mCursor != '"')
+    {
+        char c = *mCursor++;
+
+        VerifyOrExit(static_cast<unsigned char>(c) >= 0x20);
+
+        if (c == '\\')
+        {
+            VerifyOrExit(mCursor != mEnd);
+            c = *mCursor++;
+
+            switch (c)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                break;
+            case 'b':
+                c = '\b';
+                break;
+            case 'f':
+                c = '\f';
+                break;
+            case 'n':
+                c = '\n';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'u':
+            {
+                // Only the code points of the Basic Multilingual Plane are decoded, each half of a surrogate pair is
+                // encoded on its own.
+                char     hex[5] = {0};
+                char *   hexEnd;
+                uint32_t codePoint;
+
+                VerifyOrExit(mEnd - mCursor >= 4);
+                memcpy(hex, mCursor, 4);
+                codePoint = static_cast<uint32_t>(strtoul(hex, &hexEnd, 16));
+                VerifyOrExit(hexEnd == hex + 4);
+                mCursor += 4;
+
+                if (aString != NULL)
+                {
+                    if (codePoint < 0x80)
+                    {
+                        aString->push_back(static_cast<char>(codePoint));
+                    }
+                    else if (codePoint < 0x800)
+                    {
+                        aString->push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+                        aString->push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+                    }
+                    else
+                    {
+                        aString->push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+                        aString->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+                        aString->push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+                    }
+                }
+                continue;
+            }
+            default:
+                ExitNow();
+            }
+        }
+
+        if (aString != NULL)
+        {
+            aString->push_back(c);
+        }
+    }
+
+    VerifyOrExit(mCursor != mEnd);
+    mCursor++;
+    ret = true;
+
+exit:
+    return ret;
+}
+
+bool JsonReader::ParseValue(const Binding *aBinding, uint8_t aDepth)
+{
+    bool ret  = false;
+    Type type = (aBinding != NULL ? aBinding->mType : kTypeString);
+
+    VerifyOrExit(aDepth < kMaxDepth);
+    SkipSpaces();
+    VerifyOrExit(mCursor != mEnd);
+
+    if (*mCursor == '"')
+    {
+        VerifyOrExit(aBinding == NULL || type == kTypeString);
+        ret = ParseString(aBinding != NULL ? static_cast<std::string *>(aBinding->mValue) : NULL);
+    }
+    else if (*mCursor == '{' || *mCursor == '[')
+    {
+        char close = (*mCursor == '{' ? '}' : ']');
+
+        VerifyOrExit(aBinding == NULL);
+        mCursor++;
+
+        if (!Consume(close))
+        {
+            do
+            {
+                if (close == '}')
+                {
+                    SkipSpaces();
+                    VerifyOrExit(ParseString(NULL));
+                    VerifyOrExit(Consume(':'));
+                }
+                VerifyOrExit(ParseValue(NULL, aDepth + 1));
+            } while (Consume(','));
+            VerifyOrExit(Consume(close));
+        }
+        ret = true;
+    }
+    else if (static_cast<size_t>(mEnd - mCursor) >= sizeof("true") - 1 && !strncmp(mCursor, "true", 4))
+    {
+        VerifyOrExit(aBinding == NULL || type == kTypeBool);
+        mCursor += sizeof("true") - 1;
+        if (aBinding != NULL)
+        {
+            *static_cast<bool *>(aBinding->mValue) = true;
+        }
+        ret = true;
+    }
+    else if (static_cast<size_t>(mEnd - mCursor) >= sizeof("false") - 1 && !strncmp(mCursor, "false", 5))
+    {
+        VerifyOrExit(aBinding == NULL || type == kTypeBool);
+        mCursor += sizeof("false") - 1;
+        ret = true;
+    }
+    else if (static_cast<size_t>(mEnd - mCursor) >= sizeof("null") - 1 && !strncmp(mCursor, "null", 4))
+    {
+        // A null member keeps the default value, as a missing one does.
+        mCursor += sizeof("null") - 1;
+        ret = true;
+    }
+    else
+    {
+        // The text is terminated by the string storage, so the number can be converted in place.
+        char *numberEnd;
+        long  number;
+
+        VerifyOrExit(*mCursor == '-' || (*mCursor >= '0' && *mCursor <= '9'));
+        errno = 0;
+        if (aBinding == NULL)
+        {
+            strtod(mCursor, &numberEnd);
+        }
+        else
+        {
+            VerifyOrExit(type == kTypeInt);
+            number = strtol(mCursor, &numberEnd, 10);
+            VerifyOrExit(errno == 0 && number >= INT_MIN && number <= INT_MAX);
+            *static_cast<int *>(aBinding->mValue) = static_cast<int>(number);
+        }
+        VerifyOrExit(numberEnd > mCursor && numberEnd <= mEnd);
+        mCursor = numberEnd;
+        ret     = true;
+    }
+
+exit:
+    return ret;
+}
+
+} // namespace Web
+} // namespace otbr
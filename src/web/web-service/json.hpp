@@ -0,0 +1,291 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions of the JSON writer and reader of the web service.
+ */
+
+#ifndef OTBR_WEB_WEB_SERVICE_JSON_
+#define OTBR_WEB_WEB_SERVICE_JSON_
+
+#include "openthread-br/config.h"
+
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace otbr {
+namespace Web {
+
+/**
+ * This class writes compact JSON text, or the same values in CBOR, directly into a string, without building a
+ * document first.
+ *
+ * Commas and colons are inserted as needed, so a value is written by a `Key()`/`Value()` pair inside an object and
+ * by a `Value()` alone inside an array.
+ *
+ */
+class JsonWriter
+{
+public:
+    /**
+     * This enumeration represents the encodings a writer writes.
+     *
+     */
+    enum Encoding
+    {
+        kEncodingJson, ///< JSON text.
+        kEncodingCbor, ///< CBOR (RFC 8949), with indefinite-length objects and arrays, so none is counted first.
+    };
+
+    /**
+     * This constructor initializes the writer.
+     *
+     * @param[in]  aBuffer    The string to write into. It is cleared, and its storage is reused.
+     * @param[in]  aEncoding  The encoding to write.
+     *
+     */
+    explicit JsonWriter(std::string &aBuffer, Encoding aEncoding = kEncodingJson);
+
+    /**
+     * This method returns the media type of an encoding.
+     *
+     * @param[in]  aEncoding  The encoding.
+     *
+     * @returns The media type, for the Content-Type header.
+     *
+     */
+    static const char *GetContentType(Encoding aEncoding);
+
+    /**
+     * This method begins an object.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &BeginObject(void);
+
+    /**
+     * This method ends the current object.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &EndObject(void);
+
+    /**
+     * This method begins an array.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &BeginArray(void);
+
+    /**
+     * This method ends the current array.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &EndArray(void);
+
+    /**
+     * This method writes the key of an object member.
+     *
+     * @param[in]  aKey  The key.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &Key(const char *aKey);
+
+    /**
+     * This method writes a string value.
+     *
+     * @param[in]  aValue  The string, which is escaped as needed.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &Value(const char *aValue);
+
+    /**
+     * This method writes a string value.
+     *
+     * @param[in]  aValue  The string, which is escaped as needed.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &Value(const std::string &aValue);
+
+    /**
+     * This method writes a number value.
+     *
+     * @param[in]  aValue  The number.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &Value(int aValue);
+
+    /**
+     * This method writes a boolean value.
+     *
+     * @param[in]  aValue  The boolean.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    JsonWriter &Value(bool aValue);
+
+    /**
+     * This method writes an object member.
+     *
+     * @param[in]  aKey    The key.
+     * @param[in]  aValue  The value.
+     *
+     * @returns A reference to the writer.
+     *
+     */
+    template <typename ValueType> JsonWriter &Member(const char *aKey, const ValueType &aValue)
+    {
+        return Key(aKey).Value(aValue);
+    }
+
+private:
+    void BeginValue(void);
+    void WriteString(const char *aString, size_t aLength);
+    void WriteCborHead(uint8_t aMajorType, uint64_t aArgument);
+
+    std::string &mBuffer;
+    Encoding     mEncoding;
+};
+
+/**
+ * This class reads the members of a flat JSON object into variables as the text is scanned.
+ *
+ * Each variable is bound to a key and reset to its default before parsing. Members with other keys, including
+ * nested objects and arrays, are skipped.
+ *
+ */
+class JsonReader
+{
+public:
+    /**
+     * This constructor initializes a reader without any bound members.
+     *
+     */
+    JsonReader(void);
+
+    /**
+     * This method binds a string member.
+     *
+     * @param[in]  aKey    The key, which must outlive the reader.
+     * @param[out] aValue  The variable to store the value, reset to empty.
+     *
+     * @returns A reference to the reader.
+     *
+     */
+    JsonReader &Bind(const char *aKey, std::string &aValue);
+
+    /**
+     * This method binds a boolean member.
+     *
+     * @param[in]  aKey    The key, which must outlive the reader.
+     * @param[out] aValue  The variable to store the value, reset to false.
+     *
+     * @returns A reference to the reader.
+     *
+     */
+    JsonReader &Bind(const char *aKey, bool &aValue);
+
+    /**
+     * This method binds an integer member.
+     *
+     * @param[in]  aKey    The key, which must outlive the reader.
+     * @param[out] aValue  The variable to store the value, reset to 0.
+     *
+     * @returns A reference to the reader.
+     *
+     */
+    JsonReader &Bind(const char *aKey, int &aValue);
+
+    /**
+     * This method parses a JSON object.
+     *
+     * @param[in]  aJson  The JSON text.
+     *
+     * @retval true   Successfully parsed the object.
+     * @retval false  The text is not a well-formed object, or a bound member is of another type.
+     *
+     */
+    bool Parse(const std::string &aJson);
+
+private:
+    enum Type
+    {
+        kTypeString,
+        kTypeBool,
+        kTypeInt,
+    };
+
+    struct Binding
+    {
+        const char *mKey;
+        Type        mType;
+        void *      mValue;
+    };
+
+    enum
+    {
+        kMaxBindings = 16, ///< The maximum number of bound members.
+        kMaxDepth    = 32, ///< The maximum nesting depth of the skipped values.
+    };
+
+    JsonReader &Bind(const char *aKey, Type aType, void *aValue);
+
+    void           SkipSpaces(void);
+    bool           Consume(char aChar);
+    bool           ParseString(std::string *aString);
+    bool           ParseMember(void);
+    bool           ParseValue(const Binding *aBinding, uint8_t aDepth);
+    const Binding *FindBinding(const std::string &aKey) const;
+
+    Binding      mBindings[kMaxBindings];
+    uint8_t      mBindingsCount;
+    const char * mCursor;
+    const char * mEnd;
+    std::string  mKey;
+};
+
+} // namespace Web
+} // namespace otbr
+
+#endif // OTBR_WEB_WEB_SERVICE_JSON_
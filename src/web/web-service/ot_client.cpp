@@ -26,13 +26,12 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "web/web-service/ot_client.hpp"
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_WEB
 
-#include <openthread/platform/toolchain.h>
+#include "web/web-service/ot_client.hpp"
 
 #include <errno.h>
-#include <inttypes.h>
-#include <signal.h>
+#include <poll.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -43,6 +42,8 @@
 
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
+#include "common/tracepoint.hpp"
 #include "utils/strcpy_utils.hpp"
 
 // Temporary solution before posix platform header files are cleaned up.
@@ -50,9 +51,17 @@
 #define OPENTHREAD_POSIX_APP_SOCKET_NAME "/tmp/openthread.sock"
 #endif
 
+#ifndef MSG_NOSIGNAL
+// SO_NOSIGPIPE is set on the socket instead.
+#define MSG_NOSIGNAL 0
+#endif
+
 namespace otbr {
 namespace Web {
 
+static const char kCliPrompt[] = "> ";
+static const char kCliError[]  = "Error ";
+
 OpenThreadClient::OpenThreadClient(void)
     : mTimeout(kDefaultTimeout)
     , mSocket(-1)
@@ -78,9 +87,19 @@ bool OpenThreadClient::Connect(void)
     struct sockaddr_un sockname;
     int                ret;
 
+    Disconnect();
+
     mSocket = socket(AF_UNIX, SOCK_STREAM, 0);
     VerifyOrExit(mSocket != -1, perror("socket"); ret = EXIT_FAILURE);
 
+#ifdef SO_NOSIGPIPE
+    {
+        int noSigPipe = 1;
+
+        setsockopt(mSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+    }
+#endif
+
     memset(&sockname, 0, sizeof(struct sockaddr_un));
     sockname.sun_family = AF_UNIX;
     strcpy_safe(sockname.sun_path, sizeof(sockname.sun_path), OPENTHREAD_POSIX_APP_SOCKET_NAME);
@@ -96,162 +115,224 @@ exit:
     return ret == 0;
 }
 
-char *OpenThreadClient::Execute(const char *aFormat, ...)
+bool OpenThreadClient::IsConnected(void)
 {
-    va_list args;
-    int     ret;
-    char *  rval = NULL;
-    ssize_t count;
-    size_t  rxLength = 0;
+    bool rval = false;
 
-    va_start(args, aFormat);
-    ret = vsnprintf(&mBuffer[1], sizeof(mBuffer) - 1, aFormat, args);
-    va_end(args);
+    VerifyOrExit(mSocket != -1);
 
-    if (ret < 0)
+    // Discard what an idle session has to read, such as a prompt following the previous output.
+    for (;;)
     {
-        otbrLog(OTBR_LOG_ERR, "Failed to generate command: %s", strerror(errno));
-    }
+        struct pollfd pollFd = {mSocket, POLLIN, 0};
+        int           ret    = poll(&pollFd, 1, 0);
+        ssize_t       count;
 
-    mBuffer[0] = '\n';
-    ret++;
+        VerifyOrExit(ret != -1 || errno == EINTR, Disconnect());
+        if (ret == 0)
+        {
+            break;
+        }
+        if (ret == -1)
+        {
+            continue;
+        }
 
-    if (ret == sizeof(mBuffer))
-    {
-        otbrLog(OTBR_LOG_ERR, "Command exceeds maximum limit: %d", kBufferSize);
+        count = recv(mSocket, mBuffer, sizeof(mBuffer), MSG_DONTWAIT);
+        VerifyOrExit(count > 0 || (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)),
+                     Disconnect());
     }
 
-    mBuffer[ret] = '\n';
-    ret++;
+    rval = true;
 
-    count = write(mSocket, mBuffer, ret);
+exit:
+    return rval;
+}
 
-    if (count < ret)
-    {
-        mBuffer[ret] = '\0';
-        otbrLog(OTBR_LOG_ERR, "Failed to send command: %s", mBuffer);
-    }
+char *OpenThreadClient::Execute(const char *aFormat, ...)
+{
+    va_list args;
+    char *  output;
+
+    va_start(args, aFormat);
+    ExecuteV(output, aFormat, args);
+    va_end(args);
+
+    return output;
+}
+
+otbrError OpenThreadClient::ExecuteCommand(char *&aOutput, const char *aFormat, ...)
+{
+    va_list   args;
+    otbrError error;
+
+    va_start(args, aFormat);
+    error = ExecuteV(aOutput, aFormat, args);
+    va_end(args);
+
+    return error;
+}
 
-    for (int i = 0; i < mTimeout; ++i)
+otbrError OpenThreadClient::ExecuteV(char *&aOutput, const char *aFormat, va_list aArgs)
+{
+    otbrError     error     = OTBR_ERROR_NONE;
+    size_t        rxLength  = 0;
+    size_t        lineStart = 0;
+    unsigned long deadline;
+    int           length;
+    ssize_t       count;
+
+    aOutput = NULL;
+
+    OTBR_TRACEPOINT1(cli__execute__begin, aFormat);
+    length = vsnprintf(&mBuffer[1], sizeof(mBuffer) - 1, aFormat, aArgs);
+    VerifyOrExit(length >= 0, error = OTBR_ERROR_ERRNO);
+    // The command is sent between two newlines, so that a partial line left by a previous session is ignored.
+    VerifyOrExit(static_cast<size_t>(length) + 2 <= sizeof(mBuffer), errno = EMSGSIZE; error = OTBR_ERROR_ERRNO);
+    mBuffer[0]          = '\n';
+    mBuffer[length + 1] = '\n';
+    length += 2;
+
+    // A pooled connection may have been closed by the daemon, which must not raise SIGPIPE.
+    count = send(mSocket, mBuffer, length, MSG_NOSIGNAL);
+    VerifyOrExit(count == length, error = OTBR_ERROR_ERRNO);
+
+    deadline = GetNow() + mTimeout;
+
+    while (aOutput == NULL)
     {
-        fd_set  readFdSet;
-        timeval timeout = {0, 1000};
-        char *  done;
+        struct pollfd pollFd = {mSocket, POLLIN, 0};
+        unsigned long now    = GetNow();
+        int           ret;
 
-        FD_ZERO(&readFdSet);
-        FD_SET(mSocket, &readFdSet);
+        VerifyOrExit(now < deadline, errno = ETIMEDOUT; error = OTBR_ERROR_ERRNO);
 
-        ret = select(mSocket + 1, &readFdSet, NULL, NULL, &timeout);
-        VerifyOrExit(ret != -1 || errno == EINTR);
+        ret = poll(&pollFd, 1, static_cast<int>(deadline - now));
+        VerifyOrExit(ret != -1 || errno == EINTR, error = OTBR_ERROR_ERRNO);
         if (ret <= 0)
         {
             continue;
         }
 
-        count = read(mSocket, &mBuffer[rxLength], sizeof(mBuffer) - rxLength);
-        VerifyOrExit(count > 0);
-        rxLength += count;
+        // One byte is kept for the terminating null character.
+        VerifyOrExit(rxLength + 1 < sizeof(mBuffer), errno = ENOBUFS; error = OTBR_ERROR_ERRNO);
+        count = read(mSocket, &mBuffer[rxLength], sizeof(mBuffer) - 1 - rxLength);
+        VerifyOrExit(count != 0, errno = ECONNRESET; error = OTBR_ERROR_ERRNO);
+        VerifyOrExit(count > 0, error = OTBR_ERROR_ERRNO);
 
-        mBuffer[rxLength] = '\0';
-        done              = strstr(mBuffer, "Done\r\n");
+        rxLength += count;
+        SuccessOrExit(error = ParseOutput(mBuffer, rxLength, static_cast<size_t>(count), lineStart, aOutput));
+    }
 
-        if (done != NULL)
-        {
-            // remove trailing \r\n
-            if (done - rval > 2)
-            {
-                done[-2] = '\0';
-            }
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLogResult("Execute OpenThread CLI command", error);
 
-            rval = mBuffer;
-            break;
-        }
+        // The rest of the output may still come, so the connection can't be used for another command.
+        Disconnect();
     }
 
-exit:
-    return rval;
+    OTBR_TRACEPOINT1(cli__execute__end, static_cast<int>(error));
+    return error;
 }
 
-int OpenThreadClient::Scan(WpanNetworkInfo *aNetworks, int aLength)
+otbrError OpenThreadClient::ParseOutput(char *  aBuffer,
+                                        size_t  aLength,
+                                        size_t  aCount,
+                                        size_t &aLineStart,
+                                        char *& aOutput)
 {
-    char *result;
-    int   rval = 0;
+    otbrError error = OTBR_ERROR_NONE;
+    char *    end   = &aBuffer[aLength];
 
-    mTimeout = 5000;
-    result   = Execute("scan");
-    VerifyOrExit(result != NULL);
+    aOutput = NULL;
 
-    for (result = strtok(result, "\r\n"); result != NULL && rval < aLength; result = strtok(NULL, "\r\n"))
+    // Only the lines completed by the new bytes are looked at.
+    for (char *newline = static_cast<char *>(memchr(end - aCount, '\n', aCount)); newline != NULL;
+         newline       = static_cast<char *>(memchr(newline + 1, '\n', end - newline - 1)))
     {
-        static const char kCliPrompt[] = "> ";
-        char *            cliPrompt;
-        int               matched;
-        int               joinable;
-        int               lqi;
-
-        // remove prompt
-        if ((cliPrompt = strstr(result, kCliPrompt)) != NULL)
+        char *lineBegin = &aBuffer[aLineStart];
+        char *line      = lineBegin;
+        char *lineEnd   = (newline > lineBegin && newline[-1] == '\r') ? newline - 1 : newline;
+        char  lineEndChar;
+
+        aLineStart  = newline - aBuffer + 1;
+        lineEndChar = *lineEnd;
+        *lineEnd    = '\0';
+
+        while (strncmp(line, kCliPrompt, sizeof(kCliPrompt) - 1) == 0)
         {
-            if (cliPrompt == result)
-            {
-                result += sizeof(kCliPrompt) - 1;
-            }
-            else
+            line += sizeof(kCliPrompt) - 1;
+        }
+
+        if (strcmp(line, "Done") == 0)
+        {
+            // The output is what precedes the "Done" line, without the trailing newline.
+            *lineBegin = '\0';
+            if (lineBegin - aBuffer >= 2 && lineBegin[-2] == '\r')
             {
-                memmove(cliPrompt, cliPrompt + sizeof(kCliPrompt) - 1, strlen(cliPrompt) - sizeof(kCliPrompt) - 1);
+                lineBegin[-2] = '\0';
             }
+
+            aOutput = aBuffer;
+            break;
         }
 
-        matched = sscanf(result,
-                         "| %d | %s | %" PRIx64
-                         " | %hx | %02hhx%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx | %hu | %hhd | %d |",
-                         &joinable, aNetworks[rval].mNetworkName, &aNetworks[rval].mExtPanId, &aNetworks[rval].mPanId,
-                         &aNetworks[rval].mHardwareAddress[0], &aNetworks[rval].mHardwareAddress[1],
-                         &aNetworks[rval].mHardwareAddress[2], &aNetworks[rval].mHardwareAddress[3],
-                         &aNetworks[rval].mHardwareAddress[4], &aNetworks[rval].mHardwareAddress[5],
-                         &aNetworks[rval].mHardwareAddress[6], &aNetworks[rval].mHardwareAddress[7],
-                         &aNetworks[rval].mChannel, &aNetworks[rval].mRssi, &lqi);
-
-        // 15 is the number of output arguments of the last sscanf()
-        if (matched != 15)
+        if (strncmp(line, kCliError, sizeof(kCliError) - 1) == 0)
         {
-            continue;
+            otbrLog(OTBR_LOG_WARNING, "OpenThread CLI: %s", line);
+            ExitNow(error = OTBR_ERROR_OPENTHREAD);
         }
 
-        aNetworks[rval].mAllowingJoin = joinable != 0;
-        ++rval;
+        *lineEnd = lineEndChar;
     }
 
-    mTimeout = kDefaultTimeout;
-
 exit:
-    return rval;
+    return error;
 }
 
-bool OpenThreadClient::FactoryReset(void)
+OpenThreadClientPool::OpenThreadClientPool(size_t aMaxIdle)
+    : mMaxIdle(aMaxIdle)
 {
-    const char *result;
-    bool        rval = false;
-#if __APPLE__
-    typedef sig_t sighandler_t;
-#endif
-    sighandler_t handler;
+}
 
-    // Ignore the expected SIGPIPE signal during daemon reset.
-    handler = signal(SIGPIPE, SIG_IGN);
-    Execute("factoryreset");
-    signal(SIGPIPE, handler);
-    Disconnect();
-    sleep(1);
-    VerifyOrExit(rval = Connect());
+std::unique_ptr<OpenThreadClient> OpenThreadClientPool::Acquire(void)
+{
+    std::unique_ptr<OpenThreadClient> client;
+    std::unique_lock<std::mutex>      lock(mMutex);
+
+    while (client == nullptr && !mIdleClients.empty())
+    {
+        client = std::move(mIdleClients.back());
+        mIdleClients.pop_back();
+
+        if (!client->IsConnected())
+        {
+            client.reset();
+        }
+    }
 
-    result = Execute("version");
-    VerifyOrExit(result != NULL);
+    lock.unlock();
 
-    rval = strstr(result, "OPENTHREAD") != NULL;
+    if (client == nullptr)
+    {
+        client.reset(new OpenThreadClient());
+        VerifyOrExit(client->Connect(), client.reset());
+    }
 
 exit:
-    return rval;
+    return client;
+}
+
+void OpenThreadClientPool::Release(std::unique_ptr<OpenThreadClient> aClient)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (aClient != nullptr && mIdleClients.size() < mMaxIdle && aClient->IsConnected())
+    {
+        mIdleClients.push_back(std::move(aClient));
+    }
 }
 
 } // namespace Web
@@ -30,30 +30,22 @@
 
 #include "openthread-br/config.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "common/types.hpp"
+
 namespace otbr {
 namespace Web {
 
-#define OT_SCANNED_NET_BUFFER_SIZE 250
 #define OT_SET_MAX_DATA_SIZE 250
-#define OT_NETWORK_NAME_MAX_SIZE 17
-#define OT_HARDWARE_ADDRESS_SIZE 8
-#define OT_PREFIX_SIZE 8
 #define OT_ROUTER_ROLE 2
 
-struct WpanNetworkInfo
-{
-    char     mNetworkName[OT_NETWORK_NAME_MAX_SIZE];
-    bool     mAllowingJoin;
-    uint16_t mPanId;
-    uint16_t mChannel;
-    uint64_t mExtPanId;
-    int8_t   mRssi;
-    uint8_t  mHardwareAddress[OT_HARDWARE_ADDRESS_SIZE];
-    uint8_t  mPrefix[OT_PREFIX_SIZE];
-};
-
 /**
  * This class implements functionality of OpenThread client.
  *
@@ -81,6 +73,18 @@ public:
      */
     bool Connect(void);
 
+    /**
+     * This method checks whether the connection to OpenThread daemon is still usable, and disconnects it otherwise.
+     *
+     * What an idle connection has to read is discarded. The connection is closed when the daemon closed it, for
+     * example when it restarted or accepted another CLI session.
+     *
+     * @retval  true    The connection is usable.
+     * @retval  false   The connection is closed.
+     *
+     */
+    bool IsConnected(void);
+
     /**
      * This method executes OpenThread CLI.
      *
@@ -93,24 +97,42 @@ public:
     char *Execute(const char *aFormat, ...);
 
     /**
-     * This method scans Thread network.
+     * This method executes OpenThread CLI, and tells why it failed.
      *
-     * @param[out]  aNetworks   A pointer to the buffer to store network information.
-     * @param[in]   aLength     Number of entries in @p aNetworks.
+     * The connection is closed when the command fails, since the rest of the output may still come.
      *
-     * @returns Number of entries found. 0 if none found.
+     * @param[out]  aOutput     A reference to where to put the pointer to the output, or NULL if failed.
+     * @param[in]   aFormat     C style format string.
+     * @param[in]   ...         C style format arguments.
+     *
+     * @retval  OTBR_ERROR_NONE         Successfully executed the command.
+     * @retval  OTBR_ERROR_OPENTHREAD   The CLI replied with an error, which is logged.
+     * @retval  OTBR_ERROR_ERRNO        Failed to send the command or receive the output, or timed out with errno
+     *                                  set to ETIMEDOUT.
      *
      */
-    int Scan(WpanNetworkInfo *aNetworks, int aLength);
+    otbrError ExecuteCommand(char *&aOutput, const char *aFormat, ...);
 
     /**
-     * This method performs factory reset.
+     * This function looks for the end of a command output in the lines completed by newly received bytes.
+     *
+     * Scanned lines are left in place, the output is null-terminated in @p aBuffer once the "Done" line is found.
+     *
+     * @param[inout]    aBuffer     A pointer to the received bytes.
+     * @param[in]       aLength     The number of bytes received in @p aBuffer, including the new ones.
+     * @param[in]       aCount      The number of bytes newly received at the end of @p aBuffer.
+     * @param[inout]    aLineStart  A reference to the offset of the first line not completed yet.
+     * @param[out]      aOutput     A reference to where to put the pointer to the output, or NULL if more is needed.
+     *
+     * @retval  OTBR_ERROR_NONE         No error line is found, @p aOutput tells whether the output is complete.
+     * @retval  OTBR_ERROR_OPENTHREAD   The CLI replied with an error, which is logged.
      *
      */
-    bool FactoryReset(void);
+    static otbrError ParseOutput(char *aBuffer, size_t aLength, size_t aCount, size_t &aLineStart, char *&aOutput);
 
 private:
-    void Disconnect(void);
+    void      Disconnect(void);
+    otbrError ExecuteV(char *&aOutput, const char *aFormat, va_list aArgs);
 
     enum
     {
@@ -123,6 +145,77 @@ private:
     int  mSocket;
 };
 
+/**
+ * This class implements a pool of connected OpenThread clients, which are reused across requests.
+ *
+ */
+class OpenThreadClientPool
+{
+public:
+    /**
+     * This class implements a client leased from the pool, which is given back to the pool when destroyed.
+     *
+     */
+    class Lease
+    {
+    public:
+        /**
+         * This constructor leases a client from the pool.
+         *
+         * @param[in]   aPool   A reference to the pool.
+         *
+         */
+        explicit Lease(OpenThreadClientPool &aPool)
+            : mPool(aPool)
+            , mClient(aPool.Acquire())
+        {
+        }
+
+        /**
+         * This destructor gives the client back to the pool.
+         *
+         */
+        ~Lease(void) { mPool.Release(std::move(mClient)); }
+
+        /**
+         * This method indicates whether a connected client was leased.
+         *
+         * @retval  true    A client was leased.
+         * @retval  false   Failed to connect to the daemon.
+         *
+         */
+        bool IsValid(void) const { return mClient != nullptr; }
+
+        /**
+         * This method returns the leased client.
+         *
+         * @returns A pointer to the client.
+         *
+         */
+        OpenThreadClient *operator->(void) { return mClient.get(); }
+
+    private:
+        OpenThreadClientPool &            mPool;
+        std::unique_ptr<OpenThreadClient> mClient;
+    };
+
+    /**
+     * This constructor creates an empty pool.
+     *
+     * @param[in]   aMaxIdle    The maximum number of idle clients kept connected.
+     *
+     */
+    explicit OpenThreadClientPool(size_t aMaxIdle);
+
+private:
+    std::unique_ptr<OpenThreadClient> Acquire(void);
+    void                              Release(std::unique_ptr<OpenThreadClient> aClient);
+
+    std::mutex                                     mMutex;
+    std::vector<std::unique_ptr<OpenThreadClient>> mIdleClients;
+    size_t                                         mMaxIdle;
+};
+
 } // namespace Web
 } // namespace otbr
 
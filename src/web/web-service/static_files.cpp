@@ -0,0 +1,248 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the cache of static web files.
+ */
+
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_WEB
+
+#include "web/web-service/static_files.hpp"
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+
+#include "common/logging.hpp"
+
+namespace otbr {
+namespace Web {
+
+static const char kGzipSuffix[]   = ".gz";
+static const char kBrotliSuffix[] = ".br";
+static const char kIndexFile[]    = "index.html";
+
+static_assert(sizeof(kGzipSuffix) == sizeof(kBrotliSuffix), "the variant suffixes must be of the same length");
+
+static bool EndsWith(const std::string &aString, const char *aSuffix)
+{
+    size_t length = strlen(aSuffix);
+
+    return aString.size() > length && aString.compare(aString.size() - length, length, aSuffix) == 0;
+}
+
+size_t StaticFiles::Load(const std::string &aRootPath)
+{
+    std::map<std::string, File>        files;
+    std::map<std::string, std::string> variants;
+
+    try
+    {
+        boost::filesystem::path root = boost::filesystem::canonical(aRootPath);
+
+        for (boost::filesystem::recursive_directory_iterator it(root), end; it != end; ++it)
+        {
+            std::string path = it->path().string();
+            std::string name = path.substr(root.string().size() + 1);
+
+            if (!boost::filesystem::is_regular_file(it->status()))
+            {
+                continue;
+            }
+
+            if (EndsWith(name, kGzipSuffix) || EndsWith(name, kBrotliSuffix))
+            {
+                // Attached to the original file once all files are known.
+                variants[name] = path;
+                continue;
+            }
+
+            File &file = files[name];
+
+            file.mContent     = ReadFile(path);
+            file.mContentType = GetContentType(name);
+            file.mETag        = ComputeETag(file.mContent);
+            file.mImmutable   = IsHashedName(name);
+        }
+
+        for (const auto &variant : variants)
+        {
+            const std::string &name   = variant.first;
+            bool               isGzip = EndsWith(name, kGzipSuffix);
+            auto               it     = files.find(name.substr(0, name.size() - (sizeof(kGzipSuffix) - 1)));
+
+            if (it == files.end())
+            {
+                File &file = files[name];
+
+                file.mContent   = ReadFile(variant.second);
+                file.mETag      = ComputeETag(file.mContent);
+                file.mImmutable = IsHashedName(name);
+            }
+            else
+            {
+                (isGzip ? it->second.mGzipContent : it->second.mBrotliContent) = ReadFile(variant.second);
+            }
+        }
+    } catch (const std::exception &e)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to load web files from %s: %s", aRootPath.c_str(), e.what());
+    }
+
+    mFiles.swap(files);
+    otbrLog(OTBR_LOG_INFO, "Loaded %zu web files from %s", mFiles.size(), aRootPath.c_str());
+
+    return mFiles.size();
+}
+
+const StaticFiles::File *StaticFiles::Find(const std::string &aPath) const
+{
+    std::string name = aPath.substr(0, aPath.find_first_of("?#"));
+    auto        it   = mFiles.end();
+
+    name.erase(0, name.find_first_not_of('/'));
+
+    if (name.empty() || name.back() == '/')
+    {
+        name += kIndexFile;
+    }
+
+    it = mFiles.find(name);
+    if (it == mFiles.end())
+    {
+        it = mFiles.find(name + "/" + kIndexFile);
+    }
+
+    return it == mFiles.end() ? NULL : &it->second;
+}
+
+std::string StaticFiles::ReadFile(const std::string &aPath)
+{
+    std::ifstream      file(aPath, std::ios::in | std::ios::binary);
+    std::ostringstream content;
+
+    if (!file)
+    {
+        throw std::runtime_error("could not read " + aPath);
+    }
+
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+std::string StaticFiles::GetContentType(const std::string &aPath)
+{
+    static const struct
+    {
+        const char *mExtension;
+        const char *mContentType;
+    } kContentTypes[] = {
+        {".html", "text/html; charset=utf-8"},
+        {".css", "text/css"},
+        {".js", "application/javascript"},
+        {".json", "application/json"},
+        {".png", "image/png"},
+        {".jpg", "image/jpeg"},
+        {".svg", "image/svg+xml"},
+        {".ico", "image/x-icon"},
+        {".woff", "font/woff"},
+        {".woff2", "font/woff2"},
+    };
+    std::string contentType;
+
+    for (const auto &type : kContentTypes)
+    {
+        if (EndsWith(aPath, type.mExtension))
+        {
+            contentType = type.mContentType;
+            break;
+        }
+    }
+
+    return contentType;
+}
+
+std::string StaticFiles::ComputeETag(const std::string &aContent)
+{
+    // 64-bit FNV-1a, which is enough to tell versions of a file apart.
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    char     etag[sizeof("\"\"") + 16 + 1 + 16];
+
+    for (unsigned char c : aContent)
+    {
+        hash = (hash ^ c) * UINT64_C(0x100000001b3);
+    }
+
+    snprintf(etag, sizeof(etag), "\"%016" PRIx64 "-%zx\"", hash, aContent.size());
+
+    return etag;
+}
+
+bool StaticFiles::IsHashedName(const std::string &aPath)
+{
+    // A name like "main.3f2a9c1e.js": a segment of at least 8 hex digits between the base name and the extension.
+    static const size_t kMinHashLength = 8;
+
+    std::string name     = boost::filesystem::path(aPath).filename().string();
+    size_t      begin    = name.find('.');
+    bool        isHashed = false;
+
+    while (!isHashed && begin != std::string::npos)
+    {
+        size_t end = name.find('.', begin + 1);
+
+        if (end == std::string::npos)
+        {
+            break;
+        }
+
+        isHashed = (end - begin - 1 >= kMinHashLength);
+        for (size_t i = begin + 1; isHashed && i < end; i++)
+        {
+            isHashed = isxdigit(static_cast<unsigned char>(name[i]));
+        }
+
+        begin = end;
+    }
+
+    return isHashed;
+}
+
+} // namespace Web
+} // namespace otbr
@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the cache of static web files.
+ */
+
+#ifndef OTBR_WEB_WEB_SERVICE_STATIC_FILES_
+#define OTBR_WEB_WEB_SERVICE_STATIC_FILES_
+
+#include "openthread-br/config.h"
+
+#include <map>
+#include <string>
+
+namespace otbr {
+namespace Web {
+
+/**
+ * This class keeps the static web files in memory, so that they are served without touching the file system.
+ *
+ */
+class StaticFiles
+{
+public:
+    /**
+     * This structure represents a cached file.
+     *
+     */
+    struct File
+    {
+        std::string mContent;       ///< The file content.
+        std::string mGzipContent;   ///< The content of the precompressed `.gz` variant, empty if not available.
+        std::string mBrotliContent; ///< The content of the precompressed `.br` variant, empty if not available.
+        std::string mContentType;   ///< The media type, empty if unknown.
+        std::string mETag;          ///< The strong entity tag, including the quotes.
+        bool        mImmutable;     ///< Whether the file name carries a content hash, so the file never changes.
+    };
+
+    /**
+     * This method loads all the regular files under a directory, replacing the files loaded before.
+     *
+     * A file named `<name>.gz` or `<name>.br` next to `<name>` is loaded as its precompressed variant.
+     *
+     * @param[in]  aRootPath  The root directory of the web files.
+     *
+     * @returns The number of files loaded.
+     *
+     */
+    size_t Load(const std::string &aRootPath);
+
+    /**
+     * This method finds the file served for a request path.
+     *
+     * The query of the path is ignored, and `index.html` is served for a directory.
+     *
+     * @param[in]  aPath  The request path.
+     *
+     * @returns A pointer to the file, or NULL if not found.
+     *
+     */
+    const File *Find(const std::string &aPath) const;
+
+private:
+    static std::string ReadFile(const std::string &aPath);
+    static std::string GetContentType(const std::string &aPath);
+    static std::string ComputeETag(const std::string &aContent);
+    static bool        IsHashedName(const std::string &aPath);
+
+    std::map<std::string, File> mFiles;
+};
+
+} // namespace Web
+} // namespace otbr
+
+#endif // OTBR_WEB_WEB_SERVICE_STATIC_FILES_
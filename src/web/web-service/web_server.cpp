@@ -33,12 +33,19 @@
 
 #include "web/web-service/web_server.hpp"
 
-#define BOOST_NO_CXX11_SCOPED_ENUMS
-#include <boost/filesystem.hpp>
-#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <mutex>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+#include <json/json.h>
+#include <json/writer.h>
 
 #include <server_http.hpp>
 
+#include "common/code_utils.hpp"
+#include "web/web-service/compressor.hpp"
+
 #define OT_ADD_PREFIX_PATH "^/add_prefix"
 #define OT_AVAILABLE_NETWORK_PATH "^/available_network$"
 #define OT_DELETE_PREFIX_PATH "^/delete_prefix"
@@ -47,26 +54,165 @@
 #define OT_JOIN_NETWORK_PATH "^/join_network$"
 #define OT_SET_NETWORK_PATH "^/settings$"
 #define OT_COMMISSIONER_START_PATH "^/commission$"
+#define OT_JOBS_PATH "^/jobs$"
+#define OT_JOB_START_PATH "^/jobs/(available_network|form_network|join_network|commission)$"
+#define OT_JOB_STATUS_PATH "^/jobs/([0-9]+)$"
+#define OT_JOB_EVENTS_PATH "^/jobs/([0-9]+)/events$"
+#define OT_STATUS_EVENTS_PATH "^/status/events$"
 #define OT_REQUEST_METHOD_GET "GET"
 #define OT_REQUEST_METHOD_POST "POST"
 #define OT_RESPONSE_SUCCESS_STATUS "HTTP/1.1 200 OK\r\n"
 #define OT_RESPONSE_HEADER_LENGTH "Content-Length: "
-#define OT_RESPONSE_HEADER_CSS_TYPE "\r\nContent-Type: text/css"
+#define OT_RESPONSE_NOT_MODIFIED_STATUS "HTTP/1.1 304 Not Modified\r\n"
+#define OT_RESPONSE_HEADER_CACHE_IMMUTABLE "Cache-Control: public, max-age=31536000, immutable\r\n"
+#define OT_RESPONSE_HEADER_CACHE_REVALIDATE "Cache-Control: no-cache\r\n"
+#define OT_RESPONSE_HEADER_CONNECTION "Connection: "
+#define OT_RESPONSE_HEADER_CONTENT_TYPE "Content-Type: "
+#define OT_RESPONSE_HEADER_ENCODING "Content-Encoding: "
+#define OT_RESPONSE_HEADER_ETAG "ETag: "
+#define OT_RESPONSE_HEADER_VARY_ENCODING "Vary: Accept-Encoding\r\n"
+#define OT_RESPONSE_HEADER_END "\r\n"
+#define OT_RESPONSE_HEADER_EVENT_STREAM "Content-Type: text/event-stream\r\n"
 #define OT_RESPONSE_HEADER_TYPE "Content-Type: application/json\r\n charset=utf-8"
 #define OT_RESPONSE_PLACEHOLD "\r\n\r\n"
 #define OT_RESPONSE_FAILURE_STATUS "HTTP/1.1 400 Bad Request\r\n"
-#define OT_BUFFER_SIZE 1024
+#define OT_RESPONSE_BUSY_STATUS "HTTP/1.1 429 Too Many Requests\r\n"
+#define OT_RESPONSE_HEADER_RETRY_AFTER "Retry-After: "
+
+#ifndef OTBR_CONFIG_WEB_STATUS_WAIT_TIMEOUT
+/**
+ * The maximum time in milliseconds the status thread waits for a signal of the agent.
+ *
+ * A signal read by a request handler is not seen by the status thread until it times out, so this bounds how late
+ * such a change is pushed.
+ *
+ */
+#define OTBR_CONFIG_WEB_STATUS_WAIT_TIMEOUT 1000
+#endif
+
+#ifndef OTBR_CONFIG_WEB_COMPRESSION_MIN_SIZE
+/**
+ * The minimum size in bytes of an API response body to be compressed, if the client accepts it.
+ *
+ * Smaller bodies fit in a packet either way, and are not worth the time to compress.
+ *
+ */
+#define OTBR_CONFIG_WEB_COMPRESSION_MIN_SIZE 1024
+#endif
+
+#ifndef OTBR_CONFIG_WEB_RETRY_AFTER
+/**
+ * The time in seconds a client is told to wait before retrying an operation rejected for too many pending ones.
+ *
+ */
+#define OTBR_CONFIG_WEB_RETRY_AFTER 5
+#endif
 
 namespace otbr {
 namespace Web {
 
+/**
+ * This class streams events to a client as Server-Sent Events.
+ *
+ * Events are written one after another, as the response can only have one write in progress. The response is
+ * released, and so the connection closed, once the `result` event is sent or a write fails.
+ *
+ */
+class EventStream : public std::enable_shared_from_this<EventStream>
+{
+public:
+    EventStream(const HttpServer &aServer, const std::shared_ptr<HttpServer::Response> &aResponse)
+        : mServer(aServer)
+        , mResponse(aResponse)
+        , mSending(false)
+        , mClosing(false)
+    {
+    }
+
+    void Push(const std::string &aEvent, const std::string &aData)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        VerifyOrExit(mResponse != nullptr);
+
+        // The data must be on a single line, while the JSON writer ends it with a newline.
+        mPending += "event: " + aEvent + "\ndata: " + boost::algorithm::trim_right_copy(aData) + "\n\n";
+        mClosing = mClosing || aEvent == "result";
+
+        if (!mSending)
+        {
+            Flush();
+        }
+
+    exit:
+        return;
+    }
+
+    bool IsOpen(void)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mResponse != nullptr;
+    }
+
+private:
+    void Flush(void)
+    {
+        std::shared_ptr<EventStream> self = shared_from_this();
+
+        if (mPending.empty())
+        {
+            if (mClosing)
+            {
+                mResponse.reset();
+            }
+            ExitNow();
+        }
+
+        *mResponse << mPending;
+        mPending.clear();
+        mSending = true;
+
+        mServer.send(mResponse, [self](const boost::system::error_code &aError) {
+            std::lock_guard<std::mutex> lock(self->mMutex);
+
+            self->mSending = false;
+            if (aError)
+            {
+                self->mResponse.reset();
+                self->mPending.clear();
+            }
+            else
+            {
+                self->Flush();
+            }
+        });
+
+    exit:
+        return;
+    }
+
+    const HttpServer &                    mServer;
+    std::shared_ptr<HttpServer::Response> mResponse;
+    std::mutex                            mMutex;
+    std::string                           mPending;
+    bool                                  mSending;
+    bool                                  mClosing;
+};
+
 WebServer::WebServer(void)
     : mServer(new HttpServer())
+    , mStatusStopping(false)
 {
 }
 
 WebServer::~WebServer(void)
 {
+    mStatusStopping = true;
+    if (mStatusThread.joinable())
+    {
+        mStatusThread.join();
+    }
     delete mServer;
 }
 
@@ -80,14 +226,16 @@ void WebServer::Init()
     }
 }
 
-void WebServer::StartWebServer(const char *aIfName, const char *aListenAddr, uint16_t aPort)
+void WebServer::StartWebServer(const char *aIfName, const char *aListenAddr, uint16_t aPort, size_t aThreadPoolSize)
 {
     if (aListenAddr != NULL)
     {
         mServer->config.address = aListenAddr;
     }
-    mServer->config.port = aPort;
+    mServer->config.port             = aPort;
+    mServer->config.thread_pool_size = aThreadPoolSize;
     mWpanService.SetInterfaceName(aIfName);
+    mStaticFiles.Load(WEB_FILE_PATH);
     Init();
     ResponseJoinNetwork();
     ResponseFormNetwork();
@@ -96,15 +244,119 @@ void WebServer::StartWebServer(const char *aIfName, const char *aListenAddr, uin
     ResponseGetStatus();
     ResponseGetAvailableNetwork();
     ResponseCommission();
+    ResponseGetJobs();
+    ResponseStartJob();
+    ResponseGetJob();
+    ResponseJobEvents();
+    ResponseStatusEvents();
     DefaultHttpResponse();
+    mStatusThread = std::thread(&WebServer::WatchStatus, this);
     mServer->start();
+    mStatusStopping = true;
+    mStatusThread.join();
 }
 
 void WebServer::StopWebServer(void)
 {
+    mStatusStopping = true;
     mServer->stop();
 }
 
+static bool AcceptsEncoding(const HttpServer::Request &aRequest, const char *aEncoding)
+{
+    auto        header   = aRequest.header.find("Accept-Encoding");
+    bool        accepted = false;
+    std::string coding;
+
+    VerifyOrExit(header != aRequest.header.end());
+
+    for (std::istringstream codings(header->second); !accepted && std::getline(codings, coding, ',');)
+    {
+        size_t parameters = coding.find(';');
+        size_t quality    = coding.find("q=", parameters);
+
+        accepted = boost::algorithm::iequals(boost::algorithm::trim_copy(coding.substr(0, parameters)), aEncoding) &&
+                   (parameters == std::string::npos || quality == std::string::npos ||
+                    atof(coding.c_str() + quality + 2) > 0);
+    }
+
+exit:
+    return accepted;
+}
+
+static std::string GetConnectionHeader(const HttpServer::Request &aRequest)
+{
+    auto        range  = aRequest.header.equal_range("Connection");
+    std::string header = aRequest.http_version >= "1.1" ? "" : "close";
+
+    // The server keeps the connection unless the request asks to close it, or it is an HTTP/1.0 request which does not
+    // ask to keep it. Only the HTTP/1.0 clients need to be told that the connection is kept.
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (boost::algorithm::iequals(it->second, "close"))
+        {
+            header = "close";
+            break;
+        }
+        if (boost::algorithm::iequals(it->second, "keep-alive"))
+        {
+            header = aRequest.http_version >= "1.1" ? "" : "keep-alive";
+            break;
+        }
+    }
+
+    return header.empty() ? header : OT_RESPONSE_HEADER_CONNECTION + header + OT_RESPONSE_HEADER_END;
+}
+
+static void WriteResponse(HttpServer::Response &     aResponse,
+                          const HttpServer::Request &aRequest,
+                          const char *               aStatus,
+                          const std::string &        aBody)
+{
+    // Each thread of the server has its own compressor, whose streams are reused by the requests it handles.
+    static thread_local Compressor sCompressor;
+
+    const std::string *body = &aBody;
+    std::string        compressed;
+
+    aResponse << aStatus << GetConnectionHeader(aRequest);
+
+    if (aBody.size() >= OTBR_CONFIG_WEB_COMPRESSION_MIN_SIZE)
+    {
+        aResponse << OT_RESPONSE_HEADER_VARY_ENCODING;
+
+        // gzip is preferred, as some clients take deflate as raw deflate data instead of the zlib format.
+        for (int coding = 0; coding < Compressor::kCodingNum; coding++)
+        {
+            const char *name = Compressor::GetCodingName(static_cast<Compressor::Coding>(coding));
+
+            if (AcceptsEncoding(aRequest, name) &&
+                sCompressor.Compress(static_cast<Compressor::Coding>(coding), aBody, compressed))
+            {
+                aResponse << OT_RESPONSE_HEADER_ENCODING << name << OT_RESPONSE_HEADER_END;
+                body = &compressed;
+                break;
+            }
+        }
+    }
+
+    aResponse << OT_RESPONSE_HEADER_LENGTH << body->size() << OT_RESPONSE_PLACEHOLD;
+    aResponse.write(body->data(), static_cast<std::streamsize>(body->size()));
+}
+
+static void WriteBusyResponse(HttpServer::Response &aResponse, const HttpServer::Request &aRequest)
+{
+    static const std::string kStatus = OT_RESPONSE_BUSY_STATUS OT_RESPONSE_HEADER_RETRY_AFTER +
+                                       std::to_string(OTBR_CONFIG_WEB_RETRY_AFTER) + OT_RESPONSE_HEADER_END;
+    Json::Value      root;
+    Json::FastWriter jsonWriter;
+
+    root["result"] = "busy";
+    root["error"]  = 1;
+
+    WriteResponse(aResponse, aRequest, kStatus.c_str(), jsonWriter.write(root));
+}
+
 void WebServer::HandleHttpRequest(const char *aUrl, const char *aMethod, HttpRequestCallback aCallback)
 {
     mServer->resource[aUrl][aMethod] = [aCallback, this](std::shared_ptr<HttpServer::Response> response,
@@ -117,159 +369,314 @@ void WebServer::HandleHttpRequest(const char *aUrl, const char *aMethod, HttpReq
                 httpResponse = aCallback(request->content.string(), this);
             }
 
-            *response << OT_RESPONSE_SUCCESS_STATUS << OT_RESPONSE_HEADER_LENGTH << httpResponse.length()
-                      << OT_RESPONSE_PLACEHOLD << httpResponse;
+            WriteResponse(*response, *request, OT_RESPONSE_SUCCESS_STATUS, httpResponse);
         } catch (std::exception &e)
         {
-            *response << OT_RESPONSE_FAILURE_STATUS << OT_RESPONSE_HEADER_LENGTH << strlen(e.what())
-                      << OT_RESPONSE_PLACEHOLD << e.what();
+            WriteResponse(*response, *request, OT_RESPONSE_FAILURE_STATUS, e.what());
         }
     };
 }
 
-void DefaultResourceSend(const HttpServer &                           aServer,
-                         const std::shared_ptr<HttpServer::Response> &aResponse,
-                         const std::shared_ptr<std::ifstream> &       aIfStream)
+void WebServer::HandleJobRequest(const char *aUrl, const char *aMethod, const std::string &aName)
 {
-    static std::vector<char> buffer(OT_BUFFER_SIZE); // Safe when server is running on one thread
-
-    std::streamsize readLength;
-
-    if ((readLength = aIfStream->read(&buffer[0], buffer.size()).gcount()) > 0)
-    {
-        aResponse->write(&buffer[0], readLength);
-        if (readLength == static_cast<std::streamsize>(buffer.size()))
+    mServer->resource[aUrl][aMethod] = [aName, this](std::shared_ptr<HttpServer::Response> response,
+                                                     std::shared_ptr<HttpServer::Request>  request) {
+        // The operation is run as a job, so that it is limited and shared with the jobs started by other clients.
+        JobManager::Task task = CreateJobTask(aName, request->content.string());
+        uint32_t         id   = mJobManager.Start(aName, task, IsSharedJob(aName));
+        std::string      httpResponse;
+
+        if (id == 0)
         {
-            aServer.send(aResponse, [&aServer, aResponse, aIfStream](const boost::system::error_code &ec) {
-                if (!ec)
-                {
-                    DefaultResourceSend(aServer, aResponse, aIfStream);
-                }
-                else
-                {
-                    std::cerr << "Connection interrupted" << std::endl;
-                }
-            });
+            WriteBusyResponse(*response, *request);
         }
-    }
+        else if (mJobManager.Wait(id, httpResponse))
+        {
+            WriteResponse(*response, *request, OT_RESPONSE_SUCCESS_STATUS, httpResponse);
+        }
+        else
+        {
+            WriteResponse(*response, *request, OT_RESPONSE_FAILURE_STATUS, "No such job");
+        }
+    };
 }
 
-void WebServer::DefaultHttpResponse(void)
+static uint32_t GetJobId(const HttpServer::Request &aRequest)
 {
-    mServer->default_resource[OT_REQUEST_METHOD_GET] = [this](std::shared_ptr<HttpServer::Response> response,
-                                                              std::shared_ptr<HttpServer::Request>  request) {
-        try
-        {
-            auto webRootPath = boost::filesystem::canonical(WEB_FILE_PATH);
-            auto path        = boost::filesystem::canonical(webRootPath / request->path);
-            // Check if path is within webRootPath
-            if (std::distance(webRootPath.begin(), webRootPath.end()) > std::distance(path.begin(), path.end()) ||
-                !std::equal(webRootPath.begin(), webRootPath.end(), path.begin()))
-            {
-                throw std::invalid_argument("path must be within root path");
-            }
-            if (boost::filesystem::is_directory(path))
-            {
-                path /= "index.html";
-            }
-            if (!(boost::filesystem::exists(path) && boost::filesystem::is_regular_file(path)))
-            {
-                throw std::invalid_argument("file does not exist");
-            }
+    return static_cast<uint32_t>(strtoul(aRequest.path_match[1].str().c_str(), NULL, 10));
+}
 
-            std::string cacheControl, etag;
+bool WebServer::IsSharedJob(const std::string &aName)
+{
+    // A scan takes no parameters, so the scans requested at the same time all get the same result.
+    return aName == "available_network";
+}
 
-            auto ifs = std::make_shared<std::ifstream>();
-            ifs->open(path.string(), std::ifstream::in | std::ios::binary | std::ios::ate);
-            std::string extension = boost::filesystem::extension(path.string());
-            std::string style     = "";
-            if (extension == ".css")
-            {
-                style = OT_RESPONSE_HEADER_CSS_TYPE;
-            }
+void WebServer::ResponseGetJobs(void)
+{
+    mServer->resource[OT_JOBS_PATH][OT_REQUEST_METHOD_GET] =
+        [this](std::shared_ptr<HttpServer::Response> response, std::shared_ptr<HttpServer::Request> request) {
+            std::string httpResponse;
 
-            if (*ifs)
-            {
-                auto length = ifs->tellg();
-                ifs->seekg(0, std::ios::beg);
+            mJobManager.GetMetrics(httpResponse);
+            WriteResponse(*response, *request, OT_RESPONSE_SUCCESS_STATUS, httpResponse);
+        };
+}
+
+void WebServer::ResponseStartJob(void)
+{
+    mServer->resource[OT_JOB_START_PATH][OT_REQUEST_METHOD_POST] =
+        [this](std::shared_ptr<HttpServer::Response> response, std::shared_ptr<HttpServer::Request> request) {
+            std::string      name = request->path_match[1];
+            JobManager::Task task = CreateJobTask(name, request->content.string());
+            uint32_t         id   = mJobManager.Start(name, task, IsSharedJob(name));
+            Json::Value      root;
+            Json::FastWriter jsonWriter;
+
+            VerifyOrExit(id != 0, WriteBusyResponse(*response, *request));
+
+            root["result"] = "successful";
+            root["error"]  = 0;
+            root["job"]    = id;
 
-                *response << OT_RESPONSE_SUCCESS_STATUS << cacheControl << etag << OT_RESPONSE_HEADER_LENGTH << length
-                          << style << OT_RESPONSE_PLACEHOLD;
+            WriteResponse(*response, *request, OT_RESPONSE_SUCCESS_STATUS, jsonWriter.write(root));
 
-                DefaultResourceSend(*mServer, response, ifs);
+        exit:
+            return;
+        };
+}
+
+void WebServer::ResponseGetJob(void)
+{
+    mServer->resource[OT_JOB_STATUS_PATH][OT_REQUEST_METHOD_GET] =
+        [this](std::shared_ptr<HttpServer::Response> response, std::shared_ptr<HttpServer::Request> request) {
+            uint32_t    id = GetJobId(*request);
+            std::string httpResponse;
+
+            if (mJobManager.GetStatus(id, httpResponse))
+            {
+                WriteResponse(*response, *request, OT_RESPONSE_SUCCESS_STATUS, httpResponse);
             }
             else
             {
-                throw std::invalid_argument("could not read file");
+                WriteResponse(*response, *request, OT_RESPONSE_FAILURE_STATUS, "No such job");
             }
+        };
+}
 
-        } catch (const std::exception &e)
-        {
-            std::string content = "Could not open path";
-            *response << OT_RESPONSE_FAILURE_STATUS << OT_RESPONSE_HEADER_LENGTH << content.length()
-                      << OT_RESPONSE_PLACEHOLD << content;
-        }
-    };
+void WebServer::ResponseJobEvents(void)
+{
+    mServer->resource[OT_JOB_EVENTS_PATH][OT_REQUEST_METHOD_GET] =
+        [this](std::shared_ptr<HttpServer::Response> response, std::shared_ptr<HttpServer::Request> request) {
+            uint32_t                     id = GetJobId(*request);
+            std::shared_ptr<EventStream> stream(new EventStream(*mServer, response));
+
+            // The stream has no length, so it ends by closing the connection.
+            response->close_connection_after_response = true;
+            *response << OT_RESPONSE_SUCCESS_STATUS << OT_RESPONSE_HEADER_EVENT_STREAM
+                      << OT_RESPONSE_HEADER_CACHE_REVALIDATE << OT_RESPONSE_HEADER_END;
+            response.reset();
+
+            if (!mJobManager.Subscribe(id, [stream](const std::string &aEvent, const std::string &aData) {
+                    stream->Push(aEvent, aData);
+                }))
+            {
+                stream->Push("result", "{\"result\":\"failed\"}");
+            }
+        };
 }
 
-std::string WebServer::HandleJoinNetworkRequest(const std::string &aJoinRequest, void *aUserData)
+void WebServer::ResponseStatusEvents(void)
 {
-    WebServer *webServer = static_cast<WebServer *>(aUserData);
+    mServer->resource[OT_STATUS_EVENTS_PATH][OT_REQUEST_METHOD_GET] =
+        [this](std::shared_ptr<HttpServer::Response> response, std::shared_ptr<HttpServer::Request> request) {
+            std::lock_guard<std::mutex> lock(mStatusMutex);
+
+            StatusSubscriber subscriber;
+            std::string      data = mWpanService.HandleStatusRequest();
+            Json::Value      status;
+            Json::Reader     reader;
+
+            (void)request;
+
+            response->close_connection_after_response = true;
+            *response << OT_RESPONSE_SUCCESS_STATUS << OT_RESPONSE_HEADER_EVENT_STREAM
+                      << OT_RESPONSE_HEADER_CACHE_REVALIDATE << OT_RESPONSE_HEADER_END;
+            subscriber.mStream.reset(new EventStream(*mServer, response));
+            response.reset();
+
+            // The whole status is pushed first, and then only the members which change, under the same lock as the
+            // status thread so that no change falls in between.
+            reader.parse(data, status);
+            PushStatus(subscriber, status, data);
+            mStatusSubscribers.push_back(subscriber);
+        };
+}
 
-    return webServer->HandleJoinNetworkRequest(aJoinRequest);
+void WebServer::WatchStatus(void)
+{
+    while (!mStatusStopping)
+    {
+        if (mWpanService.WaitStatusChange(OTBR_CONFIG_WEB_STATUS_WAIT_TIMEOUT))
+        {
+            PushStatus();
+        }
+    }
 }
 
-std::string WebServer::HandleFormNetworkRequest(const std::string &aFormRequest, void *aUserData)
+void WebServer::PushStatus(void)
 {
-    WebServer *webServer = static_cast<WebServer *>(aUserData);
+    std::lock_guard<std::mutex> lock(mStatusMutex);
+
+    std::string  data;
+    Json::Value  status;
+    Json::Reader reader;
+
+    mStatusSubscribers.erase(std::remove_if(mStatusSubscribers.begin(), mStatusSubscribers.end(),
+                                            [](const StatusSubscriber &aSubscriber) {
+                                                return !aSubscriber.mStream->IsOpen();
+                                            }),
+                             mStatusSubscribers.end());
 
-    return webServer->HandleFormNetworkRequest(aFormRequest);
+    // Idle dashboards cost the agent nothing, and the status is only read when there is someone to push it to.
+    VerifyOrExit(!mStatusSubscribers.empty());
+
+    data = mWpanService.HandleStatusRequest();
+    VerifyOrExit(reader.parse(data, status));
+
+    for (StatusSubscriber &subscriber : mStatusSubscribers)
+    {
+        PushStatus(subscriber, status, data);
+    }
+
+exit:
+    return;
 }
 
-std::string WebServer::HandleAddPrefixRequest(const std::string &aAddPrefixRequest, void *aUserData)
+void WebServer::PushStatus(StatusSubscriber &aSubscriber, const Json::Value &aStatus, const std::string &aData)
 {
-    WebServer *webServer = static_cast<WebServer *>(aUserData);
+    const Json::Value &lastStatus = aSubscriber.mStatus;
+    const Json::Value &last       = lastStatus["result"];
+    const Json::Value &result     = aStatus["result"];
+    Json::Value        delta(Json::objectValue);
+    Json::FastWriter   jsonWriter;
 
-    return webServer->HandleAddPrefixRequest(aAddPrefixRequest);
+    if (!last.isObject() || !result.isObject() || aStatus["error"] != lastStatus["error"])
+    {
+        aSubscriber.mStream->Push("status", aData);
+        ExitNow();
+    }
+
+    // A member no longer in the status is pushed as null.
+    for (const std::string &name : result.getMemberNames())
+    {
+        if (!last.isMember(name) || last[name] != result[name])
+        {
+            delta[name] = result[name];
+        }
+    }
+    for (const std::string &name : last.getMemberNames())
+    {
+        if (!result.isMember(name))
+        {
+            delta[name] = Json::Value(Json::nullValue);
+        }
+    }
+
+    VerifyOrExit(!delta.empty());
+    aSubscriber.mStream->Push("delta", jsonWriter.write(delta));
+
+exit:
+    aSubscriber.mStatus = aStatus;
 }
 
-std::string WebServer::HandleDeletePrefixRequest(const std::string &aDeletePrefixRequest, void *aUserData)
+void WebServer::DefaultHttpResponse(void)
 {
-    WebServer *webServer = static_cast<WebServer *>(aUserData);
+    mServer->default_resource[OT_REQUEST_METHOD_GET] = [this](std::shared_ptr<HttpServer::Response> response,
+                                                              std::shared_ptr<HttpServer::Request>  request) {
+        const StaticFiles::File *file = mStaticFiles.Find(request->path);
+        const std::string *      content;
+        std::string              headers;
+        auto                     ifNoneMatch = request->header.find("If-None-Match");
 
-    return webServer->HandleDeletePrefixRequest(aDeletePrefixRequest);
+        if (file == NULL)
+        {
+            std::string failure = "Could not open path";
+            *response << OT_RESPONSE_FAILURE_STATUS << OT_RESPONSE_HEADER_LENGTH << failure.length()
+                      << OT_RESPONSE_PLACEHOLD << failure;
+            return;
+        }
+
+        headers = file->mImmutable ? OT_RESPONSE_HEADER_CACHE_IMMUTABLE : OT_RESPONSE_HEADER_CACHE_REVALIDATE;
+        headers += GetConnectionHeader(*request);
+        headers += OT_RESPONSE_HEADER_ETAG + file->mETag + OT_RESPONSE_HEADER_END;
+        if (!file->mGzipContent.empty() || !file->mBrotliContent.empty())
+        {
+            headers += OT_RESPONSE_HEADER_VARY_ENCODING;
+        }
+
+        if (ifNoneMatch != request->header.end() &&
+            (ifNoneMatch->second == "*" || ifNoneMatch->second.find(file->mETag) != std::string::npos))
+        {
+            *response << OT_RESPONSE_NOT_MODIFIED_STATUS << headers << OT_RESPONSE_HEADER_END;
+            return;
+        }
+
+        if (!file->mBrotliContent.empty() && AcceptsEncoding(*request, "br"))
+        {
+            content = &file->mBrotliContent;
+            headers += OT_RESPONSE_HEADER_ENCODING "br" OT_RESPONSE_HEADER_END;
+        }
+        else if (!file->mGzipContent.empty() && AcceptsEncoding(*request, "gzip"))
+        {
+            content = &file->mGzipContent;
+            headers += OT_RESPONSE_HEADER_ENCODING "gzip" OT_RESPONSE_HEADER_END;
+        }
+        else
+        {
+            content = &file->mContent;
+        }
+
+        if (!file->mContentType.empty())
+        {
+            headers += OT_RESPONSE_HEADER_CONTENT_TYPE + file->mContentType + OT_RESPONSE_HEADER_END;
+        }
+
+        *response << OT_RESPONSE_SUCCESS_STATUS << headers << OT_RESPONSE_HEADER_LENGTH << content->size()
+                  << OT_RESPONSE_PLACEHOLD;
+        response->write(content->data(), content->size());
+    };
 }
 
-std::string WebServer::HandleGetStatusRequest(const std::string &aGetStatusRequest, void *aUserData)
+std::string WebServer::HandleAddPrefixRequest(const std::string &aAddPrefixRequest, void *aUserData)
 {
     WebServer *webServer = static_cast<WebServer *>(aUserData);
 
-    return webServer->HandleGetStatusRequest(aGetStatusRequest);
+    return webServer->HandleAddPrefixRequest(aAddPrefixRequest);
 }
 
-std::string WebServer::HandleGetAvailableNetworkResponse(const std::string &aGetAvailableNetworkRequest,
-                                                         void *             aUserData)
+std::string WebServer::HandleDeletePrefixRequest(const std::string &aDeletePrefixRequest, void *aUserData)
 {
     WebServer *webServer = static_cast<WebServer *>(aUserData);
 
-    return webServer->HandleGetAvailableNetworkResponse(aGetAvailableNetworkRequest);
+    return webServer->HandleDeletePrefixRequest(aDeletePrefixRequest);
 }
 
-std::string WebServer::HandleCommission(const std::string &aCommissionRequest, void *aUserData)
+std::string WebServer::HandleGetStatusRequest(const std::string &aGetStatusRequest, void *aUserData)
 {
     WebServer *webServer = static_cast<WebServer *>(aUserData);
 
-    return webServer->HandleCommission(aCommissionRequest);
+    return webServer->HandleGetStatusRequest(aGetStatusRequest);
 }
 
 void WebServer::ResponseJoinNetwork(void)
 {
-    HandleHttpRequest(OT_JOIN_NETWORK_PATH, OT_REQUEST_METHOD_POST, HandleJoinNetworkRequest);
+    HandleJobRequest(OT_JOIN_NETWORK_PATH, OT_REQUEST_METHOD_POST, "join_network");
 }
 
 void WebServer::ResponseFormNetwork(void)
 {
-    HandleHttpRequest(OT_FORM_NETWORK_PATH, OT_REQUEST_METHOD_POST, HandleFormNetworkRequest);
+    HandleJobRequest(OT_FORM_NETWORK_PATH, OT_REQUEST_METHOD_POST, "form_network");
 }
 
 void WebServer::ResponseAddOnMeshPrefix(void)
@@ -289,12 +696,55 @@ void WebServer::ResponseGetStatus(void)
 
 void WebServer::ResponseGetAvailableNetwork(void)
 {
-    HandleHttpRequest(OT_AVAILABLE_NETWORK_PATH, OT_REQUEST_METHOD_GET, HandleGetAvailableNetworkResponse);
+    HandleJobRequest(OT_AVAILABLE_NETWORK_PATH, OT_REQUEST_METHOD_GET, "available_network");
 }
 
 void WebServer::ResponseCommission(void)
 {
-    HandleHttpRequest(OT_COMMISSIONER_START_PATH, OT_REQUEST_METHOD_POST, HandleCommission);
+    HandleJobRequest(OT_COMMISSIONER_START_PATH, OT_REQUEST_METHOD_POST, "commission");
+}
+
+JobManager::Task WebServer::CreateJobTask(const std::string &aName, const std::string &aRequest)
+{
+    JobManager::Task task;
+
+    if (aName == "available_network")
+    {
+        task = [this](const JobManager::EventHandler &aPublish) { return HandleAvailableNetworkJob(aPublish); };
+    }
+    else if (aName == "form_network")
+    {
+        task = [this, aRequest](const JobManager::EventHandler &) { return HandleFormNetworkRequest(aRequest); };
+    }
+    else if (aName == "join_network")
+    {
+        task = [this, aRequest](const JobManager::EventHandler &) { return HandleJoinNetworkRequest(aRequest); };
+    }
+    else
+    {
+        task = [this, aRequest](const JobManager::EventHandler &) { return HandleCommission(aRequest); };
+    }
+
+    return task;
+}
+
+std::string WebServer::HandleAvailableNetworkJob(const JobManager::EventHandler &aPublish)
+{
+    std::string      response = mWpanService.HandleAvailableNetworkRequest();
+    Json::Value      root;
+    Json::Reader     reader;
+    Json::FastWriter jsonWriter;
+
+    // Each network is published on its own, so that the client can list them before the whole result arrives.
+    if (reader.parse(response, root) && root["result"].isArray())
+    {
+        for (unsigned i = 0; i < root["result"].size(); i++)
+        {
+            aPublish("network", jsonWriter.write(root["result"][i]));
+        }
+    }
+
+    return response;
 }
 
 std::string WebServer::HandleJoinNetworkRequest(const std::string &aJoinRequest)
@@ -323,12 +773,6 @@ std::string WebServer::HandleGetStatusRequest(const std::string &aGetStatusReque
     return mWpanService.HandleStatusRequest();
 }
 
-std::string WebServer::HandleGetAvailableNetworkResponse(const std::string &aGetAvailableNetworkRequest)
-{
-    (void)aGetAvailableNetworkRequest;
-    return mWpanService.HandleAvailableNetworkRequest();
-}
-
 std::string WebServer::HandleCommission(const std::string &aCommissionRequest)
 {
     return mWpanService.HandleCommission(aCommissionRequest);
@@ -37,9 +37,13 @@
 #include "openthread-br/config.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <net/if.h>
@@ -47,6 +51,10 @@
 
 #include <boost/asio/ip/tcp.hpp>
 
+#include <json/value.h>
+
+#include "web/web-service/job_manager.hpp"
+#include "web/web-service/static_files.hpp"
 #include "web/web-service/wpan_service.hpp"
 
 namespace SimpleWeb {
@@ -59,6 +67,8 @@ namespace Web {
 
 typedef SimpleWeb::Server<SimpleWeb::HTTP> HttpServer;
 
+class EventStream;
+
 /**
  * This class implements the http server.
  *
@@ -81,12 +91,13 @@ public:
     /**
      * This method starts the Web Server.
      *
-     * @param[in]  aIfName     The pointer to the Thread interface name.
-     * @param[in]  aListenAddr The http server listen address, can be NULL for any address.
-     * @param[in]  aPort       The port of http server.
+     * @param[in]  aIfName          The pointer to the Thread interface name.
+     * @param[in]  aListenAddr      The http server listen address, can be NULL for any address.
+     * @param[in]  aPort            The port of http server.
+     * @param[in]  aThreadPoolSize  The number of threads handling http requests.
      *
      */
-    void StartWebServer(const char *aIfName, const char *aListenAddr, uint16_t aPort);
+    void StartWebServer(const char *aIfName, const char *aListenAddr, uint16_t aPort, size_t aThreadPoolSize);
 
     /**
      * This method stops the Web Server.
@@ -96,24 +107,31 @@ public:
 
 private:
     typedef std::string (*HttpRequestCallback)(const std::string &aRequest, void *aUserData);
-    static std::string HandleJoinNetworkRequest(const std::string &aJoinRequest, void *aUserData);
-    static std::string HandleFormNetworkRequest(const std::string &aFormRequest, void *aUserData);
+
+    struct StatusSubscriber
+    {
+        std::shared_ptr<EventStream> mStream;
+        Json::Value                  mStatus; ///< The status last pushed to the stream.
+    };
+
     static std::string HandleAddPrefixRequest(const std::string &aAddPrefixRequest, void *aUserData);
     static std::string HandleDeletePrefixRequest(const std::string &aDeletePrefixRequest, void *aUserData);
     static std::string HandleGetStatusRequest(const std::string &aGetStatusRequest, void *aUserData);
-    static std::string HandleGetAvailableNetworkResponse(const std::string &aGetAvailableNetworkRequest,
-                                                         void *             aUserData);
-    static std::string HandleCommission(const std::string &aCommissionRequest, void *aUserData);
 
     std::string HandleJoinNetworkRequest(const std::string &aJoinRequest);
     std::string HandleFormNetworkRequest(const std::string &aFormRequest);
     std::string HandleAddPrefixRequest(const std::string &aAddPrefixRequest);
     std::string HandleDeletePrefixRequest(const std::string &aDeletePrefixRequest);
     std::string HandleGetStatusRequest(const std::string &aGetStatusRequest);
-    std::string HandleGetAvailableNetworkResponse(const std::string &aGetAvailableNetworkRequest);
     std::string HandleCommission(const std::string &aCommissionRequest);
+    std::string HandleAvailableNetworkJob(const JobManager::EventHandler &aPublish);
+
+    JobManager::Task CreateJobTask(const std::string &aName, const std::string &aRequest);
+
+    static bool IsSharedJob(const std::string &aName);
 
     void HandleHttpRequest(const char *aUrl, const char *aMethod, HttpRequestCallback aCallback);
+    void HandleJobRequest(const char *aUrl, const char *aMethod, const std::string &aName);
     void ResponseJoinNetwork(void);
     void ResponseFormNetwork(void);
     void ResponseAddOnMeshPrefix(void);
@@ -122,11 +140,29 @@ private:
     void ResponseGetAvailableNetwork(void);
     void DefaultHttpResponse(void);
     void ResponseCommission(void);
+    void ResponseGetJobs(void);
+    void ResponseStartJob(void);
+    void ResponseGetJob(void);
+    void ResponseJobEvents(void);
+    void ResponseStatusEvents(void);
+
+    void WatchStatus(void);
+    void PushStatus(void);
+
+    static void PushStatus(StatusSubscriber &aSubscriber, const Json::Value &aStatus, const std::string &aData);
 
     void Init(void);
 
     HttpServer *           mServer;
     otbr::Web::WpanService mWpanService;
+    otbr::Web::StaticFiles mStaticFiles;
+    otbr::Web::JobManager  mJobManager;
+
+    // The status streams are pushed to by the status thread, while the stopping flag is set by a signal handler.
+    std::mutex                    mStatusMutex;
+    std::vector<StatusSubscriber> mStatusSubscribers;
+    std::thread                   mStatusThread;
+    std::atomic<bool>             mStatusStopping;
 };
 
 } // namespace Web
@@ -31,379 +31,599 @@
  *   This file implements the wpan controller service
  */
 
+#define OTBR_LOG_MODULE OTBR_LOG_MODULE_WEB
+
 #include "web/web-service/wpan_service.hpp"
 
-#include <inttypes.h>
+#include <algorithm>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
 
 #include "common/byteswap.hpp"
 #include "common/code_utils.hpp"
+#include "dbus/common/constants.hpp"
+#include "web/web-service/json.hpp"
+
+#ifndef OTBR_CONFIG_WEB_CLI_MAX_IDLE_CLIENTS
+/**
+ * The maximum number of idle CLI connections kept by the web service.
+ *
+ * The OpenThread daemon serves one CLI session at a time and closes the previous session when accepting a new one.
+ *
+ */
+#define OTBR_CONFIG_WEB_CLI_MAX_IDLE_CLIENTS 1
+#endif
+
+#ifndef OTBR_CONFIG_WEB_STATUS_TTL
+/**
+ * The time in milliseconds the network status is served from the snapshot, unless the device role changes.
+ *
+ */
+#define OTBR_CONFIG_WEB_STATUS_TTL 2000
+#endif
 
 namespace otbr {
 namespace Web {
 
+using DBus::ActiveScanResult;
+using DBus::ClientError;
+using DBus::Ip6Prefix;
+using DBus::OnMeshPrefix;
+using DBus::PropertyValues;
+using DBus::ThreadApiDBus;
+
 const char *WpanService::kBorderAgentHost = "127.0.0.1";
 const char *WpanService::kBorderAgentPort = "49191";
 
 #define WPAN_RESPONSE_SUCCESS "successful"
 #define WPAN_RESPONSE_FAILURE "failed"
 
-std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinRequest)
+// The properties the status is made of, a change to any of them changes the status.
+static const std::vector<std::string> kStatusEventProperties = {
+    OTBR_DBUS_PROPERTY_DEVICE_ROLE,          OTBR_DBUS_PROPERTY_OT_HOST_VERSION,
+    OTBR_DBUS_PROPERTY_EUI64,                OTBR_DBUS_PROPERTY_CHANNEL,
+    OTBR_DBUS_PROPERTY_NETWORK_NAME,         OTBR_DBUS_PROPERTY_EXTPANID,
+    OTBR_DBUS_PROPERTY_PANID,                OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX,
+    OTBR_DBUS_PROPERTY_MESH_LOCAL_EID,       OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY,
+    OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES,
+};
+
+static bool ParsePrefix(std::string aPrefix, Ip6Prefix &aResult)
 {
-    Json::Value                 root;
-    Json::Reader                reader;
-    Json::FastWriter            jsonWriter;
-    std::string                 response;
-    int                         index;
-    std::string                 networkKey;
-    std::string                 prefix;
-    bool                        defaultRoute;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_SetFailed);
-
-    VerifyOrExit(reader.parse(aJoinRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
-    index        = root["index"].asUInt();
-    networkKey   = root["networkKey"].asString();
-    prefix       = root["prefix"].asString();
-    defaultRoute = root["defaultRoute"].asBool();
-
-    if (prefix.find('/') == std::string::npos)
+    bool        ret = false;
+    size_t      slash;
+    in6_addr    address;
+    int         prefixLength;
+    std::string length = "64";
+
+    slash = aPrefix.find('/');
+    if (slash != std::string::npos)
     {
-        prefix += "/64";
+        length = aPrefix.substr(slash + 1);
+        aPrefix.resize(slash);
     }
 
-    VerifyOrExit(client.FactoryReset(), ret = kWpanStatus_LeaveFailed);
-    VerifyOrExit(client.Execute("masterkey %s", networkKey.c_str()) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("networkname %s", mNetworks[index].mNetworkName) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("channel %u", mNetworks[index].mChannel) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("extpanid %016" PRIx64, mNetworks[index].mExtPanId) != NULL,
-                 ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("panid %u", mNetworks[index].mPanId) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("ifconfig up") != NULL, ret = kWpanStatus_JoinFailed);
-    VerifyOrExit(client.Execute("thread start") != NULL, ret = kWpanStatus_JoinFailed);
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
-                 ret = kWpanStatus_SetFailed);
+    VerifyOrExit(inet_pton(AF_INET6, aPrefix.c_str(), &address) == 1);
+    prefixLength = atoi(length.c_str());
+    VerifyOrExit(prefixLength > 0 && prefixLength <= OTBR_IP6_PREFIX_SIZE * 8);
+    aResult.mLength = static_cast<uint8_t>(prefixLength);
+    aResult.mPrefix.assign(address.s6_addr, address.s6_addr + OTBR_IP6_PREFIX_SIZE);
+    ret = true;
+
 exit:
+    return ret;
+}
 
-    root.clear();
-    root["result"] = WPAN_RESPONSE_SUCCESS;
+static void InitOnMeshPrefix(OnMeshPrefix &aPrefix, bool aDefaultRoute)
+{
+    // The same flags as "prefix add <prefix> paso[r]" of the CLI.
+    aPrefix.mPreference   = 0;
+    aPrefix.mPreferred    = true;
+    aPrefix.mSlaac        = true;
+    aPrefix.mDhcp         = false;
+    aPrefix.mConfigure    = false;
+    aPrefix.mDefaultRoute = aDefaultRoute;
+    aPrefix.mOnMesh       = true;
+    aPrefix.mStable       = true;
+}
 
-    root["error"] = ret;
-    if (ret != kWpanStatus_Ok)
-    {
-        otbrLog(OTBR_LOG_ERR, "wpan service error: %d", ret);
-        root["result"] = WPAN_RESPONSE_FAILURE;
-    }
-    response = jsonWriter.write(root);
-    return response;
+static std::string Ip6AddressToString(const uint8_t *aAddress)
+{
+    char buffer[INET6_ADDRSTRLEN];
+
+    return inet_ntop(AF_INET6, aAddress, buffer, sizeof(buffer)) != NULL ? buffer : "";
 }
 
-std::string WpanService::HandleFormNetworkRequest(const std::string &aFormRequest)
+static std::string Uint64ToHex(uint64_t aValue)
 {
-    Json::Value                 root;
-    Json::FastWriter            jsonWriter;
-    Json::Reader                reader;
-    std::string                 response;
-    otbr::Psk::Pskc             psk;
-    char                        pskcStr[OT_PSKC_MAX_LENGTH * 2 + 1];
-    uint8_t                     extPanIdBytes[OT_EXTENDED_PANID_LENGTH];
-    std::string                 networkKey;
-    std::string                 prefix;
-    uint16_t                    channel;
-    std::string                 networkName;
-    std::string                 passphrase;
-    std::string                 panId;
-    std::string                 extPanId;
-    bool                        defaultRoute;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_SetFailed);
-
-    pskcStr[OT_PSKC_MAX_LENGTH * 2] = '\0'; // for manipulating with strlen
-    VerifyOrExit(reader.parse(aFormRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
-    networkKey   = root["networkKey"].asString();
-    prefix       = root["prefix"].asString();
-    channel      = root["channel"].asUInt();
-    networkName  = root["networkName"].asString();
-    passphrase   = root["passphrase"].asString();
-    panId        = root["panId"].asString();
-    extPanId     = root["extPanId"].asString();
-    defaultRoute = root["defaultRoute"].asBool();
-
-    otbr::Utils::Hex2Bytes(extPanId.c_str(), extPanIdBytes, OT_EXTENDED_PANID_LENGTH);
-    otbr::Utils::Bytes2Hex(psk.ComputePskc(extPanIdBytes, networkName.c_str(), passphrase.c_str()), OT_PSKC_MAX_LENGTH,
-                           pskcStr);
-
-    if (prefix.find('/') == std::string::npos)
-    {
-        prefix += "/64";
-    }
+    uint8_t bytes[sizeof(aValue)];
+    char    hex[sizeof(aValue) * 2 + 1];
+
+    otbr::Encoding::BigEndian::WriteUint64(aValue, bytes);
+    otbr::Utils::Bytes2Hex(bytes, sizeof(bytes), hex, sizeof(hex));
+
+    return hex;
+}
+
+WpanService::WpanService(void)
+    : mStatusChanged(false)
+    , mClientPool(OTBR_CONFIG_WEB_CLI_MAX_IDLE_CLIENTS)
+{
+}
+
+void WpanService::SetInterfaceName(const char *aIfName)
+{
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    DBusError error;
+
+    // The connection is used by the threads of the web server, though one at a time.
+    dbus_threads_init_default();
+    dbus_error_init(&error);
+    mThreadApi.reset();
+    mConnection = DBus::UniqueDBusConnection(dbus_bus_get(DBUS_BUS_SYSTEM, &error));
+    VerifyOrExit(mConnection != nullptr, otbrLog(OTBR_LOG_ERR, "Failed to connect to D-Bus: %s", error.message));
+    mThreadApi.reset(new ThreadApiDBus(mConnection.get(), aIfName));
+    mThreadApi->AddPropertiesChangedHandler([this](const std::vector<std::string> &aProperties) {
+        for (const std::string &property : aProperties)
+        {
+            if (std::find(kStatusEventProperties.begin(), kStatusEventProperties.end(), property) !=
+                kStatusEventProperties.end())
+            {
+                HandleStatusChanged();
+                break;
+            }
+        }
+    });
+    mThreadApi->AddIp6AddressesHandler([this](const DBus::Ip6AddressesChange &) { HandleStatusChanged(); });
+    HandleStatusChanged();
 
-    VerifyOrExit(client.FactoryReset(), ret = kWpanStatus_LeaveFailed);
-    VerifyOrExit(client.Execute("masterkey %s", networkKey.c_str()) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("networkname %s", networkName.c_str()) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("channel %u", channel) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("extpanid %s", extPanId.c_str()) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("panid %s", panId.c_str()) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("pskc %s", pskcStr) != NULL, ret = kWpanStatus_SetFailed);
-    VerifyOrExit(client.Execute("ifconfig up") != NULL, ret = kWpanStatus_FormFailed);
-    VerifyOrExit(client.Execute("thread start") != NULL, ret = kWpanStatus_FormFailed);
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
-                 ret = kWpanStatus_SetFailed);
 exit:
+    dbus_error_free(&error);
+}
 
-    root.clear();
+ThreadApiDBus *WpanService::GetThreadApi(void) const
+{
+    VerifyOrExit(mConnection != nullptr);
 
-    root["result"] = WPAN_RESPONSE_SUCCESS;
-    root["error"]  = ret;
-    if (ret != kWpanStatus_Ok)
+    // Dispatch the property signals queued since the last request instead of letting them pile up, the device role
+    // ones clear the status snapshot.
+    dbus_connection_read_write(mConnection.get(), 0);
+    while (dbus_connection_dispatch(mConnection.get()) == DBUS_DISPATCH_DATA_REMAINS)
     {
-        otbrLog(OTBR_LOG_ERR, "wpan service error: %d", ret);
-        root["result"] = WPAN_RESPONSE_FAILURE;
     }
-    response = jsonWriter.write(root);
-    return response;
+
+exit:
+    return mThreadApi.get();
 }
 
-std::string WpanService::HandleAddPrefixRequest(const std::string &aAddPrefixRequest)
+std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinRequest)
 {
-    Json::Value                 root;
-    Json::FastWriter            jsonWriter;
-    Json::Reader                reader;
-    std::string                 response;
-    std::string                 prefix;
-    bool                        defaultRoute;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_SetFailed);
-
-    VerifyOrExit(reader.parse(aAddPrefixRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
-    prefix       = root["prefix"].asString();
-    defaultRoute = root["defaultRoute"].asBool();
-
-    VerifyOrExit(client.Execute("prefix add %s paso%s", prefix.c_str(), (defaultRoute ? "r" : "")) != NULL,
-                 ret = kWpanStatus_SetGatewayFailed);
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    mStatus.clear();
+
+    int                  index;
+    std::string          networkKey;
+    std::string          prefix;
+    bool                 defaultRoute;
+    std::vector<uint8_t> masterKey(OTBR_MASTER_KEY_SIZE);
+    OnMeshPrefix         onMeshPrefix;
+    int                  ret       = kWpanStatus_Ok;
+    ThreadApiDBus *      threadApi = GetThreadApi();
+
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_SetFailed);
+
+    VerifyOrExit(JsonReader()
+                     .Bind("index", index)
+                     .Bind("networkKey", networkKey)
+                     .Bind("prefix", prefix)
+                     .Bind("defaultRoute", defaultRoute)
+                     .Parse(aJoinRequest),
+                 ret = kWpanStatus_ParseRequestFailed);
+
+    VerifyOrExit(index >= 0 && static_cast<size_t>(index) < mNetworks.size(), ret = kWpanStatus_NetworkNotFound);
+    VerifyOrExit(otbr::Utils::Hex2Bytes(networkKey.c_str(), masterKey.data(), masterKey.size()) ==
+                     static_cast<int>(masterKey.size()),
+                 ret = kWpanStatus_ParseRequestFailed);
+    VerifyOrExit(ParsePrefix(prefix, onMeshPrefix.mPrefix), ret = kWpanStatus_ParseRequestFailed);
+    InitOnMeshPrefix(onMeshPrefix, defaultRoute);
+
+    VerifyOrExit(threadApi->FactoryReset(nullptr) == ClientError::ERROR_NONE, ret = kWpanStatus_LeaveFailed);
+    VerifyOrExit(threadApi->Attach(mNetworks[index].mNetworkName, mNetworks[index].mPanId,
+                                   mNetworks[index].mExtendedPanId, masterKey, std::vector<uint8_t>(),
+                                   1U << mNetworks[index].mChannel, nullptr) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_JoinFailed);
+    VerifyOrExit(threadApi->AddOnMeshPrefix(onMeshPrefix) == ClientError::ERROR_NONE, ret = kWpanStatus_SetFailed);
 exit:
+    return GetResultResponse(ret);
+}
 
-    root.clear();
+std::string WpanService::HandleFormNetworkRequest(const std::string &aFormRequest)
+{
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    mStatus.clear();
+
+    otbr::Psk::Pskc      psk;
+    const uint8_t *      pskc;
+    uint8_t              extPanIdBytes[OT_EXTENDED_PANID_LENGTH];
+    std::string          networkKey;
+    std::string          prefix;
+    int                  channel;
+    std::string          networkName;
+    std::string          passphrase;
+    std::string          panId;
+    std::string          extPanId;
+    bool                 defaultRoute;
+    std::vector<uint8_t> masterKey(OTBR_MASTER_KEY_SIZE);
+    OnMeshPrefix         onMeshPrefix;
+    int                  ret       = kWpanStatus_Ok;
+    ThreadApiDBus *      threadApi = GetThreadApi();
+
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_SetFailed);
+
+    VerifyOrExit(JsonReader()
+                     .Bind("networkKey", networkKey)
+                     .Bind("prefix", prefix)
+                     .Bind("channel", channel)
+                     .Bind("networkName", networkName)
+                     .Bind("passphrase", passphrase)
+                     .Bind("panId", panId)
+                     .Bind("extPanId", extPanId)
+                     .Bind("defaultRoute", defaultRoute)
+                     .Parse(aFormRequest),
+                 ret = kWpanStatus_ParseRequestFailed);
+    VerifyOrExit(channel >= 0 && channel < 32, ret = kWpanStatus_ParseRequestFailed);
+
+    VerifyOrExit(otbr::Utils::Hex2Bytes(extPanId.c_str(), extPanIdBytes, OT_EXTENDED_PANID_LENGTH) ==
+                     OT_EXTENDED_PANID_LENGTH,
+                 ret = kWpanStatus_ParseRequestFailed);
+    pskc = psk.ComputePskc(extPanIdBytes, networkName.c_str(), passphrase.c_str());
+
+    VerifyOrExit(otbr::Utils::Hex2Bytes(networkKey.c_str(), masterKey.data(), masterKey.size()) ==
+                     static_cast<int>(masterKey.size()),
+                 ret = kWpanStatus_ParseRequestFailed);
+    VerifyOrExit(ParsePrefix(prefix, onMeshPrefix.mPrefix), ret = kWpanStatus_ParseRequestFailed);
+    InitOnMeshPrefix(onMeshPrefix, defaultRoute);
+
+    VerifyOrExit(threadApi->FactoryReset(nullptr) == ClientError::ERROR_NONE, ret = kWpanStatus_LeaveFailed);
+    VerifyOrExit(threadApi->Attach(networkName, static_cast<uint16_t>(strtoul(panId.c_str(), NULL, 0)),
+                                   strtoull(extPanId.c_str(), NULL, 16), masterKey,
+                                   std::vector<uint8_t>(pskc, pskc + OT_PSKC_MAX_LENGTH), 1U << channel,
+                                   nullptr) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_FormFailed);
+    VerifyOrExit(threadApi->AddOnMeshPrefix(onMeshPrefix) == ClientError::ERROR_NONE, ret = kWpanStatus_SetFailed);
+exit:
+    return GetResultResponse(ret);
+}
 
-    root["result"] = WPAN_RESPONSE_SUCCESS;
-    root["error"]  = ret;
-    if (ret != kWpanStatus_Ok)
-    {
-        otbrLog(OTBR_LOG_ERR, "wpan service error: %d", ret);
-        root["result"] = WPAN_RESPONSE_FAILURE;
-    }
-    response = jsonWriter.write(root);
-    return response;
+std::string WpanService::HandleAddPrefixRequest(const std::string &aAddPrefixRequest)
+{
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    mStatus.clear();
+
+    std::string    prefix;
+    bool           defaultRoute;
+    OnMeshPrefix   onMeshPrefix;
+    int            ret       = kWpanStatus_Ok;
+    ThreadApiDBus *threadApi = GetThreadApi();
+
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_SetFailed);
+
+    VerifyOrExit(JsonReader().Bind("prefix", prefix).Bind("defaultRoute", defaultRoute).Parse(aAddPrefixRequest),
+                 ret = kWpanStatus_ParseRequestFailed);
+
+    VerifyOrExit(ParsePrefix(prefix, onMeshPrefix.mPrefix), ret = kWpanStatus_ParseRequestFailed);
+    InitOnMeshPrefix(onMeshPrefix, defaultRoute);
+
+    VerifyOrExit(threadApi->AddOnMeshPrefix(onMeshPrefix) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_SetGatewayFailed);
+exit:
+    return GetResultResponse(ret);
 }
 
 std::string WpanService::HandleDeletePrefixRequest(const std::string &aDeleteRequest)
 {
-    Json::Value                 root;
-    Json::FastWriter            jsonWriter;
-    Json::Reader                reader;
-    std::string                 response;
-    std::string                 prefix;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    mStatus.clear();
 
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_SetFailed);
+    std::string    prefix;
+    Ip6Prefix      ip6Prefix;
+    int            ret       = kWpanStatus_Ok;
+    ThreadApiDBus *threadApi = GetThreadApi();
 
-    VerifyOrExit(reader.parse(aDeleteRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
-    prefix = root["prefix"].asString();
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_SetFailed);
 
-    VerifyOrExit(client.Execute("prefix remove %s", prefix.c_str()) != NULL, ret = kWpanStatus_SetGatewayFailed);
+    VerifyOrExit(JsonReader().Bind("prefix", prefix).Parse(aDeleteRequest), ret = kWpanStatus_ParseRequestFailed);
+
+    VerifyOrExit(ParsePrefix(prefix, ip6Prefix), ret = kWpanStatus_ParseRequestFailed);
+    VerifyOrExit(threadApi->RemoveOnMeshPrefix(ip6Prefix) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_SetGatewayFailed);
 exit:
+    return GetResultResponse(ret);
+}
 
-    root.clear();
-    root["result"] = WPAN_RESPONSE_SUCCESS;
+std::string WpanService::GetResultResponse(int aStatus)
+{
+    std::string response;
 
-    root["error"] = ret;
-    if (ret != kWpanStatus_Ok)
+    if (aStatus != kWpanStatus_Ok)
     {
-        otbrLog(OTBR_LOG_ERR, "wpan service error: %d", ret);
-        root["result"] = WPAN_RESPONSE_FAILURE;
+        otbrLog(OTBR_LOG_ERR, "wpan service error: %d", aStatus);
     }
-    response = jsonWriter.write(root);
+
+    JsonWriter(response)
+        .BeginObject()
+        .Member("error", aStatus)
+        .Member("result", aStatus == kWpanStatus_Ok ? WPAN_RESPONSE_SUCCESS : WPAN_RESPONSE_FAILURE)
+        .EndObject();
+
     return response;
 }
 
 std::string WpanService::HandleStatusRequest()
 {
-    Json::Value                 root, networkInfo;
-    Json::FastWriter            jsonWriter;
-    std::string                 response, networkName, extPanId, propertyValue;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-    char *                      rval;
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
 
-    networkInfo["WPAN service"] = "uninitialized";
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_SetFailed);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
 
-    VerifyOrExit((rval = client.Execute("state")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["NCP:State"] = rval;
+    // Dispatching the queued signals first clears the snapshot if the device role has changed.
+    GetThreadApi();
 
-    if (!strcmp(rval, "disabled"))
-    {
-        networkInfo["WPAN service"] = "offline";
-        ExitNow();
-    }
-    else if (!strcmp(rval, "detached"))
+    // All the clients polling the status share one snapshot, so they cost the agent as much as one client.
+    if (mStatus.empty() || now >= mStatusExpiry)
     {
-        networkInfo["WPAN service"] = "associating";
-        ExitNow();
+        GetStatus(mStatus);
+        mStatusExpiry = now + std::chrono::milliseconds(OTBR_CONFIG_WEB_STATUS_TTL);
     }
-    else
-    {
-        networkInfo["WPAN service"] = "associated";
-    }
-
-    VerifyOrExit((rval = client.Execute("version")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["NCP:Version"] = rval;
 
-    VerifyOrExit((rval = client.Execute("eui64")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["NCP:HardwareAddress"] = rval;
-
-    VerifyOrExit((rval = client.Execute("channel")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["NCP:Channel"] = rval;
+    return mStatus;
+}
 
-    VerifyOrExit((rval = client.Execute("state")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["Network:NodeType"] = rval;
+bool WpanService::WaitStatusChange(int aTimeout)
+{
+    struct pollfd pollFd;
+    bool          changed;
 
-    VerifyOrExit((rval = client.Execute("networkname")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["Network:Name"] = rval;
+    {
+        std::lock_guard<std::mutex> lock(mThreadApiMutex);
 
-    VerifyOrExit((rval = client.Execute("extpanid")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["Network:XPANID"] = rval;
+        changed = TakeStatusChanged();
+        pollFd  = {-1, POLLIN, 0};
+        VerifyOrExit(!changed && mConnection != nullptr);
+        VerifyOrExit(dbus_connection_get_unix_fd(mConnection.get(), &pollFd.fd));
+    }
 
-    VerifyOrExit((rval = client.Execute("panid")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-    networkInfo["Network:PANID"] = rval;
+    // The connection is polled without the lock, so that requests are not held up. A signal read by a request in the
+    // meantime is queued, and is dispatched on the timeout at the latest.
+    poll(&pollFd, 1, aTimeout);
 
     {
-        static const char kMeshLocalPrefixLocator[]       = "Mesh Local Prefix: ";
-        static const char kMeshLocalAddressTokenLocator[] = "0:ff:fe00:";
-        std::string       meshLocalPrefix;
+        std::lock_guard<std::mutex> lock(mThreadApiMutex);
 
-        VerifyOrExit((rval = client.Execute("dataset active")) != NULL, ret = kWpanStatus_GetPropertyFailed);
-        rval = strstr(rval, kMeshLocalPrefixLocator);
-        rval += sizeof(kMeshLocalPrefixLocator) - 1;
-        *strstr(rval, "\r\n") = '\0';
+        changed = TakeStatusChanged();
+    }
 
-        networkInfo["IPv6:MeshLocalPrefix"] = rval;
+exit:
+    if (!changed && pollFd.fd < 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(aTimeout));
+    }
 
-        meshLocalPrefix = rval;
-        meshLocalPrefix.resize(meshLocalPrefix.find('/'));
+    return changed;
+}
 
-        VerifyOrExit((rval = client.Execute("ipaddr")) != NULL, ret = kWpanStatus_GetPropertyFailed);
+void WpanService::HandleStatusChanged(void)
+{
+    mStatus.clear();
+    mStatusChanged = true;
+}
 
-        for (rval = strtok(rval, "\r\n"); rval != NULL; rval = strtok(NULL, "\r\n"))
-        {
-            char *meshLocalAddressToken = NULL;
+bool WpanService::TakeStatusChanged(void)
+{
+    bool changed;
 
-            if (strstr(rval, meshLocalPrefix.c_str()) != rval)
-            {
-                continue;
-            }
+    // Dispatching the queued signals sets the flag if the status has changed.
+    GetThreadApi();
+    changed        = mStatusChanged;
+    mStatusChanged = false;
 
-            meshLocalAddressToken = strstr(rval, kMeshLocalAddressTokenLocator);
+    return changed;
+}
 
-            if (meshLocalAddressToken == NULL)
-            {
-                break;
-            }
+void WpanService::GetStatus(std::string &aStatus)
+{
+    JsonWriter                                 writer(aStatus);
+    std::string                                role, version, networkName, addresses;
+    const char *                               service = "associated";
+    uint64_t                                   eui64, extPanId;
+    uint16_t                                   channel, panId;
+    std::array<uint8_t, OTBR_IP6_PREFIX_SIZE>  meshLocalPrefix;
+    std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> meshLocalEid;
+    std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> meshLocalPrefixAddress{};
+    std::vector<DBus::NeighborInfo>            neighbors;
+    std::vector<DBus::Ip6AddressInfo>          unicastAddresses;
+    char                                       panIdString[OT_PANID_LENGTH * 2 + 3];
+    PropertyValues                             values;
+    int                                        ret       = kWpanStatus_Ok;
+    ThreadApiDBus *                            threadApi = GetThreadApi();
+
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_SetFailed);
+
+    // All the properties are read in one round trip.
+    VerifyOrExit(threadApi->GetProperties(kStatusEventProperties, values) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_GetPropertyFailed);
+
+    VerifyOrExit(values.Get(OTBR_DBUS_PROPERTY_DEVICE_ROLE, role) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_GetPropertyFailed);
+
+    if (role == OTBR_ROLE_NAME_DISABLED)
+    {
+        service = "offline";
+        ExitNow();
+    }
+    else if (role == OTBR_ROLE_NAME_DETACHED)
+    {
+        service = "associating";
+        ExitNow();
+    }
 
-            // In case this address is not ends with 0:ff:fe00:xxxx
-            if (strchr(meshLocalAddressToken + sizeof(kMeshLocalAddressTokenLocator) - 1, ':') != NULL)
-            {
-                break;
-            }
+    VerifyOrExit(values.Get(OTBR_DBUS_PROPERTY_OT_HOST_VERSION, version) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_EUI64, eui64) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_CHANNEL, channel) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_NETWORK_NAME, networkName) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_EXTPANID, extPanId) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_PANID, panId) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_MESH_LOCAL_PREFIX, meshLocalPrefix) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_MESH_LOCAL_EID, meshLocalEid) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_NEIGHBOR_TABLE_PROEPRTY, neighbors) == ClientError::ERROR_NONE &&
+                     values.Get(OTBR_DBUS_PROPERTY_UNICAST_ADDRESSES, unicastAddresses) == ClientError::ERROR_NONE,
+                 ret = kWpanStatus_GetPropertyFailed);
+
+    std::copy(meshLocalPrefix.begin(), meshLocalPrefix.end(), meshLocalPrefixAddress.begin());
+    for (const DBus::Ip6AddressInfo &address : unicastAddresses)
+    {
+        if (address.mAddress.size() == OTBR_IP6_ADDRESS_SIZE)
+        {
+            addresses += (addresses.empty() ? "" : ", ") + Ip6AddressToString(address.mAddress.data()) + "/" +
+                         std::to_string(address.mPrefixLength);
         }
-
-        networkInfo["IPv6:MeshLocalAddress"] = rval;
     }
+    sprintf(panIdString, "0x%04x", panId);
 
 exit:
-    root["result"] = networkInfo;
+    writer.BeginObject().Member("error", ret).Key("result");
 
+    // The members are written in the order of the keys, which is the order the status is listed in.
     if (ret != kWpanStatus_Ok)
     {
-        root["result"] = WPAN_RESPONSE_FAILURE;
         otbrLog(OTBR_LOG_ERR, "wpan service error: %d", ret);
+        writer.Value(WPAN_RESPONSE_FAILURE);
     }
-    root["error"] = ret;
-    response      = jsonWriter.write(root);
-    return response;
+    else if (role == OTBR_ROLE_NAME_DISABLED || role == OTBR_ROLE_NAME_DETACHED)
+    {
+        writer.BeginObject().Member("NCP:State", role).Member("WPAN service", service).EndObject();
+    }
+    else
+    {
+        writer.BeginObject()
+            .Member("IPv6:Addresses", addresses)
+            .Member("IPv6:MeshLocalAddress", Ip6AddressToString(meshLocalEid.data()))
+            .Member("IPv6:MeshLocalPrefix", Ip6AddressToString(meshLocalPrefixAddress.data()) + "/64")
+            .Member("NCP:Channel", std::to_string(channel))
+            .Member("NCP:HardwareAddress", Uint64ToHex(eui64))
+            .Member("NCP:State", role)
+            .Member("NCP:Version", version)
+            .Member("Network:Name", networkName)
+            .Member("Network:NeighborCount", std::to_string(neighbors.size()))
+            .Member("Network:NodeType", role)
+            .Member("Network:PANID", panIdString)
+            .Member("Network:XPANID", Uint64ToHex(extPanId))
+            .Member("WPAN service", service)
+            .EndObject();
+    }
+
+    writer.EndObject();
 }
 
 std::string WpanService::HandleAvailableNetworkRequest()
 {
-    Json::Value                 root, networks, networkInfo;
-    Json::FastWriter            jsonWriter;
-    std::string                 response;
-    int                         ret = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-
-    VerifyOrExit(client.Connect(), ret = kWpanStatus_ScanFailed);
-    VerifyOrExit((mNetworksCount = client.Scan(mNetworks, sizeof(mNetworks) / sizeof(mNetworks[0]))) > 0,
-                 ret = kWpanStatus_NetworkNotFound);
-
-    for (int i = 0; i < mNetworksCount; i++)
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    std::string                   response;
+    JsonWriter                    writer(response);
+    bool                          done      = false;
+    int                           ret       = kWpanStatus_Ok;
+    ThreadApiDBus *               threadApi = GetThreadApi();
+    ThreadApiDBus::ScanHandler    handler   = [this, &done](const std::vector<ActiveScanResult> &aResults) {
+        mNetworks = aResults;
+        done      = true;
+    };
+
+    mNetworks.clear();
+    VerifyOrExit(threadApi != nullptr, ret = kWpanStatus_ScanFailed);
+    VerifyOrExit(threadApi->Scan(handler) == ClientError::ERROR_NONE, ret = kWpanStatus_ScanFailed);
+
+    // The scan result handler is called when dispatching the reply, or the error on timeout.
+    while (!done && dbus_connection_read_write_dispatch(mConnection.get(), -1))
     {
-        char extPanId[OT_EXTENDED_PANID_LENGTH * 2 + 1], panId[OT_PANID_LENGTH * 2 + 3],
-            hardwareAddress[OT_HARDWARE_ADDRESS_LENGTH * 2 + 1];
-        otbr::Utils::Long2Hex(bswap_64(mNetworks[i].mExtPanId), extPanId);
-        otbr::Utils::Bytes2Hex(mNetworks[i].mHardwareAddress, OT_HARDWARE_ADDRESS_LENGTH, hardwareAddress);
-        sprintf(panId, "0x%X", mNetworks[i].mPanId);
-        networkInfo[i]["nn"] = mNetworks[i].mNetworkName;
-        networkInfo[i]["xp"] = extPanId;
-        networkInfo[i]["pi"] = panId;
-        networkInfo[i]["ch"] = mNetworks[i].mChannel;
-        networkInfo[i]["ha"] = hardwareAddress;
     }
 
-    root["result"] = networkInfo;
+    VerifyOrExit(!mNetworks.empty(), ret = kWpanStatus_NetworkNotFound);
 
 exit:
+    writer.BeginObject().Member("error", ret).Key("result");
+
     if (ret != kWpanStatus_Ok)
     {
-        root["result"] = WPAN_RESPONSE_FAILURE;
         otbrLog(OTBR_LOG_ERR, "Error is %d", ret);
+        writer.Value(WPAN_RESPONSE_FAILURE);
     }
-    root["error"] = ret;
-    response      = jsonWriter.write(root);
+    else
+    {
+        writer.BeginArray();
+        for (const ActiveScanResult &network : mNetworks)
+        {
+            char panId[OT_PANID_LENGTH * 2 + 3];
+
+            sprintf(panId, "0x%X", network.mPanId);
+            writer.BeginObject()
+                .Member("ch", static_cast<int>(network.mChannel))
+                .Member("ha", Uint64ToHex(network.mExtAddress))
+                .Member("nn", network.mNetworkName)
+                .Member("pi", panId)
+                .Member("xp", Uint64ToHex(network.mExtendedPanId))
+                .EndObject();
+        }
+        writer.EndArray();
+    }
+
+    writer.EndObject();
     return response;
 }
 
 int WpanService::GetWpanServiceStatus(std::string &aNetworkName, std::string &aExtPanId) const
 {
-    int                         status = kWpanStatus_Ok;
-    otbr::Web::OpenThreadClient client;
-    const char *                rval;
-
-    VerifyOrExit(client.Connect(), status = kWpanStatus_Uninitialized);
-    rval = client.Execute("state");
-    VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
-    if (!strcmp(rval, "disabled"))
+    static const std::vector<std::string> kStatusProperties = {
+        OTBR_DBUS_PROPERTY_DEVICE_ROLE,
+        OTBR_DBUS_PROPERTY_NETWORK_NAME,
+        OTBR_DBUS_PROPERTY_EXTPANID,
+    };
+
+    std::lock_guard<std::mutex> lock(mThreadApiMutex);
+
+    int            status = kWpanStatus_Ok;
+    std::string    role;
+    uint64_t       extPanId;
+    PropertyValues values;
+    ThreadApiDBus *threadApi = GetThreadApi();
+
+    VerifyOrExit(threadApi != nullptr, status = kWpanStatus_Uninitialized);
+    VerifyOrExit(threadApi->GetProperties(kStatusProperties, values) == ClientError::ERROR_NONE,
+                 status = kWpanStatus_Down);
+    VerifyOrExit(values.Get(OTBR_DBUS_PROPERTY_DEVICE_ROLE, role) == ClientError::ERROR_NONE,
+                 status = kWpanStatus_Down);
+    if (role == OTBR_ROLE_NAME_DISABLED)
     {
         status = kWpanStatus_Offline;
     }
-    else if (!strcmp(rval, "detached"))
+    else if (role == OTBR_ROLE_NAME_DETACHED)
     {
         status = kWpanStatus_Associating;
     }
     else
     {
-        rval = client.Execute("networkname");
-        VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
-        aNetworkName = rval;
-
-        rval = client.Execute("extpanid");
-        VerifyOrExit(rval != NULL, status = kWpanStatus_Down);
-        aExtPanId = rval;
+        VerifyOrExit(values.Get(OTBR_DBUS_PROPERTY_NETWORK_NAME, aNetworkName) == ClientError::ERROR_NONE,
+                     status = kWpanStatus_Down);
+        VerifyOrExit(values.Get(OTBR_DBUS_PROPERTY_EXTPANID, extPanId) == ClientError::ERROR_NONE,
+                     status = kWpanStatus_Down);
+        aExtPanId = Uint64ToHex(extPanId);
     }
 
 exit:
@@ -413,32 +633,22 @@ exit:
 
 std::string WpanService::HandleCommission(const std::string &aCommissionRequest)
 {
-    Json::Value  root;
-    Json::Reader reader;
-    int          ret = kWpanStatus_Ok;
-    std::string  pskd;
-    std::string  response;
-
-    VerifyOrExit(reader.parse(aCommissionRequest.c_str(), root) == true, ret = kWpanStatus_ParseRequestFailed);
-    pskd = root["pskd"].asString();
+    int         ret = kWpanStatus_Ok;
+    std::string pskd;
+
+    VerifyOrExit(JsonReader().Bind("pskd", pskd).Parse(aCommissionRequest), ret = kWpanStatus_ParseRequestFailed);
     {
-        otbr::Web::OpenThreadClient client;
+        OpenThreadClientPool::Lease client(mClientPool);
         const char *                rval;
 
-        VerifyOrExit(client.Connect(), ret = kWpanStatus_Uninitialized);
-        rval = client.Execute("commissioner start");
+        VerifyOrExit(client.IsValid(), ret = kWpanStatus_Uninitialized);
+        rval = client->Execute("commissioner start");
         VerifyOrExit(rval != NULL, ret = kWpanStatus_Down);
-        rval = client.Execute("commissioner joiner add * %s", pskd.c_str());
+        rval = client->Execute("commissioner joiner add * %s", pskd.c_str());
         VerifyOrExit(rval != NULL, ret = kWpanStatus_Down);
-        root["error"] = ret;
     }
 exit:
-    if (ret != kWpanStatus_Ok)
-    {
-        root["result"] = WPAN_RESPONSE_FAILURE;
-        otbrLog(OTBR_LOG_ERR, "error: %d", ret);
-    }
-    return response;
+    return GetResultResponse(ret);
 }
 
 } // namespace Web
@@ -36,16 +36,19 @@
 
 #include "openthread-br/config.h"
 
-#include <net/if.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <json/json.h>
-#include <json/writer.h>
-
 #include "common/logging.hpp"
+#include "dbus/client/thread_api_dbus.hpp"
+#include "dbus/common/dbus_resources.hpp"
 #include "utils/hex.hpp"
 #include "utils/pskc.hpp"
 #include "web/web-service/ot_client.hpp"
@@ -56,7 +59,6 @@
  */
 
 #define OT_EXTENDED_PANID_LENGTH 8
-#define OT_HARDWARE_ADDRESS_LENGTH 8
 #define OT_NETWORK_NAME_LENGTH 16
 #define OT_PANID_LENGTH 2
 #define OT_PSKC_MAX_LENGTH 16
@@ -69,10 +71,18 @@ namespace Web {
 /**
  * This class provides web service to manage WPAN.
  *
+ * The methods are safe to be called by multiple threads.
+ *
  */
 class WpanService
 {
 public:
+    /**
+     * This constructor creates the wpan service.
+     *
+     */
+    WpanService(void);
+
     /**
      * This method handles the http request to join network.
      *
@@ -121,6 +131,20 @@ public:
      */
     std::string HandleStatusRequest(void);
 
+    /**
+     * This method waits for the agent to signal a change to the network status.
+     *
+     * The signaled changes are the ones to the device role, channel, network name, neighbor table and addresses. Other
+     * changes are only seen by the status requests after the snapshot expires.
+     *
+     * @param[in]  aTimeout  The maximum time in milliseconds to wait.
+     *
+     * @retval TRUE   The status has changed since the last call.
+     * @retval FALSE  No change was signaled within @p aTimeout.
+     *
+     */
+    bool WaitStatusChange(int aTimeout);
+
     /**
      * This method handles http request to get available networks.
      *
@@ -138,16 +162,12 @@ public:
     std::string HandleCommission(const std::string &aCommissionRequest);
 
     /**
-     * This method sets the Thread interface name.
+     * This method sets the Thread interface name, and connects to the D-Bus API of the agent serving it.
      *
      * @param[in]  aIfName  The pointer to the Thread interface name.
      *
      */
-    void SetInterfaceName(const char *aIfName)
-    {
-        strncpy(mIfName, aIfName, sizeof(mIfName) - 1);
-        mIfName[sizeof(mIfName) - 1] = '\0';
-    }
+    void SetInterfaceName(const char *aIfName);
 
     /**
      * This method gets status of wpan service.
@@ -174,11 +194,29 @@ public:
     std::string CommissionDevice(const char *aPskd, const char *aNetworkPassword);
 
 private:
-    WpanNetworkInfo mNetworks[OT_SCANNED_NET_BUFFER_SIZE];
-    int             mNetworksCount;
-    char            mIfName[IFNAMSIZ];
-    std::string     mNetworkName;
-    std::string     mExtPanId;
+    // These methods must be called with mThreadApiMutex held.
+    DBus::ThreadApiDBus *GetThreadApi(void) const;
+    void                 GetStatus(std::string &aStatus);
+    void                 HandleStatusChanged(void);
+    bool                 TakeStatusChanged(void);
+
+    static std::string GetResultResponse(int aStatus);
+
+    std::vector<DBus::ActiveScanResult>  mNetworks;
+    DBus::UniqueDBusConnection           mConnection;
+    std::unique_ptr<DBus::ThreadApiDBus> mThreadApi;
+
+    // Requests are handled by several threads, the Thread API and the scan results are used by one at a time.
+    mutable std::mutex mThreadApiMutex;
+
+    // The last status response, empty when the status has changed since.
+    std::string                           mStatus;
+    std::chrono::steady_clock::time_point mStatusExpiry;
+    bool                                  mStatusChanged;
+
+    // The commissioner has no D-Bus API yet, so commissioning still goes through the CLI. Connections to the CLI are
+    // kept across requests instead of connected by every request.
+    mutable OpenThreadClientPool mClientPool;
 
     enum
     {
@@ -0,0 +1,149 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes benchmarks of the common modules.
+ */
+
+#include <vector>
+
+#include "benchmark.hpp"
+#include "common/logging.hpp"
+#include "common/tlv.hpp"
+
+using otbr::Benchmark::DoNotOptimize;
+using otbr::Benchmark::State;
+
+namespace {
+
+/**
+ * This function fills @p aBuffer with @p aCount Tlvs of distinct types and short values, as in a MeshCoP message.
+ *
+ */
+uint16_t WriteTlvs(std::vector<uint8_t> &aBuffer, int64_t aCount)
+{
+    const uint8_t   value[4] = {0x01, 0x02, 0x03, 0x04};
+    otbr::TlvWriter writer(aBuffer.data(), static_cast<uint16_t>(aBuffer.size()));
+
+    for (int64_t i = 0; i < aCount; ++i)
+    {
+        writer.Append(static_cast<uint8_t>(i), value, sizeof(value));
+    }
+
+    return writer.GetLength();
+}
+
+void TlvViewWalk(State &aState)
+{
+    std::vector<uint8_t> buffer(aState.GetArg() * 6);
+    uint16_t             length = WriteTlvs(buffer, aState.GetArg());
+
+    while (aState.KeepRunning())
+    {
+        otbr::TlvView view(buffer.data(), length);
+        unsigned      sum = 0;
+
+        for (const otbr::Tlv &tlv : view)
+        {
+            sum += tlv.GetType();
+        }
+
+        DoNotOptimize(sum);
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations() * aState.GetArg());
+}
+
+void TlvViewFind(State &aState)
+{
+    std::vector<uint8_t> buffer(aState.GetArg() * 6);
+    uint16_t             length = WriteTlvs(buffer, aState.GetArg());
+    otbr::TlvView        view(buffer.data(), length);
+
+    // The last Tlv is the worst case of a linear search.
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(view.Find(static_cast<uint8_t>(aState.GetArg() - 1)));
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void TlvIndexFind(State &aState)
+{
+    std::vector<uint8_t> buffer(aState.GetArg() * 6);
+    uint16_t             length = WriteTlvs(buffer, aState.GetArg());
+    otbr::TlvView        view(buffer.data(), length);
+    otbr::TlvIndex       index(view);
+
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(index.Find(static_cast<uint8_t>(aState.GetArg() - 1)));
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void LogFiltered(State &aState)
+{
+    otbrLogInit("otbr-bench", OTBR_LOG_ERR, false);
+
+    while (aState.KeepRunning())
+    {
+        otbrLog(OTBR_LOG_WARNING, "filtered log %d", 1);
+    }
+
+    otbrLogDeinit();
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void LogToFile(State &aState)
+{
+    // The private log file is written by a background thread, this measures the cost on the logging thread.
+    otbrLogInit("otbr-bench", OTBR_LOG_ERR, false);
+    otbrLogEnableSyslog(false);
+    otbrLogSetFilename("/dev/null");
+
+    while (aState.KeepRunning())
+    {
+        otbrLog(OTBR_LOG_WARNING, "log to file %d %s", 1, "value");
+    }
+
+    otbrLogDeinit();
+    otbrLogEnableSyslog(true);
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+} // namespace
+
+OTBR_BENCHMARK_ARGS(TlvViewWalk, 4, 32, 255);
+OTBR_BENCHMARK_ARGS(TlvViewFind, 4, 32, 255);
+OTBR_BENCHMARK_ARGS(TlvIndexFind, 4, 32, 255);
+OTBR_BENCHMARK(LogFiltered);
+OTBR_BENCHMARK(LogToFile);
@@ -0,0 +1,127 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes benchmarks of the D-Bus message encoding and decoding.
+ */
+
+#include <vector>
+
+#include "benchmark.hpp"
+#include "common/code_utils.hpp"
+#include "dbus/common/dbus_message_helper.hpp"
+
+using otbr::Benchmark::DoNotOptimize;
+using otbr::Benchmark::State;
+using otbr::DBus::ChildInfo;
+using otbr::DBus::DBusMessageToTuple;
+using otbr::DBus::TupleToDBusMessage;
+
+namespace {
+
+std::vector<ChildInfo> MakeChildTable(int64_t aCount)
+{
+    std::vector<ChildInfo> children(aCount);
+
+    for (int64_t i = 0; i < aCount; ++i)
+    {
+        ChildInfo &child = children[i];
+
+        child.mExtAddress         = 0x1122334455667700ull + i;
+        child.mTimeout            = 240;
+        child.mAge                = static_cast<uint32_t>(i);
+        child.mRloc16             = static_cast<uint16_t>(0x0401 + i);
+        child.mChildId            = static_cast<uint16_t>(i + 1);
+        child.mNetworkDataVersion = 3;
+        child.mLinkQualityIn      = 3;
+        child.mAverageRssi        = -40;
+        child.mLastRssi           = -42;
+        child.mFrameErrorRate     = 0;
+        child.mMessageErrorRate   = 0;
+        child.mRxOnWhenIdle       = (i % 2 == 0);
+        child.mSecureDataRequest  = true;
+        child.mFullThreadDevice   = (i % 2 == 0);
+        child.mFullNetworkData    = true;
+        child.mIsStateRestoring   = false;
+    }
+
+    return children;
+}
+
+void DBusEncodeChildTable(State &aState)
+{
+    auto      children = std::make_tuple(MakeChildTable(aState.GetArg()));
+    otbrError error;
+
+    while (aState.KeepRunning())
+    {
+        DBusMessage *message = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+
+        VerifyOrExit(message != NULL, aState.SetError("failed to create the message"));
+        error = TupleToDBusMessage(*message, children);
+        dbus_message_unref(message);
+        VerifyOrExit(error == OTBR_ERROR_NONE, aState.SetError("failed to encode the child table"));
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations() * aState.GetArg());
+
+exit:
+    return;
+}
+
+void DBusDecodeChildTable(State &aState)
+{
+    DBusMessage *                      message = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    std::tuple<std::vector<ChildInfo>> children;
+
+    VerifyOrExit(message != NULL, aState.SetError("failed to create the message"));
+    VerifyOrExit(TupleToDBusMessage(*message, std::make_tuple(MakeChildTable(aState.GetArg()))) == OTBR_ERROR_NONE,
+                 aState.SetError("failed to encode the child table"));
+
+    // Decode into the same table, as a client polling the child table does.
+    while (aState.KeepRunning())
+    {
+        VerifyOrExit(DBusMessageToTuple(*message, children) == OTBR_ERROR_NONE,
+                     aState.SetError("failed to decode the child table"));
+        DoNotOptimize(std::get<0>(children).data());
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations() * aState.GetArg());
+
+exit:
+    if (message != NULL)
+    {
+        dbus_message_unref(message);
+    }
+}
+
+} // namespace
+
+OTBR_BENCHMARK_ARGS(DBusEncodeChildTable, 1, 32, 511);
+OTBR_BENCHMARK_ARGS(DBusDecodeChildTable, 1, 32, 511);
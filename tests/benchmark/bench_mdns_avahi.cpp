@@ -0,0 +1,115 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes benchmarks of the avahi poller.
+ */
+
+#include <vector>
+
+#include <sys/select.h>
+#include <unistd.h>
+
+#include "benchmark.hpp"
+#include "common/code_utils.hpp"
+#include "mdns/mdns_avahi.hpp"
+
+using otbr::Benchmark::DoNotOptimize;
+using otbr::Benchmark::State;
+
+namespace {
+
+void HandleWatch(AvahiWatch *aWatch, int aFd, AvahiWatchEvent aEvent, void *aContext)
+{
+    (void)aWatch;
+    (void)aFd;
+    (void)aEvent;
+
+    ++*static_cast<uint64_t *>(aContext);
+}
+
+/**
+ * This benchmark runs one mainloop round of the poller with N watches, all of which are reported readable.
+ *
+ * The file descriptor sets are not passed to select(), so only the bookkeeping of the poller is measured.
+ *
+ */
+void AvahiPollerMainloop(State &aState)
+{
+    otbr::Mdns::Poller        poller;
+    const AvahiPoll *         avahiPoll = poller.GetAvahiPoll();
+    std::vector<int>          fds;
+    std::vector<AvahiWatch *> watches;
+    uint64_t                  dispatched = 0;
+
+    for (int64_t i = 0; i < aState.GetArg(); ++i)
+    {
+        int pipeFds[2];
+
+        VerifyOrExit(pipe(pipeFds) == 0, aState.SetError("failed to create pipes"));
+        fds.push_back(pipeFds[0]);
+        fds.push_back(pipeFds[1]);
+        VerifyOrExit(pipeFds[0] < FD_SETSIZE, aState.SetError("too many file descriptors"));
+        watches.push_back(avahiPoll->watch_new(avahiPoll, pipeFds[0], AVAHI_WATCH_IN, HandleWatch, &dispatched));
+    }
+
+    while (aState.KeepRunning())
+    {
+        fd_set  readFdSet;
+        fd_set  writeFdSet;
+        fd_set  errorFdSet;
+        int     maxFd   = -1;
+        timeval timeout = {10, 0};
+
+        FD_ZERO(&readFdSet);
+        FD_ZERO(&writeFdSet);
+        FD_ZERO(&errorFdSet);
+
+        poller.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+        poller.Process(readFdSet, writeFdSet, errorFdSet);
+    }
+
+    DoNotOptimize(dispatched);
+    aState.SetItemsProcessed(aState.GetIterations() * aState.GetArg());
+
+exit:
+    for (AvahiWatch *watch : watches)
+    {
+        avahiPoll->watch_free(watch);
+    }
+
+    for (int fd : fds)
+    {
+        close(fd);
+    }
+}
+
+} // namespace
+
+OTBR_BENCHMARK_ARGS(AvahiPollerMainloop, 1, 16, 256);
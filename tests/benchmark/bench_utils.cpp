@@ -0,0 +1,234 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes benchmarks of the utilities.
+ */
+
+#include <vector>
+
+#include <string.h>
+
+#include "benchmark.hpp"
+#include "utils/crc16.hpp"
+#include "utils/event_emitter.hpp"
+#include "utils/hex.hpp"
+#include "utils/pskc.hpp"
+#include "utils/steering_data.hpp"
+
+using otbr::Benchmark::DoNotOptimize;
+using otbr::Benchmark::State;
+
+namespace {
+
+const uint8_t kExtPanId[OT_EXTENDED_PAN_ID_LENGTH] = {0x39, 0x75, 0x8e, 0xc8, 0x14, 0x4b, 0x07, 0xfb};
+const char    kNetworkName[]                       = "OpenThread";
+
+void FillPattern(std::vector<uint8_t> &aBytes)
+{
+    for (size_t i = 0; i < aBytes.size(); ++i)
+    {
+        aBytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+}
+
+void PskcCached(State &aState)
+{
+    otbr::Psk::Pskc pskc;
+
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(pskc.ComputePskc(kExtPanId, kNetworkName, "123456"));
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void PskcUncached(State &aState)
+{
+    // Cycle through more passphrases than the cache holds, so that every computation misses.
+    const char *    passphrases[] = {"passphrase0", "passphrase1", "passphrase2", "passphrase3", "passphrase4"};
+    const size_t    count         = sizeof(passphrases) / sizeof(passphrases[0]);
+    otbr::Psk::Pskc pskc;
+    size_t          i = 0;
+
+    static_assert(sizeof(passphrases) / sizeof(passphrases[0]) > OTBR_CONFIG_PSKC_CACHE_SIZE,
+                  "passphrases must outnumber the PSKc cache entries");
+
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(pskc.ComputePskc(kExtPanId, kNetworkName, passphrases[i]));
+        i = (i + 1) % count;
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void Crc16Byte(State &aState)
+{
+    std::vector<uint8_t> bytes(aState.GetArg());
+    otbr::Crc16          crc(otbr::Crc16::kCcitt);
+
+    FillPattern(bytes);
+
+    while (aState.KeepRunning())
+    {
+        crc.Init();
+
+        for (uint8_t byte : bytes)
+        {
+            crc.Update(byte);
+        }
+
+        DoNotOptimize(crc.Get());
+    }
+
+    aState.SetBytesProcessed(aState.GetIterations() * bytes.size());
+}
+
+void Crc16Buffer(State &aState)
+{
+    std::vector<uint8_t> bytes(aState.GetArg());
+    otbr::Crc16          crc(otbr::Crc16::kAnsi);
+
+    FillPattern(bytes);
+
+    while (aState.KeepRunning())
+    {
+        crc.Init();
+        crc.Update(bytes.data(), bytes.size());
+        DoNotOptimize(crc.Get());
+    }
+
+    aState.SetBytesProcessed(aState.GetIterations() * bytes.size());
+}
+
+void SteeringDataComputeBloomFilter(State &aState)
+{
+    uint8_t            joinerId[otbr::SteeringData::kSizeJoinerId];
+    otbr::SteeringData steeringData;
+
+    memcpy(joinerId, kExtPanId, sizeof(joinerId));
+
+    while (aState.KeepRunning())
+    {
+        steeringData.Init(otbr::SteeringData::kMaxSizeOfBloomFilter);
+        steeringData.ComputeBloomFilter(joinerId);
+        DoNotOptimize(steeringData.GetBloomFilter()[0]);
+        ++joinerId[0];
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+void SteeringDataBuilderAddJoiners(State &aState)
+{
+    std::vector<uint8_t> eui64s(aState.GetArg() * otbr::SteeringData::kSizeJoinerId);
+
+    FillPattern(eui64s);
+
+    while (aState.KeepRunning())
+    {
+        otbr::SteeringDataBuilder builder;
+
+        builder.AddJoiners(eui64s.data(), aState.GetArg());
+        DoNotOptimize(builder.GetSteeringData().GetBloomFilter()[0]);
+    }
+
+    aState.SetItemsProcessed(aState.GetIterations() * aState.GetArg());
+}
+
+void Bytes2Hex(State &aState)
+{
+    std::vector<uint8_t> bytes(aState.GetArg());
+    std::vector<char>    hex(bytes.size() * 2 + 1);
+
+    FillPattern(bytes);
+
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(otbr::Utils::Bytes2Hex(bytes.data(), bytes.size(), hex.data(), hex.size()));
+    }
+
+    aState.SetBytesProcessed(aState.GetIterations() * bytes.size());
+}
+
+void Hex2Bytes(State &aState)
+{
+    std::vector<uint8_t> bytes(aState.GetArg());
+    std::vector<char>    hex(bytes.size() * 2 + 1);
+
+    FillPattern(bytes);
+    otbr::Utils::Bytes2Hex(bytes.data(), bytes.size(), hex.data(), hex.size());
+
+    while (aState.KeepRunning())
+    {
+        DoNotOptimize(otbr::Utils::Hex2Bytes(hex.data(), bytes.size() * 2, bytes.data(), bytes.size()));
+    }
+
+    aState.SetBytesProcessed(aState.GetIterations() * bytes.size());
+}
+
+typedef otbr::EventEmitter<otbr::Event<int>> BenchmarkEmitter;
+
+void HandleValueEvent(void *aContext, int aValue)
+{
+    *static_cast<int *>(aContext) += aValue;
+}
+
+void EventEmitterEmit(State &aState)
+{
+    BenchmarkEmitter emitter;
+    int              sums[BenchmarkEmitter::EventType<0>::kMaxHandlers] = {0};
+
+    for (int64_t i = 0; i < aState.GetArg(); ++i)
+    {
+        emitter.On<0>(HandleValueEvent, &sums[i]);
+    }
+
+    while (aState.KeepRunning())
+    {
+        emitter.Emit<0>(1);
+    }
+
+    DoNotOptimize(sums);
+    aState.SetItemsProcessed(aState.GetIterations());
+}
+
+} // namespace
+
+OTBR_BENCHMARK(PskcCached);
+OTBR_BENCHMARK(PskcUncached);
+OTBR_BENCHMARK_ARGS(Crc16Byte, 16, 256, 4096);
+OTBR_BENCHMARK_ARGS(Crc16Buffer, 16, 256, 4096);
+OTBR_BENCHMARK(SteeringDataComputeBloomFilter);
+OTBR_BENCHMARK_ARGS(SteeringDataBuilderAddJoiners, 1, 32, 512);
+OTBR_BENCHMARK_ARGS(Bytes2Hex, 8, 64, 1024);
+OTBR_BENCHMARK_ARGS(Hex2Bytes, 8, 64, 1024);
+OTBR_BENCHMARK_ARGS(EventEmitterEmit, 1, 2, 4);
@@ -0,0 +1,425 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the benchmark harness of otbr hot paths.
+ *
+ *   The command line flags and the JSON report follow Google Benchmark, so that its tools, e.g. compare.py, can
+ *   track regressions between two reports.
+ */
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace otbr {
+namespace Benchmark {
+
+namespace {
+
+const uint64_t kMaxIterations = 1000000000;
+const double   kDefaultMinTime = 0.5;
+
+struct Entry
+{
+    std::string mName;
+    Function    mFunction;
+    int64_t     mArg;
+};
+
+struct Result
+{
+    std::string mName;
+    uint64_t    mIterations;
+    double      mRealTime; ///< Nanoseconds per iteration.
+    double      mCpuTime;  ///< Nanoseconds per iteration.
+    double      mBytesPerSecond;
+    double      mItemsPerSecond;
+    std::string mError;
+};
+
+std::vector<Entry> &GetEntries(void)
+{
+    static std::vector<Entry> sEntries;
+
+    return sEntries;
+}
+
+double GetSeconds(clockid_t aClock)
+{
+    timespec now;
+
+    clock_gettime(aClock, &now);
+
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void PrintJsonString(FILE *aFile, const std::string &aString)
+{
+    fputc('"', aFile);
+
+    for (char c : aString)
+    {
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', aFile);
+        }
+
+        fputc(c, aFile);
+    }
+
+    fputc('"', aFile);
+}
+
+void PrintJson(FILE *aFile, const char *aExecutable, const std::vector<Result> &aResults)
+{
+    char   date[32];
+    char   hostName[64] = "";
+    time_t now          = time(NULL);
+
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    gethostname(hostName, sizeof(hostName) - 1);
+
+    fprintf(aFile, "{\n  \"context\": {\n    \"date\": ");
+    PrintJsonString(aFile, date);
+    fprintf(aFile, ",\n    \"host_name\": ");
+    PrintJsonString(aFile, hostName);
+    fprintf(aFile, ",\n    \"executable\": ");
+    PrintJsonString(aFile, aExecutable);
+    fprintf(aFile, ",\n    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+#ifdef NDEBUG
+    fprintf(aFile, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+    fprintf(aFile, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+    fprintf(aFile, "  \"benchmarks\": [");
+
+    for (size_t i = 0; i < aResults.size(); ++i)
+    {
+        const Result &result = aResults[i];
+
+        fprintf(aFile, "%s\n    {\n      \"name\": ", i == 0 ? "" : ",");
+        PrintJsonString(aFile, result.mName);
+        fprintf(aFile, ",\n      \"run_name\": ");
+        PrintJsonString(aFile, result.mName);
+        fprintf(aFile, ",\n      \"run_type\": \"iteration\",\n");
+
+        if (!result.mError.empty())
+        {
+            fprintf(aFile, "      \"error_occurred\": true,\n      \"error_message\": ");
+            PrintJsonString(aFile, result.mError);
+            fprintf(aFile, "\n    }");
+            continue;
+        }
+
+        fprintf(aFile, "      \"iterations\": %" PRIu64 ",\n", result.mIterations);
+        fprintf(aFile, "      \"real_time\": %.6e,\n", result.mRealTime);
+        fprintf(aFile, "      \"cpu_time\": %.6e,\n", result.mCpuTime);
+        fprintf(aFile, "      \"time_unit\": \"ns\"");
+
+        if (result.mBytesPerSecond > 0)
+        {
+            fprintf(aFile, ",\n      \"bytes_per_second\": %.6e", result.mBytesPerSecond);
+        }
+
+        if (result.mItemsPerSecond > 0)
+        {
+            fprintf(aFile, ",\n      \"items_per_second\": %.6e", result.mItemsPerSecond);
+        }
+
+        fprintf(aFile, "\n    }");
+    }
+
+    fprintf(aFile, "\n  ]\n}\n");
+}
+
+void PrintConsoleHeader(void)
+{
+    printf("%-40s %15s %15s %12s %s\n", "Benchmark", "Time", "CPU", "Iterations", "UserCounters...");
+    printf("%s\n", std::string(100, '-').c_str());
+}
+
+void PrintConsole(const Result &aResult)
+{
+    if (!aResult.mError.empty())
+    {
+        printf("%-40s ERROR OCCURRED: '%s'\n", aResult.mName.c_str(), aResult.mError.c_str());
+        return;
+    }
+
+    printf("%-40s %12.0f ns %12.0f ns %12" PRIu64, aResult.mName.c_str(), aResult.mRealTime, aResult.mCpuTime,
+           aResult.mIterations);
+
+    if (aResult.mBytesPerSecond > 0)
+    {
+        printf(" bytes_per_second=%.4g", aResult.mBytesPerSecond);
+    }
+
+    if (aResult.mItemsPerSecond > 0)
+    {
+        printf(" items_per_second=%.4g", aResult.mItemsPerSecond);
+    }
+
+    printf("\n");
+}
+
+const char *GetFlag(const char *aArg, const char *aFlag)
+{
+    size_t      length = strlen(aFlag);
+    const char *value  = NULL;
+
+    if (strncmp(aArg, aFlag, length) == 0 && aArg[length] == '=')
+    {
+        value = &aArg[length + 1];
+    }
+
+    return value;
+}
+
+void PrintUsage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]\n"
+            "       [--benchmark_format=console|json] [--benchmark_out=<file>] [--benchmark_list_tests]\n",
+            aProgram);
+}
+
+} // namespace
+
+/**
+ * This class runs a benchmark until its runs last long enough to be measured.
+ *
+ */
+class Runner
+{
+public:
+    static Result Run(const Entry &aEntry, double aMinTime);
+};
+
+State::State(uint64_t aIterations, int64_t aArg)
+    : mIterations(aIterations)
+    , mRemaining(aIterations)
+    , mArg(aArg)
+    , mBytesProcessed(0)
+    , mItemsProcessed(0)
+    , mError(NULL)
+    , mRealStart(0)
+    , mCpuStart(0)
+    , mRealTime(0)
+    , mCpuTime(0)
+{
+}
+
+void State::StartTimer(void)
+{
+    mRealStart = GetSeconds(CLOCK_MONOTONIC);
+    mCpuStart  = GetSeconds(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+void State::StopTimer(void)
+{
+    mRealTime = GetSeconds(CLOCK_MONOTONIC) - mRealStart;
+    mCpuTime  = GetSeconds(CLOCK_PROCESS_CPUTIME_ID) - mCpuStart;
+}
+
+Registrar::Registrar(const char *aName, Function aFunction)
+{
+    GetEntries().push_back({aName, aFunction, 0});
+}
+
+Registrar::Registrar(const char *aName, Function aFunction, const int64_t *aArgs, unsigned aNumArgs)
+{
+    for (unsigned i = 0; i < aNumArgs; ++i)
+    {
+        GetEntries().push_back({std::string(aName) + "/" + std::to_string(aArgs[i]), aFunction, aArgs[i]});
+    }
+}
+
+Result Runner::Run(const Entry &aEntry, double aMinTime)
+{
+    uint64_t iterations = 1;
+    Result   result;
+
+    result.mName = aEntry.mName;
+
+    // Grow the number of iterations as Google Benchmark does, until a run lasts at least the minimum time.
+    while (true)
+    {
+        State state(iterations, aEntry.mArg);
+
+        aEntry.mFunction(state);
+
+        if (state.mError != NULL)
+        {
+            result.mError = state.mError;
+            break;
+        }
+
+        if (state.mRealTime >= aMinTime || iterations >= kMaxIterations)
+        {
+            result.mIterations     = iterations;
+            result.mRealTime       = state.mRealTime * 1e9 / iterations;
+            result.mCpuTime        = state.mCpuTime * 1e9 / iterations;
+            result.mBytesPerSecond = state.mRealTime > 0 ? state.mBytesProcessed / state.mRealTime : 0;
+            result.mItemsPerSecond = state.mRealTime > 0 ? state.mItemsProcessed / state.mRealTime : 0;
+            break;
+        }
+
+        {
+            double multiplier = aMinTime * 1.4 / std::max(state.mRealTime, 1e-9);
+
+            if (state.mRealTime / aMinTime <= 0.1)
+            {
+                multiplier = std::min(multiplier, 10.0);
+            }
+
+            if (multiplier <= 1.0)
+            {
+                multiplier = 2.0;
+            }
+
+            iterations = std::min(kMaxIterations, std::max(static_cast<uint64_t>(iterations * multiplier),
+                                                          iterations + 1));
+        }
+    }
+
+    return result;
+}
+
+} // namespace Benchmark
+} // namespace otbr
+
+int main(int argc, char *argv[])
+{
+    using otbr::Benchmark::Entry;
+    using otbr::Benchmark::Result;
+
+    std::regex          filter(".*");
+    double              minTime  = otbr::Benchmark::kDefaultMinTime;
+    bool                json     = false;
+    bool                list     = false;
+    const char *        fileName = NULL;
+    std::vector<Result> results;
+    int                 ret = EXIT_SUCCESS;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+
+        if ((value = otbr::Benchmark::GetFlag(argv[i], "--benchmark_filter")) != NULL)
+        {
+            filter = std::regex(value);
+        }
+        else if ((value = otbr::Benchmark::GetFlag(argv[i], "--benchmark_min_time")) != NULL)
+        {
+            minTime = strtod(value, NULL);
+        }
+        else if ((value = otbr::Benchmark::GetFlag(argv[i], "--benchmark_format")) != NULL &&
+                 (strcmp(value, "json") == 0 || strcmp(value, "console") == 0))
+        {
+            json = (strcmp(value, "json") == 0);
+        }
+        else if ((value = otbr::Benchmark::GetFlag(argv[i], "--benchmark_out")) != NULL)
+        {
+            fileName = value;
+        }
+        else if (strcmp(argv[i], "--benchmark_list_tests") == 0)
+        {
+            list = true;
+        }
+        else
+        {
+            otbr::Benchmark::PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!json && !list)
+    {
+        otbr::Benchmark::PrintConsoleHeader();
+    }
+
+    for (const Entry &entry : otbr::Benchmark::GetEntries())
+    {
+        if (!std::regex_search(entry.mName, filter))
+        {
+            continue;
+        }
+
+        if (list)
+        {
+            printf("%s\n", entry.mName.c_str());
+            continue;
+        }
+
+        results.push_back(otbr::Benchmark::Runner::Run(entry, minTime));
+
+        if (!results.back().mError.empty())
+        {
+            ret = EXIT_FAILURE;
+        }
+
+        if (!json)
+        {
+            otbr::Benchmark::PrintConsole(results.back());
+            fflush(stdout);
+        }
+    }
+
+    if (json)
+    {
+        otbr::Benchmark::PrintJson(stdout, argv[0], results);
+    }
+
+    if (fileName != NULL)
+    {
+        FILE *file = fopen(fileName, "w");
+
+        if (file == NULL)
+        {
+            perror(fileName);
+            return EXIT_FAILURE;
+        }
+
+        otbr::Benchmark::PrintJson(file, argv[0], results);
+        fclose(file);
+    }
+
+    return ret;
+}
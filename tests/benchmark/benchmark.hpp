@@ -0,0 +1,217 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the benchmark harness of otbr hot paths.
+ */
+
+#ifndef OTBR_TESTS_BENCHMARK_BENCHMARK_HPP_
+#define OTBR_TESTS_BENCHMARK_BENCHMARK_HPP_
+
+#include <stdint.h>
+
+namespace otbr {
+namespace Benchmark {
+
+/**
+ * This class carries the state of one benchmark run.
+ *
+ * Only the iterations of the KeepRunning() loop are timed, setup before the loop and teardown after it are not.
+ *
+ */
+class State
+{
+public:
+    /**
+     * This constructor initializes a run.
+     *
+     * @param[in]  aIterations  The number of iterations to run, at least one.
+     * @param[in]  aArg         The argument of the run.
+     *
+     */
+    State(uint64_t aIterations, int64_t aArg);
+
+    /**
+     * This method indicates whether to run one more iteration.
+     *
+     * The timer starts at the first call and stops at the call that ends the loop.
+     *
+     * @returns Whether to run one more iteration.
+     *
+     */
+    bool KeepRunning(void)
+    {
+        if (mRemaining == mIterations)
+        {
+            StartTimer();
+        }
+
+        if (mRemaining == 0)
+        {
+            StopTimer();
+            return false;
+        }
+
+        --mRemaining;
+        return true;
+    }
+
+    /**
+     * This method returns the argument of the run.
+     *
+     */
+    int64_t GetArg(void) const { return mArg; }
+
+    /**
+     * This method returns the number of iterations of the run.
+     *
+     */
+    uint64_t GetIterations(void) const { return mIterations; }
+
+    /**
+     * This method sets the number of bytes processed by the whole run.
+     *
+     * @param[in]  aBytes  The number of bytes.
+     *
+     */
+    void SetBytesProcessed(uint64_t aBytes) { mBytesProcessed = aBytes; }
+
+    /**
+     * This method sets the number of items processed by the whole run.
+     *
+     * @param[in]  aItems  The number of items.
+     *
+     */
+    void SetItemsProcessed(uint64_t aItems) { mItemsProcessed = aItems; }
+
+    /**
+     * This method marks the run as failed, the run is then reported with @p aMessage instead of its timings.
+     *
+     * @param[in]  aMessage  The reason of the failure.
+     *
+     */
+    void SetError(const char *aMessage) { mError = aMessage; }
+
+private:
+    friend class Runner;
+
+    void StartTimer(void);
+    void StopTimer(void);
+
+    uint64_t    mIterations;
+    uint64_t    mRemaining;
+    int64_t     mArg;
+    uint64_t    mBytesProcessed;
+    uint64_t    mItemsProcessed;
+    const char *mError;
+    double      mRealStart;
+    double      mCpuStart;
+    double      mRealTime; ///< Seconds.
+    double      mCpuTime;  ///< Seconds.
+};
+
+/**
+ * This function pointer is called to run a benchmark.
+ *
+ * @param[in]  aState  The state of the run.
+ *
+ */
+typedef void (*Function)(State &aState);
+
+/**
+ * This class registers a benchmark at static initialization.
+ *
+ */
+class Registrar
+{
+public:
+    /**
+     * This constructor registers a benchmark without argument.
+     *
+     * @param[in]  aName      The name of the benchmark.
+     * @param[in]  aFunction  The function that runs the benchmark.
+     *
+     */
+    Registrar(const char *aName, Function aFunction);
+
+    /**
+     * This constructor registers a benchmark once for each of its arguments.
+     *
+     * Each run is named after the benchmark and its argument, e.g. "Crc16Buffer/256".
+     *
+     * @param[in]  aName      The name of the benchmark.
+     * @param[in]  aFunction  The function that runs the benchmark.
+     * @param[in]  aArgs      A pointer to the arguments.
+     * @param[in]  aNumArgs   The number of arguments.
+     *
+     */
+    Registrar(const char *aName, Function aFunction, const int64_t *aArgs, unsigned aNumArgs);
+};
+
+/**
+ * This function keeps the compiler from optimizing away the computation of @p aValue.
+ *
+ * @param[in]  aValue  The value.
+ *
+ */
+template <typename T> inline void DoNotOptimize(const T &aValue)
+{
+    asm volatile("" : : "r,m"(aValue) : "memory");
+}
+
+/**
+ * This function keeps the compiler from assuming memory is unchanged across this point.
+ *
+ */
+inline void ClobberMemory(void)
+{
+    asm volatile("" : : : "memory");
+}
+
+} // namespace Benchmark
+} // namespace otbr
+
+/**
+ * This macro registers @p aFunction as a benchmark named after it.
+ *
+ */
+#define OTBR_BENCHMARK(aFunction) \
+    static ::otbr::Benchmark::Registrar sBenchmarkRegistrar##aFunction(#aFunction, aFunction)
+
+/**
+ * This macro registers @p aFunction as a benchmark run once for each of the arguments that follow.
+ *
+ */
+#define OTBR_BENCHMARK_ARGS(aFunction, ...)                                          \
+    static const int64_t                sBenchmarkArgs##aFunction[] = {__VA_ARGS__}; \
+    static ::otbr::Benchmark::Registrar sBenchmarkRegistrar##aFunction(              \
+        #aFunction, aFunction, sBenchmarkArgs##aFunction,                            \
+        sizeof(sBenchmarkArgs##aFunction) / sizeof(sBenchmarkArgs##aFunction[0]))
+
+#endif // OTBR_TESTS_BENCHMARK_BENCHMARK_HPP_
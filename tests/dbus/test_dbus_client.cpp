@@ -30,6 +30,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
 
 #include <dbus/dbus.h>
@@ -43,7 +45,10 @@ using otbr::DBus::DeviceRole;
 using otbr::DBus::ExternalRoute;
 using otbr::DBus::Ip6Prefix;
 using otbr::DBus::LinkModeConfig;
+using otbr::DBus::NetworkDataInfo;
 using otbr::DBus::OnMeshPrefix;
+using otbr::DBus::PropertyUpdates;
+using otbr::DBus::PropertyValues;
 using otbr::DBus::ThreadApiDBus;
 
 struct DBusConnectionDeleter
@@ -65,6 +70,7 @@ static void CheckExternalRoute(ThreadApiDBus *aApi, const Ip6Prefix &aPrefix)
 {
     ExternalRoute              route;
     std::vector<ExternalRoute> externalRouteTable;
+    NetworkDataInfo            networkData;
 
     route.mPrefix     = aPrefix;
     route.mStable     = true;
@@ -77,9 +83,39 @@ static void CheckExternalRoute(ThreadApiDBus *aApi, const Ip6Prefix &aPrefix)
     assert(externalRouteTable[0].mPreference == 0);
     assert(externalRouteTable[0].mStable);
     assert(externalRouteTable[0].mNextHopIsThisDevice);
+    assert(aApi->GetNetworkDataInfo(networkData) == OTBR_ERROR_NONE);
+    assert(networkData.mExternalRoutes.size() == 1);
+    assert(networkData.mExternalRoutes[0].mPrefix == aPrefix);
+    assert(networkData.mExternalRoutes[0].mStable);
+    assert(networkData.mExternalRoutes[0].mNextHopIsThisDevice);
     assert(aApi->RemoveExternalRoute(aPrefix) == OTBR_ERROR_NONE);
 }
 
+static void CheckBorderRouterConfig(ThreadApiDBus *aApi, const OnMeshPrefix &aOnMeshPrefix)
+{
+    ExternalRoute              route;
+    std::vector<ExternalRoute> externalRouteTable;
+
+    route.mPrefix     = aOnMeshPrefix.mPrefix;
+    route.mStable     = true;
+    route.mPreference = 0;
+
+    assert(aApi->UpdateBorderRouterConfig({aOnMeshPrefix}, {}, {route}, {}) == OTBR_ERROR_NONE);
+    assert(aApi->GetExternalRoutes(externalRouteTable) == OTBR_ERROR_NONE);
+    assert(externalRouteTable.size() == 1);
+    assert(externalRouteTable[0].mPrefix == aOnMeshPrefix.mPrefix);
+    // Invalid prefix length aborts the whole batch and keeps the route.
+    route.mPrefix.mLength = 129;
+    assert(aApi->UpdateBorderRouterConfig({}, {aOnMeshPrefix.mPrefix}, {route}, {aOnMeshPrefix.mPrefix}) !=
+           OTBR_ERROR_NONE);
+    assert(aApi->GetExternalRoutes(externalRouteTable) == OTBR_ERROR_NONE);
+    assert(externalRouteTable.size() == 1);
+    assert(aApi->UpdateBorderRouterConfig({}, {aOnMeshPrefix.mPrefix}, {}, {aOnMeshPrefix.mPrefix}) ==
+           OTBR_ERROR_NONE);
+    assert(aApi->GetExternalRoutes(externalRouteTable) == OTBR_ERROR_NONE);
+    assert(externalRouteTable.empty());
+}
+
 int main()
 {
     DBusError                      error;
@@ -95,6 +131,7 @@ int main()
     VerifyOrExit(dbus_bus_register(connection.get(), &error) == true);
 
     api = std::unique_ptr<ThreadApiDBus>(new ThreadApiDBus(connection.get()));
+    VerifyOrExit(api->AttachMainloop() == ClientError::ERROR_NONE);
 
     api->AddDeviceRoleHandler(
         [](DeviceRole aRole) { printf("Device role changed to %d\n", static_cast<uint8_t>(aRole)); });
@@ -112,28 +149,46 @@ int main()
         printf("LinkMode %d %d %d %d\n", cfg.mRxOnWhenIdle, cfg.mSecureDataRequests, cfg.mDeviceType, cfg.mNetworkData);
 
         cfg.mDeviceType = true;
-        api->SetLinkMode(cfg);
+        {
+            PropertyUpdates                    updates;
+            std::map<std::string, ClientError> results;
+
+            updates.Set(OTBR_DBUS_PROPERTY_LINK_MODE, cfg);
+            assert(api->SetProperties(updates, results) == ClientError::ERROR_NONE);
+            assert(results[OTBR_DBUS_PROPERTY_LINK_MODE] == ClientError::ERROR_NONE);
+        }
 
         api->Attach("Test", 0x3456, extpanid, {}, {}, UINT32_MAX, [&api, extpanid](ClientError aError) {
             printf("Attach result %d\n", static_cast<int>(aError));
             uint64_t extpanidCheck;
             if (aError == OTBR_ERROR_NONE)
             {
-                std::string                           name;
-                uint64_t                              extAddress = 0;
-                uint16_t                              rloc16     = 0xffff;
-                uint8_t                               routerId;
-                std::vector<uint8_t>                  networkData;
-                std::vector<uint8_t>                  stableNetworkData;
-                otbr::DBus::LeaderData                leaderData;
-                uint8_t                               leaderWeight;
-                int8_t                                rssi;
-                int8_t                                txPower;
-                std::vector<otbr::DBus::ChildInfo>    childTable;
-                std::vector<otbr::DBus::NeighborInfo> neighborTable;
-                uint32_t                              partitionId;
-                Ip6Prefix                             prefix;
-                OnMeshPrefix                          onMeshPrefix = {};
+                std::string                                name;
+                std::string                                cachedName;
+                uint64_t                                   extAddress = 0;
+                uint16_t                                   rloc16     = 0xffff;
+                uint8_t                                    routerId;
+                std::vector<uint8_t>                       networkData;
+                std::vector<uint8_t>                       stableNetworkData;
+                otbr::DBus::LeaderData                     leaderData;
+                uint8_t                                    leaderWeight;
+                int8_t                                     rssi;
+                int8_t                                     txPower;
+                std::vector<otbr::DBus::ChildInfo>         childTable;
+                std::vector<otbr::DBus::NeighborInfo>      neighborTable;
+                std::vector<otbr::DBus::ChannelQuality>    channelScores;
+                std::vector<otbr::DBus::CounterRates>      counterRates;
+                std::vector<otbr::DBus::TopologyNode>      topology;
+                uint32_t                                   partitionId;
+                Ip6Prefix                                  prefix;
+                OnMeshPrefix                               onMeshPrefix = {};
+                PropertyValues                             values;
+                std::array<uint8_t, OTBR_IP6_PREFIX_SIZE>  meshLocalPrefix;
+                std::array<uint8_t, OTBR_IP6_ADDRESS_SIZE> meshLocalEid;
+                uint64_t                                   eui64;
+                std::string                                version;
+                uint16_t                                   batchRloc16      = 0xffff;
+                uint32_t                                   batchPartitionId = 0;
 
                 prefix.mPrefix = {0xfd, 0xcd, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
                 prefix.mLength = 64;
@@ -153,16 +208,39 @@ int main()
                 assert(api->GetLocalLeaderWeight(leaderWeight) == OTBR_ERROR_NONE);
                 assert(api->GetChildTable(childTable) == OTBR_ERROR_NONE);
                 assert(api->GetNeighborTable(neighborTable) == OTBR_ERROR_NONE);
+                assert(api->GetChannelQualityScores(channelScores) == OTBR_ERROR_NONE);
+                assert(api->GetCounterRates(60000, counterRates) == OTBR_ERROR_NONE);
+                assert(api->GetTopology(0, topology) == OTBR_ERROR_NONE);
                 assert(api->GetPartitionId(partitionId) == OTBR_ERROR_NONE);
                 assert(api->GetInstantRssi(rssi) == OTBR_ERROR_NONE);
                 assert(api->GetRadioTxPower(txPower) == OTBR_ERROR_NONE);
+                assert(api->GetMeshLocalPrefix(meshLocalPrefix) == OTBR_ERROR_NONE);
+                assert(api->GetMeshLocalEid(meshLocalEid) == OTBR_ERROR_NONE);
+                assert(api->GetEui64(eui64) == OTBR_ERROR_NONE);
+                assert(api->GetOtHostVersion(version) == OTBR_ERROR_NONE);
+                assert(api->GetProperties({OTBR_DBUS_PROPERTY_RLOC16, OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY},
+                                          values) == ClientError::ERROR_NONE);
+                assert(values.Get(OTBR_DBUS_PROPERTY_RLOC16, batchRloc16) == ClientError::ERROR_NONE);
+                assert(values.Get(OTBR_DBUS_PROPERTY_PARTITION_ID_PROEPRTY, batchPartitionId) ==
+                       ClientError::ERROR_NONE);
+                assert(!values.Contains(OTBR_DBUS_PROPERTY_CHILD_TABLE));
                 CheckExternalRoute(api.get(), prefix);
                 assert(api->AddOnMeshPrefix(onMeshPrefix) == OTBR_ERROR_NONE);
                 assert(api->RemoveOnMeshPrefix(onMeshPrefix.mPrefix) == OTBR_ERROR_NONE);
+                CheckBorderRouterConfig(api.get(), onMeshPrefix);
+                api->SetPropertyCacheEnabled(true);
+                assert(api->GetNetworkName(cachedName) == OTBR_ERROR_NONE);
+                assert(api->GetNetworkName(cachedName) == OTBR_ERROR_NONE);
+                assert(cachedName == name);
                 api->FactoryReset(nullptr);
                 assert(api->GetNetworkName(name) == OTBR_ERROR_NONE);
+                api->SetPropertyCacheEnabled(false);
                 assert(rloc16 != 0xffff);
+                assert(batchRloc16 == rloc16);
+                assert(batchPartitionId == partitionId);
                 assert(extAddress != 0);
+                assert(std::equal(meshLocalPrefix.begin(), meshLocalPrefix.end(), meshLocalEid.begin()));
+                assert(!version.empty());
                 assert(routerId == leaderData.mLeaderRouterId);
                 assert(!networkData.empty());
                 assert(childTable.empty());
@@ -179,7 +257,21 @@ int main()
 
     while (true)
     {
-        dbus_connection_read_write_dispatch(connection.get(), 0);
+        fd_set         readFdSet, writeFdSet, errorFdSet;
+        int            maxFd   = -1;
+        struct timeval timeout = {10, 0};
+
+        FD_ZERO(&readFdSet);
+        FD_ZERO(&writeFdSet);
+        FD_ZERO(&errorFdSet);
+        api->UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+
+        if (select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout) < 0)
+        {
+            break;
+        }
+
+        api->Process(readFdSet, writeFdSet, errorFdSet);
     }
 
 exit:
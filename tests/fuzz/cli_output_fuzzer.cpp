@@ -0,0 +1,89 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a fuzz target feeding OpenThread CLI outputs to the web service parser.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+
+#include "common/logging.hpp"
+#include "web/web-service/ot_client.hpp"
+
+using otbr::Web::OpenThreadClient;
+
+extern "C" int LLVMFuzzerInitialize(int *aArgc, char ***aArgv)
+{
+    (void)aArgc;
+    (void)aArgv;
+
+    // Error lines are logged, which would dominate the throughput.
+    otbrLogInit("otbr-fuzz", OTBR_LOG_CRIT, true);
+
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *aData, size_t aSize)
+{
+    // The exact size lets the sanitizers catch any access past the bytes received, like a client buffer would.
+    std::unique_ptr<char[]> buffer(new char[aSize > 0 ? aSize : 1]);
+    size_t                  length    = 0;
+    size_t                  lineStart = 0;
+    char *                  output    = NULL;
+
+    memcpy(buffer.get(), aData, aSize);
+
+    while (length < aSize && output == NULL)
+    {
+        // The output arrives in reads of 1 to 64 bytes, so that lines are split the way a socket may split them.
+        size_t count = 1 + static_cast<uint8_t>(buffer[length]) % 64;
+
+        if (count > aSize - length)
+        {
+            count = aSize - length;
+        }
+
+        length += count;
+        if (OpenThreadClient::ParseOutput(buffer.get(), length, count, lineStart, output) != OTBR_ERROR_NONE)
+        {
+            break;
+        }
+    }
+
+    if (output != NULL && strlen(output) >= length)
+    {
+        abort();
+    }
+
+    return 0;
+}
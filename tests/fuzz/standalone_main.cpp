@@ -0,0 +1,96 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a driver running fuzz targets on files when building without libFuzzer.
+ *
+ *   The inputs are replayed so that the corpus keeps exercising the targets under any compiler, and the throughput
+ *   of the target is reported.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "common/time.hpp"
+
+extern "C" int LLVMFuzzerInitialize(int *aArgc, char ***aArgv);
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *aData, size_t aSize);
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::vector<uint8_t>> inputs;
+    unsigned long                     runs  = 1;
+    uint64_t                          bytes = 0;
+    uint64_t                          start;
+    uint64_t                          elapsed;
+
+    LLVMFuzzerInitialize(&argc, &argv);
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "-runs=", sizeof("-runs=") - 1) == 0)
+        {
+            runs = strtoul(argv[i] + sizeof("-runs=") - 1, NULL, 0);
+            continue;
+        }
+
+        std::ifstream file(argv[i], std::ios::binary);
+
+        if (!file)
+        {
+            fprintf(stderr, "Failed to open %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+
+        inputs.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    start = otbr::GetNowPrecise();
+
+    for (unsigned long run = 0; run < runs; run++)
+    {
+        for (const std::vector<uint8_t> &input : inputs)
+        {
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+            bytes += input.size();
+        }
+    }
+
+    elapsed = otbr::GetNowPrecise() - start;
+    printf("Executed %zu inputs %lu times, %llu bytes in %.3fms, %.1fMB/s\n", inputs.size(), runs,
+           static_cast<unsigned long long>(bytes), elapsed / 1000.0, elapsed > 0 ? bytes / (elapsed * 1.0) : 0.0);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,281 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the D-Bus load of the load generator.
+ */
+
+#include "load.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dbus/dbus.h>
+
+#include "common/code_utils.hpp"
+#include "dbus/client/thread_api_dbus.hpp"
+
+using otbr::DBus::ActiveScanResult;
+using otbr::DBus::ChildInfo;
+using otbr::DBus::ClientError;
+using otbr::DBus::DeviceRole;
+using otbr::DBus::OnMeshPrefix;
+using otbr::DBus::ThreadApiDBus;
+
+namespace otbr {
+namespace Load {
+
+namespace {
+
+enum RequestKind
+{
+    kRequestGet,
+    kRequestScan,
+    kRequestPrefix,
+    kNumRequestKinds,
+};
+
+const char *const kRequestKindNames[kNumRequestKinds] = {"get", "scan", "prefix"};
+
+struct ClientStats
+{
+    LatencyStats mStats[kNumRequestKinds];
+};
+
+struct DBusConnectionDeleter
+{
+    void operator()(DBusConnection *aConnection)
+    {
+        dbus_connection_close(aConnection);
+        dbus_connection_unref(aConnection);
+    }
+};
+
+using UniqueDBusConnection = std::unique_ptr<DBusConnection, DBusConnectionDeleter>;
+
+/**
+ * This function gets one of a few properties with different encodings, from a fixed integer to a table.
+ *
+ */
+ClientError GetProperty(ThreadApiDBus &aApi, unsigned aIndex)
+{
+    ClientError error;
+
+    switch (aIndex % 4)
+    {
+    case 0:
+    {
+        DeviceRole role;
+
+        error = aApi.GetDeviceRole(role);
+        break;
+    }
+    case 1:
+    {
+        uint16_t rloc16;
+
+        error = aApi.GetRloc16(rloc16);
+        break;
+    }
+    case 2:
+    {
+        std::string name;
+
+        error = aApi.GetNetworkName(name);
+        break;
+    }
+    default:
+    {
+        std::vector<ChildInfo> childTable;
+
+        error = aApi.GetChildTable(childTable);
+        break;
+    }
+    }
+
+    return error;
+}
+
+ClientError Scan(DBusConnection &aConnection, ThreadApiDBus &aApi)
+{
+    bool        done = false;
+    ClientError error;
+
+    SuccessOrExit(error = aApi.Scan([&done](const std::vector<ActiveScanResult> &) { done = true; }));
+
+    // The pending call always completes, with an error reply once the D-Bus timeout expires.
+    while (!done && dbus_connection_read_write_dispatch(&aConnection, -1))
+    {
+    }
+
+    VerifyOrExit(done, error = ClientError::ERROR_DBUS);
+
+exit:
+    return error;
+}
+
+ClientError AddAndRemovePrefix(ThreadApiDBus &aApi, unsigned aClient)
+{
+    OnMeshPrefix prefix = {};
+    ClientError  error;
+
+    // Each client owns a distinct prefix, fd00:0:0:<client>::/64.
+    prefix.mPrefix.mPrefix = {0xfd, 0x00, 0x00, 0x00, 0x00, 0x00, static_cast<uint8_t>(aClient >> 8),
+                              static_cast<uint8_t>(aClient)};
+    prefix.mPrefix.mLength = 64;
+    prefix.mPreference     = 0;
+    prefix.mStable         = true;
+    prefix.mOnMesh         = true;
+
+    SuccessOrExit(error = aApi.AddOnMeshPrefix(prefix));
+    error = aApi.RemoveOnMeshPrefix(prefix.mPrefix);
+
+exit:
+    return error;
+}
+
+void RunClient(const DBusLoadConfig &aConfig, unsigned aClient, ClientStats &aStats)
+{
+    DBusError            dbusError;
+    UniqueDBusConnection connection;
+    unsigned             seed        = aClient + 1;
+    unsigned             totalWeight = aConfig.mGetWeight + aConfig.mScanWeight + aConfig.mPrefixWeight;
+
+    dbus_error_init(&dbusError);
+
+    // A private connection per client, so that the agent sees as many peers as there are clients.
+    connection = UniqueDBusConnection(dbus_bus_get_private(DBUS_BUS_SYSTEM, &dbusError));
+
+    if (connection == nullptr)
+    {
+        fprintf(stderr, "Client %u failed to connect to the system bus: %s\n", aClient, dbusError.message);
+        dbus_error_free(&dbusError);
+        aStats.mStats[kRequestGet].AddError();
+        ExitNow();
+    }
+
+    dbus_connection_set_exit_on_disconnect(connection.get(), false);
+
+    {
+        ThreadApiDBus api(connection.get(), aConfig.mInterfaceName);
+
+        for (unsigned i = 0; i < aConfig.mRequests; ++i)
+        {
+            unsigned    pick  = static_cast<unsigned>(rand_r(&seed)) % totalWeight;
+            uint64_t    start = GetMicroseconds();
+            RequestKind kind;
+            ClientError error;
+
+            if (pick < aConfig.mGetWeight)
+            {
+                kind  = kRequestGet;
+                error = GetProperty(api, i);
+            }
+            else if (pick < aConfig.mGetWeight + aConfig.mScanWeight)
+            {
+                kind  = kRequestScan;
+                error = Scan(*connection, api);
+            }
+            else
+            {
+                kind  = kRequestPrefix;
+                error = AddAndRemovePrefix(api, aClient);
+            }
+
+            if (error == ClientError::ERROR_NONE)
+            {
+                aStats.mStats[kind].Add(GetMicroseconds() - start);
+            }
+            else
+            {
+                aStats.mStats[kind].AddError();
+            }
+        }
+    }
+
+exit:
+    return;
+}
+
+} // namespace
+
+int RunDBusLoad(const DBusLoadConfig &aConfig)
+{
+    std::vector<ClientStats> clientStats(aConfig.mClients);
+    std::vector<std::thread> clients;
+    LatencyStats             total;
+    uint64_t                 start;
+    uint64_t                 elapsed;
+    bool                     failed = false;
+
+    dbus_threads_init_default();
+
+    printf("D-Bus load: %u clients, %u requests each, mix get=%u scan=%u prefix=%u\n", aConfig.mClients,
+           aConfig.mRequests, aConfig.mGetWeight, aConfig.mScanWeight, aConfig.mPrefixWeight);
+
+    start = GetMicroseconds();
+
+    for (unsigned i = 0; i < aConfig.mClients; ++i)
+    {
+        clients.emplace_back(RunClient, std::cref(aConfig), i, std::ref(clientStats[i]));
+    }
+
+    for (std::thread &client : clients)
+    {
+        client.join();
+    }
+
+    elapsed = GetMicroseconds() - start;
+
+    for (unsigned kind = 0; kind < kNumRequestKinds; ++kind)
+    {
+        LatencyStats stats;
+
+        for (const ClientStats &client : clientStats)
+        {
+            stats.Merge(client.mStats[kind]);
+        }
+
+        failed = failed || stats.GetErrors() > 0;
+        total.Merge(stats);
+        stats.Print(kRequestKindNames[kind], elapsed);
+    }
+
+    total.Print("total", elapsed);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+} // namespace Load
+} // namespace otbr
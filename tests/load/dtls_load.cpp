@@ -0,0 +1,424 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the DTLS load of the load generator.
+ */
+
+#include "load.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+#include "common/dtls_mbedtls.hpp"
+#include "common/time.hpp"
+#include "common/timer.hpp"
+
+namespace otbr {
+namespace Load {
+
+namespace {
+
+/**
+ * This class gates the sessions, so that they are all open at the same time once their handshakes are done.
+ *
+ */
+class SessionGate
+{
+public:
+    explicit SessionGate(unsigned aSessions)
+        : mPending(aSessions)
+        , mReleased(false)
+    {
+    }
+
+    void HandshakeDone(void)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        --mPending;
+        mCondition.notify_all();
+    }
+
+    void WaitHandshakes(void)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        mCondition.wait(lock, [this] { return mPending == 0; });
+    }
+
+    void Release(void)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mReleased = true;
+        mCondition.notify_all();
+    }
+
+    void WaitRelease(void)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        mCondition.wait(lock, [this] { return mReleased; });
+    }
+
+private:
+    std::mutex              mMutex;
+    std::condition_variable mCondition;
+    unsigned                mPending;
+    bool                    mReleased;
+};
+
+/**
+ * This class implements a DTLS client doing an EC J-PAKE handshake, as a commissioner does.
+ *
+ */
+class Client
+{
+public:
+    Client(void);
+    ~Client(void);
+
+    int  Connect(const addrinfo &aAddress, const uint8_t *aPskc, size_t aPskcLength);
+    int  Handshake(void);
+    void Close(void);
+
+private:
+    static int  Send(void *aContext, const unsigned char *aBuffer, size_t aLength);
+    static int  Receive(void *aContext, unsigned char *aBuffer, size_t aLength, uint32_t aTimeout);
+    static void SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal);
+    static int  GetDelay(void *aContext);
+
+    int                      mSocket;
+    unsigned long            mIntermediate;
+    unsigned long            mFinal;
+    bool                     mIsTimerSet;
+    mbedtls_entropy_context  mEntropy;
+    mbedtls_ctr_drbg_context mCtrDrbg;
+    mbedtls_ssl_config       mConf;
+    mbedtls_ssl_context      mSsl;
+};
+
+Client::Client(void)
+    : mSocket(-1)
+    , mIntermediate(0)
+    , mFinal(0)
+    , mIsTimerSet(false)
+{
+    mbedtls_entropy_init(&mEntropy);
+    mbedtls_ctr_drbg_init(&mCtrDrbg);
+    mbedtls_ssl_config_init(&mConf);
+    mbedtls_ssl_init(&mSsl);
+}
+
+Client::~Client(void)
+{
+    mbedtls_ssl_free(&mSsl);
+    mbedtls_ssl_config_free(&mConf);
+    mbedtls_ctr_drbg_free(&mCtrDrbg);
+    mbedtls_entropy_free(&mEntropy);
+
+    if (mSocket != -1)
+    {
+        close(mSocket);
+    }
+}
+
+int Client::Connect(const addrinfo &aAddress, const uint8_t *aPskc, size_t aPskcLength)
+{
+    static const int ciphersuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+    int              error          = -1;
+
+    VerifyOrExit((mSocket = socket(aAddress.ai_family, SOCK_DGRAM, IPPROTO_UDP)) != -1);
+    VerifyOrExit(connect(mSocket, aAddress.ai_addr, aAddress.ai_addrlen) == 0);
+
+    SuccessOrExit(error = mbedtls_ctr_drbg_seed(&mCtrDrbg, mbedtls_entropy_func, &mEntropy, NULL, 0));
+    SuccessOrExit(error = mbedtls_ssl_config_defaults(&mConf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                                      MBEDTLS_SSL_PRESET_DEFAULT));
+    mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mCtrDrbg);
+    mbedtls_ssl_conf_min_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+    mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+    mbedtls_ssl_conf_ciphersuites(&mConf, ciphersuites);
+
+    SuccessOrExit(error = mbedtls_ssl_setup(&mSsl, &mConf));
+    mbedtls_ssl_set_bio(&mSsl, this, Send, NULL, Receive);
+    mbedtls_ssl_set_timer_cb(&mSsl, this, SetDelay, GetDelay);
+    error = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, aPskc, aPskcLength);
+
+exit:
+    return error;
+}
+
+int Client::Handshake(void)
+{
+    int error;
+
+    do
+    {
+        error = mbedtls_ssl_handshake(&mSsl);
+    } while (error == MBEDTLS_ERR_SSL_WANT_READ || error == MBEDTLS_ERR_SSL_WANT_WRITE);
+
+    return error;
+}
+
+void Client::Close(void)
+{
+    mbedtls_ssl_close_notify(&mSsl);
+}
+
+int Client::Send(void *aContext, const unsigned char *aBuffer, size_t aLength)
+{
+    ssize_t sent = send(static_cast<Client *>(aContext)->mSocket, aBuffer, aLength, 0);
+
+    return sent < 0 ? MBEDTLS_ERR_NET_SEND_FAILED : static_cast<int>(sent);
+}
+
+int Client::Receive(void *aContext, unsigned char *aBuffer, size_t aLength, uint32_t aTimeout)
+{
+    Client *client = static_cast<Client *>(aContext);
+    pollfd  pollFd = {client->mSocket, POLLIN, 0};
+    int     ret    = poll(&pollFd, 1, aTimeout == 0 ? -1 : static_cast<int>(aTimeout));
+
+    if (ret == 0)
+    {
+        ret = MBEDTLS_ERR_SSL_TIMEOUT;
+    }
+    else if (ret > 0)
+    {
+        ret = static_cast<int>(recv(client->mSocket, aBuffer, aLength, 0));
+    }
+
+    return ret < 0 && ret != MBEDTLS_ERR_SSL_TIMEOUT ? MBEDTLS_ERR_NET_RECV_FAILED : ret;
+}
+
+void Client::SetDelay(void *aContext, uint32_t aIntermediate, uint32_t aFinal)
+{
+    Client *      client = static_cast<Client *>(aContext);
+    unsigned long now    = GetNow();
+
+    client->mIsTimerSet   = (aFinal != 0);
+    client->mIntermediate = now + aIntermediate;
+    client->mFinal        = now + aFinal;
+}
+
+int Client::GetDelay(void *aContext)
+{
+    const Client *client = static_cast<const Client *>(aContext);
+    unsigned long now    = GetNow();
+    int           ret    = -1;
+
+    if (client->mIsTimerSet)
+    {
+        ret = 0;
+
+        if (static_cast<long>(client->mIntermediate - now) <= 0)
+        {
+            ret = 1;
+        }
+
+        if (static_cast<long>(client->mFinal - now) <= 0)
+        {
+            ret = 2;
+        }
+    }
+
+    return ret;
+}
+
+void RunSession(const DtlsLoadConfig &aConfig, const addrinfo &aAddress, SessionGate &aGate, LatencyStats &aStats)
+{
+    Client   client;
+    uint64_t start = GetMicroseconds();
+    int      error;
+
+    if ((error = client.Connect(aAddress, aConfig.mPskc, sizeof(aConfig.mPskc))) == 0)
+    {
+        error = client.Handshake();
+    }
+
+    if (error == 0)
+    {
+        aStats.Add(GetMicroseconds() - start);
+    }
+    else
+    {
+        aStats.AddError();
+    }
+
+    aGate.HandshakeDone();
+    aGate.WaitRelease();
+
+    if (error == 0)
+    {
+        client.Close();
+    }
+}
+
+/**
+ * This function runs an MbedtlsServer with its own main loop until @p aRunning is cleared.
+ *
+ */
+void RunLocalServer(Dtls::Server &aServer, const std::atomic<bool> &aRunning)
+{
+    while (aRunning)
+    {
+        fd_set  readFdSet;
+        fd_set  writeFdSet;
+        fd_set  errorFdSet;
+        int     maxFd   = -1;
+        timeval timeout = {0, 100000};
+
+        FD_ZERO(&readFdSet);
+        FD_ZERO(&writeFdSet);
+        FD_ZERO(&errorFdSet);
+
+        aServer.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+        TimerScheduler::Get().UpdateTimeout(GetNow(), timeout);
+
+        if (select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout) >= 0)
+        {
+            UpdateMainloopNow();
+            TimerScheduler::Get().Process(GetMainloopNow());
+            aServer.Process(readFdSet, writeFdSet, errorFdSet);
+        }
+        else if (errno != EINTR)
+        {
+            perror("select");
+            break;
+        }
+    }
+}
+
+} // namespace
+
+int RunDtlsLoad(const DtlsLoadConfig &aConfig)
+{
+    std::vector<LatencyStats> sessionStats(aConfig.mSessions);
+    std::vector<std::thread>  sessions;
+    SessionGate               gate(aConfig.mSessions);
+    LatencyStats              stats;
+    Dtls::Server *            server = NULL;
+    std::atomic<bool>         serverRunning(false);
+    std::thread               serverThread;
+    addrinfo                  hints;
+    addrinfo *                address = NULL;
+    char                      port[8];
+    uint64_t                  start;
+    int                       ret = EXIT_FAILURE;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_socktype = SOCK_DGRAM;
+    snprintf(port, sizeof(port), "%u", aConfig.mPort);
+
+    if (getaddrinfo(aConfig.mAddress, port, &hints, &address) != 0)
+    {
+        fprintf(stderr, "Failed to resolve %s\n", aConfig.mAddress);
+        ExitNow();
+    }
+
+    if (aConfig.mLocalServer)
+    {
+        static const uint8_t kSeed[] = "otbr-load";
+
+        server = Dtls::Server::Create(aConfig.mPort, NULL, NULL);
+        VerifyOrExit(server->SetPSK(aConfig.mPskc, sizeof(aConfig.mPskc)) == OTBR_ERROR_NONE);
+        VerifyOrExit(server->SetSeed(kSeed, sizeof(kSeed)) == OTBR_ERROR_NONE);
+        VerifyOrExit(server->Start() == OTBR_ERROR_NONE, fprintf(stderr, "Failed to start the DTLS server\n"));
+        serverRunning = true;
+        serverThread  = std::thread(RunLocalServer, std::ref(*server), std::cref(serverRunning));
+    }
+
+    printf("DTLS load: %u sessions to %s port %u%s\n", aConfig.mSessions, aConfig.mAddress, aConfig.mPort,
+           aConfig.mLocalServer ? " (local server)" : "");
+
+    start = GetMicroseconds();
+
+    for (unsigned i = 0; i < aConfig.mSessions; ++i)
+    {
+        sessions.emplace_back(RunSession, std::cref(aConfig), std::cref(*address), std::ref(gate),
+                              std::ref(sessionStats[i]));
+    }
+
+    gate.WaitHandshakes();
+
+    for (const LatencyStats &session : sessionStats)
+    {
+        stats.Merge(session);
+    }
+
+    stats.Print("handshake", GetMicroseconds() - start);
+    printf("open       sessions=%zu held=%ums\n", aConfig.mSessions - static_cast<size_t>(stats.GetErrors()),
+           aConfig.mHoldTime);
+
+    usleep(aConfig.mHoldTime * 1000);
+    gate.Release();
+
+    for (std::thread &session : sessions)
+    {
+        session.join();
+    }
+
+    ret = stats.GetErrors() > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+
+exit:
+    if (serverRunning)
+    {
+        serverRunning = false;
+        serverThread.join();
+    }
+
+    if (server != NULL)
+    {
+        Dtls::Server::Destroy(server);
+    }
+
+    if (address != NULL)
+    {
+        freeaddrinfo(address);
+    }
+
+    return ret;
+}
+
+} // namespace Load
+} // namespace otbr
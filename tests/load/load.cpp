@@ -0,0 +1,302 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the load generator of the D-Bus and DTLS endpoints.
+ *
+ *   The load generator reports the throughput and the latency percentiles of each kind of request, and the CPU time
+ *   and memory of the agent during the run, so that capacity limits are found before deployment.
+ */
+
+#include "load.hpp"
+
+#include <algorithm>
+
+#include <dirent.h>
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/code_utils.hpp"
+#include "utils/hex.hpp"
+
+namespace otbr {
+namespace Load {
+
+void LatencyStats::Merge(const LatencyStats &aOther)
+{
+    mSamples.insert(mSamples.end(), aOther.mSamples.begin(), aOther.mSamples.end());
+    mErrors += aOther.mErrors;
+}
+
+uint64_t LatencyStats::GetPercentile(unsigned aPercentile) const
+{
+    size_t index = (mSamples.size() * aPercentile + 99) / 100;
+
+    return mSamples.empty() ? 0 : mSamples[std::max<size_t>(index, 1) - 1];
+}
+
+void LatencyStats::Print(const char *aName, uint64_t aElapsed)
+{
+    std::sort(mSamples.begin(), mSamples.end());
+
+    printf("%-10s requests=%zu errors=%" PRIu32 " throughput=%.1f/s p50=%" PRIu64 "us p99=%" PRIu64 "us max=%" PRIu64
+           "us\n",
+           aName, mSamples.size(), mErrors, aElapsed > 0 ? mSamples.size() * 1e6 / aElapsed : 0.0, GetPercentile(50),
+           GetPercentile(99), mSamples.empty() ? 0 : mSamples.back());
+}
+
+otbrError GetProcessUsage(pid_t aPid, ProcessUsage &aUsage)
+{
+    otbrError          error = OTBR_ERROR_ERRNO;
+    char               path[64];
+    char               line[512];
+    FILE *             file;
+    const char *       fields;
+    unsigned long long userTime;
+    unsigned long long systemTime;
+
+    memset(&aUsage, 0, sizeof(aUsage));
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", static_cast<int>(aPid));
+    VerifyOrExit((file = fopen(path, "r")) != NULL);
+    fields = fgets(line, sizeof(line), file);
+    fclose(file);
+    VerifyOrExit(fields != NULL);
+
+    // The command name may contain spaces, fields are counted from its closing parenthesis, utime is the 14th.
+    VerifyOrExit((fields = strrchr(line, ')')) != NULL, errno = EINVAL);
+    VerifyOrExit(sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &userTime,
+                        &systemTime) == 2,
+                 errno = EINVAL);
+    aUsage.mCpuTime = (userTime + systemTime) * 1000 / static_cast<unsigned long long>(sysconf(_SC_CLK_TCK));
+
+    snprintf(path, sizeof(path), "/proc/%d/status", static_cast<int>(aPid));
+    VerifyOrExit((file = fopen(path, "r")) != NULL);
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        unsigned long long value;
+
+        if (sscanf(line, "VmRSS: %llu", &value) == 1)
+        {
+            aUsage.mRss = value;
+        }
+        else if (sscanf(line, "VmHWM: %llu", &value) == 1)
+        {
+            aUsage.mPeakRss = value;
+        }
+    }
+
+    fclose(file);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+uint64_t GetMicroseconds(void)
+{
+    timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec) / 1000;
+}
+
+} // namespace Load
+} // namespace otbr
+
+static const char kAgentName[] = "otbr-agent";
+
+static const struct option kOptions[] = {{"address", required_argument, NULL, 'a'},
+                                         {"clients", required_argument, NULL, 'c'},
+                                         {"help", no_argument, NULL, 'h'},
+                                         {"thread-ifname", required_argument, NULL, 'I'},
+                                         {"pskc", required_argument, NULL, 'k'},
+                                         {"local-server", no_argument, NULL, 'l'},
+                                         {"mix", required_argument, NULL, 'm'},
+                                         {"requests", required_argument, NULL, 'n'},
+                                         {"pid", required_argument, NULL, 'p'},
+                                         {"port", required_argument, NULL, 'P'},
+                                         {"hold-time", required_argument, NULL, 't'},
+                                         {0, 0, 0, 0}};
+
+static void PrintUsage(const char *aProgramName, FILE *aStream, int aExitCode)
+{
+    fprintf(aStream,
+            "Usage:\n"
+            "  %s dbus [-I ifname] [-c clients] [-n requests] [-m get,scan,prefix] [-p pid]\n"
+            "  %s dtls [-a address] [-P port] [-k pskc] [-c sessions] [-t hold-ms] [-l] [-p pid]\n"
+            "\n"
+            "  -m  The weights of property gets, scans and on-mesh prefix adds, default 90,5,5.\n"
+            "  -l  Run an MbedtlsServer in this process instead of targeting the agent.\n"
+            "  -p  The process whose CPU time and memory are reported, default the running %s.\n",
+            aProgramName, aProgramName, kAgentName);
+    exit(aExitCode);
+}
+
+static pid_t FindProcess(const char *aName)
+{
+    pid_t   pid = -1;
+    DIR *   dir = opendir("/proc");
+    dirent *entry;
+
+    VerifyOrExit(dir != NULL);
+
+    while (pid < 0 && (entry = readdir(dir)) != NULL)
+    {
+        char  path[300];
+        char  name[64] = "";
+        FILE *file;
+
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/proc/%s/comm", entry->d_name);
+
+        if ((file = fopen(path, "r")) == NULL)
+        {
+            continue;
+        }
+
+        if (fgets(name, sizeof(name), file) != NULL && strcmp(strtok(name, "\n"), aName) == 0)
+        {
+            pid = atoi(entry->d_name);
+        }
+
+        fclose(file);
+    }
+
+    closedir(dir);
+
+exit:
+    return pid;
+}
+
+int main(int argc, char *argv[])
+{
+    otbr::Load::DBusLoadConfig dbusConfig = {"wpan0", 4, 100, 90, 5, 5};
+    otbr::Load::DtlsLoadConfig dtlsConfig = {"::1", 49191, {0}, 16, 1000, false};
+    otbr::Load::ProcessUsage   before;
+    otbr::Load::ProcessUsage   after;
+    pid_t                      pid = -1;
+    const char *               mode;
+    uint64_t                   start;
+    uint64_t                   elapsed;
+    int                        opt;
+    int                        ret = EXIT_FAILURE;
+
+    VerifyOrExit(argc >= 2, PrintUsage(argv[0], stderr, EXIT_FAILURE));
+    mode = argv[1];
+    VerifyOrExit(strcmp(mode, "dbus") == 0 || strcmp(mode, "dtls") == 0, PrintUsage(argv[0], stderr, EXIT_FAILURE));
+
+    while ((opt = getopt_long(argc - 1, argv + 1, "a:c:hI:k:lm:n:p:P:t:", kOptions, NULL)) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+            dtlsConfig.mAddress = optarg;
+            break;
+        case 'c':
+            dbusConfig.mClients = dtlsConfig.mSessions = static_cast<unsigned>(atoi(optarg));
+            break;
+        case 'I':
+            dbusConfig.mInterfaceName = optarg;
+            break;
+        case 'k':
+            VerifyOrExit(otbr::Utils::Hex2Bytes(optarg, dtlsConfig.mPskc, sizeof(dtlsConfig.mPskc)) ==
+                             static_cast<int>(sizeof(dtlsConfig.mPskc)),
+                         PrintUsage(argv[0], stderr, EXIT_FAILURE));
+            break;
+        case 'l':
+            dtlsConfig.mLocalServer = true;
+            break;
+        case 'm':
+            VerifyOrExit(sscanf(optarg, "%u,%u,%u", &dbusConfig.mGetWeight, &dbusConfig.mScanWeight,
+                                &dbusConfig.mPrefixWeight) == 3 &&
+                             dbusConfig.mGetWeight + dbusConfig.mScanWeight + dbusConfig.mPrefixWeight > 0,
+                         PrintUsage(argv[0], stderr, EXIT_FAILURE));
+            break;
+        case 'n':
+            dbusConfig.mRequests = static_cast<unsigned>(atoi(optarg));
+            break;
+        case 'p':
+            pid = atoi(optarg);
+            break;
+        case 'P':
+            dtlsConfig.mPort = static_cast<uint16_t>(atoi(optarg));
+            break;
+        case 't':
+            dtlsConfig.mHoldTime = static_cast<unsigned>(atoi(optarg));
+            break;
+        case 'h':
+            PrintUsage(argv[0], stdout, EXIT_SUCCESS);
+            break;
+        default:
+            PrintUsage(argv[0], stderr, EXIT_FAILURE);
+            break;
+        }
+    }
+
+    if (pid < 0)
+    {
+        pid = (strcmp(mode, "dtls") == 0 && dtlsConfig.mLocalServer) ? getpid() : FindProcess(kAgentName);
+    }
+
+    if (pid < 0 || otbr::Load::GetProcessUsage(pid, before) != OTBR_ERROR_NONE)
+    {
+        fprintf(stderr, "No process to report the CPU time and memory of, use -p\n");
+        pid = -1;
+    }
+
+    start = otbr::Load::GetMicroseconds();
+    ret   = (strcmp(mode, "dbus") == 0) ? otbr::Load::RunDBusLoad(dbusConfig) : otbr::Load::RunDtlsLoad(dtlsConfig);
+    elapsed = otbr::Load::GetMicroseconds() - start;
+
+    if (pid >= 0 && otbr::Load::GetProcessUsage(pid, after) == OTBR_ERROR_NONE)
+    {
+        uint64_t cpuTime = after.mCpuTime - before.mCpuTime;
+
+        printf("process    pid=%d cpu=%" PRIu64 "ms (%.1f%%) rss=%" PRIu64 "KiB (%+" PRId64 "KiB) peak-rss=%" PRIu64
+               "KiB\n",
+               static_cast<int>(pid), cpuTime, elapsed > 0 ? cpuTime * 1e5 / elapsed : 0.0, after.mRss,
+               static_cast<int64_t>(after.mRss - before.mRss), after.mPeakRss);
+    }
+
+exit:
+    return ret;
+}
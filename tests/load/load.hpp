@@ -0,0 +1,190 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the load generator of the D-Bus and DTLS endpoints.
+ */
+
+#ifndef OTBR_TESTS_LOAD_LOAD_HPP_
+#define OTBR_TESTS_LOAD_LOAD_HPP_
+
+#include <vector>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "common/types.hpp"
+
+namespace otbr {
+namespace Load {
+
+/**
+ * This class collects the latencies of one kind of request.
+ *
+ */
+class LatencyStats
+{
+public:
+    LatencyStats(void)
+        : mErrors(0)
+    {
+    }
+
+    /**
+     * This method records a successful request.
+     *
+     * @param[in]  aLatency  The latency of the request in microseconds.
+     *
+     */
+    void Add(uint64_t aLatency) { mSamples.push_back(aLatency); }
+
+    /**
+     * This method records a failed request.
+     *
+     */
+    void AddError(void) { ++mErrors; }
+
+    /**
+     * This method returns the number of failed requests.
+     *
+     */
+    uint32_t GetErrors(void) const { return mErrors; }
+
+    /**
+     * This method adds the requests recorded by @p aOther.
+     *
+     * @param[in]  aOther  The stats to add.
+     *
+     */
+    void Merge(const LatencyStats &aOther);
+
+    /**
+     * This method prints the throughput, the latency percentiles and the errors.
+     *
+     * @param[in]  aName     The kind of request.
+     * @param[in]  aElapsed  The duration of the run in microseconds.
+     *
+     */
+    void Print(const char *aName, uint64_t aElapsed);
+
+private:
+    uint64_t GetPercentile(unsigned aPercentile) const;
+
+    std::vector<uint64_t> mSamples; ///< Sorted by Print().
+    uint32_t              mErrors;
+};
+
+/**
+ * This structure represents the resource usage of a process.
+ *
+ */
+struct ProcessUsage
+{
+    uint64_t mCpuTime; ///< User and system time in milliseconds.
+    uint64_t mRss;     ///< Resident set size in KiB.
+    uint64_t mPeakRss; ///< Peak resident set size in KiB.
+};
+
+/**
+ * This function reads the resource usage of a process from procfs.
+ *
+ * @param[in]   aPid    The process id.
+ * @param[out]  aUsage  A reference to receive the resource usage.
+ *
+ * @retval  OTBR_ERROR_NONE     Successfully read the resource usage.
+ * @retval  OTBR_ERROR_ERRNO    Failed to read the resource usage.
+ *
+ */
+otbrError GetProcessUsage(pid_t aPid, ProcessUsage &aUsage);
+
+/**
+ * This function returns a monotonic timestamp.
+ *
+ * @returns The timestamp in microseconds.
+ *
+ */
+uint64_t GetMicroseconds(void);
+
+/**
+ * This structure represents the configuration of a D-Bus load run.
+ *
+ */
+struct DBusLoadConfig
+{
+    const char *mInterfaceName; ///< The Thread interface name of the agent.
+    unsigned    mClients;       ///< The number of concurrent clients, each with its own bus connection.
+    unsigned    mRequests;      ///< The number of requests sent by each client.
+    unsigned    mGetWeight;     ///< The weight of property gets in the request mix.
+    unsigned    mScanWeight;    ///< The weight of scans in the request mix.
+    unsigned    mPrefixWeight;  ///< The weight of on-mesh prefix adds, each followed by its removal.
+};
+
+/**
+ * This function drives the D-Bus API of the agent with concurrent clients and prints the latencies.
+ *
+ * @param[in]  aConfig  The configuration of the run.
+ *
+ * @returns The exit code, EXIT_FAILURE if any request failed.
+ *
+ */
+int RunDBusLoad(const DBusLoadConfig &aConfig);
+
+/**
+ * This structure represents the configuration of a DTLS load run.
+ *
+ */
+struct DtlsLoadConfig
+{
+    enum
+    {
+        kPskcLength = 16, ///< Length of the PSKc in bytes.
+    };
+
+    const char *mAddress;           ///< The address of the DTLS server.
+    uint16_t    mPort;              ///< The port of the DTLS server.
+    uint8_t     mPskc[kPskcLength]; ///< The PSKc used as EC J-PAKE password.
+    unsigned    mSessions;          ///< The number of concurrent sessions.
+    unsigned    mHoldTime;          ///< The time in milliseconds to hold the sessions open once all are ready.
+    bool        mLocalServer;       ///< Whether to run an MbedtlsServer in this process on @p mPort.
+};
+
+/**
+ * This function opens concurrent DTLS sessions with PSK handshakes and prints the handshake latencies.
+ *
+ * @param[in]  aConfig  The configuration of the run.
+ *
+ * @returns The exit code, EXIT_FAILURE if any handshake failed.
+ *
+ */
+int RunDtlsLoad(const DtlsLoadConfig &aConfig);
+
+} // namespace Load
+} // namespace otbr
+
+#endif // OTBR_TESTS_LOAD_LOAD_HPP_
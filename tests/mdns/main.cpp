@@ -32,10 +32,16 @@
 #include <netinet/in.h>
 #include <signal.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
 #include "mdns/mdns.hpp"
 
 using namespace otbr;
@@ -44,13 +50,42 @@ static struct Context
 {
     Mdns::Publisher *mPublisher;
     bool             mUpdate;
+    bool             mDone;
 } sContext;
 
+enum
+{
+    kStressServices    = 200, ///< The default number of services published by the stress test.
+    kStressRounds      = 5,   ///< The default number of rounds, all rounds after the first update the TXT data.
+    kStressMaxTxtValue = 250, ///< The max length of the TXT value varied across services.
+};
+
+struct StressService
+{
+    char     mName[32];
+    uint64_t mSentTime;
+    bool     mPending;
+};
+
+static struct StressContext
+{
+    std::vector<StressService> mServices;
+    std::vector<uint32_t>      mLatencies;
+    unsigned                   mRounds;
+    unsigned                   mRound;
+    unsigned                   mPending;
+    unsigned                   mFailed;
+    unsigned                   mRoundFailed;
+    uint64_t                   mRoundStart;
+    uint64_t                   mStart;
+    bool                       mStarted;
+} sStress;
+
 int Mainloop(Mdns::Publisher &aPublisher)
 {
     int rval = 0;
 
-    while (true)
+    while (!sContext.mDone)
     {
         fd_set         readFdSet;
         fd_set         writeFdSet;
@@ -94,10 +129,22 @@ void PublishMultipleServices(void *aContext, Mdns::State aState)
 
     if (aState == Mdns::kStateReady)
     {
-        assert(OTBR_ERROR_NONE == sContext.mPublisher->PublishService(12345, "MultipleService1", "_meshcop._udp.", "nn",
-                                                                      "cool1", "xp", "1122334455667788", NULL));
-        assert(OTBR_ERROR_NONE == sContext.mPublisher->PublishService(12346, "MultipleService2", "_meshcop._udp.", "nn",
-                                                                      "cool2", "xp", "1122334455667788", NULL));
+        const Mdns::TxtEntry txtEntries1[] = {{"nn", "cool1"}, {"xp", "1122334455667788"}};
+        const Mdns::TxtEntry txtEntries2[] = {{"nn", "cool2"}, {"xp", "1122334455667788"}};
+        uint8_t              txt1[Mdns::Publisher::kMaxSizeOfTxtData];
+        uint8_t              txt2[Mdns::Publisher::kMaxSizeOfTxtData];
+        uint16_t             txtLength1 = sizeof(txt1);
+        uint16_t             txtLength2 = sizeof(txt2);
+
+        assert(OTBR_ERROR_NONE == Mdns::Publisher::EncodeTxtData(txtEntries1, 2, txt1, txtLength1));
+        assert(OTBR_ERROR_NONE == Mdns::Publisher::EncodeTxtData(txtEntries2, 2, txt2, txtLength2));
+
+        assert(OTBR_ERROR_NONE == sContext.mPublisher->BeginServices());
+        assert(OTBR_ERROR_NONE ==
+               sContext.mPublisher->AddService(12345, "MultipleService1", "_meshcop._udp.", txt1, txtLength1));
+        assert(OTBR_ERROR_NONE ==
+               sContext.mPublisher->AddService(12346, "MultipleService2", "_meshcop._udp.", txt2, txtLength2));
+        assert(OTBR_ERROR_NONE == sContext.mPublisher->CommitServices());
     }
 }
 
@@ -167,6 +214,146 @@ exit:
     return ret;
 }
 
+void PrintStressLatencies(const char *aLabel, std::vector<uint32_t> &aLatencies, unsigned aFailed, uint64_t aElapsed)
+{
+    size_t count = aLatencies.size();
+
+    VerifyOrExit(count > 0);
+
+    std::sort(aLatencies.begin(), aLatencies.end());
+    printf("%-8s acks=%zu failed=%u elapsed=%.1fms throughput=%.1f/s p50=%.3fms p99=%.3fms max=%.3fms\n", aLabel,
+           count, aFailed, aElapsed / 1000.0, aElapsed > 0 ? count * 1000000.0 / aElapsed : 0.0,
+           aLatencies[count / 2] / 1000.0, aLatencies[(count * 99) / 100] / 1000.0, aLatencies[count - 1] / 1000.0);
+
+exit:
+    return;
+}
+
+void PublishStressRound(void)
+{
+    char     value[kStressMaxTxtValue + 1];
+    uint8_t  txt[Mdns::Publisher::kMaxSizeOfTxtData];
+    uint16_t txtLength;
+
+    sStress.mPending     = static_cast<unsigned>(sStress.mServices.size());
+    sStress.mRoundFailed = 0;
+    sStress.mRoundStart  = GetNowPrecise();
+    assert(OTBR_ERROR_NONE == sContext.mPublisher->BeginServices());
+
+    for (size_t i = 0; i < sStress.mServices.size(); i++)
+    {
+        StressService &      service = sStress.mServices[i];
+        size_t               length  = 1 + (i * 31 + sStress.mRound * 17) % kStressMaxTxtValue;
+        const Mdns::TxtEntry txtEntries[] = {{"nn", service.mName}, {"xp", value}};
+
+        // The value changes with every round so that each round is a real update of every service.
+        memset(value, 'a' + static_cast<char>((i + sStress.mRound) % 26), length);
+        value[length] = '\0';
+        txtLength     = sizeof(txt);
+        assert(OTBR_ERROR_NONE == Mdns::Publisher::EncodeTxtData(txtEntries, 2, txt, txtLength));
+
+        // Some backends acknowledge updates before AddService() returns, so the request is marked pending first.
+        service.mPending  = true;
+        service.mSentTime = GetNowPrecise();
+        assert(OTBR_ERROR_NONE == sContext.mPublisher->AddService(static_cast<uint16_t>(20000 + i), service.mName,
+                                                                  "_meshcop._udp.", txt, txtLength));
+    }
+
+    assert(OTBR_ERROR_NONE == sContext.mPublisher->CommitServices());
+}
+
+void HandleStressPublished(void *aContext, const char *aName, const char *aType, otbrError aError)
+{
+    std::vector<StressService>::iterator it;
+    uint64_t                             now = GetNowPrecise();
+
+    assert(aContext == &sStress);
+    (void)aType;
+
+    for (it = sStress.mServices.begin(); it != sStress.mServices.end(); ++it)
+    {
+        if (it->mPending && !strcmp(it->mName, aName))
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(it != sStress.mServices.end());
+
+    it->mPending = false;
+    sStress.mLatencies.push_back(static_cast<uint32_t>(now - it->mSentTime));
+
+    if (aError != OTBR_ERROR_NONE)
+    {
+        sStress.mFailed++;
+        sStress.mRoundFailed++;
+    }
+
+    VerifyOrExit(--sStress.mPending == 0);
+
+    {
+        std::vector<uint32_t> latencies(sStress.mLatencies.end() - sStress.mServices.size(), sStress.mLatencies.end());
+        char                  label[16];
+
+        snprintf(label, sizeof(label), "round%u", sStress.mRound);
+        PrintStressLatencies(label, latencies, sStress.mRoundFailed, now - sStress.mRoundStart);
+    }
+
+    if (++sStress.mRound < sStress.mRounds)
+    {
+        PublishStressRound();
+    }
+    else
+    {
+        PrintStressLatencies("total", sStress.mLatencies, sStress.mFailed, now - sStress.mStart);
+        sContext.mDone = true;
+    }
+
+exit:
+    return;
+}
+
+void PublishStressServices(void *aContext, Mdns::State aState)
+{
+    assert(aContext == &sContext);
+
+    if (aState == Mdns::kStateReady && !sStress.mStarted)
+    {
+        sStress.mStarted = true;
+        sStress.mStart   = GetNowPrecise();
+        PublishStressRound();
+    }
+}
+
+otbrError TestStressServices(unsigned aServices, unsigned aRounds)
+{
+    otbrError        ret = OTBR_ERROR_NONE;
+    Mdns::Publisher *pub = NULL;
+
+    VerifyOrExit(aServices > 0 && aRounds > 0, errno = EINVAL, ret = OTBR_ERROR_ERRNO);
+
+    pub                 = Mdns::Publisher::Create(AF_UNSPEC, NULL, NULL, PublishStressServices, &sContext);
+    sContext.mPublisher = pub;
+    sStress.mRounds      = aRounds;
+    sStress.mServices.resize(aServices);
+
+    for (unsigned i = 0; i < aServices; i++)
+    {
+        snprintf(sStress.mServices[i].mName, sizeof(sStress.mServices[i].mName), "StressService%u", i);
+        sStress.mServices[i].mPending = false;
+    }
+
+    sStress.mLatencies.reserve(aServices * aRounds);
+    pub->SetPublishHandler(HandleStressPublished, &sStress);
+    SuccessOrExit(ret = pub->Start());
+    Mainloop(*pub);
+    VerifyOrExit(sStress.mFailed == 0, ret = OTBR_ERROR_MDNS);
+
+exit:
+    Mdns::Publisher::Destroy(pub);
+    return ret;
+}
+
 void RecoverSignal(int aSignal)
 {
     if (aSignal == SIGUSR1)
@@ -208,7 +395,8 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    otbrLogInit("otbr-mdns", OTBR_LOG_DEBUG, true);
+    // Logging every service would dominate the latencies measured by the stress test.
+    otbrLogInit("otbr-mdns", argv[1][0] == 't' ? OTBR_LOG_WARNING : OTBR_LOG_DEBUG, true);
     // allow quitting elegantly
     signal(SIGTERM, RecoverSignal);
     switch (argv[1][0])
@@ -229,6 +417,11 @@ int main(int argc, char *argv[])
         ret = TestStopService();
         break;
 
+    case 't':
+        ret = TestStressServices(static_cast<unsigned>(argc > 2 ? atoi(argv[2]) : kStressServices),
+                                 static_cast<unsigned>(argc > 3 ? atoi(argv[3]) : kStressRounds));
+        break;
+
     default:
         ret = 1;
         break;
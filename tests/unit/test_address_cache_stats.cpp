@@ -0,0 +1,107 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/address_cache_stats.hpp"
+
+using otbr::AddressCacheStats;
+
+TEST_GROUP(AddressCacheStats){};
+
+static AddressCacheStats::Entry MakeEntry(uint8_t aId, uint16_t aRloc16, AddressCacheStats::State aState)
+{
+    AddressCacheStats::Entry entry = {{0xfd, 0x00, 0x0d, 0xb8}, aRloc16, aState};
+
+    entry.mTarget[15] = aId;
+
+    return entry;
+}
+
+TEST(AddressCacheStats, TestFirstSampleIsReference)
+{
+    AddressCacheStats stats;
+
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached),
+                  MakeEntry(2, 0xfffe, AddressCacheStats::kStateQuery)});
+
+    CHECK_EQUAL(2, stats.GetEntries().size());
+    CHECK_EQUAL(0, stats.GetCounters().mQueries);
+    CHECK_EQUAL(0, stats.GetCounters().mResponses);
+    CHECK_EQUAL(2, stats.GetCounters().mPeakSize);
+}
+
+TEST(AddressCacheStats, TestQueryLifecycle)
+{
+    AddressCacheStats stats;
+
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached)});
+
+    // A query which fails once, then is answered.
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached),
+                  MakeEntry(2, 0xfffe, AddressCacheStats::kStateQuery)});
+    CHECK_EQUAL(1, stats.GetCounters().mQueries);
+
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached),
+                  MakeEntry(2, 0xfffe, AddressCacheStats::kStateRetryQuery)});
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached),
+                  MakeEntry(2, 0xfffe, AddressCacheStats::kStateRetryQuery)});
+    CHECK_EQUAL(1, stats.GetCounters().mQueries);
+    CHECK_EQUAL(1, stats.GetCounters().mFailures);
+
+    stats.Sample({MakeEntry(1, 0x0400, AddressCacheStats::kStateCached),
+                  MakeEntry(2, 0x0800, AddressCacheStats::kStateCached)});
+    CHECK_EQUAL(1, stats.GetCounters().mResponses);
+
+    // A query started and answered between two samples, and an entry evicted for it.
+    stats.Sample({MakeEntry(2, 0x0800, AddressCacheStats::kStateCached),
+                  MakeEntry(3, 0x0c00, AddressCacheStats::kStateCached)});
+    CHECK_EQUAL(2, stats.GetCounters().mQueries);
+    CHECK_EQUAL(2, stats.GetCounters().mResponses);
+    CHECK_EQUAL(1, stats.GetCounters().mEvictions);
+
+    // Snooped entries are learned without a query, and a removed query is not an eviction.
+    stats.Sample({MakeEntry(2, 0x0800, AddressCacheStats::kStateCached),
+                  MakeEntry(3, 0x0c00, AddressCacheStats::kStateCached),
+                  MakeEntry(4, 0x1000, AddressCacheStats::kStateSnooped),
+                  MakeEntry(5, 0xfffe, AddressCacheStats::kStateQuery)});
+    stats.Sample({MakeEntry(2, 0x0800, AddressCacheStats::kStateCached),
+                  MakeEntry(3, 0x0c00, AddressCacheStats::kStateCached),
+                  MakeEntry(4, 0x1000, AddressCacheStats::kStateSnooped)});
+    CHECK_EQUAL(3, stats.GetCounters().mQueries);
+    CHECK_EQUAL(2, stats.GetCounters().mResponses);
+    CHECK_EQUAL(1, stats.GetCounters().mEvictions);
+    CHECK_EQUAL(4, stats.GetCounters().mPeakSize);
+
+    // The entries of a restarted cache are not evicted.
+    stats.Restart();
+    CHECK_EQUAL(0, stats.GetEntries().size());
+    stats.Sample({MakeEntry(6, 0x1400, AddressCacheStats::kStateCached)});
+    CHECK_EQUAL(3, stats.GetCounters().mQueries);
+    CHECK_EQUAL(1, stats.GetCounters().mEvictions);
+}
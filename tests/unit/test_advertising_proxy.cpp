@@ -0,0 +1,168 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+#include <vector>
+
+#include "common/mainloop_stats.hpp"
+#include "mdns/advertising_proxy.hpp"
+
+using otbr::Mdns::AdvertisingProxy;
+
+class FakePublisher : public otbr::Mdns::Publisher
+{
+public:
+    FakePublisher(void)
+        : mReady(true)
+        , mBatches(0)
+    {
+    }
+
+    otbrError Start(void) override { return OTBR_ERROR_NONE; }
+    void      Stop(void) override {}
+    bool      IsStarted(void) const override { return true; }
+    otbrError BeginServices(void) override { return mReady ? OTBR_ERROR_NONE : OTBR_ERROR_ERRNO; }
+    otbrError AddService(uint16_t       aPort,
+                         const char *   aName,
+                         const char *   aType,
+                         const uint8_t *aTxtData,
+                         uint16_t       aTxtLength) override
+    {
+        (void)aPort;
+        (void)aTxtData;
+        (void)aTxtLength;
+        mAdded.push_back(std::string(aName) + "." + aType);
+        return OTBR_ERROR_NONE;
+    }
+    otbrError CommitServices(void) override
+    {
+        ++mBatches;
+        return OTBR_ERROR_NONE;
+    }
+    void Process(const fd_set &, const fd_set &, const fd_set &) override {}
+    void UpdateFdSet(fd_set &, fd_set &, fd_set &, int &, timeval &) override {}
+
+    void Ack(const char *aName, const char *aType) { HandlePublished(aName, aType, OTBR_ERROR_NONE); }
+
+    bool                     mReady;
+    unsigned                 mBatches;
+    std::vector<std::string> mAdded;
+
+protected:
+    otbrError StartBrowse(const char *) override { return OTBR_ERROR_NONE; }
+    void      StopBrowse(const char *) override {}
+    void      StartResolve(const otbr::Mdns::ServiceCache::Instance &) override {}
+    void      StopResolve(const otbr::Mdns::ServiceCache::Instance &) override {}
+};
+
+static AdvertisingProxy::Host MakeHost(const char *aHostName, const char *aServiceName, const char *aValue)
+{
+    AdvertisingProxy::Host    host;
+    AdvertisingProxy::Service service;
+
+    service.mName = aServiceName;
+    service.mType = "_coap._udp";
+    service.mPort = 5683;
+    service.mTxtRecord.SetEntry("v", aValue);
+    host.mName = aHostName;
+    host.mServices.push_back(service);
+
+    return host;
+}
+
+TEST_GROUP(AdvertisingProxy){};
+
+TEST(AdvertisingProxy, TestCoalesceHost)
+{
+    FakePublisher    publisher;
+    AdvertisingProxy proxy(publisher);
+
+    proxy.Register(MakeHost("host1", "dev1", "1"));
+    proxy.Register(MakeHost("host1", "dev1", "2"));
+    proxy.Register(MakeHost("host2", "dev2", "1"));
+    CHECK_EQUAL(2, proxy.GetPendingHostCount());
+    CHECK(publisher.mAdded.empty());
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, proxy.Flush());
+    CHECK_EQUAL(0, proxy.GetPendingHostCount());
+    CHECK_EQUAL(1, publisher.mBatches);
+    CHECK_EQUAL(2, publisher.mAdded.size());
+    CHECK_EQUAL(3, proxy.GetCounters().mRegistrations);
+    CHECK_EQUAL(1, proxy.GetCounters().mCoalesced);
+    CHECK_EQUAL(2, proxy.GetCounters().mServicesPublished);
+}
+
+TEST(AdvertisingProxy, TestIncrementalUpdate)
+{
+    FakePublisher    publisher;
+    AdvertisingProxy proxy(publisher);
+
+    proxy.Register(MakeHost("host1", "dev1", "1"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, proxy.Flush());
+
+    proxy.Register(MakeHost("host1", "dev1", "1"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, proxy.Flush());
+    CHECK_EQUAL(1, publisher.mAdded.size());
+    CHECK_EQUAL(1, proxy.GetCounters().mServicesUnchanged);
+
+    proxy.Register(MakeHost("host1", "dev1", "2"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, proxy.Flush());
+    CHECK_EQUAL(2, publisher.mAdded.size());
+}
+
+TEST(AdvertisingProxy, TestPublisherNotReady)
+{
+    FakePublisher    publisher;
+    AdvertisingProxy proxy(publisher);
+
+    publisher.mReady = false;
+    proxy.Register(MakeHost("host1", "dev1", "1"));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, proxy.Flush());
+    CHECK_EQUAL(1, proxy.GetPendingHostCount());
+
+    publisher.mReady = true;
+    proxy.HandleMdnsState(otbr::Mdns::kStateReady);
+    CHECK_EQUAL(0, proxy.GetPendingHostCount());
+    CHECK_EQUAL(1, publisher.mAdded.size());
+}
+
+TEST(AdvertisingProxy, TestLatency)
+{
+    FakePublisher    publisher;
+    AdvertisingProxy proxy(publisher);
+    otbr::Histogram &latency = otbr::GetMainloopHistogram(otbr::kMainloopStageAdvertisingProxyLatency);
+    uint64_t         count   = latency.GetCount();
+
+    proxy.Register(MakeHost("host1", "dev1", "1"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, proxy.Flush());
+    publisher.Ack("dev1", "_coap._udp");
+    publisher.Ack("dev1", "_coap._udp");
+    CHECK_EQUAL(count + 1, latency.GetCount());
+}
@@ -0,0 +1,160 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include "common/background_scheduler.hpp"
+#include "common/time.hpp"
+#include "common/timer.hpp"
+
+TEST_GROUP(BackgroundScheduler){};
+
+// Runs the slice due, as an iteration of the main loop does.
+static void RunSlice(otbr::TimerScheduler &aScheduler)
+{
+    // A slice with jobs left is due in the next millisecond at the earliest.
+    while (aScheduler.GetNextDeadline() > otbr::GetNow())
+    {
+    }
+
+    aScheduler.Process(otbr::GetNow());
+}
+
+TEST(BackgroundScheduler, TestRoundRobin)
+{
+    otbr::TimerScheduler      scheduler(otbr::GetNow());
+    otbr::BackgroundScheduler background(UINT32_MAX, scheduler);
+    std::string               trace;
+    int                       first  = 3;
+    int                       second = 2;
+
+    background.Post([&trace, &first]() {
+        trace += 'a';
+        return --first == 0;
+    });
+    background.Post([&trace, &second]() {
+        trace += 'b';
+        return --second == 0;
+    });
+
+    RunSlice(scheduler);
+
+    // With an unlimited budget, one slice completes all the jobs.
+    STRCMP_EQUAL("ababa", trace.c_str());
+    CHECK_EQUAL(1, background.GetCounters().mSlices);
+    CHECK_EQUAL(5, background.GetCounters().mSteps);
+    CHECK_EQUAL(UINT64_MAX, scheduler.GetNextDeadline());
+}
+
+TEST(BackgroundScheduler, TestBudget)
+{
+    otbr::TimerScheduler      scheduler(otbr::GetNow());
+    otbr::BackgroundScheduler background(0, scheduler);
+    int                       remaining = 3;
+    uint32_t                  job;
+
+    job = background.Post([&remaining]() { return --remaining == 0; });
+
+    // Without a budget, a slice runs one step and the next slice waits for the next poll of the main loop.
+    RunSlice(scheduler);
+    CHECK_EQUAL(2, remaining);
+    CHECK_TRUE(background.IsPending(job));
+    CHECK_TRUE(scheduler.GetNextDeadline() != UINT64_MAX);
+
+    RunSlice(scheduler);
+    RunSlice(scheduler);
+    CHECK_EQUAL(0, remaining);
+    CHECK_FALSE(background.IsPending(job));
+    CHECK_EQUAL(3, background.GetCounters().mSlices);
+}
+
+TEST(BackgroundScheduler, TestYield)
+{
+    otbr::TimerScheduler      scheduler(otbr::GetNow());
+    otbr::BackgroundScheduler background(UINT32_MAX, scheduler);
+    bool                      busy  = true;
+    int                       steps = 0;
+
+    background.SetYieldCheck([&busy]() { return busy; });
+    background.Post([&steps]() {
+        ++steps;
+        return false;
+    });
+
+    // A job makes progress even when foreground work is always pending, the ninth slice runs a step then yields.
+    for (int i = 0; i < 9; i++)
+    {
+        RunSlice(scheduler);
+    }
+
+    CHECK_EQUAL(1, steps);
+    CHECK_EQUAL(9, background.GetCounters().mYields);
+
+    busy = false;
+    background.Post([&background]() {
+        background.Clear();
+        return false;
+    });
+    RunSlice(scheduler);
+
+    CHECK_EQUAL(2, steps);
+    CHECK_EQUAL(UINT64_MAX, scheduler.GetNextDeadline());
+}
+
+TEST(BackgroundScheduler, TestCancel)
+{
+    otbr::TimerScheduler      scheduler(otbr::GetNow());
+    otbr::BackgroundScheduler background(UINT32_MAX, scheduler);
+    int                       cancelledSteps = 0;
+    int                       selfSteps      = 0;
+    uint32_t                  cancelled;
+    uint32_t                  self;
+
+    cancelled = background.Post([&cancelledSteps]() {
+        ++cancelledSteps;
+        return false;
+    });
+    self      = background.Post([&background, &self, &selfSteps]() {
+        background.Cancel(self);
+        ++selfSteps;
+        return false;
+    });
+
+    background.Cancel(cancelled);
+    CHECK_FALSE(background.IsPending(cancelled));
+    CHECK_TRUE(background.IsPending(self));
+
+    RunSlice(scheduler);
+
+    CHECK_EQUAL(0, cancelledSteps);
+    CHECK_EQUAL(1, selfSteps);
+    CHECK_FALSE(background.IsPending(self));
+    background.Cancel(0);
+}
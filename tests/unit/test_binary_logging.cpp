@@ -0,0 +1,148 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/binary_logging.hpp"
+#include "common/logging.hpp"
+
+using otbr::BinaryLog::Conversion;
+using otbr::BinaryLog::NextConversion;
+using otbr::BinaryLog::Writer;
+
+TEST_GROUP(BinaryLog){};
+
+static void Record(Writer &aWriter, int aLevel, const char *aFormat, ...)
+{
+    va_list ap;
+
+    va_start(ap, aFormat);
+    aWriter.Record(aLevel, aFormat, ap);
+    va_end(ap);
+}
+
+static std::string Decode(const char *aFilename)
+{
+    std::string text;
+    FILE *      output = tmpfile();
+    char        line[256];
+
+    CHECK(output != NULL);
+    CHECK(otbr::BinaryLog::Decode(aFilename, output) == OTBR_ERROR_NONE);
+    rewind(output);
+
+    while (fgets(line, sizeof(line), output) != NULL)
+    {
+        // Skip the timestamp.
+        text += strchr(line, '|') + 2;
+    }
+
+    fclose(output);
+
+    return text;
+}
+
+TEST(BinaryLog, TestNextConversion)
+{
+    Conversion  conversion;
+    const char *cur = NextConversion("a %-*.*lu %% %zx %s %8.3Lf", conversion);
+
+    CHECK(cur != NULL);
+    CHECK_EQUAL(7U, conversion.mLength);
+    CHECK_EQUAL(2, conversion.mStars);
+    CHECK_EQUAL(otbr::BinaryLog::kArgLong, conversion.mType);
+
+    cur = NextConversion(cur, conversion);
+    CHECK_EQUAL(otbr::BinaryLog::kArgNone, conversion.mType);
+    cur = NextConversion(cur, conversion);
+    CHECK_EQUAL(otbr::BinaryLog::kArgSize, conversion.mType);
+    cur = NextConversion(cur, conversion);
+    CHECK_EQUAL(otbr::BinaryLog::kArgString, conversion.mType);
+    cur = NextConversion(cur, conversion);
+    CHECK_EQUAL(otbr::BinaryLog::kArgLongDouble, conversion.mType);
+    CHECK(NextConversion(cur, conversion) == NULL);
+}
+
+TEST(BinaryLog, TestRecordAndDecode)
+{
+    char   filename[] = "/tmp/otbr-test-binlog-XXXXXX";
+    int    fd         = mkstemp(filename);
+    Writer writer;
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    CHECK(writer.Open(filename, 16 * 1024) == OTBR_ERROR_NONE);
+    Record(writer, OTBR_LOG_INFO, "DTLS session ready in %u ms.", 42U);
+    Record(writer, OTBR_LOG_DEBUG, "%s: %*d|%-4s|%.2f|%lu%%", "name", 5, -3, "ab", 1.5, 123456789UL);
+    Record(writer, OTBR_LOG_ERR, "%s", static_cast<const char *>(NULL));
+    writer.Close();
+
+    STRCMP_EQUAL("INFO | DTLS session ready in 42 ms.\n"
+                 "DEBUG | name:    -3|ab  |1.50|123456789%\n"
+                 "ERR | (null)\n",
+                 Decode(filename).c_str());
+
+    unlink(filename);
+}
+
+TEST(BinaryLog, TestRingKeepsNewestRecords)
+{
+    char        filename[] = "/tmp/otbr-test-binlog-XXXXXX";
+    int         fd         = mkstemp(filename);
+    Writer      writer;
+    std::string text;
+    char        last[64];
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    CHECK(writer.Open(filename, 4096) == OTBR_ERROR_NONE);
+    for (int i = 0; i < 1000; i++)
+    {
+        Record(writer, OTBR_LOG_INFO, "record %d %s", i, "padding the record");
+    }
+    writer.Close();
+
+    text = Decode(filename);
+    sprintf(last, "INFO | record %d padding the record\n", 999);
+
+    CHECK(text.size() < 1000 * strlen(last));
+    CHECK(text.size() > strlen(last));
+    STRCMP_EQUAL(last, text.c_str() + text.size() - strlen(last));
+    CHECK(text.find("record 0 ") == std::string::npos);
+
+    unlink(filename);
+}
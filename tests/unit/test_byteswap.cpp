@@ -0,0 +1,66 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "common/byteswap.hpp"
+
+using namespace otbr::Encoding::BigEndian;
+
+TEST_GROUP(ByteSwap){};
+
+TEST(ByteSwap, TestReadIsBigEndian)
+{
+    static constexpr uint8_t kBytes[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+
+    static_assert(ReadUint64(kBytes) == 0x0123456789abcdefULL, "ReadUint64() is not usable as a constant");
+
+    CHECK_EQUAL(0x0123, ReadUint16(kBytes));
+    CHECK_EQUAL(0x89abcdef, ReadUint32(&kBytes[4]));
+    CHECK(ReadUint64(kBytes) == 0x0123456789abcdefULL);
+}
+
+TEST(ByteSwap, TestWriteRoundTrip)
+{
+    const uint8_t kExpected[] = {0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10};
+    uint8_t       bytes[sizeof(uint64_t)];
+
+    WriteUint64(0xfedcba9876543210ULL, bytes);
+    CHECK(memcmp(bytes, kExpected, sizeof(bytes)) == 0);
+    CHECK(ReadUint64(bytes) == 0xfedcba9876543210ULL);
+
+    WriteUint32(0x01020304, bytes);
+    CHECK_EQUAL(0x01, bytes[0]);
+    CHECK_EQUAL(0x04, bytes[3]);
+    CHECK_EQUAL(0x76, bytes[4]);
+
+    WriteUint16(0xa5b6, bytes);
+    CHECK_EQUAL(0xa5b6, ReadUint16(bytes));
+}
@@ -0,0 +1,79 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/channel_quality.hpp"
+
+TEST_GROUP(ChannelQuality){};
+
+TEST(ChannelQuality, TestScoresDecay)
+{
+    otbr::ChannelQuality quality;
+
+    CHECK(!quality.HasScore(11));
+    CHECK(!quality.HasScore(otbr::ChannelQuality::kMaxChannels));
+
+    quality.AddOccupancy(11, 0x8000);
+    CHECK(quality.HasScore(11));
+    CHECK_EQUAL(0x8000, quality.GetScore(11));
+
+    // Each new sample moves the score a quarter of the way.
+    quality.AddOccupancy(11, 0);
+    CHECK_EQUAL(0x6000, quality.GetScore(11));
+
+    for (int i = 0; i < 64; i++)
+    {
+        quality.AddOccupancy(11, 0);
+    }
+    CHECK(quality.GetScore(11) < 4);
+
+    quality.AddEnergy(12, -128);
+    CHECK_EQUAL(0, quality.GetScore(12));
+    quality.AddEnergy(13, -40);
+    CHECK_EQUAL(otbr::ChannelQuality::kMaxScore, quality.GetScore(13));
+    quality.AddEnergy(14, -70);
+    CHECK_EQUAL(otbr::ChannelQuality::kMaxScore / 2, quality.GetScore(14));
+
+    quality.AddOccupancy(otbr::ChannelQuality::kMaxChannels, 0);
+}
+
+TEST(ChannelQuality, TestLeastCongestedChannels)
+{
+    otbr::ChannelQuality quality;
+
+    CHECK_EQUAL(0x07fff800U, quality.GetLeastCongestedChannels(0x07fff800U));
+
+    quality.AddOccupancy(15, 0x1000);
+    quality.AddOccupancy(20, 0x1400);
+    quality.AddOccupancy(25, 0x8000);
+
+    CHECK_EQUAL((1U << 15) | (1U << 20), quality.GetLeastCongestedChannels(0x07fff800U));
+    CHECK_EQUAL(1U << 25, quality.GetLeastCongestedChannels(1U << 25));
+    CHECK_EQUAL(1U << 11, quality.GetLeastCongestedChannels(1U << 11));
+}
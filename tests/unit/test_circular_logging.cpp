@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/circular_logging.hpp"
+
+using otbr::CircularLog::Writer;
+
+TEST_GROUP(CircularLog){};
+
+static void Append(Writer &aWriter, const char *aLine)
+{
+    aWriter.Append(aLine, strlen(aLine));
+}
+
+static std::string Decode(const char *aFilename)
+{
+    std::string text;
+    FILE *      output = tmpfile();
+    char        line[256];
+
+    CHECK(output != NULL);
+    CHECK(otbr::CircularLog::Decode(aFilename, output) == OTBR_ERROR_NONE);
+    rewind(output);
+
+    while (fgets(line, sizeof(line), output) != NULL)
+    {
+        text += line;
+    }
+
+    fclose(output);
+
+    return text;
+}
+
+TEST(CircularLog, TestAppendAndDecode)
+{
+    char   filename[] = "/tmp/otbr-test-circlog-XXXXXX";
+    int    fd         = mkstemp(filename);
+    Writer writer;
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    CHECK(writer.Open(filename, 4096) == OTBR_ERROR_NONE);
+    Append(writer, "   0.001 | first\n");
+    Append(writer, "   0.002 | second\n");
+
+    // The log is readable while the writer is open, as after a crash.
+    STRCMP_EQUAL("   0.001 | first\n   0.002 | second\n", Decode(filename).c_str());
+    writer.Close();
+
+    STRCMP_EQUAL("   0.001 | first\n   0.002 | second\n", Decode(filename).c_str());
+
+    unlink(filename);
+}
+
+TEST(CircularLog, TestRingKeepsNewestLines)
+{
+    char        filename[] = "/tmp/otbr-test-circlog-XXXXXX";
+    int         fd         = mkstemp(filename);
+    Writer      writer;
+    std::string text;
+    char        line[64];
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    CHECK(writer.Open(filename, 1024) == OTBR_ERROR_NONE);
+    for (int i = 0; i < 1000; i++)
+    {
+        sprintf(line, "line %d padding the line\n", i);
+        Append(writer, line);
+    }
+    writer.Close();
+
+    text = Decode(filename);
+
+    CHECK(text.size() <= 1024);
+    CHECK(text.size() > strlen(line));
+    STRCMP_EQUAL(line, text.c_str() + text.size() - strlen(line));
+    CHECK_EQUAL(0U, text.find("line "));
+    CHECK(text.find("line 0 ") == std::string::npos);
+
+    unlink(filename);
+}
+
+TEST(CircularLog, TestDecodeRejectsOtherFiles)
+{
+    char filename[] = "/tmp/otbr-test-circlog-XXXXXX";
+    int  fd         = mkstemp(filename);
+
+    CHECK(fd >= 0);
+    CHECK(write(fd, "not a circular log, but long enough", 35) == 35);
+    close(fd);
+
+    CHECK(otbr::CircularLog::Decode(filename, stdout) == OTBR_ERROR_ERRNO);
+    CHECK_EQUAL(EINVAL, errno);
+
+    unlink(filename);
+}
@@ -0,0 +1,89 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include <string.h>
+#include <zlib.h>
+
+#include "web/web-service/compressor.hpp"
+
+using otbr::Web::Compressor;
+
+static std::string Inflate(const std::string &aCompressed, int aWindowBits)
+{
+    z_stream    stream;
+    std::string content(64 * 1024, '\0');
+
+    memset(&stream, 0, sizeof(stream));
+    CHECK_EQUAL(Z_OK, inflateInit2(&stream, aWindowBits));
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(aCompressed.data()));
+    stream.avail_in  = static_cast<uInt>(aCompressed.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&content[0]);
+    stream.avail_out = static_cast<uInt>(content.size());
+    CHECK_EQUAL(Z_STREAM_END, inflate(&stream, Z_FINISH));
+    content.resize(stream.total_out);
+    inflateEnd(&stream);
+
+    return content;
+}
+
+TEST_GROUP(Compressor){};
+
+TEST(Compressor, TestRoundTrip)
+{
+    Compressor  compressor;
+    std::string content;
+    std::string compressed;
+
+    for (int i = 0; i < 200; i++)
+    {
+        content += "{\"NetworkName\":\"OpenThread-" + std::to_string(i % 7) + "\",\"Channel\":15},";
+    }
+
+    // The same compressor is used again for each coding, as by the requests handled by a thread of the server.
+    for (int round = 0; round < 2; round++)
+    {
+        CHECK(compressor.Compress(Compressor::kCodingGzip, content, compressed));
+        CHECK(compressed.size() < content.size());
+        CHECK_EQUAL(0x1f, static_cast<uint8_t>(compressed[0]));
+        CHECK(Inflate(compressed, MAX_WBITS + 16) == content);
+
+        CHECK(compressor.Compress(Compressor::kCodingDeflate, content, compressed));
+        CHECK(compressed.size() < content.size());
+        CHECK(Inflate(compressed, MAX_WBITS) == content);
+    }
+
+    CHECK(compressor.Compress(Compressor::kCodingGzip, "", compressed));
+    CHECK(Inflate(compressed, MAX_WBITS + 16).empty());
+
+    STRCMP_EQUAL("gzip", Compressor::GetCodingName(Compressor::kCodingGzip));
+    STRCMP_EQUAL("deflate", Compressor::GetCodingName(Compressor::kCodingDeflate));
+}
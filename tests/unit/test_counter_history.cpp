@@ -0,0 +1,110 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/counter_history.hpp"
+
+TEST_GROUP(CounterHistory){};
+
+TEST(CounterHistory, TestFineRates)
+{
+    otbr::CounterHistory        history(/* aFineSlots */ 10, /* aCoarseSlots */ 4, /* aCoarseRatio */ 5);
+    otbr::CounterHistory::Rates rates;
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, history.GetRates(1000, rates));
+    CHECK_EQUAL(EAGAIN, errno);
+
+    // The first sample is only the baseline.
+    history.Sample(1000, 100);
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, history.GetRates(1000, rates));
+
+    // 1, 2, ..., 10 events per second.
+    for (uint32_t i = 1, value = 100; i <= 10; i++)
+    {
+        value += i;
+        history.Sample(1000 + i * 1000, value);
+    }
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(0, rates));
+    CHECK_EQUAL(1000, rates.mWindow);
+    CHECK_EQUAL(10000, rates.mMean);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(4000, rates));
+    CHECK_EQUAL(4000, rates.mWindow);
+    CHECK_EQUAL(34, rates.mDelta);
+    CHECK_EQUAL(8500, rates.mMean);
+    CHECK_EQUAL(7000, rates.mMin);
+    CHECK_EQUAL(10000, rates.mMax);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(60000, rates));
+    CHECK_EQUAL(10000, rates.mWindow);
+    CHECK_EQUAL(55, rates.mDelta);
+    CHECK_EQUAL(5500, rates.mMean);
+    CHECK_EQUAL(1000, rates.mMin);
+    CHECK_EQUAL(5000, rates.mP50);
+    CHECK_EQUAL(9000, rates.mP90);
+    CHECK_EQUAL(10000, rates.mP99);
+}
+
+TEST(CounterHistory, TestResetAndCoarseRates)
+{
+    otbr::CounterHistory        history(/* aFineSlots */ 4, /* aCoarseSlots */ 4, /* aCoarseRatio */ 2);
+    otbr::CounterHistory::Rates rates;
+
+    history.Sample(0, 10);
+    history.Sample(500, 12);
+
+    // A lower value means the counter was reset to zero in between.
+    history.Sample(1000, 3);
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(0, rates));
+    CHECK_EQUAL(6000, rates.mMean);
+
+    // Restarting drops the baseline, the gap is not an interval.
+    history.Restart();
+    history.Sample(100000, 1000);
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(60000, rates));
+    CHECK_EQUAL(1000, rates.mWindow);
+    CHECK_EQUAL(5, rates.mDelta);
+
+    for (uint32_t i = 1; i <= 6; i++)
+    {
+        history.Sample(100000 + i * 1000, 1000 + i);
+    }
+
+    // The fine ring keeps 4 seconds, the coarse one 8.
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(3000, rates));
+    CHECK_EQUAL(3000, rates.mWindow);
+    CHECK_EQUAL(OTBR_ERROR_NONE, history.GetRates(60000, rates));
+    CHECK_EQUAL(7000, rates.mWindow);
+    CHECK_EQUAL(11, rates.mDelta);
+    CHECK_EQUAL(1000, rates.mMin);
+    CHECK_EQUAL(5000, rates.mMax);
+}
@@ -1,5 +1,5 @@
 /*
- *    Copyright (c) 2017, The OpenThread Authors.
+ *    Copyright (c) 2020, The OpenThread Authors.
  *    All rights reserved.
  *
  *    Redistribution and use in source and binary forms, with or without
@@ -26,69 +26,47 @@
  *    POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "utils/event_emitter.hpp"
+#include <CppUTest/TestHarness.h>
 
-#include <assert.h>
+#include "utils/crc16.hpp"
 
-namespace otbr {
+TEST_GROUP(Crc16){};
 
-void EventEmitter::On(int aEvent, Callback aCallback, void *aContext)
+TEST(Crc16, TestCheckValues)
 {
-    assert(aCallback);
+    const uint8_t kCheck[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    otbr::Crc16   ccitt(otbr::Crc16::kCcitt);
+    otbr::Crc16   ansi(otbr::Crc16::kAnsi);
 
-    Handlers &handlers = mEvents[aEvent];
+    ccitt.Update(kCheck, sizeof(kCheck));
+    ansi.Update(kCheck, sizeof(kCheck));
 
-    handlers.push_back(Handler(aCallback, aContext));
+    CHECK_EQUAL(0x31c3, ccitt.Get());
+    CHECK_EQUAL(0xfee8, ansi.Get());
 }
 
-void EventEmitter::Off(int aEvent, Callback aCallback, void *aContext)
+TEST(Crc16, TestBufferMatchesBytes)
 {
-    assert(aCallback);
+    uint8_t     buffer[37];
+    otbr::Crc16 bytewise(otbr::Crc16::kAnsi);
+    otbr::Crc16 bufferwise(otbr::Crc16::kAnsi);
 
-    if (!mEvents.count(aEvent))
+    for (size_t i = 0; i < sizeof(buffer); i++)
     {
-        return;
+        buffer[i] = static_cast<uint8_t>(i * 37 + 11);
     }
 
-    Handler   handler  = Handler(aCallback, aContext);
-    Handlers &handlers = mEvents[aEvent];
-
-    for (Handlers::iterator it = handlers.begin(); it != handlers.end(); ++it)
+    for (size_t length = 0; length <= sizeof(buffer); length++)
     {
-        if (*it == handler)
+        bytewise.Init();
+        bufferwise.Init();
+
+        for (size_t i = 0; i < length; i++)
         {
-            handlers.erase(it);
-            if (handlers.empty())
-            {
-                mEvents.erase(aEvent);
-            }
-            break;
+            bytewise.Update(buffer[i]);
         }
-    }
-}
+        bufferwise.Update(buffer, length);
 
-void EventEmitter::Emit(int aEvent, ...)
-{
-    if (!mEvents.count(aEvent))
-    {
-        return;
+        CHECK_EQUAL(bytewise.Get(), bufferwise.Get());
     }
-
-    va_list args;
-    va_start(args, aEvent);
-    Handlers &handlers = mEvents[aEvent];
-
-    assert(!handlers.empty());
-
-    for (Handlers::iterator it = handlers.begin(); it != handlers.end(); ++it)
-    {
-        va_list tmpArgs;
-        va_copy(tmpArgs, args);
-        it->first(it->second, aEvent, tmpArgs);
-        va_end(tmpArgs);
-    }
-
-    va_end(args);
 }
-
-} // namespace otbr
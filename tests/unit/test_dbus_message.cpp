@@ -40,6 +40,8 @@ using std::vector;
 using otbr::DBus::DBusMessageEncode;
 using otbr::DBus::DBusMessageExtract;
 using otbr::DBus::DBusMessageToTuple;
+using otbr::DBus::DBusStructSignature;
+using otbr::DBus::DBusTypeTrait;
 using otbr::DBus::TupleToDBusMessage;
 
 struct TestStruct
@@ -96,6 +98,153 @@ bool operator==(const otbr::DBus::LeaderData &aLhs, const otbr::DBus::LeaderData
            aLhs.mLeaderRouterId == aRhs.mLeaderRouterId;
 }
 
+bool operator==(const otbr::DBus::MainloopCounters &aLhs, const otbr::DBus::MainloopCounters &aRhs)
+{
+    return aLhs.mWakeups == aRhs.mWakeups && aLhs.mZeroTimeoutPolls == aRhs.mZeroTimeoutPolls &&
+           aLhs.mSpuriousWakeups == aRhs.mSpuriousWakeups;
+}
+
+bool operator==(const otbr::DBus::DBusQueueCounters &aLhs, const otbr::DBus::DBusQueueCounters &aRhs)
+{
+    return aLhs.mOutgoingBytes == aRhs.mOutgoingBytes && aLhs.mPeakOutgoingBytes == aRhs.mPeakOutgoingBytes &&
+           aLhs.mCoalescedSignals == aRhs.mCoalescedSignals && aLhs.mDroppedSignals == aRhs.mDroppedSignals &&
+           aLhs.mThrottledRequests == aRhs.mThrottledRequests;
+}
+
+bool operator==(const otbr::DBus::OperationQueueCounters &aLhs, const otbr::DBus::OperationQueueCounters &aRhs)
+{
+    return aLhs.mDepth == aRhs.mDepth && aLhs.mPeakDepth == aRhs.mPeakDepth && aLhs.mQueued == aRhs.mQueued &&
+           aLhs.mMerged == aRhs.mMerged && aLhs.mRejected == aRhs.mRejected &&
+           aLhs.mTotalWaitTime == aRhs.mTotalWaitTime && aLhs.mMaxWaitTime == aRhs.mMaxWaitTime;
+}
+
+bool operator==(const otbr::DBus::JoinerCounters &aLhs, const otbr::DBus::JoinerCounters &aRhs)
+{
+    return aLhs.mCachedChannelAttempts == aRhs.mCachedChannelAttempts &&
+           aLhs.mCachedChannelJoins == aRhs.mCachedChannelJoins && aLhs.mFullDiscoveries == aRhs.mFullDiscoveries &&
+           aLhs.mLastCachedChannelTime == aRhs.mLastCachedChannelTime &&
+           aLhs.mLastFullDiscoveryTime == aRhs.mLastFullDiscoveryTime;
+}
+
+bool operator==(const otbr::DBus::AddressCacheCounters &aLhs, const otbr::DBus::AddressCacheCounters &aRhs)
+{
+    return aLhs.mQueries == aRhs.mQueries && aLhs.mResponses == aRhs.mResponses && aLhs.mFailures == aRhs.mFailures &&
+           aLhs.mEvictions == aRhs.mEvictions && aLhs.mPeakSize == aRhs.mPeakSize;
+}
+
+bool operator==(const otbr::DBus::OperationalDataset &aLhs, const otbr::DBus::OperationalDataset &aRhs)
+{
+    return aLhs.mActiveTimestamp == aRhs.mActiveTimestamp && aLhs.mPendingTimestamp == aRhs.mPendingTimestamp &&
+           aLhs.mMasterKey == aRhs.mMasterKey && aLhs.mNetworkName == aRhs.mNetworkName &&
+           aLhs.mExtendedPanId == aRhs.mExtendedPanId && aLhs.mMeshLocalPrefix == aRhs.mMeshLocalPrefix &&
+           aLhs.mDelay == aRhs.mDelay && aLhs.mPanId == aRhs.mPanId && aLhs.mChannel == aRhs.mChannel &&
+           aLhs.mPskc == aRhs.mPskc && aLhs.mSecurityPolicyRotationTime == aRhs.mSecurityPolicyRotationTime &&
+           aLhs.mSecurityPolicyFlags == aRhs.mSecurityPolicyFlags && aLhs.mChannelMask == aRhs.mChannelMask &&
+           aLhs.mComponents == aRhs.mComponents;
+}
+
+namespace otbr {
+namespace DBus {
+
+// Found by argument-dependent lookup when comparing vectors.
+bool operator==(const AddressCacheEntry &aLhs, const AddressCacheEntry &aRhs)
+{
+    return aLhs.mTarget == aRhs.mTarget && aLhs.mRloc16 == aRhs.mRloc16 && aLhs.mState == aRhs.mState;
+}
+
+bool operator==(const Ip6AddressInfo &aLhs, const Ip6AddressInfo &aRhs)
+{
+    return aLhs.mAddress == aRhs.mAddress && aLhs.mPrefixLength == aRhs.mPrefixLength &&
+           aLhs.mPreferred == aRhs.mPreferred && aLhs.mValid == aRhs.mValid && aLhs.mRloc == aRhs.mRloc;
+}
+
+bool operator==(const LogLevel &aLhs, const LogLevel &aRhs)
+{
+    return aLhs.mModule == aRhs.mModule && aLhs.mLevel == aRhs.mLevel;
+}
+
+bool operator==(const HistogramBucket &aLhs, const HistogramBucket &aRhs)
+{
+    return aLhs.mLowerBound == aRhs.mLowerBound && aLhs.mCount == aRhs.mCount;
+}
+
+bool operator==(const MainloopHistogram &aLhs, const MainloopHistogram &aRhs)
+{
+    return aLhs.mStage == aRhs.mStage && aLhs.mCount == aRhs.mCount && aLhs.mSum == aRhs.mSum &&
+           aLhs.mMax == aRhs.mMax && aLhs.mBuckets == aRhs.mBuckets;
+}
+
+bool operator==(const MemoryUsage &aLhs, const MemoryUsage &aRhs)
+{
+    return aLhs.mSubsystem == aRhs.mSubsystem && aLhs.mBytes == aRhs.mBytes && aLhs.mPeakBytes == aRhs.mPeakBytes &&
+           aLhs.mAllocations == aRhs.mAllocations && aLhs.mTotalAllocations == aRhs.mTotalAllocations;
+}
+
+bool operator==(const TopologyLink &aLhs, const TopologyLink &aRhs)
+{
+    return aLhs.mRloc16 == aRhs.mRloc16 && aLhs.mLinkQualityIn == aRhs.mLinkQualityIn &&
+           aLhs.mLinkQualityOut == aRhs.mLinkQualityOut;
+}
+
+bool operator==(const TopologyChild &aLhs, const TopologyChild &aRhs)
+{
+    return aLhs.mRloc16 == aRhs.mRloc16 && aLhs.mMode == aRhs.mMode;
+}
+
+bool operator==(const TopologyNode &aLhs, const TopologyNode &aRhs)
+{
+    return aLhs.mRloc16 == aRhs.mRloc16 && aLhs.mExtAddress == aRhs.mExtAddress && aLhs.mAge == aRhs.mAge &&
+           aLhs.mLinks == aRhs.mLinks && aLhs.mChildren == aRhs.mChildren;
+}
+
+bool operator==(const TableQuery &aLhs, const TableQuery &aRhs)
+{
+    return aLhs.mOffset == aRhs.mOffset && aLhs.mLimit == aRhs.mLimit && aLhs.mHasRloc16 == aRhs.mHasRloc16 &&
+           aLhs.mRloc16 == aRhs.mRloc16 && aLhs.mHasExtAddress == aRhs.mHasExtAddress &&
+           aLhs.mExtAddress == aRhs.mExtAddress && aLhs.mMinLinkQuality == aRhs.mMinLinkQuality &&
+           aLhs.mMaxLinkQuality == aRhs.mMaxLinkQuality;
+}
+
+bool operator==(const FlightRecord &aLhs, const FlightRecord &aRhs)
+{
+    return aLhs.mAge == aRhs.mAge && aLhs.mEvent == aRhs.mEvent && aLhs.mCode == aRhs.mCode &&
+           aLhs.mValue == aRhs.mValue && aLhs.mText == aRhs.mText;
+}
+
+bool operator==(const DBusCallStats &aLhs, const DBusCallStats &aRhs)
+{
+    return aLhs.mInterface == aRhs.mInterface && aLhs.mMember == aRhs.mMember && aLhs.mKind == aRhs.mKind &&
+           aLhs.mCalls == aRhs.mCalls && aLhs.mErrors == aRhs.mErrors && aLhs.mTotalTime == aRhs.mTotalTime &&
+           aLhs.mMaxTime == aRhs.mMaxTime;
+}
+
+bool operator==(const LinkAlertRule &aLhs, const LinkAlertRule &aRhs)
+{
+    return aLhs.mId == aRhs.mId && aLhs.mMetric == aRhs.mMetric && aLhs.mAbove == aRhs.mAbove &&
+           aLhs.mThreshold == aRhs.mThreshold && aLhs.mHysteresis == aRhs.mHysteresis;
+}
+
+bool operator==(const LinkAlert &aLhs, const LinkAlert &aRhs)
+{
+    return aLhs.mRuleId == aRhs.mRuleId && aLhs.mExtAddress == aRhs.mExtAddress && aLhs.mRaised == aRhs.mRaised &&
+           aLhs.mValue == aRhs.mValue;
+}
+
+bool operator==(const JoinerInfo &aLhs, const JoinerInfo &aRhs)
+{
+    return aLhs.mEui64 == aRhs.mEui64 && aLhs.mPskd == aRhs.mPskd && aLhs.mTimeout == aRhs.mTimeout;
+}
+
+bool operator==(const CounterRates &aLhs, const CounterRates &aRhs)
+{
+    return aLhs.mCounter == aRhs.mCounter && aLhs.mWindow == aRhs.mWindow && aLhs.mDelta == aRhs.mDelta &&
+           aLhs.mMean == aRhs.mMean && aLhs.mMin == aRhs.mMin && aLhs.mMax == aRhs.mMax && aLhs.mP50 == aRhs.mP50 &&
+           aLhs.mP90 == aRhs.mP90 && aLhs.mP99 == aRhs.mP99;
+}
+
+} // namespace DBus
+} // namespace otbr
+
 bool operator==(const otbr::DBus::ActiveScanResult &aLhs, const otbr::DBus::ActiveScanResult &aRhs)
 {
     return aLhs.mExtAddress == aRhs.mExtAddress && aLhs.mNetworkName == aRhs.mNetworkName &&
@@ -175,6 +324,82 @@ TEST(DBusMessage, TestVectorMessage)
     dbus_message_unref(msg);
 }
 
+TEST(DBusMessage, TestVectorMessageDecodedInPlace)
+{
+    DBusMessage *                     msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<vector<string>>             setVals({"hello", "world"});
+    tuple<vector<string>>             getVals({"previous", "decode", "of", "a", "longer", "table"});
+    tuple<vector<vector<TestStruct>>> setStructs({{{1, 0xf0a, "test1"}}, {}});
+    tuple<vector<vector<TestStruct>>> getStructs({{{2, 0xf0b, "test2"}, {3, 0xf0c, "test3"}}});
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+    CHECK(setVals == getVals);
+
+    dbus_message_unref(msg);
+    msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setStructs) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getStructs) == OTBR_ERROR_NONE);
+    CHECK(setStructs == getStructs);
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestFixedVectorMessage)
+{
+    DBusMessage *                                  msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<vector<int8_t>, vector<uint8_t>>         setVals({-1, 0, 1}, {});
+    tuple<vector<int8_t>, vector<uint8_t>>         getVals({}, {1, 2, 3});
+    tuple<vector<vector<uint8_t>>, vector<string>> setNested({{1, 2}, {}, {3}}, {"a", "b"});
+    tuple<vector<vector<uint8_t>>, vector<string>> getNested;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(setVals == getVals);
+
+    dbus_message_unref(msg);
+
+    msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setNested) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getNested) == OTBR_ERROR_NONE);
+
+    CHECK(setNested == getNested);
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestStringViewMessage)
+{
+    DBusMessage *         msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<string, string> setVals("io.openthread.BorderRouter", "Role");
+    DBusMessageIter       iter;
+    const char *          interfaceName = nullptr;
+    const char *          propertyName  = nullptr;
+    uint8_t               byte;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(dbus_message_iter_init(msg, &iter));
+    CHECK(DBusMessageExtract(&iter, interfaceName) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageExtract(&iter, propertyName) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageExtract(&iter, byte) != OTBR_ERROR_NONE);
+
+    STRCMP_EQUAL("io.openthread.BorderRouter", interfaceName);
+    STRCMP_EQUAL("Role", propertyName);
+
+    dbus_message_unref(msg);
+}
+
 TEST(DBusMessage, TestArrayMessage)
 {
     DBusMessage *            msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
@@ -228,6 +453,17 @@ TEST(DBusMessage, TestStructMessage)
     dbus_message_unref(msg);
 }
 
+TEST(DBusMessage, TestCompositeSignatures)
+{
+    STRCMP_EQUAL("ay", DBusTypeTrait<vector<uint8_t>>::TYPE_AS_STRING);
+    STRCMP_EQUAL("as", DBusTypeTrait<vector<string>>::TYPE_AS_STRING);
+    STRCMP_EQUAL("((ayy)qybb)", DBusTypeTrait<otbr::DBus::ExternalRoute>::TYPE_AS_STRING);
+    STRCMP_EQUAL("(yya(((ayy)y(bbbbbbb))q)a((ayy)qybb)a(uyayqayb))",
+                 DBusTypeTrait<otbr::DBus::NetworkDataInfo>::TYPE_AS_STRING);
+    STRCMP_EQUAL("a(qtua(qyy)a(qy))", DBusTypeTrait<vector<otbr::DBus::TopologyNode>>::TYPE_AS_STRING);
+    STRCMP_EQUAL("(qas)", (DBusStructSignature<uint16_t, vector<string>>::kValue));
+}
+
 TEST(DBusMessage, TestOtbrChannelQuality)
 {
     DBusMessage *                                  msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
@@ -294,6 +530,308 @@ TEST(DBusMessage, TestOtbrLeaderData)
     dbus_message_unref(msg);
 }
 
+TEST(DBusMessage, TestOtbrMainloopCounters)
+{
+    DBusMessage *                                    msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::MainloopCounters>> setVals({{1, 2, UINT64_MAX}});
+    tuple<std::vector<otbr::DBus::MainloopCounters>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals)[0] == std::get<0>(getVals)[0]);
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrDBusQueueCounters)
+{
+    DBusMessage *                        msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<otbr::DBus::DBusQueueCounters> setVals({1, 2, 3, UINT32_MAX, 5});
+    tuple<otbr::DBus::DBusQueueCounters> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrOperationQueueCounters)
+{
+    DBusMessage *                             msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<otbr::DBus::OperationQueueCounters> setVals({1, 2, 3, 4, 5, UINT32_MAX, 7});
+    tuple<otbr::DBus::OperationQueueCounters> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrJoinerCounters)
+{
+    DBusMessage *                     msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<otbr::DBus::JoinerCounters> setVals({1, 2, 3, UINT32_MAX, 5});
+    tuple<otbr::DBus::JoinerCounters> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrAddressCache)
+{
+    DBusMessage *msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::AddressCacheEntry>, otbr::DBus::AddressCacheCounters> setVals(
+        {{{0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}, 0x0400, 0},
+         {{0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02}, 0xfffe, 3}},
+        {1, 2, 3, 4, UINT32_MAX});
+    tuple<std::vector<otbr::DBus::AddressCacheEntry>, otbr::DBus::AddressCacheCounters> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+    CHECK(std::get<1>(setVals) == std::get<1>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrLogLevels)
+{
+    DBusMessage *                            msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::LogLevel>> setVals({{"default", 6}, {"mdns", 7}, {"dtls", -1}});
+    tuple<std::vector<otbr::DBus::LogLevel>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrOperationalDataset)
+{
+    DBusMessage *                         msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<otbr::DBus::OperationalDataset> setVals({1,
+                                                   2,
+                                                   {0x00, 0x11, 0x22, 0x33},
+                                                   "OpenThread",
+                                                   0xdead00beef00cafe,
+                                                   {0xfd, 0x00, 0x0d, 0xb8},
+                                                   3000,
+                                                   0xface,
+                                                   15,
+                                                   {0x44, 0x55},
+                                                   672,
+                                                   0xff,
+                                                   0x07fff800,
+                                                   0xfff});
+    tuple<otbr::DBus::OperationalDataset> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrIp6Addresses)
+{
+    DBusMessage *msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::Ip6AddressInfo>, std::vector<std::vector<uint8_t>>> setVals(
+        {{{0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xfe, 0, 0xfc, 0x00}, 64, true, true, true},
+         {{0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0}, 64, false, true, false}},
+        {{0xff, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}});
+    tuple<std::vector<otbr::DBus::Ip6AddressInfo>, std::vector<std::vector<uint8_t>>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+    CHECK(std::get<1>(setVals) == std::get<1>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrMainloopHistograms)
+{
+    DBusMessage *                                     msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::MainloopHistogram>> setVals(
+        {{"a", 3, 30, 20, {{4, 1}, {20, 2}}}, {"b", 0, 0, 0, {}}});
+    tuple<std::vector<otbr::DBus::MainloopHistogram>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrMemoryUsage)
+{
+    DBusMessage *                               msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::MemoryUsage>> setVals({{"Dtls", 4096, 8192, 3, 10}, {"Timers", 0, 0, 0, 0}});
+    tuple<std::vector<otbr::DBus::MemoryUsage>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrLinkAlerts)
+{
+    DBusMessage *msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::LinkAlertRule>, std::vector<otbr::DBus::LinkAlert>> setVals(
+        {{1, "Rssi", false, -80, 5}, {2, "FrameErrorRate", true, 0x1000, 0x100}},
+        {{1, 0x18b4300000000001, true, -81}, {2, 0, false, 0x0f00}});
+    tuple<std::vector<otbr::DBus::LinkAlertRule>, std::vector<otbr::DBus::LinkAlert>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+    CHECK(std::get<1>(setVals) == std::get<1>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrCounterRates)
+{
+    DBusMessage *                                msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::CounterRates>> setVals(
+        {{"a", 60000, 120, 2000, 0, 10000, 1000, 5000, 10000}, {"b", 1000, 0, 0, 0, 0, 0, 0, 0}});
+    tuple<std::vector<otbr::DBus::CounterRates>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrTopologyNodes)
+{
+    DBusMessage *                                msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::TopologyNode>> setVals(
+        {{0x0400, 1, 2, {{0x0800, 3, 2}}, {{0x0401, 15}, {0x0402, 4}}}, {0x0800, 3, 4, {}, {}}});
+    tuple<std::vector<otbr::DBus::TopologyNode>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrTableQuery)
+{
+    DBusMessage *                 msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<otbr::DBus::TableQuery> setVals({10, 5, true, 0x0401, false, 0x18b4300000000001, 1, 3});
+    tuple<otbr::DBus::TableQuery> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrFlightRecords)
+{
+    DBusMessage *                                msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::FlightRecord>> setVals(
+        {{1500, "DBusCall", 0, 250, "GetProperties"}, {20, "StateChanged", 0, 0x1001, ""}});
+    tuple<std::vector<otbr::DBus::FlightRecord>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrDBusCallStats)
+{
+    DBusMessage *                                 msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::DBusCallStats>> setVals(
+        {{"io.openthread.BorderRouter", "Scan", otbr::DBus::OTBR_DBUS_CALL_METHOD, 3, 1, 0x100000000, 250},
+         {"io.openthread.BorderRouter", "ChildTable", otbr::DBus::OTBR_DBUS_CALL_GET_PROPERTY, UINT32_MAX, 0, 12, 7}});
+    tuple<std::vector<otbr::DBus::DBusCallStats>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
+TEST(DBusMessage, TestOtbrJoinerInfos)
+{
+    DBusMessage *                              msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    tuple<std::vector<otbr::DBus::JoinerInfo>> setVals({{0x18b4300000000001, "J01NME", 120}, {0, "J01NU5", 60}});
+    tuple<std::vector<otbr::DBus::JoinerInfo>> getVals;
+
+    CHECK(msg != NULL);
+
+    CHECK(TupleToDBusMessage(*msg, setVals) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK(std::get<0>(setVals) == std::get<0>(getVals));
+
+    dbus_message_unref(msg);
+}
+
 TEST(DBusMessage, TestOtbrActiveScanResults)
 {
     DBusMessage *                                    msg = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
@@ -327,3 +865,50 @@ TEST(DBusMessage, TestOtbrExternalRoute)
 
     dbus_message_unref(msg);
 }
+
+TEST(DBusMessage, TestOtbrNetworkDataInfo)
+{
+    DBusMessage *                       msg          = dbus_message_new(DBUS_MESSAGE_TYPE_METHOD_RETURN);
+    otbr::DBus::NetworkDataInfo         setInfo;
+    otbr::DBus::BorderRouterEntry       borderRouter = {};
+    otbr::DBus::ServiceEntry            service;
+    tuple<otbr::DBus::NetworkDataInfo>  getVals;
+    const otbr::DBus::NetworkDataInfo & getInfo      = std::get<0>(getVals);
+    const otbr::DBus::Ip6Prefix         prefix({{0xfd, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06}, 64});
+
+    CHECK(msg != NULL);
+
+    borderRouter.mConfig.mPrefix = prefix;
+    borderRouter.mConfig.mSlaac  = true;
+    borderRouter.mRloc16         = 0x5400;
+    service.mEnterpriseNumber    = 44970;
+    service.mServiceId           = 1;
+    service.mServiceData         = {0x5c};
+    service.mServerRloc16        = 0x5400;
+    service.mServerData          = {0xab, 0xcd};
+    service.mStable              = true;
+    setInfo.mVersion             = 10;
+    setInfo.mStableVersion       = 3;
+    setInfo.mOnMeshPrefixes      = {borderRouter};
+    setInfo.mExternalRoutes      = {{prefix, uint16_t(0x5400), 1, true, false}};
+    setInfo.mServices            = {service};
+
+    CHECK(TupleToDBusMessage(*msg, std::make_tuple(setInfo)) == OTBR_ERROR_NONE);
+    CHECK(DBusMessageToTuple(*msg, getVals) == OTBR_ERROR_NONE);
+
+    CHECK_EQUAL(10, getInfo.mVersion);
+    CHECK_EQUAL(3, getInfo.mStableVersion);
+    CHECK_EQUAL(1U, getInfo.mOnMeshPrefixes.size());
+    CHECK(getInfo.mOnMeshPrefixes[0].mConfig.mPrefix == prefix);
+    CHECK(getInfo.mOnMeshPrefixes[0].mConfig.mSlaac);
+    CHECK_EQUAL(0x5400, getInfo.mOnMeshPrefixes[0].mRloc16);
+    CHECK_EQUAL(1U, getInfo.mExternalRoutes.size());
+    CHECK(getInfo.mExternalRoutes[0] == setInfo.mExternalRoutes[0]);
+    CHECK_EQUAL(1U, getInfo.mServices.size());
+    CHECK_EQUAL(44970U, getInfo.mServices[0].mEnterpriseNumber);
+    CHECK(getInfo.mServices[0].mServiceData == service.mServiceData);
+    CHECK(getInfo.mServices[0].mServerData == service.mServerData);
+    CHECK(getInfo.mServices[0].mStable);
+
+    dbus_message_unref(msg);
+}
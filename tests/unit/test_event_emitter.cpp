@@ -29,36 +29,36 @@
 #include "utils/event_emitter.hpp"
 
 #include <CppUTest/TestHarness.h>
-#include <stdarg.h>
+
+enum
+{
+    kEventSingle,
+    kEventContexts,
+    kEventValue,
+};
+
+typedef otbr::EventEmitter<otbr::Event<>, otbr::Event<void *, void *>, otbr::Event<int>> TestEmitter;
 
 static int   sCounter = 0;
-static int   sEvent   = 0;
 static void *sContext = NULL;
 
-static void HandleSingleEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleSingleEvent(void *aContext)
 {
     sCounter++;
 
     CHECK_EQUAL(sContext, aContext);
-    CHECK_EQUAL(sEvent, aEvent);
-    (void)aArguments;
 }
 
-static void HandleTestDifferentContextEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleTestDifferentContextEvent(void *aContext, void *aContext1, void *aContext2)
 {
-    void *context1 = va_arg(aArguments, void *);
-    void *context2 = va_arg(aArguments, void *);
-
-    CHECK_EQUAL(sEvent, aEvent);
-
     int id = *static_cast<int *>(aContext);
     if (id == 1)
     {
-        CHECK_EQUAL(context1, aContext);
+        CHECK_EQUAL(aContext1, aContext);
     }
     else if (id == 2)
     {
-        CHECK_EQUAL(context2, aContext);
+        CHECK_EQUAL(aContext2, aContext);
     }
     else
     {
@@ -68,112 +68,144 @@ static void HandleTestDifferentContextEvent(void *aContext, int aEvent, va_list
     sCounter++;
 }
 
-static void HandleTestCallSequenceEvent(void *aContext, int aEvent, va_list aArguments)
+static void HandleTestCallSequenceEvent(void *aContext)
 {
-    CHECK_EQUAL(sEvent, aEvent);
-
     int id = *static_cast<int *>(aContext);
 
     ++sCounter;
 
     CHECK_EQUAL(sCounter, id);
+}
 
-    (void)aArguments;
+static void HandleValueEvent(void *aContext, int aValue)
+{
+    *static_cast<int *>(aContext) = aValue;
 }
 
 TEST_GROUP(EventEmitter){};
 
 TEST(EventEmitter, TestSingleHandler)
 {
-    otbr::EventEmitter ee;
-    int                event = 1;
-    ee.On(event, HandleSingleEvent, NULL);
+    TestEmitter ee;
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
 
     CHECK_EQUAL(1, sCounter);
 }
 
 TEST(EventEmitter, TestDoubleHandler)
 {
-    otbr::EventEmitter ee;
-    int                event = 1;
-    ee.On(event, HandleSingleEvent, NULL);
-    ee.On(event, HandleSingleEvent, NULL);
+    TestEmitter ee;
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestDifferentContext)
 {
-    otbr::EventEmitter ee;
-    int                event = 2;
+    TestEmitter ee;
 
     int context1 = 1;
     int context2 = 2;
 
-    ee.On(event, HandleTestDifferentContextEvent, &context1);
-    ee.On(event, HandleTestDifferentContextEvent, &context2);
+    ee.On<kEventContexts>(HandleTestDifferentContextEvent, &context1);
+    ee.On<kEventContexts>(HandleTestDifferentContextEvent, &context2);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event, &context1, &context2);
+    ee.Emit<kEventContexts>(&context1, &context2);
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestCallSequence)
 {
-    otbr::EventEmitter ee;
-    int                event = 3;
+    TestEmitter ee;
 
     int context1 = 1;
     int context2 = 2;
 
-    ee.On(event, HandleTestCallSequenceEvent, &context1);
-    ee.On(event, HandleTestCallSequenceEvent, &context2);
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context1);
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context2);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
 
     CHECK_EQUAL(2, sCounter);
 }
 
 TEST(EventEmitter, TestRemoveHandler)
 {
-    otbr::EventEmitter ee;
-    int                event = 3;
+    TestEmitter ee;
 
-    ee.On(event, HandleSingleEvent, NULL);
-    ee.On(event, HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
 
     sContext = NULL;
-    sEvent   = event;
     sCounter = 0;
 
-    ee.Emit(event);
+    ee.Emit<kEventSingle>();
     CHECK_EQUAL(2, sCounter);
 
-    ee.Off(event, HandleSingleEvent, NULL);
-    ee.Emit(event);
+    ee.Off<kEventSingle>(HandleSingleEvent, NULL);
+    ee.Emit<kEventSingle>();
     CHECK_EQUAL(3, sCounter);
 
-    ee.Off(event, HandleSingleEvent, NULL);
-    ee.Emit(event);
+    ee.Off<kEventSingle>(HandleSingleEvent, NULL);
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(3, sCounter);
+}
+
+TEST(EventEmitter, TestRemoveKeepsOrder)
+{
+    TestEmitter ee;
+
+    int context1 = 1;
+    int context2 = 2;
+    int context3 = 3;
+
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context1);
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context3);
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context2);
+    ee.Off<kEventSingle>(HandleTestCallSequenceEvent, &context3);
+    ee.On<kEventSingle>(HandleTestCallSequenceEvent, &context3);
+
+    sCounter = 0;
+
+    ee.Emit<kEventSingle>();
+
     CHECK_EQUAL(3, sCounter);
 }
+
+TEST(EventEmitter, TestEventsAreIndependent)
+{
+    TestEmitter ee;
+    int         value = 0;
+
+    ee.On<kEventSingle>(HandleSingleEvent, NULL);
+    ee.On<kEventValue>(HandleValueEvent, &value);
+
+    sContext = NULL;
+    sCounter = 0;
+
+    ee.Emit<kEventValue>(42);
+    CHECK_EQUAL(0, sCounter);
+    CHECK_EQUAL(42, value);
+
+    ee.Emit<kEventSingle>();
+    CHECK_EQUAL(1, sCounter);
+    CHECK_EQUAL(42, value);
+}
@@ -0,0 +1,109 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "common/flight_recorder.hpp"
+
+TEST_GROUP(FlightRecorder){};
+
+TEST(FlightRecorder, TestRecord)
+{
+    std::vector<otbr::FlightRecord> records;
+
+    otbr::RecordFlightEvent(otbr::kFlightEventStateChanged, 0, 0x1234);
+    otbr::RecordFlightEvent(otbr::kFlightEventDBusCall, 1, 250, "GetPropertiesOfAVeryLongMethodName");
+    otbr::GetFlightRecords(records);
+
+    CHECK_TRUE(records.size() >= 2);
+
+    const otbr::FlightRecord &state = records[records.size() - 2];
+    const otbr::FlightRecord &call  = records[records.size() - 1];
+
+    CHECK_EQUAL(otbr::kFlightEventStateChanged, state.mEvent);
+    CHECK_EQUAL(0x1234, state.mValue);
+    STRCMP_EQUAL("", state.mText.c_str());
+    CHECK_TRUE(state.mAge < 1000);
+
+    CHECK_EQUAL(otbr::kFlightEventDBusCall, call.mEvent);
+    CHECK_EQUAL(1, call.mCode);
+    CHECK_EQUAL(250, call.mValue);
+    STRCMP_EQUAL("GetPropertiesOfAVeryLon", call.mText.c_str());
+
+    STRCMP_EQUAL("DBusCall", otbr::GetFlightEventName(otbr::kFlightEventDBusCall));
+}
+
+TEST(FlightRecorder, TestWrap)
+{
+    std::vector<otbr::FlightRecord> records;
+
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        otbr::RecordFlightEvent(otbr::kFlightEventMdnsPublished, 0, i);
+    }
+
+    otbr::GetFlightRecords(records);
+
+    // Only the most recent records are kept, in order.
+    CHECK_TRUE(records.size() > 0 && records.size() < 5000);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        CHECK_EQUAL(5000 - records.size() + i, records[i].mValue);
+    }
+}
+
+TEST(FlightRecorder, TestSaveRestore)
+{
+    std::vector<otbr::FlightRecord> records;
+    std::string                     saved;
+
+    otbr::RecordFlightEvent(otbr::kFlightEventRadioReset, 0, 7);
+    otbr::RecordFlightEvent(otbr::kFlightEventDtlsState, 2, 9, "session");
+    otbr::SaveFlightRecords(saved);
+
+    // The restored records follow the ones recorded since, as they would in a new agent.
+    otbr::RecordFlightEvent(otbr::kFlightEventMdnsPublished, 0, 11);
+    CHECK_TRUE(otbr::RestoreFlightRecords(saved));
+    otbr::GetFlightRecords(records);
+
+    const otbr::FlightRecord &reset = records[records.size() - 2];
+    const otbr::FlightRecord &dtls  = records[records.size() - 1];
+
+    CHECK_EQUAL(otbr::kFlightEventRadioReset, reset.mEvent);
+    CHECK_EQUAL(7, reset.mValue);
+    CHECK_EQUAL(otbr::kFlightEventDtlsState, dtls.mEvent);
+    CHECK_EQUAL(2, dtls.mCode);
+    CHECK_EQUAL(9, dtls.mValue);
+    STRCMP_EQUAL("session", dtls.mText.c_str());
+    CHECK_TRUE(dtls.mAge < 1000);
+
+    saved.resize(saved.size() - 1);
+    CHECK_FALSE(otbr::RestoreFlightRecords(saved));
+}
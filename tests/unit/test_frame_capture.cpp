@@ -0,0 +1,141 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+#include <thread>
+
+#include <string.h>
+#include <unistd.h>
+
+#include "common/frame_capture.hpp"
+
+TEST_GROUP(FrameCapture){};
+
+TEST(FrameCapture, TestReadWrite)
+{
+    static const uint8_t     kFrame[] = {0x41, 0xd8, 0x01, 0xce, 0xfa, 0xff, 0xff, 0x00, 0x00};
+    std::string              name     = "/otbr-test-frame-capture-" + std::to_string(getpid());
+    otbr::FrameCaptureWriter writer;
+    otbr::FrameCaptureReader reader;
+    const otbr::FrameRecord *record;
+
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_ERRNO);
+
+    CHECK(writer.Open(name.c_str(), 2) == OTBR_ERROR_NONE);
+    writer.Append(kFrame, sizeof(kFrame), 11, -70, false);
+
+    // Frames captured before the reader are not read.
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_NONE);
+    CHECK(reader.Peek() == nullptr);
+
+    writer.Append(kFrame, sizeof(kFrame), 15, -60, false);
+    writer.Append(kFrame, 5, 15, 127, true);
+    writer.Append(kFrame, sizeof(kFrame), 15, -50, false);
+    CHECK_EQUAL(1, reader.GetDroppedFrames());
+
+    record = reader.Peek();
+    CHECK(record != nullptr);
+    CHECK_EQUAL(sizeof(kFrame), record->mLength);
+    CHECK_EQUAL(15, record->mChannel);
+    CHECK_EQUAL(-60, record->mRssi);
+    CHECK_EQUAL(0, record->mFlags);
+    CHECK(record->mTimestamp > 0);
+    MEMCMP_EQUAL(kFrame, record->mPsdu, sizeof(kFrame));
+
+    // The record stays in place until consumed.
+    CHECK(reader.Peek() == record);
+    reader.Consume();
+
+    record = reader.Peek();
+    CHECK(record != nullptr);
+    CHECK_EQUAL(5, record->mLength);
+    CHECK_EQUAL(127, record->mRssi);
+    CHECK_EQUAL(otbr::FrameRecord::kFlagTx, record->mFlags);
+    reader.Consume();
+
+    CHECK(reader.Peek() == nullptr);
+    writer.Append(kFrame, sizeof(kFrame), 15, -50, false);
+    CHECK(reader.Peek() != nullptr);
+    CHECK_EQUAL(1, reader.GetDroppedFrames());
+
+    // The ring is removed along with the writer, an open reader keeps its mapping.
+    writer.Close();
+    CHECK(reader.Peek() != nullptr);
+    reader.Close();
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_ERRNO);
+}
+
+TEST(FrameCapture, TestConcurrentReadWrite)
+{
+    static const uint32_t    kFrames = 100000;
+    std::string              name    = "/otbr-test-frame-capture-" + std::to_string(getpid());
+    otbr::FrameCaptureWriter writer;
+    otbr::FrameCaptureReader reader;
+    uint32_t                 read       = 0;
+    uint32_t                 last       = 0;
+    bool                     consistent = true;
+
+    CHECK(writer.Open(name.c_str(), 64) == OTBR_ERROR_NONE);
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_NONE);
+
+    std::thread writerThread([&writer]() {
+        for (uint32_t i = 1; i <= kFrames; i++)
+        {
+            uint8_t frame[otbr::FrameRecord::kMaxPsduSize];
+
+            memset(frame, static_cast<uint8_t>(i), sizeof(frame));
+            memcpy(frame, &i, sizeof(i));
+            writer.Append(frame, sizeof(frame), 11, 0, false);
+        }
+    });
+
+    // Every frame is either read in order and intact, or counted as dropped.
+    while (read + reader.GetDroppedFrames() != kFrames)
+    {
+        const otbr::FrameRecord *record = reader.Peek();
+        uint32_t                 sequence;
+
+        if (record == nullptr)
+        {
+            continue;
+        }
+
+        memcpy(&sequence, record->mPsdu, sizeof(sequence));
+        consistent = consistent && sequence > last &&
+                     record->mPsdu[otbr::FrameRecord::kMaxPsduSize - 1] == static_cast<uint8_t>(sequence);
+        last = sequence;
+        read++;
+        reader.Consume();
+    }
+
+    writerThread.join();
+    CHECK(consistent);
+    CHECK(read > 0);
+}
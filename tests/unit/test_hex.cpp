@@ -0,0 +1,72 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/hex.hpp"
+
+TEST_GROUP(Hex){};
+
+TEST(Hex, TestHex2Bytes)
+{
+    uint8_t bytes[4];
+    uint8_t expected[] = {0x0a, 0xbc, 0xde, 0xf9};
+
+    CHECK_EQUAL(4, otbr::Utils::Hex2Bytes("0aBcDef9", bytes, sizeof(bytes)));
+    MEMCMP_EQUAL(expected, bytes, sizeof(expected));
+
+    CHECK_EQUAL(4, otbr::Utils::Hex2Bytes("aBcDef9", bytes, sizeof(bytes)));
+    MEMCMP_EQUAL(expected, bytes, sizeof(expected));
+
+    CHECK_EQUAL(2, otbr::Utils::Hex2Bytes("0abcxyz", 4, bytes, sizeof(bytes)));
+    MEMCMP_EQUAL(expected, bytes, 2);
+
+    CHECK_EQUAL(0, otbr::Utils::Hex2Bytes("", bytes, sizeof(bytes)));
+    CHECK_EQUAL(-1, otbr::Utils::Hex2Bytes("0abcdef901", bytes, sizeof(bytes)));
+    CHECK_EQUAL(-1, otbr::Utils::Hex2Bytes("0abcdeg9", bytes, sizeof(bytes)));
+    CHECK_EQUAL(-1, otbr::Utils::Hex2Bytes("0a:b", bytes, sizeof(bytes)));
+}
+
+TEST(Hex, TestBytes2Hex)
+{
+    const uint8_t bytes[] = {0x0a, 0xbc, 0xde, 0xf9};
+    char          hex[sizeof(bytes) * 2 + 1];
+    char          longHex[sizeof(uint64_t) * 2 + 1];
+
+    CHECK_EQUAL(8, otbr::Utils::Bytes2Hex(bytes, sizeof(bytes), hex));
+    STRCMP_EQUAL("0ABCDEF9", hex);
+
+    CHECK_EQUAL(8, otbr::Utils::Bytes2Hex(bytes, sizeof(bytes), hex, sizeof(hex), true));
+    STRCMP_EQUAL("0abcdef9", hex);
+
+    CHECK_EQUAL(0, otbr::Utils::Bytes2Hex(bytes, sizeof(bytes), hex, sizeof(hex) - 1));
+    STRCMP_EQUAL("", hex);
+
+    CHECK_EQUAL(16, otbr::Utils::Long2Hex(0x0123456789abcdefULL, longHex));
+    STRCMP_EQUAL("EFCDAB8967452301", longHex);
+}
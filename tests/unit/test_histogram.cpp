@@ -0,0 +1,118 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <CppUTest/TestHarness.h>
+
+#include <unistd.h>
+
+#include "common/histogram.hpp"
+#include "common/mainloop_stats.hpp"
+
+TEST_GROUP(Histogram){};
+
+TEST(Histogram, TestBucketBounds)
+{
+    CHECK_EQUAL(0, otbr::Histogram::GetBucketIndex(0));
+    CHECK_EQUAL(3, otbr::Histogram::GetBucketIndex(3));
+    CHECK_EQUAL(otbr::Histogram::kBuckets - 1, otbr::Histogram::GetBucketIndex(UINT32_MAX));
+
+    for (uint8_t i = 0; i < otbr::Histogram::kBuckets; i++)
+    {
+        uint32_t lower = otbr::Histogram::GetBucketLowerBound(i);
+
+        CHECK_EQUAL(i, otbr::Histogram::GetBucketIndex(lower));
+
+        if (i > 0)
+        {
+            CHECK_EQUAL(i - 1, otbr::Histogram::GetBucketIndex(lower - 1));
+        }
+    }
+}
+
+TEST(Histogram, TestRecord)
+{
+    otbr::Histogram histogram;
+
+    histogram.Record(1);
+    histogram.Record(9);
+    histogram.Record(9);
+    histogram.Record(1000);
+
+    CHECK_EQUAL(4, histogram.GetCount());
+    CHECK_EQUAL(1019, histogram.GetSum());
+    CHECK_EQUAL(1000, histogram.GetMax());
+    CHECK_EQUAL(1, histogram.GetBucketCount(otbr::Histogram::GetBucketIndex(1)));
+    CHECK_EQUAL(2, histogram.GetBucketCount(otbr::Histogram::GetBucketIndex(8)));
+    CHECK_EQUAL(1, histogram.GetBucketCount(otbr::Histogram::GetBucketIndex(1000)));
+
+    histogram.Clear();
+    CHECK_EQUAL(0, histogram.GetCount());
+    CHECK_EQUAL(0, histogram.GetMax());
+}
+
+TEST(Histogram, TestMainloopStage)
+{
+    otbr::Histogram &histogram = otbr::GetMainloopHistogram(otbr::kMainloopStageTimers);
+    uint64_t         count     = histogram.GetCount();
+
+    {
+        otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageTimers);
+    }
+
+    CHECK_EQUAL(count + 1, histogram.GetCount());
+    STRCMP_EQUAL("Timers", otbr::GetMainloopStageName(otbr::kMainloopStageTimers));
+}
+
+TEST(Histogram, TestMainloopStall)
+{
+    uint32_t stalls    = otbr::GetMainloopStalls();
+    uint64_t stallTime = otbr::GetMainloopStallTime();
+
+    {
+        otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageAgentProcess);
+
+        {
+            otbr::MainloopStageTimer nestedTimer(otbr::kMainloopStageMdnsProcess);
+        }
+
+        {
+            otbr::MainloopStageTimer nestedTimer(otbr::kMainloopStageUbusRequest);
+
+            usleep(600000);
+        }
+    }
+
+    // Only the innermost stage is reported, and the outermost accounts for the stall time.
+    CHECK_EQUAL(stalls + 1, otbr::GetMainloopStalls());
+    CHECK(otbr::GetMainloopStallTime() - stallTime >= 600000);
+
+    {
+        otbr::MainloopStageTimer stageTimer(otbr::kMainloopStageTimers);
+    }
+
+    CHECK_EQUAL(stalls + 1, otbr::GetMainloopStalls());
+}
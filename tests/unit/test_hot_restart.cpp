@@ -0,0 +1,125 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+#include <thread>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/hot_restart.hpp"
+
+TEST_GROUP(HotRestart){};
+
+TEST(HotRestart, TestSnapshot)
+{
+    otbr::HotRestartSnapshot sent;
+    otbr::HotRestartSnapshot received;
+    std::string              value;
+    int                      sockets[2];
+    int                      pipeFds[2];
+    int                      fd;
+    char                     byte = 0;
+
+    CHECK_EQUAL(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets));
+    CHECK_EQUAL(0, pipe(pipeFds));
+
+    CHECK(sent.AddFd("pipe", pipeFds[1]) == OTBR_ERROR_NONE);
+    sent.SetValue("empty", "");
+    sent.SetValue("records", std::string("\0\1\2", 3));
+    CHECK(sent.Send(sockets[0]) == OTBR_ERROR_NONE);
+    CHECK(received.Receive(sockets[1]) == OTBR_ERROR_NONE);
+
+    CHECK_TRUE(received.GetValue("records", value));
+    CHECK_EQUAL(3, value.size());
+    CHECK_EQUAL(2, value[2]);
+    CHECK_TRUE(received.GetValue("empty", value));
+    CHECK_TRUE(value.empty());
+    CHECK_FALSE(received.GetValue("missing", value));
+
+    // The received file descriptor refers to the same pipe.
+    fd = received.TakeFd("pipe");
+    CHECK_TRUE(fd >= 0);
+    CHECK_EQUAL(-1, received.TakeFd("pipe"));
+    CHECK_EQUAL(1, write(fd, "x", 1));
+    CHECK_EQUAL(1, read(pipeFds[0], &byte, 1));
+    CHECK_EQUAL('x', byte);
+
+    // A message which is not a snapshot is rejected.
+    CHECK_EQUAL(4, send(sockets[0], "OTBR", 4, 0));
+    CHECK(received.Receive(sockets[1]) == OTBR_ERROR_ERRNO);
+    CHECK_EQUAL(EPROTO, errno);
+
+    close(fd);
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+TEST(HotRestart, TestHandOver)
+{
+    std::string              path = "/tmp/otbr-test-hot-restart-" + std::to_string(getpid());
+    otbr::HotRestartSnapshot snapshot;
+    otbr::HotRestart *       running = new otbr::HotRestart();
+    std::string              value;
+    otbrError                error = OTBR_ERROR_NONE;
+
+    CHECK(otbr::HotRestart::Request(path, snapshot, 100) == OTBR_ERROR_ERRNO);
+
+    CHECK(running->Listen(path, [](otbr::HotRestartSnapshot &aSnapshot) { aSnapshot.SetValue("state", "1"); }) ==
+          OTBR_ERROR_NONE);
+
+    std::thread request([&path, &snapshot, &error]() { error = otbr::HotRestart::Request(path, snapshot, 5000); });
+
+    while (!running->IsHandedOver())
+    {
+        fd_set  readFdSet;
+        int     maxFd   = -1;
+        timeval timeout = {1, 0};
+
+        FD_ZERO(&readFdSet);
+        running->UpdateFdSet(readFdSet, maxFd);
+        CHECK_TRUE(maxFd >= 0);
+        CHECK_TRUE(select(maxFd + 1, &readFdSet, nullptr, nullptr, &timeout) >= 0);
+        running->Process(readFdSet);
+    }
+
+    // The new agent proceeds once the running one is gone.
+    delete running;
+    request.join();
+
+    CHECK(error == OTBR_ERROR_NONE);
+    CHECK_TRUE(snapshot.GetValue("state", value));
+    STRCMP_EQUAL("1", value.c_str());
+    CHECK_EQUAL(-1, access(path.c_str(), F_OK));
+}
@@ -0,0 +1,134 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "web/web-service/job_manager.hpp"
+
+TEST_GROUP(JobManager){};
+
+TEST(JobManager, TestEventsEndWithResult)
+{
+    otbr::Web::JobManager    jobs;
+    std::vector<std::string> events;
+    std::promise<void>       done;
+    std::string              status;
+    uint32_t                 id;
+
+    id = jobs.Start("scan", [](const otbr::Web::JobManager::EventHandler &aPublish) {
+        aPublish("network", "{\"nn\":\"a\"}");
+        aPublish("network", "{\"nn\":\"b\"}");
+        return std::string("{\"error\":0}");
+    });
+
+    CHECK(jobs.Subscribe(id, [&events, &done](const std::string &aEvent, const std::string &aData) {
+        events.push_back(aEvent + " " + aData);
+        if (aEvent == "result")
+        {
+            done.set_value();
+        }
+    }));
+    done.get_future().wait();
+
+    CHECK_EQUAL(6, events.size());
+    CHECK_EQUAL("state {\"state\":\"queued\"}\n", events[0]);
+    CHECK_EQUAL("state {\"state\":\"running\"}\n", events[1]);
+    CHECK_EQUAL("network {\"nn\":\"a\"}", events[2]);
+    CHECK_EQUAL("network {\"nn\":\"b\"}", events[3]);
+    CHECK_EQUAL("state {\"state\":\"done\"}\n", events[4]);
+    CHECK_EQUAL("result {\"error\":0}", events[5]);
+
+    CHECK(jobs.GetStatus(id, status));
+    CHECK(status.find("\"state\":\"done\"") != std::string::npos);
+    CHECK(status.find("\"result\":{\"error\":0}") != std::string::npos);
+    CHECK(!jobs.GetStatus(id + 1, status));
+    CHECK(!jobs.Subscribe(id + 1, nullptr));
+}
+
+TEST(JobManager, TestFinishedJobsRemoved)
+{
+    static const int      kJobs = 32;
+    otbr::Web::JobManager jobs;
+    std::string           status;
+    uint32_t              first = 0;
+    uint32_t              last  = 0;
+
+    // The jobs of a name are limited, so each one is waited for before the next.
+    for (int i = 0; i < kJobs; i++)
+    {
+        last = jobs.Start("form", [](const otbr::Web::JobManager::EventHandler &) { return std::string("{}"); });
+        CHECK(jobs.Wait(last, status));
+        if (first == 0)
+        {
+            first = last;
+        }
+    }
+
+    CHECK(!jobs.GetStatus(first, status));
+    CHECK(jobs.GetStatus(last, status));
+}
+
+TEST(JobManager, TestLimitAndShare)
+{
+    otbr::Web::JobManager    jobs;
+    std::promise<void>       release;
+    std::shared_future<void> released = release.get_future().share();
+    std::string              result;
+    std::string              metrics;
+    uint32_t                 scan;
+    uint32_t                 form;
+
+    scan = jobs.Start(
+        "scan", [released](const otbr::Web::JobManager::EventHandler &) {
+            released.wait();
+            return std::string("{\"error\":0}");
+        },
+        true);
+    form = jobs.Start("form", [](const otbr::Web::JobManager::EventHandler &) { return std::string("{}"); });
+
+    CHECK(scan != 0);
+    CHECK_EQUAL(scan, jobs.Start("scan", nullptr, true));
+    CHECK(jobs.Start("form", [](const otbr::Web::JobManager::EventHandler &) { return std::string("{}"); }) != 0);
+    CHECK_EQUAL(0, jobs.Start("form", nullptr));
+
+    jobs.GetMetrics(metrics);
+    CHECK(metrics.find("\"queued\":2") != std::string::npos);
+    CHECK(metrics.find("\"form\":{\"queued\":2,\"rejected\":1") != std::string::npos);
+    CHECK(metrics.find("\"shared\":1,\"started\":1") != std::string::npos);
+
+    release.set_value();
+    CHECK(jobs.Wait(scan, result));
+    CHECK_EQUAL("{\"error\":0}", result);
+    CHECK(jobs.Wait(form, result));
+    CHECK_EQUAL("{}", result);
+    CHECK(!jobs.Wait(0, result));
+}
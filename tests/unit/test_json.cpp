@@ -0,0 +1,126 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+
+#include <limits.h>
+
+#include "web/web-service/json.hpp"
+
+TEST_GROUP(Json){};
+
+TEST(Json, TestWriteNested)
+{
+    std::string buffer = "stale";
+
+    otbr::Web::JsonWriter(buffer)
+        .BeginObject()
+        .Member("error", 0)
+        .Key("result")
+        .BeginArray()
+        .BeginObject()
+        .Member("ch", 15)
+        .Member("nn", "Open\"Thread\"\n")
+        .Member("joinable", true)
+        .EndObject()
+        .Value(std::string("\x01"))
+        .EndArray()
+        .EndObject();
+
+    STRCMP_EQUAL("{\"error\":0,\"result\":[{\"ch\":15,\"nn\":\"Open\\\"Thread\\\"\\n\",\"joinable\":true},\"\\u0001\"]}",
+                 buffer.c_str());
+}
+
+TEST(Json, TestWriteCbor)
+{
+    std::string buffer = "stale";
+    std::string name(24, 'x');
+
+    otbr::Web::JsonWriter(buffer, otbr::Web::JsonWriter::kEncodingCbor)
+        .BeginObject()
+        .Member("error", -3)
+        .Key("result")
+        .BeginArray()
+        .Value(23)
+        .Value(300)
+        .Value(INT_MIN)
+        .Value(true)
+        .Value(name)
+        .EndArray()
+        .Member("n", 70000)
+        .EndObject();
+
+    CHECK(buffer == std::string("\xbf\x65"
+                                "error"
+                                "\x22\x66"
+                                "result"
+                                "\x9f\x17\x19\x01\x2c\x3a\x7f\xff\xff\xff\xf5\x78\x18",
+                                28) +
+                        name + std::string("\xff\x61n\x1a\x00\x01\x11\x70\xff", 9));
+    STRCMP_EQUAL("application/cbor", otbr::Web::JsonWriter::GetContentType(otbr::Web::JsonWriter::kEncodingCbor));
+}
+
+TEST(Json, TestReadBoundMembers)
+{
+    std::string networkKey = "stale";
+    std::string prefix;
+    bool        defaultRoute = true;
+    int         index        = 1;
+
+    CHECK(otbr::Web::JsonReader()
+              .Bind("networkKey", networkKey)
+              .Bind("prefix", prefix)
+              .Bind("defaultRoute", defaultRoute)
+              .Bind("index", index)
+              .Parse(" { \"index\" : -2, \"ignored\": {\"a\": [1, 2.5e3, null, \"}\"]}, \"prefix\": \"fd11:\\u0041\\/\", "
+                     "\"networkKey\": \"00112233\" } "));
+
+    STRCMP_EQUAL("00112233", networkKey.c_str());
+    STRCMP_EQUAL("fd11:A/", prefix.c_str());
+    CHECK(!defaultRoute);
+    CHECK_EQUAL(-2, index);
+}
+
+TEST(Json, TestReadMalformed)
+{
+    std::string prefix;
+    int         index;
+
+    CHECK(otbr::Web::JsonReader().Parse("{}"));
+    CHECK(!otbr::Web::JsonReader().Parse(""));
+    CHECK(!otbr::Web::JsonReader().Parse("[]"));
+    CHECK(!otbr::Web::JsonReader().Parse("{\"a\":1,}"));
+    CHECK(!otbr::Web::JsonReader().Parse("{\"a\":1} x"));
+    CHECK(!otbr::Web::JsonReader().Parse("{\"a\":\"unterminated}"));
+    CHECK(!otbr::Web::JsonReader().Bind("prefix", prefix).Parse("{\"prefix\":1}"));
+    CHECK(!otbr::Web::JsonReader().Bind("index", index).Parse("{\"index\":\"1\"}"));
+    CHECK(!otbr::Web::JsonReader().Bind("index", index).Parse("{\"index\":1.5}"));
+    CHECK(!otbr::Web::JsonReader().Bind("index", index).Parse("{\"index\":99999999999}"));
+}
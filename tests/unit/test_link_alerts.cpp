@@ -0,0 +1,137 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+
+#include "utils/link_alerts.hpp"
+
+using otbr::LinkAlerts;
+
+TEST_GROUP(LinkAlerts){};
+
+TEST(LinkAlerts, TestHysteresis)
+{
+    LinkAlerts                        alerts(4);
+    std::vector<LinkAlerts::Crossing> crossings;
+    uint32_t                          id;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, alerts.AddRule({0, LinkAlerts::kMetricRssi, false, -80, 5}, id));
+    CHECK(alerts.IsSampled(LinkAlerts::kMetricRssi));
+    CHECK(!alerts.IsSampled(LinkAlerts::kMetricFrameErrorRate));
+
+    alerts.Update(LinkAlerts::kMetricRssi, 0x1122, -70, crossings);
+    CHECK(crossings.empty());
+
+    alerts.Update(LinkAlerts::kMetricRssi, 0x1122, -81, crossings);
+    CHECK_EQUAL(1, crossings.size());
+    CHECK_EQUAL(id, crossings[0].mRuleId);
+    CHECK_EQUAL(0x1122, crossings[0].mSubject);
+    CHECK(crossings[0].mRaised);
+    CHECK_EQUAL(-81, crossings[0].mValue);
+
+    // Samples within the hysteresis neither raise the alert again nor clear it.
+    crossings.clear();
+    alerts.Update(LinkAlerts::kMetricRssi, 0x1122, -84, crossings);
+    alerts.Update(LinkAlerts::kMetricRssi, 0x1122, -77, crossings);
+    CHECK(crossings.empty());
+    alerts.GetRaisedAlerts(crossings);
+    CHECK_EQUAL(1, crossings.size());
+    CHECK_EQUAL(-77, crossings[0].mValue);
+
+    crossings.clear();
+
+    alerts.Update(LinkAlerts::kMetricRssi, 0x1122, -75, crossings);
+    CHECK_EQUAL(1, crossings.size());
+    CHECK(!crossings[0].mRaised);
+    CHECK_EQUAL(-75, crossings[0].mValue);
+
+    // Another metric does not trigger the rule.
+    crossings.clear();
+    alerts.Update(LinkAlerts::kMetricFrameErrorRate, 0x1122, -90, crossings);
+    CHECK(crossings.empty());
+}
+
+TEST(LinkAlerts, TestEndRound)
+{
+    LinkAlerts                        alerts(4);
+    std::vector<LinkAlerts::Crossing> crossings;
+    uint32_t                          id;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, alerts.AddRule({0, LinkAlerts::kMetricFrameErrorRate, true, 0x1000, 0x100}, id));
+
+    alerts.Update(LinkAlerts::kMetricFrameErrorRate, 1, 0x2000, crossings);
+    alerts.Update(LinkAlerts::kMetricFrameErrorRate, 2, 0x2000, crossings);
+    CHECK_EQUAL(2, crossings.size());
+    crossings.clear();
+    alerts.EndRound(crossings);
+    CHECK(crossings.empty());
+
+    // The alert of a neighbor missing from a round is cleared with its last sample.
+    alerts.Update(LinkAlerts::kMetricFrameErrorRate, 1, 0x3000, crossings);
+    alerts.EndRound(crossings);
+    CHECK_EQUAL(1, crossings.size());
+    CHECK_EQUAL(2, crossings[0].mSubject);
+    CHECK(!crossings[0].mRaised);
+    CHECK_EQUAL(0x2000, crossings[0].mValue);
+
+    // Removing a rule drops its alerts silently.
+    crossings.clear();
+    CHECK_EQUAL(OTBR_ERROR_NONE, alerts.RemoveRule(id));
+    alerts.EndRound(crossings);
+    CHECK(crossings.empty());
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, alerts.RemoveRule(id));
+    CHECK_EQUAL(ENOENT, errno);
+}
+
+TEST(LinkAlerts, TestRules)
+{
+    LinkAlerts         alerts(2);
+    LinkAlerts::Metric metric;
+    uint32_t           first;
+    uint32_t           second;
+    uint32_t           third;
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, alerts.AddRule({0, LinkAlerts::kMetricNum, true, 0, 0}, first));
+    CHECK_EQUAL(EINVAL, errno);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, alerts.AddRule({0, LinkAlerts::kMetricCcaFailureRate, true, 0x4000, 0}, first));
+    CHECK_EQUAL(OTBR_ERROR_NONE, alerts.AddRule({0, LinkAlerts::kMetricTxRetryRate, true, 0x4000, 0}, second));
+    CHECK(first != second);
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, alerts.AddRule({0, LinkAlerts::kMetricRssi, false, -90, 0}, third));
+    CHECK_EQUAL(ENOSPC, errno);
+
+    CHECK_EQUAL(2, alerts.GetRules().size());
+    CHECK_EQUAL(second, alerts.GetRules()[1].mId);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, LinkAlerts::ParseMetric("CcaFailureRate", metric));
+    CHECK_EQUAL(LinkAlerts::kMetricCcaFailureRate, metric);
+    STRCMP_EQUAL("Rssi", LinkAlerts::GetMetricName(LinkAlerts::kMetricRssi));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, LinkAlerts::ParseMetric("Lqi", metric));
+}
@@ -28,10 +28,14 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
+#include "common/circular_logging.hpp"
 #include "common/logging.hpp"
 
 TEST_GROUP(Logging){};
@@ -110,3 +114,281 @@ TEST(Logging, TestLoggingDump)
     sprintf(cmd, "grep '%s.*: foobar: 0020: 6f 66 20 74 65 78 74 00' /var/log/syslog", ident);
     CHECK(0 == system(cmd));
 }
+
+TEST(Logging, TestLoggingRateLimited)
+{
+    char ident[20];
+    char cmd[128];
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, true);
+    for (int i = 0; i < 3; i++)
+    {
+        otbrLogRateLimited(60000, OTBR_LOG_INFO, "cool-limited-%d", i);
+    }
+    otbrLogDeinit();
+    sleep(0);
+
+    sprintf(cmd, "grep '%s.*cool-limited-0' /var/log/syslog", ident);
+    CHECK(0 == system(cmd));
+
+    sprintf(cmd, "grep '%s.*cool-limited-[12]' /var/log/syslog", ident);
+    CHECK(0 != system(cmd));
+}
+
+TEST(Logging, TestLoggingFile)
+{
+    char  ident[20];
+    char  filename[] = "/tmp/otbr-test-log-XXXXXX";
+    char  line[128];
+    int   fd         = mkstemp(filename);
+    int   count      = 0;
+    FILE *fp;
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, false);
+    otbrLogSetFilename(filename);
+    for (int i = 0; i < 100; i++)
+    {
+        otbrLog(OTBR_LOG_INFO, "cool-file-%d", i);
+    }
+    otbrLogDeinit();
+
+    fp = fopen(filename, "r");
+    CHECK(fp != NULL);
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        CHECK(strstr(line, " | ") != NULL);
+        if (strstr(line, "cool-file-") != NULL)
+        {
+            count++;
+        }
+    }
+    fclose(fp);
+    unlink(filename);
+
+    CHECK(count > 0);
+    CHECK_EQUAL(100, count + static_cast<int>(otbrLogGetDroppedCount()));
+}
+
+TEST(Logging, TestLoggingDumpFile)
+{
+    char    ident[20];
+    char    filename[] = "/tmp/otbr-test-log-XXXXXX";
+    char    line[128];
+    int     fd         = mkstemp(filename);
+    int     count      = 0;
+    bool    truncated  = false;
+    uint8_t data[300];
+    FILE *  fp;
+
+    CHECK(fd >= 0);
+    close(fd);
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, false);
+    otbrLogSetFilename(filename);
+    otbrDump(OTBR_LOG_INFO, "foobar", data, sizeof(data));
+    otbrLogDeinit();
+
+    fp = fopen(filename, "r");
+    CHECK(fp != NULL);
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (strstr(line, " | foobar: 0000: 00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f\n") != NULL ||
+            strstr(line, " | foobar: 00f0: f0 f1 f2 f3 f4 f5 f6 f7 f8 f9 fa fb fc fd fe ff\n") != NULL)
+        {
+            count++;
+        }
+        CHECK(strstr(line, "foobar: 0100: ") == NULL);
+        truncated = truncated || strstr(line, "foobar: 44 more bytes not dumped") != NULL;
+    }
+    fclose(fp);
+    unlink(filename);
+
+    CHECK_EQUAL(2, count);
+    CHECK(truncated);
+}
+
+TEST(Logging, TestLoggingCircular)
+{
+    char  ident[20];
+    char  filename[] = "/tmp/otbr-test-circlog-XXXXXX";
+    char  line[128];
+    int   fd         = mkstemp(filename);
+    int   count      = 0;
+    FILE *output     = tmpfile();
+
+    CHECK(fd >= 0);
+    close(fd);
+    CHECK(output != NULL);
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, false);
+    CHECK(otbrLogSetCircularFilename(filename) == OTBR_ERROR_NONE);
+    otbrLog(OTBR_LOG_DEBUG, "cool-circular-%d", 0);
+    otbrLog(OTBR_LOG_INFO, "cool-circular-%d", 1);
+    otbrLogDeinit();
+
+    CHECK(otbr::CircularLog::Decode(filename, output) == OTBR_ERROR_NONE);
+    rewind(output);
+    while (fgets(line, sizeof(line), output) != NULL)
+    {
+        CHECK(strstr(line, " | cool-circular-") != NULL);
+        count++;
+    }
+    fclose(output);
+    unlink(filename);
+
+    CHECK_EQUAL(2, count);
+}
+
+TEST(Logging, TestLoggingJournal)
+{
+    char ident[20];
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, true);
+#if OTBR_ENABLE_JOURNALD
+    CHECK(otbrLogEnableJournal(true) == OTBR_ERROR_NONE);
+    otbrLogSetInterface("wpan0");
+    otbrLog(OTBR_LOG_INFO, "cool-journal");
+    otbrLogResult("cool-journal-result", OTBR_ERROR_DTLS);
+#else
+    CHECK(otbrLogEnableJournal(true) == OTBR_ERROR_ERRNO);
+    CHECK_EQUAL(ENOTSUP, errno);
+#endif
+    otbrLogDeinit();
+
+    CHECK(otbrLogEnableJournal(true) == OTBR_ERROR_ERRNO);
+}
+
+TEST(Logging, TestLoggingSession)
+{
+    CHECK_EQUAL(0, otbrLogSetSession(5));
+    CHECK_EQUAL(5, otbrLogSetSession(0));
+}
+
+TEST(Logging, TestLoggingSkipsArguments)
+{
+    char ident[20];
+    int  evaluated = 0;
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, false);
+    otbrLog(OTBR_LOG_DEBUG, "cool-skipped-%d", ++evaluated);
+    CHECK_EQUAL(0, evaluated);
+    otbrLog(OTBR_LOG_INFO, "cool-evaluated-%d", ++evaluated);
+    CHECK_EQUAL(1, evaluated);
+    otbrLogDeinit();
+
+    otbrLog(OTBR_LOG_ERR, "cool-closed-%d", ++evaluated);
+    CHECK_EQUAL(1, evaluated);
+}
+
+TEST(Logging, TestLoggingModuleLevel)
+{
+    char ident[20];
+    char cmd[128];
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, true);
+    otbrLogSetModuleLevel(OTBR_LOG_MODULE_MDNS, OTBR_LOG_DEBUG);
+    CHECK(otbrLogIsModuleEnabled(OTBR_LOG_MODULE_MDNS, OTBR_LOG_DEBUG));
+    CHECK(!otbrLogIsModuleEnabled(OTBR_LOG_MODULE_DTLS, OTBR_LOG_DEBUG));
+    otbrLogImpl(OTBR_LOG_MODULE_MDNS, OTBR_LOG_DEBUG, "cool-module-mdns");
+    otbrLogImpl(OTBR_LOG_MODULE_DTLS, OTBR_LOG_DEBUG, "cool-module-dtls");
+    otbrLogSetModuleLevel(OTBR_LOG_MODULE_MDNS, OTBR_LOG_INHERIT);
+    otbrLogDeinit();
+    sleep(0);
+
+    sprintf(cmd, "grep '%s.*cool-module-mdns' /var/log/syslog", ident);
+    CHECK(0 == system(cmd));
+
+    sprintf(cmd, "grep '%s.*cool-module-dtls' /var/log/syslog", ident);
+    CHECK(0 != system(cmd));
+}
+
+TEST(Logging, TestLoggingParseLevel)
+{
+    otbrLogSetLevel(OTBR_LOG_INFO);
+
+    CHECK(otbrLogParseLevel("5"));
+    CHECK_EQUAL(OTBR_LOG_NOTICE, otbrLogGetLevel());
+    CHECK(otbrLogParseLevel("dbus=7"));
+    CHECK_EQUAL(OTBR_LOG_DEBUG, otbrLogGetModuleLevel(OTBR_LOG_MODULE_DBUS));
+    CHECK_EQUAL(OTBR_LOG_DEBUG, otbrLogGetEffectiveLevel(OTBR_LOG_MODULE_DBUS));
+    CHECK_EQUAL(OTBR_LOG_NOTICE, otbrLogGetEffectiveLevel(OTBR_LOG_MODULE_WEB));
+    CHECK(otbrLogParseLevel("dbus=-1"));
+    CHECK_EQUAL(OTBR_LOG_INHERIT, otbrLogGetModuleLevel(OTBR_LOG_MODULE_DBUS));
+    CHECK_EQUAL(OTBR_LOG_NOTICE, otbrLogGetEffectiveLevel(OTBR_LOG_MODULE_DBUS));
+
+    CHECK(!otbrLogParseLevel("-1"));
+    CHECK(!otbrLogParseLevel("8"));
+    CHECK(!otbrLogParseLevel("7x"));
+    CHECK(!otbrLogParseLevel("radio=7"));
+    CHECK(!otbrLogParseLevel("mdns="));
+    CHECK_EQUAL(OTBR_LOG_NOTICE, otbrLogGetLevel());
+
+    CHECK_EQUAL(OTBR_LOG_MODULE_UBUS, otbrLogModuleFromString("ubus"));
+    CHECK_EQUAL(OTBR_LOG_MODULE_NUM, otbrLogModuleFromString("radio"));
+    STRCMP_EQUAL("ncp", otbrLogModuleToString(OTBR_LOG_MODULE_NCP));
+
+    otbrLogSetLevel(OTBR_LOG_INFO);
+}
+
+TEST(Logging, TestLoggingSampledAndThrottled)
+{
+    char ident[20];
+    char cmd[128];
+    int  evaluated = 0;
+
+    sprintf(ident, "otbr-test-%ld", clock());
+    otbrLogInit(ident, OTBR_LOG_INFO, true);
+    for (int i = 0; i < 8; i++)
+    {
+        otbrLogSampled(4, OTBR_LOG_INFO, "cool-sampled-%d", i);
+        otbrLogThrottled(1, 2, OTBR_LOG_INFO, "cool-throttled-%d", i);
+        otbrLogSampled(4, OTBR_LOG_DEBUG, "cool-skipped-%d", ++evaluated);
+    }
+    otbrLogDeinit();
+    sleep(0);
+
+    CHECK_EQUAL(0, evaluated);
+
+    sprintf(cmd, "grep '%s.*cool-sampled-[04]' /var/log/syslog", ident);
+    CHECK(0 == system(cmd));
+
+    sprintf(cmd, "grep '%s.*cool-sampled-[123567]' /var/log/syslog", ident);
+    CHECK(0 != system(cmd));
+
+    sprintf(cmd, "grep '%s.*cool-throttled-[01]' /var/log/syslog", ident);
+    CHECK(0 == system(cmd));
+
+    sprintf(cmd, "grep '%s.*cool-throttled-[2-7]' /var/log/syslog", ident);
+    CHECK(0 != system(cmd));
+}
+
+TEST(Logging, TestLoggingTakeToken)
+{
+    otbrLogBucket bucket = {0, 0, 0};
+
+    CHECK(otbrLogTakeToken(OTBR_LOG_MODULE_DEFAULT, OTBR_LOG_DEBUG, bucket, 1, 2));
+    CHECK(otbrLogTakeToken(OTBR_LOG_MODULE_DEFAULT, OTBR_LOG_DEBUG, bucket, 1, 2));
+    CHECK(!otbrLogTakeToken(OTBR_LOG_MODULE_DEFAULT, OTBR_LOG_DEBUG, bucket, 1, 2));
+    CHECK_EQUAL(1, bucket.mSuppressed);
+
+    // A second later there is one token again.
+    bucket.mTime -= 1000;
+    CHECK(otbrLogTakeToken(OTBR_LOG_MODULE_DEFAULT, OTBR_LOG_DEBUG, bucket, 1, 2));
+    CHECK_EQUAL(0, bucket.mSuppressed);
+    CHECK(!otbrLogTakeToken(OTBR_LOG_MODULE_DEFAULT, OTBR_LOG_DEBUG, bucket, 1, 2));
+}
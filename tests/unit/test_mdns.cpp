@@ -0,0 +1,179 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "mdns/mdns.cpp"
+
+TEST_GROUP(Mdns){};
+
+TEST(Mdns, TestEncodeTxtData)
+{
+    const otbr::Mdns::TxtEntry entries[] = {{"nn", "cool"}, {"xp", "1122"}};
+    const uint8_t              expected[] = {7, 'n', 'n', '=', 'c', 'o', 'o', 'l',
+                                            7, 'x', 'p', '=', '1', '1', '2', '2'};
+    uint8_t                    txt[otbr::Mdns::Publisher::kMaxSizeOfTxtData];
+    uint16_t                   length = sizeof(txt);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, otbr::Mdns::Publisher::EncodeTxtData(entries, 2, txt, length));
+    CHECK_EQUAL(sizeof(expected), length);
+    CHECK(memcmp(expected, txt, sizeof(expected)) == 0);
+
+    length = sizeof(txt);
+    CHECK_EQUAL(OTBR_ERROR_NONE, otbr::Mdns::Publisher::EncodeTxtData(entries, 0, txt, length));
+    CHECK_EQUAL(0, length);
+}
+
+TEST(Mdns, TestEncodeTxtDataOverflow)
+{
+    const otbr::Mdns::TxtEntry entries[] = {{"nn", "cool"}, {"xp", "1122"}};
+    uint8_t                    txt[15];
+    uint16_t                   length = sizeof(txt);
+
+    errno = 0;
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, otbr::Mdns::Publisher::EncodeTxtData(entries, 2, txt, length));
+    CHECK_EQUAL(EMSGSIZE, errno);
+}
+
+TEST(Mdns, TestTxtRecordSetEntry)
+{
+    const uint8_t         binary[]   = {0x00, '=', 0xff};
+    const uint8_t         expected[] = {5, 'n', 'n', '=', 'a', 'b', 6, 'x', 'p', '=', 0x00, '=', 0xff};
+    otbr::Mdns::TxtRecord record;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, record.SetEntry("nn", "cool"));
+    CHECK_EQUAL(OTBR_ERROR_NONE, record.SetEntry("xp", binary, sizeof(binary)));
+    CHECK_EQUAL(OTBR_ERROR_NONE, record.SetEntry("nn", "ab"));
+    CHECK_EQUAL(sizeof(expected), record.GetLength());
+    CHECK(memcmp(expected, record.GetData(), sizeof(expected)) == 0);
+}
+
+TEST(Mdns, TestTxtRecordCompare)
+{
+    otbr::Mdns::TxtRecord record1;
+    otbr::Mdns::TxtRecord record2;
+
+    CHECK(record1 == record2);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, record1.SetEntry("nn", "cool"));
+    CHECK(record1 != record2);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, record2.SetEntry("nn", "cool"));
+    CHECK(record1 == record2);
+    CHECK(record1.Equals(record2.GetData(), record2.GetLength()));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, record2.SetEntry("n", "cool"));
+    CHECK(record1 != record2);
+
+    record2.Clear();
+    CHECK_EQUAL(0, record2.GetLength());
+}
+
+TEST(Mdns, TestServiceCacheSubscription)
+{
+    otbr::Mdns::ServiceCache cache;
+
+    CHECK(cache.AddSubscription("_meshcop._udp"));
+    CHECK(!cache.AddSubscription("_meshcop._udp"));
+    CHECK(cache.AddInstance("br1", "_meshcop._udp", "local", 0));
+    CHECK_EQUAL(1, cache.GetSubscriptions().size());
+
+    CHECK(!cache.RemoveSubscription("_meshcop._udp"));
+    CHECK_EQUAL(1, cache.GetInstances().size());
+    CHECK(cache.RemoveSubscription("_meshcop._udp"));
+    CHECK_EQUAL(0, cache.GetSubscriptions().size());
+    CHECK_EQUAL(0, cache.GetInstances().size());
+}
+
+TEST(Mdns, TestServiceCacheInstance)
+{
+    const uint8_t                             txt[] = {5, 'n', 'n', '=', 'a', 'b'};
+    otbr::Mdns::ServiceCache                  cache;
+    const otbr::Mdns::ServiceCache::Instance *instance;
+
+    CHECK(cache.AddInstance("br1", "_meshcop._udp", "local", 0));
+    CHECK(!cache.AddInstance("br1", "_meshcop._udp", "local", 0));
+
+    instance = cache.FindInstance("br1", "_meshcop._udp");
+    CHECK(instance != NULL);
+    CHECK(!instance->mResolved);
+
+    cache.UpdateInstance("br1", "_meshcop._udp", "host.local", 49191, txt, sizeof(txt), 120, 0);
+    instance = cache.FindInstance("br1", "_meshcop._udp");
+    CHECK(instance->mResolved);
+    STRCMP_EQUAL("host.local", instance->mHostName.c_str());
+    CHECK_EQUAL(49191, instance->mPort);
+    CHECK(instance->mTxtRecord.Equals(txt, sizeof(txt)));
+    CHECK_EQUAL(120000, instance->mExpireTime);
+
+    cache.RemoveInstance("br1", "_meshcop._udp");
+    CHECK(cache.FindInstance("br1", "_meshcop._udp") == NULL);
+}
+
+static int  sExpireCount;
+static bool sExpireRemoved;
+
+static void HandleExpire(void *aContext, const otbr::Mdns::ServiceCache::Instance &aInstance, bool aRemoved)
+{
+    (void)aContext;
+    (void)aInstance;
+
+    sExpireCount++;
+    sExpireRemoved = aRemoved;
+}
+
+TEST(Mdns, TestServiceCacheExpire)
+{
+    otbr::Mdns::ServiceCache cache;
+    timeval                  timeout = {10, 0};
+
+    sExpireCount = 0;
+    CHECK(cache.AddInstance("br1", "_meshcop._udp", "local", 0));
+    cache.UpdateInstance("br1", "_meshcop._udp", "host.local", 49191, NULL, 0, 2, 0);
+
+    cache.UpdateTimeout(1000, timeout);
+    CHECK_EQUAL(1, timeout.tv_sec);
+    CHECK_EQUAL(0, timeout.tv_usec);
+
+    cache.Expire(1999, HandleExpire, NULL);
+    CHECK_EQUAL(0, sExpireCount);
+
+    // An expired instance is resolved again before being removed.
+    cache.Expire(2000, HandleExpire, NULL);
+    CHECK_EQUAL(1, sExpireCount);
+    CHECK(!sExpireRemoved);
+    CHECK(!cache.FindInstance("br1", "_meshcop._udp")->mResolved);
+
+    cache.Expire(2000 + otbr::Mdns::ServiceCache::kResolveTimeout, HandleExpire, NULL);
+    CHECK_EQUAL(2, sExpireCount);
+    CHECK(sExpireRemoved);
+    CHECK_EQUAL(0, cache.GetInstances().size());
+}
@@ -0,0 +1,96 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <list>
+#include <vector>
+
+#include "common/memory_stats.hpp"
+
+TEST_GROUP(MemoryStats){};
+
+namespace {
+
+struct TaggedObject : public otbr::MemoryTagged<otbr::kMemoryTagDtls>
+{
+    uint8_t mPayload[100];
+};
+
+} // namespace
+
+TEST(MemoryStats, TestTaggedObject)
+{
+    otbr::MemoryCounters before = otbr::GetMemoryCounters(otbr::kMemoryTagDtls);
+    otbr::MemoryCounters after;
+    TaggedObject *       object = new TaggedObject();
+
+    after = otbr::GetMemoryCounters(otbr::kMemoryTagDtls);
+    CHECK_EQUAL(before.mBytes + sizeof(TaggedObject), after.mBytes);
+    CHECK_EQUAL(before.mAllocations + 1, after.mAllocations);
+    CHECK_EQUAL(before.mTotalAllocations + 1, after.mTotalAllocations);
+    CHECK(after.mPeakBytes >= after.mBytes);
+
+    delete object;
+
+    after = otbr::GetMemoryCounters(otbr::kMemoryTagDtls);
+    CHECK_EQUAL(before.mBytes, after.mBytes);
+    CHECK_EQUAL(before.mAllocations, after.mAllocations);
+    CHECK_EQUAL(before.mTotalAllocations + 1, after.mTotalAllocations);
+}
+
+TEST(MemoryStats, TestTaggedAllocator)
+{
+    otbr::MemoryCounters before = otbr::GetMemoryCounters(otbr::kMemoryTagDBus);
+    otbr::MemoryCounters after;
+
+    {
+        std::vector<uint32_t, otbr::TaggedAllocator<uint32_t, otbr::kMemoryTagDBus>> values;
+        std::list<int, otbr::TaggedAllocator<int, otbr::kMemoryTagDBus>>             nodes;
+
+        values.reserve(256);
+        nodes.push_back(1);
+        nodes.push_back(2);
+
+        after = otbr::GetMemoryCounters(otbr::kMemoryTagDBus);
+        CHECK(after.mBytes >= before.mBytes + 256 * sizeof(uint32_t) + 2 * sizeof(int));
+        CHECK_EQUAL(before.mAllocations + 3, after.mAllocations);
+        CHECK(after.mPeakBytes >= after.mBytes);
+    }
+
+    after = otbr::GetMemoryCounters(otbr::kMemoryTagDBus);
+    CHECK_EQUAL(before.mBytes, after.mBytes);
+    CHECK_EQUAL(before.mAllocations, after.mAllocations);
+    CHECK(after.mPeakBytes >= before.mBytes + 256 * sizeof(uint32_t));
+}
+
+TEST(MemoryStats, TestTagNames)
+{
+    STRCMP_EQUAL("Dtls", otbr::GetMemoryTagName(otbr::kMemoryTagDtls));
+    STRCMP_EQUAL("Timers", otbr::GetMemoryTagName(otbr::kMemoryTagTimers));
+}
@@ -0,0 +1,80 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <math.h>
+
+#include "utils/metrics_writer.hpp"
+
+TEST_GROUP(MetricsWriter){};
+
+TEST(MetricsWriter, TestFamilies)
+{
+    std::string         output = "stale";
+    otbr::MetricsWriter writer(output);
+
+    writer.Family("otbr_mac_tx_total", otbr::MetricsWriter::kTypeCounter, "Frames transmitted.")
+        .Value(static_cast<uint64_t>(18446744073709551615ULL));
+    writer.Family("otbr_neighbor_rssi_dbm", otbr::MetricsWriter::kTypeGauge, "Average RSSI.")
+        .Label("ext_address", "1122334455667788")
+        .Label("rloc16", "0x0400")
+        .Value(static_cast<int64_t>(-70))
+        .Value(0.25);
+
+    STRCMP_EQUAL("# HELP otbr_mac_tx_total Frames transmitted.\n"
+                 "# TYPE otbr_mac_tx_total counter\n"
+                 "otbr_mac_tx_total 18446744073709551615\n"
+                 "# HELP otbr_neighbor_rssi_dbm Average RSSI.\n"
+                 "# TYPE otbr_neighbor_rssi_dbm gauge\n"
+                 "otbr_neighbor_rssi_dbm{ext_address=\"1122334455667788\",rloc16=\"0x0400\"} -70\n"
+                 "otbr_neighbor_rssi_dbm 0.25\n",
+                 output.c_str());
+}
+
+TEST(MetricsWriter, TestHistogramAndEscaping)
+{
+    std::string         output;
+    otbr::MetricsWriter writer(output);
+
+    writer.Family("otbr_stage_seconds", otbr::MetricsWriter::kTypeHistogram, "A \\ stage\nlatency.")
+        .Label("stage", "a\"b\\c\nd")
+        .Label("le", "+Inf")
+        .Value("_bucket", static_cast<uint64_t>(3))
+        .Value("_sum", 1234.567891)
+        .Value("_count", static_cast<uint64_t>(3))
+        .Value("_max", static_cast<double>(INFINITY));
+
+    STRCMP_EQUAL("# HELP otbr_stage_seconds A \\\\ stage\\nlatency.\n"
+                 "# TYPE otbr_stage_seconds histogram\n"
+                 "otbr_stage_seconds_bucket{stage=\"a\\\"b\\\\c\\nd\",le=\"+Inf\"} 3\n"
+                 "otbr_stage_seconds_sum 1234.567891\n"
+                 "otbr_stage_seconds_count 3\n"
+                 "otbr_stage_seconds_max +Inf\n",
+                 output.c_str());
+}
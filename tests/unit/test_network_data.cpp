@@ -0,0 +1,134 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <vector>
+
+#include "dbus/common/network_data.hpp"
+
+using otbr::DBus::NetworkDataInfo;
+using otbr::DBus::ParseNetworkData;
+
+TEST_GROUP(NetworkData){};
+
+TEST(NetworkData, TestParse)
+{
+    const std::vector<uint8_t> networkData = {
+        // Stable Prefix TLV of fd00:102:304:506::/64.
+        0x03, 25, 0x00, 64, 0xfd, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+        // Stable Has Route sub-TLV, high preference.
+        0x01, 3, 0x54, 0x00, 0x40,
+        // Stable Border Router sub-TLV, high preference, preferred, slaac, default route, on mesh.
+        0x05, 4, 0x54, 0x00, 0x73, 0x00,
+        // Stable Context sub-TLV, which is skipped.
+        0x07, 2, 0x11, 0x40,
+        // Stable Service TLV of Thread enterprise number, service ID 1.
+        0x0b, 9, 0x81, 1, 0x5c,
+        // Server sub-TLV.
+        0x0c, 4, 0x54, 0x00, 0xab, 0xcd,
+        // Stable Service TLV of enterprise number 0x12345678, service ID 2.
+        0x0b, 10, 0x02, 0x12, 0x34, 0x56, 0x78, 0,
+        // Stable Server sub-TLV.
+        0x0d, 2, 0x6c, 0x00,
+    };
+    NetworkDataInfo info;
+
+    CHECK_EQUAL(OT_ERROR_NONE, ParseNetworkData(networkData.data(), networkData.size(), 0x6c00, info));
+
+    CHECK_EQUAL(1U, info.mExternalRoutes.size());
+    CHECK_EQUAL(64, info.mExternalRoutes[0].mPrefix.mLength);
+    CHECK_TRUE(info.mExternalRoutes[0].mPrefix.mPrefix ==
+               std::vector<uint8_t>({0xfd, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06}));
+    CHECK_EQUAL(0x5400, info.mExternalRoutes[0].mRloc16);
+    CHECK_EQUAL(1, info.mExternalRoutes[0].mPreference);
+    CHECK_TRUE(info.mExternalRoutes[0].mStable);
+    CHECK_FALSE(info.mExternalRoutes[0].mNextHopIsThisDevice);
+
+    CHECK_EQUAL(1U, info.mOnMeshPrefixes.size());
+    CHECK_EQUAL(0x5400, info.mOnMeshPrefixes[0].mRloc16);
+    CHECK_EQUAL(64, info.mOnMeshPrefixes[0].mConfig.mPrefix.mLength);
+    CHECK_EQUAL(1, info.mOnMeshPrefixes[0].mConfig.mPreference);
+    CHECK_TRUE(info.mOnMeshPrefixes[0].mConfig.mPreferred);
+    CHECK_TRUE(info.mOnMeshPrefixes[0].mConfig.mSlaac);
+    CHECK_FALSE(info.mOnMeshPrefixes[0].mConfig.mDhcp);
+    CHECK_FALSE(info.mOnMeshPrefixes[0].mConfig.mConfigure);
+    CHECK_TRUE(info.mOnMeshPrefixes[0].mConfig.mDefaultRoute);
+    CHECK_TRUE(info.mOnMeshPrefixes[0].mConfig.mOnMesh);
+    CHECK_TRUE(info.mOnMeshPrefixes[0].mConfig.mStable);
+
+    CHECK_EQUAL(2U, info.mServices.size());
+    CHECK_EQUAL(44970U, info.mServices[0].mEnterpriseNumber);
+    CHECK_EQUAL(1, info.mServices[0].mServiceId);
+    CHECK_TRUE(info.mServices[0].mServiceData == std::vector<uint8_t>({0x5c}));
+    CHECK_EQUAL(0x5400, info.mServices[0].mServerRloc16);
+    CHECK_TRUE(info.mServices[0].mServerData == std::vector<uint8_t>({0xab, 0xcd}));
+    CHECK_FALSE(info.mServices[0].mStable);
+    CHECK_EQUAL(0x12345678U, info.mServices[1].mEnterpriseNumber);
+    CHECK_EQUAL(2, info.mServices[1].mServiceId);
+    CHECK_TRUE(info.mServices[1].mServiceData.empty());
+    CHECK_EQUAL(0x6c00, info.mServices[1].mServerRloc16);
+    CHECK_TRUE(info.mServices[1].mServerData.empty());
+    CHECK_TRUE(info.mServices[1].mStable);
+}
+
+TEST(NetworkData, TestParseLocalRoute)
+{
+    // Has Route TLV of ::/0 by this device.
+    const std::vector<uint8_t> networkData = {0x02, 7, 0x00, 0, 0x00, 3, 0x6c, 0x00, 0x00};
+    NetworkDataInfo            info;
+
+    CHECK_EQUAL(OT_ERROR_NONE, ParseNetworkData(networkData.data(), networkData.size(), 0x6c00, info));
+    CHECK_EQUAL(1U, info.mExternalRoutes.size());
+    CHECK_EQUAL(0, info.mExternalRoutes[0].mPrefix.mLength);
+    CHECK_EQUAL(0, info.mExternalRoutes[0].mPreference);
+    CHECK_FALSE(info.mExternalRoutes[0].mStable);
+    CHECK_TRUE(info.mExternalRoutes[0].mNextHopIsThisDevice);
+
+    // Parsing again replaces the entries.
+    CHECK_EQUAL(OT_ERROR_NONE, ParseNetworkData(nullptr, 0, 0x6c00, info));
+    CHECK_TRUE(info.mExternalRoutes.empty());
+}
+
+TEST(NetworkData, TestParseMalformed)
+{
+    // The TLV is longer than the Network Data.
+    const std::vector<uint8_t> truncated = {0x03, 10, 0x00, 64, 0xfd, 0x00};
+    // The prefix is longer than the TLV.
+    const std::vector<uint8_t> shortPrefix = {0x03, 4, 0x00, 64, 0xfd, 0x00};
+    // The sub-TLV is longer than the Prefix TLV.
+    const std::vector<uint8_t> longSubTlv = {0x03, 5, 0x00, 0, 0x01, 3, 0x54, 0x00, 0x00};
+    // The service data is longer than the Service TLV.
+    const std::vector<uint8_t> longServiceData = {0x0b, 3, 0x81, 4, 0x5c};
+    NetworkDataInfo            info;
+
+    CHECK_EQUAL(OT_ERROR_PARSE, ParseNetworkData(truncated.data(), truncated.size(), 0, info));
+    CHECK_EQUAL(OT_ERROR_PARSE, ParseNetworkData(shortPrefix.data(), shortPrefix.size(), 0, info));
+    CHECK_EQUAL(OT_ERROR_PARSE, ParseNetworkData(longSubTlv.data(), longSubTlv.size(), 0, info));
+    CHECK_EQUAL(OT_ERROR_PARSE, ParseNetworkData(longServiceData.data(), longServiceData.size(), 0, info));
+}
@@ -46,3 +46,19 @@ TEST(Pskc, Test123456_0001020304050607_OpenThread)
     pskc = mPSKc.ComputePskc(extpanid, "OpenThread", "123456");
     MEMCMP_EQUAL(expected, pskc, sizeof(expected));
 }
+
+TEST(Pskc, TestRepeatedAndChangedInputs)
+{
+    uint8_t extpanid[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    uint8_t expected[] = {
+        0xb7, 0x83, 0x81, 0x27, 0x89, 0x91, 0x1e, 0xb4, 0xea, 0x76, 0x59, 0x6c, 0x9c, 0xed, 0x2a, 0x69,
+    };
+    uint8_t         other[sizeof(expected)];
+    otbr::Psk::Pskc anotherPSKc;
+
+    memcpy(other, mPSKc.ComputePskc(extpanid, "OpenThread", "654321"), sizeof(other));
+    MEMCMP_EQUAL(expected, mPSKc.ComputePskc(extpanid, "OpenThread", "123456"), sizeof(expected));
+    MEMCMP_EQUAL(expected, anotherPSKc.ComputePskc(extpanid, "OpenThread", "123456"), sizeof(expected));
+    MEMCMP_EQUAL(other, anotherPSKc.ComputePskc(extpanid, "OpenThread", "654321"), sizeof(other));
+    CHECK(memcmp(expected, other, sizeof(other)) != 0);
+}
@@ -0,0 +1,159 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <unistd.h>
+
+#include "common/reactor.hpp"
+
+TEST_GROUP(Reactor){};
+
+static const struct timeval kNoWait = {0, 0};
+
+TEST(Reactor, TestFdSetReadiness)
+{
+    otbr::Reactor reactor;
+    int           fds[2];
+    fd_set        readFdSet;
+    fd_set        writeFdSet;
+    fd_set        errorFdSet;
+
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Init());
+
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+    FD_SET(fds[0], &readFdSet);
+    FD_SET(fds[1], &writeFdSet);
+
+    CHECK_EQUAL(1, reactor.Poll(readFdSet, writeFdSet, errorFdSet, fds[1], kNoWait));
+    CHECK(!FD_ISSET(fds[0], &readFdSet));
+    CHECK(FD_ISSET(fds[1], &writeFdSet));
+
+    CHECK_EQUAL(1, write(fds[1], "x", 1));
+
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+    FD_SET(fds[0], &readFdSet);
+
+    CHECK_EQUAL(1, reactor.Poll(readFdSet, writeFdSet, errorFdSet, fds[0], kNoWait));
+    CHECK(FD_ISSET(fds[0], &readFdSet));
+
+    // Neither fd is in the fd sets any more, so nothing is watched.
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+
+    CHECK_EQUAL(0, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(Reactor, TestFdReuse)
+{
+    otbr::Reactor reactor;
+    int           fds[2];
+    int           reused[2];
+    fd_set        readFdSet;
+    fd_set        writeFdSet;
+    fd_set        errorFdSet;
+
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Init());
+
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+    FD_SET(fds[0], &readFdSet);
+    CHECK_EQUAL(0, reactor.Poll(readFdSet, writeFdSet, errorFdSet, fds[0], kNoWait));
+
+    // The numbers are reused by a new pipe before the next poll, which is watched for the same events.
+    close(fds[0]);
+    close(fds[1]);
+    CHECK_EQUAL(0, pipe(reused));
+    CHECK_EQUAL(fds[0], reused[0]);
+    CHECK_EQUAL(1, write(reused[1], "x", 1));
+
+    FD_SET(reused[0], &readFdSet);
+    CHECK_EQUAL(1, reactor.Poll(readFdSet, writeFdSet, errorFdSet, reused[0], kNoWait));
+    CHECK(FD_ISSET(reused[0], &readFdSet));
+
+    close(reused[0]);
+    close(reused[1]);
+}
+
+TEST(Reactor, TestHandler)
+{
+    otbr::Reactor reactor;
+    int           fds[2];
+    int           counter = 0;
+    uint32_t      events  = 0;
+    fd_set        readFdSet;
+    fd_set        writeFdSet;
+    fd_set        errorFdSet;
+
+    CHECK_EQUAL(0, pipe(fds));
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Init());
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Add(fds[0], otbr::Reactor::kEventReadable, [&](uint32_t aEvents) {
+        ++counter;
+        events = aEvents;
+    }));
+
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+    CHECK_EQUAL(0, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+    CHECK_EQUAL(0, counter);
+
+    CHECK_EQUAL(1, write(fds[1], "x", 1));
+    CHECK_EQUAL(1, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+    CHECK_EQUAL(1, counter);
+    CHECK_EQUAL(static_cast<uint32_t>(otbr::Reactor::kEventReadable), events);
+    // Handler readiness is not reported through the fd sets.
+    CHECK(!FD_ISSET(fds[0], &readFdSet));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Modify(fds[0], 0));
+    CHECK_EQUAL(0, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+    CHECK_EQUAL(1, counter);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, reactor.Modify(fds[0], otbr::Reactor::kEventReadable));
+    CHECK_EQUAL(1, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+    CHECK_EQUAL(2, counter);
+
+    reactor.Remove(fds[0]);
+    CHECK_EQUAL(0, reactor.Poll(readFdSet, writeFdSet, errorFdSet, -1, kNoWait));
+    CHECK_EQUAL(2, counter);
+    CHECK(reactor.Modify(fds[0], otbr::Reactor::kEventReadable) != OTBR_ERROR_NONE);
+
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -0,0 +1,90 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <list>
+#include <new>
+#include <string>
+
+#include "common/static_pool.hpp"
+
+TEST_GROUP(StaticPool){};
+
+TEST(StaticPool, TestStaticVector)
+{
+    otbr::StaticVector<std::string, 4> strings;
+
+    CHECK(strings.empty());
+    CHECK_EQUAL(4, strings.capacity());
+
+    strings.push_back("a");
+    strings.emplace_back("b");
+    strings.emplace_back(2, 'c');
+    CHECK_EQUAL(3, strings.size());
+    STRCMP_EQUAL("cc", strings.back().c_str());
+
+    CHECK(strings.erase(strings.begin()) == strings.begin());
+    CHECK_EQUAL(2, strings.size());
+    STRCMP_EQUAL("b", strings[0].c_str());
+    STRCMP_EQUAL("cc", strings[1].c_str());
+
+    strings.resize(4);
+    CHECK_EQUAL(4, strings.size());
+    CHECK(strings.back().empty());
+
+    strings.pop_back();
+    strings.clear();
+    CHECK(strings.empty());
+}
+
+TEST(StaticPool, TestStaticPoolAllocator)
+{
+    std::list<int, otbr::StaticPoolAllocator<int, 2>> values;
+    bool                                              exhausted = false;
+
+    values.push_back(1);
+    values.push_back(2);
+
+    try
+    {
+        values.push_back(3);
+    } catch (const std::bad_alloc &)
+    {
+        exhausted = true;
+    }
+
+    CHECK(exhausted);
+    CHECK_EQUAL(2, values.size());
+
+    // Freed nodes go back to the pool.
+    values.pop_front();
+    values.push_back(3);
+    CHECK_EQUAL(2, values.front());
+    CHECK_EQUAL(3, values.back());
+}
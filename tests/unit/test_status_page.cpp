@@ -0,0 +1,117 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string>
+#include <thread>
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "common/status_page.hpp"
+
+TEST_GROUP(StatusPage){};
+
+TEST(StatusPage, TestReadWrite)
+{
+    std::string            name = "/otbr-test-status-page-" + std::to_string(getpid());
+    otbr::StatusPageWriter writer;
+    otbr::StatusPageReader reader;
+    otbr::StatusPage       status = {};
+    otbr::StatusPage       read;
+
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_ERRNO);
+
+    CHECK(writer.Open(name.c_str()) == OTBR_ERROR_NONE);
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_NONE);
+
+    // Nothing published yet.
+    CHECK(reader.Read(read) == OTBR_ERROR_ERRNO);
+    CHECK_EQUAL(EAGAIN, errno);
+
+    status.mRole        = 4;
+    status.mChannel     = 15;
+    status.mRloc16      = 0xfc00;
+    status.mPartitionId = 0x12345678;
+    status.mMacTxTotal  = 100;
+    writer.Update(status);
+
+    CHECK(reader.Read(read) == OTBR_ERROR_NONE);
+    CHECK_EQUAL(4, read.mRole);
+    CHECK_EQUAL(15, read.mChannel);
+    CHECK_EQUAL(0xfc00, read.mRloc16);
+    CHECK_EQUAL(0x12345678, read.mPartitionId);
+    CHECK_EQUAL(100, read.mMacTxTotal);
+
+    status.mMacTxTotal = 101;
+    writer.Update(status);
+    CHECK(reader.Read(read) == OTBR_ERROR_NONE);
+    CHECK_EQUAL(101, read.mMacTxTotal);
+
+    // The page is removed along with the writer, an open reader keeps its mapping.
+    writer.Close();
+    CHECK(reader.Read(read) == OTBR_ERROR_NONE);
+    reader.Close();
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_ERRNO);
+}
+
+TEST(StatusPage, TestConsistentRead)
+{
+    static const uint32_t  kUpdates = 100000;
+    std::string            name     = "/otbr-test-status-page-" + std::to_string(getpid());
+    otbr::StatusPageWriter writer;
+    otbr::StatusPageReader reader;
+    otbr::StatusPage       read       = {};
+    bool                   consistent = true;
+
+    CHECK(writer.Open(name.c_str()) == OTBR_ERROR_NONE);
+    CHECK(reader.Open(name.c_str()) == OTBR_ERROR_NONE);
+
+    std::thread writerThread([&writer]() {
+        otbr::StatusPage status = {};
+
+        for (uint32_t i = 1; i <= kUpdates; i++)
+        {
+            status.mMacTxTotal   = i;
+            status.mIp6RxFailure = i;
+            writer.Update(status);
+        }
+    });
+
+    while (read.mMacTxTotal != kUpdates)
+    {
+        if (reader.Read(read) == OTBR_ERROR_NONE && read.mMacTxTotal != read.mIp6RxFailure)
+        {
+            consistent = false;
+        }
+    }
+
+    writerThread.join();
+    CHECK(consistent);
+}
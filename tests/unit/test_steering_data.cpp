@@ -0,0 +1,139 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/steering_data.hpp"
+
+TEST_GROUP(SteeringData){};
+
+static const uint8_t kEui64s[][otbr::SteeringData::kSizeJoinerId] = {
+    {0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x01},
+    {0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x02},
+    {0x00, 0x12, 0x4b, 0x00, 0x00, 0x00, 0x00, 0x03},
+};
+
+static void ComputeOneByOne(uint8_t aLength, size_t aCount, otbr::SteeringData &aSteeringData)
+{
+    aSteeringData.Init(aLength);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        uint8_t joinerId[otbr::SteeringData::kSizeJoinerId];
+
+        otbr::SteeringData::ComputeJoinerId(kEui64s[i], joinerId);
+        aSteeringData.ComputeBloomFilter(joinerId);
+    }
+}
+
+TEST(SteeringData, TestBuilderMatchesBloomFilter)
+{
+    uint8_t expected[] = {
+        0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x56,
+    };
+    otbr::SteeringDataBuilder builder;
+    otbr::SteeringData        steeringData;
+
+    builder.AddJoiners(kEui64s[0], 3);
+    CHECK_EQUAL(3, builder.GetJoinerCount());
+    CHECK_EQUAL(sizeof(expected), builder.GetSteeringData().GetLength());
+    MEMCMP_EQUAL(expected, builder.GetSteeringData().GetBloomFilter(), sizeof(expected));
+
+    builder.Rebuild(15);
+    ComputeOneByOne(15, 3, steeringData);
+    MEMCMP_EQUAL(steeringData.GetBloomFilter(), builder.GetSteeringData().GetBloomFilter(), 15);
+}
+
+TEST(SteeringData, TestFalsePositiveRate)
+{
+    otbr::SteeringData steeringData;
+
+    CHECK_EQUAL(0.0, otbr::SteeringData::ComputeFalsePositiveRate(16, 0));
+    DOUBLES_EQUAL(0.000242, otbr::SteeringData::ComputeFalsePositiveRate(16, 1), 0.000001);
+    CHECK(otbr::SteeringData::ComputeFalsePositiveRate(16, 64) > otbr::SteeringData::ComputeFalsePositiveRate(16, 32));
+    CHECK(otbr::SteeringData::ComputeFalsePositiveRate(8, 32) > otbr::SteeringData::ComputeFalsePositiveRate(16, 32));
+
+    CHECK_EQUAL(1, otbr::SteeringData::ComputeLength(0, 0.01));
+    CHECK_EQUAL(3, otbr::SteeringData::ComputeLength(1, 0.01));
+    CHECK_EQUAL(otbr::SteeringData::kMaxSizeOfBloomFilter, otbr::SteeringData::ComputeLength(1000, 0.01));
+
+    for (size_t count = 1; count <= 16; count++)
+    {
+        uint8_t length = otbr::SteeringData::ComputeLength(count, 0.05);
+
+        CHECK(otbr::SteeringData::ComputeFalsePositiveRate(length, count) <= 0.05);
+
+        if (length > 1)
+        {
+            CHECK(otbr::SteeringData::ComputeFalsePositiveRate(length - 1, count) > 0.05);
+        }
+    }
+
+    steeringData.Init(2);
+    CHECK_EQUAL(0.0, steeringData.GetFalsePositiveRate());
+    steeringData.SetBit(0);
+    steeringData.SetBit(1);
+    steeringData.SetBit(2);
+    steeringData.SetBit(3);
+    DOUBLES_EQUAL(0.0625, steeringData.GetFalsePositiveRate(), 0.000001);
+    steeringData.Set();
+    DOUBLES_EQUAL(1.0, steeringData.GetFalsePositiveRate(), 0.000001);
+}
+
+TEST(SteeringData, TestBuilderRebuildForFalsePositiveRate)
+{
+    otbr::SteeringDataBuilder builder;
+
+    builder.AddJoiners(kEui64s[0], 3);
+    builder.RebuildForFalsePositiveRate(0.1);
+    CHECK_EQUAL(otbr::SteeringData::ComputeLength(3, 0.1), builder.GetSteeringData().GetLength());
+    CHECK(builder.GetSteeringData().GetLength() < otbr::SteeringData::kMaxSizeOfBloomFilter);
+    CHECK(builder.GetSteeringData().GetFalsePositiveRate() <= 0.1);
+}
+
+TEST(SteeringData, TestBuilderAddAndRemove)
+{
+    otbr::SteeringDataBuilder builder(8);
+    otbr::SteeringData        steeringData;
+
+    builder.AddJoiner(kEui64s[0]);
+    builder.AddJoiner(kEui64s[1]);
+    ComputeOneByOne(8, 2, steeringData);
+    MEMCMP_EQUAL(steeringData.GetBloomFilter(), builder.GetSteeringData().GetBloomFilter(), 8);
+
+    builder.AddJoiner(kEui64s[2]);
+    CHECK_TRUE(builder.RemoveJoiner(kEui64s[2]));
+    CHECK_FALSE(builder.RemoveJoiner(kEui64s[2]));
+    CHECK_EQUAL(2, builder.GetJoinerCount());
+    MEMCMP_EQUAL(steeringData.GetBloomFilter(), builder.GetSteeringData().GetBloomFilter(), 8);
+
+    builder.Clear();
+    CHECK_EQUAL(0, builder.GetJoinerCount());
+    ComputeOneByOne(8, 0, steeringData);
+    MEMCMP_EQUAL(steeringData.GetBloomFilter(), builder.GetSteeringData().GetBloomFilter(), 8);
+}
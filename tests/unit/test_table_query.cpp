@@ -0,0 +1,77 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/table_query.hpp"
+
+TEST_GROUP(TableQuery){};
+
+TEST(TableQuery, TestPage)
+{
+    otbr::TableQuery query;
+    uint32_t         selected = 0;
+
+    query.SetPage(2, 3);
+
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        if (query.Select(i, i, 3))
+        {
+            CHECK(i >= 2 && i < 5);
+            selected++;
+        }
+    }
+
+    CHECK_EQUAL(3, selected);
+    CHECK_EQUAL(10, query.GetMatched());
+}
+
+TEST(TableQuery, TestFilters)
+{
+    otbr::TableQuery query;
+
+    CHECK_TRUE(query.Select(0x0401, 1, 0));
+
+    CHECK_FALSE(query.SetLinkQualityRange(3, 2));
+    CHECK_FALSE(query.SetLinkQualityRange(1, 4));
+    CHECK_TRUE(query.SetLinkQualityRange(2, 3));
+    CHECK_FALSE(query.Select(0x0401, 1, 1));
+    CHECK_TRUE(query.Select(0x0401, 1, 2));
+
+    query.SetRloc16(0x0402);
+    CHECK_FALSE(query.Select(0x0401, 2, 3));
+    CHECK_TRUE(query.Select(0x0402, 2, 3));
+
+    query.SetExtAddress(0x1122334455667788);
+    CHECK_FALSE(query.Select(0x0402, 2, 3));
+    CHECK_TRUE(query.Select(0x0402, 0x1122334455667788, 3));
+
+    // The first page is the whole table, only the matching entries are counted.
+    CHECK_EQUAL(4, query.GetMatched());
+}
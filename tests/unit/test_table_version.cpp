@@ -0,0 +1,151 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <vector>
+
+#include "common/table_version.hpp"
+
+TEST_GROUP(TableVersion){};
+
+static std::vector<uint64_t> GetRemoved(const otbr::TableVersion &aTable)
+{
+    std::vector<uint64_t> removed;
+
+    aTable.ForEachRemoved([&removed](uint64_t aKey) { removed.push_back(aKey); });
+
+    return removed;
+}
+
+TEST(TableVersion, TestDelta)
+{
+    otbr::TableVersion table(100, 8);
+    uint32_t           version;
+
+    // A reader without a version gets the whole table.
+    CHECK_TRUE(table.BeginScan(0));
+    CHECK_TRUE(table.Update(1, 10));
+    CHECK_TRUE(table.Update(2, 20));
+    table.EndScan();
+    version = table.GetVersion();
+    CHECK_EQUAL(101, version);
+
+    // Nothing changed.
+    CHECK_FALSE(table.BeginScan(version));
+    CHECK_FALSE(table.Update(1, 10));
+    CHECK_FALSE(table.Update(2, 20));
+    table.EndScan();
+    CHECK_EQUAL(version, table.GetVersion());
+    CHECK_TRUE(GetRemoved(table).empty());
+
+    // Entry 1 changed, entry 2 removed and entry 3 added.
+    CHECK_FALSE(table.BeginScan(version));
+    CHECK_TRUE(table.Update(1, 11));
+    CHECK_TRUE(table.Update(3, 30));
+    table.EndScan();
+    CHECK_EQUAL(version + 1, table.GetVersion());
+    CHECK_TRUE(GetRemoved(table) == std::vector<uint64_t>{2});
+
+    // A reader of the previous version still gets the same changes.
+    CHECK_FALSE(table.BeginScan(version));
+    CHECK_TRUE(table.Update(1, 11));
+    CHECK_TRUE(table.Update(3, 30));
+    table.EndScan();
+    CHECK_TRUE(GetRemoved(table) == std::vector<uint64_t>{2});
+
+    // A reader of the current version gets nothing.
+    version = table.GetVersion();
+    CHECK_FALSE(table.BeginScan(version));
+    CHECK_FALSE(table.Update(1, 11));
+    CHECK_FALSE(table.Update(3, 30));
+    table.EndScan();
+    CHECK_TRUE(GetRemoved(table).empty());
+}
+
+TEST(TableVersion, TestReAdded)
+{
+    otbr::TableVersion table(1, 8);
+    uint32_t           version;
+
+    table.BeginScan(0);
+    table.Update(1, 10);
+    table.EndScan();
+    version = table.GetVersion();
+
+    table.BeginScan(version);
+    table.EndScan();
+    table.BeginScan(version);
+    table.Update(1, 10);
+    table.EndScan();
+
+    // The entry is reported as updated, not as removed.
+    CHECK_FALSE(table.BeginScan(version));
+    CHECK_TRUE(table.Update(1, 10));
+    table.EndScan();
+    CHECK_TRUE(GetRemoved(table).empty());
+}
+
+TEST(TableVersion, TestUnknownVersion)
+{
+    otbr::TableVersion table(1000, 2);
+    uint32_t           version;
+
+    table.BeginScan(0);
+    for (uint64_t key = 0; key < 4; key++)
+    {
+        table.Update(key, 0);
+    }
+    table.EndScan();
+    version = table.GetVersion();
+
+    // Versions of a previous run are unknown.
+    CHECK_TRUE(table.BeginScan(version + 10));
+    table.EndScan();
+    CHECK_TRUE(table.BeginScan(version - 10));
+    table.EndScan();
+
+    // Removing more entries than remembered forgets the changes since older versions.
+    for (uint64_t key = 0; key < 4; key++)
+    {
+        table.BeginScan(table.GetVersion());
+        for (uint64_t other = key + 1; other < 4; other++)
+        {
+            table.Update(other, 0);
+        }
+        table.EndScan();
+    }
+
+    CHECK_TRUE(table.BeginScan(version));
+    table.EndScan();
+    CHECK_TRUE(GetRemoved(table).empty());
+
+    CHECK_FALSE(table.BeginScan(table.GetVersion() - 2));
+    table.EndScan();
+    CHECK_TRUE(GetRemoved(table) == (std::vector<uint64_t>{2, 3}));
+}
@@ -0,0 +1,108 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <CppUTest/TestHarness.h>
+
+#include <thread>
+#include <vector>
+
+#include "common/task_queue.hpp"
+
+TEST_GROUP(TaskQueue){};
+
+TEST(TaskQueue, TestRunInOrder)
+{
+    otbr::TaskQueue  queue;
+    std::vector<int> order;
+    fd_set           readFdSet;
+    int              maxFd = -1;
+
+    CHECK(queue.Init() == OTBR_ERROR_NONE);
+
+    queue.Post([&order]() { order.push_back(1); });
+    queue.Post([&order, &queue]() {
+        order.push_back(2);
+        queue.Post([&order]() { order.push_back(3); });
+    });
+
+    FD_ZERO(&readFdSet);
+    queue.UpdateFdSet(readFdSet, maxFd);
+    CHECK(maxFd >= 0);
+    CHECK_EQUAL(1, select(maxFd + 1, &readFdSet, nullptr, nullptr, nullptr));
+
+    CHECK_EQUAL(3, queue.Process(readFdSet));
+    CHECK(order == std::vector<int>({1, 2, 3}));
+
+    FD_ZERO(&readFdSet);
+    CHECK_EQUAL(0, queue.Process(readFdSet));
+}
+
+TEST(TaskQueue, TestMultipleProducers)
+{
+    static const int         kProducers = 4;
+    static const int         kTasks     = 10000;
+    otbr::TaskQueue          queue;
+    std::vector<std::thread> producers;
+    std::vector<int>         next(kProducers, 0);
+    int                      total   = 0;
+    bool                     ordered = true;
+
+    CHECK(queue.Init() == OTBR_ERROR_NONE);
+
+    for (int i = 0; i < kProducers; i++)
+    {
+        producers.emplace_back([&queue, &next, &ordered, i]() {
+            for (int j = 0; j < kTasks; j++)
+            {
+                queue.Post([&next, &ordered, i, j]() {
+                    ordered = ordered && next[i] == j;
+                    next[i] = j + 1;
+                });
+            }
+        });
+    }
+
+    while (total < kProducers * kTasks)
+    {
+        fd_set         readFdSet;
+        int            maxFd   = -1;
+        struct timeval timeout = {1, 0};
+
+        FD_ZERO(&readFdSet);
+        queue.UpdateFdSet(readFdSet, maxFd);
+        CHECK(select(maxFd + 1, &readFdSet, nullptr, nullptr, &timeout) > 0);
+        total += queue.Process(readFdSet);
+    }
+
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    CHECK_EQUAL(kProducers * kTasks, total);
+    CHECK(ordered);
+}
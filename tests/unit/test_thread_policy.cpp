@@ -0,0 +1,65 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "common/thread_policy.hpp"
+
+TEST_GROUP(ThreadPolicy){};
+
+TEST(ThreadPolicy, TestParse)
+{
+    CHECK_FALSE(otbr::IsThreadPolicySet(otbr::kThreadClassLog));
+
+    CHECK_TRUE(otbr::ParseThreadPolicy("radio=fifo:50@1"));
+    CHECK_TRUE(otbr::ParseThreadPolicy("radio=rr"));
+    CHECK_TRUE(otbr::ParseThreadPolicy("worker=@0,2-3"));
+    CHECK_TRUE(otbr::IsThreadPolicySet(otbr::kThreadClassWorker));
+
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio="));
+    CHECK_FALSE(otbr::ParseThreadPolicy("crypto=fifo"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=deadline"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=fifo:100"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=other:1"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=fifo@"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=@3-1"));
+    CHECK_FALSE(otbr::ParseThreadPolicy("radio=@1,"));
+    CHECK_FALSE(otbr::IsThreadPolicySet(otbr::kThreadClassLog));
+
+    STRCMP_EQUAL("radio", otbr::GetThreadClassName(otbr::kThreadClassRadio));
+}
+
+TEST(ThreadPolicy, TestApply)
+{
+    CHECK_EQUAL(OTBR_ERROR_NONE, otbr::ApplyThreadPolicy(otbr::kThreadClassMain));
+
+    CHECK_TRUE(otbr::ParseThreadPolicy("main=other"));
+    CHECK_TRUE(otbr::IsThreadPolicySet(otbr::kThreadClassMain));
+    CHECK_EQUAL(OTBR_ERROR_NONE, otbr::ApplyThreadPolicy(otbr::kThreadClassMain));
+}
@@ -0,0 +1,262 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common/time.hpp"
+#include "common/timer.hpp"
+
+TEST_GROUP(Timer){};
+
+static std::vector<uint64_t> sFired;
+static uint64_t              sNow;
+
+static void HandleTimer(otbr::Timer &aTimer, void *aContext)
+{
+    (void)aContext;
+    sFired.push_back(aTimer.GetDeadline());
+}
+
+static void HandleRestartTimer(otbr::Timer &aTimer, void *aContext)
+{
+    int *remaining = static_cast<int *>(aContext);
+
+    sFired.push_back(sNow);
+
+    if (--*remaining > 0)
+    {
+        aTimer.StartAt(sNow + 100);
+    }
+}
+
+TEST(Timer, TestFireInOrder)
+{
+    const uint64_t        kStart    = 1000;
+    const uint64_t        kDelays[] = {5, 0, 63, 64, 65, 4095, 4096, 300000, 90000000, 20000000000ULL};
+    otbr::TimerScheduler  scheduler(kStart);
+    std::vector<uint64_t> expected;
+
+    sFired.clear();
+
+    {
+        otbr::Timer timer0(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer1(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer2(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer3(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer4(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer5(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer6(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer7(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer8(HandleTimer, nullptr, scheduler);
+        otbr::Timer timer9(HandleTimer, nullptr, scheduler);
+        otbr::Timer *timers[] = {&timer0, &timer1, &timer2, &timer3, &timer4,
+                                 &timer5, &timer6, &timer7, &timer8, &timer9};
+
+        for (size_t i = 0; i < sizeof(kDelays) / sizeof(kDelays[0]); ++i)
+        {
+            timers[i]->StartAt(kStart + kDelays[i]);
+            expected.push_back(kStart + kDelays[i]);
+        }
+
+        std::sort(expected.begin(), expected.end());
+
+        for (uint64_t now = kStart; sFired.size() < expected.size(); now += 7)
+        {
+            uint64_t next = scheduler.GetNextDeadline();
+
+            CHECK(next <= expected[sFired.size()]);
+            // Jump straight to the next deadline when it is far away.
+            if (next > now + 7)
+            {
+                now = next;
+            }
+
+            scheduler.Process(now);
+
+            for (uint64_t deadline : sFired)
+            {
+                CHECK(deadline <= now);
+            }
+
+            for (size_t i = sFired.size(); i < expected.size(); ++i)
+            {
+                CHECK(expected[i] > now);
+            }
+        }
+
+        CHECK(expected == sFired);
+        CHECK_EQUAL(UINT64_MAX, scheduler.GetNextDeadline());
+    }
+}
+
+TEST(Timer, TestStopAndRestart)
+{
+    otbr::TimerScheduler scheduler(0);
+    otbr::Timer          timer1(HandleTimer, nullptr, scheduler);
+    otbr::Timer          timer2(HandleTimer, nullptr, scheduler);
+
+    sFired.clear();
+
+    timer1.StartAt(100);
+    timer2.StartAt(200);
+    CHECK(timer1.IsRunning());
+    CHECK(scheduler.GetNextDeadline() <= 100);
+
+    timer1.Stop();
+    CHECK(!timer1.IsRunning());
+
+    timer2.StartAt(50);
+    scheduler.Process(49);
+    CHECK(sFired.empty());
+
+    scheduler.Process(50);
+    CHECK_EQUAL(1U, sFired.size());
+    CHECK_EQUAL(50U, sFired[0]);
+    CHECK(!timer2.IsRunning());
+
+    scheduler.Process(1000);
+    CHECK_EQUAL(1U, sFired.size());
+}
+
+TEST(Timer, TestRestartFromHandler)
+{
+    int                  remaining = 3;
+    otbr::TimerScheduler scheduler(0);
+    otbr::Timer          timer(HandleRestartTimer, &remaining, scheduler);
+
+    sFired.clear();
+    timer.StartAt(100);
+
+    for (sNow = 0; sNow <= 1000; ++sNow)
+    {
+        scheduler.Process(sNow);
+    }
+
+    CHECK_EQUAL(3U, sFired.size());
+    CHECK_EQUAL(100U, sFired[0]);
+    CHECK_EQUAL(200U, sFired[1]);
+    CHECK_EQUAL(300U, sFired[2]);
+    CHECK(!timer.IsRunning());
+}
+
+TEST(Timer, TestUpdateTimeout)
+{
+    otbr::TimerScheduler scheduler(0);
+    otbr::Timer          timer(HandleTimer, nullptr, scheduler);
+    struct timeval       timeout = {10, 0};
+
+    scheduler.UpdateTimeout(0, timeout);
+    CHECK_EQUAL(10, timeout.tv_sec);
+
+    timer.StartAt(1500);
+    scheduler.UpdateTimeout(0, timeout);
+    CHECK(timeout.tv_sec * 1000 + timeout.tv_usec / 1000 <= 1500);
+
+    scheduler.UpdateTimeout(2000, timeout);
+    CHECK_EQUAL(0, timeout.tv_sec);
+    CHECK_EQUAL(0, timeout.tv_usec);
+}
+
+TEST(Timer, TestTimerTaskPool)
+{
+    otbr::TimerScheduler  scheduler(otbr::GetNow());
+    otbr::TimerTaskPool   pool(scheduler);
+    otbr::TimerTaskHandle empty;
+    otbr::TimerTaskHandle handle1;
+    otbr::TimerTaskHandle handle2;
+    int                   counter1 = 0;
+    int                   counter2 = 0;
+
+    CHECK(!empty.IsPending());
+    CHECK(!empty.Reschedule(10));
+
+    handle1 = pool.Post(0, [&counter1]() { ++counter1; });
+    handle2 = pool.Post(0, [&counter2]() { ++counter2; });
+    CHECK(handle1.IsPending());
+
+    handle2.Cancel();
+    CHECK(!handle2.IsPending());
+
+    scheduler.Process(otbr::GetNow() + 1);
+    CHECK_EQUAL(1, counter1);
+    CHECK_EQUAL(0, counter2);
+    CHECK(!handle1.IsPending());
+
+    // Tasks are recycled, stale handles must not affect the new task.
+    otbr::TimerTaskHandle handle3 = pool.Post(0, [&counter2]() { ++counter2; });
+
+    handle1.Cancel();
+    handle2.Cancel();
+    CHECK(!handle1.Reschedule(0));
+    CHECK(handle3.IsPending());
+}
+
+TEST(Timer, TestTimerTaskReschedule)
+{
+    otbr::TimerScheduler  scheduler(otbr::GetNow());
+    otbr::TimerTaskPool   pool(scheduler);
+    otbr::TimerTaskHandle handle;
+    int                   counter = 0;
+
+    handle = pool.Post(0, [&]() {
+        if (++counter < 3)
+        {
+            CHECK(handle.Reschedule(0));
+        }
+    });
+
+    while (handle.IsPending())
+    {
+        scheduler.Process(otbr::GetNow() + 1);
+    }
+
+    CHECK_EQUAL(3, counter);
+    CHECK(!handle.Reschedule(0));
+}
+
+TEST(Timer, TestMainloopNow)
+{
+    unsigned long sampled;
+
+    otbr::UpdateMainloopNow();
+    sampled = otbr::GetMainloopNow();
+
+    while (otbr::GetNow() == sampled)
+    {
+    }
+
+    CHECK_EQUAL(sampled, otbr::GetMainloopNow());
+    CHECK(otbr::GetNow() > sampled);
+    CHECK(otbr::GetNowPrecise() / 1000 >= sampled);
+
+    otbr::UpdateMainloopNow();
+    CHECK(otbr::GetMainloopNow() > sampled);
+}
@@ -0,0 +1,99 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "common/tlv.hpp"
+
+TEST_GROUP(Tlv){};
+
+TEST(Tlv, TestWriterAndView)
+{
+    uint8_t         buffer[300];
+    uint8_t         longValue[260];
+    otbr::TlvWriter writer(buffer, sizeof(buffer));
+    uint8_t         types[4];
+    size_t          count = 0;
+
+    memset(longValue, 0x5a, sizeof(longValue));
+
+    CHECK_TRUE(writer.Append(otbr::Meshcop::kState, static_cast<uint8_t>(otbr::Meshcop::kStateAccepted)));
+    CHECK_TRUE(writer.Append(otbr::Meshcop::kCommissionerSessionId, static_cast<uint16_t>(0x1234)));
+    CHECK_TRUE(writer.Append(otbr::Meshcop::kSteeringData, longValue, sizeof(longValue)));
+    CHECK_EQUAL(3 + 4 + 264, writer.GetLength());
+    CHECK_FALSE(writer.Append(otbr::Meshcop::kJoinerIid, longValue, 30));
+    CHECK_EQUAL(3 + 4 + 264, writer.GetLength());
+
+    otbr::TlvView view(buffer, writer.GetLength());
+
+    CHECK_TRUE(view.IsValid());
+
+    for (const otbr::Tlv &tlv : view)
+    {
+        types[count++] = tlv.GetType();
+    }
+
+    CHECK_EQUAL(3, count);
+    CHECK_EQUAL(otbr::Meshcop::kState, types[0]);
+    CHECK_EQUAL(otbr::Meshcop::kCommissionerSessionId, types[1]);
+    CHECK_EQUAL(otbr::Meshcop::kSteeringData, types[2]);
+
+    CHECK_EQUAL(0x1234, view.Find(otbr::Meshcop::kCommissionerSessionId)->GetValueUInt16());
+    CHECK_EQUAL(sizeof(longValue), view.Find(otbr::Meshcop::kSteeringData)->GetLength());
+    CHECK_TRUE(view.Find(otbr::Meshcop::kJoinerIid) == nullptr);
+
+    otbr::TlvIndex index(view);
+
+    CHECK_TRUE(index.Find(otbr::Meshcop::kState) == view.Find(otbr::Meshcop::kState));
+    CHECK_TRUE(index.Find(otbr::Meshcop::kJoinerIid) == nullptr);
+
+    CHECK_FALSE(otbr::TlvView(buffer, writer.GetLength(), /* aAllowExtended */ false).IsValid());
+}
+
+TEST(Tlv, TestViewStopsAtMalformedTlv)
+{
+    const uint8_t truncated[] = {0x10, 0x01, 0x01, 0x0b, 0x02, 0x12};
+    const uint8_t extended[]  = {0x10, 0x01, 0x01, 0x08, 0xff, 0x00};
+    size_t        count       = 0;
+
+    otbr::TlvView truncatedView(truncated, sizeof(truncated));
+
+    CHECK_FALSE(truncatedView.IsValid());
+
+    for (const otbr::Tlv &tlv : truncatedView)
+    {
+        CHECK_EQUAL(otbr::Meshcop::kState, tlv.GetType());
+        count++;
+    }
+
+    CHECK_EQUAL(1, count);
+    CHECK_TRUE(truncatedView.Find(otbr::Meshcop::kCommissionerSessionId) == nullptr);
+
+    CHECK_FALSE(otbr::TlvView(extended, sizeof(extended)).IsValid());
+    CHECK_TRUE(otbr::TlvView(extended, 0).IsValid());
+}
@@ -0,0 +1,108 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+
+#include <CppUTest/TestHarness.h>
+
+#include "utils/topology.hpp"
+
+TEST_GROUP(Topology){};
+
+TEST(Topology, TestCrawlFollowsRouters)
+{
+    std::vector<uint16_t> queries;
+    otbr::Topology        topology(
+        [&queries](uint16_t aRloc16) {
+            queries.push_back(aRloc16);
+            return true;
+        },
+        /* aMaxQueries */ 2, /* aQueryTimeout */ 1000, /* aNodeTtl */ 60000);
+    otbr::Topology::Node node = {};
+    uint64_t             deadline;
+
+    CHECK(!topology.IsCrawling());
+    CHECK(!topology.GetNextDeadline(deadline));
+
+    topology.Start(0, {0x0000});
+    CHECK(topology.IsCrawling());
+    CHECK(queries == std::vector<uint16_t>({0x0000}));
+    CHECK(topology.GetNextDeadline(deadline));
+    CHECK_EQUAL(1000, deadline);
+
+    // Routers already queried are not queried again, and only two queries are in flight.
+    node.mRloc16 = 0x0000;
+    node.mLinks  = {{0x0400, 3, 3}};
+    topology.HandleResponse(100, node, {0x0000, 0x0400, 0x0800, 0x0c00});
+    CHECK(queries == std::vector<uint16_t>({0x0000, 0x0400, 0x0800}));
+
+    node.mRloc16 = 0x0400;
+    node.mLinks  = {{0x0000, 3, 3}};
+    topology.HandleResponse(200, node, {0x0000, 0x0400, 0x0800, 0x0c00});
+    CHECK(queries == std::vector<uint16_t>({0x0000, 0x0400, 0x0800, 0x0c00}));
+
+    // The queries of 0x0800 and 0x0c00 time out.
+    topology.Process(1100);
+    CHECK(topology.IsCrawling());
+    topology.Process(1200);
+    CHECK(!topology.IsCrawling());
+
+    CHECK_EQUAL(2, topology.GetNodes().size());
+    CHECK_EQUAL(100, topology.GetNodes().at(0x0000).mUpdateTime);
+    CHECK_EQUAL(0x0400, topology.GetNodes().at(0x0000).mLinks[0].mRloc16);
+
+    // Each crawl queries the routers again.
+    topology.Start(2000, {0x0400});
+    CHECK_EQUAL(0x0400, queries.back());
+    topology.Stop();
+    CHECK(!topology.IsCrawling());
+}
+
+TEST(Topology, TestNodesExpire)
+{
+    otbr::Topology       topology([](uint16_t) { return false; }, 4, 1000, 60000);
+    otbr::Topology::Node node = {};
+
+    // A router whose query cannot be sent does not hold the crawl.
+    topology.Start(0, {0x0000, 0x0400});
+    CHECK(!topology.IsCrawling());
+
+    node.mRloc16 = 0x0000;
+    topology.HandleResponse(0, node, {});
+    node.mRloc16 = 0x0400;
+    topology.HandleResponse(30000, node, {});
+
+    topology.Expire(60000);
+    CHECK_EQUAL(2, topology.GetNodes().size());
+    topology.Expire(60001);
+    CHECK_EQUAL(1, topology.GetNodes().size());
+    CHECK(topology.GetNodes().count(0x0400));
+
+    topology.Clear();
+    CHECK(topology.GetNodes().empty());
+}
@@ -0,0 +1,97 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <atomic>
+
+#include <sys/select.h>
+
+#include "common/task_queue.hpp"
+#include "common/worker_pool.hpp"
+
+TEST_GROUP(WorkerPool){};
+
+TEST(WorkerPool, TestCompletionsOnConsumer)
+{
+    static const int kTasks = 1000;
+    otbr::WorkerPool pool;
+    otbr::TaskQueue  completions;
+    std::atomic<int> ran(0);
+    int              completed  = 0;
+    std::thread::id  consumer   = std::this_thread::get_id();
+    bool             onConsumer = true;
+
+    CHECK(completions.Init() == OTBR_ERROR_NONE);
+    CHECK(!pool.IsRunning());
+    pool.Start(4);
+    CHECK(pool.IsRunning());
+
+    for (int i = 0; i < kTasks; i++)
+    {
+        pool.Post([&]() {
+            ++ran;
+            completions.Post([&]() {
+                onConsumer = onConsumer && std::this_thread::get_id() == consumer;
+                ++completed;
+            });
+        });
+    }
+
+    while (completed < kTasks)
+    {
+        fd_set         readFdSet;
+        int            maxFd   = -1;
+        struct timeval timeout = {1, 0};
+
+        FD_ZERO(&readFdSet);
+        completions.UpdateFdSet(readFdSet, maxFd);
+        CHECK(select(maxFd + 1, &readFdSet, nullptr, nullptr, &timeout) > 0);
+        completions.Process(readFdSet);
+    }
+
+    pool.Stop();
+    CHECK(!pool.IsRunning());
+    CHECK_EQUAL(kTasks, ran.load());
+    CHECK(onConsumer);
+    CHECK_EQUAL(0, pool.GetQueueDepth());
+}
+
+TEST(WorkerPool, TestStopDropsQueuedTasks)
+{
+    otbr::WorkerPool pool;
+    int              ran = 0;
+
+    // Tasks posted to a stopped pool wait for workers.
+    pool.Post([&ran]() { ++ran; });
+    CHECK_EQUAL(1, pool.GetQueueDepth());
+
+    pool.Stop();
+    CHECK_EQUAL(0, pool.GetQueueDepth());
+    CHECK_EQUAL(0, ran);
+}
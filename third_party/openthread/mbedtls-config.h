@@ -36,6 +36,11 @@
 #define MBEDTLS_HAVE_ASM
 #endif
 
+// AES-NI support is detected at runtime and speeds up the AES-CMAC rounds of the PSKc derivation.
+#if defined(MBEDTLS_HAVE_ASM) && (defined(__amd64__) || defined(__x86_64__))
+#define MBEDTLS_AESNI_C
+#endif
+
 #define MBEDTLS_AES_ROM_TABLES
 #define MBEDTLS_ECP_DP_SECP256R1_ENABLED
 #define MBEDTLS_ECP_NIST_OPTIM
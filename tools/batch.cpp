@@ -0,0 +1,301 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the batch mode of the tools.
+ */
+
+#include "batch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sysexits.h>
+
+#include "common/code_utils.hpp"
+
+namespace otbr {
+namespace Tools {
+
+Batch::Batch(const std::vector<std::string> &aColumns, const Compute &aCompute)
+    : mColumns(aColumns)
+    , mCompute(aCompute)
+    , mFormat(kFormatCsv)
+    , mJobs(0)
+{
+    SetJobs(0);
+}
+
+bool Batch::SetFormat(const char *aFormat)
+{
+    bool valid = true;
+
+    if (strcmp(aFormat, "csv") == 0)
+    {
+        mFormat = kFormatCsv;
+    }
+    else if (strcmp(aFormat, "json") == 0)
+    {
+        mFormat = kFormatJson;
+    }
+    else
+    {
+        valid = false;
+    }
+
+    return valid;
+}
+
+void Batch::SetJobs(unsigned aJobs)
+{
+    mJobs = (aJobs != 0) ? aJobs : std::thread::hardware_concurrency();
+
+    // The number of cores is not always known.
+    if (mJobs == 0)
+    {
+        mJobs = 1;
+    }
+}
+
+int Batch::Run(const char *aInput)
+{
+    std::ifstream            file;
+    std::istream *           input = &std::cin;
+    std::vector<std::string> records;
+    std::vector<size_t>      lines;
+    std::vector<Result>      results;
+    std::string              line;
+    size_t                   lineNumber = 0;
+    size_t                   computed   = 0;
+    size_t                   invalid    = 0;
+    bool                     first      = true;
+    int                      ret        = EX_OK;
+    double                   seconds;
+    auto                     start = std::chrono::steady_clock::now();
+
+    if (strcmp(aInput, "-") != 0)
+    {
+        file.open(aInput);
+        VerifyOrExit(file.is_open(), fprintf(stderr, "Failed to open %s: %s\n", aInput, strerror(errno)),
+                     ret = EX_NOINPUT);
+        input = &file;
+    }
+
+    if (mFormat == kFormatCsv)
+    {
+        for (size_t i = 0; i < mColumns.size(); i++)
+        {
+            printf("%s%s", i == 0 ? "" : ",", mColumns[i].c_str());
+        }
+        printf("\n");
+    }
+    else
+    {
+        printf("[");
+    }
+
+    while (input->good())
+    {
+        records.clear();
+        lines.clear();
+
+        while (records.size() < kChunkSize && std::getline(*input, line))
+        {
+            ++lineNumber;
+
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            records.push_back(line);
+            lines.push_back(lineNumber);
+        }
+
+        ComputeChunk(records, results);
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (!results[i].mValid)
+            {
+                fprintf(stderr, "%s:%zu: %s\n", aInput, lines[i], results[i].mError.c_str());
+                ++invalid;
+                continue;
+            }
+
+            WriteResult(results[i], first);
+            first = false;
+        }
+
+        computed += results.size();
+    }
+
+    if (mFormat == kFormatJson)
+    {
+        printf("%s]\n", first ? "" : "\n");
+    }
+
+    fflush(stdout);
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "%zu records, %zu invalid, in %.3f s on %u threads: %.1f records/s\n", computed, invalid, seconds,
+            mJobs, seconds > 0 ? computed / seconds : 0.0);
+
+    VerifyOrExit(!input->bad(), fprintf(stderr, "Failed to read %s\n", aInput), ret = EX_IOERR);
+
+    if (invalid != 0)
+    {
+        ret = EX_DATAERR;
+    }
+
+exit:
+    return ret;
+}
+
+void Batch::ComputeChunk(const std::vector<std::string> &aRecords, std::vector<Result> &aResults) const
+{
+    std::atomic<size_t>      next(0);
+    std::vector<std::thread> threads;
+    auto                     work = [&]() {
+        size_t index;
+
+        while ((index = next.fetch_add(1, std::memory_order_relaxed)) < aRecords.size())
+        {
+            Result &result = aResults[index];
+
+            result.mValues.clear();
+            result.mValid = mCompute(aRecords[index], result.mValues, result.mError);
+        }
+    };
+
+    aResults.resize(aRecords.size());
+
+    // Records are claimed one at a time, so a slow record does not hold back the others of a thread.
+    for (unsigned i = 1; i < mJobs && i < aRecords.size(); i++)
+    {
+        threads.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void Batch::WriteResult(const Result &aResult, bool aFirst) const
+{
+    if (mFormat == kFormatCsv)
+    {
+        for (size_t i = 0; i < aResult.mValues.size(); i++)
+        {
+            printf("%s%s", i == 0 ? "" : ",", QuoteCsv(aResult.mValues[i]).c_str());
+        }
+        printf("\n");
+    }
+    else
+    {
+        printf("%s\n  {", aFirst ? "" : ",");
+
+        for (size_t i = 0; i < aResult.mValues.size() && i < mColumns.size(); i++)
+        {
+            printf("%s\"%s\": %s", i == 0 ? "" : ", ", mColumns[i].c_str(), QuoteJson(aResult.mValues[i]).c_str());
+        }
+
+        printf("}");
+    }
+}
+
+std::string Batch::QuoteCsv(const std::string &aValue)
+{
+    std::string quoted;
+
+    VerifyOrExit(aValue.find_first_of(",\"\r\n") != std::string::npos, quoted = aValue);
+
+    quoted.push_back('"');
+
+    for (char c : aValue)
+    {
+        if (c == '"')
+        {
+            quoted.push_back('"');
+        }
+
+        quoted.push_back(c);
+    }
+
+    quoted.push_back('"');
+
+exit:
+    return quoted;
+}
+
+std::string Batch::QuoteJson(const std::string &aValue)
+{
+    std::string quoted = "\"";
+
+    for (char c : aValue)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted.push_back('\\');
+            quoted.push_back(c);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[sizeof("\\u0000")];
+
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            quoted += escaped;
+        }
+        else
+        {
+            quoted.push_back(c);
+        }
+    }
+
+    quoted.push_back('"');
+
+    return quoted;
+}
+
+} // namespace Tools
+} // namespace otbr
@@ -0,0 +1,146 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the batch mode of the tools.
+ */
+
+#ifndef OTBR_TOOLS_BATCH_HPP_
+#define OTBR_TOOLS_BATCH_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace otbr {
+namespace Tools {
+
+/**
+ * This class computes the results of input records on several threads, one record per line.
+ *
+ * Empty lines and lines starting with '#' are skipped. Results are written in the input order, invalid records are
+ * reported on stderr and left out of the output. The throughput is reported on stderr once all records are done.
+ *
+ */
+class Batch
+{
+public:
+    /**
+     * This enumeration defines the output formats.
+     *
+     */
+    enum Format
+    {
+        kFormatCsv,  ///< A header line followed by one line of comma separated values per record.
+        kFormatJson, ///< An array with one object per record.
+    };
+
+    /**
+     * This function computes the values of a record.
+     *
+     * It is called concurrently from several threads.
+     *
+     * @param[in]   aRecord     The input line.
+     * @param[out]  aValues     The values of the record, in the order of the columns.
+     * @param[out]  aError      The reason the record is invalid.
+     *
+     * @retval true     The record was computed.
+     * @retval false    The record is invalid.
+     *
+     */
+    typedef std::function<bool(const std::string &aRecord, std::vector<std::string> &aValues, std::string &aError)>
+        Compute;
+
+    /**
+     * The constructor of a batch.
+     *
+     * @param[in]   aColumns    The names of the values of a record.
+     * @param[in]   aCompute    The function computing the values of a record.
+     *
+     */
+    Batch(const std::vector<std::string> &aColumns, const Compute &aCompute);
+
+    /**
+     * This method sets the output format, CSV by default.
+     *
+     * @param[in]   aFormat     The name of the format, either "csv" or "json".
+     *
+     * @retval true     Successfully set the format.
+     * @retval false    The format is unknown.
+     *
+     */
+    bool SetFormat(const char *aFormat);
+
+    /**
+     * This method sets the number of threads, the number of cores by default.
+     *
+     * @param[in]   aJobs   The number of threads, 0 for the number of cores.
+     *
+     */
+    void SetJobs(unsigned aJobs);
+
+    /**
+     * This method computes all records of the input and writes the results to stdout.
+     *
+     * @param[in]   aInput  The path of the input file, "-" for stdin.
+     *
+     * @returns A sysexits code, EX_DATAERR if any record is invalid.
+     *
+     */
+    int Run(const char *aInput);
+
+private:
+    enum
+    {
+        kChunkSize = 4096, ///< The number of records read and computed at once.
+    };
+
+    struct Result
+    {
+        std::vector<std::string> mValues;
+        std::string              mError;
+        bool                     mValid;
+    };
+
+    void ComputeChunk(const std::vector<std::string> &aRecords, std::vector<Result> &aResults) const;
+    void WriteResult(const Result &aResult, bool aFirst) const;
+
+    static std::string QuoteCsv(const std::string &aValue);
+    static std::string QuoteJson(const std::string &aValue);
+
+    std::vector<std::string> mColumns;
+    Compute                  mCompute;
+    Format                   mFormat;
+    unsigned                 mJobs;
+};
+
+} // namespace Tools
+} // namespace otbr
+
+#endif // OTBR_TOOLS_BATCH_HPP_
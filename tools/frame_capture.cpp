@@ -0,0 +1,206 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a simple tool to write the frames captured by otbr-agent as pcap.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sysexits.h>
+#include <time.h>
+
+#include <string>
+
+#include "common/code_utils.hpp"
+#include "common/frame_capture.hpp"
+
+enum
+{
+    kLinkTypeIeee802154Tap = 283, ///< LINKTYPE_IEEE802_15_4_TAP, a TLV header followed by the frame without FCS.
+    kTapTlvFcsType         = 0,
+    kTapTlvRss             = 1,
+    kTapTlvChannel         = 3,
+    kFcsSize               = 2,
+};
+
+// The time to wait for frames while the ring is empty.
+static const struct timespec kPollInterval = {0, 10 * 1000 * 1000};
+
+static volatile sig_atomic_t sStopped = 0;
+
+void help(void)
+{
+    printf("frame-capture - write the 802.15.4 frames captured by otbr-agent as pcap\n"
+           "SYNTAX:\n"
+           "    frame-capture <INTERFACE> <PCAP | ->\n"
+           "EXAMPLE:\n"
+           "    frame-capture wpan0 thread.pcap\n"
+           "    frame-capture wpan0 - | wireshark -k -i -\n");
+}
+
+static void HandleSignal(int)
+{
+    sStopped = 1;
+}
+
+static void PutLittleEndian16(uint8_t *aBuffer, uint16_t aValue)
+{
+    aBuffer[0] = static_cast<uint8_t>(aValue);
+    aBuffer[1] = static_cast<uint8_t>(aValue >> 8);
+}
+
+static uint8_t *PutTapTlv(uint8_t *aBuffer, uint16_t aType, const void *aValue, uint16_t aLength)
+{
+    PutLittleEndian16(aBuffer, aType);
+    PutLittleEndian16(aBuffer + 2, aLength);
+    memset(aBuffer + 4, 0, (aLength + 3u) & ~3u);
+    memcpy(aBuffer + 4, aValue, aLength);
+
+    // Values are padded to 4 bytes.
+    return aBuffer + 4 + ((aLength + 3u) & ~3u);
+}
+
+static bool WritePcapHeader(FILE *aOutput)
+{
+    struct
+    {
+        uint32_t mMagic;
+        uint16_t mVersionMajor;
+        uint16_t mVersionMinor;
+        int32_t  mThisZone;
+        uint32_t mSigFigs;
+        uint32_t mSnapLen;
+        uint32_t mLinkType;
+    } header = {0xa1b2c3d4, 2, 4, 0, 0, 256, kLinkTypeIeee802154Tap};
+
+    return fwrite(&header, sizeof(header), 1, aOutput) == 1;
+}
+
+static bool WriteFrame(FILE *aOutput, const otbr::FrameRecord &aRecord)
+{
+    struct
+    {
+        uint32_t mSeconds;
+        uint32_t mMicroseconds;
+        uint32_t mIncludedLength;
+        uint32_t mOriginalLength;
+    } header;
+    uint8_t  tap[4 + 3 * 8];
+    uint8_t *end         = tap + 4;
+    uint8_t  fcsType     = 0;
+    uint8_t  channel[3]  = {aRecord.mChannel, 0, 0};
+    uint16_t frameLength = (aRecord.mLength > kFcsSize) ? aRecord.mLength - kFcsSize : 0;
+
+    // The FCS is not always valid, e.g. of transmitted frames, so frames are written without it.
+    end = PutTapTlv(end, kTapTlvFcsType, &fcsType, sizeof(fcsType));
+    if (!(aRecord.mFlags & otbr::FrameRecord::kFlagTx) && aRecord.mRssi != 127)
+    {
+        float    rss = aRecord.mRssi;
+        uint32_t rssBits;
+        uint8_t  rssBytes[4];
+
+        memcpy(&rssBits, &rss, sizeof(rssBits));
+        PutLittleEndian16(rssBytes, static_cast<uint16_t>(rssBits));
+        PutLittleEndian16(rssBytes + 2, static_cast<uint16_t>(rssBits >> 16));
+        end = PutTapTlv(end, kTapTlvRss, rssBytes, sizeof(rssBytes));
+    }
+    end = PutTapTlv(end, kTapTlvChannel, channel, sizeof(channel));
+
+    tap[0] = 0; // version
+    tap[1] = 0; // reserved
+    PutLittleEndian16(tap + 2, static_cast<uint16_t>(end - tap));
+
+    header.mSeconds        = static_cast<uint32_t>(aRecord.mTimestamp / 1000000);
+    header.mMicroseconds   = static_cast<uint32_t>(aRecord.mTimestamp % 1000000);
+    header.mIncludedLength = static_cast<uint32_t>(end - tap) + frameLength;
+    header.mOriginalLength = header.mIncludedLength;
+
+    // The frame is written from the ring as is.
+    return fwrite(&header, sizeof(header), 1, aOutput) == 1 && fwrite(tap, end - tap, 1, aOutput) == 1 &&
+           fwrite(aRecord.mPsdu, 1, frameLength, aOutput) == frameLength;
+}
+
+int main(int argc, char *argv[])
+{
+    int                      ret    = 0;
+    FILE *                   output = nullptr;
+    uint64_t                 frames = 0;
+    std::string              name;
+    otbr::FrameCaptureReader reader;
+
+    VerifyOrExit(argc == 3, help(), ret = EX_USAGE);
+
+    name = std::string("/otbr-agent-") + argv[1] + "-frames";
+    VerifyOrExit(reader.Open(name.c_str()) == OTBR_ERROR_NONE,
+                 fprintf(stderr, "Failed to open frame capture %s: %s\n", name.c_str(), strerror(errno)),
+                 ret = EX_UNAVAILABLE);
+
+    output = (strcmp(argv[2], "-") == 0) ? stdout : fopen(argv[2], "wb");
+    VerifyOrExit(output != nullptr, fprintf(stderr, "Failed to open %s: %s\n", argv[2], strerror(errno)),
+                 ret = EX_CANTCREAT);
+    VerifyOrExit(WritePcapHeader(output), ret = EX_IOERR);
+
+    signal(SIGINT, HandleSignal);
+    signal(SIGTERM, HandleSignal);
+
+    while (!sStopped)
+    {
+        const otbr::FrameRecord *record = reader.Peek();
+
+        if (record == nullptr)
+        {
+            // Readers of a pipe see the frames once the ring has been drained.
+            VerifyOrExit(fflush(output) == 0, ret = EX_IOERR);
+            nanosleep(&kPollInterval, nullptr);
+            continue;
+        }
+
+        VerifyOrExit(WriteFrame(output, *record), ret = EX_IOERR);
+        reader.Consume();
+        frames++;
+    }
+
+exit:
+    if (output != nullptr)
+    {
+        fprintf(stderr, "%llu frames captured, %llu dropped\n", static_cast<unsigned long long>(frames),
+                static_cast<unsigned long long>(reader.GetDroppedFrames()));
+    }
+
+    if (output != nullptr && output != stdout)
+    {
+        fclose(output);
+    }
+
+    return ret;
+}
@@ -0,0 +1,72 @@
+/*
+ *    Copyright (c) 2020, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a simple tool to decode binary and circular logs.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sysexits.h>
+
+#include "common/binary_logging.hpp"
+#include "common/circular_logging.hpp"
+#include "common/code_utils.hpp"
+
+void help(void)
+{
+    printf("log-decoder - decode binary and circular logs\n"
+           "SYNTAX:\n"
+           "    log-decoder <BINARY_LOG | CIRCULAR_LOG>\n"
+           "EXAMPLE:\n"
+           "    log-decoder /var/log/otbr-agent.bin\n"
+           "    log-decoder /run/otbr-agent.log\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int       ret = 0;
+    otbrError error;
+
+    VerifyOrExit(argc == 2, help(), ret = EX_USAGE);
+
+    // Both decoders check the header first, EINVAL means the file is of the other kind.
+    error = otbr::BinaryLog::Decode(argv[1], stdout);
+    if (error == OTBR_ERROR_ERRNO && errno == EINVAL)
+    {
+        error = otbr::CircularLog::Decode(argv[1], stdout);
+    }
+
+    VerifyOrExit(error == OTBR_ERROR_NONE, fprintf(stderr, "Failed to decode %s: %s\n", argv[1], strerror(errno)),
+                 ret = EX_DATAERR);
+
+exit:
+    return ret;
+}
@@ -31,9 +31,17 @@
  *   This file implements a simple tool to compute pskc.
  */
 
+#include <getopt.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sysexits.h>
 
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "batch.hpp"
 #include "common/code_utils.hpp"
 #include "utils/hex.hpp"
 #include "utils/pskc.hpp"
@@ -53,57 +61,137 @@ void help(void)
     printf("pskc - compute PSKc\n"
            "SYNTAX:\n"
            "    pskc <PASSPHRASE> <EXTPANID> <NETWORK_NAME>\n"
+           "    pskc -b <RECORDS | -> [-j <JOBS>] [-f <csv | json>]\n"
+           "OPTIONS:\n"
+           "    -b, --batch     Compute the records of a file, \"-\" for stdin. Each line holds the arguments\n"
+           "                    <PASSPHRASE> <EXTPANID> <NETWORK_NAME> separated by spaces, the network name\n"
+           "                    being the rest of the line.\n"
+           "    -j, --jobs      Number of threads in batch mode, the number of cores by default.\n"
+           "    -f, --format    Output format in batch mode, csv by default.\n"
            "EXAMPLE:\n"
-           "    pskc 654321 1122334455667788 OpenThread\n");
+           "    pskc 654321 1122334455667788 OpenThread\n"
+           "    pskc -b devices.txt -f json\n");
 }
 
-int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+bool ComputePskc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName, std::string &aPskc,
+                 std::string &aError)
 {
     uint8_t extpanid[kSizeExtPanId];
     size_t  length;
-    int     ret = -1;
+    bool    valid = false;
 
     otbr::Psk::Pskc pskcComputer;
     const uint8_t * pskc;
+    char            hex[OT_PSKC_LENGTH * 2 + 1];
 
     length = strlen(aPassphrase);
-    VerifyOrExit(length > 0, printf("PASSPHRASE must not be empty.\n"));
+    VerifyOrExit(length > 0, aError = "PASSPHRASE must not be empty.");
     VerifyOrExit(length <= kMaxPassphrase,
-                 printf("PASSPHRASE Passphrase must be no more than %d bytes.\n", kMaxPassphrase));
+                 aError = "PASSPHRASE Passphrase must be no more than " + std::to_string(kMaxPassphrase) + " bytes.");
 
     length = strlen(aExtPanId);
-    VerifyOrExit(length == kSizeExtPanId * 2, printf("EXTPANID length must be %d bytes.\n", kSizeExtPanId));
+    VerifyOrExit(length == kSizeExtPanId * 2,
+                 aError = "EXTPANID length must be " + std::to_string(kSizeExtPanId) + " bytes.");
     for (size_t i = 0; i < length; i++)
     {
         VerifyOrExit((aExtPanId[i] <= '9' && aExtPanId[i] >= '0') || (aExtPanId[i] <= 'f' && aExtPanId[i] >= 'a') ||
                          (aExtPanId[i] <= 'F' && aExtPanId[i] >= 'A'),
-                     printf("EXTPANID must be encoded in hex.\n"));
+                     aError = "EXTPANID must be encoded in hex.");
     }
     otbr::Utils::Hex2Bytes(aExtPanId, extpanid, sizeof(extpanid));
 
     length = strlen(aNetworkName);
-    VerifyOrExit(length > 0, printf("NETWORK_NAME must not be empty.\n"));
-    VerifyOrExit(length <= kMaxNetworkName,
-                 printf("NETWOR_KNAME length must be no more than %d bytes.\n", kMaxNetworkName));
+    VerifyOrExit(length > 0, aError = "NETWORK_NAME must not be empty.");
+    VerifyOrExit(length <= kMaxNetworkName, aError = "NETWOR_KNAME length must be no more than " +
+                                                     std::to_string(kMaxNetworkName) + " bytes.");
 
     pskc = pskcComputer.ComputePskc(extpanid, aNetworkName, aPassphrase);
-    for (int i = 0; i < 16; i++)
+    for (int i = 0; i < OT_PSKC_LENGTH; i++)
     {
-        printf("%02x", pskc[i]);
+        snprintf(&hex[i * 2], sizeof(hex) - i * 2, "%02x", pskc[i]);
     }
-    printf("\n");
+    aPskc = hex;
+    valid = true;
+
+exit:
+    return valid;
+}
+
+int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+{
+    std::string pskc;
+    std::string error;
+    int         ret = -1;
+
+    VerifyOrExit(ComputePskc(aPassphrase, aExtPanId, aNetworkName, pskc, error), printf("%s\n", error.c_str()));
+    printf("%s\n", pskc.c_str());
     ret = 0;
 
 exit:
     return ret;
 }
 
+bool ComputeRecord(const std::string &aRecord, std::vector<std::string> &aValues, std::string &aError)
+{
+    std::istringstream record(aRecord);
+    std::string        passphrase;
+    std::string        extpanid;
+    std::string        networkName;
+    std::string        pskc;
+    bool               valid = false;
+
+    record >> passphrase >> extpanid >> std::ws;
+    std::getline(record, networkName);
+    VerifyOrExit(!networkName.empty(), aError = "Expected <PASSPHRASE> <EXTPANID> <NETWORK_NAME>.");
+
+    VerifyOrExit(ComputePskc(passphrase.c_str(), extpanid.c_str(), networkName.c_str(), pskc, aError));
+    aValues = {passphrase, extpanid, networkName, pskc};
+    valid   = true;
+
+exit:
+    return valid;
+}
+
 int main(int argc, char *argv[])
 {
-    int ret = 0;
+    static const option kOptions[] = {{"batch", required_argument, nullptr, 'b'},
+                                      {"jobs", required_argument, nullptr, 'j'},
+                                      {"format", required_argument, nullptr, 'f'},
+                                      {"help", no_argument, nullptr, 'h'},
+                                      {nullptr, 0, nullptr, 0}};
+
+    otbr::Tools::Batch batch({"passphrase", "extpanid", "network_name", "pskc"}, ComputeRecord);
+    const char *       input = nullptr;
+    int                ret   = 0;
+    int                opt;
+
+    // Options must come first, so that a passphrase starting with '-' is still taken as is after "--".
+    while ((opt = getopt_long(argc, argv, "+b:j:f:h", kOptions, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            input = optarg;
+            break;
+        case 'j':
+            batch.SetJobs(static_cast<unsigned>(atoi(optarg)));
+            break;
+        case 'f':
+            VerifyOrExit(batch.SetFormat(optarg), help(), ret = EX_USAGE);
+            break;
+        default:
+            ExitNow(help(), ret = EX_USAGE);
+        }
+    }
+
+    if (input != nullptr)
+    {
+        VerifyOrExit(optind == argc, help(), ret = EX_USAGE);
+        ExitNow(ret = batch.Run(input));
+    }
 
-    VerifyOrExit(argc == 4, help(), ret = EX_USAGE);
-    ret = printPSKc(argv[1], argv[2], argv[3]);
+    VerifyOrExit(argc - optind == 3, help(), ret = EX_USAGE);
+    ret = printPSKc(argv[optind], argv[optind + 1], argv[optind + 2]);
 
 exit:
     return ret;
@@ -31,11 +31,16 @@
  *   This file implements a simple tool to compute pskc.
  */
 
-#include <mbedtls/sha256.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sysexits.h>
 
+#include "batch.hpp"
 #include "common/code_utils.hpp"
 #include "utils/hex.hpp"
 #include "utils/steering_data.hpp"
@@ -45,67 +50,180 @@ void help(void)
     printf("steering-data - compute steering data\n"
            "SYNTAX:\n"
            "    steering-data [LENGTH] <JOINER_ID> ...\n"
+           "    steering-data -r <RATE> <JOINER_ID> ...\n"
+           "    steering-data -b <RECORDS | -> [-r <RATE>] [-j <JOBS>] [-f <csv | json>]\n"
+           "OPTIONS:\n"
+           "    -r, --rate      Pick the shortest length keeping the false positive rate within RATE, between\n"
+           "                    0 and 1, when no LENGTH is given.\n"
+           "    -b, --batch     Compute the records of a file, \"-\" for stdin. Each line holds the arguments\n"
+           "                    [LENGTH] <JOINER_ID> ... separated by spaces.\n"
+           "    -j, --jobs      Number of threads in batch mode, the number of cores by default.\n"
+           "    -f, --format    Output format in batch mode, csv by default.\n"
            "EXAMPLE:\n"
            "    steering-data 18b4300000000001\n"
            "    steering-data 15 18b4300000000001\n"
-           "    steering-data 18b4300000000001 18b4300000000002\n");
+           "    steering-data 18b4300000000001 18b4300000000002\n"
+           "    steering-data -r 0.01 18b4300000000001 18b4300000000002\n"
+           "    steering-data -b joiners.txt -f json\n");
 }
 
-int ComputeJoinerId(const char *aEui64, uint8_t *aJoinerId)
+bool ParseEui64(const std::string &aEui64, uint8_t *aEui64Bytes)
 {
-    int ret = -1;
+    return aEui64.size() == otbr::SteeringData::kSizeJoinerId * 2 &&
+           otbr::Utils::Hex2Bytes(aEui64.c_str(), aEui64Bytes, otbr::SteeringData::kSizeJoinerId) ==
+               otbr::SteeringData::kSizeJoinerId;
+}
 
-    VerifyOrExit(strlen(aEui64) == otbr::SteeringData::kSizeJoinerId * 2);
-    VerifyOrExit(otbr::Utils::Hex2Bytes(aEui64, aJoinerId, otbr::SteeringData::kSizeJoinerId) ==
-                 otbr::SteeringData::kSizeJoinerId);
-    otbr::SteeringData::ComputeJoinerId(aJoinerId, aJoinerId);
-    ret = 0;
+static double sFalsePositiveRate = 0;
 
-exit:
-    if (ret != 0)
+bool ComputeSteeringData(const std::vector<std::string> &aArgs,
+                         std::string &                   aLength,
+                         std::string &                   aSteeringData,
+                         std::string &                   aFalsePositiveRate,
+                         std::string &                   aError)
+{
+    otbr::SteeringDataBuilder builder;
+    std::vector<uint8_t>      eui64s;
+    int                       length   = 16;
+    bool                      adaptive = (sFalsePositiveRate > 0);
+    size_t                    i        = 0;
+    bool                      valid    = false;
+    char                      rate[sizeof("0.000000")];
+
+    VerifyOrExit(!aArgs.empty(), aError = "No joiner ID.");
+
+    if (aArgs[i].size() != otbr::SteeringData::kSizeJoinerId * 2)
     {
-        fprintf(stderr, "Invalid EUI64: %s", aEui64);
+        length = atoi(aArgs[i].c_str());
+        VerifyOrExit(length > 0 && length <= otbr::SteeringData::kMaxSizeOfBloomFilter,
+                     aError = "Invalid bloom filter length: " + aArgs[i]);
+
+        adaptive = false;
+        ++i;
     }
 
-    return ret;
-}
+    eui64s.resize((aArgs.size() - i) * otbr::SteeringData::kSizeJoinerId);
 
-int main(int argc, char *argv[])
-{
-    otbr::SteeringData computer;
-    int                ret    = EX_USAGE;
-    int                length = 16;
-    int                i      = 1;
+    for (size_t j = 0; i + j < aArgs.size(); ++j)
+    {
+        VerifyOrExit(ParseEui64(aArgs[i + j], &eui64s[j * otbr::SteeringData::kSizeJoinerId]),
+                     aError = "Invalid EUI64 : " + aArgs[i + j]);
+    }
+
+    builder.Rebuild(static_cast<uint8_t>(length));
+    builder.AddJoiners(eui64s.data(), eui64s.size() / otbr::SteeringData::kSizeJoinerId);
 
-    if (argc < 2)
+    if (adaptive)
     {
-        ExitNow(help());
+        builder.RebuildForFalsePositiveRate(sFalsePositiveRate);
+        length = builder.GetSteeringData().GetLength();
     }
 
-    if (strlen(argv[i]) != otbr::SteeringData::kSizeJoinerId * 2)
+    snprintf(rate, sizeof(rate), "%.6f", builder.GetSteeringData().GetFalsePositiveRate());
+    aFalsePositiveRate = rate;
+    aLength            = std::to_string(length);
+    aSteeringData.clear();
+
+    for (i = 0; i < static_cast<size_t>(length); i++)
     {
-        length = atoi(argv[i]);
-        VerifyOrExit(length > 0 && length <= otbr::SteeringData::kMaxSizeOfBloomFilter,
-                     fprintf(stderr, "Invalid bloom filter length: %d\n", length));
+        char hex[3];
 
-        ++i;
+        snprintf(hex, sizeof(hex), "%02x", builder.GetSteeringData().GetBloomFilter()[i]);
+        aSteeringData += hex;
     }
 
-    computer.Init(static_cast<uint8_t>(length));
+    valid = true;
 
-    for (; i < argc; ++i)
+exit:
+    return valid;
+}
+
+bool ComputeRecord(const std::string &aRecord, std::vector<std::string> &aValues, std::string &aError)
+{
+    std::istringstream       record(aRecord);
+    std::vector<std::string> args;
+    std::string              arg;
+    std::string              joinerIds;
+    std::string              length;
+    std::string              steeringData;
+    std::string              rate;
+    bool                     valid = false;
+
+    while (record >> arg)
+    {
+        args.push_back(arg);
+    }
+
+    VerifyOrExit(ComputeSteeringData(args, length, steeringData, rate, aError));
+
+    for (size_t i = (args[0].size() == otbr::SteeringData::kSizeJoinerId * 2) ? 0 : 1; i < args.size(); i++)
+    {
+        joinerIds += (joinerIds.empty() ? "" : " ") + args[i];
+    }
+
+    aValues = {length, joinerIds, steeringData, rate};
+    valid   = true;
+
+exit:
+    return valid;
+}
+
+int main(int argc, char *argv[])
+{
+    static const option kOptions[] = {{"batch", required_argument, nullptr, 'b'},
+                                      {"jobs", required_argument, nullptr, 'j'},
+                                      {"format", required_argument, nullptr, 'f'},
+                                      {"rate", required_argument, nullptr, 'r'},
+                                      {"help", no_argument, nullptr, 'h'},
+                                      {nullptr, 0, nullptr, 0}};
+
+    otbr::Tools::Batch batch({"length", "joiner_ids", "steering_data", "false_positive_rate"}, ComputeRecord);
+    const char *       input = nullptr;
+    std::string        length;
+    std::string        steeringData;
+    std::string        rate;
+    std::string        error;
+    int                ret = EX_USAGE;
+    int                opt;
+
+    while ((opt = getopt_long(argc, argv, "+b:j:f:r:h", kOptions, nullptr)) != -1)
     {
-        uint8_t joinerId[otbr::SteeringData::kSizeJoinerId];
+        switch (opt)
+        {
+        case 'b':
+            input = optarg;
+            break;
+        case 'j':
+            batch.SetJobs(static_cast<unsigned>(atoi(optarg)));
+            break;
+        case 'f':
+            VerifyOrExit(batch.SetFormat(optarg), help());
+            break;
+        case 'r':
+            sFalsePositiveRate = atof(optarg);
+            VerifyOrExit(sFalsePositiveRate > 0 && sFalsePositiveRate < 1,
+                         fprintf(stderr, "Invalid false positive rate: %s\n", optarg));
+            break;
+        default:
+            ExitNow(help());
+        }
+    }
 
-        VerifyOrExit(ComputeJoinerId(argv[i], joinerId) == 0, fprintf(stderr, "Invalid EUI64 : %s\n", argv[i]));
-        computer.ComputeBloomFilter(joinerId);
+    if (input != nullptr)
+    {
+        VerifyOrExit(optind == argc, help());
+        ExitNow(ret = batch.Run(input));
     }
 
-    for (i = 0; i < length; i++)
+    if (optind == argc)
     {
-        printf("%02x", computer.GetBloomFilter()[i]);
+        ExitNow(help());
     }
-    printf("\n");
+
+    VerifyOrExit(
+        ComputeSteeringData(std::vector<std::string>(argv + optind, argv + argc), length, steeringData, rate, error),
+        fprintf(stderr, "%s\n", error.c_str()));
+    printf("%s\n", steeringData.c_str());
 
     ret = EX_OK;
 